@@ -82,6 +82,8 @@ static const dma_conf_t dma_config[] = {
     { .stream = 6  },
     { .stream = 10 },
     { .stream = 8  },
+    { .stream = 1  },
+    { .stream = 12 },
 };
 
 #define DMA_0_ISR  isr_dma1_stream4
@@ -89,6 +91,8 @@ static const dma_conf_t dma_config[] = {
 #define DMA_2_ISR  isr_dma1_stream6
 #define DMA_3_ISR  isr_dma2_stream2
 #define DMA_4_ISR  isr_dma2_stream0
+#define DMA_5_ISR  isr_dma1_stream1
+#define DMA_6_ISR  isr_dma2_stream4
 
 #define DMA_NUMOF           (sizeof(dma_config) / sizeof(dma_config[0]))
 #endif
@@ -130,6 +134,10 @@ static const uart_conf_t uart_config[] = {
 #ifdef MODULE_PERIPH_DMA
         .dma        = 0,
         .dma_chan   = 7,
+#endif
+#ifdef MODULE_STM32_PERIPH_UART_RX_DMA
+        .rx_dma     = 5,
+        .rx_dma_chan = 4,
 #endif
     },
     {
@@ -144,6 +152,9 @@ static const uart_conf_t uart_config[] = {
 #ifdef MODULE_PERIPH_DMA
         .dma        = 1,
         .dma_chan   = 5,
+#endif
+#ifdef MODULE_STM32_PERIPH_UART_RX_DMA
+        .rx_dma     = DMA_STREAM_UNDEF,
 #endif
     },
     {
@@ -158,6 +169,9 @@ static const uart_conf_t uart_config[] = {
 #ifdef MODULE_PERIPH_DMA
         .dma        = 3,
         .dma_chan   = 4,
+#endif
+#ifdef MODULE_STM32_PERIPH_UART_RX_DMA
+        .rx_dma     = DMA_STREAM_UNDEF,
 #endif
     },
 };
@@ -293,6 +307,24 @@ static const i2c_conf_t i2c_config[] = {
 }
 /** @} */
 
+/**
+ * @name    ADC stream configuration
+ *
+ * TIM3 triggers the conversions of ADC1, DMA2 stream 4 transfers them.
+ * @{
+ */
+#ifdef MODULE_PERIPH_ADC_STREAM
+static const adc_stream_conf_t adc_stream_config = {
+    .timer    = TIM3,
+    .rcc_mask = RCC_APB1ENR_TIM3EN,
+    .bus      = APB1,
+    .trig     = ADC_TRIG_TIM3_TRGO,
+    .dma      = 6,
+    .dma_chan = 0,
+};
+#endif
+/** @} */
+
 /**
  * @name    RTC configuration
  * @{
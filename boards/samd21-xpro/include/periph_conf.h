@@ -308,6 +308,18 @@ static const adc_conf_chan_t adc_channels[] = {
 
 #define ADC_0_CHANNELS                     (6U)
 #define ADC_NUMOF                          ADC_0_CHANNELS
+
+#ifdef MODULE_PERIPH_ADC_STREAM
+/* TC7 triggers the conversions, at up to about 100 kHz with 12 bit */
+static const adc_stream_conf_t adc_stream_config = {
+    .dev        = TC7,
+    .pm_mask    = PM_APBCMASK_TC7,
+    .gclk_id    = GCLK_CLKCTRL_ID_TC6_TC7_Val,
+    .evgen      = EVSYS_ID_GEN_TC7_OVF,
+    .evsys_chan = 0,
+    .prescaler  = ADC_CTRLB_PRESCALER_DIV32,
+};
+#endif
 /** @} */
 
 #ifdef __cplusplus
@@ -39,15 +39,20 @@ void cond_wait(cond_t *cond, mutex_t *mutex)
 
     mutex_unlock(mutex);
     sched_set_status(me, STATUS_COND_BLOCKED);
+    /* tells the signaling thread the mutex to queue us on */
+    me->wait_data = mutex;
     thread_add_to_list(&cond->queue, me);
     irq_restore(irqstate);
     thread_yield_higher();
 
     /*
      * Once we reach this point, the condition variable was signalled,
-     * and we are free to continue.
+     * and we are free to continue. If the mutex was locked when signalled,
+     * we were moved to its queue and hold it already.
      */
-    mutex_lock(mutex);
+    if (me->wait_data != NULL) {
+        mutex_lock(mutex);
+    }
 }
 
 static void _cond_signal(cond_t *cond, bool broadcast)
@@ -59,10 +64,18 @@ static void _cond_signal(cond_t *cond, bool broadcast)
 
     while ((next = list_remove_head(&cond->queue)) != NULL) {
         thread_t *process = container_of((clist_node_t *)next, thread_t, rq_entry);
-        sched_set_status(process, STATUS_PENDING);
-        uint16_t process_priority = process->priority;
-        if (process_priority < min_prio) {
-            min_prio = process_priority;
+
+        /* a waiter would only block on a locked mutex right away, so it is
+         * queued on the mutex instead of waking it */
+        if (_mutex_morph(process->wait_data, process)) {
+            process->wait_data = NULL;
+        }
+        else {
+            sched_set_status(process, STATUS_PENDING);
+            uint16_t process_priority = process->priority;
+            if (process_priority < min_prio) {
+                min_prio = process_priority;
+            }
         }
 
         if (!broadcast) {
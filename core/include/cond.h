@@ -58,6 +58,12 @@
  * the condition is actually true, and goes to sleep again if it is not. This
  * is the standard way to use Mesa-style condition variables.
  *
+ * If the mutex is locked when a thread is signaled, typically by the
+ * signaling thread itself, the signaled thread is moved to the queue of the
+ * mutex right away instead of being woken ("wait morphing"). This way,
+ * cond_broadcast() does not wake all waiters just to have them block on the
+ * mutex again, they are woken one after another as the mutex is unlocked.
+ *
  * Example: Suppose we want to implement a bounded queue, such as a Unix-style
  * pipe between two threads. When data is written to the pipe, it is appended
  * to a queue, and the writing thread blocks if the queue is full. When data
@@ -108,6 +108,49 @@
 #define UNREACHABLE() do { /* nothing */ } while (1)
 #endif
 
+/**
+ * @def FASTCODE
+ * @brief Place a function in the fastest executable memory of the CPU
+ * @details This is the ITCM RAM on the STM32F7 and the normal RAM on all other
+ *          Cortex-M CPUs. Without the `fastmem` module the function stays where
+ *          it would be anyway. `fastmem_core`, `fastmem_gnrc_netif` and
+ *          `fastmem_crypto` select the hot paths of the kernel, the GNRC
+ *          interface thread and the AES rounds.
+ *
+ * @def FASTDATA
+ * @brief Place an initialized variable in the fastest data memory of the CPU
+ * @details This is the CCM RAM on CPUs that have one. The DMA controllers can
+ *          not reach it there, so buffers handed to DMA must not use this.
+ *
+ * @def FASTBSS
+ * @brief Like #FASTDATA, but for zero-initialized variables, e.g. thread
+ *        stacks and message queues
+ */
+#if defined(MODULE_FASTMEM) && defined(__GNUC__)
+#define FASTCODE  __attribute__((section(".fastcode")))
+#define FASTDATA  __attribute__((section(".fastdata")))
+#define FASTBSS   __attribute__((section(".fastbss")))
+#else
+#define FASTCODE
+#define FASTDATA
+#define FASTBSS
+#endif
+
+/**
+ * @def CORE_FASTCODE
+ * @brief #FASTCODE for the hot paths of the kernel, used with `fastmem_core`
+ *
+ * @def CORE_FASTBSS
+ * @brief #FASTBSS for the kernel's own thread stacks, used with `fastmem_core`
+ */
+#ifdef MODULE_FASTMEM_CORE
+#define CORE_FASTCODE   FASTCODE
+#define CORE_FASTBSS    FASTBSS
+#else
+#define CORE_FASTCODE
+#define CORE_FASTBSS
+#endif
+
 /**
  * @def         ALIGN_OF(T)
  * @brief       Calculate the minimal alignment for type T.
@@ -309,6 +309,38 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive up to @p max messages at once.
+ *
+ * Drains up to @p max messages from the thread's message queue (and from
+ * threads blocked on sending to it) within a single critical section. This
+ * function blocks until at least one message was received.
+ *
+ * @pre `max > 0`
+ *
+ * @param[out] out  Array of at least @p max ``msg_t`` structures, must not be
+ *                  NULL. Messages are stored in the order they were sent.
+ * @param[in]  max  Maximum number of messages to receive.
+ *
+ * @return  Number of received messages (at least 1).
+ */
+int msg_receive_batch(msg_t *out, unsigned max);
+
+/**
+ * @brief Try to receive up to @p max messages at once.
+ *
+ * Non-blocking variant of @ref msg_receive_batch().
+ *
+ * @pre `max > 0`
+ *
+ * @param[out] out  Array of at least @p max ``msg_t`` structures, must not be
+ *                  NULL. Messages are stored in the order they were sent.
+ * @param[in]  max  Maximum number of messages to receive.
+ *
+ * @return  Number of received messages, 0 if there was none.
+ */
+int msg_try_receive_batch(msg_t *out, unsigned max);
+
 /**
  * @brief Send a message, block until reply received.
  *
@@ -11,6 +11,21 @@
  * @defgroup    core_sync Synchronization
  * @brief       Mutex for thread synchronization
  * @ingroup     core
+ *
+ * With the `core_mutex_priority_inheritance` module, a thread blocking on a
+ * mutex lends its priority to the thread holding it, if that one has a lower
+ * priority, until the mutex is unlocked again. This bounds priority inversion
+ * of a high priority thread waiting on a mutex to the time the owner needs to
+ * unlock it. The inheritance is not transitive: an owner that is itself
+ * blocked on another mutex does not pass the boost on. Nested mutexes have to
+ * be unlocked in reverse order of locking for the priorities to be restored
+ * correctly. This costs a few instructions per lock and unlock and enlarges
+ * every mutex by 4 bytes on 32 bit platforms.
+ *
+ * @warning Mutexes used for signaling, i.e. that are unlocked by another
+ *          thread or an ISR than the one that locked them, may boost the
+ *          locking thread for no reason until they are unlocked.
+ *
  * @{
  *
  * @file
@@ -23,7 +38,9 @@
 #define MUTEX_H
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include "kernel_types.h"
 #include "list.h"
 
 #ifdef __cplusplus
@@ -40,18 +57,51 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   The thread holding the mutex, @ref KERNEL_PID_UNDEF if unknown
+     * @internal
+     *
+     * Only available with the `core_mutex_priority_inheritance` module.
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Priority of the owner before a waiter boosted it,
+     *          @ref MUTEX_NOT_BOOSTED if it was not boosted
+     * @internal
+     *
+     * Only available with the `core_mutex_priority_inheritance` module.
+     */
+    uint8_t owner_original_priority;
+#endif
 } mutex_t;
 
+/**
+ * @cond INTERNAL
+ * @brief Value of mutex_t::owner_original_priority while the owner runs at
+ *        its own priority
+ */
+#define MUTEX_NOT_BOOSTED   (0xff)
+/**
+ * @endcond
+ */
+
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
-#define MUTEX_INIT { { NULL } }
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, MUTEX_NOT_BOOSTED }
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, \
+                            MUTEX_NOT_BOOSTED }
+#else
+#define MUTEX_INIT { { NULL } }
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -72,6 +122,10 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+    mutex->owner_original_priority = MUTEX_NOT_BOOSTED;
+#endif
 }
 
 /**
@@ -127,6 +181,25 @@ void mutex_unlock(mutex_t *mutex);
  */
 void mutex_unlock_and_sleep(mutex_t *mutex);
 
+struct _thread;
+
+/**
+ * @brief Moves a thread waiting for a condition onto the queue of a mutex.
+ *
+ * @details Used by condition variables to hand a signaled thread directly to
+ *          the mutex it reacquires ("wait morphing"), instead of waking it
+ *          only to block on the mutex again. The thread is woken holding the
+ *          mutex once it is unlocked. Must be called with interrupts
+ *          disabled, for a thread that is blocked.
+ *
+ * @param[in] mutex         Mutex the thread reacquires, must not be NULL.
+ * @param[in] thread        Blocked thread.
+ *
+ * @return 1 if the thread was queued on the locked mutex.
+ * @return 0 if the mutex is unlocked, the caller wakes the thread.
+ */
+int _mutex_morph(mutex_t *mutex, struct _thread *thread);
+
 #ifdef __cplusplus
 }
 #endif
@@ -156,6 +156,41 @@ int ringbuffer_peek_one(const ringbuffer_t *__restrict rb);
  */
 unsigned ringbuffer_peek(const ringbuffer_t *__restrict rb, char *buf, unsigned n);
 
+/**
+ * @brief           Get the contiguous free space behind the newest element,
+ *                  to be written directly, e.g. by DMA.
+ * @details         The elements written become available with
+ *                  ringbuffer_commit(). Free space wrapping around the end of
+ *                  the buffer takes a second call after committing.
+ * @param[in]       rb    Ringbuffer to operate on.
+ * @param[out]      n     Number of elements that may be written.
+ * @returns         Start of the free space.
+ */
+char *ringbuffer_reserve(ringbuffer_t *__restrict rb, unsigned *n);
+
+/**
+ * @brief           Add the elements written after ringbuffer_reserve().
+ * @param[in,out]   rb    Ringbuffer to operate on.
+ * @param[in]       n     Number of elements written, at most the number
+ *                        returned by ringbuffer_reserve().
+ */
+static inline void ringbuffer_commit(ringbuffer_t *__restrict rb, unsigned n)
+{
+    rb->avail += n;
+}
+
+/**
+ * @brief           Get the contiguous elements starting with the oldest one,
+ *                  to be read directly.
+ * @details         Remove the elements read with ringbuffer_remove().
+ *                  Elements wrapping around the end of the buffer take a
+ *                  second call after removing.
+ * @param[in]       rb    Ringbuffer to operate on.
+ * @param[out]      n     Number of elements that may be read.
+ * @returns         The oldest element.
+ */
+char *ringbuffer_peek_region(const ringbuffer_t *__restrict rb, unsigned *n);
+
 #ifdef __cplusplus
 }
 #endif
@@ -133,6 +133,25 @@ void sched_set_status(thread_t *process, unsigned int status);
  */
 void sched_switch(uint16_t other_prio);
 
+/**
+ * @brief   Change the priority of a thread
+ *
+ * @details A thread on the runqueue is moved to the runqueue of its new
+ *          priority, as the first entry if it is the active thread.
+ *          This does not yield, the caller has to call sched_switch() or
+ *          thread_yield_higher() if appropriate.
+ *
+ * @note    Used by the `core_mutex_priority_inheritance` module, threads
+ *          waiting in a mutex's queue are not reordered.
+ *
+ * @pre     interrupts are disabled
+ *
+ * @param[in]   thread      The thread to change
+ * @param[in]   priority    The new priority, lower than
+ *                          @ref SCHED_PRIO_LEVELS
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief   Call context switching at thread exit
  */
@@ -175,6 +194,16 @@ extern clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
 NORETURN void sched_task_exit(void);
 
 #ifdef MODULE_SCHEDSTATISTICS
+#ifndef SCHEDSTAT_LATENCY_BUCKETS
+/**
+ * @brief   Number of log2 buckets of the wakeup latency histogram
+ *
+ * Bucket 0 counts wakeups with a latency of 0 ticks, bucket n > 0 counts
+ * latencies in [2^(n-1), 2^n).  The last bucket also counts everything above.
+ */
+#define SCHEDSTAT_LATENCY_BUCKETS   (16)
+#endif
+
 /**
  *  Scheduler statistics
  */
@@ -183,6 +212,18 @@ typedef struct {
                                   scheduled to run */
     unsigned int schedules;  /**< How often the thread was scheduled to run */
     uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
+    uint32_t wakeup;         /**< Time stamp of the last time this thread was
+                                  put on the runqueue */
+    uint32_t latency_max;    /**< Longest wakeup-to-run latency in ticks */
+    unsigned int wakeups;    /**< How often the thread was put on the
+                                  runqueue */
+    unsigned int preemptions;   /**< How often the thread was switched out
+                                     while still runnable */
+    unsigned int latency_hist[SCHEDSTAT_LATENCY_BUCKETS]; /**< log2 histogram
+                                                               of wakeup-to-run
+                                                               latencies */
+    uint8_t woken;           /**< Set while the latency measurement of the
+                                  last wakeup is pending */
 } schedstat;
 
 /**
@@ -196,6 +237,15 @@ extern schedstat sched_pidlist[KERNEL_PID_LAST + 1];
  *  @param[in] callback The callback functions the will be called
  */
 void sched_register_cb(void (*callback)(uint32_t, uint32_t));
+
+/**
+ *  @brief  Clear the wakeup latency and preemption statistics of a thread
+ *
+ *  The runtime statistics used by ps() are not touched.
+ *
+ *  @param[in] pid      The thread to clear the statistics for
+ */
+void sched_latency_reset(kernel_pid_t pid);
 #endif /* MODULE_SCHEDSTATISTICS */
 
 #ifdef __cplusplus
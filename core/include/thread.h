@@ -188,11 +188,8 @@ struct _thread {
 
     clist_node_t rq_entry;          /**< run queue entry                */
 
-#if defined(MODULE_CORE_MSG) || defined(MODULE_CORE_THREAD_FLAGS) \
-    || defined(MODULE_CORE_MBOX) || defined(DOXYGEN)
-    void *wait_data;                /**< used by msg, mbox and thread
-                                         flags                          */
-#endif
+    void *wait_data;                /**< used by msg, mbox, thread flags
+                                         and condition variables        */
 #if defined(MODULE_CORE_MSG) || defined(DOXYGEN)
     list_node_t msg_waiters;        /**< threads waiting for their message
                                          to be delivered to this thread
@@ -74,8 +74,8 @@ static void *idle_thread(void *arg)
 const char *main_name = "main";
 const char *idle_name = "idle";
 
-static char main_stack[THREAD_STACKSIZE_MAIN];
-static char idle_stack[THREAD_STACKSIZE_IDLE];
+static char CORE_FASTBSS main_stack[THREAD_STACKSIZE_MAIN];
+static char CORE_FASTBSS idle_stack[THREAD_STACKSIZE_IDLE];
 
 void kernel_init(void)
 {
@@ -37,9 +37,10 @@
 #include "debug.h"
 
 static int _msg_receive(msg_t *m, int block);
+static int _msg_receive_batch(msg_t *out, unsigned max, int block);
 static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state);
 
-static int queue_msg(thread_t *target, const msg_t *m)
+static CORE_FASTCODE int queue_msg(thread_t *target, const msg_t *m)
 {
     int n = cib_put(&(target->msg_queue));
     if (n < 0) {
@@ -57,7 +58,7 @@ static int queue_msg(thread_t *target, const msg_t *m)
     return 1;
 }
 
-int msg_send(msg_t *m, kernel_pid_t target_pid)
+CORE_FASTCODE int msg_send(msg_t *m, kernel_pid_t target_pid)
 {
     if (irq_is_in()) {
         return msg_send_int(m, target_pid);
@@ -79,7 +80,7 @@ int msg_try_send(msg_t *m, kernel_pid_t target_pid)
     return _msg_send(m, target_pid, false, irq_disable());
 }
 
-static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state)
+static CORE_FASTCODE int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state)
 {
 #ifdef DEVELHELP
     if (!pid_is_valid(target_pid)) {
@@ -182,7 +183,7 @@ int msg_send_to_self(msg_t *m)
     return res;
 }
 
-int msg_send_int(msg_t *m, kernel_pid_t target_pid)
+CORE_FASTCODE int msg_send_int(msg_t *m, kernel_pid_t target_pid)
 {
 #ifdef DEVELHELP
     if (!pid_is_valid(target_pid)) {
@@ -281,12 +282,12 @@ int msg_try_receive(msg_t *m)
     return _msg_receive(m, 0);
 }
 
-int msg_receive(msg_t *m)
+CORE_FASTCODE int msg_receive(msg_t *m)
 {
     return _msg_receive(m, 1);
 }
 
-static int _msg_receive(msg_t *m, int block)
+static CORE_FASTCODE int _msg_receive(msg_t *m, int block)
 {
     unsigned state = irq_disable();
     DEBUG("_msg_receive: %" PRIkernel_pid ": _msg_receive.\n",
@@ -372,6 +373,96 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+int msg_try_receive_batch(msg_t *out, unsigned max)
+{
+    return _msg_receive_batch(out, max, 0);
+}
+
+int msg_receive_batch(msg_t *out, unsigned max)
+{
+    return _msg_receive_batch(out, max, 1);
+}
+
+/* copies the message of a sender from the waiting list to m and unblocks
+ * the sender, returns the priority to switch to (or THREAD_PRIORITY_IDLE) */
+static uint16_t _take_waiter_msg(thread_t *me, msg_t *m, uint16_t prio)
+{
+    list_node_t *next = list_remove_head(&me->msg_waiters);
+    thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+
+    *m = *((msg_t*) sender->wait_data);
+    if (sender->status != STATUS_REPLY_BLOCKED) {
+        sender->wait_data = NULL;
+        sched_set_status(sender, STATUS_PENDING);
+        if (sender->priority < prio) {
+            prio = sender->priority;
+        }
+    }
+    return prio;
+}
+
+static int _msg_receive_batch(msg_t *out, unsigned max, int block)
+{
+    assert((out != NULL) && (max > 0));
+
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t*) sched_threads[sched_active_pid];
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned n = 0;
+
+    DEBUG("_msg_receive_batch: %" PRIkernel_pid ": up to %u messages.\n",
+          sched_active_thread->pid, max);
+
+    /* queued messages are older than the ones of blocked senders */
+    while (n < max) {
+        int queue_index = -1;
+
+        if (me->msg_array) {
+            queue_index = cib_get(&(me->msg_queue));
+        }
+        if (queue_index >= 0) {
+            out[n++] = me->msg_array[queue_index];
+        }
+        else if (me->msg_waiters.next) {
+            sender_prio = _take_waiter_msg(me, &out[n++], sender_prio);
+        }
+        else {
+            break;
+        }
+    }
+
+    /* move the messages of remaining senders into the just freed queue
+     * space */
+    while (me->msg_array && me->msg_waiters.next &&
+           !cib_full(&(me->msg_queue))) {
+        msg_t *m = &(me->msg_array[cib_put(&(me->msg_queue))]);
+        sender_prio = _take_waiter_msg(me, m, sender_prio);
+    }
+
+    if (n == 0) {
+        if (!block) {
+            irq_restore(state);
+            return 0;
+        }
+        DEBUG("_msg_receive_batch(): %" PRIkernel_pid ": No msg in queue. "
+              "Going blocked.\n", sched_active_thread->pid);
+        me->wait_data = (void *) out;
+        sched_set_status(me, STATUS_RECEIVE_BLOCKED);
+
+        irq_restore(state);
+        thread_yield_higher();
+
+        /* sender copied message */
+        return 1;
+    }
+
+    irq_restore(state);
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+    return n;
+}
+
 int msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
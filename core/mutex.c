@@ -32,6 +32,60 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+static inline void _set_owner(mutex_t *mutex, thread_t *thread)
+{
+    mutex->owner = thread->pid;
+    mutex->owner_original_priority = MUTEX_NOT_BOOSTED;
+}
+
+/* lends the priority of a thread about to block on the mutex to its owner */
+static inline void _boost_owner(mutex_t *mutex, thread_t *me)
+{
+    thread_t *owner = (thread_t *)thread_get(mutex->owner);
+
+    if ((owner != NULL) && (owner->priority > me->priority)) {
+        DEBUG("PID[%" PRIkernel_pid "]: boosting owner %" PRIkernel_pid
+              " to prio %" PRIu32 "\n", me->pid, owner->pid,
+              (uint32_t)me->priority);
+        if (mutex->owner_original_priority == MUTEX_NOT_BOOSTED) {
+            mutex->owner_original_priority = owner->priority;
+        }
+        sched_change_priority(owner, me->priority);
+    }
+}
+
+static inline void _restore_owner(mutex_t *mutex)
+{
+    if (mutex->owner_original_priority != MUTEX_NOT_BOOSTED) {
+        thread_t *owner = (thread_t *)thread_get(mutex->owner);
+
+        if (owner != NULL) {
+            sched_change_priority(owner, mutex->owner_original_priority);
+        }
+    }
+    mutex->owner = KERNEL_PID_UNDEF;
+    mutex->owner_original_priority = MUTEX_NOT_BOOSTED;
+}
+#else
+static inline void _set_owner(mutex_t *mutex, thread_t *thread)
+{
+    (void)mutex;
+    (void)thread;
+}
+
+static inline void _boost_owner(mutex_t *mutex, thread_t *me)
+{
+    (void)mutex;
+    (void)me;
+}
+
+static inline void _restore_owner(mutex_t *mutex)
+{
+    (void)mutex;
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -41,6 +95,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _set_owner(mutex, (thread_t *)sched_active_thread);
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -50,6 +105,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         thread_t *me = (thread_t*)sched_active_thread;
         DEBUG("PID[%" PRIkernel_pid "]: Adding node to mutex queue: prio: %"
               PRIu32 "\n", sched_active_pid, (uint32_t)me->priority);
+        _boost_owner(mutex, me);
         sched_set_status(me, STATUS_MUTEX_BLOCKED);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = (list_node_t*)&me->rq_entry;
@@ -70,6 +126,26 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     }
 }
 
+int _mutex_morph(mutex_t *mutex, thread_t *thread)
+{
+    if (mutex->queue.next == NULL) {
+        return 0;
+    }
+
+    DEBUG("PID[%" PRIkernel_pid "]: Moving thread %" PRIkernel_pid
+          " to mutex queue\n", sched_active_pid, thread->pid);
+    _boost_owner(mutex, thread);
+    sched_set_status(thread, STATUS_MUTEX_BLOCKED);
+    if (mutex->queue.next == MUTEX_LOCKED) {
+        mutex->queue.next = (list_node_t*)&thread->rq_entry;
+        mutex->queue.next->next = NULL;
+    }
+    else {
+        thread_add_to_list(&mutex->queue, thread);
+    }
+    return 1;
+}
+
 void mutex_unlock(mutex_t *mutex)
 {
     unsigned irqstate = irq_disable();
@@ -83,6 +159,8 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+    _restore_owner(mutex);
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
@@ -97,6 +175,7 @@ void mutex_unlock(mutex_t *mutex)
     DEBUG("mutex_unlock: waking up waiting thread %" PRIkernel_pid "\n",
           process->pid);
     sched_set_status(process, STATUS_PENDING);
+    _set_owner(mutex, process);
 
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
@@ -114,6 +193,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+        _restore_owner(mutex);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -123,6 +203,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
                                              rq_entry);
             DEBUG("PID[%" PRIkernel_pid "]: waking up waiter.\n", process->pid);
             sched_set_status(process, STATUS_PENDING);
+            _set_owner(mutex, process);
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
@@ -36,6 +36,10 @@
 #include "ps.h"
 #endif
 
+#ifdef MODULE_STDIO_UART_TX_ASYNC
+#include "stdio_uart.h"
+#endif
+
 const char assert_crash_message[] = "FAILED ASSERTION.";
 
 /* flag preventing "recursive crash printing loop" */
@@ -68,6 +72,9 @@ NORETURN void core_panic(core_panic_t crash_code, const char *message)
         LOG_ERROR("*** halted.\n\n");
 #else
         LOG_ERROR("*** rebooting...\n\n");
+#endif
+#ifdef MODULE_STDIO_UART_TX_ASYNC
+        stdio_uart_tx_flush();
 #endif
     }
     /* disable watchdog and all possible sources of interrupts */
@@ -52,16 +52,39 @@ static char get_head(ringbuffer_t *restrict rb)
     return result;
 }
 
+/**
+ * @brief           Position behind the newest element.
+ * @param[in]       rb   Ringbuffer to operate on.
+ * @returns         Index into rb->buf.
+ */
+static unsigned tail(const ringbuffer_t *restrict rb)
+{
+    unsigned pos = rb->start + rb->avail;
+    if (pos >= rb->size) {
+        pos -= rb->size;
+    }
+    return pos;
+}
+
 unsigned ringbuffer_add(ringbuffer_t *restrict rb, const char *buf, unsigned n)
 {
-    unsigned i;
-    for (i = 0; i < n; i++) {
-        if (ringbuffer_full(rb)) {
-            break;
+    unsigned free = ringbuffer_get_free(rb);
+    if (n > free) {
+        n = free;
+    }
+    if (n > 0) {
+        unsigned pos = tail(rb);
+        unsigned bytes_till_end = rb->size - pos;
+        if (bytes_till_end >= n) {
+            memcpy(rb->buf + pos, buf, n);
         }
-        add_tail(rb, buf[i]);
+        else {
+            memcpy(rb->buf + pos, buf, bytes_till_end);
+            memcpy(rb->buf, buf + bytes_till_end, n - bytes_till_end);
+        }
+        rb->avail += n;
     }
-    return i;
+    return n;
 }
 
 int ringbuffer_add_one(ringbuffer_t *restrict rb, char c)
@@ -121,7 +144,7 @@ unsigned ringbuffer_remove(ringbuffer_t *restrict rb, unsigned n)
         rb->avail -= n;
 
         /* compensate underflow */
-        if (rb->start > rb->size) {
+        if (rb->start >= rb->size) {
             rb->start -= rb->size;
         }
     }
@@ -140,3 +163,21 @@ unsigned ringbuffer_peek(const ringbuffer_t *restrict rb_, char *buf, unsigned n
     ringbuffer_t rb = *rb_;
     return ringbuffer_get(&rb, buf, n);
 }
+
+char *ringbuffer_reserve(ringbuffer_t *restrict rb, unsigned *n)
+{
+    unsigned pos = tail(rb);
+    unsigned bytes_till_end = rb->size - pos;
+    unsigned free = ringbuffer_get_free(rb);
+
+    *n = (free < bytes_till_end) ? free : bytes_till_end;
+    return rb->buf + pos;
+}
+
+char *ringbuffer_peek_region(const ringbuffer_t *restrict rb, unsigned *n)
+{
+    unsigned bytes_till_end = rb->size - rb->start;
+
+    *n = (rb->avail < bytes_till_end) ? rb->avail : bytes_till_end;
+    return rb->buf + rb->start;
+}
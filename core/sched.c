@@ -34,9 +34,14 @@
 #endif
 
 #ifdef MODULE_SCHEDSTATISTICS
+#include <string.h>
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_SCHED_ROUND_ROBIN
+#include "sched_round_robin.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -79,7 +84,7 @@ static void (*sched_cb) (uint32_t timestamp, uint32_t value) = NULL;
 schedstat sched_pidlist[KERNEL_PID_LAST + 1];
 #endif
 
-int __attribute__((used)) sched_run(void)
+int CORE_FASTCODE __attribute__((used)) sched_run(void)
 {
     sched_context_switch_request = 0;
 
@@ -95,6 +100,10 @@ int __attribute__((used)) sched_run(void)
           (kernel_pid_t)((active_thread == NULL) ? KERNEL_PID_UNDEF : active_thread->pid),
           next_thread->pid);
 
+#ifdef MODULE_SCHED_ROUND_ROBIN
+    sched_round_robin_check(next_thread);
+#endif
+
     if (active_thread == next_thread) {
         DEBUG("sched_run: done, sched_active_thread was not changed.\n");
         return 0;
@@ -120,6 +129,9 @@ int __attribute__((used)) sched_run(void)
         if (active_stat->laststart) {
             active_stat->runtime_ticks += now - active_stat->laststart;
         }
+        if (active_thread->status >= STATUS_ON_RUNQUEUE) {
+            active_stat->preemptions++;
+        }
 #endif
     }
 
@@ -127,6 +139,18 @@ int __attribute__((used)) sched_run(void)
     schedstat *next_stat = &sched_pidlist[next_thread->pid];
     next_stat->laststart = now;
     next_stat->schedules++;
+    if (next_stat->woken) {
+        uint32_t latency = now - next_stat->wakeup;
+        unsigned bucket = SCHEDSTAT_LATENCY_BUCKETS - 1;
+        if (!(latency >> (SCHEDSTAT_LATENCY_BUCKETS - 1))) {
+            bucket = latency ? (bitarithm_msb(latency) + 1) : 0;
+        }
+        next_stat->latency_hist[bucket]++;
+        if (latency > next_stat->latency_max) {
+            next_stat->latency_max = latency;
+        }
+        next_stat->woken = 0;
+    }
     if (sched_cb) {
         sched_cb(now, next_thread->pid);
     }
@@ -156,9 +180,22 @@ void sched_register_cb(void (*callback)(uint32_t, uint32_t))
 {
     sched_cb = callback;
 }
+
+void sched_latency_reset(kernel_pid_t pid)
+{
+    unsigned state = irq_disable();
+    schedstat *stat = &sched_pidlist[pid];
+
+    stat->latency_max = 0;
+    stat->wakeups = 0;
+    stat->preemptions = 0;
+    stat->woken = 0;
+    memset(stat->latency_hist, 0, sizeof(stat->latency_hist));
+    irq_restore(state);
+}
 #endif
 
-void sched_set_status(thread_t *process, unsigned int status)
+CORE_FASTCODE void sched_set_status(thread_t *process, unsigned int status)
 {
     if (status >= STATUS_ON_RUNQUEUE) {
         if (!(process->status >= STATUS_ON_RUNQUEUE)) {
@@ -166,6 +203,12 @@ void sched_set_status(thread_t *process, unsigned int status)
                   process->pid, process->priority);
             clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHEDSTATISTICS
+            schedstat *stat = &sched_pidlist[process->pid];
+            stat->wakeup = xtimer_now().ticks32;
+            stat->wakeups++;
+            stat->woken = 1;
+#endif
         }
     }
     else {
@@ -183,7 +226,7 @@ void sched_set_status(thread_t *process, unsigned int status)
     process->status = status;
 }
 
-void sched_switch(uint16_t other_prio)
+CORE_FASTCODE void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *) sched_active_thread;
     uint16_t current_prio = active_thread->priority;
@@ -208,6 +251,33 @@ void sched_switch(uint16_t other_prio)
     }
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    if (thread->priority == priority) {
+        return;
+    }
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        DEBUG("sched_change_priority: moving thread %" PRIkernel_pid
+              " from runqueue %" PRIu8 " to %" PRIu8 ".\n",
+              thread->pid, thread->priority, priority);
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+        if (!sched_runqueues[thread->priority].next) {
+            runqueue_bitcache &= ~(1 << thread->priority);
+        }
+        /* the active thread has to stay the head of its runqueue */
+        if (thread == sched_active_thread) {
+            clist_lpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        else {
+            clist_rpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        runqueue_bitcache |= 1 << priority;
+    }
+
+    thread->priority = priority;
+}
+
 NORETURN void sched_task_exit(void)
 {
     DEBUG("sched_task_exit: ending thread %" PRIkernel_pid "...\n", sched_active_thread->pid);
@@ -227,9 +227,9 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     cb->status = 0;
 
     cb->rq_entry.next = NULL;
+    cb->wait_data = NULL;
 
 #ifdef MODULE_CORE_MSG
-    cb->wait_data = NULL;
     cb->msg_waiters.next = NULL;
     cib_init(&(cb->msg_queue), 0);
     cb->msg_array = NULL;
@@ -69,7 +69,15 @@ static void _thread_flags_wait_any(thread_flags_t mask)
 thread_flags_t thread_flags_wait_any(thread_flags_t mask)
 {
     thread_t *me = (thread_t*) sched_active_thread;
-    _thread_flags_wait_any(mask);
+    unsigned state = irq_disable();
+    thread_flags_t res = me->flags & mask;
+    if (res) {
+        /* fast path: take the flags within one critical section */
+        me->flags &= ~res;
+        irq_restore(state);
+        return res;
+    }
+    _thread_flags_wait(mask, me, STATUS_FLAG_BLOCKED_ANY, state);
     return _thread_flags_clear_atomic(me, mask);
 }
 
@@ -87,13 +95,14 @@ thread_flags_t thread_flags_wait_all(thread_flags_t mask)
 {
     unsigned state = irq_disable();
     thread_t *me = (thread_t*) sched_active_thread;
-    if (!((me->flags & mask) == mask)) {
-        DEBUG("thread_flags_wait_all(): pid %"PRIkernel_pid" waiting for %08x\n", thread_getpid(), (unsigned)mask);
-        _thread_flags_wait(mask, me, STATUS_FLAG_BLOCKED_ALL, state);
-    }
-    else {
+    if ((me->flags & mask) == mask) {
+        /* fast path: take the flags within one critical section */
+        me->flags &= ~mask;
         irq_restore(state);
+        return mask;
     }
+    DEBUG("thread_flags_wait_all(): pid %"PRIkernel_pid" waiting for %08x\n", thread_getpid(), (unsigned)mask);
+    _thread_flags_wait(mask, me, STATUS_FLAG_BLOCKED_ALL, state);
 
     return _thread_flags_clear_atomic(me, mask);
 }
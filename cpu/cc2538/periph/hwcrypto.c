@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cc2538
+ * @ingroup     drivers_periph_hwcrypto
+ * @{
+ *
+ * @file
+ * @brief       Low-level crypto driver implementation for the AES engine
+ *
+ * The key is loaded into the key store of the engine once, and kept there
+ * while it does not change. The data is moved by the DMA controller of the
+ * engine, channel 0 feeding the input and channel 1 taking the output.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "vendor/hw_aes.h"
+
+#include "cpu.h"
+#include "mutex.h"
+#include "periph/hwcrypto.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define REG(addr)           (*(volatile uint32_t *)(addr))
+
+/* the key store area used */
+#define KEY_AREA            (0U)
+
+/* clock gating bit of the AES engine in the SYS_CTRL_xCGCSEC registers */
+#define SYS_CTRL_SEC_AES    (1U << 1)
+
+#define INT_DONE            (AES_CTRL_INT_STAT_RESULT_AV | \
+                             AES_CTRL_INT_STAT_DMA_IN_DONE)
+#define INT_ERR             (AES_CTRL_INT_STAT_DMA_BUS_ERR | \
+                             AES_CTRL_INT_STAT_KEY_ST_WR_ERR | \
+                             AES_CTRL_INT_STAT_KEY_ST_RD_ERR)
+
+static mutex_t _lock = MUTEX_INIT;
+/* copy of the key in the key store, the DMA reads it from RAM */
+static uint32_t _key[HWCRYPTO_AES128_KEY_SIZE / sizeof(uint32_t)];
+static bool _key_loaded;
+
+static int _wait(void)
+{
+    uint32_t stat;
+
+    do {
+        stat = REG(AES_CTRL_INT_STAT);
+    } while (!(stat & (AES_CTRL_INT_STAT_RESULT_AV | INT_ERR)));
+    REG(AES_CTRL_INT_CLR) = INT_DONE | INT_ERR;
+    if (stat & INT_ERR) {
+        DEBUG("hwcrypto: error 0x%08lx\n", (unsigned long)stat);
+        return -EIO;
+    }
+    return 0;
+}
+
+static int _load_key(const uint8_t *key)
+{
+    if (_key_loaded && (memcmp(_key, key, sizeof(_key)) == 0)) {
+        return 0;
+    }
+    memcpy(_key, key, sizeof(_key));
+    _key_loaded = false;
+
+    REG(AES_CTRL_ALG_SEL) = AES_CTRL_ALG_SEL_KEYSTORE;
+    REG(AES_CTRL_INT_CLR) = INT_DONE | INT_ERR;
+    /* 128 bit keys, this invalidates all areas */
+    REG(AES_KEY_STORE_SIZE) = (REG(AES_KEY_STORE_SIZE) &
+                               ~AES_KEY_STORE_SIZE_KEY_SIZE_M) | 1;
+    REG(AES_KEY_STORE_WRITE_AREA) = 1U << KEY_AREA;
+
+    REG(AES_DMAC_CH0_CTRL) = AES_DMAC_CH0_CTRL_EN;
+    REG(AES_DMAC_CH0_EXTADDR) = (uintptr_t)_key;
+    REG(AES_DMAC_CH0_DMALENGTH) = sizeof(_key);
+
+    int res = _wait();
+    REG(AES_CTRL_ALG_SEL) = 0;
+    if ((res < 0) ||
+        !(REG(AES_KEY_STORE_WRITTEN_AREA) & (1U << KEY_AREA))) {
+        return -EIO;
+    }
+    _key_loaded = true;
+    return 0;
+}
+
+static int _run(const uint8_t *key, uint32_t ctrl, const uint8_t *iv,
+                const uint8_t *in, uint8_t *out, size_t len)
+{
+    int res;
+
+    if (len % HWCRYPTO_AES_BLOCK_SIZE) {
+        return -EINVAL;
+    }
+    if (len == 0) {
+        return 0;
+    }
+
+    mutex_lock(&_lock);
+    res = _load_key(key);
+    if (res < 0) {
+        goto out;
+    }
+
+    REG(AES_CTRL_ALG_SEL) = AES_CTRL_ALG_SEL_AES;
+    REG(AES_CTRL_INT_CLR) = INT_DONE | INT_ERR;
+    REG(AES_KEY_STORE_READ_AREA) = KEY_AREA;
+    while (REG(AES_KEY_STORE_READ_AREA) & AES_KEY_STORE_READ_AREA_BUSY) {}
+    if (REG(AES_CTRL_INT_STAT) & AES_CTRL_INT_STAT_KEY_ST_RD_ERR) {
+        REG(AES_CTRL_INT_CLR) = INT_ERR;
+        _key_loaded = false;
+        res = -EIO;
+        goto out_alg;
+    }
+
+    if (iv != NULL) {
+        uint32_t words[HWCRYPTO_AES_BLOCK_SIZE / sizeof(uint32_t)];
+
+        memcpy(words, iv, sizeof(words));
+        REG(AES_AES_IV_0) = words[0];
+        REG(AES_AES_IV_1) = words[1];
+        REG(AES_AES_IV_2) = words[2];
+        REG(AES_AES_IV_3) = words[3];
+    }
+    REG(AES_AES_CTRL) = ctrl;
+    REG(AES_AES_C_LENGTH_0) = len;
+    REG(AES_AES_C_LENGTH_1) = 0;
+
+    REG(AES_DMAC_CH0_CTRL) = AES_DMAC_CH0_CTRL_EN;
+    REG(AES_DMAC_CH0_EXTADDR) = (uintptr_t)in;
+    REG(AES_DMAC_CH0_DMALENGTH) = len;
+    REG(AES_DMAC_CH1_CTRL) = AES_DMAC_CH1_CTRL_EN;
+    REG(AES_DMAC_CH1_EXTADDR) = (uintptr_t)out;
+    REG(AES_DMAC_CH1_DMALENGTH) = len;
+
+    res = _wait();
+    REG(AES_AES_CTRL) = 0;
+
+out_alg:
+    REG(AES_CTRL_ALG_SEL) = 0;
+out:
+    mutex_unlock(&_lock);
+    return res;
+}
+
+void hwcrypto_init(void)
+{
+    SYS_CTRL_RCGCSEC |= SYS_CTRL_SEC_AES;
+    SYS_CTRL_SCGCSEC |= SYS_CTRL_SEC_AES;
+    SYS_CTRL_DCGCSEC |= SYS_CTRL_SEC_AES;
+
+    /* the interrupt is not used, but its status is polled */
+    REG(AES_CTRL_INT_CFG) = AES_CTRL_INT_CFG_LEVEL;
+    REG(AES_CTRL_INT_EN) = AES_CTRL_INT_EN_RESULT_AV |
+                           AES_CTRL_INT_EN_DMA_IN_DONE;
+}
+
+int hwcrypto_aes128_ecb(const uint8_t *key, bool encrypt, const uint8_t *in,
+                        uint8_t *out, size_t len)
+{
+    return _run(key, encrypt ? AES_AES_CTRL_direction : 0, NULL, in, out, len);
+}
+
+int hwcrypto_aes128_cbc(const uint8_t *key, bool encrypt,
+                        const uint8_t iv[HWCRYPTO_AES_BLOCK_SIZE],
+                        const uint8_t *in, uint8_t *out, size_t len)
+{
+    uint32_t ctrl = AES_AES_CTRL_CBC;
+
+    if (encrypt) {
+        ctrl |= AES_AES_CTRL_direction;
+    }
+    return _run(key, ctrl, iv, in, out, len);
+}
+
+int hwcrypto_aes128_ctr(const uint8_t *key,
+                        const uint8_t ctr[HWCRYPTO_AES_BLOCK_SIZE],
+                        uint8_t ctr_len, const uint8_t *in, uint8_t *out,
+                        size_t len)
+{
+    /* the counter is 32, 64, 96 or 128 bit wide */
+    if ((ctr_len == 0) || (ctr_len % 4) ||
+        (ctr_len > HWCRYPTO_AES_BLOCK_SIZE)) {
+        return -ENOTSUP;
+    }
+    uint32_t ctrl = AES_AES_CTRL_CTR | AES_AES_CTRL_direction |
+                    (((ctr_len / 4U) - 1) << AES_AES_CTRL_ctr_width_S);
+
+    return _run(key, ctrl, ctr, in, out, len);
+}
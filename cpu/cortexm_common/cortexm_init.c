@@ -58,9 +58,20 @@ CORTEXM_STATIC_INLINE void cortexm_init_misc(void)
 #endif
 }
 
+static inline void cortexm_init_cache(void)
+{
+#if defined(__ICACHE_PRESENT) && (__ICACHE_PRESENT == 1U) && CORTEXM_ICACHE_ENABLE
+    SCB_EnableICache();
+#endif
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U) && CORTEXM_DCACHE_ENABLE
+    SCB_EnableDCache();
+#endif
+}
+
 void cortexm_init(void)
 {
     cortexm_init_fpu();
+    cortexm_init_cache();
 
     /* configure the vector table location to internal flash */
 #if defined(CPU_ARCH_CORTEX_M3) || defined(CPU_ARCH_CORTEX_M4) || \
@@ -30,6 +30,7 @@
 #ifndef CPU_H
 #define CPU_H
 
+#include <stdint.h>
 #include <stdio.h>
 
 #include "irq.h"
@@ -102,6 +103,12 @@ static inline void cortexm_init_fpu(void)
 #if defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
     /* give full access to the FPU */
     SCB->CPACR |= (uint32_t)CORTEXM_SCB_CPACR_FPU_ACCESS_FULL;
+    /* enable automatic and lazy stacking of the FPU registers, so only
+     * threads using the FPU pay for saving its context (reset default, but
+     * a bootloader may have changed it) */
+#if defined(__FPU_PRESENT) && (__FPU_PRESENT == 1U)
+    FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;
+#endif
 #endif
 }
 
@@ -189,6 +196,63 @@ static inline void cortexm_isr_end(void)
     }
 }
 
+/**
+ * @brief   Size of a line of the data cache in bytes
+ */
+#define CORTEXM_DCACHE_LINE_SIZE    (32U)
+
+/**
+ * @brief   Writes cached data of a memory area back, so that a DMA transfer
+ *          reads what the CPU wrote
+ *
+ * Also call it before a DMA transfer writes to the area, so that no dirty
+ * line gets evicted over the transferred data. Does nothing on CPUs without
+ * data cache.
+ *
+ * @param[in] addr  start of the area
+ * @param[in] len   size of the area in bytes
+ */
+static inline void cortexm_dcache_clean(const void *addr, size_t len)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    if (SCB->CCR & SCB_CCR_DC_Msk) {
+        uintptr_t start = (uintptr_t)addr & ~(CORTEXM_DCACHE_LINE_SIZE - 1);
+
+        SCB_CleanDCache_by_Addr((uint32_t *)start,
+                                (int32_t)((uintptr_t)addr + len - start));
+    }
+#else
+    (void)addr;
+    (void)len;
+#endif
+}
+
+/**
+ * @brief   Drops cached data of a memory area, so that the CPU reads what a
+ *          DMA transfer wrote
+ *
+ * Lines are invalidated as a whole, so the CPU must not write to data that
+ * shares a cache line with the area while the transfer runs. Does nothing on
+ * CPUs without data cache.
+ *
+ * @param[in] addr  start of the area
+ * @param[in] len   size of the area in bytes
+ */
+static inline void cortexm_dcache_invalidate(void *addr, size_t len)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    if (SCB->CCR & SCB_CCR_DC_Msk) {
+        uintptr_t start = (uintptr_t)addr & ~(CORTEXM_DCACHE_LINE_SIZE - 1);
+
+        SCB_InvalidateDCache_by_Addr((uint32_t *)start,
+                                     (int32_t)((uintptr_t)addr + len - start));
+    }
+#else
+    (void)addr;
+    (void)len;
+#endif
+}
+
 #ifdef __cplusplus
 }
 #endif
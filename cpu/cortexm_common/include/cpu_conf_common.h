@@ -23,6 +23,20 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Additional stack space needed by threads using the FPU
+ *
+ * With an FPU ABI selected, an exception taken by a thread with FPU context
+ * stacks the extended frame (S0-S15, FPSCR and a reserved word: 72 bytes)
+ * and the context switch saves S16-S31 (64 bytes) on top.
+ */
+#if (defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)) && \
+    defined(__ARM_FP)
+#define THREAD_EXTRA_STACKSIZE_FPU      (136)
+#else
+#define THREAD_EXTRA_STACKSIZE_FPU      (0)
+#endif
+
 /**
  * @brief    Configuration of default stack sizes
  *
@@ -33,7 +47,6 @@ extern "C" {
  * If needed, you can overwrite these values the the `cpu_conf.h` file of the
  * specific CPU implementation.
  *
- * @todo Adjust values for Cortex-M4F with FPU?
  * @todo Configure second set if no newlib nano.specs are available?
  * @{
  */
@@ -41,7 +54,7 @@ extern "C" {
 #define THREAD_EXTRA_STACKSIZE_PRINTF   (512)
 #endif
 #ifndef THREAD_STACKSIZE_DEFAULT
-#define THREAD_STACKSIZE_DEFAULT        (1024)
+#define THREAD_STACKSIZE_DEFAULT        (1024 + THREAD_EXTRA_STACKSIZE_FPU)
 #endif
 #ifndef THREAD_STACKSIZE_IDLE
 #define THREAD_STACKSIZE_IDLE           (256)
@@ -53,7 +66,7 @@ extern "C" {
  * @{
  */
 #ifndef ISR_STACKSIZE
-#define ISR_STACKSIZE                   (512U)
+#define ISR_STACKSIZE                   (512U + THREAD_EXTRA_STACKSIZE_FPU)
 #endif
 /** @} */
 
@@ -68,6 +81,21 @@ extern "C" {
 #endif
 /** @} */
 
+/**
+ * @brief   Enable the instruction and data caches of CPUs that have them
+ *
+ * DMA transfers of the periph drivers maintain the data cache, other bus
+ * masters have to use cortexm_dcache_clean() and cortexm_dcache_invalidate().
+ * @{
+ */
+#ifndef CORTEXM_ICACHE_ENABLE
+#define CORTEXM_ICACHE_ENABLE           (1)
+#endif
+#ifndef CORTEXM_DCACHE_ENABLE
+#define CORTEXM_DCACHE_ENABLE           (1)
+#endif
+/** @} */
+
 /**
  * @brief   Attribute for memory sections required by SRAM PUF
  */
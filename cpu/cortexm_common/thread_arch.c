@@ -82,7 +82,24 @@
  * | RET  | <- exception return code
  * -------- lowest address (top of stack)
  *
- * TODO: Implement handling of FPU registers for Cortex-M4 CPUs
+ * On Cortex-M4F and Cortex-M7 the FPU context is switched lazily: only threads
+ * that used the FPU have CONTROL.FPCA set, so the hardware stacks an extended
+ * frame (S0-S15 and FPSCR, lazily reserved) for them and clears bit 4 of the
+ * exception return code. Only for those threads S16-S31 are saved on top of
+ * the hardware frame, all others use the layout above. Threads using the FPU
+ * thus need 136 byte more stack.
+ *
+ * ------------- highest address (bottom of stack)
+ * | FPSCR, S15 - S0 | <- extended part of the hardware frame
+ * -------------
+ * | xPSR - R0 | <- same as for Cortex-M3/4
+ * -------------
+ * | S31 - S16 |
+ * -------------
+ * | R11 - R4  |
+ * -------------
+ * | RET  | <- exception return code, bit 4 cleared
+ * -------- lowest address (top of stack)
  *
  *
  * @author      Stefan Pfeiffer <stefan.pfeiffer@fu-berlin.de>
@@ -123,6 +140,15 @@ extern uint32_t _sstack;
  */
 #define EXCEPT_RET_TASK_MODE        (0xfffffffd)
 
+/**
+ * @brief   The FPU registers are part of the thread context, if the compiler
+ *          makes use of the FPU (i.e. hard or softfp float ABI)
+ */
+#if (defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)) && \
+    defined(__ARM_FP)
+#define CORTEXM_SWITCH_FPU_CONTEXT
+#endif
+
 char *thread_stack_init(thread_task_func_t task_func,
                              void *arg,
                              void *stack_start,
@@ -148,21 +174,8 @@ char *thread_stack_init(thread_task_func_t task_func,
         *stk = ~((uint32_t)STACK_MARKER);
     }
 
-#if defined(CPU_ARCH_CORTEX_M4F) || (CPU_ARCH_CORTEX_M7)
-    /* TODO: fix FPU handling for Cortex-M4f */
-    /*
-    stk--;
-    *stk = (unsigned int) 0;
-    */
-
-    /* S0 - S15 */
-    /*
-    for (int i = 15; i >= 0; i--) {
-        stk--;
-        *stk = i;
-    }
-    */
-#endif
+    /* no FPU registers: new threads start without FPU context, their first
+     * floating point instruction sets CONTROL.FPCA */
 
     /* ****************************** */
     /* Automatically popped registers */
@@ -280,6 +293,14 @@ void *thread_isr_stack_start(void)
 __attribute__((naked)) void NORETURN cpu_switch_context_exit(void)
 {
     __asm__ volatile (
+#ifdef CORTEXM_SWITCH_FPU_CONTEXT
+    /* drop the FPU context, so no lazy state is left on the stack of the
+     * exiting thread */
+    "mrs    r0, control               \n"
+    "bic    r0, r0, #4                \n" /* clear CONTROL.FPCA */
+    "msr    control, r0               \n"
+    "isb                              \n"
+#endif
     "bl     irq_enable               \n" /* enable IRQs to make the SVC
                                            * interrupt is reachable */
     "svc    #1                            \n" /* trigger the SVC interrupt */
@@ -295,7 +316,7 @@ void thread_yield_higher(void)
     SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
 }
 
-void __attribute__((naked)) __attribute__((used)) isr_pendsv(void) {
+void CORE_FASTCODE __attribute__((naked)) __attribute__((used)) isr_pendsv(void) {
     __asm__ volatile (
     /* PendSV handler entry point */
     /* save context by pushing unsaved registers to the stack */
@@ -317,11 +338,13 @@ void __attribute__((naked)) __attribute__((used)) isr_pendsv(void) {
     "mov    r0, sp                    \n" /* switch back to the exception SP */
     "mov    sp, r12                   \n"
 #else
+#ifdef CORTEXM_SWITCH_FPU_CONTEXT
+    "tst    lr, #0x10                 \n" /* bit 4 cleared: thread used FPU */
+    "it     eq                        \n"
+    "vstmdbeq r0!, {s16-s31}          \n" /* save FPU registers */
+#endif
     "stmdb  r0!,{r4-r11}              \n" /* save regs */
     "stmdb  r0!,{lr}                  \n" /* exception return value */
-#if defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
-/*  "vstmdb sp!, {s16-s31}            \n" */ /* TODO save FPU registers */
-#endif
 #endif
     "ldr    r1, =sched_active_thread  \n" /* load address of current tcb */
     "ldr    r1, [r1]                  \n" /* dereference pdc */
@@ -364,10 +387,12 @@ void __attribute__((naked)) __attribute__((used)) isr_svc(void) {
     "ldr    r0, [r0]                  \n" /* dereference TCB */
     "ldr    r1, [r0]                  \n" /* load tcb->sp to register 1 */
     "ldmia  r1!, {r0}                 \n" /* restore exception return value */
-#if defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
-/*  "pop    {s16-s31}                 \n" */ /* TODO load FPU registers */
-#endif
     "ldmia  r1!, {r4-r11}             \n" /* restore other registers */
+#ifdef CORTEXM_SWITCH_FPU_CONTEXT
+    "tst    r0, #0x10                 \n" /* bit 4 cleared: thread used FPU */
+    "it     eq                        \n"
+    "vldmiaeq r1!, {s16-s31}          \n" /* restore FPU registers */
+#endif
     "msr    psp, r1                   \n" /* restore user mode SP to PSP reg */
     "bx     r0                        \n" /* load exception return value to PC,
                                            * causes end of exception*/
@@ -46,8 +46,17 @@
 extern uint32_t _sfixed;
 extern uint32_t _efixed;
 extern uint32_t _etext;
+extern uint32_t _lrelocate;
 extern uint32_t _srelocate;
 extern uint32_t _erelocate;
+extern uint32_t _lfastcode;
+extern uint32_t _sfastcode;
+extern uint32_t _efastcode;
+extern uint32_t _lfastdata;
+extern uint32_t _sfastdata;
+extern uint32_t _efastdata;
+extern uint32_t _sfastbss;
+extern uint32_t _efastbss;
 extern uint32_t _szero;
 extern uint32_t _ezero;
 extern uint32_t _sstack;
@@ -78,7 +87,7 @@ __attribute__((weak)) void post_startup (void)
 void reset_handler_default(void)
 {
     uint32_t *dst;
-    uint32_t *src = &_etext;
+    uint32_t *src;
 
 #ifdef MODULE_PUF_SRAM
     puf_sram_init((uint8_t *)&_srelocate, SEED_RAM_LEN);
@@ -98,6 +107,7 @@ void reset_handler_default(void)
 #endif
 
     /* load data section from flash to ram */
+    src = &_lrelocate;
     for (dst = &_srelocate; dst < &_erelocate; ) {
         *(dst++) = *(src++);
     }
@@ -105,6 +115,18 @@ void reset_handler_default(void)
     for (dst = &_szero; dst < &_ezero; ) {
         *(dst++) = 0;
     }
+    /* load FASTCODE and FASTDATA into the fast memory, zero FASTBSS */
+    src = &_lfastcode;
+    for (dst = &_sfastcode; dst < &_efastcode; ) {
+        *(dst++) = *(src++);
+    }
+    src = &_lfastdata;
+    for (dst = &_sfastdata; dst < &_efastdata; ) {
+        *(dst++) = *(src++);
+    }
+    for (dst = &_sfastbss; dst < &_efastbss; ) {
+        *(dst++) = 0;
+    }
 
 #ifdef MODULE_MPU_STACK_GUARD
     if (((uintptr_t)&_sstack) != SRAM_BASE) {
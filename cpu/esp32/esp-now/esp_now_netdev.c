@@ -107,6 +107,13 @@ static bool _esp_now_add_peer (uint8_t* bssid, uint8_t channel, uint8_t* key)
     }
 
     esp_err_t ret = esp_now_add_peer(&peer);
+    if (ret == ESP_OK) {
+        /* cache the size of the peer table for sending to all peers */
+        _esp_now_dev.peers_all++;
+        if (peer.encrypt) {
+            _esp_now_dev.peers_enc++;
+        }
+    }
     DEBUG("esp_now_add_peer node %02x:%02x:%02x:%02x:%02x:%02x "
           "added with return value %d\n",
           bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5], ret);
@@ -154,9 +161,9 @@ static void IRAM_ATTR esp_now_scan_peers_done (void)
         /* iterate over APs records */
         for (uint16_t i = 0; i < ap_num; i++) {
 
-            /* check whether the AP is an ESP_NOW node which is not already a peer */
-            if (strncmp((char*)aps[i].ssid, ESP_NOW_AP_PREFIX, ESP_NOW_AP_PREFIX_LEN) == 0 &&
-                !esp_now_is_peer_exist(aps[i].bssid)) {
+            /* check whether the AP is an ESP_NOW node, nodes that are
+             * already peers are skipped by _esp_now_add_peer */
+            if (strncmp((char*)aps[i].ssid, ESP_NOW_AP_PREFIX, ESP_NOW_AP_PREFIX_LEN) == 0) {
                 /* add the AP as peer */
                 _esp_now_add_peer(aps[i].bssid, aps[i].primary, esp_now_params.key);
             }
@@ -264,7 +271,10 @@ static IRAM_ATTR void esp_now_recv_cb (const uint8_t *mac, const uint8_t *data,
     critical_exit();
 }
 
-static int _esp_now_sending = 0;
+/* number of send callbacks that are still expected */
+static volatile unsigned _esp_now_pending = 0;
+static volatile bool _esp_now_tx_waiting = false;
+static mutex_t _esp_now_tx_wait = MUTEX_INIT_LOCKED;
 
 static void IRAM_ATTR esp_now_send_cb (const uint8_t *mac, esp_now_send_status_t status)
 {
@@ -272,9 +282,41 @@ static void IRAM_ATTR esp_now_send_cb (const uint8_t *mac, esp_now_send_status_t
           __func__,
           mac[0], mac[1], mac[2], mac[3], mac[4], mac[5], status);
 
-    if (_esp_now_sending) {
-        _esp_now_sending--;
+    critical_enter();
+    if (_esp_now_pending) {
+        _esp_now_pending--;
     }
+    if (_esp_now_tx_waiting) {
+        _esp_now_tx_waiting = false;
+        mutex_unlock(&_esp_now_tx_wait);
+    }
+    critical_exit();
+}
+
+/* waits until there is room for sending a frame that is confirmed by n send
+ * callbacks, a frame is always sent when nothing is pending */
+static void _esp_now_tx_reserve(unsigned n)
+{
+    while (1) {
+        critical_enter();
+        if ((_esp_now_pending == 0) ||
+            ((_esp_now_pending + n) <= ESP_NOW_TX_PENDING_MAX)) {
+            _esp_now_pending += n;
+            critical_exit();
+            return;
+        }
+        _esp_now_tx_waiting = true;
+        critical_exit();
+        /* returns immediately if the callback came in meanwhile */
+        mutex_lock(&_esp_now_tx_wait);
+    }
+}
+
+static void _esp_now_tx_release(unsigned n)
+{
+    critical_enter();
+    _esp_now_pending = (_esp_now_pending > n) ? (_esp_now_pending - n) : 0;
+    critical_exit();
 }
 
 /*
@@ -518,7 +560,7 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
     /* esp_hexdump (dev->tx_buf, dev->tx_len, 'b', 16); */
     #endif
 
-    _esp_now_sending = 1;
+    unsigned _esp_now_sending = 1;
 
     uint8_t* _esp_now_dst = 0;
 
@@ -584,7 +626,6 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
     uint8_t  _esp_now_dst_from_iid[6];
 
     _esp_now_dst = (uint8_t*)_esp_now_mac;
-    _esp_now_sending = 1;
 
     if (ipv6_hdr->dst.u8[0] == 0xff) {
         /* packets to multicast prefix ff::/8 are sent to all peers */
@@ -637,12 +678,12 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
               _esp_now_dst[3], _esp_now_dst[4], _esp_now_dst[5]);
     }
 
+    /* ESP-NOW copies the frame, so the next one can be sent without waiting
+     * for the confirmation as long as not too many are pending */
+    _esp_now_tx_reserve(_esp_now_sending);
+
     /* send the the packet to the peer(s) mac address */
     if (esp_now_send (_esp_now_dst, dev->tx_buf, dev->tx_len) == 0) {
-        while (_esp_now_sending > 0) {
-            thread_yield_higher();
-        }
-
         #ifdef MODULE_NETSTATS_L2
         netdev->stats.tx_bytes += dev->tx_len;
         netdev->event_callback(netdev, NETDEV_EVENT_TX_COMPLETE);
@@ -652,6 +693,7 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
         return dev->tx_len;
     }
     else {
+        _esp_now_tx_release(_esp_now_sending);
         #ifdef MODULE_NETSTATS_L2
         netdev->stats.tx_failed++;
         #endif
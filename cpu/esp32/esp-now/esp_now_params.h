@@ -40,6 +40,14 @@
 #define ESP_NOW_SCAN_PERIOD     (10000000UL)
 #endif
 
+#ifndef ESP_NOW_TX_PENDING_MAX
+/**
+ * Maximum number of frames that are sent but not confirmed by the send
+ * callback yet, a frame to all peers counts once per peer
+ */
+#define ESP_NOW_TX_PENDING_MAX  (8)
+#endif
+
 #ifndef ESP_NOW_SOFT_AP_PASS
 /** Passphrase (max. 64 chars) used for the SoftAP interface of the nodes */
 #define ESP_NOW_SOFT_AP_PASS    "ThisistheRIOTporttoESP"
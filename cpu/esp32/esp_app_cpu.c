@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp32
+ * @{
+ *
+ * @file
+ * @brief       Offloading of jobs to the APP CPU
+ *
+ * The job handed over to the APP CPU is written by the PRO CPU only while
+ * the APP CPU is idle and cleared by the APP CPU only when it is done, so
+ * there is one writer at a time and no lock is needed. Volatile accesses are
+ * serialized with `memw` by the compiler.
+ *
+ * @}
+ */
+
+#ifdef MODULE_ESP_APP_CPU
+
+#include "esp_common.h"
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include "esp_app_cpu.h"
+#include "esp_attr.h"
+#include "irq.h"
+#include "irq_arch.h"
+#include "kernel_defines.h"
+#include "mutex.h"
+
+#include "rom/cache.h"
+#include "rom/ets_sys.h"
+#include "soc/cpu.h"
+#include "soc/dport_reg.h"
+#include "soc/dport_access.h"
+#include "xtensa/xtensa_api.h"
+
+/* job running on the APP CPU, shared by both CPUs */
+static esp_app_cpu_job_t * volatile _job;
+static volatile bool _started;
+
+/* the following are only used by the PRO CPU */
+static esp_app_cpu_job_t *_running;
+static esp_app_cpu_job_t *_pending;
+
+static NORETURN void IRAM_ATTR _app_cpu_loop(void)
+{
+    while (1) {
+        esp_app_cpu_job_t *job = _job;
+
+        if (job == NULL) {
+            continue;
+        }
+        job->func(job->arg);
+        _job = NULL;
+        /* tell the PRO CPU */
+        DPORT_WRITE_PERI_REG(DPORT_CPU_INTR_FROM_CPU_1_REG,
+                             DPORT_CPU_INTR_FROM_CPU_1);
+    }
+}
+
+static void IRAM_ATTR _call_start_cpu1(void)
+{
+    extern uint8_t _init_start;
+
+    /* use the exception vectors in IRAM */
+    asm volatile ("wsr %0, vecbase\n" ::"r"(&_init_start));
+    ets_set_appcpu_boot_addr(0);
+    cpu_configure_region_protection();
+
+    _started = true;
+    _app_cpu_loop();
+}
+
+/* must be called with interrupts disabled */
+static void _start_next(void)
+{
+    _running = _pending;
+    if (_running) {
+        _pending = _running->next;
+        _job = _running;
+    }
+}
+
+static void IRAM_ATTR _done_isr(void *arg)
+{
+    esp_app_cpu_job_t *job = _running;
+
+    (void)arg;
+    DPORT_WRITE_PERI_REG(DPORT_CPU_INTR_FROM_CPU_1_REG, 0);
+
+    /* spurious interrupt */
+    if ((job == NULL) || (_job != NULL)) {
+        return;
+    }
+    _start_next();
+    if (job->done) {
+        job->done(job);
+    }
+}
+
+void esp_app_cpu_init(void)
+{
+    /* signal of finished jobs */
+    intr_matrix_set(PRO_CPU_NUM, ETS_FROM_CPU_INTR1_SOURCE, CPU_INUM_APP_CPU);
+    xt_set_interrupt_handler(CPU_INUM_APP_CPU, _done_isr, NULL);
+    xt_ints_on(BIT(CPU_INUM_APP_CPU));
+
+    /* the bootloader configured the flash MMU of both CPUs */
+    Cache_Flush(1);
+    Cache_Read_Enable(1);
+    esp_cpu_unstall(1);
+
+    /* enable the clock and reset the APP CPU */
+    DPORT_SET_PERI_REG_MASK(DPORT_APPCPU_CTRL_B_REG, DPORT_APPCPU_CLKGATE_EN);
+    DPORT_CLEAR_PERI_REG_MASK(DPORT_APPCPU_CTRL_C_REG, DPORT_APPCPU_RUNSTALL);
+    DPORT_SET_PERI_REG_MASK(DPORT_APPCPU_CTRL_A_REG, DPORT_APPCPU_RESETTING);
+    DPORT_CLEAR_PERI_REG_MASK(DPORT_APPCPU_CTRL_A_REG, DPORT_APPCPU_RESETTING);
+    ets_set_appcpu_boot_addr((uint32_t)_call_start_cpu1);
+
+    while (!_started) {
+        ets_delay_us(100);
+    }
+    ets_printf("Started APP cpu for jobs\n");
+}
+
+void esp_app_cpu_post(esp_app_cpu_job_t *job)
+{
+    esp_app_cpu_job_t **pos = &_pending;
+    unsigned state = irq_disable();
+
+    assert(job && job->func);
+    job->next = NULL;
+    while (*pos) {
+        pos = &(*pos)->next;
+    }
+    *pos = job;
+    if (_running == NULL) {
+        _start_next();
+    }
+    irq_restore(state);
+}
+
+typedef struct {
+    esp_app_cpu_job_t job;      /* must be the first member */
+    mutex_t done;
+    void (*func)(void *arg);
+    void *arg;
+} _run_t;
+
+static void _run_done(esp_app_cpu_job_t *job)
+{
+    mutex_unlock(&((_run_t *)job)->done);
+}
+
+static void IRAM_ATTR _run_func(void *arg)
+{
+    _run_t *run = arg;
+
+    run->func(run->arg);
+}
+
+void esp_app_cpu_run(void (*func)(void *arg), void *arg)
+{
+    _run_t run = {
+        .job = { .func = _run_func, .done = _run_done },
+        .done = MUTEX_INIT_LOCKED,
+        .func = func,
+        .arg = arg,
+    };
+
+    run.job.arg = &run;
+    esp_app_cpu_post(&run.job);
+    mutex_lock(&run.done);
+}
+
+#endif /* MODULE_ESP_APP_CPU */
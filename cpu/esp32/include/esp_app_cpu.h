@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_esp32
+ * @{
+ *
+ * @file
+ * @brief       Offloading of jobs to the APP CPU
+ *
+ * RIOT runs on the PRO CPU only. With the `esp_app_cpu` module the APP CPU
+ * runs jobs handed over by RIOT threads one after the other (AMP), e.g.
+ * the number crunching of a TLS handshake, while the PRO CPU keeps serving
+ * the network stack.
+ *
+ * Jobs run outside of RIOT: they must not call any kernel function (no
+ * mutexes, messages, xtimer, malloc or stdio) and must only touch memory
+ * that the thread which posted the job does not use until the job is done.
+ * They run on the small stack the ROM sets up for the APP CPU and the APP
+ * CPU busy waits while there is no job.
+ *
+ * Flash must not be written while a job runs, since only the cache of the
+ * PRO CPU is disabled meanwhile. Functions of jobs that run while the flash
+ * may be written have to be placed in IRAM with `IRAM_ATTR`.
+ */
+
+#ifndef ESP_APP_CPU_H
+#define ESP_APP_CPU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Forward declaration of a job
+ */
+typedef struct esp_app_cpu_job esp_app_cpu_job_t;
+
+/**
+ * @brief   A job for the APP CPU
+ */
+struct esp_app_cpu_job {
+    esp_app_cpu_job_t *next;            /**< next pending job, internal */
+    void (*func)(void *arg);            /**< the job, runs on the APP CPU */
+    void *arg;                          /**< argument of esp_app_cpu_job_t::func */
+    /**
+     * @brief   Called on the PRO CPU in interrupt context when the job is
+     *          done, may be NULL
+     */
+    void (*done)(esp_app_cpu_job_t *job);
+};
+
+/**
+ * @brief   Starts the APP CPU
+ *
+ * Called by the startup code.
+ */
+void esp_app_cpu_init(void);
+
+/**
+ * @brief   Queues a job for the APP CPU
+ *
+ * @pre     @p job is not queued yet
+ *
+ * @param[in] job   the job, must stay valid until esp_app_cpu_job_t::done
+ *                  was called
+ */
+void esp_app_cpu_post(esp_app_cpu_job_t *job);
+
+/**
+ * @brief   Runs a function on the APP CPU and waits for it
+ *
+ * The calling thread sleeps in the meantime, so other threads run on the
+ * PRO CPU.
+ *
+ * @pre     not called from interrupt context
+ *
+ * @param[in] func  the function, with the restrictions of a job
+ * @param[in] arg   argument of @p func
+ */
+void esp_app_cpu_run(void (*func)(void *arg), void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESP_APP_CPU_H */
+/** @} */
@@ -42,6 +42,7 @@ extern volatile uint32_t irq_interrupt_nesting;
   */
 #define CPU_INUM_GPIO       2   /* level interrupt, low priority = 1 */
 #define CPU_INUM_CAN        3   /* level interrupt, low priority = 1 */
+#define CPU_INUM_APP_CPU    4   /* level interrupt, low priority = 1 */
 #define CPU_INUM_UART       5   /* level interrupt, low priority = 1 */
 #define CPU_INUM_RTC        9   /* level interrupt, low priority = 1 */
 #define CPU_INUM_I2C        12  /* level interrupt, low priority = 1 */
@@ -65,6 +65,10 @@
 #include "stdio_uart.h"
 #endif
 
+#ifdef MODULE_ESP_APP_CPU
+#include "esp_app_cpu.h"
+#endif
+
 #define MHZ 1000000UL
 #define STRINGIFY(s) STRINGIFY2(s)
 #define STRINGIFY2(s) #s
@@ -345,6 +349,11 @@ static NORETURN void IRAM system_init (void)
     xt_set_interrupt_handler(CPU_INUM_SOFTWARE, thread_yield_isr, NULL);
     xt_ints_on(BIT(CPU_INUM_SOFTWARE));
 
+    #ifdef MODULE_ESP_APP_CPU
+    /* start the APP CPU for jobs offloaded by threads */
+    esp_app_cpu_init();
+    #endif
+
     /* initialize ESP system event loop */
     extern void esp_event_handler_init(void);
     esp_event_handler_init();
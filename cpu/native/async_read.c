@@ -22,6 +22,9 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include "async_read.h"
 #include "native_internal.h"
@@ -36,6 +39,21 @@ static pid_t _sigio_child_pids[ASYNC_READ_NUMOF];
 static void _sigio_child(int fd);
 #endif
 
+#ifdef __linux__
+/* epoll instance watching all fds, so the ISR gets the ready ones only */
+static int _epfd = -1;
+
+static void _async_io_isr(void) {
+    struct epoll_event events[ASYNC_READ_NUMOF];
+
+    int n = epoll_wait(_epfd, events, ASYNC_READ_NUMOF, 0);
+
+    for (int i = 0; i < n; i++) {
+        int index = events[i].data.u32;
+        _native_async_read_callbacks[index](_fds[index], _args[index]);
+    }
+}
+#else
 static void _async_io_isr(void) {
     fd_set rfds;
 
@@ -61,8 +79,14 @@ static void _async_io_isr(void) {
         }
     }
 }
+#endif
 
 void native_async_read_setup(void) {
+#ifdef __linux__
+    if ((_epfd == -1) && ((_epfd = epoll_create1(EPOLL_CLOEXEC)) == -1)) {
+        err(EXIT_FAILURE, "native_async_read_setup(): epoll_create1()");
+    }
+#endif
     register_interrupt(SIGIO, _async_io_isr);
 }
 
@@ -75,6 +99,12 @@ void native_async_read_cleanup(void) {
 #endif
         real_close(_fds[i]);
     }
+#ifdef __linux__
+    if (_epfd != -1) {
+        real_close(_epfd);
+        _epfd = -1;
+    }
+#endif
 }
 
 void native_async_read_continue(int fd) {
@@ -102,6 +132,16 @@ void native_async_read_add_handler(int fd, void *arg, native_async_read_callback
      * * check http://sourceforge.net/p/tuntaposx/bugs/17/ */
     _sigio_child(_next_index);
 #else
+#ifdef __linux__
+    struct epoll_event event = {
+        .events = EPOLLIN,
+        .data.u32 = _next_index,
+    };
+
+    if (epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): epoll_ctl()");
+    }
+#endif
     /* configure fds to send signals on io */
     if (real_fcntl(fd, F_SETOWN, _native_pid) == -1) {
         err(EXIT_FAILURE, "native_async_read_add_handler(): fcntl(F_SETOWN)");
@@ -23,9 +23,14 @@
 #error "MODULE can_linux is only available on Linux"
 #else
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE     /* for recvmmsg() */
+#endif
+
 #include <string.h>
 #include <errno.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
 #include <net/if.h>
 
 #include <linux/can/raw.h>
@@ -176,6 +181,21 @@ static int _init(candev_t *candev)
         return -1;
     }
 
+    /* the number of frames dropped by the socket comes with every frame */
+    int enable = 1;
+    if (real_setsockopt(dev->sock, SOL_SOCKET, SO_RXQ_OVFL,
+                        &enable, sizeof(enable)) < 0) {
+        DEBUG("candev_linux: SO_RXQ_OVFL not supported\n");
+    }
+
+#ifdef CANDEV_LINUX_RCVBUF
+    int rcvbuf = CANDEV_LINUX_RCVBUF;
+    if (real_setsockopt(dev->sock, SOL_SOCKET, SO_RCVBUF,
+                        &rcvbuf, sizeof(rcvbuf)) < 0) {
+        real_printf("Error: setsockopt SO_RCVBUF failed\n");
+    }
+#endif
+
     strcpy(ifr.ifr_name, dev->conf->interface_name);
     ret = real_ioctl(dev->sock, SIOCGIFINDEX, &ifr);
 
@@ -221,48 +241,91 @@ static int _send(candev_t *candev, const struct can_frame *frame)
     return 0;
 }
 
-static void _isr(candev_t *candev)
+static void _rx_frame(candev_linux_t *dev, struct can_frame *rcv_frame)
 {
-    int nbytes;
-    struct can_frame rcv_frame;
-    candev_linux_t *dev = (candev_linux_t *)candev;
-
-    if (dev == NULL) {
-        return;
-    }
-
-    DEBUG("candev_native _isr: CAN SIGIO interrupt received, sock = %i\n", dev->sock);
-    nbytes = real_read(dev->sock, &rcv_frame, sizeof(struct can_frame));
-
-    if (nbytes < 0) {   /* SIGIO signal was probably due to an error with the socket */
-        DEBUG("candev_native _isr: read: error during read\n");
-        return;
-    }
-
-    if (nbytes < (int)sizeof(struct can_frame)) {
-        DEBUG("candev_native _isr: read: incomplete CAN frame\n");
-        return;
-    }
-
-    if (rcv_frame.can_id & CAN_ERR_FLAG) {
+    if (rcv_frame->can_id & CAN_ERR_FLAG) {
         DEBUG("candev_native _isr: error frame\n");
-        candev_event_t evt = _can_error_to_can_evt(rcv_frame);
+        candev_event_t evt = _can_error_to_can_evt(*rcv_frame);
         if ((evt != CANDEV_EVENT_NOEVENT) && (dev->candev.event_callback)) {
             dev->candev.event_callback(&dev->candev, evt, NULL);
         }
         return;
     }
 
-    if (rcv_frame.can_id & CAN_RTR_FLAG) {
+    if (rcv_frame->can_id & CAN_RTR_FLAG) {
         DEBUG("candev_native _isr: rtr frame\n");
         return;
     }
 
     if (dev->candev.event_callback) {
         DEBUG("candev_native _isr: calling event callback\n");
-        dev->candev.event_callback(&dev->candev, CANDEV_EVENT_RX_INDICATION, &rcv_frame);
+        dev->candev.event_callback(&dev->candev, CANDEV_EVENT_RX_INDICATION, rcv_frame);
     }
+}
 
+static void _rx_overflow(candev_linux_t *dev, struct msghdr *hdr)
+{
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(hdr); cmsg;
+         cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+        if ((cmsg->cmsg_level == SOL_SOCKET) &&
+            (cmsg->cmsg_type == SO_RXQ_OVFL)) {
+            uint32_t dropped;
+
+            memcpy(&dropped, CMSG_DATA(cmsg), sizeof(dropped));
+            if ((dropped != dev->rx_dropped) && dev->candev.event_callback) {
+                DEBUG("candev_native _isr: %u frames dropped\n",
+                      (unsigned)(dropped - dev->rx_dropped));
+                dev->candev.event_callback(&dev->candev, CANDEV_EVENT_RX_ERROR, NULL);
+            }
+            dev->rx_dropped = dropped;
+        }
+    }
+}
+
+static void _isr(candev_t *candev)
+{
+    struct can_frame frames[CANDEV_LINUX_RX_BATCH];
+    struct mmsghdr msgs[CANDEV_LINUX_RX_BATCH];
+    struct iovec iov[CANDEV_LINUX_RX_BATCH];
+    char ctrl[CANDEV_LINUX_RX_BATCH][CMSG_SPACE(sizeof(uint32_t))];
+    candev_linux_t *dev = (candev_linux_t *)candev;
+    int num;
+
+    if (dev == NULL) {
+        return;
+    }
+
+    DEBUG("candev_native _isr: CAN SIGIO interrupt received, sock = %i\n", dev->sock);
+
+    /* read all pending frames, a burst may come with a single SIGIO */
+    do {
+        memset(msgs, 0, sizeof(msgs));
+        for (unsigned i = 0; i < CANDEV_LINUX_RX_BATCH; i++) {
+            iov[i].iov_base = &frames[i];
+            iov[i].iov_len = sizeof(frames[i]);
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = ctrl[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(ctrl[i]);
+        }
+
+        num = real_recvmmsg(dev->sock, msgs, CANDEV_LINUX_RX_BATCH, MSG_DONTWAIT, NULL);
+        if (num < 0) {
+            /* SIGIO signal was probably due to an error with the socket,
+             * or there is nothing left to read */
+            DEBUG("candev_native _isr: read: error during read\n");
+            return;
+        }
+
+        for (int i = 0; i < num; i++) {
+            _rx_overflow(dev, &msgs[i].msg_hdr);
+            if (msgs[i].msg_len < sizeof(struct can_frame)) {
+                DEBUG("candev_native _isr: read: incomplete CAN frame\n");
+                continue;
+            }
+            _rx_frame(dev, &frames[i]);
+        }
+    } while (num == CANDEV_LINUX_RX_BATCH);
 }
 
 static int _set_bittiming(candev_linux_t *dev, struct can_bittiming *bittiming)
@@ -37,7 +37,9 @@ typedef void (*native_async_read_callback_t)(int fd, void *arg);
 /**
  * @brief   initialize asynchronus read system
  *
- * This registers SIGIO signal handler.
+ * This registers SIGIO signal handler. On Linux, the file descriptors are
+ * additionally watched by an epoll instance, so the handler only visits the
+ * ones that are ready to read.
  */
 void native_async_read_setup(void);
 
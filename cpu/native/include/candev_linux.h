@@ -68,6 +68,22 @@ typedef struct candev_linux_conf {
 #define CANDEV_LINUX_DEFAULT_SPT (875)
 #endif
 
+#ifndef CANDEV_LINUX_RX_BATCH
+/**
+ * Maximum number of frames read from the socket with a single system call
+ */
+#define CANDEV_LINUX_RX_BATCH (8)
+#endif
+
+#if defined(DOXYGEN)
+/**
+ * Size of the receive buffer of the socket in bytes, if defined. The default
+ * of the system may be too small to take bursts of frames, e.g. when
+ * replaying recorded traffic at full bus speed.
+ */
+#define CANDEV_LINUX_RCVBUF
+#endif
+
 /**
  * @brief The candev_linux struct
  */
@@ -75,6 +91,7 @@ typedef struct candev_linux {
     candev_t candev;                  /**< candev base structure */
     int sock;                         /**< local socket id */
     const candev_linux_conf_t *conf;  /**< device configuration */
+    uint32_t rx_dropped;              /**< frames dropped by the socket so far */
     /** filter list */
     struct can_filter filters[CANDEV_LINUX_MAX_FILTERS_RX];
 } candev_linux_t;
@@ -133,6 +133,11 @@ extern int (*real_fputc)(int c, FILE *stream);
 extern int (*real_fgetc)(FILE *stream);
 extern mode_t (*real_umask)(mode_t cmask);
 extern ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
+extern ssize_t (*real_readv)(int fildes, const struct iovec *iov, int iovcnt);
+/* void pointers instead of struct mmsghdr and struct timespec, which are not
+ * available everywhere */
+extern int (*real_recvmmsg)(int sockfd, void *msgvec, unsigned int vlen,
+                            int flags, void *timeout);
 
 #ifdef __MACH__
 #else
@@ -166,6 +171,7 @@ extern const char *_native_unix_socket_path;
 ssize_t _native_read(int fd, void *buf, size_t count);
 ssize_t _native_write(int fd, const void *buf, size_t count);
 ssize_t _native_writev(int fildes, const struct iovec *iov, int iovcnt);
+ssize_t _native_readv(int fildes, const struct iovec *iov, int iovcnt);
 
 /**
  * @endcond
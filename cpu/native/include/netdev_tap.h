@@ -24,6 +24,7 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "net/netdev.h"
 
@@ -35,6 +36,17 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Maximum number of frames received per signal
+ *
+ * All frames waiting on the tap interface are handed to the upper layer in
+ * one go, up to this number. Then the interface is rearmed, so that other
+ * threads are not starved by a busy interface.
+ */
+#ifndef NETDEV_TAP_RX_BATCH
+#define NETDEV_TAP_RX_BATCH     (32U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +56,7 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    bool rx_consumed;                   /**< a frame was taken from tap_fd */
 } netdev_tap_t;
 
 /**
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_shm_radio  Shared memory radio
+ * @ingroup     drivers_netdev
+ * @brief       IEEE 802.15.4 device of native instances sharing one medium
+ *              in memory
+ *
+ * All native instances started with the same `-r <file>` map that file and
+ * exchange their frames through it, without the UDP sockets and the hub of
+ * @ref drivers_socket_zep. Each instance claims one of the
+ * @ref SHM_RADIO_NODES slots of the medium. A slot holds a ring of
+ * @ref SHM_RADIO_RING_SIZE frames other instances write to lock-free, and
+ * the channel and addresses of its owner, so a sender only puts a frame
+ * into the rings of the instances it is meant for: all instances on the
+ * channel for broadcast frames, the addressed one otherwise. If a ring is
+ * full, the frame is lost for that receiver.
+ *
+ * A sender wakes up a receiver with a one byte datagram to its Unix socket
+ * `<file>.<slot>`, but only if the receiver drained its ring since the last
+ * one, so a burst of frames costs one wake-up.
+ *
+ * The medium has no topology, all instances hear each other. Slots of
+ * instances that exited are taken over by new ones.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Shared memory radio definitions
+ */
+#ifndef SHM_RADIO_H
+#define SHM_RADIO_H
+
+#include <stdbool.h>
+
+#include "net/netdev.h"
+#include "net/netdev/ieee802154.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of instances the medium can hold
+ *
+ * Must be the same for all instances sharing a medium.
+ */
+#ifndef SHM_RADIO_NODES
+#define SHM_RADIO_NODES         (512U)
+#endif
+
+/**
+ * @brief   Number of frames an instance can have pending, must be a power
+ *          of two
+ *
+ * Must be the same for all instances sharing a medium.
+ */
+#ifndef SHM_RADIO_RING_SIZE
+#define SHM_RADIO_RING_SIZE     (8U)
+#endif
+
+/**
+ * @brief   Shared memory medium, opaque
+ */
+typedef struct shm_radio_medium shm_radio_medium_t;
+
+/**
+ * @brief   Slot of an instance in the medium, opaque
+ */
+typedef struct shm_radio_node shm_radio_node_t;
+
+/**
+ * @brief   Shared memory radio device state
+ */
+typedef struct {
+    netdev_ieee802154_t netdev;     /**< netdev internal member */
+    shm_radio_medium_t *medium;     /**< the mapped medium */
+    shm_radio_node_t *node;         /**< slot of this instance */
+    const char *path;               /**< file of the medium */
+    int sock_fd;                    /**< socket of this instance */
+    unsigned idx;                   /**< index of the slot */
+    bool tx_done;                   /**< TX_COMPLETE is pending */
+} shm_radio_t;
+
+/**
+ * @brief   Shared memory radio initialization parameters
+ */
+typedef struct {
+    char *path;         /**< file of the medium, created if missing */
+} shm_radio_params_t;
+
+/**
+ * @brief   Maps the medium and claims a slot in it
+ *
+ * Exits the instance if the medium can't be mapped or is full.
+ *
+ * @param[in] dev       the preallocated shm_radio_t device handle to setup
+ * @param[in] params    initialization parameters
+ */
+void shm_radio_setup(shm_radio_t *dev, const shm_radio_params_t *params);
+
+/**
+ * @brief   Releases the slot and unmaps the medium
+ *
+ * @param[in] dev       the device
+ */
+void shm_radio_cleanup(shm_radio_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHM_RADIO_H */
+/** @} */
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_shm_radio
+ * @{
+ *
+ * @file
+ * @brief       Configuration parameters for the shared memory radio
+ */
+#ifndef SHM_RADIO_PARAMS_H
+#define SHM_RADIO_PARAMS_H
+
+#include "shm_radio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Parameters of the device, set by the `-r` option of native
+ */
+extern shm_radio_params_t shm_radio_params;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHM_RADIO_PARAMS_H */
+/** @} */
@@ -11,6 +11,10 @@
  * @ingroup     drivers_netdev
  * @brief       UDP socket-based IEEE 802.15.4 device over ZEP
  *
+ * Several instances are connected through a hub forwarding the frames
+ * between them, e.g. `dist/tools/zep_dispatch`, which also models the
+ * topology and the loss of the links.
+ *
  * @see @ref net_zep for protocol definitions
  *
  * @{
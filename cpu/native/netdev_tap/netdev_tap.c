@@ -68,6 +68,7 @@
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const iolist_t *iolist);
 static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info);
 
 static inline void _get_mac_addr(netdev_t *netdev, uint8_t *dst)
 {
@@ -94,16 +95,37 @@ static inline int _set_promiscous(netdev_t *netdev, int value)
     return value;
 }
 
+static bool _readable(netdev_tap_t *dev);
+static void _continue_reading(netdev_tap_t *dev);
+
 static inline void _isr(netdev_t *netdev)
 {
-    if (netdev->event_callback) {
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+
+    if (!netdev->event_callback) {
+#if DEVELHELP
+        puts("netdev_tap: _isr(): no event_callback set.");
+#endif
+        return;
+    }
+
+    /* hand all waiting frames to the upper layer, instead of taking a
+     * signal round trip for each of them */
+    for (unsigned i = 0; i < NETDEV_TAP_RX_BATCH; i++) {
+        dev->rx_consumed = false;
         netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        if (!dev->rx_consumed || !_readable(dev)) {
+            break;
+        }
+    }
+
+    if (dev->rx_consumed) {
+        _continue_reading(dev);
     }
-#if DEVELHELP
     else {
-        puts("netdev_tap: _isr(): no event_callback set.");
+        /* the frame was not taken, wait for the next one */
+        native_async_read_continue(dev->tap_fd);
     }
-#endif
 }
 
 static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
@@ -162,6 +184,7 @@ static const netdev_driver_t netdev_driver_tap = {
     .isr = _isr,
     .get = _get,
     .set = _set,
+    .recv_iolist = _recv_iolist,
 };
 
 /* driver implementation */
@@ -177,9 +200,8 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
-static void _continue_reading(netdev_tap_t *dev)
+static bool _readable(netdev_tap_t *dev)
 {
-    /* work around lost signals */
     fd_set rfds;
     struct timeval t;
     memset(&t, 0, sizeof(t));
@@ -187,8 +209,20 @@ static void _continue_reading(netdev_tap_t *dev)
     FD_SET(dev->tap_fd, &rfds);
 
     _native_in_syscall++; /* no switching here */
+    bool res = (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1);
+    _native_in_syscall--;
+
+    return res;
+}
+
+static void _continue_reading(netdev_tap_t *dev)
+{
+    /* work around lost signals */
+    bool readable = _readable(dev);
 
-    if (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
+    _native_in_syscall++; /* no switching here */
+
+    if (readable) {
         int sig = SIGIO;
         extern int _sig_pipefd[2];
         extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
@@ -204,39 +238,13 @@ static void _continue_reading(netdev_tap_t *dev)
     _native_in_syscall--;
 }
 
-static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+static int _recv_done(netdev_tap_t *dev, void *buf, int nread)
 {
-    netdev_tap_t *dev = (netdev_tap_t*)netdev;
-    (void)info;
-
-    if (!buf) {
-        if (len > 0) {
-            /* no memory available in pktbuf, discarding the frame */
-            DEBUG("netdev_tap: discarding the frame\n");
-
-            /* repeating `real_read` for small size on tap device results in
-             * freeze for some reason. Using a large buffer for now. */
-            /*
-            uint8_t buf[4];
-            while (real_read(dev->tap_fd, buf, sizeof(buf)) > 0) {
-            }
-            */
-
-            static uint8_t nullbuf[ETHERNET_FRAME_LEN];
-
-            real_read(dev->tap_fd, nullbuf, sizeof(nullbuf));
-
-            _continue_reading(dev);
-        }
-
-        /* no way of figuring out packet size without racey buffering,
-         * so we return the maximum possible size */
-        return ETHERNET_FRAME_LEN;
+    if (nread >= 0) {
+        /* _isr() rearms the interface */
+        dev->rx_consumed = true;
     }
 
-    int nread = real_read(dev->tap_fd, buf, len);
-    DEBUG("netdev_tap: read %d bytes\n", nread);
-
     if (nread > 0) {
         ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
         if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
@@ -247,16 +255,12 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
                   hdr->dst[0], hdr->dst[1], hdr->dst[2],
                   hdr->dst[3], hdr->dst[4], hdr->dst[5]);
 
-            native_async_read_continue(dev->tap_fd);
-
             return 0;
         }
 
-        _continue_reading(dev);
-
 #ifdef MODULE_NETSTATS_L2
-        netdev->stats.rx_count++;
-        netdev->stats.rx_bytes += nread;
+        dev->netdev.stats.rx_count++;
+        dev->netdev.stats.rx_bytes += nread;
 #endif
         return nread;
     }
@@ -277,6 +281,79 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     return -1;
 }
 
+static int _readv_frame(netdev_tap_t *dev, struct iovec *iov, unsigned n,
+                        size_t size)
+{
+    /* the tap device silently truncates a frame larger than the buffers,
+     * so catch the rest in a scratch buffer to detect that */
+    static uint8_t overflow[ETHERNET_FRAME_LEN];
+
+    iov[n].iov_base = overflow;
+    iov[n].iov_len = sizeof(overflow);
+
+    int nread = real_readv(dev->tap_fd, iov, n + 1);
+    DEBUG("netdev_tap: read %d bytes\n", nread);
+
+    if ((nread > 0) && ((size_t)nread > size)) {
+        DEBUG("netdev_tap: buffer too small, dropping the frame\n");
+        dev->rx_consumed = true;
+        return -ENOBUFS;
+    }
+    return _recv_done(dev, iov[0].iov_base, nread);
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    (void)info;
+
+    if (!buf) {
+        if (len > 0) {
+            /* no memory available in pktbuf, discarding the frame */
+            DEBUG("netdev_tap: discarding the frame\n");
+
+            /* repeating `real_read` for small size on tap device results in
+             * freeze for some reason. Using a large buffer for now. */
+            /*
+            uint8_t buf[4];
+            while (real_read(dev->tap_fd, buf, sizeof(buf)) > 0) {
+            }
+            */
+
+            static uint8_t nullbuf[ETHERNET_FRAME_LEN];
+
+            real_read(dev->tap_fd, nullbuf, sizeof(nullbuf));
+            dev->rx_consumed = true;
+        }
+
+        /* no way of figuring out packet size without racey buffering,
+         * so we return the maximum possible size */
+        return ETHERNET_FRAME_LEN;
+    }
+
+    struct iovec iov[2] = { { .iov_base = buf, .iov_len = len } };
+
+    return _readv_frame(dev, iov, 1, len);
+}
+
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    (void)info;
+
+    /* the destination address is needed for filtering */
+    if (iolist->iol_len < ETHERNET_ADDR_LEN) {
+        return -EINVAL;
+    }
+
+    /* one more for _readv_frame()'s scratch buffer */
+    struct iovec iov[iolist_count(iolist) + 1];
+    unsigned n;
+    size_t size = iolist_to_iovec(iolist, iov, &n);
+
+    return _readv_frame(dev, iov, n, size);
+}
+
 static int _send(netdev_t *netdev, const iolist_t *iolist)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
@@ -0,0 +1,447 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Shared memory radio implementation
+ *
+ * The ring of a slot is a bounded multi-producer queue: a producer claims a
+ * position by advancing `enqueue`, `seq` of the frame tells whether it is
+ * free for that position, written, or not yet read. `seq` is kept relative
+ * to the first position of the lap, so a zeroed medium is a valid empty
+ * one.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "async_read.h"
+#include "byteorder.h"
+#include "iolist.h"
+#include "native_internal.h"
+
+#include "shm_radio.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define _MAGIC          (0x52534d31)    /* "RSM1" */
+
+#if (SHM_RADIO_RING_SIZE & (SHM_RADIO_RING_SIZE - 1))
+#error "SHM_RADIO_RING_SIZE must be a power of two"
+#endif
+
+typedef struct {
+    atomic_uint seq;
+    uint8_t chan;
+    uint8_t len;
+    uint8_t data[IEEE802154_FRAME_LEN_MAX];
+} _frame_t;
+
+struct shm_radio_node {
+    atomic_int pid;         /* owner, 0 if the slot is free */
+    atomic_uint enqueue;    /* next position to write */
+    atomic_uint dequeue;    /* next position to read, only the owner */
+    atomic_bool armed;      /* the owner waits for a wake-up */
+    uint8_t chan;
+    uint8_t short_addr[IEEE802154_SHORT_ADDRESS_LEN];
+    uint8_t long_addr[IEEE802154_LONG_ADDRESS_LEN];
+    _frame_t ring[SHM_RADIO_RING_SIZE];
+};
+
+struct shm_radio_medium {
+    atomic_uint magic;
+    uint32_t nodes;
+    uint32_t ring_size;
+    uint32_t node_size;
+    shm_radio_node_t node[SHM_RADIO_NODES];
+};
+
+static inline unsigned _lap(unsigned pos)
+{
+    return pos & ~(SHM_RADIO_RING_SIZE - 1);
+}
+
+static void _sock_addr(const shm_radio_t *dev, unsigned idx,
+                       struct sockaddr_un *addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    snprintf(addr->sun_path, sizeof(addr->sun_path), "%s.%u", dev->path, idx);
+}
+
+/* publishes channel and addresses, senders filter by them */
+static void _publish(shm_radio_t *dev)
+{
+    dev->node->chan = dev->netdev.chan;
+    memcpy(dev->node->short_addr, dev->netdev.short_addr,
+           sizeof(dev->node->short_addr));
+    memcpy(dev->node->long_addr, dev->netdev.long_addr,
+           sizeof(dev->node->long_addr));
+}
+
+static bool _for_node(const shm_radio_node_t *node, const uint8_t *frame)
+{
+    uint8_t dst_addr[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t dst_pan;
+
+    switch (ieee802154_get_dst(frame, dst_addr, &dst_pan)) {
+        case IEEE802154_LONG_ADDRESS_LEN:
+            return memcmp(dst_addr, node->long_addr,
+                          IEEE802154_LONG_ADDRESS_LEN) == 0;
+        case IEEE802154_SHORT_ADDRESS_LEN:
+            return (memcmp(dst_addr, ieee802154_addr_bcast,
+                           IEEE802154_SHORT_ADDRESS_LEN) == 0) ||
+                   (memcmp(dst_addr, node->short_addr,
+                           IEEE802154_SHORT_ADDRESS_LEN) == 0);
+        default:
+            return true;
+    }
+}
+
+/* puts a frame into the ring of a node, returns true if the node needs to
+ * be woken up */
+static bool _put(shm_radio_node_t *node, uint8_t chan, const uint8_t *frame,
+                 size_t len)
+{
+    unsigned pos = atomic_load_explicit(&node->enqueue, memory_order_relaxed);
+    _frame_t *f;
+
+    while (1) {
+        f = &node->ring[pos & (SHM_RADIO_RING_SIZE - 1)];
+        int diff = (int)(atomic_load_explicit(&f->seq, memory_order_acquire) -
+                         _lap(pos));
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak(&node->enqueue, &pos, pos + 1)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            /* ring is full, the frame is lost for this node */
+            return false;
+        }
+        else {
+            pos = atomic_load_explicit(&node->enqueue, memory_order_relaxed);
+        }
+    }
+    f->chan = chan;
+    f->len = len;
+    memcpy(f->data, frame, len);
+    atomic_store_explicit(&f->seq, _lap(pos) + 1, memory_order_release);
+    return atomic_exchange(&node->armed, false);
+}
+
+static _frame_t *_peek(shm_radio_t *dev)
+{
+    unsigned pos = atomic_load_explicit(&dev->node->dequeue,
+                                        memory_order_relaxed);
+    _frame_t *f = &dev->node->ring[pos & (SHM_RADIO_RING_SIZE - 1)];
+
+    if (atomic_load_explicit(&f->seq, memory_order_acquire) !=
+        (_lap(pos) + 1)) {
+        return NULL;
+    }
+    return f;
+}
+
+static void _pop(shm_radio_t *dev)
+{
+    unsigned pos = atomic_load_explicit(&dev->node->dequeue,
+                                        memory_order_relaxed);
+    _frame_t *f = &dev->node->ring[pos & (SHM_RADIO_RING_SIZE - 1)];
+
+    atomic_store_explicit(&f->seq, _lap(pos) + SHM_RADIO_RING_SIZE,
+                          memory_order_release);
+    atomic_store_explicit(&dev->node->dequeue, pos + 1, memory_order_relaxed);
+}
+
+static int _send(netdev_t *netdev, const iolist_t *iolist)
+{
+    shm_radio_t *dev = (shm_radio_t *)netdev;
+    uint8_t frame[IEEE802154_FRAME_LEN_MAX];
+    size_t len = 0;
+
+    for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
+        if ((len + iol->iol_len) > sizeof(frame)) {
+            return -EOVERFLOW;
+        }
+        memcpy(&frame[len], iol->iol_base, iol->iol_len);
+        len += iol->iol_len;
+    }
+    DEBUG("shm_radio::send(%p, %u bytes)\n", (void *)netdev, (unsigned)len);
+
+    _native_in_syscall++; /* no switching here */
+    for (unsigned i = 0; i < SHM_RADIO_NODES; i++) {
+        shm_radio_node_t *node = &dev->medium->node[i];
+
+        if ((i == dev->idx) || (atomic_load(&node->pid) == 0) ||
+            (node->chan != dev->netdev.chan) || !_for_node(node, frame)) {
+            continue;
+        }
+        if (_put(node, dev->netdev.chan, frame, len)) {
+            struct sockaddr_un addr;
+            const uint8_t bell = 0;
+
+            _sock_addr(dev, i, &addr);
+            sendto(dev->sock_fd, &bell, sizeof(bell), MSG_DONTWAIT,
+                   (struct sockaddr *)&addr, sizeof(addr));
+        }
+    }
+    _native_in_syscall--;
+
+    /* simulate TX_COMPLETE interrupt */
+    if (netdev->event_callback) {
+        dev->tx_done = true;
+        netdev->event_callback(netdev, NETDEV_EVENT_ISR);
+    }
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.tx_bytes += len;
+#endif
+    return len;
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    shm_radio_t *dev = (shm_radio_t *)netdev;
+    _frame_t *f = _peek(dev);
+    int size;
+
+    if (f == NULL) {
+        return 0;
+    }
+    size = f->len;
+    if (buf == NULL) {
+        if (len > 0) {
+            /* drop the frame */
+            _pop(dev);
+        }
+        return size;
+    }
+    if ((size_t)size > len) {
+        _pop(dev);
+        return -ENOBUFS;
+    }
+    memcpy(buf, f->data, size);
+    _pop(dev);
+    if (info != NULL) {
+        struct netdev_radio_rx_info *rx_info = info;
+
+        rx_info->lqi = UINT8_MAX;
+        rx_info->rssi = UINT8_MAX;
+    }
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.rx_count++;
+    netdev->stats.rx_bytes += size;
+#endif
+    return size;
+}
+
+static void _isr(netdev_t *netdev)
+{
+    shm_radio_t *dev = (shm_radio_t *)netdev;
+
+    if (netdev->event_callback == NULL) {
+        return;
+    }
+    if (dev->tx_done) {
+        dev->tx_done = false;
+        netdev->event_callback(netdev, NETDEV_EVENT_TX_COMPLETE);
+    }
+    while (1) {
+        _frame_t *f;
+
+        while ((f = _peek(dev)) != NULL) {
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+            if (_peek(dev) == f) {
+                /* the frame was not taken, don't spin on it */
+                _pop(dev);
+            }
+        }
+        atomic_store(&dev->node->armed, true);
+        /* a frame written before arming did not ring */
+        if ((_peek(dev) == NULL) ||
+            !atomic_exchange(&dev->node->armed, false)) {
+            return;
+        }
+    }
+}
+
+static void _socket_isr(int fd, void *arg)
+{
+    netdev_t *netdev = arg;
+    uint8_t bell;
+
+    /* the frames are in the ring, the datagrams only wake us up */
+    while (real_read(fd, &bell, sizeof(bell)) > 0) {}
+    native_async_read_continue(fd);
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV_EVENT_ISR);
+    }
+}
+
+static int _init(netdev_t *netdev)
+{
+    shm_radio_t *dev = (shm_radio_t *)netdev;
+
+    netdev_ieee802154_reset(&dev->netdev);
+    dev->netdev.chan = IEEE802154_DEFAULT_CHANNEL;
+    _publish(dev);
+    return 0;
+}
+
+static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    assert(netdev != NULL);
+    return netdev_ieee802154_get((netdev_ieee802154_t *)netdev, opt, value,
+                                 max_len);
+}
+
+static int _set(netdev_t *netdev, netopt_t opt, const void *value,
+                size_t value_len)
+{
+    int res;
+
+    assert(netdev != NULL);
+    res = netdev_ieee802154_set((netdev_ieee802154_t *)netdev, opt, value,
+                                value_len);
+    _publish((shm_radio_t *)netdev);
+    return res;
+}
+
+static const netdev_driver_t shm_radio_driver = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static void _map(shm_radio_t *dev)
+{
+    int fd = real_open(dev->path, O_RDWR | O_CREAT, 0600);
+
+    if (fd < 0) {
+        err(EXIT_FAILURE, "shm_radio: unable to open %s", dev->path);
+    }
+    /* all instances grow the file to the same size, it starts zeroed */
+    if ((ftruncate(fd, sizeof(shm_radio_medium_t)) < 0) ||
+        ((dev->medium = mmap(NULL, sizeof(shm_radio_medium_t),
+                             PROT_READ | PROT_WRITE, MAP_SHARED,
+                             fd, 0)) == MAP_FAILED)) {
+        err(EXIT_FAILURE, "shm_radio: unable to map %s", dev->path);
+    }
+    real_close(fd);
+
+    unsigned magic = 0;
+
+    if (atomic_compare_exchange_strong(&dev->medium->magic, &magic,
+                                       _MAGIC)) {
+        dev->medium->nodes = SHM_RADIO_NODES;
+        dev->medium->ring_size = SHM_RADIO_RING_SIZE;
+        dev->medium->node_size = sizeof(shm_radio_node_t);
+    }
+    else if ((magic != _MAGIC) || (dev->medium->nodes != SHM_RADIO_NODES) ||
+             (dev->medium->ring_size != SHM_RADIO_RING_SIZE) ||
+             (dev->medium->node_size != sizeof(shm_radio_node_t))) {
+        errx(EXIT_FAILURE, "shm_radio: %s is a different medium", dev->path);
+    }
+}
+
+static void _claim(shm_radio_t *dev)
+{
+    for (unsigned i = 0; i < SHM_RADIO_NODES; i++) {
+        shm_radio_node_t *node = &dev->medium->node[i];
+        int pid = atomic_load(&node->pid);
+
+        if ((pid != 0) && ((kill(pid, 0) == 0) || (errno != ESRCH))) {
+            continue;
+        }
+        if (!atomic_compare_exchange_strong(&node->pid, &pid, _native_pid)) {
+            continue;
+        }
+        if (pid != 0) {
+            /* taken over from an instance that exited */
+            atomic_store(&node->enqueue, 0);
+            atomic_store(&node->dequeue, 0);
+            for (unsigned j = 0; j < SHM_RADIO_RING_SIZE; j++) {
+                atomic_store(&node->ring[j].seq, 0);
+            }
+        }
+        atomic_store(&node->armed, true);
+        dev->node = node;
+        dev->idx = i;
+        return;
+    }
+    errx(EXIT_FAILURE, "shm_radio: all %u slots of %s in use",
+         SHM_RADIO_NODES, dev->path);
+}
+
+void shm_radio_setup(shm_radio_t *dev, const shm_radio_params_t *params)
+{
+    struct sockaddr_un addr;
+
+    DEBUG("shm_radio_setup(%p, %p)\n", (void *)dev, (void *)params);
+    assert(params->path != NULL);
+    memset(dev, 0, sizeof(shm_radio_t));
+    dev->netdev.netdev.driver = &shm_radio_driver;
+    dev->path = params->path;
+    _map(dev);
+    _claim(dev);
+
+    if ((dev->sock_fd = real_socket(AF_UNIX, SOCK_DGRAM, 0)) < 0) {
+        err(EXIT_FAILURE, "shm_radio: unable to create socket");
+    }
+    _sock_addr(dev, dev->idx, &addr);
+    real_unlink(addr.sun_path);
+    if (real_bind(dev->sock_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        err(EXIT_FAILURE, "shm_radio: unable to bind %s", addr.sun_path);
+    }
+
+    /* hardware address from the slot */
+    dev->netdev.long_addr[1] = 'S';     /* The "OUI" */
+    dev->netdev.long_addr[2] = 'H';
+    dev->netdev.long_addr[3] = 'M';
+    dev->netdev.long_addr[6] = (uint8_t)(dev->idx >> 8);
+    dev->netdev.long_addr[7] = (uint8_t)dev->idx;
+    dev->netdev.short_addr[0] = dev->netdev.long_addr[6];
+    dev->netdev.short_addr[1] = dev->netdev.long_addr[7];
+    native_async_read_setup();
+    native_async_read_add_handler(dev->sock_fd, dev, _socket_isr);
+#ifdef MODULE_NETSTATS_L2
+    memset(&dev->netdev.netdev.stats, 0, sizeof(netstats_t));
+#endif
+}
+
+void shm_radio_cleanup(shm_radio_t *dev)
+{
+    struct sockaddr_un addr;
+
+    assert(dev != NULL);
+    native_async_read_cleanup();
+    real_close(dev->sock_fd);
+    _sock_addr(dev, dev->idx, &addr);
+    real_unlink(addr.sun_path);
+    atomic_store(&dev->node->pid, 0);
+    munmap(dev->medium, sizeof(shm_radio_medium_t));
+}
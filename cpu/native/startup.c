@@ -83,6 +83,12 @@ netdev_tap_params_t netdev_tap_params[NETDEV_TAP_MAX];
 socket_zep_params_t socket_zep_params[SOCKET_ZEP_MAX];
 #endif
 
+#ifdef MODULE_SHM_RADIO
+#include "shm_radio_params.h"
+
+shm_radio_params_t shm_radio_params;
+#endif
+
 static const char short_opts[] = ":hi:s:deEoc:"
 #ifdef MODULE_MTD_NATIVE
     "m:"
@@ -92,6 +98,9 @@ static const char short_opts[] = ":hi:s:deEoc:"
 #endif
 #ifdef MODULE_SOCKET_ZEP
     "z:"
+#endif
+#ifdef MODULE_SHM_RADIO
+    "r:"
 #endif
     "";
 
@@ -112,6 +121,9 @@ static const struct option long_opts[] = {
 #endif
 #ifdef MODULE_SOCKET_ZEP
     { "zep", required_argument, NULL, 'z' },
+#endif
+#ifdef MODULE_SHM_RADIO
+    { "radio", required_argument, NULL, 'r' },
 #endif
     { NULL, 0, NULL, '\0' },
 };
@@ -251,6 +263,9 @@ void usage_exit(int status)
         real_printf(" -z <laddr>:<lport>,<raddr>:<rport>\n");
     }
 #endif
+#ifdef MODULE_SHM_RADIO
+    real_printf(" -r <file>\n");
+#endif
 
     real_printf(" help: %s -h\n\n", _progname);
 
@@ -280,6 +295,11 @@ void usage_exit(int status)
 "        provide a ZEP interface with local address and port (<laddr>, <lport>)\n"
 "        and remote address and port (default local: [::]:17754).\n"
 "        Required to be provided SOCKET_ZEP_MAX times\n"
+#endif
+#ifdef MODULE_SHM_RADIO
+"    -r <file>, --radio=<file>\n"
+"        join the radio medium mapped from <file>, all instances given the\n"
+"        same <file> hear each other (required)\n"
 #endif
     );
 #ifdef MODULE_MTD_NATIVE
@@ -455,6 +475,11 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
             case 'z':
                 _zep_params_setup(optarg, zeps++);
                 break;
+#endif
+#ifdef MODULE_SHM_RADIO
+            case 'r':
+                shm_radio_params.path = optarg;
+                break;
 #endif
             default:
                 usage_exit(EXIT_FAILURE);
@@ -475,6 +500,12 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
         usage_exit(EXIT_FAILURE);
     }
 #endif
+#ifdef MODULE_SHM_RADIO
+    if (shm_radio_params.path == NULL) {
+        /* no medium given */
+        usage_exit(EXIT_FAILURE);
+    }
+#endif
 
     if (dmn) {
         filter_daemonize_argv(_native_argv);
@@ -98,6 +98,9 @@ int (*real_fputc)(int c, FILE *stream);
 int (*real_fgetc)(FILE *stream);
 mode_t (*real_umask)(mode_t cmask);
 ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
+ssize_t (*real_readv)(int fildes, const struct iovec *iov, int iovcnt);
+int (*real_recvmmsg)(int sockfd, void *msgvec, unsigned int vlen, int flags,
+                     void *timeout);
 
 #ifdef __MACH__
 #else
@@ -248,6 +251,17 @@ ssize_t _native_writev(int fd, const struct iovec *iov, int iovcnt)
     return r;
 }
 
+ssize_t _native_readv(int fd, const struct iovec *iov, int iovcnt)
+{
+    ssize_t r;
+
+    _native_syscall_enter();
+    r = real_readv(fd, iov, iovcnt);
+    _native_syscall_leave();
+
+    return r;
+}
+
 #if defined(__FreeBSD__)
 #undef putchar
 #endif
@@ -484,6 +498,8 @@ void _native_init_syscalls(void)
     *(void **)(&real_clearerr) = dlsym(RTLD_NEXT, "clearerr");
     *(void **)(&real_umask) = dlsym(RTLD_NEXT, "umask");
     *(void **)(&real_writev) = dlsym(RTLD_NEXT, "writev");
+    *(void **)(&real_readv) = dlsym(RTLD_NEXT, "readv");
+    *(void **)(&real_recvmmsg) = dlsym(RTLD_NEXT, "recvmmsg");
     *(void **)(&real_fclose) = dlsym(RTLD_NEXT, "fclose");
     *(void **)(&real_fseek) = dlsym(RTLD_NEXT, "fseek");
     *(void **)(&real_fputc) = dlsym(RTLD_NEXT, "fputc");
@@ -187,3 +187,177 @@ int adc_sample(adc_t line, adc_res_t res)
     _done();
     return result;
 }
+
+#if defined(MODULE_PERIPH_ADC_STREAM) && defined(CPU_SAMD21)
+/* the descriptor of channel 0 and the one of the second block, linked to a
+ * ring */
+static DmacDescriptor _desc[2] __attribute__((aligned(16)));
+static DmacDescriptor _desc_wb[1] __attribute__((aligned(16)));
+
+static struct {
+    adc_t line;
+    uint16_t *buf;
+    size_t half;
+    unsigned next;
+    adc_stream_cb_t cb;
+    void *arg;
+} _stream = { .line = ADC_UNDEF };
+
+/* TC_CTRLA_PRESCALER values as power of two */
+static const uint8_t _tc_prescaler_shift[] = { 0, 1, 2, 3, 4, 6, 8, 10 };
+
+static int _stream_tc_init(uint32_t freq)
+{
+    const adc_stream_conf_t *conf = &adc_stream_config;
+    uint32_t ticks = CLOCK_CORECLOCK / freq;
+    unsigned prescaler = 0;
+
+    while ((ticks >> _tc_prescaler_shift[prescaler]) > 0x10000) {
+        if (++prescaler == sizeof(_tc_prescaler_shift)) {
+            return -1;
+        }
+    }
+    if (ticks < 2) {
+        return -1;
+    }
+
+    PM->APBCMASK.reg |= conf->pm_mask;
+    /* TC6 and TC7 share their clock with the PWM, which uses GCLK0 as well */
+    GCLK->CLKCTRL.reg = (uint16_t)(GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 |
+                                   GCLK_CLKCTRL_ID(conf->gclk_id));
+    conf->dev->COUNT16.CTRLA.reg = TC_CTRLA_SWRST;
+    while (conf->dev->COUNT16.CTRLA.reg & TC_CTRLA_SWRST) {}
+    /* count to CC0, the overflow event starts a conversion */
+    conf->dev->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 |
+                                   TC_CTRLA_WAVEGEN_MFRQ |
+                                   TC_CTRLA_PRESCALER(prescaler);
+    conf->dev->COUNT16.CC[0].reg =
+        (ticks >> _tc_prescaler_shift[prescaler]) - 1;
+    conf->dev->COUNT16.EVCTRL.reg = TC_EVCTRL_OVFEO;
+    while (conf->dev->COUNT16.STATUS.reg & TC_STATUS_SYNCBUSY) {}
+
+    PM->APBCMASK.reg |= PM_APBCMASK_EVSYS;
+    EVSYS->USER.reg = EVSYS_USER_USER(EVSYS_ID_USER_ADC_START) |
+                      EVSYS_USER_CHANNEL(conf->evsys_chan + 1);
+    EVSYS->CHANNEL.reg = EVSYS_CHANNEL_CHANNEL(conf->evsys_chan) |
+                         EVSYS_CHANNEL_EVGEN(conf->evgen) |
+                         EVSYS_CHANNEL_PATH_ASYNCHRONOUS;
+    return 0;
+}
+
+static void _stream_dmac_init(void)
+{
+    for (unsigned i = 0; i < 2; i++) {
+        uint16_t *block = &_stream.buf[i * _stream.half];
+
+        _desc[i].BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BLOCKACT_INT |
+                              DMAC_BTCTRL_BEATSIZE_HWORD | DMAC_BTCTRL_DSTINC;
+        _desc[i].BTCNT.reg = _stream.half;
+        _desc[i].SRCADDR.reg = (uint32_t)&ADC_0_DEV->RESULT.reg;
+        /* with increment, the address of the end of the block is given */
+        _desc[i].DSTADDR.reg = (uint32_t)(block + _stream.half);
+        _desc[i].DESCADDR.reg = (uint32_t)&_desc[1 - i];
+    }
+    _stream.next = 0;
+
+    PM->AHBMASK.reg |= PM_AHBMASK_DMAC;
+    PM->APBBMASK.reg |= PM_APBBMASK_DMAC;
+    DMAC->CTRL.reg = 0;
+    DMAC->CTRL.reg = DMAC_CTRL_SWRST;
+    while (DMAC->CTRL.reg & DMAC_CTRL_SWRST) {}
+    DMAC->BASEADDR.reg = (uint32_t)_desc;
+    DMAC->WRBADDR.reg = (uint32_t)_desc_wb;
+    DMAC->CTRL.reg = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN(0xf);
+
+    DMAC->CHID.reg = 0;
+    DMAC->CHCTRLB.reg = DMAC_CHCTRLB_TRIGSRC(ADC_DMAC_ID_RESRDY) |
+                        DMAC_CHCTRLB_TRIGACT_BEAT;
+    DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TCMPL;
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_ENABLE;
+    NVIC_EnableIRQ(DMAC_IRQn);
+}
+
+void isr_dmac(void)
+{
+    DMAC->CHID.reg = 0;
+    DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_TCMPL;
+
+    uint16_t *block = &_stream.buf[_stream.next * _stream.half];
+
+    /* the blocks complete in turns */
+    _stream.next ^= 1;
+    _stream.cb(_stream.arg, block, _stream.half);
+    cortexm_isr_end();
+}
+
+int adc_stream_start(adc_t line, adc_res_t res, uint32_t freq, uint16_t *buf,
+                     size_t len, adc_stream_cb_t cb, void *arg)
+{
+    const adc_stream_conf_t *conf = &adc_stream_config;
+
+    assert(_stream.line == ADC_UNDEF);
+    if ((line >= ADC_NUMOF) || (freq == 0) || (len < 2) || (len & 1) ||
+        (len > 2 * UINT16_MAX)) {
+        return -1;
+    }
+    if ((res != ADC_RES_8BIT) && (res != ADC_RES_10BIT) &&
+        (res != ADC_RES_12BIT)) {
+        return -1;
+    }
+
+    _prep();
+    if (_adc_configure(res) != 0) {
+        DEBUG("adc: configuration failed\n");
+        return -1;
+    }
+    if (_stream_tc_init(freq) != 0) {
+        _adc_poweroff();
+        _done();
+        DEBUG("adc: sampling rate not applicable\n");
+        return -1;
+    }
+    _stream.line = line;
+    _stream.buf = buf;
+    _stream.half = len / 2;
+    _stream.cb = cb;
+    _stream.arg = arg;
+    _stream_dmac_init();
+
+    /* the prescaler of adc_sample() is usually too slow for streaming */
+    ADC_0_DEV->CTRLA.reg &= ~ADC_CTRLA_ENABLE;
+    while (_adc_syncing()) {}
+    ADC_0_DEV->CTRLB.reg = conf->prescaler | res;
+    ADC_0_DEV->INPUTCTRL.reg = ADC_0_GAIN_FACTOR_DEFAULT |
+                               adc_channels[line].muxpos | ADC_0_NEG_INPUT;
+    ADC_0_DEV->EVCTRL.reg = ADC_EVCTRL_STARTEI;
+    ADC_0_DEV->CTRLA.reg |= ADC_CTRLA_ENABLE;
+    while (_adc_syncing()) {}
+
+    conf->dev->COUNT16.CTRLA.reg |= TC_CTRLA_ENABLE;
+    return 0;
+}
+
+void adc_stream_stop(void)
+{
+    const adc_stream_conf_t *conf = &adc_stream_config;
+
+    if (_stream.line == ADC_UNDEF) {
+        return;
+    }
+    conf->dev->COUNT16.CTRLA.reg = 0;
+    while (conf->dev->COUNT16.STATUS.reg & TC_STATUS_SYNCBUSY) {}
+    PM->APBCMASK.reg &= ~conf->pm_mask;
+
+    NVIC_DisableIRQ(DMAC_IRQn);
+    DMAC->CHID.reg = 0;
+    DMAC->CHCTRLA.reg = 0;
+    DMAC->CTRL.reg = 0;
+    PM->AHBMASK.reg &= ~PM_AHBMASK_DMAC;
+    PM->APBBMASK.reg &= ~PM_APBBMASK_DMAC;
+
+    ADC_0_DEV->EVCTRL.reg = 0;
+    _adc_poweroff();
+    _stream.line = ADC_UNDEF;
+    _done();
+}
+#endif /* MODULE_PERIPH_ADC_STREAM && CPU_SAMD21 */
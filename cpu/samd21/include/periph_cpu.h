@@ -107,6 +107,23 @@ typedef enum {
     ADC_RES_16BIT = 0xfd                        /**< not supported */
 } adc_res_t;
 /** @} */
+
+#if defined(MODULE_PERIPH_ADC_STREAM) || defined(DOXYGEN)
+/**
+ * @brief   ADC stream configuration
+ *
+ * The stream uses DMAC channel 0 and the DMAC interrupt, so the DMAC can not
+ * be used otherwise while the `periph_adc_stream` module is used.
+ */
+typedef struct {
+    Tc *dev;                /**< TC triggering the conversions */
+    uint32_t pm_mask;       /**< PM_APBCMASK bit of the TC */
+    uint8_t gclk_id;        /**< GCLK_CLKCTRL_ID_x_Val of the TC */
+    uint8_t evgen;          /**< EVSYS_ID_GEN_x_OVF of the TC */
+    uint8_t evsys_chan;     /**< event system channel to use */
+    uint32_t prescaler;     /**< ADC_CTRLB_PRESCALER_x while streaming */
+} adc_stream_conf_t;
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -74,6 +74,27 @@ extern "C" {
 #define PERIPH_SPI_NEEDS_TRANSFER_REGS
 /** @} */
 
+#if defined(MODULE_PERIPH_DMA) || defined(DOXYGEN)
+/**
+ * @brief   SPI transfers can run in the background using DMA
+ */
+#define PERIPH_SPI_PROVIDES_TRANSFER_BYTES_ASYNC
+#endif
+
+#if defined(MODULE_STM32_PERIPH_UART_RX_DMA) || defined(DOXYGEN)
+/**
+ * @brief   UARTs can receive chunks of data using DMA
+ */
+#define PERIPH_UART_PROVIDES_INIT_BLOCK
+
+/**
+ * @brief   Size of the circular DMA receive buffer of each UART
+ */
+#ifndef STM32_UART_RX_DMA_BUFSIZE
+#define STM32_UART_RX_DMA_BUFSIZE   (64U)
+#endif
+#endif
+
 /**
  * @brief   Number of usable low power modes
  */
@@ -88,6 +109,11 @@ extern "C" {
 #define STM32_PM_STOP         (1U)
 #define STM32_PM_STANDBY      (0U)
 /** @} */
+
+/**
+ * @brief   The timers are not clocked from STOP mode on
+ */
+#define PM_TIMER_STOP_MODE    STM32_PM_STOP
 #endif
 
 /**
@@ -269,6 +295,14 @@ typedef enum {
 #define DMA_DATA_WIDTH_MASK      (0x0C)
 #define DMA_DATA_WIDTH_SHIFT     (2)
 /** @} */
+
+/**
+ * @brief   Restart the transfer at the end of the buffer
+ *
+ * The end of transfer callback, if any, is kept and called both when the
+ * buffer is half and when it is completely transferred.
+ */
+#define DMA_CIRCULAR             (0x10)
 #endif /* MODULE_PERIPH_DMA */
 
 /**
@@ -350,6 +384,11 @@ typedef struct {
     dma_t dma;              /**< Logical DMA stream used for TX */
     uint8_t dma_chan;       /**< DMA channel used for TX */
 #endif
+#ifdef MODULE_STM32_PERIPH_UART_RX_DMA
+    dma_t rx_dma;           /**< Logical DMA stream used for RX - set to
+                                 DMA_STREAM_UNDEF when receiving byte-wise */
+    uint8_t rx_dma_chan;    /**< DMA channel used for RX */
+#endif
 #ifdef MODULE_STM32_PERIPH_UART_HW_FC
     gpio_t cts_pin;         /**< CTS pin - set to GPIO_UNDEF when not using HW flow control */
     gpio_t rts_pin;         /**< RTS pin */
@@ -583,6 +622,26 @@ void dma_stop(dma_t dma);
  */
 void dma_wait(dma_t dma);
 
+/**
+ * @brief   Signature for the callback signaling the end of a DMA transfer
+ *
+ * @param[in] arg       optional context for the callback
+ */
+typedef void (*dma_cb_t)(void *arg);
+
+/**
+ * @brief   Set a callback for the end of the next transfer on a stream
+ *
+ * The callback is called from interrupt context instead of waking up
+ * dma_wait() and is cleared afterwards, unless the transfer is
+ * @ref DMA_CIRCULAR. Must be called before the transfer is started.
+ *
+ * @param[in] dma     logical DMA stream
+ * @param[in] cb      callback, NULL to wake up dma_wait()
+ * @param[in] arg     optional argument passed to @p cb
+ */
+void dma_set_cb(dma_t dma, dma_cb_t cb, void *arg);
+
 /**
  * @brief   Configure a DMA stream for a new transfer
  *
@@ -37,6 +37,10 @@ struct dma_ctx {
     mutex_t conf_lock;
     mutex_t sync_lock;
     uint16_t len;
+    void *dst;              /* memory written by the transfer */
+    size_t dst_len;         /* its size in bytes, 0 if none */
+    dma_cb_t cb;
+    void *cb_arg;
 };
 
 static struct dma_ctx dma_ctx[DMA_NUMOF];
@@ -153,9 +157,28 @@ int dma_configure(dma_t dma, int chan, const void *src, void *dst, size_t len,
                  (mode & 3) << DMA_SxCR_DIR_Pos;
     /* Enable interrupts */
     stream->CR |= DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+    if (flags & DMA_CIRCULAR) {
+        /* report both halves of the buffer */
+        stream->CR |= DMA_SxCR_CIRC | DMA_SxCR_HTIE;
+    }
     /* Configure FIFO */
     stream->FCR = 0;
 
+    /* write back what the CPU wrote before the DMA reads it, and keep dirty
+     * lines from being evicted over what the DMA writes */
+    size_t item = 1U << width;
+    if (mode != DMA_PERIPH_TO_MEM) {
+        cortexm_dcache_clean(src, (flags & DMA_INC_SRC_ADDR) ? (len * item) : item);
+    }
+    if (mode != DMA_MEM_TO_PERIPH) {
+        dma_ctx[dma].dst = dst;
+        dma_ctx[dma].dst_len = (flags & DMA_INC_DST_ADDR) ? (len * item) : item;
+        cortexm_dcache_clean(dst, dma_ctx[dma].dst_len);
+    }
+    else {
+        dma_ctx[dma].dst_len = 0;
+    }
+
     /* Set length */
     stream->NDTR = len;
     dma_ctx[dma].len = len;
@@ -226,11 +249,34 @@ void dma_wait(dma_t dma)
     mutex_lock(&dma_ctx[dma].sync_lock);
 }
 
+void dma_set_cb(dma_t dma, dma_cb_t cb, void *arg)
+{
+    assert(dma < DMA_NUMOF);
+
+    dma_ctx[dma].cb = cb;
+    dma_ctx[dma].cb_arg = arg;
+}
+
 void dma_isr_handler(dma_t dma)
 {
+    dma_cb_t cb = dma_ctx[dma].cb;
+
     dma_clear_all_flags(dma);
 
-    mutex_unlock(&dma_ctx[dma].sync_lock);
+    /* let the CPU read what the DMA wrote */
+    if (dma_ctx[dma].dst_len) {
+        cortexm_dcache_invalidate(dma_ctx[dma].dst, dma_ctx[dma].dst_len);
+    }
+
+    if (cb != NULL) {
+        if (!(dma_stream(dma_config[dma].stream)->CR & DMA_SxCR_CIRC)) {
+            dma_ctx[dma].cb = NULL;
+        }
+        cb(dma_ctx[dma].cb_arg);
+    }
+    else {
+        mutex_unlock(&dma_ctx[dma].sync_lock);
+    }
 
     cortexm_isr_end();
 }
@@ -161,14 +161,34 @@ static inline void _wait_for_end(spi_t bus)
 }
 
 #ifdef MODULE_PERIPH_DMA
-static void _transfer_dma(spi_t bus, const void *out, void *in, size_t len)
+/**
+ * @brief   State of an asynchronous transfer
+ */
+typedef struct {
+    spi_cb_t cb;            /**< callback for the end of the transfer */
+    void *arg;              /**< argument of cb */
+    spi_cs_t cs;            /**< chip select line */
+    bool cont;              /**< keep the device selected */
+    uint8_t dummy;          /**< source or sink for NULL buffers */
+} _async_t;
+
+static _async_t _async[SPI_NUMOF];
+
+static inline bool _has_dma(spi_t bus)
 {
-    uint8_t tmp = 0;
+    return (spi_config[bus].tx_dma != DMA_STREAM_UNDEF) &&
+           (spi_config[bus].rx_dma != DMA_STREAM_UNDEF);
+}
+
+static void _dma_setup(spi_t bus, const void *out, void *in, size_t len,
+                       uint8_t *dummy)
+{
+    *dummy = 0;
     dma_acquire(spi_config[bus].tx_dma);
     dma_acquire(spi_config[bus].rx_dma);
 
     if (!out) {
-        dma_configure(spi_config[bus].tx_dma, spi_config[bus].tx_dma_chan, &tmp,
+        dma_configure(spi_config[bus].tx_dma, spi_config[bus].tx_dma_chan, dummy,
                       (void *)&(dev(bus)->DR), len, DMA_MEM_TO_PERIPH, 0);
     }
     else {
@@ -177,20 +197,17 @@ static void _transfer_dma(spi_t bus, const void *out, void *in, size_t len)
     }
     if (!in) {
         dma_configure(spi_config[bus].rx_dma, spi_config[bus].rx_dma_chan,
-                      (void *)&(dev(bus)->DR), &tmp, len, DMA_PERIPH_TO_MEM, 0);
+                      (void *)&(dev(bus)->DR), dummy, len, DMA_PERIPH_TO_MEM, 0);
     }
     else {
         dma_configure(spi_config[bus].rx_dma, spi_config[bus].rx_dma_chan,
                       (void *)&(dev(bus)->DR), in, len, DMA_PERIPH_TO_MEM, DMA_INC_DST_ADDR);
     }
     dev(bus)->CR2 |= SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN;
+}
 
-    dma_start(spi_config[bus].rx_dma);
-    dma_start(spi_config[bus].tx_dma);
-
-    dma_wait(spi_config[bus].rx_dma);
-    dma_wait(spi_config[bus].tx_dma);
-
+static void _dma_finish(spi_t bus)
+{
     dev(bus)->CR2 &= ~(SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
 
     dma_stop(spi_config[bus].tx_dma);
@@ -201,6 +218,21 @@ static void _transfer_dma(spi_t bus, const void *out, void *in, size_t len)
 
     _wait_for_end(bus);
 }
+
+static void _transfer_dma(spi_t bus, const void *out, void *in, size_t len)
+{
+    uint8_t tmp;
+
+    _dma_setup(bus, out, in, len, &tmp);
+
+    dma_start(spi_config[bus].rx_dma);
+    dma_start(spi_config[bus].tx_dma);
+
+    dma_wait(spi_config[bus].rx_dma);
+    dma_wait(spi_config[bus].tx_dma);
+
+    _dma_finish(bus);
+}
 #endif
 
 static void _transfer_no_dma(spi_t bus, const void *out, void *in, size_t len)
@@ -244,6 +276,24 @@ static void _transfer_no_dma(spi_t bus, const void *out, void *in, size_t len)
     _wait_for_end(bus);
 }
 
+static inline void _cs_select(spi_t bus, spi_cs_t cs)
+{
+    dev(bus)->CR1 |= (SPI_CR1_SPE);     /* this pulls the HW CS line low */
+    if ((cs != SPI_HWCS_MASK) && (cs != SPI_CS_UNDEF)) {
+        gpio_clear((gpio_t)cs);
+    }
+}
+
+static inline void _cs_release(spi_t bus, spi_cs_t cs, bool cont)
+{
+    if ((!cont) && (cs != SPI_CS_UNDEF)) {
+        dev(bus)->CR1 &= ~(SPI_CR1_SPE);    /* pull HW CS line high */
+        if (cs != SPI_HWCS_MASK) {
+            gpio_set((gpio_t)cs);
+        }
+    }
+}
+
 void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
                         const void *out, void *in, size_t len)
 {
@@ -251,14 +301,10 @@ void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
     assert(out || in);
 
     /* active the given chip select line */
-    dev(bus)->CR1 |= (SPI_CR1_SPE);     /* this pulls the HW CS line low */
-    if ((cs != SPI_HWCS_MASK) && (cs != SPI_CS_UNDEF)) {
-        gpio_clear((gpio_t)cs);
-    }
+    _cs_select(bus, cs);
 
 #ifdef MODULE_PERIPH_DMA
-    if (spi_config[bus].tx_dma != DMA_STREAM_UNDEF
-            && spi_config[bus].rx_dma != DMA_STREAM_UNDEF) {
+    if (_has_dma(bus)) {
         _transfer_dma(bus, out, in, len);
     }
     else {
@@ -269,10 +315,51 @@ void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
 #endif
 
     /* release the chip select if not specified differently */
-    if ((!cont) && (cs != SPI_CS_UNDEF)) {
-        dev(bus)->CR1 &= ~(SPI_CR1_SPE);    /* pull HW CS line high */
-        if (cs != SPI_HWCS_MASK) {
-            gpio_set((gpio_t)cs);
-        }
+    _cs_release(bus, cs, cont);
+}
+
+#ifdef MODULE_PERIPH_DMA
+static void _dma_tx_done(void *arg)
+{
+    /* the end of the RX stream marks the end of the transfer */
+    (void)arg;
+}
+
+static void _dma_rx_done(void *arg)
+{
+    spi_t bus = (spi_t)(uintptr_t)arg;
+    _async_t *async = &_async[bus];
+
+    _dma_finish(bus);
+    _cs_release(bus, async->cs, async->cont);
+    async->cb(async->arg);
+}
+
+void spi_transfer_bytes_async(spi_t bus, spi_cs_t cs, bool cont,
+                              const void *out, void *in, size_t len,
+                              spi_cb_t cb, void *arg)
+{
+    /* make sure at least one input or one output buffer is given */
+    assert(out || in);
+    assert(cb != NULL);
+
+    if (!_has_dma(bus) || (len == 0)) {
+        spi_transfer_bytes(bus, cs, cont, out, in, len);
+        cb(arg);
+        return;
     }
+
+    _async[bus].cb = cb;
+    _async[bus].arg = arg;
+    _async[bus].cs = cs;
+    _async[bus].cont = cont;
+
+    _cs_select(bus, cs);
+    _dma_setup(bus, out, in, len, &_async[bus].dummy);
+    dma_set_cb(spi_config[bus].tx_dma, _dma_tx_done, NULL);
+    dma_set_cb(spi_config[bus].rx_dma, _dma_rx_done, (void *)(uintptr_t)bus);
+
+    dma_start(spi_config[bus].rx_dma);
+    dma_start(spi_config[bus].tx_dma);
 }
+#endif
@@ -44,6 +44,21 @@ static inline USART_TypeDef *dev(uart_t uart)
     return uart_config[uart].dev;
 }
 
+#ifdef MODULE_STM32_PERIPH_UART_RX_DMA
+/**
+ * @brief   Context of block-wise reception
+ */
+typedef struct {
+    uart_rx_block_cb_t rx_cb;   /**< chunk callback */
+    void *arg;                  /**< argument to rx_cb */
+    uart_t uart;                /**< the UART */
+    uint16_t pos;               /**< first byte in buf not yet delivered */
+    uint8_t buf[STM32_UART_RX_DMA_BUFSIZE]; /**< circular DMA buffer */
+} rx_dma_ctx_t;
+
+static rx_dma_ctx_t rx_dma_ctx[UART_NUMOF];
+#endif
+
 int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
 {
     uint16_t mantissa;
@@ -216,6 +231,77 @@ void uart_poweroff(uart_t uart)
 #endif
 }
 
+#ifdef MODULE_STM32_PERIPH_UART_RX_DMA
+static void rx_dma_flush(void *arg)
+{
+    rx_dma_ctx_t *ctx = arg;
+    const DMA_Stream_TypeDef *stream =
+        dma_stream(dma_config[uart_config[ctx->uart].rx_dma].stream);
+    uint16_t pos = (STM32_UART_RX_DMA_BUFSIZE - stream->NDTR) %
+                   STM32_UART_RX_DMA_BUFSIZE;
+
+    if (pos < ctx->pos) {
+        /* deliver the end of the buffer first */
+        ctx->rx_cb(ctx->arg, &ctx->buf[ctx->pos],
+                   STM32_UART_RX_DMA_BUFSIZE - ctx->pos);
+        ctx->pos = 0;
+    }
+    if (pos > ctx->pos) {
+        ctx->rx_cb(ctx->arg, &ctx->buf[ctx->pos], pos - ctx->pos);
+    }
+    ctx->pos = pos;
+}
+
+static void rx_byte(void *arg, uint8_t data)
+{
+    rx_dma_ctx_t *ctx = arg;
+
+    ctx->rx_cb(ctx->arg, &data, 1);
+}
+
+int uart_init_block(uart_t uart, uint32_t baudrate, uart_rx_block_cb_t rx_cb,
+                    void *arg)
+{
+    rx_dma_ctx_t *ctx = &rx_dma_ctx[uart];
+    int res;
+
+    assert(uart < UART_NUMOF);
+
+    if (rx_cb == NULL) {
+        return uart_init(uart, baudrate, NULL, NULL);
+    }
+    ctx->rx_cb = rx_cb;
+    ctx->arg = arg;
+    ctx->uart = uart;
+    ctx->pos = 0;
+
+    /* without a DMA stream, or until DMA is running, bytes are delivered one
+     * by one */
+    res = uart_init(uart, baudrate, rx_byte, ctx);
+    if ((res != UART_OK) || (uart_config[uart].rx_dma == DMA_STREAM_UNDEF)) {
+        return res;
+    }
+
+    dma_acquire(uart_config[uart].rx_dma);
+#ifdef CPU_FAM_STM32F7
+    const void *src = (void *)&dev(uart)->RDR;
+#else
+    const void *src = (void *)&dev(uart)->DR;
+#endif
+    dma_configure(uart_config[uart].rx_dma, uart_config[uart].rx_dma_chan,
+                  src, ctx->buf, STM32_UART_RX_DMA_BUFSIZE,
+                  DMA_PERIPH_TO_MEM, DMA_INC_DST_ADDR | DMA_CIRCULAR);
+    dma_set_cb(uart_config[uart].rx_dma, rx_dma_flush, ctx);
+
+    dev(uart)->CR1 &= ~USART_CR1_RXNEIE;
+    dev(uart)->CR3 |= USART_CR3_DMAR;
+    dma_start(uart_config[uart].rx_dma);
+    dev(uart)->CR1 |= USART_CR1_IDLEIE;
+
+    return UART_OK;
+}
+#endif
+
 static inline void irq_handler(uart_t uart)
 {
 #if defined(CPU_FAM_STM32F0) || defined(CPU_FAM_STM32L0) \
@@ -224,24 +310,38 @@ static inline void irq_handler(uart_t uart)
 
     uint32_t status = dev(uart)->ISR;
 
-    if (status & USART_ISR_RXNE) {
+    if ((status & USART_ISR_RXNE) && (dev(uart)->CR1 & USART_CR1_RXNEIE)) {
         isr_ctx[uart].rx_cb(isr_ctx[uart].arg, (uint8_t)dev(uart)->RDR);
     }
     if (status & USART_ISR_ORE) {
         dev(uart)->ICR |= USART_ICR_ORECF;    /* simply clear flag on overrun */
     }
+#ifdef MODULE_STM32_PERIPH_UART_RX_DMA
+    if ((status & USART_ISR_IDLE) && (dev(uart)->CR1 & USART_CR1_IDLEIE)) {
+        dev(uart)->ICR |= USART_ICR_IDLECF;
+        rx_dma_flush(&rx_dma_ctx[uart]);
+    }
+#endif
 
 #else
 
     uint32_t status = dev(uart)->SR;
 
-    if (status & USART_SR_RXNE) {
+    if ((status & USART_SR_RXNE) && (dev(uart)->CR1 & USART_CR1_RXNEIE)) {
         isr_ctx[uart].rx_cb(isr_ctx[uart].arg, (uint8_t)dev(uart)->DR);
     }
     if (status & USART_SR_ORE) {
         /* ORE is cleared by reading SR and DR sequentially */
         dev(uart)->DR;
     }
+#ifdef MODULE_STM32_PERIPH_UART_RX_DMA
+    if ((status & USART_SR_IDLE) && (dev(uart)->CR1 & USART_CR1_IDLEIE)) {
+        /* IDLE is cleared by reading SR and DR sequentially, DR is empty as
+         * long as the DMA keeps up */
+        dev(uart)->DR;
+        rx_dma_flush(&rx_dma_ctx[uart]);
+    }
+#endif
 
 #endif
 
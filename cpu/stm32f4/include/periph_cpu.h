@@ -84,6 +84,32 @@ typedef struct {
     uint8_t chan;           /**< CPU ADC channel connected to the pin */
 } adc_conf_t;
 
+#if defined(MODULE_PERIPH_ADC_STREAM) || defined(DOXYGEN)
+/**
+ * @name    ADC external trigger selection of the timers' TRGO output
+ * @{
+ */
+#define ADC_TRIG_TIM2_TRGO  (0x6)
+#define ADC_TRIG_TIM3_TRGO  (0x8)
+#define ADC_TRIG_TIM8_TRGO  (0xe)
+/** @} */
+
+/**
+ * @brief   ADC stream configuration
+ *
+ * The DMA stream and channel must be the ones of the ADC device of the
+ * lines streamed, e.g. DMA2 stream 0 or 4, channel 0 for ADC1.
+ */
+typedef struct {
+    TIM_TypeDef *timer;     /**< timer triggering the conversions */
+    uint32_t rcc_mask;      /**< bit in the RCC enable register of the timer */
+    uint8_t bus;            /**< APBx bus the timer is clocked by */
+    uint8_t trig;           /**< ADC_TRIG_x value of the timer */
+    dma_t dma;              /**< logical DMA stream transferring the samples */
+    uint8_t dma_chan;       /**< DMA channel of the ADC device */
+} adc_stream_conf_t;
+#endif
+
 #ifdef __cplusplus
 }
 #endif
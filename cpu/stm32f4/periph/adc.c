@@ -23,6 +23,9 @@
 #include "mutex.h"
 #include "periph/adc.h"
 #include "periph_conf.h"
+#ifdef MODULE_PERIPH_ADC_STREAM
+#include "assert.h"
+#endif
 
 /**
  * @brief   Maximum allowed ADC clock speed
@@ -120,3 +123,107 @@ int adc_sample(adc_t line, adc_res_t res)
 
     return sample;
 }
+
+#ifdef MODULE_PERIPH_ADC_STREAM
+static struct {
+    adc_t line;
+    uint16_t *buf;
+    size_t half;
+    adc_stream_cb_t cb;
+    void *arg;
+} _stream = { .line = ADC_UNDEF };
+
+static void _stream_dma_cb(void *arg)
+{
+    (void)arg;
+    DMA_Stream_TypeDef *stream =
+        dma_stream(dma_config[adc_stream_config.dma].stream);
+
+    /* NDTR counts down and is reloaded at the end of the buffer, so while
+     * the second half is being filled, the first one is complete */
+    uint16_t *block = (stream->NDTR > _stream.half)
+                    ? &_stream.buf[_stream.half] : _stream.buf;
+
+    _stream.cb(_stream.arg, block, _stream.half);
+}
+
+static int _stream_timer_init(uint32_t freq)
+{
+    const adc_stream_conf_t *conf = &adc_stream_config;
+    uint32_t ticks = periph_timer_clk(conf->bus) / freq;
+    uint32_t psc = ticks >> 16;
+
+    if ((ticks < 2) || (psc > UINT16_MAX)) {
+        return -1;
+    }
+    periph_clk_en(conf->bus, conf->rcc_mask);
+    conf->timer->CR1 = 0;
+    conf->timer->PSC = psc;
+    conf->timer->ARR = (ticks / (psc + 1)) - 1;
+    /* the update event is the trigger output */
+    conf->timer->CR2 = TIM_CR2_MMS_1;
+    conf->timer->EGR = TIM_EGR_UG;
+    return 0;
+}
+
+int adc_stream_start(adc_t line, adc_res_t res, uint32_t freq, uint16_t *buf,
+                     size_t len, adc_stream_cb_t cb, void *arg)
+{
+    const adc_stream_conf_t *conf = &adc_stream_config;
+
+    assert(_stream.line == ADC_UNDEF);
+    if ((line >= ADC_NUMOF) || (res & 0xff) || (freq == 0) ||
+        (len < 2) || (len & 1) || (len > UINT16_MAX)) {
+        return -1;
+    }
+
+    prep(line);
+    if (_stream_timer_init(freq) != 0) {
+        done(line);
+        return -1;
+    }
+    _stream.line = line;
+    _stream.buf = buf;
+    _stream.half = len / 2;
+    _stream.cb = cb;
+    _stream.arg = arg;
+
+    dma_acquire(conf->dma);
+    dma_configure(conf->dma, conf->dma_chan, (void *)&dev(line)->DR, buf, len,
+                  DMA_PERIPH_TO_MEM, DMA_INC_DST_ADDR |
+                  DMA_DATA_WIDTH_HALF_WORD | DMA_CIRCULAR);
+    dma_set_cb(conf->dma, _stream_dma_cb, NULL);
+    dma_start(conf->dma);
+
+    dev(line)->CR1 = res;
+    dev(line)->SQR3 = adc_config[line].chan;
+    /* request DMA for every conversion, triggered by the rising edge of the
+     * trigger output of the timer */
+    dev(line)->CR2 = ADC_CR2_ADON | ADC_CR2_DMA | ADC_CR2_DDS |
+                     ADC_CR2_EXTEN_0 | (conf->trig << ADC_CR2_EXTSEL_Pos);
+    conf->timer->CR1 = TIM_CR1_CEN;
+    return 0;
+}
+
+void adc_stream_stop(void)
+{
+    const adc_stream_conf_t *conf = &adc_stream_config;
+    adc_t line = _stream.line;
+
+    if (line == ADC_UNDEF) {
+        return;
+    }
+    conf->timer->CR1 = 0;
+    periph_clk_dis(conf->bus, conf->rcc_mask);
+    dev(line)->CR2 = ADC_CR2_ADON;
+    dev(line)->SR = 0;
+    /* also disables the DMA interrupt, so no half transfer callback is
+     * pending after the stream stopped */
+    dma_suspend(conf->dma);
+    dma_stop(conf->dma);
+    dma_set_cb(conf->dma, NULL, NULL);
+    dma_release(conf->dma);
+    _stream.line = ADC_UNDEF;
+    done(line);
+}
+#endif /* MODULE_PERIPH_ADC_STREAM */
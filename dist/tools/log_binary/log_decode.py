@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Formats the records of the log_binary module with the strings of the ELF"""
+
+import argparse
+import re
+import struct
+import sys
+
+HDR_SIZE = 6
+LEVELS = ["", "E", "W", "I", "D", "A"]
+
+# a conversion of a format string: flags, width, precision, length, type
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?"
+                        r"(hh|h|ll|l|j|z|t|L)?([diouxXcpsfFeEgGaAn%])")
+
+
+class Elf:
+    """Reads the strings of the allocated sections of an ELF file"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            sys.exit("%s is not an ELF file" % path)
+        is64 = self.data[4] == 2
+        end = "<" if self.data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(end + "Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(end + "HH", self.data, 0x3a)
+            shdr = end + "IIQQQQ"
+        else:
+            shoff, = struct.unpack_from(end + "I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(end + "HH", self.data, 0x2e)
+            shdr = end + "IIIIII"
+        self.sections = []
+        for i in range(shnum):
+            _, kind, flags, addr, offset, size = struct.unpack_from(
+                shdr, self.data, shoff + i * shentsize)
+            # allocated sections with contents, SHT_NOBITS has none
+            if flags & 0x2 and kind != 8:
+                self.sections.append((addr, offset, size))
+
+    def string(self, addr):
+        """Returns the string at addr, or None"""
+        for start, offset, size in self.sections:
+            if start <= addr < start + size:
+                pos = offset + addr - start
+                end = self.data.index(b"\0", pos, offset + size)
+                return self.data[pos:end].decode("utf-8", "replace")
+        return None
+
+
+class Args:
+    """Takes the arguments of a record one after another"""
+
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, fmt):
+        size = struct.calcsize(fmt)
+        if self.pos + size > len(self.data):
+            return None
+        val, = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += size
+        return val
+
+    def string(self):
+        length = self.take("<B")
+        if length is None or self.pos + length > len(self.data):
+            return None
+        val = self.data[self.pos:self.pos + length]
+        self.pos += length
+        return val.decode("utf-8", "replace")
+
+
+def format_message(fmt, args):
+    """Formats the arguments of a record like printf does"""
+    out = []
+    last = 0
+    for conv in CONVERSION.finditer(fmt):
+        out.append(fmt[last:conv.start()])
+        last = conv.end()
+        flags, width, prec, length, kind = conv.groups()
+        if kind == "%":
+            out.append("%")
+            continue
+        if width == "*":
+            width = args.take("<i")
+        if prec == "*":
+            prec = args.take("<i")
+        spec = "%" + flags + (str(width) if width is not None else "")
+        if prec is not None:
+            spec += "." + str(prec)
+        wide = length in ("ll", "j")
+
+        if kind in "di":
+            val = args.take("<q" if wide else "<i")
+            spec += "d"
+        elif kind in "ouxX":
+            val = args.take("<Q" if wide else "<I")
+            spec += kind
+        elif kind == "c":
+            val = args.take("<i")
+            val = None if val is None else chr(val & 0xff)
+            spec += "c"
+        elif kind == "p":
+            val = args.take("<I")
+            spec = "0x%08x"
+        elif kind == "s":
+            val = args.string()
+            spec += "s"
+        elif kind == "n":
+            continue
+        else:
+            val = args.take("<d")
+            if kind in "aA":
+                val = None if val is None else val.hex()
+                spec += "s"
+            else:
+                spec += kind
+        # the arguments that did not fit into the record
+        out.append("?" if val is None else spec % val)
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def decode(rec, elf, levels):
+    """Returns the message of a record"""
+    if len(rec) < HDR_SIZE:
+        return "[log_binary: short record]\n"
+    addr, level, length = struct.unpack_from("<IBB", rec)
+    args = Args(rec[HDR_SIZE:HDR_SIZE + length])
+    if addr == 0:
+        return "[log_binary: %d messages dropped]\n" % args.take("<I")
+    fmt = elf.string(addr)
+    if fmt is None:
+        return "[log_binary: unknown format string 0x%08x]\n" % addr
+    msg = format_message(fmt, args)
+    if levels and level < len(LEVELS):
+        msg = "%s: %s" % (LEVELS[level], msg)
+    return msg
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("elf", help="ELF file of the application")
+    parser.add_argument("log", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin,
+                        help="output of the node, other lines are passed on")
+    parser.add_argument("-l", "--levels", action="store_true",
+                        help="prefix the messages with their log level")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    for line in args.log:
+        text = line.strip()
+        # e.g. behind the prompt of pyterm
+        pos = text.find("@")
+        if pos >= 0 and re.fullmatch(r"([0-9a-f]{2})+", text[pos + 1:]):
+            sys.stdout.write(text[:pos] +
+                             decode(bytes.fromhex(text[pos + 1:]), elf,
+                                    args.levels))
+        else:
+            sys.stdout.write(line)
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
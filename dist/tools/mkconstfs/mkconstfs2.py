@@ -15,6 +15,7 @@ C_HEADER = """/* This file was automatically generated by mkconstfs2.
  * !!!! DO NOT EDIT !!!!!
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "fs/constfs.h"
 
@@ -31,6 +32,7 @@ C_FOOTER = """
 static const constfs_t _fs_data = {{
     .files = _files,
     .nfiles = sizeof(_files) / sizeof(_files[0]),
+    .sorted = true,
 }};
 
 vfs_mount_t {constfs_name} = {{
@@ -73,9 +75,11 @@ def mkconstfs(files, root_path, mount_point, constfs_name):
 
     yield FILES_DECL
 
+    # sorted by path as by strcmp(), for constfs to use binary search
     yield from (FILE_TEMPLATE.format(target_name=_addroot(relp),
                                      buff_name=ident)
-                for ident, relp in sorted(filemap.values()))
+                for ident, relp in sorted(filemap.values(),
+                                          key=lambda f: _addroot(f[1]).encode()))
 
     yield "};\n"
 
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Create a delta image for riotboot_ota
+
+Encodes the new image as copy and insert operations against the old image
+(see sys/include/riotboot/ota.h) and prints the SHA-256 digest of the new
+image, to be passed to riotboot_ota_finish(). Compress the result with
+`heatshrink -e -w 8 -l 4` for RIOTBOOT_OTA_COMPRESSED.
+"""
+
+import argparse
+import hashlib
+import struct
+
+OP_COPY = 0x01
+OP_INSERT = 0x02
+BLOCK = 16
+
+
+def delta(old, new):
+    blocks = {}
+    for off in range(len(old) - BLOCK, -1, -1):
+        blocks[old[off:off + BLOCK]] = off
+
+    out = bytearray()
+    literal = bytearray()
+    pos = 0
+    while pos < len(new):
+        src = blocks.get(new[pos:pos + BLOCK])
+        if src is None:
+            literal.append(new[pos])
+            pos += 1
+            continue
+        length = BLOCK
+        while ((pos + length < len(new)) and (src + length < len(old)) and
+               (new[pos + length] == old[src + length])):
+            length += 1
+        if literal:
+            out += struct.pack("<BI", OP_INSERT, len(literal)) + literal
+            literal = bytearray()
+        out += struct.pack("<BII", OP_COPY, length, src)
+        pos += length
+    if literal:
+        out += struct.pack("<BI", OP_INSERT, len(literal)) + literal
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("old", help="image running on the device")
+    parser.add_argument("new", help="image to install")
+    parser.add_argument("out", help="delta image to write")
+    args = parser.parse_args()
+
+    with open(args.old, "rb") as f:
+        old = f.read()
+    with open(args.new, "rb") as f:
+        new = f.read()
+    data = delta(old, new)
+    with open(args.out, "wb") as f:
+        f.write(data)
+    print("{} -> {} bytes, sha256 {}".format(len(new), len(data),
+                                             hashlib.sha256(new).hexdigest()))
+
+
+if __name__ == "__main__":
+    main()
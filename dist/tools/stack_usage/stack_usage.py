@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Estimate the worst case stack usage of thread entry functions
+
+Combines the per function stack usage written by the compiler with
+`-fstack-usage` (build with `STACK_USAGE=1`) with the static call graph taken
+from the disassembly of the ELF file. Calls through function pointers are not
+visible, so thread entry functions and ISRs typically show up as roots of the
+call graph.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+SU_RE = re.compile(r"^(?P<file>.*):\d+:\d+:(?P<func>[^\t]+)\t(?P<size>\d+)\t(?P<qual>\S+)$")
+FUNC_RE = re.compile(r"^[0-9a-f]+ <(?P<func>[^>]+)>:$")
+# direct calls and tail calls of the usual architectures, a target without
+# offset is the start of a function
+CALL_RE = re.compile(r"\t(?P<insn>bl|blx|call|callq|calll|jal|rcall|call\.a|b|b\.w|j|jmp|jmpq|rjmp)"
+                     r"\s+(?:0x)?[0-9a-f]+\s+<(?P<func>[^>+]+)>")
+TAIL_INSNS = ("b", "b.w", "j", "jmp", "jmpq", "rjmp")
+
+UNBOUNDED = "dynamic"
+RECURSIVE = "recursive"
+INCOMPLETE = "incomplete"
+
+
+def su_func_name(func):
+    """Strips C++ argument lists, to match the symbol names of objdump"""
+    if "(" in func:
+        func = func.split("(")[0].split(" ")[-1]
+    return func
+
+
+def parse_su(bindir):
+    frames = {}
+    flags = {}
+    for root, _, files in os.walk(bindir):
+        for filename in files:
+            if not filename.endswith(".su"):
+                continue
+            with open(os.path.join(root, filename)) as su_file:
+                for line in su_file:
+                    match = SU_RE.match(line.strip())
+                    if match is None:
+                        continue
+                    func = su_func_name(match.group("func"))
+                    # static functions may share a name, be pessimistic
+                    frames[func] = max(frames.get(func, 0), int(match.group("size")))
+                    if match.group("qual") != "static":
+                        flags.setdefault(func, set()).add(UNBOUNDED)
+    return frames, flags
+
+
+def parse_calls(objdump, elffile):
+    calls = {}
+    func = None
+    disasm = subprocess.check_output([objdump, "-d", elffile],
+                                     universal_newlines=True)
+    for line in disasm.splitlines():
+        match = FUNC_RE.match(line)
+        if match is not None:
+            func = match.group("func")
+            calls.setdefault(func, set())
+            continue
+        match = CALL_RE.search(line)
+        if (match is None) or (func is None):
+            continue
+        callee = match.group("func")
+        if (match.group("insn") in TAIL_INSNS) and (callee == func):
+            # a loop back to the function's start
+            continue
+        calls[func].add(callee)
+    return calls
+
+
+class StackGraph(object):
+    def __init__(self, frames, flags, calls):
+        self.frames = frames
+        self.flags = flags
+        self.calls = calls
+        self._cache = {}
+
+    def worst(self, func, stack=()):
+        """Returns usage, flags, and path of the deepest call chain"""
+        if func in self._cache:
+            return self._cache[func]
+        if func in stack:
+            return 0, {RECURSIVE}, [func]
+        flags = set(self.flags.get(func, set()))
+        if func not in self.frames:
+            flags.add(INCOMPLETE)
+        best = (0, set(), [])
+        for callee in sorted(self.calls.get(func, ())):
+            res = self.worst(callee, stack + (func,))
+            flags |= res[1]
+            if res[0] > best[0]:
+                best = res
+        res = (self.frames.get(func, 0) + best[0], flags, [func] + best[2])
+        if RECURSIVE not in flags:
+            # results within a recursion depend on the entry point
+            self._cache[func] = res
+        return res
+
+    def roots(self):
+        called = set()
+        for callees in self.calls.values():
+            called |= callees
+        return [func for func in self.frames if func not in called]
+
+
+def round_up(value, align):
+    return ((value + align - 1) // align) * align
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elffile", help="the linked application")
+    parser.add_argument("bindir", help="directory to search for .su files")
+    parser.add_argument("--objdump", default="objdump", help="objdump of the toolchain")
+    parser.add_argument("-e", "--entry", action="append", default=[],
+                        help="thread entry function to report, may be repeated "
+                             "(default: all roots of the call graph)")
+    parser.add_argument("-n", "--numof", type=int, default=20,
+                        help="number of roots to report (default: %(default)s)")
+    parser.add_argument("--overhead", type=int, default=128,
+                        help="bytes added for the saved context and "
+                             "interrupts nesting on the thread stack "
+                             "(default: %(default)s)")
+    parser.add_argument("-v", "--verbose", action="store_true",
+                        help="print the deepest call chain")
+    args = parser.parse_args()
+
+    frames, flags = parse_su(args.bindir)
+    if not frames:
+        sys.exit("no .su files found in {}, build with STACK_USAGE=1".format(args.bindir))
+    graph = StackGraph(frames, flags, parse_calls(args.objdump, args.elffile))
+
+    entries = args.entry
+    if not entries:
+        entries = sorted(graph.roots(), key=lambda f: graph.worst(f)[0], reverse=True)
+        entries = entries[:args.numof]
+
+    print("{:<40} {:>8} {:>9}  {}".format("entry", "usage", "suggested", "notes"))
+    for entry in entries:
+        usage, notes, path = graph.worst(entry)
+        print("{:<40} {:>8} {:>9}  {}".format(entry, usage,
+                                              round_up(usage + args.overhead, 8),
+                                              ", ".join(sorted(notes))))
+        if args.verbose:
+            for func in path:
+                print("    {:<36} {:>8}".format(func, frames.get(func, "?")))
+    print("\n{}: contains variable length arrays or alloca(), {}: calls itself,\n"
+          "{}: calls code without stack usage information (assembler, libraries),\n"
+          "calls through function pointers are not accounted for"
+          .format(UNBOUNDED, RECURSIVE, INCOMPLETE))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Converts the output of tracing_dump() to the Chrome trace format"""
+
+import argparse
+import json
+import subprocess
+import sys
+
+
+def read_symbols(elf, nm):
+    """Returns the function names of elf by address"""
+    out = subprocess.check_output([nm, "--defined-only", elf],
+                                  universal_newlines=True)
+    symbols = {}
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[1] in "tTwW":
+            symbols[int(fields[0], 16)] = fields[2]
+    return symbols
+
+
+def read_events(lines):
+    """Yields (time, type, addr) of the last dump found in lines"""
+    events = None
+    unit = None
+    for line in lines:
+        line = line.strip()
+        if line.startswith("tracing: end"):
+            continue
+        if line.startswith("tracing: "):
+            unit = line.split()[1]
+            events = []
+            continue
+        if events is None:
+            continue
+        fields = line.split()
+        if len(fields) == 4 and fields[1] in "EXS":
+            events.append((int(fields[0]), fields[1], int(fields[2], 16)))
+    if events is None:
+        sys.exit("no tracing dump found")
+    return unit, events
+
+
+def convert(unit, events, symbols, freq):
+    """Returns the events in the Chrome trace format"""
+    scale = 1.0
+    if unit == "cycles":
+        if not freq:
+            sys.exit("the timestamps are CPU cycles, please give --freq")
+        scale = 1e6 / freq
+
+    trace = []
+    pid = 0
+    last = None
+    offset = 0
+    for time, kind, addr in events:
+        # the timestamps are 32 bit wide
+        if last is not None and time < last:
+            offset += 1 << 32
+        last = time
+        ts = (time + offset) * scale
+
+        if kind == "S":
+            pid = addr
+            trace.append({"name": "thread %d" % pid, "ph": "i", "s": "g",
+                          "ts": ts, "pid": 0, "tid": pid})
+            continue
+        # Thumb function pointers have the lowest bit set
+        name = symbols.get(addr, symbols.get(addr & ~1, "0x%08x" % addr))
+        trace.append({"name": name, "ph": "B" if kind == "E" else "E",
+                      "ts": ts, "pid": 0, "tid": pid})
+    return {"traceEvents": trace, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("log", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin,
+                        help="output of the node containing a dump")
+    parser.add_argument("-e", "--elf", help="ELF file to resolve the names")
+    parser.add_argument("--nm", default="nm", help="nm of the toolchain")
+    parser.add_argument("-f", "--freq", type=float,
+                        help="CPU clock in Hz, for timestamps in cycles")
+    parser.add_argument("-o", "--output", type=argparse.FileType("w"),
+                        default=sys.stdout, help="Chrome trace JSON file")
+    args = parser.parse_args()
+
+    symbols = read_symbols(args.elf, args.nm) if args.elf else {}
+    unit, events = read_events(args.log)
+    json.dump(convert(unit, events, symbols, args.freq), args.output)
+
+
+if __name__ == "__main__":
+    main()
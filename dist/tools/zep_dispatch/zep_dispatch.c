@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @file
+ * @brief   ZEP hub for native instances using socket_zep
+ *
+ * Every ZEP datagram received is forwarded to the other nodes. Nodes are
+ * learned from the datagrams they send, and named by their UDP port. With a
+ * topology file, frames are only forwarded along the links given there, and
+ * dropped with the link's loss probability.
+ */
+
+#include <errno.h>
+#include <netdb.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#define MAX_NODES           (256U)
+#define MAX_LINKS           (4096U)
+#define BUF_SIZE            (256U)
+
+/* offsets in the ZEPv2 data header */
+#define ZEP_VERSION         (2U)
+#define ZEP_TYPE            (3U)
+#define ZEP_LQI_VAL         (8U)
+#define ZEP_V2_HDR_LEN      (32U)
+#define ZEP_V2_TYPE_DATA    (1U)
+
+typedef struct {
+    struct sockaddr_storage addr;
+    socklen_t addr_len;
+    unsigned port;
+} node_t;
+
+typedef struct {
+    unsigned from;          /* port of the sending node */
+    unsigned to;            /* port of the receiving node */
+    double loss;            /* probability a frame is lost */
+} link_t;
+
+static node_t _nodes[MAX_NODES];
+static unsigned _nodes_numof;
+static link_t _links[MAX_LINKS];
+static unsigned _links_numof;
+static bool _use_topology;
+static bool _verbose;
+
+/* xorshift64*, the drops only need to be reproducible */
+static uint64_t _rng_state = 1;
+
+static double _random(void)
+{
+    _rng_state ^= _rng_state >> 12;
+    _rng_state ^= _rng_state << 25;
+    _rng_state ^= _rng_state >> 27;
+    return ((_rng_state * 2685821657736338717ULL) >> 11) *
+           (1.0 / 9007199254740992.0);
+}
+
+static unsigned _port(const struct sockaddr_storage *addr)
+{
+    if (addr->ss_family == AF_INET6) {
+        return ntohs(((const struct sockaddr_in6 *)addr)->sin6_port);
+    }
+    return ntohs(((const struct sockaddr_in *)addr)->sin_port);
+}
+
+static node_t *_node(const struct sockaddr_storage *addr, socklen_t addr_len)
+{
+    for (unsigned i = 0; i < _nodes_numof; i++) {
+        if ((_nodes[i].addr_len == addr_len) &&
+            (memcmp(&_nodes[i].addr, addr, addr_len) == 0)) {
+            return &_nodes[i];
+        }
+    }
+    if (_nodes_numof == MAX_NODES) {
+        fprintf(stderr, "too many nodes, ignoring port %u\n", _port(addr));
+        return NULL;
+    }
+
+    node_t *node = &_nodes[_nodes_numof++];
+
+    memcpy(&node->addr, addr, addr_len);
+    node->addr_len = addr_len;
+    node->port = _port(addr);
+    if (_verbose) {
+        printf("new node %u\n", node->port);
+    }
+    return node;
+}
+
+static const link_t *_link(unsigned from, unsigned to)
+{
+    for (unsigned i = 0; i < _links_numof; i++) {
+        if ((_links[i].from == from) && (_links[i].to == to)) {
+            return &_links[i];
+        }
+    }
+    return NULL;
+}
+
+static int _add_link(unsigned from, unsigned to, double loss)
+{
+    if (_links_numof == MAX_LINKS) {
+        return -1;
+    }
+    _links[_links_numof].from = from;
+    _links[_links_numof].to = to;
+    _links[_links_numof].loss = loss;
+    _links_numof++;
+    return 0;
+}
+
+static int _read_topology(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[128];
+    unsigned lineno = 0;
+
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), file)) {
+        unsigned a, b;
+        double loss_ab = 0, loss_ba;
+
+        lineno++;
+        char *comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+
+        int n = sscanf(line, "%u %u %lf %lf", &a, &b, &loss_ab, &loss_ba);
+        if (n <= 0) {
+            continue;
+        }
+        if (n < 4) {
+            loss_ba = loss_ab;
+        }
+        if ((n < 2) || (loss_ab < 0) || (loss_ab > 1) || (loss_ba < 0) ||
+            (loss_ba > 1)) {
+            fprintf(stderr, "%s:%u: invalid link\n", path, lineno);
+            fclose(file);
+            return -1;
+        }
+        if ((_add_link(a, b, loss_ab) < 0) || (_add_link(b, a, loss_ba) < 0)) {
+            fprintf(stderr, "%s:%u: too many links\n", path, lineno);
+            fclose(file);
+            return -1;
+        }
+    }
+    fclose(file);
+    _use_topology = true;
+    return 0;
+}
+
+static void _forward(int sock, const node_t *src, uint8_t *buf, size_t len)
+{
+    bool is_data = (len >= ZEP_V2_HDR_LEN) && (buf[0] == 'E') &&
+                   (buf[1] == 'X') && (buf[ZEP_VERSION] == 2) &&
+                   (buf[ZEP_TYPE] == ZEP_V2_TYPE_DATA);
+
+    for (unsigned i = 0; i < _nodes_numof; i++) {
+        const node_t *dst = &_nodes[i];
+
+        if (dst == src) {
+            continue;
+        }
+        if (_use_topology) {
+            const link_t *link = _link(src->port, dst->port);
+
+            if ((link == NULL) || (_random() < link->loss)) {
+                continue;
+            }
+            if (is_data) {
+                /* the receiver reports the quality of the link as LQI */
+                buf[ZEP_LQI_VAL] = (uint8_t)((1.0 - link->loss) * 255 + 0.5);
+            }
+        }
+        if (sendto(sock, buf, len, 0, (const struct sockaddr *)&dst->addr,
+                   dst->addr_len) < 0) {
+            perror("sendto");
+        }
+    }
+}
+
+static void _usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-t <topology>] [-s <seed>] [-v] "
+            "<address> <port>\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:s:v")) != -1) {
+        switch (opt) {
+            case 't':
+                if (_read_topology(optarg) < 0) {
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 's':
+                _rng_state = strtoull(optarg, NULL, 0);
+                if (_rng_state == 0) {
+                    /* xorshift does not leave the all zero state */
+                    _rng_state = 1;
+                }
+                break;
+            case 'v':
+                _verbose = true;
+                break;
+            default:
+                _usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (argc - optind != 2) {
+        _usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    struct addrinfo hints = {
+        .ai_family = AF_UNSPEC,
+        .ai_socktype = SOCK_DGRAM,
+        .ai_flags = AI_NUMERICHOST,
+    };
+    struct addrinfo *ai;
+    int res = getaddrinfo(argv[optind], argv[optind + 1], &hints, &ai);
+
+    if (res != 0) {
+        fprintf(stderr, "getaddrinfo: %s\n", gai_strerror(res));
+        return EXIT_FAILURE;
+    }
+
+    int sock = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if ((sock < 0) || (bind(sock, ai->ai_addr, ai->ai_addrlen) < 0)) {
+        perror("socket");
+        freeaddrinfo(ai);
+        return EXIT_FAILURE;
+    }
+    freeaddrinfo(ai);
+
+    while (1) {
+        uint8_t buf[BUF_SIZE];
+        struct sockaddr_storage addr;
+        socklen_t addr_len = sizeof(addr);
+        ssize_t len = recvfrom(sock, buf, sizeof(buf), 0,
+                               (struct sockaddr *)&addr, &addr_len);
+
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("recvfrom");
+            break;
+        }
+
+        node_t *src = _node(&addr, addr_len);
+        if (src != NULL) {
+            _forward(sock, src, buf, len);
+        }
+    }
+
+    close(sock);
+    return EXIT_FAILURE;
+}
@@ -37,6 +37,16 @@
 #include "debug.h"
 
 
+#ifdef MODULE_ENERGY
+static const uint32_t _energy_ua[ENERGY_NETDEV_STATES] = AT86RF2XX_ENERGY_UA;
+static const energy_model_t _energy_model = {
+    .name = "at86rf2xx",
+    .state_names = energy_netdev_state_names,
+    .current_ua = _energy_ua,
+    .numof = ENERGY_NETDEV_STATES,
+};
+#endif
+
 void at86rf2xx_setup(at86rf2xx_t *dev, const at86rf2xx_params_t *params)
 {
     netdev_t *netdev = (netdev_t *)dev;
@@ -49,6 +59,9 @@ void at86rf2xx_setup(at86rf2xx_t *dev, const at86rf2xx_params_t *params)
     /* radio state is P_ON when first powered-on */
     dev->state = AT86RF2XX_STATE_P_ON;
     dev->pending_tx = 0;
+#ifdef MODULE_ENERGY
+    energy_netdev_init(&dev->energy, &_energy_model);
+#endif
 }
 
 void at86rf2xx_reset(at86rf2xx_t *dev)
@@ -469,6 +469,32 @@ void at86rf2xx_set_option(at86rf2xx_t *dev, uint16_t option, bool state)
  * @param cmd       command to initiate state transition
  */
 
+static inline void _account(at86rf2xx_t *dev)
+{
+#ifdef MODULE_ENERGY
+    netopt_state_t state;
+
+    switch (dev->state) {
+        case AT86RF2XX_STATE_SLEEP:
+            state = NETOPT_STATE_SLEEP;
+            break;
+        case AT86RF2XX_STATE_TRX_OFF:
+            state = NETOPT_STATE_STANDBY;
+            break;
+        case AT86RF2XX_STATE_PLL_ON:
+        case AT86RF2XX_STATE_TX_ARET_ON:
+            state = NETOPT_STATE_TX;
+            break;
+        default:
+            state = NETOPT_STATE_IDLE;
+            break;
+    }
+    energy_netdev_set(&dev->energy, state);
+#else
+    (void)dev;
+#endif
+}
+
 static inline void _set_state(at86rf2xx_t *dev, uint8_t state, uint8_t cmd)
 {
     at86rf2xx_reg_write(dev, AT86RF2XX_REG__TRX_STATE, cmd);
@@ -489,6 +515,7 @@ static inline void _set_state(at86rf2xx_t *dev, uint8_t state, uint8_t cmd)
     }
 
     dev->state = state;
+    _account(dev);
 }
 
 uint8_t at86rf2xx_set_state(at86rf2xx_t *dev, uint8_t state)
@@ -524,6 +551,7 @@ uint8_t at86rf2xx_set_state(at86rf2xx_t *dev, uint8_t state)
             /* Go to SLEEP mode from TRX_OFF */
             gpio_set(dev->params.sleep_pin);
             dev->state = state;
+            _account(dev);
         }
         else {
             if (old_state == AT86RF2XX_STATE_SLEEP) {
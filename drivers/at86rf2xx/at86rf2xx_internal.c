@@ -128,6 +128,9 @@ void at86rf2xx_assert_awake(at86rf2xx_t *dev)
             dev->state = at86rf2xx_reg_read(dev, AT86RF2XX_REG__TRX_STATUS)
                          & AT86RF2XX_TRX_STATUS_MASK__TRX_STATUS;
         } while (dev->state != AT86RF2XX_TRX_STATUS__TRX_OFF);
+#ifdef MODULE_ENERGY
+        energy_netdev_set(&dev->energy, NETOPT_STATE_STANDBY);
+#endif
     }
 }
 
@@ -147,6 +150,9 @@ void at86rf2xx_hardware_reset(at86rf2xx_t *dev)
                      & AT86RF2XX_TRX_STATUS_MASK__TRX_STATUS;
     } while ((dev->state != AT86RF2XX_STATE_TRX_OFF)
              && (dev->state != AT86RF2XX_STATE_P_ON));
+#ifdef MODULE_ENERGY
+    energy_netdev_set(&dev->energy, NETOPT_STATE_STANDBY);
+#endif
 }
 
 void at86rf2xx_configure_phy(at86rf2xx_t *dev)
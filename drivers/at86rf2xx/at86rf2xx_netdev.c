@@ -44,6 +44,7 @@
 
 static int _send(netdev_t *netdev, const iolist_t *iolist);
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info);
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info);
 static int _init(netdev_t *netdev);
 static void _isr(netdev_t *netdev);
 static int _get(netdev_t *netdev, netopt_t opt, void *val, size_t max_len);
@@ -56,6 +57,7 @@ const netdev_driver_t at86rf2xx_driver = {
     .isr = _isr,
     .get = _get,
     .set = _set,
+    .recv_iolist = _recv_iolist,
 };
 
 static void _irq_handler(void *arg)
@@ -98,26 +100,41 @@ static int _init(netdev_t *netdev)
 static int _send(netdev_t *netdev, const iolist_t *iolist)
 {
     at86rf2xx_t *dev = (at86rf2xx_t *)netdev;
-    size_t len = 0;
+    size_t len = iolist_size(iolist);
+
+    /* current packet data + FCS too long */
+    if ((len + IEEE802154_FCS_LEN) > AT86RF2XX_MAX_PKT_LENGTH) {
+        DEBUG("[at86rf2xx] error: packet too large (%u byte) to be send\n",
+              (unsigned)len + IEEE802154_FCS_LEN);
+        return -EOVERFLOW;
+    }
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.tx_bytes += len;
+#endif
 
     at86rf2xx_tx_prepare(dev);
 
     /* load packet data into FIFO */
+    bool started = false;
+    size_t offset = 0;
     for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
-        /* current packet data + FCS too long */
-        if ((len + iol->iol_len + 2) > AT86RF2XX_MAX_PKT_LENGTH) {
-            DEBUG("[at86rf2xx] error: packet too large (%u byte) to be send\n",
-                  (unsigned)len + 2);
-            return -EOVERFLOW;
+        offset = at86rf2xx_tx_load(dev, iol->iol_base, iol->iol_len, offset);
+#if AT86RF2XX_PIPELINED_TX
+        if ((iol == iolist) && (iol->iol_next != NULL) &&
+            !(dev->flags & AT86RF2XX_OPT_PRELOADING)) {
+            /* start sending, the rest is uploaded while the frame's head
+             * is on the air */
+            dev->tx_frame_len = (uint8_t)(len + IEEE802154_FCS_LEN);
+            at86rf2xx_tx_exec(dev);
+            started = true;
         }
-#ifdef MODULE_NETSTATS_L2
-        netdev->stats.tx_bytes += len;
 #endif
-        len = at86rf2xx_tx_load(dev, iol->iol_base, iol->iol_len, len);
     }
+    /* at86rf2xx_tx_load() kept adding up after an early start */
+    dev->tx_frame_len = (uint8_t)(len + IEEE802154_FCS_LEN);
 
     /* send data out directly if pre-loading id disabled */
-    if (!(dev->flags & AT86RF2XX_OPT_PRELOADING)) {
+    if (!(dev->flags & AT86RF2XX_OPT_PRELOADING) && !started) {
         at86rf2xx_tx_exec(dev);
     }
     /* return the number of bytes that were actually loaded into the frame
@@ -125,11 +142,9 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
     return (int)len;
 }
 
-static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+static size_t _fb_start_frame(at86rf2xx_t *dev)
 {
-    at86rf2xx_t *dev = (at86rf2xx_t *)netdev;
     uint8_t phr;
-    size_t pkt_len;
 
     /* frame buffer protection will be unlocked as soon as at86rf2xx_fb_stop() is called,
      * Set receiver to PLL_ON state to be able to free the SPI bus and avoid loosing data. */
@@ -142,10 +157,17 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     at86rf2xx_fb_read(dev, &phr, 1);
 
     /* ignore MSB (refer p.80) and substract length of FCS field */
-    pkt_len = (phr & 0x7f) - 2;
+    return (phr & 0x7f) - 2;
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    at86rf2xx_t *dev = (at86rf2xx_t *)netdev;
 
     /* return length when buf == NULL */
     if (buf == NULL) {
+        size_t pkt_len = _fb_start_frame(dev);
+
         /* release SPI bus */
         at86rf2xx_fb_stop(dev);
 
@@ -159,8 +181,21 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
         return pkt_len;
     }
 
-    /* not enough space in buf */
-    if (pkt_len > len) {
+    iolist_t iolist = {
+        .iol_next = NULL,
+        .iol_base = buf,
+        .iol_len = len,
+    };
+    return _recv_iolist(netdev, &iolist, info);
+}
+
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    at86rf2xx_t *dev = (at86rf2xx_t *)netdev;
+    size_t pkt_len = _fb_start_frame(dev);
+
+    /* not enough space in iolist */
+    if (pkt_len > iolist_size(iolist)) {
         at86rf2xx_fb_stop(dev);
         /* set device back in operation state which was used before last transmission.
          * This state is saved in at86rf2xx.c/at86rf2xx_tx_prepare() e.g RX_AACK_ON */
@@ -171,8 +206,16 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     netdev->stats.rx_count++;
     netdev->stats.rx_bytes += pkt_len;
 #endif
-    /* copy payload */
-    at86rf2xx_fb_read(dev, (uint8_t *)buf, pkt_len);
+    /* copy payload, the frame buffer read continues where the last one
+     * stopped, so each io vector is filled directly */
+    size_t left = pkt_len;
+    for (const iolist_t *iol = iolist; left && iol; iol = iol->iol_next) {
+        size_t chunk = (iol->iol_len < left) ? iol->iol_len : left;
+        if (chunk) {
+            at86rf2xx_fb_read(dev, iol->iol_base, chunk);
+            left -= chunk;
+        }
+    }
 
     /* Ignore FCS but advance fb read - we must give a temporary buffer here,
      * as we are not allowed to issue SPI transfers without any buffer */
@@ -35,6 +35,8 @@
 static int read_calibration_data(bmx280_t* dev);
 static int do_measurement(const bmx280_t* dev);
 static uint8_t get_ctrl_meas(const bmx280_t* dev);
+static uint8_t ctrl_meas_config(const bmx280_t* dev);
+static int16_t compensate_temperature(const bmx280_t* dev);
 static uint8_t get_status(const bmx280_t* dev);
 static uint8_t read_u8_reg(const bmx280_t* dev, uint8_t reg);
 static void write_u8_reg(const bmx280_t* dev, uint8_t reg, uint8_t b);
@@ -98,6 +100,14 @@ int16_t bmx280_read_temperature(const bmx280_t* dev)
         return INT16_MIN;
     }
 
+    return compensate_temperature(dev);
+}
+
+/*
+ * Compensates the temperature in measurement_regs, sets t_fine
+ */
+static int16_t compensate_temperature(const bmx280_t* dev)
+{
     const bmx280_calibration_t *cal = &dev->calibration; /* helper variable */
 
     /* Read the uncompensated temperature */
@@ -280,10 +290,7 @@ static int read_calibration_data(bmx280_t* dev)
     write_u8_reg(dev, BME280_CTRL_HUMIDITY_REG, b);
 #endif
 
-    b = ((dev->params.temp_oversample & 7) << 5) |
-        ((dev->params.press_oversample & 7) << 2) |
-        (dev->params.run_mode & 3);
-    write_u8_reg(dev, BMX280_CTRL_MEAS_REG, b);
+    write_u8_reg(dev, BMX280_CTRL_MEAS_REG, ctrl_meas_config(dev));
 
     return 0;
 }
@@ -335,6 +342,13 @@ static uint8_t get_ctrl_meas(const bmx280_t* dev)
     return read_u8_reg(dev, BMX280_CTRL_MEAS_REG);
 }
 
+static uint8_t ctrl_meas_config(const bmx280_t* dev)
+{
+    return ((dev->params.temp_oversample & 7) << 5) |
+           ((dev->params.press_oversample & 7) << 2) |
+           (dev->params.run_mode & 3);
+}
+
 static uint8_t get_status(const bmx280_t* dev)
 {
     return read_u8_reg(dev, BMX280_STAT_REG);
@@ -368,6 +382,62 @@ static int16_t get_int16_le(const uint8_t *buffer, size_t offset)
     return (((int16_t)buffer[offset + 1]) << 8) + buffer[offset];
 }
 
+#ifdef MODULE_I2C_ASYNC
+void bmx280_trigger_async(const bmx280_t *dev, bmx280_async_t *req,
+                          i2c_async_cb_t cb, void *arg)
+{
+    /* writing ctrl_meas starts a new measurement in FORCED mode */
+    req->ctrl_meas = ctrl_meas_config(dev);
+    req->op.type = I2C_ASYNC_WRITE_REGS;
+    req->op.reg = BMX280_CTRL_MEAS_REG;
+    req->op.data = &req->ctrl_meas;
+    req->op.len = 1;
+    req->op.flags = 0;
+    i2c_async_init(&req->req, dev->params.i2c_addr, &req->op, 1, cb, arg);
+    i2c_async_submit(dev->params.i2c_dev, &req->req);
+}
+
+void bmx280_read_async(const bmx280_t *dev, bmx280_async_t *req,
+                       i2c_async_cb_t cb, void *arg)
+{
+    req->op.type = I2C_ASYNC_READ_REGS;
+    req->op.reg = BMX280_PRESSURE_MSB_REG;
+    req->op.data = req->regs;
+    req->op.len = sizeof(req->regs);
+    req->op.flags = 0;
+    i2c_async_init(&req->req, dev->params.i2c_addr, &req->op, 1, cb, arg);
+    i2c_async_submit(dev->params.i2c_dev, &req->req);
+}
+
+int bmx280_async_results(const bmx280_t *dev, const bmx280_async_t *req,
+                         int16_t *temp, uint32_t *press, uint16_t *hum)
+{
+    if (req->req.res < 0) {
+        LOG_ERROR("Unable to read temperature data\n");
+        return BMX280_ERR_I2C;
+    }
+    memcpy(measurement_regs, req->regs, sizeof(measurement_regs));
+    DUMP_BUFFER("Raw Sensor Data", measurement_regs, sizeof(measurement_regs));
+
+    /* temperature first, it sets t_fine */
+    int16_t t = compensate_temperature(dev);
+    if (temp) {
+        *temp = t;
+    }
+    if (press) {
+        *press = bmx280_read_pressure(dev);
+    }
+#if defined(MODULE_BME280)
+    if (hum) {
+        *hum = bme280_read_humidity(dev);
+    }
+#else
+    (void)hum;
+#endif
+    return BMX280_OK;
+}
+#endif /* MODULE_I2C_ASYNC */
+
 #if ENABLE_DEBUG
 static void dump_buffer(const char *txt, uint8_t *buffer, size_t size)
 {
@@ -60,6 +60,8 @@ const char *cc110x_state_to_text(uint8_t state)
         return "rx busy";
     case RADIO_PWD:
         return "pwd";
+    case RADIO_WOR:
+        return "wor";
     case RADIO_UNKNOWN:
         return "unknown";
     }
@@ -89,6 +91,41 @@ static void _rx_start(cc110x_t *dev)
     gpio_irq_enable(dev->params.gdo2);
 }
 
+static void _rx_done(cc110x_t *dev, const uint8_t *status,
+                     void(*callback)(void*), void*arg)
+{
+    cc110x_pkt_buf_t *pkt_buf = &dev->pkt_buf;
+
+    /* Store RSSI value of packet */
+    pkt_buf->rssi = status[I_RSSI];
+
+    /* Bit 0-6 of LQI indicates the link quality (LQI) */
+    pkt_buf->lqi = status[I_LQI] & LQI_EST;
+
+    /* MSB of LQI is the CRC_OK bit */
+    int crc_ok = (status[I_LQI] & CRC_OK) >> 7;
+
+    if (crc_ok) {
+        LOG_DEBUG("cc110x: received packet from=%u to=%u payload len=%u\n",
+                  (unsigned)pkt_buf->packet.phy_src,
+                  (unsigned)pkt_buf->packet.address,
+                  pkt_buf->packet.length - 3);
+        /* let someone know that we've got a packet */
+        callback(arg);
+
+        cc110x_switch_to_rx(dev);
+    }
+    else {
+        DEBUG("%s:%s:%u crc-error\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
+        dev->cc110x_statistic.packets_in_crc_fail++;
+#if defined(MODULE_OD) && ENABLE_DEBUG
+        od_hex_dump(pkt_buf->packet.data, pkt_buf->packet.length - 3,
+                    OD_WIDTH_DEFAULT);
+#endif
+        _rx_abort(dev);
+    }
+}
+
 static void _rx_read_data(cc110x_t *dev, void(*callback)(void*), void*arg)
 {
     int fifo = cc110x_get_reg_robust(dev, 0xfb);
@@ -108,19 +145,35 @@ static void _rx_read_data(cc110x_t *dev, void(*callback)(void*), void*arg)
     if (!pkt_buf->pos) {
         pkt_buf->pos = 1;
         pkt_buf->packet.length = cc110x_read_reg(dev, CC110X_RXFIFO);
+        fifo--;
 
         /* Possible packet received, RX -> IDLE (0.1 us) */
         dev->cc110x_statistic.packets_in++;
+
+        if (pkt_buf->packet.length >= sizeof(cc110x_pkt_t)) {
+            DEBUG("%s:%s:%u oversized packet\n", RIOT_FILE_RELATIVE, __func__,
+                  __LINE__);
+            _rx_abort(dev);
+            return;
+        }
     }
 
     int left = pkt_buf->packet.length+1 - pkt_buf->pos;
 
+    if (fifo >= left + 2) {
+        /* the rest of the packet and the 2 appended status bytes are in the
+         * fifo: get them in one burst, the status bytes end up right behind
+         * the packet */
+        uint8_t *pos = ((uint8_t *)&pkt_buf->packet) + pkt_buf->pos;
+        cc110x_readburst_reg(dev, CC110X_RXFIFO, (char *)pos, left + 2);
+        pkt_buf->pos += left;
+        _rx_done(dev, pos + left, callback, arg);
+        return;
+    }
+
     /* if the fifo doesn't contain the rest of the packet,
      * leav at least one byte as per spec sheet. */
-    int to_read = (fifo < left) ? (fifo-1) : fifo;
-    if (to_read > left) {
-        to_read = left;
-    }
+    int to_read = (fifo < left) ? (fifo-1) : left;
 
     if (to_read) {
         cc110x_readburst_reg(dev, CC110X_RXFIFO,
@@ -133,35 +186,7 @@ static void _rx_read_data(cc110x_t *dev, void(*callback)(void*), void*arg)
         /* full packet received. */
         /* Read the 2 appended status bytes (status[0] = RSSI, status[1] = LQI) */
         cc110x_readburst_reg(dev, CC110X_RXFIFO, (char *)status, 2);
-
-        /* Store RSSI value of packet */
-        pkt_buf->rssi = status[I_RSSI];
-
-        /* Bit 0-6 of LQI indicates the link quality (LQI) */
-        pkt_buf->lqi = status[I_LQI] & LQI_EST;
-
-        /* MSB of LQI is the CRC_OK bit */
-        int crc_ok = (status[I_LQI] & CRC_OK) >> 7;
-
-        if (crc_ok) {
-            LOG_DEBUG("cc110x: received packet from=%u to=%u payload len=%u\n",
-                      (unsigned)pkt_buf->packet.phy_src,
-                      (unsigned)pkt_buf->packet.address,
-                      pkt_buf->packet.length - 3);
-            /* let someone know that we've got a packet */
-            callback(arg);
-
-            cc110x_switch_to_rx(dev);
-        }
-        else {
-            DEBUG("%s:%s:%u crc-error\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
-            dev->cc110x_statistic.packets_in_crc_fail++;
-#if defined(MODULE_OD) && ENABLE_DEBUG
-            od_hex_dump(pkt_buf->packet.data, pkt_buf->packet.length - 3,
-                        OD_WIDTH_DEFAULT);
-#endif
-            _rx_abort(dev);
-        }
+        _rx_done(dev, status, callback, arg);
     }
 }
 
@@ -203,18 +228,24 @@ static void _tx_continue(cc110x_t *dev)
         return;
     }
 
-    int fifo = CC110X_FIFO_LENGTH - cc110x_get_reg_robust(dev, 0xfa);
+    int fifo = CC110X_FIFO_LENGTH;
 
-    if (fifo & TXFIFO_UNDERFLOW) {
-        DEBUG("%s:%s:%u tx underflow!\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
-        _tx_abort(dev);
-        return;
-    }
+    /* the fifo was flushed by cc110x_send(), only ask for the free space
+     * when refilling */
+    if (left != size) {
+        fifo -= cc110x_get_reg_robust(dev, 0xfa);
 
-    if (!fifo) {
-        DEBUG("%s:%s:%u fifo full!?\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
-        _tx_abort(dev);
-        return;
+        if (fifo & TXFIFO_UNDERFLOW) {
+            DEBUG("%s:%s:%u tx underflow!\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
+            _tx_abort(dev);
+            return;
+        }
+
+        if (!fifo) {
+            DEBUG("%s:%s:%u fifo full!?\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
+            _tx_abort(dev);
+            return;
+        }
     }
 
     int to_send = left > fifo ? fifo : left;
@@ -229,10 +260,9 @@ static void _tx_continue(cc110x_t *dev)
     }
 
     if (to_send < left) {
-        /* set GDO2 to 0x2 -> will deassert at TX FIFO below threshold */
+        /* GDO2 is still set to 0x2 by cc110x_send() -> will deassert at TX
+         * FIFO below threshold */
         gpio_irq_enable(dev->params.gdo2);
-        cc110x_write_reg(dev, CC110X_IOCFG2,
-                         CC110X_GDO_LOW_ON_TX_FIFO_BELOW_THRESHOLD);
     }
     else {
         /* set GDO2 to 0x6 -> will deassert at packet end */
@@ -245,6 +275,7 @@ void cc110x_isr_handler(cc110x_t *dev, void(*callback)(void*), void*arg)
 {
     switch (dev->radio_state) {
         case RADIO_RX:
+        case RADIO_WOR:
             if (gpio_read(dev->params.gdo2)) {
                 _rx_start(dev);
             }
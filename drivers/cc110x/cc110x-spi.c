@@ -50,6 +50,16 @@ static inline void lock(cc110x_t *dev)
 void cc110x_cs(cc110x_t *dev)
 {
     volatile int retry_count = 0;
+
+    /* SO only has to be polled while the crystal may be off: before the
+     * device was set up, in power down and while sleeping in wake-on-radio */
+    if ((dev->radio_state != RADIO_UNKNOWN) &&
+        (dev->radio_state != RADIO_PWD) &&
+        (dev->radio_state != RADIO_WOR)) {
+        gpio_clear(dev->params.cs);
+        return;
+    }
+
     /* Switch MISO/GDO1 to GPIO input mode */
 #ifndef GPIO_READS_SPI_PINS
     gpio_init(dev->params.gdo1, GPIO_IN);
@@ -95,18 +105,12 @@ void cc110x_writeburst_reg(cc110x_t *dev, uint8_t addr, const char *src, uint8_t
 
 void cc110x_readburst_reg(cc110x_t *dev, uint8_t addr, char *buffer, uint8_t count)
 {
-    int i = 0;
     unsigned int cpsr;
     lock(dev);
     cpsr = irq_disable();
     cc110x_cs(dev);
-    spi_transfer_byte(dev->params.spi, SPI_CS_UNDEF, false,
-                      (addr | CC110X_READ_BURST));
-    while (i < count) {
-        buffer[i] = (char)spi_transfer_byte(dev->params.spi, SPI_CS_UNDEF,
-                                            false, CC110X_NOBYTE);
-        i++;
-    }
+    spi_transfer_regs(dev->params.spi, SPI_CS_UNDEF,
+                      (addr | CC110X_READ_BURST), NULL, buffer, count);
     gpio_set(dev->params.cs);
     irq_restore(cpsr);
     spi_release(dev->params.spi);
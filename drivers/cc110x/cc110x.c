@@ -53,6 +53,8 @@ int cc110x_setup(cc110x_t *dev, const cc110x_params_t *params)
 #endif
 
     dev->params = *params;
+    dev->radio_state = RADIO_UNKNOWN;
+    dev->wor = false;
 
     /* Configure chip-select */
     spi_init_cs(dev->params.spi, dev->params.cs);
@@ -65,12 +67,12 @@ int cc110x_setup(cc110x_t *dev, const cc110x_params_t *params)
     _power_up_reset(dev);
 #endif
 
-    /* set default state */
-    dev->radio_state = RADIO_IDLE;
-
     /* Write configuration to configuration registers */
     cc110x_writeburst_reg(dev, 0x00, cc110x_default_conf, cc110x_default_conf_size);
 
+    /* set default state, from now on the crystal is known to be running */
+    dev->radio_state = RADIO_IDLE;
+
     /* Write PATABLE (power settings) */
     cc110x_writeburst_reg(dev, CC110X_PATABLE, CC110X_DEFAULT_PATABLE, 8);
 
@@ -130,11 +132,33 @@ void cc110x_setup_rx_mode(cc110x_t *dev)
 {
     DEBUG("%s:%s:%u\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
 
-    /* Stay in RX mode until end of packet */
-    cc110x_write_reg(dev, CC110X_MCSM2, 0x07);
+    if (dev->wor) {
+        /* leave RX early if no carrier is sensed, poll with EVENT1 = 7,
+         * calibrate the RC oscillator and leave it on */
+        cc110x_write_reg(dev, CC110X_MCSM2, 0x10 | CC110X_WOR_RX_TIME);
+        cc110x_write_reg(dev, CC110X_WOREVT1, CC110X_WOR_EVENT0 >> 8);
+        cc110x_write_reg(dev, CC110X_WOREVT0, CC110X_WOR_EVENT0 & 0xff);
+        cc110x_write_reg(dev, CC110X_WORCTRL, 0x78);
+    }
+    else {
+        /* Stay in RX mode until end of packet */
+        cc110x_write_reg(dev, CC110X_MCSM2, 0x07);
+    }
     cc110x_switch_to_rx(dev);
 }
 
+void cc110x_set_wor(cc110x_t *dev, bool enable)
+{
+    uint8_t old_state = dev->radio_state;
+
+    cc110x_wakeup_from_rx(dev);
+    dev->wor = enable;
+    /* reconfigure the receiver if it was listening */
+    if ((old_state == RADIO_RX) || (old_state == RADIO_WOR)) {
+        cc110x_setup_rx_mode(dev);
+    }
+}
+
 void cc110x_switch_to_rx(cc110x_t *dev)
 {
     DEBUG("%s:%s:%u\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
@@ -149,17 +173,23 @@ void cc110x_switch_to_rx(cc110x_t *dev)
     cc110x_strobe(dev, CC110X_SIDLE);
     cc110x_strobe(dev, CC110X_SFRX);
 
-    dev->radio_state = RADIO_RX;
-
     cc110x_write_reg(dev, CC110X_IOCFG2, CC110X_GDO_HIGH_ON_SYNC_WORD);
-    cc110x_strobe(dev, CC110X_SRX);
+    if (dev->wor) {
+        cc110x_strobe(dev, CC110X_SWORRST);
+        cc110x_strobe(dev, CC110X_SWOR);
+        dev->radio_state = RADIO_WOR;
+    }
+    else {
+        cc110x_strobe(dev, CC110X_SRX);
+        dev->radio_state = RADIO_RX;
+    }
 
     gpio_irq_enable(dev->params.gdo2);
 }
 
 void cc110x_wakeup_from_rx(cc110x_t *dev)
 {
-    if (dev->radio_state != RADIO_RX) {
+    if ((dev->radio_state != RADIO_RX) && (dev->radio_state != RADIO_WOR)) {
         return;
     }
 
@@ -229,7 +259,7 @@ void cc110x_write_register(cc110x_t *dev, uint8_t r, uint8_t value)
 
     /* Have to put radio back to RX if old radio state
      * was RX, otherwise no action is necessary */
-    if (old_state == RADIO_RX) {
+    if ((old_state == RADIO_RX) || (old_state == RADIO_WOR)) {
         cc110x_switch_to_rx(dev);
     }
 }
@@ -57,6 +57,14 @@ extern "C" {
                                                  after CS */
 #define CC110X_GDO1_LOW_RETRY       (100)   /**< Max. retries for SO to go low
                                                  after CS */
+#ifndef CC110X_WOR_EVENT0
+#define CC110X_WOR_EVENT0           (0x876B) /**< wake-on-radio polling interval
+                                                  (EVENT0), ~1s at 26MHz */
+#endif
+#ifndef CC110X_WOR_RX_TIME
+#define CC110X_WOR_RX_TIME          (0x03)  /**< wake-on-radio RX timeout
+                                                 (MCSM2.RX_TIME) */
+#endif
 #ifndef CC110X_DEFAULT_CHANNEL
 #define CC110X_DEFAULT_CHANNEL      (0)     /**< The default channel number */
 #endif
@@ -74,6 +82,7 @@ enum {
     RADIO_RX,
     RADIO_RX_BUSY,
     RADIO_PWD,
+    RADIO_WOR,
 };
 /** @} */
 
@@ -122,6 +131,10 @@ typedef struct {
     uint8_t lqi;                            /**< link quality indicator */
     uint8_t pos;                            /**< I have no clue. */
     cc110x_pkt_t packet;                    /**< whole packet */
+    uint8_t status_room[2];                 /**< room for the appended status
+                                                 bytes of a full size packet,
+                                                 they are read together with
+                                                 the packet */
 } cc110x_pkt_buf_t;
 
 /**
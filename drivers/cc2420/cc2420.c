@@ -33,6 +33,16 @@
 #include "debug.h"
 
 
+#ifdef MODULE_ENERGY
+static const uint32_t _energy_ua[ENERGY_NETDEV_STATES] = CC2420_ENERGY_UA;
+static const energy_model_t _energy_model = {
+    .name = "cc2420",
+    .state_names = energy_netdev_state_names,
+    .current_ua = _energy_ua,
+    .numof = ENERGY_NETDEV_STATES,
+};
+#endif
+
 void cc2420_setup(cc2420_t * dev, const cc2420_params_t *params)
 {
     /* set pointer to the devices netdev functions */
@@ -42,6 +52,9 @@ void cc2420_setup(cc2420_t * dev, const cc2420_params_t *params)
     dev->state = CC2420_STATE_IDLE;
     /* reset device descriptor fields */
     dev->options = 0;
+#ifdef MODULE_ENERGY
+    energy_netdev_init(&dev->energy, &_energy_model);
+#endif
 }
 
 int cc2420_init(cc2420_t *dev)
@@ -287,6 +287,13 @@ int cc2420_set_state(cc2420_t *dev, netopt_state_t cmd)
             DEBUG("cc2420: set_state: called with invalid target state\n");
             return -ENOTSUP;
     }
+#ifdef MODULE_ENERGY
+    /* the radio returns to listening after sending by itself, and draws
+     * about the same current while sending, so TX is accounted as idle */
+    if (cmd <= NETOPT_STATE_IDLE) {
+        energy_netdev_set(&dev->energy, cmd);
+    }
+#endif
     return sizeof(netopt_state_t);
 }
 
@@ -64,12 +64,16 @@
  * @brief   Buffer configuration
  *
  * We use the split the buffer in the following way:
- * - RX: 6k [0x0000 to 0x17fe]
- * - TX: 2k [0x1800 to 0x1ffe]
+ * - RX: 5k [0x0000 to 0x13ff]
+ * - TX: 2 x 1.5k [0x1400 to 0x19ff and 0x1a00 to 0x1fff]
+ *
+ * Each TX slot takes a full frame plus control byte and transmit status
+ * vector, so the next frame is uploaded while the previous one is sent.
  *
  * RX must start at buffer address 0x0000 (see errata sheet, section 5)
  */
-#define BUF_TX_START                ((BUFFER_SIZE / 4) * 3)
+#define BUF_TX_SLOT_SIZE            (0x0600)
+#define BUF_TX_START                (BUFFER_SIZE - (2 * BUF_TX_SLOT_SIZE))
 #define BUF_TX_END                  (BUFFER_SIZE - 1)
 #define BUF_RX_START                (0)
 #define BUF_RX_END                  (BUF_TX_START - 1)
@@ -83,6 +87,17 @@
  */
 #define MAX_TX_TIME                 (1230U)
 
+/**
+ * @brief   Size of the control byte and the transmit status vector that
+ *          surround a frame in the TX buffer
+ */
+#define TX_OVERHEAD                 (1U + 7U)
+
+/**
+ * @brief   Start address of a TX slot
+ */
+#define TX_SLOT(n)                  (BUF_TX_START + ((n) * BUF_TX_SLOT_SIZE))
+
 static void switch_bank(enc28j60_t *dev, int8_t bank)
 {
     /* only switch bank if needed */
@@ -165,17 +180,16 @@ static void cmd_bfc(enc28j60_t *dev, uint8_t reg, int8_t bank, uint8_t mask)
     spi_release(dev->spi);
 }
 
-static uint16_t cmd_r_addr(enc28j60_t *dev, uint8_t addr)
-{
-    uint8_t low = cmd_rcr(dev, addr, 0);
-    uint8_t high = cmd_rcr(dev, addr + 1, 0);
-    return (uint16_t)((high << 8) | low);
-}
-
 static void cmd_w_addr(enc28j60_t *dev, uint8_t addr, uint16_t val)
 {
-    cmd_wcr(dev, addr, 0, (val & 0xff));
-    cmd_wcr(dev, addr + 1, 0, (val >> 8));
+    /* both bytes in one bus session */
+    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
+
+    switch_bank(dev, 0);
+    spi_transfer_reg(dev->spi, dev->cs_pin, (CMD_WCR | addr), (val & 0xff));
+    spi_transfer_reg(dev->spi, dev->cs_pin, (CMD_WCR | (addr + 1)), (val >> 8));
+
+    spi_release(dev->spi);
 }
 
 static uint16_t cmd_r_phy(enc28j60_t *dev, uint8_t reg)
@@ -202,22 +216,18 @@ static void cmd_w_phy(enc28j60_t *dev, uint8_t reg, uint16_t val)
     while (cmd_rcr_miimac(dev, REG_B3_MISTAT, 3) & MISTAT_BUSY) {}
 }
 
-static void cmd_rbm(enc28j60_t *dev, uint8_t *data, size_t len)
+static void cmd_wbm_iolist(enc28j60_t *dev, uint8_t ctrl,
+                           const iolist_t *iolist)
 {
     /* start transaction */
     spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
-    /* transfer data */
-    spi_transfer_regs(dev->spi, dev->cs_pin, CMD_RBM, NULL, data, len);
-    /* finish SPI transaction */
-    spi_release(dev->spi);
-}
-
-static void cmd_wbm(enc28j60_t *dev, uint8_t *data, size_t len)
-{
-    /* start transaction */
-    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
-    /* transfer data */
-    spi_transfer_regs(dev->spi, dev->cs_pin, CMD_WBM, data, NULL, len);
+    /* write the control byte and all chunks in a single burst */
+    spi_transfer_byte(dev->spi, dev->cs_pin, true, CMD_WBM);
+    spi_transfer_byte(dev->spi, dev->cs_pin, (iolist != NULL), ctrl);
+    for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
+        spi_transfer_bytes(dev->spi, dev->cs_pin, (iol->iol_next != NULL),
+                           iol->iol_base, NULL, iol->iol_len);
+    }
     /* finish SPI transaction */
     spi_release(dev->spi);
 }
@@ -248,16 +258,42 @@ static void on_int(void *arg)
     netdev->event_callback(arg, NETDEV_EVENT_ISR);
 }
 
+static void tx_start(enc28j60_t *dev, uint16_t end)
+{
+    cmd_w_addr(dev, ADDR_TX_START, TX_SLOT(dev->tx_slot));
+    cmd_w_addr(dev, ADDR_TX_END, end);
+    /* trigger the send process */
+    cmd_bfs(dev, REG_ECON1, -1, ECON1_TXRTS);
+    /* set last transmission time for timeout handling */
+    dev->tx_time = xtimer_now_usec();
+}
+
+static void tx_next(enc28j60_t *dev)
+{
+    mutex_lock(&dev->devlock);
+    if (dev->tx_queued) {
+        dev->tx_slot ^= 1;
+        tx_start(dev, dev->tx_queued);
+        dev->tx_queued = 0;
+    }
+    mutex_unlock(&dev->devlock);
+}
+
 static int nd_send(netdev_t *netdev, const iolist_t *iolist)
 {
     enc28j60_t *dev = (enc28j60_t *)netdev;
-    uint8_t ctrl = 0;
-    int c = 0;
+    int c = (int)iolist_size(iolist);
+    bool busy = false;
+
+    if (c > (int)(BUF_TX_SLOT_SIZE - TX_OVERHEAD)) {
+        return -EOVERFLOW;
+    }
 
     mutex_lock(&dev->devlock);
 
     if (cmd_rcr(dev, REG_ECON1, -1) & ECON1_TXRTS) {
         /* there is already a transmission in progress */
+        busy = true;
         if (xtimer_now_usec() - dev->tx_time > MAX_TX_TIME * 2) {
             /*
              * if transmission time exceeds the double of maximum transmission
@@ -265,33 +301,32 @@ static int nd_send(netdev_t *netdev, const iolist_t *iolist)
              */
             cmd_bfs(dev, REG_ECON1, -1, ECON1_TXRST);
             cmd_bfc(dev, REG_ECON1, -1, ECON1_TXRST);
+            dev->tx_queued = 0;
+            busy = false;
         }
-        else {
+        else if (dev->tx_queued) {
             /*
              * otherwise we suppose that the transmission is still in progress
-             * and return EBUSY
+             * and, with the other slot taken as well, return EBUSY
              */
             mutex_unlock(&dev->devlock);
             return -EBUSY;
         }
     }
 
-    /* set TX start pointer */
-    cmd_w_addr(dev, ADDR_TX_START, BUF_TX_START);
-    /* set write pointer */
-    cmd_w_addr(dev, ADDR_WRITE_PTR, BUF_TX_START);
-    /* write control byte and the actual data into the buffer */
-    cmd_wbm(dev, &ctrl, 1);
-    for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
-        c += iol->iol_len;
-        cmd_wbm(dev, iol->iol_base, iol->iol_len);
+    /* upload the frame into the slot not used by the last transmission */
+    uint16_t start = TX_SLOT(dev->tx_slot ^ 1);
+    cmd_w_addr(dev, ADDR_WRITE_PTR, start);
+    cmd_wbm_iolist(dev, 0, iolist);
+
+    if (busy) {
+        /* sent from the ISR once the current transmission is done */
+        dev->tx_queued = start + c;
+    }
+    else {
+        dev->tx_slot ^= 1;
+        tx_start(dev, start + c);
     }
-    /* set TX end pointer */
-    cmd_w_addr(dev, ADDR_TX_END, cmd_r_addr(dev, ADDR_WRITE_PTR) - 1);
-    /* trigger the send process */
-    cmd_bfs(dev, REG_ECON1, -1, ECON1_TXRTS);
-    /* set last transmission time for timeout handling */
-    dev->tx_time = xtimer_now_usec();
 
 #ifdef MODULE_NETSTATS_L2
     netdev->stats.tx_bytes += c;
@@ -304,48 +339,78 @@ static int nd_send(netdev_t *netdev, const iolist_t *iolist)
 /*
  * Section 14 of errata sheet: Even values in ERXRDPT may corrupt receive
  * buffer as well as the next packet pointer. ERXRDPT need to be set always
- * at odd addresses. Following macros determine odd ERXRDPT from next packet
- * pointer and vise versa. Next packet pointer is always at even address
- * because of hardware padding.
+ * at odd addresses. Following macro determines odd ERXRDPT from the next
+ * packet pointer, which is always at even address because of hardware
+ * padding. The start of the next packet is tracked in the device descriptor,
+ * so ERXRDPT is never read back.
  */
 #define NEXT_TO_ERXRDPT(n) ((n == BUF_RX_START || n - 1 > BUF_RX_END) ? BUF_RX_END : n - 1)
-#define ERXRDPT_TO_NEXT(e) ((e >= BUF_RX_END) ? BUF_RX_START : e + 1)
 
 static int nd_recv(netdev_t *netdev, void *buf, size_t max_len, void *info)
 {
     enc28j60_t *dev = (enc28j60_t *)netdev;
-    uint8_t head[6];
+    bool reading = false;
     uint16_t size;
-    uint16_t next;
 
     (void)info;
     mutex_lock(&dev->devlock);
 
-    /* set read pointer to RX read address */
-    uint16_t rx_rd_ptr = cmd_r_addr(dev, ADDR_RX_READ);
-    cmd_w_addr(dev, ADDR_READ_PTR, ERXRDPT_TO_NEXT(rx_rd_ptr));
-    /* read packet header */
-    cmd_rbm(dev, head, 6);
-    /* TODO: care for endianess */
-    next = (uint16_t)((head[1] << 8) | head[0]);
-    size = (uint16_t)((head[3] << 8) | head[2]) - 4;  /* discard CRC */
+    if (dev->rx_len == 0) {
+        uint8_t head[6];
+
+        /* set read pointer to the header of the next packet */
+        cmd_w_addr(dev, ADDR_READ_PTR, dev->rx_ptr);
+        /* read the header, and if we got a buffer the packet right behind it
+         * in the same transaction */
+        reading = (buf != NULL);
+        spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
+        spi_transfer_byte(dev->spi, dev->cs_pin, true, CMD_RBM);
+        spi_transfer_bytes(dev->spi, dev->cs_pin, reading, NULL, head, 6);
+        /* TODO: care for endianess */
+        dev->rx_next = (uint16_t)((head[1] << 8) | head[0]);
+        dev->rx_len = (uint16_t)((head[3] << 8) | head[2]) - 4;  /* discard CRC */
+    }
+    else {
+        /* the read pointer is still behind the header */
+        spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
+    }
+    size = dev->rx_len;
 
-    if (buf != NULL) {
+    if ((buf == NULL) && (max_len == 0)) {
+        /* only the size was asked for, keep the packet */
+        spi_release(dev->spi);
+        mutex_unlock(&dev->devlock);
+        return (int)size;
+    }
+
+    if ((buf != NULL) && (size <= max_len)) {
 #ifdef MODULE_NETSTATS_L2
         netdev->stats.rx_count++;
         netdev->stats.rx_bytes += size;
 #endif
         /* read packet content into the supplied buffer */
-        if (size <= max_len) {
-            cmd_rbm(dev, (uint8_t *)buf, size);
-        } else {
+        if (!reading) {
+            spi_transfer_byte(dev->spi, dev->cs_pin, true, CMD_RBM);
+        }
+        spi_transfer_bytes(dev->spi, dev->cs_pin, false, NULL, buf, size);
+    }
+    else {
+        if (reading) {
+            /* terminate the read command */
+            spi_transfer_byte(dev->spi, dev->cs_pin, false, 0);
+        }
+        if (buf != NULL) {
             DEBUG("[enc28j60] recv: unable to get packet - buffer too small\n");
             size = 0;
         }
-        /* release memory */
-        cmd_w_addr(dev, ADDR_RX_READ, NEXT_TO_ERXRDPT(next));
-        cmd_bfs(dev, REG_ECON2, -1, ECON2_PKTDEC);
     }
+    spi_release(dev->spi);
+
+    /* release memory */
+    cmd_w_addr(dev, ADDR_RX_READ, NEXT_TO_ERXRDPT(dev->rx_next));
+    cmd_bfs(dev, REG_ECON2, -1, ECON2_PKTDEC);
+    dev->rx_ptr = dev->rx_next;
+    dev->rx_len = 0;
 
     mutex_unlock(&dev->devlock);
     return (int)size;
@@ -392,6 +457,8 @@ static int nd_init(netdev_t *netdev)
     cmd_w_addr(dev, ADDR_RX_START, BUF_RX_START);
     cmd_w_addr(dev, ADDR_RX_END, BUF_RX_END);
     cmd_w_addr(dev, ADDR_RX_READ, NEXT_TO_ERXRDPT(BUF_RX_START));
+    dev->rx_ptr = BUF_RX_START;
+    dev->rx_len = 0;
     /* configure the TX buffer */
     cmd_w_addr(dev, ADDR_TX_START, BUF_TX_START);
     cmd_w_addr(dev, ADDR_TX_END, BUF_TX_END);
@@ -466,10 +533,15 @@ static void nd_isr(netdev_t *netdev)
             }
         }
         if (eir & EIR_PKTIF) {
-            do {
-                DEBUG("[enc28j60] isr: packet received\n");
-                netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
-            } while (cmd_rcr(dev, REG_B1_EPKTCNT, 1) > 0);
+            /* hand up all pending packets, only checking the packet counter
+             * again once they are consumed */
+            uint8_t cnt;
+            while ((cnt = cmd_rcr(dev, REG_B1_EPKTCNT, 1)) > 0) {
+                DEBUG("[enc28j60] isr: %u packet(s) received\n", (unsigned)cnt);
+                while (cnt--) {
+                    netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+                }
+            }
         }
         if (eir & EIR_RXERIF) {
             DEBUG("[enc28j60] isr: incoming packet dropped - RX buffer full\n");
@@ -477,12 +549,14 @@ static void nd_isr(netdev_t *netdev)
         }
         if (eir & EIR_TXIF) {
             DEBUG("[enc28j60] isr: packet transmitted\n");
-            netdev->event_callback(netdev, NETDEV_EVENT_TX_COMPLETE);
             cmd_bfc(dev, REG_EIR, -1, EIR_TXIF);
+            tx_next(dev);
+            netdev->event_callback(netdev, NETDEV_EVENT_TX_COMPLETE);
         }
         if (eir & EIR_TXERIF) {
             DEBUG("[enc28j60] isr: error during transmission - pkt dropped\n");
             cmd_bfc(dev, REG_EIR, -1, EIR_TXERIF);
+            tx_next(dev);
         }
         eir = cmd_rcr(dev, REG_EIR, -1);
     }
@@ -543,4 +617,8 @@ void enc28j60_setup(enc28j60_t *dev, const enc28j60_params_t *params)
     mutex_init(&dev->devlock);
     dev->bank = 99;                         /* mark as invalid */
     dev->tx_time = 0;
+    dev->tx_queued = 0;
+    dev->tx_slot = 1;
+    dev->rx_ptr = BUF_RX_START;
+    dev->rx_len = 0;
 }
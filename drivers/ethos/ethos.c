@@ -207,26 +207,26 @@ static size_t iolist_count_total(const iolist_t *iolist)
     return result;
 }
 
-static void _write_escaped(uart_t uart, uint8_t c)
+static void _write_escaped(uart_t uart, const uint8_t *data, size_t len)
 {
-    const uint8_t *out;
-    int n;
+    const uint8_t *run = data;
+    const uint8_t *stop = data + len;
 
-    switch(c) {
-        case ETHOS_FRAME_DELIMITER:
-            out = _esc_delim;
-            n = 2;
-            break;
-        case ETHOS_ESC_CHAR:
-            out = _esc_esc;
-            n = 2;
-            break;
-        default:
-            out = &c;
-            n = 1;
+    /* write runs of bytes that need no escaping in one go */
+    for (; data < stop; data++) {
+        if ((*data != ETHOS_FRAME_DELIMITER) && (*data != ETHOS_ESC_CHAR)) {
+            continue;
+        }
+        if (data > run) {
+            uart_write(uart, run, data - run);
+        }
+        uart_write(uart, (*data == ETHOS_FRAME_DELIMITER) ? _esc_delim : _esc_esc,
+                   2);
+        run = data + 1;
+    }
+    if (data > run) {
+        uart_write(uart, run, data - run);
     }
-
-    uart_write(uart, out, n);
 }
 
 void ethos_send_frame(ethos_t *dev, const uint8_t *data, size_t len, unsigned frame_type)
@@ -252,9 +252,7 @@ void ethos_send_frame(ethos_t *dev, const uint8_t *data, size_t len, unsigned fr
     }
 
     /* send frame content */
-    while(len--) {
-        _write_escaped(dev->uart, *data++);
-    }
+    _write_escaped(dev->uart, data, len);
 
     /* end of frame */
     uart_write(dev->uart, &frame_delim, 1);
@@ -281,11 +279,7 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
 
     /* send iolist */
     for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
-        size_t n = iol->iol_len;
-        uint8_t *ptr = iol->iol_base;
-        while(n--) {
-            _write_escaped(dev->uart, *ptr++);
-        }
+        _write_escaped(dev->uart, iol->iol_base, iol->iol_len);
     }
 
     uart_write(dev->uart, &frame_delim, 1);
@@ -14,6 +14,7 @@
  * @author      Hyung-Sin Kim <hs.kim@cs.berkeleyedu>
  */
 
+#include <string.h>
 
 #include "periph/i2c.h"
 #include "xtimer.h"
@@ -52,6 +53,41 @@ static int fxos8700_write_regs(const fxos8700_t* dev, uint8_t reg, uint8_t* data
     return FXOS8700_OK;
 }
 
+static int fxos8700_convert_acc(const fxos8700_t* dev, const uint8_t* data,
+                                fxos8700_measurement_t* acc)
+{
+#if FXOS8700_USE_ACC_RAW_VALUES
+    (void)dev;
+    acc->x = (int16_t) ((data[0] << 8) | data[1]) >> 2;
+    acc->y = (int16_t) ((data[2] << 8) | data[3]) >> 2;
+    acc->z = (int16_t) ((data[4] << 8) | data[5]) >> 2;
+#else
+    int32_t acc_raw_x = (int16_t) ((data[0] << 8) | data[1]) >> 2;
+    int32_t acc_raw_y = (int16_t) ((data[2] << 8) | data[3]) >> 2;
+    int32_t acc_raw_z = (int16_t) ((data[4] << 8) | data[5]) >> 2;
+    switch(dev->p.acc_range) {
+        case FXOS8700_REG_XYZ_DATA_CFG_FS__2G:
+            acc->x = (int16_t) ((acc_raw_x * 244) / 100);
+            acc->y = (int16_t) ((acc_raw_y * 244) / 100);
+            acc->z = (int16_t) ((acc_raw_z * 244) / 100);
+            break;
+        case FXOS8700_REG_XYZ_DATA_CFG_FS__4G:
+            acc->x = (int16_t) ((acc_raw_x * 488) / 1000);
+            acc->y = (int16_t) ((acc_raw_y * 488) / 1000);
+            acc->z = (int16_t) ((acc_raw_z * 488) / 1000);
+            break;
+        case FXOS8700_REG_XYZ_DATA_CFG_FS__8G:
+            acc->x = (int16_t) ((acc_raw_x * 976) / 1000);
+            acc->y = (int16_t) ((acc_raw_y * 976) / 1000);
+            acc->z = (int16_t) ((acc_raw_z * 976) / 1000);
+            break;
+        default:
+            return FXOS8700_NODEV;
+    }
+#endif
+    return FXOS8700_OK;
+}
+
 int fxos8700_init(fxos8700_t* dev, const fxos8700_params_t *params)
 {
     uint8_t config;
@@ -160,35 +196,8 @@ int fxos8700_read(const fxos8700_t* dev, fxos8700_measurement_t* acc,
     }
 
     /* Read accelerometer */
-    if (acc) {
-#if FXOS8700_USE_ACC_RAW_VALUES
-        acc->x = (int16_t) ((data[0] << 8) | data[1]) >> 2;
-        acc->y = (int16_t) ((data[2] << 8) | data[3]) >> 2;
-        acc->z = (int16_t) ((data[4] << 8) | data[5]) >> 2;
-#else
-        int32_t acc_raw_x = (int16_t) ((data[0] << 8) | data[1]) >> 2;
-        int32_t acc_raw_y = (int16_t) ((data[2] << 8) | data[3]) >> 2;
-        int32_t acc_raw_z = (int16_t) ((data[4] << 8) | data[5]) >> 2;
-        switch(dev->p.acc_range) {
-            case FXOS8700_REG_XYZ_DATA_CFG_FS__2G:
-                acc->x = (int16_t) ((acc_raw_x * 244) / 100);
-                acc->y = (int16_t) ((acc_raw_y * 244) / 100);
-                acc->z = (int16_t) ((acc_raw_z * 244) / 100);
-                break;
-            case FXOS8700_REG_XYZ_DATA_CFG_FS__4G:
-                acc->x = (int16_t) ((acc_raw_x * 488) / 1000);
-                acc->y = (int16_t) ((acc_raw_y * 488) / 1000);
-                acc->z = (int16_t) ((acc_raw_z * 488) / 1000);
-                break;
-            case FXOS8700_REG_XYZ_DATA_CFG_FS__8G:
-                acc->x = (int16_t) ((acc_raw_x * 976) / 1000);
-                acc->y = (int16_t) ((acc_raw_y * 976) / 1000);
-                acc->z = (int16_t) ((acc_raw_z * 976) / 1000);
-                break;
-            default:
-                return FXOS8700_NODEV;
-        }
-#endif
+    if (acc && (fxos8700_convert_acc(dev, &data[0], acc) != FXOS8700_OK)) {
+        return FXOS8700_NODEV;
     }
     /* Read magnetometer */
     if (mag) {
@@ -199,6 +208,74 @@ int fxos8700_read(const fxos8700_t* dev, fxos8700_measurement_t* acc,
     return FXOS8700_OK;
 }
 
+int fxos8700_set_fifo(const fxos8700_t* dev, uint8_t watermark)
+{
+    uint8_t reg;
+
+    if (watermark >= FXOS8700_FIFO_SIZE) {
+        watermark = FXOS8700_FIFO_SIZE - 1;
+    }
+    /* the FIFO can only be configured in standby */
+    if (fxos8700_set_idle(dev) != FXOS8700_OK) {
+        return FXOS8700_BUSERR;
+    }
+    reg = (watermark ? FXOS8700_REG_F_SETUP_F_MODE__CIRC
+                     : FXOS8700_REG_F_SETUP_F_MODE__OFF) |
+          (watermark & FXOS8700_REG_F_SETUP_MASK__F_WMRK);
+    if (fxos8700_write_regs(dev, FXOS8700_REG_F_SETUP, &reg, 1) != FXOS8700_OK) {
+        return FXOS8700_BUSERR;
+    }
+    /* route the watermark interrupt to INT1 */
+    reg = watermark ? FXOS8700_REG_CTRL_REG5_MASK__INT_CFG_FIFO : 0;
+    if (fxos8700_write_regs(dev, FXOS8700_REG_CTRL_REG5, &reg, 1) != FXOS8700_OK) {
+        return FXOS8700_BUSERR;
+    }
+    reg = watermark ? FXOS8700_REG_CTRL_REG4_MASK__INT_EN_FIFO : 0;
+    if (fxos8700_write_regs(dev, FXOS8700_REG_CTRL_REG4, &reg, 1) != FXOS8700_OK) {
+        return FXOS8700_BUSERR;
+    }
+    /* without hybrid auto increment a burst wraps from OUT_Z_LSB to
+     * OUT_X_MSB, so it reads consecutive FIFO samples */
+    reg = watermark ? 0 : FXOS8700_REG_M_CTRL_REG2_MASK__HYB_AUTOINC_MODE;
+    if (fxos8700_write_regs(dev, FXOS8700_REG_M_CTRL_REG2, &reg, 1) != FXOS8700_OK) {
+        return FXOS8700_BUSERR;
+    }
+    if (watermark) {
+        return fxos8700_set_active(dev);
+    }
+    return FXOS8700_OK;
+}
+
+int fxos8700_read_fifo(const fxos8700_t* dev, fxos8700_measurement_t* acc,
+                       unsigned max)
+{
+    uint8_t status;
+
+    if (fxos8700_read_regs(dev, FXOS8700_REG_STATUS, &status, 1) != FXOS8700_OK) {
+        return FXOS8700_BUSERR;
+    }
+    unsigned num = status & FXOS8700_REG_F_STATUS_MASK__F_CNT;
+    if (num > max) {
+        num = max;
+    }
+    if (num == 0) {
+        return 0;
+    }
+    /* a raw sample has the size of a measurement, so convert in place */
+    if (fxos8700_read_regs(dev, FXOS8700_REG_OUT_X_MSB, (uint8_t *)acc,
+                           num * sizeof(fxos8700_measurement_t)) != FXOS8700_OK) {
+        return FXOS8700_BUSERR;
+    }
+    for (unsigned i = 0; i < num; i++) {
+        uint8_t data[6];
+        memcpy(data, &acc[i], sizeof(data));
+        if (fxos8700_convert_acc(dev, data, &acc[i]) != FXOS8700_OK) {
+            return FXOS8700_NODEV;
+        }
+    }
+    return num;
+}
+
 int fxos8700_read_cached(const void *dev, fxos8700_measurement_t* acc,
                          fxos8700_measurement_t* mag)
 {
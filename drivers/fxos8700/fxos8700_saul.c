@@ -35,14 +35,10 @@ static int read_mag(const void *dev, phydat_t *res)
     return 3;
 }
 
-static int read_acc(const void *dev, phydat_t *res)
+static void acc_unit(const void *dev, phydat_t *res)
 {
-    if (fxos8700_read_cached(dev, (fxos8700_measurement_t *)res, NULL)
-        != FXOS8700_OK) {
-        /* Read failure */
-        return -ECANCELED;
-    }
 #if FXOS8700_USE_ACC_RAW_VALUES
+    (void)dev;
     res->unit = UNIT_NONE;
     res->scale = 0;
 #else
@@ -53,9 +49,39 @@ static int read_acc(const void *dev, phydat_t *res)
         res->scale = -3;
     }
 #endif
+}
+
+static int read_acc(const void *dev, phydat_t *res)
+{
+    if (fxos8700_read_cached(dev, (fxos8700_measurement_t *)res, NULL)
+        != FXOS8700_OK) {
+        /* Read failure */
+        return -ECANCELED;
+    }
+    acc_unit(dev, res);
     return 3;
 }
 
+static int read_acc_burst(const void *dev, phydat_t *res, unsigned max)
+{
+    fxos8700_measurement_t acc[FXOS8700_FIFO_SIZE];
+
+    if (max > FXOS8700_FIFO_SIZE) {
+        max = FXOS8700_FIFO_SIZE;
+    }
+    int num = fxos8700_read_fifo(dev, acc, max);
+    if (num < 0) {
+        return -ECANCELED;
+    }
+    for (int i = 0; i < num; i++) {
+        res[i].val[0] = acc[i].x;
+        res[i].val[1] = acc[i].y;
+        res[i].val[2] = acc[i].z;
+        acc_unit(dev, &res[i]);
+    }
+    return num;
+}
+
 const saul_driver_t fxos8700_saul_mag_driver = {
     .read = read_mag,
     .write = saul_notsup,
@@ -66,4 +92,5 @@ const saul_driver_t fxos8700_saul_acc_driver = {
     .read = read_acc,
     .write = saul_notsup,
     .type = SAUL_SENSE_ACCEL,
+    .read_burst = read_acc_burst,
 };
@@ -202,6 +202,20 @@ extern "C"
 #define FXOS8700_REG_XYZ_DATA_CFG_FS__8G   (0x02)
 /** @} */
 
+/**
+ * @name FIFO configuration and status
+ * @{
+ */
+#define FXOS8700_REG_F_SETUP_MASK__F_MODE   (0xC0)
+#define FXOS8700_REG_F_SETUP_F_MODE__OFF    (0x00)
+#define FXOS8700_REG_F_SETUP_F_MODE__CIRC   (0x40)
+#define FXOS8700_REG_F_SETUP_MASK__F_WMRK   (0x3F)
+#define FXOS8700_REG_F_STATUS_MASK__F_CNT   (0x3F)
+#define FXOS8700_REG_CTRL_REG4_MASK__INT_EN_FIFO    (0x40)
+#define FXOS8700_REG_CTRL_REG5_MASK__INT_CFG_FIFO   (0x40)
+#define FXOS8700_FIFO_SIZE                  (32U)
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,18 @@
 static int16_t temp_cached, hum_cached;
 static uint32_t last_read_time;
 
+static void _convert(const uint8_t *buf, int16_t *temp, int16_t *hum)
+{
+    if (temp) {
+        uint16_t traw = ((uint16_t)buf[0] << 8) | buf[1];
+        *temp = (int16_t)((((int32_t)traw * 16500) >> 16) - 4000);
+    }
+    if (hum) {
+        uint16_t hraw = ((uint16_t)buf[2] << 8) | buf[3];
+        *hum  = (int16_t)(((int32_t)hraw * 10000) >> 16);
+    }
+}
+
 int hdc1000_init(hdc1000_t *dev, const hdc1000_params_t *params)
 {
     uint8_t reg[2];
@@ -112,14 +124,7 @@ int hdc1000_get_results(const hdc1000_t *dev, int16_t *temp, int16_t *hum)
 
     if (status == HDC1000_OK) {
         /* if all ok, we convert the values to their physical representation */
-        if (temp) {
-            uint16_t traw = ((uint16_t)buf[0] << 8) | buf[1];
-            *temp = (int16_t)((((int32_t)traw * 16500) >> 16) - 4000);
-        }
-        if (hum) {
-            uint16_t hraw = ((uint16_t)buf[2] << 8) | buf[3];
-            *hum  = (int16_t)(((int32_t)hraw * 10000) >> 16);
-        }
+        _convert(buf, temp, hum);
     }
 
     return status;
@@ -156,3 +161,43 @@ int hdc1000_read_cached(const hdc1000_t *dev, int16_t *temp, int16_t *hum)
     }
     return HDC1000_OK;
 }
+
+#ifdef MODULE_I2C_ASYNC
+void hdc1000_trigger_conversion_async(const hdc1000_t *dev,
+                                      hdc1000_async_t *req,
+                                      i2c_async_cb_t cb, void *arg)
+{
+    assert(dev && req);
+
+    req->buf[0] = HDC1000_TEMPERATURE;
+    req->op.type = I2C_ASYNC_WRITE_BYTES;
+    req->op.data = req->buf;
+    req->op.len = 1;
+    req->op.flags = 0;
+    i2c_async_init(&req->req, dev->p.addr, &req->op, 1, cb, arg);
+    i2c_async_submit(dev->p.i2c, &req->req);
+}
+
+void hdc1000_get_results_async(const hdc1000_t *dev, hdc1000_async_t *req,
+                               i2c_async_cb_t cb, void *arg)
+{
+    assert(dev && req);
+
+    req->op.type = I2C_ASYNC_READ_BYTES;
+    req->op.data = req->buf;
+    req->op.len = sizeof(req->buf);
+    req->op.flags = 0;
+    i2c_async_init(&req->req, dev->p.addr, &req->op, 1, cb, arg);
+    i2c_async_submit(dev->p.i2c, &req->req);
+}
+
+int hdc1000_async_results(const hdc1000_async_t *req,
+                          int16_t *temp, int16_t *hum)
+{
+    if (req->req.res < 0) {
+        return HDC1000_BUSERR;
+    }
+    _convert(req->buf, temp, hum);
+    return HDC1000_OK;
+}
+#endif /* MODULE_I2C_ASYNC */
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_i2c_async
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous I2C transaction implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+
+#include "irq.h"
+#include "kernel_defines.h"
+#include "periph_conf.h"
+#include "i2c_async.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+typedef struct {
+    event_t super;              /**< drains the queue */
+    i2c_async_req_t *head;      /**< first pending request */
+    i2c_async_req_t *tail;      /**< last pending request */
+    i2c_t bus;                  /**< bus of this queue */
+    uint8_t busy;               /**< super is posted or running */
+} _bus_t;
+
+static _bus_t _buses[I2C_NUMOF];
+
+static i2c_async_req_t *_pop(_bus_t *bus)
+{
+    unsigned state = irq_disable();
+    i2c_async_req_t *req = bus->head;
+
+    if (req) {
+        bus->head = req->next;
+        req->next = NULL;
+    }
+    else {
+        bus->tail = NULL;
+        bus->busy = 0;
+    }
+    irq_restore(state);
+    return req;
+}
+
+static int _run(i2c_t bus, const i2c_async_req_t *req)
+{
+    for (unsigned i = 0; i < req->ops_numof; i++) {
+        const i2c_async_op_t *op = &req->ops[i];
+        int res;
+
+        switch (op->type) {
+            case I2C_ASYNC_READ_REGS:
+                res = i2c_read_regs(bus, req->addr, op->reg, op->data,
+                                    op->len, op->flags);
+                break;
+            case I2C_ASYNC_WRITE_REGS:
+                res = i2c_write_regs(bus, req->addr, op->reg, op->data,
+                                     op->len, op->flags);
+                break;
+            case I2C_ASYNC_READ_BYTES:
+                res = i2c_read_bytes(bus, req->addr, op->data, op->len,
+                                     op->flags);
+                break;
+            case I2C_ASYNC_WRITE_BYTES:
+                res = i2c_write_bytes(bus, req->addr, op->data, op->len,
+                                      op->flags);
+                break;
+            default:
+                res = -EINVAL;
+                break;
+        }
+        if (res < 0) {
+            DEBUG("i2c_async: op %u on 0x%02x failed: %d\n", i,
+                  (unsigned)req->addr, res);
+            return res;
+        }
+    }
+    return 0;
+}
+
+static void _handler(event_t *event)
+{
+    _bus_t *bus = container_of(event, _bus_t, super);
+    i2c_async_req_t *req;
+
+    /* one bus session for everything queued until the queue runs empty */
+    i2c_acquire(bus->bus);
+    while ((req = _pop(bus))) {
+        req->res = _run(bus->bus, req);
+        req->cb(req);
+    }
+    i2c_release(bus->bus);
+}
+
+void i2c_async_submit(i2c_t bus, i2c_async_req_t *req)
+{
+    assert(bus < I2C_NUMOF);
+    assert(req->cb);
+
+    _bus_t *b = &_buses[bus];
+    unsigned state = irq_disable();
+
+    req->next = NULL;
+    if (b->tail) {
+        b->tail->next = req;
+    }
+    else {
+        b->head = req;
+    }
+    b->tail = req;
+    if (!b->busy) {
+        b->busy = 1;
+        b->bus = bus;
+        b->super.handler = _handler;
+        event_post(event_workq(I2C_ASYNC_PRIO), &b->super);
+    }
+    irq_restore(state);
+}
@@ -38,6 +38,9 @@
 #include "net/netdev.h"
 #include "net/netdev/ieee802154.h"
 #include "net/gnrc/nettype.h"
+#ifdef MODULE_ENERGY
+#include "energy.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -139,6 +142,21 @@ extern "C" {
 #define AT86RF2XX_SMART_IDLE_LISTENING     (0)
 #endif
 
+/**
+ * @brief   Pipelined frame upload
+ *
+ * If enabled, the transmission is started as soon as the first chunk of the
+ * frame (the MAC header) is in the frame buffer and the rest of the frame is
+ * uploaded while the transceiver performs CSMA-CA and sends the synchronization
+ * header. The SPI link stays ahead of the transceiver reading the frame
+ * buffer, as long as it is considerably faster than the PHY data rate, which
+ * is the case for the default SPI clock. Not used with
+ * @ref NETOPT_PRELOADING.
+ */
+#ifndef AT86RF2XX_PIPELINED_TX
+#define AT86RF2XX_PIPELINED_TX             (0)
+#endif
+
 /**
  * @name    Flags for device internal states (see datasheet)
  * @{
@@ -192,6 +210,16 @@ typedef struct at86rf2xx_params {
     gpio_t reset_pin;       /**< GPIO pin connected to the reset pin */
 } at86rf2xx_params_t;
 
+/**
+ * @brief   Current in µA for each @ref netopt_state_t, for the energy module
+ *
+ * Typical values of the AT86RF233 at 3 V and +4 dBm. Idle is listening for
+ * frames, standby is TRX_OFF.
+ */
+#ifndef AT86RF2XX_ENERGY_UA
+#define AT86RF2XX_ENERGY_UA     { 0, 0, 11800, 11800, 13800, 300, 300 }
+#endif
+
 /**
  * @brief   Device descriptor for AT86RF2XX radio devices
  *
@@ -215,6 +243,9 @@ typedef struct {
 #if AT86RF2XX_HAVE_RETRIES
     /* Only radios with the XAH_CTRL_2 register support frame retry reporting */
     uint8_t tx_retries;                 /**< Number of NOACK retransmissions */
+#endif
+#ifdef MODULE_ENERGY
+    energy_netdev_t energy;             /**< time spent in each state */
 #endif
     /** @} */
 } at86rf2xx_t;
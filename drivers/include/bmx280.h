@@ -63,6 +63,9 @@
 #include <inttypes.h>
 #include "saul.h"
 #include "periph/i2c.h"
+#ifdef MODULE_I2C_ASYNC
+#include "i2c_async.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -187,6 +190,7 @@ enum {
     BMX280_OK           =  0,     /**< everything was fine */
     BMX280_ERR_NODEV    = -1,     /**< did not detect BME280 or BMP280 */
     BMX280_ERR_NOCAL    = -2,     /**< could not read calibration data */
+    BMX280_ERR_I2C      = -3,     /**< error during I2C communication */
 };
 
 /**
@@ -238,6 +242,63 @@ uint32_t bmx280_read_pressure(const bmx280_t *dev);
 uint16_t bme280_read_humidity(const bmx280_t *dev);
 #endif
 
+#if defined(MODULE_I2C_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Asynchronous BMX280 request, see @ref drivers_i2c_async
+ *
+ * The completion callback is called with &bmx280_async_t::req.
+ */
+typedef struct {
+    i2c_async_req_t req;                /**< I2C request, must be first */
+    i2c_async_op_t op;                  /**< transfer of the request */
+    uint8_t ctrl_meas;                  /**< ctrl_meas register value */
+    uint8_t regs[8];                    /**< raw measurement registers */
+} bmx280_async_t;
+
+/**
+ * @brief   Start a measurement without blocking
+ *
+ * Only needed in FORCED mode, the device measures continuously in NORMAL
+ * mode. Read the results with bmx280_read_async() once the measurement is
+ * done.
+ *
+ * @param[in]  dev          Device descriptor of BMX280 device
+ * @param[out] req          Request to use, must stay valid until @p cb
+ * @param[in]  cb           Completion callback
+ * @param[in]  arg          Argument stored in the request
+ */
+void bmx280_trigger_async(const bmx280_t *dev, bmx280_async_t *req,
+                          i2c_async_cb_t cb, void *arg);
+
+/**
+ * @brief   Read the measurement registers without blocking
+ *
+ * Convert the results in @p cb with bmx280_async_results().
+ *
+ * @param[in]  dev          Device descriptor of BMX280 device
+ * @param[out] req          Request to use, must stay valid until @p cb
+ * @param[in]  cb           Completion callback
+ * @param[in]  arg          Argument stored in the request
+ */
+void bmx280_read_async(const bmx280_t *dev, bmx280_async_t *req,
+                       i2c_async_cb_t cb, void *arg);
+
+/**
+ * @brief   Compensate the results of a completed bmx280_read_async()
+ *
+ * @param[in]  dev          Device descriptor of BMX280 device
+ * @param[in]  req          Completed request
+ * @param[out] temp         Temperature in centi Celsius, may be NULL
+ * @param[out] press        Air pressure in Pa, may be NULL
+ * @param[out] hum          Humidity in centi %RH, BME280 only, may be NULL
+ *
+ * @return                  BMX280_OK on success
+ * @return                  BMX280_ERR_I2C if the request failed
+ */
+int bmx280_async_results(const bmx280_t *dev, const bmx280_async_t *req,
+                         int16_t *temp, uint32_t *press, uint16_t *hum);
+#endif /* MODULE_I2C_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,6 +24,8 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+
 #include "periph/spi.h"
 #include "periph/gpio.h"
 #include "cc110x-internal.h"
@@ -57,6 +59,7 @@ struct cc110x {
     uint8_t radio_state;                        /**< Radio state */
     uint8_t radio_channel;                      /**< current Radio channel */
     uint8_t radio_address;                      /**< current Radio address */
+    bool wor;                                   /**< listen with wake-on-radio */
 
     cc110x_pkt_buf_t pkt_buf;                   /**< RX/TX buffer */
     void (*isr_cb)(cc110x_t *dev, void* arg);   /**< isr callback */
@@ -128,6 +131,20 @@ uint8_t cc110x_set_address(cc110x_t *dev, uint8_t address);
  */
 void cc110x_set_monitor(cc110x_t *dev, uint8_t mode);
 
+/**
+ * @brief   Enable or disable wake-on-radio
+ *
+ * With wake-on-radio the device sleeps while listening and only polls the
+ * channel every @ref CC110X_WOR_EVENT0 cycles of the RC oscillator, staying
+ * in RX for @ref CC110X_WOR_RX_TIME if no carrier is sensed. Senders need a
+ * preamble longer than the polling interval to be received.
+ *
+ * @param[in] dev       device to work on
+ * @param[in] enable    true to listen with wake-on-radio, false to listen
+ *                      continuously
+ */
+void cc110x_set_wor(cc110x_t *dev, bool enable);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,9 @@
 
 #include "net/netdev.h"
 #include "net/netdev/ieee802154.h"
+#ifdef MODULE_ENERGY
+#include "energy.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -83,6 +86,16 @@ typedef struct cc2420_params {
     gpio_t pin_reset;       /**< pin connected to the reset pin */
 } cc2420_params_t;
 
+/**
+ * @brief   Current in µA for each @ref netopt_state_t, for the energy module
+ *
+ * Typical values from the datasheet at 0 dBm. Off is power down with the
+ * voltage regulator on, sleep is the idle state with the oscillator running.
+ */
+#ifndef CC2420_ENERGY_UA
+#define CC2420_ENERGY_UA        { 20, 426, 18800, 18800, 17400, 426, 426 }
+#endif
+
 /**
  * @brief   Device descriptor for CC2420 radio devices
  */
@@ -94,6 +107,9 @@ typedef struct {
     /* device state fields */
     uint8_t state;                /**< current state of the radio */
     uint16_t options;             /**< state of used options */
+#ifdef MODULE_ENERGY
+    energy_netdev_t energy;       /**< time spent in each state */
+#endif
 } cc2420_t;
 
 /**
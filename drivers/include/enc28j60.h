@@ -54,6 +54,14 @@ typedef struct {
     mutex_t devlock;        /**< lock the device on access */
     int8_t bank;            /**< remember the active register bank */
     uint32_t tx_time;       /**< last transmission time for timeout handling */
+    uint16_t tx_queued;     /**< end of the frame waiting in the second TX
+                             *   slot, 0 if none */
+    uint8_t tx_slot;        /**< TX slot of the last transmission */
+    uint16_t rx_ptr;        /**< RX buffer address of the next packet */
+    uint16_t rx_next;       /**< next packet pointer of the packet whose
+                             *   header was read */
+    uint16_t rx_len;        /**< size of the packet whose header was read,
+                             *   0 if not read yet */
 } enc28j60_t;
 
 /**
@@ -142,6 +142,39 @@ int fxos8700_set_idle(const fxos8700_t* dev);
  */
 int fxos8700_read(const fxos8700_t* dev, fxos8700_measurement_t* acc, fxos8700_measurement_t* mag);
 
+/**
+ * @brief   Enable or disable the accelerometer FIFO
+ *
+ * With a watermark the device keeps sampling in the background and the FIFO
+ * watermark interrupt is routed to INT1. Wait for it, then drain the FIFO
+ * with fxos8700_read_fifo(). fxos8700_read() puts the device back to idle,
+ * so do not use it, or the SAUL single reads, while the FIFO is enabled.
+ *
+ * @param[in]  dev          device descriptor of sensor
+ * @param[in]  watermark    number of samples [1-31] that raise the
+ *                          interrupt, 0 to disable the FIFO
+ *
+ * @return                  FXOS8700_OK on success
+ * @return                  FXOS8700_BUSERR on I2C communication failures
+ */
+int fxos8700_set_fifo(const fxos8700_t* dev, uint8_t watermark);
+
+/**
+ * @brief   Read all acceleration samples buffered in the FIFO
+ *
+ * The samples are read in one I2C transaction.
+ *
+ * @param[in]  dev          device descriptor of sensor
+ * @param[out] acc          array of 3-axis accelerations, same unit as for
+ *                          fxos8700_read()
+ * @param[in]  max          number of elements in @p acc
+ *
+ * @return                  number of samples read
+ * @return                  FXOS8700_BUSERR on I2C communication failures
+ */
+int fxos8700_read_fifo(const fxos8700_t* dev, fxos8700_measurement_t* acc,
+                       unsigned max);
+
 /**
  * @brief   Extended read function including caching capability
  *
@@ -45,6 +45,9 @@
 
 #include "periph/i2c.h"
 #include "hdc1000_regs.h"
+#ifdef MODULE_I2C_ASYNC
+#include "i2c_async.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
@@ -173,6 +176,61 @@ int hdc1000_read(const hdc1000_t *dev, int16_t *temp, int16_t *hum);
  */
 int hdc1000_read_cached(const hdc1000_t *dev, int16_t *temp, int16_t *hum);
 
+#if defined(MODULE_I2C_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Asynchronous HDC1000 request, see @ref drivers_i2c_async
+ *
+ * The completion callback is called with &hdc1000_async_t::req.
+ */
+typedef struct {
+    i2c_async_req_t req;    /**< I2C request, must be the first member */
+    i2c_async_op_t op;      /**< transfer of the request */
+    uint8_t buf[4];         /**< command or raw results */
+} hdc1000_async_t;
+
+/**
+ * @brief   Trigger a new conversion without blocking
+ *
+ * Same as hdc1000_trigger_conversion(), the results can be fetched with
+ * hdc1000_get_results_async() @ref HDC1000_CONVERSION_TIME us after the
+ * callback was called.
+ *
+ * @param[in]  dev          device descriptor of sensor
+ * @param[out] req          request to use, must stay valid until @p cb
+ * @param[in]  cb           completion callback
+ * @param[in]  arg          argument stored in the request
+ */
+void hdc1000_trigger_conversion_async(const hdc1000_t *dev,
+                                      hdc1000_async_t *req,
+                                      i2c_async_cb_t cb, void *arg);
+
+/**
+ * @brief   Read the conversion results without blocking
+ *
+ * Convert the results in @p cb with hdc1000_async_results().
+ *
+ * @param[in]  dev          device descriptor of sensor
+ * @param[out] req          request to use, must stay valid until @p cb
+ * @param[in]  cb           completion callback
+ * @param[in]  arg          argument stored in the request
+ */
+void hdc1000_get_results_async(const hdc1000_t *dev, hdc1000_async_t *req,
+                               i2c_async_cb_t cb, void *arg);
+
+/**
+ * @brief   Convert the results of a completed hdc1000_get_results_async()
+ *
+ * @param[in]  req          completed request
+ * @param[out] temp         temperature [in 100 * degree centigrade]
+ * @param[out] hum          humidity [in 100 * percent relative]
+ *
+ * @return                  HDC1000_OK on success
+ * @return                  HDC1000_BUSERR if the request failed
+ */
+int hdc1000_async_results(const hdc1000_async_t *req,
+                          int16_t *temp, int16_t *hum);
+#endif /* MODULE_I2C_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_i2c_async Asynchronous I2C transactions
+ * @ingroup     drivers_periph_i2c
+ * @brief       Queues I2C transactions and calls back on completion
+ *
+ * A request is a list of operations (register or plain byte reads and
+ * writes) for one device. Requests are queued per bus and executed by the
+ * workers of the @ref sys_event work queue (see event/workq.h), so the
+ * submitting thread does not block while the bus is busy. All requests
+ * pending on a bus are executed in one bus session: the bus is acquired
+ * once, the queue is drained and the bus is released afterwards. Queue the
+ * reads of all sensors on a bus back to back to batch them.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static uint8_t buf[6];
+ * static const i2c_async_op_t ops[] = {
+ *     { .type = I2C_ASYNC_READ_REGS, .reg = 0x28, .data = buf, .len = 6 },
+ * };
+ * static i2c_async_req_t req;
+ *
+ * static void _done(i2c_async_req_t *req)
+ * {
+ *     if (req->res == 0) {
+ *         [...]
+ *     }
+ * }
+ *
+ * i2c_async_init(&req, 0x19, ops, ARRAY_SIZE(ops), _done, NULL);
+ * i2c_async_submit(I2C_DEV(0), &req);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The callback runs on a worker thread with the bus acquired. It must not
+ * call the blocking periph_i2c functions on the same bus, but it may submit
+ * further requests, including the request it was called for; they are
+ * executed within the same bus session. The request, its operations and
+ * their buffers must stay valid until the callback was called.
+ *
+ * The transfers themselves are done with the periph_i2c driver of the CPU.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous I2C transaction API
+ */
+
+#ifndef I2C_ASYNC_H
+#define I2C_ASYNC_H
+
+#include <stdint.h>
+
+#include "event/workq.h"
+#include "periph/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Work queue priority the requests are executed with
+ */
+#ifndef I2C_ASYNC_PRIO
+#define I2C_ASYNC_PRIO      (EVENT_WORKQ_PRIO_HIGH)
+#endif
+
+/**
+ * @brief   Operation types
+ */
+enum {
+    I2C_ASYNC_READ_REGS,    /**< i2c_read_regs() */
+    I2C_ASYNC_WRITE_REGS,   /**< i2c_write_regs() */
+    I2C_ASYNC_READ_BYTES,   /**< i2c_read_bytes() */
+    I2C_ASYNC_WRITE_BYTES,  /**< i2c_write_bytes() */
+};
+
+/**
+ * @brief   A single transfer of a request
+ */
+typedef struct {
+    void *data;             /**< buffer to read to or write from */
+    uint16_t len;           /**< number of bytes to transfer */
+    uint16_t reg;           /**< register, ignored for byte transfers */
+    uint8_t type;           /**< one of the I2C_ASYNC_* operation types */
+    uint8_t flags;          /**< periph_i2c flags, see i2c_flags_t */
+} i2c_async_op_t;
+
+/**
+ * @brief   Forward declaration for the callback type
+ */
+typedef struct i2c_async_req i2c_async_req_t;
+
+/**
+ * @brief   Completion callback, see i2c_async_req::res for the result
+ */
+typedef void (*i2c_async_cb_t)(i2c_async_req_t *req);
+
+/**
+ * @brief   Asynchronous I2C request
+ */
+struct i2c_async_req {
+    i2c_async_req_t *next;      /**< next pending request, internal */
+    const i2c_async_op_t *ops;  /**< operations to execute in order */
+    uint8_t ops_numof;          /**< number of operations */
+    uint16_t addr;              /**< device address */
+    i2c_async_cb_t cb;          /**< completion callback */
+    void *arg;                  /**< argument for the callback */
+    int res;                    /**< 0 on success or the error of the first
+                                 *   failing operation, the remaining
+                                 *   operations are skipped */
+};
+
+/**
+ * @brief   Sets up a request
+ *
+ * @param[out] req          request to set up
+ * @param[in]  addr         device address
+ * @param[in]  ops          operations to execute
+ * @param[in]  ops_numof    number of operations
+ * @param[in]  cb           completion callback
+ * @param[in]  arg          argument for @p cb, stored in @p req
+ */
+static inline void i2c_async_init(i2c_async_req_t *req, uint16_t addr,
+                                  const i2c_async_op_t *ops,
+                                  uint8_t ops_numof,
+                                  i2c_async_cb_t cb, void *arg)
+{
+    req->next = NULL;
+    req->ops = ops;
+    req->ops_numof = ops_numof;
+    req->addr = addr;
+    req->cb = cb;
+    req->arg = arg;
+    req->res = 0;
+}
+
+/**
+ * @brief   Queues a request on a bus
+ *
+ * May be called from interrupt context. A request must not be submitted
+ * again before its callback was called.
+ *
+ * @param[in] bus       bus to execute the request on
+ * @param[in] req       request set up with i2c_async_init()
+ */
+void i2c_async_submit(i2c_t bus, i2c_async_req_t *req);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2C_ASYNC_H */
+/** @} */
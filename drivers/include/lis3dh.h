@@ -775,6 +775,25 @@ int lis3dh_init(lis3dh_t *dev, const lis3dh_params_t *params);
  */
 int lis3dh_read_xyz(const lis3dh_t *dev, lis3dh_data_t *acc_data);
 
+/**
+ * @brief   Read all samples buffered in the FIFO in a single transaction
+ *
+ * For watermark driven burst reads, enable the FIFO with lis3dh_set_fifo(),
+ * route the watermark to INT1 with lis3dh_set_int1() and
+ * LIS3DH_CTRL_REG3_I1_WTM_MASK, and call this function from the thread woken
+ * up by the interrupt on lis3dh_params_t::int1.
+ *
+ * @param[in]  dev          Device descriptor of sensor
+ * @param[out] acc_data     Array of accelerometer samples
+ * @param[in]  max          Number of elements in @p acc_data
+ *
+ * @return                  number of samples read on success, 0 if the FIFO
+ *                          was empty or is disabled
+ * @return                  -1 on error
+ */
+int lis3dh_read_fifo(const lis3dh_t *dev, lis3dh_data_t *acc_data,
+                     unsigned max);
+
 /**
  * @brief   Read auxiliary ADC channel 1 data from the accelerometer
  *
@@ -160,6 +160,39 @@ int lsm6dsl_read_acc(const lsm6dsl_t *dev, lsm6dsl_3d_data_t *data);
  */
 int lsm6dsl_read_gyro(const lsm6dsl_t *dev, lsm6dsl_3d_data_t *data);
 
+/**
+ * @brief   Read all data sets buffered in the FIFO
+ *
+ * The FIFO is always enabled in continuous mode. A data set holds one
+ * gyroscope and one accelerometer sample, for each sensor whose decimation is
+ * not LSM6DSL_DECIMATION_NOT_IN_FIFO. If both sensors are in the FIFO they
+ * need the same decimation. Samples of a sensor are dropped if the matching
+ * output pointer is NULL, so reading only one of them through SAUL drops the
+ * other. The data is read in bursts of LSM6DSL_FIFO_BURST_SETS data sets per
+ * I2C transaction.
+ *
+ * @param[in] dev    device to read
+ * @param[out] acc   array of accelerometer values, may be NULL
+ * @param[out] gyro  array of gyroscope values, may be NULL
+ * @param[in] max    number of elements in @p acc and @p gyro
+ *
+ * @return number of data sets read on success
+ * @return < 0 on error
+ */
+int lsm6dsl_read_fifo(const lsm6dsl_t *dev, lsm6dsl_3d_data_t *acc,
+                      lsm6dsl_3d_data_t *gyro, unsigned max);
+
+/**
+ * @brief   Signal on INT1 when the FIFO holds @p sets data sets
+ *
+ * @param[in] dev    device to configure
+ * @param[in] sets   FIFO watermark in data sets, 0 disables the interrupt
+ *
+ * @return LSM6DSL_OK on success
+ * @return < 0 on error
+ */
+int lsm6dsl_set_fifo_watermark(const lsm6dsl_t *dev, uint16_t sets);
+
 /**
  * @brief   Read temperature data
  *
@@ -146,6 +146,19 @@ struct mtd_desc {
      * @return < 0 value on error
      */
     int (*power)(mtd_dev_t *dev, enum mtd_power_state power);
+
+    /**
+     * @brief   Write back data buffered by the Memory Technology Device (MTD)
+     *
+     * Optional, devices that finish all writes within write() leave it
+     * NULL.
+     *
+     * @param[in] dev       Pointer to the selected driver
+     *
+     * @return 0 on success
+     * @return < 0 value on error
+     */
+    int (*flush)(mtd_dev_t *dev);
 };
 
 /**
@@ -229,6 +242,20 @@ int mtd_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t count);
  */
 int mtd_power(mtd_dev_t *mtd, enum mtd_power_state power);
 
+/**
+ * @brief   mtd_flush Write back data buffered by a MTD device
+ *
+ * File systems call this when they sync or are unmounted.
+ *
+ * @param      mtd   the device to flush
+ * @return 0 if all data was written
+ * @return 0 if @p mtd does not buffer data
+ * @return < 0 if an error occured
+ * @return -ENODEV if @p mtd is not a valid device
+ * @return -EIO if I/O error occured
+ */
+int mtd_flush(mtd_dev_t *mtd);
+
 #if defined(MODULE_VFS) || defined(DOXYGEN)
 /**
  * @brief   MTD driver for VFS
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_cache Page cache for MTD devices
+ * @ingroup     drivers_storage
+ * @brief       MTD device caching the pages of another MTD device
+ *
+ * File systems read the same metadata pages over and over. mtd_cache keeps
+ * the least recently used pages of the underlying device in RAM and is used
+ * in its place:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static uint8_t cache_buf[8 * 256];
+ * static mtd_cache_page_t cache_pages[8];
+ * static mtd_cache_t cache = {
+ *     .base = { .driver = &mtd_cache_driver },
+ *     .parent = (mtd_dev_t *)&mtd_spi_nor,
+ *     .buf = cache_buf,
+ *     .pages = cache_pages,
+ *     .numof = 8,
+ *     .read_ahead = 1,
+ * };
+ *
+ * littlefs_desc.dev = &cache.base;
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * - Reads that miss a cached page load it and the @ref mtd_cache_t::read_ahead
+ *   pages following it. Uncached whole pages go to the device directly, so
+ *   large file reads do not evict the metadata.
+ * - Writes only modify the cached page. Dirty pages are written back when they
+ *   are evicted, by mtd_flush() (called by the file systems on sync and
+ *   unmount) and before mtd_power() powers down.
+ * - Erasing drops the cached pages of the erased sectors.
+ *
+ * @warning Written data is lost on a reset before it was flushed.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the mtd_cache driver
+ */
+
+#ifndef MTD_CACHE_H
+#define MTD_CACHE_H
+
+#include <stdint.h>
+
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief   State of a cached page
+ */
+typedef struct {
+    uint32_t page;          /**< page number, UINT32_MAX if unused */
+    uint32_t used;          /**< time of the last access */
+    uint32_t dirty_start;   /**< first modified byte of the page */
+    uint32_t dirty_end;     /**< end of the modified bytes, 0 if clean */
+} mtd_cache_page_t;
+
+/**
+ * @brief   Device descriptor for mtd_cache device
+ *
+ * This is an extension of the @c mtd_dev_t struct
+ */
+typedef struct {
+    mtd_dev_t base;             /**< inherit from mtd_dev_t object */
+    mtd_dev_t *parent;          /**< the cached device */
+    uint8_t *buf;               /**< numof times the page size of parent */
+    mtd_cache_page_t *pages;    /**< numof page states */
+    unsigned numof;             /**< number of cached pages */
+    unsigned read_ahead;        /**< pages loaded in addition on a miss */
+    mutex_t lock;               /**< protects the cache, set by init */
+    uint32_t clock;             /**< access counter, set by init */
+} mtd_cache_t;
+
+/**
+ * @brief   mtd_cache device operations table for mtd
+ *
+ * mtd_init() initializes the parent device, mtd_cache takes its geometry.
+ */
+extern const mtd_desc_t mtd_cache_driver;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_CACHE_H */
+/** @} */
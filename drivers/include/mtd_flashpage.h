@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_flashpage MTD wrapper for the internal flash
+ * @ingroup     drivers_storage
+ * @brief       MTD device on a range of pages of periph_flashpage
+ *
+ * Each flash page is a sector of the MTD device, and a sector holds a single
+ * page, so the pages of the MCU can be erased individually. Writes use
+ * flashpage_write_raw(), so their address and length must be multiples of
+ * @ref FLASHPAGE_RAW_BLOCKSIZE. Reads go to the memory mapped flash.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * // the last four pages of the flash
+ * static mtd_flashpage_t flash = MTD_FLASHPAGE_INIT(FLASHPAGE_NUMOF - 4, 4);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the mtd_flashpage driver
+ */
+
+#ifndef MTD_FLASHPAGE_H
+#define MTD_FLASHPAGE_H
+
+#include "mtd.h"
+#include "periph/flashpage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the buffer for writing unaligned data, in bytes
+ *
+ * Must be a multiple of @ref FLASHPAGE_RAW_BLOCKSIZE.
+ */
+#ifndef MTD_FLASHPAGE_BOUNCE_SIZE
+#define MTD_FLASHPAGE_BOUNCE_SIZE   (64U)
+#endif
+
+/**
+ * @brief   Device descriptor for mtd_flashpage devices
+ *
+ * This is an extension of the @c mtd_dev_t struct
+ */
+typedef struct {
+    mtd_dev_t base;     /**< inherit from mtd_dev_t object */
+    unsigned first;     /**< first flash page of the device */
+} mtd_flashpage_t;
+
+/**
+ * @brief   Static initializer for an mtd_flashpage device
+ *
+ * @param[in] _first    first flash page used
+ * @param[in] _numof    number of flash pages used
+ */
+#define MTD_FLASHPAGE_INIT(_first, _numof) { \
+        .base = { \
+            .driver = &mtd_flashpage_driver, \
+            .sector_count = (_numof), \
+            .pages_per_sector = 1, \
+            .page_size = FLASHPAGE_SIZE, \
+        }, \
+        .first = (_first), \
+    }
+
+/**
+ * @brief   flashpage device operations table for mtd
+ */
+extern const mtd_desc_t mtd_flashpage_driver;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_FLASHPAGE_H */
+/** @} */
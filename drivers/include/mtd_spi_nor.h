@@ -82,6 +82,13 @@ typedef struct __attribute__((packed)) {
  * @brief   Flag to set when the device support 32KiB block erase (block_erase_32k opcode)
  */
 #define SPI_NOR_F_SECT_32K  (2)
+/**
+ * @brief   Flag to set to read using the read_fast opcode
+ *
+ * The fast read command is followed by a dummy byte, but allows higher SPI
+ * clocks than the read command on most devices.
+ */
+#define SPI_NOR_F_FAST_READ (4)
 
 /**
  * @brief   Device descriptor for serial flash memory devices
@@ -413,8 +413,60 @@ typedef struct netdev_driver {
      */
     int (*set)(netdev_t *dev, netopt_t opt,
                const void *value, size_t value_len);
+
+    /**
+     * @brief Get a received frame, scattered into an io vector list
+     *
+     * Optional, may be NULL.  Allows the upper layer to read a frame directly
+     * into the final buffers, e.g. a link layer header and a payload snip of
+     * the packet buffer, without copying it around afterwards.
+     *
+     * The frame is written to the entries of @p iolist in order, filling each
+     * entry completely before using the next one.  Use
+     * @ref netdev_driver_t::recv "recv()" with `buf := NULL` to get the size
+     * of the frame or to drop it.
+     *
+     * @pre `(dev != NULL) && (iolist != NULL)`
+     *
+     * @param[in]   dev     network device descriptor. Must not be NULL.
+     * @param[out]  iolist  io vector list to write the frame into
+     * @param[out]  info    status information for the received packet, see
+     *                      @ref netdev_driver_t::recv "recv()"
+     *
+     * @return `-ENOBUFS` if @p iolist is too small for the frame
+     * @return number of bytes read
+     */
+    int (*recv_iolist)(netdev_t *dev, const iolist_t *iolist, void *info);
 } netdev_driver_t;
 
+/**
+ * @brief   Get a received frame, scattered into an io vector list
+ *
+ * Uses @ref netdev_driver_t::recv_iolist if the driver provides it, and
+ * falls back to @ref netdev_driver_t::recv for single element lists
+ * otherwise.
+ *
+ * @param[in]   dev     network device descriptor. Must not be NULL.
+ * @param[out]  iolist  io vector list to write the frame into
+ * @param[out]  info    status information for the received packet
+ *
+ * @return `-ENOBUFS` if @p iolist is too small for the frame
+ * @return `-ENOTSUP` if @p iolist has more than one element and the driver
+ *         does not support scattered reception
+ * @return number of bytes read
+ */
+static inline int netdev_recv_iolist(netdev_t *dev, const iolist_t *iolist,
+                                     void *info)
+{
+    if (dev->driver->recv_iolist) {
+        return dev->driver->recv_iolist(dev, iolist, info);
+    }
+    if (iolist->iol_next != NULL) {
+        return -ENOTSUP;
+    }
+    return dev->driver->recv(dev, iolist->iol_base, iolist->iol_len, info);
+}
+
 /**
  * @brief   Convenience function for declaring get() as not supported in general
  *
@@ -30,7 +30,8 @@
  * waiting for the result of a conversion (e.g. through putting the calling
  * thread to sleep while waiting for the conversion results).
  *
- * @todo        Extend interface for continuous mode?
+ * With the `periph_adc_stream` feature, a line can be sampled continuously at
+ * a fixed rate, see adc_stream_start().
  *
  * @{
  *
@@ -44,6 +45,8 @@
 #define PERIPH_ADC_H
 
 #include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include "periph_cpu.h"
 #include "periph_conf.h"
@@ -115,6 +118,55 @@ int adc_init(adc_t line);
  */
 int adc_sample(adc_t line, adc_res_t res);
 
+#if defined(MODULE_PERIPH_ADC_STREAM) || defined(DOXYGEN)
+/**
+ * @brief   Called by the ADC stream for each full block of samples
+ *
+ * Called in interrupt context. The block is only valid until the other half
+ * of the buffer is full, i.e. for @p len samples. So usually the callback
+ * only hands the block to a thread, e.g. with thread_flags_set() or
+ * msg_send_int().
+ *
+ * @param[in] arg           argument given to adc_stream_start()
+ * @param[in] block         the full block, right-aligned samples
+ * @param[in] len           number of samples in @p block
+ */
+typedef void (*adc_stream_cb_t)(void *arg, uint16_t *block, size_t len);
+
+/**
+ * @brief   Starts sampling the given ADC line continuously
+ *
+ * The conversions are triggered by a timer at the given rate and written to
+ * @p buf by DMA, without the CPU being involved. @p buf is used as ping-pong
+ * buffer: while DMA fills one half, the other half is passed to @p cb.
+ *
+ * The ADC device of the line is reserved for the stream until
+ * adc_stream_stop() is called, adc_sample() on it blocks meanwhile. Only one
+ * stream can be run at a time. The timer and DMA channel used are given by
+ * the board configuration.
+ *
+ * @param[in] line          line to sample, initialized by adc_init()
+ * @param[in] res           resolution to use for conversion
+ * @param[in] freq          sample rate in Hz
+ * @param[out] buf          buffer for two blocks of samples
+ * @param[in] len           number of samples @p buf takes, must be even
+ * @param[in] cb            called for each full block
+ * @param[in] arg           argument passed to @p cb
+ *
+ * @return                  0 on success
+ * @return                  -1 on invalid line, resolution, rate or length
+ */
+int adc_stream_start(adc_t line, adc_res_t res, uint32_t freq, uint16_t *buf,
+                     size_t len, adc_stream_cb_t cb, void *arg);
+
+/**
+ * @brief   Stops the stream started by adc_stream_start()
+ *
+ * The samples of the block being filled are lost.
+ */
+void adc_stream_stop(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_hwcrypto HWCRYPTO Abstraction
+ * @ingroup     drivers_periph
+ * @brief       Peripheral hardware crypto accelerator interface
+ *
+ * The interface runs AES-128 on the crypto engine of the MCU, typically
+ * moving the data with DMA. It is not meant to be used directly: with the
+ * `periph_hwcrypto` module, @ref sys_crypto dispatches AES-128 and the ECB,
+ * CBC and CTR modes to it, and falls back to software for anything an
+ * engine returns -ENOTSUP for.
+ *
+ * All functions block until the operation completed and serialize concurrent
+ * callers. The data is processed in whole 16 byte blocks.
+ *
+ * @{
+ * @file
+ * @brief       Hardware crypto accelerator driver interface
+ */
+
+#ifndef PERIPH_HWCRYPTO_H
+#define PERIPH_HWCRYPTO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Block size of AES
+ */
+#define HWCRYPTO_AES_BLOCK_SIZE     (16U)
+
+/**
+ * @brief   Key size of AES-128
+ */
+#define HWCRYPTO_AES128_KEY_SIZE    (16U)
+
+/**
+ * @brief   Initialize the crypto engine
+ *
+ * Called by periph_init().
+ */
+void hwcrypto_init(void);
+
+/**
+ * @brief   Encrypt or decrypt blocks with AES-128 in ECB mode
+ *
+ * @param[in]  key      key of @ref HWCRYPTO_AES128_KEY_SIZE bytes
+ * @param[in]  encrypt  true to encrypt, false to decrypt
+ * @param[in]  in       input data
+ * @param[out] out      output data, may be @p in
+ * @param[in]  len      length of @p in, a multiple of the block size
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p len is no multiple of the block size
+ * @return  -ENOTSUP if the engine does not support the operation
+ * @return  -EIO if the engine failed
+ */
+int hwcrypto_aes128_ecb(const uint8_t *key, bool encrypt, const uint8_t *in,
+                        uint8_t *out, size_t len);
+
+/**
+ * @brief   Encrypt or decrypt blocks with AES-128 in CBC mode
+ *
+ * @param[in]  key      key of @ref HWCRYPTO_AES128_KEY_SIZE bytes
+ * @param[in]  encrypt  true to encrypt, false to decrypt
+ * @param[in]  iv       initialization vector, not modified
+ * @param[in]  in       input data
+ * @param[out] out      output data, may be @p in
+ * @param[in]  len      length of @p in, a multiple of the block size
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p len is no multiple of the block size
+ * @return  -ENOTSUP if the engine does not support the operation
+ * @return  -EIO if the engine failed
+ */
+int hwcrypto_aes128_cbc(const uint8_t *key, bool encrypt,
+                        const uint8_t iv[HWCRYPTO_AES_BLOCK_SIZE],
+                        const uint8_t *in, uint8_t *out, size_t len);
+
+/**
+ * @brief   Encrypt or decrypt blocks with AES-128 in CTR mode
+ *
+ * The counter is the big endian number in the last @p ctr_len bytes of
+ * @p ctr, incremented for each block.
+ *
+ * @param[in]  key      key of @ref HWCRYPTO_AES128_KEY_SIZE bytes
+ * @param[in]  ctr      nonce and initial counter, not modified
+ * @param[in]  ctr_len  length of the counter in bytes
+ * @param[in]  in       input data
+ * @param[out] out      output data, may be @p in
+ * @param[in]  len      length of @p in, a multiple of the block size
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p len is no multiple of the block size
+ * @return  -ENOTSUP if the engine does not support the operation, e.g. the
+ *          counter length
+ * @return  -EIO if the engine failed
+ */
+int hwcrypto_aes128_ctr(const uint8_t *key,
+                        const uint8_t ctr[HWCRYPTO_AES_BLOCK_SIZE],
+                        uint8_t ctr_len, const uint8_t *in, uint8_t *out,
+                        size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_HWCRYPTO_H */
+/** @} */
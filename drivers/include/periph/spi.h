@@ -285,6 +285,41 @@ uint8_t spi_transfer_byte(spi_t bus, spi_cs_t cs, bool cont, uint8_t out);
 void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
                         const void *out, void *in, size_t len);
 
+/**
+ * @brief   Signature for the callback signaling the end of a transfer
+ *
+ * @param[in] arg       optional context for the callback
+ */
+typedef void (*spi_cb_t)(void *arg);
+
+/**
+ * @brief   Transfer a number bytes using the given SPI bus, without waiting
+ *          for the end of the transfer
+ *
+ * Same as spi_transfer_bytes(), but returns right after starting the transfer
+ * on platforms that can transfer in the background (e.g. using DMA), so the
+ * calling thread can do something else in the meantime. @p cb is called as
+ * soon as the transfer is done and the chip select line was handled. This
+ * may happen in interrupt context, or even before this function returns on
+ * platforms without background transfers.
+ *
+ * The buffers must stay valid and the bus must not be used or released until
+ * @p cb was called.
+ *
+ * @param[in]  bus      SPI device to use
+ * @param[in]  cs       chip select pin/line to use, set to SPI_CS_UNDEF if chip
+ *                      select should not be handled by the SPI driver
+ * @param[in]  cont     if true, keep device selected after transfer
+ * @param[in]  out      buffer to send data from, set NULL if only receiving
+ * @param[out] in       buffer to read into, set NULL if only sending
+ * @param[in]  len      number of bytes to transfer
+ * @param[in]  cb       callback for the end of the transfer, must not be NULL
+ * @param[in]  arg      optional argument passed to @p cb
+ */
+void spi_transfer_bytes_async(spi_t bus, spi_cs_t cs, bool cont,
+                              const void *out, void *in, size_t len,
+                              spi_cb_t cb, void *arg);
+
 /**
  * @brief   Transfer one byte to/from a given register address
  *
@@ -90,6 +90,16 @@ typedef unsigned int uart_t;
  */
 typedef void(*uart_rx_cb_t)(void *arg, uint8_t data);
 
+/**
+ * @brief   Signature for receive interrupt callback delivering chunks of data
+ *
+ * @param[in] arg           context to the callback (optional)
+ * @param[in] data          the bytes that were received, only valid during the
+ *                          call
+ * @param[in] len           number of bytes in @p data, at least 1
+ */
+typedef void(*uart_rx_block_cb_t)(void *arg, const uint8_t *data, size_t len);
+
 /**
  * @brief   Interrupt context for a UART device
  */
@@ -137,6 +147,25 @@ enum {
  */
 int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg);
 
+/**
+ * @brief   Initialize a given UART device, receiving chunks of data
+ *
+ * Same as uart_init(), but @p rx_cb is called with all bytes received since
+ * its last call. Platforms that receive via DMA call it when their receive
+ * buffer is half full or full, or when the RX line becomes idle, which saves
+ * an interrupt per byte at high baudrates. Elsewhere @p rx_cb is called for
+ * every byte.
+ *
+ * @param[in] uart          UART device to initialize
+ * @param[in] baudrate      desired baudrate in baud/s
+ * @param[in] rx_cb         receive callback, executed in interrupt context
+ * @param[in] arg           optional context passed to the callback functions
+ *
+ * @return                  return values of uart_init()
+ */
+int uart_init_block(uart_t uart, uint32_t baudrate, uart_rx_block_cb_t rx_cb,
+                    void *arg);
+
 /**
  * @brief   Write data from the given buffer to the specified UART device
  *
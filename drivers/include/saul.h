@@ -142,6 +142,24 @@ typedef int(*saul_read_t)(const void *dev, phydat_t *res);
  */
 typedef int(*saul_write_t)(const void *dev, phydat_t *data);
 
+/**
+ * @brief   Read a burst of samples buffered by a device
+ *
+ * Sensors with a hardware FIFO use this to hand out everything they have
+ * collected since the last call in a single bus transaction, e.g. after a
+ * FIFO watermark interrupt woke up the MCU. Each element of @p res holds one
+ * sample with the same dimension as returned by the device's saul_read_t.
+ *
+ * @param[in] dev       device descriptor of the target device
+ * @param[out] res      array to store the samples in
+ * @param[in] max       number of elements in @p res
+ *
+ * @return  number of samples written into @p res, 0 if none were buffered
+ * @return  -ENOTSUP if the device does not buffer samples
+ * @return  -ECANCELED on other errors
+ */
+typedef int(*saul_read_burst_t)(const void *dev, phydat_t *res, unsigned max);
+
 /**
  * @brief   Definition of the RIOT actuator/sensor interface
  */
@@ -149,6 +167,8 @@ typedef struct {
     saul_read_t read;       /**< read function pointer */
     saul_write_t write;     /**< write function pointer */
     uint8_t type;           /**< device class the device belongs to */
+    saul_read_burst_t read_burst;   /**< burst read function pointer, NULL if
+                                     *   the device does not buffer samples */
 } saul_driver_t;
 
 /**
@@ -25,6 +25,9 @@
 #define SI70XX_H
 
 #include "periph/i2c.h"
+#ifdef MODULE_I2C_ASYNC
+#include "i2c_async.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -118,6 +121,47 @@ uint8_t si70xx_get_id(const si70xx_t *dev);
  */
 uint8_t si70xx_get_revision(const si70xx_t *dev);
 
+#if defined(MODULE_I2C_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Asynchronous Si70xx request, see @ref drivers_i2c_async
+ *
+ * The completion callback is called with &si70xx_async_t::req.
+ */
+typedef struct {
+    i2c_async_req_t req;        /**< I2C request, must be the first member */
+    i2c_async_op_t ops[4];      /**< transfers of the request */
+    uint8_t cmd[2];             /**< measurement commands */
+    uint8_t buf[4];             /**< raw humidity and temperature */
+} si70xx_async_t;
+
+/**
+ * @brief   Read the relative humidity and temperature without blocking
+ *
+ * Same measurement as si70xx_get_both(), convert the results in @p cb with
+ * si70xx_async_results().
+ *
+ * @param[in] dev           device descriptor
+ * @param[out] req          request to use, must stay valid until @p cb
+ * @param[in] cb            completion callback
+ * @param[in] arg           argument stored in the request
+ */
+void si70xx_get_both_async(const si70xx_t *dev, si70xx_async_t *req,
+                           i2c_async_cb_t cb, void *arg);
+
+/**
+ * @brief   Convert the results of a completed si70xx_get_both_async()
+ *
+ * @param[in] req           completed request
+ * @param[out] humidity     pointer to relative humidity (in centi-percent)
+ * @param[out] temperature  pointer to temperature (in centi-degrees Celsius)
+ *
+ * @return                  SI70XX_OK on success
+ * @return                  -SI70XX_ERR_I2C if the request failed
+ */
+int si70xx_async_results(const si70xx_async_t *req, uint16_t *humidity,
+                         int16_t *temperature);
+#endif /* MODULE_I2C_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
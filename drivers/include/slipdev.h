@@ -44,6 +44,15 @@ extern "C" {
 #define SLIPDEV_BUFSIZE (2048U)
 #endif
 
+/**
+ * @brief   Maximum number of received frames waiting to be fetched
+ *
+ * @pre Needs to be power of two
+ */
+#ifndef SLIPDEV_RX_FRAMES
+#define SLIPDEV_RX_FRAMES   (4U)
+#endif
+
 /**
  * @brief   Configuration parameters for a slipdev
  */
@@ -60,10 +69,18 @@ typedef struct {
 typedef struct {
     netdev_t netdev;                        /**< parent class */
     slipdev_params_t config;                /**< configuration parameters */
-    tsrb_t inbuf;                           /**< RX buffer */
+    tsrb_t inbuf;                           /**< RX buffer, holds decoded
+                                             *   frames */
     char rxmem[SLIPDEV_BUFSIZE];            /**< memory used by RX buffer */
+    cib_t rx_frames_idx;                    /**< index of slipdev_t::rx_frames */
+    uint16_t rx_frames[SLIPDEV_RX_FRAMES];  /**< sizes of the frames in
+                                             *   slipdev_t::inbuf */
+    uint16_t rx_len;                        /**< size of the frame currently
+                                             *   received */
     uint16_t inesc;                         /**< device previously received an escape
                                              *   byte */
+    uint8_t rx_drop;                        /**< frame currently received does
+                                             *   not fit into the RX buffer */
 } slipdev_t;
 
 /**
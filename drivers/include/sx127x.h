@@ -64,6 +64,9 @@
 #include "net/netdev.h"
 #include "periph/gpio.h"
 #include "periph/spi.h"
+#ifdef MODULE_ENERGY
+#include "energy.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -97,6 +100,14 @@ extern "C" {
 #endif
 /** @} */
 
+/**
+ * @brief   Number of symbols after which a channel activity detection is
+ *          considered as failed
+ */
+#ifndef SX127X_CAD_TIMEOUT_SYMBOLS
+#define SX127X_CAD_TIMEOUT_SYMBOLS       (4U)
+#endif
+
 /**
  * @brief   SX127X initialization result.
  */
@@ -160,6 +171,7 @@ enum {
 #define SX127X_CHANNEL_HOPPING_FLAG             (1 << 3)
 #define SX127X_IQ_INVERTED_FLAG                 (1 << 4)
 #define SX127X_RX_CONTINUOUS_FLAG               (1 << 5)
+#define SX127X_LBT_FLAG                         (1 << 6)
 /** @} */
 
 /**
@@ -222,6 +234,16 @@ typedef struct {
  */
 typedef uint8_t sx127x_flags_t;
 
+/**
+ * @brief   Current in µA for each @ref netopt_state_t, for the energy module
+ *
+ * Typical values of the SX1276 with LoRa at 125 kHz bandwidth and +13 dBm.
+ * Transmitting at higher power draws up to 120 mA.
+ */
+#ifndef SX127X_ENERGY_UA
+#define SX127X_ENERGY_UA        { 0, 0, 10800, 10800, 29000, 1600, 1600 }
+#endif
+
 /**
  * @brief   SX127X device descriptor.
  * @extends netdev_t
@@ -232,6 +254,9 @@ typedef struct {
     sx127x_params_t params;            /**< Device driver parameters */
     sx127x_internal_t _internal;       /**< Internal sx127x data used within the driver */
     sx127x_flags_t irq;                /**< Device IRQ flags */
+#ifdef MODULE_ENERGY
+    energy_netdev_t energy;            /**< time spent in each state */
+#endif
 } sx127x_t;
 
 /**
@@ -302,6 +327,40 @@ void sx127x_start_cad(sx127x_t *dev);
  */
 bool sx127x_is_channel_free(sx127x_t *dev, uint32_t freq, int16_t rssi_threshold);
 
+/**
+ * @brief   Runs a channel activity detection on the current channel and waits
+ *          for its end
+ *
+ * Unlike sx127x_start_cad(), the result is polled and no
+ * NETDEV_EVENT_CAD_DONE is raised. CAD detects LoRa preambles of the
+ * configured spreading factor and bandwidth within a few symbols, which is
+ * faster and more reliable than an RSSI measurement. The radio is in standby
+ * afterwards.
+ *
+ * @param[in] dev                      The sx127x device descriptor
+ *
+ * @return true if activity was detected or CAD did not finish within
+ *         @ref SX127X_CAD_TIMEOUT_SYMBOLS, false otherwise or if not in LoRa
+ *         mode
+ */
+bool sx127x_cad(sx127x_t *dev);
+
+/**
+ * @brief   Scans channels for the first one without activity, using
+ *          sx127x_cad()
+ *
+ * The channel of @p dev is left at the last scanned channel, i.e. at the free
+ * channel if one was found.
+ *
+ * @param[in] dev                      The sx127x device descriptor
+ * @param[in] channels                 RF frequencies of the channels
+ * @param[in] numof                    number of entries in @p channels
+ *
+ * @return index of the first free channel in @p channels
+ * @return -EBUSY if there is activity on all channels
+ */
+int sx127x_cad_scan(sx127x_t *dev, const uint32_t *channels, unsigned numof);
+
 /**
  * @brief   Reads the current RSSI value.
  *
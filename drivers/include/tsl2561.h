@@ -26,6 +26,9 @@
 
 #include "saul.h"
 #include "periph/i2c.h"
+#ifdef MODULE_I2C_ASYNC
+#include "i2c_async.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -105,6 +108,68 @@ int tsl2561_init(tsl2561_t *dev, const tsl2561_params_t *params);
  */
 uint16_t tsl2561_read_illuminance(const tsl2561_t *dev);
 
+#if defined(MODULE_I2C_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Asynchronous TSL2561 request, see @ref drivers_i2c_async
+ *
+ * The completion callback is called with &tsl2561_async_t::req.
+ */
+typedef struct {
+    i2c_async_req_t req;               /**< I2C request, must be first */
+    i2c_async_op_t ops[3];             /**< transfers of the request */
+    const tsl2561_t *dev;              /**< device the request is for */
+    uint8_t ctrl;                      /**< control register value */
+    uint8_t buf[4];                    /**< raw channel values */
+} tsl2561_async_t;
+
+/**
+ * @brief   Get the integration time of a device
+ *
+ * @param[in]  dev          Device descriptor of TSL2561 device
+ *
+ * @return                  Integration time in us
+ */
+uint32_t tsl2561_integration_time(const tsl2561_t *dev);
+
+/**
+ * @brief   Power on the device without blocking, starting an integration
+ *
+ * Read the results with tsl2561_read_async()
+ * tsl2561_integration_time() us after the callback was called.
+ *
+ * @param[in]  dev          Device descriptor of TSL2561 device
+ * @param[out] req          Request to use, must stay valid until @p cb
+ * @param[in]  cb           Completion callback
+ * @param[in]  arg          Argument stored in the request
+ */
+void tsl2561_start_async(const tsl2561_t *dev, tsl2561_async_t *req,
+                         i2c_async_cb_t cb, void *arg);
+
+/**
+ * @brief   Read both channels and power off without blocking
+ *
+ * Get the illuminance in @p cb with tsl2561_async_illuminance().
+ *
+ * @param[in]  dev          Device descriptor of TSL2561 device
+ * @param[out] req          Request to use, must stay valid until @p cb
+ * @param[in]  cb           Completion callback
+ * @param[in]  arg          Argument stored in the request
+ */
+void tsl2561_read_async(const tsl2561_t *dev, tsl2561_async_t *req,
+                        i2c_async_cb_t cb, void *arg);
+
+/**
+ * @brief   Compute the illuminance of a completed tsl2561_read_async()
+ *
+ * @param[in]  req          Completed request
+ * @param[out] lux          Illuminance in Lux (lx)
+ *
+ * @return                  0 on success
+ * @return                  -1 if the request failed
+ */
+int tsl2561_async_illuminance(const tsl2561_async_t *req, uint16_t *lux);
+#endif /* MODULE_I2C_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
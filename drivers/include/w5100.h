@@ -34,6 +34,7 @@
 #ifndef W5100_H
 #define W5100_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "periph/spi.h"
@@ -67,6 +68,12 @@ typedef struct {
 typedef struct {
     netdev_t nd;            /**< extends the netdev structure */
     w5100_params_t p;       /**< device configuration parameters */
+    uint16_t tx_wr;         /**< TX write pointer */
+    uint16_t rx_rd;         /**< RX read pointer */
+    uint16_t rx_avail;      /**< received bytes not consumed yet */
+    uint16_t rx_psize;      /**< size field of the next packet, 0 if not
+                             *   read yet */
+    bool tx_busy;           /**< a send was triggered and not waited for */
 } w5100_t;
 
 /**
@@ -82,9 +82,15 @@ int lis3dh_init(lis3dh_t *dev, const lis3dh_params_t *params)
     return 0;
 }
 
-int lis3dh_read_xyz(const lis3dh_t *dev, lis3dh_data_t *acc_data)
+/**
+ * @brief Read @p num samples from the output registers in one transaction
+ *
+ * While the FIFO is enabled the register address wraps from OUT_Z_H back to
+ * OUT_X_L, so this drains @p num samples from the FIFO.
+ */
+static void lis3dh_read_samples(const lis3dh_t *dev, lis3dh_data_t *acc_data,
+                                unsigned num)
 {
-    uint8_t i;
     /* Set READ MULTIPLE mode */
     static const uint8_t addr = (LIS3DH_REG_OUT_X_L | LIS3DH_SPI_READ_MASK |
                                  LIS3DH_SPI_MULTI_MASK);
@@ -93,21 +99,44 @@ int lis3dh_read_xyz(const lis3dh_t *dev, lis3dh_data_t *acc_data)
     spi_acquire(DEV_SPI, DEV_CS, SPI_MODE, DEV_CLK);
     /* Perform the transaction */
     spi_transfer_regs(DEV_SPI, DEV_CS, addr,
-                      NULL, acc_data, sizeof(lis3dh_data_t));
+                      NULL, acc_data, num * sizeof(lis3dh_data_t));
     /* Release the bus for other threads. */
     spi_release(DEV_SPI);
 
     /* Scale to milli-G */
-    for (i = 0; i < 3; ++i) {
+    for (unsigned i = 0; i < (num * 3); ++i) {
         int32_t tmp = (int32_t)(((int16_t *)acc_data)[i]);
         tmp *= dev->scale;
         tmp /= 32768;
         (((int16_t *)acc_data)[i]) = (int16_t)tmp;
     }
+}
+
+int lis3dh_read_xyz(const lis3dh_t *dev, lis3dh_data_t *acc_data)
+{
+    lis3dh_read_samples(dev, acc_data, 1);
 
     return 0;
 }
 
+int lis3dh_read_fifo(const lis3dh_t *dev, lis3dh_data_t *acc_data,
+                     unsigned max)
+{
+    int level = lis3dh_get_fifo_level(dev);
+
+    if (level < 0) {
+        return -1;
+    }
+    if ((unsigned)level > max) {
+        level = max;
+    }
+    if (level > 0) {
+        lis3dh_read_samples(dev, acc_data, level);
+    }
+
+    return level;
+}
+
 int lis3dh_read_aux_adc1(const lis3dh_t *dev, int16_t *out)
 {
     return lis3dh_read_regs(dev, LIS3DH_REG_OUT_AUX_ADC1_L,
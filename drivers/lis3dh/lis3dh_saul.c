@@ -44,8 +44,39 @@ static int read_acc(const void *dev, phydat_t *res)
     return 3;
 }
 
+static int read_acc_burst(const void *dev, phydat_t *res, unsigned max)
+{
+    lis3dh_data_t xyz[8];
+    unsigned num = 0;
+
+    while (num < max) {
+        unsigned chunk = max - num;
+        if (chunk > sizeof(xyz) / sizeof(xyz[0])) {
+            chunk = sizeof(xyz) / sizeof(xyz[0]);
+        }
+        int got = lis3dh_read_fifo((const lis3dh_t *)dev, xyz, chunk);
+        if (got < 0) {
+            return -ECANCELED;
+        }
+        for (int i = 0; i < got; i++) {
+            res[num].val[0] = xyz[i].acc_x;
+            res[num].val[1] = xyz[i].acc_y;
+            res[num].val[2] = xyz[i].acc_z;
+            res[num].scale = -3;
+            res[num].unit = UNIT_G;
+            num++;
+        }
+        if ((unsigned)got < chunk) {
+            break;
+        }
+    }
+
+    return num;
+}
+
 const saul_driver_t lis3dh_saul_driver = {
     .read = read_acc,
     .write = saul_notsup,
     .type = SAUL_SENSE_ACCEL,
+    .read_burst = read_acc_burst,
 };
@@ -171,6 +171,137 @@ int lsm6dsl_read_gyro(const lsm6dsl_t *dev, lsm6dsl_3d_data_t *data)
     return LSM6DSL_OK;
 }
 
+/**
+ * @brief   Number of 16-bit words per FIFO data set, 0 on invalid decimation
+ */
+static unsigned _fifo_words_per_set(const lsm6dsl_t *dev)
+{
+    unsigned words = 0;
+
+    if (dev->params.gyro_decimation != LSM6DSL_DECIMATION_NOT_IN_FIFO) {
+        words += 3;
+    }
+    if (dev->params.acc_decimation != LSM6DSL_DECIMATION_NOT_IN_FIFO) {
+        if ((words > 0) &&
+            (dev->params.acc_decimation != dev->params.gyro_decimation)) {
+            return 0;
+        }
+        words += 3;
+    }
+    return words;
+}
+
+static void _fifo_sample(const uint8_t *buf, lsm6dsl_3d_data_t *data,
+                         int16_t range)
+{
+    data->x = ((int32_t)(int16_t)(buf[0] | (buf[1] << 8)) * range) / INT16_MAX;
+    data->y = ((int32_t)(int16_t)(buf[2] | (buf[3] << 8)) * range) / INT16_MAX;
+    data->z = ((int32_t)(int16_t)(buf[4] | (buf[5] << 8)) * range) / INT16_MAX;
+}
+
+int lsm6dsl_read_fifo(const lsm6dsl_t *dev, lsm6dsl_3d_data_t *acc,
+                      lsm6dsl_3d_data_t *gyro, unsigned max)
+{
+    uint8_t buf[LSM6DSL_FIFO_BURST_SETS * 6 * 2];
+    unsigned wps = _fifo_words_per_set(dev);
+    unsigned words, pattern, sets;
+    bool has_gyro = (dev->params.gyro_decimation != LSM6DSL_DECIMATION_NOT_IN_FIFO);
+    bool has_acc = (dev->params.acc_decimation != LSM6DSL_DECIMATION_NOT_IN_FIFO);
+
+    if (wps == 0) {
+        DEBUG("[ERROR] lsm6dsl_read_fifo: decimation\n");
+        return -LSM6DSL_ERROR_CNF;
+    }
+    assert(dev->params.acc_fs < LSM6DSL_ACC_FS_MAX);
+    assert(dev->params.gyro_fs < LSM6DSL_GYRO_FS_MAX);
+
+    i2c_acquire(BUS);
+    if (i2c_read_regs(BUS, ADDR, LSM6DSL_REG_FIFO_STATUS1, buf, 4, 0) < 0) {
+        i2c_release(BUS);
+        return -LSM6DSL_ERROR_BUS;
+    }
+    words = buf[0] | ((buf[1] & LSM6DSL_FIFO_STATUS2_DIFF_MASK) << 8);
+    pattern = buf[2] | ((buf[3] & LSM6DSL_FIFO_STATUS4_PATTERN_MASK) << 8);
+
+    /* drop the rest of a partially read data set */
+    unsigned skip = (wps - (pattern % wps)) % wps;
+    if (skip > words) {
+        skip = words;
+    }
+    if ((skip > 0) &&
+        (i2c_read_regs(BUS, ADDR, LSM6DSL_REG_FIFO_DATA_OUT_L, buf,
+                       skip * 2, 0) < 0)) {
+        i2c_release(BUS);
+        return -LSM6DSL_ERROR_BUS;
+    }
+    sets = (words - skip) / wps;
+    if (sets > max) {
+        sets = max;
+    }
+
+    /* FIFO_DATA_OUT_H wraps to FIFO_DATA_OUT_L, so a burst drains the FIFO */
+    for (unsigned done = 0; done < sets; ) {
+        unsigned chunk = sets - done;
+        if (chunk > LSM6DSL_FIFO_BURST_SETS) {
+            chunk = LSM6DSL_FIFO_BURST_SETS;
+        }
+        if (i2c_read_regs(BUS, ADDR, LSM6DSL_REG_FIFO_DATA_OUT_L, buf,
+                          chunk * wps * 2, 0) < 0) {
+            i2c_release(BUS);
+            DEBUG("[ERROR] lsm6dsl_read_fifo\n");
+            return -LSM6DSL_ERROR_BUS;
+        }
+        for (unsigned i = 0; i < chunk; i++, done++) {
+            const uint8_t *set = &buf[i * wps * 2];
+            if (has_gyro) {
+                if (gyro) {
+                    _fifo_sample(set, &gyro[done],
+                                 range_gyro[dev->params.gyro_fs]);
+                }
+                set += 6;
+            }
+            if (has_acc && acc) {
+                _fifo_sample(set, &acc[done], range_acc[dev->params.acc_fs]);
+            }
+        }
+    }
+    i2c_release(BUS);
+
+    return sets;
+}
+
+int lsm6dsl_set_fifo_watermark(const lsm6dsl_t *dev, uint16_t sets)
+{
+    unsigned wps = _fifo_words_per_set(dev);
+    uint32_t words = (uint32_t)sets * wps;
+    uint8_t tmp;
+    int res;
+
+    if ((wps == 0) || (words > 0x7ff)) {
+        return -LSM6DSL_ERROR_CNF;
+    }
+
+    i2c_acquire(BUS);
+    res = i2c_write_reg(BUS, ADDR, LSM6DSL_REG_FIFO_CTRL1, words & 0xff, 0);
+    res += i2c_write_reg(BUS, ADDR, LSM6DSL_REG_FIFO_CTRL2,
+                         (words >> 8) & LSM6DSL_FIFO_CTRL2_FTH_MASK, 0);
+    res += i2c_read_reg(BUS, ADDR, LSM6DSL_REG_INT1_CTRL, &tmp, 0);
+    if (sets > 0) {
+        tmp |= LSM6DSL_INT1_CTRL_FTH;
+    }
+    else {
+        tmp &= ~LSM6DSL_INT1_CTRL_FTH;
+    }
+    res += i2c_write_reg(BUS, ADDR, LSM6DSL_REG_INT1_CTRL, tmp, 0);
+    i2c_release(BUS);
+
+    if (res < 0) {
+        DEBUG("[ERROR] lsm6dsl_set_fifo_watermark\n");
+        return -LSM6DSL_ERROR_BUS;
+    }
+    return LSM6DSL_OK;
+}
+
 int lsm6dsl_read_temp(const lsm6dsl_t *dev, int16_t *data)
 {
     uint8_t tmp;
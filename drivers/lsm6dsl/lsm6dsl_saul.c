@@ -20,7 +20,10 @@
  * @}
  */
 
+#include <stdbool.h>
+
 #include "lsm6dsl.h"
+#include "lsm6dsl_internal.h"
 #include "saul.h"
 
 static int read_acc(const void *dev, phydat_t *res)
@@ -49,6 +52,48 @@ static int read_gyro(const void *dev, phydat_t *res)
     return 3;
 }
 
+static int read_burst(const void *dev, phydat_t *res, unsigned max, bool acc)
+{
+    lsm6dsl_3d_data_t data[LSM6DSL_FIFO_BURST_SETS];
+    unsigned num = 0;
+
+    while (num < max) {
+        unsigned chunk = max - num;
+        if (chunk > LSM6DSL_FIFO_BURST_SETS) {
+            chunk = LSM6DSL_FIFO_BURST_SETS;
+        }
+        int got = lsm6dsl_read_fifo((const lsm6dsl_t *)dev,
+                                    acc ? data : NULL, acc ? NULL : data,
+                                    chunk);
+        if (got < 0) {
+            return -ECANCELED;
+        }
+        for (int i = 0; i < got; i++) {
+            res[num].val[0] = data[i].x;
+            res[num].val[1] = data[i].y;
+            res[num].val[2] = data[i].z;
+            res[num].scale = acc ? -3 : -1;
+            res[num].unit = acc ? UNIT_G : UNIT_DPS;
+            num++;
+        }
+        if ((unsigned)got < chunk) {
+            break;
+        }
+    }
+
+    return num;
+}
+
+static int read_acc_burst(const void *dev, phydat_t *res, unsigned max)
+{
+    return read_burst(dev, res, max, true);
+}
+
+static int read_gyro_burst(const void *dev, phydat_t *res, unsigned max)
+{
+    return read_burst(dev, res, max, false);
+}
+
 static int read_temp(const void *dev, phydat_t *res)
 {
     if (lsm6dsl_read_temp((const lsm6dsl_t *)dev, (int16_t *)&res[0]) < 0) {
@@ -64,12 +109,14 @@ const saul_driver_t lsm6dsl_saul_acc_driver = {
     .read = read_acc,
     .write = saul_notsup,
     .type = SAUL_SENSE_ACCEL,
+    .read_burst = read_acc_burst,
 };
 
 const saul_driver_t lsm6dsl_saul_gyro_driver = {
     .read = read_gyro,
     .write = saul_notsup,
     .type = SAUL_SENSE_GYRO,
+    .read_burst = read_gyro_burst,
 };
 
 const saul_driver_t lsm6dsl_saul_temp_driver = {
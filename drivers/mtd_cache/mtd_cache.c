@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_cache
+ * @{
+ *
+ * @file
+ * @brief       LRU write-back page cache for MTD devices
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "mtd_cache.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define UNUSED      (UINT32_MAX)
+
+static uint8_t *_data(mtd_cache_t *cache, unsigned idx)
+{
+    return cache->buf + (idx * cache->base.page_size);
+}
+
+static int _find(mtd_cache_t *cache, uint32_t page)
+{
+    for (unsigned i = 0; i < cache->numof; i++) {
+        if (cache->pages[i].page == page) {
+            cache->pages[i].used = ++cache->clock;
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int _write_back(mtd_cache_t *cache, unsigned idx)
+{
+    mtd_cache_page_t *p = &cache->pages[idx];
+
+    if (p->dirty_end == 0) {
+        return 0;
+    }
+    DEBUG("mtd_cache: write back page %lu\n", (unsigned long)p->page);
+    int res = mtd_write(cache->parent, _data(cache, idx) + p->dirty_start,
+                        (p->page * cache->base.page_size) + p->dirty_start,
+                        p->dirty_end - p->dirty_start);
+    if (res < 0) {
+        return res;
+    }
+    p->dirty_end = 0;
+    return 0;
+}
+
+/* returns the least recently used slot, written back and unused */
+static int _victim(mtd_cache_t *cache)
+{
+    unsigned idx = 0;
+
+    for (unsigned i = 0; i < cache->numof; i++) {
+        if (cache->pages[i].page == UNUSED) {
+            return i;
+        }
+        if (cache->pages[i].used < cache->pages[idx].used) {
+            idx = i;
+        }
+    }
+    int res = _write_back(cache, idx);
+    if (res < 0) {
+        return res;
+    }
+    cache->pages[idx].page = UNUSED;
+    return idx;
+}
+
+static int _load(mtd_cache_t *cache, uint32_t page)
+{
+    int idx = _victim(cache);
+
+    if (idx < 0) {
+        return idx;
+    }
+    DEBUG("mtd_cache: load page %lu\n", (unsigned long)page);
+    int res = mtd_read(cache->parent, _data(cache, idx),
+                       page * cache->base.page_size, cache->base.page_size);
+    if (res < 0) {
+        return res;
+    }
+    cache->pages[idx].page = page;
+    cache->pages[idx].used = ++cache->clock;
+    cache->pages[idx].dirty_end = 0;
+    return idx;
+}
+
+static uint32_t _page_count(mtd_cache_t *cache)
+{
+    return cache->base.sector_count * cache->base.pages_per_sector;
+}
+
+static int _init(mtd_dev_t *dev)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    int res = mtd_init(cache->parent);
+
+    if (res < 0) {
+        return res;
+    }
+    dev->sector_count = cache->parent->sector_count;
+    dev->pages_per_sector = cache->parent->pages_per_sector;
+    dev->page_size = cache->parent->page_size;
+    mutex_init(&cache->lock);
+    cache->clock = 0;
+    for (unsigned i = 0; i < cache->numof; i++) {
+        cache->pages[i].page = UNUSED;
+        cache->pages[i].dirty_end = 0;
+    }
+    DEBUG("mtd_cache: %u pages of %lu bytes\n", cache->numof,
+          (unsigned long)dev->page_size);
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t page_size = dev->page_size;
+    uint8_t *dst = buff;
+    uint32_t left = size;
+    int res = 0;
+
+    if ((addr + size) > (_page_count(cache) * page_size)) {
+        return -EOVERFLOW;
+    }
+    mutex_lock(&cache->lock);
+    while (left > 0) {
+        uint32_t page = addr / page_size;
+        uint32_t off = addr % page_size;
+        uint32_t len = page_size - off;
+        int idx = _find(cache, page);
+
+        if (len > left) {
+            len = left;
+        }
+        if ((idx < 0) && (len == page_size)) {
+            /* whole pages that are not cached bypass the cache */
+            while (((len + page_size) <= left) &&
+                   (_find(cache, page + (len / page_size)) < 0)) {
+                len += page_size;
+            }
+            res = mtd_read(cache->parent, dst, addr, len);
+            if (res < 0) {
+                break;
+            }
+        }
+        else {
+            if (idx < 0) {
+                idx = _load(cache, page);
+                if (idx < 0) {
+                    res = idx;
+                    break;
+                }
+                /* never evict the page just loaded */
+                for (unsigned i = 1; (i <= cache->read_ahead) &&
+                     (i < cache->numof); i++) {
+                    if (((page + i) >= _page_count(cache)) ||
+                        (_find(cache, page + i) >= 0) ||
+                        (_load(cache, page + i) < 0)) {
+                        break;
+                    }
+                }
+            }
+            memcpy(dst, _data(cache, idx) + off, len);
+        }
+        dst += len;
+        addr += len;
+        left -= len;
+    }
+    mutex_unlock(&cache->lock);
+    return (res < 0) ? res : (int)size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t page_size = dev->page_size;
+    uint32_t page = addr / page_size;
+    uint32_t off = addr % page_size;
+    int idx;
+
+    if (((off + size) > page_size) ||
+        ((addr + size) > (_page_count(cache) * page_size))) {
+        return -EOVERFLOW;
+    }
+    if (size == 0) {
+        return 0;
+    }
+    mutex_lock(&cache->lock);
+    idx = _find(cache, page);
+    if (idx < 0) {
+        if (size == page_size) {
+            /* overwritten completely, no need to read it */
+            idx = _victim(cache);
+            if (idx >= 0) {
+                cache->pages[idx].page = page;
+                cache->pages[idx].used = ++cache->clock;
+                cache->pages[idx].dirty_end = 0;
+            }
+        }
+        else {
+            idx = _load(cache, page);
+        }
+        if (idx < 0) {
+            mutex_unlock(&cache->lock);
+            return idx;
+        }
+    }
+
+    mtd_cache_page_t *p = &cache->pages[idx];
+    memcpy(_data(cache, idx) + off, buff, size);
+    if (p->dirty_end == 0) {
+        p->dirty_start = off;
+        p->dirty_end = off + size;
+    }
+    else {
+        /* bytes in between are written with their current content */
+        if (off < p->dirty_start) {
+            p->dirty_start = off;
+        }
+        if ((off + size) > p->dirty_end) {
+            p->dirty_end = off + size;
+        }
+    }
+    mutex_unlock(&cache->lock);
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t first = addr / dev->page_size;
+    uint32_t last = (addr + size) / dev->page_size;
+
+    mutex_lock(&cache->lock);
+    /* pending writes to erased pages are void */
+    for (unsigned i = 0; i < cache->numof; i++) {
+        if ((cache->pages[i].page >= first) && (cache->pages[i].page < last)) {
+            cache->pages[i].page = UNUSED;
+            cache->pages[i].dirty_end = 0;
+        }
+    }
+    int res = mtd_erase(cache->parent, addr, size);
+    mutex_unlock(&cache->lock);
+    return res;
+}
+
+static int _flush(mtd_dev_t *dev)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    int res = 0;
+
+    mutex_lock(&cache->lock);
+    for (unsigned i = 0; i < cache->numof; i++) {
+        int tmp = _write_back(cache, i);
+        if (tmp < 0) {
+            res = tmp;
+        }
+    }
+    if (res == 0) {
+        res = mtd_flush(cache->parent);
+    }
+    mutex_unlock(&cache->lock);
+    return res;
+}
+
+static int _power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    if (power == MTD_POWER_DOWN) {
+        int res = _flush(dev);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return mtd_power(cache->parent, power);
+}
+
+const mtd_desc_t mtd_cache_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .power = _power,
+    .flush = _flush,
+};
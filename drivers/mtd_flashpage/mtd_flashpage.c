@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_flashpage
+ * @{
+ *
+ * @file
+ * @brief       Driver for using periph_flashpage via mtd interface
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "mtd_flashpage.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static uint8_t *_addr(mtd_dev_t *dev, uint32_t addr)
+{
+    mtd_flashpage_t *flash = (mtd_flashpage_t *)dev;
+
+    return (uint8_t *)flashpage_addr(flash->first) + addr;
+}
+
+static int _check(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    uint32_t total = dev->sector_count * FLASHPAGE_SIZE;
+
+    if ((addr > total) || (size > (total - addr))) {
+        return -EOVERFLOW;
+    }
+    return 0;
+}
+
+static int _init(mtd_dev_t *dev)
+{
+    mtd_flashpage_t *flash = (mtd_flashpage_t *)dev;
+
+    if ((flash->first + dev->sector_count) > FLASHPAGE_NUMOF) {
+        return -EOVERFLOW;
+    }
+    dev->pages_per_sector = 1;
+    dev->page_size = FLASHPAGE_SIZE;
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    int res = _check(dev, addr, size);
+
+    if (res < 0) {
+        return res;
+    }
+    memcpy(buff, _addr(dev, addr), size);
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    DEBUG("mtd_flashpage_write: addr:%" PRIu32 " size:%" PRIu32 "\n",
+          addr, size);
+    int res = _check(dev, addr, size);
+
+    if (res < 0) {
+        return res;
+    }
+    if ((addr % FLASHPAGE_RAW_ALIGNMENT) || (size % FLASHPAGE_RAW_BLOCKSIZE)) {
+        return -EINVAL;
+    }
+    if (((uintptr_t)buff % FLASHPAGE_RAW_ALIGNMENT) == 0) {
+        flashpage_write_raw(_addr(dev, addr), buff, size);
+        return size;
+    }
+
+    /* flashpage_write_raw() needs an aligned source */
+    uint64_t bounce[MTD_FLASHPAGE_BOUNCE_SIZE / sizeof(uint64_t)];
+    const uint8_t *src = buff;
+
+    for (uint32_t done = 0; done < size;) {
+        uint32_t chunk = size - done;
+
+        if (chunk > sizeof(bounce)) {
+            chunk = sizeof(bounce);
+        }
+        memcpy(bounce, src + done, chunk);
+        flashpage_write_raw(_addr(dev, addr + done), bounce, chunk);
+        done += chunk;
+    }
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    mtd_flashpage_t *flash = (mtd_flashpage_t *)dev;
+    int res = _check(dev, addr, size);
+
+    if (res < 0) {
+        return res;
+    }
+    if ((addr % FLASHPAGE_SIZE) || (size % FLASHPAGE_SIZE)) {
+        return -EOVERFLOW;
+    }
+    for (uint32_t page = addr / FLASHPAGE_SIZE;
+         page < ((addr + size) / FLASHPAGE_SIZE); page++) {
+        flashpage_write(flash->first + page, NULL);
+    }
+    return 0;
+}
+
+static int _power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    (void)dev;
+    (void)power;
+    return -ENOTSUP;
+}
+
+const mtd_desc_t mtd_flashpage_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .power = _power,
+};
@@ -48,6 +48,14 @@
 #define MTD_SPI_NOR_WRITE_WAIT_US (50 * US_PER_MS)
 #endif
 
+/* first status polling interval, doubled up to MTD_SPI_NOR_WRITE_WAIT_US */
+#ifndef MTD_SPI_NOR_PROGRAM_WAIT_US
+#define MTD_SPI_NOR_PROGRAM_WAIT_US (100U)
+#endif
+#ifndef MTD_SPI_NOR_ERASE_WAIT_US
+#define MTD_SPI_NOR_ERASE_WAIT_US   (1000U)
+#endif
+
 #define MTD_32K             (32768ul)
 #define MTD_32K_ADDR_MASK   (0x7FFF)
 #define MTD_4K              (4096ul)
@@ -74,11 +82,13 @@ const mtd_desc_t mtd_spi_nor_driver = {
  * @param[in]  dev    pointer to device descriptor
  * @param[in]  opcode command opcode
  * @param[in]  addr   address (big endian)
+ * @param[in]  dummy  number of dummy bytes to send after the address
  * @param[out] dest   read buffer
  * @param[in]  count  number of bytes to read after the address has been sent
  */
 static void mtd_spi_cmd_addr_read(const mtd_spi_nor_t *dev, uint8_t opcode,
-                                  be_uint32_t addr, void *dest, uint32_t count)
+                                  be_uint32_t addr, unsigned dummy,
+                                  void *dest, uint32_t count)
 {
     TRACE("mtd_spi_cmd_addr_read: %p, %02x, (%02x %02x %02x %02x), %p, %" PRIu32 "\n",
           (void *)dev, (unsigned int)opcode, addr.u8[0], addr.u8[1], addr.u8[2],
@@ -97,6 +107,9 @@ static void mtd_spi_cmd_addr_read(const mtd_spi_nor_t *dev, uint8_t opcode,
         /* Send opcode followed by address */
         spi_transfer_byte(dev->spi, dev->cs, true, opcode);
         spi_transfer_bytes(dev->spi, dev->cs, true, (char *)addr_buf, NULL, dev->addr_width);
+        while (dummy--) {
+            spi_transfer_byte(dev->spi, dev->cs, true, 0);
+        }
 
         /* Read data */
         spi_transfer_bytes(dev->spi, dev->cs, false, NULL, dest, count);
@@ -256,7 +269,7 @@ static int mtd_spi_read_jedec_id(const mtd_spi_nor_t *dev, mtd_jedec_id_t *out)
     return status;
 }
 
-static inline void wait_for_write_complete(const mtd_spi_nor_t *dev)
+static inline void wait_for_write_complete(const mtd_spi_nor_t *dev, uint32_t us)
 {
     do {
         uint8_t status;
@@ -267,8 +280,16 @@ static inline void wait_for_write_complete(const mtd_spi_nor_t *dev)
             break;
         }
 #if MODULE_XTIMER
-        xtimer_usleep(MTD_SPI_NOR_WRITE_WAIT_US);
+        /* leave the bus to other devices while waiting */
+        spi_release(dev->spi);
+        xtimer_usleep(us);
+        spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+        us *= 2;
+        if (us > MTD_SPI_NOR_WRITE_WAIT_US) {
+            us = MTD_SPI_NOR_WRITE_WAIT_US;
+        }
 #else
+        (void)us;
         thread_yield();
 #endif
     } while (1);
@@ -359,24 +380,23 @@ static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t
     if (addr > chipsize) {
         return -EOVERFLOW;
     }
-    if (size > mtd->page_size) {
-        size = mtd->page_size;
-    }
     if ((addr + size) > chipsize) {
         size = chipsize - addr;
     }
-    uint32_t page_addr_mask = dev->page_addr_mask;
-    if ((addr & page_addr_mask) != ((addr + size - 1) & page_addr_mask)) {
-        /* Reads across page boundaries must be split */
-        size = mtd->page_size - (addr & ~(page_addr_mask));
-    }
     if (size == 0) {
         return 0;
     }
     be_uint32_t addr_be = byteorder_htonl(addr);
 
+    /* the address counter of the chip wraps at the end of the memory only,
+     * so the whole range is read with a single command */
     spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
-    mtd_spi_cmd_addr_read(dev, dev->opcode->read, addr_be, dest, size);
+    if (dev->flag & SPI_NOR_F_FAST_READ) {
+        mtd_spi_cmd_addr_read(dev, dev->opcode->read_fast, addr_be, 1, dest, size);
+    }
+    else {
+        mtd_spi_cmd_addr_read(dev, dev->opcode->read, addr_be, 0, dest, size);
+    }
     spi_release(dev->spi);
 
     return size;
@@ -414,7 +434,7 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     mtd_spi_cmd_addr_write(dev, dev->opcode->page_program, addr_be, src, size);
 
     /* waiting for the command to complete before returning */
-    wait_for_write_complete(dev);
+    wait_for_write_complete(dev, MTD_SPI_NOR_PROGRAM_WAIT_US);
 
     spi_release(dev->spi);
     return size;
@@ -475,7 +495,7 @@ static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
         }
 
         /* waiting for the command to complete before continuing */
-        wait_for_write_complete(dev);
+        wait_for_write_complete(dev, MTD_SPI_NOR_ERASE_WAIT_US);
     }
     spi_release(dev->spi);
 
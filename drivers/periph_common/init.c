@@ -35,6 +35,9 @@
 #ifdef MODULE_PERIPH_HWRNG
 #include "periph/hwrng.h"
 #endif
+#ifdef MODULE_PERIPH_HWCRYPTO
+#include "periph/hwcrypto.h"
+#endif
 
 void periph_init(void)
 {
@@ -65,4 +68,8 @@ void periph_init(void)
 #ifdef MODULE_PERIPH_HWRNG
     hwrng_init();
 #endif
+
+#ifdef MODULE_PERIPH_HWCRYPTO
+    hwcrypto_init();
+#endif
 }
@@ -23,6 +23,7 @@
 
 #include "board.h"
 #include "cpu.h"
+#include "assert.h"
 #include "periph/spi.h"
 
 #ifdef SPI_NUMOF
@@ -70,4 +71,16 @@ void spi_transfer_regs(spi_t bus, spi_cs_t cs,
 }
 #endif
 
+#ifndef PERIPH_SPI_PROVIDES_TRANSFER_BYTES_ASYNC
+void spi_transfer_bytes_async(spi_t bus, spi_cs_t cs, bool cont,
+                              const void *out, void *in, size_t len,
+                              spi_cb_t cb, void *arg)
+{
+    assert(cb != NULL);
+
+    spi_transfer_bytes(bus, cs, cont, out, in, len);
+    cb(arg);
+}
+#endif
+
 #endif /* SPI_NUMOF */
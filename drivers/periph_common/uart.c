@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     drivers_periph_uart
+ * @{
+ *
+ * @file
+ * @brief       common UART function fallback implementations
+ *
+ * @}
+ */
+
+#include "periph/uart.h"
+
+#if defined(UART_NUMOF) && !defined(PERIPH_UART_PROVIDES_INIT_BLOCK)
+/**
+ * @brief   Chunk callbacks, fed byte by byte
+ */
+typedef struct {
+    uart_rx_block_cb_t rx_cb;   /**< the chunk callback */
+    void *arg;                  /**< argument to rx_cb */
+} _block_ctx_t;
+
+static _block_ctx_t _block_ctx[UART_NUMOF];
+
+static void _rx_byte(void *arg, uint8_t data)
+{
+    _block_ctx_t *ctx = arg;
+
+    ctx->rx_cb(ctx->arg, &data, 1);
+}
+
+int uart_init_block(uart_t uart, uint32_t baudrate, uart_rx_block_cb_t rx_cb,
+                    void *arg)
+{
+    if (uart >= UART_NUMOF) {
+        return UART_NODEV;
+    }
+    if (rx_cb == NULL) {
+        return uart_init(uart, baudrate, NULL, NULL);
+    }
+    _block_ctx[uart].rx_cb = rx_cb;
+    _block_ctx[uart].arg = arg;
+    return uart_init(uart, baudrate, _rx_byte, &_block_ctx[uart]);
+}
+#endif
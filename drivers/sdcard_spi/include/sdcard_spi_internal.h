@@ -97,6 +97,7 @@ extern "C" {
 #define SD_CMD_17 17 /* Reads a block of the size selected by the SET_BLOCKLEN command */
 #define SD_CMD_18 18 /* Continuously transfers data blocks from card to host
                         until interrupted by a STOP_TRANSMISSION command */
+#define SD_CMD_23 23 /* Sent as ACMD23 sets the number of blocks to pre-erase before writing */
 #define SD_CMD_24 24 /* Writes a block of the size selected by the SET_BLOCKLEN command */
 #define SD_CMD_25 25 /* Continuously writes blocks of data until 'Stop Tran'token is sent */
 #define SD_CMD_41 41 /* Reserved (used for ACMD41) */
@@ -563,6 +563,20 @@ static inline int _hw_spi_rxtx_byte(sdcard_spi_t *card, char out, char *in){
 }
 
 static inline int _transfer_bytes(sdcard_spi_t *card, const char *out, char *in, unsigned int length){
+    if ((_dyn_spi_rxtx_byte == &_hw_spi_rxtx_byte) &&
+        ((out != NULL) || (in != NULL))) {
+        /* transfer the whole buffer at once, the periph driver may use DMA */
+        if (out == NULL) {
+            /* the card expects MOSI high while sending, so the dummy bytes
+             * are sent from the receive buffer in place */
+            memset(in, SD_CARD_DUMMY_BYTE, length);
+            out = in;
+        }
+        spi_transfer_bytes(card->params.spi_dev, GPIO_UNDEF, true, out, in,
+                           length);
+        return length;
+    }
+
     int trans_ret;
     unsigned trans_bytes = 0;
     char in_temp;
@@ -750,6 +764,14 @@ static inline int _write_blocks(sdcard_spi_t *card, char cmd_idx, int bladdr, co
     _select_card_spi(card);
     int written = 0;
 
+    if (cmd_idx == SD_CMD_25) {
+        /* lets the card erase the blocks in advance, which speeds up the
+           write (not supported by MMC cards, so the result is ignored) */
+        char acmd23_r1 = sdcard_spi_send_acmd(card, SD_CMD_23, nbl, 0);
+        DEBUG("_write_blocks: ACMD23: 0x%02x\n", acmd23_r1);
+        (void)acmd23_r1;
+    }
+
     uint32_t addr = card->use_block_addr ? bladdr : (bladdr * SD_HC_BLOCK_SIZE);
     char cmd_r1_resu = sdcard_spi_send_cmd(card, cmd_idx, addr, SD_BLOCK_WRITE_CMD_RETRIES);
 
@@ -791,8 +813,10 @@ static inline int _write_blocks(sdcard_spi_t *card, char cmd_idx, int bladdr, co
             /* sd card needs dummy byte before we can wait for not-busy
                state */
             _send_dummy_byte(card);
-            if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
-                _unselect_card_spi(card);
+            if (_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
+                *state = SD_RW_OK;
+            }
+            else {
                 *state = SD_RW_TIMEOUT;
             }
         }
@@ -30,6 +30,41 @@
 #define SI70XX_I2C     (dev->params.i2c_dev)
 #define SI70XX_ADDR    (dev->params.address)
 
+/**
+ * @brief   Internal helper function to reconstruct a raw measurement.
+ */
+static uint16_t _raw(const uint8_t *result)
+{
+    return ((uint16_t)result[0] << 8) + (result[1] & 0xfc);
+}
+
+/**
+ * @brief   Internal helper function to convert a raw humidity.
+ */
+static uint16_t _humidity(uint16_t raw)
+{
+    int32_t humidity = ((12500 * raw) / 65536) - 600;
+
+    /* according to datasheet, values may exceed bounds, but can be clipped */
+    if (humidity < 0) {
+        return 0;
+    }
+    else if (humidity > 10000) {
+        return 10000;
+    }
+    else {
+        return (uint16_t) humidity;
+    }
+}
+
+/**
+ * @brief   Internal helper function to convert a raw temperature.
+ */
+static int16_t _temperature(uint16_t raw)
+{
+    return ((17572 * raw) / 65536) - 4685;
+}
+
 /**
  * @brief   Internal helper function to perform and reconstruct a measurement.
  */
@@ -50,7 +85,7 @@ static uint16_t _do_measure(const si70xx_t *dev, uint8_t command)
     i2c_release(SI70XX_I2C);
 
     /* reconstruct raw result */
-    return ((uint16_t)result[0] << 8) + (result[1] & 0xfc);
+    return _raw(result);
 }
 
 /**
@@ -177,34 +212,14 @@ int si70xx_init(si70xx_t *dev, const si70xx_params_t *params)
 
 uint16_t si70xx_get_relative_humidity(const si70xx_t *dev)
 {
-    uint16_t raw;
-    int32_t humidity;
-
     /* perform measurement */
-    raw = _do_measure(dev, SI70XX_MEASURE_RH_HOLD);
-
-    humidity = ((12500 * raw) / 65536) - 600;
-
-    /* according to datasheet, values may exceed bounds, but can be clipped */
-    if (humidity < 0) {
-        return 0;
-    }
-    else if (humidity > 10000) {
-        return 10000;
-    }
-    else {
-        return (uint16_t) humidity;
-    }
+    return _humidity(_do_measure(dev, SI70XX_MEASURE_RH_HOLD));
 }
 
 int16_t si70xx_get_temperature(const si70xx_t *dev)
 {
-    uint16_t raw;
-
     /* perform measurement */
-    raw = _do_measure(dev, SI70XX_MEASURE_TEMP_HOLD);
-
-    return ((17572 * raw) / 65536) - 4685;
+    return _temperature(_do_measure(dev, SI70XX_MEASURE_TEMP_HOLD));
 }
 
 void si70xx_get_both(const si70xx_t *dev, uint16_t *humidity, int16_t *temperature)
@@ -217,5 +232,41 @@ void si70xx_get_both(const si70xx_t *dev, uint16_t *humidity, int16_t *temperatu
     /* read the temperature using the data from the previous measurement */
     raw = _do_measure(dev, SI70XX_MEASURE_TEMP_PREV);
 
-    *temperature = ((17572 * raw) / 65536) - 4685;
+    *temperature = _temperature(raw);
+}
+
+#ifdef MODULE_I2C_ASYNC
+static void _op(i2c_async_op_t *op, uint8_t type, void *data, uint16_t len)
+{
+    op->type = type;
+    op->data = data;
+    op->len = len;
+    op->flags = 0;
+}
+
+void si70xx_get_both_async(const si70xx_t *dev, si70xx_async_t *req,
+                           i2c_async_cb_t cb, void *arg)
+{
+    /* same sequence as si70xx_get_both(), in one request */
+    req->cmd[0] = SI70XX_MEASURE_RH_HOLD;
+    req->cmd[1] = SI70XX_MEASURE_TEMP_PREV;
+    _op(&req->ops[0], I2C_ASYNC_WRITE_BYTES, &req->cmd[0], 1);
+    _op(&req->ops[1], I2C_ASYNC_READ_BYTES, &req->buf[0], 2);
+    _op(&req->ops[2], I2C_ASYNC_WRITE_BYTES, &req->cmd[1], 1);
+    _op(&req->ops[3], I2C_ASYNC_READ_BYTES, &req->buf[2], 2);
+    i2c_async_init(&req->req, SI70XX_ADDR, req->ops, 4, cb, arg);
+    i2c_async_submit(SI70XX_I2C, &req->req);
+}
+
+int si70xx_async_results(const si70xx_async_t *req, uint16_t *humidity,
+                         int16_t *temperature)
+{
+    if (req->req.res < 0) {
+        DEBUG("[ERROR] Asynchronous measurement failed.\n");
+        return -SI70XX_ERR_I2C;
+    }
+    *humidity = _humidity(_raw(&req->buf[0]));
+    *temperature = _temperature(_raw(&req->buf[2]));
+    return SI70XX_OK;
 }
+#endif /* MODULE_I2C_ASYNC */
@@ -30,11 +30,60 @@
 static void _slip_rx_cb(void *arg, uint8_t byte)
 {
     slipdev_t *dev = arg;
+    tsrb_t *rb = &dev->inbuf;
 
-    tsrb_add_one(&dev->inbuf, byte);
-    if ((byte == SLIP_END) && (dev->netdev.event_callback != NULL)) {
-        dev->netdev.event_callback((netdev_t *)dev, NETDEV_EVENT_ISR);
+    switch (byte) {
+        case SLIP_END:
+            if (dev->rx_len == 0) {
+                /* empty frame, e.g. the leading END of a frame */
+                break;
+            }
+            if (!dev->rx_drop) {
+                int idx = cib_put(&dev->rx_frames_idx);
+
+                if (idx >= 0) {
+                    /* hand frame over to the reader as a whole */
+                    dev->rx_frames[idx] = dev->rx_len;
+                    tsrb_commit(rb, dev->rx_len);
+                    if (dev->netdev.event_callback != NULL) {
+                        dev->netdev.event_callback((netdev_t *)dev,
+                                                   NETDEV_EVENT_ISR);
+                    }
+                }
+            }
+            dev->rx_len = 0;
+            dev->rx_drop = 0;
+            dev->inesc = 0;
+            return;
+        case SLIP_ESC:
+            dev->inesc = 1;
+            return;
+        case SLIP_END_ESC:
+            if (dev->inesc) {
+                byte = SLIP_END;
+            }
+            break;
+        case SLIP_ESC_ESC:
+            if (dev->inesc) {
+                byte = SLIP_ESC;
+            }
+            break;
+        default:
+            break;
+    }
+    dev->inesc = 0;
+    if (dev->rx_drop) {
+        return;
     }
+    if (dev->rx_len >= tsrb_free(rb)) {
+        /* frame does not fit, drop it as a whole */
+        DEBUG("slipdev: RX buffer full, dropping frame\n");
+        dev->rx_drop = 1;
+        return;
+    }
+    /* the decoded frame is stored behind the committed data and handed over
+     * on the terminating END byte */
+    rb->buf[(rb->writes + dev->rx_len++) & (rb->size - 1)] = byte;
 }
 
 static int _init(netdev_t *netdev)
@@ -45,6 +94,7 @@ static int _init(netdev_t *netdev)
           (void *)dev, dev->config.uart, dev->config.baudrate);
     /* initialize buffers */
     tsrb_init(&dev->inbuf, dev->rxmem, sizeof(dev->rxmem));
+    cib_init(&dev->rx_frames_idx, SLIPDEV_RX_FRAMES);
     if (uart_init(dev->config.uart, dev->config.baudrate, _slip_rx_cb,
                   dev) != UART_OK) {
         LOG_ERROR("slipdev: error initializing UART %i with baudrate %" PRIu32 "\n",
@@ -54,120 +104,89 @@ static int _init(netdev_t *netdev)
     return 0;
 }
 
-static inline void _write_byte(slipdev_t *dev, uint8_t byte)
-{
-    uart_write(dev->config.uart, &byte, 1);
-}
-
 static int _send(netdev_t *netdev, const iolist_t *iolist)
 {
+    static const uint8_t esc_end[] = { SLIP_ESC, SLIP_END_ESC };
+    static const uint8_t esc_esc[] = { SLIP_ESC, SLIP_ESC_ESC };
+    static const uint8_t end = SLIP_END;
     slipdev_t *dev = (slipdev_t *)netdev;
     int bytes = 0;
 
     DEBUG("slipdev: sending iolist\n");
     for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
-        uint8_t *data = iol->iol_base;
-
-        for (unsigned j = 0; j < iol->iol_len; j++, data++) {
-            switch(*data) {
-                case SLIP_END:
-                    /* escaping END byte*/
-                    _write_byte(dev, SLIP_ESC);
-                    _write_byte(dev, SLIP_END_ESC);
-                    break;
-                case SLIP_ESC:
-                    /* escaping ESC byte*/
-                    _write_byte(dev, SLIP_ESC);
-                    _write_byte(dev, SLIP_ESC_ESC);
-                    break;
-                default:
-                    _write_byte(dev, *data);
+        const uint8_t *data = iol->iol_base;
+        const uint8_t *run = data;
+        const uint8_t *stop = data + iol->iol_len;
+
+        /* write runs of bytes that need no escaping in one go */
+        for (; data < stop; data++) {
+            if ((*data != SLIP_END) && (*data != SLIP_ESC)) {
+                continue;
             }
-            bytes++;
+            if (data > run) {
+                uart_write(dev->config.uart, run, data - run);
+            }
+            uart_write(dev->config.uart,
+                       (*data == SLIP_END) ? esc_end : esc_esc, 2);
+            run = data + 1;
+        }
+        if (data > run) {
+            uart_write(dev->config.uart, run, data - run);
         }
+        bytes += iol->iol_len;
     }
-    _write_byte(dev, SLIP_END);
+    uart_write(dev->config.uart, &end, 1);
     return bytes;
 }
 
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     slipdev_t *dev = (slipdev_t *)netdev;
-    int res = 0;
+    int idx = cib_peek(&dev->rx_frames_idx);
+    unsigned size;
 
     (void)info;
+    if (idx < 0) {
+        return (buf == NULL) ? 0 : -EIO;
+    }
+    size = dev->rx_frames[idx];
+    if ((buf == NULL) && (len == 0)) {
+        return size;
+    }
+    /* the frame is decoded already, just copy it out */
     if (buf == NULL) {
-        if (len > 0) {
-            /* remove data */
-            for (; len > 0; len--) {
-                int byte = tsrb_get_one(&dev->inbuf);
-                if ((byte == (int)SLIP_END) || (byte < 0)) {
-                    /* end early if end of packet or ringbuffer is reached;
-                     * len might be larger than the actual packet */
-                    break;
-                }
-            }
-        } else {
-            /* the user was warned not to use a buffer size > `INT_MAX` ;-) */
-            res = (int)tsrb_avail(&dev->inbuf);
-        }
+        tsrb_drop(&dev->inbuf, size);
+    }
+    else if (size > len) {
+        tsrb_drop(&dev->inbuf, size);
+        cib_get(&dev->rx_frames_idx);
+        return -ENOBUFS;
     }
     else {
-        int byte;
-        uint8_t *ptr = buf;
-
-        do {
-            if ((byte = tsrb_get_one(&dev->inbuf)) < 0) {
-                /* something went wrong, return error */
-                return -EIO;
-            }
-            switch (byte) {
-                case SLIP_END:
-                    break;
-                case SLIP_ESC:
-                    dev->inesc = 1;
-                    break;
-                case SLIP_END_ESC:
-                    if (dev->inesc) {
-                        *(ptr++) = SLIP_END;
-                        res++;
-                        dev->inesc = 0;
-                        break;
-                    }
-                    /* Intentionally falls through */
-                    /* to default when !dev->inesc */
-                case SLIP_ESC_ESC:
-                    if (dev->inesc) {
-                        *(ptr++) = SLIP_ESC;
-                        res++;
-                        dev->inesc = 0;
-                        break;
-                    }
-                    /* Intentionally falls through */
-                    /* to default when !dev->inesc */
-                default:
-                    *(ptr++) = (uint8_t)byte;
-                    res++;
-                    break;
-            }
-            if ((unsigned)res > len) {
-                while (byte != SLIP_END) {
-                    /* clear out unreceived packet */
-                    byte = tsrb_get_one(&dev->inbuf);
-                }
-                return -ENOBUFS;
-            }
-        } while (byte != SLIP_END);
+        tsrb_get(&dev->inbuf, buf, size);
     }
-    return res;
+    cib_get(&dev->rx_frames_idx);
+    return size;
 }
 
 static void _isr(netdev_t *netdev)
 {
+    slipdev_t *dev = (slipdev_t *)netdev;
+
     DEBUG("slipdev: handling ISR event\n");
     if (netdev->event_callback != NULL) {
         DEBUG("slipdev: event handler set, issuing RX_COMPLETE event\n");
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        /* deliver all complete frames, several may have arrived since the
+         * event was posted */
+        while (cib_avail(&dev->rx_frames_idx)) {
+            unsigned pending = cib_avail(&dev->rx_frames_idx);
+
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+            if (cib_avail(&dev->rx_frames_idx) >= pending) {
+                /* upper layer did not fetch the frame, try again later */
+                break;
+            }
+        }
     }
 }
 
@@ -202,6 +221,8 @@ void slipdev_setup(slipdev_t *dev, const slipdev_params_t *params)
     /* set device descriptor fields */
     memcpy(&dev->config, params, sizeof(dev->config));
     dev->inesc = 0U;
+    dev->rx_len = 0U;
+    dev->rx_drop = 0U;
     dev->netdev.driver = &slip_driver;
 }
 
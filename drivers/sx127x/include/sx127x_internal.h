@@ -23,6 +23,7 @@
 #define SX127X_INTERNAL_H
 
 #include <inttypes.h>
+#include "iolist.h"
 #include "sx127x.h"
 
 #ifdef __cplusplus
@@ -101,6 +102,15 @@ void sx127x_reg_read_burst(const sx127x_t *dev, uint8_t addr, uint8_t *buffer,
  */
 void sx127x_write_fifo(const sx127x_t *dev, uint8_t *buffer, uint8_t size);
 
+/**
+ * @brief   Writes the contents of an iolist to the SX1276 FIFO, in a single
+ *          SPI transaction
+ *
+ * @param[in] dev                      The sx127x device structure pointer
+ * @param[in] iolist                   Buffers to be put on the FIFO
+ */
+void sx127x_write_fifo_iol(const sx127x_t *dev, const iolist_t *iolist);
+
 /**
  * @brief   Reads the contents of the SX1276 FIFO
  *
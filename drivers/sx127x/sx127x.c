@@ -57,11 +57,24 @@ static void sx127x_on_dio3_isr(void *arg);
 static void sx127x_on_dio_multi_isr(void *arg);
 #endif
 
+#ifdef MODULE_ENERGY
+static const uint32_t _energy_ua[ENERGY_NETDEV_STATES] = SX127X_ENERGY_UA;
+static const energy_model_t _energy_model = {
+    .name = "sx127x",
+    .state_names = energy_netdev_state_names,
+    .current_ua = _energy_ua,
+    .numof = ENERGY_NETDEV_STATES,
+};
+#endif
+
 void sx127x_setup(sx127x_t *dev, const sx127x_params_t *params)
 {
     netdev_t *netdev = (netdev_t*) dev;
     netdev->driver = &sx127x_driver;
     memcpy(&dev->params, params, sizeof(sx127x_params_t));
+#ifdef MODULE_ENERGY
+    energy_netdev_init(&dev->energy, &_energy_model);
+#endif
 }
 
 int sx127x_reset(const sx127x_t *dev)
@@ -61,6 +61,21 @@ void sx127x_set_state(sx127x_t *dev, uint8_t state)
 #endif
 
     dev->settings.state = state;
+#ifdef MODULE_ENERGY
+    switch (state) {
+        case SX127X_RF_RX_RUNNING:
+        case SX127X_RF_CAD:
+            energy_netdev_set(&dev->energy, NETOPT_STATE_RX);
+            break;
+        case SX127X_RF_TX_RUNNING:
+            energy_netdev_set(&dev->energy, NETOPT_STATE_TX);
+            break;
+        default:
+            /* sx127x_set_sleep() corrects this to sleep */
+            energy_netdev_set(&dev->energy, NETOPT_STATE_STANDBY);
+            break;
+    }
+#endif
 }
 
 void sx127x_set_modem(sx127x_t *dev, uint8_t modem)
@@ -207,6 +222,9 @@ void sx127x_set_sleep(sx127x_t *dev)
     /* Put chip into sleep */
     sx127x_set_op_mode(dev, SX127X_RF_OPMODE_SLEEP);
     sx127x_set_state(dev,  SX127X_RF_IDLE);
+#ifdef MODULE_ENERGY
+    energy_netdev_set(&dev->energy, NETOPT_STATE_SLEEP);
+#endif
 }
 
 void sx127x_set_standby(sx127x_t *dev)
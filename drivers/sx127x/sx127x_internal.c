@@ -19,6 +19,7 @@
  * @author      Alexandre Abadie <alexandre.abadie@inria.fr>
  * @}
  */
+#include <errno.h>
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
@@ -26,6 +27,7 @@
 #include <inttypes.h>
 
 #include "irq.h"
+#include "mutex.h"
 
 #include "net/lora.h"
 
@@ -114,14 +116,61 @@ void sx127x_reg_read_burst(const sx127x_t *dev, uint8_t addr, uint8_t *buffer,
     irq_restore(cpsr);
 }
 
+static void _fifo_done(void *arg)
+{
+    mutex_unlock(arg);
+}
+
+/* the FIFO is only accessed from thread context, so the transfer is not
+ * guarded by disabling the interrupts but runs in the background where the
+ * platform supports it */
+static void _fifo_transfer(const sx127x_t *dev, const void *out, void *in,
+                           size_t len)
+{
+    mutex_t done = MUTEX_INIT_LOCKED;
+
+    spi_transfer_bytes_async(dev->params.spi, SPI_CS_UNDEF, true, out, in, len,
+                             _fifo_done, &done);
+    mutex_lock(&done);
+}
+
+static void _fifo_begin(const sx127x_t *dev, bool write)
+{
+    spi_acquire(dev->params.spi, SPI_CS_UNDEF, SX127X_SPI_MODE, SX127X_SPI_SPEED);
+    gpio_clear(dev->params.nss_pin);
+    spi_transfer_byte(dev->params.spi, SPI_CS_UNDEF, true,
+                      write ? (SX127X_REG_LR_FIFO | 0x80) : SX127X_REG_LR_FIFO);
+}
+
+static void _fifo_end(const sx127x_t *dev)
+{
+    gpio_set(dev->params.nss_pin);
+    spi_release(dev->params.spi);
+}
+
 void sx127x_write_fifo(const sx127x_t *dev, uint8_t *buffer, uint8_t size)
 {
-    sx127x_reg_write_burst(dev, 0, buffer, size);
+    _fifo_begin(dev, true);
+    _fifo_transfer(dev, buffer, NULL, size);
+    _fifo_end(dev);
+}
+
+void sx127x_write_fifo_iol(const sx127x_t *dev, const iolist_t *iolist)
+{
+    _fifo_begin(dev, true);
+    for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
+        if (iol->iol_len) {
+            _fifo_transfer(dev, iol->iol_base, NULL, iol->iol_len);
+        }
+    }
+    _fifo_end(dev);
 }
 
 void sx127x_read_fifo(const sx127x_t *dev, uint8_t *buffer, uint8_t size)
 {
-    sx127x_reg_read_burst(dev, 0, buffer, size);
+    _fifo_begin(dev, false);
+    _fifo_transfer(dev, NULL, buffer, size);
+    _fifo_end(dev);
 }
 
 #if defined(MODULE_SX1276)
@@ -241,3 +290,73 @@ bool sx127x_is_channel_free(sx127x_t *dev, uint32_t freq, int16_t rssi_threshold
 
     return (rssi <= rssi_threshold);
 }
+
+bool sx127x_cad(sx127x_t *dev)
+{
+    /* a symbol takes 2^SF / BW, CAD is done after about two of them */
+    uint32_t symbol = ((1UL << dev->settings.lora.datarate) * 8U) >>
+                      dev->settings.lora.bandwidth;
+    unsigned polls = SX127X_CAD_TIMEOUT_SYMBOLS * 4;
+    uint8_t dio_mapping;
+    uint8_t flags = 0;
+
+    if (dev->settings.modem != SX127X_MODEM_LORA) {
+        return false;
+    }
+
+    if (sx127x_get_op_mode(dev) == SX127X_RF_OPMODE_SLEEP) {
+        sx127x_set_standby(dev);
+        xtimer_usleep(SX127X_RADIO_WAKEUP_TIME); /* wait for chip wake up */
+    }
+
+    dio_mapping = sx127x_reg_read(dev, SX127X_REG_DIOMAPPING1);
+    /* the flags are polled, keep CADDone off the DIO lines so that no
+     * NETDEV_EVENT_CAD_DONE is raised */
+    sx127x_reg_write(dev, SX127X_REG_LR_IRQFLAGSMASK,
+                     (uint8_t)~(SX127X_RF_LORA_IRQFLAGS_CADDONE |
+                                SX127X_RF_LORA_IRQFLAGS_CADDETECTED));
+    sx127x_reg_write(dev, SX127X_REG_DIOMAPPING1,
+                     (dio_mapping & SX127X_RF_LORA_DIOMAPPING1_DIO0_MASK &
+                      SX127X_RF_LORA_DIOMAPPING1_DIO3_MASK) |
+                     SX127X_RF_LORA_DIOMAPPING1_DIO0_00 |
+                     SX127X_RF_LORA_DIOMAPPING1_DIO3_10);
+    sx127x_reg_write(dev, SX127X_REG_LR_IRQFLAGS,
+                     SX127X_RF_LORA_IRQFLAGS_CADDONE |
+                     SX127X_RF_LORA_IRQFLAGS_CADDETECTED);
+
+    sx127x_set_state(dev, SX127X_RF_CAD);
+    sx127x_set_op_mode(dev, SX127X_RF_LORA_OPMODE_CAD);
+
+    while (polls--) {
+        xtimer_usleep(symbol / 4 + 1);
+        flags = sx127x_reg_read(dev, SX127X_REG_LR_IRQFLAGS);
+        if (flags & SX127X_RF_LORA_IRQFLAGS_CADDONE) {
+            break;
+        }
+    }
+
+    sx127x_reg_write(dev, SX127X_REG_LR_IRQFLAGS,
+                     SX127X_RF_LORA_IRQFLAGS_CADDONE |
+                     SX127X_RF_LORA_IRQFLAGS_CADDETECTED);
+    sx127x_reg_write(dev, SX127X_REG_DIOMAPPING1, dio_mapping);
+    sx127x_set_state(dev, SX127X_RF_IDLE);
+
+    if (!(flags & SX127X_RF_LORA_IRQFLAGS_CADDONE)) {
+        DEBUG("[sx127x] CAD timed out\n");
+        sx127x_set_standby(dev);
+        /* rather wait than collide */
+        return true;
+    }
+    return (flags & SX127X_RF_LORA_IRQFLAGS_CADDETECTED) != 0;
+}
+
+int sx127x_cad_scan(sx127x_t *dev, const uint32_t *channels, unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        sx127x_set_channel(dev, channels[i]);
+        if (!sx127x_cad(dev)) {
+            return i;
+        }
+    }
+    return -EBUSY;
+}
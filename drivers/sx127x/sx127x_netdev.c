@@ -53,6 +53,12 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
 
     uint8_t size = iolist_size(iolist);
 
+    /* listen before talk */
+    if ((dev->settings.lora.flags & SX127X_LBT_FLAG) && sx127x_cad(dev)) {
+        DEBUG("[sx127x] Cannot send packet: channel is busy\n");
+        return -EBUSY;
+    }
+
     switch (dev->settings.modem) {
         case SX127X_MODEM_FSK:
             /* todo */
@@ -73,9 +79,7 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
             }
 
             /* Write payload buffer */
-            for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
-                sx127x_write_fifo(dev, iol->iol_base, iol->iol_len);
-            }
+            sx127x_write_fifo_iol(dev, iolist);
             break;
         default:
             puts("sx127x_netdev, Unsupported modem");
@@ -112,8 +116,10 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     sx127x_t *dev = (sx127x_t*) netdev;
-    volatile uint8_t irq_flags = 0;
+    uint8_t irq_flags = 0;
     uint8_t size = 0;
+    /* RegFifoRxCurrentAddr to RegRxNbBytes, read in one burst */
+    uint8_t rx_regs[4];
     switch (dev->settings.modem) {
         case SX127X_MODEM_FSK:
             /* todo */
@@ -122,7 +128,10 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
             /* Clear IRQ */
             sx127x_reg_write(dev, SX127X_REG_LR_IRQFLAGS, SX127X_RF_LORA_IRQFLAGS_RXDONE);
 
-            irq_flags = sx127x_reg_read(dev, SX127X_REG_LR_IRQFLAGS);
+            sx127x_reg_read_burst(dev, SX127X_REG_LR_FIFORXCURRENTADDR,
+                                  rx_regs, sizeof(rx_regs));
+            irq_flags = rx_regs[SX127X_REG_LR_IRQFLAGS -
+                                SX127X_REG_LR_FIFORXCURRENTADDR];
             if ( (irq_flags & SX127X_RF_LORA_IRQFLAGS_PAYLOADCRCERROR_MASK) ==
                  SX127X_RF_LORA_IRQFLAGS_PAYLOADCRCERROR) {
                 /* Clear IRQ */
@@ -142,7 +151,11 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
             if (packet_info) {
                 /* there is no LQI for LoRa */
                 packet_info->lqi = 0;
-                uint8_t snr_value = sx127x_reg_read(dev, SX127X_REG_LR_PKTSNRVALUE);
+                /* RegPktSnrValue and RegPktRssiValue */
+                uint8_t pkt_regs[2];
+                sx127x_reg_read_burst(dev, SX127X_REG_LR_PKTSNRVALUE,
+                                      pkt_regs, sizeof(pkt_regs));
+                uint8_t snr_value = pkt_regs[0];
                 if (snr_value & 0x80) { /* The SNR is negative */
                     /* Invert and divide by 4 */
                     packet_info->snr = -1 * ((~snr_value + 1) & 0xFF) >> 2;
@@ -152,7 +165,7 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
                     packet_info->snr = (snr_value & 0xFF) >> 2;
                 }
 
-                int16_t rssi = sx127x_reg_read(dev, SX127X_REG_LR_PKTRSSIVALUE);
+                int16_t rssi = pkt_regs[1];
 
                 if (packet_info->snr < 0) {
 #if defined(MODULE_SX1272)
@@ -180,7 +193,8 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
                 }
             }
 
-            size = sx127x_reg_read(dev, SX127X_REG_LR_RXNBBYTES);
+            size = rx_regs[SX127X_REG_LR_RXNBBYTES -
+                           SX127X_REG_LR_FIFORXCURRENTADDR];
             if (buf == NULL) {
                 return size;
             }
@@ -195,8 +209,7 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 
             xtimer_remove(&dev->_internal.rx_timeout_timer);
             /* Read the last packet from FIFO */
-            uint8_t last_rx_addr = sx127x_reg_read(dev, SX127X_REG_LR_FIFORXCURRENTADDR);
-            sx127x_reg_write(dev, SX127X_REG_LR_FIFOADDRPTR, last_rx_addr);
+            sx127x_reg_write(dev, SX127X_REG_LR_FIFOADDRPTR, rx_regs[0]);
             sx127x_read_fifo(dev, (uint8_t*)buf, size);
             break;
         default:
@@ -368,6 +381,11 @@ static int _get(netdev_t *netdev, netopt_t opt, void *val, size_t max_len)
             *((netopt_enable_t*) val) = sx127x_get_iq_invert(dev) ? NETOPT_ENABLE : NETOPT_DISABLE;
             return sizeof(netopt_enable_t);
 
+        case NETOPT_CSMA:
+            assert(max_len >= sizeof(netopt_enable_t));
+            *((netopt_enable_t*) val) = (dev->settings.lora.flags & SX127X_LBT_FLAG) ? NETOPT_ENABLE : NETOPT_DISABLE;
+            return sizeof(netopt_enable_t);
+
         default:
             break;
     }
@@ -497,6 +515,16 @@ static int _set(netdev_t *netdev, netopt_t opt, const void *val, size_t len)
             sx127x_set_iq_invert(dev, *((const netopt_enable_t*) val) ? true : false);
             return sizeof(bool);
 
+        case NETOPT_CSMA:
+            assert(len <= sizeof(netopt_enable_t));
+            if (*((const netopt_enable_t*) val)) {
+                dev->settings.lora.flags |= SX127X_LBT_FLAG;
+            }
+            else {
+                dev->settings.lora.flags &= ~SX127X_LBT_FLAG;
+            }
+            return sizeof(netopt_enable_t);
+
         default:
             break;
     }
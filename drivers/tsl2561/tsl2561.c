@@ -39,6 +39,7 @@
 static void _enable(const tsl2561_t *dev);
 static void _disable(const tsl2561_t *dev);
 static void _read_data(const tsl2561_t *dev, uint16_t *full, uint16_t *ir);
+static uint16_t _illuminance(const tsl2561_t *dev, uint16_t full, uint16_t ir);
 static void _print_init_info(const tsl2561_t *dev);
 
 /*---------------------------------------------------------------------------*
@@ -99,6 +100,25 @@ uint16_t tsl2561_read_illuminance(const tsl2561_t *dev)
     DEBUG("[Info] Full spectrum value: %i\n", (int)full);
     DEBUG("[Info] IR spectrum value: %i\n", (int)ir);
 
+    return _illuminance(dev, full, ir);
+}
+
+uint32_t tsl2561_integration_time(const tsl2561_t *dev)
+{
+    switch (DEV_INTEGRATION) {
+        case TSL2561_INTEGRATIONTIME_13MS:
+            return 13700;
+
+        case TSL2561_INTEGRATIONTIME_101MS:
+            return 101000;
+
+        default: /* TSL2561_INTEGRATIONTIME_402MS */
+            return 402000;
+    }
+}
+
+static uint16_t _illuminance(const tsl2561_t *dev, uint16_t full, uint16_t ir)
+{
     /* Compute illuminance */
     uint32_t channel_scale;
     uint32_t channel_1;
@@ -219,19 +239,7 @@ static void _read_data(const tsl2561_t *dev, uint16_t *full, uint16_t *ir)
     _enable(dev);
 
     /* Wait integration time in ms for ADC to complete */
-    switch (DEV_INTEGRATION) {
-        case TSL2561_INTEGRATIONTIME_13MS:
-            xtimer_usleep(13700);
-            break;
-
-        case TSL2561_INTEGRATIONTIME_101MS:
-            xtimer_usleep(101000);
-            break;
-
-        default: /* TSL2561_INTEGRATIONTIME_402MS */
-            xtimer_usleep(402000);
-            break;
-    }
+    xtimer_usleep(tsl2561_integration_time(dev));
 
     char buffer[2] = { 0 };
     /* Read full spectrum channel */
@@ -254,6 +262,57 @@ static void _read_data(const tsl2561_t *dev, uint16_t *full, uint16_t *ir)
     i2c_release(DEV_I2C);
 }
 
+#ifdef MODULE_I2C_ASYNC
+static void _op(i2c_async_op_t *op, uint8_t type, uint16_t reg,
+                void *data, uint16_t len)
+{
+    op->type = type;
+    op->reg = TSL2561_COMMAND_MODE | reg;
+    op->data = data;
+    op->len = len;
+    op->flags = 0;
+}
+
+void tsl2561_start_async(const tsl2561_t *dev, tsl2561_async_t *req,
+                         i2c_async_cb_t cb, void *arg)
+{
+    req->dev = dev;
+    req->ctrl = TSL2561_CONTROL_POWERON;
+    _op(&req->ops[0], I2C_ASYNC_WRITE_REGS, TSL2561_REGISTER_CONTROL,
+        &req->ctrl, 1);
+    i2c_async_init(&req->req, DEV_ADDR, req->ops, 1, cb, arg);
+    i2c_async_submit(DEV_I2C, &req->req);
+}
+
+void tsl2561_read_async(const tsl2561_t *dev, tsl2561_async_t *req,
+                        i2c_async_cb_t cb, void *arg)
+{
+    req->dev = dev;
+    req->ctrl = TSL2561_CONTROL_POWEROFF;
+    _op(&req->ops[0], I2C_ASYNC_READ_REGS,
+        TSL2561_COMMAND_WORD | TSL2561_REGISTER_CHAN0, &req->buf[0], 2);
+    _op(&req->ops[1], I2C_ASYNC_READ_REGS,
+        TSL2561_COMMAND_WORD | TSL2561_REGISTER_CHAN1, &req->buf[2], 2);
+    /* Turn the device off to save power */
+    _op(&req->ops[2], I2C_ASYNC_WRITE_REGS, TSL2561_REGISTER_CONTROL,
+        &req->ctrl, 1);
+    i2c_async_init(&req->req, DEV_ADDR, req->ops, 3, cb, arg);
+    i2c_async_submit(DEV_I2C, &req->req);
+}
+
+int tsl2561_async_illuminance(const tsl2561_async_t *req, uint16_t *lux)
+{
+    if (req->req.res < 0) {
+        return -1;
+    }
+    uint16_t full = ((uint16_t)req->buf[1] << 8) | req->buf[0];
+    uint16_t ir = ((uint16_t)req->buf[3] << 8) | req->buf[2];
+
+    *lux = _illuminance(req->dev, full, ir);
+    return 0;
+}
+#endif /* MODULE_I2C_ASYNC */
+
 static void _print_init_info(const tsl2561_t *dev)
 {
     DEBUG("[Info] I2C device: %d\n", DEV_I2C);
@@ -44,29 +44,22 @@
 
 static const netdev_driver_t netdev_driver_w5100;
 
-static inline void send_addr(w5100_t *dev, uint16_t addr)
-{
-#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
-    spi_transfer_byte(dev->p.spi, dev->p.cs, true, (addr >> 8));
-    spi_transfer_byte(dev->p.spi, dev->p.cs, true, (addr & 0xff));
-#else
-    spi_transfer_byte(dev->p.spi, dev->p.cs, true, (addr & 0xff));
-    spi_transfer_byte(dev->p.spi, dev->p.cs, true, (addr >> 8));
-#endif
-}
-
+/* every access is a 4 byte frame: command, address (MSB first) and data.
+ * Each frame is clocked out with a single transfer */
 static uint8_t rreg(w5100_t *dev, uint16_t reg)
 {
-    spi_transfer_byte(dev->p.spi, dev->p.cs, true, CMD_READ);
-    send_addr(dev, reg++);
-    return spi_transfer_byte(dev->p.spi, dev->p.cs, false, 0);
+    const uint8_t out[4] = { CMD_READ, (reg >> 8), (reg & 0xff), 0 };
+    uint8_t in[4];
+
+    spi_transfer_bytes(dev->p.spi, dev->p.cs, false, out, in, sizeof(out));
+    return in[3];
 }
 
 static void wreg(w5100_t *dev, uint16_t reg, uint8_t data)
 {
-    spi_transfer_byte(dev->p.spi, dev->p.cs, true, CMD_WRITE);
-    send_addr(dev, reg);
-    spi_transfer_byte(dev->p.spi, dev->p.cs, false, data);
+    const uint8_t out[4] = { CMD_WRITE, (reg >> 8), (reg & 0xff), data };
+
+    spi_transfer_bytes(dev->p.spi, dev->p.cs, false, out, NULL, sizeof(out));
 }
 
 static uint16_t raddr(w5100_t *dev, uint16_t addr_high, uint16_t addr_low)
@@ -92,7 +85,7 @@ static void rchunk(w5100_t *dev, uint16_t addr, uint8_t *data, size_t len)
     }
 }
 
-static void wchunk(w5100_t *dev, uint16_t addr, uint8_t *data, size_t len)
+static void wchunk(w5100_t *dev, uint16_t addr, const uint8_t *data, size_t len)
 {
     /* writing a chunk must be split in multiple single byte writes, as the
      * device does not support auto address increment via SPI */
@@ -172,55 +165,69 @@ static int init(netdev_t *netdev)
     /* start receiving packets */
     wreg(dev, S0_CR, CR_RECV);
 
+    /* from now on the pointers are only moved by us, so keep track of them
+     * instead of reading them for every packet */
+    dev->tx_wr = raddr(dev, S0_TX_WR0, S0_TX_WR1);
+    dev->rx_rd = raddr(dev, S0_RX_RD0, S0_RX_RD1);
+    dev->rx_avail = 0;
+    dev->rx_psize = 0;
+    dev->tx_busy = false;
+
     /* release the SPI bus again */
     spi_release(dev->p.spi);
 
     return 0;
 }
 
-static uint16_t tx_upload(w5100_t *dev, uint16_t start, void *data, size_t len)
+static void tx_upload(w5100_t *dev, uint16_t ptr, const void *data, size_t len)
 {
-    if ((start + len) >= (S0_TX_BASE + S0_MEMSIZE)) {
-        size_t limit = ((S0_TX_BASE + S0_MEMSIZE) - start);
-        wchunk(dev, start, data, limit);
-        wchunk(dev, S0_TX_BASE, &((uint8_t *)data)[limit], len - limit);
-        return (S0_TX_BASE + limit);
+    uint16_t offset = (ptr & S0_MASK);
+
+    if ((offset + len) > S0_MEMSIZE) {
+        size_t limit = (S0_MEMSIZE - offset);
+        wchunk(dev, S0_TX_BASE + offset, data, limit);
+        wchunk(dev, S0_TX_BASE, &((const uint8_t *)data)[limit], len - limit);
     }
     else {
-        wchunk(dev, start, data, len);
-        waddr(dev, S0_TX_WR0, S0_TX_WR1, start + len);
-        return (start + len);
+        wchunk(dev, S0_TX_BASE + offset, data, len);
+    }
+}
+
+static void tx_wait(w5100_t *dev)
+{
+    if (dev->tx_busy) {
+        while (!(rreg(dev, S0_IR) & IR_SEND_OK)) {};
+        wreg(dev, S0_IR, IR_SEND_OK);
+        dev->tx_busy = false;
     }
 }
 
 static int send(netdev_t *netdev, const iolist_t *iolist)
 {
     w5100_t *dev = (w5100_t *)netdev;
+    uint16_t pos = dev->tx_wr;
     int sum = 0;
 
     /* get access to the SPI bus for the duration of this function */
     spi_acquire(dev->p.spi, dev->p.cs, SPI_CONF, dev->p.clk);
 
-    uint16_t pos = raddr(dev, S0_TX_WR0, S0_TX_WR1);
-
-    /* the register is only set correctly after the first send pkt, so we need
-     * this fix here */
-    if (pos == 0) {
-        pos = S0_TX_BASE;
-    }
-
+    /* the 8KB TX memory takes more than one frame, so the new frame is
+     * uploaded while the previous one is still on the wire */
     for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
         size_t len = iol->iol_len;
-        pos = tx_upload(dev, pos, iol->iol_base, len);
+        tx_upload(dev, pos, iol->iol_base, len);
+        pos += len;
         sum += len;
     }
 
+    /* only then wait for the previous frame to be sent out */
+    tx_wait(dev);
     waddr(dev, S0_TX_WR0, S0_TX_WR1, pos);
+    dev->tx_wr = pos;
 
-    /* trigger the sending process */
+    /* trigger the sending process, it is waited for by the next send */
     wreg(dev, S0_CR, CR_SEND_MAC);
-    while (!(rreg(dev, S0_IR) & IR_SEND_OK)) {};
-    wreg(dev, S0_IR, IR_SEND_OK);
+    dev->tx_busy = true;
 
     DEBUG("[w5100] send: transferred %i byte (at 0x%04x)\n", sum, (int)pos);
 
@@ -240,13 +247,23 @@ static int recv(netdev_t *netdev, void *buf, size_t len, void *info)
     /* get access to the SPI bus for the duration of this function */
     spi_acquire(dev->p.spi, dev->p.cs, SPI_CONF, dev->p.clk);
 
-    uint16_t num = raddr(dev, S0_RX_RSR0, S0_RX_RSR1);
-
-    if (num > 0) {
-        /* find the size of the next packet in the RX buffer */
-        uint16_t rp = raddr(dev, S0_RX_RD0, S0_RX_RD1);
-        uint16_t psize = raddr(dev, (S0_RX_BASE + (rp & S0_MASK)),
+    if (dev->rx_psize == 0) {
+        /* only ask the device for the received size once all data we knew
+         * of was consumed */
+        if (dev->rx_avail == 0) {
+            dev->rx_avail = raddr(dev, S0_RX_RSR0, S0_RX_RSR1);
+        }
+        if (dev->rx_avail > 0) {
+            /* find the size of the next packet in the RX buffer */
+            uint16_t rp = dev->rx_rd;
+            dev->rx_psize = raddr(dev, (S0_RX_BASE + (rp & S0_MASK)),
                                   (S0_RX_BASE + ((rp + 1) & S0_MASK)));
+        }
+    }
+
+    if (dev->rx_psize > 0) {
+        uint16_t rp = dev->rx_rd;
+        uint16_t psize = dev->rx_psize;
         n = psize - 2;
 
         DEBUG("[w5100] recv: got packet of %i byte (at 0x%04x)\n", n, (int)rp);
@@ -261,14 +278,22 @@ static int recv(netdev_t *netdev, void *buf, size_t len, void *info)
 
             DEBUG("[w5100] recv: read %i byte from device (at 0x%04x)\n",
                   n, (int)rp);
+        }
 
+        if ((in_buf != NULL) || (len > 0)) {
             /* set the new read pointer address */
-            waddr(dev, S0_RX_RD0, S0_RX_RD1, rp += psize);
+            waddr(dev, S0_RX_RD0, S0_RX_RD1, rp + psize);
             wreg(dev, S0_CR, CR_RECV);
+            dev->rx_rd = rp + psize;
+            dev->rx_avail -= psize;
+            dev->rx_psize = 0;
 
             /* if RX buffer now empty, clear RECV interrupt flag */
-            if ((num - psize) == 0) {
-                wreg(dev, S0_IR, IR_RECV);
+            if (dev->rx_avail == 0) {
+                dev->rx_avail = raddr(dev, S0_RX_RSR0, S0_RX_RSR1);
+                if (dev->rx_avail == 0) {
+                    wreg(dev, S0_IR, IR_RECV);
+                }
             }
         }
     }
@@ -292,8 +317,12 @@ static void isr(netdev_t *netdev)
     /* we only react on RX events, and if we see one, we read from the RX buffer
      * until it is empty */
     while (ir & IR_RECV) {
-        DEBUG("[w5100] netdev RX complete\n");
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        /* drain all packets the last size read of recv() knows of before
+         * looking at the interrupt register again */
+        do {
+            DEBUG("[w5100] netdev RX complete\n");
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        } while (dev->rx_avail > 0);
 
         /* reread interrupt register */
         spi_acquire(dev->p.spi, dev->p.cs, SPI_CONF, dev->p.clk);
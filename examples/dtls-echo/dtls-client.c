@@ -26,6 +26,7 @@
 
 #include "net/sock/udp.h"
 #include "tinydtls_keys.h"
+#include "xtimer.h"
 
 /* TinyDTLS */
 #include "dtls_debug.h"
@@ -48,7 +49,32 @@
 #define DEFAULT_US_DELAY 100
 #endif
 
+/*
+ * Number of established DTLS channels kept for sending more data to the same
+ * server without a new handshake. Each takes a DTLS context and a DTLS peer,
+ * see DTLS_CONTEXT_MAX and DTLS_PEER_MAX.
+ */
+#ifndef DTLS_CLIENT_SESSIONS
+#define DTLS_CLIENT_SESSIONS (1U)
+#endif
+
+/* Seconds after which a channel is closed and a new handshake is done */
+#ifndef DTLS_CLIENT_SESSION_LIFETIME
+#define DTLS_CLIENT_SESSION_LIFETIME (3600U)
+#endif
+
+/* An established DTLS channel to a server */
+typedef struct {
+    dtls_context_t *ctx;    /* NULL for an unused entry */
+    sock_udp_t sock;        /* the app_data of ctx */
+    session_t dst;
+    uint64_t since;         /* time of the handshake in microseconds */
+} client_session_t;
+
+static client_session_t _sessions[DTLS_CLIENT_SESSIONS];
+
 static int dtls_connected = 0; /* This is handled by Tinydtls callbacks */
+static int dtls_answered = 0; /* Set when application data was received */
 
 /* TinyDTLS callback for detecting the state of the DTLS channel. */
 static int _events_handler(struct dtls_context_t *ctx,
@@ -242,6 +268,7 @@ static int _read_from_peer_handler(struct dtls_context_t *ctx,
     (void) ctx;
     (void) session;
 
+    dtls_answered = 1;
     printf("Client: got DTLS Data App -- ");
     for (size_t i = 0; i < len; i++)
         printf("%c", data[i]);
@@ -381,26 +408,59 @@ dtls_context_t *_init_dtls(sock_udp_t *sock, sock_udp_ep_t *local,
     return new_context;
 }
 
+static void _session_release(client_session_t *s)
+{
+    /* Release resources (strict order!) */
+    dtls_free_context(s->ctx); /* This also sends a DTLS Alert record */
+    sock_udp_close(&s->sock);
+    s->ctx = NULL;
+    DEBUG("Client DTLS session finished\n");
+}
+
+/*
+ * Returns the established channel to addr, or an unused entry. Expired
+ * channels are closed, and the oldest one if all entries are in use.
+ */
+static client_session_t *_session_get(const ipv6_addr_t *addr)
+{
+    client_session_t *oldest = &_sessions[0];
+    uint64_t now = xtimer_now_usec64();
+
+    for (unsigned i = 0; i < DTLS_CLIENT_SESSIONS; i++) {
+        client_session_t *s = &_sessions[i];
+
+        if (s->ctx && ((now - s->since) >
+                       (uint64_t)DTLS_CLIENT_SESSION_LIFETIME * US_PER_SEC)) {
+            DEBUG("Client: DTLS session expired\n");
+            _session_release(s);
+        }
+        if (s->ctx && ipv6_addr_equal(&s->dst.addr, addr)) {
+            return s;
+        }
+        if (!s->ctx || (oldest->ctx && (s->since < oldest->since))) {
+            oldest = s;
+        }
+    }
+    if (oldest->ctx) {
+        _session_release(oldest);
+    }
+    return oldest;
+}
+
 static void client_send(char *addr_str, char *data)
 {
-    static session_t dst;
-    dtls_context_t *dtls_context = NULL;
+    client_session_t *session;
+    ipv6_addr_t addr;
+    char tmp[IPV6_ADDR_MAX_STR_LEN + sizeof("%65535")];
 
     sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
     sock_udp_ep_t remote = SOCK_IPV6_EP_ANY;
-    sock_udp_t sock;
 
     uint8_t watch = MAX_TIMES_TRY_TO_SEND;
     ssize_t app_data_buf = 0;               /* Upper layer packet to send */
 
     /* NOTE: dtls_init() must be called previous to this (see main.c) */
 
-    dtls_context = _init_dtls(&sock, &local, &remote, &dst, addr_str);
-    if (!dtls_context) {
-        puts("ERROR: Client unable to load context!");
-        return;
-    }
-
     char *client_payload;
     if (strlen(data) > DTLS_MAX_BUF) {
         puts("ERROR: Exceeded max size of DTLS buffer.");
@@ -409,24 +469,57 @@ static void client_send(char *addr_str, char *data)
     client_payload = data;
     app_data_buf = strlen(client_payload);
 
-    /* The sock must be opened with the remote already linked to it */
-    if (sock_udp_create(&sock, &local, &remote, 0) != 0) {
-        puts("ERROR: Unable to create UDP sock");
+    /* The address is parsed from a copy, the interface is split off later */
+    if (strlen(addr_str) >= sizeof(tmp)) {
+        puts("ERROR: unable to parse destination address");
         return;
     }
-
-    /*
-     * Starts the DTLS handshake process by sending the first DTLS Hello Client
-     * record.
-     *
-     * NOTE: If dtls_connect() returns zero, then the DTLS channel for the
-     *      dtls_context is already created (never the case for this example)
-     */
-    if (dtls_connect(dtls_context, &dst) < 0) {
-        puts("ERROR: Client unable to start a DTLS channel!\n");
+    strcpy(tmp, addr_str);
+    ipv6_addr_split_iface(tmp);
+    if (ipv6_addr_from_str(&addr, tmp) == NULL) {
+        puts("ERROR: unable to parse destination address");
         return;
     }
 
+    session = _session_get(&addr);
+    if (session->ctx) {
+        /* The DTLS channel to the server is still established */
+        DEBUG("Client: reusing DTLS session\n");
+        dtls_connected = 1;
+    }
+    else {
+        session->ctx = _init_dtls(&session->sock, &local, &remote,
+                                  &session->dst, addr_str);
+        if (!session->ctx) {
+            puts("ERROR: Client unable to load context!");
+            return;
+        }
+
+        /* The sock must be opened with the remote already linked to it */
+        if (sock_udp_create(&session->sock, &local, &remote, 0) != 0) {
+            puts("ERROR: Unable to create UDP sock");
+            dtls_free_context(session->ctx);
+            session->ctx = NULL;
+            return;
+        }
+
+        /*
+         * Starts the DTLS handshake process by sending the first DTLS Hello
+         * Client record.
+         *
+         * NOTE: If dtls_connect() returns zero, then the DTLS channel for the
+         *      dtls_context is already created (never the case for this
+         *      example)
+         */
+        if (dtls_connect(session->ctx, &session->dst) < 0) {
+            puts("ERROR: Client unable to start a DTLS channel!\n");
+            _session_release(session);
+            return;
+        }
+        session->since = xtimer_now_usec64();
+    }
+    dtls_answered = 0;
+
     /*
      * This loop transmits all the DTLS records involved in the DTLS session.
      * Including the real (upper) data to send and to receive. There is a
@@ -446,7 +539,7 @@ static void client_send(char *addr_str, char *data)
         /*  DTLS Session must be established before sending our data */
         if (dtls_connected) {
             DEBUG("Sending (upper layer) data\n");
-            app_data_buf = try_send(dtls_context, &dst,
+            app_data_buf = try_send(session->ctx, &session->dst,
                                     (uint8 *)client_payload, app_data_buf);
 
             if (app_data_buf == 0) { /* Client only transmit data one time. */
@@ -456,7 +549,7 @@ static void client_send(char *addr_str, char *data)
 
         /* Check if a DTLS record was received */
         /* NOTE: We expect an answer after try_send() */
-        dtls_handle_read(dtls_context);
+        dtls_handle_read(session->ctx);
         watch--;
     } /* END while */
 
@@ -472,11 +565,14 @@ static void client_send(char *addr_str, char *data)
      * ends, in a similar approach to the server side.
      */
 
-    /* Release resources (strict order!) */
-    dtls_free_context(dtls_context); /* This also sends a DTLS Alert record */
-    sock_udp_close(&sock);
+    /*
+     * The channel is kept for the next data, unless the handshake failed or
+     * the server did not answer, e.g. because it lost the session.
+     */
+    if (!dtls_connected || !dtls_answered) {
+        _session_release(session);
+    }
     dtls_connected = 0;
-    DEBUG("Client DTLS session finished\n");
 
     return;
 }
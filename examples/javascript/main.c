@@ -26,15 +26,16 @@
 #include "jerryscript.h"
 #include "jerryscript-ext/handler.h"
 
+#ifdef MODULE_JERRYSCRIPT_SNAPSHOT
+/* include header generated from the snapshot of main.js */
+#include "main.js.snapshot.h"
+#else
 /* include header generated from main.js */
 #include "main.js.h"
+#endif
 
-int js_run(const jerry_char_t *script, size_t script_size)
+static void js_init(void)
 {
-
-    jerry_value_t parsed_code, ret_value;
-    int res = 0;
-
     /* Initialize engine, no flags, default configuration */
 
     jerry_init(JERRY_INIT_EMPTY);
@@ -43,6 +44,28 @@ int js_run(const jerry_char_t *script, size_t script_size)
 
     jerryx_handler_register_global((const jerry_char_t *) "print",
                                    jerryx_handler_print);
+}
+
+static int js_check(jerry_value_t ret_value)
+{
+    int res = 0;
+
+    if (jerry_value_is_error(ret_value)) {
+        printf("js_run(): Script Error!");
+        res = -1;
+    }
+    jerry_release_value(ret_value);
+
+    return res;
+}
+
+int js_run(const jerry_char_t *script, size_t script_size)
+{
+
+    jerry_value_t parsed_code;
+    int res = 0;
+
+    js_init();
 
     /* Setup Global scope code */
 
@@ -50,12 +73,7 @@ int js_run(const jerry_char_t *script, size_t script_size)
 
     if (!jerry_value_is_error(parsed_code)) {
         /* Execute the parsed source code in the Global scope */
-        ret_value = jerry_run(parsed_code);
-        if (jerry_value_is_error(ret_value)) {
-            printf("js_run(): Script Error!");
-            res = -1;
-        }
-        jerry_release_value(ret_value);
+        res = js_check(jerry_run(parsed_code));
     }
 
     jerry_release_value(parsed_code);
@@ -66,6 +84,24 @@ int js_run(const jerry_char_t *script, size_t script_size)
     return res;
 }
 
+#ifdef MODULE_JERRYSCRIPT_SNAPSHOT
+int js_run_snapshot(const uint32_t *snapshot, size_t snapshot_size)
+{
+    int res;
+
+    js_init();
+
+    /* Without JERRY_SNAPSHOT_EXEC_COPY_DATA the byte code is executed in
+     * place, so the snapshot must stay valid until jerry_cleanup() */
+    res = js_check(jerry_exec_snapshot(snapshot, snapshot_size, 0, 0));
+
+    /* Cleanup engine */
+    jerry_cleanup();
+
+    return res;
+}
+#endif
+
 int main(void)
 {
     printf("You are running RIOT on a(n) %s board.\n", RIOT_BOARD);
@@ -73,7 +109,11 @@ int main(void)
 
     printf("Executing main.js:\n");
 
+#ifdef MODULE_JERRYSCRIPT_SNAPSHOT
+    js_run_snapshot((const uint32_t *)main_js_snapshot, main_js_snapshot_len);
+#else
     js_run(main_js, main_js_len);
+#endif
 
     return 0;
 }
@@ -64,9 +64,9 @@ export CFLAGS += -DCPU_ARCH_$(ARCH)
 
 # set the compiler specific CPU and FPU options
 ifeq ($(CPU_ARCH),cortex-m4f)
-# TODO: enable hard floating points for the M4F once the context save/restore
-#       code is adjusted to take care of FPU registers
-#export CFLAGS_FPU += -mfloat-abi=hard -mfpu=fpv4-sp-d16
+# the FPU context is switched lazily, but hard float is opt-in until verified
+# on hardware: set CFLAGS_FPU = -mfloat-abi=hard -mfpu=fpv4-sp-d16 to use it.
+# Threads using the FPU then need THREAD_EXTRA_STACKSIZE_FPU more stack.
 export MCPU := cortex-m4
 endif
 CFLAGS_FPU ?= -mfloat-abi=soft
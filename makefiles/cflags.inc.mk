@@ -53,6 +53,12 @@ ifeq ($(LTO),1)
   LINKFLAGS += $(LTOFLAGS)
 endif
 
+# Write the stack usage of every function to a .su file next to its object,
+# evaluated by `make stack-usage`
+ifeq ($(STACK_USAGE),1)
+  CFLAGS += -fstack-usage
+endif
+
 # Forbid common symbols to prevent accidental aliasing.
 CFLAGS += -fno-common
 
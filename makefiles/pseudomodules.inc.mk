@@ -1,5 +1,7 @@
 PSEUDOMODULES += at_urc
+PSEUDOMODULES += auto_init_deferred
 PSEUDOMODULES += auto_init_gnrc_rpl
+PSEUDOMODULES += auto_init_timing
 PSEUDOMODULES += can_mbox
 PSEUDOMODULES += can_pm
 PSEUDOMODULES += can_raw
@@ -10,8 +12,19 @@ PSEUDOMODULES += cord_epsim_standalone
 PSEUDOMODULES += core_%
 PSEUDOMODULES += ecc_%
 PSEUDOMODULES += emb6_router
+PSEUDOMODULES += emcute_async
 PSEUDOMODULES += event_%
+PSEUDOMODULES += evtimer_heap
+PSEUDOMODULES += fastmem
+PSEUDOMODULES += fastmem_%
+PSEUDOMODULES += gcoap_dedup
+PSEUDOMODULES += gcoap_oscore
+PSEUDOMODULES += gcoap_proxy
+PSEUDOMODULES += gcoap_resource_index
+PSEUDOMODULES += gcoap_worker
 PSEUDOMODULES += gnrc_ipv6_default
+PSEUDOMODULES += gnrc_ipv6_fast_forward
+PSEUDOMODULES += gnrc_ipv6_flow_cache
 PSEUDOMODULES += gnrc_ipv6_router
 PSEUDOMODULES += gnrc_ipv6_router_default
 PSEUDOMODULES += gnrc_ipv6_nib_6lbr
@@ -20,18 +33,38 @@ PSEUDOMODULES += gnrc_ipv6_nib_6lr
 PSEUDOMODULES += gnrc_ipv6_nib_dns
 PSEUDOMODULES += gnrc_ipv6_nib_router
 PSEUDOMODULES += gnrc_netdev_default
+PSEUDOMODULES += gnrc_netif_etx
+PSEUDOMODULES += gnrc_netif_csum_offload
+PSEUDOMODULES += gnrc_netif_isr_flag
+PSEUDOMODULES += gnrc_netif_pktq
+PSEUDOMODULES += gnrc_netif_poll
+PSEUDOMODULES += gnrc_netif_shared
+PSEUDOMODULES += gnrc_netif_single
 PSEUDOMODULES += gnrc_neterr
 PSEUDOMODULES += gnrc_netapi_callbacks
+PSEUDOMODULES += gnrc_netapi_direct
 PSEUDOMODULES += gnrc_netapi_mbox
+PSEUDOMODULES += gnrc_netreg_hash
 PSEUDOMODULES += gnrc_pktbuf_cmd
+PSEUDOMODULES += gnrc_pktbuf_quota
+PSEUDOMODULES += gnrc_pktbuf_slab
+PSEUDOMODULES += gnrc_priority_pktqueue_heap
+PSEUDOMODULES += gnrc_rpl_mrhof
+PSEUDOMODULES += gnrc_rpl_srh_root
 PSEUDOMODULES += gnrc_sixlowpan_border_router_default
 PSEUDOMODULES += gnrc_sixlowpan_default
+PSEUDOMODULES += gnrc_sixlowpan_frag_stats
+PSEUDOMODULES += gnrc_sixlowpan_frag_vrb
+PSEUDOMODULES += gnrc_sixlowpan_iphc_cache
 PSEUDOMODULES += gnrc_sixlowpan_iphc_nhc
 PSEUDOMODULES += gnrc_sixlowpan_nd_border_router
 PSEUDOMODULES += gnrc_sixlowpan_router
 PSEUDOMODULES += gnrc_sixlowpan_router_default
+PSEUDOMODULES += gnrc_sock_async
 PSEUDOMODULES += gnrc_sock_check_reuse
+PSEUDOMODULES += gnrc_tcp_async
 PSEUDOMODULES += gnrc_txtsnd
+PSEUDOMODULES += jerryscript-snapshot
 PSEUDOMODULES += l2filter_blacklist
 PSEUDOMODULES += l2filter_whitelist
 PSEUDOMODULES += lis2dh12_spi
@@ -51,7 +84,10 @@ PSEUDOMODULES += newlib
 PSEUDOMODULES += newlib_gnu_source
 PSEUDOMODULES += newlib_nano
 PSEUDOMODULES += openthread
+PSEUDOMODULES += phydat_cbor
 PSEUDOMODULES += pktqueue
+PSEUDOMODULES += pm_layered_governor
+PSEUDOMODULES += posix_poll
 PSEUDOMODULES += printf_float
 PSEUDOMODULES += prng
 PSEUDOMODULES += prng_%
@@ -59,11 +95,21 @@ PSEUDOMODULES += riotboot_%
 PSEUDOMODULES += saul_adc
 PSEUDOMODULES += saul_default
 PSEUDOMODULES += saul_gpio
+PSEUDOMODULES += saul_reg_index
 PSEUDOMODULES += schedstatistics
+PSEUDOMODULES += semtech_loramac_aggregate
 PSEUDOMODULES += sock
+PSEUDOMODULES += sock_async
+PSEUDOMODULES += sock_dns_cache
 PSEUDOMODULES += sock_ip
 PSEUDOMODULES += sock_tcp
 PSEUDOMODULES += sock_udp
+PSEUDOMODULES += stdio_uart_tx_async
+PSEUDOMODULES += tlsf-malloc_stats
+PSEUDOMODULES += trickle_event
+PSEUDOMODULES += xtimer_stats
+PSEUDOMODULES += xtimer_tickless
+PSEUDOMODULES += xtimer_wheel
 
 # print ascii representation in function od_hex_dump()
 PSEUDOMODULES += od_string
@@ -132,5 +178,7 @@ PSEUDOMODULES += ds18_optimized
 PSEUDOMODULES += crypto_aes_precalculated
 # This pseudomodule causes a loop in AES to be unrolled (more flash, less CPU)
 PSEUDOMODULES += crypto_aes_unroll
+# Selects the constant time AES without lookup tables
+PSEUDOMODULES += crypto_aes_ct
 
 # Packages may also add modules to PSEUDOMODULES in their `Makefile.include`.
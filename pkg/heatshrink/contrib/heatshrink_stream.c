@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_heatshrink
+ * @{
+ *
+ * @file
+ * @brief       Streaming compression on top of heatshrink
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "heatshrink_stream.h"
+
+void heatshrink_stream_enc_init(heatshrink_stream_enc_t *s)
+{
+    heatshrink_encoder_reset(&s->hse);
+    s->done = false;
+}
+
+ssize_t heatshrink_stream_compress(heatshrink_stream_enc_t *s,
+                                   const void *in, size_t *in_len,
+                                   void *out, size_t out_len, bool last)
+{
+    uint8_t *src = (uint8_t *)in;
+    uint8_t *dst = out;
+    size_t taken = 0;
+    size_t written = 0;
+
+    while (!s->done && (written < out_len)) {
+        size_t n;
+        HSE_poll_res res = heatshrink_encoder_poll(&s->hse, &dst[written],
+                                                   out_len - written, &n);
+
+        if (res < 0) {
+            return -EINVAL;
+        }
+        written += n;
+        if (res == HSER_POLL_MORE) {
+            /* out is full */
+            continue;
+        }
+        /* the encoder only takes input once all of its output is polled */
+        if (taken < *in_len) {
+            if (heatshrink_encoder_sink(&s->hse, &src[taken],
+                                        *in_len - taken, &n) < 0) {
+                return -EINVAL;
+            }
+            taken += n;
+        }
+        else if (last) {
+            HSE_finish_res fin = heatshrink_encoder_finish(&s->hse);
+
+            if (fin < 0) {
+                return -EINVAL;
+            }
+            s->done = (fin == HSER_FINISH_DONE);
+        }
+        else {
+            break;
+        }
+    }
+    *in_len = taken;
+    return written;
+}
+
+void heatshrink_stream_dec_init(heatshrink_stream_dec_t *s)
+{
+    heatshrink_decoder_reset(&s->hsd);
+    s->done = false;
+}
+
+ssize_t heatshrink_stream_decompress(heatshrink_stream_dec_t *s,
+                                     const void *in, size_t *in_len,
+                                     void *out, size_t out_len, bool last)
+{
+    uint8_t *src = (uint8_t *)in;
+    uint8_t *dst = out;
+    size_t taken = 0;
+    size_t written = 0;
+
+    while (!s->done && (written < out_len)) {
+        size_t n;
+        HSD_poll_res res = heatshrink_decoder_poll(&s->hsd, &dst[written],
+                                                   out_len - written, &n);
+
+        if (res < 0) {
+            return -EINVAL;
+        }
+        written += n;
+        if (res == HSDR_POLL_MORE) {
+            continue;
+        }
+        if (taken < *in_len) {
+            if (heatshrink_decoder_sink(&s->hsd, &src[taken],
+                                        *in_len - taken, &n) < 0) {
+                return -EINVAL;
+            }
+            taken += n;
+        }
+        else if (last) {
+            HSD_finish_res fin = heatshrink_decoder_finish(&s->hsd);
+
+            if (fin < 0) {
+                return -EINVAL;
+            }
+            s->done = (fin == HSDR_FINISH_DONE);
+        }
+        else {
+            break;
+        }
+    }
+    *in_len = taken;
+    return written;
+}
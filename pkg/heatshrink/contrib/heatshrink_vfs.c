@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_heatshrink
+ * @{
+ *
+ * @file
+ * @brief       Compressing file descriptors
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+
+#include "mutex.h"
+#include "vfs.h"
+#include "heatshrink_stream.h"
+
+typedef struct {
+    union {
+        heatshrink_stream_enc_t enc;
+        heatshrink_stream_dec_t dec;
+    } s;
+    int fd;                             /* wrapped fd */
+    bool used;                          /* context is in use */
+    bool eof;                           /* fd was read to its end */
+    uint16_t pos;                       /* next byte to decompress */
+    uint16_t len;                       /* bytes in buf */
+    uint8_t buf[HEATSHRINK_VFS_BUFSIZE];    /* compressed data */
+} _ctx_t;
+
+static _ctx_t _ctx[HEATSHRINK_VFS_NUMOF];
+static mutex_t _lock = MUTEX_INIT;
+
+static int _flush(_ctx_t *ctx)
+{
+    for (uint16_t pos = 0; pos < ctx->len;) {
+        ssize_t res = vfs_write(ctx->fd, &ctx->buf[pos], ctx->len - pos);
+
+        if (res < 0) {
+            return res;
+        }
+        pos += res;
+    }
+    ctx->len = 0;
+    return 0;
+}
+
+/* compresses into buf, writing it to fd whenever it is full */
+static ssize_t _compress(_ctx_t *ctx, const uint8_t *src, size_t nbytes,
+                         bool last)
+{
+    size_t taken = 0;
+
+    do {
+        size_t len = nbytes - taken;
+        ssize_t res = heatshrink_stream_compress(&ctx->s.enc, &src[taken],
+                                                 &len, &ctx->buf[ctx->len],
+                                                 sizeof(ctx->buf) - ctx->len,
+                                                 last);
+
+        if (res < 0) {
+            return res;
+        }
+        taken += len;
+        ctx->len += res;
+        if ((ctx->len == sizeof(ctx->buf)) && ((res = _flush(ctx)) < 0)) {
+            return res;
+        }
+    } while ((taken < nbytes) ||
+             (last && !heatshrink_stream_enc_done(&ctx->s.enc)));
+    return nbytes;
+}
+
+static ssize_t _write(vfs_file_t *filp, const void *src, size_t nbytes)
+{
+    _ctx_t *ctx = filp->private_data.ptr;
+
+    if ((filp->flags & O_ACCMODE) != O_WRONLY) {
+        return -EBADF;
+    }
+    return _compress(ctx, src, nbytes, false);
+}
+
+static ssize_t _read(vfs_file_t *filp, void *dest, size_t nbytes)
+{
+    _ctx_t *ctx = filp->private_data.ptr;
+    size_t got = 0;
+
+    if ((filp->flags & O_ACCMODE) != O_RDONLY) {
+        return -EBADF;
+    }
+    while ((got < nbytes) && !heatshrink_stream_dec_done(&ctx->s.dec)) {
+        if ((ctx->pos == ctx->len) && !ctx->eof) {
+            ssize_t res = vfs_read(ctx->fd, ctx->buf, sizeof(ctx->buf));
+
+            if (res < 0) {
+                return (got) ? (ssize_t)got : res;
+            }
+            ctx->pos = 0;
+            ctx->len = res;
+            ctx->eof = (res == 0);
+        }
+
+        size_t len = ctx->len - ctx->pos;
+        ssize_t res = heatshrink_stream_decompress(&ctx->s.dec,
+                                                   &ctx->buf[ctx->pos], &len,
+                                                   (uint8_t *)dest + got,
+                                                   nbytes - got, ctx->eof);
+        if (res < 0) {
+            return res;
+        }
+        ctx->pos += len;
+        got += res;
+    }
+    return got;
+}
+
+static off_t _lseek(vfs_file_t *filp, off_t off, int whence)
+{
+    (void)filp;
+    (void)off;
+    (void)whence;
+    return -ESPIPE;
+}
+
+static int _close(vfs_file_t *filp)
+{
+    _ctx_t *ctx = filp->private_data.ptr;
+    int res = 0;
+
+    if ((filp->flags & O_ACCMODE) == O_WRONLY) {
+        /* write what the encoder still holds back */
+        res = _compress(ctx, (const uint8_t *)"", 0, true);
+        if (res >= 0) {
+            res = _flush(ctx);
+        }
+    }
+    int close_res = vfs_close(ctx->fd);
+
+    mutex_lock(&_lock);
+    ctx->used = false;
+    mutex_unlock(&_lock);
+    return (res < 0) ? res : close_res;
+}
+
+static const vfs_file_ops_t _ops = {
+    .close = _close,
+    .lseek = _lseek,
+    .read = _read,
+    .write = _write,
+};
+
+int heatshrink_vfs_open(int fd, int flags)
+{
+    _ctx_t *ctx = NULL;
+
+    if ((flags != O_WRONLY) && (flags != O_RDONLY)) {
+        return -EINVAL;
+    }
+
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < HEATSHRINK_VFS_NUMOF; i++) {
+        if (!_ctx[i].used) {
+            ctx = &_ctx[i];
+            break;
+        }
+    }
+    if (ctx == NULL) {
+        mutex_unlock(&_lock);
+        return -ENFILE;
+    }
+
+    int res = vfs_bind(VFS_ANY_FD, flags, &_ops, ctx);
+    if (res >= 0) {
+        ctx->used = true;
+        ctx->fd = fd;
+        ctx->eof = false;
+        ctx->pos = 0;
+        ctx->len = 0;
+        if (flags == O_WRONLY) {
+            heatshrink_stream_enc_init(&ctx->s.enc);
+        }
+        else {
+            heatshrink_stream_dec_init(&ctx->s.dec);
+        }
+    }
+    mutex_unlock(&_lock);
+    return res;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_heatshrink
+ * @brief       Streaming compression on top of heatshrink
+ * @{
+ *
+ * The `heatshrink_stream` module drives the sink/poll state machines of the
+ * heatshrink encoder and decoder for the caller: each call takes as much
+ * input as fits and fills the output buffer, so data can be compressed
+ * chunk by chunk into fixed size buffers, e.g. the blocks of a CoAP
+ * block-wise transfer, without holding the whole input or output.
+ *
+ * With the `vfs` module, heatshrink_vfs_open() wraps a file descriptor, so
+ * e.g. a log is compressed transparently while writing it and decompressed
+ * while reading it back. The state of @ref HEATSHRINK_VFS_NUMOF wrapped
+ * descriptors is allocated statically.
+ *
+ * The window and lookahead sizes are the static ones of heatshrink
+ * (`HEATSHRINK_STATIC_WINDOW_BITS`, `HEATSHRINK_STATIC_LOOKAHEAD_BITS`), and
+ * need to be the same for compressing and decompressing. The compressed data
+ * has no header, an application sending it to others needs to announce the
+ * coding by itself, e.g. by the CoAP content format of the resource.
+ *
+ * @file
+ * @brief       Streaming compression definitions
+ */
+
+#ifndef HEATSHRINK_STREAM_H
+#define HEATSHRINK_STREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#include "heatshrink_encoder.h"
+#include "heatshrink_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of file descriptors heatshrink_vfs_open() can wrap at once
+ */
+#ifndef HEATSHRINK_VFS_NUMOF
+#define HEATSHRINK_VFS_NUMOF        (1U)
+#endif
+
+/**
+ * @brief   Size of the buffer between a wrapped file descriptor and the
+ *          encoder or decoder
+ *
+ * The larger, the fewer the writes to the file system.
+ */
+#ifndef HEATSHRINK_VFS_BUFSIZE
+#define HEATSHRINK_VFS_BUFSIZE      (64U)
+#endif
+
+/**
+ * @brief   Compression stream
+ */
+typedef struct {
+    heatshrink_encoder hse;     /**< encoder state */
+    bool done;                  /**< all output was returned */
+} heatshrink_stream_enc_t;
+
+/**
+ * @brief   Decompression stream
+ */
+typedef struct {
+    heatshrink_decoder hsd;     /**< decoder state */
+    bool done;                  /**< all output was returned */
+} heatshrink_stream_dec_t;
+
+/**
+ * @brief   Initializes a compression stream
+ *
+ * @param[out] s    stream to initialize
+ */
+void heatshrink_stream_enc_init(heatshrink_stream_enc_t *s);
+
+/**
+ * @brief   Compresses a chunk
+ *
+ * Takes input until @p out is full. With @p last set, the stream is finished
+ * once all of the input was taken, and heatshrink_stream_enc_done() tells
+ * when all of the output was returned; call this again with no more input
+ * until then.
+ *
+ * @param[in,out] s         stream
+ * @param[in]     in        input
+ * @param[in,out] in_len    length of @p in, set to the number of bytes taken
+ * @param[out]    out       output buffer
+ * @param[in]     out_len   size of @p out
+ * @param[in]     last      @p in ends the input
+ *
+ * @return  number of bytes written to @p out
+ * @return  -EINVAL on misuse, e.g. more input after the last
+ */
+ssize_t heatshrink_stream_compress(heatshrink_stream_enc_t *s,
+                                   const void *in, size_t *in_len,
+                                   void *out, size_t out_len, bool last);
+
+/**
+ * @brief   Checks whether all output of a compression stream was returned
+ *
+ * @param[in] s     stream
+ *
+ * @return  true, if the stream is finished
+ */
+static inline bool heatshrink_stream_enc_done(const heatshrink_stream_enc_t *s)
+{
+    return s->done;
+}
+
+/**
+ * @brief   Initializes a decompression stream
+ *
+ * @param[out] s    stream to initialize
+ */
+void heatshrink_stream_dec_init(heatshrink_stream_dec_t *s);
+
+/**
+ * @brief   Decompresses a chunk
+ *
+ * Same as heatshrink_stream_compress(), the other way round.
+ *
+ * @param[in,out] s         stream
+ * @param[in]     in        compressed input
+ * @param[in,out] in_len    length of @p in, set to the number of bytes taken
+ * @param[out]    out       output buffer
+ * @param[in]     out_len   size of @p out
+ * @param[in]     last      @p in ends the input
+ *
+ * @return  number of bytes written to @p out
+ * @return  -EINVAL on misuse or corrupt input
+ */
+ssize_t heatshrink_stream_decompress(heatshrink_stream_dec_t *s,
+                                     const void *in, size_t *in_len,
+                                     void *out, size_t out_len, bool last);
+
+/**
+ * @brief   Checks whether all output of a decompression stream was returned
+ *
+ * @param[in] s     stream
+ *
+ * @return  true, if the stream is finished
+ */
+static inline bool heatshrink_stream_dec_done(const heatshrink_stream_dec_t *s)
+{
+    return s->done;
+}
+
+#if defined(MODULE_VFS) || defined(DOXYGEN)
+/**
+ * @brief   Wraps a file descriptor in compression
+ *
+ * Data written to the returned file descriptor is compressed into @p fd,
+ * data read from it is decompressed from @p fd. Closing it writes the rest
+ * of the compressed data and closes @p fd as well. It does not support
+ * seeking.
+ *
+ * Needs the `vfs` module.
+ *
+ * @param[in] fd        file descriptor to wrap, owned by the new one
+ * @param[in] flags     O_WRONLY to compress, O_RDONLY to decompress
+ *
+ * @return  the new file descriptor
+ * @return  -EINVAL if @p flags is neither O_WRONLY nor O_RDONLY
+ * @return  -ENFILE if @ref HEATSHRINK_VFS_NUMOF descriptors are wrapped
+ *          already
+ * @return  other negative errors of vfs_bind()
+ */
+int heatshrink_vfs_open(int fd, int flags);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEATSHRINK_STREAM_H */
+/** @} */
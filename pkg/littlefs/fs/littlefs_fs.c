@@ -25,6 +25,9 @@
 #include <string.h>
 
 #include "fs/littlefs_fs.h"
+#ifdef MODULE_FS_CHECKPOINT
+#include "fs/checkpoint.h"
+#endif
 
 #include "kernel_defines.h"
 
@@ -122,9 +125,9 @@ static int _dev_erase(const struct lfs_config *c, lfs_block_t block)
 
 static int _dev_sync(const struct lfs_config *c)
 {
-    (void)c;
+    littlefs_desc_t *fs = c->context;
 
-    return 0;
+    return mtd_flush(fs->dev);
 }
 
 static int prepare(littlefs_desc_t *fs)
@@ -166,6 +169,69 @@ static int prepare(littlefs_desc_t *fs)
     return mtd_init(fs->dev);
 }
 
+#ifdef MODULE_FS_CHECKPOINT
+/* allocation state of a cleanly unmounted file system */
+typedef struct {
+    uint32_t base_addr;
+    lfs_size_t block_count;
+    lfs_size_t block_size;
+    lfs_block_t off;
+    lfs_block_t size;
+    lfs_block_t i;
+    lfs_block_t ack;
+    uint8_t deorphaned;
+    uint8_t lookahead[LITTLEFS_LOOKAHEAD_SIZE / 8];
+} _checkpoint_t;
+
+static void _checkpoint_save(littlefs_desc_t *fs)
+{
+    _checkpoint_t cp;
+
+    if (!fs->checkpoint) {
+        return;
+    }
+    memset(&cp, 0, sizeof(cp));
+    cp.base_addr = fs->base_addr;
+    cp.block_count = fs->config.block_count;
+    cp.block_size = fs->config.block_size;
+    cp.off = fs->fs.free.off;
+    cp.size = fs->fs.free.size;
+    cp.i = fs->fs.free.i;
+    cp.ack = fs->fs.free.ack;
+    cp.deorphaned = fs->fs.deorphaned;
+    memcpy(cp.lookahead, fs->lookahead_buf, sizeof(cp.lookahead));
+
+    int ret = fs_checkpoint_save(fs->dev, fs->checkpoint, &cp, sizeof(cp));
+    DEBUG("littlefs: checkpoint saved: %d\n", ret);
+    (void)ret;
+}
+
+static void _checkpoint_restore(littlefs_desc_t *fs)
+{
+    _checkpoint_t cp;
+
+    if (!fs->checkpoint ||
+        (fs_checkpoint_take(fs->dev, fs->checkpoint, &cp, sizeof(cp)) < 0)) {
+        return;
+    }
+    if ((cp.base_addr != fs->base_addr) ||
+        (cp.block_count != fs->config.block_count) ||
+        (cp.block_size != fs->config.block_size)) {
+        DEBUG("littlefs: checkpoint of another geometry\n");
+        return;
+    }
+    /* the lookahead window and the orphan check are picked up where they
+     * were left, instead of traversing the file system again */
+    fs->fs.free.off = cp.off;
+    fs->fs.free.size = cp.size;
+    fs->fs.free.i = cp.i;
+    fs->fs.free.ack = cp.ack;
+    fs->fs.deorphaned = cp.deorphaned;
+    memcpy(fs->lookahead_buf, cp.lookahead, sizeof(cp.lookahead));
+    DEBUG("littlefs: checkpoint restored\n");
+}
+#endif
+
 static int _format(vfs_mount_t *mountp)
 {
     littlefs_desc_t *fs = mountp->private_data;
@@ -176,6 +242,11 @@ static int _format(vfs_mount_t *mountp)
         return -ENODEV;
     }
 
+#ifdef MODULE_FS_CHECKPOINT
+    if (fs->checkpoint) {
+        fs_checkpoint_discard(fs->dev, fs->checkpoint);
+    }
+#endif
     ret = lfs_format(&fs->fs, &fs->config);
     mutex_unlock(&fs->lock);
 
@@ -198,6 +269,11 @@ static int _mount(vfs_mount_t *mountp)
     }
 
     ret = lfs_mount(&fs->fs, &fs->config);
+#ifdef MODULE_FS_CHECKPOINT
+    if (ret == LFS_ERR_OK) {
+        _checkpoint_restore(fs);
+    }
+#endif
     mutex_unlock(&fs->lock);
 
     return littlefs_err_to_errno(ret);
@@ -211,6 +287,9 @@ static int _umount(vfs_mount_t *mountp)
 
     DEBUG("littlefs: umount: mountp=%p\n", (void *)mountp);
 
+#ifdef MODULE_FS_CHECKPOINT
+    _checkpoint_save(fs);
+#endif
     int ret = lfs_unmount(&fs->fs);
     mutex_unlock(&fs->lock);
 
@@ -44,6 +44,13 @@ const char *lua_riot_str_errors[] = {
     "Unknown error"
 };
 
+/* State of the allocator of a lua state, at the start of its memory */
+typedef struct {
+    tlsf_t tlsf;
+    size_t used;        /* bytes requested by lua */
+    size_t limit;       /* 0 for no limit */
+} lua_riot_heap_t;
+
 /* The lua docs state the behavior in these cases:
  *
  *  1.              ptr=?, size=0    -> free(ptr)
@@ -63,42 +70,87 @@ const char *lua_riot_str_errors[] = {
  *  }
  *
  * Therefore it is safe to use tlsf_realloc here.
+ *
+ * The usage is counted in the sizes of the TLSF blocks, as osize is the type
+ * of the object if ptr is NULL, and the debug allocator adds a header.
+ * Failing a request makes lua run a full garbage collection and try again,
+ * which is what we want when the limit is reached.
  */
 static void *lua_tlsf_alloc(void *ud, void *ptr, size_t osize, size_t nsize)
 {
-    tlsf_t tlsf = ud;
+    lua_riot_heap_t *heap = ud;
+    size_t old = (ptr) ? tlsf_block_size(ptr) : 0;
+    void *res;
 
     (void)osize;
 
-    return tlsf_realloc(tlsf, ptr, nsize);
+    if (heap->limit && (nsize > old) &&
+        ((heap->used >= heap->limit) ||
+         ((nsize - old) > (heap->limit - heap->used)))) {
+        return NULL;
+    }
+
+    res = tlsf_realloc(heap->tlsf, ptr, nsize);
+    if (res) {
+        heap->used = heap->used - old + tlsf_block_size(res);
+    }
+    else if (nsize == 0) {
+        heap->used -= old;
+    }
+    return res;
+}
+
+static lua_riot_heap_t *_get_heap(lua_State *L)
+{
+    void *ud;
+
+    lua_getallocf(L, &ud);
+    #ifdef LUA_DEBUG
+        return ((Memcontrol *)ud)->alloc_ud;
+    #else
+        return ud;
+    #endif
 }
 
 LUALIB_API lua_State *lua_riot_newstate(void *memory, size_t mem_size,
                                         lua_CFunction panicf)
 {
     lua_State *L;
+    lua_riot_heap_t *heap = memory;
 
     #ifdef LUA_DEBUG
-        Memcontrol *mc = memory;
+        Memcontrol *mc;
     #endif
 
+    if (mem_size < sizeof(*heap)) {
+        return NULL;
+    }
+    memory = heap + 1;
+    mem_size -= sizeof(*heap);
+
     /* If we are using the lua debug module, let's reserve a space for the
      * memcontrol block directly. We don't use the allocator because we lose
      * the pointer, so we won't be able to free it and we will get a false
      * positive if we try to check for memory leaks.
      */
     #ifdef LUA_DEBUG
+        mc = memory;
         memory = (Memcontrol *)memory + 1;
         mem_size -= (uint8_t *)memory - (uint8_t *)mc;
     #endif
 
-    tlsf_t tlsf = tlsf_create_with_pool(memory, mem_size);
+    heap->tlsf = tlsf_create_with_pool(memory, mem_size);
+    if (heap->tlsf == NULL) {
+        return NULL;
+    }
+    heap->used = 0;
+    heap->limit = 0;
 
     #ifdef LUA_DEBUG
-        luaB_init_memcontrol(mc, lua_tlsf_alloc, tlsf);
+        luaB_init_memcontrol(mc, lua_tlsf_alloc, heap);
         L = luaB_newstate(mc);
     #else
-        L = lua_newstate(lua_tlsf_alloc, tlsf);
+        L = lua_newstate(lua_tlsf_alloc, heap);
     #endif
 
     if (L != NULL) {
@@ -108,6 +160,16 @@ LUALIB_API lua_State *lua_riot_newstate(void *memory, size_t mem_size,
     return L;
 }
 
+LUALIB_API void lua_riot_set_memlimit(lua_State *L, size_t limit)
+{
+    _get_heap(L)->limit = limit;
+}
+
+LUALIB_API size_t lua_riot_get_memused(lua_State *L)
+{
+    return _get_heap(L)->used;
+}
+
 static const luaL_Reg loadedlibs[LUAR_LOAD_O_ALL] = {
     { "_G", luaopen_base },
     { LUA_LOADLIBNAME, luaopen_package },
@@ -164,6 +226,7 @@ NORETURN static int _jump_back(lua_State *L)
 }
 
 static int lua_riot_do_module_or_buf(const uint8_t *buf, size_t buflen,
+                                     const char *mode,
                                      const char *modname, void *memory, size_t mem_size,
                                      uint16_t modmask, int *retval)
 {
@@ -204,8 +267,10 @@ static int lua_riot_do_module_or_buf(const uint8_t *buf, size_t buflen,
         compilation_result = lua_riot_getloader(L, modname);
     }
     else {
+        /* the reader of luaL_loadbufferx() hands out buf as a whole, so
+         * code in flash is parsed in place */
         compilation_result = luaL_loadbufferx(L, (const char *)buf,
-                                              buflen, modname, "t");
+                                              buflen, modname, mode);
     }
 
     switch (compilation_result) {
@@ -261,15 +326,23 @@ lua_riot_do_error:
 LUALIB_API int lua_riot_do_module(const char *modname, void *memory, size_t mem_size,
                                   uint16_t modmask, int *retval)
 {
-    return lua_riot_do_module_or_buf(NULL, 0, modname, memory, mem_size, modmask,
-                                     retval);
+    return lua_riot_do_module_or_buf(NULL, 0, NULL, modname, memory, mem_size,
+                                     modmask, retval);
 }
 
 LUALIB_API int lua_riot_do_buffer(const uint8_t *buf, size_t buflen, void *memory,
                                   size_t mem_size, uint16_t modmask, int *retval)
 {
-    return lua_riot_do_module_or_buf(buf, buflen, "=BUFFER", memory, mem_size,
-                                     modmask, retval);
+    return lua_riot_do_module_or_buf(buf, buflen, "t", "=BUFFER", memory,
+                                     mem_size, modmask, retval);
+}
+
+LUALIB_API int lua_riot_do_bytecode(const uint8_t *buf, size_t buflen,
+                                    void *memory, size_t mem_size,
+                                    uint16_t modmask, int *retval)
+{
+    return lua_riot_do_module_or_buf(buf, buflen, "b", "=BYTECODE", memory,
+                                     mem_size, modmask, retval);
 }
 
 #define MAX_ERR_STRING ((sizeof(lua_riot_str_errors) / sizeof(*lua_riot_str_errors)) - 1)
@@ -49,7 +49,8 @@ extern "C" {
  */
 struct lua_riot_builtin_lua {
     const char *name;   /*!< Name of the module */
-    const uint8_t *code;   /*!< Lua source code buffer*/
+    const uint8_t *code;   /*!< Lua source code or precompiled
+                            *   bytecode buffer */
     size_t code_size;   /*!< Size of the source code buffer. */
 };
 
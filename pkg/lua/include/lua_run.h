@@ -121,14 +121,12 @@ LUALIB_API const char *lua_riot_strerror(int errn);
 /**
  * Initialize a lua state and set the panic handler.
  *
- * @todo    Use a per-state allocator
+ * The state allocates from its own TLSF heap in @p memory, the start of
+ * @p memory holds the state of the allocator.
  *
  * @param   memory      Pointer to memory region that will be used as heap for
- *                      the allocator. Currently this functionality is not
- *                      supported and this must be set to NULL.
+ *                      the allocator, aligned to the size of a pointer.
  * @param   mem_size    Size of the memory region that will be used as heap.
- *                      Currently this functionality is not supported and this
- *                      must be set to 0.
  * @param   panicf      Function to be passed to lua_atpanic. If set to NULL,
  *                      a generic function that does nothing will be used.
  *
@@ -137,6 +135,30 @@ LUALIB_API const char *lua_riot_strerror(int errn);
 LUALIB_API lua_State *lua_riot_newstate(void *memory, size_t mem_size,
                                         lua_CFunction panicf);
 
+/**
+ * Limit the memory a lua state may use.
+ *
+ * Allocations beyond the limit fail, which makes lua collect garbage and
+ * raise a memory error if that did not help. This allows to give a state
+ * less than the size of its heap, e.g. to keep a reserve for the C code
+ * called by it.
+ *
+ * @param   L           Lua state created with lua_riot_newstate()
+ * @param   limit       Maximum number of bytes, 0 for no limit besides the
+ *                      size of the heap.
+ */
+LUALIB_API void lua_riot_set_memlimit(lua_State *L, size_t limit);
+
+/**
+ * Get the memory used by a lua state.
+ *
+ * @param   L           Lua state created with lua_riot_newstate()
+ *
+ * @return      Number of bytes in use, including the overhead of the
+ *              allocator for every block.
+ */
+LUALIB_API size_t lua_riot_get_memused(lua_State *L);
+
 /**
  * Terminate the lua state.
  *
@@ -214,6 +236,33 @@ LUALIB_API int lua_riot_do_module(const char *modname, void *memory, size_t mem_
 LUALIB_API int lua_riot_do_buffer(const uint8_t *buf, size_t buflen, void *memory,
                                   size_t mem_size, uint16_t modmask, int *retval);
 
+/**
+ * Initialize the interpreter and run precompiled bytecode in protected mode.
+ *
+ * This skips the compilation of the source code at startup, which takes
+ * most of the time and RAM of lua_riot_do_buffer(). The bytecode is read in
+ * place, so it can be stored in flash, e.g. as a const array or a file of
+ * @ref sys_constfs.
+ *
+ * The bytecode must be created by `luac` of the same lua version with the
+ * same number types and sizes as the target (see `Makefile.lua`), from
+ * trusted sources only: the lua interpreter is not robust against corrupt
+ * binary code.
+ *
+ * @see lua_riot_do_module() for more information on internal errors.
+ *
+ * @param       buf         Bytecode.
+ * @param       buflen      Size of the bytecode in bytes.
+ * @param       memory      @see lua_riot_newstate()
+ * @param       mem_size    @see lua_riot_newstate()
+ * @param       modmask     @see lua_riot_newstate()
+ * @param[out]  retval      @see lua_riot_do_module()
+ * @return      @see lua_riot_do_module().
+ */
+LUALIB_API int lua_riot_do_bytecode(const uint8_t *buf, size_t buflen,
+                                    void *memory, size_t mem_size,
+                                    uint16_t modmask, int *retval);
+
 #ifdef __cplusplus
 extern "C" }
 #endif
@@ -235,7 +235,7 @@ static err_t _ieee802154_link_output(struct netif *netif, struct pbuf *p)
 
 static struct pbuf *_get_recv_pkt(netdev_t *dev)
 {
-    int len = dev->driver->recv(dev, _tmp_buf, sizeof(_tmp_buf), NULL);
+    int len = dev->driver->recv(dev, NULL, 0, NULL);
 
     if (len < 0) {
         DEBUG("lwip_netdev: an error occurred while reading the packet\n");
@@ -246,9 +246,29 @@ static struct pbuf *_get_recv_pkt(netdev_t *dev)
 
     if (p == NULL) {
         DEBUG("lwip_netdev: can not allocate in pbuf\n");
+        /* drop the packet */
+        dev->driver->recv(dev, NULL, len, NULL);
         return NULL;
     }
-    pbuf_take(p, _tmp_buf, len);
+    if (p->next == NULL) {
+        /* the packet fits into a single pbuf, receive it right there */
+        len = dev->driver->recv(dev, p->payload, p->len, NULL);
+    }
+    else {
+        /* the payloads of a pbuf chain are scattered, so take the detour via
+         * the temporary buffer */
+        len = dev->driver->recv(dev, _tmp_buf, sizeof(_tmp_buf), NULL);
+        if (len > 0) {
+            pbuf_take(p, _tmp_buf, len);
+        }
+    }
+    if (len < 0) {
+        DEBUG("lwip_netdev: an error occurred while reading the packet\n");
+        pbuf_free(p);
+        return NULL;
+    }
+    /* the size reported beforehand is an upper bound for some drivers */
+    pbuf_realloc(p, (u16_t)len);
     return p;
 }
 
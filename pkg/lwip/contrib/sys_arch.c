@@ -23,6 +23,7 @@
 #include "lwip/opt.h"
 #include "lwip/sys.h"
 
+#include "irq.h"
 #include "msg.h"
 #include "sema.h"
 #include "thread.h"
@@ -38,7 +39,7 @@ void sys_init(void)
 
 u32_t sys_now(void)
 {
-    return (uint32_t)(xtimer_now_usec64() / US_PER_MS);
+    return xtimer_now_msec();
 }
 
 err_t sys_mutex_new(sys_mutex_t *mutex)
@@ -131,37 +132,59 @@ err_t sys_mbox_trypost(sys_mbox_t *mbox, void *msg)
     }
 }
 
+/**
+ * @brief   timeout of sys_arch_mbox_fetch()
+ */
+typedef struct {
+    xtimer_t timer;
+    mbox_t *mbox;
+    uint32_t id;    /**< tells the timeouts of consecutive fetches apart */
+} _mbox_timeout_t;
+
+static uint32_t _timeout_id;
+
 static void _mbox_timeout(void *arg)
 {
-    msg_t m = { .type = _MSG_TIMEOUT };
-    mbox_put(arg, &m);
+    _mbox_timeout_t *timeout = arg;
+    msg_t m = { .content = { .value = timeout->id }, .type = _MSG_TIMEOUT };
+
+    /* never block in interrupt context, the fetch returns with any message */
+    mbox_try_put(timeout->mbox, &m);
 }
 
 u32_t sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout)
 {
     msg_t m;
-    xtimer_t timer = { .callback = _mbox_timeout, .arg = &mbox->mbox };
+    _mbox_timeout_t t = {
+        .timer = { .callback = _mbox_timeout, .arg = &t },
+        .mbox = &mbox->mbox,
+    };
     uint64_t start, stop;
 
     start = xtimer_now_usec64();
     if (timeout > 0) {
         uint64_t u_timeout = (timeout * US_PER_MS);
-        _xtimer_set64(&timer, (uint32_t)u_timeout, (uint32_t)(u_timeout >> 32));
+        unsigned state = irq_disable();
+
+        t.id = ++_timeout_id;
+        irq_restore(state);
+        _xtimer_set64(&t.timer, (uint32_t)u_timeout, (uint32_t)(u_timeout >> 32));
     }
-    mbox_get(&mbox->mbox, &m);
-    stop = xtimer_now_usec64();
-    xtimer_remove(&timer);  /* in case timer did not time out */
-    switch (m.type) {
-        case _MSG_SUCCESS:
+    while (1) {
+        mbox_get(&mbox->mbox, &m);
+        if (m.type == _MSG_SUCCESS) {
+            stop = xtimer_now_usec64();
+            xtimer_remove(&t.timer);    /* in case timer did not time out */
             *msg = m.content.ptr;
             return (u32_t)((stop - start) / US_PER_MS);
-        case _MSG_TIMEOUT:
-            break;
-        default:    /* should not happen */
-            LWIP_ASSERT("invalid message received", false);
-            break;
+        }
+        LWIP_ASSERT("invalid message received", (m.type == _MSG_TIMEOUT));
+        /* skip the timeouts of earlier fetches that fired right after their
+         * message was received */
+        if ((timeout > 0) && (m.content.value == t.id)) {
+            return SYS_ARCH_TIMEOUT;
+        }
     }
-    return SYS_ARCH_TIMEOUT;
 }
 
 u32_t sys_arch_mbox_tryfetch(sys_mbox_t *mbox, void **msg)
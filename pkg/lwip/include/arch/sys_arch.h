@@ -36,7 +36,13 @@ extern "C" {
 
 #define LWIP_COMPAT_MUTEX   (0)
 #define SYS_SEM_NULL        { 0, PRIORITY_QUEUE_INIT }
+
+/**
+ * @brief   Number of messages of a mailbox
+ */
+#ifndef SYS_MBOX_SIZE
 #define SYS_MBOX_SIZE       (8)
+#endif
 
 typedef struct {
     mbox_t mbox;
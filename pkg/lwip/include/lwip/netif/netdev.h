@@ -33,6 +33,12 @@ extern "C" {
 
 /**
  * @brief   Length of the temporary copying buffer for receival.
+ *
+ * A packet that fits into a single pbuf of the pool is received directly
+ * into it, only packets that need a pbuf chain are received into this buffer
+ * first. Set `PBUF_POOL_BUFSIZE` to the maximum packet length to always
+ * receive directly.
+ *
  * @note    It should be as long as the maximum packet length of all the netdev you use.
  */
 #ifndef LWIP_NETDEV_BUFLEN
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    pkg_nimble_netif GNRC netif implementation for NimBLE
+ * @ingroup     pkg_nimble
+ * @brief       IPv6 over BLE (RFC 7668) on top of NimBLE's L2CAP
+ *              connection-oriented channels
+ *
+ * This module provides a GNRC network interface that transfers 6LoWPAN
+ * compressed IPv6 packets over L2CAP connection-oriented channels on the
+ * IPSP PSM. Each BLE connection carries one channel, and up to
+ * @ref NIMBLE_NETIF_CONN_NUMOF connections are served at the same time.
+ * Unicast packets are sent over the channel to the peer with the matching
+ * link-layer address, multicast packets are sent over all channels.
+ *
+ * Connections are opened with nimble_netif_connect() (GAP central) or
+ * accepted after nimble_netif_accept() (GAP peripheral). The L2CAP channel
+ * is set up on top of the connection without further involvement of the
+ * application.
+ *
+ * Packets are copied once in each direction, between the L2CAP SDU mbuf
+ * chain and the packet buffer, without an intermediate buffer.
+ *
+ * @{
+ *
+ * @file
+ * @brief       GNRC netif implementation for NimBLE
+ */
+
+#ifndef NIMBLE_NETIF_H
+#define NIMBLE_NETIF_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "host/ble_hs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of concurrent connections
+ */
+#ifndef NIMBLE_NETIF_CONN_NUMOF
+#define NIMBLE_NETIF_CONN_NUMOF     (MYNEWT_VAL_BLE_MAX_CONNECTIONS)
+#endif
+
+/**
+ * @brief   MTU of the L2CAP channels
+ *
+ * RFC 7668 requires IPv6 packets of 1280 bytes to fit into one SDU.
+ */
+#ifndef NIMBLE_NETIF_MTU
+#define NIMBLE_NETIF_MTU            (1280U)
+#endif
+
+/**
+ * @brief   L2CAP PSM of the Internet Protocol Support Profile
+ */
+#define NIMBLE_NETIF_IPSP_PSM       (0x0023)
+
+/**
+ * @brief   Priority of the netif thread
+ */
+#ifndef NIMBLE_NETIF_PRIO
+#define NIMBLE_NETIF_PRIO           (GNRC_NETIF_PRIO)
+#endif
+
+/**
+ * @brief   Events reported to the application
+ */
+typedef enum {
+    NIMBLE_NETIF_CONNECTED,         /**< the L2CAP channel is open */
+    NIMBLE_NETIF_CLOSED,            /**< the connection was closed */
+    NIMBLE_NETIF_ABORT,             /**< opening a connection failed */
+} nimble_netif_event_t;
+
+/**
+ * @brief   Callback for connection events
+ *
+ * Called in the context of NimBLE's host thread.
+ *
+ * @param[in] handle    connection handle
+ * @param[in] event     the event
+ */
+typedef void (*nimble_netif_eventcb_t)(int handle, nimble_netif_event_t event);
+
+/**
+ * @brief   Creates the network interface and the L2CAP server
+ *
+ * Called by auto_init.
+ */
+void nimble_netif_init(void);
+
+/**
+ * @brief   Sets the callback for connection events
+ *
+ * @param[in] cb    the callback, NULL to disable
+ */
+void nimble_netif_eventcb(nimble_netif_eventcb_t cb);
+
+/**
+ * @brief   Opens a connection to a peer as GAP central
+ *
+ * @param[in] addr      address of the peer
+ * @param[in] params    connection parameters, NULL for NimBLE's defaults
+ * @param[in] timeout   timeout of the connection attempt in ms
+ *
+ * @return  0 on success, i.e. the attempt was started
+ * @return  -ENOMEM if all connections are in use
+ * @return  -EBUSY if a connection attempt is in progress already
+ * @return  -EIO on other errors of NimBLE
+ */
+int nimble_netif_connect(const ble_addr_t *addr,
+                         const struct ble_gap_conn_params *params,
+                         uint32_t timeout);
+
+/**
+ * @brief   Advertises and accepts a connection as GAP peripheral
+ *
+ * Advertising stops as soon as a peer connected, call this function again to
+ * accept further connections.
+ *
+ * @param[in] ad            advertising data
+ * @param[in] ad_len        length of @p ad
+ * @param[in] adv_params    advertising parameters
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if all connections are in use
+ * @return  -EIO on errors of NimBLE, e.g. when advertising already
+ */
+int nimble_netif_accept(const uint8_t *ad, size_t ad_len,
+                        const struct ble_gap_adv_params *adv_params);
+
+/**
+ * @brief   Closes a connection
+ *
+ * @param[in] handle    connection handle
+ *
+ * @return  0 on success
+ * @return  -ENOTCONN if there is no such connection
+ */
+int nimble_netif_close(int handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NIMBLE_NETIF_H */
+/** @} */
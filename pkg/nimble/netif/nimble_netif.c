@@ -0,0 +1,567 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_nimble_netif
+ * @{
+ *
+ * @file
+ * @brief       GNRC netif implementation for NimBLE
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/nettype.h"
+
+#include "nimble_netif.h"
+
+#include "host/ble_gap.h"
+#include "host/ble_l2cap.h"
+#include "host/util/util.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if NIMBLE_NETIF_CONN_NUMOF > MYNEWT_VAL_BLE_L2CAP_COC_MAX_NUM
+#error "NIMBLE_NETIF_CONN_NUMOF must not exceed MYNEWT_VAL_BLE_L2CAP_COC_MAX_NUM"
+#endif
+
+/* NimBLE stores addresses with the least significant byte first, the
+ * link-layer addresses of RFC 7668 start with the most significant one */
+#define L2ADDR_LEN          (BLE_DEV_ADDR_LEN)
+
+/* every connection needs a buffer for receiving and one for sending an SDU */
+#define MBUF_OVHD           (sizeof(struct os_mbuf) + \
+                             sizeof(struct os_mbuf_pkthdr))
+#define MBUF_SIZE           (MBUF_OVHD + MYNEWT_VAL_BLE_L2CAP_COC_MPS)
+#define MBUF_PER_SDU        ((NIMBLE_NETIF_MTU + MBUF_SIZE - 1) / MBUF_SIZE)
+#define MBUF_CNT            (NIMBLE_NETIF_CONN_NUMOF * 2 * (MBUF_PER_SDU + 1))
+
+enum {
+    CONN_UNUSED = 0,
+    CONN_CONNECTING,                /* GAP connection in progress or open */
+    CONN_OPEN,                      /* L2CAP channel open */
+};
+
+typedef struct {
+    struct ble_l2cap_chan *coc;
+    uint16_t handle;
+    uint8_t addr[L2ADDR_LEN];
+    uint8_t state;
+} _conn_t;
+
+static char _stack[THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE];
+static gnrc_netif_t *_netif;
+static _conn_t _conns[NIMBLE_NETIF_CONN_NUMOF];
+/* held while accessing the connections, they are changed in the host
+ * thread and used for sending in the netif thread */
+static mutex_t _lock = MUTEX_INIT;
+static nimble_netif_eventcb_t _eventcb;
+static uint8_t _own_addr_type;
+
+static os_membuf_t _mem[OS_MEMPOOL_SIZE(MBUF_CNT, MBUF_SIZE)];
+static struct os_mempool _mem_pool;
+static struct os_mbuf_pool _mbuf_pool;
+
+static int _on_gap_evt(struct ble_gap_event *event, void *arg);
+
+static void _addr_rev(uint8_t *dst, const uint8_t *src)
+{
+    for (unsigned i = 0; i < L2ADDR_LEN; i++) {
+        dst[i] = src[L2ADDR_LEN - 1 - i];
+    }
+}
+
+static void _notify(int handle, nimble_netif_event_t event)
+{
+    nimble_netif_eventcb_t cb = _eventcb;
+
+    if (cb) {
+        cb(handle, event);
+    }
+}
+
+/* must be called with _lock held */
+static _conn_t *_conn_by_handle(uint16_t handle)
+{
+    for (unsigned i = 0; i < NIMBLE_NETIF_CONN_NUMOF; i++) {
+        if ((_conns[i].state != CONN_UNUSED) && (_conns[i].handle == handle)) {
+            return &_conns[i];
+        }
+    }
+    return NULL;
+}
+
+/* must be called with _lock held */
+static _conn_t *_conn_by_addr(const uint8_t *addr)
+{
+    for (unsigned i = 0; i < NIMBLE_NETIF_CONN_NUMOF; i++) {
+        if ((_conns[i].state == CONN_OPEN) &&
+            (memcmp(_conns[i].addr, addr, L2ADDR_LEN) == 0)) {
+            return &_conns[i];
+        }
+    }
+    return NULL;
+}
+
+/* must be called with _lock held */
+static _conn_t *_conn_alloc(uint16_t handle)
+{
+    for (unsigned i = 0; i < NIMBLE_NETIF_CONN_NUMOF; i++) {
+        if (_conns[i].state == CONN_UNUSED) {
+            _conns[i].state = CONN_CONNECTING;
+            _conns[i].handle = handle;
+            _conns[i].coc = NULL;
+            return &_conns[i];
+        }
+    }
+    return NULL;
+}
+
+static void _conn_free(_conn_t *conn)
+{
+    conn->state = CONN_UNUSED;
+    conn->handle = BLE_HS_CONN_HANDLE_NONE;
+    conn->coc = NULL;
+}
+
+static int _send_sdu(_conn_t *conn, const gnrc_pktsnip_t *payload)
+{
+    struct os_mbuf *sdu = os_mbuf_get_pkthdr(&_mbuf_pool, 0);
+    int res;
+
+    if (sdu == NULL) {
+        return -ENOBUFS;
+    }
+    for (; payload != NULL; payload = payload->next) {
+        if (os_mbuf_append(sdu, payload->data, payload->size) != 0) {
+            os_mbuf_free_chain(sdu);
+            return -ENOBUFS;
+        }
+    }
+    res = ble_l2cap_send(conn->coc, sdu);
+    if (res != 0) {
+        DEBUG("nimble_netif: unable to send on %u: %d\n", conn->handle, res);
+        os_mbuf_free_chain(sdu);
+        return -EBUSY;
+    }
+    return 0;
+}
+
+static int _netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr;
+    int res = -ENOTCONN;
+
+    (void)netif;
+    if (pkt->type != GNRC_NETTYPE_NETIF) {
+        DEBUG("nimble_netif: first header is not generic netif header\n");
+        gnrc_pktbuf_release(pkt);
+        return -EBADMSG;
+    }
+    hdr = pkt->data;
+
+    mutex_lock(&_lock);
+    if (hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                      GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        /* there is no multicast in BLE, so send to all peers */
+        for (unsigned i = 0; i < NIMBLE_NETIF_CONN_NUMOF; i++) {
+            if (_conns[i].state == CONN_OPEN) {
+                int tmp = _send_sdu(&_conns[i], pkt->next);
+                if (res < 0) {
+                    res = tmp;
+                }
+            }
+        }
+    }
+    else {
+        _conn_t *conn = NULL;
+
+        if (hdr->dst_l2addr_len == L2ADDR_LEN) {
+            conn = _conn_by_addr(gnrc_netif_hdr_get_dst_addr(hdr));
+        }
+        if (conn != NULL) {
+            res = _send_sdu(conn, pkt->next);
+        }
+    }
+    mutex_unlock(&_lock);
+
+    if (res == 0) {
+        res = gnrc_pkt_len(pkt->next);
+    }
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+static gnrc_pktsnip_t *_netif_recv(gnrc_netif_t *netif)
+{
+    (void)netif;
+    /* packets are dispatched right from the host thread */
+    return NULL;
+}
+
+static void _netif_init(gnrc_netif_t *netif)
+{
+#ifdef MODULE_GNRC_IPV6
+    /* the L2CAP channels take a whole IPv6 packet, no fragmentation is
+     * needed */
+    netif->ipv6.mtu = NIMBLE_NETIF_MTU;
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    netif->flags |= GNRC_NETIF_FLAGS_6LO_HC;
+#endif
+    (void)netif;
+}
+
+static const gnrc_netif_ops_t _nimble_netif_ops = {
+    .init = _netif_init,
+    .send = _netif_send,
+    .recv = _netif_recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+    .msg_handler = NULL,
+};
+
+static int _netdev_init(netdev_t *dev)
+{
+    ble_addr_t addr;
+
+    _netif = dev->context;
+    /* the address is only known once the host synced with the controller */
+    while (!ble_hs_synced()) {
+        xtimer_usleep(US_PER_MS);
+    }
+    if ((ble_hs_id_infer_auto(0, &_own_addr_type) != 0) ||
+        (ble_hs_id_copy_addr(_own_addr_type, addr.val, NULL) != 0)) {
+        return -EIO;
+    }
+    _addr_rev(_netif->l2addr, addr.val);
+    return 0;
+}
+
+static int _netdev_get(netdev_t *dev, netopt_t opt, void *value,
+                       size_t max_len)
+{
+    (void)dev;
+    switch (opt) {
+        case NETOPT_ADDRESS:
+            assert(max_len >= L2ADDR_LEN);
+            memcpy(value, _netif->l2addr, L2ADDR_LEN);
+            return L2ADDR_LEN;
+        case NETOPT_ADDR_LEN:
+        case NETOPT_SRC_LEN:
+            assert(max_len == sizeof(uint16_t));
+            *((uint16_t *)value) = L2ADDR_LEN;
+            return sizeof(uint16_t);
+        case NETOPT_MAX_PACKET_SIZE:
+            assert(max_len >= sizeof(uint16_t));
+            *((uint16_t *)value) = NIMBLE_NETIF_MTU;
+            return sizeof(uint16_t);
+        case NETOPT_PROTO:
+            assert(max_len == sizeof(gnrc_nettype_t));
+            *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+            return sizeof(gnrc_nettype_t);
+        case NETOPT_DEVICE_TYPE:
+            assert(max_len == sizeof(uint16_t));
+            *((uint16_t *)value) = NETDEV_TYPE_BLE;
+            return sizeof(uint16_t);
+        default:
+            return -ENOTSUP;
+    }
+}
+
+static const netdev_driver_t _nimble_netdev_driver = {
+    .send = NULL,
+    .recv = NULL,
+    .init = _netdev_init,
+    .isr = NULL,
+    .get = _netdev_get,
+    .set = netdev_set_notsup,
+};
+
+/* netdev is required by gnrc_netif, only its options are used */
+static netdev_t _nimble_netdev_dummy = {
+    .driver = &_nimble_netdev_driver,
+};
+
+static void _on_data(_conn_t *conn, struct os_mbuf *sdu)
+{
+    size_t len = OS_MBUF_PKTLEN(sdu);
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        DEBUG("nimble_netif: no space left in packet buffer\n");
+        return;
+    }
+    /* the only copy on the way up the stack */
+    if (os_mbuf_copydata(sdu, 0, len, pkt->data) != 0) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    hdr = gnrc_netif_hdr_build(conn->addr, L2ADDR_LEN,
+                               _netif->l2addr, L2ADDR_LEN);
+    if (hdr == NULL) {
+        DEBUG("nimble_netif: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ((gnrc_netif_hdr_t *)hdr->data)->if_pid = _netif->pid;
+    LL_APPEND(pkt, hdr);
+
+    if (!gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL,
+                                      pkt)) {
+        DEBUG("nimble_netif: unable to forward packet of type %i\n",
+              pkt->type);
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static int _on_l2cap_evt(struct ble_l2cap_event *event, void *arg)
+{
+    struct ble_gap_conn_desc desc;
+    struct os_mbuf *sdu;
+    _conn_t *conn;
+    int handle = -1;
+    nimble_netif_event_t notify = NIMBLE_NETIF_CONNECTED;
+
+    (void)arg;
+    mutex_lock(&_lock);
+    switch (event->type) {
+        case BLE_L2CAP_EVENT_COC_CONNECTED:
+            conn = _conn_by_handle(event->connect.conn_handle);
+            if (conn == NULL) {
+                break;
+            }
+            if ((event->connect.status != 0) ||
+                (ble_gap_conn_find(conn->handle, &desc) != 0)) {
+                DEBUG("nimble_netif: L2CAP connect failed\n");
+                ble_gap_terminate(conn->handle, BLE_ERR_REM_USER_CONN_TERM);
+                break;
+            }
+            _addr_rev(conn->addr, desc.peer_id_addr.val);
+            conn->coc = event->connect.chan;
+            conn->state = CONN_OPEN;
+            handle = conn->handle;
+            break;
+        case BLE_L2CAP_EVENT_COC_DISCONNECTED:
+            conn = _conn_by_handle(event->disconnect.conn_handle);
+            if (conn != NULL) {
+                /* the GAP connection is closed as well */
+                conn->coc = NULL;
+                conn->state = CONN_CONNECTING;
+            }
+            break;
+        case BLE_L2CAP_EVENT_COC_ACCEPT:
+            conn = _conn_by_handle(event->accept.conn_handle);
+            sdu = os_mbuf_get_pkthdr(&_mbuf_pool, 0);
+            if ((conn == NULL) || (sdu == NULL)) {
+                if (sdu != NULL) {
+                    os_mbuf_free_chain(sdu);
+                }
+                mutex_unlock(&_lock);
+                return BLE_HS_ENOMEM;
+            }
+            ble_l2cap_recv_ready(event->accept.chan, sdu);
+            break;
+        case BLE_L2CAP_EVENT_COC_DATA_RECEIVED:
+            conn = _conn_by_handle(event->receive.conn_handle);
+            if (conn != NULL) {
+                _on_data(conn, event->receive.sdu_rx);
+            }
+            os_mbuf_free_chain(event->receive.sdu_rx);
+            /* hand out a buffer for the next SDU */
+            sdu = os_mbuf_get_pkthdr(&_mbuf_pool, 0);
+            if (sdu == NULL) {
+                DEBUG("nimble_netif: no buffer left for receiving\n");
+                ble_l2cap_disconnect(event->receive.chan);
+                break;
+            }
+            ble_l2cap_recv_ready(event->receive.chan, sdu);
+            break;
+        default:
+            break;
+    }
+    mutex_unlock(&_lock);
+
+    if (handle >= 0) {
+        _notify(handle, notify);
+    }
+    return 0;
+}
+
+static int _on_gap_evt(struct ble_gap_event *event, void *arg)
+{
+    struct os_mbuf *sdu;
+    _conn_t *conn;
+    bool central = (arg != NULL);
+    int handle;
+
+    switch (event->type) {
+        case BLE_GAP_EVENT_CONNECT:
+            handle = event->connect.conn_handle;
+            mutex_lock(&_lock);
+            if (central) {
+                /* allocated when connecting, with an unknown handle */
+                conn = _conn_by_handle(BLE_HS_CONN_HANDLE_NONE);
+            }
+            else {
+                conn = (event->connect.status == 0) ? _conn_alloc(handle)
+                                                    : NULL;
+            }
+            if (event->connect.status != 0) {
+                if (conn != NULL) {
+                    _conn_free(conn);
+                }
+                mutex_unlock(&_lock);
+                _notify(-1, NIMBLE_NETIF_ABORT);
+                return 0;
+            }
+            if (conn == NULL) {
+                mutex_unlock(&_lock);
+                ble_gap_terminate(handle, BLE_ERR_CONN_LIMIT);
+                return 0;
+            }
+            conn->handle = handle;
+            mutex_unlock(&_lock);
+            /* the central opens the channel, the peripheral accepts it */
+            if (central) {
+                sdu = os_mbuf_get_pkthdr(&_mbuf_pool, 0);
+                if ((sdu == NULL) ||
+                    (ble_l2cap_connect(handle, NIMBLE_NETIF_IPSP_PSM,
+                                       NIMBLE_NETIF_MTU, sdu,
+                                       _on_l2cap_evt, NULL) != 0)) {
+                    if (sdu != NULL) {
+                        os_mbuf_free_chain(sdu);
+                    }
+                    ble_gap_terminate(handle, BLE_ERR_REM_USER_CONN_TERM);
+                }
+            }
+            break;
+        case BLE_GAP_EVENT_DISCONNECT:
+            handle = event->disconnect.conn.conn_handle;
+            mutex_lock(&_lock);
+            conn = _conn_by_handle(handle);
+            if (conn != NULL) {
+                _conn_free(conn);
+            }
+            mutex_unlock(&_lock);
+            if (conn != NULL) {
+                _notify(handle, NIMBLE_NETIF_CLOSED);
+            }
+            break;
+        default:
+            break;
+    }
+    return 0;
+}
+
+void nimble_netif_init(void)
+{
+    int res;
+
+    (void)res;
+    for (unsigned i = 0; i < NIMBLE_NETIF_CONN_NUMOF; i++) {
+        _conn_free(&_conns[i]);
+    }
+
+    res = os_mempool_init(&_mem_pool, MBUF_CNT, MBUF_SIZE, _mem, "nim_gnrc");
+    assert(res == 0);
+    res = os_mbuf_pool_init(&_mbuf_pool, &_mem_pool, MBUF_SIZE, MBUF_CNT);
+    assert(res == 0);
+
+    res = ble_l2cap_create_server(NIMBLE_NETIF_IPSP_PSM, NIMBLE_NETIF_MTU,
+                                  _on_l2cap_evt, NULL);
+    assert(res == 0);
+
+    gnrc_netif_create(_stack, sizeof(_stack), NIMBLE_NETIF_PRIO,
+                      "nimble_netif", &_nimble_netdev_dummy,
+                      &_nimble_netif_ops);
+}
+
+void nimble_netif_eventcb(nimble_netif_eventcb_t cb)
+{
+    _eventcb = cb;
+}
+
+int nimble_netif_connect(const ble_addr_t *addr,
+                         const struct ble_gap_conn_params *params,
+                         uint32_t timeout)
+{
+    _conn_t *conn;
+
+    mutex_lock(&_lock);
+    if (_conn_by_handle(BLE_HS_CONN_HANDLE_NONE) != NULL) {
+        mutex_unlock(&_lock);
+        return -EBUSY;
+    }
+    conn = _conn_alloc(BLE_HS_CONN_HANDLE_NONE);
+    mutex_unlock(&_lock);
+    if (conn == NULL) {
+        return -ENOMEM;
+    }
+
+    /* a non-NULL argument tells the GAP events of the central apart */
+    if (ble_gap_connect(_own_addr_type, addr, timeout, params,
+                        _on_gap_evt, conn) != 0) {
+        mutex_lock(&_lock);
+        _conn_free(conn);
+        mutex_unlock(&_lock);
+        return -EIO;
+    }
+    return 0;
+}
+
+int nimble_netif_accept(const uint8_t *ad, size_t ad_len,
+                        const struct ble_gap_adv_params *adv_params)
+{
+    bool free = false;
+
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < NIMBLE_NETIF_CONN_NUMOF; i++) {
+        free |= (_conns[i].state == CONN_UNUSED);
+    }
+    mutex_unlock(&_lock);
+    if (!free) {
+        return -ENOMEM;
+    }
+
+    if ((ble_gap_adv_set_data(ad, (int)ad_len) != 0) ||
+        (ble_gap_adv_start(_own_addr_type, NULL, BLE_HS_FOREVER, adv_params,
+                           _on_gap_evt, NULL) != 0)) {
+        return -EIO;
+    }
+    return 0;
+}
+
+int nimble_netif_close(int handle)
+{
+    _conn_t *conn;
+
+    mutex_lock(&_lock);
+    conn = _conn_by_handle((uint16_t)handle);
+    mutex_unlock(&_lock);
+    if ((handle < 0) || (conn == NULL)) {
+        return -ENOTCONN;
+    }
+    if (ble_gap_terminate((uint16_t)handle, BLE_ERR_REM_USER_CONN_TERM) != 0) {
+        return -ENOTCONN;
+    }
+    return 0;
+}
@@ -20,6 +20,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <string.h>
+#include "event/wait_multi.h"
 #include "msg.h"
 #include "openthread/cli.h"
 #include "openthread/instance.h"
@@ -39,6 +40,7 @@ static msg_t _queue[OPENTHREAD_QUEUE_LEN];
 
 static kernel_pid_t _pid;
 static otInstance *sInstance;
+static netdev_t *_netdev;
 
 uint8_t ot_call_command(char* command, void *arg, void* answer) {
     ot_job_t job;
@@ -70,7 +72,6 @@ static void *_openthread_event_loop(void *arg) {
     sInstance = otInstanceInitSingle();
 
     msg_init_queue(_queue, OPENTHREAD_QUEUE_LEN);
-    netdev_t *dev;
     msg_t msg, reply;
 
 #if defined(MODULE_OPENTHREAD_CLI_FTD) || defined(MODULE_OPENTHREAD_CLI_MTD)
@@ -92,20 +93,28 @@ static void *_openthread_event_loop(void *arg) {
 
     ot_job_t *job;
     serial_msg_t* serialBuffer;
+    event_wait_multi_t wait;
     while (1) {
         otTaskletsProcess(sInstance);
         if (otTaskletsArePending(sInstance) == false) {
-            msg_receive(&msg);
+            if (event_wait_multi(NULL, OPENTHREAD_THREAD_FLAG_ISR |
+                                       OPENTHREAD_THREAD_FLAG_ENERGY_SCAN,
+                                 &wait) == EVENT_WAIT_MULTI_FLAGS) {
+                if (wait.flags & OPENTHREAD_THREAD_FLAG_ISR) {
+                    /* Handle the events of the driver */
+                    _netdev->driver->isr(_netdev);
+                }
+                if (wait.flags & OPENTHREAD_THREAD_FLAG_ENERGY_SCAN) {
+                    energy_scan_done(sInstance);
+                }
+                continue;
+            }
+            msg = wait.msg;
             switch (msg.type) {
                 case OPENTHREAD_XTIMER_MSG_TYPE_EVENT:
                     /* Tell OpenThread a time event was received */
                     otPlatAlarmMilliFired(sInstance);
                     break;
-                case OPENTHREAD_NETDEV_MSG_TYPE_EVENT:
-                    /* Received an event from driver */
-                    dev = msg.content.ptr;
-                    dev->driver->isr(dev);
-                    break;
                 case OPENTHREAD_SERIAL_MSG_TYPE_EVENT:
                     /* Tell OpenThread about the reception of a CLI command */
                     serialBuffer = (serial_msg_t*)msg.content.ptr;
@@ -127,24 +136,19 @@ static void *_openthread_event_loop(void *arg) {
 static void _event_cb(netdev_t *dev, netdev_event_t event) {
     switch (event) {
         case NETDEV_EVENT_ISR:
-            {
-                msg_t msg;
-                assert(_pid != KERNEL_PID_UNDEF);
-
-                msg.type = OPENTHREAD_NETDEV_MSG_TYPE_EVENT;
-                msg.content.ptr = dev;
-
-                if (msg_send(&msg, _pid) <= 0) {
-                    DEBUG("openthread_netdev: possibly lost interrupt.\n");
-                }
-                break;
-            }
+            assert(_pid != KERNEL_PID_UNDEF);
+            /* can't get lost, subsequent interrupts are handled by one call
+             * to the driver's isr() */
+            thread_flags_set((thread_t *)thread_get(_pid),
+                             OPENTHREAD_THREAD_FLAG_ISR);
+            break;
 
         case NETDEV_EVENT_RX_COMPLETE:
             DEBUG("openthread_netdev: Reception of a packet\n");
             recv_pkt(sInstance, dev);
             break;
         case NETDEV_EVENT_TX_COMPLETE:
+        case NETDEV_EVENT_TX_COMPLETE_DATA_PENDING:
         case NETDEV_EVENT_TX_NOACK:
         case NETDEV_EVENT_TX_MEDIUM_BUSY:
             DEBUG("openthread_netdev: Transmission of a packet\n");
@@ -165,6 +169,7 @@ int openthread_netdev_init(char *stack, int stacksize, char priority,
                            const char *name, netdev_t *netdev) {
     netdev->driver->init(netdev);
     netdev->event_callback = _event_cb;
+    _netdev = netdev;
 
     netopt_enable_t enable = NETOPT_ENABLE;
     netdev->driver->set(netdev, NETOPT_TX_END_IRQ, &enable, sizeof(enable));
@@ -31,22 +31,37 @@
 #include "openthread/platform/diag.h"
 #include "openthread/platform/radio.h"
 #include "ot.h"
+#include "thread.h"
+#include "xtimer.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 #define RADIO_IEEE802154_FCS_LEN    (2U)
+/* frame control, sequence number and FCS */
+#define RADIO_IEEE802154_ACK_LEN    (3U + RADIO_IEEE802154_FCS_LEN)
 
 static otRadioFrame sTransmitFrame;
 static otRadioFrame sReceiveFrame;
+static otRadioFrame sAckFrame;
+static uint8_t sAckPsdu[RADIO_IEEE802154_ACK_LEN];
 static int8_t Rssi;
+static int8_t sEnergyScanMaxRssi;
 
 static netdev_t *_dev;
+static int _channel = -1;
 
 /* set 15.4 channel */
 static int _set_channel(uint16_t channel)
 {
-    return _dev->driver->set(_dev, NETOPT_CHANNEL, &channel, sizeof(uint16_t));
+    /* changing the channel of a radio is costly, e.g. it needs the PLL to
+     * settle, and OpenThread sets it before every frame */
+    if (_channel == channel) {
+        return sizeof(uint16_t);
+    }
+    int res = _dev->driver->set(_dev, NETOPT_CHANNEL, &channel, sizeof(uint16_t));
+    _channel = (res < 0) ? -1 : channel;
+    return res;
 }
 
 /* set transmission power */
@@ -133,6 +148,8 @@ void openthread_radio_init(netdev_t *dev, uint8_t *tb, uint8_t *rb)
     sTransmitFrame.mLength = 0;
     sReceiveFrame.mPsdu = rb;
     sReceiveFrame.mLength = 0;
+    sAckFrame.mPsdu = sAckPsdu;
+    sAckFrame.mLength = RADIO_IEEE802154_ACK_LEN;
     _dev = dev;
 }
 
@@ -186,7 +203,13 @@ void send_pkt(otInstance *aInstance, netdev_t *dev, netdev_event_t event)
             break;
         case NETDEV_EVENT_TX_COMPLETE_DATA_PENDING:
             DEBUG("openthread: NETDEV_EVENT_TX_COMPLETE_DATA_PENDING\n");
-            otPlatRadioTxDone(aInstance, &sTransmitFrame, NULL, OT_ERROR_NONE);
+            /* OpenThread takes the frame pending bit from the ACK, e.g. to
+             * keep a sleepy end device awake after a data poll */
+            sAckPsdu[0] = IEEE802154_FCF_TYPE_ACK | IEEE802154_FCF_FRAME_PEND;
+            sAckPsdu[1] = 0;
+            sAckPsdu[2] = sTransmitFrame.mPsdu[2];
+            sAckFrame.mChannel = sTransmitFrame.mChannel;
+            otPlatRadioTxDone(aInstance, &sTransmitFrame, &sAckFrame, OT_ERROR_NONE);
             break;
         case NETDEV_EVENT_TX_NOACK:
             DEBUG("openthread: NETDEV_EVENT_TX_NOACK\n");
@@ -357,7 +380,10 @@ otError otPlatRadioTransmit(otInstance *aInstance, otRadioFrame *aPacket)
     _set_channel(aPacket->mChannel);
 
     /* send packet though netdev */
-    _dev->driver->send(_dev, &iolist);
+    if (_dev->driver->send(_dev, &iolist) < 0) {
+        DEBUG("openthread: otPlatRadioTransmit: send failed\n");
+        return OT_ERROR_INVALID_STATE;
+    }
     otPlatRadioTxStarted(aInstance, aPacket);
 
     return OT_ERROR_NONE;
@@ -369,7 +395,14 @@ otRadioCaps otPlatRadioGetCaps(otInstance *aInstance)
     (void)aInstance;
     DEBUG("openthread: otPlatRadioGetCaps\n");
     /* all drivers should handle ACK, including call of NETDEV_EVENT_TX_NOACK */
-    return OT_RADIO_CAPS_TRANSMIT_RETRIES | OT_RADIO_CAPS_ACK_TIMEOUT;
+    otRadioCaps caps = OT_RADIO_CAPS_TRANSMIT_RETRIES | OT_RADIO_CAPS_ACK_TIMEOUT;
+    int8_t ed;
+
+    /* an energy scan is made of CCAs, see otPlatRadioEnergyScan() */
+    if (_dev->driver->get(_dev, NETOPT_LAST_ED_LEVEL, &ed, sizeof(ed)) > 0) {
+        caps |= OT_RADIO_CAPS_ENERGY_SCAN;
+    }
+    return caps;
 }
 
 /* OpenThread will call this for getting the state of promiscuous mode */
@@ -446,13 +479,40 @@ void otPlatRadioClearSrcMatchExtEntries(otInstance *aInstance)
     (void)aInstance;
 }
 
+/* OpenThread will call this for measuring the energy on a channel, the
+ * result is reported with energy_scan_done() */
 otError otPlatRadioEnergyScan(otInstance *aInstance, uint8_t aScanChannel, uint16_t aScanDuration)
 {
-    DEBUG("otPlatRadioEnergyScan\n");
+    DEBUG("otPlatRadioEnergyScan. Channel: %i\n", aScanChannel);
     (void)aInstance;
-    (void)aScanChannel;
-    (void)aScanDuration;
-    return OT_ERROR_NOT_IMPLEMENTED;
+    uint32_t start = xtimer_now_usec();
+    netopt_enable_t clear;
+    int8_t ed;
+
+    _set_idle();
+    _set_channel(aScanChannel);
+    sEnergyScanMaxRssi = INT8_MIN;
+    do {
+        /* a CCA measures the energy on the channel */
+        if ((_dev->driver->get(_dev, NETOPT_IS_CHANNEL_CLR, &clear, sizeof(clear)) < 0) ||
+            (_dev->driver->get(_dev, NETOPT_LAST_ED_LEVEL, &ed, sizeof(ed)) < 0)) {
+            return OT_ERROR_NOT_IMPLEMENTED;
+        }
+        if (ed > sEnergyScanMaxRssi) {
+            sEnergyScanMaxRssi = ed;
+        }
+    } while ((xtimer_now_usec() - start) < (aScanDuration * US_PER_MS));
+
+    /* OpenThread expects the result after this function returned */
+    thread_flags_set((thread_t *)thread_get(openthread_get_pid()),
+                     OPENTHREAD_THREAD_FLAG_ENERGY_SCAN);
+    return OT_ERROR_NONE;
+}
+
+/* Called upon OPENTHREAD_THREAD_FLAG_ENERGY_SCAN */
+void energy_scan_done(otInstance *aInstance)
+{
+    otPlatRadioEnergyScanDone(aInstance, sEnergyScanMaxRssi);
 }
 
 void otPlatRadioGetIeeeEui64(otInstance *aInstance, uint8_t *aIeee64Eui64)
@@ -51,6 +51,16 @@ extern "C" {
 #define OPENTHREAD_JOB_MSG_TYPE_EVENT                       (0x2240)
 /** @} */
 
+/**
+ * @name    Openthread thread flags
+ * @{
+ */
+/** @brief   set by the netdev ISR instead of sending a message */
+#define OPENTHREAD_THREAD_FLAG_ISR                          (1u << 1)
+/** @brief   an energy scan is done */
+#define OPENTHREAD_THREAD_FLAG_ENERGY_SCAN                  (1u << 2)
+/** @} */
+
 /**
  * @name    Openthread constants
  * @{
@@ -112,6 +122,13 @@ void recv_pkt(otInstance *aInstance, netdev_t *dev);
  */
 void send_pkt(otInstance *aInstance, netdev_t *dev, netdev_event_t event);
 
+/**
+ * @brief   Inform OpenThread that an energy scan is done
+ *
+ * @param[in]  aInstance          pointer to an OpenThread instance
+ */
+void energy_scan_done(otInstance *aInstance);
+
 /**
  * @brief   Bootstrap OpenThread
  */
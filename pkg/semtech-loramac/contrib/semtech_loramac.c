@@ -833,6 +833,64 @@ uint8_t semtech_loramac_send(semtech_loramac_t *mac, uint8_t *data, uint8_t len)
     return SEMTECH_LORAMAC_TX_SCHEDULE;
 }
 
+#ifdef MODULE_SEMTECH_LORAMAC_AGGREGATE
+static uint8_t _max_payload(semtech_loramac_t *mac)
+{
+    LoRaMacTxInfo_t txInfo;
+
+    mutex_lock(&mac->lock);
+    /* also fills in the maximum payload if the size does not fit */
+    LoRaMacQueryTxPossible(0, &txInfo);
+    mutex_unlock(&mac->lock);
+
+    return txInfo.MaxPossiblePayload;
+}
+
+uint8_t semtech_loramac_flush(semtech_loramac_t *mac)
+{
+    if (mac->tx_len == 0) {
+        return SEMTECH_LORAMAC_TX_DONE;
+    }
+
+    /* the MAC copies the payload into its own buffer */
+    uint8_t ret = semtech_loramac_send(mac, mac->tx_buf, mac->tx_len);
+    if (ret == SEMTECH_LORAMAC_TX_SCHEDULE) {
+        mac->tx_len = 0;
+    }
+
+    return ret;
+}
+
+uint8_t semtech_loramac_queue(semtech_loramac_t *mac, const uint8_t *data, uint8_t len)
+{
+    if (!_is_mac_joined(mac)) {
+        DEBUG("[semtech-loramac] network is not joined\n");
+        return SEMTECH_LORAMAC_NOT_JOINED;
+    }
+
+    uint8_t max = _max_payload(mac);
+    uint8_t ret = SEMTECH_LORAMAC_TX_QUEUED;
+
+    if (len > max) {
+        DEBUG("[semtech-loramac] payload exceeds %u bytes\n", max);
+        return SEMTECH_LORAMAC_TX_ERROR;
+    }
+
+    if (mac->tx_len + len > max) {
+        DEBUG("[semtech-loramac] sending %u queued bytes\n", mac->tx_len);
+        ret = semtech_loramac_flush(mac);
+        if (ret != SEMTECH_LORAMAC_TX_SCHEDULE) {
+            return ret;
+        }
+    }
+
+    memcpy(&mac->tx_buf[mac->tx_len], data, len);
+    mac->tx_len += len;
+
+    return ret;
+}
+#endif
+
 uint8_t semtech_loramac_recv(semtech_loramac_t *mac)
 {
     mac->caller_pid = thread_getpid();
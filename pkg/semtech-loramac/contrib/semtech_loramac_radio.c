@@ -19,6 +19,9 @@
  * @}
  */
 
+#include <string.h>
+
+#include "irq.h"
 #include "net/lora.h"
 #include "net/netdev.h"
 
@@ -28,11 +31,53 @@
 
 #include "radio/radio.h"
 
+#include "semtech_loramac.h"
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 extern sx127x_t sx127x;
 
+static semtech_loramac_airtime_t _airtime[SEMTECH_LORAMAC_AIRTIME_NUMOF];
+
+static void _account_airtime(uint32_t freq, uint32_t airtime)
+{
+    unsigned state = irq_disable();
+
+    for (unsigned i = 0; i < SEMTECH_LORAMAC_AIRTIME_NUMOF; i++) {
+        if ((_airtime[i].frequency == freq) || (_airtime[i].count == 0)) {
+            _airtime[i].frequency = freq;
+            _airtime[i].airtime += airtime;
+            _airtime[i].count++;
+            break;
+        }
+    }
+    irq_restore(state);
+}
+
+unsigned semtech_loramac_get_airtime(semtech_loramac_airtime_t *stats, unsigned max)
+{
+    unsigned state = irq_disable();
+    unsigned num = 0;
+
+    while ((num < max) && (num < SEMTECH_LORAMAC_AIRTIME_NUMOF) &&
+           _airtime[num].count) {
+        stats[num] = _airtime[num];
+        num++;
+    }
+    irq_restore(state);
+
+    return num;
+}
+
+void semtech_loramac_reset_airtime(void)
+{
+    unsigned state = irq_disable();
+
+    memset(_airtime, 0, sizeof(_airtime));
+    irq_restore(state);
+}
+
 /*
  * Radio driver functions implementation wrappers, the netdev2 object
  * is known within the scope of the function
@@ -138,6 +183,8 @@ void SX127XSend(uint8_t *buffer, uint8_t size)
         .iol_base = buffer,
         .iol_len = size
     };
+    _account_airtime(sx127x_get_channel(&sx127x),
+                     sx127x_get_time_on_air(&sx127x, size));
     dev->driver->send(dev, &iol);
 }
 
@@ -223,7 +270,7 @@ void SX127XSetPublicNetwork(bool enable)
 
 uint32_t SX127XGetWakeupTime(void)
 {
-    return 0;
+    return SEMTECH_LORAMAC_RADIO_WAKEUP_TIME;
 }
 
 void SX127XIrqProcess(void)
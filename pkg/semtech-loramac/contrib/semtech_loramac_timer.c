@@ -22,6 +22,7 @@
 #include "xtimer.h"
 #include "thread.h"
 #include "semtech-loramac/timer.h"
+#include "semtech_loramac.h"
 
 extern kernel_pid_t semtech_loramac_pid;
 
@@ -62,10 +63,16 @@ void TimerSetValue(TimerEvent_t *obj, uint32_t value)
 
     /* According to the lorawan specifications, the data sent from the gateway
        could arrive with a short shift in time of +/- 20ms. Here the timeout is
-       triggered 50ms in advance to make sure the radio switches to RX mode on
-       time and doesn't miss any downlink messages, taking in consideration
-       possible xtimer inaccuracies. */
-    obj->timeout = (value - 50) * US_PER_MS;
+       triggered SEMTECH_LORAMAC_TIMER_MARGIN in advance to make sure the radio
+       switches to RX mode on time and doesn't miss any downlink messages,
+       taking in consideration possible xtimer inaccuracies. */
+    if (value > SEMTECH_LORAMAC_TIMER_MARGIN) {
+        value -= SEMTECH_LORAMAC_TIMER_MARGIN;
+    }
+    else {
+        value = 0;
+    }
+    obj->timeout = value * US_PER_MS;
 }
 
 TimerTime_t TimerGetCurrentTime(void)
@@ -52,6 +52,35 @@ extern "C" {
  */
 #define LORAWAN_APP_DATA_MAX_SIZE      (242U)
 
+/**
+ * @brief   Time the MAC timers expire in advance, in ms
+ *
+ * The data sent by the gateway may arrive with a shift of +/- 20ms, the
+ * timers are triggered this much in advance so that the radio is in RX mode
+ * on time, taking possible timer inaccuracies into account.
+ */
+#ifndef SEMTECH_LORAMAC_TIMER_MARGIN
+#define SEMTECH_LORAMAC_TIMER_MARGIN   (50U)
+#endif
+
+/**
+ * @brief   Time the radio needs to wake up from sleep, in ms
+ *
+ * The MAC opens the receive windows this much earlier, e.g. to compensate
+ * the start-up time of a TCXO or the wake-up time of the MCU from a low
+ * power mode.
+ */
+#ifndef SEMTECH_LORAMAC_RADIO_WAKEUP_TIME
+#define SEMTECH_LORAMAC_RADIO_WAKEUP_TIME   (0U)
+#endif
+
+/**
+ * @brief   Number of channels the time on air is accounted for
+ */
+#ifndef SEMTECH_LORAMAC_AIRTIME_NUMOF
+#define SEMTECH_LORAMAC_AIRTIME_NUMOF  (16U)
+#endif
+
 /**
  * @brief   LoRaMAC return status
  */
@@ -67,7 +96,8 @@ enum {
     SEMTECH_LORAMAC_TX_ERROR,                   /**< Error in TX (invalid param, unknown service) */
     SEMTECH_LORAMAC_DATA_RECEIVED,              /**< Data received */
     SEMTECH_LORAMAC_BUSY,                       /**< Internal MAC is busy */
-    SEMTECH_LORAMAC_DUTYCYCLE_RESTRICTED        /**< Restricted access to channels */
+    SEMTECH_LORAMAC_DUTYCYCLE_RESTRICTED,       /**< Restricted access to channels */
+    SEMTECH_LORAMAC_TX_QUEUED                   /**< Payload queued for the next TX */
 };
 
 /**
@@ -104,6 +134,15 @@ typedef struct {
     bool available;                              /**< new link check information avalable */
 } semtech_loramac_link_check_info_t;
 
+/**
+ * @brief   Time on air spent on a channel
+ */
+typedef struct {
+    uint32_t frequency;                          /**< channel center frequency */
+    uint32_t airtime;                            /**< time on air of all frames sent, in ms */
+    uint32_t count;                              /**< number of frames sent */
+} semtech_loramac_airtime_t;
+
 /**
  * @brief   Semtech LoRaMAC descriptor
  */
@@ -120,6 +159,10 @@ typedef struct {
     uint8_t devaddr[LORAMAC_DEVADDR_LEN];        /**< device address */
     semtech_loramac_rx_data_t rx_data;           /**< struct handling the RX data */
     semtech_loramac_link_check_info_t link_chk;  /**< link check information */
+#if defined(MODULE_SEMTECH_LORAMAC_AGGREGATE) || defined(DOXYGEN)
+    uint8_t tx_buf[LORAWAN_APP_DATA_MAX_SIZE];   /**< queued TX payloads */
+    uint8_t tx_len;                              /**< length of the queued TX payloads */
+#endif
 } semtech_loramac_t;
 
 /**
@@ -163,6 +206,61 @@ uint8_t semtech_loramac_join(semtech_loramac_t *mac, uint8_t type);
  */
 uint8_t semtech_loramac_send(semtech_loramac_t *mac, uint8_t *data, uint8_t len);
 
+#if defined(MODULE_SEMTECH_LORAMAC_AGGREGATE) || defined(DOXYGEN)
+/**
+ * @brief   Queues data to be sent with the next data in a single frame
+ *
+ * The payloads are concatenated until the next one does not fit into the
+ * maximum payload of the current datarate anymore, then the queued payloads
+ * are sent and @p data is queued for the next frame. The application must be
+ * able to split the received payload again, e.g. with payloads of fixed
+ * length.
+ *
+ * This saves the header, the time on air and the receive windows of a frame
+ * for every payload, at the price of the latency.
+ *
+ * @param[in] mac          Pointer to the mac
+ * @param[in] data         The TX data
+ * @param[in] len          The length of the TX data
+ *
+ * @return SEMTECH_LORAMAC_TX_QUEUED when the data is queued
+ * @return SEMTECH_LORAMAC_TX_SCHEDULE when the previously queued data are sent
+ *         and @p data is queued, wait for the result with semtech_loramac_recv()
+ * @return SEMTECH_LORAMAC_NOT_JOINED when the network is not joined
+ * @return SEMTECH_LORAMAC_TX_ERROR when @p len exceeds the maximum payload
+ */
+uint8_t semtech_loramac_queue(semtech_loramac_t *mac, const uint8_t *data, uint8_t len);
+
+/**
+ * @brief   Sends the queued data
+ *
+ * @param[in] mac          Pointer to the mac
+ *
+ * @return SEMTECH_LORAMAC_TX_SCHEDULE when the TX is scheduled in the mac
+ * @return SEMTECH_LORAMAC_TX_DONE when no data is queued
+ * @return SEMTECH_LORAMAC_NOT_JOINED when the network is not joined
+ */
+uint8_t semtech_loramac_flush(semtech_loramac_t *mac);
+#endif
+
+/**
+ * @brief   Gets the time on air spent on the channels used so far
+ *
+ * Together with the duty-cycle bands of the region, e.g. 1 % for the default
+ * channels of EU868, this tells how much of the allowed time on air is used.
+ *
+ * @param[out] stats       Time on air per channel
+ * @param[in] max          Number of entries in @p stats
+ *
+ * @return number of entries written to @p stats
+ */
+unsigned semtech_loramac_get_airtime(semtech_loramac_airtime_t *stats, unsigned max);
+
+/**
+ * @brief   Resets the time on air statistics
+ */
+void semtech_loramac_reset_airtime(void);
+
 /**
  * @brief   Wait for a message sent by the LoRaWAN network
  *
@@ -24,6 +24,9 @@
 #include <inttypes.h>
 
 #include "fs/spiffs_fs.h"
+#ifdef MODULE_FS_CHECKPOINT
+#include "fs/checkpoint.h"
+#endif
 
 #include "kernel_defines.h"
 
@@ -152,6 +155,56 @@ static int prepare(spiffs_desc_t *fs_desc)
     return mtd_init(dev);
 }
 
+#ifdef MODULE_FS_CHECKPOINT
+/* usage of a cleanly unmounted file system */
+typedef struct {
+    uint32_t total;
+    uint32_t used;
+} _checkpoint_t;
+
+static mtd_dev_t *_dev(spiffs_desc_t *fs_desc)
+{
+#if SPIFFS_HAL_CALLBACK_EXTRA == 1
+    return fs_desc->dev;
+#else
+    (void)fs_desc;
+    return SPIFFS_MTD_DEV;
+#endif
+}
+
+static void _checkpoint_save(spiffs_desc_t *fs_desc)
+{
+    _checkpoint_t cp;
+
+    if (!fs_desc->checkpoint ||
+        (SPIFFS_info(&fs_desc->fs, &cp.total, &cp.used) < 0)) {
+        return;
+    }
+    int ret = fs_checkpoint_save(_dev(fs_desc), fs_desc->checkpoint, &cp,
+                                 sizeof(cp));
+    DEBUG("spiffs: checkpoint saved: %d\n", ret);
+    (void)ret;
+}
+
+static void _checkpoint_check(spiffs_desc_t *fs_desc)
+{
+    _checkpoint_t cp;
+    uint32_t total;
+    uint32_t used;
+
+    fs_desc->clean = false;
+    if (!fs_desc->checkpoint ||
+        (fs_checkpoint_take(_dev(fs_desc), fs_desc->checkpoint, &cp,
+                            sizeof(cp)) < 0) ||
+        (SPIFFS_info(&fs_desc->fs, &total, &used) < 0)) {
+        return;
+    }
+    /* the mount scan must have found the file system as it was left */
+    fs_desc->clean = (cp.total == total) && (cp.used == used);
+    DEBUG("spiffs: clean: %d\n", fs_desc->clean);
+}
+#endif
+
 static int _format(vfs_mount_t *mountp)
 {
     spiffs_desc_t *fs_desc = mountp->private_data;
@@ -179,6 +232,11 @@ static int _format(vfs_mount_t *mountp)
         DEBUG("spiffs: format: unmount fs\n");
         SPIFFS_unmount(&fs_desc->fs);
     }
+#ifdef MODULE_FS_CHECKPOINT
+    if (fs_desc->checkpoint) {
+        fs_checkpoint_discard(_dev(fs_desc), fs_desc->checkpoint);
+    }
+#endif
     DEBUG("spiffs: format: formatting fs\n");
     ret = SPIFFS_format(&fs_desc->fs);
     DEBUG("spiffs: mount: format ret %" PRId32 "\n", ret);
@@ -208,6 +266,11 @@ static int _mount(vfs_mount_t *mountp)
 #endif
                              NULL);
 
+#ifdef MODULE_FS_CHECKPOINT
+    if (ret == SPIFFS_OK) {
+        _checkpoint_check(fs_desc);
+    }
+#endif
     return spiffs_err_to_errno(ret);
 }
 
@@ -215,9 +278,16 @@ static int _umount(vfs_mount_t *mountp)
 {
     spiffs_desc_t *fs_desc = mountp->private_data;
 
+#ifdef MODULE_FS_CHECKPOINT
+    _checkpoint_save(fs_desc);
+#endif
     SPIFFS_unmount(&fs_desc->fs);
 
-    return 0;
+#if SPIFFS_HAL_CALLBACK_EXTRA == 1
+    return mtd_flush(fs_desc->dev);
+#else
+    return mtd_flush(SPIFFS_MTD_DEV);
+#endif
 }
 
 static int _unlink(vfs_mount_t *mountp, const char *name)
@@ -23,6 +23,15 @@
  * control block should be initialized as the first thing before the stdlib is
  * used. Boards should use tlsf_add_global_pool() at startup to add all the memory
  * regions they want to make available for dynamic allocation via malloc().
+ * With `newlib_syscalls_default`, the heap region of the linker script is
+ * added on the first allocation if no pool was added before. The reentrant
+ * functions used inside of newlib, e.g. `_malloc_r()`, are replaced as well,
+ * so that newlib doesn't run its own allocator on top of `_sbrk_r()`.
+ *
+ * The module `tlsf-malloc_stats` counts the allocations of every thread and
+ * of the first @ref TLSF_MALLOC_CALLSITES_NUMOF callers of malloc() and
+ * friends, and computes the fragmentation of the heap, see
+ * tlsf_malloc_print_stats().
  *
  * @{
  * @file
@@ -38,11 +47,107 @@
 
 #include <stddef.h>
 #include "tlsf.h"
+#ifdef MODULE_TLSF_MALLOC_STATS
+#include "kernel_types.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if defined(MODULE_TLSF_MALLOC_STATS) || defined(DOXYGEN)
+/**
+ * @brief Number of callers of malloc() and friends that are counted
+ */
+#ifndef TLSF_MALLOC_CALLSITES_NUMOF
+#define TLSF_MALLOC_CALLSITES_NUMOF     (16U)
+#endif
+
+/**
+ * @brief Number of pools covered by tlsf_malloc_heap()
+ */
+#ifndef TLSF_MALLOC_POOLS_NUMOF
+#define TLSF_MALLOC_POOLS_NUMOF         (2U)
+#endif
+
+/**
+ * @brief Allocation counters of a thread
+ *
+ * realloc() counts as a free of the old and an allocation of the new block.
+ */
+typedef struct {
+    unsigned allocs;        /**< number of allocations */
+    unsigned frees;         /**< number of freed blocks */
+    unsigned failed;        /**< number of failed allocations */
+    size_t bytes;           /**< total number of bytes allocated */
+} tlsf_malloc_counter_t;
+
+/**
+ * @brief Allocation counters of a caller
+ */
+typedef struct {
+    const void *caller;     /**< return address of the call */
+    unsigned allocs;        /**< number of allocations */
+    size_t bytes;           /**< total number of bytes allocated */
+} tlsf_malloc_callsite_t;
+
+/**
+ * @brief State of the heap
+ */
+typedef struct {
+    size_t used;            /**< size of the used blocks */
+    size_t free;            /**< size of the free blocks */
+    size_t largest_free;    /**< size of the largest free block */
+    size_t peak;            /**< maximum size of the used blocks so far */
+    unsigned free_blocks;   /**< number of free blocks */
+} tlsf_malloc_heap_t;
+
+/**
+ * @brief Gets the state of the heap
+ *
+ * Walks the first @ref TLSF_MALLOC_POOLS_NUMOF pools with interrupts
+ * disabled, which takes time linear to the number of blocks.
+ *
+ * @param[out] heap     the state
+ */
+void tlsf_malloc_heap(tlsf_malloc_heap_t *heap);
+
+/**
+ * @brief Computes the fragmentation of the heap
+ *
+ * @param[in] heap      state of the heap
+ *
+ * @return  share of the free memory in percent that is not part of the
+ *          largest free block
+ */
+unsigned tlsf_malloc_fragmentation(const tlsf_malloc_heap_t *heap);
+
+/**
+ * @brief Gets the allocation counters of a thread
+ *
+ * @param[in] pid       the thread, KERNEL_PID_UNDEF for the allocations
+ *                      before the scheduler started
+ * @param[out] cnt      the counters
+ */
+void tlsf_malloc_thread_stats(kernel_pid_t pid, tlsf_malloc_counter_t *cnt);
+
+/**
+ * @brief Gets the allocation counters of a caller
+ *
+ * @param[in] idx       index of the caller, in the order of their first call
+ * @param[out] site     the counters
+ *
+ * @return  1 on success
+ * @return  0 if there is no caller with index @p idx
+ */
+int tlsf_malloc_callsite(unsigned idx, tlsf_malloc_callsite_t *site);
+
+/**
+ * @brief Prints the state of the heap and all counters
+ */
+void tlsf_malloc_print_stats(void);
+#endif
+
 /**
  * @brief Struct to hold the total sizes of free and used blocks
  * Used for @ref tlsf_size_walker()
@@ -18,18 +18,43 @@
  *
  */
 
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "irq.h"
 #include "tlsf.h"
 #include "tlsf-malloc.h"
+#ifdef MODULE_TLSF_MALLOC_STATS
+#include "thread.h"
+#endif
+#ifdef MODULE_NEWLIB
+#include <reent.h>
+#endif
 
 /**
  * Global memory heap (really a collection of pools, or areas)
  **/
 static tlsf_t gheap = NULL;
 
+#ifdef MODULE_NEWLIB_SYSCALLS_DEFAULT
+/* the heap region of the linker script, used if no pool was added before
+ * the first allocation */
+extern char _sheap;
+extern char _eheap;
+#endif
+
+#ifdef MODULE_TLSF_MALLOC_STATS
+/* index 0 counts the allocations before the scheduler runs */
+static tlsf_malloc_counter_t _threads[MAXTHREADS + 1];
+static tlsf_malloc_callsite_t _callsites[TLSF_MALLOC_CALLSITES_NUMOF];
+static unsigned _callsites_numof;
+static size_t _used;
+static size_t _peak;
+static pool_t _pools[TLSF_MALLOC_POOLS_NUMOF];
+static unsigned _pools_numof;
+#endif
+
 /* TODO: Add defines for other compilers */
 #if defined(__GNUC__) && !defined(__clang__)    /* Clang supports __GNUC__ but
                                                  * not the alloc_size()
@@ -49,15 +74,33 @@ static tlsf_t gheap = NULL;
 
 #endif /* __GNUC__ */
 
+#define CALLER  (__builtin_return_address(0))
+
 int tlsf_add_global_pool(void *mem, size_t bytes)
 {
+    pool_t pool;
+
     if (gheap == NULL) {
         gheap = tlsf_create_with_pool(mem, bytes);
-        return gheap == NULL;
+        if (gheap == NULL) {
+            return 1;
+        }
+        pool = tlsf_get_pool(gheap);
     }
     else {
-        return tlsf_add_pool(gheap, mem, bytes) == NULL;
+        pool = tlsf_add_pool(gheap, mem, bytes);
+        if (pool == NULL) {
+            return 1;
+        }
+    }
+#ifdef MODULE_TLSF_MALLOC_STATS
+    if (_pools_numof < TLSF_MALLOC_POOLS_NUMOF) {
+        _pools[_pools_numof++] = pool;
     }
+#else
+    (void)pool;
+#endif
+    return 0;
 }
 
 tlsf_t *_tlsf_get_global_control(void)
@@ -77,66 +120,308 @@ void tlsf_size_walker(void* ptr, size_t size, int used, void* user)
     }
 }
 
-/**
- * Allocate a block of size "bytes"
- */
-ATTR_MALLOC void *malloc(size_t bytes)
+/* must be called with interrupts disabled */
+static tlsf_t _heap(void)
+{
+#ifdef MODULE_NEWLIB_SYSCALLS_DEFAULT
+    if (gheap == NULL) {
+        /* TLSF needs the pool to be aligned to the size of a pointer */
+        uintptr_t start = ((uintptr_t)&_sheap + sizeof(void *) - 1) &
+                          ~(sizeof(void *) - 1);
+
+        tlsf_add_global_pool((void *)start, (uintptr_t)&_eheap - start);
+    }
+#endif
+    return gheap;
+}
+
+#ifdef MODULE_TLSF_MALLOC_STATS
+static tlsf_malloc_counter_t *_thread(void)
+{
+    kernel_pid_t pid = sched_active_pid;
+
+    return &_threads[pid_is_valid(pid) ? pid : 0];
+}
+
+/* must be called with interrupts disabled */
+static void _count_alloc(void *ptr, size_t bytes, const void *caller)
+{
+    tlsf_malloc_counter_t *thread = _thread();
+    tlsf_malloc_callsite_t *site = NULL;
+
+    if (ptr == NULL) {
+        thread->failed++;
+        return;
+    }
+    thread->allocs++;
+    thread->bytes += bytes;
+    _used += tlsf_block_size(ptr);
+    if (_used > _peak) {
+        _peak = _used;
+    }
+
+    for (unsigned i = 0; i < _callsites_numof; i++) {
+        if (_callsites[i].caller == caller) {
+            site = &_callsites[i];
+            break;
+        }
+    }
+    if ((site == NULL) && (_callsites_numof < TLSF_MALLOC_CALLSITES_NUMOF)) {
+        site = &_callsites[_callsites_numof++];
+        site->caller = caller;
+    }
+    if (site) {
+        site->allocs++;
+        site->bytes += bytes;
+    }
+}
+
+/* must be called with interrupts disabled */
+static void _count_free(void *ptr)
+{
+    if (ptr) {
+        _thread()->frees++;
+        _used -= tlsf_block_size(ptr);
+    }
+}
+
+/* must be called with interrupts disabled */
+static void _count_unfree(void *ptr)
+{
+    _thread()->frees--;
+    _used += tlsf_block_size(ptr);
+}
+#else
+#define _count_alloc(ptr, bytes, caller)    (void)(caller)
+#define _count_free(ptr)
+#define _count_unfree(ptr)
+#endif
+
+static void *_malloc(size_t bytes, const void *caller)
 {
     unsigned old_state = irq_disable();
-    void *result = tlsf_malloc(gheap, bytes);
+    void *result = tlsf_malloc(_heap(), bytes);
 
+    _count_alloc(result, bytes, caller);
     irq_restore(old_state);
     return result;
 }
 
-/**
- * Allocate and clear a block of size "bytes*count"
- */
-ATTR_CALLOC void *calloc(size_t count, size_t bytes)
+static void *_calloc(size_t count, size_t bytes, const void *caller)
 {
-    void *result = malloc(count * bytes);
+    size_t total;
+    void *result;
 
+    if (__builtin_mul_overflow(count, bytes, &total)) {
+        return NULL;
+    }
+    result = _malloc(total, caller);
     if (result) {
-        memset(result, 0, count * bytes);
+        memset(result, 0, total);
     }
     return result;
 }
 
-/**
- * Allocate an aligned memory block.
- */
-ATTR_MALIGN void *memalign(size_t align, size_t bytes)
+static void *_memalign(size_t align, size_t bytes, const void *caller)
 {
     unsigned old_state = irq_disable();
-    void *result = tlsf_memalign(gheap, align, bytes);
+    void *result = tlsf_memalign(_heap(), align, bytes);
 
+    _count_alloc(result, bytes, caller);
     irq_restore(old_state);
     return result;
 }
 
-/**
- * Deallocate and reallocate with a different size.
- */
-ATTR_REALLOC void *realloc(void *ptr, size_t size)
+static void *_realloc(void *ptr, size_t size, const void *caller)
 {
     unsigned old_state = irq_disable();
-    void *result = tlsf_realloc(gheap, ptr, size);
+    void *result;
 
+    /* counted as a free of the old and an allocation of the new block */
+    _count_free(ptr);
+    result = tlsf_realloc(_heap(), ptr, size);
+    if (size) {
+        _count_alloc(result, size, caller);
+        if (ptr && !result) {
+            /* the old block is kept */
+            _count_unfree(ptr);
+        }
+    }
     irq_restore(old_state);
     return result;
 }
 
+static void _free(void *ptr)
+{
+    unsigned old_state = irq_disable();
+
+    _count_free(ptr);
+    tlsf_free(gheap, ptr);
+    irq_restore(old_state);
+}
+
+/**
+ * Allocate a block of size "bytes"
+ */
+ATTR_MALLOC void *malloc(size_t bytes)
+{
+    return _malloc(bytes, CALLER);
+}
+
+/**
+ * Allocate and clear a block of size "bytes*count"
+ */
+ATTR_CALLOC void *calloc(size_t count, size_t bytes)
+{
+    return _calloc(count, bytes, CALLER);
+}
+
+/**
+ * Allocate an aligned memory block.
+ */
+ATTR_MALIGN void *memalign(size_t align, size_t bytes)
+{
+    return _memalign(align, bytes, CALLER);
+}
+
+/**
+ * Deallocate and reallocate with a different size.
+ */
+ATTR_REALLOC void *realloc(void *ptr, size_t size)
+{
+    return _realloc(ptr, size, CALLER);
+}
+
 
 /**
  * Deallocate a block of data.
  */
 void free(void *ptr)
+{
+    _free(ptr);
+}
+
+#ifdef MODULE_NEWLIB
+/* the reentrant versions used inside of newlib, e.g. by stdio, would
+ * otherwise use newlib's malloc on top of _sbrk_r() */
+void *_malloc_r(struct _reent *r, size_t bytes)
+{
+    (void)r;
+    return _malloc(bytes, CALLER);
+}
+
+void *_calloc_r(struct _reent *r, size_t count, size_t bytes)
+{
+    (void)r;
+    return _calloc(count, bytes, CALLER);
+}
+
+void *_memalign_r(struct _reent *r, size_t align, size_t bytes)
+{
+    (void)r;
+    return _memalign(align, bytes, CALLER);
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size)
+{
+    (void)r;
+    return _realloc(ptr, size, CALLER);
+}
+
+void _free_r(struct _reent *r, void *ptr)
+{
+    (void)r;
+    _free(ptr);
+}
+#endif
+
+#ifdef MODULE_TLSF_MALLOC_STATS
+static void _frag_walker(void *ptr, size_t size, int used, void *user)
+{
+    tlsf_malloc_heap_t *heap = user;
+
+    (void)ptr;
+    if (used) {
+        heap->used += size;
+    }
+    else {
+        heap->free += size;
+        heap->free_blocks++;
+        if (size > heap->largest_free) {
+            heap->largest_free = size;
+        }
+    }
+}
+
+void tlsf_malloc_heap(tlsf_malloc_heap_t *heap)
 {
     unsigned old_state = irq_disable();
 
-    tlsf_free(gheap, ptr);
+    memset(heap, 0, sizeof(*heap));
+    for (unsigned i = 0; i < _pools_numof; i++) {
+        tlsf_walk_pool(_pools[i], _frag_walker, heap);
+    }
+    heap->peak = _peak;
+    irq_restore(old_state);
+}
+
+void tlsf_malloc_thread_stats(kernel_pid_t pid, tlsf_malloc_counter_t *cnt)
+{
+    unsigned old_state = irq_disable();
+
+    *cnt = _threads[pid_is_valid(pid) ? pid : 0];
+    irq_restore(old_state);
+}
+
+int tlsf_malloc_callsite(unsigned idx, tlsf_malloc_callsite_t *site)
+{
+    unsigned old_state = irq_disable();
+    int res = 0;
+
+    if (idx < _callsites_numof) {
+        *site = _callsites[idx];
+        res = 1;
+    }
     irq_restore(old_state);
+    return res;
+}
+
+unsigned tlsf_malloc_fragmentation(const tlsf_malloc_heap_t *heap)
+{
+    if (heap->free == 0) {
+        return 0;
+    }
+    return 100 - (unsigned)(((uint64_t)heap->largest_free * 100) / heap->free);
+}
+
+void tlsf_malloc_print_stats(void)
+{
+    tlsf_malloc_heap_t heap;
+    tlsf_malloc_counter_t cnt;
+    tlsf_malloc_callsite_t site;
+
+    /* the counters are copied one by one, as printf may allocate */
+    tlsf_malloc_heap(&heap);
+    printf("heap: %u used, %u free in %u blocks, %u largest, %u peak, "
+           "fragmentation %u%%\n", (unsigned)heap.used, (unsigned)heap.free,
+           heap.free_blocks, (unsigned)heap.largest_free, (unsigned)heap.peak,
+           tlsf_malloc_fragmentation(&heap));
+
+    for (kernel_pid_t pid = 0; pid <= KERNEL_PID_LAST; pid++) {
+        tlsf_malloc_thread_stats(pid, &cnt);
+        if (cnt.allocs || cnt.frees || cnt.failed) {
+            printf("pid %2d: %u allocs (%u bytes), %u frees, %u failed\n",
+                   (int)pid, cnt.allocs, (unsigned)cnt.bytes, cnt.frees,
+                   cnt.failed);
+        }
+    }
+
+    for (unsigned i = 0; tlsf_malloc_callsite(i, &site); i++) {
+        printf("%p: %u allocs (%u bytes)\n", site.caller, site.allocs,
+               (unsigned)site.bytes);
+    }
 }
+#endif
 
 /**
  * @}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_u8g2
+ * @{
+ *
+ * @file
+ * @brief       Partial display updates for U8g2 full buffer displays
+ *
+ * Instead of sending the whole buffer with u8g2_SendBuffer(), only the tiles
+ * that were drawn on since the last update are sent:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * u8g2_riotos_dirty_t dirty = { 0 };
+ *
+ * u8g2_DrawStr(&u8g2, 0, 10, "23.5 C");
+ * u8g2_riotos_dirty_add(&dirty, 0, 0, 48, 10);
+ * u8g2_riotos_update(&u8g2, &dirty);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+
+#ifndef U8G2_RIOTOS_H
+#define U8G2_RIOTOS_H
+
+#include <stdint.h>
+
+#include "u8g2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Tiles of 8x8 pixels that changed since the last update
+ *
+ * Initialize with zeros, which is an empty region.
+ */
+typedef struct {
+    uint8_t x0;     /**< leftmost tile column */
+    uint8_t y0;     /**< topmost tile row */
+    uint8_t x1;     /**< column after the rightmost one, 0 if empty */
+    uint8_t y1;     /**< row after the lowest one */
+} u8g2_riotos_dirty_t;
+
+/**
+ * @brief   Adds a rectangle that was drawn on to the dirty region
+ *
+ * @param[in,out] dirty dirty region
+ * @param[in] x         left of the rectangle in pixels
+ * @param[in] y         top of the rectangle in pixels
+ * @param[in] w         width of the rectangle in pixels
+ * @param[in] h         height of the rectangle in pixels
+ */
+void u8g2_riotos_dirty_add(u8g2_riotos_dirty_t *dirty, u8g2_uint_t x,
+                           u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+
+/**
+ * @brief   Sends the tiles of the dirty region to the display and clears the
+ *          region
+ *
+ * Each row of tiles is a separate transfer, so a bus shared with other
+ * devices is not blocked for a whole frame.
+ *
+ * @pre     @p u8g2 was set up with a full buffer (the `_f` setup functions)
+ *          of a display with the vertical tile layout, e.g. SSD1306
+ *
+ * @param[in] u8g2      display
+ * @param[in,out] dirty dirty region
+ */
+void u8g2_riotos_update(u8g2_t *u8g2, u8g2_riotos_dirty_t *dirty);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* U8G2_RIOTOS_H */
+/** @} */
@@ -22,7 +22,9 @@
 #include <string.h>
 
 #include "u8g2.h"
+#include "u8g2_riotos.h"
 
+#include "mutex.h"
 #include "xtimer.h"
 #include "periph/spi.h"
 #include "periph/i2c.h"
@@ -111,15 +113,27 @@ uint8_t u8x8_gpio_and_delay_riotos(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, v
 }
 
 #ifdef SPI_NUMOF
+static void _spi_done(void *arg)
+{
+    mutex_unlock(arg);
+}
+
 uint8_t u8x8_byte_riotos_hw_spi(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
     spi_t dev = (spi_t) u8g2->dev;
 
     switch (msg) {
-        case U8X8_MSG_BYTE_SEND:
-            spi_transfer_bytes(dev, GPIO_UNDEF, true,
-                               arg_ptr, NULL, (size_t)arg_int);
+        case U8X8_MSG_BYTE_SEND: {
+            /* tiles are sent in the background where the platform supports
+             * it, the thread sleeps meanwhile */
+            mutex_t done = MUTEX_INIT_LOCKED;
+
+            spi_transfer_bytes_async(dev, GPIO_UNDEF, true,
+                                     arg_ptr, NULL, (size_t)arg_int,
+                                     _spi_done, &done);
+            mutex_lock(&done);
             break;
+        }
         case U8X8_MSG_BYTE_INIT:
             spi_init_pins(dev);
             break;
@@ -180,3 +194,58 @@ uint8_t u8x8_byte_riotos_hw_i2c(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, void
     return 1;
 }
 #endif /* I2C_NUMOF */
+
+void u8g2_riotos_dirty_add(u8g2_riotos_dirty_t *dirty, u8g2_uint_t x,
+                           u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+    uint8_t x0, y0, x1, y1;
+
+    if ((w == 0) || (h == 0)) {
+        return;
+    }
+
+    /* pixels to the tiles of 8x8 pixels that contain them */
+    x0 = x / 8;
+    y0 = y / 8;
+    x1 = (x + w + 7) / 8;
+    y1 = (y + h + 7) / 8;
+
+    if (dirty->x1 == 0) {
+        dirty->x0 = x0;
+        dirty->y0 = y0;
+        dirty->x1 = x1;
+        dirty->y1 = y1;
+        return;
+    }
+
+    if (x0 < dirty->x0) {
+        dirty->x0 = x0;
+    }
+    if (y0 < dirty->y0) {
+        dirty->y0 = y0;
+    }
+    if (x1 > dirty->x1) {
+        dirty->x1 = x1;
+    }
+    if (y1 > dirty->y1) {
+        dirty->y1 = y1;
+    }
+}
+
+void u8g2_riotos_update(u8g2_t *u8g2, u8g2_riotos_dirty_t *dirty)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+    uint8_t width = u8g2_GetBufferTileWidth(u8g2);
+    uint8_t height = u8g2->tile_buf_height;
+    uint8_t x1 = (dirty->x1 < width) ? dirty->x1 : width;
+    uint8_t y1 = (dirty->y1 < height) ? dirty->y1 : height;
+
+    for (uint8_t y = dirty->y0; (y < y1) && (dirty->x0 < x1); y++) {
+        uint8_t *tiles = u8g2_GetBufferPtr(u8g2) + (y * width + dirty->x0) * 8;
+
+        /* one transfer per row of tiles, the bus is released in between */
+        u8x8_DrawTile(u8x8, dirty->x0, y, x1 - dirty->x0, tiles);
+    }
+
+    memset(dirty, 0, sizeof(*dirty));
+}
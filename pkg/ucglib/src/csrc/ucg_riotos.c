@@ -20,6 +20,7 @@
 
 #include "ucg.h"
 
+#include "mutex.h"
 #include "xtimer.h"
 
 #include "periph/spi.h"
@@ -27,6 +28,15 @@
 #include "periph/gpio.h"
 
 #include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief   Size of the buffer to send repeated pixels in bulk, must be a
+ *          multiple of 6 for repeated sequences of 1, 2 and 3 bytes
+ */
+#ifndef UCG_RIOTOS_REPEAT_BUF_SIZE
+#define UCG_RIOTOS_REPEAT_BUF_SIZE  (48U)
+#endif
 
 #ifdef SPI_NUMOF
 static spi_clk_t ucg_serial_clk_speed_to_spi_speed(uint32_t serial_clk_speed)
@@ -67,6 +77,42 @@ static void ucg_enable_pins(gpio_t *pins, uint32_t pins_enabled)
 }
 
 #ifdef SPI_NUMOF
+static void _spi_done(void *arg)
+{
+    mutex_unlock(arg);
+}
+
+/* sends in the background where the platform supports it, the thread sleeps
+ * meanwhile */
+static void _spi_send(spi_t dev, const uint8_t *data, size_t len)
+{
+    mutex_t done = MUTEX_INIT_LOCKED;
+
+    spi_transfer_bytes_async(dev, GPIO_UNDEF, true, data, NULL, len,
+                             _spi_done, &done);
+    mutex_lock(&done);
+}
+
+/* sends a sequence of size bytes count times, with as few transfers as
+ * possible */
+static void _spi_repeat(spi_t dev, const uint8_t *seq, size_t size,
+                        uint16_t count)
+{
+    uint8_t buf[UCG_RIOTOS_REPEAT_BUF_SIZE];
+    size_t per_buf = sizeof(buf) / size;
+    size_t n = (count < per_buf) ? count : per_buf;
+
+    for (size_t i = 0; i < n; i++) {
+        memcpy(&buf[i * size], seq, size);
+    }
+
+    while (count) {
+        n = (count < per_buf) ? count : per_buf;
+        _spi_send(dev, buf, n * size);
+        count -= n;
+    }
+}
+
 int16_t ucg_com_riotos_hw_spi(ucg_t *ucg, int16_t msg, uint16_t arg, uint8_t *data)
 {
     spi_t dev = (spi_t) ucg->dev;
@@ -107,22 +153,16 @@ int16_t ucg_com_riotos_hw_spi(ucg_t *ucg, int16_t msg, uint16_t arg, uint8_t *da
             spi_transfer_byte(dev, GPIO_UNDEF, true, (uint8_t) arg);
             break;
         case UCG_COM_MSG_REPEAT_1_BYTE:
-            while (arg--) {
-                spi_transfer_byte(dev, GPIO_UNDEF, true, ((uint8_t *) data)[0]);
-            }
+            _spi_repeat(dev, data, 1, arg);
             break;
         case UCG_COM_MSG_REPEAT_2_BYTES:
-            while (arg--) {
-                spi_transfer_bytes(dev, GPIO_UNDEF, true, data, NULL, 2);
-            }
+            _spi_repeat(dev, data, 2, arg);
             break;
         case UCG_COM_MSG_REPEAT_3_BYTES:
-            while (arg--) {
-                spi_transfer_bytes(dev, GPIO_UNDEF, true, data, NULL, 3);
-            }
+            _spi_repeat(dev, data, 3, arg);
             break;
         case UCG_COM_MSG_SEND_STR:
-            spi_transfer_bytes(dev, GPIO_UNDEF, true, data, NULL, arg);
+            _spi_send(dev, data, arg);
             break;
         case UCG_COM_MSG_SEND_CD_DATA_SEQUENCE:
             while (arg--) {
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_wakaama
+ * @{
+ *
+ * @file
+ * @brief       Batching of resource changes
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+
+#include "lwm2m_notify.h"
+
+/* whether a change of @p b is reported by a change of @p a */
+static bool _covers(const lwm2m_uri_t *a, const lwm2m_uri_t *b)
+{
+    if (a->objectId != b->objectId) {
+        return false;
+    }
+    if (LWM2M_URI_IS_SET_INSTANCE(a) &&
+        (!LWM2M_URI_IS_SET_INSTANCE(b) || (a->instanceId != b->instanceId))) {
+        return false;
+    }
+    if (LWM2M_URI_IS_SET_RESOURCE(a) &&
+        (!LWM2M_URI_IS_SET_RESOURCE(b) || (a->resourceId != b->resourceId))) {
+        return false;
+    }
+    return true;
+}
+
+static void _report(lwm2m_notify_batch_t *batch, lwm2m_context_t *ctx)
+{
+    for (unsigned i = 0; i < batch->numof; i++) {
+        lwm2m_resource_value_changed(ctx, &batch->uris[i]);
+    }
+    batch->numof = 0;
+}
+
+void lwm2m_notify_batch_init(lwm2m_notify_batch_t *batch)
+{
+    batch->numof = 0;
+}
+
+void lwm2m_notify_changed(lwm2m_notify_batch_t *batch, lwm2m_context_t *ctx,
+                          const lwm2m_uri_t *uri)
+{
+    for (unsigned i = 0; i < batch->numof; i++) {
+        if (_covers(&batch->uris[i], uri)) {
+            return;
+        }
+    }
+    if (batch->numof == LWM2M_NOTIFY_BATCH_SIZE) {
+        _report(batch, ctx);
+    }
+    if (batch->numof == 0) {
+        batch->first = lwm2m_gettime();
+    }
+    batch->uris[batch->numof++] = *uri;
+}
+
+time_t lwm2m_notify_flush(lwm2m_notify_batch_t *batch, lwm2m_context_t *ctx)
+{
+    if (batch->numof == 0) {
+        return LWM2M_NOTIFY_BATCH_PERIOD;
+    }
+
+    time_t passed = lwm2m_gettime() - batch->first;
+
+    if (passed < LWM2M_NOTIFY_BATCH_PERIOD) {
+        return LWM2M_NOTIFY_BATCH_PERIOD - passed;
+    }
+    _report(batch, ctx);
+    /* Wakaama sends the notifications within this lwm2m_step() */
+    return 0;
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_wakaama
+ * @{
+ *
+ * @file
+ * @brief       SenML-CBOR serialization and SAUL-backed objects
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "fmt.h"
+#include "lwm2m_senml.h"
+
+/* "/65535/65535/" */
+#define BN_MAXLEN       (13U)
+/* "65535/65535/65535" */
+#define NAME_MAXLEN     (17U)
+
+static void _write(cbor_enc_t *enc, senml_rec_t *rec, char *name,
+                   size_t pos, const lwm2m_data_t *data)
+{
+    pos += fmt_u16_dec(&name[pos], data->id);
+
+    switch (data->type) {
+        case LWM2M_TYPE_OBJECT_INSTANCE:
+        case LWM2M_TYPE_MULTIPLE_RESOURCE:
+            name[pos++] = '/';
+            for (size_t i = 0; i < data->value.asChildren.count; i++) {
+                _write(enc, rec, name, pos,
+                       &data->value.asChildren.array[i]);
+            }
+            return;
+        case LWM2M_TYPE_STRING:
+        case LWM2M_TYPE_OPAQUE:
+        case LWM2M_TYPE_INTEGER:
+        case LWM2M_TYPE_FLOAT:
+        case LWM2M_TYPE_BOOLEAN:
+            break;
+        default:
+            return;
+    }
+
+    name[pos] = '\0';
+    rec->n = name;
+    switch (data->type) {
+        case LWM2M_TYPE_STRING:
+            senml_cbor_str(enc, rec, (const char *)data->value.asBuffer.buffer,
+                           data->value.asBuffer.length);
+            break;
+        case LWM2M_TYPE_OPAQUE:
+            senml_cbor_data(enc, rec, data->value.asBuffer.buffer,
+                            data->value.asBuffer.length);
+            break;
+        case LWM2M_TYPE_INTEGER:
+            senml_cbor_int(enc, rec, data->value.asInteger);
+            break;
+        case LWM2M_TYPE_FLOAT:
+            senml_cbor_float(enc, rec, (float)data->value.asFloat);
+            break;
+        default:
+            senml_cbor_bool(enc, rec, data->value.asBoolean);
+            break;
+    }
+    /* the base name applies to all following records */
+    rec->bn = NULL;
+}
+
+ssize_t lwm2m_senml_cbor(const lwm2m_uri_t *uri, const lwm2m_data_t *data,
+                         int numof, uint8_t *buf, size_t len)
+{
+    char bn[BN_MAXLEN + 1];
+    char name[NAME_MAXLEN + 1];
+    size_t pos = 0;
+    cbor_enc_t enc;
+    senml_rec_t rec = { .bn = bn };
+
+    /* the base name is the path down to the instance, if given */
+    bn[pos++] = '/';
+    pos += fmt_u16_dec(&bn[pos], uri->objectId);
+    bn[pos++] = '/';
+    if (LWM2M_URI_IS_SET_INSTANCE(uri)) {
+        pos += fmt_u16_dec(&bn[pos], uri->instanceId);
+        bn[pos++] = '/';
+    }
+    bn[pos] = '\0';
+
+    cbor_enc_init(&enc, buf, len);
+    cbor_enc_array_indef(&enc);
+    for (int i = 0; i < numof; i++) {
+        _write(&enc, &rec, name, 0, &data[i]);
+    }
+    cbor_enc_break(&enc);
+    return cbor_enc_len(&enc);
+}
+
+static double _value(const phydat_t *res, unsigned i)
+{
+    double val = res->val[i];
+
+    for (int8_t scale = res->scale; scale > 0; scale--) {
+        val *= 10;
+    }
+    for (int8_t scale = res->scale; scale < 0; scale++) {
+        val /= 10;
+    }
+    return val;
+}
+
+static bool _set(lwm2m_data_t *data, const phydat_t *res, int dim)
+{
+    const char *unit;
+
+    switch (data->id) {
+        case LWM2M_SAUL_RES_VALUE:
+            if (dim != 1) {
+                return false;
+            }
+            lwm2m_data_encode_float(_value(res, 0), data);
+            return true;
+        case LWM2M_SAUL_RES_X:
+        case LWM2M_SAUL_RES_Y:
+        case LWM2M_SAUL_RES_Z:
+            if (dim != 3) {
+                return false;
+            }
+            lwm2m_data_encode_float(_value(res, data->id - LWM2M_SAUL_RES_X),
+                                    data);
+            return true;
+        case LWM2M_SAUL_RES_UNITS:
+            unit = senml_unit(res->unit);
+            lwm2m_data_encode_string(unit ? unit
+                                          : phydat_unit_to_str(res->unit),
+                                     data);
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint8_t lwm2m_saul_read(saul_reg_t *dev, int *numof, lwm2m_data_t **data)
+{
+    phydat_t res;
+    int dim = saul_reg_read(dev, &res);
+
+    if (dim <= 0) {
+        return COAP_500_INTERNAL_SERVER_ERROR;
+    }
+
+    if (*numof == 0) {
+        static const uint16_t ids_1[] = {
+            LWM2M_SAUL_RES_VALUE, LWM2M_SAUL_RES_UNITS
+        };
+        static const uint16_t ids_3[] = {
+            LWM2M_SAUL_RES_X, LWM2M_SAUL_RES_Y, LWM2M_SAUL_RES_Z,
+            LWM2M_SAUL_RES_UNITS
+        };
+        const uint16_t *ids = (dim == 3) ? ids_3 : ids_1;
+
+        *numof = (dim == 3) ? 4 : 2;
+        *data = lwm2m_data_new(*numof);
+        if (*data == NULL) {
+            return COAP_500_INTERNAL_SERVER_ERROR;
+        }
+        for (int i = 0; i < *numof; i++) {
+            (*data)[i].id = ids[i];
+        }
+    }
+
+    /* all resources share the one reading */
+    for (int i = 0; i < *numof; i++) {
+        if (!_set(&(*data)[i], &res, dim)) {
+            return COAP_404_NOT_FOUND;
+        }
+    }
+    return COAP_205_CONTENT;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_wakaama
+ * @brief       Batching of resource changes into few notifications
+ * @{
+ *
+ * Reporting each change with lwm2m_resource_value_changed() right away
+ * makes Wakaama send the notification of an observed object instance as
+ * soon as the minimum period (pmin) of the observation passed, so changes
+ * of different resources end up in different notifications, each waking up
+ * the radio. The `wakaama_contrib` module collects the changes instead and
+ * reports them together every @ref LWM2M_NOTIFY_BATCH_PERIOD seconds, so
+ * Wakaama sends all notifications of an instance, and of all instances
+ * that changed meanwhile, in the same lwm2m_step(). Wakaama still enforces
+ * pmin and pmax of each observation.
+ *
+ *     lwm2m_notify_changed(&batch, ctx, &uri);
+ *     ...
+ *     time_t timeout = lwm2m_notify_flush(&batch, ctx);
+ *     lwm2m_step(ctx, &timeout);
+ *
+ * @file
+ * @brief       Batching of resource changes
+ */
+
+#ifndef LWM2M_NOTIFY_H
+#define LWM2M_NOTIFY_H
+
+#include <stdint.h>
+#include <time.h>
+
+#include "liblwm2m.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of changed URIs a batch holds
+ *
+ * A full batch is reported right away.
+ */
+#ifndef LWM2M_NOTIFY_BATCH_SIZE
+#define LWM2M_NOTIFY_BATCH_SIZE     (8U)
+#endif
+
+/**
+ * @brief   Period in seconds after which changes are reported
+ *
+ * Should not exceed the pmin the server sets for the observations.
+ */
+#ifndef LWM2M_NOTIFY_BATCH_PERIOD
+#define LWM2M_NOTIFY_BATCH_PERIOD   (10)
+#endif
+
+/**
+ * @brief   Changes not reported yet
+ */
+typedef struct {
+    lwm2m_uri_t uris[LWM2M_NOTIFY_BATCH_SIZE];  /**< changed URIs */
+    uint8_t numof;                              /**< number of changed URIs */
+    time_t first;                               /**< time of the first
+                                                 *   change, see
+                                                 *   lwm2m_gettime() */
+} lwm2m_notify_batch_t;
+
+/**
+ * @brief   Initializes a batch
+ *
+ * @param[out] batch    batch to initialize
+ */
+void lwm2m_notify_batch_init(lwm2m_notify_batch_t *batch);
+
+/**
+ * @brief   Adds a change to a batch
+ *
+ * Instead of lwm2m_resource_value_changed(). A change of a URI already
+ * covered by the batch, e.g. of a resource of an instance that changed as
+ * a whole, is not added again.
+ *
+ * @param[in,out] batch     batch to add to
+ * @param[in]     ctx       LwM2M context, the batch is reported if full
+ * @param[in]     uri       URI that changed
+ */
+void lwm2m_notify_changed(lwm2m_notify_batch_t *batch, lwm2m_context_t *ctx,
+                          const lwm2m_uri_t *uri);
+
+/**
+ * @brief   Reports the changes of a batch, if its period passed
+ *
+ * Call this before each lwm2m_step().
+ *
+ * @param[in,out] batch     batch to report
+ * @param[in]     ctx       LwM2M context
+ *
+ * @return  seconds until the batch is to be reported, to be passed as
+ *          timeout to lwm2m_step()
+ */
+time_t lwm2m_notify_flush(lwm2m_notify_batch_t *batch, lwm2m_context_t *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWM2M_NOTIFY_H */
+/** @} */
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_wakaama
+ * @brief       SenML-CBOR serialization and SAUL-backed objects for Wakaama
+ * @{
+ *
+ * The `wakaama_contrib` module serializes the data of a read or a
+ * notification as SenML-CBOR (@ref sys_senml), which for numeric sensor
+ * resources is about half the size of TLV and of plain text for more than
+ * one resource. As in LwM2M 1.1, the base name is the path of the object
+ * instance and each record's name the path below it, e.g. `/3303/0/` and
+ * `5700`.
+ *
+ * lwm2m_saul_read() implements the read callback of an IPSO sensor object
+ * instance backed by a SAUL device: all requested resources come from a
+ * single reading of the device.
+ *
+ * @file
+ * @brief       SenML-CBOR serialization and SAUL-backed objects
+ */
+
+#ifndef LWM2M_SENML_H
+#define LWM2M_SENML_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "liblwm2m.h"
+#include "saul_reg.h"
+#include "senml.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   LwM2M content format of SenML-CBOR
+ */
+#define LWM2M_CONTENT_SENML_CBOR    (SENML_CBOR_CONTENT_FORMAT)
+
+/**
+ * @name    IPSO resources lwm2m_saul_read() provides
+ * @{
+ */
+#define LWM2M_SAUL_RES_VALUE        (5700U) /**< sensor value, 1 dimension */
+#define LWM2M_SAUL_RES_UNITS        (5701U) /**< sensor units */
+#define LWM2M_SAUL_RES_X            (5702U) /**< x value, 3 dimensions */
+#define LWM2M_SAUL_RES_Y            (5703U) /**< y value, 3 dimensions */
+#define LWM2M_SAUL_RES_Z            (5704U) /**< z value, 3 dimensions */
+/** @} */
+
+/**
+ * @brief   Serializes data as SenML-CBOR
+ *
+ * Object links are not supported and skipped.
+ *
+ * @param[in]  uri      URI the data was read from
+ * @param[in]  data     the data, as given by the read callbacks
+ * @param[in]  numof    number of elements in @p data
+ * @param[out] buf      buffer to write to
+ * @param[in]  len      size of @p buf
+ *
+ * @return  length of the serialization
+ * @return  -ENOBUFS if @p buf is too small
+ */
+ssize_t lwm2m_senml_cbor(const lwm2m_uri_t *uri, const lwm2m_data_t *data,
+                         int numof, uint8_t *buf, size_t len);
+
+/**
+ * @brief   Read callback of an IPSO sensor object instance backed by a
+ *          SAUL device
+ *
+ * Call this from the read callback of the object with the device of the
+ * instance. The device is read once for all requested resources. Devices
+ * of one dimension provide @ref LWM2M_SAUL_RES_VALUE, of three dimensions
+ * @ref LWM2M_SAUL_RES_X to @ref LWM2M_SAUL_RES_Z, all devices
+ * @ref LWM2M_SAUL_RES_UNITS.
+ *
+ * @param[in]     dev       device of the instance
+ * @param[in,out] numof     number of requested resources, 0 for all
+ * @param[in,out] data      requested resources, allocated if @p numof is 0
+ *
+ * @return  COAP_205_CONTENT on success
+ * @return  COAP_404_NOT_FOUND if the device does not provide a requested
+ *          resource
+ * @return  COAP_500_INTERNAL_SERVER_ERROR if reading the device failed or
+ *          out of memory
+ */
+uint8_t lwm2m_saul_read(saul_reg_t *dev, int *numof, lwm2m_data_t **data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWM2M_SENML_H */
+/** @} */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_arena
+ * @{
+ *
+ * @file
+ * @brief       Arena allocator implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "arena.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if (ARENA_ALIGN & (ARENA_ALIGN - 1))
+#error "ARENA_ALIGN must be a power of two"
+#endif
+
+#define ALIGN_UP(x)     (((x) + (ARENA_ALIGN - 1)) & ~((uintptr_t)ARENA_ALIGN - 1))
+/* the objects of a block start behind its header */
+#define CHUNK_HDR_SIZE  ALIGN_UP(sizeof(arena_chunk_t))
+
+void arena_init(arena_t *arena, void *buf, size_t size, memarray_t *blocks)
+{
+    assert(((uintptr_t)buf % ARENA_ALIGN) == 0);
+    assert(!blocks || (blocks->size > CHUNK_HDR_SIZE));
+
+    arena->buf = buf;
+    arena->buf_end = (buf) ? arena->buf + size : NULL;
+    arena->blocks = blocks;
+    arena->chunk = NULL;
+    arena_reset(arena);
+}
+
+static int _take_block(arena_t *arena, size_t size)
+{
+    arena_chunk_t *chunk;
+
+    if (!arena->blocks || (size > (arena->blocks->size - CHUNK_HDR_SIZE))) {
+        return -1;
+    }
+    chunk = memarray_alloc(arena->blocks);
+    if (chunk == NULL) {
+        return -1;
+    }
+    DEBUG("arena: take block %p\n", (void *)chunk);
+    chunk->next = arena->chunk;
+    arena->chunk = chunk;
+    arena->pos = (uint8_t *)chunk + CHUNK_HDR_SIZE;
+    arena->end = (uint8_t *)chunk + arena->blocks->size;
+    return 0;
+}
+
+void *arena_alloc(arena_t *arena, size_t size)
+{
+    uintptr_t pos = ALIGN_UP((uintptr_t)arena->pos);
+    void *res;
+
+    /* also catches pos being aligned beyond the end */
+    if ((pos > (uintptr_t)arena->end) ||
+        (size > ((uintptr_t)arena->end - pos))) {
+        if (_take_block(arena, size) < 0) {
+            return NULL;
+        }
+        pos = (uintptr_t)arena->pos;
+    }
+    res = (void *)pos;
+    arena->pos = (uint8_t *)(pos + size);
+    return res;
+}
+
+void *arena_calloc(size_t count, size_t size, void *arena)
+{
+    size_t total = count * size;
+    void *res;
+
+    if (count && ((total / count) != size)) {
+        return NULL;
+    }
+    res = arena_alloc(arena, total);
+    if (res) {
+        memset(res, 0, total);
+    }
+    return res;
+}
+
+void arena_nofree(void *ptr, void *arena)
+{
+    (void)ptr;
+    (void)arena;
+}
+
+void arena_reset_to(arena_t *arena, arena_mark_t mark)
+{
+    while (arena->chunk != mark.chunk) {
+        arena_chunk_t *chunk = arena->chunk;
+
+        assert(chunk != NULL);
+        arena->chunk = chunk->next;
+        DEBUG("arena: give back block %p\n", (void *)chunk);
+        memarray_free(arena->blocks, chunk);
+    }
+    arena->pos = mark.pos;
+    arena->end = (arena->chunk) ? (uint8_t *)arena->chunk + arena->blocks->size
+                                : arena->buf_end;
+}
@@ -15,11 +15,17 @@
  * @author  Hauke Petersen <hauke.petersen@fu-berlin.de>
  * @}
  */
+#include <inttypes.h>
 #include <stdint.h>
 #include <stdio.h>
 
 #include "auto_init.h"
 
+#ifdef MODULE_AUTO_INIT_DEFERRED
+#include "mutex.h"
+#include "thread.h"
+#endif
+
 #ifdef MODULE_MCI
 #include "diskio.h"
 #endif
@@ -28,10 +34,34 @@
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_STACK_WATERMARK
+#include "stack_watermark.h"
+#endif
+
+#ifdef MODULE_TRACING
+#include "tracing.h"
+#endif
+
+#ifdef MODULE_STDIO_UART_TX_ASYNC
+#include "stdio_uart.h"
+#endif
+
+#ifdef MODULE_PROFILER
+#include "profiler.h"
+#endif
+
+#ifdef MODULE_EVENT_WORKQ
+#include "event/workq.h"
+#endif
+
 #ifdef MODULE_GNRC_SIXLOWPAN
 #include "net/gnrc/sixlowpan.h"
 #endif
 
+#ifdef MODULE_GNRC_MPL
+#include "net/gnrc/mpl.h"
+#endif
+
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
 #endif
@@ -91,24 +121,23 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
-void auto_init(void)
+/* runs one group of initializations, timing it with auto_init_timing */
+static void _run(const char *name, void (*init)(void))
 {
-#ifdef MODULE_PRNG
-    void auto_init_random(void);
-    auto_init_random();
-#endif
-#ifdef MODULE_XTIMER
-    DEBUG("Auto init xtimer module.\n");
-    xtimer_init();
-#endif
-#ifdef MODULE_MCI
-    DEBUG("Auto init mci module.\n");
-    mci_initialize();
-#endif
-#ifdef MODULE_PROFILING
-    extern void profiling_init(void);
-    profiling_init();
+#ifdef MODULE_AUTO_INIT_TIMING
+    uint32_t start = xtimer_now_usec();
+
+    init();
+    printf("auto_init: %s took %" PRIu32 " us\n", name,
+           xtimer_now_usec() - start);
+#else
+    (void)name;
+    init();
 #endif
+}
+
+static void _auto_init_net(void)
+{
 #ifdef MODULE_GNRC_PKTBUF
     DEBUG("Auto init gnrc_pktbuf module\n");
     gnrc_pktbuf_init();
@@ -182,7 +211,10 @@ void auto_init(void)
     extern void nimble_riot_init(void);
     nimble_riot_init();
 #endif
+}
 
+static void _auto_init_netif(void)
+{
 /* initialize network devices */
 #ifdef MODULE_AUTO_INIT_GNRC_NETIF
 
@@ -266,11 +298,21 @@ void auto_init(void)
     auto_init_socket_zep();
 #endif
 
+#ifdef MODULE_SHM_RADIO
+    extern void auto_init_shm_radio(void);
+    auto_init_shm_radio();
+#endif
+
 #ifdef MODULE_NORDIC_SOFTDEVICE_BLE
     extern void gnrc_nordic_ble_6lowpan_init(void);
     gnrc_nordic_ble_6lowpan_init();
 #endif
 
+#ifdef MODULE_NIMBLE_NETIF
+    extern void nimble_netif_init(void);
+    nimble_netif_init();
+#endif
+
 #ifdef MODULE_NRFMIN
     extern void gnrc_nrfmin_init(void);
     gnrc_nrfmin_init();
@@ -288,6 +330,11 @@ void auto_init(void)
 
 #endif /* MODULE_AUTO_INIT_GNRC_NETIF */
 
+#ifdef MODULE_GNRC_MPL
+    /* joins the MPL domains on the interfaces initialized above */
+    gnrc_mpl_init();
+#endif
+
 #ifdef MODULE_GNRC_UHCPC
     extern void auto_init_gnrc_uhcpc(void);
     auto_init_gnrc_uhcpc();
@@ -298,18 +345,22 @@ void auto_init(void)
     DEBUG("Auto init NDN module.\n");
     ndn_init();
 #endif
+}
 
-/* initialize sensors and actuators */
-#ifdef MODULE_SHT1X
-    /* The sht1x module needs to be initialized regardless of SAUL being used,
-     * as the shell commands rely on auto-initialization. auto_init_sht1x also
-     * performs SAUL registration, but only if module auto_init_saul is used.
-     */
-    DEBUG("Auto init SHT1X module (SHT10/SHT11/SHT15 sensor driver).\n");
-    extern void auto_init_sht1x(void);
-    auto_init_sht1x();
+static void _auto_init_rpl(void)
+{
+#ifdef MODULE_AUTO_INIT_GNRC_RPL
+
+#ifdef MODULE_GNRC_RPL
+    extern void auto_init_gnrc_rpl(void);
+    auto_init_gnrc_rpl();
 #endif
 
+#endif /* MODULE_AUTO_INIT_GNRC_RPL */
+}
+
+static void _auto_init_saul(void)
+{
 #ifdef MODULE_AUTO_INIT_SAUL
     DEBUG("auto_init SAUL\n");
 
@@ -476,16 +527,10 @@ void auto_init(void)
 #endif
 
 #endif /* MODULE_AUTO_INIT_SAUL */
+}
 
-#ifdef MODULE_AUTO_INIT_GNRC_RPL
-
-#ifdef MODULE_GNRC_RPL
-    extern void auto_init_gnrc_rpl(void);
-    auto_init_gnrc_rpl();
-#endif
-
-#endif /* MODULE_AUTO_INIT_GNRC_RPL */
-
+static void _auto_init_storage(void)
+{
 /* initialize storage devices */
 #ifdef MODULE_AUTO_INIT_STORAGE
     DEBUG("auto_init STORAGE\n");
@@ -496,7 +541,10 @@ void auto_init(void)
 #endif
 
 #endif /* MODULE_AUTO_INIT_STORAGE */
+}
 
+static void _auto_init_can(void)
+{
 #ifdef MODULE_AUTO_INIT_CAN
     DEBUG("auto_init CAN\n");
 
@@ -505,3 +553,102 @@ void auto_init(void)
 
 #endif /* MODULE_AUTO_INIT_CAN */
 }
+
+/* initializes the drivers nothing else in auto_init depends on */
+static void _auto_init_late(void)
+{
+    _run("saul", _auto_init_saul);
+    _run("storage", _auto_init_storage);
+    _run("can", _auto_init_can);
+}
+
+#ifdef MODULE_AUTO_INIT_DEFERRED
+static char _deferred_stack[AUTO_INIT_DEFERRED_STACKSIZE];
+static mutex_t _deferred_done = MUTEX_INIT_LOCKED;
+
+static void *_deferred(void *arg)
+{
+    (void)arg;
+    _auto_init_late();
+    mutex_unlock(&_deferred_done);
+    return NULL;
+}
+
+void auto_init_wait(void)
+{
+    mutex_lock(&_deferred_done);
+    mutex_unlock(&_deferred_done);
+}
+#endif
+
+void auto_init(void)
+{
+#ifdef MODULE_PRNG
+    void auto_init_random(void);
+    auto_init_random();
+#endif
+#ifdef MODULE_XTIMER
+    DEBUG("Auto init xtimer module.\n");
+    xtimer_init();
+#endif
+#ifdef MODULE_XTIMER_TICKLESS
+    DEBUG("Auto init xtimer_tickless module.\n");
+    xtimer_tickless_init();
+#endif
+#ifdef MODULE_MCI
+    DEBUG("Auto init mci module.\n");
+    mci_initialize();
+#endif
+#ifdef MODULE_PROFILING
+    extern void profiling_init(void);
+    profiling_init();
+#endif
+#ifdef MODULE_TRACING
+    DEBUG("Auto init tracing module.\n");
+    tracing_init();
+#endif
+#ifdef MODULE_STDIO_UART_TX_ASYNC
+    DEBUG("Auto init stdio_uart_tx_async module.\n");
+    stdio_uart_tx_init();
+#endif
+#ifdef MODULE_LOG_BINARY
+    DEBUG("Auto init log_binary module.\n");
+    extern void log_binary_init(void);
+    log_binary_init();
+#endif
+#ifdef MODULE_PROFILER
+    DEBUG("Auto init profiler module.\n");
+    profiler_init();
+#endif
+#ifdef MODULE_STACK_WATERMARK
+    DEBUG("Auto init stack_watermark module.\n");
+    stack_watermark_init();
+#endif
+#ifdef MODULE_EVENT_WORKQ
+    DEBUG("Auto init event_workq module.\n");
+    event_workq_init();
+#endif
+
+    _run("net", _auto_init_net);
+    _run("netif", _auto_init_netif);
+    _run("rpl", _auto_init_rpl);
+
+/* initialize sensors and actuators */
+#ifdef MODULE_SHT1X
+    /* The sht1x module needs to be initialized regardless of SAUL being used,
+     * as the shell commands rely on auto-initialization. auto_init_sht1x also
+     * performs SAUL registration, but only if module auto_init_saul is used.
+     */
+    DEBUG("Auto init SHT1X module (SHT10/SHT11/SHT15 sensor driver).\n");
+    extern void auto_init_sht1x(void);
+    auto_init_sht1x();
+#endif
+
+#ifdef MODULE_AUTO_INIT_DEFERRED
+    thread_create(_deferred_stack, sizeof(_deferred_stack),
+                  AUTO_INIT_DEFERRED_PRIO, THREAD_CREATE_STACKTEST,
+                  _deferred, NULL, "auto_init");
+#else
+    _auto_init_late();
+#endif
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ */
+
+/**
+ * @ingroup sys_auto_init_gnrc_netif
+ * @{
+ *
+ * @file
+ * @brief   Auto initialization for @ref drivers_shm_radio devices
+ */
+
+#ifdef MODULE_SHM_RADIO
+
+#include "log.h"
+#include "shm_radio.h"
+#include "shm_radio_params.h"
+#include "net/gnrc/netif/ieee802154.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief   Define stack parameters for the MAC layer thread
+ */
+#define SHM_RADIO_MAC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
+#ifndef SHM_RADIO_MAC_PRIO
+#define SHM_RADIO_MAC_PRIO          (GNRC_NETIF_PRIO)
+#endif
+
+/**
+ * @brief   Stack for the MAC layer thread
+ */
+static char _shm_radio_stack[SHM_RADIO_MAC_STACKSIZE];
+static shm_radio_t _shm_radio;
+
+void auto_init_shm_radio(void)
+{
+    LOG_DEBUG("[auto_init_netif] initializing shm_radio on %s\n",
+              shm_radio_params.path);
+    shm_radio_setup(&_shm_radio, &shm_radio_params);
+    gnrc_netif_ieee802154_create(_shm_radio_stack, SHM_RADIO_MAC_STACKSIZE,
+                                 SHM_RADIO_MAC_PRIO, "shm_radio",
+                                 (netdev_t *)&_shm_radio);
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_SHM_RADIO */
+/** @} */
@@ -18,9 +18,196 @@
  * @}
  */
 
+#include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
 
 #include "benchmark.h"
+#include "cpu.h"
+#include "irq.h"
+#include "matstat.h"
+#include "xtimer.h"
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+#define _HAS_CYCCNT     (1)
+#else
+#define _HAS_CYCCNT     (0)
+#endif
+
+#if _HAS_CYCCNT
+static bool _cyccnt_init(void)
+{
+    static int _avail = -1;
+
+    if (_avail < 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        /* some implementations of the DWT unit come without cycle counter */
+        _avail = !(DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk);
+        if (_avail) {
+            DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        }
+    }
+    return _avail;
+}
+
+static inline uint32_t _now(bool cycles)
+{
+    return (cycles) ? DWT->CYCCNT : xtimer_now_usec();
+}
+#else
+static inline bool _cyccnt_init(void)
+{
+    return false;
+}
+
+static inline uint32_t _now(bool cycles)
+{
+    (void)cycles;
+    return xtimer_now_usec();
+}
+#endif
+
+static uint32_t _isqrt(uint64_t val)
+{
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > val) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (val >= res + bit) {
+            val -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+static void _sort(uint32_t *samples, unsigned numof)
+{
+    /* insertion sort, numof is small */
+    for (unsigned i = 1; i < numof; i++) {
+        uint32_t tmp = samples[i];
+        unsigned j = i;
+
+        for (; (j > 0) && (samples[j - 1] > tmp); j--) {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = tmp;
+    }
+}
+
+/* prints time per call with three decimal places */
+static void _print_per_call(const char *sep, int width, uint32_t time,
+                            unsigned long runs)
+{
+    uint32_t full = time / runs;
+    uint32_t frac = (uint32_t)((((uint64_t)(time - (full * runs))) * 1000) /
+                               runs);
+
+    printf("%s%*" PRIu32 ".%03" PRIu32, sep, width, full, frac);
+}
+
+const char *benchmark_unit(void)
+{
+    return (_cyccnt_init()) ? "cycles" : "us";
+}
+
+void benchmark_run(const benchmark_case_t *bench, benchmark_result_t *res)
+{
+    uint32_t samples[BENCHMARK_SAMPLES];
+    matstat_state_t stat = MATSTAT_STATE_INIT;
+    bool cycles = _cyccnt_init();
+
+    for (unsigned i = 0; i < (BENCHMARK_WARMUP + BENCHMARK_SAMPLES); i++) {
+        /* xtimer needs its interrupt to extend 16 bit timers, so only the
+         * cycle counter is read with interrupts disabled */
+        unsigned irqstate = (cycles) ? irq_disable() : 0;
+        uint32_t time = _now(cycles);
+
+        bench->func(bench->runs);
+        time = _now(cycles) - time;
+        if (cycles) {
+            irq_restore(irqstate);
+        }
+        if (i >= BENCHMARK_WARMUP) {
+            samples[i - BENCHMARK_WARMUP] = time;
+            matstat_add(&stat, (int32_t)time);
+        }
+    }
+    _sort(samples, BENCHMARK_SAMPLES);
+    res->min = samples[0];
+    res->max = samples[BENCHMARK_SAMPLES - 1];
+    res->mean = matstat_mean(&stat);
+    if (BENCHMARK_SAMPLES & 1) {
+        res->median = samples[BENCHMARK_SAMPLES / 2];
+    }
+    else {
+        res->median = (samples[(BENCHMARK_SAMPLES / 2) - 1] +
+                       samples[BENCHMARK_SAMPLES / 2]) / 2;
+    }
+    res->stddev = _isqrt(matstat_variance(&stat));
+    res->samples = BENCHMARK_SAMPLES;
+}
+
+void benchmark_print_header(void)
+{
+#if BENCHMARK_FORMAT == BENCHMARK_FORMAT_CSV
+    puts("name,unit,runs,samples,median,min,max,mean,stddev");
+#elif BENCHMARK_FORMAT == BENCHMARK_FORMAT_TEXT
+    printf("%25s  %12s %12s %12s %12s %12s  (%s per call)\n",
+           "name", "median", "min", "max", "mean", "stddev", benchmark_unit());
+#endif
+}
+
+void benchmark_print_result(const benchmark_case_t *bench,
+                            const benchmark_result_t *res)
+{
+    const uint32_t values[] = {
+        res->median, res->min, res->max, res->mean, res->stddev
+    };
+#if BENCHMARK_FORMAT == BENCHMARK_FORMAT_JSON
+    static const char *keys[] = { "median", "min", "max", "mean", "stddev" };
+
+    printf("{\"name\": \"%s\", \"unit\": \"%s\", \"runs\": %lu, "
+           "\"samples\": %u", bench->name, benchmark_unit(), bench->runs,
+           res->samples);
+    for (unsigned i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        printf(", \"%s\": ", keys[i]);
+        _print_per_call("", 0, values[i], bench->runs);
+    }
+    puts("}");
+#elif BENCHMARK_FORMAT == BENCHMARK_FORMAT_CSV
+    printf("%s,%s,%lu,%u", bench->name, benchmark_unit(), bench->runs,
+           res->samples);
+    for (unsigned i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        _print_per_call(",", 0, values[i], bench->runs);
+    }
+    puts("");
+#else
+    printf("%25s:", bench->name);
+    for (unsigned i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        _print_per_call(" ", 8, values[i], bench->runs);
+    }
+    puts("");
+#endif
+}
+
+void benchmark_run_all(const benchmark_case_t *cases, unsigned numof)
+{
+    benchmark_print_header();
+    for (unsigned i = 0; i < numof; i++) {
+        benchmark_result_t res;
+
+        benchmark_run(&cases[i], &res);
+        benchmark_print_result(&cases[i], &res);
+    }
+}
 
 void benchmark_print_time(uint32_t time, unsigned long runs, const char *name)
 {
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bitalloc
+ * @{
+ *
+ * @file
+ * @}
+ */
+
+#include <assert.h>
+
+#include "bitarithm.h"
+#include "bitalloc.h"
+
+void bitalloc_init(bitalloc_t *ba, unsigned *map, unsigned *summary,
+                   unsigned numof)
+{
+    ba->map = map;
+    ba->summary = summary;
+    ba->numof = numof;
+    bitalloc_reset(ba);
+}
+
+void bitalloc_reset(bitalloc_t *ba)
+{
+    unsigned words = BITALLOC_MAP_WORDS(ba->numof);
+
+    for (unsigned i = 0; i < words; i++) {
+        ba->map[i] = ~0U;
+    }
+    for (unsigned i = 0; i < BITALLOC_MAP_WORDS(words); i++) {
+        ba->summary[i] = ~0U;
+    }
+    /* the bits beyond the last entry and word are never free */
+    if (ba->numof % BITALLOC_WORD_BITS) {
+        ba->map[words - 1] = (1U << (ba->numof % BITALLOC_WORD_BITS)) - 1;
+    }
+    if (words % BITALLOC_WORD_BITS) {
+        ba->summary[BITALLOC_MAP_WORDS(words) - 1] =
+            (1U << (words % BITALLOC_WORD_BITS)) - 1;
+    }
+}
+
+int bitalloc_find(const bitalloc_t *ba)
+{
+    unsigned words = BITALLOC_SUMMARY_WORDS(ba->numof);
+
+    for (unsigned i = 0; i < words; i++) {
+        if (ba->summary[i]) {
+            unsigned word = (i * BITALLOC_WORD_BITS) +
+                            bitarithm_lsb(ba->summary[i]);
+
+            return (word * BITALLOC_WORD_BITS) + bitarithm_lsb(ba->map[word]);
+        }
+    }
+    return -1;
+}
+
+void bitalloc_take(bitalloc_t *ba, unsigned idx)
+{
+    unsigned word = idx / BITALLOC_WORD_BITS;
+
+    assert(idx < ba->numof);
+    ba->map[word] &= ~(1U << (idx % BITALLOC_WORD_BITS));
+    if (ba->map[word] == 0) {
+        ba->summary[word / BITALLOC_WORD_BITS] &=
+            ~(1U << (word % BITALLOC_WORD_BITS));
+    }
+}
+
+void bitalloc_put(bitalloc_t *ba, unsigned idx)
+{
+    unsigned word = idx / BITALLOC_WORD_BITS;
+
+    assert(idx < ba->numof);
+    ba->map[word] |= 1U << (idx % BITALLOC_WORD_BITS);
+    ba->summary[word / BITALLOC_WORD_BITS] |=
+        1U << (word % BITALLOC_WORD_BITS);
+}
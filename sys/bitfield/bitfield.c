@@ -18,6 +18,9 @@
  */
 
 #include <stdint.h>
+#include <string.h>
+
+#include "bitarithm.h"
 #include "bitfield.h"
 #include "irq.h"
 
@@ -25,20 +28,29 @@ int bf_get_unset(uint8_t field[], int size)
 {
     int result = -1;
     int nbytes = (size + 7) / 8;
-    int i = 0;
+    int j = 0;
 
     unsigned state = irq_disable();
 
-    /* skip full bytes */
-    for (int j = 0; (j < nbytes) && (field[j] == 255); j++) {
-        i += 8;
+    /* skip full words, field may be unaligned */
+    for (; (j + (int)sizeof(unsigned)) <= nbytes; j += sizeof(unsigned)) {
+        unsigned word;
+
+        memcpy(&word, &field[j], sizeof(word));
+        if (word != ~0U) {
+            break;
+        }
     }
+    /* skip full bytes */
+    for (; (j < nbytes) && (field[j] == 255); j++) {}
 
-    for (; i < size; i++) {
-        if (!bf_isset(field, i)) {
+    if (j < nbytes) {
+        /* lowest unset bit, beyond size only if all below are set */
+        int i = (j * 8) + bitarithm_lsb(~field[j] & 0xff);
+
+        if (i < size) {
             bf_set(field, i);
             result = i;
-            break;
         }
     }
 
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bloom
+ * @{
+ *
+ * @file
+ * @brief       Blocked and counting blocked Bloom filter implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "bloom.h"
+
+#if (BLOOM_BLOCK_SIZE < 4) || (BLOOM_BLOCK_SIZE & (BLOOM_BLOCK_SIZE - 1))
+#error "BLOOM_BLOCK_SIZE must be a power of two of at least 4"
+#endif
+
+#define BITS_PER_BLOCK      (BLOOM_BLOCK_SIZE * 8U)
+#define COUNTERS_PER_BLOCK  (BLOOM_BLOCK_SIZE * 2U)
+
+/* probes of an element: a block and the start and step within the block */
+typedef struct {
+    uint32_t *block;
+    uint32_t pos;
+    uint32_t step;
+} _probe_t;
+
+static void _probe(const bloom_blocked_t *bloom, const uint8_t *buf,
+                   size_t len, _probe_t *probe)
+{
+    uint64_t hash = siphash13(bloom->key, buf, len);
+    /* maps the upper half evenly to [0, numof), without a division */
+    size_t block = ((hash >> 32) * bloom->numof) >> 32;
+
+    probe->block = bloom->blocks + block * (BLOOM_BLOCK_SIZE / 4U);
+    probe->pos = hash & 0xffff;
+    /* odd, so that the first probes of a block hit distinct positions */
+    probe->step = ((uint32_t)hash >> 16) | 1;
+}
+
+void bloom_blocked_init(bloom_blocked_t *bloom, uint32_t *blocks,
+                        size_t numof, unsigned k, const uint8_t *key)
+{
+    assert((numof > 0) && (k > 0));
+
+    bloom->blocks = blocks;
+    bloom->numof = numof;
+    bloom->k = k;
+    if (key) {
+        memcpy(bloom->key, key, sizeof(bloom->key));
+    }
+    else {
+        memset(bloom->key, 0, sizeof(bloom->key));
+    }
+    bloom_blocked_clear(bloom);
+}
+
+void bloom_blocked_clear(bloom_blocked_t *bloom)
+{
+    memset(bloom->blocks, 0, bloom->numof * BLOOM_BLOCK_SIZE);
+}
+
+bool bloom_blocked_check(const bloom_blocked_t *bloom, const uint8_t *buf,
+                         size_t len)
+{
+    _probe_t p;
+
+    _probe(bloom, buf, len, &p);
+    for (unsigned i = 0; i < bloom->k; i++, p.pos += p.step) {
+        uint32_t bit = p.pos & (BITS_PER_BLOCK - 1);
+
+        if (!(p.block[bit / 32] & (1UL << (bit % 32)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool bloom_blocked_test_and_add(bloom_blocked_t *bloom, const uint8_t *buf,
+                                size_t len)
+{
+    _probe_t p;
+    uint32_t missing = 0;
+
+    _probe(bloom, buf, len, &p);
+    for (unsigned i = 0; i < bloom->k; i++, p.pos += p.step) {
+        uint32_t bit = p.pos & (BITS_PER_BLOCK - 1);
+        uint32_t mask = 1UL << (bit % 32);
+
+        missing |= ~p.block[bit / 32] & mask;
+        p.block[bit / 32] |= mask;
+    }
+    return (missing == 0);
+}
+
+/* the counters are nibbles, the lower one first */
+static inline unsigned _counter(const _probe_t *p, uint32_t *word,
+                                unsigned *shift)
+{
+    uint32_t idx = p->pos & (COUNTERS_PER_BLOCK - 1);
+
+    *word = idx / 8;
+    *shift = (idx % 8) * 4;
+    return (p->block[*word] >> *shift) & 0xf;
+}
+
+void bloom_counting_add(bloom_blocked_t *bloom, const uint8_t *buf,
+                        size_t len)
+{
+    _probe_t p;
+
+    _probe(bloom, buf, len, &p);
+    for (unsigned i = 0; i < bloom->k; i++, p.pos += p.step) {
+        uint32_t word;
+        unsigned shift;
+
+        if (_counter(&p, &word, &shift) < BLOOM_COUNTING_MAX) {
+            p.block[word] += 1UL << shift;
+        }
+    }
+}
+
+void bloom_counting_remove(bloom_blocked_t *bloom, const uint8_t *buf,
+                           size_t len)
+{
+    _probe_t p;
+
+    _probe(bloom, buf, len, &p);
+    for (unsigned i = 0; i < bloom->k; i++, p.pos += p.step) {
+        uint32_t word;
+        unsigned shift;
+        unsigned count = _counter(&p, &word, &shift);
+
+        /* a saturated counter lost track of its elements */
+        if ((count > 0) && (count < BLOOM_COUNTING_MAX)) {
+            p.block[word] -= 1UL << shift;
+        }
+    }
+}
+
+bool bloom_counting_check(const bloom_blocked_t *bloom, const uint8_t *buf,
+                          size_t len)
+{
+    _probe_t p;
+
+    _probe(bloom, buf, len, &p);
+    for (unsigned i = 0; i < bloom->k; i++, p.pos += p.step) {
+        uint32_t word;
+        unsigned shift;
+
+        if (_counter(&p, &word, &shift) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -144,11 +144,9 @@ static void _tx_conf_timeout(void *arg)
     put_msg(conn, &msg);
 }
 
-int conn_can_isotp_send(conn_can_isotp_t *conn, const void *buf, size_t size, int flags)
+static int _send(conn_can_isotp_t *conn, const void *buf, size_t size,
+                 const iolist_t *iol, int flags)
 {
-    assert(conn != NULL);
-    assert(buf != NULL || size == 0);
-
     int ret = 0;
 
     if (!conn->bound) {
@@ -164,7 +162,16 @@ int conn_can_isotp_send(conn_can_isotp_t *conn, const void *buf, size_t size, in
         timer.arg = conn;
         xtimer_set(&timer, CONN_CAN_ISOTP_TIMEOUT_TX_CONF);
 
-        ret = isotp_send(&conn->isotp, buf, size, flags);
+        if (iol) {
+            ret = isotp_send_iol(&conn->isotp, iol, flags);
+        }
+        else {
+            ret = isotp_send(&conn->isotp, buf, size, flags);
+        }
+        if (ret < 0) {
+            xtimer_remove(&timer);
+            return ret;
+        }
 
         msg_t msg;
         while (1) {
@@ -197,6 +204,22 @@ int conn_can_isotp_send(conn_can_isotp_t *conn, const void *buf, size_t size, in
     return ret;
 }
 
+int conn_can_isotp_send(conn_can_isotp_t *conn, const void *buf, size_t size, int flags)
+{
+    assert(conn != NULL);
+    assert(buf != NULL || size == 0);
+
+    return _send(conn, buf, size, NULL, flags);
+}
+
+int conn_can_isotp_send_iol(conn_can_isotp_t *conn, const iolist_t *iol, int flags)
+{
+    assert(conn != NULL);
+    assert(iol != NULL);
+
+    return _send(conn, NULL, 0, iol, flags & ~CAN_ISOTP_TX_DONT_WAIT);
+}
+
 static void _rx_timeout(void *arg)
 {
     conn_can_isotp_t *conn = arg;
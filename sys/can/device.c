@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 
 #include "thread.h"
 #include "can/device.h"
@@ -98,6 +99,7 @@ static void _can_event(candev_t *dev, candev_event_t event, void *arg)
         break;
     case CANDEV_EVENT_RX_ERROR:
         DEBUG("_can_event: CANDEV_EVENT_RX_ERROR\n");
+        candev_dev->stats.rx_errors++;
         break;
     case CANDEV_EVENT_BUS_OFF:
         dev->state = CAN_STATE_BUS_OFF;
@@ -197,6 +199,74 @@ static void wake_up(candev_dev_t *candev_dev)
 #endif
 }
 
+static void tx_send(candev_dev_t *candev_dev, can_pkt_t *pkt)
+{
+    candev_t *dev = candev_dev->dev;
+
+    /* frames are sent in order, so only try if none is waiting */
+    if (candev_dev->tx_queue_len == 0) {
+        int res = dev->driver->send(dev, &pkt->frame);
+        if (res >= 0) {
+            return;
+        }
+        if (res != -EBUSY) {
+            DEBUG("can device: send error %d\n", res);
+            can_dll_dispatch_tx_error(pkt);
+            return;
+        }
+    }
+
+    if (candev_dev->tx_queue_len == CAN_DEVICE_TX_QUEUE_SIZE) {
+        DEBUG("can device: tx queue full\n");
+        can_dll_dispatch_tx_error(pkt);
+        return;
+    }
+    candev_dev->tx_queue[(candev_dev->tx_queue_first + candev_dev->tx_queue_len)
+                         % CAN_DEVICE_TX_QUEUE_SIZE] = pkt;
+    candev_dev->tx_queue_len++;
+}
+
+/* hands the waiting frames to the driver until all its mailboxes are busy */
+static void tx_flush(candev_dev_t *candev_dev)
+{
+    candev_t *dev = candev_dev->dev;
+
+    while (candev_dev->tx_queue_len) {
+        can_pkt_t *pkt = candev_dev->tx_queue[candev_dev->tx_queue_first];
+        int res = dev->driver->send(dev, &pkt->frame);
+        if (res == -EBUSY) {
+            break;
+        }
+        candev_dev->tx_queue_first = (candev_dev->tx_queue_first + 1) % CAN_DEVICE_TX_QUEUE_SIZE;
+        candev_dev->tx_queue_len--;
+        if (res < 0) {
+            DEBUG("can device: send error %d\n", res);
+            can_dll_dispatch_tx_error(pkt);
+        }
+    }
+}
+
+/* removes a frame from the tx queue, returns false if it is not queued */
+static bool tx_dequeue(candev_dev_t *candev_dev, can_pkt_t *pkt)
+{
+    unsigned i;
+
+    for (i = 0; i < candev_dev->tx_queue_len; i++) {
+        if (candev_dev->tx_queue[(candev_dev->tx_queue_first + i) % CAN_DEVICE_TX_QUEUE_SIZE] == pkt) {
+            break;
+        }
+    }
+    if (i == candev_dev->tx_queue_len) {
+        return false;
+    }
+    for (; i + 1 < candev_dev->tx_queue_len; i++) {
+        candev_dev->tx_queue[(candev_dev->tx_queue_first + i) % CAN_DEVICE_TX_QUEUE_SIZE] =
+            candev_dev->tx_queue[(candev_dev->tx_queue_first + i + 1) % CAN_DEVICE_TX_QUEUE_SIZE];
+    }
+    candev_dev->tx_queue_len--;
+    return true;
+}
+
 static void *_can_device_thread(void *args)
 {
     candev_dev_t *candev_dev = (candev_dev_t *) args;
@@ -245,11 +315,15 @@ static void *_can_device_thread(void *args)
         case CAN_MSG_EVENT:
             DEBUG("can device: CAN_MSG_EVENT received\n");
             dev->driver->isr(dev);
+            /* mailboxes may have been freed */
+            tx_flush(candev_dev);
             break;
         case CAN_MSG_ABORT_FRAME:
             DEBUG("can device: CAN_MSG_ABORT_FRAME received\n");
             pkt = (can_pkt_t *) msg.content.ptr;
-            dev->driver->abort(dev, &pkt->frame);
+            if (!tx_dequeue(candev_dev, pkt)) {
+                dev->driver->abort(dev, &pkt->frame);
+            }
             reply.type = CAN_MSG_ACK;
             reply.content.value = 0;
             msg_reply(&msg, &reply);
@@ -259,7 +333,18 @@ static void *_can_device_thread(void *args)
             wake_up(candev_dev);
             /* read incoming pkt */
             pkt = (can_pkt_t *) msg.content.ptr;
-            dev->driver->send(dev, &pkt->frame);
+            tx_send(candev_dev, pkt);
+            break;
+        case CAN_MSG_SEND_BATCH:
+            DEBUG("can device: CAN_MSG_SEND_BATCH received\n");
+            wake_up(candev_dev);
+            /* NULL terminated array of pkts, owned by the waiting sender */
+            for (can_pkt_t **pkts = msg.content.ptr; *pkts; pkts++) {
+                tx_send(candev_dev, *pkts);
+            }
+            reply.type = CAN_MSG_ACK;
+            reply.content.value = 0;
+            msg_reply(&msg, &reply);
             break;
         case CAN_MSG_SET:
             DEBUG("can device: CAN_MSG_SET received\n");
@@ -24,8 +24,10 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
+#include "irq.h"
 #include "thread.h"
 #include "can/dll.h"
 #include "can/raw.h"
@@ -92,6 +94,56 @@ int raw_can_send(int ifnum, const struct can_frame *frame, kernel_pid_t pid)
     return _send_pkt(pkt);
 }
 
+int raw_can_send_batch(int ifnum, const struct can_frame *frames, size_t num,
+                       kernel_pid_t pid, int *handles)
+{
+    size_t sent = 0;
+    bool full = false;
+
+    assert(frames);
+    assert(ifnum < candev_nb);
+
+    DEBUG("raw_can_send_batch: ifnum=%d, num=%u from pid=%" PRIkernel_pid "\n",
+          ifnum, (unsigned)num, pid);
+
+    while (!full && (sent < num)) {
+        can_pkt_t *pkts[RAW_CAN_SEND_BATCH_SIZE + 1];
+        size_t n = 0;
+        msg_t msg, reply;
+
+        while ((n < RAW_CAN_SEND_BATCH_SIZE) && (sent + n < num)) {
+            pkts[n] = can_pkt_alloc_tx(ifnum, &frames[sent + n], pid);
+            if (!pkts[n]) {
+                full = true;
+                break;
+            }
+            if (handles) {
+                handles[sent + n] = pkts[n]->handle;
+            }
+            n++;
+        }
+        if (n == 0) {
+            break;
+        }
+        pkts[n] = NULL;
+
+        mutex_lock(&tx_lock);
+        for (size_t i = 0; i < n; i++) {
+            LL_APPEND(tx_list[ifnum], &pkts[i]->entry);
+        }
+        mutex_unlock(&tx_lock);
+
+        /* the pkts array lives on this stack until the device thread replies */
+        msg.type = CAN_MSG_SEND_BATCH;
+        msg.content.ptr = pkts;
+        msg_send_receive(&msg, &reply, candev_list[ifnum]->pid);
+
+        sent += n;
+    }
+
+    return (sent || !num) ? (int)sent : -ENOMEM;
+}
+
 #ifdef MODULE_CAN_MBOX
 int raw_can_send_mbox(int ifnum, const struct can_frame *frame, mbox_t *mbox)
 {
@@ -328,15 +380,36 @@ int can_dll_register_candev(candev_dev_t *candev)
 
 int can_dll_dispatch_rx_frame(struct can_frame *frame, kernel_pid_t pid)
 {
-    can_pkt_t *pkt = can_pkt_alloc_rx(_get_ifnum(pid), frame);
+    int ifnum = _get_ifnum(pid);
+    can_pkt_t *pkt;
+    int res;
+
+    if (ifnum < 0) {
+        return ifnum;
+    }
 
-    return can_router_dispatch_rx_indic(pkt);
+    candev_list[ifnum]->stats.rx_frames++;
+    pkt = can_pkt_alloc_rx(ifnum, frame);
+    if (!pkt) {
+        candev_list[ifnum]->stats.rx_overruns++;
+        return -ENOMEM;
+    }
+
+    res = can_router_dispatch_rx_indic(pkt);
+    if (res == -EBUSY) {
+        /* the queue of a subscriber was full */
+        candev_list[ifnum]->stats.rx_overruns++;
+    }
+
+    return res;
 }
 
 int can_dll_dispatch_tx_conf(can_pkt_t *pkt)
 {
     DEBUG("can_dll_dispatch_tx_conf: pkt=0x%p\n", (void*)pkt);
 
+    candev_list[pkt->entry.ifnum]->stats.tx_frames++;
+
     can_router_dispatch_tx_conf(pkt);
 
     mutex_lock(&tx_lock);
@@ -352,6 +425,8 @@ int can_dll_dispatch_tx_error(can_pkt_t *pkt)
 {
     DEBUG("can_dll_dispatch_tx_error: pkt=0x%p\n", (void*)pkt);
 
+    candev_list[pkt->entry.ifnum]->stats.tx_errors++;
+
     can_router_dispatch_tx_error(pkt);
 
     mutex_lock(&tx_lock);
@@ -522,3 +597,19 @@ candev_dev_t *raw_can_get_dev_by_ifnum(int ifnum)
 
     return candev_list[ifnum];
 }
+
+int raw_can_get_stats(int ifnum, can_stats_t *stats)
+{
+    assert(stats);
+
+    if ((ifnum < 0) || (ifnum >= candev_nb)) {
+        return -ENODEV;
+    }
+
+    /* the counters are updated by the device thread */
+    unsigned state = irq_disable();
+    *stats = candev_list[ifnum]->stats;
+    irq_restore(state);
+
+    return 0;
+}
@@ -25,6 +25,7 @@
 #include "can/common.h"
 #include "can/raw.h"
 #include "can/router.h"
+#include "iolist.h"
 #include "thread.h"
 #include "mutex.h"
 #include "timex.h"
@@ -153,8 +154,11 @@ static int _isotp_dispatch_tx(struct isotp *isotp, int err)
 {
     msg_t msg;
 
-    gnrc_pktbuf_release(isotp->tx.snip);
-    isotp->tx.snip = NULL;
+    if (isotp->tx.snip) {
+        gnrc_pktbuf_release(isotp->tx.snip);
+        isotp->tx.snip = NULL;
+    }
+    isotp->tx_iol = NULL;
 
     if (isotp->opt.flags & CAN_ISOTP_TX_DONT_WAIT) {
         return 0;
@@ -282,10 +286,8 @@ static int _isotp_rcv_sf(struct isotp *isotp, struct can_frame *frame, int ae)
     }
     isotp->rx.snip = snip;
 
-    isotp->rx.idx = 0;
-    for (size_t i = SF_PCI_SZ + ae; i < isotp->rx.snip->size + ae + SF_PCI_SZ; i++) {
-        ((uint8_t *)isotp->rx.snip->data)[isotp->rx.idx++] = frame->data[i];
-    }
+    memcpy(isotp->rx.snip->data, &frame->data[SF_PCI_SZ + ae], len);
+    isotp->rx.idx = len;
 
     return _isotp_dispatch_rx(isotp);
 }
@@ -364,11 +366,13 @@ static int _isotp_rcv_cf(struct isotp *isotp, struct can_frame *frame, int ae)
     isotp->rx.sn++;
     isotp->rx.sn %= 16;
 
-    for (int i = ae + N_PCI_SZ; i < frame->can_dlc; i++) {
-        ((uint8_t *)isotp->rx.snip->data)[isotp->rx.idx++] = frame->data[i];
-        if (isotp->rx.idx >= isotp->rx.snip->size) {
-            break;
-        }
+    if (frame->can_dlc > ae + N_PCI_SZ) {
+        size_t len = MIN((size_t)(frame->can_dlc - ae - N_PCI_SZ),
+                         isotp->rx.snip->size - isotp->rx.idx);
+
+        memcpy((uint8_t *)isotp->rx.snip->data + isotp->rx.idx,
+               &frame->data[ae + N_PCI_SZ], len);
+        isotp->rx.idx += len;
     }
 
 #if ENABLE_DEBUG
@@ -480,6 +484,31 @@ static int _isotp_send_fc(struct isotp *isotp, int ae, uint8_t status)
     }
 }
 
+/* copies the next @p len bytes of the data to transmit, at tx.idx */
+static void _isotp_tx_read(struct isotp *isotp, uint8_t *dst, size_t len)
+{
+    const iolist_t *iol = isotp->tx_iol;
+    size_t off = isotp->tx.idx;
+
+    if (!len) {
+        return;
+    }
+    isotp->tx.idx += len;
+    while (off >= iol->iol_len) {
+        off -= iol->iol_len;
+        iol = iol->iol_next;
+    }
+    while (len) {
+        size_t n = MIN(len, iol->iol_len - off);
+
+        memcpy(dst, (const uint8_t *)iol->iol_base + off, n);
+        dst += n;
+        len -= n;
+        off = 0;
+        iol = iol->iol_next;
+    }
+}
+
 static void _isotp_create_ff(struct isotp *isotp, struct can_frame *frame, int ae)
 {
 
@@ -490,12 +519,10 @@ static void _isotp_create_ff(struct isotp *isotp, struct can_frame *frame, int a
         frame->data[0] = isotp->opt.ext_address;
     }
 
-    frame->data[ae] = (uint8_t)(isotp->tx.snip->size >> 8) | N_PCI_FF;
-    frame->data[ae + 1] = (uint8_t) isotp->tx.snip->size & 0xFFU;
+    frame->data[ae] = (uint8_t)(isotp->tx_len >> 8) | N_PCI_FF;
+    frame->data[ae + 1] = (uint8_t) isotp->tx_len & 0xFFU;
 
-    for (int i = ae + FF_PCI_SZ; i < CAN_MAX_DLEN; i++) {
-        frame->data[i] = ((uint8_t *)isotp->tx.snip->data)[isotp->tx.idx++];
-    }
+    _isotp_tx_read(isotp, &frame->data[ae + FF_PCI_SZ], CAN_MAX_DLEN - ae - FF_PCI_SZ);
 
     isotp->tx.sn = 1;
 }
@@ -504,7 +531,7 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
 {
     size_t pci_len = N_PCI_SZ + ae;
     size_t space = CAN_MAX_DLEN - pci_len;
-    size_t num_bytes = MIN(space, isotp->tx.snip->size - isotp->tx.idx);
+    size_t num_bytes = MIN(space, isotp->tx_len - isotp->tx.idx);
 
     frame->can_id = isotp->opt.tx_id;
     frame->can_dlc = num_bytes + pci_len;
@@ -518,9 +545,7 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
         }
     }
 
-    for (size_t i = 0; i < num_bytes; i++) {
-        frame->data[pci_len + i] = ((uint8_t *)isotp->tx.snip->data)[isotp->tx.idx++];
-    }
+    _isotp_tx_read(isotp, &frame->data[pci_len], num_bytes);
 
     if (ae) {
         frame->data[0] = isotp->opt.ext_address;
@@ -528,10 +553,61 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
 
 }
 
+/* sends the next CF, or the next CFs of the block at once if no gap is
+ * required between them */
+static void _isotp_send_cf(struct isotp *isotp, int ae)
+{
+    struct can_frame frames[RAW_CAN_SEND_BATCH_SIZE];
+    int handles[RAW_CAN_SEND_BATCH_SIZE];
+    size_t space = CAN_MAX_DLEN - N_PCI_SZ - ae;
+    size_t left = (isotp->tx_len - isotp->tx.idx + space - 1) / space;
+    unsigned idx = isotp->tx.idx;
+    uint8_t sn = isotp->tx.sn;
+    uint8_t bs = isotp->tx.bs;
+    int num = 1;
+
+    if (isotp->tx_gap == 0) {
+        num = MIN(left, RAW_CAN_SEND_BATCH_SIZE);
+        if (isotp->txfc.bs) {
+            num = MIN(num, isotp->txfc.bs - isotp->tx.bs);
+        }
+    }
+
+    for (int i = 0; i < num; i++) {
+        _isotp_fill_dataframe(isotp, &frames[i], ae);
+        frames[i].data[ae] = N_PCI_CF | isotp->tx.sn++;
+        isotp->tx.sn %= 16;
+        isotp->tx.bs++;
+    }
+
+    isotp->tx.state = ISOTP_SENDING_CF;
+    if (num == 1) {
+        _isotp_tx_send(isotp, &frames[0]);
+        return;
+    }
+
+    xtimer_set(&isotp->tx_timer, CAN_ISOTP_TIMEOUT_N_As);
+    int res = raw_can_send_batch(isotp->entry.ifnum, frames, num, isotp_pid, handles);
+    DEBUG("_isotp_send_cf: %d/%d CFs sent\n", res, num);
+    if (res < 0) {
+        xtimer_remove(&isotp->tx_timer);
+        isotp->tx.state = ISOTP_IDLE;
+        _isotp_dispatch_tx(isotp, res);
+        return;
+    }
+    if (res < num) {
+        /* the others are sent after the confirmation of the last one sent */
+        isotp->tx.idx = idx + res * space;
+        isotp->tx.sn = (sn + res) % 16;
+        isotp->tx.bs = bs + res;
+    }
+    /* the frames are sent in order, only the last one is waited for */
+    isotp->tx.tx_handle = handles[res - 1];
+}
+
 static void _isotp_tx_timeout_task(struct isotp *isotp)
 {
     int ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
-    struct can_frame frame;
 
     DEBUG("_isotp_tx_timeout_task: state=%d\n", isotp->tx.state);
 
@@ -544,13 +620,7 @@ static void _isotp_tx_timeout_task(struct isotp *isotp)
 
     case ISOTP_SENDING_NEXT_CF:
         DEBUG("_isotp_tx_timeout_task: sending next CF\n");
-        _isotp_fill_dataframe(isotp, &frame, ae);
-        frame.data[ae] = N_PCI_CF | isotp->tx.sn++;
-        isotp->tx.sn %= 16;
-        isotp->tx.bs++;
-
-        isotp->tx.state = ISOTP_SENDING_CF;
-        _isotp_tx_send(isotp, &frame);
+        _isotp_send_cf(isotp, ae);
         break;
 
     case ISOTP_SENDING_CF:
@@ -583,7 +653,7 @@ static void _isotp_tx_tx_conf(struct isotp *isotp)
         break;
 
     case ISOTP_SENDING_CF:
-        if (isotp->tx.idx >= isotp->tx.snip->size) {
+        if (isotp->tx.idx >= isotp->tx_len) {
             /* Finished */
             isotp->tx.state = ISOTP_IDLE;
             _isotp_dispatch_tx(isotp, 0);
@@ -654,12 +724,12 @@ static int _isotp_send_sf_ff(struct isotp *isotp)
     struct can_frame frame;
     unsigned ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
 
-    if (isotp->tx.snip->size <= CAN_MAX_DLEN - SF_PCI_SZ - ae) {
+    if (isotp->tx_len <= CAN_MAX_DLEN - SF_PCI_SZ - ae) {
         /* Fits into a single frame */
         _isotp_fill_dataframe(isotp, &frame, ae);
 
         frame.data[ae] = N_PCI_SF;
-        frame.data[ae] |= isotp->tx.snip->size;
+        frame.data[ae] |= isotp->tx_len;
 
         isotp->tx.state = ISOTP_SENDING_SF;
     }
@@ -752,6 +822,28 @@ kernel_pid_t isotp_init(char *stack, int stacksize, char priority, const char *n
     return res;
 }
 
+static void _isotp_start_tx(struct isotp *isotp, const iolist_t *iol, size_t len)
+{
+    isotp->tx_iol = iol;
+    isotp->tx_len = len;
+    isotp->tx.idx = 0;
+
+    isotp->tx_wft = 0;
+
+    msg_t msg;
+    msg.type = CAN_MSG_SEND_FRAME;
+    msg.content.ptr = isotp;
+    msg_send(&msg, isotp_pid);
+}
+
+static void _isotp_set_tx_flags(struct isotp *isotp, int flags)
+{
+    if (flags) {
+        isotp->opt.flags &= CAN_ISOTP_RX_FLAGS_MASK;
+        isotp->opt.flags |= (flags & CAN_ISOTP_TX_FLAGS_MASK);
+    }
+}
+
 int isotp_send(struct isotp *isotp, const void *buf, int len, int flags)
 {
     assert(isotp != NULL);
@@ -767,10 +859,7 @@ int isotp_send(struct isotp *isotp, const void *buf, int len, int flags)
         return -EBUSY;
     }
 
-    if (flags) {
-        isotp->opt.flags &= CAN_ISOTP_RX_FLAGS_MASK;
-        isotp->opt.flags |= (flags & CAN_ISOTP_TX_FLAGS_MASK);
-    }
+    _isotp_set_tx_flags(isotp, flags);
 
     gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
     if (!snip) {
@@ -780,18 +869,51 @@ int isotp_send(struct isotp *isotp, const void *buf, int len, int flags)
 
     memcpy(isotp->tx.snip->data, buf, len);
 
-    isotp->tx.idx = 0;
+    /* a snip is an iolist */
+    _isotp_start_tx(isotp, (iolist_t *)snip, len);
 
-    isotp->tx_wft = 0;
+    return len;
+}
 
-    msg_t msg;
-    msg.type = CAN_MSG_SEND_FRAME;
-    msg.content.ptr = isotp;
-    msg_send(&msg, isotp_pid);
+int isotp_send_iol(struct isotp *isotp, const iolist_t *iol, int flags)
+{
+    assert(isotp != NULL);
+#ifdef MODULE_CAN_MBOX
+    assert((isotp->entry.type == CAN_TYPE_DEFAULT && pid_is_valid(isotp->entry.target.pid)) ||
+           (isotp->entry.type == CAN_TYPE_MBOX && isotp->entry.target.mbox != NULL));
+#else
+    assert(isotp->entry.target.pid != KERNEL_PID_UNDEF);
+#endif
+
+    size_t len = iolist_size(iol);
+    assert (len && len <= MAX_MSG_LENGTH);
+
+    if (flags & CAN_ISOTP_TX_DONT_WAIT) {
+        /* the caller would not know when the buffers are free again */
+        return -EINVAL;
+    }
+
+    if (isotp->tx.state != ISOTP_IDLE) {
+        return -EBUSY;
+    }
+
+    _isotp_set_tx_flags(isotp, flags);
+    isotp->opt.flags &= ~CAN_ISOTP_TX_DONT_WAIT;
+
+    isotp->tx.snip = NULL;
+    _isotp_start_tx(isotp, iol, len);
 
     return len;
 }
 
+void isotp_set_rxfc(struct isotp *isotp, uint8_t bs, uint8_t stmin)
+{
+    assert(isotp != NULL);
+
+    isotp->rxfc.bs = bs;
+    isotp->rxfc.stmin = stmin;
+}
+
 int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg)
 {
     int ret;
@@ -886,6 +1008,7 @@ int isotp_release(struct isotp *isotp)
     }
     isotp->rx.state = ISOTP_IDLE;
     isotp->entry.target.pid = KERNEL_PID_UNDEF;
+    isotp->tx_iol = NULL;
 
     mutex_lock(&lock);
     LL_DELETE(isotp_list, isotp);
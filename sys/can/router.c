@@ -54,10 +54,29 @@ typedef struct filter_el {
 } filter_el_t;
 
 /**
- * This table contains @p CAN_ROUTER_APP_MAX lists of CAN IDs per interface
+ * A mask whose filters are indexed
+ */
+typedef struct {
+    canid_t mask;            /**< the mask */
+    unsigned count;          /**< number of indexed filters, 0 if unused */
+} index_mask_t;
+
+/**
+ * This table contains the sorted list of the filters that are not indexed
+ * per interface
  */
 static can_reg_entry_t *table[CAN_DLL_NUMOF];
 
+/**
+ * The hash buckets of the filters of the indexed masks per interface
+ */
+static can_reg_entry_t *buckets[CAN_DLL_NUMOF][CAN_ROUTER_INDEX_BUCKETS];
+
+/**
+ * The indexed masks per interface
+ */
+static index_mask_t masks[CAN_DLL_NUMOF][CAN_ROUTER_INDEX_MASKS];
+
 
 static mutex_t lock = MUTEX_INIT;
 
@@ -66,18 +85,27 @@ static void _free_filter_el(filter_el_t *el);
 static void _insert_to_list(can_reg_entry_t **list, filter_el_t *el);
 static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *data);
 static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask);
+static can_reg_entry_t **_get_list(unsigned int ifnum, canid_t can_id, canid_t mask);
 
 #if ENABLE_DEBUG
+static void _print_list(can_reg_entry_t *list)
+{
+    can_reg_entry_t *entry;
+    LL_FOREACH(list, entry) {
+        filter_el_t *el = container_of(entry, filter_el_t, entry);
+        DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
+              el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data);
+    }
+}
+
 static void _print_filters(void)
 {
     for (int i = 0; i < (int)CAN_DLL_NUMOF; i++) {
         DEBUG("--- Ifnum: %d ---\n", i);
-        can_reg_entry_t *entry;
-        LL_FOREACH(table[i], entry) {
-            filter_el_t *el = container_of(entry, filter_el_t, entry);
-            DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
-                  el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data);
+        for (unsigned j = 0; j < CAN_ROUTER_INDEX_BUCKETS; j++) {
+            _print_list(buckets[i][j]);
         }
+        _print_list(table[i]);
     }
 }
 
@@ -150,6 +178,97 @@ static void _insert_to_list(can_reg_entry_t **list, filter_el_t *el)
     }
 }
 
+static unsigned _bucket(canid_t can_id, canid_t mask)
+{
+    /* Fibonacci hashing */
+    return (((can_id ^ mask) * 0x9e3779b1UL) >> 16) & (CAN_ROUTER_INDEX_BUCKETS - 1);
+}
+
+/* returns the slot of an indexed mask, -1 if it is not indexed */
+static int _mask_slot(unsigned int ifnum, canid_t mask)
+{
+    for (unsigned i = 0; i < CAN_ROUTER_INDEX_MASKS; i++) {
+        if (masks[ifnum][i].count && (masks[ifnum][i].mask == mask)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* filters with bits of the CAN ID outside of the mask never match, and
+ * filters without a mask match all frames, they are not indexed */
+static int _is_indexable(canid_t can_id, canid_t mask)
+{
+    return mask && !(can_id & ~mask);
+}
+
+/* Returns the list a filter is in, or is to be inserted to */
+static can_reg_entry_t **_get_list(unsigned int ifnum, canid_t can_id, canid_t mask)
+{
+    if (_is_indexable(can_id, mask) && (_mask_slot(ifnum, mask) >= 0)) {
+        return &buckets[ifnum][_bucket(can_id, mask)];
+    }
+    return &table[ifnum];
+}
+
+/* Starts indexing a mask if there is a free slot, and moves the filters of
+ * this mask from the list to the buckets. Returns the slot, or -1. */
+static int _index_mask(unsigned int ifnum, canid_t mask)
+{
+    can_reg_entry_t *entry, *tmp;
+    int slot = -1;
+
+    for (unsigned i = 0; i < CAN_ROUTER_INDEX_MASKS; i++) {
+        if (!masks[ifnum][i].count) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) {
+        return slot;
+    }
+    masks[ifnum][slot].mask = mask;
+    LL_FOREACH_SAFE(table[ifnum], entry, tmp) {
+        filter_el_t *el = container_of(entry, filter_el_t, entry);
+        if ((el->mask == mask) && _is_indexable(el->can_id, mask)) {
+            LL_DELETE(table[ifnum], entry);
+            LL_PREPEND(buckets[ifnum][_bucket(el->can_id, mask)], entry);
+            masks[ifnum][slot].count++;
+        }
+    }
+    DEBUG("_index_mask: indexing mask=0x%" PRIx32 "\n", mask);
+    return slot;
+}
+
+static void _insert(unsigned int ifnum, filter_el_t *el)
+{
+    int slot = -1;
+
+    if (_is_indexable(el->can_id, el->mask)) {
+        slot = _mask_slot(ifnum, el->mask);
+        if (slot < 0) {
+            slot = _index_mask(ifnum, el->mask);
+        }
+    }
+    if (slot < 0) {
+        _insert_to_list(&table[ifnum], el);
+        return;
+    }
+    LL_PREPEND(buckets[ifnum][_bucket(el->can_id, el->mask)], &el->entry);
+    masks[ifnum][slot].count++;
+}
+
+static void _remove(unsigned int ifnum, filter_el_t *el)
+{
+    can_reg_entry_t **list = _get_list(ifnum, el->can_id, el->mask);
+
+    LL_DELETE(*list, &el->entry);
+    if (list != &table[ifnum]) {
+        /* the mask becomes unused with its last filter */
+        masks[ifnum][_mask_slot(ifnum, el->mask)].count--;
+    }
+}
+
 #ifdef MODULE_CAN_MBOX
 #define ENTRY_MATCHES(e1, e2) (((e1)->type == (e2)->type) && \
     (((e1)->type == CAN_TYPE_DEFAULT && (e1)->target.pid == (e2)->target.pid) ||\
@@ -179,7 +298,7 @@ static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entr
 
 static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask)
 {
-    filter_el_t *el = container_of(table[ifnum], filter_el_t, entry);
+    filter_el_t *el = container_of(*_get_list(ifnum, can_id, mask), filter_el_t, entry);
     if (!el) {
         DEBUG("_filter_is_used: empty list\n");
         return 0;
@@ -238,7 +357,7 @@ int can_router_register(can_reg_entry_t *entry, canid_t can_id, canid_t mask, vo
     filter->entry.target.pid = entry->target.pid;
 #endif
     filter->entry.ifnum = entry->ifnum;
-    _insert_to_list(&table[entry->ifnum], filter);
+    _insert(entry->ifnum, filter);
     mutex_unlock(&lock);
 
     PRINT_FILTERS();
@@ -264,12 +383,12 @@ int can_router_unregister(can_reg_entry_t *entry, canid_t can_id,
 #endif
 
     mutex_lock(&lock);
-    el = _find_filter_el(table[entry->ifnum], entry, can_id, mask, param);
+    el = _find_filter_el(*_get_list(entry->ifnum, can_id, mask), entry, can_id, mask, param);
     if (!el) {
         mutex_unlock(&lock);
         return -EINVAL;
     }
-    LL_DELETE(table[entry->ifnum], &el->entry);
+    _remove(entry->ifnum, el);
     _free_filter_el(el);
     ret = _filter_is_used(entry->ifnum, can_id, mask);
     mutex_unlock(&lock);
@@ -296,28 +415,21 @@ static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 #endif
 }
 
-/* send received pkt to all interested users */
-int can_router_dispatch_rx_indic(can_pkt_t *pkt)
+/* send received pkt to the interested users of a list, @p mask restricts the
+ * filters to those of an indexed mask, 0 for all */
+static int _dispatch_list(can_pkt_t *pkt, can_reg_entry_t *list, canid_t mask)
 {
-    if (!pkt) {
-        DEBUG("can_router_dispatch_rx_indic: invalid pkt\n");
-        return -EINVAL;
-    }
-
-    int res = 0;
     msg_t msg;
     msg.type = CAN_MSG_RX_INDICATION;
-#if ENABLE_DEBUG
-    int msg_cnt = 0;
-#endif
-    DEBUG("can_router_dispatch_rx_indic: pkt=%p, ifnum=%d, can_id=%" PRIx32 "\n",
-          (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
 
-    mutex_lock(&lock);
     can_reg_entry_t *entry;
     filter_el_t *el;
-    LL_FOREACH(table[pkt->entry.ifnum], entry) {
+    LL_FOREACH(list, entry) {
         el = container_of(entry, filter_el_t, entry);
+        /* a bucket holds the filters of several masks */
+        if (mask && (el->mask != mask)) {
+            continue;
+        }
         if ((pkt->frame.can_id & el->mask) == el->can_id) {
             DEBUG("can_router_dispatch_rx_indic: found el=%p, data=%p\n",
                   (void *)el, (void *)el->data);
@@ -325,23 +437,44 @@ int can_router_dispatch_rx_indic(can_pkt_t *pkt)
                   PRIkernel_pid "\n", entry->target.pid);
             atomic_fetch_add(&pkt->ref_count, 1);
             msg.content.ptr = can_pkt_alloc_rx_data(&pkt->frame, sizeof(pkt->frame), el->data);
-#if ENABLE_DEBUG
-            msg_cnt++;
-#endif
             if (!msg.content.ptr || (_send_msg(&msg, entry) <= 0)) {
                 can_pkt_free_rx_data(msg.content.ptr);
                 atomic_fetch_sub(&pkt->ref_count, 1);
                 DEBUG("can_router_dispatch_rx_indic: failed to send msg to "
                       "pid=%" PRIkernel_pid "\n", entry->target.pid);
-                res = -EBUSY;
-                break;
+                return -EBUSY;
             }
         }
     }
+    return 0;
+}
+
+/* send received pkt to all interested users */
+int can_router_dispatch_rx_indic(can_pkt_t *pkt)
+{
+    if (!pkt) {
+        DEBUG("can_router_dispatch_rx_indic: invalid pkt\n");
+        return -EINVAL;
+    }
+
+    int res = 0;
+    int ifnum = pkt->entry.ifnum;
+    DEBUG("can_router_dispatch_rx_indic: pkt=%p, ifnum=%d, can_id=%" PRIx32 "\n",
+          (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
+
+    mutex_lock(&lock);
+    /* one lookup per indexed mask, then the remaining filters */
+    for (unsigned i = 0; (res == 0) && (i < CAN_ROUTER_INDEX_MASKS); i++) {
+        if (masks[ifnum][i].count) {
+            canid_t mask = masks[ifnum][i].mask;
+            canid_t can_id = pkt->frame.can_id & mask;
+            res = _dispatch_list(pkt, buckets[ifnum][_bucket(can_id, mask)], mask);
+        }
+    }
+    if (res == 0) {
+        res = _dispatch_list(pkt, table[ifnum], 0);
+    }
     mutex_unlock(&lock);
-#if ENABLE_DEBUG
-    DEBUG("can_router_dispatch_rx: msg send to %d threads\n", msg_cnt);
-#endif
     if (atomic_load(&pkt->ref_count) == 0) {
         can_pkt_free(pkt);
     }
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_cbor_enc
+ * @{
+ *
+ * @file
+ * @brief       Streaming CBOR encoder implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "cbor_enc.h"
+
+#define MAJOR_UINT          (0x00U)
+#define MAJOR_NINT          (0x20U)
+#define MAJOR_BSTR          (0x40U)
+#define MAJOR_TSTR          (0x60U)
+#define MAJOR_ARRAY         (0x80U)
+#define MAJOR_MAP           (0xa0U)
+#define MAJOR_TAG           (0xc0U)
+#define MAJOR_SIMPLE        (0xe0U)
+
+#define INFO_U8             (24U)
+#define INFO_U16            (25U)
+#define INFO_U32            (26U)
+#define INFO_U64            (27U)
+#define INFO_INDEF          (31U)
+
+#define SIMPLE_FALSE        (20U)
+#define SIMPLE_TRUE         (21U)
+#define SIMPLE_NULL         (22U)
+
+static void _put(cbor_enc_t *enc, uint8_t byte)
+{
+    if (enc->len < enc->size) {
+        enc->buf[enc->len] = byte;
+    }
+    enc->len++;
+}
+
+static void _be(cbor_enc_t *enc, uint64_t val, unsigned bytes)
+{
+    /* network byte order */
+    while (bytes--) {
+        _put(enc, (uint8_t)(val >> (8 * bytes)));
+    }
+}
+
+static void _head(cbor_enc_t *enc, uint8_t major, uint32_t val)
+{
+    if (val < INFO_U8) {
+        _put(enc, major | val);
+        return;
+    }
+
+    unsigned bytes;
+
+    if (val <= UINT8_MAX) {
+        _put(enc, major | INFO_U8);
+        bytes = 1;
+    }
+    else if (val <= UINT16_MAX) {
+        _put(enc, major | INFO_U16);
+        bytes = 2;
+    }
+    else {
+        _put(enc, major | INFO_U32);
+        bytes = 4;
+    }
+    _be(enc, val, bytes);
+}
+
+static void _data(cbor_enc_t *enc, uint8_t major, const void *data,
+                  size_t len)
+{
+    _head(enc, major, len);
+    if (enc->len + len <= enc->size) {
+        memcpy(&enc->buf[enc->len], data, len);
+    }
+    enc->len += len;
+}
+
+ssize_t cbor_enc_len(const cbor_enc_t *enc)
+{
+    if (enc->buf && (enc->len > enc->size)) {
+        return -ENOBUFS;
+    }
+    return enc->len;
+}
+
+void cbor_enc_uint(cbor_enc_t *enc, uint32_t val)
+{
+    _head(enc, MAJOR_UINT, val);
+}
+
+void cbor_enc_int(cbor_enc_t *enc, int32_t val)
+{
+    if (val < 0) {
+        /* -1 - val, without overflow for INT32_MIN */
+        _head(enc, MAJOR_NINT, ~(uint32_t)val);
+    }
+    else {
+        _head(enc, MAJOR_UINT, val);
+    }
+}
+
+void cbor_enc_int64(cbor_enc_t *enc, int64_t val)
+{
+    uint8_t major = (val < 0) ? MAJOR_NINT : MAJOR_UINT;
+    uint64_t uval = (val < 0) ? ~(uint64_t)val : (uint64_t)val;
+
+    if (uval <= UINT32_MAX) {
+        _head(enc, major, (uint32_t)uval);
+    }
+    else {
+        _put(enc, major | INFO_U64);
+        _be(enc, uval, 8);
+    }
+}
+
+void cbor_enc_float(cbor_enc_t *enc, float val)
+{
+    union {
+        float f;
+        uint32_t u;
+    } bits = { .f = val };
+
+    _put(enc, MAJOR_SIMPLE | INFO_U32);
+    _be(enc, bits.u, 4);
+}
+
+void cbor_enc_bstr(cbor_enc_t *enc, const void *data, size_t len)
+{
+    _data(enc, MAJOR_BSTR, data, len);
+}
+
+void cbor_enc_tstr(cbor_enc_t *enc, const char *str, size_t len)
+{
+    _data(enc, MAJOR_TSTR, str, len);
+}
+
+void cbor_enc_array(cbor_enc_t *enc, uint32_t numof)
+{
+    _head(enc, MAJOR_ARRAY, numof);
+}
+
+void cbor_enc_map(cbor_enc_t *enc, uint32_t numof)
+{
+    _head(enc, MAJOR_MAP, numof);
+}
+
+void cbor_enc_array_indef(cbor_enc_t *enc)
+{
+    _put(enc, MAJOR_ARRAY | INFO_INDEF);
+}
+
+void cbor_enc_map_indef(cbor_enc_t *enc)
+{
+    _put(enc, MAJOR_MAP | INFO_INDEF);
+}
+
+void cbor_enc_break(cbor_enc_t *enc)
+{
+    _put(enc, MAJOR_SIMPLE | INFO_INDEF);
+}
+
+void cbor_enc_tag(cbor_enc_t *enc, uint32_t tag)
+{
+    _head(enc, MAJOR_TAG, tag);
+}
+
+void cbor_enc_bool(cbor_enc_t *enc, bool val)
+{
+    _put(enc, MAJOR_SIMPLE | (val ? SIMPLE_TRUE : SIMPLE_FALSE));
+}
+
+void cbor_enc_null(cbor_enc_t *enc)
+{
+    _put(enc, MAJOR_SIMPLE | SIMPLE_NULL);
+}
+
+void cbor_enc_decfrac(cbor_enc_t *enc, int32_t mantissa, int32_t exponent)
+{
+    cbor_enc_tag(enc, CBOR_ENC_TAG_DECFRAC);
+    cbor_enc_array(enc, 2);
+    cbor_enc_int(enc, exponent);
+    cbor_enc_int(enc, mantissa);
+}
@@ -34,6 +34,24 @@ using namespace std::chrono;
 
 namespace riot {
 
+namespace {
+
+// wakes a waiter, or queues it on its mutex if that is locked (wait
+// morphing), returns the priority to switch to or -1
+int wake(thread_t* thread) {
+  // a waiter may be signaled before it went to sleep
+  if (thread->status == STATUS_SLEEPING
+      && _mutex_morph(static_cast<mutex_t*>(thread->wait_data), thread)) {
+    // the waiter holds the mutex when woken
+    thread->wait_data = NULL;
+    return -1;
+  }
+  sched_set_status(thread, STATUS_PENDING);
+  return thread->priority;
+}
+
+} // namespace
+
 condition_variable::~condition_variable() { m_queue.first = NULL; }
 
 void condition_variable::notify_one() noexcept {
@@ -43,8 +61,7 @@ void condition_variable::notify_one() noexcept {
   if (head != NULL) {
     thread_t* other_thread = (thread_t*)sched_threads[head->data];
     if (other_thread) {
-      other_prio = other_thread->priority;
-      sched_set_status(other_thread, STATUS_PENDING);
+      other_prio = wake(other_thread);
     }
     head->data = -1u;
   }
@@ -66,8 +83,10 @@ void condition_variable::notify_all() noexcept {
     if (other_thread) {
       auto max_prio
         = [](int a, int b) { return (a < 0) ? b : ((a < b) ? a : b); };
-      other_prio = max_prio(other_prio, other_thread->priority);
-      sched_set_status(other_thread, STATUS_PENDING);
+      int prio = wake(other_thread);
+      if (prio >= 0) {
+        other_prio = max_prio(other_prio, prio);
+      }
     }
     head->data = -1u;
   }
@@ -78,6 +97,8 @@ void condition_variable::notify_all() noexcept {
 }
 
 void condition_variable::wait(unique_lock<mutex>& lock) noexcept {
+  thread_t* me = (thread_t*)sched_active_thread;
+  me->wait_data = lock.mutex()->native_handle();
   priority_queue_node_t n;
   n.priority = sched_active_thread->priority;
   n.data = sched_active_pid;
@@ -94,7 +115,9 @@ void condition_variable::wait(unique_lock<mutex>& lock) noexcept {
     priority_queue_remove(&m_queue, &n);
     irq_restore(old_state);
   }
-  mutex_lock(lock.mutex()->native_handle());
+  if (me->wait_data != NULL) {
+    mutex_lock(lock.mutex()->native_handle());
+  }
 }
 
 cv_status condition_variable::wait_until(unique_lock<mutex>& lock,
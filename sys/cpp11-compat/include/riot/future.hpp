@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Promise and future without allocation
+ * @see     <a href="http://en.cppreference.com/w/cpp/thread/promise">
+ *            std::promise and std::future
+ *          </a>
+ *
+ * The shared state lives in the promise, so the promise must outlive the
+ * future. The waiting thread sleeps on @ref RIOT_CPP_FUTURE_THREAD_FLAG,
+ * which requires the `core_thread_flags` module.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.cpp}
+ * static riot::promise<int> result;
+ * static riot::static_thread<1024> worker;
+ *
+ * riot::future<int> fut = result.get_future();
+ * worker.start([] { result.set_value(compute()); });
+ * int value = fut.get();
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @}
+ */
+
+#ifndef RIOT_FUTURE_HPP
+#define RIOT_FUTURE_HPP
+
+#include "irq.h"
+#include "sched.h"
+#include "thread_flags.h"
+
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <system_error>
+
+/**
+ * @brief Thread flag a thread waiting for a future sleeps on
+ */
+#ifndef RIOT_CPP_FUTURE_THREAD_FLAG
+#define RIOT_CPP_FUTURE_THREAD_FLAG (1u << 12)
+#endif
+
+namespace riot {
+
+template <class T>
+class future;
+
+namespace detail {
+
+/**
+ * @brief Synchronization of promise and future, independent of the type.
+ */
+class future_sync {
+public:
+  inline future_sync() noexcept
+      : m_waiter{nullptr}, m_ready{false}, m_retrieved{false} {}
+
+  /**
+   * @brief Marks the value as available and wakes the waiting thread.
+   */
+  inline void notify() noexcept {
+    unsigned state = irq_disable();
+    m_ready = true;
+    thread_t* waiter = m_waiter;
+    irq_restore(state);
+    if (waiter != nullptr) {
+      thread_flags_set(waiter, RIOT_CPP_FUTURE_THREAD_FLAG);
+    }
+  }
+  /**
+   * @brief Blocks until notify() was called.
+   */
+  inline void wait() noexcept {
+    unsigned state = irq_disable();
+    while (!m_ready) {
+      m_waiter = (thread_t*)sched_active_thread;
+      irq_restore(state);
+      thread_flags_wait_any(RIOT_CPP_FUTURE_THREAD_FLAG);
+      state = irq_disable();
+    }
+    m_waiter = nullptr;
+    irq_restore(state);
+  }
+  /**
+   * @brief Query if notify() was called.
+   */
+  inline bool ready() const noexcept { return m_ready; }
+  /**
+   * @brief Marks the future as retrieved.
+   */
+  inline void retrieve() {
+    if (m_retrieved) {
+      throw std::system_error(
+        std::make_error_code(std::errc::operation_not_permitted),
+        "Future already retrieved.");
+    }
+    m_retrieved = true;
+  }
+
+private:
+  thread_t* volatile m_waiter;
+  volatile bool m_ready;
+  bool m_retrieved;
+};
+
+} // namespace detail
+
+/**
+ * @brief Provides a value to a riot::future
+ *
+ * @tparam T  The type of the value, may be `void`.
+ */
+template <class T>
+class promise {
+  friend class future<T>;
+
+public:
+  inline promise() noexcept {}
+  promise(const promise&) = delete;
+  promise& operator=(const promise&) = delete;
+  inline ~promise() {
+    if (m_sync.ready()) {
+      value()->~value_type();
+    }
+  }
+
+  /**
+   * @brief Returns the future of this promise, only once.
+   * @throws std::system_error if the future was already retrieved.
+   */
+  future<T> get_future();
+  /**
+   * @brief Stores a value and wakes a thread waiting for the future.
+   * @throws std::system_error if a value was already set.
+   */
+  template <class... Args>
+  void set_value(Args&&... args) {
+    if (m_sync.ready()) {
+      throw std::system_error(
+        std::make_error_code(std::errc::operation_not_permitted),
+        "Promise already satisfied.");
+    }
+    new (&m_value) value_type(std::forward<Args>(args)...);
+    m_sync.notify();
+  }
+
+private:
+  // void is stored as an empty struct
+  struct empty {};
+  using value_type
+    = typename std::conditional<std::is_void<T>::value, empty, T>::type;
+
+  inline value_type* value() noexcept {
+    return reinterpret_cast<value_type*>(&m_value);
+  }
+
+  detail::future_sync m_sync;
+  typename std::aligned_storage<sizeof(value_type),
+                                alignof(value_type)>::type m_value;
+};
+
+/**
+ * @brief Waits for the value of a riot::promise
+ *
+ * @tparam T  The type of the value, may be `void`.
+ */
+template <class T>
+class future {
+  friend class promise<T>;
+
+public:
+  /**
+   * @brief Creates a future without shared state.
+   */
+  inline future() noexcept : m_promise{nullptr} {}
+  future(const future&) = delete;
+  future& operator=(const future&) = delete;
+  /**
+   * @brief Move constructor.
+   */
+  inline future(future&& other) noexcept : m_promise{other.m_promise} {
+    other.m_promise = nullptr;
+  }
+  /**
+   * @brief Move assignment operator.
+   */
+  inline future& operator=(future&& other) noexcept {
+    std::swap(m_promise, other.m_promise);
+    return *this;
+  }
+
+  /**
+   * @brief Query if the future refers to a shared state.
+   */
+  inline bool valid() const noexcept { return m_promise != nullptr; }
+  /**
+   * @brief Blocks until the value is available.
+   */
+  inline void wait() const noexcept { m_promise->m_sync.wait(); }
+  /**
+   * @brief Blocks until the value is available and moves it out. The future
+   *        is not valid() afterwards.
+   */
+  T get() {
+    promise<T>* p = m_promise;
+    p->m_sync.wait();
+    m_promise = nullptr;
+    return take(p);
+  }
+
+private:
+  explicit inline future(promise<T>* p) noexcept : m_promise{p} {}
+
+  template <class U = T>
+  static typename std::enable_if<!std::is_void<U>::value, U>::type
+  take(promise<T>* p) {
+    return std::move(*p->value());
+  }
+  template <class U = T>
+  static typename std::enable_if<std::is_void<U>::value, U>::type
+  take(promise<T>*) {}
+
+  promise<T>* m_promise;
+};
+
+template <class T>
+future<T> promise<T>::get_future() {
+  m_sync.retrieve();
+  return future<T>{this};
+}
+
+} // namespace riot
+
+#endif // RIOT_FUTURE_HPP
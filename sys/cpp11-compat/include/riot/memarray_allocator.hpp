@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Allocator for STL containers backed by a memarray pool
+ * @see     <a href="http://en.cppreference.com/w/cpp/named_req/Allocator">
+ *            Allocator requirements
+ *          </a>
+ *
+ * Allocations take constant time and have a fixed size, so node based
+ * containers (std::list, std::map, std::set, ...) do not fragment memory.
+ * The chunks must be large enough for the node type of the container, which
+ * is implementation defined; an allocation that does not fit throws
+ * std::bad_alloc. Requires the `memarray` module.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.cpp}
+ * static riot::memarray_pool<32, 16> pool;
+ *
+ * std::list<int, riot::memarray_allocator<int>> list{
+ *     riot::memarray_allocator<int>(pool)};
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @}
+ */
+
+#ifndef RIOT_MEMARRAY_ALLOCATOR_HPP
+#define RIOT_MEMARRAY_ALLOCATOR_HPP
+
+#include "irq.h"
+#include "memarray.h"
+
+#include <new>
+#include <cstddef>
+
+namespace riot {
+
+/**
+ * @brief Statically allocated memarray pool
+ *
+ * @tparam ChunkSize  Size of each chunk in bytes, rounded up to the
+ *                    alignment of `std::max_align_t`.
+ * @tparam Num        Number of chunks.
+ */
+template <std::size_t ChunkSize, std::size_t Num>
+class memarray_pool {
+public:
+  /**
+   * @brief Size of each chunk in bytes
+   */
+  static constexpr std::size_t chunk_size
+    = ((ChunkSize + alignof(std::max_align_t) - 1)
+       / alignof(std::max_align_t)) * alignof(std::max_align_t);
+
+  static_assert(ChunkSize >= sizeof(void*), "ChunkSize too small");
+  static_assert(Num > 0, "Num must not be 0");
+
+  memarray_pool() noexcept {
+    memarray_init(&m_mem, m_data, chunk_size, Num);
+  }
+
+  /**
+   * @brief Provides access to the native handle.
+   * @return The memarray of the pool.
+   */
+  inline memarray_t* native_handle() noexcept { return &m_mem; }
+
+private:
+  memarray_pool(const memarray_pool&);
+  memarray_pool& operator=(const memarray_pool&);
+
+  alignas(std::max_align_t) unsigned char m_data[chunk_size * Num];
+  memarray_t m_mem;
+};
+
+/**
+ * @brief Allocator handing out the chunks of a memarray pool
+ *
+ * Copies and rebound allocators share the pool. Allocating is interrupt safe.
+ *
+ * @tparam T  The type to allocate.
+ */
+template <class T>
+class memarray_allocator {
+public:
+  /**
+   * @brief The type to allocate.
+   */
+  using value_type = T;
+
+  /**
+   * @brief Creates an allocator for a memarray initialized elsewhere.
+   * @param mem  The memarray to allocate from.
+   */
+  explicit memarray_allocator(memarray_t* mem) noexcept : m_mem{mem} {}
+  /**
+   * @brief Creates an allocator for a pool.
+   * @param pool  The pool to allocate from.
+   */
+  template <std::size_t ChunkSize, std::size_t Num>
+  explicit memarray_allocator(memarray_pool<ChunkSize, Num>& pool) noexcept
+      : m_mem{pool.native_handle()} {}
+  /**
+   * @brief Creates an allocator for the pool of another one.
+   */
+  template <class U>
+  memarray_allocator(const memarray_allocator<U>& other) noexcept
+      : m_mem{other.native_handle()} {}
+
+  /**
+   * @brief Allocates a chunk of the pool.
+   * @param n  Number of objects of type @p T, must fit into one chunk.
+   * @throws std::bad_alloc if the objects do not fit or the pool is empty.
+   */
+  T* allocate(std::size_t n) {
+    if ((n > m_mem->size / sizeof(T))
+        || (alignof(T) > alignof(std::max_align_t))) {
+      throw std::bad_alloc();
+    }
+    unsigned state = irq_disable();
+    void* res = memarray_alloc(m_mem);
+    irq_restore(state);
+    if (res == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(res);
+  }
+  /**
+   * @brief Returns a chunk to the pool.
+   * @param ptr  A pointer returned by allocate().
+   */
+  void deallocate(T* ptr, std::size_t) noexcept {
+    unsigned state = irq_disable();
+    memarray_free(m_mem, ptr);
+    irq_restore(state);
+  }
+
+  /**
+   * @brief Provides access to the native handle.
+   * @return The memarray allocated from.
+   */
+  inline memarray_t* native_handle() const noexcept { return m_mem; }
+
+private:
+  memarray_t* m_mem;
+};
+
+/**
+ * @brief Allocators are equal if they share the pool.
+ */
+template <class T, class U>
+inline bool operator==(const memarray_allocator<T>& lhs,
+                       const memarray_allocator<U>& rhs) noexcept {
+  return lhs.native_handle() == rhs.native_handle();
+}
+
+/**
+ * @brief Allocators are equal if they share the pool.
+ */
+template <class T, class U>
+inline bool operator!=(const memarray_allocator<T>& lhs,
+                       const memarray_allocator<U>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+} // namespace riot
+
+#endif // RIOT_MEMARRAY_ALLOCATOR_HPP
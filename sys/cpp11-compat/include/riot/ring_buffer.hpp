@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   FIFO with a fixed capacity and storage inside the object
+ * @see     <a href="http://en.cppreference.com/w/cpp/container/queue">
+ *            std::queue
+ *          </a>
+ *
+ * Unlike ringbuffer_t and @ref sys_tsrb, it holds objects of any type. It is
+ * not synchronized, protect it with a riot::mutex if it is shared.
+ *
+ * @}
+ */
+
+#ifndef RIOT_RING_BUFFER_HPP
+#define RIOT_RING_BUFFER_HPP
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+namespace riot {
+
+/**
+ * @brief FIFO of up to @p N elements that never allocates
+ *
+ * @tparam T  The element type.
+ * @tparam N  The capacity.
+ */
+template <class T, std::size_t N>
+class ring_buffer {
+public:
+  using value_type = T;                   /**< element type */
+  using size_type = std::size_t;          /**< size type */
+  using reference = T&;                   /**< element reference */
+  using const_reference = const T&;       /**< const element reference */
+
+  static_assert(N > 0, "N must not be 0");
+
+  ring_buffer() noexcept : m_start{0}, m_size{0} {}
+  /**
+   * @brief Copies the elements of @p other.
+   */
+  ring_buffer(const ring_buffer& other) : m_start{0}, m_size{0} {
+    for (size_type i = 0; i < other.size(); i++) {
+      push_back(other[i]);
+    }
+  }
+  ~ring_buffer() { clear(); }
+
+  /**
+   * @brief Replaces the elements with copies of those of @p other.
+   */
+  ring_buffer& operator=(const ring_buffer& other) {
+    if (this != &other) {
+      clear();
+      for (size_type i = 0; i < other.size(); i++) {
+        push_back(other[i]);
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Accesses an element, 0 is the oldest one.
+   */
+  reference operator[](size_type pos) noexcept { return *slot(pos); }
+  /**
+   * @brief Accesses an element, 0 is the oldest one.
+   */
+  const_reference operator[](size_type pos) const noexcept {
+    return *slot(pos);
+  }
+  /**
+   * @brief Accesses the oldest element.
+   */
+  reference front() noexcept { return *slot(0); }
+  /**
+   * @brief Accesses the oldest element.
+   */
+  const_reference front() const noexcept { return *slot(0); }
+  /**
+   * @brief Accesses the newest element.
+   */
+  reference back() noexcept { return *slot(m_size - 1); }
+  /**
+   * @brief Accesses the newest element.
+   */
+  const_reference back() const noexcept { return *slot(m_size - 1); }
+
+  /** @brief Checks whether the buffer is empty. */
+  bool empty() const noexcept { return m_size == 0; }
+  /** @brief Checks whether the buffer is full. */
+  bool full() const noexcept { return m_size == N; }
+  /** @brief Returns the number of elements. */
+  size_type size() const noexcept { return m_size; }
+  /** @brief Returns the capacity. */
+  static constexpr size_type capacity() noexcept { return N; }
+
+  /**
+   * @brief Destroys all elements.
+   */
+  void clear() noexcept {
+    while (m_size > 0) {
+      pop_front();
+    }
+  }
+  /**
+   * @brief Appends a copy of @p value.
+   * @throws std::length_error if the buffer is full.
+   */
+  void push_back(const T& value) { emplace_back(value); }
+  /**
+   * @brief Appends @p value.
+   * @throws std::length_error if the buffer is full.
+   */
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+  /**
+   * @brief Appends an element constructed from @p args.
+   * @throws std::length_error if the buffer is full.
+   */
+  template <class... Args>
+  reference emplace_back(Args&&... args) {
+    if (full()) {
+      throw std::length_error("riot::ring_buffer");
+    }
+    T* res = new (slot(m_size)) T(std::forward<Args>(args)...);
+    m_size++;
+    return *res;
+  }
+  /**
+   * @brief Appends a copy of @p value, dropping the oldest element if the
+   *        buffer is full.
+   */
+  void push_back_overwrite(const T& value) {
+    if (full()) {
+      pop_front();
+    }
+    emplace_back(value);
+  }
+  /**
+   * @brief Removes the oldest element.
+   * @pre   The buffer is not empty.
+   */
+  void pop_front() noexcept {
+    slot(0)->~T();
+    m_start = (m_start + 1) % N;
+    m_size--;
+  }
+
+private:
+  T* slot(size_type pos) noexcept {
+    return reinterpret_cast<T*>(&m_data[(m_start + pos) % N]);
+  }
+  const T* slot(size_type pos) const noexcept {
+    return reinterpret_cast<const T*>(&m_data[(m_start + pos) % N]);
+  }
+
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_data[N];
+  size_type m_start;
+  size_type m_size;
+};
+
+} // namespace riot
+
+#endif // RIOT_RING_BUFFER_HPP
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Thread with its stack inside the object
+ *
+ * Unlike riot::thread, which allocates its stack and the callable with
+ * `new`, riot::static_thread holds both in the object. The callable and its
+ * arguments are moved to the bottom of the stack memory, the thread runs on
+ * the rest. Define it as a static or global object, it can be started again
+ * once it was joined.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.cpp}
+ * static riot::static_thread<1024> worker;
+ *
+ * worker.start([](int n) { do_work(n); }, 42);
+ * worker.join();
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @}
+ */
+
+#ifndef RIOT_STATIC_THREAD_HPP
+#define RIOT_STATIC_THREAD_HPP
+
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+
+#include <new>
+#include <tuple>
+#include <cstddef>
+#include <utility>
+#include <exception>
+#include <type_traits>
+#include <system_error>
+
+#include "riot/thread.hpp"
+#include "riot/detail/thread_util.hpp"
+
+namespace riot {
+
+/**
+ * @brief Thread with a statically allocated stack
+ *
+ * @tparam StackSize  Size of the stack memory, including the callable.
+ * @tparam Prio       Priority of the thread.
+ */
+template <std::size_t StackSize = THREAD_STACKSIZE_MAIN,
+          uint8_t Prio = THREAD_PRIORITY_MAIN - 1>
+class static_thread {
+public:
+  /**
+   * @brief The id is of type `thread_id`.
+   */
+  using id = thread_id;
+  /**
+   * @brief The native handle type is the `kernel_pid_t` of RIOT.
+   */
+  using native_handle_type = kernel_pid_t;
+
+  inline static_thread() noexcept
+      : m_handle{thread_uninitialized}, m_joiner{thread_uninitialized},
+        m_done{true} {}
+  /**
+   * @brief Create and start a thread from a functor and arguments for it.
+   * @param[in] f     Functor to run as a thread.
+   * @param[in] args  Arguments passed to the functor.
+   */
+  template <class F, class... Args>
+  explicit static_thread(F&& f, Args&&... args) : static_thread() {
+    start(std::forward<F>(f), std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief The thread runs on the object, it can be neither copied nor
+   *        moved.
+   */
+  static_thread(const static_thread&) = delete;
+  /**
+   * @brief The thread runs on the object, it can be neither copied nor
+   *        moved.
+   */
+  static_thread& operator=(const static_thread&) = delete;
+
+  inline ~static_thread() {
+    if (joinable() || !m_done) {
+      std::terminate();
+    }
+  }
+
+  /**
+   * @brief Start the thread.
+   * @param[in] f     Functor to run as a thread.
+   * @param[in] args  Arguments passed to the functor.
+   * @throws std::system_error if the thread is still running or joinable.
+   */
+  template <class F, class... Args>
+  void start(F&& f, Args&&... args);
+
+  /**
+   * @brief Query if the thread is joinable.
+   * @return  `true` if the thread is joinable, `false` otherwise.
+   */
+  inline bool joinable() const noexcept {
+    return m_handle != thread_uninitialized;
+  }
+  /**
+   * @brief Block until the thread finishes. Leads to an error if the thread is
+   *        not joinable or a thread joins itself.
+   */
+  void join();
+  /**
+   * @brief Detaches the thread from the object. The object can not be started
+   *        again before the thread finished.
+   */
+  void detach();
+  /**
+   * @brief Returns the id of the thread.
+   */
+  inline id get_id() const noexcept { return thread_id{m_handle}; }
+  /**
+   * @brief Returns the native handle to the thread.
+   */
+  inline native_handle_type native_handle() noexcept { return m_handle; }
+
+private:
+  template <class Tuple>
+  static void* proxy(void* arg);
+  // arguments are passed as rvalues, like std::thread does
+  template <class Tuple, long... Is>
+  static void invoke(Tuple& tup, detail::int_list<Is...>) {
+    std::get<0>(tup)(std::move(std::get<Is>(tup))...);
+  }
+
+  alignas(std::max_align_t) char m_stack[StackSize];
+  kernel_pid_t m_handle;
+  kernel_pid_t m_joiner;
+  volatile bool m_done;
+};
+
+/** @cond INTERNAL */
+template <std::size_t StackSize, uint8_t Prio>
+template <class Tuple>
+void* static_thread<StackSize, Prio>::proxy(void* arg) {
+  auto self = static_cast<static_thread*>(arg);
+  {
+    auto p = reinterpret_cast<Tuple*>(self->m_stack);
+    auto indices = detail::get_indices<std::tuple_size<Tuple>::value, 1>();
+    try {
+      invoke(*p, indices);
+    }
+    catch (...) {
+      // nop
+    }
+    p->~Tuple();
+  }
+  // wake the joiner without switching to it: the thread must not run again
+  // once the joiner may reuse the stack
+  irq_disable();
+  self->m_done = true;
+  if (self->m_joiner != thread_uninitialized) {
+    thread_t* joiner = (thread_t*)thread_get(self->m_joiner);
+    if ((joiner != nullptr) && (joiner->status == STATUS_SLEEPING)) {
+      sched_set_status(joiner, STATUS_PENDING);
+    }
+  }
+  sched_task_exit();
+  return nullptr;
+}
+/** @endcond */
+
+template <std::size_t StackSize, uint8_t Prio>
+template <class F, class... Args>
+void static_thread<StackSize, Prio>::start(F&& f, Args&&... args) {
+  using namespace std;
+  using func_and_args
+    = tuple<typename decay<F>::type, typename decay<Args>::type...>;
+  constexpr size_t offset
+    = ((sizeof(func_and_args) + alignof(max_align_t) - 1)
+       / alignof(max_align_t)) * alignof(max_align_t);
+  static_assert(alignof(func_and_args) <= alignof(max_align_t),
+                "callable is overaligned");
+  static_assert(offset < StackSize,
+                "StackSize too small for the callable");
+
+  if (joinable() || !m_done) {
+    throw system_error(make_error_code(errc::resource_unavailable_try_again),
+                       "Thread still running.");
+  }
+  auto p = new (m_stack) func_and_args(forward<F>(f), forward<Args>(args)...);
+  m_done = false;
+  m_joiner = thread_uninitialized;
+  m_handle = thread_create(m_stack + offset, StackSize - offset, Prio,
+                           THREAD_CREATE_STACKTEST,
+                           &static_thread::proxy<func_and_args>, this,
+                           "riot_cpp_thread");
+  if (m_handle < 0) {
+    m_handle = thread_uninitialized;
+    m_done = true;
+    p->~func_and_args();
+    throw system_error(make_error_code(errc::resource_unavailable_try_again),
+                       "Failed to create thread.");
+  }
+}
+
+template <std::size_t StackSize, uint8_t Prio>
+void static_thread<StackSize, Prio>::join() {
+  if (get_id() == this_thread::get_id()) {
+    throw std::system_error(
+      std::make_error_code(std::errc::resource_deadlock_would_occur),
+      "Joining this leads to a deadlock.");
+  }
+  if (!joinable()) {
+    throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                            "Can not join an unjoinable thread.");
+  }
+  unsigned state = irq_disable();
+  while (!m_done) {
+    m_joiner = thread_getpid();
+    sched_set_status((thread_t*)sched_active_thread, STATUS_SLEEPING);
+    irq_restore(state);
+    thread_yield_higher();
+    state = irq_disable();
+  }
+  m_joiner = thread_uninitialized;
+  irq_restore(state);
+  m_handle = thread_uninitialized;
+}
+
+template <std::size_t StackSize, uint8_t Prio>
+void static_thread<StackSize, Prio>::detach() {
+  if (!joinable()) {
+    throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                            "Can not detach an unjoinable thread.");
+  }
+  m_handle = thread_uninitialized;
+}
+
+} // namespace riot
+
+#endif // RIOT_STATIC_THREAD_HPP
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Vector with a fixed capacity and storage inside the object
+ * @see     <a href="http://en.cppreference.com/w/cpp/container/vector">
+ *            std::vector
+ *          </a>
+ *
+ * @}
+ */
+
+#ifndef RIOT_STATIC_VECTOR_HPP
+#define RIOT_STATIC_VECTOR_HPP
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+
+namespace riot {
+
+/**
+ * @brief Subset of std::vector that never allocates
+ *
+ * Up to @p N elements are constructed in place in the object, operations
+ * exceeding the capacity throw std::length_error.
+ *
+ * @tparam T  The element type.
+ * @tparam N  The capacity.
+ */
+template <class T, std::size_t N>
+class static_vector {
+public:
+  using value_type = T;                   /**< element type */
+  using size_type = std::size_t;          /**< size type */
+  using reference = T&;                   /**< element reference */
+  using const_reference = const T&;       /**< const element reference */
+  using iterator = T*;                    /**< iterator */
+  using const_iterator = const T*;        /**< const iterator */
+  using reverse_iterator
+    = std::reverse_iterator<iterator>;    /**< reverse iterator */
+  using const_reverse_iterator
+    = std::reverse_iterator<const_iterator>; /**< const reverse iterator */
+
+  static_vector() noexcept : m_size{0} {}
+  /**
+   * @brief Creates a vector of @p count copies of @p value.
+   */
+  static_vector(size_type count, const T& value = T()) : m_size{0} {
+    check_capacity(count);
+    while (m_size < count) {
+      push_back(value);
+    }
+  }
+  /**
+   * @brief Creates a vector holding the elements of @p init.
+   */
+  static_vector(std::initializer_list<T> init) : m_size{0} {
+    check_capacity(init.size());
+    for (const T& value : init) {
+      push_back(value);
+    }
+  }
+  /**
+   * @brief Copies the elements of @p other.
+   */
+  static_vector(const static_vector& other) : m_size{0} {
+    for (const T& value : other) {
+      push_back(value);
+    }
+  }
+  /**
+   * @brief Moves the elements of @p other, @p other keeps its size.
+   */
+  static_vector(static_vector&& other) : m_size{0} {
+    for (T& value : other) {
+      push_back(std::move(value));
+    }
+  }
+  ~static_vector() { clear(); }
+
+  /**
+   * @brief Replaces the elements with copies of those of @p other.
+   */
+  static_vector& operator=(const static_vector& other) {
+    if (this != &other) {
+      clear();
+      for (const T& value : other) {
+        push_back(value);
+      }
+    }
+    return *this;
+  }
+  /**
+   * @brief Replaces the elements with those moved from @p other.
+   */
+  static_vector& operator=(static_vector&& other) {
+    if (this != &other) {
+      clear();
+      for (T& value : other) {
+        push_back(std::move(value));
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Accesses an element with bounds checking.
+   * @throws std::out_of_range if @p pos is not less than size().
+   */
+  reference at(size_type pos) {
+    if (pos >= m_size) {
+      throw std::out_of_range("riot::static_vector::at");
+    }
+    return data()[pos];
+  }
+  /**
+   * @copydoc at(size_type)
+   */
+  const_reference at(size_type pos) const {
+    if (pos >= m_size) {
+      throw std::out_of_range("riot::static_vector::at");
+    }
+    return data()[pos];
+  }
+  /**
+   * @brief Accesses an element.
+   */
+  reference operator[](size_type pos) noexcept { return data()[pos]; }
+  /**
+   * @brief Accesses an element.
+   */
+  const_reference operator[](size_type pos) const noexcept {
+    return data()[pos];
+  }
+  /**
+   * @brief Accesses the first element.
+   */
+  reference front() noexcept { return data()[0]; }
+  /**
+   * @brief Accesses the first element.
+   */
+  const_reference front() const noexcept { return data()[0]; }
+  /**
+   * @brief Accesses the last element.
+   */
+  reference back() noexcept { return data()[m_size - 1]; }
+  /**
+   * @brief Accesses the last element.
+   */
+  const_reference back() const noexcept { return data()[m_size - 1]; }
+  /**
+   * @brief Accesses the underlying array.
+   */
+  T* data() noexcept { return reinterpret_cast<T*>(m_data); }
+  /**
+   * @brief Accesses the underlying array.
+   */
+  const T* data() const noexcept {
+    return reinterpret_cast<const T*>(m_data);
+  }
+
+  /** @brief Iterator to the first element. */
+  iterator begin() noexcept { return data(); }
+  /** @brief Iterator to the first element. */
+  const_iterator begin() const noexcept { return data(); }
+  /** @brief Iterator to the first element. */
+  const_iterator cbegin() const noexcept { return data(); }
+  /** @brief Iterator past the last element. */
+  iterator end() noexcept { return data() + m_size; }
+  /** @brief Iterator past the last element. */
+  const_iterator end() const noexcept { return data() + m_size; }
+  /** @brief Iterator past the last element. */
+  const_iterator cend() const noexcept { return data() + m_size; }
+  /** @brief Reverse iterator to the last element. */
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  /** @brief Reverse iterator to the last element. */
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  /** @brief Reverse iterator before the first element. */
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  /** @brief Reverse iterator before the first element. */
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  /** @brief Checks whether the vector is empty. */
+  bool empty() const noexcept { return m_size == 0; }
+  /** @brief Checks whether the vector is full. */
+  bool full() const noexcept { return m_size == N; }
+  /** @brief Returns the number of elements. */
+  size_type size() const noexcept { return m_size; }
+  /** @brief Returns the capacity. */
+  static constexpr size_type max_size() noexcept { return N; }
+  /** @brief Returns the capacity. */
+  static constexpr size_type capacity() noexcept { return N; }
+
+  /**
+   * @brief Destroys all elements.
+   */
+  void clear() noexcept {
+    while (m_size > 0) {
+      pop_back();
+    }
+  }
+  /**
+   * @brief Appends a copy of @p value.
+   * @throws std::length_error if the vector is full.
+   */
+  void push_back(const T& value) { emplace_back(value); }
+  /**
+   * @brief Appends @p value.
+   * @throws std::length_error if the vector is full.
+   */
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+  /**
+   * @brief Appends an element constructed from @p args.
+   * @throws std::length_error if the vector is full.
+   */
+  template <class... Args>
+  reference emplace_back(Args&&... args) {
+    check_capacity(m_size + 1);
+    T* res = new (data() + m_size) T(std::forward<Args>(args)...);
+    m_size++;
+    return *res;
+  }
+  /**
+   * @brief Removes the last element.
+   * @pre   The vector is not empty.
+   */
+  void pop_back() noexcept {
+    data()[--m_size].~T();
+  }
+  /**
+   * @brief Removes the element at @p pos, keeping the order.
+   * @return Iterator following the removed element.
+   */
+  iterator erase(const_iterator pos) {
+    iterator res = begin() + (pos - cbegin());
+    for (iterator it = res; (it + 1) != end(); ++it) {
+      *it = std::move(*(it + 1));
+    }
+    pop_back();
+    return res;
+  }
+
+private:
+  static void check_capacity(size_type size) {
+    if (size > N) {
+      throw std::length_error("riot::static_vector");
+    }
+  }
+
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_data[N];
+  size_type m_size;
+};
+
+} // namespace riot
+
+#endif // RIOT_STATIC_VECTOR_HPP
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Allocator for STL containers backed by a TLSF heap
+ * @see     <a href="http://en.cppreference.com/w/cpp/named_req/Allocator">
+ *            Allocator requirements
+ *          </a>
+ *
+ * TLSF allocates and frees in bounded time and keeps fragmentation low, so
+ * containers with variable sized allocations (std::vector, std::string, ...)
+ * can get a heap of their own, apart from the system heap. Requires the
+ * `tlsf` package.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.cpp}
+ * static riot::tlsf_pool<4096> heap;
+ *
+ * std::vector<int, riot::tlsf_allocator<int>> vec{
+ *     riot::tlsf_allocator<int>(heap)};
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @}
+ */
+
+#ifndef RIOT_TLSF_ALLOCATOR_HPP
+#define RIOT_TLSF_ALLOCATOR_HPP
+
+#include "irq.h"
+#include "tlsf.h"
+
+#include <new>
+#include <cstddef>
+
+namespace riot {
+
+/**
+ * @brief Statically allocated TLSF heap
+ *
+ * @tparam Bytes  Size of the heap in bytes, including the TLSF control
+ *                structure (see tlsf_size()).
+ */
+template <std::size_t Bytes>
+class tlsf_pool {
+public:
+  tlsf_pool() noexcept {
+    m_tlsf = tlsf_create_with_pool(m_data, sizeof(m_data));
+  }
+
+  /**
+   * @brief Provides access to the native handle.
+   * @return The TLSF instance of the heap.
+   */
+  inline tlsf_t native_handle() noexcept { return m_tlsf; }
+
+private:
+  tlsf_pool(const tlsf_pool&);
+  tlsf_pool& operator=(const tlsf_pool&);
+
+  alignas(std::max_align_t) unsigned char m_data[Bytes];
+  tlsf_t m_tlsf;
+};
+
+/**
+ * @brief Allocator taking memory from a TLSF heap
+ *
+ * Copies and rebound allocators share the heap. Allocating is interrupt safe.
+ *
+ * @tparam T  The type to allocate.
+ */
+template <class T>
+class tlsf_allocator {
+public:
+  /**
+   * @brief The type to allocate.
+   */
+  using value_type = T;
+
+  /**
+   * @brief Creates an allocator for a TLSF instance created elsewhere.
+   * @param tlsf  The TLSF instance to allocate from.
+   */
+  explicit tlsf_allocator(tlsf_t tlsf) noexcept : m_tlsf{tlsf} {}
+  /**
+   * @brief Creates an allocator for a heap.
+   * @param pool  The heap to allocate from.
+   */
+  template <std::size_t Bytes>
+  explicit tlsf_allocator(tlsf_pool<Bytes>& pool) noexcept
+      : m_tlsf{pool.native_handle()} {}
+  /**
+   * @brief Creates an allocator for the heap of another one.
+   */
+  template <class U>
+  tlsf_allocator(const tlsf_allocator<U>& other) noexcept
+      : m_tlsf{other.native_handle()} {}
+
+  /**
+   * @brief Allocates memory for @p n objects.
+   * @throws std::bad_alloc if the heap is exhausted.
+   */
+  T* allocate(std::size_t n) {
+    if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+    unsigned state = irq_disable();
+    void* res = tlsf_memalign(m_tlsf, alignof(T), n * sizeof(T));
+    irq_restore(state);
+    if (res == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(res);
+  }
+  /**
+   * @brief Returns memory to the heap.
+   * @param ptr  A pointer returned by allocate().
+   */
+  void deallocate(T* ptr, std::size_t) noexcept {
+    unsigned state = irq_disable();
+    tlsf_free(m_tlsf, ptr);
+    irq_restore(state);
+  }
+
+  /**
+   * @brief Provides access to the native handle.
+   * @return The TLSF instance allocated from.
+   */
+  inline tlsf_t native_handle() const noexcept { return m_tlsf; }
+
+private:
+  tlsf_t m_tlsf;
+};
+
+/**
+ * @brief Allocators are equal if they share the heap.
+ */
+template <class T, class U>
+inline bool operator==(const tlsf_allocator<T>& lhs,
+                       const tlsf_allocator<U>& rhs) noexcept {
+  return lhs.native_handle() == rhs.native_handle();
+}
+
+/**
+ * @brief Allocators are equal if they share the heap.
+ */
+template <class T, class U>
+inline bool operator!=(const tlsf_allocator<T>& lhs,
+                       const tlsf_allocator<U>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+} // namespace riot
+
+#endif // RIOT_TLSF_ALLOCATOR_HPP
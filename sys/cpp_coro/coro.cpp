@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_cpp_coro
+ * @{
+ *
+ * @file
+ * @brief   Coroutine task and awaitable implementation
+ *
+ * @}
+ */
+
+#include <cerrno>
+
+#include "riot/coro.hpp"
+
+namespace riot {
+namespace coro {
+
+void task::on_resume(event_t* event) {
+  auto res = reinterpret_cast<resume_event*>(event);
+  handle_type::from_promise(*res->promise).resume();
+}
+
+void spawn(event_queue_t* queue, task t) noexcept {
+  task::handle_type handle = t.m_handle;
+  t.m_handle = nullptr;
+  handle.promise().queue = queue;
+  handle.promise().schedule();
+}
+
+void sleep_for::on_timeout(void* arg) {
+  static_cast<task::promise_type*>(arg)->schedule();
+}
+
+void event_awaiter::on_event(event_t* event) {
+  event_awaiter* self = reinterpret_cast<owned_event*>(event)->self;
+  if (self->m_waiter == nullptr) {
+    self->m_posted = true;
+    return;
+  }
+  task::promise_type* waiter = self->m_waiter;
+  self->m_waiter = nullptr;
+  /* resumes from the task's own queue, even if posted to another one */
+  waiter->schedule();
+}
+
+void poll_awaitable::await_suspend(task::handle_type h) noexcept {
+  m_waiter = &h.promise();
+  arm();
+}
+
+void poll_awaitable::arm() noexcept {
+  m_timer.callback = &poll_awaitable::on_timeout;
+  m_timer.arg = this;
+  xtimer_set(&m_timer, CPP_CORO_POLL_INTERVAL);
+}
+
+void poll_awaitable::on_timeout(void* arg) {
+  auto self = static_cast<poll_awaitable*>(arg);
+  event_post(self->m_waiter->queue, &self->m_event.super);
+}
+
+void poll_awaitable::on_retry(event_t* event) {
+  poll_awaitable* self = reinterpret_cast<owned_event*>(event)->self;
+  if (!self->try_complete()) {
+    self->arm();
+    return;
+  }
+  /* the task may end and free the awaitable */
+  task::handle_type::from_promise(*self->m_waiter).resume();
+}
+
+#ifdef MODULE_SOCK_UDP
+bool recv::try_complete() noexcept {
+  m_res = sock_udp_recv(&m_sock, m_data, m_max_len, 0, m_remote);
+  if (m_res != -EAGAIN) {
+    return true;
+  }
+  if ((m_timeout != SOCK_NO_TIMEOUT) &&
+      ((xtimer_now_usec() - m_start) >= m_timeout)) {
+    m_res = -ETIMEDOUT;
+    return true;
+  }
+  return false;
+}
+#endif
+
+} // namespace coro
+} // namespace riot
@@ -0,0 +1,360 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_cpp_coro
+ * @{
+ *
+ * @file
+ * @brief   Coroutine task type and awaitables
+ *
+ * @}
+ */
+
+#ifndef RIOT_CORO_HPP
+#define RIOT_CORO_HPP
+
+#include <cstdint>
+#include <utility>
+#include <coroutine>
+#include <exception>
+#include <sys/types.h>
+
+#include "event.h"
+#include "mutex.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+#ifdef MODULE_SOCK_UDP
+#include "net/sock.h"
+
+/* net/sock/udp.h pulls in the network stack's headers, which do not compile
+ * as C++ with every stack, so only what is needed here is declared */
+extern "C" {
+typedef struct _sock_tl_ep sock_udp_ep_t;
+typedef struct sock_udp sock_udp_t;
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote);
+}
+#endif
+
+/**
+ * @brief Interval in microseconds in which polling awaitables retry
+ */
+#ifndef CPP_CORO_POLL_INTERVAL
+#define CPP_CORO_POLL_INTERVAL  (10U * US_PER_MS)
+#endif
+
+namespace riot {
+namespace coro {
+
+/**
+ * @brief A coroutine running on an event queue
+ *
+ * A task starts when passed to spawn() and frees itself when it returns.
+ */
+class task {
+public:
+  struct promise_type;
+  /**
+   * @brief Handle type of the coroutine.
+   */
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  /** @cond INTERNAL */
+  struct resume_event {
+    event_t super;
+    promise_type* promise;
+  };
+
+  struct promise_type {
+    promise_type() noexcept : queue{nullptr}, resume{{}, this} {
+      resume.super.handler = &task::on_resume;
+    }
+    task get_return_object() noexcept {
+      return task{handle_type::from_promise(*this)};
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+
+    /* resumes the coroutine from the queue, may be called from ISRs */
+    void schedule() noexcept { event_post(queue, &resume.super); }
+
+    event_queue_t* queue;
+    resume_event resume;
+  };
+  /** @endcond */
+
+  task(const task&) = delete;
+  task& operator=(const task&) = delete;
+  /**
+   * @brief Move constructor.
+   */
+  inline task(task&& other) noexcept : m_handle{other.m_handle} {
+    other.m_handle = nullptr;
+  }
+  /**
+   * @brief Frees the coroutine, if it was never spawned.
+   */
+  inline ~task() {
+    if (m_handle) {
+      m_handle.destroy();
+    }
+  }
+
+  friend void spawn(event_queue_t* queue, task t) noexcept;
+
+private:
+  explicit inline task(handle_type handle) noexcept : m_handle{handle} {}
+
+  static void on_resume(event_t* event);
+
+  handle_type m_handle;
+};
+
+/**
+ * @brief Starts a task
+ *
+ * The task runs in the thread calling event_loop() on @p queue.
+ *
+ * @param[in] queue   The queue to run the task on.
+ * @param[in] t       The task.
+ */
+void spawn(event_queue_t* queue, task t) noexcept;
+
+/**
+ * @brief Lets the other events and tasks of the queue run
+ */
+class yield {
+public:
+  /** @cond INTERNAL */
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(task::handle_type h) noexcept { h.promise().schedule(); }
+  void await_resume() const noexcept {}
+  /** @endcond */
+};
+
+/**
+ * @brief Suspends the task for a time
+ */
+class sleep_for {
+public:
+  /**
+   * @param[in] us  The time to sleep in microseconds.
+   */
+  explicit inline sleep_for(uint32_t us) noexcept : m_timer{}, m_us{us} {}
+
+  /** @cond INTERNAL */
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(task::handle_type h) noexcept {
+    m_timer.callback = &sleep_for::on_timeout;
+    m_timer.arg = &h.promise();
+    xtimer_set(&m_timer, m_us);
+  }
+  void await_resume() const noexcept {}
+  /** @endcond */
+
+private:
+  static void on_timeout(void* arg);
+
+  xtimer_t m_timer;
+  uint32_t m_us;
+};
+
+/**
+ * @brief Suspends the task until an event is posted
+ *
+ * Post event() to the queue the task runs on, e.g. from an ISR. A post
+ * before the task awaits it is remembered.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.cpp}
+ * static riot::coro::event_awaiter button;
+ *
+ * void button_isr(void *arg) { event_post(&queue, button.event()); }
+ *
+ * riot::coro::task handle_button(void)
+ * {
+ *     while (1) {
+ *         co_await button;
+ *         ...
+ *     }
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class event_awaiter {
+public:
+  inline event_awaiter() noexcept : m_event{{}, this}, m_waiter{nullptr},
+                                    m_posted{false} {
+    m_event.super.handler = &event_awaiter::on_event;
+  }
+  event_awaiter(const event_awaiter&) = delete;
+  event_awaiter& operator=(const event_awaiter&) = delete;
+
+  /**
+   * @brief Returns the event to post.
+   */
+  inline event_t* event() noexcept { return &m_event.super; }
+
+  /** @cond INTERNAL */
+  bool await_ready() noexcept {
+    bool res = m_posted;
+    m_posted = false;
+    return res;
+  }
+  void await_suspend(task::handle_type h) noexcept { m_waiter = &h.promise(); }
+  void await_resume() const noexcept {}
+  /** @endcond */
+
+private:
+  struct owned_event {
+    event_t super;
+    event_awaiter* self;
+  };
+
+  static void on_event(event_t* event);
+
+  owned_event m_event;
+  task::promise_type* m_waiter;
+  bool m_posted;
+};
+
+/**
+ * @brief Base of awaitables that retry every @ref CPP_CORO_POLL_INTERVAL
+ */
+class poll_awaitable {
+public:
+  poll_awaitable(const poll_awaitable&) = delete;
+  poll_awaitable& operator=(const poll_awaitable&) = delete;
+
+  /** @cond INTERNAL */
+  bool await_ready() noexcept { return try_complete(); }
+  void await_suspend(task::handle_type h) noexcept;
+  /** @endcond */
+
+protected:
+  inline poll_awaitable() noexcept : m_event{{}, this}, m_timer{},
+                                     m_waiter{nullptr} {
+    m_event.super.handler = &poll_awaitable::on_retry;
+  }
+  /**
+   * @brief Tries to complete the operation without blocking.
+   * @return  `true` if the task can continue.
+   */
+  virtual bool try_complete() noexcept = 0;
+
+private:
+  struct owned_event {
+    event_t super;
+    poll_awaitable* self;
+  };
+
+  static void on_timeout(void* arg);
+  static void on_retry(event_t* event);
+  void arm() noexcept;
+
+  owned_event m_event;
+  xtimer_t m_timer;
+  task::promise_type* m_waiter;
+};
+
+/**
+ * @brief Suspends the task until it locked a mutex
+ *
+ * The mutex is owned by the thread of the queue, unlock it from the task.
+ */
+class lock final : public poll_awaitable {
+public:
+  /**
+   * @param[in] mutex   The mutex to lock.
+   */
+  explicit inline lock(mutex_t& mutex) noexcept : m_mutex{mutex} {}
+
+  /** @cond INTERNAL */
+  void await_resume() const noexcept {}
+  /** @endcond */
+
+protected:
+  bool try_complete() noexcept override { return mutex_trylock(&m_mutex); }
+
+private:
+  mutex_t& m_mutex;
+};
+
+/**
+ * @brief Suspends the task until one of a set of thread flags is set
+ *
+ * The flags are those of the thread of the queue and must not contain
+ * @ref THREAD_FLAG_EVENT. `co_await` returns and clears the flags set.
+ */
+class flags_any final : public poll_awaitable {
+public:
+  /**
+   * @param[in] mask    The flags to wait for.
+   */
+  explicit inline flags_any(thread_flags_t mask) noexcept
+      : m_mask{mask}, m_flags{0} {}
+
+  /** @cond INTERNAL */
+  thread_flags_t await_resume() const noexcept { return m_flags; }
+  /** @endcond */
+
+protected:
+  bool try_complete() noexcept override {
+    m_flags = thread_flags_clear(m_mask);
+    return m_flags != 0;
+  }
+
+private:
+  thread_flags_t m_mask;
+  thread_flags_t m_flags;
+};
+
+#if defined(MODULE_SOCK_UDP) || defined(DOXYGEN)
+/**
+ * @brief Suspends the task until a UDP packet was received
+ *
+ * `co_await` returns the result of sock_udp_recv().
+ */
+class recv final : public poll_awaitable {
+public:
+  /**
+   * @param[in] sock      The sock to receive from.
+   * @param[out] data     Buffer for the payload.
+   * @param[in] max_len   Size of @p data.
+   * @param[in] timeout   Timeout in microseconds or @ref SOCK_NO_TIMEOUT.
+   * @param[out] remote   Remote end point of the packet, may be NULL.
+   */
+  inline recv(sock_udp_t& sock, void* data, size_t max_len,
+              uint32_t timeout = SOCK_NO_TIMEOUT,
+              sock_udp_ep_t* remote = nullptr) noexcept
+      : m_sock{sock}, m_data{data}, m_max_len{max_len}, m_timeout{timeout},
+        m_start{xtimer_now_usec()}, m_remote{remote}, m_res{0} {}
+
+  /** @cond INTERNAL */
+  ssize_t await_resume() const noexcept { return m_res; }
+  /** @endcond */
+
+protected:
+  bool try_complete() noexcept override;
+
+private:
+  sock_udp_t& m_sock;
+  void* m_data;
+  size_t m_max_len;
+  uint32_t m_timeout;
+  uint32_t m_start;
+  sock_udp_ep_t* m_remote;
+  ssize_t m_res;
+};
+#endif
+
+} // namespace coro
+} // namespace riot
+
+#endif // RIOT_CORO_HPP
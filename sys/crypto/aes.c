@@ -37,18 +37,33 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include "kernel_defines.h"
 #include "crypto/aes.h"
 #include "crypto/ciphers.h"
+#ifdef MODULE_PERIPH_HWCRYPTO
+#include "periph/hwcrypto.h"
+#endif
 
 /**
  * Interface to the aes cipher
  */
+/**
+ * @brief   Run the AES rounds from fast memory with `fastmem_crypto`
+ */
+#ifdef MODULE_FASTMEM_CRYPTO
+#define AES_FASTCODE    FASTCODE
+#else
+#define AES_FASTCODE
+#endif
+
 static const cipher_interface_t aes_interface = {
     AES_BLOCK_SIZE,
     AES_KEY_SIZE,
     aes_init,
     aes_encrypt,
-    aes_decrypt
+    aes_decrypt,
+    aes_encrypt_blocks,
+    aes_decrypt_blocks
 };
 const cipher_id_t CIPHER_AES_128 = &aes_interface;
 
@@ -1012,22 +1027,12 @@ static int aes_set_decrypt_key(const unsigned char *userKey, const int bits,
 
 #ifndef AES_ASM
 /*
- * Encrypt a single block
+ * Encrypt a single block with an expanded key
  * in and out can overlap
  */
-int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
-                uint8_t *cipherBlock)
+static AES_FASTCODE void _encrypt_block(const AES_KEY *key, const uint8_t *plainBlock,
+                           uint8_t *cipherBlock)
 {
-    /* setup AES_KEY */
-    int res;
-    AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
-    res = aes_set_encrypt_key((unsigned char *)context->context,
-                                   AES_KEY_SIZE * 8, &aeskey);
-    if (res < 0) {
-        return res;
-    }
-
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 #ifndef MODULE_CRYPTO_AES_UNROLL
@@ -1267,27 +1272,15 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
         (Te4((t2) & 0xff)       & 0x000000ff) ^
         rk[3];
     PUTU32(cipherBlock + 12, s3);
-    return 1;
 }
 
 /*
- * Decrypt a single block
+ * Decrypt a single block with an expanded key
  * in and out can overlap
  */
-int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
-                uint8_t *plainBlock)
+static AES_FASTCODE void _decrypt_block(const AES_KEY *key, const uint8_t *cipherBlock,
+                           uint8_t *plainBlock)
 {
-    /* setup AES_KEY */
-    int res;
-    AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
-    res = aes_set_decrypt_key((unsigned char *)context->context,
-                              AES_KEY_SIZE * 8, &aeskey);
-
-    if (res < 0) {
-        return res;
-    }
-
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 #ifndef MODULE_CRYPTO_AES_UNROLL
@@ -1527,6 +1520,165 @@ int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
         (Td4((t0) & 0xff)       & 0x000000ff) ^
         rk[3];
     PUTU32(plainBlock + 12, s3);
+}
+
+/*
+ * Encrypt a single block
+ * in and out can overlap
+ */
+int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                uint8_t *cipherBlock)
+{
+#ifdef MODULE_PERIPH_HWCRYPTO
+    if (hwcrypto_aes128_ecb(context->context, true, plainBlock, cipherBlock,
+                            AES_BLOCK_SIZE) == 0) {
+        return 1;
+    }
+#endif
+    /* setup AES_KEY */
+    int res;
+    AES_KEY aeskey;
+    res = aes_set_encrypt_key((unsigned char *)context->context,
+                                   AES_KEY_SIZE * 8, &aeskey);
+    if (res < 0) {
+        return res;
+    }
+
+    _encrypt_block(&aeskey, plainBlock, cipherBlock);
+    return 1;
+}
+
+/*
+ * Decrypt a single block
+ * in and out can overlap
+ */
+int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                uint8_t *plainBlock)
+{
+#ifdef MODULE_PERIPH_HWCRYPTO
+    if (hwcrypto_aes128_ecb(context->context, false, cipherBlock, plainBlock,
+                            AES_BLOCK_SIZE) == 0) {
+        return 1;
+    }
+#endif
+    /* setup AES_KEY */
+    int res;
+    AES_KEY aeskey;
+    res = aes_set_decrypt_key((unsigned char *)context->context,
+                              AES_KEY_SIZE * 8, &aeskey);
+
+    if (res < 0) {
+        return res;
+    }
+
+    _decrypt_block(&aeskey, cipherBlock, plainBlock);
+    return 1;
+}
+
+/*
+ * Encrypt a run of blocks, the key is expanded once
+ * in and out can overlap
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks, uint8_t *chain)
+{
+#ifdef MODULE_PERIPH_HWCRYPTO
+    if (blocks > 0) {
+        size_t len = blocks * AES_BLOCK_SIZE;
+
+        if ((chain == NULL) &&
+            (hwcrypto_aes128_ecb(context->context, true, input, output,
+                                 len) == 0)) {
+            return 1;
+        }
+        if ((chain != NULL) && (output != NULL) &&
+            (hwcrypto_aes128_cbc(context->context, true, chain, input, output,
+                                 len) == 0)) {
+            memcpy(chain, output + len - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+            return 1;
+        }
+    }
+#endif
+    int res;
+    AES_KEY aeskey;
+    res = aes_set_encrypt_key((unsigned char *)context->context,
+                              AES_KEY_SIZE * 8, &aeskey);
+    if (res < 0) {
+        return res;
+    }
+
+    for (size_t n = 0; n < blocks; n++) {
+        if (chain != NULL) {
+            for (unsigned i = 0; i < AES_BLOCK_SIZE; i++) {
+                chain[i] ^= input[i];
+            }
+            _encrypt_block(&aeskey, chain, chain);
+            if (output != NULL) {
+                memcpy(output, chain, AES_BLOCK_SIZE);
+            }
+        }
+        else {
+            _encrypt_block(&aeskey, input, output);
+        }
+        input += AES_BLOCK_SIZE;
+        if (output != NULL) {
+            output += AES_BLOCK_SIZE;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Decrypt a run of blocks, the key is expanded once
+ * in and out can overlap
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks, uint8_t *chain)
+{
+#ifdef MODULE_PERIPH_HWCRYPTO
+    if (blocks > 0) {
+        size_t len = blocks * AES_BLOCK_SIZE;
+        uint8_t last[AES_BLOCK_SIZE];
+
+        if ((chain == NULL) &&
+            (hwcrypto_aes128_ecb(context->context, false, input, output,
+                                 len) == 0)) {
+            return 1;
+        }
+        memcpy(last, input + len - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+        if ((chain != NULL) &&
+            (hwcrypto_aes128_cbc(context->context, false, chain, input, output,
+                                 len) == 0)) {
+            memcpy(chain, last, AES_BLOCK_SIZE);
+            return 1;
+        }
+    }
+#endif
+    int res;
+    AES_KEY aeskey;
+    res = aes_set_decrypt_key((unsigned char *)context->context,
+                              AES_KEY_SIZE * 8, &aeskey);
+    if (res < 0) {
+        return res;
+    }
+
+    for (size_t n = 0; n < blocks; n++) {
+        if (chain != NULL) {
+            uint8_t block[AES_BLOCK_SIZE];
+
+            memcpy(block, input, AES_BLOCK_SIZE);
+            _decrypt_block(&aeskey, block, output);
+            for (unsigned i = 0; i < AES_BLOCK_SIZE; i++) {
+                output[i] ^= chain[i];
+            }
+            memcpy(chain, block, AES_BLOCK_SIZE);
+        }
+        else {
+            _decrypt_block(&aeskey, input, output);
+        }
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
     return 1;
 }
 
@@ -0,0 +1,561 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Constant time AES-128 without lookup tables
+ *
+ * Selected by the `crypto_aes_ct` pseudomodule instead of the T-table
+ * implementation in aes.c. No memory access and no branch depends on the key
+ * or the data, which keeps cache timing from leaking them, and there are no
+ * tables in flash.
+ *
+ * The S-box is the circuit of Boyar and Peralta, evaluated bitsliced: the 32
+ * bytes of two blocks are transposed into eight words, word i holding bit i
+ * of every byte. The inverse S-box reuses it between two inverse affine
+ * transforms. The linear layers work on bytes.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#ifdef MODULE_PERIPH_HWCRYPTO
+#include "periph/hwcrypto.h"
+#endif
+
+#define ROUNDS          (10U)
+/* blocks processed by each S-box evaluation */
+#define LANE_BLOCKS     (2U)
+#define LANE_SIZE       (LANE_BLOCKS * AES_BLOCK_SIZE)
+
+/**
+ * Interface to the aes cipher
+ */
+static const cipher_interface_t aes_interface = {
+    AES_BLOCK_SIZE,
+    AES_KEY_SIZE,
+    aes_init,
+    aes_encrypt,
+    aes_decrypt,
+    aes_encrypt_blocks,
+    aes_decrypt_blocks
+};
+const cipher_id_t CIPHER_AES_128 = &aes_interface;
+
+typedef struct {
+    uint8_t rk[(ROUNDS + 1) * AES_BLOCK_SIZE];
+} _schedule_t;
+
+/* transposes the 8x8 bit matrix in x and y, rows are the bytes */
+static void _transpose8(uint32_t *x, uint32_t *y)
+{
+    uint32_t t;
+
+    t = (*x ^ (*x >> 7)) & 0x00AA00AA;
+    *x ^= t ^ (t << 7);
+    t = (*y ^ (*y >> 7)) & 0x00AA00AA;
+    *y ^= t ^ (t << 7);
+    t = (*x ^ (*x >> 14)) & 0x0000CCCC;
+    *x ^= t ^ (t << 14);
+    t = (*y ^ (*y >> 14)) & 0x0000CCCC;
+    *y ^= t ^ (t << 14);
+    t = (*x & 0xF0F0F0F0) | ((*y >> 4) & 0x0F0F0F0F);
+    *y = ((*x << 4) & 0xF0F0F0F0) | (*y & 0x0F0F0F0F);
+    *x = t;
+}
+
+/* transposes len bytes, a multiple of 8, into the lanes */
+static void _to_lanes(const uint8_t *s, size_t len, uint32_t q[8])
+{
+    memset(q, 0, 8 * sizeof(q[0]));
+    for (unsigned g = 0; g < len / 8; g++) {
+        const uint8_t *a = &s[8 * g];
+        uint32_t x = ((uint32_t)a[0] << 24) | ((uint32_t)a[1] << 16) |
+                     ((uint32_t)a[2] << 8) | a[3];
+        uint32_t y = ((uint32_t)a[4] << 24) | ((uint32_t)a[5] << 16) |
+                     ((uint32_t)a[6] << 8) | a[7];
+
+        _transpose8(&x, &y);
+        for (unsigned i = 0; i < 4; i++) {
+            q[7 - i] |= ((x >> (24 - 8 * i)) & 0xff) << (8 * g);
+            q[3 - i] |= ((y >> (24 - 8 * i)) & 0xff) << (8 * g);
+        }
+    }
+}
+
+static void _from_lanes(const uint32_t q[8], uint8_t *s, size_t len)
+{
+    for (unsigned g = 0; g < len / 8; g++) {
+        uint8_t *a = &s[8 * g];
+        uint32_t x = 0, y = 0;
+
+        for (unsigned i = 0; i < 4; i++) {
+            x |= ((q[7 - i] >> (8 * g)) & 0xff) << (24 - 8 * i);
+            y |= ((q[3 - i] >> (8 * g)) & 0xff) << (24 - 8 * i);
+        }
+        _transpose8(&x, &y);
+        for (unsigned i = 0; i < 4; i++) {
+            a[i] = x >> (24 - 8 * i);
+            a[4 + i] = y >> (24 - 8 * i);
+        }
+    }
+}
+
+/* Boyar-Peralta S-box circuit, x0 is the most significant bit */
+static void _sbox(uint32_t q[8])
+{
+    uint32_t x0, x1, x2, x3, x4, x5, x6, x7;
+    uint32_t y1, y2, y3, y4, y5, y6, y7, y8, y9;
+    uint32_t y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+    uint32_t y20, y21;
+    uint32_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+    uint32_t z10, z11, z12, z13, z14, z15, z16, z17;
+    uint32_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+    uint32_t t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    uint32_t t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+    uint32_t t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    uint32_t t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+    uint32_t t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    uint32_t t60, t61, t62, t63, t64, t65, t66, t67;
+    uint32_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    /* top linear transformation */
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    /* non-linear section */
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    /* bottom linear transformation */
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+/* inverse of the affine transform of the S-box,
+ * b <<< 1 ^ b <<< 3 ^ b <<< 6 ^ 0x05 on every byte */
+static void _inv_affine(uint32_t q[8])
+{
+    uint32_t r[8];
+
+    for (unsigned i = 0; i < 8; i++) {
+        r[i] = q[(i + 7) % 8] ^ q[(i + 5) % 8] ^ q[(i + 2) % 8];
+    }
+    r[0] = ~r[0];
+    r[2] = ~r[2];
+    memcpy(q, r, sizeof(r));
+}
+
+static void _sub_bytes(uint8_t *s, size_t len)
+{
+    uint32_t q[8];
+
+    _to_lanes(s, len, q);
+    _sbox(q);
+    _from_lanes(q, s, len);
+}
+
+static void _inv_sub_bytes(uint8_t s[LANE_SIZE])
+{
+    uint32_t q[8];
+
+    /* S(x) = A(x^-1), so S^-1(y) = A^-1(S(A^-1(y))) */
+    _to_lanes(s, LANE_SIZE, q);
+    _inv_affine(q);
+    _sbox(q);
+    _inv_affine(q);
+    _from_lanes(q, s, LANE_SIZE);
+}
+
+static uint8_t _xtime(uint8_t x)
+{
+    return (x << 1) ^ (0x1b & -(x >> 7));
+}
+
+static void _shift_rows(uint8_t *s)
+{
+    uint8_t t[AES_BLOCK_SIZE];
+
+    for (unsigned c = 0; c < 4; c++) {
+        for (unsigned r = 0; r < 4; r++) {
+            t[4 * c + r] = s[4 * ((c + r) % 4) + r];
+        }
+    }
+    memcpy(s, t, sizeof(t));
+}
+
+static void _inv_shift_rows(uint8_t *s)
+{
+    uint8_t t[AES_BLOCK_SIZE];
+
+    for (unsigned c = 0; c < 4; c++) {
+        for (unsigned r = 0; r < 4; r++) {
+            t[4 * ((c + r) % 4) + r] = s[4 * c + r];
+        }
+    }
+    memcpy(s, t, sizeof(t));
+}
+
+static void _mix_columns(uint8_t *s)
+{
+    for (unsigned c = 0; c < 4; c++) {
+        uint8_t *a = &s[4 * c];
+        uint8_t t = a[0] ^ a[1] ^ a[2] ^ a[3], u = a[0];
+
+        a[0] ^= t ^ _xtime(a[0] ^ a[1]);
+        a[1] ^= t ^ _xtime(a[1] ^ a[2]);
+        a[2] ^= t ^ _xtime(a[2] ^ a[3]);
+        a[3] ^= t ^ _xtime(a[3] ^ u);
+    }
+}
+
+static void _inv_mix_columns(uint8_t *s)
+{
+    /* reduces to MixColumns after multiplying with 4x^2 + 5 */
+    for (unsigned c = 0; c < 4; c++) {
+        uint8_t *a = &s[4 * c];
+        uint8_t u = _xtime(_xtime(a[0] ^ a[2]));
+        uint8_t v = _xtime(_xtime(a[1] ^ a[3]));
+
+        a[0] ^= u;
+        a[1] ^= v;
+        a[2] ^= u;
+        a[3] ^= v;
+    }
+    _mix_columns(s);
+}
+
+static void _add_round_key(uint8_t s[LANE_SIZE], const uint8_t *rk)
+{
+    for (unsigned i = 0; i < LANE_SIZE; i++) {
+        s[i] ^= rk[i % AES_BLOCK_SIZE];
+    }
+}
+
+static void _expand_key(const uint8_t *key, _schedule_t *ks)
+{
+    uint8_t rcon = 0x01;
+
+    memcpy(ks->rk, key, AES_KEY_SIZE);
+    for (unsigned i = AES_KEY_SIZE; i < sizeof(ks->rk); i += 4) {
+        uint8_t *w = &ks->rk[i];
+
+        memcpy(w, w - 4, 4);
+        if ((i % AES_KEY_SIZE) == 0) {
+            uint8_t s[8] = { 0 };
+
+            /* RotWord and SubWord */
+            s[0] = w[1];
+            s[1] = w[2];
+            s[2] = w[3];
+            s[3] = w[0];
+            _sub_bytes(s, sizeof(s));
+            memcpy(w, s, 4);
+            w[0] ^= rcon;
+            rcon = _xtime(rcon);
+        }
+        for (unsigned j = 0; j < 4; j++) {
+            w[j] ^= ks->rk[i + j - AES_KEY_SIZE];
+        }
+    }
+}
+
+static void _encrypt_lanes(const _schedule_t *ks, uint8_t s[LANE_SIZE])
+{
+    _add_round_key(s, &ks->rk[0]);
+    for (unsigned r = 1; r <= ROUNDS; r++) {
+        _sub_bytes(s, LANE_SIZE);
+        for (unsigned b = 0; b < LANE_BLOCKS; b++) {
+            _shift_rows(&s[b * AES_BLOCK_SIZE]);
+            if (r < ROUNDS) {
+                _mix_columns(&s[b * AES_BLOCK_SIZE]);
+            }
+        }
+        _add_round_key(s, &ks->rk[r * AES_BLOCK_SIZE]);
+    }
+}
+
+static void _decrypt_lanes(const _schedule_t *ks, uint8_t s[LANE_SIZE])
+{
+    _add_round_key(s, &ks->rk[ROUNDS * AES_BLOCK_SIZE]);
+    for (unsigned r = ROUNDS; r-- > 0;) {
+        for (unsigned b = 0; b < LANE_BLOCKS; b++) {
+            _inv_shift_rows(&s[b * AES_BLOCK_SIZE]);
+        }
+        _inv_sub_bytes(s);
+        _add_round_key(s, &ks->rk[r * AES_BLOCK_SIZE]);
+        if (r > 0) {
+            for (unsigned b = 0; b < LANE_BLOCKS; b++) {
+                _inv_mix_columns(&s[b * AES_BLOCK_SIZE]);
+            }
+        }
+    }
+}
+
+int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize)
+{
+    /* Make sure that context is large enough. If this is not the case,
+       you should build with -DAES */
+    if (CIPHER_MAX_CONTEXT_SIZE < AES_KEY_SIZE) {
+        return CIPHER_ERR_BAD_CONTEXT_SIZE;
+    }
+
+    /* key must be at least CIPHERS_MAX_KEY_SIZE Bytes long, fill it up by
+     * concatenating key as long as needed */
+    for (unsigned i = 0; i < CIPHERS_MAX_KEY_SIZE; i++) {
+        context->context[i] = key[i % keySize];
+    }
+
+    return CIPHER_INIT_SUCCESS;
+}
+
+int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                uint8_t *cipherBlock)
+{
+    return aes_encrypt_blocks(context, plainBlock, cipherBlock, 1, NULL);
+}
+
+int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                uint8_t *plainBlock)
+{
+    return aes_decrypt_blocks(context, cipherBlock, plainBlock, 1, NULL);
+}
+
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks, uint8_t *chain)
+{
+#ifdef MODULE_PERIPH_HWCRYPTO
+    if (blocks > 0) {
+        size_t len = blocks * AES_BLOCK_SIZE;
+
+        if ((chain == NULL) &&
+            (hwcrypto_aes128_ecb(context->context, true, input, output,
+                                 len) == 0)) {
+            return 1;
+        }
+        if ((chain != NULL) && (output != NULL) &&
+            (hwcrypto_aes128_cbc(context->context, true, chain, input, output,
+                                 len) == 0)) {
+            memcpy(chain, output + len - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+            return 1;
+        }
+    }
+#endif
+    _schedule_t ks;
+    uint8_t s[LANE_SIZE];
+
+    _expand_key(context->context, &ks);
+    while (blocks > 0) {
+        /* chained blocks depend on each other, one at a time */
+        size_t n = (chain || (blocks < LANE_BLOCKS)) ? 1 : LANE_BLOCKS;
+
+        memset(s, 0, sizeof(s));
+        memcpy(s, input, n * AES_BLOCK_SIZE);
+        if (chain) {
+            for (unsigned i = 0; i < AES_BLOCK_SIZE; i++) {
+                s[i] ^= chain[i];
+            }
+        }
+        _encrypt_lanes(&ks, s);
+        if (chain) {
+            memcpy(chain, s, AES_BLOCK_SIZE);
+        }
+        if (output) {
+            memcpy(output, s, n * AES_BLOCK_SIZE);
+            output += n * AES_BLOCK_SIZE;
+        }
+        input += n * AES_BLOCK_SIZE;
+        blocks -= n;
+    }
+    return 1;
+}
+
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks, uint8_t *chain)
+{
+#ifdef MODULE_PERIPH_HWCRYPTO
+    if (blocks > 0) {
+        size_t len = blocks * AES_BLOCK_SIZE;
+        uint8_t last[AES_BLOCK_SIZE];
+
+        if ((chain == NULL) &&
+            (hwcrypto_aes128_ecb(context->context, false, input, output,
+                                 len) == 0)) {
+            return 1;
+        }
+        memcpy(last, input + len - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+        if ((chain != NULL) &&
+            (hwcrypto_aes128_cbc(context->context, false, chain, input, output,
+                                 len) == 0)) {
+            memcpy(chain, last, AES_BLOCK_SIZE);
+            return 1;
+        }
+    }
+#endif
+    _schedule_t ks;
+    uint8_t s[LANE_SIZE], in[LANE_SIZE];
+
+    _expand_key(context->context, &ks);
+    while (blocks > 0) {
+        /* CBC decryption does not chain, both lanes can be used */
+        size_t n = (blocks < LANE_BLOCKS) ? 1 : LANE_BLOCKS;
+
+        memset(s, 0, sizeof(s));
+        memcpy(s, input, n * AES_BLOCK_SIZE);
+        memcpy(in, s, sizeof(in));
+        _decrypt_lanes(&ks, s);
+        if (chain) {
+            for (unsigned i = 0; i < n * AES_BLOCK_SIZE; i++) {
+                s[i] ^= (i < AES_BLOCK_SIZE) ? chain[i]
+                                             : in[i - AES_BLOCK_SIZE];
+            }
+            memcpy(chain, &in[(n - 1) * AES_BLOCK_SIZE], AES_BLOCK_SIZE);
+        }
+        memcpy(output, s, n * AES_BLOCK_SIZE);
+        input += n * AES_BLOCK_SIZE;
+        output += n * AES_BLOCK_SIZE;
+        blocks -= n;
+    }
+    return 1;
+}
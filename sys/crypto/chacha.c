@@ -120,3 +120,27 @@ void chacha_encrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8_t *c)
         c[i] = m[i] ^ x[i];
     }
 }
+
+void chacha_xor(chacha_ctx *ctx, const uint8_t *m, uint8_t *c, size_t len)
+{
+    uint32_t x[16];
+
+    while (len > 0) {
+        size_t chunk = (len < sizeof(x)) ? len : sizeof(x);
+        size_t i = 0;
+
+        chacha_keystream_bytes(ctx, x);
+        for (; i + sizeof(uint32_t) <= chunk; i += sizeof(uint32_t)) {
+            uint32_t w;
+            memcpy(&w, &m[i], sizeof(w));
+            w ^= x[i / sizeof(uint32_t)];
+            memcpy(&c[i], &w, sizeof(w));
+        }
+        for (; i < chunk; ++i) {
+            c[i] = m[i] ^ ((uint8_t *)x)[i];
+        }
+        m += chunk;
+        c += chunk;
+        len -= chunk;
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto_chacha20poly1305
+ * @{
+ *
+ * @file
+ * @brief       ChaCha20-Poly1305 implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/chacha.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/helper.h"
+#include "crypto/poly1305.h"
+
+static const uint8_t _pad[POLY1305_BLOCK_SIZE];
+
+/* ChaCha20 with the 32 bit block counter and 96 bit nonce of RFC 8439 */
+static void _init(chacha_ctx *chacha, const uint8_t *key, const uint8_t *nonce)
+{
+    chacha_init(chacha, 20, key, CHACHA20POLY1305_KEY_BYTES, &nonce[4]);
+    memcpy(&chacha->state[13], nonce, sizeof(uint32_t));
+}
+
+static void _update_padded(poly1305_ctx_t *poly, const uint8_t *data,
+                           size_t len)
+{
+    poly1305_update(poly, data, len);
+    if (len % POLY1305_BLOCK_SIZE) {
+        poly1305_update(poly, _pad,
+                        POLY1305_BLOCK_SIZE - (len % POLY1305_BLOCK_SIZE));
+    }
+}
+
+static void _tag(chacha_ctx *chacha, uint8_t *tag, const uint8_t *cipher,
+                 size_t cipherlen, const uint8_t *aad, size_t aadlen)
+{
+    uint32_t otk[16];
+    uint8_t lengths[16];
+    poly1305_ctx_t poly;
+
+    /* the one time key is the first 32 bytes of block 0 */
+    chacha_keystream_bytes(chacha, otk);
+    poly1305_init(&poly, (uint8_t *)otk);
+    crypto_secure_wipe(otk, sizeof(otk));
+
+    _update_padded(&poly, aad, aadlen);
+    _update_padded(&poly, cipher, cipherlen);
+    for (unsigned i = 0; i < 8; i++) {
+        lengths[i] = (uint64_t)aadlen >> (8 * i);
+        lengths[8 + i] = (uint64_t)cipherlen >> (8 * i);
+    }
+    poly1305_update(&poly, lengths, sizeof(lengths));
+    poly1305_finish(&poly, tag);
+    crypto_secure_wipe(&poly, sizeof(poly));
+}
+
+void chacha20poly1305_encrypt(uint8_t *cipher, const uint8_t *msg,
+                              size_t msglen, const uint8_t *aad, size_t aadlen,
+                              const uint8_t *key, const uint8_t *nonce)
+{
+    chacha_ctx chacha, chacha_mac;
+
+    _init(&chacha, key, nonce);
+    chacha_mac = chacha;
+    /* the message is encrypted from block 1 */
+    chacha.state[12] = 1;
+    chacha_xor(&chacha, msg, cipher, msglen);
+    _tag(&chacha_mac, &cipher[msglen], cipher, msglen, aad, aadlen);
+    crypto_secure_wipe(&chacha, sizeof(chacha));
+    crypto_secure_wipe(&chacha_mac, sizeof(chacha_mac));
+}
+
+int chacha20poly1305_decrypt(const uint8_t *cipher, size_t cipherlen,
+                             uint8_t *msg, size_t *msglen,
+                             const uint8_t *aad, size_t aadlen,
+                             const uint8_t *key, const uint8_t *nonce)
+{
+    chacha_ctx chacha;
+    uint8_t tag[CHACHA20POLY1305_TAG_BYTES];
+    int res = 0;
+
+    if (cipherlen < CHACHA20POLY1305_TAG_BYTES) {
+        return 0;
+    }
+    *msglen = cipherlen - CHACHA20POLY1305_TAG_BYTES;
+
+    _init(&chacha, key, nonce);
+    _tag(&chacha, tag, cipher, *msglen, aad, aadlen);
+    if (crypto_equals(tag, &cipher[*msglen], sizeof(tag))) {
+        /* _tag() left the counter at block 1 */
+        chacha_xor(&chacha, cipher, msg, *msglen);
+        res = 1;
+    }
+    crypto_secure_wipe(&chacha, sizeof(chacha));
+    return res;
+}
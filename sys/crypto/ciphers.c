@@ -44,6 +44,76 @@ int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 }
 
 
+int cipher_encrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t blocks, uint8_t* chain)
+{
+    uint8_t block_size = cipher->interface->block_size;
+
+    if (cipher->interface->encrypt_blocks) {
+        return cipher->interface->encrypt_blocks(&cipher->context, input,
+                                                 output, blocks, chain);
+    }
+
+    for (size_t n = 0; n < blocks; n++) {
+        int res;
+
+        if (chain) {
+            for (uint8_t i = 0; i < block_size; ++i) {
+                chain[i] ^= input[i];
+            }
+            res = cipher_encrypt(cipher, chain, chain);
+            if (output) {
+                memcpy(output, chain, block_size);
+            }
+        }
+        else {
+            res = cipher_encrypt(cipher, input, output);
+        }
+        if (res != 1) {
+            return res;
+        }
+        input += block_size;
+        if (output) {
+            output += block_size;
+        }
+    }
+    return 1;
+}
+
+
+int cipher_decrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t blocks, uint8_t* chain)
+{
+    uint8_t block_size = cipher->interface->block_size;
+
+    if (cipher->interface->decrypt_blocks) {
+        return cipher->interface->decrypt_blocks(&cipher->context, input,
+                                                 output, blocks, chain);
+    }
+
+    for (size_t n = 0; n < blocks; n++) {
+        uint8_t block[CIPHER_MAX_BLOCK_SIZE];
+        int res;
+
+        /* keep the input, output may be the same memory */
+        memcpy(block, input, block_size);
+        res = cipher_decrypt(cipher, block, output);
+        if (res != 1) {
+            return res;
+        }
+        if (chain) {
+            for (uint8_t i = 0; i < block_size; ++i) {
+                output[i] ^= chain[i];
+            }
+            memcpy(chain, block, block_size);
+        }
+        input += block_size;
+        output += block_size;
+    }
+    return 1;
+}
+
+
 int cipher_get_block_size(const cipher_t* cipher)
 {
     return cipher->interface->block_size;
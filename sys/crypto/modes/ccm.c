@@ -18,6 +18,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <string.h>
 #include "debug.h"
 #include "crypto/helper.h"
@@ -34,35 +35,6 @@ static inline int min(int a, int b)
     }
 }
 
-int ccm_compute_cbc_mac(cipher_t* cipher, const uint8_t iv[16],
-                        const uint8_t* input, size_t length, uint8_t* mac)
-{
-    uint8_t offset, block_size, mac_enc[16] = {0};
-
-    block_size = cipher_get_block_size(cipher);
-    memmove(mac, iv, 16);
-    offset = 0;
-    do {
-        uint8_t block_size_input = (length - offset > block_size) ?
-                                   block_size : length - offset;
-
-        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        for (int i = 0; i < block_size_input; ++i) {
-            mac[i] ^= input[offset + i];
-        }
-
-        if (cipher_encrypt(cipher, mac, mac_enc) != 1) {
-            return CIPHER_ERR_ENC_FAILED;
-        }
-
-        memcpy(mac, mac_enc, block_size);
-        offset += block_size_input;
-    } while (offset < length);
-
-    return offset;
-}
-
-
 int ccm_create_mac_iv(cipher_t* cipher, uint8_t auth_data_len, uint8_t M,
                       uint8_t L, const uint8_t* nonce, uint8_t nonce_len,
                       size_t plaintext_len, uint8_t X1[16])
@@ -83,7 +55,7 @@ int ccm_create_mac_iv(cipher_t* cipher, uint8_t auth_data_len, uint8_t M,
     memcpy(&X1[1], nonce, min(nonce_len, 15 - L));
 
     /* write plaintext_len to B[15..16-L] */
-    for (uint8_t i = 15; i > 16 - L; --i) {
+    for (uint8_t i = 15; i > 15 - L; --i) {
         X1[i] = plaintext_len & 0xff;
         plaintext_len >>= 8;
     }
@@ -99,40 +71,6 @@ int ccm_create_mac_iv(cipher_t* cipher, uint8_t auth_data_len, uint8_t M,
     return 0;
 }
 
-int ccm_compute_adata_mac(cipher_t* cipher, const uint8_t* auth_data,
-                          uint32_t auth_data_len, uint8_t X1[16])
-{
-    if (auth_data_len > 0) {
-        int len;
-
-        /* 16 octet block size + max. 10 len encoding  */
-        uint8_t auth_data_encoded[26], len_encoding = 0;
-
-        /* If 0 < l(a) < (2^16 - 2^8), then the length field is encoded as two
-         * octets. (RFC3610 page 2)
-         */
-        if (auth_data_len <= 0xFEFF) {
-            /* length (0x0001 ... 0xFEFF)  */
-            len_encoding = 2;
-
-            auth_data_encoded[1] = auth_data_len & 0xFF;
-            auth_data_encoded[0] = (auth_data_len >> 8) & 0xFF;
-        } else {
-            DEBUG("UNSUPPORTED Adata length: %" PRIu32 "\n", auth_data_len);
-            return -1;
-        }
-
-        memcpy(auth_data_encoded + len_encoding, auth_data, auth_data_len);
-        len = ccm_compute_cbc_mac(cipher, X1, auth_data_encoded, auth_data_len + len_encoding, X1);
-        if (len < 0) {
-            return -1;
-        }
-    }
-
-    return 0;
-}
-
-
 /* Check if 'value' can be stored in 'num_bytes' */
 static inline int _fits_in_nbytes(size_t value, uint8_t num_bytes)
 {
@@ -144,16 +82,54 @@ static inline int _fits_in_nbytes(size_t value, uint8_t num_bytes)
 }
 
 
-int cipher_encrypt_ccm(cipher_t* cipher,
-                       const uint8_t* auth_data, uint32_t auth_data_len,
-                       uint8_t mac_length, uint8_t length_encoding,
-                       const uint8_t* nonce, size_t nonce_len,
-                       const uint8_t* input, size_t input_len,
-                       uint8_t* output)
+/* absorbs data into the CBC-MAC, ctx->pos bytes of the block are taken */
+static int _mac_update(ccm_context_t *ctx, const uint8_t *data, size_t len)
 {
-    int len = -1;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                stream_block[16] = {0}, zero_block[16] = {0}, block_size;
+    while (len > 0) {
+        if ((ctx->pos == 0) && (len >= CCM_BLOCK_SIZE)) {
+            size_t blocks = len / CCM_BLOCK_SIZE;
+
+            if (cipher_encrypt_blocks(ctx->cipher, data, NULL, blocks,
+                                      ctx->mac) != 1) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
+            data += blocks * CCM_BLOCK_SIZE;
+            len -= blocks * CCM_BLOCK_SIZE;
+            continue;
+        }
+        while ((len > 0) && (ctx->pos < CCM_BLOCK_SIZE)) {
+            ctx->mac[ctx->pos++] ^= *data++;
+            len--;
+        }
+        if (ctx->pos == CCM_BLOCK_SIZE) {
+            ctx->pos = 0;
+            if (cipher_encrypt(ctx->cipher, ctx->mac, ctx->mac) != 1) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
+        }
+    }
+    return 0;
+}
+
+/* the last block is zero padded */
+static int _mac_pad(ccm_context_t *ctx)
+{
+    if (ctx->pos == 0) {
+        return 0;
+    }
+    ctx->pos = 0;
+    if (cipher_encrypt(ctx->cipher, ctx->mac, ctx->mac) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+    return 0;
+}
+
+int cipher_ccm_init(ccm_context_t *ctx, cipher_t *cipher,
+                    const iolist_t *auth_data, uint8_t mac_length,
+                    uint8_t length_encoding, const uint8_t *nonce,
+                    size_t nonce_len, size_t input_len)
+{
+    size_t auth_data_len = 0;
 
     if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
         return CCM_ERR_INVALID_MAC_LENGTH;
@@ -164,114 +140,253 @@ int cipher_encrypt_ccm(cipher_t* cipher,
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
 
+    for (const iolist_t *iol = auth_data; iol; iol = iol->iol_next) {
+        auth_data_len += iol->iol_len;
+    }
+    /* If 0 < l(a) < (2^16 - 2^8), then the length field is encoded as two
+     * octets. (RFC3610 page 2)
+     */
+    if (auth_data_len > 0xFEFF) {
+        DEBUG("UNSUPPORTED Adata length: %u\n", (unsigned)auth_data_len);
+        return -1;
+    }
+
+    ctx->cipher = cipher;
+    ctx->input_len = input_len;
+    ctx->pos = 0;
+    ctx->mac_length = mac_length;
+    ctx->length_encoding = length_encoding;
+
     /* Create B0, encrypt it (X1) and use it as mac_iv */
-    block_size = cipher_get_block_size(cipher);
-    if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, input_len, mac_iv) < 0) {
+    if (ccm_create_mac_iv(cipher, auth_data_len > 0, mac_length,
+                          length_encoding, nonce, nonce_len, input_len,
+                          ctx->mac) < 0) {
         return CCM_ERR_INVALID_DATA_LENGTH;
     }
 
-    /* MAC calulation (T) with additional data and plaintext */
-    len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
-    if (len < 0) {
-        return len;
-    }
-    len = ccm_compute_cbc_mac(cipher, mac_iv, input, input_len, mac);
-    if (len < 0) {
-        return len;
-    }
+    /* MAC calulation (T) with the encoded length and the additional data */
+    if (auth_data_len > 0) {
+        uint8_t len_encoded[2] = { auth_data_len >> 8, auth_data_len & 0xFF };
+        int res = _mac_update(ctx, len_encoded, sizeof(len_encoded));
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    memcpy(&nonce_counter[1], nonce,
-           min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size,
-                             zero_block, block_size, stream_block);
-    if (len < 0) {
-        return len;
+        for (const iolist_t *iol = auth_data; iol && (res == 0);
+             iol = iol->iol_next) {
+            res = _mac_update(ctx, iol->iol_base, iol->iol_len);
+        }
+        if ((res < 0) || ((res = _mac_pad(ctx)) < 0)) {
+            return res;
+        }
     }
 
-    /* Encrypt message in counter mode  */
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             input_len, output);
-    if (len < 0) {
-        return len;
+    /* counter block A0, its key stream is kept for the MAC */
+    memset(ctx->ctr, 0, sizeof(ctx->ctr));
+    ctx->ctr[0] = length_encoding - 1;
+    memcpy(&ctx->ctr[1], nonce, min(nonce_len, (size_t) 15 - length_encoding));
+    if (cipher_encrypt(cipher, ctx->ctr, ctx->stream) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
     }
+    memcpy(ctx->mac_stream, ctx->stream, sizeof(ctx->mac_stream));
+    crypto_block_inc_ctr(ctx->ctr, length_encoding);
 
-    /* auth value: mac ^ first stream block */
-    for (uint8_t i = 0; i < mac_length; ++i) {
-        output[len + i] = mac[i] ^ stream_block[i];
+    return 0;
+}
+
+static int _update(ccm_context_t *ctx, const uint8_t *input, size_t len,
+                   uint8_t *output, bool encrypt)
+{
+    if (len > ctx->input_len) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
     }
+    ctx->input_len -= len;
+
+    while (len > 0) {
+        int res;
+
+        /* whole blocks go to the multi-block cipher operations */
+        if ((ctx->pos == 0) && (len >= CCM_BLOCK_SIZE)) {
+            size_t chunk = len - (len % CCM_BLOCK_SIZE);
+
+            if (encrypt && ((res = _mac_update(ctx, input, chunk)) < 0)) {
+                return res;
+            }
+            res = cipher_encrypt_ctr(ctx->cipher, ctx->ctr,
+                                     CCM_BLOCK_SIZE - ctx->length_encoding,
+                                     input, chunk, output);
+            if (res < 0) {
+                return res;
+            }
+            if (!encrypt && ((res = _mac_update(ctx, output, chunk)) < 0)) {
+                return res;
+            }
+            input += chunk;
+            output += chunk;
+            len -= chunk;
+            continue;
+        }
+
+        if (ctx->pos == 0) {
+            if (cipher_encrypt(ctx->cipher, ctx->ctr, ctx->stream) != 1) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
+            crypto_block_inc_ctr(ctx->ctr, ctx->length_encoding);
+        }
+        /* the MAC is taken over the plaintext, input may be output */
+        uint8_t pos = ctx->pos;
+        size_t chunk = CCM_BLOCK_SIZE - pos;
 
-    return len + mac_length;
+        if (chunk > len) {
+            chunk = len;
+        }
+        for (size_t i = 0; i < chunk; i++) {
+            uint8_t c = input[i] ^ ctx->stream[pos + i];
+
+            ctx->mac[pos + i] ^= encrypt ? input[i] : c;
+            output[i] = c;
+        }
+        ctx->pos += chunk;
+        if ((ctx->pos == CCM_BLOCK_SIZE) && ((res = _mac_pad(ctx)) < 0)) {
+            return res;
+        }
+        input += chunk;
+        output += chunk;
+        len -= chunk;
+    }
+    return 0;
 }
 
+int cipher_ccm_encrypt_update(ccm_context_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output)
+{
+    return _update(ctx, input, len, output, true);
+}
 
-int cipher_decrypt_ccm(cipher_t* cipher,
-                       const uint8_t* auth_data, uint32_t auth_data_len,
-                       uint8_t mac_length, uint8_t length_encoding,
-                       const uint8_t* nonce, size_t nonce_len,
-                       const uint8_t* input, size_t input_len,
-                       uint8_t* plain)
+int cipher_ccm_decrypt_update(ccm_context_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output)
 {
-    int len = -1;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                mac_recv[16] = {0}, stream_block[16] = {0}, zero_block[16] = {0},
-                                        plain_len, block_size;
+    return _update(ctx, input, len, output, false);
+}
 
-    if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
-        return CCM_ERR_INVALID_MAC_LENGTH;
+static int _update_iolist(ccm_context_t *ctx, const iolist_t *data,
+                          bool encrypt)
+{
+    for (const iolist_t *iol = data; iol; iol = iol->iol_next) {
+        int res = _update(ctx, iol->iol_base, iol->iol_len, iol->iol_base,
+                          encrypt);
+        if (res < 0) {
+            return res;
+        }
     }
+    return 0;
+}
 
-    if (length_encoding < 2 || length_encoding > 8 ||
-            !_fits_in_nbytes(input_len, length_encoding)) {
-        return CCM_ERR_INVALID_LENGTH_ENCODING;
-    }
+int cipher_ccm_encrypt_iolist(ccm_context_t *ctx, const iolist_t *data)
+{
+    return _update_iolist(ctx, data, true);
+}
+
+int cipher_ccm_decrypt_iolist(ccm_context_t *ctx, const iolist_t *data)
+{
+    return _update_iolist(ctx, data, false);
+}
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    block_size = cipher_get_block_size(cipher);
-    memcpy(&nonce_counter[1], nonce, min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size, zero_block,
-                             block_size, stream_block);
-    if (len < 0) {
-        return len;
+static int _finish(ccm_context_t *ctx)
+{
+    if (ctx->input_len > 0) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
+    }
+    int res = _mac_pad(ctx);
+    if (res < 0) {
+        return res;
     }
 
-    /* Decrypt message in counter mode */
-    plain_len = input_len - mac_length;
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             plain_len, plain);
-    if (len < 0) {
-        return len;
+    /* auth value: mac ^ first stream block */
+    for (uint8_t i = 0; i < ctx->mac_length; ++i) {
+        ctx->mac[i] ^= ctx->mac_stream[i];
     }
+    return 0;
+}
 
-    /* Create B0, encrypt it (X1) and use it as mac_iv */
-    if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, plain_len, mac_iv) < 0) {
-        return CCM_ERR_INVALID_DATA_LENGTH;
+int cipher_ccm_encrypt_finish(ccm_context_t *ctx, uint8_t *mac)
+{
+    int res = _finish(ctx);
+
+    if (res < 0) {
+        return res;
     }
+    memcpy(mac, ctx->mac, ctx->mac_length);
+    return ctx->mac_length;
+}
+
+int cipher_ccm_decrypt_finish(ccm_context_t *ctx, const uint8_t *mac)
+{
+    int res = _finish(ctx);
 
-    /* MAC calulation (T) with additional data and plaintext */
-    len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
-    if (len < 0) {
-        return len;
+    if (res < 0) {
+        return res;
     }
-    len = ccm_compute_cbc_mac(cipher, mac_iv, plain, plain_len, mac);
-    if (len < 0) {
-        return len;
+    if (!crypto_equals(ctx->mac, mac, ctx->mac_length)) {
+        return CCM_ERR_INVALID_CBC_MAC;
     }
+    return 0;
+}
 
-    /* mac = input[plain_len...plain_len+mac_length] ^ first stream block */
-    for (uint8_t i = 0; i < mac_length; ++i) {
-        mac_recv[i] = input[len + i] ^ stream_block[i];
+int cipher_encrypt_ccm(cipher_t* cipher,
+                       const uint8_t* auth_data, uint32_t auth_data_len,
+                       uint8_t mac_length, uint8_t length_encoding,
+                       const uint8_t* nonce, size_t nonce_len,
+                       const uint8_t* input, size_t input_len,
+                       uint8_t* output)
+{
+    ccm_context_t ctx;
+    iolist_t adata = {
+        .iol_base = (uint8_t *)auth_data,
+        .iol_len = auth_data_len,
+    };
+    int res = cipher_ccm_init(&ctx, cipher, &adata, mac_length,
+                              length_encoding, nonce, nonce_len, input_len);
+
+    if ((res < 0) ||
+        ((res = cipher_ccm_encrypt_update(&ctx, input, input_len,
+                                          output)) < 0) ||
+        ((res = cipher_ccm_encrypt_finish(&ctx, &output[input_len])) < 0)) {
+        return res;
     }
+    return input_len + mac_length;
+}
 
-    if (!crypto_equals(mac_recv, mac, mac_length)) {
-        return CCM_ERR_INVALID_CBC_MAC;
+
+int cipher_decrypt_ccm(cipher_t* cipher,
+                       const uint8_t* auth_data, uint32_t auth_data_len,
+                       uint8_t mac_length, uint8_t length_encoding,
+                       const uint8_t* nonce, size_t nonce_len,
+                       const uint8_t* input, size_t input_len,
+                       uint8_t* plain)
+{
+    ccm_context_t ctx;
+    iolist_t adata = {
+        .iol_base = (uint8_t *)auth_data,
+        .iol_len = auth_data_len,
+    };
+    size_t plain_len = input_len - mac_length;
+    int res;
+
+    /* the length encoding limits the length of the input, not only the
+     * plaintext */
+    if (length_encoding >= 2 && length_encoding <= 8 &&
+            !_fits_in_nbytes(input_len, length_encoding)) {
+        return CCM_ERR_INVALID_LENGTH_ENCODING;
+    }
+    if (input_len < mac_length) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
     }
 
+    res = cipher_ccm_init(&ctx, cipher, &adata, mac_length, length_encoding,
+                          nonce, nonce_len, plain_len);
+    if ((res < 0) ||
+        ((res = cipher_ccm_decrypt_update(&ctx, input, plain_len,
+                                          plain)) < 0) ||
+        ((res = cipher_ccm_decrypt_finish(&ctx, &input[plain_len])) < 0)) {
+        return res;
+    }
     return plain_len;
 }
@@ -18,32 +18,90 @@
 * @}
 */
 
+#include <string.h>
+
 #include "crypto/helper.h"
 #include "crypto/modes/ctr.h"
+#ifdef MODULE_PERIPH_HWCRYPTO
+#include "crypto/aes.h"
+#include "periph/hwcrypto.h"
+
+/* The engine is given a 32 bit counter. If counting the blocks does not carry
+ * out of the lowest 32 bit nor out of the counter, any counter wider than it
+ * gives the same key stream. */
+static int _no_carry(const uint8_t nonce_counter[16], uint8_t ctr_len,
+                     size_t blocks)
+{
+    uint8_t width = (ctr_len < 4) ? ctr_len : 4;
+    uint64_t low = 0;
+
+    for (unsigned i = 16 - width; i < 16; i++) {
+        low = (low << 8) | nonce_counter[i];
+    }
+    return (low + blocks) <= (1ULL << (8 * width));
+}
+
+/* encrypts the whole blocks with the engine, returns the bytes done */
+static size_t _encrypt_ctr_hw(cipher_t* cipher, uint8_t nonce_counter[16],
+                              uint8_t nonce_len, const uint8_t* input,
+                              size_t length, uint8_t* output)
+{
+    uint8_t ctr_len = AES_BLOCK_SIZE - nonce_len;
+    size_t blocks = length / AES_BLOCK_SIZE;
+
+    if ((cipher->interface != CIPHER_AES_128) || (nonce_len >= AES_BLOCK_SIZE) ||
+        (blocks == 0) || !_no_carry(nonce_counter, ctr_len, blocks) ||
+        (hwcrypto_aes128_ctr(cipher->context.context, nonce_counter, 4, input,
+                             output, blocks * AES_BLOCK_SIZE) != 0)) {
+        return 0;
+    }
+    for (size_t i = 0; i < blocks; i++) {
+        crypto_block_inc_ctr(nonce_counter, ctr_len);
+    }
+    return blocks * AES_BLOCK_SIZE;
+}
+#endif
 
 int cipher_encrypt_ctr(cipher_t* cipher, uint8_t nonce_counter[16],
                        uint8_t nonce_len, const uint8_t* input, size_t length,
                        uint8_t* output)
 {
     size_t offset = 0;
-    uint8_t stream_block[16] = {0}, block_size;
+    uint8_t stream[CTR_CHUNK_BLOCKS * CIPHER_MAX_BLOCK_SIZE], block_size;
 
     block_size = cipher_get_block_size(cipher);
+#ifdef MODULE_PERIPH_HWCRYPTO
+    offset = _encrypt_ctr_hw(cipher, nonce_counter, nonce_len, input, length,
+                             output);
+    if ((offset > 0) && (offset == length)) {
+        return offset;
+    }
+#endif
     do {
-        uint8_t block_size_input;
+        size_t blocks = (length - offset + block_size - 1) / block_size;
+        size_t chunk;
 
-        if (cipher_encrypt(cipher, nonce_counter, stream_block) != 1) {
+        /* one block at least, the counter is incremented for empty input */
+        if (blocks == 0) {
+            blocks = 1;
+        }
+        else if (blocks > CTR_CHUNK_BLOCKS) {
+            blocks = CTR_CHUNK_BLOCKS;
+        }
+        for (size_t n = 0; n < blocks; n++) {
+            memcpy(&stream[n * block_size], nonce_counter, block_size);
+            crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        }
+        if (cipher_encrypt_blocks(cipher, stream, stream, blocks, NULL) != 1) {
             return CIPHER_ERR_ENC_FAILED;
         }
 
-        block_size_input = (length - offset > block_size) ?
-                           block_size : length - offset;
-        for (uint8_t i = 0; i < block_size_input; ++i) {
-            output[offset + i] = stream_block[i] ^ input[offset + i];
+        chunk = (length - offset > blocks * block_size) ?
+                blocks * block_size : length - offset;
+        for (size_t i = 0; i < chunk; ++i) {
+            output[offset + i] = stream[i] ^ input[offset + i];
         }
-
-        offset += block_size_input;
-        crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        offset += chunk;
     } while (offset < length);
 
     return offset;
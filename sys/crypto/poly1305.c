@@ -102,13 +102,28 @@ static void _take_input(poly1305_ctx_t *ctx, uint8_t input)
 
 void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len)
 {
-    for (size_t i = 0; i < len; i++) {
-        _take_input(ctx, data[i]);
-        if (ctx->c_idx == 16) {
+    /* complete a buffered chunk first */
+    for (; len && ctx->c_idx; data++, len--) {
+        _take_input(ctx, *data);
+        if (ctx->c_idx == POLY1305_BLOCK_SIZE) {
             poly1305_block(ctx, 1);
             _clear_c(ctx);
         }
     }
+
+    /* whole blocks are loaded a word at a time */
+    for (; len >= POLY1305_BLOCK_SIZE; data += POLY1305_BLOCK_SIZE,
+                                       len -= POLY1305_BLOCK_SIZE) {
+        for (size_t i = 0; i < 4; i++) {
+            ctx->c[i] = u8to32(&data[4 * i]);
+        }
+        poly1305_block(ctx, 1);
+        _clear_c(ctx);
+    }
+
+    for (; len; data++, len--) {
+        _take_input(ctx, *data);
+    }
 }
 
 void poly1305_init(poly1305_ctx_t *ctx, const uint8_t *key)
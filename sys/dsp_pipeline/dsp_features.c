@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       RMS and peak stage
+ *
+ * @}
+ */
+
+#include "dsp_pipeline.h"
+
+#ifndef MODULE_CMSIS_DSP
+static uint32_t _isqrt(uint32_t val)
+{
+    uint32_t res = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > val) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (val >= res + bit) {
+            val -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+#endif
+
+static dsp_q15_t *_features_process(dsp_stage_t *stage, dsp_q15_t *in,
+                                    dsp_q15_t *out, size_t *len)
+{
+    dsp_features_t *feat = (dsp_features_t *)stage;
+    int32_t max, min;
+
+    (void)out;
+    if (*len == 0) {
+        feat->rms = 0;
+        feat->peak = 0;
+        return in;
+    }
+#ifdef MODULE_CMSIS_DSP
+    q15_t rms, val;
+    uint32_t index;
+
+    arm_rms_q15(in, *len, &rms);
+    arm_max_q15(in, *len, &val, &index);
+    max = val;
+    arm_min_q15(in, *len, &val, &index);
+    min = val;
+    feat->rms = rms;
+#else
+    uint64_t sum = 0;
+
+    max = INT16_MIN;
+    min = INT16_MAX;
+    for (size_t i = 0; i < *len; i++) {
+        sum += (int32_t)in[i] * in[i];
+        if (in[i] > max) {
+            max = in[i];
+        }
+        if (in[i] < min) {
+            min = in[i];
+        }
+    }
+    /* the root of the mean square in Q30 is in Q15 */
+    uint32_t rms = _isqrt((uint32_t)(sum / *len));
+    feat->rms = (rms > INT16_MAX) ? INT16_MAX : (dsp_q15_t)rms;
+#endif
+    if (-min > max) {
+        max = -min;
+    }
+    feat->peak = (max > INT16_MAX) ? INT16_MAX : (dsp_q15_t)max;
+    return in;
+}
+
+void dsp_features_init(dsp_features_t *feat)
+{
+    feat->stage.next = NULL;
+    feat->stage.process = _features_process;
+    feat->rms = 0;
+    feat->peak = 0;
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       FFT stage, based on the CMSIS DSP library
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "dsp_pipeline.h"
+
+static dsp_q15_t *_fft_process(dsp_stage_t *stage, dsp_q15_t *in,
+                               dsp_q15_t *out, size_t *len)
+{
+    dsp_fft_t *fft = (dsp_fft_t *)stage;
+
+    /* overwrites the input */
+    arm_rfft_q15(&fft->rfft, in, fft->buf);
+    *len /= 2;
+    arm_cmplx_mag_q15(fft->buf, out, *len);
+    return out;
+}
+
+int dsp_fft_init(dsp_fft_t *fft, size_t len, dsp_q15_t *buf)
+{
+    if (arm_rfft_init_q15(&fft->rfft, len, 0, 1) != ARM_MATH_SUCCESS) {
+        return -EINVAL;
+    }
+    fft->stage.next = NULL;
+    fft->stage.process = _fft_process;
+    fft->buf = buf;
+    return 0;
+}
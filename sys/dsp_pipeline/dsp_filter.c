@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       Conversion, FIR, decimation and biquad stages
+ *
+ * Without the CMSIS DSP library, the portable code computes exactly what the
+ * library does: products are accumulated with full precision, then shifted
+ * and saturated.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "dsp_pipeline.h"
+
+#ifndef MODULE_CMSIS_DSP
+static inline dsp_q15_t _sat(int64_t val)
+{
+    if (val > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (val < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (dsp_q15_t)val;
+}
+
+/* every factor-th output of an FIR filter, as arm_fir_q15() and
+ * arm_fir_decimate_q15() */
+static void _fir(const dsp_q15_t *coeffs, uint16_t numof, dsp_q15_t *state,
+                 const dsp_q15_t *in, dsp_q15_t *out, size_t len,
+                 unsigned factor)
+{
+    memcpy(&state[numof - 1], in, len * sizeof(dsp_q15_t));
+    for (size_t n = factor - 1; n < len; n += factor) {
+        /* the window of output n ends with in[n] */
+        const dsp_q15_t *x = &state[n];
+        int64_t acc = 0;
+
+        for (unsigned k = 0; k < numof; k++) {
+            acc += (int32_t)coeffs[k] * x[k];
+        }
+        *out++ = _sat(acc >> 15);
+    }
+    memmove(state, &state[len], (numof - 1) * sizeof(dsp_q15_t));
+}
+#endif
+
+static dsp_q15_t *_convert_process(dsp_stage_t *stage, dsp_q15_t *in,
+                                   dsp_q15_t *out, size_t *len)
+{
+    dsp_convert_t *conv = (dsp_convert_t *)stage;
+    unsigned shift = 16 - conv->bits;
+
+    (void)out;
+    for (size_t i = 0; i < *len; i++) {
+        /* left-aligned offset binary to two's complement */
+        in[i] = (dsp_q15_t)((uint16_t)(in[i] << shift) ^ 0x8000);
+    }
+    return in;
+}
+
+void dsp_convert_init(dsp_convert_t *conv, uint8_t bits)
+{
+    conv->stage.next = NULL;
+    conv->stage.process = _convert_process;
+    conv->bits = bits;
+}
+
+static dsp_q15_t *_fir_process(dsp_stage_t *stage, dsp_q15_t *in,
+                               dsp_q15_t *out, size_t *len)
+{
+    dsp_fir_t *fir = (dsp_fir_t *)stage;
+
+#ifdef MODULE_CMSIS_DSP
+    arm_fir_instance_q15 inst = {
+        .numTaps = fir->numof,
+        .pState = fir->state,
+        .pCoeffs = (q15_t *)fir->coeffs,
+    };
+    arm_fir_q15(&inst, in, out, *len);
+#else
+    _fir(fir->coeffs, fir->numof, fir->state, in, out, *len, 1);
+#endif
+    return out;
+}
+
+int dsp_fir_init(dsp_fir_t *fir, const dsp_q15_t *coeffs, uint16_t numof,
+                 dsp_q15_t *state, size_t block_len)
+{
+    /* as required by arm_fir_q15() */
+    if ((numof < 4) || (numof & 1)) {
+        return -EINVAL;
+    }
+    fir->stage.next = NULL;
+    fir->stage.process = _fir_process;
+    fir->coeffs = coeffs;
+    fir->state = state;
+    fir->numof = numof;
+    memset(state, 0,
+           DSP_FIR_STATE_LEN(numof, block_len) * sizeof(dsp_q15_t));
+    return 0;
+}
+
+static dsp_q15_t *_decimate_process(dsp_stage_t *stage, dsp_q15_t *in,
+                                    dsp_q15_t *out, size_t *len)
+{
+    dsp_decimate_t *dec = (dsp_decimate_t *)stage;
+
+#ifdef MODULE_CMSIS_DSP
+    arm_fir_decimate_instance_q15 inst = {
+        .M = dec->factor,
+        .numTaps = dec->numof,
+        .pCoeffs = (q15_t *)dec->coeffs,
+        .pState = dec->state,
+    };
+    arm_fir_decimate_q15(&inst, in, out, *len);
+#else
+    _fir(dec->coeffs, dec->numof, dec->state, in, out, *len, dec->factor);
+#endif
+    *len /= dec->factor;
+    return out;
+}
+
+int dsp_decimate_init(dsp_decimate_t *dec, const dsp_q15_t *coeffs,
+                      uint16_t numof, uint8_t factor, dsp_q15_t *state,
+                      size_t block_len)
+{
+    if ((numof == 0) || (factor == 0) || (block_len % factor)) {
+        return -EINVAL;
+    }
+    dec->stage.next = NULL;
+    dec->stage.process = _decimate_process;
+    dec->coeffs = coeffs;
+    dec->state = state;
+    dec->numof = numof;
+    dec->factor = factor;
+    memset(state, 0,
+           DSP_FIR_STATE_LEN(numof, block_len) * sizeof(dsp_q15_t));
+    return 0;
+}
+
+static dsp_q15_t *_biquad_process(dsp_stage_t *stage, dsp_q15_t *in,
+                                  dsp_q15_t *out, size_t *len)
+{
+    dsp_biquad_t *bq = (dsp_biquad_t *)stage;
+
+#ifdef MODULE_CMSIS_DSP
+    arm_biquad_casd_df1_inst_q15 inst = {
+        .numStages = bq->stages,
+        .pState = bq->state,
+        .pCoeffs = (q15_t *)bq->coeffs,
+        .postShift = bq->post_shift,
+    };
+    arm_biquad_cascade_df1_q15(&inst, in, out, *len);
+#else
+    unsigned shift = 15 - bq->post_shift;
+
+    for (unsigned s = 0; s < bq->stages; s++) {
+        const dsp_q15_t *c = &bq->coeffs[6 * s];
+        dsp_q15_t *st = &bq->state[4 * s];
+        dsp_q15_t x1 = st[0], x2 = st[1], y1 = st[2], y2 = st[3];
+
+        for (size_t n = 0; n < *len; n++) {
+            dsp_q15_t x0 = in[n];
+            int64_t acc = (int32_t)c[0] * x0 + (int32_t)c[2] * x1 +
+                          (int32_t)c[3] * x2 + (int32_t)c[4] * y1 +
+                          (int32_t)c[5] * y2;
+            dsp_q15_t y0 = _sat(acc >> shift);
+
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            out[n] = y0;
+        }
+        st[0] = x1;
+        st[1] = x2;
+        st[2] = y1;
+        st[3] = y2;
+        /* the following biquads work in place */
+        in = out;
+    }
+#endif
+    return out;
+}
+
+void dsp_biquad_init(dsp_biquad_t *bq, const dsp_q15_t *coeffs,
+                     uint8_t stages, int8_t post_shift, dsp_q15_t *state)
+{
+    bq->stage.next = NULL;
+    bq->stage.process = _biquad_process;
+    bq->coeffs = coeffs;
+    bq->state = state;
+    bq->stages = stages;
+    bq->post_shift = post_shift;
+    memset(state, 0, DSP_BIQUAD_STATE_LEN(stages) * sizeof(dsp_q15_t));
+}
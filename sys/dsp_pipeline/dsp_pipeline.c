@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipeline
+ * @{
+ *
+ * @file
+ * @brief       DSP pipeline and its thread
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "dsp_pipeline.h"
+#include "msg.h"
+#include "thread.h"
+
+void dsp_pipeline_init(dsp_pipeline_t *pipe, dsp_q15_t *scratch,
+                       size_t block_len)
+{
+    pipe->stages = NULL;
+    pipe->scratch = scratch;
+    pipe->block_len = block_len;
+    pipe->sink = NULL;
+    pipe->arg = NULL;
+    pipe->pid = KERNEL_PID_UNDEF;
+}
+
+void dsp_pipeline_add(dsp_pipeline_t *pipe, dsp_stage_t *stage)
+{
+    dsp_stage_t **pos = &pipe->stages;
+
+    while (*pos) {
+        pos = &(*pos)->next;
+    }
+    stage->next = NULL;
+    *pos = stage;
+}
+
+dsp_q15_t *dsp_pipeline_run(dsp_pipeline_t *pipe, dsp_q15_t *block,
+                            size_t *len)
+{
+    dsp_q15_t *in = block;
+    dsp_q15_t *spare = pipe->scratch;
+
+    for (dsp_stage_t *stage = pipe->stages; stage; stage = stage->next) {
+        dsp_q15_t *out = stage->process(stage, in, spare, len);
+
+        if (out == spare) {
+            /* the input is no longer needed */
+            spare = in;
+        }
+        in = out;
+    }
+    return in;
+}
+
+static void *_thread(void *arg)
+{
+    dsp_pipeline_t *pipe = arg;
+
+    while (1) {
+        msg_t msg;
+        size_t len = pipe->block_len;
+
+        msg_receive(&msg);
+        dsp_q15_t *out = dsp_pipeline_run(pipe, msg.content.ptr, &len);
+        pipe->sink(pipe->arg, out, len);
+    }
+    return NULL;
+}
+
+kernel_pid_t dsp_pipeline_thread_create(dsp_pipeline_t *pipe, char *stack,
+                                        int stacksize, uint8_t priority,
+                                        dsp_pipeline_sink_t sink, void *arg)
+{
+    pipe->sink = sink;
+    pipe->arg = arg;
+    pipe->pid = thread_create(stack, stacksize, priority,
+                              THREAD_CREATE_STACKTEST, _thread, pipe,
+                              "dsp_pipeline");
+    return pipe->pid;
+}
+
+int dsp_pipeline_push(dsp_pipeline_t *pipe, dsp_q15_t *block)
+{
+    msg_t msg = { .content = { .ptr = block } };
+
+    /* without message queue, the message is only delivered while the thread
+     * waits for the next block */
+    if (msg_try_send(&msg, pipe->pid) != 1) {
+        return -EBUSY;
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_energy
+ * @{
+ *
+ * @file
+ * @brief       Energy accounting implementation
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "assert.h"
+#include "energy.h"
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+#include "xtimer.h"
+#ifdef MODULE_PM_LAYERED_GOVERNOR
+#include "pm_layered.h"
+#endif
+
+const char *const energy_netdev_state_names[ENERGY_NETDEV_STATES] = {
+    [NETOPT_STATE_OFF]      = "off",
+    [NETOPT_STATE_SLEEP]    = "sleep",
+    [NETOPT_STATE_IDLE]     = "idle",
+    [NETOPT_STATE_RX]       = "rx",
+    [NETOPT_STATE_TX]       = "tx",
+    [NETOPT_STATE_RESET]    = "reset",
+    [NETOPT_STATE_STANDBY]  = "standby",
+};
+
+static energy_account_t *_accounts;
+
+/* µA times µs, in µC */
+static inline uint64_t _charge(uint32_t current_ua, uint64_t time_us)
+{
+    return (current_ua * time_us) / US_PER_SEC;
+}
+
+static void _print_line(const char *kind, const char *name, uint64_t time_us,
+                        uint64_t charge)
+{
+    /* newlib nano has no 64 bit printf, ms and µC fit 32 bit for weeks */
+    printf("  %s %s %" PRIu32 " ms %" PRIu32 " uC\n", kind, name,
+           (uint32_t)(time_us / US_PER_MS), (uint32_t)charge);
+}
+
+void energy_account_init(energy_account_t *account,
+                         const energy_model_t *model, uint64_t *time_us,
+                         unsigned state)
+{
+    unsigned irq_state = irq_disable();
+    energy_account_t *pos = _accounts;
+
+    while (pos && (pos != account)) {
+        pos = pos->next;
+    }
+    if (pos == NULL) {
+        account->next = _accounts;
+        _accounts = account;
+    }
+
+    account->model = model;
+    account->time_us = time_us;
+    for (unsigned i = 0; i < model->numof; i++) {
+        time_us[i] = 0;
+    }
+    account->state = state;
+    account->since = xtimer_now_usec64();
+    irq_restore(irq_state);
+}
+
+void energy_account_set(energy_account_t *account, unsigned state)
+{
+    assert(state < account->model->numof);
+
+    unsigned irq_state = irq_disable();
+    uint64_t now = xtimer_now_usec64();
+
+    account->time_us[account->state] += now - account->since;
+    account->state = state;
+    account->since = now;
+    irq_restore(irq_state);
+}
+
+uint64_t energy_account_time(const energy_account_t *account, unsigned state)
+{
+    unsigned irq_state = irq_disable();
+    uint64_t time = account->time_us[state];
+
+    if (state == account->state) {
+        time += xtimer_now_usec64() - account->since;
+    }
+    irq_restore(irq_state);
+    return time;
+}
+
+uint64_t energy_account_charge(const energy_account_t *account)
+{
+    uint64_t charge = 0;
+
+    for (unsigned i = 0; i < account->model->numof; i++) {
+        charge += _charge(account->model->current_ua[i],
+                          energy_account_time(account, i));
+    }
+    return charge;
+}
+
+static uint64_t _print_cpu(void)
+{
+    uint64_t total = 0;
+
+    puts("energy: cpu");
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        const thread_t *thread = (const thread_t *)sched_threads[pid];
+
+        if (thread == NULL) {
+            continue;
+        }
+
+        uint64_t time = _xtimer_usec_from_ticks64(
+            sched_pidlist[pid].runtime_ticks);
+        uint32_t current = ENERGY_CPU_ACTIVE_UA;
+
+        if (thread->priority == THREAD_PRIORITY_IDLE) {
+#ifdef MODULE_PM_LAYERED_GOVERNOR
+            /* accounted below, by power mode */
+            continue;
+#else
+            current = ENERGY_CPU_IDLE_UA;
+#endif
+        }
+
+        const char *name = thread_getname(pid);
+        char buf[8];
+        if (name == NULL) {
+            snprintf(buf, sizeof(buf), "%d", (int)pid);
+            name = buf;
+        }
+        uint64_t charge = _charge(current, time);
+        _print_line("thread", name, time, charge);
+        total += charge;
+    }
+
+#ifdef MODULE_PM_LAYERED_GOVERNOR
+    static const uint32_t pm_ua[PM_NUM_MODES + 1] = ENERGY_PM_UA;
+    const pm_layered_stats_t *stats = pm_layered_stats();
+
+    for (unsigned mode = 0; mode <= PM_NUM_MODES; mode++) {
+        char name[8];
+        uint64_t charge = _charge(pm_ua[mode], stats[mode].residency_us);
+
+        snprintf(name, sizeof(name), "%u", mode);
+        _print_line("pm", name, stats[mode].residency_us, charge);
+        total += charge;
+    }
+#endif
+    return total;
+}
+
+void energy_print(void)
+{
+    uint64_t total = _print_cpu();
+
+    for (const energy_account_t *account = _accounts; account;
+         account = account->next) {
+        const energy_model_t *model = account->model;
+
+        printf("energy: %s\n", model->name);
+        for (unsigned i = 0; i < model->numof; i++) {
+            uint64_t time = energy_account_time(account, i);
+            uint64_t state_charge = _charge(model->current_ua[i], time);
+            char buf[8];
+            const char *name = buf;
+
+            if (model->state_names) {
+                name = model->state_names[i];
+            }
+            else {
+                snprintf(buf, sizeof(buf), "%u", i);
+            }
+            _print_line("state", name, time, state_charge);
+            total += state_charge;
+        }
+    }
+    printf("energy: total %" PRIu32 " uC\n", (uint32_t)total);
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup     sys_event
+ * @{
+ *
+ * @file
+ * @brief       Combined wait implementation, blocking path
+ *
+ * @}
+ */
+
+#include "event/wait_multi.h"
+
+event_wait_multi_type_t event_wait_multi_block(event_queue_t *queue,
+                                               thread_flags_t mask,
+                                               event_wait_multi_t *res)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+    thread_flags_t wait = mask | THREAD_FLAG_MSG_WAITING;
+    event_wait_multi_type_t type;
+
+    if (queue != NULL) {
+        wait |= THREAD_FLAG_EVENT;
+    }
+    do {
+        /* waiting clears the flags, put them back for the fast path to
+         * sort them out */
+        thread_flags_t flags = thread_flags_wait_any(wait);
+        unsigned state = irq_disable();
+        me->flags |= flags;
+        irq_restore(state);
+        type = event_wait_multi_try(queue, mask, res);
+    } while (type == EVENT_WAIT_MULTI_NONE);
+    return type;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup     sys_event
+ * @{
+ *
+ * @file
+ * @brief       Event work queue implementation
+ *
+ * event_post() notifies the waiter of a queue only, so the waiter of all
+ * queues is always the worker that went idle last. A woken worker wakes the
+ * next idle one, if work is left.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+
+#include "irq.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "event/workq.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+event_queue_t event_workq_queues[EVENT_WORKQ_PRIO_NUMOF];
+
+static char _stacks[EVENT_WORKQ_WORKERS_NUMOF][EVENT_WORKQ_STACKSIZE];
+static thread_t *_idle[EVENT_WORKQ_WORKERS_NUMOF];
+static unsigned _idle_numof;
+
+/* must be called with interrupts disabled */
+static void _set_waiter(thread_t *waiter)
+{
+    for (unsigned i = 0; i < EVENT_WORKQ_PRIO_NUMOF; i++) {
+        event_workq_queues[i].waiter = waiter;
+    }
+}
+
+/* must be called with interrupts disabled */
+static event_t *_pop(void)
+{
+    for (unsigned i = 0; i < EVENT_WORKQ_PRIO_NUMOF; i++) {
+        event_t *event = (event_t *)clist_lpop(&event_workq_queues[i].event_list);
+
+        if (event != NULL) {
+            return event;
+        }
+    }
+    return NULL;
+}
+
+/* must be called with interrupts disabled */
+static bool _pending(void)
+{
+    for (unsigned i = 0; i < EVENT_WORKQ_PRIO_NUMOF; i++) {
+        if (event_workq_queues[i].event_list.next != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* must be called with interrupts disabled */
+static void _wake_up(thread_t *me)
+{
+    /* the worker may have been woken up by a flag left from a busy phase,
+     * while another one is the waiter */
+    for (unsigned i = 0; i < _idle_numof; i++) {
+        if (_idle[i] == me) {
+            _idle[i] = _idle[--_idle_numof];
+            break;
+        }
+    }
+    _set_waiter((_idle_numof > 0) ? _idle[_idle_numof - 1] : me);
+}
+
+static void *_worker(void *arg)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+
+    (void)arg;
+    while (1) {
+        thread_t *peer = NULL;
+        unsigned state = irq_disable();
+        event_t *event = _pop();
+
+        if (event == NULL) {
+            _idle[_idle_numof++] = me;
+            _set_waiter(me);
+            irq_restore(state);
+            thread_flags_wait_any(THREAD_FLAG_EVENT);
+            state = irq_disable();
+            _wake_up(me);
+            irq_restore(state);
+            continue;
+        }
+        if (_pending() && (_idle_numof > 0)) {
+            peer = _idle[_idle_numof - 1];
+        }
+        irq_restore(state);
+
+        if (peer != NULL) {
+            thread_flags_set(peer, THREAD_FLAG_EVENT);
+        }
+        event->list_node.next = NULL;
+        DEBUG("event_workq: %" PRIkernel_pid " handles %p\n", me->pid,
+              (void *)event);
+        event->handler(event);
+    }
+    return NULL;
+}
+
+void event_workq_init(void)
+{
+    for (unsigned i = 0; i < EVENT_WORKQ_WORKERS_NUMOF; i++) {
+        kernel_pid_t pid = thread_create(_stacks[i], sizeof(_stacks[i]),
+                                         EVENT_WORKQ_THREAD_PRIO,
+                                         THREAD_CREATE_WOUT_YIELD |
+                                         THREAD_CREATE_STACKTEST,
+                                         _worker, NULL, "event_workq");
+
+        if (i == 0) {
+            /* events may be posted before the first worker ran */
+            unsigned state = irq_disable();
+            _set_waiter((thread_t *)thread_get(pid));
+            irq_restore(state);
+        }
+    }
+}
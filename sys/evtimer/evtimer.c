@@ -22,6 +22,8 @@
  * @}
  */
 
+#include <stdbool.h>
+
 #include "div.h"
 #include "irq.h"
 #include "xtimer.h"
@@ -31,6 +33,7 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#ifndef MODULE_EVTIMER_HEAP
 /* XXX this function is intentionally non-static, since the optimizer can't
  * handle the pointer hack in this function */
 void evtimer_add_event_to_list(evtimer_t *evtimer, evtimer_event_t *event)
@@ -138,33 +141,41 @@ static void _update_head_offset(evtimer_t *evtimer)
     }
 }
 
-void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
+static void _add_event(evtimer_t *evtimer, evtimer_event_t *event)
 {
-    unsigned state = irq_disable();
-
-    DEBUG("evtimer_add(): adding event with offset %" PRIu32 "\n", event->offset);
-
     _update_head_offset(evtimer);
     evtimer_add_event_to_list(evtimer, event);
     if (evtimer->events == event) {
         _set_timer(&evtimer->timer, event->offset);
     }
-    irq_restore(state);
-    if (sched_context_switch_request) {
-        thread_yield_higher();
-    }
 }
 
-void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
+static void _del_event(evtimer_t *evtimer, evtimer_event_t *event)
 {
-    unsigned state = irq_disable();
-
-    DEBUG("evtimer_del(): removing event with offset %" PRIu32 "\n", event->offset);
-
     _update_head_offset(evtimer);
     _del_event_from_list(evtimer, event);
     _update_timer(evtimer);
-    irq_restore(state);
+}
+
+static uint32_t _remaining(const evtimer_t *evtimer,
+                           const evtimer_event_t *event)
+{
+    const evtimer_event_t *list = evtimer->events;
+    uint32_t offset;
+
+    if (list == NULL) {
+        return UINT32_MAX;
+    }
+    /* the offset of the head is only updated when the list changes */
+    offset = _get_offset((xtimer_t *)&evtimer->timer);
+    while (list != event) {
+        list = list->next;
+        if (list == NULL) {
+            return UINT32_MAX;
+        }
+        offset += list->offset;
+    }
+    return offset;
 }
 
 static evtimer_event_t *_get_next(evtimer_t *evtimer)
@@ -198,6 +209,190 @@ static void _evtimer_handler(void *arg)
 
     _update_timer(evtimer);
 }
+#else   /* MODULE_EVTIMER_HEAP */
+/* The events are kept in a pairing heap ordered by their absolute deadline:
+ * every event points to its first child (child), its next sibling (next) and
+ * its parent if it is the first child or its previous sibling otherwise
+ * (prev). Only the root has prev == NULL. */
+
+static evtimer_event_t *_meld(evtimer_event_t *a, evtimer_event_t *b)
+{
+    if (a == NULL) {
+        return b;
+    }
+    if (b == NULL) {
+        return a;
+    }
+    if (b->deadline < a->deadline) {
+        evtimer_event_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    /* b becomes the first child of a */
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+/* melds a list of siblings into one heap, left to right in pairs, then
+ * the pairs right to left */
+static evtimer_event_t *_merge_pairs(evtimer_event_t *first)
+{
+    evtimer_event_t *pairs = NULL, *res = NULL;
+
+    while (first) {
+        evtimer_event_t *a = first, *b = first->next;
+
+        first = (b) ? b->next : NULL;
+        a->next = a->prev = NULL;
+        if (b) {
+            b->next = b->prev = NULL;
+        }
+        a = _meld(a, b);
+        /* the pairs are stacked up in reverse order */
+        a->next = pairs;
+        pairs = a;
+    }
+    while (pairs) {
+        evtimer_event_t *pair = pairs;
+
+        pairs = pair->next;
+        pair->next = NULL;
+        res = _meld(pair, res);
+    }
+    return res;
+}
+
+static inline bool _is_pending(const evtimer_t *evtimer,
+                               const evtimer_event_t *event)
+{
+    return (event == evtimer->events) || (event->prev != NULL);
+}
+
+static void _update_timer(evtimer_t *evtimer)
+{
+    if (evtimer->events) {
+        uint64_t now_us = xtimer_now_usec64();
+        uint64_t deadline = evtimer->events->deadline;
+
+        xtimer_set64(&evtimer->timer,
+                     (deadline > now_us) ? (deadline - now_us) : 0);
+    }
+    else {
+        xtimer_remove(&evtimer->timer);
+    }
+}
+
+static void _add_event(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    event->deadline = xtimer_now_usec64() +
+                      ((uint64_t)event->offset * US_PER_MS);
+    event->child = event->prev = event->next = NULL;
+    evtimer->events = _meld(evtimer->events, event);
+    if (evtimer->events == event) {
+        _update_timer(evtimer);
+    }
+}
+
+static void _del_event(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    evtimer_event_t *sub;
+
+    if (!_is_pending(evtimer, event)) {
+        return;
+    }
+    if (event == evtimer->events) {
+        evtimer->events = _merge_pairs(event->child);
+        event->child = NULL;
+        _update_timer(evtimer);
+        return;
+    }
+    /* cut the subtree of the event out and meld it back in */
+    if (event->prev->child == event) {
+        event->prev->child = event->next;
+    }
+    else {
+        event->prev->next = event->next;
+    }
+    if (event->next) {
+        event->next->prev = event->prev;
+    }
+    event->next = event->prev = NULL;
+    sub = _merge_pairs(event->child);
+    event->child = NULL;
+    evtimer->events = _meld(evtimer->events, sub);
+}
+
+static uint32_t _remaining(const evtimer_t *evtimer,
+                           const evtimer_event_t *event)
+{
+    uint64_t now_us;
+
+    if (!_is_pending(evtimer, event)) {
+        return UINT32_MAX;
+    }
+    now_us = xtimer_now_usec64();
+    if (event->deadline <= now_us) {
+        return 0;
+    }
+    /* add half of 125 so integer division rounds to nearest */
+    return div_u64_by_125(((event->deadline - now_us) >> 3) + 62);
+}
+
+static void _evtimer_handler(void *arg)
+{
+    DEBUG("_evtimer_handler()\n");
+
+    evtimer_t *evtimer = (evtimer_t *)arg;
+    evtimer_event_t *event;
+
+    while ((event = evtimer->events) &&
+           (event->deadline <= xtimer_now_usec64())) {
+        evtimer->events = _merge_pairs(event->child);
+        event->child = NULL;
+        evtimer->callback(event);
+    }
+
+    _update_timer(evtimer);
+}
+#endif  /* MODULE_EVTIMER_HEAP */
+
+void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+
+    DEBUG("evtimer_add(): adding event with offset %" PRIu32 "\n", event->offset);
+
+    _add_event(evtimer, event);
+    irq_restore(state);
+    if (sched_context_switch_request) {
+        thread_yield_higher();
+    }
+}
+
+void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+
+    DEBUG("evtimer_del(): removing event with offset %" PRIu32 "\n", event->offset);
+
+    _del_event(evtimer, event);
+    irq_restore(state);
+}
+
+uint32_t evtimer_remaining(const evtimer_t *evtimer,
+                           const evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+    uint32_t res = _remaining(evtimer, event);
+
+    irq_restore(state);
+    return res;
+}
 
 void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
 {
@@ -207,6 +402,20 @@ void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
     evtimer->events = NULL;
 }
 
+#ifdef MODULE_EVTIMER_HEAP
+static void _print(const evtimer_t *evtimer, const evtimer_event_t *event)
+{
+    for (; event; event = event->next) {
+        printf("ev offset=%u\n", (unsigned)_remaining(evtimer, event));
+        _print(evtimer, event->child);
+    }
+}
+
+void evtimer_print(const evtimer_t *evtimer)
+{
+    _print(evtimer, evtimer->events);
+}
+#else
 void evtimer_print(const evtimer_t *evtimer)
 {
     evtimer_event_t *list = evtimer->events;
@@ -217,3 +426,4 @@ void evtimer_print(const evtimer_t *evtimer)
         list = list->next;
     }
 }
+#endif
@@ -48,6 +48,66 @@ static const uint32_t _tenmap[] = {
 
 #define TENMAP_SIZE  (sizeof(_tenmap) / sizeof(_tenmap[0]))
 
+/* "00" to "99", so two digits are written per division */
+static const char _digit_pairs[200] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9',
+};
+
+/* Divisions by constants as multiplication with the reciprocal, exact for
+ * all 32 bit values. Compilers do this themselves where the CPU has a
+ * 32x32->64 bit multiplication, but e.g. on Cortex-M0 they call the
+ * (slow) software division instead. */
+static inline uint32_t _div100(uint32_t x)
+{
+    return ((uint64_t)x * 0x51EB851FU) >> 37;
+}
+
+static inline uint32_t _div10000(uint32_t x)
+{
+    return ((uint64_t)x * 0xD1B71759U) >> 45;
+}
+
+static inline void _write_pair(char *out, unsigned val)
+{
+    out[0] = _digit_pairs[2 * val];
+    out[1] = _digit_pairs[2 * val + 1];
+}
+
+/* writes the digits of val ending right before end */
+static void _write_u32_dec(char *end, uint32_t val)
+{
+    while (val >= 100) {
+        uint32_t q = _div100(val);
+        end -= 2;
+        _write_pair(end, val - (q * 100));
+        val = q;
+    }
+    if (val >= 10) {
+        _write_pair(end - 2, val);
+    }
+    else {
+        end[-1] = '0' + val;
+    }
+}
+
+/* writes val < 10000 as exactly four digits */
+static void _write_dec4(char *out, uint32_t val)
+{
+    uint32_t q = _div100(val);
+
+    _write_pair(out, q);
+    _write_pair(out + 2, val - (q * 100));
+}
+
 static inline int _is_digit(char c)
 {
     return (c >= '0' && c <= '9');
@@ -184,26 +244,30 @@ size_t fmt_u64_dec(char *out, uint64_t val)
     uint32_t q;
     size_t len = 0;
 
+    if (val <= UINT32_MAX) {
+        return fmt_u32_dec(out, val);
+    }
+
     d[0] = val       & 0xFFFF;
     d[1] = (val>>16) & 0xFFFF;
     d[2] = (val>>32) & 0xFFFF;
     d[3] = (val>>48) & 0xFFFF;
 
     d[0] = 656 * d[3] + 7296 * d[2] + 5536 * d[1] + d[0];
-    q = d[0] / 10000;
-    d[0] = d[0] % 10000;
+    q = _div10000(d[0]);
+    d[0] -= q * 10000;
 
     d[1] = q + 7671 * d[3] + 9496 * d[2] + 6 * d[1];
-    q = d[1] / 10000;
-    d[1] = d[1] % 10000;
+    q = _div10000(d[1]);
+    d[1] -= q * 10000;
 
     d[2] = q + 4749 * d[3] + 42 * d[2];
-    q = d[2] / 10000;
-    d[2] = d[2] % 10000;
+    q = _div10000(d[2]);
+    d[2] -= q * 10000;
 
     d[3] = q + 281 * d[3];
-    q = d[3] / 10000;
-    d[3] = d[3] % 10000;
+    q = _div10000(d[3]);
+    d[3] -= q * 10000;
 
     d[4] = q;
 
@@ -218,13 +282,9 @@ size_t fmt_u64_dec(char *out, uint64_t val)
 
     if (out) {
         out += len;
-        memset(out, '0', total_len - len);
         while(first) {
             first--;
-            if (d[first]) {
-                size_t tmp = fmt_u32_dec(NULL, d[first]);
-                fmt_u32_dec(out+(4-tmp), d[first]);
-            }
+            _write_dec4(out, d[first]);
             out += 4;
         }
     }
@@ -248,10 +308,7 @@ size_t fmt_u32_dec(char *out, uint32_t val)
     }
 
     if (out) {
-        char *ptr = out + len;
-        do {
-            *--ptr = (val % 10) + '0';
-        } while ((val /= 10));
+        _write_u32_dec(out + len, val);
     }
 
     return len;
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_fmt
+ * @{
+ *
+ * @file
+ * @brief       Shortest round-trip float formatting
+ *
+ * This is the Ryu algorithm by Ulf Adams ("Ryu: fast float-to-string
+ * conversion", PLDI 2018), in the 32 bit variant which only needs
+ * 32x64 bit multiplications and no floating point math.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "fmt.h"
+
+#define FLOAT_MANTISSA_BITS     (23)
+#define FLOAT_EXPONENT_BITS     (8)
+#define FLOAT_BIAS              (127)
+
+#define FLOAT_POW5_INV_BITCOUNT (59)
+#define FLOAT_POW5_BITCOUNT     (61)
+
+/* decimal exponents of the leading digit printed without exponent */
+#define PLAIN_EXP_MIN           (-4)
+#define PLAIN_EXP_MAX           (8)
+
+/* floor(2^(FLOAT_POW5_INV_BITCOUNT + pow5bits(i) - 1) / 5^i) + 1 */
+static const uint64_t _pow5_inv_split[31] = {
+    0x0800000000000001ULL, 0x0666666666666667ULL,
+    0x051eb851eb851eb9ULL, 0x04189374bc6a7efaULL,
+    0x068db8bac710cb2aULL, 0x053e2d6238da3c22ULL,
+    0x0431bde82d7b634eULL, 0x06b5fca6af2bd216ULL,
+    0x055e63b88c230e78ULL, 0x044b82fa09b5a52dULL,
+    0x06df37f675ef6eaeULL, 0x057f5ff85e592558ULL,
+    0x0465e6604b7a8447ULL, 0x0709709a125da071ULL,
+    0x05a126e1a84ae6c1ULL, 0x0480ebe7b9d58567ULL,
+    0x0734aca5f6226f0bULL, 0x05c3bd5191b525a3ULL,
+    0x049c97747490eae9ULL, 0x0760f253edb4ab0eULL,
+    0x05e72843249088d8ULL, 0x04b8ed0283a6d3e0ULL,
+    0x078e480405d7b966ULL, 0x060b6cd004ac9452ULL,
+    0x04d5f0a66a23a9dbULL, 0x07bcb43d769f762bULL,
+    0x063090312bb2c4efULL, 0x04f3a68dbc8f03f3ULL,
+    0x07ec3daf94180651ULL, 0x065697bfa9acd1daULL,
+    0x051212ffbaf0a7e2ULL,
+};
+
+/* 5^i, normalized to FLOAT_POW5_BITCOUNT bits */
+static const uint64_t _pow5_split[47] = {
+    0x1000000000000000ULL, 0x1400000000000000ULL,
+    0x1900000000000000ULL, 0x1f40000000000000ULL,
+    0x1388000000000000ULL, 0x186a000000000000ULL,
+    0x1e84800000000000ULL, 0x1312d00000000000ULL,
+    0x17d7840000000000ULL, 0x1dcd650000000000ULL,
+    0x12a05f2000000000ULL, 0x174876e800000000ULL,
+    0x1d1a94a200000000ULL, 0x12309ce540000000ULL,
+    0x16bcc41e90000000ULL, 0x1c6bf52634000000ULL,
+    0x11c37937e0800000ULL, 0x16345785d8a00000ULL,
+    0x1bc16d674ec80000ULL, 0x1158e460913d0000ULL,
+    0x15af1d78b58c4000ULL, 0x1b1ae4d6e2ef5000ULL,
+    0x10f0cf064dd59200ULL, 0x152d02c7e14af680ULL,
+    0x1a784379d99db420ULL, 0x108b2a2c28029094ULL,
+    0x14adf4b7320334b9ULL, 0x19d971e4fe8401e7ULL,
+    0x1027e72f1f128130ULL, 0x1431e0fae6d7217cULL,
+    0x193e5939a08ce9dbULL, 0x1f8def8808b02452ULL,
+    0x13b8b5b5056e16b3ULL, 0x18a6e32246c99c60ULL,
+    0x1ed09bead87c0378ULL, 0x13426172c74d822bULL,
+    0x1812f9cf7920e2b6ULL, 0x1e17b84357691b64ULL,
+    0x12ced32a16a1b11eULL, 0x178287f49c4a1d66ULL,
+    0x1d6329f1c35ca4bfULL, 0x125dfa371a19e6f7ULL,
+    0x16f578c4e0a060b5ULL, 0x1cb2d6f618c878e3ULL,
+    0x11efc659cf7d4b8dULL, 0x166bb7f0435c9e71ULL,
+    0x1c06a5ec5433c60dULL,
+};
+
+/* number of bits of 5^e, for 0 <= e <= 3528 */
+static inline int32_t _pow5bits(int32_t e)
+{
+    return (int32_t)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+/* floor(log10(2^e)), for 0 <= e <= 1650 */
+static inline uint32_t _log10_pow2(int32_t e)
+{
+    return ((uint32_t)e * 78913) >> 18;
+}
+
+/* floor(log10(5^e)), for 0 <= e <= 2620 */
+static inline uint32_t _log10_pow5(int32_t e)
+{
+    return ((uint32_t)e * 732923) >> 20;
+}
+
+static bool _multiple_of_pow5(uint32_t val, uint32_t p)
+{
+    uint32_t count = 0;
+
+    while (val % 5 == 0) {
+        val /= 5;
+        count++;
+    }
+    return count >= p;
+}
+
+static inline bool _multiple_of_pow2(uint32_t val, uint32_t p)
+{
+    return (val & ((1U << p) - 1)) == 0;
+}
+
+static inline uint32_t _mul_shift(uint32_t m, uint64_t factor, int32_t shift)
+{
+    uint64_t lo = (uint64_t)m * (uint32_t)factor;
+    uint64_t hi = (uint64_t)m * (uint32_t)(factor >> 32);
+
+    return (uint32_t)(((lo >> 32) + hi) >> (shift - 32));
+}
+
+/* converts mantissa and exponent to the shortest decimal digits and
+ * decimal exponent that round-trip */
+static uint32_t _shortest(uint32_t ieee_mantissa, uint32_t ieee_exponent,
+                          int32_t *exp)
+{
+    int32_t e2;
+    uint32_t m2;
+
+    if (ieee_exponent == 0) {
+        e2 = 1 - FLOAT_BIAS - FLOAT_MANTISSA_BITS - 2;
+        m2 = ieee_mantissa;
+    }
+    else {
+        e2 = (int32_t)ieee_exponent - FLOAT_BIAS - FLOAT_MANTISSA_BITS - 2;
+        m2 = (1U << FLOAT_MANTISSA_BITS) | ieee_mantissa;
+    }
+    bool accept_bounds = (m2 & 1) == 0;
+
+    /* the value and the halfway points to its neighbours, times four */
+    uint32_t mv = 4 * m2;
+    uint32_t mp = 4 * m2 + 2;
+    uint32_t mm_shift = (ieee_mantissa != 0) || (ieee_exponent <= 1);
+    uint32_t mm = 4 * m2 - 1 - mm_shift;
+
+    uint32_t vr, vp, vm;
+    int32_t e10;
+    bool vm_trailing_zeros = false;
+    bool vr_trailing_zeros = false;
+    uint8_t last_removed = 0;
+
+    if (e2 >= 0) {
+        uint32_t q = _log10_pow2(e2);
+        int32_t k = FLOAT_POW5_INV_BITCOUNT + _pow5bits(q) - 1;
+        int32_t i = -e2 + (int32_t)q + k;
+
+        e10 = q;
+        vr = _mul_shift(mv, _pow5_inv_split[q], i);
+        vp = _mul_shift(mp, _pow5_inv_split[q], i);
+        vm = _mul_shift(mm, _pow5_inv_split[q], i);
+        if ((q != 0) && ((vp - 1) / 10 <= vm / 10)) {
+            /* the loop below removes no digit, so we need the last removed
+             * one now */
+            int32_t l = FLOAT_POW5_INV_BITCOUNT + _pow5bits(q - 1) - 1;
+            last_removed = _mul_shift(mv, _pow5_inv_split[q - 1],
+                                      -e2 + (int32_t)q - 1 + l) % 10;
+        }
+        if (q <= 9) {
+            /* only one of mp, mv and mm can be a multiple of 5 */
+            if (mv % 5 == 0) {
+                vr_trailing_zeros = _multiple_of_pow5(mv, q);
+            }
+            else if (accept_bounds) {
+                vm_trailing_zeros = _multiple_of_pow5(mm, q);
+            }
+            else {
+                vp -= _multiple_of_pow5(mp, q);
+            }
+        }
+    }
+    else {
+        uint32_t q = _log10_pow5(-e2);
+        int32_t i = -e2 - (int32_t)q;
+        int32_t k = _pow5bits(i) - FLOAT_POW5_BITCOUNT;
+        int32_t j = (int32_t)q - k;
+
+        e10 = (int32_t)q + e2;
+        vr = _mul_shift(mv, _pow5_split[i], j);
+        vp = _mul_shift(mp, _pow5_split[i], j);
+        vm = _mul_shift(mm, _pow5_split[i], j);
+        if ((q != 0) && ((vp - 1) / 10 <= vm / 10)) {
+            j = (int32_t)q - 1 - (_pow5bits(i + 1) - FLOAT_POW5_BITCOUNT);
+            last_removed = _mul_shift(mv, _pow5_split[i + 1], j) % 10;
+        }
+        if (q <= 1) {
+            /* mv = 4 * m2 has at least two trailing zero bits */
+            vr_trailing_zeros = true;
+            if (accept_bounds) {
+                vm_trailing_zeros = (mm_shift == 1);
+            }
+            else {
+                vp--;
+            }
+        }
+        else if (q < 31) {
+            vr_trailing_zeros = _multiple_of_pow2(mv, q - 1);
+        }
+    }
+
+    /* remove digits as long as the result stays within the bounds */
+    int32_t removed = 0;
+    uint32_t output;
+
+    if (vm_trailing_zeros || vr_trailing_zeros) {
+        while (vp / 10 > vm / 10) {
+            vm_trailing_zeros &= (vm % 10 == 0);
+            vr_trailing_zeros &= (last_removed == 0);
+            last_removed = vr % 10;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_trailing_zeros) {
+            while (vm % 10 == 0) {
+                vr_trailing_zeros &= (last_removed == 0);
+                last_removed = vr % 10;
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vr_trailing_zeros && (last_removed == 5) && (vr % 2 == 0)) {
+            /* exactly halfway, round to even */
+            last_removed = 4;
+        }
+        output = vr + (((vr == vm) && (!accept_bounds || !vm_trailing_zeros)) ||
+                       (last_removed >= 5));
+    }
+    else {
+        while (vp / 10 > vm / 10) {
+            last_removed = vr % 10;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + ((vr == vm) || (last_removed >= 5));
+    }
+
+    *exp = e10 + removed;
+    return output;
+}
+
+size_t fmt_float_shortest(char *out, float f)
+{
+    /* sign, 9 digits, decimal point and "e-45" */
+    char buf[16];
+    char *pos = buf;
+    uint32_t bits;
+
+    memcpy(&bits, &f, sizeof(bits));
+    uint32_t ieee_mantissa = bits & ((1U << FLOAT_MANTISSA_BITS) - 1);
+    uint32_t ieee_exponent = (bits >> FLOAT_MANTISSA_BITS) &
+                             ((1U << FLOAT_EXPONENT_BITS) - 1);
+
+    if (ieee_exponent == ((1U << FLOAT_EXPONENT_BITS) - 1)) {
+        return fmt_str(out, ieee_mantissa ? "nan" :
+                            ((bits >> 31) ? "-inf" : "inf"));
+    }
+    if (bits >> 31) {
+        *pos++ = '-';
+    }
+    if ((ieee_exponent == 0) && (ieee_mantissa == 0)) {
+        *pos++ = '0';
+        goto out;
+    }
+
+    int32_t exp;
+    uint32_t digits = _shortest(ieee_mantissa, ieee_exponent, &exp);
+    int32_t len = fmt_u32_dec(NULL, digits);
+    /* decimal exponent of the leading digit */
+    int32_t lead = exp + len - 1;
+
+    if ((lead < PLAIN_EXP_MIN) || (lead > PLAIN_EXP_MAX)) {
+        /* d[.ddd]e[-]x */
+        fmt_u32_dec(pos + 1, digits);
+        pos[0] = pos[1];
+        if (len > 1) {
+            pos[1] = '.';
+            pos += len + 1;
+        }
+        else {
+            pos++;
+        }
+        *pos++ = 'e';
+        pos += fmt_s32_dec(pos, lead);
+    }
+    else if (exp >= 0) {
+        /* integer, pad with zeros */
+        pos += fmt_u32_dec(pos, digits);
+        memset(pos, '0', exp);
+        pos += exp;
+    }
+    else if (lead >= 0) {
+        /* insert the decimal point after the integer digits */
+        fmt_u32_dec(pos, digits);
+        memmove(pos + lead + 2, pos + lead + 1, len - lead - 1);
+        pos[lead + 1] = '.';
+        pos += len + 1;
+    }
+    else {
+        /* 0.[0...]ddd */
+        *pos++ = '0';
+        *pos++ = '.';
+        memset(pos, '0', -lead - 1);
+        pos += -lead - 1;
+        pos += fmt_u32_dec(pos, digits);
+    }
+
+out:
+    if (out) {
+        memcpy(out, buf, pos - buf);
+    }
+    return pos - buf;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_fs_checkpoint
+ * @{
+ *
+ * @file
+ * @brief       Mount checkpoint implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "fs/checkpoint.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define ALIGN(n)        ((((n) + FS_CHECKPOINT_ALIGN - 1) / \
+                          FS_CHECKPOINT_ALIGN) * FS_CHECKPOINT_ALIGN)
+/* staging buffer for writes, a multiple of the alignment */
+#define STAGE_SIZE      ALIGN(32U)
+
+static uint32_t _sector_size(const mtd_dev_t *dev)
+{
+    return dev->page_size * dev->pages_per_sector;
+}
+
+static uint16_t _crc(uint16_t len, const void *data)
+{
+    uint16_t crc = crc16_ccitt_calc((const uint8_t *)&len, sizeof(len));
+
+    return crc16_ccitt_update(crc, data, len);
+}
+
+static int _write(mtd_dev_t *dev, uint32_t addr, const uint8_t *data,
+                  size_t len)
+{
+    /* page programs must not cross page boundaries */
+    while (len > 0) {
+        size_t chunk = dev->page_size - (addr % dev->page_size);
+        if (chunk > len) {
+            chunk = len;
+        }
+        int res = mtd_write(dev, data, addr, chunk);
+        if (res < 0) {
+            return res;
+        }
+        data += chunk;
+        addr += chunk;
+        len -= chunk;
+    }
+    return 0;
+}
+
+int fs_checkpoint_save(mtd_dev_t *dev, uint32_t sector, const void *data,
+                       uint16_t len)
+{
+    fs_checkpoint_hdr_t hdr = {
+        .magic = FS_CHECKPOINT_MAGIC,
+        .len = len,
+        .crc = _crc(len, data),
+    };
+    uint8_t stage[STAGE_SIZE];
+    uint32_t addr = sector * _sector_size(dev);
+    const uint8_t *src = data;
+
+    if ((sizeof(hdr) + len) > _sector_size(dev)) {
+        return -ENOSPC;
+    }
+    int res = fs_checkpoint_discard(dev, sector);
+    if (res < 0) {
+        return res;
+    }
+
+    /* the header goes last, an interrupted save leaves no checkpoint */
+    addr += sizeof(hdr);
+    while (len > 0) {
+        size_t chunk = (len < sizeof(stage)) ? len : sizeof(stage);
+
+        memcpy(stage, src, chunk);
+        memset(&stage[chunk], 0xff, ALIGN(chunk) - chunk);
+        res = _write(dev, addr, stage, ALIGN(chunk));
+        if (res < 0) {
+            return res;
+        }
+        src += chunk;
+        addr += chunk;
+        len -= chunk;
+    }
+    DEBUG("fs_checkpoint: saved %u bytes to sector %lu\n", (unsigned)hdr.len,
+          (unsigned long)sector);
+    return _write(dev, sector * _sector_size(dev), (const uint8_t *)&hdr,
+                  sizeof(hdr));
+}
+
+int fs_checkpoint_take(mtd_dev_t *dev, uint32_t sector, void *data,
+                       uint16_t len)
+{
+    fs_checkpoint_hdr_t hdr;
+    uint32_t addr = sector * _sector_size(dev);
+
+    int res = mtd_read(dev, &hdr, addr, sizeof(hdr));
+    if (res < 0) {
+        return res;
+    }
+    if ((hdr.magic != FS_CHECKPOINT_MAGIC) || (hdr.len != len)) {
+        DEBUG("fs_checkpoint: none in sector %lu\n", (unsigned long)sector);
+        return -ENOENT;
+    }
+    res = mtd_read(dev, data, addr + sizeof(hdr), len);
+    if (res < 0) {
+        return res;
+    }
+    if (_crc(len, data) != hdr.crc) {
+        DEBUG("fs_checkpoint: corrupted\n");
+        return -ENOENT;
+    }
+
+    /* the state is only valid until the file system is modified */
+    res = fs_checkpoint_discard(dev, sector);
+    if (res < 0) {
+        return res;
+    }
+    DEBUG("fs_checkpoint: took %u bytes from sector %lu\n", (unsigned)len,
+          (unsigned long)sector);
+    return 0;
+}
+
+int fs_checkpoint_discard(mtd_dev_t *dev, uint32_t sector)
+{
+    int res = mtd_erase(dev, sector * _sector_size(dev), _sector_size(dev));
+
+    return (res < 0) ? res : 0;
+}
@@ -44,6 +44,7 @@ static int constfs_close(vfs_file_t *filp);
 static int constfs_fstat(vfs_file_t *filp, struct stat *buf);
 static off_t constfs_lseek(vfs_file_t *filp, off_t off, int whence);
 static int constfs_open(vfs_file_t *filp, const char *name, int flags, mode_t mode, const char *abs_path);
+static ssize_t constfs_mmap(vfs_file_t *filp, const void **addr);
 static ssize_t constfs_read(vfs_file_t *filp, void *dest, size_t nbytes);
 static ssize_t constfs_write(vfs_file_t *filp, const void *src, size_t nbytes);
 
@@ -64,6 +65,7 @@ static const vfs_file_ops_t constfs_file_ops = {
     .close = constfs_close,
     .fstat = constfs_fstat,
     .lseek = constfs_lseek,
+    .mmap  = constfs_mmap,
     .open  = constfs_open,
     .read  = constfs_read,
     .write = constfs_write,
@@ -92,6 +94,18 @@ const vfs_file_system_t constfs_file_system = {
  */
 static void _constfs_write_stat(const constfs_file_t *fp, struct stat *restrict buf);
 
+/**
+ * @internal
+ * @brief Find a file by its path
+ *
+ * @param[in]  fs     file system to search
+ * @param[in]  name   path of the file
+ *
+ * @return index of the file in the files array
+ * @return -ENOENT if there is no such file
+ */
+static int _constfs_find(const constfs_t *fs, const char *name);
+
 static int constfs_mount(vfs_mount_t *mountp)
 {
     /* perform any extra initialization here */
@@ -122,18 +136,15 @@ static int constfs_stat(vfs_mount_t *mountp, const char *restrict name, struct s
         return -EFAULT;
     }
     constfs_t *fs = mountp->private_data;
-    /* linear search through the files array */
-    for (size_t i = 0; i < fs->nfiles; ++i) {
-        DEBUG("constfs_stat ? \"%s\"\n", fs->files[i].path);
-        if (strcmp(fs->files[i].path, name) == 0) {
-            DEBUG("constfs_stat: Found :)\n");
-            _constfs_write_stat(&fs->files[i], buf);
-            buf->st_ino = i;
-            return 0;
-        }
+    int i = _constfs_find(fs, name);
+    if (i < 0) {
+        DEBUG("constfs_stat: Not found :(\n");
+        return i;
     }
-    DEBUG("constfs_stat: Not found :(\n");
-    return -ENOENT;
+    DEBUG("constfs_stat: Found :)\n");
+    _constfs_write_stat(&fs->files[i], buf);
+    buf->st_ino = i;
+    return 0;
 }
 
 static int constfs_statvfs(vfs_mount_t *mountp, const char *restrict path, struct statvfs *restrict buf)
@@ -215,17 +226,27 @@ static int constfs_open(vfs_file_t *filp, const char *name, int flags, mode_t mo
     if ((flags & O_ACCMODE) != O_RDONLY) {
         return -EROFS;
     }
-    /* linear search through the files array */
-    for (size_t i = 0; i < fs->nfiles; ++i) {
-        DEBUG("constfs_open ? \"%s\"\n", fs->files[i].path);
-        if (strcmp(fs->files[i].path, name) == 0) {
-            DEBUG("constfs_open: Found :)\n");
-            filp->private_data.ptr = (void *)&fs->files[i];
-            return 0;
-        }
+    int i = _constfs_find(fs, name);
+    if (i < 0) {
+        DEBUG("constfs_open: Not found :(\n");
+        return i;
     }
-    DEBUG("constfs_open: Not found :(\n");
-    return -ENOENT;
+    DEBUG("constfs_open: Found :)\n");
+    filp->private_data.ptr = (void *)&fs->files[i];
+    return 0;
+}
+
+static ssize_t constfs_mmap(vfs_file_t *filp, const void **addr)
+{
+    constfs_file_t *fp = filp->private_data.ptr;
+    DEBUG("constfs_mmap: %p, %p\n", (void *)filp, (void *)addr);
+    if ((size_t)filp->pos >= fp->size) {
+        /* Current offset is at or beyond end of file */
+        *addr = fp->data + fp->size;
+        return 0;
+    }
+    *addr = fp->data + filp->pos;
+    return fp->size - filp->pos;
 }
 
 static ssize_t constfs_read(vfs_file_t *filp, void *dest, size_t nbytes)
@@ -317,3 +338,35 @@ static void _constfs_write_stat(const constfs_file_t *fp, struct stat *restrict
     buf->st_blocks = fp->size;
     buf->st_blksize = sizeof(uint8_t);
 }
+
+static int _constfs_find(const constfs_t *fs, const char *name)
+{
+    if (!fs->sorted) {
+        /* linear search through the files array */
+        for (size_t i = 0; i < fs->nfiles; ++i) {
+            DEBUG("constfs_find ? \"%s\"\n", fs->files[i].path);
+            if (strcmp(fs->files[i].path, name) == 0) {
+                return i;
+            }
+        }
+        return -ENOENT;
+    }
+    /* binary search through the sorted files array */
+    size_t lo = 0;
+    size_t hi = fs->nfiles;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        DEBUG("constfs_find ? \"%s\"\n", fs->files[mid].path);
+        int cmp = strcmp(fs->files[mid].path, name);
+        if (cmp == 0) {
+            return mid;
+        }
+        if (cmp < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return -ENOENT;
+}
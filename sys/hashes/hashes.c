@@ -16,6 +16,18 @@
 
 #include "hashes.h"
 
+/* reads little endian, at any alignment */
+static inline uint32_t _read32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+           ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+static inline uint32_t _rotl32(uint32_t x, unsigned r)
+{
+    return (x << r) | (x >> (32 - r));
+}
+
 uint32_t djb2_hash(const uint8_t *buf, size_t len)
 {
     uint32_t hash = 5381;
@@ -109,3 +121,98 @@ uint32_t one_at_a_time_hash(const uint8_t *buf, size_t len)
     hash += hash << 15;
     return hash;
 }
+
+#define XXH32_PRIME1    (2654435761U)
+#define XXH32_PRIME2    (2246822519U)
+#define XXH32_PRIME3    (3266489917U)
+#define XXH32_PRIME4    (668265263U)
+#define XXH32_PRIME5    (374761393U)
+
+static inline uint32_t _xxh32_round(uint32_t acc, uint32_t input)
+{
+    acc += input * XXH32_PRIME2;
+    return _rotl32(acc, 13) * XXH32_PRIME1;
+}
+
+uint32_t xxh32_hash(const uint8_t *buf, size_t len, uint32_t seed)
+{
+    const uint8_t *end = buf + len;
+    uint32_t hash;
+
+    if (len >= 16) {
+        uint32_t v1 = seed + XXH32_PRIME1 + XXH32_PRIME2;
+        uint32_t v2 = seed + XXH32_PRIME2;
+        uint32_t v3 = seed;
+        uint32_t v4 = seed - XXH32_PRIME1;
+
+        do {
+            v1 = _xxh32_round(v1, _read32(buf));
+            v2 = _xxh32_round(v2, _read32(buf + 4));
+            v3 = _xxh32_round(v3, _read32(buf + 8));
+            v4 = _xxh32_round(v4, _read32(buf + 12));
+            buf += 16;
+        } while (end - buf >= 16);
+        hash = _rotl32(v1, 1) + _rotl32(v2, 7) + _rotl32(v3, 12) +
+               _rotl32(v4, 18);
+    }
+    else {
+        hash = seed + XXH32_PRIME5;
+    }
+
+    hash += (uint32_t)len;
+    for (; end - buf >= 4; buf += 4) {
+        hash += _read32(buf) * XXH32_PRIME3;
+        hash = _rotl32(hash, 17) * XXH32_PRIME4;
+    }
+    for (; buf < end; buf++) {
+        hash += *buf * XXH32_PRIME5;
+        hash = _rotl32(hash, 11) * XXH32_PRIME1;
+    }
+
+    hash ^= hash >> 15;
+    hash *= XXH32_PRIME2;
+    hash ^= hash >> 13;
+    hash *= XXH32_PRIME3;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+static inline uint32_t _murmur3_mix(uint32_t k)
+{
+    k *= 0xcc9e2d51;
+    k = _rotl32(k, 15);
+    return k * 0x1b873593;
+}
+
+uint32_t murmur3_32_hash(const uint8_t *buf, size_t len, uint32_t seed)
+{
+    uint32_t hash = seed;
+    size_t words = len / 4;
+
+    for (size_t i = 0; i < words; i++, buf += 4) {
+        hash ^= _murmur3_mix(_read32(buf));
+        hash = _rotl32(hash, 13);
+        hash = hash * 5 + 0xe6546b64;
+    }
+
+    uint32_t k = 0;
+    switch (len & 3) {
+        case 3:
+            k ^= (uint32_t)buf[2] << 16;
+            /* fall-through */
+        case 2:
+            k ^= (uint32_t)buf[1] << 8;
+            /* fall-through */
+        case 1:
+            k ^= buf[0];
+            hash ^= _murmur3_mix(k);
+    }
+
+    hash ^= (uint32_t)len;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+}
@@ -122,42 +122,61 @@ static const uint32_t K[64] = {
     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
 };
 
+/* message schedule in a ring of 16 words */
+#define W_LOAD(i)   (W[i])
+#define W_NEXT(i)   (W[(i) & 15] += s1(W[((i) - 2) & 15]) + \
+                     W[((i) - 7) & 15] + s0(W[((i) - 15) & 15]))
+
+/* one round, the caller rotates the names of the working variables */
+#define ROUND(a, b, c, d, e, f, g, h, w, k)                 \
+    do {                                                    \
+        uint32_t t0 = h + S1(e) + Ch(e, f, g) + (w) + (k);  \
+        d += t0;                                            \
+        h = t0 + S0(a) + Maj(a, b, c);                      \
+    } while (0)
+
+#define ROUNDS8(i, w)                                               \
+    do {                                                            \
+        ROUND(a, b, c, d, e, f, g, h, w((i) + 0), K[(i) + 0]);      \
+        ROUND(h, a, b, c, d, e, f, g, w((i) + 1), K[(i) + 1]);      \
+        ROUND(g, h, a, b, c, d, e, f, w((i) + 2), K[(i) + 2]);      \
+        ROUND(f, g, h, a, b, c, d, e, w((i) + 3), K[(i) + 3]);      \
+        ROUND(e, f, g, h, a, b, c, d, w((i) + 4), K[(i) + 4]);      \
+        ROUND(d, e, f, g, h, a, b, c, w((i) + 5), K[(i) + 5]);      \
+        ROUND(c, d, e, f, g, h, a, b, w((i) + 6), K[(i) + 6]);      \
+        ROUND(b, c, d, e, f, g, h, a, w((i) + 7), K[(i) + 7]);      \
+    } while (0)
+
 /*
  * SHA256 block compression function.  The 256-bit state is transformed via
  * the 512-bit input block to produce a new state.
+ *
+ * The working variables are kept in locals, eight rounds per iteration bring
+ * their names back in order, so the compiler can keep them in registers. The
+ * message schedule is expanded on the fly.
  */
 static void sha256_transform(uint32_t *state, const unsigned char block[64])
 {
-    uint32_t W[64];
-    uint32_t S[8];
+    uint32_t W[16];
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
 
-    /* 1. Prepare message schedule W. */
     be32dec_vect(W, block, 64);
-    for (int i = 16; i < 64; i++) {
-        W[i] = s1(W[i - 2]) + W[i - 7] + s0(W[i - 15]) + W[i - 16];
+    for (unsigned i = 0; i < 16; i += 8) {
+        ROUNDS8(i, W_LOAD);
     }
-
-    /* 2. Initialize working variables. */
-    memcpy(S, state, 32);
-
-    /* 3. Mix. */
-    for (int i = 0; i < 64; ++i) {
-        uint32_t e = S[(68 - i) % 8], f = S[(69 - i) % 8];
-        uint32_t g = S[(70 - i) % 8], h = S[(71 - i) % 8];
-        uint32_t t0 = h + S1(e) + Ch(e, f, g) + W[i] + K[i];
-
-        uint32_t a = S[(64 - i) % 8], b = S[(65 - i) % 8];
-        uint32_t c = S[(66 - i) % 8], d = S[(67 - i) % 8];
-        uint32_t t1 = S0(a) + Maj(a, b, c);
-
-        S[(67 - i) % 8] = d + t0;
-        S[(71 - i) % 8] = t0 + t1;
+    for (unsigned i = 16; i < 64; i += 8) {
+        ROUNDS8(i, W_NEXT);
     }
 
-    /* 4. Mix local working variables into global state */
-    for (int i = 0; i < 8; i++) {
-        state[i] += S[i];
-    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
 }
 
 static unsigned char PAD[64] = {
@@ -187,6 +206,11 @@ static void sha256_pad(sha256_context_t *ctx)
     sha256_update(ctx, len, 8);
 }
 
+static const uint32_t IV[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
 /* SHA-256 initialization.  Begins a SHA-256 operation. */
 void sha256_init(sha256_context_t *ctx)
 {
@@ -194,14 +218,7 @@ void sha256_init(sha256_context_t *ctx)
     ctx->count[0] = ctx->count[1] = 0;
 
     /* Magic initialization constants */
-    ctx->state[0] = 0x6A09E667;
-    ctx->state[1] = 0xBB67AE85;
-    ctx->state[2] = 0x3C6EF372;
-    ctx->state[3] = 0xA54FF53A;
-    ctx->state[4] = 0x510E527F;
-    ctx->state[5] = 0x9B05688C;
-    ctx->state[6] = 0x1F83D9AB;
-    ctx->state[7] = 0x5BE0CD19;
+    memcpy(ctx->state, IV, sizeof(IV));
 }
 
 /* Add bytes into the hash */
@@ -262,6 +279,18 @@ void sha256_final(sha256_context_t *ctx, void *dst)
     memset((void *) ctx, 0, sizeof(*ctx));
 }
 
+void sha256_multi(const void *const data[], size_t len,
+                  void *const digests[], size_t count)
+{
+    sha256_context_t c;
+
+    for (size_t i = 0; i < count; i++) {
+        sha256_init(&c);
+        sha256_update(&c, data[i], len);
+        sha256_final(&c, digests[i]);
+    }
+}
+
 void *sha256(const void *data, size_t len, void *digest)
 {
     sha256_context_t c;
@@ -362,11 +391,17 @@ const void *hmac_sha256(const void *key, size_t key_length,
  */
 static inline void sha256_inplace(unsigned char element[SHA256_DIGEST_LENGTH])
 {
-    sha256_context_t ctx;
+    /* the padded message fits a single block, with a bit count of 256 */
+    unsigned char block[SHA256_INTERNAL_BLOCK_SIZE] = { 0 };
+    uint32_t state[8];
+
+    memcpy(block, element, SHA256_DIGEST_LENGTH);
+    block[SHA256_DIGEST_LENGTH] = 0x80;
+    block[SHA256_INTERNAL_BLOCK_SIZE - 2] = 0x01;
 
-    sha256_init(&ctx);
-    sha256_update(&ctx, element, SHA256_DIGEST_LENGTH);
-    sha256_final(&ctx, element);
+    memcpy(state, IV, sizeof(IV));
+    sha256_transform(state, block);
+    be32enc_vect(element, state, SHA256_DIGEST_LENGTH);
 }
 
 void *sha256_chain(const void *seed, size_t seed_length,
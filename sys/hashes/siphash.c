@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_hashes_siphash
+ * @{
+ *
+ * @file
+ * @brief       SipHash implementation, following the reference code
+ *
+ * @}
+ */
+
+#include "hashes/siphash.h"
+
+typedef struct {
+    uint64_t v0, v1, v2, v3;
+} _state_t;
+
+/* reads little endian, at any alignment */
+static inline uint64_t _read64(const uint8_t *buf, size_t len)
+{
+    uint64_t val = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        val |= (uint64_t)buf[i] << (8 * i);
+    }
+    return val;
+}
+
+static inline uint64_t _rotl64(uint64_t x, unsigned r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static void _rounds(_state_t *s, unsigned rounds)
+{
+    while (rounds--) {
+        s->v0 += s->v1;
+        s->v1 = _rotl64(s->v1, 13);
+        s->v1 ^= s->v0;
+        s->v0 = _rotl64(s->v0, 32);
+        s->v2 += s->v3;
+        s->v3 = _rotl64(s->v3, 16);
+        s->v3 ^= s->v2;
+        s->v0 += s->v3;
+        s->v3 = _rotl64(s->v3, 21);
+        s->v3 ^= s->v0;
+        s->v2 += s->v1;
+        s->v1 = _rotl64(s->v1, 17);
+        s->v1 ^= s->v2;
+        s->v2 = _rotl64(s->v2, 32);
+    }
+}
+
+static uint64_t _siphash(const uint8_t *key, const uint8_t *data, size_t len,
+                         unsigned c_rounds, unsigned d_rounds)
+{
+    uint64_t k0 = _read64(key, 8);
+    uint64_t k1 = _read64(key + 8, 8);
+    _state_t s = {
+        .v0 = k0 ^ 0x736f6d6570736575ULL,
+        .v1 = k1 ^ 0x646f72616e646f6dULL,
+        .v2 = k0 ^ 0x6c7967656e657261ULL,
+        .v3 = k1 ^ 0x7465646279746573ULL,
+    };
+    size_t tail = len & 7;
+    const uint8_t *end = data + (len - tail);
+
+    for (; data < end; data += 8) {
+        uint64_t m = _read64(data, 8);
+
+        s.v3 ^= m;
+        _rounds(&s, c_rounds);
+        s.v0 ^= m;
+    }
+
+    uint64_t m = ((uint64_t)len << 56) | _read64(data, tail);
+
+    s.v3 ^= m;
+    _rounds(&s, c_rounds);
+    s.v0 ^= m;
+
+    s.v2 ^= 0xff;
+    _rounds(&s, d_rounds);
+    return s.v0 ^ s.v1 ^ s.v2 ^ s.v3;
+}
+
+uint64_t siphash24(const uint8_t *key, const void *data, size_t len)
+{
+    return _siphash(key, data, len, 2, 4);
+}
+
+uint64_t siphash13(const uint8_t *key, const void *data, size_t len)
+{
+    return _siphash(key, data, len, 1, 3);
+}
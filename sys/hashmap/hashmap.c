@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_hashmap
+ * @{
+ *
+ * @file
+ * @brief       Robin Hood hash map implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "hashes.h"
+#include "hashmap.h"
+
+static inline uint8_t *_slot(const hashmap_t *map, unsigned idx)
+{
+    return map->slots + idx * map->slot_size;
+}
+
+static inline uint8_t *_key(const hashmap_t *map, unsigned idx)
+{
+    return _slot(map, idx) + HASHMAP_KEY_OFFSET(map->val_size);
+}
+
+static inline unsigned _next(const hashmap_t *map, unsigned idx)
+{
+    return (idx + 1) & map->mask;
+}
+
+/* Finds the slot of key. If key is not in the map, returns the slot it is to
+ * be inserted at and sets *dist to its distance from home plus one, or to 0
+ * if that distance does not fit into map->dist. */
+static unsigned _find(const hashmap_t *map, const void *key, uint8_t *dist,
+                      int *found)
+{
+    unsigned idx = map->hash(key, map->key_size, map->seed) & map->mask;
+    uint8_t d = 1;
+
+    /* the entries of a run are ordered by their home slot, so key is
+     * missing as soon as an entry is met that is closer to its home */
+    while (map->dist[idx] >= d) {
+        if ((map->dist[idx] == d) &&
+            (memcmp(_key(map, idx), key, map->key_size) == 0)) {
+            *found = 1;
+            return idx;
+        }
+        if (d == UINT8_MAX) {
+            *dist = 0;
+            *found = 0;
+            return idx;
+        }
+        idx = _next(map, idx);
+        d++;
+    }
+    *dist = d;
+    *found = 0;
+    return idx;
+}
+
+void hashmap_init(hashmap_t *map, uint32_t *slots, uint8_t *dist,
+                  unsigned numof, size_t key_size, size_t val_size,
+                  hashmap_hash_t hash, uint32_t seed)
+{
+    assert((numof > 0) && (numof <= HASHMAP_NUMOF_MAX) &&
+           ((numof & (numof - 1)) == 0));
+    assert((key_size > 0) &&
+           (HASHMAP_SLOT_SIZE(key_size, val_size) <= UINT8_MAX));
+
+    map->slots = (uint8_t *)slots;
+    map->dist = dist;
+    map->hash = (hash) ? hash : murmur3_32_hash;
+    map->seed = seed;
+    map->key_size = key_size;
+    map->val_size = val_size;
+    map->slot_size = HASHMAP_SLOT_SIZE(key_size, val_size);
+    map->mask = numof - 1;
+    hashmap_clear(map);
+}
+
+void hashmap_clear(hashmap_t *map)
+{
+    memset(map->dist, 0, map->mask + 1);
+    map->used = 0;
+}
+
+void *hashmap_get(const hashmap_t *map, const void *key)
+{
+    uint8_t dist;
+    int found;
+    unsigned idx = _find(map, key, &dist, &found);
+
+    return (found) ? _slot(map, idx) : NULL;
+}
+
+void *hashmap_put(hashmap_t *map, const void *key, const void *val)
+{
+    uint8_t dist;
+    int found;
+    unsigned idx = _find(map, key, &dist, &found);
+
+    if (!found) {
+        if ((map->used > map->mask) || (dist == 0)) {
+            return NULL;
+        }
+        /* move the rest of the run one slot up, its entries all have a
+         * later home slot */
+        if (map->dist[idx]) {
+            unsigned end = idx;
+
+            while (map->dist[end]) {
+                if (map->dist[end] == UINT8_MAX) {
+                    return NULL;
+                }
+                end = _next(map, end);
+            }
+            while (end != idx) {
+                unsigned prev = (end - 1) & map->mask;
+
+                memcpy(_slot(map, end), _slot(map, prev), map->slot_size);
+                map->dist[end] = map->dist[prev] + 1;
+                end = prev;
+            }
+        }
+        map->dist[idx] = dist;
+        memcpy(_key(map, idx), key, map->key_size);
+        if (val == NULL) {
+            memset(_slot(map, idx), 0, map->val_size);
+        }
+        map->used++;
+    }
+    if (val) {
+        memcpy(_slot(map, idx), val, map->val_size);
+    }
+    return _slot(map, idx);
+}
+
+int hashmap_remove(hashmap_t *map, const void *key)
+{
+    uint8_t dist;
+    int found;
+    unsigned idx = _find(map, key, &dist, &found);
+
+    if (!found) {
+        return -ENOENT;
+    }
+    /* move the entries behind back, until one is at its home slot */
+    for (unsigned next = _next(map, idx); map->dist[next] > 1;
+         next = _next(map, next)) {
+        memcpy(_slot(map, idx), _slot(map, next), map->slot_size);
+        map->dist[idx] = map->dist[next] - 1;
+        idx = next;
+    }
+    map->dist[idx] = 0;
+    map->used--;
+    return 0;
+}
+
+void *hashmap_iter(const hashmap_t *map, unsigned *pos, const void **key)
+{
+    for (unsigned idx = *pos; idx <= map->mask; idx++) {
+        if (map->dist[idx]) {
+            *pos = idx + 1;
+            if (key) {
+                *key = _key(map, idx);
+            }
+            return _slot(map, idx);
+        }
+    }
+    *pos = map->mask + 1;
+    return NULL;
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_arena Arena allocator
+ * @ingroup     sys_memory_management
+ * @brief       Bump allocator for objects that are freed together
+ *
+ * An arena hands out memory by moving a pointer through a buffer, objects
+ * are not freed one by one but all at once with arena_reset(), or all
+ * that were allocated after a point in time with arena_reset_to(). This
+ * fits request handlers and parsers well, which allocate many small
+ * objects that live as long as the request:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * arena_mark_t mark = arena_mark(&arena);
+ *
+ * jsmntok_t *tokens = arena_alloc(&arena, 16 * sizeof(jsmntok_t));
+ * [...]
+ * arena_reset_to(&arena, mark);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The memory is a static buffer, blocks of a @ref sys_memarray that are
+ * taken when the buffer is used up, or both.
+ *
+ * arena_calloc() and arena_nofree() match the allocation functions of
+ * @ref pkg_cn-cbor, so the nodes of a parsed document are allocated from an
+ * arena:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static cn_cbor_context ct = {
+ *     .calloc_func = arena_calloc,
+ *     .free_func = arena_nofree,
+ *     .context = &arena,
+ * };
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * An arena is not thread-safe.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Arena allocator interface
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "memarray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Alignment of the allocated objects, must be a power of two
+ */
+#ifndef ARENA_ALIGN
+#define ARENA_ALIGN         (8U)
+#endif
+
+/**
+ * @brief   Header of a block taken from the memarray
+ */
+typedef struct arena_chunk {
+    struct arena_chunk *next;   /**< the block taken before */
+} arena_chunk_t;
+
+/**
+ * @brief   Arena
+ */
+typedef struct {
+    uint8_t *pos;               /**< next free byte */
+    uint8_t *end;               /**< end of the current buffer or block */
+    uint8_t *buf;               /**< static buffer */
+    uint8_t *buf_end;           /**< end of the static buffer */
+    memarray_t *blocks;         /**< blocks to take when the static buffer
+                                     is used up, may be NULL */
+    arena_chunk_t *chunk;       /**< last block taken from arena_t::blocks */
+} arena_t;
+
+/**
+ * @brief   State of an arena to reset it to
+ */
+typedef struct {
+    arena_chunk_t *chunk;       /**< the current block */
+    uint8_t *pos;               /**< the next free byte */
+} arena_mark_t;
+
+/**
+ * @brief   Initializes an arena
+ *
+ * @pre     @p buf is aligned to @ref ARENA_ALIGN
+ * @pre     the blocks of @p blocks are aligned to @ref ARENA_ALIGN
+ *
+ * @param[out] arena    the arena
+ * @param[in] buf       static buffer, may be NULL
+ * @param[in] size      size of @p buf
+ * @param[in] blocks    memarray to take further blocks from when @p buf is
+ *                      used up, may be NULL
+ */
+void arena_init(arena_t *arena, void *buf, size_t size, memarray_t *blocks);
+
+/**
+ * @brief   Allocates memory from an arena
+ *
+ * @param[in,out] arena the arena
+ * @param[in] size      size of the object
+ *
+ * @return  the object, aligned to @ref ARENA_ALIGN
+ * @return  NULL if the arena is used up or @p size is bigger than a block
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * @brief   Allocates zeroed memory for an array from an arena
+ *
+ * The signature matches the `calloc_func` of cn-cbor.
+ *
+ * @param[in] count     number of elements
+ * @param[in] size      size of an element
+ * @param[in,out] arena the arena, of type arena_t
+ *
+ * @return  the array
+ * @return  NULL if the arena is used up
+ */
+void *arena_calloc(size_t count, size_t size, void *arena);
+
+/**
+ * @brief   Does nothing, objects are freed with arena_reset()
+ *
+ * The signature matches the `free_func` of cn-cbor.
+ *
+ * @param[in] ptr       the object
+ * @param[in] arena     the arena
+ */
+void arena_nofree(void *ptr, void *arena);
+
+/**
+ * @brief   Gets the state of an arena, to free all later allocations with
+ *          arena_reset_to()
+ *
+ * @param[in] arena     the arena
+ *
+ * @return  the state
+ */
+static inline arena_mark_t arena_mark(const arena_t *arena)
+{
+    arena_mark_t mark = { .chunk = arena->chunk, .pos = arena->pos };
+
+    return mark;
+}
+
+/**
+ * @brief   Frees all objects allocated after a call of arena_mark()
+ *
+ * Blocks taken from the memarray since are given back.
+ *
+ * @pre     no arena_reset_to() to an earlier mark happened since @p mark was
+ *          taken
+ *
+ * @param[in,out] arena the arena
+ * @param[in] mark      return value of arena_mark()
+ */
+void arena_reset_to(arena_t *arena, arena_mark_t mark);
+
+/**
+ * @brief   Frees all objects of an arena
+ *
+ * @param[in,out] arena the arena
+ */
+static inline void arena_reset(arena_t *arena)
+{
+    arena_mark_t mark = { .chunk = NULL, .pos = arena->buf };
+
+    arena_reset_to(arena, mark);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARENA_H */
+/** @} */
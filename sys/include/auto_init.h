@@ -59,6 +59,21 @@
  *
  * From low-level CPU peripheral, the default initialization parameters are
  * defined in each board configuration that provides them.
+ *
+ * Boot time
+ * ---------
+ *
+ * With the `auto_init_timing` module, `auto_init` prints how long each group
+ * of initializations took (network stack, network devices, RPL, SAUL drivers,
+ * storage devices and CAN), so boot time regressions can be spotted. It
+ * needs `xtimer`, so the modules initialized before it are not measured.
+ *
+ * With the `auto_init_deferred` module, the SAUL drivers, storage devices and
+ * CAN devices are initialized in a thread of their own, as nothing else in
+ * `auto_init` depends on them. Probing sensors and initializing an SD card
+ * then no longer delay @e main, e.g. the shell is ready right away. The thread
+ * has a lower priority than the main thread, so it runs whenever the main
+ * thread blocks. Code that uses these devices calls auto_init_wait() first.
  */
 
 /**
@@ -105,6 +120,36 @@ extern "C" {
  */
 void auto_init(void);
 
+/**
+ * @brief   Stack size of the thread initializing devices with
+ *          `auto_init_deferred`
+ */
+#ifndef AUTO_INIT_DEFERRED_STACKSIZE
+#define AUTO_INIT_DEFERRED_STACKSIZE    (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the thread initializing devices with
+ *          `auto_init_deferred`
+ */
+#ifndef AUTO_INIT_DEFERRED_PRIO
+#define AUTO_INIT_DEFERRED_PRIO         (THREAD_PRIORITY_MAIN + 1)
+#endif
+
+#if defined(MODULE_AUTO_INIT_DEFERRED) || defined(DOXYGEN)
+/**
+ * @brief   Waits until the devices initialized in the background with
+ *          `auto_init_deferred` are ready
+ *
+ * Returns right away without `auto_init_deferred`.
+ */
+void auto_init_wait(void);
+#else
+static inline void auto_init_wait(void)
+{
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
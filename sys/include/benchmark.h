@@ -10,6 +10,34 @@
  * @defgroup    sys_benchmark Benchmark
  * @ingroup     sys
  * @brief       Framework for running simple runtime benchmarks
+ *
+ * There are two ways to use this module:
+ *
+ * @ref BENCHMARK_FUNC() measures a single loop over a function call using
+ * @ref sys_xtimer and prints the total and the mean time per call.
+ *
+ * For results that can be compared across builds, a benchmark application
+ * defines an array of @ref benchmark_case_t and passes it to
+ * benchmark_run_all(). Each case is then repeated for one or more warm-up
+ * samples (see @ref BENCHMARK_WARMUP) and @ref BENCHMARK_SAMPLES measured
+ * samples. Minimum, maximum, mean, median, and standard deviation over the
+ * samples are printed in the format selected by @ref BENCHMARK_FORMAT. Where
+ * available, the CPU's cycle counter (currently the DWT unit on Cortex-M3 and
+ * above) is used instead of @ref sys_xtimer.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * BENCHMARK_LOOP(_bench_nop, __asm__ volatile ("nop"))
+ *
+ * static const benchmark_case_t _cases[] = {
+ *     { "nop loop", _bench_nop, 100000UL },
+ * };
+ *
+ * int main(void)
+ * {
+ *     benchmark_run_all(_cases, sizeof(_cases) / sizeof(_cases[0]));
+ *     return 0;
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
  * @{
  *
  * @file
@@ -53,6 +81,130 @@ extern "C" {
         benchmark_print_time(_benchmark_time, runs, name);      \
     }
 
+/**
+ * @name    Output formats of benchmark_print_result()
+ * @{
+ */
+#define BENCHMARK_FORMAT_TEXT   (0) /**< human readable table */
+#define BENCHMARK_FORMAT_JSON   (1) /**< one JSON object per line */
+#define BENCHMARK_FORMAT_CSV    (2) /**< comma separated values */
+/** @} */
+
+/**
+ * @brief   Output format of benchmark_print_result()
+ *
+ * Use e.g. `CFLAGS += -DBENCHMARK_FORMAT=BENCHMARK_FORMAT_JSON` in the
+ * application's Makefile to get machine-readable output.
+ */
+#ifndef BENCHMARK_FORMAT
+#define BENCHMARK_FORMAT        BENCHMARK_FORMAT_TEXT
+#endif
+
+/**
+ * @brief   Number of samples taken by benchmark_run() that are not evaluated
+ */
+#ifndef BENCHMARK_WARMUP
+#define BENCHMARK_WARMUP        (1U)
+#endif
+
+/**
+ * @brief   Number of samples benchmark_run() evaluates
+ *
+ * @note    This number of 32-bit values is allocated on the stack.
+ */
+#ifndef BENCHMARK_SAMPLES
+#define BENCHMARK_SAMPLES       (10U)
+#endif
+
+/**
+ * @brief   Defines a function suitable for benchmark_case_t::func
+ *
+ * The function runs @p func as often as requested, so no function pointer
+ * call is measured in between.
+ *
+ * @param[in] name      name of the function to define
+ * @param[in] func      function call to benchmark
+ */
+#define BENCHMARK_LOOP(name, func)                              \
+    static void name(unsigned long runs)                        \
+    {                                                           \
+        for (unsigned long i = 0; i < runs; i++) {              \
+            func;                                               \
+        }                                                       \
+    }
+
+/**
+ * @brief   A benchmark case
+ */
+typedef struct {
+    const char *name;                   /**< name to label the output */
+    void (*func)(unsigned long runs);   /**< runs the benchmarked code `runs`
+                                         *   times, see @ref BENCHMARK_LOOP() */
+    unsigned long runs;                 /**< number of calls per sample */
+} benchmark_case_t;
+
+/**
+ * @brief   Result of a benchmark case
+ *
+ * All times are given per sample (i.e. for benchmark_case_t::runs calls) in
+ * the unit returned by benchmark_unit().
+ */
+typedef struct {
+    uint32_t min;           /**< shortest sample */
+    uint32_t max;           /**< longest sample */
+    uint32_t mean;          /**< arithmetic mean of the samples */
+    uint32_t median;        /**< median of the samples */
+    uint32_t stddev;        /**< sample standard deviation */
+    unsigned samples;       /**< number of samples */
+} benchmark_result_t;
+
+/**
+ * @brief   Get the unit of the times measured by benchmark_run()
+ *
+ * @return  "cycles", if the CPU's cycle counter is used
+ * @return  "us", if @ref sys_xtimer is used
+ */
+const char *benchmark_unit(void);
+
+/**
+ * @brief   Runs a benchmark case
+ *
+ * When counting cycles, interrupts are disabled during each sample. With
+ * @ref sys_xtimer they stay enabled, as the overflows of narrow timers are
+ * handled in an interrupt: a sample must not exceed 2^32 us then, and
+ * interrupts the device raises are part of the measurement.
+ *
+ * @param[in] bench     the benchmark case
+ * @param[out] res      statistics over the samples taken
+ */
+void benchmark_run(const benchmark_case_t *bench, benchmark_result_t *res);
+
+/**
+ * @brief   Prints the header line for the results on STDIO, if
+ *          @ref BENCHMARK_FORMAT requires one
+ */
+void benchmark_print_header(void);
+
+/**
+ * @brief   Prints the result of a benchmark case on STDIO in
+ *          @ref BENCHMARK_FORMAT
+ *
+ * Times are printed per call with three decimal places.
+ *
+ * @param[in] bench     the benchmark case
+ * @param[in] res       result of benchmark_run() for @p bench
+ */
+void benchmark_print_result(const benchmark_case_t *bench,
+                            const benchmark_result_t *res);
+
+/**
+ * @brief   Runs and prints a list of benchmark cases
+ *
+ * @param[in] cases     benchmark cases
+ * @param[in] numof     number of entries in @p cases
+ */
+void benchmark_run_all(const benchmark_case_t *cases, unsigned numof);
+
 /**
  * @brief   Output the given time as well as the time per run on STDIO
  *
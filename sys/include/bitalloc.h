@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_bitalloc Bitmap allocator
+ * @ingroup     sys
+ * @brief       Allocates the indices of a fixed size pool from a bitmap
+ *
+ * Keeps a bit per entry, set while the entry is free, in words of
+ * `unsigned`, and a summary bit per word, set while that word has a free
+ * entry. Finding a free entry scans the summary for a set bit and takes the
+ * lowest ones of it and of the word it points to with bitarithm_lsb(), so it
+ * takes one step per @ref BITALLOC_WORD_BITS² entries: for all pools of up
+ * to 1024 entries on 32-bit platforms (256 on 16-bit ones), it is O(1).
+ * Always the lowest free index is returned.
+ *
+ * The allocator is not thread-safe, like @ref sys_memarray.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Bitmap allocator definitions
+ */
+
+#ifndef BITALLOC_H
+#define BITALLOC_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of bits in a word of the bitmap
+ */
+#define BITALLOC_WORD_BITS          (sizeof(unsigned) * 8)
+
+/**
+ * @brief   Number of words of the bitmap of @p numof entries
+ */
+#define BITALLOC_MAP_WORDS(numof)   \
+    (((numof) + BITALLOC_WORD_BITS - 1) / BITALLOC_WORD_BITS)
+
+/**
+ * @brief   Number of words of the summary of @p numof entries
+ */
+#define BITALLOC_SUMMARY_WORDS(numof)   \
+    BITALLOC_MAP_WORDS(BITALLOC_MAP_WORDS(numof))
+
+/**
+ * @brief   Bitmap allocator
+ */
+typedef struct {
+    unsigned *map;          /**< bit per entry, set if free */
+    unsigned *summary;      /**< bit per word of map, set if it has a free
+                                 entry */
+    unsigned numof;         /**< number of entries */
+} bitalloc_t;
+
+/**
+ * @brief   Initializes a bitmap allocator with all entries free
+ *
+ * @param[out] ba       allocator to initialize
+ * @param[in] map       @ref BITALLOC_MAP_WORDS(@p numof) words for the bitmap
+ * @param[in] summary   @ref BITALLOC_SUMMARY_WORDS(@p numof) words for the
+ *                      summary
+ * @param[in] numof     number of entries
+ */
+void bitalloc_init(bitalloc_t *ba, unsigned *map, unsigned *summary,
+                   unsigned numof);
+
+/**
+ * @brief   Marks all entries free
+ *
+ * @param[in,out] ba    allocator
+ */
+void bitalloc_reset(bitalloc_t *ba);
+
+/**
+ * @brief   Finds the lowest free entry, without taking it
+ *
+ * @param[in] ba    allocator
+ *
+ * @return  index of the entry
+ * @return  -1 if all entries are taken
+ */
+int bitalloc_find(const bitalloc_t *ba);
+
+/**
+ * @brief   Marks an entry taken
+ *
+ * @param[in,out] ba    allocator
+ * @param[in] idx       index of the entry, taken ones stay taken
+ */
+void bitalloc_take(bitalloc_t *ba, unsigned idx);
+
+/**
+ * @brief   Marks an entry free
+ *
+ * @param[in,out] ba    allocator
+ * @param[in] idx       index of the entry, free ones stay free
+ */
+void bitalloc_put(bitalloc_t *ba, unsigned idx);
+
+/**
+ * @brief   Takes the lowest free entry
+ *
+ * @param[in,out] ba    allocator
+ *
+ * @return  index of the entry
+ * @return  -1 if all entries are taken
+ */
+static inline int bitalloc_get(bitalloc_t *ba)
+{
+    int idx = bitalloc_find(ba);
+
+    if (idx >= 0) {
+        bitalloc_take(ba, idx);
+    }
+    return idx;
+}
+
+/**
+ * @brief   Checks whether an entry is free
+ *
+ * @param[in] ba    allocator
+ * @param[in] idx   index of the entry
+ *
+ * @return  true, if the entry is free
+ */
+static inline bool bitalloc_is_free(const bitalloc_t *ba, unsigned idx)
+{
+    return ba->map[idx / BITALLOC_WORD_BITS] &
+           (1U << (idx % BITALLOC_WORD_BITS));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BITALLOC_H */
+/** @} */
@@ -127,6 +127,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "hashes/siphash.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -228,6 +230,174 @@ void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len);
  */
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len);
 
+/**
+ * @name    Blocked Bloom filter
+ *
+ * A variant of the Bloom filter that derives all k probes from a single
+ * 64 bit SipHash of the element, by double hashing
+ * (Kirsch-Mitzenmacher): the upper half selects a block of
+ * @ref BLOOM_BLOCK_SIZE bytes, the lower half the k bits within it. So each
+ * operation hashes the element once and touches a single cache line or a few
+ * consecutive words, instead of calling k hash functions and touching k
+ * random bytes of the filter.
+ *
+ * Confining the bits of an element to a block costs false positives, about
+ * 10 % more than a classic filter of the same size for 16 bits per element.
+ * The keyed hash prevents others from flooding the filter with elements that
+ * set the same bits, e.g. for the duplicate detection of multicast packets.
+ *
+ * A counting variant keeps a 4 bit counter instead of a bit, which allows
+ * removing elements at four times the memory.
+ * @{
+ */
+#ifndef BLOOM_BLOCK_SIZE
+/**
+ * @brief   Size of a block in bytes, a power of two, e.g. the cache line size
+ */
+#define BLOOM_BLOCK_SIZE            (64U)
+#endif
+
+/**
+ * @brief   Number of 32 bit words of the storage of a filter
+ *
+ * @param[in] blocks    number of blocks of the filter
+ */
+#define BLOOM_BLOCKED_WORDS(blocks) ((blocks) * BLOOM_BLOCK_SIZE / 4U)
+
+/**
+ * @brief   Maximum value of a counter of a counting filter
+ *
+ * A counter that reached this value is not changed anymore, as the number
+ * of elements it counts is lost.
+ */
+#define BLOOM_COUNTING_MAX          (15U)
+
+/**
+ * @brief   Blocked Bloom filter, or counting blocked Bloom filter
+ */
+typedef struct {
+    uint32_t *blocks;               /**< bits or counters */
+    size_t numof;                   /**< number of blocks */
+    unsigned k;                     /**< number of probes per element */
+    uint8_t key[SIPHASH_KEY_LEN];   /**< key of the hash */
+} bloom_blocked_t;
+
+/**
+ * @brief   Initializes an empty blocked Bloom filter
+ *
+ * For n elements, about 10 bits per element and k = 7 give a false positive
+ * rate of about 1 %, i.e. a block of 64 bytes holds about 50 elements. For
+ * the counting variant, four times the memory is needed.
+ *
+ * @param[out] bloom    filter to initialize
+ * @param[in]  blocks   storage of BLOOM_BLOCKED_WORDS(@p numof) words
+ * @param[in]  numof    number of blocks
+ * @param[in]  k        number of probes per element, at least 1
+ * @param[in]  key      secret key of SIPHASH_KEY_LEN bytes, e.g. random,
+ *                      may be NULL for a zero key
+ */
+void bloom_blocked_init(bloom_blocked_t *bloom, uint32_t *blocks,
+                        size_t numof, unsigned k, const uint8_t *key);
+
+/**
+ * @brief   Removes all elements of a blocked or counting filter
+ *
+ * @param[in,out] bloom     filter to clear
+ */
+void bloom_blocked_clear(bloom_blocked_t *bloom);
+
+/**
+ * @brief   Checks if an element may be in a blocked filter
+ *
+ * @param[in] bloom     filter
+ * @param[in] buf       element
+ * @param[in] len       length of @p buf
+ *
+ * @return  false if @p buf is not in the filter
+ * @return  true if @p buf may be in the filter
+ */
+bool bloom_blocked_check(const bloom_blocked_t *bloom, const uint8_t *buf,
+                         size_t len);
+
+/**
+ * @brief   Adds an element to a blocked filter and checks if it may have
+ *          been in the filter before, hashing it once
+ *
+ * To detect duplicates, e.g. of received packets.
+ *
+ * @param[in,out] bloom     filter
+ * @param[in]     buf       element
+ * @param[in]     len       length of @p buf
+ *
+ * @return  false if @p buf was not in the filter
+ * @return  true if @p buf may have been in the filter
+ */
+bool bloom_blocked_test_and_add(bloom_blocked_t *bloom, const uint8_t *buf,
+                                size_t len);
+
+/**
+ * @brief   Adds an element to a blocked filter
+ *
+ * @param[in,out] bloom     filter
+ * @param[in]     buf       element
+ * @param[in]     len       length of @p buf
+ */
+static inline void bloom_blocked_add(bloom_blocked_t *bloom,
+                                     const uint8_t *buf, size_t len)
+{
+    bloom_blocked_test_and_add(bloom, buf, len);
+}
+
+/**
+ * @brief   Initializes an empty counting blocked Bloom filter
+ *
+ * A block holds 2 * @ref BLOOM_BLOCK_SIZE counters of 4 bit.
+ *
+ * @see     bloom_blocked_init() for the parameters
+ */
+static inline void bloom_counting_init(bloom_blocked_t *bloom,
+                                       uint32_t *blocks, size_t numof,
+                                       unsigned k, const uint8_t *key)
+{
+    bloom_blocked_init(bloom, blocks, numof, k, key);
+}
+
+/**
+ * @brief   Adds an element to a counting filter
+ *
+ * @param[in,out] bloom     counting filter
+ * @param[in]     buf       element
+ * @param[in]     len       length of @p buf
+ */
+void bloom_counting_add(bloom_blocked_t *bloom, const uint8_t *buf,
+                        size_t len);
+
+/**
+ * @brief   Removes an element from a counting filter
+ *
+ * @param[in,out] bloom     counting filter
+ * @param[in]     buf       element, that was added before
+ * @param[in]     len       length of @p buf
+ *
+ * @warning Removing an element that was not added causes false negatives.
+ */
+void bloom_counting_remove(bloom_blocked_t *bloom, const uint8_t *buf,
+                           size_t len);
+
+/**
+ * @brief   Checks if an element may be in a counting filter
+ *
+ * @param[in] bloom     counting filter
+ * @param[in] buf       element
+ * @param[in] len       length of @p buf
+ *
+ * @return  false if @p buf is not in the filter
+ * @return  true if @p buf may be in the filter
+ */
+bool bloom_counting_check(const bloom_blocked_t *bloom, const uint8_t *buf,
+                          size_t len);
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
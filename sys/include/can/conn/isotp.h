@@ -180,6 +180,21 @@ int conn_can_isotp_recv(conn_can_isotp_t *conn, void *buf, size_t size, uint32_t
  */
 int conn_can_isotp_send(conn_can_isotp_t *conn, const void *buf, size_t size, int flags);
 
+/**
+ * @brief  Send isotp data without copying it
+ *
+ * Blocks until the data has been sent, as the buffers of @p iol are read while
+ * sending.
+ *
+ * @param[in] conn          ISO-TP connection
+ * @param[in] iol           data to send
+ * @param[in] flags         flags for sending, CAN_ISOTP_TX_DONT_WAIT is ignored
+ *
+ * @return the number of bytes sent
+ * @return any other negative number in case of an error
+ */
+int conn_can_isotp_send_iol(conn_can_isotp_t *conn, const iolist_t *iol, int flags);
+
 #if defined(MODULE_CONN_CAN_ISOTP_MULTI) || defined(DOXYGEN)
 /**
  * @brief Wait for reception from multiple connections
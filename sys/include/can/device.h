@@ -25,6 +25,7 @@ extern "C" {
 #endif
 
 #include "can/candev.h"
+#include "can/pkt.h"
 #include "kernel_types.h"
 
 #ifdef MODULE_CAN_PM
@@ -49,6 +50,24 @@ extern "C" {
 #define CAN_DLL_NUMOF       (1)
 #endif
 
+#ifndef CAN_DEVICE_TX_QUEUE_SIZE
+/**
+ * Maximum number of frames waiting in a device thread for a free tx mailbox
+ */
+#define CAN_DEVICE_TX_QUEUE_SIZE    (8)
+#endif
+
+/**
+ * @brief Statistics of a CAN interface
+ */
+typedef struct {
+    uint32_t rx_frames;     /**< frames received */
+    uint32_t rx_overruns;   /**< received frames lost for all or some subscribers */
+    uint32_t rx_errors;     /**< receive errors reported by the driver */
+    uint32_t tx_frames;     /**< frames sent */
+    uint32_t tx_errors;     /**< frames which could not be sent */
+} can_stats_t;
+
 /**
  * @brief Parameters to initialize a candev
  */
@@ -81,6 +100,10 @@ typedef struct candev_dev {
     uint32_t last_pm_value;    /**< last pm timer value set */
     xtimer_t pm_timer;         /**< timer for power management */
 #endif
+    can_pkt_t *tx_queue[CAN_DEVICE_TX_QUEUE_SIZE]; /**< frames waiting for a free mailbox */
+    uint8_t tx_queue_first;    /**< index of the oldest frame in tx_queue */
+    uint8_t tx_queue_len;      /**< number of frames in tx_queue */
+    can_stats_t stats;         /**< statistics of the interface */
 } candev_dev_t;
 
 /**
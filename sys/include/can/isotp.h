@@ -27,6 +27,7 @@ extern "C" {
 
 #include "can/can.h"
 #include "can/common.h"
+#include "iolist.h"
 #include "thread.h"
 #include "xtimer.h"
 #include "net/gnrc/pktbuf.h"
@@ -93,6 +94,8 @@ struct isotp {
     xtimer_t tx_timer;             /**< timer for tx operations */
     xtimer_t rx_timer;             /**< timer for rx operations */
     can_reg_entry_t entry;         /**< entry containing ifnum and upper layer msg system */
+    const iolist_t *tx_iol;        /**< data to transmit */
+    size_t tx_len;                 /**< length of the data to transmit */
     uint32_t tx_gap;               /**< transmit gap from fc (in us) */
     uint8_t tx_wft;                /**< transmit wait counter */
     void *arg;                     /**< upper layer private arg */
@@ -151,6 +154,36 @@ kernel_pid_t isotp_init(char *stack, int stacksize, char priority, const char *n
  */
 int isotp_send(struct isotp *isotp, const void *buf, int len, int flags);
 
+/**
+ * @brief Send data through an isotp channel without copying it
+ *
+ * The data is read from the buffers of @p iol while it is sent, e.g. straight
+ * from memory mapped flash. @p iol and its buffers must stay valid until the
+ * tx confirmation or the tx error is received, so CAN_ISOTP_TX_DONT_WAIT is
+ * not allowed.
+ *
+ * @param isotp           the channel to use
+ * @param iol             the data to send
+ * @param flags           flags for sending
+ *
+ * @return the number of bytes sent
+ * @return < 0 if an error occured  (-EBUSY, -EINVAL)
+ */
+int isotp_send_iol(struct isotp *isotp, const iolist_t *iol, int flags);
+
+/**
+ * @brief Set the flow control parameters sent to the peer
+ *
+ * A block size of 0 and a separation time of 0 let the peer send the whole
+ * message as fast as it can. The values are used from the next flow control
+ * frame on.
+ *
+ * @param isotp           the channel to configure, must be bound
+ * @param bs              block size, 0 = off
+ * @param stmin           separation time, see @ref isotp_fc_options
+ */
+void isotp_set_rxfc(struct isotp *isotp, uint8_t bs, uint8_t stmin);
+
 /**
  * @brief Bind an isotp channel
  *
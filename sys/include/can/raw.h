@@ -46,6 +46,14 @@ extern "C" {
  */
 #define RAW_CAN_DEV_UNDEF (-1)
 
+#ifndef RAW_CAN_SEND_BATCH_SIZE
+/**
+ * @brief Maximum number of frames passed to the device thread at once by
+ *        raw_can_send_batch()
+ */
+#define RAW_CAN_SEND_BATCH_SIZE (8)
+#endif
+
 /**
  * @brief Send a CAN frame
  *
@@ -62,6 +70,31 @@ extern "C" {
  */
 int raw_can_send(int ifnum, const struct can_frame *frame, kernel_pid_t pid);
 
+/**
+ * @brief Send several CAN frames
+ *
+ * Send the @p num frames of @p frames in order through the @p ifnum interface.
+ * Unlike calling raw_can_send() for each frame, the device thread gets up to
+ * @ref RAW_CAN_SEND_BATCH_SIZE frames at once and fills all free tx mailboxes
+ * of the driver in one go. The frames which do not fit in a mailbox are sent as
+ * soon as one is free again.
+ *
+ * The results are sent to the @p pid thread via IPC, one for each frame.
+ *
+ * @param[in] ifnum   the interface number to send to
+ * @param[in] frames  the frames to send
+ * @param[in] num     number of frames in @p frames
+ * @param[in] pid     the user thread id to whom the result msgs will be sent
+ *                    it can be THREAD_PID_UNDEF if no feedback is expected
+ * @param[out] handles  the handles identifying the sent frames, can be NULL
+ *
+ * @return the number of frames sent, less than @p num if no more pkt could be
+ *         allocated
+ * @return -ENOMEM if no frame could be sent
+ */
+int raw_can_send_batch(int ifnum, const struct can_frame *frames, size_t num,
+                       kernel_pid_t pid, int *handles);
+
 /**
  * @brief Abort a CAN frame
  *
@@ -239,6 +272,17 @@ const char *raw_can_get_name_by_ifnum(int ifnum);
  */
 candev_dev_t *raw_can_get_dev_by_ifnum(int ifnum);
 
+/**
+ * @brief Get the statistics of the given interface
+ *
+ * @param[in] ifnum   interface number
+ * @param[out] stats  the statistics of the interface
+ *
+ * @return 0 on success
+ * @return -ENODEV if no interface is registered with this number
+ */
+int raw_can_get_stats(int ifnum, can_stats_t *stats);
+
 /**
  * @brief Set the given bitrate/sample_point to the given ifnum
  *
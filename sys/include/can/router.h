@@ -29,6 +29,25 @@ extern "C" {
 #include "can/can.h"
 #include "can/pkt.h"
 
+/**
+ * @brief Number of hash buckets per interface for filters of the indexed masks,
+ *        must be a power of two
+ */
+#ifndef CAN_ROUTER_INDEX_BUCKETS
+#define CAN_ROUTER_INDEX_BUCKETS    (16U)
+#endif
+
+/**
+ * @brief Number of distinct masks per interface whose filters are indexed
+ *
+ * A received frame is looked up in the hash buckets once per indexed mask,
+ * e.g. @ref CAN_SFF_MASK for exact standard IDs. The filters of other masks
+ * are compared one by one.
+ */
+#ifndef CAN_ROUTER_INDEX_MASKS
+#define CAN_ROUTER_INDEX_MASKS      (2U)
+#endif
+
 /**
  * @brief Register a user @p entry to receive a frame @p can_id
  *
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_cbor_enc Streaming CBOR encoder
+ * @ingroup     sys_serialization
+ * @brief       Writes CBOR (RFC 7049) directly into a buffer
+ *
+ * The encoder writes each item right into the buffer given to
+ * cbor_enc_init(), e.g. the payload of a CoAP response or of a packet
+ * buffer snip. It neither allocates memory nor keeps track of containers:
+ * the caller gives the number of items of an array or map when opening it,
+ * or uses an indefinite length container closed by cbor_enc_break().
+ *
+ * Items that do not fit into the buffer are not written, but still counted.
+ * So the items can be written unconditionally and the result checked once
+ * with cbor_enc_len() at the end. With a NULL buffer, only the length of the
+ * encoding is determined.
+ *
+ *     cbor_enc_t enc;
+ *
+ *     cbor_enc_init(&enc, buf, sizeof(buf));
+ *     cbor_enc_map(&enc, 1);
+ *     cbor_enc_str(&enc, "temp");
+ *     cbor_enc_decfrac(&enc, 2150, -2);
+ *     ssize_t len = cbor_enc_len(&enc);
+ *
+ * Integers are written with up to 32 bit, or 64 bit with cbor_enc_int64().
+ * Floats are written in single precision, use decimal fractions
+ * (cbor_enc_decfrac()) for exact values.
+ *
+ * @see         @ref phydat_to_cbor() for encoding @ref phydat_t values
+ *
+ * @{
+ *
+ * @file
+ * @brief       Streaming CBOR encoder definitions
+ */
+#ifndef CBOR_ENC_H
+#define CBOR_ENC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Tag of a decimal fraction
+ */
+#define CBOR_ENC_TAG_DECFRAC    (4U)
+
+/**
+ * @brief   Encoder state
+ */
+typedef struct {
+    uint8_t *buf;       /**< start of the buffer, may be NULL */
+    size_t size;        /**< size of the buffer */
+    size_t len;         /**< length of the encoding, may exceed size */
+} cbor_enc_t;
+
+/**
+ * @brief   Initializes an encoder
+ *
+ * @param[out] enc      encoder to initialize
+ * @param[out] buf      buffer to write to, or NULL to only count the bytes
+ * @param[in]  size     size of @p buf
+ */
+static inline void cbor_enc_init(cbor_enc_t *enc, uint8_t *buf, size_t size)
+{
+    enc->buf = buf;
+    enc->size = buf ? size : 0;
+    enc->len = 0;
+}
+
+/**
+ * @brief   Gets the length of the encoding
+ *
+ * @param[in] enc       encoder
+ *
+ * @return  number of bytes written
+ * @return  -ENOBUFS if the buffer was too small
+ * @return  number of bytes needed, if the buffer is NULL
+ */
+ssize_t cbor_enc_len(const cbor_enc_t *enc);
+
+/**
+ * @brief   Writes an unsigned integer
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     val   value to write
+ */
+void cbor_enc_uint(cbor_enc_t *enc, uint32_t val);
+
+/**
+ * @brief   Writes a signed integer
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     val   value to write
+ */
+void cbor_enc_int(cbor_enc_t *enc, int32_t val);
+
+/**
+ * @brief   Writes a signed 64 bit integer
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     val   value to write
+ */
+void cbor_enc_int64(cbor_enc_t *enc, int64_t val);
+
+/**
+ * @brief   Writes a single precision float
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     val   value to write
+ */
+void cbor_enc_float(cbor_enc_t *enc, float val);
+
+/**
+ * @brief   Writes a byte string
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     data  bytes to write
+ * @param[in]     len   number of bytes
+ */
+void cbor_enc_bstr(cbor_enc_t *enc, const void *data, size_t len);
+
+/**
+ * @brief   Writes a text string
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     str   UTF-8 string to write, needs not be terminated
+ * @param[in]     len   length of @p str in bytes
+ */
+void cbor_enc_tstr(cbor_enc_t *enc, const char *str, size_t len);
+
+/**
+ * @brief   Writes a null terminated text string
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     str   UTF-8 string to write
+ */
+static inline void cbor_enc_str(cbor_enc_t *enc, const char *str)
+{
+    cbor_enc_tstr(enc, str, strlen(str));
+}
+
+/**
+ * @brief   Opens an array
+ *
+ * The next @p numof items are its elements.
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     numof number of elements
+ */
+void cbor_enc_array(cbor_enc_t *enc, uint32_t numof);
+
+/**
+ * @brief   Opens a map
+ *
+ * The next 2 * @p numof items are its keys and values, in turns.
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     numof number of pairs
+ */
+void cbor_enc_map(cbor_enc_t *enc, uint32_t numof);
+
+/**
+ * @brief   Opens an array of indefinite length
+ *
+ * The array is closed by cbor_enc_break().
+ *
+ * @param[in,out] enc   encoder
+ */
+void cbor_enc_array_indef(cbor_enc_t *enc);
+
+/**
+ * @brief   Opens a map of indefinite length
+ *
+ * The map is closed by cbor_enc_break().
+ *
+ * @param[in,out] enc   encoder
+ */
+void cbor_enc_map_indef(cbor_enc_t *enc);
+
+/**
+ * @brief   Closes an array or map of indefinite length
+ *
+ * @param[in,out] enc   encoder
+ */
+void cbor_enc_break(cbor_enc_t *enc);
+
+/**
+ * @brief   Writes a tag, which applies to the next item
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     tag   tag to write
+ */
+void cbor_enc_tag(cbor_enc_t *enc, uint32_t tag);
+
+/**
+ * @brief   Writes a boolean
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     val   value to write
+ */
+void cbor_enc_bool(cbor_enc_t *enc, bool val);
+
+/**
+ * @brief   Writes null
+ *
+ * @param[in,out] enc   encoder
+ */
+void cbor_enc_null(cbor_enc_t *enc);
+
+/**
+ * @brief   Writes the decimal fraction @p mantissa * 10^@p exponent
+ *
+ * @param[in,out] enc       encoder
+ * @param[in]     mantissa  mantissa
+ * @param[in]     exponent  decimal exponent
+ */
+void cbor_enc_decfrac(cbor_enc_t *enc, int32_t mantissa, int32_t exponent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CBOR_ENC_H */
+/** @} */
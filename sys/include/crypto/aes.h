@@ -124,6 +124,43 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
 int aes_decrypt(const cipher_context_t *context, const uint8_t *cipher_block,
                 uint8_t *plain_block);
 
+/**
+ * @brief   encrypts a run of blocks, expanding the key once
+ *
+ * @see     cipher_interface_st::encrypt_blocks
+ *
+ * @param       context       the cipher_context_t-struct to use
+ * @param       input         the plaintext blocks
+ * @param       output        where the ciphertext blocks will be stored, may
+ *                            be NULL if @p chain is given
+ * @param       blocks        number of blocks
+ * @param       chain         CBC chaining value, or NULL for ECB
+ *
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks, uint8_t *chain);
+
+/**
+ * @brief   decrypts a run of blocks, expanding the key once
+ *
+ * @see     cipher_interface_st::decrypt_blocks
+ *
+ * @param       context       the cipher_context_t-struct to use
+ * @param       input         the ciphertext blocks
+ * @param       output        where the plaintext blocks will be stored
+ * @param       blocks        number of blocks
+ * @param       chain         CBC chaining value, or NULL for ECB
+ *
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks, uint8_t *chain);
+
 #ifdef __cplusplus
 }
 #endif
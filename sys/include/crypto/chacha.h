@@ -104,6 +104,24 @@ static inline void chacha_decrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8
     chacha_encrypt_bytes(ctx, m, c);
 }
 
+/**
+ * @brief Encode or decode data of arbitrary length.
+ *
+ * @details Generates the keystream block by block and XORs it with whole
+ *          words where possible. The remaining keystream of a trailing
+ *          partial block is discarded, so continuing the stream over several
+ *          calls requires all but the last to be a multiple of 64 bytes.
+ *
+ * @warning You need to re-initialize the context with a new nonce after 2^64
+ *          encrypted blocks, or the keystream will repeat!
+ *
+ * @param[in,out] ctx The ChaCha context.
+ * @param[in]     m   The input.
+ * @param[out]    c   The output, may be @p m.
+ * @param[in]     len Length of @p m in bytes.
+ */
+void chacha_xor(chacha_ctx *ctx, const uint8_t *m, uint8_t *c, size_t len);
+
 /**
  * @brief Seed the pseudo-random number generator.
  *
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @defgroup    sys_crypto_chacha20poly1305 ChaCha20-Poly1305
+ * @brief       ChaCha20-Poly1305 AEAD as specified in RFC 8439
+ *
+ * Authenticated encryption with additional data, built from @ref chacha_xor()
+ * and @ref sys_crypto_poly1305. Without AES hardware it needs less CPU time
+ * than AES-CCM on 32 bit MCUs, and runs in constant time.
+ *
+ * A nonce must never be used twice with the same key.
+ *
+ * @{
+ *
+ * @file
+ * @brief       ChaCha20-Poly1305 interface
+ *
+ * @see         https://tools.ietf.org/html/rfc8439#section-2.8
+ */
+
+#ifndef CRYPTO_CHACHA20POLY1305_H
+#define CRYPTO_CHACHA20POLY1305_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of the key in bytes
+ */
+#define CHACHA20POLY1305_KEY_BYTES      (32U)
+
+/**
+ * @brief   Length of the nonce in bytes
+ */
+#define CHACHA20POLY1305_NONCE_BYTES    (12U)
+
+/**
+ * @brief   Length of the tag in bytes
+ */
+#define CHACHA20POLY1305_TAG_BYTES      (16U)
+
+/**
+ * @brief   Encrypt and authenticate a message
+ *
+ * @param[out] cipher   ciphertext followed by the tag, of
+ *                      @p msglen + @ref CHACHA20POLY1305_TAG_BYTES bytes.
+ *                      May be @p msg.
+ * @param[in]  msg      message to encrypt
+ * @param[in]  msglen   length of @p msg
+ * @param[in]  aad      additional data to authenticate
+ * @param[in]  aadlen   length of @p aad
+ * @param[in]  key      key of @ref CHACHA20POLY1305_KEY_BYTES bytes
+ * @param[in]  nonce    nonce of @ref CHACHA20POLY1305_NONCE_BYTES bytes
+ */
+void chacha20poly1305_encrypt(uint8_t *cipher, const uint8_t *msg,
+                              size_t msglen, const uint8_t *aad, size_t aadlen,
+                              const uint8_t *key, const uint8_t *nonce);
+
+/**
+ * @brief   Verify and decrypt a message
+ *
+ * The message is only decrypted if the tag is correct.
+ *
+ * @param[in]  cipher       ciphertext followed by the tag
+ * @param[in]  cipherlen    length of @p cipher, including the tag
+ * @param[out] msg          decrypted message, may be @p cipher
+ * @param[out] msglen       length of @p msg
+ * @param[in]  aad          additional data to authenticate
+ * @param[in]  aadlen       length of @p aad
+ * @param[in]  key          key of @ref CHACHA20POLY1305_KEY_BYTES bytes
+ * @param[in]  nonce        nonce of @ref CHACHA20POLY1305_NONCE_BYTES bytes
+ *
+ * @return  1 if the message is authentic
+ * @return  0 if the tag is wrong or @p cipher is too short
+ */
+int chacha20poly1305_decrypt(const uint8_t *cipher, size_t cipherlen,
+                             uint8_t *msg, size_t *msglen,
+                             const uint8_t *aad, size_t aadlen,
+                             const uint8_t *key, const uint8_t *nonce);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_CHACHA20POLY1305_H */
+/** @} */
@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H
 #define CRYPTO_CIPHERS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -96,6 +97,26 @@ typedef struct cipher_interface_st {
     /** the decrypt function */
     int (*decrypt)(const cipher_context_t *ctx, const uint8_t *cipher_block,
                    uint8_t *plain_block);
+
+    /**
+     * @brief   encrypts @p blocks blocks at once, may be NULL
+     *
+     * Without @p chain, the blocks are encrypted independently (ECB). With
+     * @p chain, each input block is XORed with @p chain before it is
+     * encrypted and @p chain is set to the result (CBC), @p output may then
+     * be NULL to compute a CBC-MAC only.
+     */
+    int (*encrypt_blocks)(const cipher_context_t *ctx, const uint8_t *input,
+                          uint8_t *output, size_t blocks, uint8_t *chain);
+
+    /**
+     * @brief   decrypts @p blocks blocks at once, may be NULL
+     *
+     * With @p chain, each decrypted block is XORed with @p chain, which is
+     * then set to the input block (CBC).
+     */
+    int (*decrypt_blocks)(const cipher_context_t *ctx, const uint8_t *input,
+                          uint8_t *output, size_t blocks, uint8_t *chain);
 } cipher_interface_t;
 
 
@@ -167,6 +188,45 @@ int cipher_encrypt(const cipher_t *cipher, const uint8_t *input, uint8_t *output
 int cipher_decrypt(const cipher_t *cipher, const uint8_t *input, uint8_t *output);
 
 
+/**
+ * @brief Encrypt a run of blocks
+ *
+ * Uses the multi-block operation of the cipher if it has one, so the key
+ * schedule is only set up once, and single blocks otherwise.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p blocks blocks of input data
+ * @param output     pointer to allocated memory for @p blocks blocks, may be
+ *                   @p input. May be NULL if @p chain is given.
+ * @param blocks     number of blocks
+ * @param chain      block sized CBC chaining value, updated to the last
+ *                   ciphertext block, or NULL for independent blocks (ECB)
+ *
+ * @return           1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_encrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks, uint8_t *chain);
+
+
+/**
+ * @brief Decrypt a run of blocks
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p blocks blocks of input data
+ * @param output     pointer to allocated memory for @p blocks blocks, may be
+ *                   @p input
+ * @param blocks     number of blocks
+ * @param chain      block sized CBC chaining value, updated to the last
+ *                   input block, or NULL for independent blocks (ECB)
+ *
+ * @return           1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_decrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks, uint8_t *chain);
+
+
 /**
  * @brief Get block size of cipher
  * *
@@ -21,6 +21,7 @@
 #define CRYPTO_MODES_CCM_H
 
 #include "crypto/ciphers.h"
+#include "iolist.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -37,6 +38,140 @@ extern "C" {
 #define CCM_ERR_INVALID_MAC_LENGTH          (-5)
 /** @} */
 
+/**
+ * @brief   Block size of the ciphers CCM is defined for
+ */
+#define CCM_BLOCK_SIZE                      (16U)
+
+/**
+ * @brief   Context of a streaming CCM operation
+ */
+typedef struct {
+    cipher_t *cipher;                   /**< cipher in use */
+    uint8_t mac[CCM_BLOCK_SIZE];        /**< CBC-MAC so far */
+    uint8_t ctr[CCM_BLOCK_SIZE];        /**< next counter block */
+    uint8_t stream[CCM_BLOCK_SIZE];     /**< key stream of the current block */
+    uint8_t mac_stream[CCM_BLOCK_SIZE]; /**< key stream of the counter 0 */
+    size_t input_len;                   /**< bytes of the message left */
+    uint8_t pos;                        /**< bytes done of the current block */
+    uint8_t mac_length;                 /**< length of the MAC */
+    uint8_t length_encoding;            /**< length of the length field */
+} ccm_context_t;
+
+/**
+ * @brief   Starts a streaming CCM encryption or decryption
+ *
+ * CCM authenticates the length of the message first, so it is given here,
+ * the additional data is authenticated completely. The message is then
+ * processed in any number of updates, e.g. one per snip of a packet.
+ *
+ * @param[out] ctx              context to initialize
+ * @param[in]  cipher           already initialized cipher struct, used until
+ *                              the operation is finished
+ * @param[in]  auth_data        additional data to authenticate, may be NULL
+ * @param[in]  mac_length       length of the MAC (between 4 and 16 - only
+ *                              even values)
+ * @param[in]  length_encoding  maximal supported length of the message
+ *                              (2^(8*length_enc)).
+ * @param[in]  nonce            nonce for ctr mode encryption
+ * @param[in]  nonce_len        length of the nonce in octets
+ *                              (maximum: 15-length_encoding)
+ * @param[in]  input_len        length of the message (without the MAC)
+ *
+ * @return  0 on success
+ * @return  a negative error code if something went wrong
+ */
+int cipher_ccm_init(ccm_context_t *ctx, cipher_t *cipher,
+                    const iolist_t *auth_data, uint8_t mac_length,
+                    uint8_t length_encoding, const uint8_t *nonce,
+                    size_t nonce_len, size_t input_len);
+
+/**
+ * @brief   Encrypts the next part of the message
+ *
+ * @param[in]  ctx      context of the operation
+ * @param[in]  input    plaintext
+ * @param[in]  len      length of @p input
+ * @param[out] output   ciphertext of @p len bytes, may be @p input
+ *
+ * @return  0 on success
+ * @return  CCM_ERR_INVALID_DATA_LENGTH if the message gets longer than
+ *          given to cipher_ccm_init()
+ * @return  a negative error code if something else went wrong
+ */
+int cipher_ccm_encrypt_update(ccm_context_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output);
+
+/**
+ * @brief   Decrypts the next part of the message
+ *
+ * The plaintext must not be used before cipher_ccm_decrypt_finish()
+ * verified the MAC.
+ *
+ * @param[in]  ctx      context of the operation
+ * @param[in]  input    ciphertext
+ * @param[in]  len      length of @p input
+ * @param[out] output   plaintext of @p len bytes, may be @p input
+ *
+ * @return  0 on success
+ * @return  CCM_ERR_INVALID_DATA_LENGTH if the message gets longer than
+ *          given to cipher_ccm_init()
+ * @return  a negative error code if something else went wrong
+ */
+int cipher_ccm_decrypt_update(ccm_context_t *ctx, const uint8_t *input,
+                              size_t len, uint8_t *output);
+
+/**
+ * @brief   Encrypts the next parts of the message in place
+ *
+ * A @ref gnrc_pktsnip_t chain can be passed as iolist.
+ *
+ * @param[in]     ctx   context of the operation
+ * @param[in,out] data  plaintext, replaced by the ciphertext
+ *
+ * @return  see cipher_ccm_encrypt_update()
+ */
+int cipher_ccm_encrypt_iolist(ccm_context_t *ctx, const iolist_t *data);
+
+/**
+ * @brief   Decrypts the next parts of the message in place
+ *
+ * A @ref gnrc_pktsnip_t chain can be passed as iolist.
+ *
+ * @param[in]     ctx   context of the operation
+ * @param[in,out] data  ciphertext, replaced by the plaintext
+ *
+ * @return  see cipher_ccm_decrypt_update()
+ */
+int cipher_ccm_decrypt_iolist(ccm_context_t *ctx, const iolist_t *data);
+
+/**
+ * @brief   Finishes an encryption
+ *
+ * @param[in]  ctx      context of the operation
+ * @param[out] mac      MAC of ccm_context_t::mac_length bytes
+ *
+ * @return  the length of the MAC on success
+ * @return  CCM_ERR_INVALID_DATA_LENGTH if the message is shorter than given
+ *          to cipher_ccm_init()
+ * @return  a negative error code if something else went wrong
+ */
+int cipher_ccm_encrypt_finish(ccm_context_t *ctx, uint8_t *mac);
+
+/**
+ * @brief   Finishes a decryption, verifying the MAC
+ *
+ * @param[in]  ctx      context of the operation
+ * @param[in]  mac      received MAC of ccm_context_t::mac_length bytes
+ *
+ * @return  0 if the message is authentic
+ * @return  CCM_ERR_INVALID_CBC_MAC if the MAC does not match
+ * @return  CCM_ERR_INVALID_DATA_LENGTH if the message is shorter than given
+ *          to cipher_ccm_init()
+ * @return  a negative error code if something else went wrong
+ */
+int cipher_ccm_decrypt_finish(ccm_context_t *ctx, const uint8_t *mac);
+
 /**
  * @brief Encrypt and authenticate data of arbitrary length in ccm mode.
  *
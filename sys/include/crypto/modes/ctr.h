@@ -26,6 +26,13 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Number of key stream blocks encrypted at once
+ */
+#ifndef CTR_CHUNK_BLOCKS
+#define CTR_CHUNK_BLOCKS    (4)
+#endif
+
 /**
  * @brief Encrypt data of arbitrary length in counter mode.
  *
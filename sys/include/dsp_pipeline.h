@@ -0,0 +1,357 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_dsp_pipeline DSP pipeline
+ * @ingroup     sys
+ * @brief       Chains signal processing stages over blocks of samples
+ *
+ * A pipeline is a list of stages, e.g. filters, a decimator, an FFT and the
+ * computation of features like RMS and peak. Each block passed to the
+ * pipeline runs through all stages in turn. The samples are Q15 fixed-point
+ * values throughout, so the same pipeline runs on CPUs without FPU.
+ *
+ * Blocks are not copied between stages: each stage writes its output either
+ * in place or into the other of two buffers, the block itself and a scratch
+ * buffer of the pipeline. So the block passed in is overwritten.
+ *
+ * With the `cmsis-dsp` package, the stages use the CMSIS DSP library, which
+ * uses the SIMD instructions of Cortex-M4 and M7. Otherwise, portable C code
+ * is used, giving the same results. The FFT stage is only available with
+ * `cmsis-dsp`.
+ *
+ * The pipeline can be run synchronously with dsp_pipeline_run(), or by a
+ * thread it owns: dsp_pipeline_push() may be called from interrupt context,
+ * e.g. by the callback of adc_stream_start(), and the results are passed to
+ * a sink.
+ *
+ *     static dsp_convert_t conv;
+ *     static dsp_fir_t fir;
+ *     static dsp_features_t feat;
+ *
+ *     dsp_pipeline_init(&pipe, scratch, BLOCK_LEN);
+ *     dsp_convert_init(&conv, 12);
+ *     dsp_fir_init(&fir, coeffs, ARRAY_SIZE(coeffs), fir_state, BLOCK_LEN);
+ *     dsp_features_init(&feat);
+ *     dsp_pipeline_add(&pipe, &conv.stage);
+ *     dsp_pipeline_add(&pipe, &fir.stage);
+ *     dsp_pipeline_add(&pipe, &feat.stage);
+ *
+ * @{
+ *
+ * @file
+ * @brief       DSP pipeline definitions
+ */
+#ifndef DSP_PIPELINE_H
+#define DSP_PIPELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#ifdef MODULE_CMSIS_DSP
+#include "arm_math.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A sample in Q15 format, i.e. in [-1, 1)
+ */
+typedef int16_t dsp_q15_t;
+
+/**
+ * @brief   Size of the state of an FIR filter or decimator in samples
+ *
+ * @param[in] numof     number of coefficients
+ * @param[in] block_len number of input samples of a block
+ */
+#define DSP_FIR_STATE_LEN(numof, block_len)     ((numof) + (block_len) - 1)
+
+/**
+ * @brief   Size of the state of a biquad cascade in samples
+ *
+ * @param[in] stages    number of biquad stages
+ */
+#define DSP_BIQUAD_STATE_LEN(stages)            (4 * (stages))
+
+/**
+ * @brief   Stage of a pipeline
+ *
+ * Stages are embedded as first member into the descriptor of a specific
+ * stage, e.g. @ref dsp_fir_t.
+ */
+typedef struct dsp_stage dsp_stage_t;
+
+/**
+ * @brief   Processes a block
+ *
+ * @param[in]     stage the stage
+ * @param[in]     in    input block, may be overwritten
+ * @param[out]    out   buffer for the output, of the size of @p in
+ * @param[in,out] len   number of samples of @p in and of the output
+ *
+ * @return  @p in if the output was written in place, @p out otherwise
+ */
+typedef dsp_q15_t *(*dsp_stage_process_t)(dsp_stage_t *stage, dsp_q15_t *in,
+                                          dsp_q15_t *out, size_t *len);
+
+/**
+ * @brief   Stage of a pipeline
+ */
+struct dsp_stage {
+    dsp_stage_t *next;              /**< next stage of the pipeline */
+    dsp_stage_process_t process;    /**< processes a block */
+};
+
+/**
+ * @brief   Receives the output of a pipeline run by its thread
+ *
+ * @param[in] arg   argument given to dsp_pipeline_thread_create()
+ * @param[in] out   output of the last stage
+ * @param[in] len   number of samples in @p out
+ */
+typedef void (*dsp_pipeline_sink_t)(void *arg, dsp_q15_t *out, size_t len);
+
+/**
+ * @brief   Pipeline
+ */
+typedef struct {
+    dsp_stage_t *stages;            /**< first stage */
+    dsp_q15_t *scratch;             /**< buffer in turns with the block */
+    size_t block_len;               /**< samples of the blocks pushed */
+    dsp_pipeline_sink_t sink;       /**< sink of the thread */
+    void *arg;                      /**< argument of the sink */
+    kernel_pid_t pid;               /**< thread, if created */
+} dsp_pipeline_t;
+
+/**
+ * @brief   Initializes an empty pipeline
+ *
+ * @param[out] pipe         pipeline to initialize
+ * @param[in]  scratch      buffer of @p block_len samples
+ * @param[in]  block_len    maximum number of samples of a block
+ */
+void dsp_pipeline_init(dsp_pipeline_t *pipe, dsp_q15_t *scratch,
+                       size_t block_len);
+
+/**
+ * @brief   Appends a stage to a pipeline
+ *
+ * @param[in,out] pipe      pipeline
+ * @param[in]     stage     initialized stage
+ */
+void dsp_pipeline_add(dsp_pipeline_t *pipe, dsp_stage_t *stage);
+
+/**
+ * @brief   Runs a block through all stages of a pipeline
+ *
+ * @param[in]     pipe      pipeline
+ * @param[in]     block     input block, is overwritten
+ * @param[in,out] len       number of samples of @p block and of the output
+ *
+ * @return  the output of the last stage, either @p block or the scratch
+ *          buffer
+ */
+dsp_q15_t *dsp_pipeline_run(dsp_pipeline_t *pipe, dsp_q15_t *block,
+                            size_t *len);
+
+/**
+ * @brief   Creates a thread that runs each block pushed through a pipeline
+ *
+ * @param[in,out] pipe      pipeline
+ * @param[in]     stack     stack of the thread
+ * @param[in]     stacksize size of @p stack
+ * @param[in]     priority  priority of the thread
+ * @param[in]     sink      receives the output of each block
+ * @param[in]     arg       argument of @p sink
+ *
+ * @return  PID of the thread
+ * @return  < 0 if the thread could not be created
+ */
+kernel_pid_t dsp_pipeline_thread_create(dsp_pipeline_t *pipe, char *stack,
+                                        int stacksize, uint8_t priority,
+                                        dsp_pipeline_sink_t sink, void *arg);
+
+/**
+ * @brief   Passes a block of dsp_pipeline_t::block_len samples to the thread
+ *          of a pipeline
+ *
+ * May be called from interrupt context. The block must stay valid until it
+ * was passed to the sink.
+ *
+ * @param[in] pipe      pipeline with thread
+ * @param[in] block     block to process
+ *
+ * @return  0 on success
+ * @return  -EBUSY if the thread is still busy with the previous block
+ */
+int dsp_pipeline_push(dsp_pipeline_t *pipe, dsp_q15_t *block);
+
+/**
+ * @brief   Conversion of unsigned samples, e.g. of an ADC, to Q15
+ */
+typedef struct {
+    dsp_stage_t stage;              /**< stage descriptor */
+    uint8_t bits;                   /**< resolution of the samples */
+} dsp_convert_t;
+
+/**
+ * @brief   Initializes a conversion from unsigned samples to Q15
+ *
+ * The samples are right-aligned, as given by adc_stream_start(), and
+ * converted in place. Mid-scale becomes 0.
+ *
+ * @param[out] conv     stage to initialize
+ * @param[in]  bits     resolution of the samples, 1 to 16
+ */
+void dsp_convert_init(dsp_convert_t *conv, uint8_t bits);
+
+/**
+ * @brief   FIR filter
+ */
+typedef struct {
+    dsp_stage_t stage;              /**< stage descriptor */
+    const dsp_q15_t *coeffs;        /**< coefficients, time reversed */
+    dsp_q15_t *state;               /**< previous and current input */
+    uint16_t numof;                 /**< number of coefficients */
+} dsp_fir_t;
+
+/**
+ * @brief   Initializes an FIR filter
+ *
+ * The coefficients are given in time reversed order, as for the CMSIS DSP
+ * library, i.e. @p coeffs[0] is applied to the oldest sample.
+ *
+ * @param[out] fir          stage to initialize
+ * @param[in]  coeffs       @p numof coefficients
+ * @param[in]  numof        number of coefficients, even and at least 4
+ * @param[out] state        buffer of DSP_FIR_STATE_LEN() samples
+ * @param[in]  block_len    maximum number of samples of a block
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p numof is not applicable
+ */
+int dsp_fir_init(dsp_fir_t *fir, const dsp_q15_t *coeffs, uint16_t numof,
+                 dsp_q15_t *state, size_t block_len);
+
+/**
+ * @brief   Decimator, i.e. FIR anti-aliasing filter and downsampling
+ */
+typedef struct {
+    dsp_stage_t stage;              /**< stage descriptor */
+    const dsp_q15_t *coeffs;        /**< coefficients, time reversed */
+    dsp_q15_t *state;               /**< previous and current input */
+    uint16_t numof;                 /**< number of coefficients */
+    uint8_t factor;                 /**< decimation factor */
+} dsp_decimate_t;
+
+/**
+ * @brief   Initializes a decimator
+ *
+ * A block of n samples results in n / @p factor samples.
+ *
+ * @param[out] dec          stage to initialize
+ * @param[in]  coeffs       @p numof coefficients of the filter, time reversed
+ * @param[in]  numof        number of coefficients
+ * @param[in]  factor       decimation factor
+ * @param[out] state        buffer of DSP_FIR_STATE_LEN() samples
+ * @param[in]  block_len    number of samples of a block, a multiple of
+ *                          @p factor
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p factor is not applicable
+ */
+int dsp_decimate_init(dsp_decimate_t *dec, const dsp_q15_t *coeffs,
+                      uint16_t numof, uint8_t factor, dsp_q15_t *state,
+                      size_t block_len);
+
+/**
+ * @brief   Cascade of biquad (second order IIR) filters
+ */
+typedef struct {
+    dsp_stage_t stage;              /**< stage descriptor */
+    const dsp_q15_t *coeffs;        /**< 6 coefficients per biquad */
+    dsp_q15_t *state;               /**< 4 samples per biquad */
+    uint8_t stages;                 /**< number of biquads */
+    int8_t post_shift;              /**< scale of the coefficients */
+} dsp_biquad_t;
+
+/**
+ * @brief   Initializes a cascade of biquad filters
+ *
+ * As for the CMSIS DSP library, the coefficients of each biquad are
+ * {b0, 0, b1, b2, a1, a2}, for
+ * y[n] = b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] + a1 * y[n-1] + a2 * y[n-2].
+ * Note that a1 and a2 are negated compared with e.g. Matlab. The
+ * coefficients are scaled down by 2^@p post_shift, so that they fit Q15.
+ *
+ * @param[out] bq           stage to initialize
+ * @param[in]  coeffs       6 * @p stages coefficients
+ * @param[in]  stages       number of biquads
+ * @param[in]  post_shift   scale of the coefficients, 0 to 15
+ * @param[out] state        buffer of DSP_BIQUAD_STATE_LEN() samples
+ */
+void dsp_biquad_init(dsp_biquad_t *bq, const dsp_q15_t *coeffs,
+                     uint8_t stages, int8_t post_shift, dsp_q15_t *state);
+
+/**
+ * @brief   Computation of the RMS and peak of each block
+ *
+ * The block is passed on unchanged.
+ */
+typedef struct {
+    dsp_stage_t stage;              /**< stage descriptor */
+    dsp_q15_t rms;                  /**< RMS of the last block */
+    dsp_q15_t peak;                 /**< largest magnitude of the last block */
+} dsp_features_t;
+
+/**
+ * @brief   Initializes the computation of features
+ *
+ * @param[out] feat     stage to initialize
+ */
+void dsp_features_init(dsp_features_t *feat);
+
+#if defined(MODULE_CMSIS_DSP) || defined(DOXYGEN)
+/**
+ * @brief   Real FFT with magnitude of the bins as output
+ */
+typedef struct {
+    dsp_stage_t stage;              /**< stage descriptor */
+#ifdef MODULE_CMSIS_DSP
+    arm_rfft_instance_q15 rfft;     /**< CMSIS FFT instance */
+#endif
+    dsp_q15_t *buf;                 /**< complex spectrum */
+} dsp_fft_t;
+
+/**
+ * @brief   Initializes a real FFT
+ *
+ * A block of @p len samples results in the magnitudes of the @p len / 2
+ * bins from 0 to half the sample rate. As usual for fixed-point FFTs, they
+ * are scaled down by @p len.
+ *
+ * @param[out] fft      stage to initialize
+ * @param[in]  len      number of samples of a block, a power of 2
+ * @param[out] buf      buffer of 2 * @p len samples
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p len is not supported
+ */
+int dsp_fft_init(dsp_fft_t *fft, size_t len, dsp_q15_t *buf);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_PIPELINE_H */
+/** @} */
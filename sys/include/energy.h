@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_energy Energy accounting
+ * @ingroup     sys
+ * @brief       Estimates the charge drawn by the CPU, each thread and each
+ *              peripheral
+ *
+ * Components like radios that have states with distinct current draw keep an
+ * @ref energy_account_t. It sums the time spent in each state. Together with
+ * the current of each state given by an @ref energy_model_t, this results in
+ * an estimate of the charge drawn. The at86rf2xx, cc2420 and sx127x drivers
+ * keep an account in their device descriptor when this module is used,
+ * based on the typical currents given in their datasheets.
+ *
+ * The CPU time of each thread is taken from schedstatistics and charged with
+ * @ref ENERGY_CPU_ACTIVE_UA. With the `pm_layered_governor` module, the time
+ * of the idle thread is split into the power modes according to
+ * pm_layered_stats() and charged with @ref ENERGY_PM_UA, otherwise it is
+ * charged with @ref ENERGY_CPU_IDLE_UA.
+ *
+ * The estimates are only as good as the currents configured, which depend on
+ * the board, the clock configuration and e.g. the transmit power. Set them
+ * from measurements of the actual hardware where possible.
+ *
+ * The `energy` shell command or energy_print() print all estimates.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Energy accounting definitions
+ */
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <stdint.h>
+
+#include "net/netopt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Current drawn by the CPU while running a thread in µA
+ */
+#ifndef ENERGY_CPU_ACTIVE_UA
+#define ENERGY_CPU_ACTIVE_UA    (0U)
+#endif
+
+/**
+ * @brief   Current drawn by the CPU while in the idle thread in µA
+ *
+ * Only used without the `pm_layered_governor` module.
+ */
+#ifndef ENERGY_CPU_IDLE_UA
+#define ENERGY_CPU_IDLE_UA      (0U)
+#endif
+
+/**
+ * @brief   Current drawn by the CPU in each power mode in µA
+ *
+ * Initializer of an array of PM_NUM_MODES + 1 values, starting with mode 0
+ * and ending with the idle mode. Only used with the `pm_layered_governor`
+ * module.
+ */
+#ifndef ENERGY_PM_UA
+#define ENERGY_PM_UA            { 0 }
+#endif
+
+/**
+ * @brief   Number of states of a network device, one for each
+ *          @ref netopt_state_t
+ */
+#define ENERGY_NETDEV_STATES    (NETOPT_STATE_STANDBY + 1)
+
+/**
+ * @brief   Current draw of a component
+ */
+typedef struct {
+    const char *name;               /**< name of the component */
+    const char *const *state_names; /**< name of each state, may be NULL */
+    const uint32_t *current_ua;     /**< current of each state in µA */
+    uint8_t numof;                  /**< number of states */
+} energy_model_t;
+
+/**
+ * @brief   Time a component spent in each state
+ */
+typedef struct energy_account {
+    struct energy_account *next;    /**< next registered account */
+    const energy_model_t *model;    /**< current draw of the component */
+    uint64_t *time_us;              /**< time spent in each state in µs */
+    uint64_t since;                 /**< time the current state was entered */
+    uint8_t state;                  /**< current state */
+} energy_account_t;
+
+/**
+ * @brief   Account of a network device
+ */
+typedef struct {
+    energy_account_t account;                   /**< the account */
+    uint64_t time_us[ENERGY_NETDEV_STATES];     /**< time of each state */
+} energy_netdev_t;
+
+/**
+ * @brief   Names of the states of a network device
+ */
+extern const char *const energy_netdev_state_names[ENERGY_NETDEV_STATES];
+
+/**
+ * @brief   Initializes an account and registers it for energy_print()
+ *
+ * Registering an account again only resets it.
+ *
+ * @param[out] account  account to initialize
+ * @param[in]  model    current draw of the component
+ * @param[in]  time_us  array of model->numof entries for the time per state
+ * @param[in]  state    state the component is in
+ */
+void energy_account_init(energy_account_t *account,
+                         const energy_model_t *model, uint64_t *time_us,
+                         unsigned state);
+
+/**
+ * @brief   Records that a component changes its state
+ *
+ * May be called from interrupt context.
+ *
+ * @param[in,out] account   account of the component
+ * @param[in]     state     the new state
+ */
+void energy_account_set(energy_account_t *account, unsigned state);
+
+/**
+ * @brief   Gets the time a component spent in a state so far
+ *
+ * @param[in] account   account of the component
+ * @param[in] state     state to get the time of
+ *
+ * @return  time in µs
+ */
+uint64_t energy_account_time(const energy_account_t *account, unsigned state);
+
+/**
+ * @brief   Gets the charge a component drew so far
+ *
+ * @param[in] account   account of the component
+ *
+ * @return  charge in µC
+ */
+uint64_t energy_account_charge(const energy_account_t *account);
+
+/**
+ * @brief   Prints the time and charge of the threads, the power modes and
+ *          all registered accounts
+ */
+void energy_print(void);
+
+/**
+ * @brief   Initializes the account of a network device
+ *
+ * @param[out] energy   account to initialize
+ * @param[in]  model    current draw of the device, for ENERGY_NETDEV_STATES
+ *                      states
+ */
+static inline void energy_netdev_init(energy_netdev_t *energy,
+                                      const energy_model_t *model)
+{
+    energy_account_init(&energy->account, model, energy->time_us,
+                        NETOPT_STATE_STANDBY);
+}
+
+/**
+ * @brief   Records that a network device changes its state
+ *
+ * @param[in,out] energy    account of the device
+ * @param[in]     state     the new state
+ */
+static inline void energy_netdev_set(energy_netdev_t *energy,
+                                     netopt_state_t state)
+{
+    energy_account_set(&energy->account, state);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ENERGY_H */
+/** @} */
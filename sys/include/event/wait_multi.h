@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @brief       Waits for thread flags, messages and events at once
+ *
+ * A thread serving an event queue, messages and thread flags set from ISRs
+ * can wait for all of them with one call:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * event_wait_multi_t res;
+ *
+ * while (1) {
+ *     switch (event_wait_multi(&queue, FLAG_ISR, &res)) {
+ *         case EVENT_WAIT_MULTI_FLAGS:
+ *             handle_isr(res.flags);
+ *             break;
+ *         case EVENT_WAIT_MULTI_EVENT:
+ *             res.event->handler(res.event);
+ *             break;
+ *         case EVENT_WAIT_MULTI_MSG:
+ *             handle_msg(&res.msg);
+ *             break;
+ *         default:
+ *             break;
+ *     }
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Thread flags are reported first, then events, then messages. If anything
+ * is pending already, the inline fast path returns it without entering the
+ * scheduler. Messages require a message queue (see msg_init_queue()).
+ *
+ * @{
+ *
+ * @file
+ * @brief       Combined wait API
+ */
+
+#ifndef EVENT_WAIT_MULTI_H
+#define EVENT_WAIT_MULTI_H
+
+#include "event.h"
+#include "msg.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   What event_wait_multi() returned
+ */
+typedef enum {
+    EVENT_WAIT_MULTI_NONE,      /**< nothing was pending */
+    EVENT_WAIT_MULTI_FLAGS,     /**< flags of the mask were set */
+    EVENT_WAIT_MULTI_EVENT,     /**< an event was taken from the queue */
+    EVENT_WAIT_MULTI_MSG,       /**< a message was received */
+} event_wait_multi_type_t;
+
+/**
+ * @brief   Result of event_wait_multi()
+ *
+ * Only the member matching the returned type is valid.
+ */
+typedef struct {
+    thread_flags_t flags;       /**< the flags set, they are cleared */
+    event_t *event;             /**< the event */
+    msg_t msg;                  /**< the message */
+} event_wait_multi_t;
+
+/**
+ * @brief   Takes what is pending, without blocking
+ *
+ * @param[in] queue     Event queue of the calling thread, may be NULL.
+ * @param[in] mask      Thread flags to wait for, must contain neither
+ *                      @ref THREAD_FLAG_EVENT nor
+ *                      @ref THREAD_FLAG_MSG_WAITING.
+ * @param[out] res      The flags, event or message taken.
+ *
+ * @return  What was taken.
+ * @return  EVENT_WAIT_MULTI_NONE, if nothing was pending.
+ */
+static inline event_wait_multi_type_t event_wait_multi_try(event_queue_t *queue,
+                                                           thread_flags_t mask,
+                                                           event_wait_multi_t *res)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+    unsigned state = irq_disable();
+    thread_flags_t flags = me->flags & mask;
+
+    if (flags) {
+        me->flags &= ~flags;
+        irq_restore(state);
+        res->flags = flags;
+        return EVENT_WAIT_MULTI_FLAGS;
+    }
+    if (queue != NULL) {
+        event_t *event = (event_t *)clist_lpop(&queue->event_list);
+
+        if (event != NULL) {
+            if (clist_rpeek(&queue->event_list) == NULL) {
+                me->flags &= ~THREAD_FLAG_EVENT;
+            }
+            irq_restore(state);
+            event->list_node.next = NULL;
+            res->event = event;
+            return EVENT_WAIT_MULTI_EVENT;
+        }
+        /* events may have been canceled */
+        me->flags &= ~THREAD_FLAG_EVENT;
+    }
+    /* the flag is not cleared on receive, so it may be stale */
+    if (me->flags & THREAD_FLAG_MSG_WAITING) {
+        me->flags &= ~THREAD_FLAG_MSG_WAITING;
+        irq_restore(state);
+        if (msg_try_receive(&res->msg) == 1) {
+            /* there may be more, check again next time */
+            state = irq_disable();
+            me->flags |= THREAD_FLAG_MSG_WAITING;
+            irq_restore(state);
+            return EVENT_WAIT_MULTI_MSG;
+        }
+        return EVENT_WAIT_MULTI_NONE;
+    }
+    irq_restore(state);
+    return EVENT_WAIT_MULTI_NONE;
+}
+
+/**
+ * @brief   Blocks until something is pending, use event_wait_multi()
+ *
+ * @internal
+ */
+event_wait_multi_type_t event_wait_multi_block(event_queue_t *queue,
+                                               thread_flags_t mask,
+                                               event_wait_multi_t *res);
+
+/**
+ * @brief   Waits for thread flags, an event or a message
+ *
+ * @param[in] queue     Event queue of the calling thread, may be NULL.
+ * @param[in] mask      Thread flags to wait for, must contain neither
+ *                      @ref THREAD_FLAG_EVENT nor
+ *                      @ref THREAD_FLAG_MSG_WAITING.
+ * @param[out] res      The flags, event or message taken.
+ *
+ * @return  What was taken, never EVENT_WAIT_MULTI_NONE.
+ */
+static inline event_wait_multi_type_t event_wait_multi(event_queue_t *queue,
+                                                       thread_flags_t mask,
+                                                       event_wait_multi_t *res)
+{
+    event_wait_multi_type_t type = event_wait_multi_try(queue, mask, res);
+
+    if (type != EVENT_WAIT_MULTI_NONE) {
+        return type;
+    }
+    return event_wait_multi_block(queue, mask, res);
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* EVENT_WAIT_MULTI_H */
+/** @} */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @brief       Shared work queue served by a pool of worker threads
+ *
+ * Instead of spawning a thread with a dedicated stack, modules can post their
+ * work as events to one of the shared queues of this module. The
+ * @ref EVENT_WORKQ_WORKERS_NUMOF worker threads take the events of all
+ * queues, higher priority queues first, and run their handlers.
+ *
+ * The queues are ordinary event queues, so event_post(), event_cancel(),
+ * event timeouts and event callbacks work with them:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void handler(event_t *event);
+ * static event_t event = { .handler = handler };
+ * static event_timeout_t timeout;
+ *
+ * event_post(event_workq(EVENT_WORKQ_PRIO_MEDIUM), &event);
+ * [...]
+ * event_timeout_init(&timeout, event_workq(EVENT_WORKQ_PRIO_LOW), &event);
+ * event_timeout_set(&timeout, 1000000);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Handlers may block, e.g. waiting for a response, which occupies one worker
+ * in the meantime. They must not wait for @ref THREAD_FLAG_EVENT.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event work queue API
+ */
+
+#ifndef EVENT_WORKQ_H
+#define EVENT_WORKQ_H
+
+#include "event.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of worker threads
+ */
+#ifndef EVENT_WORKQ_WORKERS_NUMOF
+#define EVENT_WORKQ_WORKERS_NUMOF   (2U)
+#endif
+
+/**
+ * @brief   Stack size of each worker thread
+ */
+#ifndef EVENT_WORKQ_STACKSIZE
+#define EVENT_WORKQ_STACKSIZE       (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the worker threads
+ */
+#ifndef EVENT_WORKQ_THREAD_PRIO
+#define EVENT_WORKQ_THREAD_PRIO     (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @brief   Priorities of the work queues
+ */
+typedef enum {
+    EVENT_WORKQ_PRIO_HIGH = 0,  /**< handled first */
+    EVENT_WORKQ_PRIO_MEDIUM,    /**< handled if no high priority work */
+    EVENT_WORKQ_PRIO_LOW,       /**< handled if nothing else is pending */
+    EVENT_WORKQ_PRIO_NUMOF,     /**< number of priorities */
+} event_workq_prio_t;
+
+/**
+ * @brief   The work queues, use event_workq() to access them
+ *
+ * @internal
+ */
+extern event_queue_t event_workq_queues[EVENT_WORKQ_PRIO_NUMOF];
+
+/**
+ * @brief   Gets the work queue of a priority
+ *
+ * @param[in] prio  Priority of the queue.
+ *
+ * @return  The queue to post events to.
+ */
+static inline event_queue_t *event_workq(event_workq_prio_t prio)
+{
+    return &event_workq_queues[prio];
+}
+
+/**
+ * @brief   Starts the worker threads
+ *
+ * Called by auto_init.
+ */
+void event_workq_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* EVENT_WORKQ_H */
+/** @} */
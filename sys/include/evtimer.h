@@ -31,6 +31,13 @@
  *   example.
  * - uses @ref sys_xtimer "xtimer" as backend
  *
+ * By default, the events are kept in a list sorted by their offsets, which
+ * makes adding and removing an event linear in the number of events. For
+ * timers with many pending events, e.g. of large neighbor caches, module
+ * `evtimer_heap` keeps them in a pairing heap instead: adding takes constant
+ * time, removing logarithmic time (amortized), and evtimer_remaining() takes
+ * constant time. This costs two pointers and 8 bytes more per event.
+ *
  * @{
  *
  * @file
@@ -56,7 +63,15 @@ extern "C" {
  */
 typedef struct evtimer_event {
     struct evtimer_event *next; /**< the next event in the queue */
+#if defined(MODULE_EVTIMER_HEAP) || defined(DOXYGEN)
+    struct evtimer_event *child;    /**< first child in the heap */
+    struct evtimer_event *prev;     /**< parent or previous sibling in the
+                                     *   heap */
+#endif
     uint32_t offset;            /**< offset in milliseconds from previous event */
+#if defined(MODULE_EVTIMER_HEAP) || defined(DOXYGEN)
+    uint64_t deadline;          /**< time of the event in microseconds */
+#endif
 } evtimer_event_t;
 
 /**
@@ -98,6 +113,21 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event);
  */
 void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event);
 
+/**
+ * @brief   Returns the time until an event fires
+ *
+ * With module `evtimer_heap` this takes constant time, otherwise it is
+ * linear in the number of events before @p event.
+ *
+ * @param[in] evtimer       An event timer
+ * @param[in] event         An event
+ *
+ * @return  Milliseconds until @p event fires
+ * @return  UINT32_MAX if @p event is not pending in @p evtimer
+ */
+uint32_t evtimer_remaining(const evtimer_t *evtimer,
+                           const evtimer_event_t *event);
+
 /**
  * @brief   Print overview of current state of an event timer
  *
@@ -310,6 +310,31 @@ size_t fmt_s32_dfp(char *out, int32_t val, int fp_digits);
  */
 size_t fmt_float(char *out, float f, unsigned precision);
 
+/**
+ * @brief Format float to the shortest string that converts back to it
+ *
+ * Converts float value @p f to the least number of digits that strtof()
+ * reads as the exact same float, e.g. 0.1f to "0.1" instead of
+ * "0.100000001". Values with a decimal exponent from -4 to 8 are written
+ * without exponent ("0.000123", "12345678"), others in exponential notation
+ * ("1.5e-7", "3.4028235e38"). NaN and infinity are written as "nan", "inf"
+ * and "-inf".
+ *
+ * Unlike fmt_float(), this function works on the full range of float and
+ * uses integer math only (the Ryu algorithm). It needs about 600 bytes of
+ * tables.
+ *
+ * If @p out is NULL, will only return the number of bytes that would have
+ * been written.
+ *
+ * @param[out]  out         string to write to (or NULL), needs at most 15
+ *                          bytes
+ * @param[in]   f           float value to convert
+ *
+ * @returns     nr of bytes the function did or would write to out
+ */
+size_t fmt_float_shortest(char *out, float f);
+
 /**
  * @brief   Copy @p in char to string (without terminating '\0')
  *
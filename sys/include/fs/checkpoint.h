@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_fs_checkpoint Mount checkpoints for file systems
+ * @ingroup     sys_fs
+ * @brief       Keeps state of a cleanly unmounted file system on MTD
+ *
+ * File system glue layers save state they would otherwise rebuild by
+ * scanning the device, e.g. allocation bitmaps, to a sector reserved for the
+ * checkpoint when the file system is unmounted. When mounting, the checkpoint
+ * is taken: it is read, validated and erased before the file system is used,
+ * so a checkpoint is only found after a clean unmount with no modification
+ * since.
+ *
+ * @code {unparsed}
+ * sector:  | magic | len | crc | data ... | 0xff...
+ * @endcode
+ *
+ * @{
+ *
+ * @file
+ * @brief       Mount checkpoint definitions
+ */
+
+#ifndef FS_CHECKPOINT_H
+#define FS_CHECKPOINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Write alignment of the checkpoint
+ */
+#ifndef FS_CHECKPOINT_ALIGN
+#define FS_CHECKPOINT_ALIGN     (4U)
+#endif
+
+/**
+ * @brief   Marks a valid checkpoint, "fscp"
+ */
+#define FS_CHECKPOINT_MAGIC     (0x70637366UL)
+
+/**
+ * @brief   Checkpoint header
+ */
+typedef struct {
+    uint32_t magic;             /**< @ref FS_CHECKPOINT_MAGIC */
+    uint16_t len;               /**< length of the data */
+    uint16_t crc;               /**< CRC16 over the length and the data */
+} fs_checkpoint_hdr_t;
+
+/**
+ * @brief   Saves a checkpoint
+ *
+ * @param[in]  dev      MTD device
+ * @param[in]  sector   sector reserved for the checkpoint
+ * @param[in]  data     state to save
+ * @param[in]  len      length of @p data
+ *
+ * @return  0 on success
+ * @return  <0 on error
+ */
+int fs_checkpoint_save(mtd_dev_t *dev, uint32_t sector, const void *data,
+                       uint16_t len);
+
+/**
+ * @brief   Takes a checkpoint
+ *
+ * The checkpoint is erased once read, it is only returned if erasing
+ * succeeded.
+ *
+ * @param[in]  dev      MTD device
+ * @param[in]  sector   sector reserved for the checkpoint
+ * @param[out] data     saved state, clobbered if there is no checkpoint
+ * @param[in]  len      length of @p data, must match the saved length
+ *
+ * @return  0 on success
+ * @return  -ENOENT if there is no valid checkpoint
+ * @return  <0 on other errors
+ */
+int fs_checkpoint_take(mtd_dev_t *dev, uint32_t sector, void *data,
+                       uint16_t len);
+
+/**
+ * @brief   Discards a checkpoint, e.g. when formatting the file system
+ *
+ * @param[in]  dev      MTD device
+ * @param[in]  sector   sector reserved for the checkpoint
+ *
+ * @return  0 on success
+ * @return  <0 on error
+ */
+int fs_checkpoint_discard(mtd_dev_t *dev, uint32_t sector);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FS_CHECKPOINT_H */
+/** @} */
@@ -24,6 +24,7 @@
 #ifndef FS_CONSTFS_H
 #define FS_CONSTFS_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -48,6 +49,13 @@ typedef struct {
 typedef struct {
     const size_t nfiles; /**< Number of files */
     const constfs_file_t *files; /**< Files array */
+    /**
+     * @brief   @c files is sorted by path (as by strcmp()), files are found
+     *          by binary search
+     *
+     * Images generated with `dist/tools/constfs/mkconstfs.py` are sorted.
+     */
+    const bool sorted;
 } constfs_t;
 
 /**
@@ -57,6 +65,16 @@ typedef struct {
  */
 extern const vfs_file_system_t constfs_file_system;
 
+#if defined(MODULE_CONSTFS_IMAGE) || defined(DOXYGEN)
+/**
+ * @brief Files below `CONSTFS_DIR`, packed at build time
+ *
+ * The files are mounted at `CONSTFS_MOUNT`, `/const` by default, see
+ * `dist/tools/mkconstfs/README.md`.
+ */
+extern vfs_mount_t constfs_image;
+#endif
+
 #ifdef __cplusplus
 }
 #endif
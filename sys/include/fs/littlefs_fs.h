@@ -11,6 +11,13 @@
  * @ingroup     pkg_littlefs
  * @brief       RIOT integration of littlefs
  *
+ * With the @ref sys_fs_checkpoint module, the allocation state of littlefs is
+ * saved to @ref littlefs_desc_t::checkpoint on unmount. The next mount picks
+ * it up, so neither the first allocation nor the first modification after
+ * boot traverse the whole file system. All firmware mounting the file system
+ * must use the same checkpoint sector, as the state is only valid as long as
+ * nothing else modified the file system.
+ *
  * @{
  *
  * @file
@@ -72,6 +79,11 @@ typedef struct {
      * total number of block is defined in @p config.
      * if set to 0, the total number of sectors from the mtd is used */
     uint32_t base_addr;
+#if defined(MODULE_FS_CHECKPOINT) || DOXYGEN
+    /** mtd sector reserved for the mount checkpoint, outside of the file
+     * system, if set to 0, no checkpoint is used */
+    uint32_t checkpoint;
+#endif
 #if LITTLEFS_FILE_BUFFER_SIZE || DOXYGEN
     /** file buffer to use internally if LITTLEFS_FILE_BUFFER_SIZE is set */
     uint8_t file_buf[LITTLEFS_FILE_BUFFER_SIZE];
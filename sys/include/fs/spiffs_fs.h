@@ -33,6 +33,13 @@
  * @p SPIFFS_LOCK and @p SPIFFS_UNLOCK are also defined in the RIOT custom
  * spiffs_config.h to use @p spiffs_lock() and @p spiffs_unlock()
  *
+ * With the @ref sys_fs_checkpoint module, the usage of the file system is
+ * saved to @p spiffs_desc_t::checkpoint on unmount. On mount, it is compared
+ * to the usage found by the mount scan, spiffs_desc_t::clean tells if the
+ * file system was cleanly unmounted. Only after an unclean shutdown the file
+ * system needs to be checked with `SPIFFS_check()`, which may be done from a
+ * low priority thread while the file system is used.
+ *
  * @{
  *
  * @file
@@ -48,6 +55,8 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+
 #include "spiffs.h"
 #include "spiffs_config.h"
 #include "vfs.h"
@@ -121,6 +130,13 @@ typedef struct spiffs_desc {
     uint32_t block_count;                       /**< Number of blocks in current partition,
                                                  *  if 0, the mtd number of sector is used */
 #endif
+#if defined(MODULE_FS_CHECKPOINT) || defined(DOXYGEN)
+    uint32_t checkpoint;                        /**< mtd sector reserved for the mount checkpoint,
+                                                 *  outside of the partition, if 0, no checkpoint
+                                                 *  is used */
+    bool clean;                                 /**< the file system was cleanly unmounted,
+                                                 *  set on mount */
+#endif
 } spiffs_desc_t;
 
 /** The SPIFFS vfs driver, a pointer to a spiffs_desc_t must be provided as vfs_mountp::private_data */
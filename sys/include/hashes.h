@@ -171,6 +171,43 @@ uint32_t rotating_hash(const uint8_t *buf, size_t len);
  */
 uint32_t one_at_a_time_hash(const uint8_t *buf, size_t len);
 
+/**
+ * @defgroup sys_hashes_xxh32 xxHash32
+ * @ingroup sys_hashes_non_crypto
+ * @brief xxHash32 hash algorithm.
+ *
+ * Processes the input in words of 32 bit rather than byte by byte, and
+ * passes the SMHasher test suite. Starts paying off compared to the
+ * byte-wise hashes above from about 16 bytes of input on.
+ *
+ * found on
+ * https://github.com/Cyan4973/xxHash
+ *
+ * @param buf input buffer to hash
+ * @param len length of buffer
+ * @param seed seed of the hash
+ * @return 32 bit sized hash
+ */
+uint32_t xxh32_hash(const uint8_t *buf, size_t len, uint32_t seed);
+
+/**
+ * @defgroup sys_hashes_murmur3 MurmurHash3
+ * @ingroup sys_hashes_non_crypto
+ * @brief MurmurHash3 hash algorithm, 32 bit variant (x86_32).
+ *
+ * Processes the input in words of 32 bit, with less setup than
+ * @ref sys_hashes_xxh32 and thus faster for short keys, e.g. addresses.
+ *
+ * found on
+ * https://github.com/aappleby/smhasher
+ *
+ * @param buf input buffer to hash
+ * @param len length of buffer
+ * @param seed seed of the hash
+ * @return 32 bit sized hash
+ */
+uint32_t murmur3_32_hash(const uint8_t *buf, size_t len, uint32_t seed);
+
 #ifdef __cplusplus
 }
 #endif
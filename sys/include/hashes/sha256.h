@@ -134,6 +134,22 @@ void sha256_final(sha256_context_t *ctx, void *digest);
  */
 void *sha256(const void *data, size_t len, void *digest);
 
+/**
+ * @brief   Computes the hashes of several messages of the same length
+ *
+ * This is the common case of e.g. the leaves of a hash tree. The messages
+ * are hashed one after the other: interleaving them needs twice the working
+ * registers, which is slower on the targets supported.
+ *
+ * @param[in]  data     pointers to the @p count messages
+ * @param[in]  len      length of each message
+ * @param[out] digests  pointers to @p count buffers of
+ *                      @ref SHA256_DIGEST_LENGTH bytes for the results
+ * @param[in]  count    number of messages
+ */
+void sha256_multi(const void *const data[], size_t len,
+                  void *const digests[], size_t count);
+
 /**
  * @brief hmac_sha256_init HMAC SHA-256 calculation. Initiate calculation of a HMAC
  * @param[in] ctx hmac_context_t handle to use
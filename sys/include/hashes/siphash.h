@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_hashes_siphash SipHash
+ * @ingroup     sys_hashes_keyed
+ * @brief       Implementation of the SipHash keyed hash function
+ *
+ * SipHash is a pseudorandom function for short inputs. With a secret key,
+ * an attacker cannot construct inputs that collide, which makes it the hash
+ * of choice for hash tables indexed by data received from the network, e.g.
+ * with @ref sys_hashmap.
+ *
+ * SipHash-2-4 is the variant recommended by the authors. SipHash-1-3 runs
+ * fewer rounds and is used for hash tables e.g. by Rust and Python, where
+ * speed matters more than the security margin.
+ *
+ * @see https://131002.net/siphash/
+ *
+ * @{
+ *
+ * @file
+ * @brief       SipHash interface definition
+ */
+
+#ifndef HASHES_SIPHASH_H
+#define HASHES_SIPHASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of a SipHash key in bytes
+ */
+#define SIPHASH_KEY_LEN     (16U)
+
+/**
+ * @brief   Calculates SipHash-2-4 of data
+ *
+ * @param[in] key       secret key of SIPHASH_KEY_LEN bytes
+ * @param[in] data      data to hash
+ * @param[in] len       length of @p data in bytes
+ *
+ * @return  64 bit hash
+ */
+uint64_t siphash24(const uint8_t *key, const void *data, size_t len);
+
+/**
+ * @brief   Calculates SipHash-1-3 of data
+ *
+ * @param[in] key       secret key of SIPHASH_KEY_LEN bytes
+ * @param[in] data      data to hash
+ * @param[in] len       length of @p data in bytes
+ *
+ * @return  64 bit hash
+ */
+uint64_t siphash13(const uint8_t *key, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* HASHES_SIPHASH_H */
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_hashmap Hash map
+ * @ingroup     sys
+ * @brief       Open addressing hash map on static storage
+ *
+ * Maps keys of a fixed size to values of a fixed size, both copied into the
+ * slots of the map. The storage is given by the user, e.g. as static arrays
+ * of the size of @ref HASHMAP_SLOTS_WORDS():
+ *
+ *     static uint32_t slots[HASHMAP_SLOTS_WORDS(16, sizeof(ipv6_addr_t),
+ *                                               sizeof(entry_t))];
+ *     static uint8_t dist[16];
+ *     static hashmap_t map;
+ *
+ *     hashmap_init(&map, slots, dist, 16, sizeof(ipv6_addr_t),
+ *                  sizeof(entry_t), NULL, 0);
+ *     entry_t *entry = hashmap_put(&map, &addr, NULL);
+ *
+ * Collisions are resolved by linear probing with Robin Hood ordering: the
+ * entries of a run of slots are kept in the order of their home slots, so
+ * a lookup of a missing key stops at the first entry closer to its home slot,
+ * and lookups stay short up to high load factors. Removing shifts the
+ * following entries back, so there are no tombstones.
+ *
+ * Keys are compared by their bytes, so they must not contain padding.
+ * For keys chosen by others, e.g. addresses received from the network,
+ * use a hash function with a secret seed or key, e.g. a wrapper of
+ * siphash13() from @ref sys_hashes_siphash, to prevent collision attacks.
+ *
+ * The map is not thread safe.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Hash map definitions
+ */
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of slots of a map
+ */
+#define HASHMAP_NUMOF_MAX       (1024U)
+
+/**
+ * @brief   Offset of keys in a slot, values are stored first
+ */
+#define HASHMAP_KEY_OFFSET(val_size)    (((val_size) + 3U) & ~3U)
+
+/**
+ * @brief   Size of a slot in bytes
+ */
+#define HASHMAP_SLOT_SIZE(key_size, val_size) \
+    ((HASHMAP_KEY_OFFSET(val_size) + (key_size) + 3U) & ~3U)
+
+/**
+ * @brief   Number of 32 bit words needed for the slots of a map
+ *
+ * @param[in] numof     number of slots
+ * @param[in] key_size  size of the keys in bytes
+ * @param[in] val_size  size of the values in bytes
+ */
+#define HASHMAP_SLOTS_WORDS(numof, key_size, val_size) \
+    ((numof) * HASHMAP_SLOT_SIZE(key_size, val_size) / 4U)
+
+/**
+ * @brief   Signature of the hash function of a map, as of
+ *          murmur3_32_hash() and xxh32_hash()
+ */
+typedef uint32_t (*hashmap_hash_t)(const uint8_t *key, size_t len,
+                                   uint32_t seed);
+
+/**
+ * @brief   Hash map
+ */
+typedef struct {
+    uint8_t *slots;         /**< values and keys */
+    uint8_t *dist;          /**< distance of each entry from its home slot
+                                 plus one, zero for empty slots */
+    hashmap_hash_t hash;    /**< hash function */
+    uint32_t seed;          /**< seed of the hash function */
+    uint16_t mask;          /**< number of slots minus one */
+    uint16_t used;          /**< number of entries */
+    uint8_t key_size;       /**< size of a key */
+    uint8_t val_size;       /**< size of a value */
+    uint8_t slot_size;      /**< size of a slot */
+} hashmap_t;
+
+/**
+ * @brief   Initializes an empty map
+ *
+ * @param[out] map      map to initialize
+ * @param[in]  slots    storage of HASHMAP_SLOTS_WORDS() 32 bit words
+ * @param[in]  dist     storage of @p numof bytes
+ * @param[in]  numof    number of slots, a power of two up to
+ *                      @ref HASHMAP_NUMOF_MAX
+ * @param[in]  key_size size of the keys in bytes
+ * @param[in]  val_size size of the values in bytes, may be 0 for a set
+ * @param[in]  hash     hash function, NULL for murmur3_32_hash()
+ * @param[in]  seed     seed of the hash function
+ */
+void hashmap_init(hashmap_t *map, uint32_t *slots, uint8_t *dist,
+                  unsigned numof, size_t key_size, size_t val_size,
+                  hashmap_hash_t hash, uint32_t seed);
+
+/**
+ * @brief   Removes all entries of a map
+ *
+ * @param[in,out] map   map to clear
+ */
+void hashmap_clear(hashmap_t *map);
+
+/**
+ * @brief   Gets the number of entries of a map
+ *
+ * @param[in] map       map
+ *
+ * @return  number of entries
+ */
+static inline unsigned hashmap_len(const hashmap_t *map)
+{
+    return map->used;
+}
+
+/**
+ * @brief   Looks up the value of a key
+ *
+ * @param[in] map       map
+ * @param[in] key       key to look up
+ *
+ * @return  the value of @p key in the map, 4 byte aligned
+ * @return  NULL if @p key is not in @p map
+ */
+void *hashmap_get(const hashmap_t *map, const void *key);
+
+/**
+ * @brief   Adds or replaces the value of a key
+ *
+ * The returned pointer is valid until the map is modified.
+ *
+ * @param[in,out] map   map
+ * @param[in]     key   key to add
+ * @param[in]     val   value to copy, NULL to zero the value of a new key and
+ *                      keep the one of an existing key
+ *
+ * @return  the value of @p key in the map, 4 byte aligned
+ * @return  NULL if @p key is new to @p map and @p map is full, or if
+ *          inserting it would move an entry more than 255 slots from its
+ *          home slot, which only happens for very poorly distributed hashes
+ */
+void *hashmap_put(hashmap_t *map, const void *key, const void *val);
+
+/**
+ * @brief   Removes a key
+ *
+ * @param[in,out] map   map
+ * @param[in]     key   key to remove
+ *
+ * @return  0 on success
+ * @return  -ENOENT if @p key is not in @p map
+ */
+int hashmap_remove(hashmap_t *map, const void *key);
+
+/**
+ * @brief   Iterates over the entries of a map, in no particular order
+ *
+ *     unsigned pos = 0;
+ *     const void *key;
+ *     entry_t *entry;
+ *
+ *     while ((entry = hashmap_iter(&map, &pos, &key))) {
+ *         ...
+ *     }
+ *
+ * The map must not be modified during the iteration.
+ *
+ * @param[in]     map   map
+ * @param[in,out] pos   position of the iteration, starting at 0
+ * @param[out]    key   key of the entry, may be NULL
+ *
+ * @return  the value of the next entry
+ * @return  NULL after the last entry
+ */
+void *hashmap_iter(const hashmap_t *map, unsigned *pos, const void **key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HASHMAP_H */
+/** @} */
@@ -64,6 +64,18 @@ void isrpipe_init(isrpipe_t *isrpipe, char *buf, size_t bufsize);
  */
 int isrpipe_write_one(isrpipe_t *isrpipe, char c);
 
+/**
+ * @brief   Put a number of characters into the isrpipe's buffer
+ *
+ * @param[in]   isrpipe     isrpipe object to operate on
+ * @param[in]   buf         characters to add to isrpipe buffer
+ * @param[in]   count       number of characters in @p buf
+ *
+ * @returns     number of characters added, less than @p count if the buffer
+ *              was full
+ */
+int isrpipe_write(isrpipe_t *isrpipe, const char *buf, size_t count);
+
 /**
  * @brief   Read data from isrpipe (blocking)
  *
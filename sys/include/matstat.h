@@ -22,6 +22,18 @@
  * It is important to know that using integer operations will result in lower
  * precision in the computed measures because of truncation.
  *
+ * Besides the statistics over all values, there are
+ *
+ * - the statistics over a sliding window of the last values, see
+ *   @ref matstat_window_t, and
+ * - histograms of logarithmic buckets for the estimation of quantiles, see
+ *   @ref matstat_hist_t.
+ *
+ * Adding a value takes constant time for all of them, and they never
+ * allocate memory, so values can be added in interrupt context, e.g. to
+ * measure latencies. Reading the results from a thread then needs the
+ * interrupts to be disabled meanwhile.
+ *
  * @{
  * @file
  * @brief       Matstat library declarations
@@ -32,6 +44,7 @@
 #ifndef MATSTAT_H
 #define MATSTAT_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -109,6 +122,156 @@ uint64_t matstat_variance(const matstat_state_t *state);
  */
 void matstat_merge(matstat_state_t *dest, const matstat_state_t *src);
 
+/**
+ * @brief   Statistics over a sliding window of the last values
+ *
+ * The values of the window are kept in a ring buffer given by the user.
+ * Mean and variance are computed from the sums in constant time, the sums
+ * being exact as long as the sum of the squares of the values of a window
+ * fits 63 bit.
+ */
+typedef struct {
+    int32_t *values;    /**< ring buffer of the values of the window */
+    int64_t sum;        /**< sum of the values of the window */
+    uint64_t sum_sq;    /**< sum of the squares of the values */
+    uint32_t size;      /**< size of the window */
+    uint32_t count;     /**< number of values in the window */
+    uint32_t pos;       /**< position of the next value in @p values */
+} matstat_window_t;
+
+/**
+ * @brief   Initialize an empty sliding window
+ *
+ * @param[out]  win     window to initialize
+ * @param[in]   values  buffer for @p size values
+ * @param[in]   size    size of the window, at least 1
+ */
+void matstat_window_init(matstat_window_t *win, int32_t *values,
+                         uint32_t size);
+
+/**
+ * @brief   Add a value to a window, dropping the oldest one of a full window
+ *
+ * @param[in]   win     window to operate on
+ * @param[in]   value   value to add
+ */
+void matstat_window_add(matstat_window_t *win, int32_t value);
+
+/**
+ * @brief   Return the mean of the values of a window
+ *
+ * @param[in]   win     window to operate on
+ *
+ * @return  arithmetic mean, 0 for an empty window
+ */
+int32_t matstat_window_mean(const matstat_window_t *win);
+
+/**
+ * @brief   Compute the sample variance of the values of a window
+ *
+ * @param[in]   win     window to operate on
+ *
+ * @return  sample variance, 0 for less than two values
+ */
+uint64_t matstat_window_variance(const matstat_window_t *win);
+
+/**
+ * @brief   Find the minimum of the values of a window
+ *
+ * Takes time linear in the size of the window.
+ *
+ * @param[in]   win     window to operate on
+ *
+ * @return  minimum, INT32_MAX for an empty window
+ */
+int32_t matstat_window_min(const matstat_window_t *win);
+
+/**
+ * @brief   Find the maximum of the values of a window
+ *
+ * Takes time linear in the size of the window.
+ *
+ * @param[in]   win     window to operate on
+ *
+ * @return  maximum, INT32_MIN for an empty window
+ */
+int32_t matstat_window_max(const matstat_window_t *win);
+
+/**
+ * @brief   Number of buckets of a histogram
+ *
+ * @param[in]   bits    values up to 2^@p bits - 1 are told apart
+ * @param[in]   sub     2^@p sub buckets per power of two
+ */
+#define MATSTAT_HIST_BUCKETS(bits, sub)     ((((bits) - (sub)) + 1) << (sub))
+
+/**
+ * @brief   Histogram of logarithmic buckets for quantile estimation
+ *
+ * Values below 2^(sub + 1) are counted exactly. Above, each power of two is
+ * split into 2^sub buckets, so the relative error of a quantile is less than
+ * 2^-sub, e.g. 12.5 % for sub = 3, for a total of
+ * MATSTAT_HIST_BUCKETS(32, 3) = 240 buckets covering all 32 bit values.
+ * Values beyond the last bucket are counted in the last bucket.
+ *
+ * Histograms of the same layout can be merged, so e.g. quantiles over a
+ * sliding window can be estimated from a set of histograms of time slots.
+ */
+typedef struct {
+    uint32_t *buckets;  /**< counts of the buckets */
+    uint32_t count;     /**< number of values added */
+    uint16_t numof;     /**< number of buckets */
+    uint8_t sub;        /**< log2 of the buckets per power of two */
+} matstat_hist_t;
+
+/**
+ * @brief   Initialize an empty histogram
+ *
+ * @param[out]  hist    histogram to initialize
+ * @param[out]  buckets buffer of @p numof buckets, see MATSTAT_HIST_BUCKETS()
+ * @param[in]   numof   number of buckets
+ * @param[in]   sub     log2 of the buckets per power of two, 0 to 8
+ */
+void matstat_hist_init(matstat_hist_t *hist, uint32_t *buckets, size_t numof,
+                       uint8_t sub);
+
+/**
+ * @brief   Reset a histogram
+ *
+ * @param[in]   hist    histogram to clear
+ */
+void matstat_hist_clear(matstat_hist_t *hist);
+
+/**
+ * @brief   Add a value to a histogram
+ *
+ * @param[in]   hist    histogram to operate on
+ * @param[in]   value   value to add
+ */
+void matstat_hist_add(matstat_hist_t *hist, uint32_t value);
+
+/**
+ * @brief   Estimate a quantile of the values of a histogram
+ *
+ * The result is the upper bound of the bucket the quantile falls into, so
+ * at least the given share of the values is less or equal to it.
+ *
+ * @param[in]   hist    histogram to operate on
+ * @param[in]   ppm     quantile in parts per million, e.g. 990000 for the
+ *                      99th percentile
+ *
+ * @return  estimated quantile, 0 for an empty histogram
+ */
+uint32_t matstat_hist_quantile(const matstat_hist_t *hist, uint32_t ppm);
+
+/**
+ * @brief   Add the counts of one histogram to another of the same layout
+ *
+ * @param[inout]    dest    destination histogram
+ * @param[in]       src     source histogram
+ */
+void matstat_hist_merge(matstat_hist_t *dest, const matstat_hist_t *src);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_msg_buf Owned message buffers
+ * @ingroup     sys
+ * @brief       Pass buffers between threads by reference with @ref core_msg
+ *
+ * A @ref msg_t only carries 32 bits of content. To hand larger records from
+ * thread to thread, e.g. sensor frames or CAN frames, without copying them,
+ * a msg_buf_t is sent by reference: msg_send_buf() moves the ownership of
+ * the buffer to the receiver, which calls msg_buf_release() when it is done
+ * with it. If the message can't be delivered, msg_send_buf() releases the
+ * buffer itself, so a buffer is never leaked on the way.
+ *
+ * Buffers usually come from a msg_buf_pool_t, a @ref sys_memarray of fixed
+ * size buffers, and return to it on release. Any other buffer can be sent as
+ * well, with its own release function set by msg_buf_init().
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static MSG_BUF_POOL_DATA(_pool_data, 64, 4);
+ * static msg_buf_pool_t _pool;
+ *
+ * msg_buf_pool_init(&_pool, _pool_data, 64, 4);
+ * ...
+ * msg_buf_t *buf = msg_buf_alloc(&_pool);
+ * if (buf) {
+ *     buf->size = sensor_read(buf->data, buf->capacity);
+ *     msg_send_buf(consumer_pid, MSG_TYPE_FRAME, buf);
+ * }
+ * ...
+ * msg_buf_t *buf = msg_receive_buf(&type);
+ * process(buf->data, buf->size);
+ * msg_buf_release(buf);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Allocating from and releasing to a pool is interrupt safe, so ISRs can
+ * send buffers, too.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Owned message buffer definitions
+ */
+
+#ifndef MSG_BUF_H
+#define MSG_BUF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "memarray.h"
+#include "msg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Message buffer
+ */
+typedef struct msg_buf msg_buf_t;
+
+/**
+ * @brief   Function freeing a message buffer
+ *
+ * @param[in] buf   the buffer to free
+ */
+typedef void (*msg_buf_release_t)(msg_buf_t *buf);
+
+/**
+ * @brief   Message buffer
+ */
+struct msg_buf {
+    msg_buf_release_t release;  /**< frees the buffer, may be NULL */
+    void *ctx;                  /**< context for msg_buf_t::release, the
+                                     pool of pool buffers */
+    uint8_t *data;              /**< the payload */
+    size_t size;                /**< bytes used in msg_buf_t::data */
+    size_t capacity;            /**< size of msg_buf_t::data */
+};
+
+/**
+ * @brief   Pool of message buffers of the same capacity
+ */
+typedef struct {
+    memarray_t mem;             /**< the buffers */
+    size_t capacity;            /**< capacity of each buffer */
+} msg_buf_pool_t;
+
+/**
+ * @brief   Size of a buffer in a msg_buf_pool_t, header included
+ *
+ * @param[in] capacity  payload bytes of the buffer
+ */
+#define MSG_BUF_POOL_ELEM_SIZE(capacity) \
+    ((sizeof(msg_buf_t) + (capacity) + sizeof(void *) - 1) & \
+     ~(sizeof(void *) - 1))
+
+/**
+ * @brief   Declares suitably aligned memory for a msg_buf_pool_t
+ *
+ * @param[in] name      name of the array
+ * @param[in] capacity  payload bytes of each buffer
+ * @param[in] num       number of buffers
+ */
+#define MSG_BUF_POOL_DATA(name, capacity, num) \
+    void *name[(MSG_BUF_POOL_ELEM_SIZE(capacity) * (num)) / sizeof(void *)]
+
+/**
+ * @brief   Initializes a pool of message buffers
+ *
+ * @param[out] pool     the pool
+ * @param[in]  data     memory for the buffers, see @ref MSG_BUF_POOL_DATA
+ * @param[in]  capacity payload bytes of each buffer
+ * @param[in]  num      number of buffers
+ */
+void msg_buf_pool_init(msg_buf_pool_t *pool, void *data, size_t capacity,
+                       size_t num);
+
+/**
+ * @brief   Takes a buffer from a pool
+ *
+ * @param[in,out] pool  the pool
+ *
+ * @return  an empty buffer, released back to @p pool
+ * @return  NULL, if all buffers of @p pool are in use
+ */
+msg_buf_t *msg_buf_alloc(msg_buf_pool_t *pool);
+
+/**
+ * @brief   Initializes a buffer that does not come from a pool
+ *
+ * @param[out] buf      the buffer
+ * @param[in]  data     the payload
+ * @param[in]  size     bytes used in @p data, also its capacity
+ * @param[in]  release  called to free @p buf, may be NULL
+ * @param[in]  ctx      context for @p release
+ */
+static inline void msg_buf_init(msg_buf_t *buf, void *data, size_t size,
+                                msg_buf_release_t release, void *ctx)
+{
+    buf->release = release;
+    buf->ctx = ctx;
+    buf->data = data;
+    buf->size = size;
+    buf->capacity = size;
+}
+
+/**
+ * @brief   Frees a buffer the caller owns
+ *
+ * @param[in] buf   the buffer
+ */
+static inline void msg_buf_release(msg_buf_t *buf)
+{
+    if (buf->release) {
+        buf->release(buf);
+    }
+}
+
+/**
+ * @brief   Sends a buffer, blocking
+ *
+ * Moves the ownership of @p buf to @p target, like msg_send() blocks until
+ * the message is delivered. In interrupt context it does not block.
+ *
+ * @param[in] target    PID of the receiving thread
+ * @param[in] type      type of the message
+ * @param[in] buf       the buffer, owned by the caller
+ *
+ * @return  1, if the buffer was delivered
+ * @return  0, if it could not be delivered without blocking, in interrupt
+ *          context
+ * @return  -1, on an invalid @p target
+ * @return  in all cases but 1, @p buf was released
+ */
+int msg_send_buf(kernel_pid_t target, uint16_t type, msg_buf_t *buf);
+
+/**
+ * @brief   Sends a buffer, without blocking
+ *
+ * Same as msg_send_buf(), but returns 0 like msg_try_send() if @p target
+ * can't take the message right now.
+ *
+ * @param[in] target    PID of the receiving thread
+ * @param[in] type      type of the message
+ * @param[in] buf       the buffer, owned by the caller
+ *
+ * @return  1, if the buffer was delivered
+ * @return  0, if @p target could not take the message
+ * @return  -1, on an invalid @p target
+ * @return  in all cases but 1, @p buf was released
+ */
+int msg_try_send_buf(kernel_pid_t target, uint16_t type, msg_buf_t *buf);
+
+/**
+ * @brief   Receives a buffer, blocking
+ *
+ * For threads receiving only buffers. Threads which also receive other
+ * messages use msg_receive() and msg_buf_from_msg() for the types that
+ * carry buffers.
+ *
+ * @param[out] type     type of the message, may be NULL
+ *
+ * @return  the buffer, now owned by the caller
+ */
+msg_buf_t *msg_receive_buf(uint16_t *type);
+
+/**
+ * @brief   Gets the buffer of a message sent with msg_send_buf()
+ *
+ * @param[in] msg   a message of one of the types used with msg_send_buf()
+ *
+ * @return  the buffer, now owned by the caller
+ */
+static inline msg_buf_t *msg_buf_from_msg(const msg_t *msg)
+{
+    return msg->content.ptr;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MSG_BUF_H */
+/** @} */
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_mtdkv Key/value store on MTD devices
+ * @ingroup     sys
+ * @brief       Wear leveled storage for configuration values on flash
+ *
+ * The store keeps its values in a @ref sys_mtdlog ring log of two or more
+ * erase sectors, e.g. pages of the internal flash by @ref
+ * drivers_mtd_flashpage. Every update appends a record with the key and its
+ * new value (or a deletion mark), so no page is rewritten for an update and
+ * the wear is spread over all sectors.
+ *
+ * - On mount, the log is replayed from the oldest record into a hash index
+ *   in RAM, which maps each key to its newest record. Reading a value looks
+ *   up the index and reads a single record.
+ * - Before the log runs out of sectors, the records still used of the oldest
+ *   sector are appended again and the sector is given up. One sector is
+ *   always kept free for this.
+ * - mtdkv_commit() writes several updates atomically: after a power loss,
+ *   either all or none of them are visible on mount.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static mtd_flashpage_t flash = MTD_FLASHPAGE_INIT(FLASHPAGE_NUMOF - 2, 2);
+ * static mtdkv_t kv;
+ * uint16_t channel = 26;
+ *
+ * mtdkv_init(&kv, &flash.base, 0, 2);
+ * if (mtdkv_get(&kv, "channel", &channel, sizeof(channel)) < 0) {
+ *     mtdkv_set(&kv, "channel", &channel, sizeof(channel));
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @note    The number of keys is limited by the size of the index,
+ *          @ref MTDKV_INDEX_SIZE.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Key/value store definitions
+ */
+
+#ifndef MTDKV_H
+#define MTDKV_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mtdlog.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of slots of the index, must be a power of two
+ *
+ * Up to one less keys can be stored. Deleted keys keep their slot until
+ * their deletion mark is given up with its sector.
+ */
+#ifndef MTDKV_INDEX_SIZE
+#define MTDKV_INDEX_SIZE    (32U)
+#endif
+
+/**
+ * @brief   Maximum length of a key
+ */
+#ifndef MTDKV_KEY_MAX
+#define MTDKV_KEY_MAX       (16U)
+#endif
+
+/**
+ * @brief   Maximum length of a value
+ */
+#ifndef MTDKV_VALUE_MAX
+#define MTDKV_VALUE_MAX     (64U)
+#endif
+
+/**
+ * @brief   Maximum number of updates of a mtdkv_commit()
+ */
+#ifndef MTDKV_COMMIT_MAX
+#define MTDKV_COMMIT_MAX    (8U)
+#endif
+
+/**
+ * @brief   Length of the record header (horizon, flags, key length)
+ */
+#define MTDKV_RECORD_HDR    (6U)
+
+/**
+ * @brief   Index slot, maps a key to its newest record
+ */
+typedef struct {
+    uint32_t hash;          /**< hash of the key */
+    mtdlog_cursor_t pos;    /**< position of the record */
+    uint8_t flags;          /**< slot used, key deleted */
+} mtdkv_slot_t;
+
+/**
+ * @brief   An update of mtdkv_commit()
+ */
+typedef struct {
+    const char *key;        /**< key to update */
+    const void *value;      /**< new value, NULL deletes the key */
+    size_t len;             /**< length of @p value */
+} mtdkv_update_t;
+
+/**
+ * @brief   Key/value store descriptor
+ */
+typedef struct {
+    mtdlog_t log;                           /**< the log holding the records */
+    mtdkv_slot_t index[MTDKV_INDEX_SIZE];   /**< the index */
+    unsigned numof;                         /**< used slots */
+    /** buffer for a record */
+    uint8_t buf[MTDKV_RECORD_HDR + MTDKV_KEY_MAX + MTDKV_VALUE_MAX];
+    mutex_t lock;                           /**< serializes the accesses */
+} mtdkv_t;
+
+/**
+ * @brief   Mounts a store
+ *
+ * An empty range of sectors is an empty store.
+ *
+ * @param[out] kv       store to mount
+ * @param[in]  dev      initialized MTD device
+ * @param[in]  first    first sector used
+ * @param[in]  numof    number of sectors used, at least 2
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the range or the sectors are too small
+ * @return  -ENOMEM if the store holds more keys than the index
+ * @return  <0 on errors of the device
+ */
+int mtdkv_init(mtdkv_t *kv, mtd_dev_t *dev, uint32_t first, uint32_t numof);
+
+/**
+ * @brief   Reads a value
+ *
+ * @param[in]  kv       store to read from
+ * @param[in]  key      key to look up
+ * @param[out] value    buffer for the value
+ * @param[in]  len      size of @p value
+ *
+ * @return  length of the value
+ * @return  -ENOENT if the key is not stored
+ * @return  -ENOBUFS if the value is larger than @p len
+ * @return  <0 on errors of the device
+ */
+int mtdkv_get(mtdkv_t *kv, const char *key, void *value, size_t len);
+
+/**
+ * @brief   Stores a value
+ *
+ * @param[in]  kv       store to write to
+ * @param[in]  key      key to update, at most @ref MTDKV_KEY_MAX characters
+ * @param[in]  value    new value
+ * @param[in]  len      length of @p value, at most @ref MTDKV_VALUE_MAX
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p key or @p len are too long
+ * @return  -ENOMEM if the index is full
+ * @return  -ENOSPC if the sectors are full
+ * @return  <0 on errors of the device
+ */
+int mtdkv_set(mtdkv_t *kv, const char *key, const void *value, size_t len);
+
+/**
+ * @brief   Deletes a key
+ *
+ * @param[in]  kv       store to write to
+ * @param[in]  key      key to delete
+ *
+ * @return  0 on success
+ * @return  -ENOENT if the key is not stored
+ * @return  -ENOSPC if the sectors are full
+ * @return  <0 on errors of the device
+ */
+int mtdkv_delete(mtdkv_t *kv, const char *key);
+
+/**
+ * @brief   Applies several updates atomically
+ *
+ * @param[in]  kv       store to write to
+ * @param[in]  updates  updates to apply, in order
+ * @param[in]  numof    number of @p updates, at most @ref MTDKV_COMMIT_MAX
+ *
+ * @return  0 on success
+ * @return  -EINVAL if an update or @p numof are too long
+ * @return  -ENOMEM if the index is full
+ * @return  -ENOSPC if the sectors are full
+ * @return  <0 on errors of the device
+ */
+int mtdkv_commit(mtdkv_t *kv, const mtdkv_update_t *updates, unsigned numof);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTDKV_H */
+/** @} */
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_mtdlog Append-only ring log on MTD devices
+ * @ingroup     sys
+ * @brief       Stores small records in a circular log on flash
+ *
+ * A log occupies a range of erase sectors of an @ref drivers_mtd device,
+ * which are used as a ring. Records are appended to the current (head)
+ * sector, when it is full the next sector is erased and used, overwriting
+ * the oldest records once the log wrapped around. Each sector is written
+ * sequentially and erased once per round, which keeps the wear minimal and
+ * equal for all sectors.
+ *
+ * @code {unparsed}
+ * sector:  | seq | magic | len | crc | data ... | len | crc | data ... | 0xff...
+ * @endcode
+ *
+ * - Every sector starts with a sequence number, increasing by one for each
+ *   sector used. On mount, the head sector is located by a binary search
+ *   over the sector headers and its end by scanning its records.
+ * - Every record is protected by a CRC16 (see @ref sys_checksum_crc16_ccitt)
+ *   over its length and data. A record torn by a power loss ends its sector,
+ *   appending continues in the next one.
+ * - Records are read with a cursor, which stays valid while records are
+ *   appended. The cursor notices when the records it points to were
+ *   overwritten.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static mtdlog_t log;
+ * mtdlog_cursor_t cur;
+ * uint8_t buf[32];
+ * int len;
+ *
+ * mtdlog_init(&log, mtd, 0, 16);
+ * mtdlog_append(&log, &sample, sizeof(sample), NULL);
+ *
+ * mtdlog_cursor_oldest(&log, &cur);
+ * while ((len = mtdlog_read(&log, &cur, buf, sizeof(buf))) > 0) {
+ *     ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @note    The headers are stored in the byte order of the CPU.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Append-only ring log definitions
+ */
+
+#ifndef MTDLOG_H
+#define MTDLOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Alignment of the records in bytes
+ *
+ * Set to the write granularity of the flash, if it only supports aligned
+ * writes.
+ */
+#ifndef MTDLOG_ALIGN
+#define MTDLOG_ALIGN        (4U)
+#endif
+
+/**
+ * @brief   Marks a sector in use, "mtdl"
+ */
+#define MTDLOG_MAGIC        (0x6d74646cUL)
+
+/**
+ * @brief   Header at the start of each sector
+ */
+typedef struct {
+    uint32_t seq;           /**< sequence number of the sector */
+    uint32_t magic;         /**< @ref MTDLOG_MAGIC, written after seq */
+} mtdlog_sector_hdr_t;
+
+/**
+ * @brief   Bytes used by a record of @p len bytes
+ */
+#define MTDLOG_RECORD_SIZE(len) ((((len) + sizeof(mtdlog_record_hdr_t) + \
+                                   MTDLOG_ALIGN - 1) / MTDLOG_ALIGN) * \
+                                 MTDLOG_ALIGN)
+
+/**
+ * @brief   Bytes of a sector available for records
+ */
+#define MTDLOG_SECTOR_PAYLOAD(sector_size) \
+    ((sector_size) - ((((sizeof(mtdlog_sector_hdr_t) + MTDLOG_ALIGN - 1) / \
+                        MTDLOG_ALIGN) * MTDLOG_ALIGN)))
+
+/**
+ * @brief   Header in front of each record
+ */
+typedef struct {
+    uint16_t len;           /**< length of the data, UINT16_MAX if erased */
+    uint16_t crc;           /**< CRC16-CCITT of len and data */
+} mtdlog_record_hdr_t;
+
+/**
+ * @brief   Ring log descriptor
+ *
+ * All members are set by mtdlog_init(), but @ref mtdlog_t::keep may be
+ * changed afterwards.
+ */
+typedef struct {
+    mtd_dev_t *dev;         /**< device the log is stored on */
+    uint32_t first;         /**< first sector of the log */
+    uint32_t numof;         /**< number of sectors of the log */
+    uint32_t sector_size;   /**< bytes per sector */
+    uint32_t head;          /**< sector appended to, relative to first */
+    uint32_t head_seq;      /**< sequence number of the head sector */
+    uint32_t head_off;      /**< append offset in the head sector */
+    uint32_t tail;          /**< sector holding the oldest records */
+    uint32_t tail_seq;      /**< sequence number of the tail sector */
+    bool keep;              /**< fail with -ENOSPC instead of overwriting */
+    mutex_t lock;           /**< serializes the accesses */
+} mtdlog_t;
+
+/**
+ * @brief   Read position in a log
+ */
+typedef struct {
+    uint32_t seq;           /**< sequence number of the sector */
+    uint32_t off;           /**< offset of the next record in the sector */
+} mtdlog_cursor_t;
+
+/**
+ * @brief   Mounts a log
+ *
+ * Initializes @p dev. Sectors not containing a log are handled as empty, so
+ * an erased range yields an empty log.
+ *
+ * @param[out] log      log descriptor to initialize
+ * @param[in]  dev      device to store the log on
+ * @param[in]  first    first sector of the log
+ * @param[in]  numof    number of sectors to use, at least 2
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the sector range is invalid
+ * @return  <0 on errors of the device
+ */
+int mtdlog_init(mtdlog_t *log, mtd_dev_t *dev, uint32_t first, uint32_t numof);
+
+/**
+ * @brief   Appends a record
+ *
+ * @param[in]  log      log to append to
+ * @param[in]  data     record data
+ * @param[in]  len      length of @p data
+ * @param[out] pos      position of the record, for mtdlog_read(), may be
+ *                      NULL
+ *
+ * @return  0 on success
+ * @return  -EMSGSIZE if the record does not fit into a sector
+ * @return  -ENOSPC if @ref mtdlog_t::keep is set and the oldest records
+ *          would be overwritten
+ * @return  <0 on errors of the device
+ */
+int mtdlog_append(mtdlog_t *log, const void *data, size_t len,
+                  mtdlog_cursor_t *pos);
+
+/**
+ * @brief   Gets the number of unused sectors
+ *
+ * @param[in]  log      log to check
+ *
+ * @return  Number of sectors that can be used before the oldest records are
+ *          overwritten.
+ */
+uint32_t mtdlog_sectors_free(mtdlog_t *log);
+
+/**
+ * @brief   Gives up the sector with the oldest records
+ *
+ * The sector is reused before any other, but not erased now, so its records
+ * show up again when the log is mounted before.
+ *
+ * @param[in]  log      log to truncate
+ *
+ * @return  0 on success
+ * @return  -EINVAL if only the sector appended to is left
+ */
+int mtdlog_drop_oldest(mtdlog_t *log);
+
+/**
+ * @brief   Ends the sector appended to
+ *
+ * The next record starts a new sector, so the current one can be dropped
+ * with mtdlog_drop_oldest() once it is the oldest. The rest of the sector is
+ * used again if the log is mounted before.
+ *
+ * @param[in]  log      log to seal
+ */
+void mtdlog_seal(mtdlog_t *log);
+
+/**
+ * @brief   Erases all records
+ *
+ * @param[in]  log      log to erase
+ *
+ * @return  0 on success
+ * @return  <0 on errors of the device
+ */
+int mtdlog_erase(mtdlog_t *log);
+
+/**
+ * @brief   Points a cursor to the oldest record of a log
+ *
+ * @param[in]  log      log to read
+ * @param[out] cur      cursor to set
+ */
+void mtdlog_cursor_oldest(mtdlog_t *log, mtdlog_cursor_t *cur);
+
+/**
+ * @brief   Points a cursor behind the newest record of a log
+ *
+ * Reading returns the records appended afterwards only.
+ *
+ * @param[in]  log      log to read
+ * @param[out] cur      cursor to set
+ */
+void mtdlog_cursor_newest(mtdlog_t *log, mtdlog_cursor_t *cur);
+
+/**
+ * @brief   Reads the record at a cursor and advances the cursor
+ *
+ * @param[in]     log   log to read
+ * @param[in,out] cur   position to read from
+ * @param[out]    buf   buffer for the record data
+ * @param[in]     len   size of @p buf
+ *
+ * @return  length of the record
+ * @return  0 if there are no more records
+ * @return  -ENOBUFS if the record is longer than @p len, the cursor is kept
+ * @return  -EOVERFLOW if records were overwritten before they were read, the
+ *          cursor now points to the oldest record
+ * @return  <0 on errors of the device
+ */
+int mtdlog_read(mtdlog_t *log, mtdlog_cursor_t *cur, void *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTDLOG_H */
+/** @} */
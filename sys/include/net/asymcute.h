@@ -22,17 +22,39 @@
  * Implemented features:
  * - Connecting to multiple gateways simultaneously
  * - Registration of topic names
- * - Publishing of data (QoS 0 and QoS 1)
+ * - Publishing of data (QoS 0, QoS 1, and QoS 2)
  * - Subscription to topics
  * - Pre-defined topic IDs as well as short and normal topic names
  *
  * Missing features:
  * - Gateway discovery process not implemented
  * - Last will feature not implemented
- * - No support for QoS level 2
  * - No support for wildcard characters in topic names when subscribing
  * - Actual granted QoS level on subscription is ignored
  *
+ * # Publish window
+ *
+ * Up to @ref ASYMCUTE_PUBLISH_WINDOW QoS 1 and QoS 2 publish requests of a
+ * connection are in flight at the same time, each with its own
+ * retransmission timer. Further publish requests are queued and sent as soon
+ * as a request in flight is acknowledged or times out. Message IDs still used
+ * by a pending request are not handed out again.
+ *
+ * If the connection to the gateway is lost, i.e. the gateway does not answer
+ * to keep alive pings or sends a DISCONNECT, the QoS 1 and QoS 2 publish
+ * requests of the connection are not canceled but held. When the client
+ * reconnects without a clean session, they are sent again (with the DUP flag
+ * set, if they were sent before), up to the window at once. Connecting with a
+ * clean session or closing the connection with asymcute_disconnect() cancels
+ * them.
+ *
+ * # Topic ID cache
+ *
+ * Each connection remembers the last @ref ASYMCUTE_TOPIC_CACHE_SIZE topic IDs
+ * it learned from REGACK, SUBACK, and REGISTER messages sent by the gateway.
+ * Registering a cached topic name completes without a round trip to the
+ * gateway. The cache is cleared when connecting with a clean session.
+ *
  * @{
  * @file
  * @brief       Asymcute MQTT-SN interface definition
@@ -152,6 +174,32 @@ extern "C" {
 #define ASYMCUTE_N_RETRY            (3U)
 #endif
 
+#ifndef ASYMCUTE_PUBLISH_WINDOW
+/**
+ * @brief   Maximum number of QoS 1 and QoS 2 publish requests in flight per
+ *          connection
+ */
+#define ASYMCUTE_PUBLISH_WINDOW     (4U)
+#endif
+
+#ifndef ASYMCUTE_TOPIC_CACHE_SIZE
+/**
+ * @brief   Number of topic IDs cached per connection, set to 0 to disable
+ *          the cache
+ */
+#define ASYMCUTE_TOPIC_CACHE_SIZE   (4U)
+#endif
+
+#ifndef ASYMCUTE_QOS2_RX_NUMOF
+/**
+ * @brief   Number of received QoS 2 PUBLISH messages per connection waiting
+ *          for their PUBREL
+ *
+ * Used to deliver retransmissions of these messages only once.
+ */
+#define ASYMCUTE_QOS2_RX_NUMOF      (2U)
+#endif
+
 /**
  * @brief   Return values used by public Asymcute functions
  */
@@ -264,14 +312,34 @@ struct asymcute_con {
     sock_udp_t sock;                    /**< socket used by a connections */
     sock_udp_ep_t server_ep;            /**< the gateway's UDP endpoint */
     asymcute_req_t *pending;            /**< list holding pending requests */
+    asymcute_req_t *queued;             /**< list holding publish requests
+                                         *   waiting for the publish window */
     asymcute_sub_t *subscriptions;      /**< list holding active subscriptions */
     asymcute_evt_cb_t user_cb;          /**< event callback provided by user */
     event_callback_t keepalive_evt;     /**< keep alive event */
     event_timeout_t keepalive_timer;    /**< keep alive timer */
     uint16_t last_id;                   /**< last used message ID for this
                                          *   connection */
+    uint16_t qos2_rx[ASYMCUTE_QOS2_RX_NUMOF];   /**< message IDs of received
+                                                 *   QoS 2 PUBLISH messages
+                                                 *   waiting for PUBREL */
+#if ASYMCUTE_TOPIC_CACHE_SIZE || defined(DOXYGEN)
+    /**
+     * @brief   Topic ID cache
+     */
+    struct {
+        uint16_t id;                            /**< topic ID, 0 if unused */
+        char name[ASYMCUTE_TOPIC_MAXLEN + 1];   /**< topic name */
+    } topics[ASYMCUTE_TOPIC_CACHE_SIZE];
+    uint8_t topics_next;                /**< cache entry to replace next */
+#endif
     uint8_t keepalive_retry_cnt;        /**< keep alive transmission counter */
     uint8_t state;                      /**< connection state */
+    uint8_t inflight;                   /**< QoS 1 and QoS 2 publish requests
+                                         *   in flight */
+    uint8_t qos2_rx_next;               /**< entry of
+                                         *   asymcute_con_t::qos2_rx to
+                                         *   replace next */
     uint8_t rxbuf[ASYMCUTE_BUFSIZE];    /**< connection specific receive buf */
     char cli_id[ASYMCUTE_ID_MAXLEN + 1];/**< buffer to store client ID */
 };
@@ -454,7 +522,8 @@ bool asymcute_is_connected(const asymcute_con_t *con);
  * @param[in,out] req   request context to use for CONNECT procedure
  * @param[in] server    UDP endpoint of the target gateway
  * @param[in] cli_id    client ID to register with the gateway
- * @param[in] clean     set `true` to start a clean session
+ * @param[in] clean     set `true` to start a clean session, this cancels the
+ *                      publish requests held from the last connection
  * @param[in] will      last will (currently not implemented)
  *
  * @return  ASYMCUTE_OK if CONNECT message has been sent
@@ -486,6 +555,9 @@ int asymcute_disconnect(asymcute_con_t *con, asymcute_req_t *req);
  * @param[in,out] req   request context to use for REGISTER procedure
  * @param[in,out] topic topic to register
  *
+ * If the topic ID of @p topic is cached, no REGISTER message is sent, but
+ * ASYMCUTE_REGISTERED is still signaled through the event callback.
+ *
  * @return  ASYMCUTE_OK if REGISTER message has been sent
  * @return  ASYMCUTE_REGERR if topic is already registered
  * @return  ASYMCUTE_GWERR if not connected to a gateway
@@ -504,7 +576,10 @@ int asymcute_register(asymcute_con_t *con, asymcute_req_t *req,
  * @param[in] data_len  size of @p data in bytes
  * @param[in] flags     additional flags (QoS level, DUP, and RETAIN)
  *
- * @return  ASYMCUTE_OK if PUBLISH message has been sent
+ * QoS 1 and QoS 2 requests are queued if @ref ASYMCUTE_PUBLISH_WINDOW
+ * requests are already in flight.
+ *
+ * @return  ASYMCUTE_OK if PUBLISH message has been sent or queued
  * @return  ASYMCUTE_NOTSUP if unsupported flags have been set
  * @return  ASYMCUTE_OVERFLOW if data does not fit into transmit buffer
  * @return  ASYMCUTE_REGERR if given topic is not registered
@@ -36,14 +36,20 @@ extern "C" {
  * @{
  */
 #define COAP_OPT_URI_HOST       (3)
+#define COAP_OPT_ETAG           (4)
 #define COAP_OPT_OBSERVE        (6)
+#define COAP_OPT_URI_PORT       (7)
 #define COAP_OPT_LOCATION_PATH  (8)
+#define COAP_OPT_OSCORE         (9)
 #define COAP_OPT_URI_PATH       (11)
 #define COAP_OPT_CONTENT_FORMAT (12)
+#define COAP_OPT_MAX_AGE        (14)
 #define COAP_OPT_URI_QUERY      (15)
 #define COAP_OPT_LOCATION_QUERY (20)
 #define COAP_OPT_BLOCK2         (23)
 #define COAP_OPT_BLOCK1         (27)
+#define COAP_OPT_PROXY_URI      (35)
+#define COAP_OPT_PROXY_SCHEME   (39)
 /** @} */
 
 /**
@@ -164,6 +164,22 @@ extern "C" {
 #define EMCUTE_N_RETRY          (3U)
 #endif
 
+#ifndef EMCUTE_INFLIGHT_MAX
+/**
+ * @brief   Number of QoS 1 publish messages that can be awaiting their PUBACK
+ *          at the same time (module `emcute_async` only)
+ */
+#define EMCUTE_INFLIGHT_MAX     (4U)
+#endif
+
+#ifndef EMCUTE_INFLIGHT_BUFSIZE
+/**
+ * @brief   Buffer size for each in-flight publish message, including its
+ *          header of up to 9 byte (module `emcute_async` only)
+ */
+#define EMCUTE_INFLIGHT_BUFSIZE (64U)
+#endif
+
 /**
  * @brief   MQTT-SN flags
  *
@@ -198,7 +214,8 @@ enum {
     EMCUTE_REJECT   = -2,       /**< error: operation was rejected by broker */
     EMCUTE_OVERFLOW = -3,       /**< error: ran out of buffer space */
     EMCUTE_TIMEOUT  = -4,       /**< error: timeout */
-    EMCUTE_NOTSUP   = -5        /**< error: feature not supported */
+    EMCUTE_NOTSUP   = -5,       /**< error: feature not supported */
+    EMCUTE_BUSY     = -6        /**< error: no free in-flight slot */
 };
 
 /**
@@ -228,6 +245,28 @@ typedef struct emcute_sub {
     void *arg;                  /**< optional custom argument */
 } emcute_sub_t;
 
+/**
+ * @brief   Signature for callbacks fired when an asynchronous publish
+ *          completes
+ *
+ * The callback is executed in the context of the emCute thread.
+ *
+ * @param[in] res       EMCUTE_OK if the gateway acknowledged the message,
+ *                      EMCUTE_REJECT if it rejected it, EMCUTE_TIMEOUT if no
+ *                      PUBACK arrived after @ref EMCUTE_N_RETRY retries, or
+ *                      EMCUTE_NOGW if the connection was closed
+ * @param[in] arg       optional argument given to emcute_pub_async()
+ */
+typedef void(*emcute_pub_cb_t)(int res, void *arg);
+
+/**
+ * @brief   Publish message for emcute_pub_batch()
+ */
+typedef struct {
+    const void *data;           /**< data to publish */
+    size_t len;                 /**< length of @p data in bytes */
+} emcute_msg_t;
+
 /**
  * @brief   Connect to a given MQTT-SN gateway (CONNECT)
  *
@@ -293,6 +332,55 @@ int emcute_reg(emcute_topic_t *topic);
 int emcute_pub(emcute_topic_t *topic, const void *buf, size_t len,
                unsigned flags);
 
+/**
+ * @brief   Publish data on the given topic with QoS 1, without waiting for
+ *          the PUBACK
+ *
+ * The message is copied into one of @ref EMCUTE_INFLIGHT_MAX in-flight slots
+ * and sent right away. The emCute thread retransmits it every
+ * @ref EMCUTE_T_RETRY seconds until the matching PUBACK arrives and calls
+ * @p cb once the slot is released again.
+ *
+ * @note    Only available with module `emcute_async`
+ *
+ * @param[in] topic     topic to publish to, must be registered
+ * @param[in] buf       data to publish
+ * @param[in] len       length of @p buf in bytes
+ * @param[in] flags     flags used for publication, must contain
+ *                      EMCUTE_QOS_1
+ * @param[in] cb        function called on completion, may be NULL
+ * @param[in] arg       optional argument passed to @p cb
+ *
+ * @return  EMCUTE_OK if the message was sent
+ * @return  EMCUTE_NOGW if not connected to a gateway
+ * @return  EMCUTE_OVERFLOW if length of data exceeds
+ *          @ref EMCUTE_INFLIGHT_BUFSIZE
+ * @return  EMCUTE_BUSY if all in-flight slots are in use
+ */
+int emcute_pub_async(emcute_topic_t *topic, const void *buf, size_t len,
+                     unsigned flags, emcute_pub_cb_t cb, void *arg);
+
+/**
+ * @brief   Publish a number of messages on the given topic
+ *
+ * With QoS 1, up to @ref EMCUTE_INFLIGHT_MAX messages are awaiting their
+ * PUBACK at the same time instead of a single one. The function returns once
+ * every message was either acknowledged or failed.
+ *
+ * @note    Only available with module `emcute_async`
+ *
+ * @param[in] topic     topic to publish to, must be registered
+ * @param[in] msgs      messages to publish
+ * @param[in] num       number of messages in @p msgs
+ * @param[in] flags     flags used for publication
+ *
+ * @return  number of messages published (QoS 1: acknowledged by the gateway)
+ * @return  EMCUTE_NOGW if not connected to a gateway
+ * @return  EMCUTE_NOTSUP on unsupported flag values
+ */
+int emcute_pub_batch(emcute_topic_t *topic, const emcute_msg_t *msgs,
+                     size_t num, unsigned flags);
+
 /**
  * @brief   Subscribe to the given topic
  *
@@ -19,6 +19,7 @@
 #ifndef NET_FIB_TABLE_H
 #define NET_FIB_TABLE_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "kernel_types.h"
@@ -92,6 +93,18 @@ typedef struct {
     size_t entry_pool_size;
 } fib_sr_meta_t;
 
+/**
+ * @brief Number of slots of the optional hash index of a FIB table
+ *
+ * @param[in] size  number of entries of the table
+ */
+#define FIB_INDEX_SIZE(size) (2 * (size))
+
+/**
+ * @brief Number of words of the bitmap of prefix lengths per FIB table
+ */
+#define FIB_PREFIX_LENS_WORDS ((UNIVERSAL_ADDRESS_SIZE * 8) / 32 + 1)
+
 /**
 * @brief FIB table type for single hop entries
 */
@@ -133,6 +146,18 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** Optional hash index of the single hop entries by destination, of
+    *   FIB_INDEX_SIZE(size) slots. With an index, a lookup takes one hash
+    *   lookup per distinct prefix length in the table instead of comparing
+    *   all entries. NULL to compare all entries.
+    */
+    uint16_t *index;
+    /** the lengths of the prefixes in the index, one bit per length */
+    uint32_t prefix_lens[FIB_PREFIX_LENS_WORDS];
+    /** a prefix has bits set beyond its length, so it is only found by
+    *   comparing all entries
+    */
+    bool index_incomplete;
 } fib_table_t;
 
 #ifdef __cplusplus
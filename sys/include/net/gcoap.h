@@ -130,8 +130,10 @@
  *
  * A CoAP client may register for Observe notifications for any resource that
  * an application has registered with gcoap. An application does not need to
- * take any action to support Observe client registration. However, gcoap
- * limits registration for a given resource to a _single_ observer.
+ * take any action to support Observe client registration. Each resource may
+ * have several observers; the total number of registrations is limited by
+ * GCOAP_OBS_REGISTRATIONS_MAX, the number of distinct observed resources by
+ * GCOAP_OBS_RESOURCES_MAX.
  *
  * An Observe notification is considered a response to the original client
  * registration request. So, the Observe server only needs to create and send
@@ -151,7 +153,9 @@
  *    in the coap_pkt_t.
  * -# Call gcoap_finish(), which updates the packet for the payload.
  *
- * Finally, call gcoap_obs_send() for the resource.
+ * Finally, call gcoap_obs_send() for the resource. It sends the notification
+ * to every observer of the resource; only the header and token are rewritten
+ * for each of them.
  *
  * ### Other considerations ###
  *
@@ -166,8 +170,16 @@
  * indicated by the presence of the Observe option in the response.
  *
  * To cancel registration, the server expects to receive a GET request with
- * the Observe option value set to 1. The server does not support cancellation
- * via a reset (RST) response to a non-confirmable notification.
+ * the Observe option value set to 1. A reset (RST) response to the last
+ * notification sent to an observer cancels all its registrations.
+ *
+ * Every GCOAP_OBS_CON_INTERVAL th notification to an observer is sent
+ * confirmable, to learn whether the observer still is interested. At most one
+ * confirmable notification is outstanding per observer; notifications for
+ * the observer are dropped until it is acknowledged or its ACK timeout
+ * expired. The next notification then is sent confirmable again, with doubled
+ * timeout. After COAP_MAX_RETRANSMIT unacknowledged retries, the observer is
+ * removed (see RFC 7641, section 4.5).
  *
  * ## Implementation Notes ##
  *
@@ -188,7 +200,60 @@
  * for a response, so the gcoap thread does not block while waiting. The user is
  * notified via the same callback, whether the message is received or the wait
  * times out. We track the response with an entry in the
- * `_coap_state.open_reqs` array.
+ * `_coap_state.open_reqs` array, or in a pool added with
+ * gcoap_req_memo_pool_add() once that array is exhausted.
+ *
+ * ### Slow resource handlers ###
+ *
+ * Resource handlers run on the gcoap thread, so a handler that blocks stalls
+ * all other CoAP traffic. With module `gcoap_worker`, the handlers of a
+ * listener with the @ref GCOAP_LISTENER_DEFERRED flag run on a pool of
+ * @ref GCOAP_WORKER_NUMOF worker threads instead. gcoap acknowledges a
+ * confirmable request for such a resource right away and sends the response
+ * separately as a non-confirmable message (see RFC 7252, section 5.2.2).
+ *
+ * ### Duplicate requests ###
+ *
+ * A client resends a confirmable request when the response got lost. With
+ * module `gcoap_dedup`, gcoap keeps the last @ref GCOAP_DEDUP_CACHE_SIZE
+ * responses, and answers a request with the message ID and endpoint of one of
+ * them from the cache instead of running the handler again (see RFC 7252,
+ * section 4.5).
+ *
+ * ### Forward proxy ###
+ *
+ * With module `gcoap_proxy`, gcoap forwards requests with a Proxy-Uri or
+ * Proxy-Scheme option to the server they name, e.g. a gateway forwards the
+ * requests of cloud clients to the nodes behind it (see RFC 7252,
+ * section 5.7). Only the `coap` scheme with IPv6 address literals as host is
+ * supported; gcoap answers other requests with 5.05 (Proxying Not Supported).
+ * A confirmable request is acknowledged right away, and the response is sent
+ * separately as a non-confirmable message once the server answered.
+ *
+ * Responses to GET of up to @ref GCOAP_PROXY_PAYLOAD_MAX bytes are kept in a
+ * cache of @ref GCOAP_PROXY_CACHE_SIZE entries for as long as their Max-Age
+ * allows, and later GET requests for the same URI are answered from it. When
+ * an entry with an ETag expires, the proxy validates it with the server
+ * instead of fetching it again. A client that sends the ETag of the cached
+ * response gets 2.03 (Valid). A GET for a URI that is already requested from
+ * the server waits for that response instead of causing another request.
+ * Other methods are forwarded as they come and invalidate the cache entry of
+ * their URI. Block-wise transfers and observing are not proxied.
+ *
+ * ### Object security ###
+ *
+ * With module `gcoap_oscore`, requests sent with gcoap_req_send_oscore() and
+ * their responses are protected end-to-end with OSCORE (RFC 8613), and
+ * gcoap answers protected requests from the clients registered with
+ * gcoap_oscore_ctx_register(). The keys are derived once per security
+ * context, messages are encrypted and decrypted in the PDU buffer; see
+ * @ref net_gcoap_oscore.
+ *
+ * ### Outstanding requests ###
+ *
+ * A client may have several requests outstanding to the same server. Their
+ * number is limited only by the available request memos, unless
+ * @ref GCOAP_NSTART or gcoap_nstart_set() limits it per endpoint.
  *
  * ## Implementation Status ##
  * gcoap includes server and client capability. Available features include:
@@ -226,6 +291,9 @@
 #include "net/sock/udp.h"
 #include "net/nanocoap.h"
 #include "xtimer.h"
+#ifdef MODULE_GCOAP_OSCORE
+#include "net/gcoap/oscore.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -341,6 +409,22 @@ extern "C" {
 #define GCOAP_OBS_REGISTRATIONS_MAX     (2)
 #endif
 
+/**
+ * @brief   Maximum number of resources with Observe registrations; use
+ *          GCOAP_OBS_REGISTRATIONS_MAX if not defined
+ */
+#ifndef GCOAP_OBS_RESOURCES_MAX
+#define GCOAP_OBS_RESOURCES_MAX         (GCOAP_OBS_REGISTRATIONS_MAX)
+#endif
+
+/**
+ * @brief   Send every n-th notification to an observer as confirmable
+ *          message; use 16 if not defined
+ */
+#ifndef GCOAP_OBS_CON_INTERVAL
+#define GCOAP_OBS_CON_INTERVAL          (16)
+#endif
+
 /**
  * @name    States for the memo used to track Observe registrations
  * @{
@@ -408,6 +492,157 @@ extern "C" {
 #define GCOAP_RESEND_BUFS_MAX      (1)
 #endif
 
+/**
+ * @brief   Number of resources the lookup index of module
+ *          `gcoap_resource_index` can hold
+ *
+ * The resources of all registered listeners, including the
+ * `/.well-known/core` resource of gcoap itself, are kept in a sorted index
+ * that is binary searched for each request. If more resources are registered,
+ * gcoap falls back to searching the listeners one by one.
+ */
+#ifndef GCOAP_RESOURCE_INDEX_SIZE
+#define GCOAP_RESOURCE_INDEX_SIZE   (16)
+#endif
+
+/**
+ * @brief   Number of worker threads of module `gcoap_worker`
+ */
+#ifndef GCOAP_WORKER_NUMOF
+#define GCOAP_WORKER_NUMOF          (1)
+#endif
+
+/**
+ * @brief   Stack size of a worker thread
+ */
+#ifndef GCOAP_WORKER_STACK_SIZE
+#define GCOAP_WORKER_STACK_SIZE     (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
+#endif
+
+/**
+ * @brief   Priority of the worker threads
+ */
+#ifndef GCOAP_WORKER_PRIO
+#define GCOAP_WORKER_PRIO           (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @brief   Count of requests that can wait for or be handled by a worker
+ *          thread at the same time
+ *
+ * Each one holds a PDU buffer. Further requests for deferred resources are
+ * answered with 5.03 (Service Unavailable).
+ */
+#ifndef GCOAP_WORKER_JOBS_MAX
+#define GCOAP_WORKER_JOBS_MAX       (2)
+#endif
+
+/**
+ * @brief   Count of responses module `gcoap_dedup` keeps to answer duplicate
+ *          requests
+ *
+ * Each entry holds a PDU buffer. When all entries are in use, the oldest one
+ * is replaced.
+ */
+#ifndef GCOAP_DEDUP_CACHE_SIZE
+#define GCOAP_DEDUP_CACHE_SIZE      (2)
+#endif
+
+/**
+ * @brief   Time in usec a response is kept to answer duplicate requests; use
+ *          EXCHANGE_LIFETIME from RFC 7252 if not defined
+ */
+#ifndef GCOAP_DEDUP_LIFETIME
+#define GCOAP_DEDUP_LIFETIME        (247U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Count of responses module `gcoap_proxy` caches
+ */
+#ifndef GCOAP_PROXY_CACHE_SIZE
+#define GCOAP_PROXY_CACHE_SIZE      (4)
+#endif
+
+/**
+ * @brief   Maximum payload length of a response module `gcoap_proxy` caches
+ *
+ * A cached response is sent from a PDU buffer, which also holds the header
+ * and options of up to 30 bytes.
+ */
+#ifndef GCOAP_PROXY_PAYLOAD_MAX
+#define GCOAP_PROXY_PAYLOAD_MAX     (64)
+#endif
+
+/**
+ * @brief   Maximum length of the path and query of a proxied URI, including
+ *          the terminating null
+ */
+#ifndef GCOAP_PROXY_PATH_MAX
+#define GCOAP_PROXY_PATH_MAX        (64)
+#endif
+
+/**
+ * @brief   Maximum length of a Proxy-Uri option
+ */
+#ifndef GCOAP_PROXY_URI_MAX
+#define GCOAP_PROXY_URI_MAX         (128)
+#endif
+
+/**
+ * @brief   Maximum number of requests module `gcoap_proxy` forwards at the
+ *          same time
+ *
+ * Further requests are answered with 5.03 (Service Unavailable).
+ */
+#ifndef GCOAP_PROXY_PENDING_MAX
+#define GCOAP_PROXY_PENDING_MAX     (2)
+#endif
+
+/**
+ * @brief   Maximum number of clients waiting for the response to a forwarded
+ *          GET request
+ */
+#ifndef GCOAP_PROXY_WAITERS_MAX
+#define GCOAP_PROXY_WAITERS_MAX     (4)
+#endif
+
+/**
+ * @brief   Time in seconds a response without Max-Age option is cached; 60
+ *          in RFC 7252
+ */
+#ifndef GCOAP_PROXY_MAX_AGE_DEFAULT
+#define GCOAP_PROXY_MAX_AGE_DEFAULT (60U)
+#endif
+
+/**
+ * @brief   Default maximum number of outstanding requests to an endpoint
+ *
+ * Zero means no limit beyond the available request memos. RFC 7252 suggests
+ * 1 (NSTART). gcoap_nstart_set() overrides the limit for an endpoint.
+ */
+#ifndef GCOAP_NSTART
+#define GCOAP_NSTART                (0)
+#endif
+
+/**
+ * @brief   Maximum number of endpoints with a limit set by gcoap_nstart_set()
+ */
+#ifndef GCOAP_NSTART_ENDPOINTS_MAX
+#define GCOAP_NSTART_ENDPOINTS_MAX  (2)
+#endif
+
+/**
+ * @name    Flags for gcoap_listener_t
+ * @{
+ */
+/**
+ * @brief   Run the resource handlers of the listener on a worker thread
+ *
+ * Requires module `gcoap_worker`, ignored otherwise.
+ */
+#define GCOAP_LISTENER_DEFERRED     (0x01)
+/** @} */
+
 /**
  * @brief   A modular collection of resources for a server
  */
@@ -416,6 +651,7 @@ typedef struct gcoap_listener {
                                          *   resources; must order alphabetically */
     size_t resources_len;               /**< Length of array */
     struct gcoap_listener *next;        /**< Next listener in list */
+    unsigned flags;                     /**< GCOAP_LISTENER_... flags */
 } gcoap_listener_t;
 
 /**
@@ -452,16 +688,37 @@ typedef struct {
     gcoap_resp_handler_t resp_handler;  /**< Callback for the response */
     xtimer_t response_timer;            /**< Limits wait for response */
     msg_t timeout_msg;                  /**< For response timer */
+#ifdef MODULE_GCOAP_OSCORE
+    gcoap_oscore_req_t oscore;          /**< Protection of the request */
+#endif
 } gcoap_request_memo_t;
 
+/**
+ * @brief   Additional storage for tracking requests
+ *
+ * Beyond @ref GCOAP_REQ_WAITING_MAX open requests and
+ * @ref GCOAP_RESEND_BUFS_MAX confirmable ones, gcoap uses the memos and
+ * resend buffers of all pools added with gcoap_req_memo_pool_add().
+ */
+typedef struct gcoap_req_memo_pool {
+    gcoap_request_memo_t *memos;        /**< Memos for open requests */
+    size_t memos_numof;                 /**< Number of entries in memos */
+    uint8_t (*resend_bufs)[GCOAP_PDU_BUF_SIZE];
+                                        /**< PDU buffers for resending
+                                         *   confirmable requests; may be NULL */
+    size_t resend_bufs_numof;           /**< Number of entries in resend_bufs */
+    struct gcoap_req_memo_pool *next;   /**< Next pool in list */
+} gcoap_req_memo_pool_t;
+
 /**
  * @brief   Memo for Observe registration and notifications
  */
-typedef struct {
+typedef struct gcoap_observe_memo {
     sock_udp_ep_t *observer;            /**< Client endpoint; unused if null */
     const coap_resource_t *resource;    /**< Entity being observed */
     uint8_t token[GCOAP_TOKENLEN_MAX];  /**< Client token for notifications */
     unsigned token_len;                 /**< Actual length of token attribute */
+    struct gcoap_observe_memo *next;    /**< Next registration for resource */
 } gcoap_observe_memo_t;
 
 /**
@@ -482,6 +739,32 @@ kernel_pid_t gcoap_init(void);
  */
 void gcoap_register_listener(gcoap_listener_t *listener);
 
+/**
+ * @brief   Adds storage for tracking more outstanding requests
+ *
+ * The pool must stay valid for the rest of the runtime.
+ *
+ * @param[in] pool      Pool of memos and resend buffers; its content is
+ *                      cleared
+ */
+void gcoap_req_memo_pool_add(gcoap_req_memo_pool_t *pool);
+
+/**
+ * @brief   Sets the maximum number of outstanding requests to an endpoint
+ *
+ * gcoap_req_send2() does not send a request to @p remote while @p nstart
+ * requests to it wait for a response.
+ *
+ * @param[in] remote    Endpoint
+ * @param[in] nstart    Maximum number of outstanding requests, zero for no
+ *                      limit; @ref GCOAP_NSTART restores the default
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if limits are set for @ref GCOAP_NSTART_ENDPOINTS_MAX
+ *          other endpoints already
+ */
+int gcoap_nstart_set(const sock_udp_ep_t *remote, unsigned nstart);
+
 /**
  * @brief   Initializes a CoAP request PDU on a buffer.
 
@@ -556,12 +839,39 @@ static inline ssize_t gcoap_request(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  * @param[in] resp_handler  Callback when response received, may be NULL
  *
  * @return  length of the packet
- * @return  0 if cannot send
+ * @return  0 if cannot send, including when the limit of outstanding requests
+ *          to @p remote is reached (see gcoap_nstart_set())
  */
 size_t gcoap_req_send2(const uint8_t *buf, size_t len,
                        const sock_udp_ep_t *remote,
                        gcoap_resp_handler_t resp_handler);
 
+#if defined(MODULE_GCOAP_OSCORE) || defined(DOXYGEN)
+/**
+ * @brief   Protects a CoAP request with OSCORE and sends it to the provided
+ *          endpoint
+ *
+ * The request is protected in @p buf, which must be large enough for the
+ * protected request, see @ref GCOAP_OSCORE_OVERHEAD. The protection of the
+ * response is removed before @p resp_handler is called; responses failing
+ * to verify are dropped, unprotected error responses are passed on.
+ *
+ * @param[in,out] buf       Buffer containing the PDU
+ * @param[in] len           Length of the PDU
+ * @param[in] buf_len       Size of @p buf
+ * @param[in] remote        Destination for the packet
+ * @param[in] resp_handler  Callback when response received, may be NULL
+ * @param[in] ctx           Security context shared with @p remote
+ *
+ * @return  length of the protected packet
+ * @return  0 if cannot protect or send
+ */
+size_t gcoap_req_send_oscore(uint8_t *buf, size_t len, size_t buf_len,
+                             const sock_udp_ep_t *remote,
+                             gcoap_resp_handler_t resp_handler,
+                             gcoap_oscore_ctx_t *ctx);
+#endif
+
 /**
  * @brief  Sends a buffer containing a CoAP request to the provided host/port
  *
@@ -615,9 +925,10 @@ static inline ssize_t gcoap_response(coap_pkt_t *pdu, uint8_t *buf,
 
 /**
  * @brief   Initializes a CoAP Observe notification packet on a buffer, for the
- *          observer registered for a resource
+ *          observers registered for a resource
  *
- * First verifies that an observer has been registered for the resource.
+ * First verifies that an observer has been registered for the resource. The
+ * token of one observer is used; gcoap_obs_send() sets the token of each.
  *
  * @param[out] pdu      Notification metadata
  * @param[out] buf      Buffer containing the PDU
@@ -633,15 +944,15 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 
 /**
  * @brief   Sends a buffer containing a CoAP Observe notification to the
- *          observer registered for a resource
+ *          observers registered for a resource
  *
- * Assumes a single observer for a resource.
+ * Type, message ID and token of @p buf are replaced for each observer.
  *
- * @param[in] buf Buffer containing the PDU
- * @param[in] len Length of the buffer
+ * @param[in] buf Buffer containing the PDU, as created with gcoap_obs_init()
+ * @param[in] len Length of the buffer; at most GCOAP_PDU_BUF_SIZE
  * @param[in] resource Resource to send
  *
- * @return  length of the packet
+ * @return  length of the packet, if sent to at least one observer
  * @return  0 if cannot send
  */
 size_t gcoap_obs_send(const uint8_t *buf, size_t len,
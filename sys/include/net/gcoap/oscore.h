@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gcoap_oscore OSCORE
+ * @ingroup     net_gcoap
+ * @brief       Object Security for gcoap, with AES-CCM-16-64-128
+ * @see         [RFC 8613](https://tools.ietf.org/html/rfc8613)
+ *
+ * The `gcoap_oscore` module protects requests and responses end-to-end with
+ * the security context shared by a client and a server. A context is derived
+ * once with gcoap_oscore_ctx_init() from the master secret and salt and the
+ * sender and recipient IDs: HKDF-SHA-256 gives the sender key, the recipient
+ * key and the common IV, and the keys are kept as initialized ciphers, so no
+ * key material is derived per message. The context further holds the
+ * sequence number of the sender and the replay window of the recipient, a
+ * bitmap of the last 32 sequence numbers received.
+ *
+ * The protection is computed in the PDU buffer, without COSE structures
+ * built into a buffer of their own:
+ * gcoap_oscore_protect() moves the inner (class E) options and the payload
+ * of a message behind the outer (class U) options and the OSCORE option, and
+ * encrypts them in place with the streaming CCM API of @ref sys_crypto,
+ * followed by the tag. gcoap_oscore_unprotect() decrypts the ciphertext
+ * where it was received and merges the inner options back into the outer
+ * ones. Uri-Host, Uri-Port, Observe, Proxy-Uri and Proxy-Scheme are outer
+ * options, all others are inner. Protecting a response adds at most
+ * @ref GCOAP_OSCORE_OVERHEAD bytes, a request in addition a flags byte, the
+ * Partial IV and the sender ID in the OSCORE option.
+ *
+ * gcoap uses the layer for requests sent with gcoap_req_send_oscore() and
+ * removes the protection of their responses before the response handler is
+ * called. A server registers the contexts of its clients with
+ * gcoap_oscore_ctx_register(); gcoap looks up the context of a request by
+ * its key ID, decrypts it before the resource handler runs and protects the
+ * response, which therefore must leave @ref GCOAP_OSCORE_OVERHEAD bytes of
+ * the buffer unused. Protected requests with an unknown key ID or a replayed
+ * sequence number are answered with 4.01 (Unauthorized), those failing to
+ * decrypt with 4.00 (Bad Request). Requests with a Proxy-Uri or
+ * Proxy-Scheme option are left to @ref net_gcoap "gcoap_proxy", which
+ * forwards them protected.
+ *
+ * Limitations: Observe notifications are not protected, so protected
+ * requests cannot register an observer. The ID context and the Appendix B
+ * procedures are not supported: the sequence number starts at 0 whenever a
+ * context is initialized, so the master secret must be renewed whenever the
+ * node reboots.
+ *
+ * @{
+ *
+ * @file
+ * @brief       OSCORE definitions
+ */
+#ifndef NET_GCOAP_OSCORE_H
+#define NET_GCOAP_OSCORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "crypto/ciphers.h"
+#include "net/nanocoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum length of a sender or recipient ID
+ *
+ * The nonce length of AES-CCM-16-64-128 less 6.
+ */
+#define GCOAP_OSCORE_ID_MAX         (7U)
+
+/**
+ * @brief   Maximum length of a Partial IV, i.e. the CoAP sequence number
+ */
+#define GCOAP_OSCORE_PIV_MAX        (5U)
+
+/**
+ * @brief   Length of the authentication tag
+ */
+#define GCOAP_OSCORE_TAG_LEN        (8U)
+
+/**
+ * @brief   Nonce length, the length of the common IV
+ */
+#define GCOAP_OSCORE_NONCE_LEN      (13U)
+
+/**
+ * @brief   Bytes added to a message by the protection, without the OSCORE
+ *          option value: option header, payload marker, inner code, a longer
+ *          option delta and the tag
+ */
+#define GCOAP_OSCORE_OVERHEAD       (4U + GCOAP_OSCORE_TAG_LEN)
+
+/**
+ * @brief   Size of the scratch buffer for the values of the outer options
+ *          of a message, on the stack
+ */
+#ifndef GCOAP_OSCORE_OUTER_MAX
+#define GCOAP_OSCORE_OUTER_MAX      (64U)
+#endif
+
+/**
+ * @brief   Security context
+ *
+ * Initialize with gcoap_oscore_ctx_init(), all members are private.
+ */
+typedef struct gcoap_oscore_ctx {
+    struct gcoap_oscore_ctx *next;              /**< next registered context */
+    cipher_t sender;                            /**< sender key */
+    cipher_t recipient;                         /**< recipient key */
+    uint64_t sender_seq;                        /**< next sequence number */
+    uint64_t replay_max;                        /**< highest sequence number
+                                                     received */
+    uint32_t replay_window;                     /**< received sequence numbers,
+                                                     bit n for replay_max - n */
+    bool replay_valid;                          /**< replay_max is valid */
+    uint8_t common_iv[GCOAP_OSCORE_NONCE_LEN];  /**< common IV */
+    uint8_t sender_id[GCOAP_OSCORE_ID_MAX];     /**< sender ID */
+    uint8_t sender_id_len;                      /**< length of sender_id */
+    uint8_t recipient_id[GCOAP_OSCORE_ID_MAX];  /**< recipient ID */
+    uint8_t recipient_id_len;                   /**< length of recipient_id */
+} gcoap_oscore_ctx_t;
+
+/**
+ * @brief   A protected request, to protect or verify its response
+ */
+typedef struct {
+    gcoap_oscore_ctx_t *ctx;                    /**< security context, NULL if
+                                                     not protected */
+    uint8_t piv[GCOAP_OSCORE_PIV_MAX];          /**< Partial IV */
+    uint8_t piv_len;                            /**< length of piv */
+} gcoap_oscore_req_t;
+
+/**
+ * @brief   Derives a security context
+ *
+ * @param[out] ctx              context to initialize
+ * @param[in]  secret           master secret
+ * @param[in]  secret_len       length of @p secret
+ * @param[in]  salt             master salt, may be NULL if @p salt_len is 0
+ * @param[in]  salt_len         length of @p salt
+ * @param[in]  sender_id        sender ID, the recipient ID of the peer
+ * @param[in]  sender_id_len    length of @p sender_id
+ * @param[in]  recipient_id     recipient ID, the sender ID of the peer
+ * @param[in]  recipient_id_len length of @p recipient_id
+ *
+ * @return  0 on success
+ * @return  -EINVAL if an ID is longer than @ref GCOAP_OSCORE_ID_MAX
+ * @return  -ENOTSUP if AES is not compiled in
+ */
+int gcoap_oscore_ctx_init(gcoap_oscore_ctx_t *ctx,
+                          const uint8_t *secret, size_t secret_len,
+                          const uint8_t *salt, size_t salt_len,
+                          const uint8_t *sender_id, size_t sender_id_len,
+                          const uint8_t *recipient_id, size_t recipient_id_len);
+
+/**
+ * @brief   Registers a context for the requests of a client
+ *
+ * @param[in] ctx   initialized context, its recipient ID the key ID of the
+ *                  client's requests
+ */
+void gcoap_oscore_ctx_register(gcoap_oscore_ctx_t *ctx);
+
+/**
+ * @brief   Finds a registered context by its recipient ID
+ *
+ * @param[in] kid       key ID of a request
+ * @param[in] kid_len   length of @p kid
+ *
+ * @return  the context
+ * @return  NULL if none is registered for @p kid
+ */
+gcoap_oscore_ctx_t *gcoap_oscore_ctx_find(const uint8_t *kid, size_t kid_len);
+
+/**
+ * @brief   Protects a message in place
+ *
+ * For a request, the next sequence number of the context is used as
+ * Partial IV and stored to @p req. A response is protected with the nonce
+ * of its request.
+ *
+ * @param[in,out] buf       buffer with the message
+ * @param[in]     len       length of the message
+ * @param[in]     buf_len   size of @p buf
+ * @param[in,out] req       request: @p req->ctx set, Partial IV written;
+ *                          response: the request as unprotected
+ * @param[in]     request   true if the message is a request
+ *
+ * @return  length of the protected message
+ * @return  -ENOBUFS if it does not fit @p buf or its outer options do not
+ *          fit @ref GCOAP_OSCORE_OUTER_MAX
+ * @return  -EBADMSG if the message cannot be parsed or is protected already
+ * @return  -EOVERFLOW if the sequence numbers of the context are used up
+ */
+ssize_t gcoap_oscore_protect(uint8_t *buf, size_t len, size_t buf_len,
+                             gcoap_oscore_req_t *req, bool request);
+
+/**
+ * @brief   Removes the protection of a parsed message in place
+ *
+ * The message, shortened by the protection, must be parsed again with
+ * coap_parse().
+ *
+ * @param[in,out] pdu   the message
+ * @param[in,out] req   request: written, with the registered context of its
+ *                      key ID; response: as used to protect its request
+ *
+ * @return  length of the unprotected message
+ * @return  -ENOENT if the message is not protected
+ * @return  -EACCES if no context is registered for the key ID of a request
+ * @return  -EALREADY if the request was received before
+ * @return  -EBADMSG if the message cannot be decrypted
+ * @return  -ENOBUFS if its outer options do not fit
+ *          @ref GCOAP_OSCORE_OUTER_MAX
+ */
+ssize_t gcoap_oscore_unprotect(coap_pkt_t *pdu, gcoap_oscore_req_t *req);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GCOAP_OSCORE_H */
+/** @} */
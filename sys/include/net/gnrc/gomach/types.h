@@ -253,6 +253,7 @@ typedef struct {
     uint16_t sub_channel_seq;       /**< Receiver's sub-channel sequence. */
     uint8_t slots_position;         /**< Node's own slots position. */
     uint8_t slots_num;              /**< Node's allocated slots number. */
+    uint32_t slots_end_us;          /**< End of the node's own slots period. */
 } gnrc_gomach_vtdma_t;
 
 /**
@@ -58,6 +58,27 @@ gnrc_pktsnip_t *gnrc_icmpv6_echo_build(uint8_t type, uint16_t id, uint16_t seq,
 void gnrc_icmpv6_echo_req_handle(gnrc_netif_t *netif, ipv6_hdr_t *ipv6_hdr,
                                  icmpv6_echo_t *echo, uint16_t len);
 
+/**
+ * @brief   Turns a received echo request into the reply and sends it
+ *
+ * Other than gnrc_icmpv6_echo_req_handle() no new packet is built: the
+ * addresses of the IPv6 header are swapped, the type is changed and the
+ * checksum is patched incrementally. The reply is handed to the IPv6
+ * thread as @ref GNRC_IPV6_MSG_TYPE_SND_PREPARED.
+ *
+ * Only unshared packets without extension headers and to a unicast address
+ * are handled.
+ *
+ * @param[in] netif     The interface the echo request was received on.
+ * @param[in] pkt       The echo request, starting with the ICMPv6 snip, in
+ *                      receive order.
+ *
+ * @return  0, if @p pkt was consumed
+ * @return  -EINVAL, if @p pkt can not be replied to in place. It is left
+ *          untouched then.
+ */
+int gnrc_icmpv6_echo_req_reply(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
+
 #ifdef __cplusplus
 }
 #endif
@@ -67,6 +67,37 @@ extern "C" {
 #define GNRC_IPV6_MSG_QUEUE_SIZE    (8U)
 #endif
 
+/**
+ * @brief   Maximum number of messages the IPv6 thread handles per wake-up
+ *
+ * @see     msg_receive_batch()
+ */
+#ifndef GNRC_IPV6_MSG_BATCH_SIZE
+#define GNRC_IPV6_MSG_BATCH_SIZE    (4U)
+#endif
+
+/**
+ * @brief   Number of destinations the flow cache of the IPv6 thread remembers
+ *
+ * @note    Only available with module `gnrc_ipv6_flow_cache`.
+ *
+ * @see     gnrc_ipv6_flow_cache_invalidate()
+ */
+#ifndef GNRC_IPV6_FLOW_CACHE_SIZE
+#define GNRC_IPV6_FLOW_CACHE_SIZE   (4U)
+#endif
+
+/**
+ * @brief   Message type to send a packet with a complete IPv6 header
+ *
+ * The IPv6 thread sends those packets without filling in the IPv6 header or
+ * calculating the upper layer checksum, e.g. replies built in place from a
+ * received packet. Next header, hop limit, payload length, addresses and the
+ * upper layer checksum must be set already. Send with msg_try_send() to
+ * @ref gnrc_ipv6_pid.
+ */
+#define GNRC_IPV6_MSG_TYPE_SND_PREPARED (0x4f00U)
+
 #ifdef DOXYGEN
 /**
  * @brief   Add a static IPv6 link local address to any network interface
@@ -168,6 +199,62 @@ void gnrc_ipv6_demux(gnrc_netif_t *netif, gnrc_pktsnip_t *current,
  */
 ipv6_hdr_t *gnrc_ipv6_get_header(gnrc_pktsnip_t *pkt);
 
+#if defined(MODULE_GNRC_IPV6_FLOW_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Invalidates all entries of the flow cache
+ *
+ * With module `gnrc_ipv6_flow_cache` the IPv6 thread remembers interface,
+ * next hop link-layer address, and source address for the last
+ * @ref GNRC_IPV6_FLOW_CACHE_SIZE unicast destinations it sent to, as long as
+ * the next hop is reachable. Subsequent packets to one of those destinations
+ * then skip route lookup, address resolution, and source address selection.
+ *
+ * The NIB and the network interfaces call this function whenever routes,
+ * neighbor cache entries, or interface addresses change, so there should be
+ * no need to call it from anywhere else.
+ *
+ * @note    The destination cache of the NIB is not updated and
+ *          @ref GNRC_IPV6_NIB_ROUTE_INFO_TYPE_RN is not reported to the
+ *          route info callback for packets that were sent using the flow
+ *          cache.
+ *
+ * This function can be called from any thread.
+ */
+void gnrc_ipv6_flow_cache_invalidate(void);
+#else
+static inline void gnrc_ipv6_flow_cache_invalidate(void)
+{
+}
+#endif
+
+#if defined(MODULE_GNRC_IPV6_FAST_FORWARD) || defined(DOXYGEN)
+/**
+ * @brief   Counters of forwarded packets
+ *
+ * With module `gnrc_ipv6_fast_forward` a router forwards packets whose
+ * destination is in the flow cache (see gnrc_ipv6_flow_cache_invalidate())
+ * from the thread of the receiving interface. The interface header of the
+ * received packet is reused, and the packet goes to the outgoing interface
+ * without passing through the IPv6 thread. All other packets to forward
+ * still take the slow path through the IPv6 thread.
+ *
+ * @note    Only available with module `gnrc_ipv6_fast_forward`. Requires
+ *          @ref net_gnrc_netapi "gnrc_netapi_direct", so received packets
+ *          are handled in the thread of the interface at all.
+ */
+typedef struct {
+    uint32_t fast;      /**< packets forwarded from the receiving interface */
+    uint32_t slow;      /**< packets forwarded by the IPv6 thread */
+} gnrc_ipv6_fwd_stats_t;
+
+/**
+ * @brief   Gets the counters of forwarded packets
+ *
+ * @param[out] stats    the counters
+ */
+void gnrc_ipv6_fwd_stats_get(gnrc_ipv6_fwd_stats_t *stats);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -205,6 +205,45 @@ extern "C" {
 #ifndef GNRC_IPV6_NIB_CONF_MULTIHOP_DAD
 #define GNRC_IPV6_NIB_CONF_MULTIHOP_DAD (0)
 #endif
+
+/**
+ * @brief   Use automatically configured addresses of a 6LN before their
+ *          registration finished
+ *
+ * Addresses with an interface identifier derived from an EUI-64 are assumed
+ * to be unique (see [RFC 6775, section 5.4](https://tools.ietf.org/html/rfc6775#section-5.4)),
+ * so the registration with a router hardly ever fails. These addresses are
+ * marked @ref GNRC_NETIF_IPV6_ADDRS_FLAGS_OPTIMISTIC and can be used right
+ * away instead of after the round trip to the router.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_6LN_OPTIMISTIC
+#define GNRC_IPV6_NIB_CONF_6LN_OPTIMISTIC   (GNRC_IPV6_NIB_CONF_6LN)
+#endif
+
+/**
+ * @brief   Index the off-link entries (forwarding table, prefix list, and
+ *          destination cache) in a longest-prefix-match trie
+ *
+ * Route lookups then no longer need to scan all
+ * @ref GNRC_IPV6_NIB_OFFL_NUMOF entries, which pays off for large forwarding
+ * tables, e.g. on border routers with many downward routes. This requires
+ * `2 * GNRC_IPV6_NIB_OFFL_NUMOF` additional trie nodes of about 32 bytes each.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_OFFL_TRIE
+#define GNRC_IPV6_NIB_CONF_OFFL_TRIE    (0)
+#endif
+
+/**
+ * @brief   Index the on-link entries (e.g. the neighbor cache) by address in
+ *          a hash table
+ *
+ * Neighbor lookups then take constant time instead of scanning all
+ * @ref GNRC_IPV6_NIB_NUMOF entries, which pays off for large 6LoWPAN meshes.
+ * This requires `4 * GNRC_IPV6_NIB_NUMOF` bytes of additional RAM.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_ONL_HASH
+#define GNRC_IPV6_NIB_CONF_ONL_HASH     (0)
+#endif
 /** @} */
 
 /**
@@ -216,6 +255,20 @@ extern "C" {
 #define GNRC_IPV6_NIB_CONF_REACH_TIME_RESET (7200000U)
 #endif
 
+/**
+ * @brief   Time in milliseconds within which the re-registrations of the
+ *          addresses of a 6LN are sent together
+ *
+ * When the re-registration of an address is due, the other registered
+ * addresses of the interface that are due within this time are re-registered
+ * with the same router right along. Their registrations then stay in step,
+ * and the node wakes up once per registration lifetime instead of once per
+ * address.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_REREG_BATCH_MS
+#define GNRC_IPV6_NIB_CONF_REREG_BATCH_MS   (5U * 60U * 1000U)
+#endif
+
 /**
  * @brief   Disable router solicitations
  *
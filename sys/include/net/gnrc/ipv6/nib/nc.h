@@ -95,8 +95,11 @@ extern "C" {
 
 /**
  * @brief   Mask for interface identifier
+ *
+ * Wide enough to also hold the pseudo-PIDs of @ref net_gnrc_netif_shared
+ * interfaces, which are allocated above @ref KERNEL_PID_LAST.
  */
-#define GNRC_IPV6_NIB_NC_INFO_IFACE_MASK                (0x01f0)
+#define GNRC_IPV6_NIB_NC_INFO_IFACE_MASK                (0x07f0)
 
 /**
  * @brief   Shift position of interface identifier
@@ -108,12 +111,12 @@ extern "C" {
  *
  * @see [RFC 6775, section 3.5](https://tools.ietf.org/html/rfc6775#section-3.5)
  */
-#define GNRC_IPV6_NIB_NC_INFO_AR_STATE_MASK             (0x0600)
+#define GNRC_IPV6_NIB_NC_INFO_AR_STATE_MASK             (0x1800)
 
 /**
  * @brief   Shift position of address registration states
  */
-#define GNRC_IPV6_NIB_NC_INFO_AR_STATE_POS              (9)
+#define GNRC_IPV6_NIB_NC_INFO_AR_STATE_POS              (11)
 
 /**
  * @brief   Not managed by 6Lo-AR (address can be removed when memory is low
@@ -123,17 +126,17 @@ extern "C" {
 /**
  * @brief   Address registration still pending at upstream router
  */
-#define GNRC_IPV6_NIB_NC_INFO_AR_STATE_TENTATIVE        (0x0200)
+#define GNRC_IPV6_NIB_NC_INFO_AR_STATE_TENTATIVE        (0x0800)
 
 /**
  * @brief   Address is registered
  */
-#define GNRC_IPV6_NIB_NC_INFO_AR_STATE_REGISTERED       (0x0400)
+#define GNRC_IPV6_NIB_NC_INFO_AR_STATE_REGISTERED       (0x1000)
 
 /**
  * @brief   Address was added manually
  */
-#define GNRC_IPV6_NIB_NC_INFO_AR_STATE_MANUAL           (0x0600)
+#define GNRC_IPV6_NIB_NC_INFO_AR_STATE_MANUAL           (0x1800)
 /** @} */
 
 /**
@@ -209,7 +212,8 @@ static inline unsigned gnrc_ipv6_nib_nc_get_ar_state(const gnrc_ipv6_nib_nc_t *e
  *
  * @pre `ipv6 != NULL`
  * @pre `l2addr_len <= GNRC_IPV6_NIB_L2ADDR_MAX_LEN`
- * @pre `(iface > KERNEL_PID_UNDEF) && (iface <= KERNEL_PID_LAST)`
+ * @pre `(iface > KERNEL_PID_UNDEF) && (iface <= KERNEL_PID_LAST)`, or
+ *      @p iface is an interface of @ref net_gnrc_netif_shared
  *
  * @param[in] ipv6          The neighbor's IPv6 address.
  * @param[in] iface         The interface to the neighbor.
@@ -257,10 +261,39 @@ void gnrc_ipv6_nib_nc_del(const ipv6_addr_t *ipv6, unsigned iface);
  *
  * Entries in state @ref GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED are not
  * affected by this, since they are assumed to always be reachable and kept out
- * of the NUD state-machine
+ * of the NUD state-machine. Neither are entries in state
+ * @ref GNRC_IPV6_NIB_NC_INFO_NUD_STATE_INCOMPLETE, since there is no
+ * link-layer address yet the confirmation could refer to.
+ *
+ * A confirmation restarts the reachable time of the entry and cancels any
+ * pending neighbor unreachability detection probes. To keep the cost of
+ * frequent confirmations low, entries still in state
+ * @ref GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE for more than half of their
+ * reachable time are left untouched.
  */
 void gnrc_ipv6_nib_nc_mark_reachable(const ipv6_addr_t *ipv6);
 
+/**
+ * @brief   Mark neighbor with link-layer address @p l2addr as reachable
+ *
+ * @pre `(l2addr != NULL) || (l2addr_len == 0)`
+ *
+ * @param[in] iface         Interface to the neighbor.
+ * @param[in] l2addr        The neighbor's link-layer address.
+ * @param[in] l2addr_len    Length of @p l2addr.
+ *
+ * Like gnrc_ipv6_nib_nc_mark_reachable(), but for link-layer reachability
+ * confirmation, i.e. a link-layer acknowledgement of a unicast frame. All
+ * neighbor cache entries with @p l2addr on @p iface are marked.
+ *
+ * This function is meant to be called by the thread of @p iface and never
+ * blocks: if the NIB is busy, the confirmation is dropped.
+ *
+ * Does nothing if @ref GNRC_IPV6_NIB_CONF_ARSM == 0.
+ */
+void gnrc_ipv6_nib_nc_mark_reachable_l2(unsigned iface, const uint8_t *l2addr,
+                                        size_t l2addr_len);
+
 /**
  * @brief   Iterates over all neighbor cache entries in the NIB
  *
@@ -90,6 +90,9 @@ typedef struct __attribute__((packed)) {
     gnrc_lwmac_hdr_t header;        /**< WA packet header type */
     gnrc_lwmac_l2_addr_t dst_addr;  /**< WA is broadcast, so destination address needed */
     uint32_t current_phase;         /**< Node's current phase value */
+    uint8_t wakeup_shift;           /**< Node's wake-up interval is
+                                         @ref GNRC_LWMAC_WAKEUP_INTERVAL_US
+                                         shifted right by this */
 } gnrc_lwmac_frame_wa_t;
 
 /**
@@ -61,6 +61,18 @@
  * receiver's phase is too close to its own phase, it will run a backoff scheme to
  * randomly reselect a new wake-up phase for itself.
  *
+ * ## Traffic adaptive wake-up interval
+ * Under load, a node halves its wake-up interval up to
+ * @ref GNRC_LWMAC_WAKEUP_INTERVAL_SHIFT_MAX times, so packets for it wait less
+ * for its next wake-up. The load (receptions plus queued packets) is evaluated
+ * once per @ref GNRC_LWMAC_WAKEUP_INTERVAL_US, and the interval is doubled
+ * again after @ref GNRC_LWMAC_WAKEUP_ADAPT_IDLE idle intervals. The shortened
+ * intervals divide the full one, so a node still wakes up at the phase its
+ * neighbors have locked on. The current interval is advertised in the WA
+ * packets, so phase-locked senders also use the additional wake-ups.
+ * The radio on-time is accounted in gnrc_lwmac_t::awake_duration_sum_ticks and
+ * the number of wake-ups in gnrc_lwmac_t::wakeup_count.
+ *
  * @{
  *
  * @file
@@ -98,6 +110,34 @@ extern "C" {
 #define GNRC_LWMAC_WAKEUP_INTERVAL_US        (200LU *US_PER_MS)
 #endif
 
+/**
+ * @brief Maximum number of times the wake-up interval is halved under load.
+ *
+ * Set to 0 to always use @ref GNRC_LWMAC_WAKEUP_INTERVAL_US.
+ */
+#ifndef GNRC_LWMAC_WAKEUP_INTERVAL_SHIFT_MAX
+#define GNRC_LWMAC_WAKEUP_INTERVAL_SHIFT_MAX (2U)
+#endif
+
+/**
+ * @brief Load in one @ref GNRC_LWMAC_WAKEUP_INTERVAL_US to halve the wake-up
+ *        interval.
+ *
+ * The load is the number of successful receptions in that interval and the
+ * number of packets queued for transmission at its end.
+ */
+#ifndef GNRC_LWMAC_WAKEUP_ADAPT_BUSY
+#define GNRC_LWMAC_WAKEUP_ADAPT_BUSY         (2U)
+#endif
+
+/**
+ * @brief Number of consecutive @ref GNRC_LWMAC_WAKEUP_INTERVAL_US without load
+ *        to double the wake-up interval again.
+ */
+#ifndef GNRC_LWMAC_WAKEUP_ADAPT_IDLE
+#define GNRC_LWMAC_WAKEUP_ADAPT_IDLE         (2U)
+#endif
+
 /**
  * @brief The Maximum WR (preamble packet @ref gnrc_lwmac_frame_wr_t) duration time.
  *
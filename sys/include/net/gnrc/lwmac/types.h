@@ -203,13 +203,21 @@ typedef struct lwmac {
     uint32_t last_wakeup;                                       /**< Used to calculate wakeup times */
     uint8_t lwmac_info;                                         /**< LWMAC's internal informations (flags) */
     gnrc_lwmac_timeout_t timeouts[GNRC_LWMAC_TIMEOUT_COUNT];    /**< Store timeouts used for protocol */
+    uint32_t base_wakeup;                                       /**< Last wake-up at the phase of the full
+                                                                     interval */
+    uint8_t wakeup_shift;                                       /**< Wake-up interval is
+                                                                     @ref GNRC_LWMAC_WAKEUP_INTERVAL_US
+                                                                     shifted right by this */
+    uint8_t rx_count;                                           /**< Receptions since base_wakeup */
+    uint8_t idle_count;                                         /**< Full intervals without load */
 
-#if (GNRC_LWMAC_ENABLE_DUTYCYLE_RECORD == 1)
     /* Parameters for recording duty-cycle */
     uint32_t last_radio_on_time_ticks;                          /**< The last time in ticks when radio is on */
+    uint32_t awake_duration_sum_ticks;                          /**< The sum of time in ticks when radio is on */
+    uint32_t wakeup_count;                                      /**< Number of wake-ups */
+#if (GNRC_LWMAC_ENABLE_DUTYCYLE_RECORD == 1)
     uint32_t radio_off_time_ticks;                              /**< The time in ticks when radio is off */
     uint32_t system_start_time_ticks;                           /**< The time in ticks when chip is started */
-    uint32_t awake_duration_sum_ticks;                          /**< The sum of time in ticks when radio is on */
     uint32_t pkt_start_sending_time_ticks;                      /**< The time in ticks when the packet is started
                                                                      to be sent */
 #endif
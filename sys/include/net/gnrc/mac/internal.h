@@ -105,6 +105,10 @@ static inline void gnrc_netif_set_tx_feedback(gnrc_netif_t *netif,
  *        On the other hand, if `gnrc_mac_tx_neighbor_t` structure is not in used (indicated
  *        by `GNRC_MAC_NEIGHBOR_COUNT == 0`), this function queues the packet into the single
  *        priority TX queue defined in in netdev_t::tx.
+ *        If all queue entries are in use, the last packet of the longest
+ *        neighbor queue is dropped for @p pkt, if the queue is longer than
+ *        the one of @p pkt's destination. So a neighbor that is not reachable
+ *        for a longer time can't block the queues of the other neighbors.
  *
  * @param[in,out] tx        gnrc_mac transmission management object
  * @param[in]     priority  the priority of @p pkt
@@ -113,6 +117,25 @@ static inline void gnrc_netif_set_tx_feedback(gnrc_netif_t *netif,
  * @return                  true if queued successfully, otherwise false.
  */
 bool gnrc_mac_queue_tx_packet(gnrc_mac_tx_t *tx, uint32_t priority, gnrc_pktsnip_t *pkt);
+
+#if (GNRC_MAC_NEIGHBOR_COUNT != 0) || defined(DOXYGEN)
+/**
+ * @brief Takes the next packet to a unicast neighbor out of the TX queues.
+ *        The neighbor queues are served by deficit round robin: each round,
+ *        a non-empty queue is credited @ref GNRC_MAC_TX_DRR_QUANTUM bytes
+ *        and may send as long as its head packet fits its credit. So
+ *        neighbors get an equal share of transmissions in bytes, regardless
+ *        of how many packets are queued for them. The broadcast queue
+ *        (neighbor id `0`) is not part of the rounds.
+ *
+ * @param[in,out] tx        gnrc_mac transmission management object
+ * @param[out]    neighbor  the neighbor of the returned packet
+ *
+ * @return                  the packet, NULL if all unicast queues are empty.
+ */
+gnrc_pktsnip_t *gnrc_mac_dequeue_tx_packet(gnrc_mac_tx_t *tx,
+                                           gnrc_mac_tx_neighbor_t **neighbor);
+#endif /* (GNRC_MAC_NEIGHBOR_COUNT != 0) || defined(DOXYGEN) */
 #endif /* (GNRC_MAC_TX_QUEUE_SIZE != 0) || defined(DOXYGEN) */
 
 #if (GNRC_MAC_RX_QUEUE_SIZE != 0) || defined(DOXYGEN)
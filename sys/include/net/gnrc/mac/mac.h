@@ -56,6 +56,16 @@ extern "C" {
 #define GNRC_MAC_TX_QUEUE_SIZE             (8U)
 #endif
 
+/**
+ * @brief   Bytes a neighbor's TX queue is credited with per round of the
+ *          deficit round robin scheduler
+ *
+ * @see gnrc_mac_dequeue_tx_packet()
+ */
+#ifndef GNRC_MAC_TX_DRR_QUANTUM
+#define GNRC_MAC_TX_DRR_QUANTUM            (127U)
+#endif
+
 /**
  * @brief Enable/disable MAC radio duty-cycle recording and displaying.
  *
@@ -35,6 +35,9 @@
 #ifdef MODULE_GNRC_GOMACH
 #include "net/gnrc/gomach/types.h"
 #endif
+#ifdef MODULE_GNRC_TSCH
+#include "net/gnrc/tsch/types.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -116,6 +119,17 @@ typedef struct {
 #endif  /* ((GNRC_MAC_RX_QUEUE_SIZE != 0) || (GNRC_MAC_DISPATCH_BUFFER_SIZE != 0)) || defined(DOXYGEN) */
 
 #if (GNRC_MAC_NEIGHBOR_COUNT != 0) || defined(DOXYGEN)
+#if (GNRC_MAC_TX_QUEUE_SIZE != 0) || defined(DOXYGEN)
+/**
+ * @brief Statistics of a neighbor's TX queue.
+ */
+typedef struct {
+    uint16_t queued;        /**< Packets queued for the neighbor */
+    uint16_t dropped;       /**< Packets dropped for lack of queue entries */
+    uint8_t depth_max;      /**< Maximum length of the queue */
+} gnrc_mac_tx_queue_stats_t;
+#endif /* (GNRC_MAC_TX_QUEUE_SIZE != 0) || defined(DOXYGEN) */
+
 /**
  * @brief type for storing states of TX neighbor node.
  */
@@ -126,6 +140,9 @@ typedef struct {
 
 #if (GNRC_MAC_TX_QUEUE_SIZE != 0) || defined(DOXYGEN)
     gnrc_priority_pktqueue_t queue;                  /**< TX queue for this particular Neighbor */
+    uint16_t deficit;                                /**< Bytes the queue may send in the
+                                                          current scheduling round */
+    gnrc_mac_tx_queue_stats_t stats;                 /**< Statistics of the queue */
 #endif /* (GNRC_MAC_TX_QUEUE_SIZE != 0) || defined(DOXYGEN) */
 
 #ifdef MODULE_GNRC_GOMACH
@@ -133,6 +150,14 @@ typedef struct {
     uint32_t cp_phase;      /**< Neighbor's wake-up phase. */
     uint8_t mac_type;       /**< Neighbor's phase-track indicator. */
 #endif
+
+#ifdef MODULE_GNRC_LWMAC
+    uint8_t wakeup_shift;   /**< Neighbor's wake-up interval shift, valid with its phase. */
+#endif
+
+#ifdef MODULE_GNRC_TSCH
+    uint8_t tsch_retries;   /**< Retransmissions of the frame at the queue's head. */
+#endif
 } gnrc_mac_tx_neighbor_t;
 
 /**
@@ -154,6 +179,8 @@ typedef struct {
         0, \
         GNRC_MAC_PHASE_UNINITIALIZED, \
         PRIORITY_PKTQUEUE_INIT, \
+        0, \
+        { 0 }, \
 }
 #else
 #define GNRC_MAC_TX_NEIGHBOR_INIT { \
@@ -188,6 +215,9 @@ typedef struct {
 
     gnrc_priority_pktqueue_node_t _queue_nodes[GNRC_MAC_TX_QUEUE_SIZE]; /**< Shared buffer for TX queue nodes */
     gnrc_pktsnip_t *packet;                                             /**< currently scheduled packet for sending */
+#if (GNRC_MAC_NEIGHBOR_COUNT != 0) || defined(DOXYGEN)
+    uint8_t drr_next;                                                   /**< Neighbor the scheduling round continues with */
+#endif /* (GNRC_MAC_NEIGHBOR_COUNT != 0) || defined(DOXYGEN) */
 #endif /* (GNRC_MAC_TX_QUEUE_SIZE != 0) || defined(DOXYGEN) */
 
 #ifdef MODULE_GNRC_LWMAC
@@ -210,7 +240,6 @@ typedef struct {
     gnrc_gomach_vtdma_t vtdma_para;               /**< Node's vTMDA slots allocation management unit. */
     uint8_t no_ack_counter;                       /**< Counter for recording no-ACK times for data transmission. */
     uint8_t t2u_retry_counter;                    /**< Counter for recording t2u attempt failures. */
-    uint8_t last_tx_neighbor_id;                  /**< Record last TX neighbor's sequence in the neighbor list. */
     uint8_t tx_busy_count;                        /**< Counter recording csma busy feedback times. */
     uint8_t t2u_fail_count;                       /**< Preamble trial failure count. */
 #endif
@@ -225,6 +254,7 @@ typedef struct {
         NULL, \
         { PRIORITY_PKTQUEUE_NODE_INIT(0, NULL) }, \
         NULL, \
+        0, \
 }
 #elif ((GNRC_MAC_TX_QUEUE_SIZE != 0) && (GNRC_MAC_NEIGHBOR_COUNT == 0)) || defined(DOXYGEN)
 #define GNRC_MAC_TX_INIT { \
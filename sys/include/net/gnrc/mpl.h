@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_mpl MPL
+ * @ingroup     net_gnrc
+ * @brief       Multicast forwarding with the Multicast Protocol for Low-Power
+ *              and Lossy Networks
+ * @see         [RFC 7731](https://tools.ietf.org/html/rfc7731)
+ *
+ * The `gnrc_mpl` module floods multicast packets to the addresses of its MPL
+ * domains through a multi-hop mesh. A domain is a multicast address of at
+ * least realm-local scope; @ref MPL_ALL_FORWARDERS_REALM_LOCAL is added by
+ * gnrc_mpl_init(), others with gnrc_mpl_domain_add(). Every interface joins
+ * each domain address and its link-local variant, e.g. `ff02::fc` for
+ * `ff03::fc`, to which the control messages of the domain are sent.
+ *
+ * Packets sent to a domain address by this node become MPL data messages:
+ * @ref net_gnrc_ipv6 hands them to gnrc_mpl_seed(), which adds a hop-by-hop
+ * options header with the MPL option, carrying the sequence number of the
+ * node as seed, and sends them on all interfaces. Received data messages
+ * pass gnrc_mpl_receive() before they are delivered: duplicates are
+ * dropped, new messages are copied into a buffer of
+ * @ref GNRC_MPL_BUFFER_SIZE messages to send them on.
+ *
+ * Duplicates are detected with the seed set: for each of up to
+ * @ref GNRC_MPL_SEED_SET_SIZE seeds the lowest sequence number still
+ * accepted and a bitmap of the 32 sequence numbers from there that were
+ * received. Older messages are dropped, newer ones move the window. When a
+ * seed is evicted from the full set, its received sequence numbers are added
+ * to a blocked Bloom filter, so duplicates still travelling the mesh are
+ * recognized once the seed shows up again. A false positive of the filter
+ * drops a single new message.
+ *
+ * Each buffered message is sent on by a trickle timer (@ref sys_trickle),
+ * that a consistent duplicate from a neighbor suppresses. In reactive mode
+ * the messages are only sent when the control messages show that a neighbor
+ * misses them: one trickle timer per domain advertises the seed set and the
+ * buffered messages to the neighbors, see @ref gnrc_mpl_mode_t.
+ *
+ * @{
+ *
+ * @file
+ * @brief       MPL definitions
+ */
+#ifndef NET_GNRC_MPL_H
+#define NET_GNRC_MPL_H
+
+#include <stdbool.h>
+
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/pkt.h"
+#include "net/ipv6/addr.h"
+#include "net/mpl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Stack size of the MPL thread
+ */
+#ifndef GNRC_MPL_STACK_SIZE
+#define GNRC_MPL_STACK_SIZE         (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the MPL thread
+ */
+#ifndef GNRC_MPL_PRIO
+#define GNRC_MPL_PRIO               (GNRC_IPV6_PRIO + 1)
+#endif
+
+/**
+ * @brief   Message queue size of the MPL thread
+ */
+#ifndef GNRC_MPL_MSG_QUEUE_SIZE
+#define GNRC_MPL_MSG_QUEUE_SIZE     (8U)
+#endif
+
+/**
+ * @brief   Number of MPL domains
+ */
+#ifndef GNRC_MPL_DOMAINS_NUMOF
+#define GNRC_MPL_DOMAINS_NUMOF      (2U)
+#endif
+
+/**
+ * @brief   Number of seeds in the seed set
+ */
+#ifndef GNRC_MPL_SEED_SET_SIZE
+#define GNRC_MPL_SEED_SET_SIZE      (8U)
+#endif
+
+/**
+ * @brief   Time in seconds a seed without new messages is kept in the seed
+ *          set, SEED_SET_ENTRY_LIFETIME of RFC 7731
+ */
+#ifndef GNRC_MPL_SEED_SET_ENTRY_LIFETIME
+#define GNRC_MPL_SEED_SET_ENTRY_LIFETIME    (1800U)
+#endif
+
+/**
+ * @brief   Number of buffered messages
+ */
+#ifndef GNRC_MPL_BUFFER_SIZE
+#define GNRC_MPL_BUFFER_SIZE        (4U)
+#endif
+
+/**
+ * @brief   Number of 64 byte blocks of the Bloom filter of evicted seeds
+ *
+ * A block holds about 50 sequence numbers at a false positive rate of 1 %.
+ * The filter is cleared when it holds that many per block.
+ */
+#ifndef GNRC_MPL_BLOOM_BLOCKS
+#define GNRC_MPL_BLOOM_BLOCKS       (1U)
+#endif
+
+/**
+ * @name    Trickle parameters of data messages, in ms and doublings of Imin
+ * @{
+ */
+#ifndef GNRC_MPL_DATA_MESSAGE_IMIN
+#define GNRC_MPL_DATA_MESSAGE_IMIN          (64U)
+#endif
+#ifndef GNRC_MPL_DATA_MESSAGE_IMAX
+#define GNRC_MPL_DATA_MESSAGE_IMAX          (0U)
+#endif
+#ifndef GNRC_MPL_DATA_MESSAGE_K
+#define GNRC_MPL_DATA_MESSAGE_K             (1U)
+#endif
+#ifndef GNRC_MPL_DATA_MESSAGE_TIMER_EXPIRATIONS
+#define GNRC_MPL_DATA_MESSAGE_TIMER_EXPIRATIONS     (3U)
+#endif
+/** @} */
+
+/**
+ * @name    Trickle parameters of control messages, in ms and doublings of
+ *          Imin
+ * @{
+ */
+#ifndef GNRC_MPL_CONTROL_MESSAGE_IMIN
+#define GNRC_MPL_CONTROL_MESSAGE_IMIN       (256U)
+#endif
+#ifndef GNRC_MPL_CONTROL_MESSAGE_IMAX
+#define GNRC_MPL_CONTROL_MESSAGE_IMAX       (10U)
+#endif
+#ifndef GNRC_MPL_CONTROL_MESSAGE_K
+#define GNRC_MPL_CONTROL_MESSAGE_K          (1U)
+#endif
+#ifndef GNRC_MPL_CONTROL_MESSAGE_TIMER_EXPIRATIONS
+#define GNRC_MPL_CONTROL_MESSAGE_TIMER_EXPIRATIONS  (10U)
+#endif
+/** @} */
+
+/**
+ * @brief   Forwarding modes
+ */
+typedef enum {
+    /**
+     * @brief   Buffered messages are sent by their trickle timer right away,
+     *          no control messages are sent (PROACTIVE_FORWARDING of
+     *          RFC 7731)
+     */
+    GNRC_MPL_MODE_PROACTIVE = 0,
+    /**
+     * @brief   Buffered messages are only sent to neighbors whose control
+     *          messages lack them, saving transmissions in dense meshes at
+     *          the cost of latency
+     */
+    GNRC_MPL_MODE_REACTIVE,
+    /**
+     * @brief   Both: messages are sent right away, control messages repair
+     *          what was lost nevertheless
+     */
+    GNRC_MPL_MODE_BOTH,
+} gnrc_mpl_mode_t;
+
+/**
+ * @brief   Forwarding mode gnrc_mpl_init() sets
+ */
+#ifndef GNRC_MPL_MODE
+#define GNRC_MPL_MODE               (GNRC_MPL_MODE_PROACTIVE)
+#endif
+
+/**
+ * @brief   Message type for the trickle timers
+ */
+#define GNRC_MPL_MSG_TYPE_TRICKLE   (0x0910)
+
+/**
+ * @brief   PID of the MPL thread
+ */
+extern kernel_pid_t gnrc_mpl_pid;
+
+/**
+ * @brief   Starts the MPL thread and adds
+ *          @ref MPL_ALL_FORWARDERS_REALM_LOCAL as domain
+ *
+ * Called by auto_init after the network interfaces are initialized.
+ *
+ * @return  PID of the MPL thread
+ * @return  KERNEL_PID_UNDEF if it could not be started
+ */
+kernel_pid_t gnrc_mpl_init(void);
+
+/**
+ * @brief   Adds an MPL domain
+ *
+ * All interfaces join @p addr and its link-local variant.
+ *
+ * @param[in] addr  multicast address of at least realm-local scope
+ *
+ * @return  0 on success or if @p addr is a domain already
+ * @return  -EINVAL if @p addr is not a multicast address of at least
+ *          realm-local scope
+ * @return  -ENOMEM if there are @ref GNRC_MPL_DOMAINS_NUMOF domains already
+ */
+int gnrc_mpl_domain_add(const ipv6_addr_t *addr);
+
+/**
+ * @brief   Checks whether an address is an MPL domain
+ *
+ * @param[in] addr  an IPv6 address
+ *
+ * @return  true if @p addr is the address of an MPL domain
+ */
+bool gnrc_mpl_is_domain(const ipv6_addr_t *addr);
+
+/**
+ * @brief   Sets the forwarding mode
+ *
+ * @param[in] mode  the mode
+ */
+void gnrc_mpl_set_mode(gnrc_mpl_mode_t mode);
+
+/**
+ * @brief   Turns a packet sent to an MPL domain by this node into a data
+ *          message (called by @ref net_gnrc_ipv6)
+ *
+ * Adds the hop-by-hop options header with the MPL option and buffers a copy
+ * to send it on.
+ *
+ * @pre The IPv6 header of @p pkt is filled, its upper layer checksum
+ *      calculated, and @p pkt has no extension headers
+ *
+ * @param[in] pkt   packet in send order, starting with the IPv6 header, does
+ *                  not need to be writable
+ *
+ * @return  the data message, as a single snip of type GNRC_NETTYPE_IPV6, to
+ *          send on all interfaces
+ * @return  NULL if there is no space in the packet buffer, @p pkt is
+ *          released
+ */
+gnrc_pktsnip_t *gnrc_mpl_seed(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Checks a received packet for a data message (called by
+ *          @ref net_gnrc_ipv6)
+ *
+ * @param[in] pkt       the payload after the IPv6 header, in receive order
+ * @param[in] ipv6      the IPv6 header of @p pkt
+ *
+ * @return  true if @p pkt is a duplicate or invalid data message, to be
+ *          dropped
+ * @return  false to deliver @p pkt as usual
+ */
+bool gnrc_mpl_receive(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *ipv6);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_MPL_H */
+/** @} */
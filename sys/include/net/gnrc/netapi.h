@@ -54,6 +54,35 @@
  * USEMODULE += gnrc_netapi_callbacks
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * @}
+ *
+ * @defgroup    net_gnrc_netapi_direct   Run-to-completion receive path
+ * @ingroup     net_gnrc_netapi
+ * @brief       Handle received packets in the thread of the lower layer
+ * @{
+ * @details With the submodule `gnrc_netapi_direct`, the @ref net_gnrc_ipv6
+ *          and @ref net_gnrc_udp threads register a
+ *          [callback](@ref net_gnrc_netapi_callbacks) instead of their PID
+ *          at the @ref net_gnrc_netreg. Received packets are then handled
+ *          already within gnrc_netapi_dispatch_receive(), so e.g. a UDP
+ *          datagram runs through IPv6 and UDP in the thread of the network
+ *          interface and only the final hand-over to the application costs
+ *          a context switch. Packets to send, packets to forward, and
+ *          timer events are still handled in the thread of the respective
+ *          layer. Layers without such a callback keep using their thread
+ *          for everything.
+ *
+ * To use, add the module `gnrc_netapi_direct` to the `USEMODULE` macro in
+ * your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_direct
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @warning The stacks of the network interface threads (and of the
+ *          @ref net_gnrc_sixlowpan thread) need to accommodate the receive
+ *          functions of IPv6 and UDP in addition to their own, i.e. about
+ *          @ref GNRC_IPV6_STACK_SIZE more.
+ * @}
  */
 
 #ifndef NET_GNRC_NETAPI_H
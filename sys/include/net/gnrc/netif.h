@@ -14,6 +14,26 @@
  * Network interfaces in the context of GNRC are threads for protocols that are
  * below the network layer.
  *
+ * Nodes with exactly one network interface can use the `gnrc_netif_single`
+ * pseudomodule. The lookups of interfaces then check that one interface
+ * instead of iterating over all of them, which saves cycles on every packet.
+ *
+ * With the `gnrc_netif_poll` pseudomodule an interface switches to polling
+ * once a device interrupt yielded a received frame: it calls the driver's
+ * @ref netdev_driver_t::isr "isr()" again until no more frames come in, at
+ * most @ref GNRC_NETIF_POLL_BUDGET frames per round before it lets its
+ * pending messages through. Interrupts of the device in that time don't post
+ * messages, they are only remembered. The driver's `isr()` must cope
+ * with being called without a pending interrupt.
+ *
+ * With the `gnrc_netif_csum_offload` pseudomodule an interface asks its
+ * device for @ref NETOPT_CSUM_OFFLOAD_TX and @ref NETOPT_CSUM_OFFLOAD_RX, so
+ * IPv6 leaves the checksums the device calculates to the device and UDP, TCP
+ * and ICMPv6 trust the checksums it verifies.
+ *
+ * With the `gnrc_netif_shared` module several interfaces can share one
+ * thread driven by an event queue, see @ref net_gnrc_netif_shared.
+ *
  * @{
  *
  * @file
@@ -44,6 +64,12 @@
 #ifdef MODULE_GNRC_MAC
 #include "net/gnrc/netif/mac.h"
 #endif
+#ifdef MODULE_GNRC_NETIF_PKTQ
+#include "net/gnrc/netif/pktq.h"
+#endif
+#ifdef MODULE_GNRC_NETIF_SHARED
+#include "net/gnrc/netif/shared.h"
+#endif
 #include "net/ndp.h"
 #include "net/netdev.h"
 #include "rmutex.h"
@@ -94,6 +120,47 @@ typedef struct {
 #endif
 #if defined(MODULE_GNRC_SIXLOWPAN) || DOXYGEN
     gnrc_netif_6lo_t sixlo;                 /**< 6Lo component */
+#endif
+#if defined(MODULE_GNRC_NETIF_PKTQ) || DOXYGEN
+    gnrc_netif_pktq_t send_queue;           /**< @ref net_gnrc_netif_pktq */
+#endif
+#if defined(MODULE_GNRC_NETIF_SHARED) || DOXYGEN
+    gnrc_netif_shared_t shared;             /**< @ref net_gnrc_netif_shared */
+#endif
+#if defined(MODULE_GNRC_NETIF_CSUM_OFFLOAD) || DOXYGEN
+    /**
+     * @brief   Checksums the device calculates, see @ref NETOPT_CSUM_OFFLOAD_TX
+     *
+     * @note    Only available with module `gnrc_netif_csum_offload`
+     */
+    uint8_t csum_offload_tx;
+    /**
+     * @brief   Checksums the device verifies, see @ref NETOPT_CSUM_OFFLOAD_RX
+     *
+     * @note    Only available with module `gnrc_netif_csum_offload`
+     */
+    uint8_t csum_offload_rx;
+#endif
+#if defined(MODULE_GNRC_NETIF_POLL) || DOXYGEN
+    /**
+     * @brief   Frames received by the current call to the driver's `isr()`
+     *
+     * @note    Only available with module `gnrc_netif_poll`
+     */
+    uint8_t poll_rx;
+    /**
+     * @brief   The interface polls its device, interrupts only set
+     *          gnrc_netif_t::poll_irq
+     *
+     * @note    Only available with module `gnrc_netif_poll`
+     */
+    volatile bool polling;
+    /**
+     * @brief   The device interrupted while the interface was polling
+     *
+     * @note    Only available with module `gnrc_netif_poll`
+     */
+    volatile bool poll_irq;
 #endif
     uint8_t cur_hl;                         /**< Current hop-limit for out-going packets */
     uint8_t device_type;                    /**< Device type */
@@ -208,6 +275,9 @@ struct gnrc_netif_ops {
  * @brief   Creates a network interface
  *
  * @param[in] stack     The stack for the network interface's thread.
+ *                      With the `gnrc_netif_shared` module NULL adds the
+ *                      interface to the shared thread instead, see
+ *                      @ref net_gnrc_netif_shared.
  * @param[in] stacksize Size of @p stack.
  * @param[in] priority  Priority for the network interface's thread.
  * @param[in] name      Name for the network interface. May be NULL.
@@ -254,6 +324,47 @@ gnrc_netif_t *gnrc_netif_iter(const gnrc_netif_t *prev);
  */
 gnrc_netif_t *gnrc_netif_get_by_pid(kernel_pid_t pid);
 
+/**
+ * @brief   Checks whether the device of an interface calculates a checksum
+ *
+ * @param[in] netif A network interface. May be NULL.
+ * @param[in] csum  One of the @ref netopt_csum_offload_t values.
+ *
+ * @return  true, if the checksum is left to the device.
+ */
+static inline bool gnrc_netif_csum_offload_tx(const gnrc_netif_t *netif,
+                                              unsigned csum)
+{
+#ifdef MODULE_GNRC_NETIF_CSUM_OFFLOAD
+    return (netif != NULL) && (netif->csum_offload_tx & csum);
+#else
+    (void)netif;
+    (void)csum;
+    return false;
+#endif
+}
+
+/**
+ * @brief   Checks whether the device a packet was received with verified a
+ *          checksum
+ *
+ * @param[in] pkt   A received packet or a snip of it, in receive order.
+ * @param[in] csum  One of the @ref netopt_csum_offload_t values.
+ *
+ * @return  true, if the checksum of @p pkt was verified in hardware.
+ */
+#if defined(MODULE_GNRC_NETIF_CSUM_OFFLOAD) || DOXYGEN
+bool gnrc_netif_csum_offload_rx(gnrc_pktsnip_t *pkt, unsigned csum);
+#else
+static inline bool gnrc_netif_csum_offload_rx(gnrc_pktsnip_t *pkt,
+                                              unsigned csum)
+{
+    (void)pkt;
+    (void)csum;
+    return false;
+}
+#endif
+
 /**
  * @brief   Gets the (unicast on anycast) IPv6 addresss of an interface (if IPv6
  *          is supported)
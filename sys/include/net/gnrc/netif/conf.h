@@ -32,7 +32,13 @@ extern "C" {
  *
  * @note    Intentionally not calling it `GNRC_NETIF_NUMOF` to not require
  *          rewrites throughout the stack.
+ *
+ * Always 1 with the `gnrc_netif_single` pseudomodule.
  */
+#if defined(MODULE_GNRC_NETIF_SINGLE) && defined(GNRC_NETIF_NUMOF) && \
+    (GNRC_NETIF_NUMOF != 1)
+#error "gnrc_netif_single requires GNRC_NETIF_NUMOF == 1"
+#endif
 #ifndef GNRC_NETIF_NUMOF
 #define GNRC_NETIF_NUMOF            (1)
 #endif
@@ -120,6 +126,14 @@ extern "C" {
 #endif
 #endif
 
+/**
+ * @brief   Maximum number of frames an interface receives in one round of
+ *          polling with module `gnrc_netif_poll`
+ */
+#ifndef GNRC_NETIF_POLL_BUDGET
+#define GNRC_NETIF_POLL_BUDGET     (8U)
+#endif
+
 #ifndef GNRC_NETIF_DEFAULT_HL
 #define GNRC_NETIF_DEFAULT_HL      (64U)   /**< default hop limit */
 #endif
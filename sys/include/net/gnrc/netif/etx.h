@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_etx ETX estimation
+ * @ingroup     net_gnrc_netif
+ * @brief       Estimates the expected transmission count of neighbors
+ *
+ * With the `gnrc_netif_etx` module the network interfaces keep track of the
+ * transmissions needed for unicast frames to a neighbor. For every frame
+ * the number of transmissions is taken from the TX status of the device (link
+ * layer retransmissions via @ref NETOPT_TX_RETRIES_NEEDED on
+ * @ref NETDEV_EVENT_TX_COMPLETE, @ref GNRC_NETIF_ETX_NOACK_PENALTY on
+ * @ref NETDEV_EVENT_TX_NOACK) and smoothed with an exponentially weighted
+ * moving average.
+ *
+ * The estimator requires the device to report the end of transmissions, so
+ * @ref NETOPT_TX_END_IRQ is enabled on all interfaces with this module.
+ *
+ * With @ref net_gnrc_ipv6_nib the acknowledged frames also confirm the
+ * reachability of the neighbor to the neighbor unreachability detection (see
+ * gnrc_ipv6_nib_nc_mark_reachable_l2()), so it does not need to probe
+ * neighbors that are sent to regularly.
+ *
+ * @{
+ *
+ * @file
+ * @brief       ETX estimation definitions
+ */
+#ifndef NET_GNRC_NETIF_ETX_H
+#define NET_GNRC_NETIF_ETX_H
+
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+#include "net/netdev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Fixed point divisor of ETX values
+ *
+ * Same as the ETX metric object of RFC 6551, so an ETX of 1 is 128.
+ */
+#define GNRC_NETIF_ETX_DIVISOR          (128U)
+
+/**
+ * @brief   Number of neighbors to keep estimates for
+ */
+#ifndef GNRC_NETIF_ETX_NUMOF
+#define GNRC_NETIF_ETX_NUMOF            (8U)
+#endif
+
+/**
+ * @brief   ETX of neighbors without estimate (times @ref
+ *          GNRC_NETIF_ETX_DIVISOR)
+ */
+#ifndef GNRC_NETIF_ETX_INIT
+#define GNRC_NETIF_ETX_INIT             (2U * GNRC_NETIF_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   Weight in percent of the current estimate for a new sample
+ */
+#ifndef GNRC_NETIF_ETX_ALPHA
+#define GNRC_NETIF_ETX_ALPHA            (90U)
+#endif
+
+/**
+ * @brief   Number of transmissions accounted for an unacknowledged frame
+ */
+#ifndef GNRC_NETIF_ETX_NOACK_PENALTY
+#define GNRC_NETIF_ETX_NOACK_PENALTY    (8U)
+#endif
+
+/**
+ * @brief   Notes the destination of a frame that is about to be sent
+ *
+ * @note    Called by the interface's thread only.
+ *
+ * @param[in] pid   PID of the interface.
+ * @param[in] pkt   The packet, starting with its @ref net_gnrc_netif_hdr.
+ */
+void gnrc_netif_etx_sending(kernel_pid_t pid, const gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Accounts the TX status of the last frame sent
+ *
+ * @note    Called by the interface's thread only.
+ *
+ * @param[in] pid       PID of the interface.
+ * @param[in] event     The netdev event.
+ * @param[in] retries   Link layer retransmissions of the frame.
+ */
+void gnrc_netif_etx_tx_done(kernel_pid_t pid, netdev_event_t event,
+                            unsigned retries);
+
+/**
+ * @brief   Gets the ETX of a neighbor
+ *
+ * @param[in] pid           PID of the interface to the neighbor.
+ * @param[in] l2addr        Link layer address of the neighbor.
+ * @param[in] l2addr_len    Length of @p l2addr.
+ *
+ * @return  ETX times @ref GNRC_NETIF_ETX_DIVISOR.
+ * @return  @ref GNRC_NETIF_ETX_INIT, if there is no estimate for the neighbor.
+ */
+uint16_t gnrc_netif_etx_get(kernel_pid_t pid, const uint8_t *l2addr,
+                            unsigned l2addr_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_ETX_H */
+/** @} */
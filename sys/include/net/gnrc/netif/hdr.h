@@ -88,6 +88,28 @@ extern "C" {
  *          @ref IEEE802154_FCF_FRAME_PEND
  */
 #define GNRC_NETIF_HDR_FLAGS_MORE_DATA  (0x10)
+
+/**
+ * @brief   Mask of the send priority of the packet
+ *
+ * @details One of the GNRC_NETIF_HDR_PRIO_* values. Interfaces with the
+ *          @ref net_gnrc_netif_pktq send packets of a higher priority first.
+ *          @ref net_gnrc_ipv6 derives them from the IPv6 traffic class, if a
+ *          higher layer did not set them.
+ */
+#define GNRC_NETIF_HDR_FLAGS_PRIO_MASK  (0x03)
+/**
+ * @}
+ */
+
+/**
+ * @{
+ * @name    Send priorities in @ref GNRC_NETIF_HDR_FLAGS_PRIO_MASK
+ */
+#define GNRC_NETIF_HDR_PRIO_BEST_EFFORT (0x00)  /**< default */
+#define GNRC_NETIF_HDR_PRIO_BULK        (0x01)  /**< background traffic */
+#define GNRC_NETIF_HDR_PRIO_EXPEDITED   (0x02)  /**< alarms, real-time data */
+#define GNRC_NETIF_HDR_PRIO_CONTROL     (0x03)  /**< network control */
 /**
  * @}
  */
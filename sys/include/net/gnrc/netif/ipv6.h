@@ -68,6 +68,15 @@ extern "C" {
  * @brief   Address is an anycast address
  */
 #define GNRC_NETIF_IPV6_ADDRS_FLAGS_ANYCAST                (0x20U)
+
+/**
+ * @brief   Address may be used while still tentative
+ *
+ * An optimistic address (see [RFC 4429](https://tools.ietf.org/html/rfc4429))
+ * is a source address candidate before its duplicate address detection or
+ * registration finished.
+ */
+#define GNRC_NETIF_IPV6_ADDRS_FLAGS_OPTIMISTIC             (0x40U)
 /** @} */
 
 /**
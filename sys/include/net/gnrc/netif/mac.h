@@ -45,7 +45,8 @@ extern "C" {
  */
 #define GNRC_NETIF_MAC_INFO_CSMA_ENABLED       (0x0100U)
 
-#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH)
+#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH) || \
+    defined(MODULE_GNRC_TSCH)
 /**
  * @brief Data type to hold MAC protocols
  */
@@ -63,6 +64,13 @@ typedef union {
      */
     gnrc_gomach_t gomach;
 #endif
+
+#ifdef MODULE_GNRC_TSCH
+    /**
+     * @brief TSCH specific structure object for storing TSCH internal states.
+     */
+    gnrc_tsch_t tsch;
+#endif
 } gnrc_mac_prot_t;
 #endif
 
@@ -101,7 +109,8 @@ typedef struct {
     gnrc_mac_tx_t tx;
 #endif  /* ((GNRC_MAC_TX_QUEUE_SIZE != 0) || (GNRC_MAC_NEIGHBOR_COUNT == 0)) || DOXYGEN */
 
-#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH)
+#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH) || \
+    defined(MODULE_GNRC_TSCH)
     gnrc_mac_prot_t prot;
 #endif
 } gnrc_netif_mac_t;
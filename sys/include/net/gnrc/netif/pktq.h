@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_pktq Send queue
+ * @ingroup     net_gnrc_netif
+ * @brief       Priority queue for packets to send over a network interface
+ *
+ * With the `gnrc_netif_pktq` module every network interface queues the
+ * packets it is given to send, instead of handing them to the device in the
+ * order their messages arrived. The interface first takes all pending
+ * messages from its message queue, so a burst of packets is sorted into the
+ * queue before the first of them is sent, and then sends the queued packets
+ * by priority. If the device reports `-EBUSY`, the packet stays at the head
+ * of the queue until the device signals the end of a transmission or
+ * @ref GNRC_NETIF_PKTQ_RETRY_US passed.
+ *
+ * The priority of a packet is taken from the
+ * @ref GNRC_NETIF_HDR_FLAGS_PRIO_MASK bits of its @ref net_gnrc_netif_hdr.
+ * @ref net_gnrc_ipv6 sets them from the DSCP of the traffic class of the
+ * IPv6 header, unless a higher layer already did (see
+ * gnrc_netif_pktq_ipv6_prio()):
+ *
+ * | Priority                          | DSCP                       |
+ * |-----------------------------------|----------------------------|
+ * | @ref GNRC_NETIF_HDR_PRIO_CONTROL  | CS6, CS7, ICMPv6 with DSCP 0 |
+ * | @ref GNRC_NETIF_HDR_PRIO_EXPEDITED| CS4, AF4x, CS5, EF         |
+ * | @ref GNRC_NETIF_HDR_PRIO_BEST_EFFORT | all others              |
+ * | @ref GNRC_NETIF_HDR_PRIO_BULK     | LE, CS1                    |
+ *
+ * Every priority may take up @ref GNRC_NETIF_PKTQ_LIMITS entries of the
+ * @ref GNRC_NETIF_PKTQ_SIZE entries of the queue. If the queue is full, a
+ * packet pushes the last packet of a lower priority out. Higher layers can
+ * check with gnrc_netif_pktq_full() whether a packet would be dropped, so
+ * @ref net_gnrc_sock returns `-EAGAIN` instead of sending it.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Send queue definitions
+ */
+#ifndef NET_GNRC_NETIF_PKTQ_H
+#define NET_GNRC_NETIF_PKTQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "msg.h"
+#include "xtimer.h"
+#include "net/ipv6/hdr.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/priority_pktqueue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of packets an interface can queue
+ */
+#ifndef GNRC_NETIF_PKTQ_SIZE
+#define GNRC_NETIF_PKTQ_SIZE            (8U)
+#endif
+
+/**
+ * @brief   Maximum number of packets per priority
+ *
+ * In order of the GNRC_NETIF_HDR_PRIO_* values: best effort, bulk,
+ * expedited and control.
+ */
+#ifndef GNRC_NETIF_PKTQ_LIMITS
+#define GNRC_NETIF_PKTQ_LIMITS          { 6U, 2U, 4U, 8U }
+#endif
+
+/**
+ * @brief   Time after which a packet the device was too busy for is sent
+ *          again, if the device did not report the end of a transmission
+ */
+#ifndef GNRC_NETIF_PKTQ_RETRY_US
+#define GNRC_NETIF_PKTQ_RETRY_US        (5000U)
+#endif
+
+/**
+ * @brief   Message type to send the queued packets
+ */
+#define GNRC_NETIF_PKTQ_DEQUEUE_MSG     (0x1235)
+
+/**
+ * @brief   Number of priorities
+ */
+#define GNRC_NETIF_PKTQ_PRIO_NUMOF      (4U)
+
+/**
+ * @brief   Send queue of an interface
+ */
+typedef struct {
+    gnrc_priority_pktqueue_t queue;     /**< queued packets */
+    /**
+     * @brief   Entries of gnrc_netif_pktq_t::queue
+     */
+    gnrc_priority_pktqueue_node_t nodes[GNRC_NETIF_PKTQ_SIZE];
+    xtimer_t timer;                     /**< retry timer */
+    msg_t msg;                          /**< message of
+                                         *   gnrc_netif_pktq_t::timer */
+    uint8_t len[GNRC_NETIF_PKTQ_PRIO_NUMOF];        /**< queued packets per
+                                                     *   priority */
+    uint16_t dropped[GNRC_NETIF_PKTQ_PRIO_NUMOF];   /**< dropped packets per
+                                                     *   priority */
+} gnrc_netif_pktq_t;
+
+/**
+ * @brief   Initializes a send queue
+ *
+ * @param[out] q    send queue
+ */
+void gnrc_netif_pktq_init(gnrc_netif_pktq_t *q);
+
+/**
+ * @brief   Gets the priority of an IPv6 packet
+ *
+ * @param[in] hdr   header of the packet
+ *
+ * @return  One of the GNRC_NETIF_HDR_PRIO_* values
+ */
+unsigned gnrc_netif_pktq_ipv6_prio(const ipv6_hdr_t *hdr);
+
+/**
+ * @brief   Checks whether a packet of a priority would be dropped
+ *
+ * @param[in] q     send queue
+ * @param[in] prio  one of the GNRC_NETIF_HDR_PRIO_* values
+ *
+ * @return  true, if the priority is at its limit or the queue is full of
+ *          packets of at least @p prio
+ */
+bool gnrc_netif_pktq_full(const gnrc_netif_pktq_t *q, unsigned prio);
+
+/**
+ * @brief   Queues a packet
+ *
+ * @param[in] q     send queue
+ * @param[in] pkt   packet starting with a @ref net_gnrc_netif_hdr
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS if the packet's priority is at its limit or the queue is
+ *          full of packets of at least its priority. The packet is not
+ *          released.
+ */
+int gnrc_netif_pktq_put(gnrc_netif_pktq_t *q, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Gets the packet to send next without removing it
+ *
+ * @param[in] q     send queue
+ *
+ * @return  The packet of the highest priority queued first, NULL if
+ *          @p q is empty
+ */
+gnrc_pktsnip_t *gnrc_netif_pktq_head(gnrc_netif_pktq_t *q);
+
+/**
+ * @brief   Removes the packet gnrc_netif_pktq_head() returns
+ *
+ * @param[in] q     send queue
+ *
+ * @return  The packet, NULL if @p q is empty
+ */
+gnrc_pktsnip_t *gnrc_netif_pktq_get(gnrc_netif_pktq_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_PKTQ_H */
+/** @} */
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_shared Shared interface thread
+ * @ingroup     net_gnrc_netif
+ * @brief       Several network interfaces driven by one thread
+ *
+ * With the `gnrc_netif_shared` module, gnrc_netif_create() called with
+ * `stack == NULL` does not start a thread for the interface, but adds it to
+ * one thread shared by all such interfaces. This saves a stack and a
+ * message queue per interface on devices with several of them, and the
+ * context switches between the interface threads.
+ *
+ * The shared thread runs an @ref sys_event queue: the device interrupt,
+ * packets to send and option requests of an interface are events, handled
+ * one after the other in the order they were posted. A pending interrupt
+ * can't get lost, the driver's `isr()` handles all interrupts that came in
+ * until it runs.
+ *
+ * The interfaces keep their own PIDs, which are not threads, but are
+ * reserved for them after the highest thread PID, so @ref net_gnrc_netapi
+ * works with them as with any interface: gnrc_netapi_send() queues the
+ * packet for the interface and gnrc_netapi_get() and gnrc_netapi_set() wait
+ * for the shared thread to handle the request. Messages beyond those of
+ * netapi can't be sent to them, so interfaces with a
+ * gnrc_netif_ops_t::msg_handler, e.g. of @ref net_gnrc_mac, and
+ * @ref net_gnrc_netif_pktq need a thread of their own.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Shared interface thread definitions
+ */
+#ifndef NET_GNRC_NETIF_SHARED_H
+#define NET_GNRC_NETIF_SHARED_H
+
+#include <stdbool.h>
+
+#include "cib.h"
+#include "event.h"
+#include "kernel_types.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/conf.h"
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Stack size of the shared thread
+ */
+#ifndef GNRC_NETIF_SHARED_STACKSIZE
+#define GNRC_NETIF_SHARED_STACKSIZE     (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the shared thread
+ */
+#ifndef GNRC_NETIF_SHARED_PRIO
+#define GNRC_NETIF_SHARED_PRIO          (GNRC_NETIF_PRIO)
+#endif
+
+/**
+ * @brief   Number of packets an interface of the shared thread holds to be
+ *          sent, must be a power of two
+ */
+#ifndef GNRC_NETIF_SHARED_TX_QUEUE_SIZE
+#define GNRC_NETIF_SHARED_TX_QUEUE_SIZE (8U)
+#endif
+
+/**
+ * @brief   First PID reserved for the interfaces of the shared thread
+ */
+#define GNRC_NETIF_SHARED_PID_FIRST     (KERNEL_PID_LAST + 1)
+
+/**
+ * @brief   State of an interface in the shared thread
+ */
+typedef struct {
+    event_t isr;                /**< posted by the device's interrupt */
+    event_t tx;                 /**< posted for packets to send */
+    cib_t tx_cib;               /**< index of gnrc_netif_shared_t::tx_queue */
+    /**
+     * @brief   Packets to send
+     */
+    gnrc_pktsnip_t *tx_queue[GNRC_NETIF_SHARED_TX_QUEUE_SIZE];
+} gnrc_netif_shared_t;
+
+/**
+ * @brief   Checks whether a PID belongs to an interface of the shared thread
+ *
+ * @param[in] pid   a PID
+ *
+ * @return  true, if @p pid is one of an interface of the shared thread
+ */
+static inline bool gnrc_netif_shared_is(kernel_pid_t pid)
+{
+    return (pid >= GNRC_NETIF_SHARED_PID_FIRST) &&
+           (pid < (GNRC_NETIF_SHARED_PID_FIRST + GNRC_NETIF_NUMOF));
+}
+
+/**
+ * @brief   Queues a packet for an interface of the shared thread
+ *
+ * Used by gnrc_netapi_send(), same return values.
+ *
+ * @param[in] pid   PID of the interface, gnrc_netif_shared_is() is true
+ * @param[in] pkt   packet to send
+ *
+ * @return  1 if the packet was queued
+ * @return  0 if the queue is full
+ * @return  -1 if there is no such interface
+ */
+int gnrc_netif_shared_send(kernel_pid_t pid, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Gets or sets an option of an interface of the shared thread
+ *
+ * Used by gnrc_netapi_get() and gnrc_netapi_set(), waits until the shared
+ * thread handled the request.
+ *
+ * @param[in] pid   PID of the interface, gnrc_netif_shared_is() is true
+ * @param[in] type  @ref GNRC_NETAPI_MSG_TYPE_GET or
+ *                  @ref GNRC_NETAPI_MSG_TYPE_SET
+ * @param[in] opt   the option
+ *
+ * @return  the result of gnrc_netif_ops_t::get() or gnrc_netif_ops_t::set()
+ * @return  -ENODEV if there is no such interface
+ */
+int gnrc_netif_shared_get_set(kernel_pid_t pid, uint16_t type,
+                              gnrc_netapi_opt_t *opt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_SHARED_H */
+/** @} */
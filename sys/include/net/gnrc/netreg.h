@@ -72,6 +72,21 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Number of buckets per @ref gnrc_nettype_t of the demux context
+ *          index
+ *
+ * With module `gnrc_netreg_hash` the registry keeps the entries of each type
+ * in @ref GNRC_NETREG_HASH_SIZE lists selected by a hash of
+ * gnrc_netreg_entry_t::demux_ctx, instead of in one list per type. Lookups,
+ * e.g. of the socket bound to a UDP port, then only need to search the
+ * entries that share a bucket. This requires
+ * `(GNRC_NETREG_HASH_SIZE - 1) * GNRC_NETTYPE_NUMOF` additional pointers.
+ */
+#ifndef GNRC_NETREG_HASH_SIZE
+#define GNRC_NETREG_HASH_SIZE       (8U)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -305,6 +320,9 @@ static inline void gnrc_netreg_entry_init_cb(gnrc_netreg_entry_t *entry,
  * @warning Call gnrc_netreg_unregister() *before* you leave the context you
  *          allocated @p entry in. Otherwise it might get overwritten.
  *
+ * @warning Do not change gnrc_netreg_entry_t::demux_ctx of @p entry while it
+ *          is registered.
+ *
  * @pre The calling thread must provide a [message queue](@ref msg_init_queue)
  *      when using @ref GNRC_NETREG_TYPE_DEFAULT for gnrc_netreg_entry_t::type
  *      of @p entry.
@@ -120,6 +120,29 @@ typedef struct gnrc_pktsnip {
     kernel_pid_t err_sub;           /**< subscriber to errors related to this
                                      *   packet snip */
 #endif
+#if defined(MODULE_GNRC_PKTTRACE) || defined(DOXYGEN)
+    /**
+     * @brief   Time of the last trace point, see @ref net_gnrc_pkttrace
+     *
+     * @internal
+     */
+    uint32_t trace_time;
+    /**
+     * @brief   Last trace point + 1, 0 if the snip is not traced
+     *
+     * @internal
+     */
+    uint8_t trace_point;
+#endif
+#if defined(MODULE_GNRC_PKTBUF_QUOTA) || defined(DOXYGEN)
+    /**
+     * @brief   Class the snip is accounted to, see
+     *          @ref gnrc_pktbuf_class_t
+     *
+     * @internal
+     */
+    uint8_t cls;
+#endif
 } gnrc_pktsnip_t;
 
 /**
@@ -58,6 +58,112 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @name    Size-class pools of the `gnrc_pktbuf_slab` module
+ *
+ * With `gnrc_pktbuf_slab` the static packet buffer serves packet snip
+ * descriptors and common payload sizes from fixed-size pools (based on
+ * @ref sys_memarray) in addition to the @ref GNRC_PKTBUF_SIZE arena. Requests
+ * that do not fit a class reasonably, or hit an exhausted class, fall back to
+ * the arena. Setting a number to 0 disables the respective class.
+ * @{
+ */
+#ifndef GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define GNRC_PKTBUF_SLAB_SNIP_NUMOF     (16)    /**< gnrc_pktsnip_t headers */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_32_NUMOF
+#define GNRC_PKTBUF_SLAB_32_NUMOF       (8)     /**< 32 byte chunks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_128_NUMOF
+#define GNRC_PKTBUF_SLAB_128_NUMOF      (4)     /**< 128 byte chunks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_256_NUMOF
+#define GNRC_PKTBUF_SLAB_256_NUMOF      (2)     /**< 256 byte chunks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_1280_NUMOF
+#define GNRC_PKTBUF_SLAB_1280_NUMOF     (2)     /**< 1280 byte chunks */
+#endif
+/** @} */
+
+/**
+ * @name    Quotas of the `gnrc_pktbuf_quota` module
+ *
+ * With `gnrc_pktbuf_quota` every snip of the static packet buffer is
+ * accounted to a @ref gnrc_pktbuf_class_t, with `sizeof(gnrc_pktsnip_t)`
+ * plus its size. An allocation is refused when it would take its class
+ * beyond the quota of the class, or, for all classes but
+ * @ref GNRC_PKTBUF_CLASS_CTRL, into the last
+ * @ref GNRC_PKTBUF_CTRL_RESERVE bytes of the buffer. So a burst of fragments
+ * being reassembled or a sock that is not read can't starve the others, and
+ * the control plane (NDP, RPL and all ICMPv6) still gets to send and process
+ * its messages when the buffer runs full. The quotas, in bytes, and the
+ * reserve can be changed at run-time with gnrc_pktbuf_set_quota() and
+ * gnrc_pktbuf_set_reserve().
+ * @{
+ */
+#ifndef GNRC_PKTBUF_QUOTA_OTHER
+#define GNRC_PKTBUF_QUOTA_OTHER     (GNRC_PKTBUF_SIZE)      /**< unclassified */
+#endif
+#ifndef GNRC_PKTBUF_QUOTA_RX
+#define GNRC_PKTBUF_QUOTA_RX        (GNRC_PKTBUF_SIZE / 2)  /**< received */
+#endif
+#ifndef GNRC_PKTBUF_QUOTA_REASS
+#define GNRC_PKTBUF_QUOTA_REASS     (GNRC_PKTBUF_SIZE / 2)  /**< reassembly */
+#endif
+#ifndef GNRC_PKTBUF_QUOTA_TX
+#define GNRC_PKTBUF_QUOTA_TX        (GNRC_PKTBUF_SIZE / 2)  /**< send queues */
+#endif
+#ifndef GNRC_PKTBUF_QUOTA_SOCK
+#define GNRC_PKTBUF_QUOTA_SOCK      (GNRC_PKTBUF_SIZE / 2)  /**< sock queues */
+#endif
+#ifndef GNRC_PKTBUF_QUOTA_CTRL
+#define GNRC_PKTBUF_QUOTA_CTRL      (GNRC_PKTBUF_SIZE)      /**< control plane */
+#endif
+/** @} */
+
+/**
+ * @brief   Bytes at the end of the packet buffer only
+ *          @ref GNRC_PKTBUF_CLASS_CTRL may use
+ *
+ * No space is reserved by default, so users of the whole buffer keep
+ * working. Nodes taking part in a mesh should reserve room for a few
+ * control messages, e.g. `GNRC_PKTBUF_SIZE / 8`.
+ */
+#ifndef GNRC_PKTBUF_CTRL_RESERVE
+#define GNRC_PKTBUF_CTRL_RESERVE    (0U)
+#endif
+
+/**
+ * @brief   Bytes besides a received frame a network interface requires to
+ *          be free to receive it, for the headers the stack adds while
+ *          parsing
+ *
+ * Frames that do not fit are dropped by the interface before they are read
+ * from the device.
+ */
+#ifndef GNRC_PKTBUF_RX_HEADROOM
+#define GNRC_PKTBUF_RX_HEADROOM     (4 * sizeof(gnrc_pktsnip_t))
+#endif
+
+/**
+ * @brief   Accounting classes of `gnrc_pktbuf_quota`
+ *
+ * A new snip is accounted to the class of the snip it is prepended to. A
+ * first snip of type GNRC_NETTYPE_ICMPV6 is accounted to
+ * @ref GNRC_PKTBUF_CLASS_CTRL, other first snips to
+ * @ref GNRC_PKTBUF_CLASS_OTHER, until the stack moves the packet to a class
+ * with gnrc_pktbuf_set_class().
+ */
+typedef enum {
+    GNRC_PKTBUF_CLASS_OTHER = 0,    /**< not classified */
+    GNRC_PKTBUF_CLASS_RX,           /**< received by a network interface */
+    GNRC_PKTBUF_CLASS_REASS,        /**< reassembly buffers */
+    GNRC_PKTBUF_CLASS_TX,           /**< send queues of the interfaces */
+    GNRC_PKTBUF_CLASS_SOCK,         /**< receive queues of socks */
+    GNRC_PKTBUF_CLASS_CTRL,         /**< control plane, may use the reserve */
+    GNRC_PKTBUF_CLASS_NUMOF,        /**< number of classes */
+} gnrc_pktbuf_class_t;
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -352,13 +458,93 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
  */
 int gnrc_pktbuf_merge(gnrc_pktsnip_t *pkt);
 
+#if defined(MODULE_GNRC_PKTBUF_QUOTA) || defined(DOXYGEN)
+/**
+ * @brief   Moves a packet to an accounting class
+ *
+ * All snips of @p pkt not accounted to @p cls yet are moved, also those
+ * shared with other packets. Snips of @ref GNRC_PKTBUF_CLASS_CTRL keep their
+ * class, so control traffic does not count against the quotas of the queues
+ * it passes.
+ *
+ * @param[in] pkt   a packet
+ * @param[in] cls   its new class
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS if the snips would exceed the quota of @p cls, @p pkt
+ *          is left unchanged then
+ */
+int gnrc_pktbuf_set_class(gnrc_pktsnip_t *pkt, gnrc_pktbuf_class_t cls);
+
+/**
+ * @brief   Checks if a snip fits the quota of a class and the buffer
+ *
+ * Used to drop packets before spending any work on them, the space is not
+ * reserved.
+ *
+ * @param[in] cls   a class
+ * @param[in] size  size of a snip
+ *
+ * @return  true if a snip of @p size could be allocated for @p cls
+ */
+bool gnrc_pktbuf_admit(gnrc_pktbuf_class_t cls, size_t size);
+
+/**
+ * @brief   Sets the quota of a class
+ *
+ * Snips accounted to @p cls are kept when it is exceeded.
+ *
+ * @param[in] cls       a class
+ * @param[in] quota     its quota in bytes
+ */
+void gnrc_pktbuf_set_quota(gnrc_pktbuf_class_t cls, size_t quota);
+
+/**
+ * @brief   Sets the bytes reserved for @ref GNRC_PKTBUF_CLASS_CTRL
+ *
+ * Snips allocated in the reserve already are kept.
+ *
+ * @param[in] reserve   the reserve in bytes, initially
+ *                      @ref GNRC_PKTBUF_CTRL_RESERVE
+ */
+void gnrc_pktbuf_set_reserve(size_t reserve);
+
+/**
+ * @brief   Gets the bytes accounted to a class
+ *
+ * @param[in] cls   a class
+ *
+ * @return  the bytes accounted to @p cls
+ */
+size_t gnrc_pktbuf_usage(gnrc_pktbuf_class_t cls);
+#else
+static inline int gnrc_pktbuf_set_class(gnrc_pktsnip_t *pkt,
+                                        gnrc_pktbuf_class_t cls)
+{
+    (void)pkt;
+    (void)cls;
+    return 0;
+}
+
+static inline bool gnrc_pktbuf_admit(gnrc_pktbuf_class_t cls, size_t size)
+{
+    (void)cls;
+    (void)size;
+    return true;
+}
+#endif
+
 #ifdef DEVELHELP
 /**
  * @brief   Prints some statistics about the packet buffer to stdout.
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes. With
+ *          `gnrc_pktbuf_slab` the current and maximum number of used chunks
+ *          of each size class is reported as well, with `gnrc_pktbuf_quota`
+ *          the usage, peak usage and refused allocations of each accounting
+ *          class.
  */
 void gnrc_pktbuf_stats(void);
 #endif
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktcap Packet capture
+ * @ingroup     net_gnrc
+ * @brief       Ring of the frames sent and received by the network
+ *              interfaces, exported as pcapng
+ *
+ * Unlike @ref net_gnrc_pktdump, which formats every packet as text while
+ * it passes, the `gnrc_pktcap` module only copies the first
+ * @ref GNRC_PKTCAP_SNAPLEN bytes of each frame with a time stamp into a
+ * ring of @ref GNRC_PKTCAP_NUMOF records in RAM, overwriting the oldest
+ * ones when full. That costs a bounded copy with interrupts disabled per
+ * frame, so it can stay enabled under load.
+ *
+ * Frames are captured as they are handed to and read from the device, with
+ * their link layer header, by the Ethernet and IEEE 802.15.4 interfaces.
+ * gnrc_pktcap_filter() restricts capturing to an EtherType and a UDP or TCP
+ * port. IEEE 802.15.4 frames count as @ref ETHERTYPE_IPV6; their ports are
+ * compressed, so a port filter only matches uncompressed IPv6, i.e. on
+ * Ethernet.
+ *
+ * gnrc_pktcap_read() reads the ring as a pcapng file at any offset: with one
+ * interface description block per network interface, in the order of
+ * gnrc_netif_iter(), and the direction of each frame in its flags. Its
+ * signature is that of @ref coap_block_read_t, so a CoAP resource serves it
+ * with coap_block2_reply_stream(). The `pktcap` shell command writes it to a
+ * file (with the `vfs` module) or as hex to stdio, which `xxd -r -p` turns
+ * back into the pcapng file. Disable capturing while exporting, or the
+ * ring changes in between reads.
+ *
+ * Without the module the capture points compile to nothing.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Packet capture definitions
+ */
+#ifndef NET_GNRC_PKTCAP_H
+#define NET_GNRC_PKTCAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "iolist.h"
+#include "net/gnrc/netif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of frames kept
+ */
+#ifndef GNRC_PKTCAP_NUMOF
+#define GNRC_PKTCAP_NUMOF           (16U)
+#endif
+
+/**
+ * @brief   Number of bytes kept of each frame, at most 255
+ */
+#ifndef GNRC_PKTCAP_SNAPLEN
+#define GNRC_PKTCAP_SNAPLEN         (64U)
+#endif
+
+/**
+ * @brief   Capture statistics
+ */
+typedef struct {
+    uint32_t captured;      /**< frames captured */
+    uint32_t filtered;      /**< frames not matching the filter */
+    uint32_t overwritten;   /**< captured frames overwritten by newer ones */
+} gnrc_pktcap_stats_t;
+
+#if defined(MODULE_GNRC_PKTCAP) || defined(DOXYGEN)
+/**
+ * @brief   Captures a frame (called by the network interfaces)
+ *
+ * @param[in] netif the interface sending or receiving @p frame
+ * @param[in] frame the frame, starting with its link layer header
+ * @param[in] tx    true if @p frame is sent
+ */
+void gnrc_pktcap_frame(const gnrc_netif_t *netif, const iolist_t *frame,
+                       bool tx);
+
+/**
+ * @brief   Enables or disables capturing
+ *
+ * Capturing is enabled initially.
+ *
+ * @param[in] enable    true to capture frames
+ */
+void gnrc_pktcap_enable(bool enable);
+
+/**
+ * @brief   Sets the filter
+ *
+ * @param[in] ethertype EtherType to capture, 0 for all
+ * @param[in] port      UDP or TCP source or destination port to capture, 0
+ *                      for all
+ */
+void gnrc_pktcap_filter(uint16_t ethertype, uint16_t port);
+
+/**
+ * @brief   Drops all captured frames and clears the statistics
+ */
+void gnrc_pktcap_clear(void);
+
+/**
+ * @brief   Gets the statistics
+ *
+ * @param[out] stats    the statistics
+ */
+void gnrc_pktcap_stats(gnrc_pktcap_stats_t *stats);
+
+/**
+ * @brief   Reads the captured frames as pcapng file
+ *
+ * @param[in] arg       unused, for use as @ref coap_block_read_t
+ * @param[in] offset    offset in the file
+ * @param[out] buf      buffer to read to
+ * @param[in] len       size of @p buf
+ *
+ * @return  number of bytes read, less than @p len at the end of the file
+ */
+ssize_t gnrc_pktcap_read(void *arg, size_t offset, void *buf, size_t len);
+#else
+static inline void gnrc_pktcap_frame(const gnrc_netif_t *netif,
+                                     const iolist_t *frame, bool tx)
+{
+    (void)netif;
+    (void)frame;
+    (void)tx;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTCAP_H */
+/** @} */
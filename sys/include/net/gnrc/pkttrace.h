@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pkttrace Packet latency tracing
+ * @ingroup     net_gnrc
+ * @brief       Per-layer latency histograms of the packets passing GNRC
+ *
+ * With the `gnrc_pkttrace` module each packet is stamped when it enters the
+ * stack, i.e. when the network interface starts reading it from the device
+ * or when @ref net_gnrc_sock builds it. Every layer it passes then records
+ * the time since the previous layer stamped it into the histogram of its
+ * trace point (see @ref gnrc_pkttrace_point_t) and stamps it anew, so a
+ * histogram holds the latency of reaching that layer from the one before:
+ * the netif and netdev points show the time the device driver takes, the
+ * others mostly the time the packet waited in message queues.
+ *
+ * The stamp is kept in the snip of the packet that survives all layers, the
+ * payload. Packets assembled anew on the way, e.g. reassembled or
+ * fragmented by @ref net_gnrc_sixlowpan_frag, lose it and are not traced
+ * any further.
+ *
+ * The histograms have @ref GNRC_PKTTRACE_BUCKETS logarithmic buckets of
+ * microseconds. The `pkttrace` shell command prints them;
+ * gnrc_pkttrace_get() provides them for export, e.g. over CoAP.
+ *
+ * Without the module the trace points compile to nothing.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Packet latency tracing definitions
+ */
+#ifndef NET_GNRC_PKTTRACE_H
+#define NET_GNRC_PKTTRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of buckets of a histogram
+ *
+ * Bucket 0 counts latencies below 2 µs, bucket i > 0 latencies from 2^i µs
+ * to 2^(i + 1) - 1 µs, and the last bucket all longer ones.
+ */
+#ifndef GNRC_PKTTRACE_BUCKETS
+#define GNRC_PKTTRACE_BUCKETS       (16U)
+#endif
+
+/**
+ * @brief   Trace points
+ */
+typedef enum {
+    GNRC_PKTTRACE_RX_NETDEV = 0,    /**< device reported a frame (start) */
+    GNRC_PKTTRACE_RX_NETIF,         /**< frame read from the device */
+    GNRC_PKTTRACE_RX_SIXLOWPAN,     /**< 6LoWPAN got the frame */
+    GNRC_PKTTRACE_RX_IPHC,          /**< 6LoWPAN decompressed the header */
+    GNRC_PKTTRACE_RX_IPV6,          /**< IPv6 got the packet */
+    GNRC_PKTTRACE_RX_UDP,           /**< UDP got the packet */
+    GNRC_PKTTRACE_RX_SOCK,          /**< packet delivered to a sock */
+    GNRC_PKTTRACE_TX_SOCK,          /**< sock built the packet (start) */
+    GNRC_PKTTRACE_TX_UDP,           /**< UDP got the packet */
+    GNRC_PKTTRACE_TX_IPV6,          /**< IPv6 got the packet */
+    GNRC_PKTTRACE_TX_SIXLOWPAN,     /**< 6LoWPAN got the packet */
+    GNRC_PKTTRACE_TX_IPHC,          /**< 6LoWPAN compressed the header */
+    GNRC_PKTTRACE_TX_NETIF,         /**< network interface got the packet */
+    GNRC_PKTTRACE_TX_NETDEV,        /**< device driver sent the packet */
+    GNRC_PKTTRACE_NUMOF,            /**< number of trace points */
+} gnrc_pkttrace_point_t;
+
+/**
+ * @brief   Latency histogram of a trace point
+ */
+typedef struct {
+    uint32_t buckets[GNRC_PKTTRACE_BUCKETS];    /**< packets per bucket */
+    uint32_t sum;                   /**< sum of all latencies in µs */
+    uint32_t max;                   /**< longest latency in µs */
+} gnrc_pkttrace_hist_t;
+
+#if defined(MODULE_GNRC_PKTTRACE) || defined(DOXYGEN)
+/**
+ * @brief   Stamps a packet entering the stack
+ *
+ * @param[in] pkt   the payload snip of the packet, it is stamped
+ * @param[in] point @ref GNRC_PKTTRACE_RX_NETDEV or
+ *                  @ref GNRC_PKTTRACE_TX_SOCK
+ * @param[in] time  time the packet entered in µs, see xtimer_now_usec()
+ */
+void gnrc_pkttrace_start(gnrc_pktsnip_t *pkt, gnrc_pkttrace_point_t point,
+                         uint32_t time);
+
+/**
+ * @brief   Records the latency since the previous trace point of a packet
+ *
+ * Does nothing if no snip of @p pkt is stamped.
+ *
+ * @param[in] pkt   the packet
+ * @param[in] point the trace point reached
+ */
+void gnrc_pkttrace(gnrc_pktsnip_t *pkt, gnrc_pkttrace_point_t point);
+
+/**
+ * @brief   Gets the time of the last trace point of a packet
+ *
+ * For trace points after which the packet is gone, e.g. sent by the device
+ * driver: the caller measures the latency and adds it with
+ * gnrc_pkttrace_record().
+ *
+ * @param[in] pkt   the packet
+ * @param[out] time time of the last trace point in µs
+ *
+ * @return  true, if a snip of @p pkt is stamped
+ */
+bool gnrc_pkttrace_time(const gnrc_pktsnip_t *pkt, uint32_t *time);
+
+/**
+ * @brief   Adds a latency to the histogram of a trace point
+ *
+ * @param[in] point     the trace point
+ * @param[in] latency   the latency in µs
+ */
+void gnrc_pkttrace_record(gnrc_pkttrace_point_t point, uint32_t latency);
+
+/**
+ * @brief   Gets the histogram of a trace point
+ *
+ * @param[in] point     a trace point
+ * @param[out] hist     the histogram
+ */
+void gnrc_pkttrace_get(gnrc_pkttrace_point_t point,
+                       gnrc_pkttrace_hist_t *hist);
+
+/**
+ * @brief   Gets the name of a trace point
+ *
+ * @param[in] point     a trace point
+ *
+ * @return  the name, e.g. "rx_ipv6"
+ */
+const char *gnrc_pkttrace_point_str(gnrc_pkttrace_point_t point);
+
+/**
+ * @brief   Clears all histograms
+ */
+void gnrc_pkttrace_reset(void);
+
+/**
+ * @brief   Prints all histograms that counted packets
+ */
+void gnrc_pkttrace_print(void);
+#else
+static inline void gnrc_pkttrace_start(gnrc_pktsnip_t *pkt,
+                                       gnrc_pkttrace_point_t point,
+                                       uint32_t time)
+{
+    (void)pkt;
+    (void)point;
+    (void)time;
+}
+
+static inline void gnrc_pkttrace(gnrc_pktsnip_t *pkt,
+                                 gnrc_pkttrace_point_t point)
+{
+    (void)pkt;
+    (void)point;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTTRACE_H */
+/** @} */
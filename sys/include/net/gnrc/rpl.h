@@ -193,12 +193,44 @@ extern "C" {
 /**
  * @brief   Number of implemented Objective Functions
  */
+#if defined(MODULE_GNRC_RPL_MRHOF) || defined(DOXYGEN)
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (2)
+#else
 #define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#endif
 
 /**
  * @brief   Default Objective Code Point (OF0)
+ *
+ * Set to 1 to use MRHOF (module `gnrc_rpl_mrhof`) for DODAGs of this node.
  */
+#ifndef GNRC_RPL_DEFAULT_OCP
 #define GNRC_RPL_DEFAULT_OCP (0)
+#endif
+
+/**
+ * @name    MRHOF parameters
+ * @see     <a href="https://tools.ietf.org/html/rfc6719#section-5">
+ *              RFC 6719, section 5
+ *          </a>
+ *
+ * Metrics are ETX times @ref GNRC_NETIF_ETX_DIVISOR
+ * @{
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_LINK_METRIC
+/**
+ * @brief   Parents with a higher link ETX are not selected
+ */
+#define GNRC_RPL_MRHOF_MAX_LINK_METRIC          (512U)
+#endif
+#ifndef GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+/**
+ * @brief   ETX a parent needs to be better than the preferred parent to
+ *          replace it
+ */
+#define GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD  (192U)
+#endif
+/** @} */
 
 /**
  * @brief   Default Instance ID
@@ -349,6 +381,16 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
  */
 #define GNRC_RPL_DAO_DELAY_JITTER   (1000UL)
 #endif
+#ifndef GNRC_RPL_DAO_AGGREGATION_WINDOW
+/**
+ * @brief Window in milli seconds to collect DAO triggers in
+ *
+ * Target updates of children, DTSN increments and parent changes within this
+ * window (plus @ref GNRC_RPL_DAO_DELAY_JITTER) after the first of them are
+ * announced in a single DAO. Further triggers do not postpone the DAO.
+ */
+#define GNRC_RPL_DAO_AGGREGATION_WINDOW (1000UL)
+#endif
 /** @} */
 
 /**
@@ -612,6 +654,18 @@ void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag);
  */
 void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag);
 
+/**
+ * @brief   Schedule a DAO within the aggregation window
+ *
+ * Does nothing, if a DAO is already scheduled within the window, so all
+ * triggers until then are announced in one DAO.
+ *
+ * @see @ref GNRC_RPL_DAO_AGGREGATION_WINDOW
+ *
+ * @param[in] dodag     The DODAG of the DAO
+ */
+void gnrc_rpl_aggregate_dao(gnrc_rpl_dodag_t *dodag);
+
 /**
  * @brief Create a new RPL instance and RPL DODAG.
  *
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_routes RPL downward route store
+ * @ingroup     net_gnrc_rpl
+ * @brief       Compact storage for downward routes of RPL storing mode
+ *
+ * In storing mode, every target announced in a DAO becomes a host route. With
+ * this module, /128 targets are not stored as full forwarding table entries
+ * of the NIB, but as pair of an index into a small table of shared /64
+ * prefixes (typically only the DODAG prefix) and the 64-bit interface
+ * identifier of the target. Next hops (the children of the node) are
+ * referenced by index as well, so a route takes 16 byte of RAM.
+ *
+ * Routes of the store take precedence over the forwarding table of the NIB
+ * when resolving the next hop of a packet. Targets that do not fit the store
+ * (other prefix lengths or a full store) are added to the NIB as before.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the RPL downward route store
+ */
+#ifndef NET_GNRC_RPL_ROUTES_H
+#define NET_GNRC_RPL_ROUTES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of downward routes
+ */
+#ifndef GNRC_RPL_ROUTES_NUMOF
+#define GNRC_RPL_ROUTES_NUMOF           (64)
+#endif
+
+/**
+ * @brief   Maximum number of distinct /64 prefixes of the targets
+ */
+#ifndef GNRC_RPL_ROUTES_PREFIX_NUMOF
+#define GNRC_RPL_ROUTES_PREFIX_NUMOF    (2)
+#endif
+
+/**
+ * @brief   Maximum number of distinct next hops of the routes
+ *
+ * @note    Must not exceed 255.
+ */
+#ifndef GNRC_RPL_ROUTES_NEXT_HOP_NUMOF
+#define GNRC_RPL_ROUTES_NEXT_HOP_NUMOF  (16)
+#endif
+
+/**
+ * @brief   Adds or updates the route to a target
+ *
+ * @param[in] dst       Target address of the route.
+ * @param[in] next_hop  Next hop to @p dst.
+ * @param[in] iface     Interface to @p next_hop.
+ * @param[in] lifetime  Lifetime of the route in seconds. 0 for infinite
+ *                      lifetime.
+ *
+ * @return  0, on success.
+ * @return  -EINVAL, if a parameter was of invalid value.
+ * @return  -ENOMEM, if there was no space left in one of the tables.
+ */
+int gnrc_rpl_routes_add(const ipv6_addr_t *dst, const ipv6_addr_t *next_hop,
+                        unsigned iface, uint32_t lifetime);
+
+/**
+ * @brief   Deletes the route to a target
+ *
+ * @param[in] dst   Target address of the route.
+ */
+void gnrc_rpl_routes_del(const ipv6_addr_t *dst);
+
+/**
+ * @brief   Deletes all routes over an interface
+ *
+ * @param[in] iface     Interface of the routes. 0 for all interfaces.
+ */
+void gnrc_rpl_routes_flush(unsigned iface);
+
+/**
+ * @brief   Gets the route to a destination
+ *
+ * @param[in] dst   Destination address.
+ * @param[out] fte  Forwarding table entry for @p dst.
+ *
+ * @return  0, if a route to @p dst exists.
+ * @return  -ENETUNREACH, if there is no route to @p dst.
+ */
+int gnrc_rpl_routes_get(const ipv6_addr_t *dst, gnrc_ipv6_nib_ft_t *fte);
+
+/**
+ * @brief   Iterates over all routes
+ *
+ * @pre `(state != NULL) && (fte != NULL)`
+ *
+ * @param[in] iface     Restrict iteration to entries on this interface.
+ *                      0 for any interface.
+ * @param[in,out] state Iteration state. Must point to a NULL pointer before
+ *                      the first call.
+ * @param[out] fte      The next route.
+ *
+ * @return  true, if iteration can be continued.
+ * @return  false, if there are no more routes.
+ */
+bool gnrc_rpl_routes_iter(unsigned iface, void **state,
+                          gnrc_ipv6_nib_ft_t *fte);
+
+/**
+ * @brief   Gets the number of routes in the store
+ *
+ * @return  Number of routes.
+ */
+unsigned gnrc_rpl_routes_numof(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_ROUTES_H */
+/** @} */
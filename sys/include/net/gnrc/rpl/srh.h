@@ -65,6 +65,89 @@ typedef struct __attribute__((packed)) {
  */
 int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh);
 
+#if defined(MODULE_GNRC_RPL_SRH_ROOT) || defined(DOXYGEN)
+/**
+ * @name    Source route computation of non-storing roots
+ *
+ * A root of a non-storing DODAG keeps the DAO parent of every target in a
+ * graph and builds the source routing header of downward packets from it.
+ * Built headers are cached per destination, until the graph changes.
+ *
+ * @note    Only available with module `gnrc_rpl_srh_root`
+ * @{
+ */
+/**
+ * @brief   Maximum number of nodes in the DAO parent graph
+ */
+#ifndef GNRC_RPL_SRH_ROOT_NODES_NUMOF
+#define GNRC_RPL_SRH_ROOT_NODES_NUMOF   (32)
+#endif
+
+/**
+ * @brief   Maximum number of hops below the root
+ */
+#ifndef GNRC_RPL_SRH_ROOT_HOPS_MAX
+#define GNRC_RPL_SRH_ROOT_HOPS_MAX      (8)
+#endif
+
+/**
+ * @brief   Number of destinations to cache the source routing header for
+ */
+#ifndef GNRC_RPL_SRH_ROOT_CACHE_NUMOF
+#define GNRC_RPL_SRH_ROOT_CACHE_NUMOF   (4)
+#endif
+
+/**
+ * @brief   Maximum size of a source routing header built by the root
+ */
+#define GNRC_RPL_SRH_ROOT_SRH_MAX       (sizeof(gnrc_rpl_srh_t) + \
+                                         (GNRC_RPL_SRH_ROOT_HOPS_MAX * \
+                                          sizeof(ipv6_addr_t)))
+
+/**
+ * @brief   Sets the DAO parent of a target
+ *
+ * @param[in] target    A target of a DAO.
+ * @param[in] parent    The parent address of the transit information of
+ *                      @p target. NULL if the target is a child of the root.
+ * @param[in] lifetime  Lifetime of the path in seconds. 0 to remove the
+ *                      target (No-Path DAO).
+ *
+ * @return  0, on success.
+ * @return  -ENOMEM, if there is no space left in the graph.
+ */
+int gnrc_rpl_srh_root_update(const ipv6_addr_t *target,
+                             const ipv6_addr_t *parent, uint32_t lifetime);
+
+/**
+ * @brief   Removes all targets from the DAO parent graph
+ */
+void gnrc_rpl_srh_root_flush(void);
+
+/**
+ * @brief   Gets the source routing header to a destination
+ *
+ * @param[in] dst           Destination of a downward packet.
+ * @param[out] first_hop    The address to use as IPv6 destination of the
+ *                          packet. Equals @p dst if the destination is a
+ *                          child of the root.
+ * @param[out] buf          Buffer for the header, should be of
+ *                          @ref GNRC_RPL_SRH_ROOT_SRH_MAX bytes. The
+ *                          gnrc_rpl_srh_t::nh field is left at 0.
+ * @param[in] len           Length of @p buf.
+ *
+ * @return  Length of the header in @p buf.
+ * @return  0, if @p dst is a child of the root, so no header is needed.
+ * @return  -ENETUNREACH, if there is no path to @p dst.
+ * @return  -ELOOP, if the path has a loop or more than
+ *          @ref GNRC_RPL_SRH_ROOT_HOPS_MAX hops.
+ * @return  -ENOBUFS, if @p len is too small for the header.
+ */
+int gnrc_rpl_srh_root_get(const ipv6_addr_t *dst, ipv6_addr_t *first_hop,
+                          void *buf, size_t len);
+/** @} */
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,7 @@
 #include "net/gnrc/netif/hdr.h"
 #include "net/ieee802154.h"
 #include "net/sixlowpan.h"
+#include "timex.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,6 +55,37 @@ extern "C" {
 #define GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF     (0x0226)
 /** @} */
 
+/**
+ * @brief   Number of datagrams that can be fragmented at the same time
+ *
+ * The fragments of these datagrams are sent interleaved, with the smallest
+ * datagram first and datagrams of equal size round-robin. Packets that do not
+ * need to be fragmented are sent in between any two fragments.
+ */
+#ifndef GNRC_SIXLOWPAN_MSG_FRAG_SIZE
+#define GNRC_SIXLOWPAN_MSG_FRAG_SIZE        (1U)
+#endif
+
+/**
+ * @brief   Number of entries in the virtual reassembly buffer
+ *
+ * @note    Only used with module `gnrc_sixlowpan_frag_vrb`.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_SIZE
+#define GNRC_SIXLOWPAN_FRAG_VRB_SIZE        (4U)
+#endif
+
+/**
+ * @brief   Timeout in microseconds after which an entry of the virtual
+ *          reassembly buffer that did not receive any further fragments may
+ *          be reused
+ *
+ * @note    Only used with module `gnrc_sixlowpan_frag_vrb`.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT
+#define GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT     (3U * US_PER_SEC)
+#endif
+
 /**
  * @brief   An entry in the 6LoWPAN reassembly buffer.
  *
@@ -92,9 +124,27 @@ typedef struct {
     size_t datagram_size;   /**< Length of just the (uncompressed) IPv6 packet to be fragmented */
     uint16_t offset;        /**< Offset of the Nth fragment from the beginning of the
                              *   payload datagram */
+    uint16_t tag;           /**< Tag of the datagram */
     kernel_pid_t pid;       /**< PID of the interface */
 } gnrc_sixlowpan_msg_frag_t;
 
+/**
+ * @brief   Statistics on the usage of the reassembly buffer
+ *
+ * @note    Only available with module `gnrc_sixlowpan_frag_stats`. Use these
+ *          to size `RBUF_SIZE` and `RBUF_INT_SIZE` for a deployment.
+ */
+typedef struct {
+    uint32_t rbuf_full;         /**< incomplete datagrams dropped to make room
+                                 *   for a new one */
+    uint32_t rbuf_timeouts;     /**< incomplete datagrams dropped because they
+                                 *   timed out */
+    uint32_t ints_full;         /**< fragments dropped because the interval
+                                 *   pool was exhausted */
+    uint16_t rbuf_max_used;     /**< maximum number of reassembly buffer
+                                 *   entries in use at the same time */
+} gnrc_sixlowpan_frag_stats_t;
+
 /**
  * @brief   Allocates a @ref gnrc_sixlowpan_msg_frag_t object
  *
@@ -106,7 +156,13 @@ gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void);
 /**
  * @brief   Sends a packet fragmented
  *
- * @pre `ctx != NULL`
+ * With @p pkt set, the datagram in @p ctx is added to the datagrams being
+ * fragmented. With `pkt == NULL` (i.e. when a message of type
+ * @ref GNRC_SIXLOWPAN_MSG_FRAG_SND is received) the next fragment of the
+ * datagram that is next in turn is sent. Each call sends at most one
+ * fragment.
+ *
+ * @pre `(pkt == NULL) || (ctx != NULL)`
  * @pre gnrc_sixlowpan_msg_frag_t::pkt of @p ctx is equal to @p pkt or
  *      `pkt == NULL`.
  *
@@ -114,8 +170,8 @@ gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void);
  * @param[in] ctx       Message containing status of the 6LoWPAN fragmentation
  *                      progress. Expected to be of type
  *                      @ref gnrc_sixlowpan_msg_frag_t, with
- *                      gnrc_sixlowpan_msg_frag_t set to @p pkt. Must not be
- *                      NULL.
+ *                      gnrc_sixlowpan_msg_frag_t set to @p pkt. Ignored if
+ *                      @p pkt is NULL.
  * @param[in] page      Current 6Lo dispatch parsing page.
  */
 void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
@@ -129,6 +185,13 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
  */
 void gnrc_sixlowpan_frag_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
 
+/**
+ * @brief   Generates a new datagram tag for fragmentation
+ *
+ * @return  A new datagram tag.
+ */
+uint16_t gnrc_sixlowpan_frag_next_tag(void);
+
 /**
  * @brief   Garbage collect reassembly buffer.
  */
@@ -158,6 +221,53 @@ void gnrc_sixlowpan_frag_rbuf_remove(gnrc_sixlowpan_rbuf_t *rbuf);
  */
 void gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(gnrc_sixlowpan_rbuf_t *rbuf,
                                                      gnrc_netif_hdr_t *netif);
+
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Get the current statistics of the reassembly buffer
+ *
+ * @return  The statistics of the reassembly buffer.
+ */
+gnrc_sixlowpan_frag_stats_t *gnrc_sixlowpan_frag_stats_get(void);
+#endif
+
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) || defined(DOXYGEN)
+/**
+ * @brief   Forwards the first fragment of a datagram to the next hop and
+ *          remembers that next hop for its subsequent fragments
+ *
+ * With module `gnrc_sixlowpan_frag_vrb` a 6LoWPAN router does not reassemble
+ * datagrams it forwards. Instead, @ref net_gnrc_sixlowpan_iphc decompresses
+ * the IPv6 header in the first fragment of a datagram, recompresses it for
+ * the next hop, and hands it to this function. A virtual reassembly buffer
+ * entry then maps the datagram's link-layer source address and tag to the
+ * next hop, and subsequent fragments are forwarded to it as they arrive, with
+ * only their tag rewritten
+ * (see [draft-ietf-6lo-minimal-fragment](https://tools.ietf.org/html/draft-ietf-6lo-minimal-fragment)).
+ *
+ * @pre `rbuf != NULL`
+ * @pre `(pkt != NULL) && (pkt->type == GNRC_NETTYPE_NETIF)`
+ *
+ * @param[in] rbuf      The reassembly buffer entry the first fragment was
+ *                      received for. Only the information identifying the
+ *                      datagram is read from it.
+ * @param[in] pkt       The recompressed first fragment without fragment
+ *                      header in send order, i.e. starting with a
+ *                      @ref gnrc_netif_hdr_t that has the next hop as
+ *                      destination and gnrc_netif_hdr_t::if_pid set.
+ * @param[in] frag_size Size of the payload of the first fragment in the
+ *                      uncompressed datagram.
+ *
+ * @return  true, when the fragment was forwarded. @p pkt is released in that
+ *          case.
+ * @return  false, when the fragment can not be forwarded (because the virtual
+ *          reassembly buffer is full or the fragment does not fit into a frame
+ *          of the outgoing interface) and the datagram needs to be reassembled
+ *          instead. @p pkt is *not* released in that case.
+ */
+bool gnrc_sixlowpan_frag_vrb_send_1st(const gnrc_sixlowpan_rbuf_t *rbuf,
+                                      gnrc_pktsnip_t *pkt, size_t frag_size);
+#endif
 #else
 /* NOPs to be used with gnrc_sixlowpan_iphc if gnrc_sixlowpan_frag is not
  * compiled in */
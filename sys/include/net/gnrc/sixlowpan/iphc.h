@@ -29,6 +29,17 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of destinations the address compression cache remembers
+ *
+ * @note    Only available with module `gnrc_sixlowpan_iphc_cache`.
+ *
+ * @see     gnrc_sixlowpan_iphc_cache_invalidate()
+ */
+#ifndef GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+#define GNRC_SIXLOWPAN_IPHC_CACHE_SIZE  (2U)
+#endif
+
 /**
  * @brief   Decompresses a received 6LoWPAN IPHC frame.
  *
@@ -57,6 +68,31 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
  */
 void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
 
+#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Invalidates all entries of the address compression cache
+ *
+ * With module `gnrc_sixlowpan_iphc_cache` the IPHC encoder remembers the
+ * compressed form of source and destination address (including the context
+ * identifiers used) for the last @ref GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+ * combinations of interface, source, destination, and link-layer destination
+ * it sent to. Subsequent packets between those then only need their
+ * variable fields (traffic class, flow label, next header, hop limit, and
+ * UDP header) to be compressed.
+ *
+ * The 6LoWPAN context buffer and the network interfaces call this function
+ * whenever a context or the link-layer address of an interface changes, so
+ * there should be no need to call it from anywhere else.
+ *
+ * This function can be called from any thread.
+ */
+void gnrc_sixlowpan_iphc_cache_invalidate(void);
+#else
+static inline void gnrc_sixlowpan_iphc_cache_invalidate(void)
+{
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -52,6 +52,45 @@ int gnrc_tcp_init(void);
  */
 void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Use a caller supplied receive buffer for a TCB
+ *
+ * By default, the receive buffer of a connection is taken from a pool of
+ * @ref GNRC_TCP_RCV_BUFFERS buffers of @ref GNRC_TCP_RCV_BUF_SIZE bytes each.
+ * This allows connections with a larger (or smaller) receive window. The
+ * buffer is used by all following connections of @p tcb, until this function
+ * is called with @p buf set to NULL.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p buf must stay valid until the connection is closed.
+ *
+ * @param[in,out] tcb    TCB that should use @p buf.
+ * @param[in]     buf    Receive buffer, NULL to go back to the buffer pool.
+ * @param[in]     size   Size of @p buf in bytes.
+ *
+ * @returns   Zero on success.
+ *            -EISCONN if TCB is already in use.
+ */
+int gnrc_tcp_tcb_set_rcv_buf(gnrc_tcp_tcb_t *tcb, void *buf, size_t size);
+
+/**
+ * @brief Select the congestion control algorithm of a TCB
+ *
+ * Every TCB uses @ref gnrc_tcp_cc_newreno after gnrc_tcp_tcb_init().
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p cc must not be NULL.
+ *
+ * @param[in,out] tcb   TCB that should use @p cc.
+ * @param[in]     cc    Congestion control algorithm.
+ *
+ * @returns   Zero on success.
+ *            -EISCONN if TCB is already in use.
+ */
+int gnrc_tcp_tcb_set_cc(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_cc_t *cc);
+
 /**
  * @brief Opens a connection actively.
  *
@@ -122,6 +161,9 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ *       Transmitted data is acknowledged by the peer, unless
+ *       @ref GNRC_TCP_SND_QUEUE_SIZE allows more than one segment in flight:
+ *       then the function returns as soon as there is room for more data.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -179,6 +221,21 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
  */
 void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Get statistics of a TCP connection.
+ *
+ * The counters are reset whenever a connection is opened. This function may be
+ * called from any thread, also while another thread blocks on @p tcb.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p stats must not be NULL.
+ *
+ * @param[in]  tcb     TCB holding the connection information.
+ * @param[out] stats   Statistics of the connection.
+ */
+void gnrc_tcp_get_stats(gnrc_tcp_tcb_t *tcb, gnrc_tcp_stats_t *stats);
+
 /**
  * @brief Abort a TCP connection.
  *
@@ -214,6 +271,144 @@ int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_h
  */
 gnrc_pktsnip_t *gnrc_tcp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src, uint16_t dst);
 
+/**
+ * @name Events of the asynchronous API
+ *
+ * Module `gnrc_tcp_async` adds non-blocking variants of the calls that wait
+ * for the peer. Instead of blocking a thread per connection, they report
+ * their outcome by calling the callback given to gnrc_tcp_async_init() from
+ * the thread handling the event queue, so a single thread can serve many
+ * connections:
+ *
+ * ~~~~~~~~~~~~~~~~ {.c}
+ * static void _cb(gnrc_tcp_tcb_t *tcb, unsigned events, void *arg)
+ * {
+ *     if (events & GNRC_TCP_ASYNC_READABLE) {
+ *         while ((res = gnrc_tcp_recv(tcb, buf, sizeof(buf), 0)) > 0) {
+ *             ...
+ *         }
+ *     }
+ *     if (events & GNRC_TCP_ASYNC_EOF) {
+ *         gnrc_tcp_async_close(tcb);
+ *     }
+ *     if (events & GNRC_TCP_ASYNC_CLOSED) {
+ *         // tcb can be reused
+ *     }
+ * }
+ *
+ * gnrc_tcp_tcb_init(&tcb);
+ * gnrc_tcp_async_init(&tcb, &queue, _cb, NULL);
+ * gnrc_tcp_async_open_passive(&tcb, AF_INET6, NULL, 80);
+ * event_loop(&queue);
+ * ~~~~~~~~~~~~~~~~
+ *
+ * Multiple TCBs in LISTEN state on the same port serve one incoming
+ * connection each. gnrc_tcp_recv() with a timeout of zero and
+ * gnrc_tcp_abort() never block and work as they are. The blocking calls
+ * must not be used on a TCB set up for the asynchronous API.
+ *
+ * A connection is aborted with @ref GNRC_TCP_ASYNC_CLOSED, if it does not
+ * make progress for @ref GNRC_TCP_CONNECTION_TIMEOUT_DURATION while opening,
+ * closing or waiting for acknowledgments.
+ * @{
+ */
+#define GNRC_TCP_ASYNC_CONNECTED (0x01)  /**< Connection was established */
+#define GNRC_TCP_ASYNC_READABLE  (0x02)  /**< New data can be received */
+#define GNRC_TCP_ASYNC_WRITABLE  (0x04)  /**< Data can be sent again after
+                                          *   gnrc_tcp_async_send() could not
+                                          *   send everything */
+#define GNRC_TCP_ASYNC_EOF       (0x08)  /**< Peer closed its sending direction */
+#define GNRC_TCP_ASYNC_CLOSED    (0x10)  /**< Connection was closed, aborted,
+                                          *   refused or timed out. The TCB
+                                          *   can be opened again. */
+/** @} */
+
+#if defined(MODULE_GNRC_TCP_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief Set up a TCB for the asynchronous API
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb, @p queue and @p cb must not be NULL.
+ * @pre The connection of @p tcb must be closed.
+ *
+ * @param[in,out] tcb     TCB to use asynchronously.
+ * @param[in]     queue   Event queue @p cb is called from.
+ * @param[in]     cb      Callback for events on @p tcb.
+ * @param[in]     arg     Argument passed to @p cb.
+ */
+void gnrc_tcp_async_init(gnrc_tcp_tcb_t *tcb, event_queue_t *queue,
+                         gnrc_tcp_async_cb_t cb, void *arg);
+
+/**
+ * @brief Start opening a connection actively.
+ *
+ * @pre gnrc_tcp_async_init() must have been called on @p tcb.
+ *
+ * Arguments are the same as for gnrc_tcp_open_active(). The outcome is
+ * reported with @ref GNRC_TCP_ASYNC_CONNECTED or @ref GNRC_TCP_ASYNC_CLOSED.
+ *
+ * @returns   Zero if the connection opening was started.
+ *            -EAFNOSUPPORT if @p address_family is not supported.
+ *            -EINVAL if @p address_family is not the same the address_family use by the TCB.
+ *                    or @p target_addr is invalid.
+ *            -EISCONN if TCB is already in use.
+ *            -ENOMEM if the receive buffer for the TCB could not be allocated.
+ *            -EADDRINUSE if @p local_port is already used by another connection.
+ */
+int gnrc_tcp_async_open_active(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
+                               char *target_addr, uint16_t target_port,
+                               uint16_t local_port);
+
+/**
+ * @brief Start waiting for an incoming connection.
+ *
+ * @pre gnrc_tcp_async_init() must have been called on @p tcb.
+ *
+ * Arguments are the same as for gnrc_tcp_open_passive(). A connection is
+ * reported with @ref GNRC_TCP_ASYNC_CONNECTED.
+ *
+ * @returns   Zero if @p tcb is listening.
+ *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
+ *            -EINVAL if @p address_family is not the same the address_family used in TCB.
+ *                    or @p target_addr is invalid.
+ *            -EISCONN if TCB is already in use.
+ *            -ENOMEM if the receive buffer for the TCB could not be allocated.
+ */
+int gnrc_tcp_async_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
+                                const char *local_addr, uint16_t local_port);
+
+/**
+ * @brief Send as much data as possible without blocking.
+ *
+ * @pre gnrc_tcp_async_init() must have been called on @p tcb.
+ * @pre @p data must not be NULL.
+ *
+ * If not all of @p data could be sent, @ref GNRC_TCP_ASYNC_WRITABLE is
+ * reported when sending is possible again. A closed send window of the peer
+ * is probed meanwhile.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     data   Pointer to the data that should be transmitted.
+ * @param[in]     len    Number of bytes that should be transmitted.
+ *
+ * @returns   The number of bytes sent.
+ *            -EAGAIN if nothing could be sent right now.
+ *            -ENOTCONN if connection is not established.
+ */
+ssize_t gnrc_tcp_async_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len);
+
+/**
+ * @brief Start closing a connection.
+ *
+ * @pre gnrc_tcp_async_init() must have been called on @p tcb.
+ *
+ * @ref GNRC_TCP_ASYNC_CLOSED is reported once the connection is closed.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void gnrc_tcp_async_close(gnrc_tcp_tcb_t *tcb);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
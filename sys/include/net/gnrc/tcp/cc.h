@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's TCP implementation for the GNRC network stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       GNRC TCP congestion control interface
+ *
+ * The state machine detects duplicate ACKs, fast retransmits and leaves fast
+ * recovery (see RFC 5681 and RFC 6582). A congestion control algorithm only
+ * decides how the congestion window `cwnd` and the slow start threshold
+ * `ssthresh` of the TCB react to those events.
+ */
+
+#ifndef NET_GNRC_TCP_CC_H
+#define NET_GNRC_TCP_CC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Forward declaration of the transmission control block.
+ */
+struct _transmission_control_block;
+
+/**
+ * @brief Events passed to a congestion control algorithm.
+ */
+typedef enum {
+    GNRC_TCP_CC_EVENT_ACK = 0,          /**< New data was acknowledged */
+    GNRC_TCP_CC_EVENT_RECOVERY_START,   /**< Duplicate ACK threshold reached,
+                                             the first unacknowledged segment
+                                             is retransmitted */
+    GNRC_TCP_CC_EVENT_DUP_ACK,          /**< Further duplicate ACK in fast
+                                             recovery */
+    GNRC_TCP_CC_EVENT_PARTIAL_ACK,      /**< Some, but not all data sent before
+                                             fast recovery was acknowledged */
+    GNRC_TCP_CC_EVENT_RECOVERY_END,     /**< All data sent before fast recovery
+                                             was acknowledged */
+    GNRC_TCP_CC_EVENT_TIMEOUT,          /**< Retransmission timer expired */
+} gnrc_tcp_cc_event_t;
+
+/**
+ * @brief Congestion control algorithm
+ */
+typedef struct {
+    /**
+     * @brief Initializes `cwnd` and `ssthresh` of a newly established
+     *        connection
+     *
+     * @param[in,out] tcb   TCB of the connection.
+     */
+    void (*init)(struct _transmission_control_block *tcb);
+
+    /**
+     * @brief Adjusts `cwnd` and `ssthresh` of a connection on @p event
+     *
+     * `snd_una` is already updated when this is called.
+     *
+     * @param[in,out] tcb     TCB of the connection.
+     * @param[in]     event   The event.
+     * @param[in]     acked   Number of newly acknowledged bytes (zero for
+     *                        duplicate ACKs and timeouts).
+     */
+    void (*event)(struct _transmission_control_block *tcb,
+                  gnrc_tcp_cc_event_t event, uint32_t acked);
+} gnrc_tcp_cc_t;
+
+/**
+ * @brief NewReno congestion control (see RFC 5681 and RFC 6582)
+ *
+ * This is the default for every TCB.
+ */
+extern const gnrc_tcp_cc_t gnrc_tcp_cc_newreno;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TCP_CC_H */
+/** @} */
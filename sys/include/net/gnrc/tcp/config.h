@@ -81,6 +81,61 @@ extern "C" {
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Negotiate the window scale option (see RFC 7323)
+ *
+ * Required for receive windows larger than 65535 bytes, i.e. for receive
+ * buffers set with gnrc_tcp_tcb_set_rcv_buf() that are larger than that.
+ */
+#ifndef GNRC_TCP_CONF_WND_SCALE
+#define GNRC_TCP_CONF_WND_SCALE (0)
+#endif
+
+/**
+ * @brief Negotiate selective acknowledgments (see RFC 2018)
+ *
+ * If the peer agrees, acknowledgments report the out-of-order data held in the
+ * receive buffer, so the peer only needs to retransmit what is missing.
+ */
+#ifndef GNRC_TCP_CONF_SACK
+#define GNRC_TCP_CONF_SACK (0)
+#endif
+
+/**
+ * @brief Number of out-of-order byte ranges tracked in the receive buffer
+ *
+ * Segments that arrive ahead of the next expected sequence number are stored
+ * in the receive buffer right away. Each disjoint range of such data takes
+ * one entry of 8 bytes in the TCB. Must be at least 1. With
+ * @ref GNRC_TCP_CONF_SACK, up to 4 of them are reported to the peer.
+ */
+#ifndef GNRC_TCP_OOSEQ_NUMOF
+#if GNRC_TCP_CONF_SACK
+#define GNRC_TCP_OOSEQ_NUMOF (4U)
+#else
+#define GNRC_TCP_OOSEQ_NUMOF (1U)
+#endif
+#endif
+
+/**
+ * @brief Maximum number of unacknowledged segments per connection
+ *
+ * Every segment in flight is held in the packet buffer until it is
+ * acknowledged, so this costs up to `GNRC_TCP_SND_QUEUE_SIZE * GNRC_TCP_MSS`
+ * bytes of packet buffer per connection. With the default of one segment,
+ * gnrc_tcp_send() returns only after the data was acknowledged.
+ */
+#ifndef GNRC_TCP_SND_QUEUE_SIZE
+#define GNRC_TCP_SND_QUEUE_SIZE (1U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUP_ACK_THRESHOLD
+#define GNRC_TCP_DUP_ACK_THRESHOLD (3U)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
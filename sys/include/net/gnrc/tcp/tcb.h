@@ -22,6 +22,7 @@
 #ifndef NET_GNRC_TCP_TCB_H
 #define NET_GNRC_TCP_TCB_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "kernel_types.h"
 #include "ringbuffer.h"
@@ -30,12 +31,17 @@
 #include "msg.h"
 #include "mbox.h"
 #include "net/gnrc/pkt.h"
+#include "cc.h"
 #include "config.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
 #endif
 
+#ifdef MODULE_GNRC_TCP_ASYNC
+#include "event.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -45,6 +51,42 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+/**
+ * @brief Range of out-of-order data held in the receive buffer.
+ */
+typedef struct {
+    uint32_t start;     /**< Sequence number of the first byte */
+    uint32_t end;       /**< Sequence number following the last byte */
+} gnrc_tcp_ooseq_t;
+
+/**
+ * @brief Statistics of a connection
+ *
+ * @see gnrc_tcp_get_stats()
+ */
+typedef struct {
+    uint32_t retransmits;       /**< Number of retransmitted segments */
+    uint32_t fast_retransmits;  /**< Number of retransmissions triggered by duplicate ACKs */
+    uint32_t timeouts;          /**< Number of expired retransmission timers */
+    uint32_t srtt;              /**< Smoothed round trip time in microseconds, 0 if unknown */
+    uint32_t rtt_var;           /**< Round trip time variance in microseconds, 0 if unknown */
+    uint32_t rto;               /**< Current retransmission timeout in microseconds */
+    uint32_t cwnd;              /**< Congestion window in bytes */
+    uint32_t ssthresh;          /**< Slow start threshold in bytes */
+    uint32_t snd_wnd;           /**< Send window announced by the peer in bytes */
+    uint32_t flight_size;       /**< Number of sent, but unacknowledged bytes */
+} gnrc_tcp_stats_t;
+
+/**
+ * @brief Callback for events of the asynchronous API
+ *
+ * @param[in] tcb      TCB the events occurred on.
+ * @param[in] events   Bitfield of events (`GNRC_TCP_ASYNC_*`).
+ * @param[in] arg      Argument given to gnrc_tcp_async_init().
+ */
+typedef void (*gnrc_tcp_async_cb_t)(struct _transmission_control_block *tcb,
+                                    unsigned events, void *arg);
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -61,28 +103,52 @@ typedef struct _transmission_control_block {
     uint8_t status;        /**< A connections status flags */
     uint32_t snd_una;      /**< Send unacknowledged */
     uint32_t snd_nxt;      /**< Send next */
-    uint16_t snd_wnd;      /**< Send window */
+    uint32_t snd_wnd;      /**< Send window */
     uint32_t snd_wl1;      /**< SeqNo. from last window update */
     uint32_t snd_wl2;      /**< AckNo. from last window update */
     uint32_t rcv_nxt;      /**< Receive next */
-    uint16_t rcv_wnd;      /**< Receive window */
+    uint32_t rcv_wnd;      /**< Receive window */
+    uint8_t snd_wnd_scale; /**< Shift count for windows announced by the peer */
+    uint8_t rcv_wnd_scale; /**< Shift count for windows announced to the peer */
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< Sequence number that ends the rtt measurement */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
+    uint8_t dup_acks;      /**< Number of consecutive duplicate ACKs */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Highest sequence number sent when fast recovery started */
+    const gnrc_tcp_cc_t *cc;    /**< Congestion control algorithm */
+    gnrc_tcp_stats_t stats;     /**< Connection statistics (counters only) */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    gnrc_pktsnip_t *pkt_retransmit[GNRC_TCP_SND_QUEUE_SIZE];   /**< "Retransmit queue", oldest first */
+    uint8_t pkt_retransmit_num;   /**< Number of packets in pkt_retransmit */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
+    uint8_t *rcv_buf_user;   /**< Receive buffer given by the user (optional) */
+    size_t rcv_buf_user_size;   /**< Size of rcv_buf_user */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
+    gnrc_tcp_ooseq_t ooseq[GNRC_TCP_OOSEQ_NUMOF];   /**< Out-of-order data, most recent first */
+    uint8_t ooseq_num;       /**< Number of used entries in ooseq */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+#if defined(MODULE_GNRC_TCP_ASYNC) || defined(DOXYGEN)
+    event_t async_event;     /**< Event posted to async_queue */
+    event_queue_t *async_queue;   /**< Queue the events are handled in */
+    gnrc_tcp_async_cb_t async_cb; /**< Callback for events, NULL for the blocking API */
+    void *async_arg;         /**< Argument for async_cb */
+    uint8_t async_events;    /**< Events not yet passed to async_cb */
+    uint8_t async_status;    /**< Status flags of the asynchronous API */
+    xtimer_t async_tim;      /**< Timer for connection timeouts and probes */
+    msg_t async_msg;         /**< Message sent on expiration of async_tim */
+#endif
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
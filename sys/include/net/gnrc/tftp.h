@@ -29,6 +29,22 @@
  *  - https://tools.ietf.org/html/rfc2349
  *     (RFC2349 TFTP Timeout Interval and Transfer Size Options)
  *
+ *  - https://tools.ietf.org/html/rfc7440
+ *     (RFC7440 TFTP Windowsize Option)
+ *
+ * With the option extensions the client requests the largest block size that
+ * fits into the MTU of the path to the server (but at most
+ * @ref GNRC_TFTP_MAX_TRANSFER_UNIT) and a window of @ref GNRC_TFTP_WINDOW_SIZE
+ * blocks, so the sender only waits for an acknowledgement after each window
+ * instead of after each block. The server accepts both options up to the same
+ * limits. Without path MTU discovery, the MTU of the path to a peer that is
+ * not link-local is assumed to be at most @ref IPV6_MIN_MTU.
+ *
+ * The data callback reads the blocks from and writes them to the packet
+ * buffer directly, so the application can e.g. pass them on to a file or
+ * flash device without another copy. Blocks that are lost are requested
+ * again, so the callback may be asked for the same offset more than once.
+ *
  * @author      Nick van IJzendoorn <nijzendoorn@engineering-spirit.nl>
  */
 
@@ -74,6 +90,16 @@ extern "C" {
 #define GNRC_TFTP_MAX_TRANSFER_UNIT         (512)
 #endif
 
+/**
+ * @brief The maximum number of blocks sent before waiting for an ACK
+ *
+ * Requested by the client and accepted by the server with the windowsize
+ * option. 1 yields lock-step transfers as without the option.
+ */
+#ifndef GNRC_TFTP_WINDOW_SIZE
+#define GNRC_TFTP_WINDOW_SIZE               (4)
+#endif
+
 /**
  * @brief The number of retries that must be made before stopping a transfer
  */
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tsch TSCH
+ * @ingroup     net_gnrc
+ * @brief       Time Slotted Channel Hopping MAC for IEEE 802.15.4 radios
+ *
+ * TSCH (IEEE 802.15.4-2015, formerly 802.15.4e) divides time into slots
+ * that are grouped into a repeating slotframe. A cell is a slot offset and
+ * a channel offset within the slotframe. In each slot the channel is derived
+ * from the absolute slot number (ASN) and the cell's channel offset, so
+ * consecutive transmissions in a cell hop over the channels of
+ * @ref GNRC_TSCH_HOPPING_SEQUENCE. Outside its cells the radio is off.
+ *
+ * The PAN coordinator (see gnrc_tsch_coordinator_start()) keeps the time and
+ * announces the network in enhanced beacons. Other nodes listen for beacons,
+ * join the network with the sender as time source and resynchronize on every
+ * frame received from it. Joined nodes send beacons themselves, so the
+ * network can span multiple hops.
+ *
+ * The schedule follows the 6TiSCH minimal configuration (RFC 8180): slot 0
+ * holds one shared cell for all traffic and the beacons. Additionally, an
+ * autonomous scheduling function in the style of the 6TiSCH MSF (RFC 9033)
+ * installs one receive cell per node and a transmit cell for each unicast
+ * neighbor, both at a slot derived from the receiver's address, without
+ * any negotiation. More cells can be added with gnrc_tsch_cell_add().
+ *
+ * Frames are queued per neighbor with the @ref net_gnrc_mac queues. A frame
+ * is retried in the next cell to its destination up to
+ * @ref GNRC_TSCH_MAX_RETRIES times. Shared cells use the TSCH exponential
+ * backoff after failures.
+ *
+ * Enhanced beacons are simplified: they are broadcast data frames carrying
+ * @ref GNRC_TSCH_EB_DISPATCH, the ASN and the join priority instead of
+ * information elements, and the hardware acknowledgments of the radio are
+ * used without the time correction IE. The time of a received frame is
+ * taken in the radio interrupt that signals its start, so radios must
+ * support @ref NETOPT_RX_START_IRQ.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for TSCH
+ */
+
+#ifndef NET_GNRC_TSCH_H
+#define NET_GNRC_TSCH_H
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tsch/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Slot duration in microseconds
+ */
+#ifndef GNRC_TSCH_SLOT_DURATION_US
+#define GNRC_TSCH_SLOT_DURATION_US          (10000U)
+#endif
+
+/**
+ * @brief   Number of slots in the slotframe
+ *
+ * Should be coprime with the length of @ref GNRC_TSCH_HOPPING_SEQUENCE, so
+ * every cell visits all channels.
+ */
+#ifndef GNRC_TSCH_SLOTFRAME_LEN
+#define GNRC_TSCH_SLOTFRAME_LEN             (17U)
+#endif
+
+/**
+ * @brief   Channel hopping sequence
+ *
+ * The default is the 16 channel sequence of IEEE 802.15.4-2015 used by
+ * 6TiSCH.
+ */
+#ifndef GNRC_TSCH_HOPPING_SEQUENCE
+#define GNRC_TSCH_HOPPING_SEQUENCE          { 16, 17, 23, 18, 26, 15, 25, 22, \
+                                              19, 11, 12, 13, 24, 14, 20, 21 }
+#endif
+
+/**
+ * @brief   Start of the frame's SFD within the slot (macTsTxOffset)
+ */
+#ifndef GNRC_TSCH_TX_OFFSET_US
+#define GNRC_TSCH_TX_OFFSET_US              (2120U)
+#endif
+
+/**
+ * @brief   Start of reception within the slot (macTsRxOffset)
+ */
+#ifndef GNRC_TSCH_RX_OFFSET_US
+#define GNRC_TSCH_RX_OFFSET_US              (1120U)
+#endif
+
+/**
+ * @brief   Time the receiver waits for a frame to start (macTsRxWait)
+ */
+#ifndef GNRC_TSCH_RX_WAIT_US
+#define GNRC_TSCH_RX_WAIT_US                (2200U)
+#endif
+
+/**
+ * @brief   Time the frame is loaded into the radio before it is sent
+ *
+ * Only used if the radio supports @ref NETOPT_PRELOADING.
+ */
+#ifndef GNRC_TSCH_TX_LOAD_US
+#define GNRC_TSCH_TX_LOAD_US                (1000U)
+#endif
+
+/**
+ * @brief   Delay from starting a transmission to the transmitted SFD
+ *
+ * Is radio specific. Without preloading it includes loading the frame.
+ */
+#ifndef GNRC_TSCH_TX_DELAY_US
+#define GNRC_TSCH_TX_DELAY_US               (200U)
+#endif
+
+/**
+ * @brief   Delay from the received SFD to the time taken in the interrupt
+ */
+#ifndef GNRC_TSCH_RX_DELAY_US
+#define GNRC_TSCH_RX_DELAY_US               (50U)
+#endif
+
+/**
+ * @brief   Number of retransmissions of a frame (macMaxFrameRetries)
+ */
+#ifndef GNRC_TSCH_MAX_RETRIES
+#define GNRC_TSCH_MAX_RETRIES               (3U)
+#endif
+
+/**
+ * @brief   Minimum backoff exponent in shared cells (macMinBe)
+ */
+#ifndef GNRC_TSCH_MIN_BE
+#define GNRC_TSCH_MIN_BE                    (1U)
+#endif
+
+/**
+ * @brief   Maximum backoff exponent in shared cells (macMaxBe)
+ */
+#ifndef GNRC_TSCH_MAX_BE
+#define GNRC_TSCH_MAX_BE                    (5U)
+#endif
+
+/**
+ * @brief   Interval of enhanced beacons in microseconds
+ */
+#ifndef GNRC_TSCH_EB_PERIOD_US
+#define GNRC_TSCH_EB_PERIOD_US              (2U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Time without frames from the time source after which a node
+ *          leaves the network and scans again
+ */
+#ifndef GNRC_TSCH_DESYNC_TIMEOUT_US
+#define GNRC_TSCH_DESYNC_TIMEOUT_US         (15U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Start the interface as PAN coordinator
+ *
+ * Otherwise call gnrc_tsch_coordinator_start() to become PAN coordinator.
+ */
+#ifndef GNRC_TSCH_COORDINATOR
+#define GNRC_TSCH_COORDINATOR               (0)
+#endif
+
+/**
+ * @brief   First payload byte of an enhanced beacon
+ *
+ * From the 6LoWPAN NALP (not a LoWPAN frame) range, so other stacks drop
+ * them.
+ */
+#define GNRC_TSCH_EB_DISPATCH               (0x3aU)
+
+/**
+ * @brief   Creates a TSCH network interface
+ *
+ * @param[in] stack     The stack for the network interface's thread.
+ * @param[in] stacksize Size of @p stack.
+ * @param[in] priority  Priority for the network interface's thread.
+ * @param[in] name      Name for the network interface. May be NULL.
+ * @param[in] dev       Device for the interface.
+ *
+ * @see @ref gnrc_netif_create()
+ *
+ * @return  The network interface on success.
+ */
+gnrc_netif_t *gnrc_netif_tsch_create(char *stack, int stacksize,
+                                     char priority, char *name,
+                                     netdev_t *dev);
+
+/**
+ * @brief   Makes the interface the PAN coordinator of a new network
+ *
+ * @param[in] netif     A TSCH interface
+ *
+ * @return  0 on success
+ * @return  -EBUSY if the interface's message queue is full
+ */
+int gnrc_tsch_coordinator_start(gnrc_netif_t *netif);
+
+/**
+ * @brief   Adds a cell to the slotframe of an interface
+ *
+ * @param[in] netif     A TSCH interface
+ * @param[in] cell      The cell, gnrc_tsch_cell_t::slot must be less than
+ *                      @ref GNRC_TSCH_SLOTFRAME_LEN
+ *
+ * @return  0 on success
+ * @return  -EINVAL for an invalid cell
+ * @return  -ENOMEM if all @ref GNRC_TSCH_CELLS_NUMOF cells are in use
+ */
+int gnrc_tsch_cell_add(gnrc_netif_t *netif, const gnrc_tsch_cell_t *cell);
+
+/**
+ * @brief   Removes all cells at a slot and channel offset
+ *
+ * @param[in] netif     A TSCH interface
+ * @param[in] slot      The slot offset
+ * @param[in] choff     The channel offset
+ *
+ * @return  Number of cells removed
+ */
+int gnrc_tsch_cell_remove(gnrc_netif_t *netif, uint16_t slot, uint8_t choff);
+
+/**
+ * @brief   Gets the absolute slot number of an interface
+ *
+ * @param[in] netif     A TSCH interface
+ *
+ * @return  The ASN of the current slot, 0 if not part of a network
+ */
+uint64_t gnrc_tsch_get_asn(gnrc_netif_t *netif);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_H */
+/** @} */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Internal types of TSCH
+ */
+
+#ifndef NET_GNRC_TSCH_TYPES_H
+#define NET_GNRC_TSCH_TYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "msg.h"
+#include "xtimer.h"
+#include "net/ieee802154.h"
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of cells an interface can hold, including the minimal cell
+ *          and the autonomous cells
+ */
+#ifndef GNRC_TSCH_CELLS_NUMOF
+#define GNRC_TSCH_CELLS_NUMOF               (8U)
+#endif
+
+/**
+ * @name    Message types of the TSCH slot engine
+ * @{
+ */
+#define GNRC_TSCH_MSG_SLOT_START            (0x4420)    /**< next slot starts */
+#define GNRC_TSCH_MSG_SLOT_ACTION           (0x4421)    /**< in-slot event */
+#define GNRC_TSCH_MSG_COORDINATOR           (0x4422)    /**< start a network */
+/** @} */
+
+/**
+ * @name    Cell options
+ * @{
+ */
+#define GNRC_TSCH_CELL_TX                   (0x01U) /**< transmit cell */
+#define GNRC_TSCH_CELL_RX                   (0x02U) /**< receive cell */
+#define GNRC_TSCH_CELL_SHARED               (0x04U) /**< contention with backoff */
+#define GNRC_TSCH_CELL_ADV                  (0x08U) /**< enhanced beacons are
+                                                     *   sent in this cell */
+#define GNRC_TSCH_CELL_AUTO                 (0x10U) /**< installed by the
+                                                     *   autonomous scheduling
+                                                     *   function */
+/** @} */
+
+/**
+ * @brief   A cell of the slotframe
+ */
+typedef struct {
+    uint8_t addr[IEEE802154_LONG_ADDRESS_LEN];  /**< neighbor of a TX cell */
+    uint16_t slot;                              /**< slot offset */
+    uint8_t choff;                              /**< channel offset */
+    uint8_t flags;                              /**< GNRC_TSCH_CELL_* options,
+                                                 *   0 for an unused cell */
+    uint8_t addr_len;                           /**< length of
+                                                 *   gnrc_tsch_cell_t::addr, 0
+                                                 *   if the cell is for any
+                                                 *   neighbor */
+} gnrc_tsch_cell_t;
+
+/**
+ * @brief   Synchronization states
+ */
+typedef enum {
+    GNRC_TSCH_STATE_SCANNING = 0,   /**< listening for enhanced beacons */
+    GNRC_TSCH_STATE_JOINED,         /**< synchronized to a time source */
+    GNRC_TSCH_STATE_COORDINATOR,    /**< PAN coordinator, keeps the time */
+} gnrc_tsch_state_t;
+
+/**
+ * @brief   States within a slot
+ */
+typedef enum {
+    GNRC_TSCH_SLOT_IDLE = 0,        /**< radio off */
+    GNRC_TSCH_SLOT_TX_LOAD,         /**< load frame before the TX offset */
+    GNRC_TSCH_SLOT_TX,              /**< start transmission at the TX offset */
+    GNRC_TSCH_SLOT_TX_BUSY,         /**< waiting for the transmission result */
+    GNRC_TSCH_SLOT_RX,              /**< turn on the receiver at RX offset */
+    GNRC_TSCH_SLOT_RX_LISTEN,       /**< waiting for a frame to start */
+    GNRC_TSCH_SLOT_RX_BUSY,         /**< frame reception ongoing */
+} gnrc_tsch_slot_state_t;
+
+/**
+ * @brief   TSCH state of an interface
+ */
+typedef struct {
+    gnrc_tsch_cell_t cells[GNRC_TSCH_CELLS_NUMOF];  /**< slotframe */
+    xtimer_t slot_timer;                /**< fires at the start of the next
+                                         *   active slot */
+    xtimer_t action_timer;              /**< fires at in-slot events */
+    msg_t slot_msg;                     /**< message of
+                                         *   gnrc_tsch_t::slot_timer */
+    msg_t action_msg;                   /**< message of
+                                         *   gnrc_tsch_t::action_timer */
+    uint64_t asn;                       /**< absolute slot number of the
+                                         *   current slot */
+    gnrc_pktsnip_t *tx_pkt;             /**< frame of the current slot */
+    const gnrc_tsch_cell_t *tx_cell;    /**< cell of the current frame */
+    uint32_t slot_start;                /**< start of the current slot */
+    uint32_t last_sync;                 /**< last frame from the time source */
+    uint32_t last_eb;                   /**< last enhanced beacon sent */
+    volatile uint32_t isr_time;         /**< time of the last radio IRQ */
+    uint32_t rx_time;                   /**< time the current frame started */
+    uint8_t time_source[IEEE802154_LONG_ADDRESS_LEN];   /**< address of the
+                                                         *   time source */
+    uint8_t time_source_len;            /**< length of
+                                         *   gnrc_tsch_t::time_source */
+    uint16_t skip;                      /**< slots to the next active slot */
+    uint8_t state;                      /**< gnrc_tsch_state_t */
+    uint8_t slot_state;                 /**< gnrc_tsch_slot_state_t */
+    uint8_t join_prio;                  /**< join priority, 0 for the PAN
+                                         *   coordinator */
+    uint8_t backoff;                    /**< shared cells left to skip */
+    uint8_t backoff_exp;                /**< backoff exponent */
+    bool preload;                       /**< radio supports preloading */
+} gnrc_tsch_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_TYPES_H */
+/** @} */
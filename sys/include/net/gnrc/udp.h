@@ -39,6 +39,15 @@ extern "C" {
 #define GNRC_UDP_MSG_QUEUE_SIZE (8U)
 #endif
 
+/**
+ * @brief   Maximum number of messages the UDP thread handles per wake-up
+ *
+ * @see     msg_receive_batch()
+ */
+#ifndef GNRC_UDP_MSG_BATCH_SIZE
+#define GNRC_UDP_MSG_BATCH_SIZE (4U)
+#endif
+
 /**
  * @brief   Priority of the UDP thread
  */
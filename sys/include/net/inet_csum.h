@@ -73,6 +73,31 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates a (normalized) Internet Checksum after a part of its domain
+ *          changed
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @details This allows to fix up the checksum field of a header after e.g.
+ *          an address or port was rewritten without recalculating the
+ *          checksum over the whole domain.
+ *
+ * @pre The changed part starts at an even offset within the checksum domain.
+ *
+ * @param[in] csum      The current checksum, as found in the checksum field (i.e.
+ *                      normalized).
+ * @param[in] old_buf   The old content of the changed part.
+ * @param[in] new_buf   The new content of the changed part.
+ * @param[in] len       Length of @p old_buf and @p new_buf in byte.
+ *
+ * @return  The new (normalized) checksum.
+ */
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_buf, const uint8_t *new_buf,
+                          uint16_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_mpl MPL
+ * @ingroup     net
+ * @brief       Definitions of the Multicast Protocol for Low-Power and Lossy
+ *              Networks
+ * @see         [RFC 7731](https://tools.ietf.org/html/rfc7731)
+ * @{
+ *
+ * @file
+ * @brief       MPL wire format definitions
+ */
+#ifndef NET_MPL_H
+#define NET_MPL_H
+
+#include <stdint.h>
+
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   ALL_MPL_FORWARDERS, the realm-local default MPL domain
+ *
+ * @see [RFC 7731, section 6](https://tools.ietf.org/html/rfc7731#section-6)
+ */
+#define MPL_ALL_FORWARDERS_REALM_LOCAL  {{ 0xff, 0x03, 0x00, 0x00, \
+                                           0x00, 0x00, 0x00, 0x00, \
+                                           0x00, 0x00, 0x00, 0x00, \
+                                           0x00, 0x00, 0x00, 0xfc }}
+
+/**
+ * @name    MPL option
+ * @see     [RFC 7731, section 6.1](https://tools.ietf.org/html/rfc7731#section-6.1)
+ * @{
+ */
+#define MPL_OPT_TYPE            (0x6dU) /**< hop-by-hop option type */
+#define MPL_OPT_S_MASK          (0xc0U) /**< length of the seed-id */
+#define MPL_OPT_S_POS           (6U)    /**< position of MPL_OPT_S_MASK */
+#define MPL_OPT_M               (0x20U) /**< largest sequence number known */
+#define MPL_OPT_V               (0x10U) /**< unsupported version, drop */
+#define MPL_OPT_LEN_MIN         (2U)    /**< option data without seed-id */
+/** @} */
+
+/**
+ * @name    Values of the S field
+ * @{
+ */
+#define MPL_SEED_ID_SRC         (0U)    /**< IPv6 source address */
+#define MPL_SEED_ID_16          (1U)    /**< 16 bit seed-id */
+#define MPL_SEED_ID_64          (2U)    /**< 64 bit seed-id */
+#define MPL_SEED_ID_128         (3U)    /**< 128 bit seed-id */
+/** @} */
+
+/**
+ * @brief   Maximum length of a seed-id in bytes
+ */
+#define MPL_SEED_ID_LEN_MAX     (16U)
+
+/**
+ * @name    MPL seed info of a control message
+ * @see     [RFC 7731, section 6.2](https://tools.ietf.org/html/rfc7731#section-6.2)
+ * @{
+ */
+#define MPL_SEED_INFO_S_MASK    (0x03U) /**< length of the seed-id */
+#define MPL_SEED_INFO_BM_POS    (2U)    /**< position of the bitmap length */
+#define MPL_SEED_INFO_BM_MAX    (63U)   /**< maximum length of the bitmap */
+/** @} */
+
+/**
+ * @brief   Gets the length of a seed-id in an MPL option
+ *
+ * @param[in] s     the S field
+ *
+ * @return  length of the seed-id in bytes, 0 if it is the IPv6 source address
+ */
+static inline unsigned mpl_seed_id_len(uint8_t s)
+{
+    static const uint8_t lens[] = { 0, 2, 8, 16 };
+
+    return lens[s & 0x3];
+}
+
+/**
+ * @brief   MPL option of a hop-by-hop options header, with the seed-id
+ *          following
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t type;       /**< @ref MPL_OPT_TYPE */
+    uint8_t len;        /**< option data length */
+    uint8_t flags;      /**< S, M and V */
+    uint8_t seq;        /**< sequence number */
+} mpl_opt_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_MPL_H */
+/** @} */
@@ -131,6 +131,14 @@
  * finalizes the packet and calls coap_block2_finish() internally to update
  * the block2 option.
  *
+ The slicer runs the whole handler for every block, so the cost of serving a
+ * block grows with its number. Resources that can be read at an arbitrary
+ * offset, like a file or a flash region, should rather use
+ * coap_block2_reply_stream(). It reads only the requested block through a
+ * @ref coap_block_read_t callback. Likewise, coap_block1_handle_stream()
+ * passes every received Block1 payload to a @ref coap_block_write_t callback
+ * together with its offset.
+ *
  * @{
  *
  * @file
@@ -181,7 +189,11 @@ extern "C" {
  * @name    Nanocoap specific maximum values
  * @{
  */
-#define NANOCOAP_NOPTS_MAX          (16)
+#ifndef NANOCOAP_NOPTS_MAX
+#define NANOCOAP_NOPTS_MAX          (16)    /**< Maximum number of options,
+                                             *   counting each instance of a
+                                             *   repeated option */
+#endif
 #define NANOCOAP_URI_MAX            (64)
 #define NANOCOAP_BLOCK_SIZE_EXP_MAX  (6)  /**< Maximum size for a blockwise
                                             *  transfer as power of 2 */
@@ -215,10 +227,14 @@ typedef struct __attribute__((packed)) {
 
 /**
  * @brief   CoAP option array entry
+ *
+ * There is one entry per option instance, in the order of the packet, so
+ * repeated options like URI_PATH occupy consecutive entries.
  */
 typedef struct {
     uint16_t opt_num;           /**< full CoAP option number    */
-    uint16_t offset;            /**< offset in packet           */
+    uint16_t offset;            /**< offset of value in packet  */
+    uint16_t len;               /**< length of value            */
 } coap_optpos_t;
 
 /**
@@ -272,6 +288,37 @@ typedef struct {
     uint8_t *opt;                   /**< Pointer to the placed option       */
 } coap_block_slicer_t;
 
+/**
+ * @brief   Reads part of a resource for a block-wise transfer
+ *
+ * @param[in]   arg     user argument passed along with the callback
+ * @param[in]   offset  offset into the resource
+ * @param[out]  buf     buffer to read to
+ * @param[in]   len     number of bytes to read
+ *
+ * @returns     number of bytes read, less than @p len only when the end of
+ *              the resource was reached
+ * @returns     <0 on error
+ */
+typedef ssize_t (*coap_block_read_t)(void *arg, size_t offset, void *buf,
+                                     size_t len);
+
+/**
+ * @brief   Stores part of a resource received in a block-wise transfer
+ *
+ * @param[in]   arg     user argument passed along with the callback
+ * @param[in]   offset  offset of @p buf in the resource
+ * @param[in]   buf     received data
+ * @param[in]   len     length of @p buf
+ * @param[in]   more    true if further blocks follow
+ *
+ * @returns     >=0 on success
+ * @returns     -ENOSPC if the resource does not fit
+ * @returns     <0 on other errors
+ */
+typedef ssize_t (*coap_block_write_t)(void *arg, size_t offset, const void *buf,
+                                      size_t len, bool more);
+
 /**
  * @brief   Global CoAP resource list
  */
@@ -615,6 +662,23 @@ ssize_t coap_opt_add_string(coap_pkt_t *pkt, uint16_t optnum, const char *string
  */
 ssize_t coap_opt_add_uint(coap_pkt_t *pkt, uint16_t optnum, uint32_t value);
 
+/**
+ * @brief   Encode the given opaque option into pkt
+ *
+ * @post pkt.payload advanced to first byte after option
+ * @post pkt.payload_len reduced by option length
+ *
+ * @param[in,out] pkt         pkt referencing target buffer
+ * @param[in]     optnum      option number to use
+ * @param[in]     val         option value
+ * @param[in]     val_len     length of @p val
+ *
+ * @return        number of bytes written to buffer
+ * @return        -ENOSPC if no available options
+ */
+ssize_t coap_opt_add_opaque(coap_pkt_t *pkt, uint16_t optnum,
+                            const uint8_t *val, size_t val_len);
+
 /**
  * @brief   Finalizes options as required and prepares for payload
  *
@@ -645,6 +709,20 @@ ssize_t coap_opt_finish(coap_pkt_t *pkt, uint16_t flags);
  */
 size_t coap_opt_put_block2(uint8_t *buf, uint16_t lastonum, coap_block_slicer_t *slicer, bool more);
 
+/**
+ * @brief   Get the value of a uint option
+ *
+ * @param[in]   pkt     packet to read from
+ * @param[in]   opt_num absolute option number
+ * @param[out]  target  the value; left unchanged if the packet does not
+ *                      contain the option
+ *
+ * @return      0 on success
+ * @return      -ENOSPC if the option is longer than 4 bytes
+ * @return      -1 if the packet does not contain the option
+ */
+int coap_get_option_uint(coap_pkt_t *pkt, unsigned opt_num, uint32_t *target);
+
 /**
  * @brief   Get content type from packet
  *
@@ -655,6 +733,22 @@ size_t coap_opt_put_block2(uint8_t *buf, uint16_t lastonum, coap_block_slicer_t
  */
 unsigned coap_get_content_type(coap_pkt_t *pkt);
 
+/**
+ * @brief   Get the value of the first instance of an option
+ *
+ * For opaque options like COAP_OPT_ETAG, or to read a string option without
+ * copying it. The value is not null terminated.
+ *
+ * @param[in]   pkt         packet to read from
+ * @param[in]   optnum      absolute option number
+ * @param[out]  value       start of the option value in the packet
+ *
+ * @return      length of the option value
+ * @return      -ENOENT if the packet does not contain the option
+ */
+ssize_t coap_opt_get_opaque(const coap_pkt_t *pkt, unsigned optnum,
+                            uint8_t **value);
+
 /**
  * @brief   Read a full option as null terminated string into the target buffer
  *
@@ -695,6 +789,22 @@ static inline ssize_t coap_get_uri_path(const coap_pkt_t *pkt, uint8_t *target)
                                NANOCOAP_URI_MAX, '/');
 }
 
+/**
+ * @brief   Compares the packet's URI_PATH with a path string
+ *
+ * The result is the same as of `strcmp()` on the string written by
+ * coap_get_uri_path(), but the URI is read in place from the options without
+ * copying it into a buffer.
+ *
+ * @param[in]   pkt     pkt to work on
+ * @param[in]   path    '\0'-terminated path to compare with, e.g. "/a/b"
+ *
+ * @returns     0 if the URI path equals @p path
+ * @returns     <0 if the URI path sorts before @p path
+ * @returns     >0 if the URI path sorts after @p path
+ */
+int coap_uri_path_cmp(const coap_pkt_t *pkt, const char *path);
+
 /**
  * @brief   Convenience function for getting the packet's URI_QUERY option
  *
@@ -836,6 +946,64 @@ size_t coap_blockwise_put_char(coap_block_slicer_t *slicer, uint8_t *bufpos, cha
 size_t coap_blockwise_put_bytes(coap_block_slicer_t *slicer, uint8_t *bufpos,
                                 const uint8_t *c, size_t len);
 
+/**
+ * @brief   Build reply to CoAP block2 request from a seekable resource
+ *
+ * Reads only the block requested in @p pkt with @p read_cb, instead of
+ * generating the whole resource up to that block. Without a block2 option in
+ * the request, the reply carries the first block of the largest size allowed
+ * by @ref NANOCOAP_BLOCK_SIZE_EXP_MAX. The block size is reduced to what fits
+ * into @p buf.
+ *
+ * Replies with 4.02 (Bad Option) for blocks beyond the end of the resource and
+ * with 5.00 (Internal Server Error) if @p read_cb fails.
+ *
+ * @note    @p read_cb is asked for one byte more than the block size, to
+ *          detect whether further blocks follow.
+ *
+ * @param[in]   pkt         packet to reply to
+ * @param[in]   code        reply code (e.g., COAP_CODE_205)
+ * @param[out]  buf         buffer to write reply to
+ * @param[in]   len         size of @p buf
+ * @param[in]   ct          content type of the resource
+ * @param[in]   read_cb     callback reading the resource
+ * @param[in]   arg         argument passed to @p read_cb
+ *
+ * @returns     size of reply packet on success
+ * @returns     <0 on error
+ */
+ssize_t coap_block2_reply_stream(coap_pkt_t *pkt, unsigned code,
+                                 uint8_t *buf, size_t len, unsigned ct,
+                                 coap_block_read_t read_cb, void *arg);
+
+/**
+ * @brief   Handle a CoAP block1 request and build the reply
+ *
+ * Passes the payload of @p pkt to @p write_cb, at the offset given by its
+ * block1 option (or zero for requests without the option). Replies with
+ * 2.31 (Continue) while further blocks follow and with @p code after the last
+ * one, echoing the block1 option.
+ *
+ * Replies with 4.00 (Bad Request) for an invalid block, with 4.13 (Request
+ * Entity Too Large) if @p write_cb returns -ENOSPC and with 5.00 (Internal
+ * Server Error) if it fails otherwise.
+ *
+ * @note    @p buf may be the buffer @p pkt was parsed from.
+ *
+ * @param[in]   pkt         packet to reply to
+ * @param[in]   code        reply code after the last block (e.g., COAP_CODE_204)
+ * @param[out]  buf         buffer to write reply to
+ * @param[in]   len         size of @p buf
+ * @param[in]   write_cb    callback storing the resource
+ * @param[in]   arg         argument passed to @p write_cb
+ *
+ * @returns     size of reply packet on success
+ * @returns     <0 on error
+ */
+ssize_t coap_block1_handle_stream(coap_pkt_t *pkt, unsigned code,
+                                  uint8_t *buf, size_t len,
+                                  coap_block_write_t write_cb, void *arg);
+
 /**
  * @brief   Helper to decode SZX value to size in bytes
  *
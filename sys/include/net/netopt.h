@@ -554,6 +554,24 @@ typedef enum {
      */
     NETOPT_PHY_BUSY,
 
+    /**
+     * @brief   (uint8_t) checksums the device calculates for outgoing
+     *          frames, as OR of @ref netopt_csum_offload_t values (get only)
+     *
+     * The network stack leaves the checksum fields of these protocols zero
+     * and the device fills them in.
+     */
+    NETOPT_CSUM_OFFLOAD_TX,
+
+    /**
+     * @brief   (uint8_t) checksums the device verifies for incoming frames,
+     *          as OR of @ref netopt_csum_offload_t values (get only)
+     *
+     * The device must drop frames where a checksum it verifies is wrong. The
+     * network stack then skips the verification in software.
+     */
+    NETOPT_CSUM_OFFLOAD_RX,
+
     /* add more options if needed */
 
     /**
@@ -606,6 +624,16 @@ typedef enum {
     NETOPT_RF_TESTMODE_CTX_PRBS9,   /**< PRBS9 continuous tx mode */
 } netopt_rf_testmode_t;
 
+/**
+ * @brief   Checksums for @ref NETOPT_CSUM_OFFLOAD_TX and
+ *          @ref NETOPT_CSUM_OFFLOAD_RX
+ */
+typedef enum {
+    NETOPT_CSUM_OFFLOAD_UDP     = 0x01, /**< UDP checksum */
+    NETOPT_CSUM_OFFLOAD_TCP     = 0x02, /**< TCP checksum */
+    NETOPT_CSUM_OFFLOAD_ICMPV6  = 0x04, /**< ICMPv6 checksum */
+} netopt_csum_offload_t;
+
 /**
  * @brief   Get a string ptr corresponding to opt, for debugging
  *
@@ -19,8 +19,11 @@
  *
  * # Design Decisions and Limitations
  * - support for local addresses only (using `luid` to generate them)
- * - advertising interval is configured during compile time, override by setting
- *   `CFLAGS+=-DSKALD_INTERVAL=xxx`
+ * - the default advertising interval is configured during compile time,
+ *   override by setting `CFLAGS+=-DSKALD_INTERVAL=xxx`, or set the interval
+ *   of each context with its `interval` field
+ * - multiple contexts advertise at the same time, their advertising events
+ *   are scheduled with a single timer in the order of their deadlines
  * - advertising channels are configured during compile time, override by
  *   setting `CFLAGS+=-DSKALD_ADV_CHAN={37,39}`
  *
@@ -78,10 +81,13 @@ typedef struct {
 /**
  * @brief   Advertising context holding the advertising data and state
  */
-typedef struct {
+typedef struct skald_ctx {
     netdev_ble_pkt_t pkt;   /**< packet holding the advertisement (GAP) data */
-    xtimer_t timer;         /**< timer for scheduling advertising events */
-    uint32_t last;          /**< last timer trigger (for offset compensation) */
+    struct skald_ctx *next; /**< next context waiting for its event */
+    uint32_t interval;      /**< advertising interval in us, 0 for
+                             *   SKALD_INTERVAL */
+    uint32_t deadline;      /**< start of the next advertising event */
+    uint32_t last;          /**< start of the last advertising event */
     uint8_t cur_chan;       /**< keep track of advertising channels */
 } skald_ctx_t;
 
@@ -93,8 +99,11 @@ void skald_init(void);
 /**
  * @brief   Start advertising the given packet
  *
- * The packet will be send out each advertising interval (see SKALD_INTERVAL) on
- * each of the defined advertising channels (see SKALD_ADV_CHAN).
+ * The packet will be send out each advertising interval of the context (see
+ * SKALD_INTERVAL for the default) on each of the defined advertising channels
+ * (see SKALD_ADV_CHAN). A random delay of up to 10ms is added to each
+ * interval. If the events of two contexts overlap, the later one is delayed
+ * until the radio is free again.
  *
  * @param[in,out] ctx   start advertising this context
  */
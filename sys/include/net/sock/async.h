@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async  Asynchronous sock notifications
+ * @ingroup     net_sock
+ * @brief       Readiness notifications for sock objects
+ *
+ * With the `sock_async` module, a callback can be set on a sock object with
+ * e.g. sock_udp_set_cb(). The stack calls it whenever the sock becomes ready,
+ * so a single thread can serve many socks without blocking in one of them,
+ * e.g. by forwarding the callback to an @ref sys_event queue or by setting a
+ * thread flag.
+ *
+ * The callback is called in the context of the network stack. It must not
+ * block, and it must not receive from the sock itself.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Types of the asynchronous sock notifications
+ */
+#ifndef NET_SOCK_ASYNC_H
+#define NET_SOCK_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Events reported to the callback of a sock
+ */
+typedef enum {
+    /**
+     * @brief   A message was received and can be read without blocking
+     *
+     * Reported once for every message.
+     */
+    SOCK_ASYNC_MSG_RECV = 0x01,
+} sock_async_flags_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_H */
+/** @} */
@@ -61,6 +61,27 @@ typedef struct {
 #define SOCK_DNS_QUERYBUF_LEN   (sizeof(sock_dns_hdr_t) + 4 + SOCK_DNS_MAX_NAME_LEN)
 /** @} */
 
+/**
+ * @brief   Number of results module `sock_dns_cache` keeps
+ */
+#ifndef SOCK_DNS_CACHE_SIZE
+#define SOCK_DNS_CACHE_SIZE     (4)
+#endif
+
+/**
+ * @brief   Maximum time in seconds a result is cached, whatever its TTL
+ */
+#ifndef SOCK_DNS_CACHE_TTL_MAX
+#define SOCK_DNS_CACHE_TTL_MAX  (86400U)
+#endif
+
+/**
+ * @brief   Time in seconds it is cached that a name has no record of a type
+ */
+#ifndef SOCK_DNS_CACHE_NEG_TTL
+#define SOCK_DNS_CACHE_NEG_TTL  (60U)
+#endif
+
 /**
  * @brief Get IP address for DNS name
  *
@@ -70,8 +91,13 @@ typedef struct {
  * By supplying AF_INET, AF_INET6 or AF_UNSPEC in @p family requesting of A
  * records (IPv4), AAAA records (IPv6) or both can be selected.
  *
- * This function will return the first DNS record it receives. IF both A and
- * AAAA are requested, AAAA will be preferred.
+ * If both A and AAAA are requested, both queries are sent at once and AAAA
+ * will be preferred.
+ *
+ * With module `sock_dns_cache`, results are cached for the TTL of the record,
+ * and the fact that a name has no record of a type for
+ * @ref SOCK_DNS_CACHE_NEG_TTL. The function may be called from several
+ * threads at the same time; each call uses its own sock.
  *
  * @note @p addr_out needs to provide space for any possible result!
  *       (4byte when family==AF_INET, 16byte otherwise)
@@ -80,8 +106,11 @@ typedef struct {
  * @param[out]  addr_out        buffer to write result into
  * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
  *
- * @return      0 on success
- * @return      !=0 otherwise
+ * @return      length of the address on success
+ * @return      -EHOSTUNREACH, if the name has no record of the requested
+ *              type(s)
+ * @return      -ETIMEDOUT, if the server did not answer
+ * @return      <0 on other errors
  */
 int sock_dns_query(const char *domain_name, void *addr_out, int family);
 
@@ -274,6 +274,7 @@
 #include <sys/types.h>
 
 #include "net/sock.h"
+#include "net/sock/async.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -435,6 +436,8 @@ ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
  *                      end point of @p sock provides this information.
  *
  * @return  The number of bytes sent on success.
+ * @return  -EAGAIN, if the send queue of the interface is full, so the packet
+ *          would be dropped (depends on the stack).
  * @return  -EAFNOSUPPORT, if `remote != NULL` and sock_ip_ep_t::family of
  *          @p remote is != AF_UNSPEC and not supported.
  * @return  -EINVAL, if sock_ip_ep_t::addr of @p remote is an invalid address.
@@ -450,6 +453,33 @@ ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
 ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
                      uint8_t proto, const sock_ip_ep_t *remote);
 
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Callback for the readiness notifications of a raw IPv4/IPv6 sock
+ *
+ * @param[in] sock  The sock the event happened on.
+ * @param[in] flags The events, see @ref sock_async_flags_t.
+ * @param[in] arg   The argument given to sock_ip_set_cb().
+ */
+typedef void (*sock_ip_cb_t)(sock_ip_t *sock, sock_async_flags_t flags,
+                             void *arg);
+
+/**
+ * @brief   Sets the readiness callback of a raw IPv4/IPv6 sock
+ *
+ * Messages received before the callback was set are reported right away.
+ *
+ * @note    Only available with module `sock_async`.
+ *
+ * @pre `sock != NULL`, @p sock was created with sock_ip_create().
+ *
+ * @param[in] sock  A raw IPv4/IPv6 sock object.
+ * @param[in] cb    The callback, NULL to disable the notifications.
+ * @param[in] arg   Argument passed to @p cb.
+ */
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *arg);
+#endif
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
@@ -273,7 +273,9 @@
 #include <stdlib.h>
 #include <sys/types.h>
 
+#include "iolist.h"
 #include "net/sock.h"
+#include "net/sock/async.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -289,6 +291,18 @@ typedef struct _sock_tl_ep sock_udp_ep_t;   /**< An end point for a UDP sock obj
  */
 typedef struct sock_udp sock_udp_t;
 
+/**
+ * @brief   A UDP message for sock_udp_recv_batch() and sock_udp_send_batch()
+ */
+typedef struct {
+    void *data;                 /**< Data to send or buffer to receive to */
+    size_t len;                 /**< Length of data to send or space at
+                                 *   sock_udp_msg_t::data; set to the number
+                                 *   of bytes received on receive */
+    sock_udp_ep_t *remote;      /**< Remote end point to send to or
+                                 *   of the received data; may be `NULL` */
+} sock_udp_msg_t;
+
 /**
  * @brief   Creates a new UDP sock object
  *
@@ -402,6 +416,48 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+/**
+ * @brief   Provides stack-internal buffer space containing a UDP message from
+ *          a remote end point
+ *
+ * Unlike sock_udp_recv(), the message is not copied, but @p data points to
+ * it within the buffer of the network stack. After the message was
+ * processed, call this function again with the same @p buf_ctx to release
+ * the buffer:
+ *
+ * ~~~~~~~~~~~~~~~~~~~ {.c}
+ * void *data, *ctx = NULL;
+ * ssize_t res = sock_udp_recv_buf(sock, &data, &ctx, SOCK_NO_TIMEOUT, NULL);
+ * if (res >= 0) {
+ *     parse(data, res);
+ *     sock_udp_recv_buf(sock, &data, &ctx, 0, NULL);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~
+ *
+ * @note    Only provided by the GNRC implementation of sock.
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] data     Pointer to the received data; only valid until the
+ *                      buffer is released. Must not be written to, as the
+ *                      buffer may be shared with other receivers.
+ * @param[in,out] buf_ctx   Buffer context; must be `NULL` to receive a
+ *                      message. If not `NULL`, the buffer it refers to is
+ *                      released instead and @p buf_ctx is set to `NULL`.
+ * @param[in] timeout   Timeout for receive in microseconds.
+ *                      May be @ref SOCK_NO_TIMEOUT.
+ * @param[out] remote   Remote end point of the received data.
+ *                      May be `NULL`, if it is not required by the application.
+ *
+ * @return  The number of bytes received on success; @p buf_ctx is set
+ *          then, also for an empty message.
+ * @return  0, if a buffer was released.
+ * @return  The errors of sock_udp_recv(), except -ENOBUFS.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -420,6 +476,8 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
  *                      sock_udp_ep_t::port may not be 0.
  *
  * @return  The number of bytes sent on success.
+ * @return  -EAGAIN, if the send queue of the interface is full, so the packet
+ *          would be dropped (depends on the stack).
  * @return  -EADDRINUSE, if `sock` has no local end-point or was `NULL` and the
  *          pool of available ephemeral ports is depleted.
  * @return  -EAFNOSUPPORT, if `remote != NULL` and sock_udp_ep_t::family of
@@ -438,6 +496,98 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Sends a UDP message, gathered from several buffers, to remote end
+ *          point
+ *
+ * Same as sock_udp_send(), but the payload is the concatenation of all
+ * entries of @p snips, so e.g. a header and a payload do not need to be
+ * copied to a common buffer first.
+ *
+ * @pre `((sock != NULL || remote != NULL))`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ * @param[in] snips     List of payload chunks, may be `NULL` for an empty
+ *                      message.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  The same errors as sock_udp_send().
+ */
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote);
+
+/**
+ * @brief   Receives several UDP messages at once
+ *
+ * Waits up to @p timeout for the first message like sock_udp_recv(), then
+ * receives further messages that are already waiting, without blocking, until
+ * @p count messages are received. A message that fails to be received after
+ * the first one ends the batch; it is dropped, as sock_udp_recv() would.
+ *
+ * @pre `(sock != NULL) && (msgs != NULL) && (count > 0)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in,out] msgs  Buffers for the messages; sock_udp_msg_t::len is set
+ *                      to the number of bytes received.
+ * @param[in] count     Number of entries in @p msgs.
+ * @param[in] timeout   Timeout for the first message in microseconds.
+ *                      May be @ref SOCK_NO_TIMEOUT.
+ *
+ * @return  The number of messages received on success.
+ * @return  The errors of sock_udp_recv(), if the first message could not be
+ *          received.
+ */
+ssize_t sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                            size_t count, uint32_t timeout);
+
+/**
+ * @brief   Sends several UDP messages at once
+ *
+ * Stops at the first message that can not be sent.
+ *
+ * @pre `(msgs != NULL) && (count > 0)`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`, if all messages
+ *                      have a remote end point.
+ * @param[in] msgs      The messages.
+ * @param[in] count     Number of entries in @p msgs.
+ *
+ * @return  The number of messages sent on success.
+ * @return  The errors of sock_udp_send(), if the first message could not be
+ *          sent.
+ */
+ssize_t sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                            size_t count);
+
+#if defined(MODULE_SOCK_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Callback for the readiness notifications of a UDP sock
+ *
+ * @param[in] sock  The sock the event happened on.
+ * @param[in] flags The events, see @ref sock_async_flags_t.
+ * @param[in] arg   The argument given to sock_udp_set_cb().
+ */
+typedef void (*sock_udp_cb_t)(sock_udp_t *sock, sock_async_flags_t flags,
+                              void *arg);
+
+/**
+ * @brief   Sets the readiness callback of a UDP sock
+ *
+ * Messages received before the callback was set are reported right away.
+ *
+ * @note    Only available with module `sock_async`.
+ *
+ * @pre `sock != NULL`, @p sock was created with sock_udp_create().
+ *
+ * @param[in] sock  A UDP sock object.
+ * @param[in] cb    The callback, NULL to disable the notifications.
+ * @param[in] arg   Argument passed to @p cb.
+ */
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *arg);
+#endif
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
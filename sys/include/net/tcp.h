@@ -43,6 +43,9 @@ extern "C" {
 #define TCP_OPTION_KIND_EOL (0x00)  /**< "End of List"-Option */
 #define TCP_OPTION_KIND_NOP (0x01)  /**< "No Operatrion"-Option */
 #define TCP_OPTION_KIND_MSS (0x02)  /**< "Maximum Segment Size"-Option */
+#define TCP_OPTION_KIND_WND_SCALE (0x03)    /**< "Window Scale"-Option */
+#define TCP_OPTION_KIND_SACK_PERM (0x04)    /**< "SACK Permitted"-Option */
+#define TCP_OPTION_KIND_SACK      (0x05)    /**< "Selective Acknowledgment"-Option */
 /** @} */
 
 /**
@@ -50,8 +53,25 @@ extern "C" {
  * @{
  */
 #define TCP_OPTION_LENGTH_MSS (0x04)  /**< MSS Option Size always 4 */
+#define TCP_OPTION_LENGTH_WND_SCALE (0x03)  /**< Window Scale Option Size always 3 */
+#define TCP_OPTION_LENGTH_SACK_PERM (0x02)  /**< SACK Permitted Option Size always 2 */
 /** @} */
 
+/**
+ * @brief Maximum shift count of the "Window Scale"-Option
+ *
+ * @see [RFC 7323, section 2.3](https://tools.ietf.org/html/rfc7323#section-2.3)
+ */
+#define TCP_WND_SCALE_MAX (14U)
+
+/**
+ * @brief Maximum number of blocks in a "Selective Acknowledgment"-Option
+ *        without timestamps
+ *
+ * @see [RFC 2018, section 3](https://tools.ietf.org/html/rfc2018#section-3)
+ */
+#define TCP_SACK_BLOCKS_MAX (4U)
+
 /**
  * @brief TCP header definition
  */
@@ -37,6 +37,8 @@
 
 #include <stdint.h>
 
+#include "cbor_enc.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -211,6 +213,24 @@ char phydat_prefix_from_scale(int8_t scale);
  */
 void phydat_fit(phydat_t *dat, const int32_t *values, unsigned int dim);
 
+/**
+ * @brief   Writes the given data container as CBOR
+ *
+ * The data is written as a map with the key `"v"` for an array of the @p dim
+ * values and, if phydat_unit_to_str() knows the unit, the key `"u"` for its
+ * name. Each value is written as an integer if the scale is 0, otherwise as a
+ * decimal fraction (tag 4) with the scale as exponent, so no precision is
+ * lost. E.g. 21.5 °C
+ * becomes `{"v": [4([-1, 215])], "u": "°C"}`, which takes 15 bytes.
+ *
+ * Needs the `phydat_cbor` module.
+ *
+ * @param[in]     data  data container to write
+ * @param[in]     dim   number of dimensions of @p data to write
+ * @param[in,out] enc   encoder to write to
+ */
+void phydat_to_cbor(const phydat_t *data, uint8_t dim, cbor_enc_t *enc);
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,19 @@
  *
  * In order to use this module, you'll need to implement pm_set().
  *
+ * With the `pm_layered_governor` module, the idle thread additionally
+ * considers the time until the next xtimer timer fires: a mode is only
+ * entered if that time is at least @ref PM_LAYERED_RESIDENCY_FACTOR times the
+ * mode's latency given in @ref PM_LATENCY_US, as entering and leaving it
+ * would otherwise cost more energy than it saves and delay the timer.
+ * Otherwise, the next shallower mode is checked. The governor also records
+ * how often and how long each mode was used, see pm_layered_stats().
+ *
+ * Modes up to @ref PM_TIMER_STOP_MODE stop the xtimer timer. With the
+ * `xtimer_tickless` module, the RTT keeps the time while in these modes, see
+ * xtimer_tickless_suspend(). If the next timer is too close for that, the
+ * governor uses the next mode above @ref PM_TIMER_STOP_MODE instead.
+ *
  * @file
  * @brief       Layered low power mode infrastructure
  *
@@ -34,6 +47,8 @@
 #ifndef PM_LAYERED_H
 #define PM_LAYERED_H
 
+#include <stdint.h>
+
 #include "assert.h"
 #include "periph_cpu.h"
 
@@ -49,6 +64,43 @@ extern "C" {
 #define PROVIDES_PM_SET_LOWEST
 #endif
 
+/**
+ * @brief   Latency of entering and leaving each power mode in microseconds
+ *
+ * CPUs define this in periph_cpu.h as initializer of an array of
+ * PM_NUM_MODES values, starting with mode 0. The default of all zeros lets
+ * the governor always select the lowest unblocked mode.
+ */
+#ifndef PM_LATENCY_US
+#define PM_LATENCY_US                   { 0 }
+#endif
+
+/**
+ * @brief   Highest power mode that stops the xtimer timer
+ *
+ * Only used with the `xtimer_tickless` module.
+ */
+#ifndef PM_TIMER_STOP_MODE
+#define PM_TIMER_STOP_MODE              (0U)
+#endif
+
+/**
+ * @brief   Minimum time until the next timer, as a multiple of a mode's
+ *          latency, to enter the mode
+ */
+#ifndef PM_LAYERED_RESIDENCY_FACTOR
+#define PM_LAYERED_RESIDENCY_FACTOR     (2U)
+#endif
+
+/**
+ * @brief   Usage of a power mode, recorded by the governor
+ */
+typedef struct {
+    uint32_t count;             /**< number of times the mode was entered */
+    uint64_t residency_us;      /**< time spent in the mode, including the
+                                     interrupts handled when waking up */
+} pm_layered_stats_t;
+
 /**
  * @brief   Block a power mode
  *
@@ -75,6 +127,17 @@ void pm_unblock(unsigned mode);
  */
 void pm_set(unsigned mode);
 
+/**
+ * @brief   Get the usage statistics of the power modes
+ *
+ * Only available with the `pm_layered_governor` module. The times are taken
+ * with xtimer, so they are only accurate for modes xtimer keeps running in.
+ *
+ * @return  array of PM_NUM_MODES + 1 entries, the last one being the idle
+ *          mode
+ */
+const pm_layered_stats_t *pm_layered_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
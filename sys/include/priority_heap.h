@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_priority_heap Priority heap
+ * @ingroup     sys
+ * @brief       Priority queue for many elements, as a pairing heap
+ *
+ * Offers the semantics of @ref priority_queue_t, i.e. lower values have a
+ * higher priority and elements of equal priority leave in the order they were
+ * added. Unlike the sorted list of @ref priority_queue_t, adding takes
+ * constant time and removing an element amortized logarithmic time, so it
+ * scales to queues of hundreds of elements, at the cost of three pointers
+ * and a sequence number per node.
+ *
+ * Nodes are allocated by the user, as for @ref priority_queue_t.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Priority heap definitions
+ */
+#ifndef PRIORITY_HEAP_H
+#define PRIORITY_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Node of a priority heap
+ */
+typedef struct priority_heap_node {
+    struct priority_heap_node *next;    /**< next sibling */
+    uint32_t priority;                  /**< node priority, lower first */
+    unsigned int data;                  /**< node data */
+    struct priority_heap_node *child;   /**< first child */
+    struct priority_heap_node *prev;    /**< previous sibling, or parent of
+                                             the first child */
+    uint32_t seq;                       /**< order of adding */
+} priority_heap_node_t;
+
+/**
+ * @brief   Priority heap
+ */
+typedef struct {
+    priority_heap_node_t *root;         /**< node of the highest priority */
+    uint32_t seq;                       /**< sequence number of the next node */
+    unsigned numof;                     /**< number of nodes */
+} priority_heap_t;
+
+/**
+ * @brief   Static initializer for priority_heap_node_t
+ */
+#define PRIORITY_HEAP_NODE_INIT { NULL, 0, 0, NULL, NULL, 0 }
+
+/**
+ * @brief   Static initializer for priority_heap_t
+ */
+#define PRIORITY_HEAP_INIT { NULL, 0, 0 }
+
+/**
+ * @brief   Initialize a priority heap node
+ *
+ * @param[out] node     node to initialize
+ */
+static inline void priority_heap_node_init(priority_heap_node_t *node)
+{
+    priority_heap_node_t n = PRIORITY_HEAP_NODE_INIT;
+    *node = n;
+}
+
+/**
+ * @brief   Initialize a priority heap
+ *
+ * @param[out] heap     heap to initialize
+ */
+static inline void priority_heap_init(priority_heap_t *heap)
+{
+    priority_heap_t h = PRIORITY_HEAP_INIT;
+    *heap = h;
+}
+
+/**
+ * @brief   Get the node of the highest priority without removing it
+ *
+ * @param[in] heap      heap to operate on
+ *
+ * @return  the head, NULL if @p heap is empty
+ */
+static inline priority_heap_node_t *priority_heap_head(const priority_heap_t *heap)
+{
+    return heap->root;
+}
+
+/**
+ * @brief   Get the number of nodes of a heap
+ *
+ * @param[in] heap      heap to operate on
+ *
+ * @return  number of nodes
+ */
+static inline unsigned priority_heap_len(const priority_heap_t *heap)
+{
+    return heap->numof;
+}
+
+/**
+ * @brief   Add a node to a heap, behind the nodes of the same priority
+ *
+ * @param[in,out] heap      heap to operate on
+ * @param[in]     node      node to add, with priority and data set
+ *
+ * @pre The heap does not already contain @p node.
+ */
+void priority_heap_add(priority_heap_t *heap, priority_heap_node_t *node);
+
+/**
+ * @brief   Remove the node of the highest priority
+ *
+ * @param[in,out] heap      heap to operate on
+ *
+ * @return  the old head, NULL if @p heap is empty
+ */
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *heap);
+
+/**
+ * @brief   Remove a node from a heap
+ *
+ * @param[in,out] heap      heap to operate on
+ * @param[in]     node      node of @p heap to remove
+ */
+void priority_heap_remove(priority_heap_t *heap, priority_heap_node_t *node);
+
+/**
+ * @brief   Find the node of the lowest priority, i.e. the one that would be
+ *          removed last
+ *
+ * Takes time linear in the number of nodes.
+ *
+ * @param[in] heap      heap to operate on
+ *
+ * @return  the last node, NULL if @p heap is empty
+ */
+priority_heap_node_t *priority_heap_last(const priority_heap_t *heap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIORITY_HEAP_H */
+/** @} */
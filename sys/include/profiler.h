@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_profiler Sampling profiler
+ * @ingroup     sys
+ * @brief       Samples the program counter periodically
+ *
+ * The `profiler` module uses a channel of a peripheral timer that is not used
+ * otherwise to interrupt the CPU every @ref PROFILER_INTERVAL timer ticks.
+ * Each time, the program counter of the interrupted thread is recorded
+ * together with the PID of the thread. Equal samples are counted in a table
+ * of @ref PROFILER_SLOTS entries, so a long run does not take more memory.
+ * Unlike @ref sys_tracing, no code needs to be instrumented.
+ *
+ * On Cortex-M, the program counter is read from the exception stack frame of
+ * the thread. Samples that interrupted another interrupt handler are only
+ * counted, as the timer interrupt does not know their stack frame. On native,
+ * the program counter is the one saved by the signal handler.
+ *
+ * The timer must not be the one used by xtimer, so @ref PROFILER_TIMER
+ * defaults to `TIMER_DEV(1)`. Boards with a single timer, like native, can
+ * not be profiled without moving xtimer to another timer.
+ *
+ * The `prof dump` shell command or profiler_dump() print one line
+ * `<pid> 0x<pc> <count>` per sample. The addresses can be resolved with e.g.
+ *
+ *     awk '/^[0-9]+ 0x/ {print $2}' dump.txt | arm-none-eabi-addr2line -f -e app.elf
+ *
+ * @{
+ *
+ * @file
+ * @brief       Sampling profiler definitions
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+#include "periph/timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Timer used for sampling
+ */
+#ifndef PROFILER_TIMER
+#define PROFILER_TIMER          TIMER_DEV(1)
+#endif
+
+/**
+ * @brief   Channel of @ref PROFILER_TIMER used for sampling
+ */
+#ifndef PROFILER_TIMER_CHAN
+#define PROFILER_TIMER_CHAN     (0)
+#endif
+
+/**
+ * @brief   Frequency @ref PROFILER_TIMER is run at
+ */
+#ifndef PROFILER_TIMER_FREQ
+#define PROFILER_TIMER_FREQ     (1000000LU)
+#endif
+
+/**
+ * @brief   Timer ticks between two samples
+ *
+ * Choose an interval that is not a multiple of the period of regular events
+ * in the application, otherwise the samples are biased towards them.
+ */
+#ifndef PROFILER_INTERVAL
+#define PROFILER_INTERVAL       (997U)
+#endif
+
+/**
+ * @brief   Number of distinct samples that can be counted
+ *
+ * Must be a power of two.
+ */
+#ifndef PROFILER_SLOTS
+#define PROFILER_SLOTS          (256U)
+#endif
+
+/**
+ * @brief   Initializes the timer and starts sampling
+ *
+ * Called by auto_init.
+ *
+ * @return  0 on success
+ * @return  -1 if @ref PROFILER_TIMER could not be initialized
+ */
+int profiler_init(void);
+
+/**
+ * @brief   Starts sampling
+ */
+void profiler_start(void);
+
+/**
+ * @brief   Stops sampling
+ */
+void profiler_stop(void);
+
+/**
+ * @brief   Clears all samples
+ */
+void profiler_reset(void);
+
+/**
+ * @brief   Prints the samples
+ *
+ * Sampling is paused while printing. Besides the samples, the number of
+ * samples taken in interrupt context and the number of samples that did not
+ * fit into the table are printed.
+ */
+void profiler_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROFILER_H */
+/** @} */
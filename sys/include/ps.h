@@ -32,6 +32,16 @@ extern "C" {
  */
 void ps(void);
 
+/**
+ * @brief Print wakeup latency and preemption statistics of all active
+ *        threads to stdout.
+ *
+ * Only available with the `schedstatistics` module.  Latencies are printed in
+ * xtimer ticks, the histogram columns are the log2 buckets described at
+ * @ref SCHEDSTAT_LATENCY_BUCKETS, trailing empty buckets are omitted.
+ */
+void ps_latency(void);
+
 #ifdef __cplusplus
 }
 #endif
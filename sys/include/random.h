@@ -22,6 +22,10 @@
  *  - Simple Park-Miller PRNG
  *  - Musl C PRNG
  *  - Fortuna (CS)PRNG
+ *  - ChaCha20 CSPRNG
+ *
+ * All generators are seeded on start-up, from the hardware RNG if
+ * `periph_hwrng` is used, else from `puf_sram` or the CPU ID.
  */
 
 #ifndef RANDOM_H
@@ -42,6 +46,21 @@ extern "C" {
 #define RANDOM_SEED_DEFAULT (1)
 #endif
 
+#ifndef RANDOM_SEED_HWRNG_WORDS
+/**
+ * @brief   Words of seed read from the hardware RNG on start-up
+ */
+#define RANDOM_SEED_HWRNG_WORDS (8)
+#endif
+
+#ifndef PRNG_CHACHA20_RESEED_INTERVAL
+/**
+ * @brief   Bytes of output after which the ChaCha20 CSPRNG mixes in entropy
+ *          from the hardware RNG, if `periph_hwrng` is used
+ */
+#define PRNG_CHACHA20_RESEED_INTERVAL (4096U)
+#endif
+
 /**
  * @brief Enables support for floating point random number generation
  */
@@ -79,6 +98,10 @@ uint32_t random_uint32(void);
 
 /**
  * @brief writes random bytes in the [0,0xff]-interval to memory
+ *
+ * Generators producing blocks of bytes, i.e. Fortuna, SHA1PRNG and ChaCha20,
+ * fill @p buf from their native output, which is considerably cheaper than
+ * calling random_uint32() repeatedly.
  */
 void random_bytes(uint8_t *buf, size_t size);
 
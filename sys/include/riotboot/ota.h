@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_riotboot_ota Streaming firmware image writer
+ * @ingroup     sys
+ * @brief       Writes compressed and delta encoded images to flash pages
+ *
+ * The writer takes an image in chunks as they arrive, e.g. from the network,
+ * and writes it page by page with flashpage_write() to a range of flash
+ * pages. Two encodings shrink the data to transfer:
+ *
+ * - @ref RIOTBOOT_OTA_COMPRESSED: the data is compressed with
+ *   @ref pkg_heatshrink, using the window and lookahead sizes the package is
+ *   built with (`heatshrink -e -w 8 -l 4`). Requires `USEPKG += heatshrink`.
+ * - @ref RIOTBOOT_OTA_DELTA: the (decompressed) data is a sequence of
+ *   operations building the image from a source image, typically the one
+ *   running:
+ *
+ * @code {unparsed}
+ * copy:   | 0x01 | length (le32) | source offset (le32) |
+ * insert: | 0x02 | length (le32) | bytes ... |
+ * @endcode
+ *
+ * The SHA-256 digest of the image is computed while writing, and checked by
+ * riotboot_ota_finish(). The first bytes of the image, which hold the
+ * @ref riotboot_hdr_t, are written last, so an incomplete or corrupted image
+ * is never found by the bootloader.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static riotboot_ota_t ota;
+ *
+ * riotboot_ota_init(&ota, SLOT1_PAGE, SLOT1_PAGES,
+ *                   RIOTBOOT_OTA_COMPRESSED | RIOTBOOT_OTA_DELTA,
+ *                   flashpage_addr(SLOT0_PAGE), SLOT0_PAGES * FLASHPAGE_SIZE);
+ * while ((len = receive(buf, sizeof(buf))) > 0) {
+ *     riotboot_ota_write(&ota, buf, len);
+ * }
+ * if (riotboot_ota_finish(&ota, digest) == 0) {
+ *     pm_reboot();
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Streaming firmware image writer definitions
+ */
+
+#ifndef RIOTBOOT_OTA_H
+#define RIOTBOOT_OTA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hashes/sha256.h"
+#include "periph/flashpage.h"
+#include "riotboot/hdr.h"
+#ifdef MODULE_HEATSHRINK
+#include "heatshrink_decoder.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Encodings of the data passed to riotboot_ota_write()
+ * @{
+ */
+#define RIOTBOOT_OTA_COMPRESSED (0x01)  /**< heatshrink compressed */
+#define RIOTBOOT_OTA_DELTA      (0x02)  /**< delta against a source image */
+/** @} */
+
+/**
+ * @name    Operations of delta encoded data
+ * @{
+ */
+#define RIOTBOOT_OTA_OP_COPY    (0x01)  /**< copy from the source image */
+#define RIOTBOOT_OTA_OP_INSERT  (0x02)  /**< insert the following bytes */
+/** @} */
+
+/**
+ * @brief   Maximum length of an operation header
+ */
+#define RIOTBOOT_OTA_OP_HDR_MAX (9U)
+
+/**
+ * @brief   Number of bytes at the start of the image written last
+ */
+#define RIOTBOOT_OTA_HOLD       (sizeof(riotboot_hdr_t))
+
+/**
+ * @brief   Image writer state
+ */
+typedef struct {
+    sha256_context_t sha;               /**< digest of the image */
+#if defined(MODULE_HEATSHRINK) || defined(DOXYGEN)
+    heatshrink_decoder hsd;             /**< decompressor */
+#endif
+    const uint8_t *src;                 /**< source image of a delta */
+    size_t src_len;                     /**< length of @p src */
+    unsigned first;                     /**< first page written to */
+    unsigned numof;                     /**< number of pages written to */
+    unsigned flags;                     /**< encodings of the data */
+    uint32_t offset;                    /**< bytes of the image written */
+    uint32_t insert;                    /**< bytes left of an insert */
+    uint8_t op[RIOTBOOT_OTA_OP_HDR_MAX];/**< header of the next operation */
+    uint8_t op_len;                     /**< bytes of the header received */
+    uint8_t hold[RIOTBOOT_OTA_HOLD];    /**< start of the image */
+    /** page being filled */
+    uint32_t page[FLASHPAGE_SIZE / sizeof(uint32_t)];
+} riotboot_ota_t;
+
+/**
+ * @brief   Starts writing an image
+ *
+ * The first page is erased at once, the others when they are written.
+ *
+ * @param[out] ota      writer state
+ * @param[in]  first    first flash page of the image
+ * @param[in]  numof    number of pages available for the image
+ * @param[in]  flags    encodings of the data, RIOTBOOT_OTA_* flags
+ * @param[in]  src      source image of a delta, may be NULL without
+ *                      @ref RIOTBOOT_OTA_DELTA
+ * @param[in]  src_len  length of @p src
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP if @ref RIOTBOOT_OTA_COMPRESSED is given without
+ *          heatshrink
+ * @return  -EINVAL on invalid pages
+ */
+int riotboot_ota_init(riotboot_ota_t *ota, unsigned first, unsigned numof,
+                      unsigned flags, const void *src, size_t src_len);
+
+/**
+ * @brief   Writes the next chunk of data
+ *
+ * @param[in]  ota      writer state
+ * @param[in]  data     data as received
+ * @param[in]  len      length of @p data
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the data is malformed
+ * @return  -EFBIG if the image does not fit into the pages
+ * @return  -EIO if writing the flash failed
+ */
+int riotboot_ota_write(riotboot_ota_t *ota, const void *data, size_t len);
+
+/**
+ * @brief   Completes the image
+ *
+ * Writes the remaining data and, if the digest matches, the start of the
+ * image.
+ *
+ * @param[in]  ota      writer state
+ * @param[in]  digest   expected SHA-256 digest of the image
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the data ended in the middle of an operation, or the
+ *          image is shorter than its header
+ * @return  -EBADMSG if the digest does not match
+ * @return  -EIO if writing the flash failed
+ */
+int riotboot_ota_finish(riotboot_ota_t *ota,
+                        const uint8_t digest[SHA256_DIGEST_LENGTH]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RIOTBOOT_OTA_H */
+/** @} */
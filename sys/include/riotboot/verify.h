@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_riotboot_verify Cached image verification
+ * @ingroup     sys
+ * @brief       Verifies an image by its SHA-256 digest once, and by a MAC
+ *              protected marker on later boots
+ *
+ * Hashing a whole slot takes long on large images. After the first full
+ * verification, riotboot_verify() fills a marker: the digest of the image and
+ * an HMAC-SHA256, keyed with a device secret, over the digest, the header and
+ * the length of the image. The caller stores the marker, e.g. in a flash page
+ * of its own. On later boots only the MAC of the marker is checked, which is
+ * a matter of two SHA-256 blocks.
+ *
+ * The marker is only valid for the header it was made for, so installing an
+ * image with another version or start address falls back to the full
+ * verification. An image rewritten with the same header, e.g. by
+ * @ref sys_riotboot_ota, is not detected: invalidate the marker with
+ * riotboot_verify_clear() whenever a slot is erased. The marker does not
+ * protect against a slot being changed behind the back of the update code,
+ * skip the cache where that needs to be detected.
+ *
+ * The key is not derived by this module. It needs to stay the same across
+ * reboots and be out of reach of the application images, e.g. a key in a
+ * read protected flash area. The seed of @ref sys_puf_sram is not suitable,
+ * as it differs from boot to boot.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * int res = riotboot_verify(&marker, hdr, len, expected, key, sizeof(key));
+ *
+ * if (res == RIOTBOOT_VERIFY_FULL) {
+ *     store_marker(&marker);
+ * }
+ * if (res >= 0) {
+ *     boot(hdr);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Cached image verification definitions
+ */
+
+#ifndef RIOTBOOT_VERIFY_H
+#define RIOTBOOT_VERIFY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hashes/sha256.h"
+#include "riotboot/hdr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Magic number of a valid marker
+ */
+#define RIOTBOOT_VERIFY_MAGIC   (0x4b524d56)    /* "VMRK" */
+
+/**
+ * @name    Return values of riotboot_verify()
+ * @{
+ */
+#define RIOTBOOT_VERIFY_CACHED  (0)     /**< verified by the marker */
+#define RIOTBOOT_VERIFY_FULL    (1)     /**< verified by the digest, the
+                                             marker was filled */
+/** @} */
+
+/**
+ * @brief   Verification marker
+ *
+ * The marker is meant to be written to flash as is.
+ */
+typedef struct {
+    uint32_t magic;                         /**< RIOTBOOT_VERIFY_MAGIC */
+    uint32_t len;                           /**< length of the image */
+    uint8_t digest[SHA256_DIGEST_LENGTH];   /**< digest of the image */
+    uint8_t mac[SHA256_DIGEST_LENGTH];      /**< MAC over the above and the
+                                                 header */
+} riotboot_verify_marker_t;
+
+/**
+ * @brief   Verifies an image
+ *
+ * Checks @p marker first. If it does not match the image, the SHA-256 digest
+ * of the @p len bytes starting at @p hdr is compared to @p digest, and
+ * @p marker is filled on success.
+ *
+ * @param[in,out] marker    marker stored by an earlier call
+ * @param[in]     hdr       header at the start of the image
+ * @param[in]     len       length of the image, including the header
+ * @param[in]     digest    expected digest of the image
+ * @param[in]     key       device secret
+ * @param[in]     key_len   length of @p key
+ *
+ * @return  RIOTBOOT_VERIFY_CACHED if @p marker matches the image
+ * @return  RIOTBOOT_VERIFY_FULL if the image matches @p digest, the caller
+ *          should store @p marker
+ * @return  -EBADMSG if the image is not valid, @p marker is cleared
+ */
+int riotboot_verify(riotboot_verify_marker_t *marker,
+                    const riotboot_hdr_t *hdr, size_t len,
+                    const uint8_t digest[SHA256_DIGEST_LENGTH],
+                    const void *key, size_t key_len);
+
+/**
+ * @brief   Checks a marker only
+ *
+ * @param[in] marker    marker to check
+ * @param[in] hdr       header at the start of the image
+ * @param[in] len       length of the image, including the header
+ * @param[in] key       device secret
+ * @param[in] key_len   length of @p key
+ *
+ * @return  0 if @p marker is valid for the image
+ * @return  -EBADMSG if not
+ */
+int riotboot_verify_check(const riotboot_verify_marker_t *marker,
+                          const riotboot_hdr_t *hdr, size_t len,
+                          const void *key, size_t key_len);
+
+/**
+ * @brief   Invalidates a marker
+ *
+ * @param[out] marker   marker to invalidate
+ */
+void riotboot_verify_clear(riotboot_verify_marker_t *marker);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RIOTBOOT_VERIFY_H */
+/** @} */
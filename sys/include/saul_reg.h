@@ -11,6 +11,14 @@
  * @ingroup     sys
  * @brief       Global sensor/actuator registry for SAUL devices
  *
+ * The registry is a list, so looking up a device takes longer the more
+ * devices are registered. With the `saul_reg_index` module, up to
+ * @ref SAUL_REG_INDEX_NUMOF devices are also kept in arrays sorted by type
+ * and by name, so saul_reg_find_type(), saul_reg_find_name() and
+ * saul_reg_find_all() use a binary search, and saul_reg_find_nth() takes
+ * constant time. If more devices are registered, they fall back to walking
+ * the list.
+ *
  * @see @ref drivers_saul
  *
  * @{
@@ -33,6 +41,13 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of devices indexed by the `saul_reg_index` module
+ */
+#ifndef SAUL_REG_INDEX_NUMOF
+#define SAUL_REG_INDEX_NUMOF    (16U)
+#endif
+
 /**
  * @brief   SAUL registry entry
  */
@@ -109,6 +124,23 @@ saul_reg_t *saul_reg_find_type(uint8_t type);
  */
 saul_reg_t *saul_reg_find_name(const char *name);
 
+/**
+ * @brief   Find all devices of the given class
+ *
+ * With the `saul_reg_index` module, the devices are returned in the order of
+ * their type, and devices of the same type in the order of registration.
+ * Otherwise, all are returned in the order of registration.
+ *
+ * @param[in] type      class of the devices to find, @ref SAUL_SENSE_ANY,
+ *                      @ref SAUL_ACT_ANY or @ref SAUL_CLASS_ANY match all
+ *                      sensors, actuators or devices
+ * @param[out] devs     array to store the devices in
+ * @param[in] max       number of elements in @p devs
+ *
+ * @return      the number of devices written to @p devs
+ */
+unsigned saul_reg_find_all(uint8_t type, saul_reg_t **devs, unsigned max);
+
 /**
  * @brief   Read data from the given device
  *
@@ -122,6 +154,23 @@ saul_reg_t *saul_reg_find_name(const char *name);
  */
 int saul_reg_read(saul_reg_t *dev, phydat_t *res);
 
+/**
+ * @brief   Read all samples the given device has buffered
+ *
+ * Devices without a saul_driver_t::read_burst function are read once with
+ * saul_reg_read(), so callers can use this for any sensor.
+ *
+ * @param[in] dev       device to read from
+ * @param[out] res      array to store the samples in
+ * @param[in] max       number of elements in @p res
+ *
+ * @return      the number of samples written to @p res
+ * @return      -ENODEV if given device is invalid
+ * @return      -ENOTSUP if read operation is not supported by the device
+ * @return      -ECANCELED on device errors
+ */
+int saul_reg_read_burst(saul_reg_t *dev, phydat_t *res, unsigned max);
+
 /**
  * @brief   Write data to the given device
  *
@@ -135,6 +184,48 @@ int saul_reg_read(saul_reg_t *dev, phydat_t *res);
  */
 int saul_reg_write(saul_reg_t *dev, phydat_t *data);
 
+/**
+ * @brief   Called by saul_reg_read_all() for each device read
+ *
+ * @param[in] dev       device that was read
+ * @param[in] res       the data read
+ * @param[in] dim       the number of data elements in @p res [1-3]
+ * @param[in] arg       argument given to saul_reg_read_all()
+ */
+typedef void (*saul_reg_read_cb_t)(saul_reg_t *dev, const phydat_t *res,
+                                   int dim, void *arg);
+
+/**
+ * @brief   Reads all devices of the given class in one pass
+ *
+ * The data of each device is passed to @p cb right after reading it, so no
+ * buffer for all results is needed. Devices that fail to read are skipped.
+ * E.g. a telemetry message with the readings of all sensors is written as
+ * CBOR (see @ref phydat_to_cbor()) directly into the payload buffer with
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void _add(saul_reg_t *dev, const phydat_t *res, int dim, void *arg)
+ * {
+ *     cbor_enc_str(arg, dev->name);
+ *     phydat_to_cbor(res, dim, arg);
+ * }
+ *
+ * cbor_enc_init(&enc, payload, payload_len);
+ * cbor_enc_map_indef(&enc);
+ * saul_reg_read_all(SAUL_SENSE_ANY, _add, &enc);
+ * cbor_enc_break(&enc);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @param[in] type      class of the devices to read, @ref SAUL_SENSE_ANY,
+ *                      @ref SAUL_ACT_ANY or @ref SAUL_CLASS_ANY match all
+ *                      sensors, actuators or devices
+ * @param[in] cb        called for each device read
+ * @param[in] arg       argument passed to @p cb
+ *
+ * @return      the number of devices read
+ */
+int saul_reg_read_all(uint8_t type, saul_reg_read_cb_t cb, void *arg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_round_robin Round robin scheduling
+ * @ingroup     sys
+ * @brief       Time slicing among threads of the same priority
+ *
+ * The RIOT scheduler only switches between runnable threads of the same
+ * priority if the running one yields or blocks. With this module, a thread
+ * that shares its priority with other runnable threads is moved to the end
+ * of its runqueue after it ran for @ref SCHED_ROUND_ROBIN_QUANTUM
+ * microseconds, so a CPU-heavy thread can no longer starve its peers.
+ *
+ * The timer only runs while the active thread has runnable peers, threads
+ * with a priority of their own are never interrupted by it. Without the
+ * module, the scheduler is not touched at all.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Round robin scheduling definitions
+ */
+#ifndef SCHED_ROUND_ROBIN_H
+#define SCHED_ROUND_ROBIN_H
+
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Time slice of a thread in microseconds
+ */
+#ifndef SCHED_ROUND_ROBIN_QUANTUM
+#define SCHED_ROUND_ROBIN_QUANTUM   (10000U)
+#endif
+
+/**
+ * @brief   Starts or stops the time slice of the thread to run next
+ *
+ * @internal
+ * @note    Called by sched_run() with the thread it chose.
+ *
+ * @param[in] thread    The thread about to run.
+ */
+void sched_round_robin_check(thread_t *thread);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_ROUND_ROBIN_H */
+/** @} */
@@ -25,6 +25,7 @@
 #ifndef SEMA_H
 #define SEMA_H
 
+#include <stdatomic.h>
 #include <stdint.h>
 
 #include "mutex.h"
@@ -59,9 +60,13 @@ typedef enum {
 
 /**
  * @brief A Semaphore.
+ *
+ * The value is changed atomically, so waiting for a semaphore that is posted
+ * and posting a semaphore no thread waits for does not disable interrupts or
+ * touch the mutex, which only blocks the waiting threads.
  */
 typedef struct {
-    unsigned int value;             /**< value of the semaphore */
+    atomic_uint value;              /**< value of the semaphore */
     sema_state_t state;             /**< state of the semaphore */
     mutex_t mutex;                  /**< mutex of the semaphore */
 } sema_t;
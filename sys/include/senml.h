@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_senml SenML-CBOR encoder
+ * @ingroup     sys_serialization
+ * @brief       Writes Sensor Measurement Lists (RFC 8428) as CBOR
+ *
+ * A SenML pack is a CBOR array of records, each a map with integer labels.
+ * The records are written with @ref sys_cbor_enc, so the pack itself is
+ * opened with cbor_enc_array(), or with cbor_enc_array_indef() and closed by
+ * cbor_enc_break() if the number of records is not known in advance:
+ *
+ *     cbor_enc_init(&enc, buf, sizeof(buf));
+ *     cbor_enc_array_indef(&enc);
+ *     senml_cbor_saul(&enc, "/3303/0/", names, dev);
+ *     cbor_enc_break(&enc);
+ *
+ * Only the fields a constrained device sends in practice are supported:
+ * base name, name, unit, and one value. Numeric values of @ref phydat_t are
+ * written as integers or as decimal fractions, like phydat_to_cbor() does.
+ *
+ * The content format of SenML-CBOR is @ref SENML_CBOR_CONTENT_FORMAT.
+ *
+ * @{
+ *
+ * @file
+ * @brief       SenML-CBOR encoder definitions
+ */
+#ifndef SENML_H
+#define SENML_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cbor_enc.h"
+#include "phydat.h"
+#ifdef MODULE_SAUL_REG
+#include "saul_reg.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   CoAP content format of SenML-CBOR
+ */
+#define SENML_CBOR_CONTENT_FORMAT   (112U)
+
+/**
+ * @name    SenML-CBOR labels (RFC 8428, section 6)
+ * @{
+ */
+#define SENML_LABEL_BN              (-2)    /**< base name */
+#define SENML_LABEL_N               (0)     /**< name */
+#define SENML_LABEL_U               (1)     /**< unit */
+#define SENML_LABEL_V               (2)     /**< numeric value */
+#define SENML_LABEL_VS              (3)     /**< string value */
+#define SENML_LABEL_VB              (4)     /**< boolean value */
+#define SENML_LABEL_VD              (8)     /**< data value */
+/** @} */
+
+/**
+ * @brief   Fields of a record besides its value
+ */
+typedef struct {
+    const char *bn;         /**< base name, NULL to omit */
+    const char *n;          /**< name, NULL to omit */
+    const char *u;          /**< unit, NULL to omit */
+} senml_rec_t;
+
+/**
+ * @brief   Writes a record with an integer value
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     rec   fields of the record
+ * @param[in]     val   value
+ */
+void senml_cbor_int(cbor_enc_t *enc, const senml_rec_t *rec, int64_t val);
+
+/**
+ * @brief   Writes a record with the value @p mantissa * 10^@p exponent
+ *
+ * @param[in,out] enc       encoder
+ * @param[in]     rec       fields of the record
+ * @param[in]     mantissa  mantissa
+ * @param[in]     exponent  decimal exponent
+ */
+void senml_cbor_decfrac(cbor_enc_t *enc, const senml_rec_t *rec,
+                        int32_t mantissa, int32_t exponent);
+
+/**
+ * @brief   Writes a record with a float value
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     rec   fields of the record
+ * @param[in]     val   value, written in single precision
+ */
+void senml_cbor_float(cbor_enc_t *enc, const senml_rec_t *rec, float val);
+
+/**
+ * @brief   Writes a record with a boolean value
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     rec   fields of the record
+ * @param[in]     val   value
+ */
+void senml_cbor_bool(cbor_enc_t *enc, const senml_rec_t *rec, bool val);
+
+/**
+ * @brief   Writes a record with a string value
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     rec   fields of the record
+ * @param[in]     str   UTF-8 string, needs not be terminated
+ * @param[in]     len   length of @p str in bytes
+ */
+void senml_cbor_str(cbor_enc_t *enc, const senml_rec_t *rec,
+                    const char *str, size_t len);
+
+/**
+ * @brief   Writes a record with a data value
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     rec   fields of the record
+ * @param[in]     data  the data
+ * @param[in]     len   length of @p data in bytes
+ */
+void senml_cbor_data(cbor_enc_t *enc, const senml_rec_t *rec,
+                     const void *data, size_t len);
+
+/**
+ * @brief   Gets the SenML unit of a phydat unit
+ *
+ * @param[in] unit  one of the UNIT_* values of @ref phydat_t
+ *
+ * @return  the unit as registered for SenML, e.g. "Cel" for @ref UNIT_TEMP_C
+ * @return  NULL if SenML has no unit for @p unit without converting the
+ *          value
+ */
+const char *senml_unit(uint8_t unit);
+
+/**
+ * @brief   Writes one record per dimension of a data container
+ *
+ * The first record carries @p bn, every record the unit.
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     bn    base name, NULL to omit
+ * @param[in]     names name of the record of each dimension, NULL to omit
+ *                      all names
+ * @param[in]     data  data container to write
+ * @param[in]     dim   number of dimensions of @p data to write
+ */
+void senml_cbor_phydat(cbor_enc_t *enc, const char *bn,
+                       const char *const *names, const phydat_t *data,
+                       uint8_t dim);
+
+#if defined(MODULE_SAUL_REG) || defined(DOXYGEN)
+/**
+ * @brief   Reads a device once and writes a record per dimension read
+ *
+ * E.g. all three axes of an accelerometer or all resources of an LwM2M
+ * object instance backed by the device come from the same reading.
+ *
+ * @param[in,out] enc   encoder
+ * @param[in]     bn    base name, NULL to omit
+ * @param[in]     names name of the record of each dimension, NULL to omit
+ *                      all names
+ * @param[in]     dev   device to read
+ *
+ * @return  the number of records written
+ * @return  a negative error of saul_reg_read(), nothing is written then
+ */
+int senml_cbor_saul(cbor_enc_t *enc, const char *bn,
+                    const char *const *names, saul_reg_t *dev);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENML_H */
+/** @} */
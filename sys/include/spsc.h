@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_spsc Lock-free message channel
+ * @ingroup     sys
+ * @brief       Single-producer/single-consumer message queue without
+ *              interrupt locking
+ *
+ * Unlike @ref core_msg and @ref core_mbox, which disable interrupts for
+ * every message, an spsc_t is a ring of @ref msg_t that is synchronized with
+ * C11 atomics only. It is meant for one producer, typically an ISR, feeding a
+ * single consumer thread at high rates, e.g. ADC samples to a processing
+ * thread.
+ *
+ * The producer only notifies the consumer with a thread flag, if the consumer
+ * is blocked in spsc_wait(). Only then, thread_flags_set() disables
+ * interrupts briefly. The consumer can take many messages at once with
+ * spsc_get_bulk().
+ *
+ * @note    On platforms without native atomic instructions (e.g. Cortex-M0)
+ *          the atomics are emulated by `core/atomic_c11.c`, which
+ *          disables interrupts for every access.
+ *
+ * @attention   Buffer size must be a power of two!
+ *
+ * @{
+ *
+ * @file
+ * @brief       Lock-free message channel definitions
+ */
+
+#ifndef SPSC_H
+#define SPSC_H
+
+/* The stdatomic.h in GCC gives compilation errors with C++
+ * see: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=60932
+ */
+#ifdef __cplusplus
+#include <atomic>
+/* Make atomic types available without namespace specifier */
+using std::atomic_uint;
+using std::atomic_bool;
+#else
+#include <stdatomic.h>
+#endif
+
+#include "msg.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default thread flag the consumer waits for
+ */
+#ifndef SPSC_THREAD_FLAG
+#define SPSC_THREAD_FLAG    (1u << 13)
+#endif
+
+/**
+ * @brief   Lock-free message channel
+ */
+typedef struct {
+    msg_t *buf;                 /**< ring of messages */
+    unsigned mask;              /**< size of buf - 1 */
+    atomic_uint writes;         /**< total number of puts, producer only */
+    atomic_uint reads;          /**< total number of gets, consumer only */
+    atomic_bool waiting;        /**< consumer is blocked in spsc_wait() */
+    thread_t *consumer;         /**< thread to notify while waiting */
+    thread_flags_t flag;        /**< thread flag used for notification */
+} spsc_t;
+
+/**
+ * @brief   Initializes a channel
+ *
+ * @pre     @p size is a power of two
+ *
+ * @param[out] chan     The channel to initialize.
+ * @param[in] buf       Buffer for the messages.
+ * @param[in] size      Number of messages in @p buf.
+ * @param[in] flag      Thread flag to wake the consumer with, e.g.
+ *                      @ref SPSC_THREAD_FLAG.
+ */
+void spsc_init(spsc_t *chan, msg_t *buf, unsigned size, thread_flags_t flag);
+
+/**
+ * @brief   Puts a message into the channel, never blocks
+ *
+ * May be called from interrupt context. The sender_pid of the message is set
+ * to @ref KERNEL_PID_ISR or the PID of the calling thread.
+ *
+ * @note    Only one context may act as the producer of a channel.
+ *
+ * @param[in] chan  The channel.
+ * @param[in] msg   The message.
+ *
+ * @return  1, if the message was queued.
+ * @return  0, if the channel is full.
+ */
+int spsc_put(spsc_t *chan, const msg_t *msg);
+
+/**
+ * @brief   Takes a message from the channel, never blocks
+ *
+ * @note    Only one thread may act as the consumer of a channel.
+ *
+ * @param[in] chan  The channel.
+ * @param[out] msg  The message.
+ *
+ * @return  1, if a message was taken.
+ * @return  0, if the channel is empty.
+ */
+int spsc_get(spsc_t *chan, msg_t *msg);
+
+/**
+ * @brief   Takes up to @p n messages from the channel, never blocks
+ *
+ * @param[in] chan  The channel.
+ * @param[out] msgs Array for at least @p n messages.
+ * @param[in] n     Maximum number of messages to take.
+ *
+ * @return  Number of messages taken.
+ */
+unsigned spsc_get_bulk(spsc_t *chan, msg_t *msgs, unsigned n);
+
+/**
+ * @brief   Gets the number of messages in the channel
+ *
+ * @param[in] chan  The channel.
+ *
+ * @return  Number of messages that can be taken.
+ */
+unsigned spsc_avail(spsc_t *chan);
+
+/**
+ * @brief   Blocks the calling thread until the channel is not empty
+ *
+ * The calling thread becomes the consumer of the channel.
+ *
+ * @param[in] chan  The channel.
+ *
+ * @return  Number of messages that can be taken, at least 1.
+ */
+unsigned spsc_wait(spsc_t *chan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPSC_H */
+/** @} */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_stack_watermark Stack watermark sampler
+ * @ingroup     sys
+ * @brief       Tracks the maximum stack usage of all threads in the background
+ *
+ * A thread just above the idle thread periodically measures the stack usage
+ * of all threads (see thread_measure_stack_free()) and of the ISR stack, and
+ * logs every new maximum. Unlike `ps`, the maximum of a thread is kept after
+ * it exited. Run a node under realistic load for a while to get the stack
+ * sizes actually needed. Use `make STACK_USAGE=1 stack-usage` for a static
+ * estimate from the compiler (see `dist/tools/stack_usage`).
+ *
+ * @note    Requires `DEVELHELP` and threads created with
+ *          @ref THREAD_CREATE_STACKTEST.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Stack watermark sampler definitions
+ */
+#ifndef STACK_WATERMARK_H
+#define STACK_WATERMARK_H
+
+#include "kernel_types.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Sampling interval in seconds
+ */
+#ifndef STACK_WATERMARK_INTERVAL
+#define STACK_WATERMARK_INTERVAL    (10U)
+#endif
+
+/**
+ * @brief   Free stack in bytes below which a warning is logged
+ */
+#ifndef STACK_WATERMARK_LOW
+#define STACK_WATERMARK_LOW         (64U)
+#endif
+
+/**
+ * @brief   Stack size of the sampler thread
+ */
+#ifndef STACK_WATERMARK_STACKSIZE
+#define STACK_WATERMARK_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Starts the sampler thread
+ *
+ * Called by auto_init.
+ */
+void stack_watermark_init(void);
+
+/**
+ * @brief   Samples all stacks now
+ *
+ * @return  Number of threads whose maximum increased.
+ */
+unsigned stack_watermark_sample(void);
+
+/**
+ * @brief   Gets the maximum stack usage seen of a thread
+ *
+ * @param[in] pid   PID of the thread.
+ *
+ * @return  Maximum number of stack bytes used.
+ * @return  0, if @p pid was never sampled.
+ */
+unsigned stack_watermark_get(kernel_pid_t pid);
+
+/**
+ * @brief   Gets the maximum usage seen of the ISR stack
+ *
+ * @return  Maximum number of ISR stack bytes used.
+ */
+unsigned stack_watermark_isr(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STACK_WATERMARK_H */
+/** @} */
@@ -52,6 +52,62 @@ extern "C" {
 #define STDIO_UART_RX_BUFSIZE   (64)
 #endif
 
+#ifndef STDIO_UART_TX_BUFSIZE
+/**
+ * @brief Transmit buffer size for STDIO with `stdio_uart_tx_async`, must be a
+ *        power of two
+ */
+#define STDIO_UART_TX_BUFSIZE   (256)
+#endif
+
+#ifndef STDIO_UART_TX_PRIO
+/**
+ * @brief Priority of the thread sending the transmit buffer
+ */
+#define STDIO_UART_TX_PRIO      (THREAD_PRIORITY_IDLE - 1)
+#endif
+
+#ifndef STDIO_UART_TX_STACKSIZE
+/**
+ * @brief Stack size of the thread sending the transmit buffer
+ */
+#define STDIO_UART_TX_STACKSIZE (THREAD_STACKSIZE_SMALL)
+#endif
+
+#ifdef DOXYGEN
+/**
+ * @brief Drop output that does not fit into the transmit buffer
+ *
+ * By default, stdio_write() blocks until the output fits into the transmit
+ * buffer. Output written from interrupts is always dropped if it does not
+ * fit.
+ */
+#define STDIO_UART_TX_DROP
+#endif
+
+/**
+ * @brief Starts the thread sending the transmit buffer
+ *
+ * Only with the `stdio_uart_tx_async` module, called by auto_init. Output
+ * is written synchronously before.
+ *
+ * With `stdio_uart_tx_async`, stdio_write() only copies the output into a
+ * ring buffer of @ref STDIO_UART_TX_BUFSIZE bytes, and a thread of the
+ * priority @ref STDIO_UART_TX_PRIO sends it with uart_write(). On platforms
+ * sending via DMA, the thread sleeps while the data is sent. So printf does
+ * not stall the calling thread for the time it takes to send the output.
+ */
+void stdio_uart_tx_init(void);
+
+/**
+ * @brief Waits until the transmit buffer is sent
+ *
+ * From interrupts the buffer is sent in the calling context, which is meant
+ * for a panic: bytes being sent by the thread at the time of the interrupt
+ * may be sent twice.
+ */
+void stdio_uart_tx_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_tracing Function tracing
+ * @ingroup     sys
+ * @brief       Records function entries and exits and context switches
+ *
+ * With the `tracing` module, all code except for the excluded directories is
+ * compiled with `-finstrument-functions`. Each entry and exit of a function
+ * and each context switch is recorded with a timestamp into a ring buffer of
+ * @ref TRACING_NUMOF events, the oldest events being overwritten. The
+ * timestamps are CPU cycles on Cortex-M CPUs with a cycle counter, and
+ * microseconds otherwise.
+ *
+ * The directories given in `TRACING_EXCLUDE` are not instrumented. By
+ * default, these are `core`, the CPU and board code, xtimer and this module,
+ * as the recording itself uses them. Exclude further code that runs too
+ * often to be of interest, e.g. `TRACING_EXCLUDE += $(RIOTBASE)/sys/tsrb`.
+ *
+ * The `trace dump` shell command or tracing_dump() print the buffer. Use
+ * `dist/tools/tracing/trace2chrome.py` to convert the output to the Chrome
+ * trace format, which is shown by `chrome://tracing` or Perfetto.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Function tracing definitions
+ */
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of events in the ring buffer
+ */
+#ifndef TRACING_NUMOF
+#define TRACING_NUMOF       (256U)
+#endif
+
+/**
+ * @brief   Event types
+ */
+typedef enum {
+    TRACING_ENTER,          /**< function entered */
+    TRACING_EXIT,           /**< function left */
+    TRACING_SWITCH,         /**< context switch */
+} tracing_type_t;
+
+/**
+ * @brief   A recorded event
+ */
+typedef struct {
+    uint32_t time;          /**< timestamp */
+    uint32_t type;          /**< @ref tracing_type_t */
+    uintptr_t addr;         /**< function, or the pid switched to */
+    uintptr_t site;         /**< call site of the function */
+} tracing_event_t;
+
+/**
+ * @brief   Initializes the clock and starts recording
+ *
+ * Called by auto_init.
+ */
+void tracing_init(void);
+
+/**
+ * @brief   Starts recording
+ */
+void tracing_start(void);
+
+/**
+ * @brief   Stops recording
+ */
+void tracing_stop(void);
+
+/**
+ * @brief   Prints the recorded events, oldest first, and clears the buffer
+ *
+ * Recording is paused while printing.
+ */
+void tracing_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACING_H */
+/** @} */
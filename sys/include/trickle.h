@@ -16,6 +16,13 @@
  *
  * @see https://tools.ietf.org/html/rfc6206
  *
+ * By default, every trickle timer has its own xtimer and sends a message to
+ * a thread at the end of each interval, which has to call trickle_callback().
+ * With the module `trickle_event`, instances started with
+ * trickle_event_start() instead share a single xtimer and run their
+ * callbacks directly in the thread of an event queue, which keeps the timer
+ * list short when there are many instances, e.g. for MPL.
+ *
  * @{
  *
  * @file
@@ -34,6 +41,20 @@
 
 #include "xtimer.h"
 #include "thread.h"
+#ifdef MODULE_TRICKLE_EVENT
+#include "event.h"
+#endif
+
+/**
+ * @brief   Divisor of the interval size for the slack of the timer
+ *
+ * The message of an interval may be sent up to `I / TRICKLE_SLACK_DIV` late,
+ * so that it can share a wakeup with other timers, see xtimer_set_slack().
+ * Set to 0 to send it in time.
+ */
+#ifndef TRICKLE_SLACK_DIV
+#define TRICKLE_SLACK_DIV       (16U)
+#endif
 
 /**
  * @brief Trickle callback function with arguments
@@ -46,7 +67,7 @@ typedef struct {
 /**
  * @brief all state variables of a trickle timer
  */
-typedef struct {
+typedef struct trickle {
     uint8_t k;                      /**< redundancy constant */
     uint8_t Imax;                   /**< maximum interval size,
                                          described as of Imin doublings in ms */
@@ -61,6 +82,13 @@ typedef struct {
     msg_t msg;                      /**< the msg_t to use for intervals */
     xtimer_t msg_timer;             /**< xtimer to send a msg_t to the target
                                          thread for a new interval */
+#if defined(MODULE_TRICKLE_EVENT) || defined(DOXYGEN)
+    struct trickle *next;           /**< next instance run by the event
+                                         queue */
+    uint64_t deadline;              /**< time of the next callback in
+                                         microseconds, for instances run
+                                         by the event queue */
+#endif
 } trickle_t;
 
 /**
@@ -89,6 +117,38 @@ void trickle_reset_timer(trickle_t *trickle);
 void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
                    uint32_t Imin, uint8_t Imax, uint8_t k);
 
+#if defined(MODULE_TRICKLE_EVENT) || defined(DOXYGEN)
+/**
+ * @brief   Sets the event queue to run the callbacks of the instances
+ *          started with trickle_event_start()
+ *
+ * Must be called before the first of these instances is started.
+ *
+ * @param[in] queue     event queue, handled by a thread calling event_loop()
+ */
+void trickle_event_init(event_queue_t *queue);
+
+/**
+ * @brief   Starts a trickle timer that runs on the shared timer
+ *
+ * The callback of @p trickle is called in the thread of the event queue
+ * set with trickle_event_init(). trickle_callback() must not be called for
+ * the instance, trickle_reset_timer(), trickle_increment_counter() and
+ * trickle_stop() are used as usual.
+ *
+ * @pre `Imin > 0`
+ * @pre `(Imin << Imax) < (UINT32_MAX / 2)` to avoid overflow of uint32_t
+ *
+ * @param[in] trickle               trickle timer, with trickle_t::callback
+ *                                  set
+ * @param[in] Imin                  minimum interval in ms
+ * @param[in] Imax                  maximum interval in ms
+ * @param[in] k                     redundancy constant
+ */
+void trickle_event_start(trickle_t *trickle, uint32_t Imin, uint8_t Imax,
+                         uint8_t k);
+#endif
+
 /**
  * @brief stops the trickle timer
  *
@@ -153,6 +153,41 @@ int tsrb_add_one(tsrb_t *rb, char c);
  */
 int tsrb_add(tsrb_t *rb, const char *src, size_t n);
 
+/**
+ * @brief       Get the contiguous free space of the ringbuffer, to be written
+ *              directly, e.g. by DMA
+ *
+ * The bytes written become available to the reader with tsrb_commit(). Free
+ * space wrapping around the end of the buffer takes a second call after
+ * committing. Only to be called by the writer.
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[out]  n   nr of bytes that may be written
+ * @return      start of the free space
+ */
+char *tsrb_reserve(tsrb_t *rb, size_t *n);
+
+/**
+ * @brief       Make the bytes written after tsrb_reserve() available
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes written, at most the number returned by
+ *                  tsrb_reserve()
+ */
+void tsrb_commit(tsrb_t *rb, size_t n);
+
+/**
+ * @brief       Get the contiguous bytes available for reading, to be read
+ *              directly
+ *
+ * Drop the bytes read with tsrb_drop(). Bytes wrapping around the end of the
+ * buffer take a second call after dropping. Only to be called by the reader.
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[out]  n   nr of bytes that may be read
+ * @return      the oldest byte
+ */
+char *tsrb_peek_region(tsrb_t *rb, size_t *n);
+
 #ifdef __cplusplus
 }
 #endif
@@ -70,6 +70,7 @@ using std::atomic_int;
 
 #include "kernel_types.h"
 #include "clist.h"
+#include "iolist.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -318,6 +319,20 @@ struct vfs_file_ops {
      */
     off_t (*lseek) (vfs_file_t *filp, off_t off, int whence);
 
+    /**
+     * @brief Get a pointer to the contents of an open file
+     *
+     * Only file systems keeping their files in memory mapped storage, e.g.
+     * internal flash, implement this. The file position is not changed.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[out] addr     pointer to the contents at the current position
+     *
+     * @return number of bytes available at @p addr on success
+     * @return <0 on error
+     */
+    ssize_t (*mmap) (vfs_file_t *filp, const void **addr);
+
     /**
      * @brief Attempt to open a file in the file system at rel_path
      *
@@ -633,6 +648,23 @@ int vfs_fstatvfs(int fd, struct statvfs *buf);
  */
 off_t vfs_lseek(int fd, off_t off, int whence);
 
+/**
+ * @brief Get a pointer to the contents of an open file
+ *
+ * This gives direct access to the file from the current position on, without
+ * copying it with vfs_read(). The file position is not changed, use
+ * vfs_lseek() to move it.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[out] addr     pointer to the contents at the current position
+ *
+ * @return number of bytes available at @p addr on success, 0 at the end of the
+ *         file
+ * @return -ENOTSUP if the file system does not keep its files memory mapped
+ * @return <0 on error
+ */
+ssize_t vfs_mmap(int fd, const void **addr);
+
 /**
  * @brief Open a file
  *
@@ -669,6 +701,30 @@ ssize_t vfs_read(int fd, void *dest, size_t count);
  */
 ssize_t vfs_write(int fd, const void *src, size_t count);
 
+/**
+ * @brief Read bytes from an open file into the buffers of an iolist
+ *
+ * The buffers are filled in order, until the end of the file is reached.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  iolist   buffers to hold the file contents
+ *
+ * @return number of bytes read on success
+ * @return <0 on error, if nothing was read
+ */
+ssize_t vfs_readv(int fd, const iolist_t *iolist);
+
+/**
+ * @brief Write the buffers of an iolist to an open file
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  iolist   buffers to write
+ *
+ * @return number of bytes written on success
+ * @return <0 on error, if nothing was written
+ */
+ssize_t vfs_writev(int fd, const iolist_t *iolist);
+
 /**
  * @brief Open a directory for reading with readdir
  *
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_vfs_async Asynchronous VFS I/O
+ * @ingroup     sys_vfs
+ * @brief       Reads and writes files in the background
+ *
+ * The requests are executed by the workers of the @ref sys_event work queue
+ * (see event/workq.h), so the calling thread does not block while the file
+ * system programs the flash. When a request is done, the completion event
+ * given by the caller is posted to its queue:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static vfs_async_t req;
+ *
+ * static void _written(event_t *event)
+ * {
+ *     (void)event;
+ *     printf("wrote %d bytes\n", (int)req.res);
+ * }
+ * static event_t done = { .handler = _written };
+ *
+ * vfs_write_async(&req, fd, buf, len, &queue, &done);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The request, the buffers and the file descriptor must stay valid until
+ * the completion event was posted. Requests on the same file must not be
+ * issued before the previous one completed, as they may be executed by
+ * different workers in parallel.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous VFS I/O API
+ */
+
+#ifndef VFS_ASYNC_H
+#define VFS_ASYNC_H
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+#include "event.h"
+#include "event/workq.h"
+#include "iolist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Work queue priority the requests are executed with
+ */
+#ifndef VFS_ASYNC_PRIO
+#define VFS_ASYNC_PRIO      (EVENT_WORKQ_PRIO_LOW)
+#endif
+
+/**
+ * @brief   Asynchronous VFS request
+ */
+typedef struct {
+    event_t super;              /**< executes the request, internal */
+    iolist_t buf;               /**< buffer of single buffer requests */
+    const iolist_t *iolist;     /**< buffers to read to or write from */
+    event_queue_t *queue;       /**< queue to post done to */
+    event_t *done;              /**< completion event */
+    int fd;                     /**< file to access */
+    bool write;                 /**< true for writes */
+    ssize_t res;                /**< result, valid after completion */
+} vfs_async_t;
+
+/**
+ * @brief   Reads from an open file into the buffers of an iolist
+ *
+ * @param[out] req      request to set up, see vfs_readv() for the result
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  iolist   buffers to hold the file contents
+ * @param[in]  queue    queue to post @p done to
+ * @param[in]  done     event posted when the request completed
+ */
+void vfs_readv_async(vfs_async_t *req, int fd, const iolist_t *iolist,
+                     event_queue_t *queue, event_t *done);
+
+/**
+ * @brief   Writes the buffers of an iolist to an open file
+ *
+ * @param[out] req      request to set up, see vfs_writev() for the result
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  iolist   buffers to write
+ * @param[in]  queue    queue to post @p done to
+ * @param[in]  done     event posted when the request completed
+ */
+void vfs_writev_async(vfs_async_t *req, int fd, const iolist_t *iolist,
+                      event_queue_t *queue, event_t *done);
+
+/**
+ * @brief   Reads from an open file
+ *
+ * @param[out] req      request to set up, see vfs_read() for the result
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[out] dest     destination buffer to hold the file contents
+ * @param[in]  count    maximum number of bytes to read
+ * @param[in]  queue    queue to post @p done to
+ * @param[in]  done     event posted when the request completed
+ */
+void vfs_read_async(vfs_async_t *req, int fd, void *dest, size_t count,
+                    event_queue_t *queue, event_t *done);
+
+/**
+ * @brief   Writes to an open file
+ *
+ * @param[out] req      request to set up, see vfs_write() for the result
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  src      pointer to source buffer
+ * @param[in]  count    maximum number of bytes to write
+ * @param[in]  queue    queue to post @p done to
+ * @param[in]  done     event posted when the request completed
+ */
+void vfs_write_async(vfs_async_t *req, int fd, const void *src, size_t count,
+                     event_queue_t *queue, event_t *done);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VFS_ASYNC_H */
+/** @} */
@@ -20,6 +20,17 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * For applications keeping many timers armed at the same time, the
+ * `xtimer_wheel` module replaces the lists by a hierarchical timer wheel
+ * with O(1) insertion and removal, at the cost of a static table of
+ * (@ref XTIMER_WHEEL_LEVELS * 2^@ref XTIMER_WHEEL_BITS) pointers and one
+ * additional pointer per timer.  The API is the same for both backends.
+ *
+ * To correlate latency spikes with timer load, the `xtimer_stats` module
+ * records histograms of how late the ISR fires timers, how long it runs
+ * and how many timers it leaves in the lists, see xtimer_stats_get() and
+ * the `timerstats` shell command.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -69,6 +80,10 @@ typedef void (*xtimer_callback_t)(void*);
  */
 typedef struct xtimer {
     struct xtimer *next;         /**< reference to next timer in timer lists */
+#if defined(MODULE_XTIMER_WHEEL) || defined(DOXYGEN)
+    struct xtimer **pprev;       /**< reference to the pointer pointing to
+                                     this timer, only used by xtimer_wheel */
+#endif
     uint32_t target;             /**< lower 32bit absolute target time */
     uint32_t long_target;        /**< upper 32bit absolute target time */
     xtimer_callback_t callback;  /**< callback function to call when timer
@@ -114,6 +129,16 @@ static inline uint32_t xtimer_now_usec(void);
  */
 static inline uint64_t xtimer_now_usec64(void);
 
+/**
+ * @brief get the current system time in milliseconds since start
+ *
+ * A coarse clock for callers that don't need microseconds, e.g. for protocol
+ * timeouts. It is monotonic, but wraps around after ~49.7 days, so compare
+ * time stamps by their difference only. It is cheaper than dividing
+ * xtimer_now_usec64() by @ref US_PER_MS, but still reads the 64-bit time.
+ */
+static inline uint32_t xtimer_now_msec(void);
+
 /**
  * @brief xtimer initialization function
  *
@@ -312,6 +337,50 @@ static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
  */
 static inline void xtimer_set64(xtimer_t *timer, uint64_t offset_us);
 
+/**
+ * @brief Set a timer that may fire up to @p slack microseconds late
+ *
+ * The timer fires at the point in time between @p offset_us and
+ * @p offset_us + @p slack microseconds from now with the most trailing zero
+ * bits in ticks. Timers with overlapping windows thus end up at the same
+ * target and are handled in one wakeup, instead of waking the CPU once for
+ * every timer.
+ *
+ * Meant for periodic and housekeeping timers that don't need to be exact,
+ * e.g. trickle or protocol timeouts. A @p slack of 0 is equal to
+ * xtimer_set64().
+ *
+ * @warning Callbacks are executed in interrupt context, see xtimer_set().
+ *
+ * @param[in] timer       the timer structure to use.
+ *                        Its xtimer_t::target and xtimer_t::long_target
+ *                        fields need to be initialized with 0 on first use
+ * @param[in] offset_us   earliest time in microseconds from now to execute
+ *                        the callback
+ * @param[in] slack       maximum delay in microseconds after @p offset_us
+ */
+static inline void xtimer_set_slack(xtimer_t *timer, uint64_t offset_us,
+                                    uint32_t slack);
+
+/**
+ * @brief Set a timer that sends a message and may fire up to @p slack
+ *        microseconds late
+ *
+ * See xtimer_set_slack() for how the target is chosen and
+ * xtimer_set_msg64() for the message.
+ *
+ * @param[in] timer         timer struct to work with.
+ *                          Its xtimer_t::target and xtimer_t::long_target
+ *                          fields need to be initialized with 0 on first use.
+ * @param[in] offset        earliest time in microseconds from now
+ * @param[in] slack         maximum delay in microseconds after @p offset
+ * @param[in] msg           ptr to msg that will be sent
+ * @param[in] target_pid    pid the message will be sent to
+ */
+static inline void xtimer_set_msg_slack(xtimer_t *timer, uint64_t offset,
+                                        uint32_t slack, msg_t *msg,
+                                        kernel_pid_t target_pid);
+
 /**
  * @brief remove a timer
  *
@@ -321,6 +390,98 @@ static inline void xtimer_set64(xtimer_t *timer, uint64_t offset_us);
  */
 void xtimer_remove(xtimer_t *timer);
 
+/**
+ * @brief Get the time until the next timer interrupt
+ *
+ * This is the time until the next timer fires, or until the next overflow of
+ * the low-level timer, whichever comes first. Power management uses it to
+ * select a sleep mode.
+ *
+ * @return time in microseconds until xtimer needs the CPU again
+ */
+uint32_t xtimer_usec_until_next(void);
+
+/**
+ * @brief Initialize the RTT for tickless sleep
+ *
+ * Only available with the `xtimer_tickless` module, called by auto_init.
+ */
+void xtimer_tickless_init(void);
+
+/**
+ * @brief Hand timekeeping over to the RTT for a sleep mode that stops the
+ *        xtimer timer
+ *
+ * Stops the xtimer timer and sets an RTT alarm @p latency_us before the next
+ * timer needs the CPU. Must be called with interrupts disabled, and be
+ * followed by xtimer_tickless_resume() once the CPU woke up, before
+ * interrupts are enabled again.
+ *
+ * Only available with the `xtimer_tickless` module.
+ *
+ * @param[in] latency_us    time the CPU needs to wake up
+ *
+ * @return  0 on success
+ * @return  -1 if the next timer is too close, the timer was not stopped
+ */
+int xtimer_tickless_suspend(uint32_t latency_us);
+
+/**
+ * @brief Advance xtimer by the time slept according to the RTT and restart
+ *        the timer
+ *
+ * Only available with the `xtimer_tickless` module.
+ */
+void xtimer_tickless_resume(void);
+
+#ifndef XTIMER_STATS_BUCKETS
+/**
+ * @brief   Number of buckets per histogram of the `xtimer_stats` module
+ *
+ * Bucket 0 counts the value 0, bucket i > 0 the values from 2^(i-1) to
+ * 2^i - 1, and the last bucket all values above.
+ */
+#define XTIMER_STATS_BUCKETS (12U)
+#endif
+
+/**
+ * @brief   Timer statistics recorded by the `xtimer_stats` module
+ *
+ * All histograms use the buckets described at @ref XTIMER_STATS_BUCKETS.
+ */
+typedef struct {
+    uint32_t late[XTIMER_STATS_BUCKETS];    /**< timers fired by the ISR, by
+                                                 how late it called them in
+                                                 microseconds */
+    uint32_t isr[XTIMER_STATS_BUCKETS];     /**< ISR runs, by duration in
+                                                 microseconds */
+    uint32_t list[XTIMER_STATS_BUCKETS];    /**< ISR runs, by the number of
+                                                 timers left in this period */
+    uint32_t long_list[XTIMER_STATS_BUCKETS];   /**< ISR runs, by the number
+                                                     of timers left beyond
+                                                     this period */
+    uint32_t late_max;                      /**< latest call in microseconds */
+    uint32_t isr_max;                       /**< longest ISR run in
+                                                 microseconds */
+} xtimer_stats_t;
+
+/**
+ * @brief   Get a consistent copy of the timer statistics
+ *
+ * Only available with the `xtimer_stats` module. The statistics cover the
+ * timers in the list implementation, `xtimer_wheel` does not record them.
+ *
+ * @param[out] stats    the statistics since boot or the last reset
+ */
+void xtimer_stats_get(xtimer_stats_t *stats);
+
+/**
+ * @brief   Clear the timer statistics
+ *
+ * Only available with the `xtimer_stats` module.
+ */
+void xtimer_stats_reset(void);
+
 /**
  * @brief receive a message blocking but with timeout
  *
@@ -541,6 +702,38 @@ void xtimer_set_timeout_flag(xtimer_t *t, uint32_t timeout);
 #define XTIMER_PERIODIC_RELATIVE (512)
 #endif
 
+#ifndef XTIMER_WHEEL_BITS
+/**
+ * @brief   log2 of the number of slots per level of the xtimer_wheel
+ *
+ * Must not exceed log2 of the number of bits of `unsigned` on the target
+ * platform, i.e. 4 on 16 bit platforms.
+ */
+#define XTIMER_WHEEL_BITS (4)
+#endif
+
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   Number of levels of the xtimer_wheel
+ *
+ * Timers further than 2^(@ref XTIMER_WHEEL_BITS * @ref XTIMER_WHEEL_LEVELS)
+ * ticks in the future are kept in an overflow list which is redistributed
+ * once per wheel revolution.
+ */
+#define XTIMER_WHEEL_LEVELS (8)
+#endif
+
+#ifndef XTIMER_TICKLESS_MIN_US
+/**
+ * @brief   Minimum time until the next timer for xtimer_tickless_suspend()
+ *          to hand over to the RTT
+ *
+ * Each hand over loses up to one RTT tick of time, so this should be well
+ * above the RTT tick period.
+ */
+#define XTIMER_TICKLESS_MIN_US (2000)
+#endif
+
 /*
  * Default xtimer configuration
  */
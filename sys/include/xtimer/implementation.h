@@ -42,13 +42,12 @@ extern volatile uint32_t _xtimer_high_cnt;
  */
 #define MSG_XTIMER 12345
 
+#ifdef MODULE_XTIMER_TICKLESS
 /**
- * @brief returns the (masked) low-level timer counter value.
+ * @brief ticks the low-level timer missed while stopped in tickless sleep
  */
-static inline uint32_t _xtimer_lltimer_now(void)
-{
-    return timer_read(XTIMER_DEV);
-}
+extern uint32_t _xtimer_lltimer_offset;
+#endif
 
 /**
  * @brief drop bits of a value that don't fit into the low-level timer.
@@ -60,6 +59,29 @@ static inline uint32_t _xtimer_lltimer_mask(uint32_t val)
     return val & ~XTIMER_MASK;
 }
 
+/**
+ * @brief returns the (masked) low-level timer counter value.
+ */
+static inline uint32_t _xtimer_lltimer_now(void)
+{
+#ifdef MODULE_XTIMER_TICKLESS
+    return _xtimer_lltimer_mask(timer_read(XTIMER_DEV) + _xtimer_lltimer_offset);
+#else
+    return timer_read(XTIMER_DEV);
+#endif
+}
+
+/**
+ * @brief programs the low-level timer to fire at a (masked) counter value.
+ */
+static inline void _xtimer_lltimer_set_absolute(uint32_t target)
+{
+#ifdef MODULE_XTIMER_TICKLESS
+    target -= _xtimer_lltimer_offset;
+#endif
+    timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, _xtimer_lltimer_mask(target));
+}
+
 /**
  * @{
  * @brief xtimer internal stuff
@@ -87,6 +109,7 @@ void _xtimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period);
 void _xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg, kernel_pid_t target_pid);
 void _xtimer_set_msg64(xtimer_t *timer, uint64_t offset, msg_t *msg, kernel_pid_t target_pid);
 void _xtimer_set_wakeup(xtimer_t *timer, uint32_t offset, kernel_pid_t pid);
+uint64_t _xtimer_slack(uint64_t offset, uint32_t slack);
 void _xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_pid_t pid);
 int _xtimer_msg_receive_timeout(msg_t *msg, uint32_t ticks);
 int _xtimer_msg_receive_timeout64(msg_t *msg, uint64_t ticks);
@@ -95,6 +118,22 @@ int _xtimer_msg_receive_timeout64(msg_t *msg, uint64_t ticks);
  * @brief  Sleep for the given number of ticks
  */
 void _xtimer_tsleep(uint32_t offset, uint32_t long_offset);
+
+/**
+ * @brief  Program the low-level timer again, after its counter was moved
+ */
+void _xtimer_lltimer_rearm(void);
+
+/**
+ * @brief  Record how many ticks late the ISR fires a timer (xtimer_stats)
+ */
+void _xtimer_stats_late(uint32_t ticks);
+
+/**
+ * @brief  Record the duration of an ISR run in ticks and the lengths of the
+ *         timer lists it left behind (xtimer_stats)
+ */
+void _xtimer_stats_isr(uint32_t ticks, unsigned list, unsigned long_list);
 /** @} */
 
 #ifndef XTIMER_MIN_SPIN
@@ -151,6 +190,17 @@ static inline uint64_t xtimer_now_usec64(void)
     return xtimer_usec_from_ticks64(xtimer_now64());
 }
 
+static inline uint32_t xtimer_now_msec(void)
+{
+    /* us / 1000 == (us / 8) / 125, the 64 bit division by 125 is split into
+     * one by 15625 (which div.h does by multiplication) and a 32 bit one of
+     * the remainder */
+    uint64_t val = xtimer_now_usec64() >> 3;
+    uint64_t q = div_u64_by_15625(val);
+
+    return (q * 125) + ((uint32_t)(val - (q * 15625)) / 125);
+}
+
 static inline void _xtimer_spin(uint32_t offset) {
     uint32_t start = _xtimer_lltimer_now();
 #if XTIMER_MASK
@@ -241,6 +291,24 @@ static inline void xtimer_set64(xtimer_t *timer, uint64_t period_us)
     _xtimer_set64(timer, ticks, ticks >> 32);
 }
 
+static inline void xtimer_set_slack(xtimer_t *timer, uint64_t offset_us,
+                                    uint32_t slack)
+{
+    uint64_t ticks = _xtimer_slack(_xtimer_ticks_from_usec64(offset_us),
+                                   _xtimer_ticks_from_usec(slack));
+    _xtimer_set64(timer, ticks, ticks >> 32);
+}
+
+static inline void xtimer_set_msg_slack(xtimer_t *timer, uint64_t offset,
+                                        uint32_t slack, msg_t *msg,
+                                        kernel_pid_t target_pid)
+{
+    _xtimer_set_msg64(timer,
+                      _xtimer_slack(_xtimer_ticks_from_usec64(offset),
+                                    _xtimer_ticks_from_usec(slack)),
+                      msg, target_pid);
+}
+
 static inline int xtimer_msg_receive_timeout(msg_t *msg, uint32_t timeout)
 {
     return _xtimer_msg_receive_timeout(msg, _xtimer_ticks_from_usec(timeout));
@@ -0,0 +1,307 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_log_binary
+ * @{
+ *
+ * @file
+ * @brief       Deferred binary log implementation
+ *
+ * @}
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "log.h"
+#include "mutex.h"
+#include "thread.h"
+#include "tsrb.h"
+
+#if (LOG_BINARY_BUFSIZE & (LOG_BINARY_BUFSIZE - 1))
+#error "LOG_BINARY_BUFSIZE must be a power of two"
+#endif
+
+#if (LOG_BINARY_ARGS_MAX > UINT8_MAX) || (LOG_BINARY_STRLEN_MAX > UINT8_MAX)
+#error "LOG_BINARY_ARGS_MAX and LOG_BINARY_STRLEN_MAX must fit into a byte"
+#endif
+
+#if LOG_BINARY_ARGS_MAX < 4
+#error "LOG_BINARY_ARGS_MAX must be at least 4"
+#endif
+
+#define RECORD_MAX      (LOG_BINARY_HDR_SIZE + LOG_BINARY_ARGS_MAX)
+
+static char _buf[LOG_BINARY_BUFSIZE];
+static tsrb_t _rb = TSRB_INIT(_buf);
+static unsigned _dropped;
+/* unlocked whenever a record was added */
+static mutex_t _signal = MUTEX_INIT_LOCKED;
+/* held while reading records */
+static mutex_t _reader = MUTEX_INIT;
+static log_binary_sink_t _sink;
+static char _stack[LOG_BINARY_STACKSIZE];
+
+/* the arguments of a record, little endian */
+typedef struct {
+    uint8_t *buf;
+    size_t len;
+} _args_t;
+
+static bool _put(_args_t *args, uint64_t val, size_t len)
+{
+    if (args->len + len > LOG_BINARY_ARGS_MAX) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++, val >>= 8) {
+        args->buf[args->len++] = (uint8_t)val;
+    }
+    return true;
+}
+
+static bool _put_str(_args_t *args, const char *str)
+{
+    size_t len;
+
+    if (str == NULL) {
+        str = "(null)";
+    }
+    len = strnlen(str, LOG_BINARY_STRLEN_MAX);
+    if (args->len + 1 + len > LOG_BINARY_ARGS_MAX) {
+        return false;
+    }
+    args->buf[args->len++] = len;
+    memcpy(&args->buf[args->len], str, len);
+    args->len += len;
+    return true;
+}
+
+/* fetches the arguments in the order of the conversions of the format
+ * string, the arguments that do not fit are dropped */
+static size_t _fetch(uint8_t *buf, const char *format, va_list ap)
+{
+    _args_t args = { .buf = buf, .len = 0 };
+    bool fits = true;
+
+    while (fits && (format = strchr(format, '%'))) {
+        char mod = '\0';
+        unsigned longs = 0;
+
+        format++;
+        while (*format && strchr("-+ #0123456789.*", *format)) {
+            if ((*format == '*') && !_put(&args, va_arg(ap, int), 4)) {
+                return args.len;
+            }
+            format++;
+        }
+        while (*format && strchr("hljztL", *format)) {
+            if (*format == 'l') {
+                longs++;
+            }
+            else {
+                mod = *format;
+            }
+            format++;
+        }
+
+        switch (*format) {
+            case 'd':
+            case 'i':
+                if ((longs > 1) || (mod == 'j')) {
+                    fits = _put(&args, (mod == 'j') ? (uint64_t)va_arg(ap, intmax_t)
+                                                    : (uint64_t)va_arg(ap, long long), 8);
+                }
+                else if (longs == 1) {
+                    fits = _put(&args, (int32_t)va_arg(ap, long), 4);
+                }
+                else if ((mod == 'z') || (mod == 't')) {
+                    fits = _put(&args, (int32_t)va_arg(ap, ptrdiff_t), 4);
+                }
+                else {
+                    fits = _put(&args, (int32_t)va_arg(ap, int), 4);
+                }
+                break;
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                if ((longs > 1) || (mod == 'j')) {
+                    fits = _put(&args, (mod == 'j') ? (uint64_t)va_arg(ap, uintmax_t)
+                                                    : va_arg(ap, unsigned long long), 8);
+                }
+                else if (longs == 1) {
+                    fits = _put(&args, (uint32_t)va_arg(ap, unsigned long), 4);
+                }
+                else if ((mod == 'z') || (mod == 't')) {
+                    fits = _put(&args, (uint32_t)va_arg(ap, size_t), 4);
+                }
+                else {
+                    fits = _put(&args, va_arg(ap, unsigned), 4);
+                }
+                break;
+            case 'c':
+                fits = _put(&args, va_arg(ap, int), 4);
+                break;
+            case 'p':
+                fits = _put(&args, (uintptr_t)va_arg(ap, void *), 4);
+                break;
+            case 's':
+                fits = _put_str(&args, va_arg(ap, const char *));
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': {
+                double d = (mod == 'L') ? (double)va_arg(ap, long double)
+                                        : va_arg(ap, double);
+                uint64_t raw;
+
+                memcpy(&raw, &d, sizeof(raw));
+                fits = _put(&args, raw, 8);
+                break;
+            }
+            case 'n':
+                (void)va_arg(ap, void *);
+                break;
+            case '%':
+                format++;
+                break;
+            default:
+                /* unknown or unterminated conversion */
+                return args.len;
+        }
+    }
+    return args.len;
+}
+
+static void _add(const uint8_t *rec, size_t len)
+{
+    unsigned state = irq_disable();
+
+    if (tsrb_free(&_rb) >= len) {
+        tsrb_add(&_rb, (const char *)rec, len);
+    }
+    else {
+        _dropped++;
+    }
+    irq_restore(state);
+    mutex_unlock(&_signal);
+}
+
+static void _le32(uint8_t *buf, uint32_t val)
+{
+    buf[0] = (uint8_t)val;
+    buf[1] = (uint8_t)(val >> 8);
+    buf[2] = (uint8_t)(val >> 16);
+    buf[3] = (uint8_t)(val >> 24);
+}
+
+static void _header(uint8_t *rec, uint32_t addr, unsigned level, size_t len)
+{
+    _le32(rec, addr);
+    rec[4] = level;
+    rec[5] = len;
+}
+
+void log_write(unsigned level, const char *format, ...)
+{
+    uint8_t rec[RECORD_MAX];
+    va_list ap;
+    size_t len;
+
+    va_start(ap, format);
+    len = _fetch(&rec[LOG_BINARY_HDR_SIZE], format, ap);
+    va_end(ap);
+
+    _header(rec, (uintptr_t)format, level, len);
+    _add(rec, LOG_BINARY_HDR_SIZE + len);
+}
+
+static void _stdio_sink(const uint8_t *rec, size_t len)
+{
+    static const char hex[] = "0123456789abcdef";
+    char line[1 + 2 * RECORD_MAX + 1];
+    size_t pos = 0;
+
+    line[pos++] = '@';
+    for (size_t i = 0; i < len; i++) {
+        line[pos++] = hex[rec[i] >> 4];
+        line[pos++] = hex[rec[i] & 0xf];
+    }
+    line[pos++] = '\n';
+    fwrite(line, 1, pos, stdout);
+}
+
+static void _drain(void)
+{
+    log_binary_sink_t sink;
+    uint8_t rec[RECORD_MAX];
+    unsigned dropped;
+    unsigned state;
+
+    mutex_lock(&_reader);
+    sink = (_sink) ? _sink : _stdio_sink;
+    /* the records are added in whole with interrupts disabled */
+    while (tsrb_get(&_rb, (char *)rec, LOG_BINARY_HDR_SIZE)) {
+        size_t len = rec[5];
+
+        tsrb_get(&_rb, (char *)&rec[LOG_BINARY_HDR_SIZE], len);
+        sink(rec, LOG_BINARY_HDR_SIZE + len);
+    }
+
+    state = irq_disable();
+    dropped = _dropped;
+    _dropped = 0;
+    irq_restore(state);
+    if (dropped) {
+        _header(rec, 0, LOG_NONE, 4);
+        _le32(&rec[LOG_BINARY_HDR_SIZE], dropped);
+        sink(rec, LOG_BINARY_HDR_SIZE + 4);
+    }
+    mutex_unlock(&_reader);
+}
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        mutex_lock(&_signal);
+        _drain();
+    }
+    return NULL;
+}
+
+void log_binary_init(void)
+{
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_IDLE - 1,
+                  THREAD_CREATE_STACKTEST, _thread, NULL, "log_binary");
+}
+
+void log_binary_set_sink(log_binary_sink_t sink)
+{
+    mutex_lock(&_reader);
+    _sink = sink;
+    mutex_unlock(&_reader);
+}
+
+void log_binary_flush(void)
+{
+    _drain();
+    fflush(stdout);
+}
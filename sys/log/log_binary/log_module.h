@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_log_binary Deferred binary log module
+ * @ingroup     sys
+ * @brief       Logs the arguments of messages in binary, to be formatted on
+ *              the host
+ *
+ * Formatting a message with printf and writing it to a UART blocks the
+ * caller for the whole time it takes to send the message. With this module,
+ * log_write() only records the address of the format string and the raw
+ * values of the arguments into a ring buffer (see @ref sys_tsrb), which
+ * takes a few microseconds. A thread of the lowest priority drains the
+ * buffer in the background and passes the records to a sink.
+ *
+ * The default sink writes every record as a line of `@` followed by the
+ * record in hex to stdio, i.e. to the UART, to RTT with `stdio_rtt` or to
+ * whatever other stdio is used. The format strings are not sent, the host
+ * tool `dist/tools/log_binary/log_decode.py` looks them up in the ELF file
+ * of the application and formats the messages:
+ *
+ *     make term | dist/tools/log_binary/log_decode.py bin/<board>/<app>.elf
+ *
+ * Other sinks are set with log_binary_set_sink(), e.g. to store the records
+ * on flash with @ref sys_mtdlog.
+ *
+ * A record consists of
+ *
+ * - the address of the format string (4 bytes, little endian),
+ * - the log level (1 byte),
+ * - the length of the arguments (1 byte),
+ * - the arguments in the order of the format string: integers and pointers
+ *   as 4 bytes, `long long` and `intmax_t` as 8 bytes, doubles as 8 bytes,
+ *   strings as their length (1 byte) followed by at most
+ *   @ref LOG_BINARY_STRLEN_MAX bytes of them.
+ *
+ * Records are dropped if the buffer is full, the number of dropped records
+ * is sent as a record with the address 0.
+ *
+ * @note    Messages are written only when no other thread is ready to run.
+ *          Call log_binary_flush() to write them e.g. before a reboot.
+ *
+ * @{
+ *
+ * @file
+ * @brief       log_module header of the deferred binary log
+ */
+
+#ifndef LOG_MODULE_H
+#define LOG_MODULE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the ring buffer in bytes, must be a power of two
+ */
+#ifndef LOG_BINARY_BUFSIZE
+#define LOG_BINARY_BUFSIZE          (512U)
+#endif
+
+/**
+ * @brief   Maximum length of the arguments of a record in bytes,
+ *          longer arguments are cut
+ */
+#ifndef LOG_BINARY_ARGS_MAX
+#define LOG_BINARY_ARGS_MAX         (48U)
+#endif
+
+/**
+ * @brief   Maximum number of bytes of a string argument, longer strings are
+ *          cut
+ */
+#ifndef LOG_BINARY_STRLEN_MAX
+#define LOG_BINARY_STRLEN_MAX       (16U)
+#endif
+
+/**
+ * @brief   Stack size of the thread writing the records
+ */
+#ifndef LOG_BINARY_STACKSIZE
+#define LOG_BINARY_STACKSIZE        (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Size of the header of a record
+ */
+#define LOG_BINARY_HDR_SIZE         (6U)
+
+/**
+ * @brief   Signature of a sink of records
+ *
+ * @param[in] rec   the record
+ * @param[in] len   length of @p rec
+ */
+typedef void (*log_binary_sink_t)(const uint8_t *rec, size_t len);
+
+/**
+ * @brief   Records a message
+ *
+ * Safe to be called from any thread and from interrupts.
+ *
+ * @param[in] level     log level of the message
+ * @param[in] format    format string of the message, must be stored for the
+ *                      lifetime of the application, i.e. a string literal
+ */
+void log_write(unsigned level, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief   Starts the thread writing the records
+ *
+ * Called by auto_init.
+ */
+void log_binary_init(void);
+
+/**
+ * @brief   Sets the sink of the records
+ *
+ * @param[in] sink  the new sink, NULL for the default sink writing to stdio
+ */
+void log_binary_set_sink(log_binary_sink_t sink);
+
+/**
+ * @brief   Writes all recorded messages to the sink, in the calling thread
+ */
+void log_binary_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOG_MODULE_H */
+/** @} */
@@ -34,7 +34,7 @@ void matstat_add(matstat_state_t *state, int32_t value)
     }
     else {
         int32_t new_mean = state->sum / state->count;
-        int64_t diff = (value - state->mean) * (value - new_mean);
+        int64_t diff = (int64_t)(value - state->mean) * (value - new_mean);
         if ((diff < 0) && ((uint64_t)(-diff) > state->sum_sq)) {
             /* Handle corner cases where sum_sq becomes negative */
             state->sum_sq = 0;
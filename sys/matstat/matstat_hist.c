@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_matstat
+ * @{
+ *
+ * @file
+ * @brief       Histograms of logarithmic buckets
+ *
+ * Bucket i covers the values of group g = i >> sub: group 0 holds the values
+ * 0 to 2^sub - 1 in buckets of width 1, group g > 0 the values 2^(sub+g-1) to
+ * 2^(sub+g) - 1 in 2^sub buckets of width 2^(g-1).
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "matstat.h"
+
+static inline unsigned _msb(uint32_t value)
+{
+#if ARCH_32_BIT
+    return bitarithm_msb(value);
+#else
+    return (value >> 16) ? 16 + bitarithm_msb(value >> 16)
+                         : bitarithm_msb(value);
+#endif
+}
+
+static inline unsigned _index(uint32_t value, unsigned sub)
+{
+    if (value < (2UL << sub)) {
+        return value;
+    }
+    unsigned msb = _msb(value);
+
+    /* the sub most significant bits below the top one select the bucket */
+    return ((msb - sub + 1) << sub) + (unsigned)(value >> (msb - sub)) -
+           (1U << sub);
+}
+
+static uint32_t _upper(unsigned index, unsigned sub)
+{
+    unsigned group = index >> sub;
+    uint32_t first = index & ((1U << sub) - 1);
+
+    if (group == 0) {
+        return first;
+    }
+    uint64_t low = (uint64_t)((1UL << sub) + first) << (group - 1);
+    uint64_t upper = low + (1ULL << (group - 1)) - 1;
+
+    return (upper > UINT32_MAX) ? UINT32_MAX : (uint32_t)upper;
+}
+
+void matstat_hist_init(matstat_hist_t *hist, uint32_t *buckets, size_t numof,
+                       uint8_t sub)
+{
+    assert((numof > 0) && (sub <= 8));
+    hist->buckets = buckets;
+    hist->numof = numof;
+    hist->sub = sub;
+    matstat_hist_clear(hist);
+}
+
+void matstat_hist_clear(matstat_hist_t *hist)
+{
+    memset(hist->buckets, 0, hist->numof * sizeof(hist->buckets[0]));
+    hist->count = 0;
+}
+
+void matstat_hist_add(matstat_hist_t *hist, uint32_t value)
+{
+    unsigned index = _index(value, hist->sub);
+
+    if (index >= hist->numof) {
+        index = hist->numof - 1;
+    }
+    hist->buckets[index]++;
+    hist->count++;
+}
+
+uint32_t matstat_hist_quantile(const matstat_hist_t *hist, uint32_t ppm)
+{
+    if (hist->count == 0) {
+        return 0;
+    }
+    /* rank of the quantile, rounded up, starting with 1 */
+    uint64_t rank = ((uint64_t)hist->count * ppm + 999999U) / 1000000U;
+    uint64_t seen = 0;
+
+    if (rank == 0) {
+        rank = 1;
+    }
+    for (unsigned i = 0; i < hist->numof; i++) {
+        seen += hist->buckets[i];
+        if (seen >= rank) {
+            return _upper(i, hist->sub);
+        }
+    }
+    return _upper(hist->numof - 1, hist->sub);
+}
+
+void matstat_hist_merge(matstat_hist_t *dest, const matstat_hist_t *src)
+{
+    assert((dest->numof == src->numof) && (dest->sub == src->sub));
+    for (unsigned i = 0; i < dest->numof; i++) {
+        dest->buckets[i] += src->buckets[i];
+    }
+    dest->count += src->count;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_matstat
+ * @{
+ *
+ * @file
+ * @brief       Statistics over a sliding window
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#include "matstat.h"
+
+void matstat_window_init(matstat_window_t *win, int32_t *values,
+                         uint32_t size)
+{
+    assert(size > 0);
+    win->values = values;
+    win->sum = 0;
+    win->sum_sq = 0;
+    win->size = size;
+    win->count = 0;
+    win->pos = 0;
+}
+
+void matstat_window_add(matstat_window_t *win, int32_t value)
+{
+    if (win->count == win->size) {
+        int32_t old = win->values[win->pos];
+
+        win->sum -= old;
+        win->sum_sq -= (uint64_t)((int64_t)old * old);
+    }
+    else {
+        win->count++;
+    }
+    win->values[win->pos] = value;
+    win->sum += value;
+    win->sum_sq += (uint64_t)((int64_t)value * value);
+    if (++win->pos == win->size) {
+        win->pos = 0;
+    }
+}
+
+int32_t matstat_window_mean(const matstat_window_t *win)
+{
+    if (win->count == 0) {
+        return 0;
+    }
+    return (int32_t)(win->sum / (int64_t)win->count);
+}
+
+uint64_t matstat_window_variance(const matstat_window_t *win)
+{
+    if (win->count < 2) {
+        return 0;
+    }
+    /* sum^2 / count, split up with sum = q * count + r to fit 64 bit */
+    int64_t q = win->sum / (int64_t)win->count;
+    int64_t r = win->sum % (int64_t)win->count;
+    uint64_t sq_mean = (uint64_t)(q * win->sum + q * r) +
+                       (uint64_t)((r * r) / win->count);
+
+    if (sq_mean > win->sum_sq) {
+        /* never exceeds the sum of squares except by rounding */
+        return 0;
+    }
+    return (win->sum_sq - sq_mean) / (win->count - 1);
+}
+
+int32_t matstat_window_min(const matstat_window_t *win)
+{
+    int32_t min = INT32_MAX;
+
+    for (uint32_t i = 0; i < win->count; i++) {
+        if (win->values[i] < min) {
+            min = win->values[i];
+        }
+    }
+    return min;
+}
+
+int32_t matstat_window_max(const matstat_window_t *win)
+{
+    int32_t max = INT32_MIN;
+
+    for (uint32_t i = 0; i < win->count; i++) {
+        if (win->values[i] > max) {
+            max = win->values[i];
+        }
+    }
+    return max;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_msg_buf
+ * @{
+ *
+ * @file
+ * @brief       Owned message buffer implementation
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+
+#include "irq.h"
+#include "msg_buf.h"
+
+static void _pool_release(msg_buf_t *buf)
+{
+    msg_buf_pool_t *pool = buf->ctx;
+    unsigned state = irq_disable();
+
+    memarray_free(&pool->mem, buf);
+    irq_restore(state);
+}
+
+void msg_buf_pool_init(msg_buf_pool_t *pool, void *data, size_t capacity,
+                       size_t num)
+{
+    memarray_init(&pool->mem, data, MSG_BUF_POOL_ELEM_SIZE(capacity), num);
+    pool->capacity = capacity;
+}
+
+msg_buf_t *msg_buf_alloc(msg_buf_pool_t *pool)
+{
+    unsigned state = irq_disable();
+    msg_buf_t *buf = memarray_alloc(&pool->mem);
+
+    irq_restore(state);
+    if (buf) {
+        /* the payload follows the header */
+        msg_buf_init(buf, buf + 1, pool->capacity, _pool_release, pool);
+        buf->size = 0;
+    }
+    return buf;
+}
+
+static int _send(kernel_pid_t target, uint16_t type, msg_buf_t *buf,
+                 bool block)
+{
+    msg_t msg = { .type = type, .content = { .ptr = buf } };
+    int res = (block) ? msg_send(&msg, target) : msg_try_send(&msg, target);
+
+    if (res != 1) {
+        /* nobody else will get hold of it */
+        msg_buf_release(buf);
+    }
+    return res;
+}
+
+int msg_send_buf(kernel_pid_t target, uint16_t type, msg_buf_t *buf)
+{
+    return _send(target, type, buf, true);
+}
+
+int msg_try_send_buf(kernel_pid_t target, uint16_t type, msg_buf_t *buf)
+{
+    return _send(target, type, buf, false);
+}
+
+msg_buf_t *msg_receive_buf(uint16_t *type)
+{
+    msg_t msg;
+
+    msg_receive(&msg);
+    if (type) {
+        *type = msg.type;
+    }
+    return msg_buf_from_msg(&msg);
+}
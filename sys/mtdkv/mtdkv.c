@@ -0,0 +1,545 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_mtdkv
+ * @{
+ *
+ * @file
+ * @brief       Key/value store implementation
+ *
+ * A record is the horizon, flags, the key length, the key and the value. The
+ * horizon is the oldest sector of the log when the record was written: all
+ * records still used are at or after it, so older ones are dropped from the
+ * index when replaying. This matters as the log does not erase sectors given
+ * up, they show up again on mount.
+ *
+ * The first record of a commit is flagged FIRST, all but the last are
+ * flagged MORE. A commit ends with its last record, the records of a commit
+ * torn by a power loss are discarded by the next FIRST.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "hashes.h"
+#include "mtdkv.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define HDR_HORIZON     (0U)
+#define HDR_FLAGS       (4U)
+#define HDR_KEY_LEN     (5U)
+
+#define F_FIRST         (0x01)  /**< first record of a commit */
+#define F_MORE          (0x02)  /**< the commit continues */
+#define F_DELETE        (0x04)  /**< deletion mark */
+
+#define SLOT_USED       (0x01)
+#define SLOT_DELETED    (0x02)
+
+#define MASK            (MTDKV_INDEX_SIZE - 1)
+
+#if (MTDKV_INDEX_SIZE & MASK)
+#error "MTDKV_INDEX_SIZE must be a power of two"
+#endif
+#if (MTDKV_KEY_MAX > UINT8_MAX)
+#error "MTDKV_KEY_MAX must fit into a byte"
+#endif
+
+static uint32_t _hash(const char *key, size_t klen)
+{
+    return djb2_hash((const uint8_t *)key, klen);
+}
+
+static uint32_t _used(mtdkv_t *kv)
+{
+    return kv->log.numof - mtdlog_sectors_free(&kv->log);
+}
+
+static uint32_t _tail(mtdkv_t *kv)
+{
+    mtdlog_cursor_t cur;
+
+    mtdlog_cursor_oldest(&kv->log, &cur);
+    return cur.seq;
+}
+
+/* reads the record at pos into kv->buf */
+static int _read_at(mtdkv_t *kv, const mtdlog_cursor_t *pos)
+{
+    mtdlog_cursor_t cur = *pos;
+    int res = mtdlog_read(&kv->log, &cur, kv->buf, sizeof(kv->buf));
+
+    if (res < 0) {
+        return res;
+    }
+    if ((res < (int)MTDKV_RECORD_HDR) ||
+        ((MTDKV_RECORD_HDR + kv->buf[HDR_KEY_LEN]) > (unsigned)res) ||
+        (cur.seq != pos->seq) ||
+        (cur.off != (pos->off + MTDLOG_RECORD_SIZE(res)))) {
+        return -EIO;
+    }
+    return res;
+}
+
+static int _find(mtdkv_t *kv, const char *key, size_t klen, uint32_t hash,
+                 int *rec_len)
+{
+    for (unsigned i = hash & MASK; kv->index[i].flags; i = (i + 1) & MASK) {
+        if (kv->index[i].hash != hash) {
+            continue;
+        }
+        int res = _read_at(kv, &kv->index[i].pos);
+        if (res < 0) {
+            return res;
+        }
+        if ((kv->buf[HDR_KEY_LEN] == klen) &&
+            (memcmp(&kv->buf[MTDKV_RECORD_HDR], key, klen) == 0)) {
+            if (rec_len) {
+                *rec_len = res;
+            }
+            return i;
+        }
+    }
+    return -ENOENT;
+}
+
+static void _remove(mtdkv_t *kv, unsigned i)
+{
+    /* shift back the following slots, which would not be found otherwise */
+    for (unsigned j = (i + 1) & MASK; kv->index[j].flags; j = (j + 1) & MASK) {
+        unsigned home = kv->index[j].hash & MASK;
+
+        if (((j - home) & MASK) >= ((j - i) & MASK)) {
+            kv->index[i] = kv->index[j];
+            i = j;
+        }
+    }
+    kv->index[i].flags = 0;
+    kv->numof--;
+}
+
+static int _apply(mtdkv_t *kv, const char *key, size_t klen,
+                  const mtdlog_cursor_t *pos, bool delete)
+{
+    uint32_t hash = _hash(key, klen);
+    int slot = _find(kv, key, klen, hash, NULL);
+
+    if (slot == -ENOENT) {
+        if (delete) {
+            return 0;
+        }
+        if (kv->numof >= (MTDKV_INDEX_SIZE - 1)) {
+            return -ENOMEM;
+        }
+        slot = hash & MASK;
+        while (kv->index[slot].flags) {
+            slot = (slot + 1) & MASK;
+        }
+        kv->index[slot].hash = hash;
+        kv->numof++;
+    }
+    else if (slot < 0) {
+        return slot;
+    }
+    kv->index[slot].pos = *pos;
+    kv->index[slot].flags = SLOT_USED | (delete ? SLOT_DELETED : 0);
+    return 0;
+}
+
+static int _apply_at(mtdkv_t *kv, const mtdlog_cursor_t *pos)
+{
+    char key[MTDKV_KEY_MAX];
+    int res = _read_at(kv, pos);
+
+    if (res < 0) {
+        return res;
+    }
+    size_t klen = kv->buf[HDR_KEY_LEN];
+    if (klen > MTDKV_KEY_MAX) {
+        return 0;
+    }
+    memcpy(key, &kv->buf[MTDKV_RECORD_HDR], klen);
+    return _apply(kv, key, klen, pos, kv->buf[HDR_FLAGS] & F_DELETE);
+}
+
+static void _purge(mtdkv_t *kv, uint32_t horizon)
+{
+    for (unsigned i = 0; i < MTDKV_INDEX_SIZE;) {
+        if (kv->index[i].flags &&
+            ((int32_t)(kv->index[i].pos.seq - horizon) < 0)) {
+            /* refills slot i */
+            _remove(kv, i);
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+static int _mount(mtdkv_t *kv)
+{
+    mtdlog_cursor_t cur, pending[MTDKV_COMMIT_MAX];
+    unsigned numof = 0;
+    bool in_commit = false;
+    uint32_t horizon;
+    int res;
+
+    memset(kv->index, 0, sizeof(kv->index));
+    kv->numof = 0;
+    mtdlog_cursor_oldest(&kv->log, &cur);
+    horizon = cur.seq;
+    while ((res = mtdlog_read(&kv->log, &cur, kv->buf, sizeof(kv->buf))) != 0) {
+        if (res < 0) {
+            return res;
+        }
+        if ((res < (int)MTDKV_RECORD_HDR) ||
+            ((MTDKV_RECORD_HDR + kv->buf[HDR_KEY_LEN]) > (unsigned)res)) {
+            in_commit = false;
+            continue;
+        }
+
+        uint32_t rec_horizon;
+        uint8_t flags = kv->buf[HDR_FLAGS];
+
+        memcpy(&rec_horizon, &kv->buf[HDR_HORIZON], sizeof(rec_horizon));
+        if ((int32_t)(rec_horizon - horizon) > 0) {
+            horizon = rec_horizon;
+            _purge(kv, horizon);
+        }
+        if (flags & F_FIRST) {
+            in_commit = true;
+            numof = 0;
+        }
+        if (!in_commit) {
+            continue;
+        }
+        if (numof == MTDKV_COMMIT_MAX) {
+            in_commit = false;
+            continue;
+        }
+        pending[numof].seq = cur.seq;
+        pending[numof].off = cur.off - MTDLOG_RECORD_SIZE(res);
+        numof++;
+        if (!(flags & F_MORE)) {
+            in_commit = false;
+            for (unsigned i = 0; i < numof; i++) {
+                res = _apply_at(kv, &pending[i]);
+                if (res < 0) {
+                    return res;
+                }
+            }
+        }
+    }
+    DEBUG("mtdkv: %u keys\n", kv->numof);
+    return 0;
+}
+
+/* true if the update replaces the value of the record in kv->buf */
+static bool _replaces(mtdkv_t *kv, const mtdkv_update_t *update)
+{
+    size_t klen = strlen(update->key);
+
+    return (kv->buf[HDR_KEY_LEN] == klen) &&
+           (memcmp(&kv->buf[MTDKV_RECORD_HDR], update->key, klen) == 0);
+}
+
+/* true if no value refers to the oldest sector, after applying updates */
+static bool _dead(mtdkv_t *kv, const mtdkv_update_t *updates, unsigned numof)
+{
+    uint32_t tail = _tail(kv);
+
+    for (unsigned i = 0; i < MTDKV_INDEX_SIZE; i++) {
+        mtdkv_slot_t *slot = &kv->index[i];
+        bool replaced = false;
+
+        if ((slot->flags != SLOT_USED) || (slot->pos.seq != tail)) {
+            continue;
+        }
+        for (unsigned j = 0; (j < numof) && !replaced; j++) {
+            if (_hash(updates[j].key, strlen(updates[j].key)) == slot->hash) {
+                replaced = (_read_at(kv, &slot->pos) >= 0) &&
+                           _replaces(kv, &updates[j]);
+            }
+        }
+        if (!replaced) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* moves the values of the oldest sector to the head and gives it up */
+static int _gc(mtdkv_t *kv)
+{
+    uint32_t tail = _tail(kv);
+    uint32_t used = _used(kv);
+    int res;
+
+    if (used == 0) {
+        return -ENOSPC;
+    }
+    if (used == 1) {
+        mtdlog_seal(&kv->log);
+    }
+    DEBUG("mtdkv: collect sector %" PRIu32 "\n", tail);
+    for (unsigned i = 0; i < MTDKV_INDEX_SIZE;) {
+        mtdkv_slot_t *slot = &kv->index[i];
+
+        if (!slot->flags || (slot->pos.seq != tail)) {
+            i++;
+            continue;
+        }
+        if (slot->flags & SLOT_DELETED) {
+            /* older values are before the horizon of the next record */
+            _remove(kv, i);
+            continue;
+        }
+        res = _read_at(kv, &slot->pos);
+        if (res < 0) {
+            return res;
+        }
+        memcpy(&kv->buf[HDR_HORIZON], &tail, sizeof(tail));
+        kv->buf[HDR_FLAGS] = F_FIRST;
+        res = mtdlog_append(&kv->log, kv->buf, res, &slot->pos);
+        if (res < 0) {
+            return res;
+        }
+        i++;
+    }
+    res = mtdlog_drop_oldest(&kv->log);
+    return (res == -EINVAL) ? -ENOSPC : res;
+}
+
+/* gives up oldest sectors that hold no values */
+static int _trim(mtdkv_t *kv)
+{
+    while ((_used(kv) > 1) && _dead(kv, NULL, 0)) {
+        int res = _gc(kv);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+static size_t _record_len(const mtdkv_update_t *update)
+{
+    return MTDKV_RECORD_HDR + strlen(update->key) +
+           ((update->value != NULL) ? update->len : 0);
+}
+
+/* number of sectors started when appending the updates */
+static unsigned _advances(mtdkv_t *kv, const mtdkv_update_t *updates,
+                          unsigned numof)
+{
+    uint32_t room = kv->log.sector_size - kv->log.head_off;
+    unsigned res = 0;
+
+    for (unsigned i = 0; i < numof; i++) {
+        uint32_t size = MTDLOG_RECORD_SIZE(_record_len(&updates[i]));
+
+        if (size > room) {
+            res++;
+            room = MTDLOG_SECTOR_PAYLOAD(kv->log.sector_size);
+        }
+        room -= size;
+    }
+    return res;
+}
+
+/* collects sectors until the updates fit and one sector is left for
+ * collecting */
+static int _reserve(mtdkv_t *kv, const mtdkv_update_t *updates,
+                    unsigned numof)
+{
+    for (unsigned i = 0; i <= kv->log.numof; i++) {
+        uint32_t free = mtdlog_sectors_free(&kv->log);
+        unsigned advances = _advances(kv, updates, numof);
+
+        if ((free >= advances) &&
+            ((free - advances + _dead(kv, updates, numof)) >= 1)) {
+            return 0;
+        }
+        int res = _gc(kv);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return -ENOSPC;
+}
+
+static int _commit(mtdkv_t *kv, const mtdkv_update_t *updates,
+                   unsigned numof)
+{
+    mtdlog_cursor_t pos[MTDKV_COMMIT_MAX];
+    unsigned added = 0;
+    int res = _reserve(kv, updates, numof);
+
+    if (res < 0) {
+        return res;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        const char *key = updates[i].key;
+        size_t klen = strlen(key);
+
+        if (updates[i].value == NULL) {
+            continue;
+        }
+        res = _find(kv, key, klen, _hash(key, klen), NULL);
+        if (res == -ENOENT) {
+            added++;
+        }
+        else if (res < 0) {
+            return res;
+        }
+    }
+    if ((kv->numof + added) >= MTDKV_INDEX_SIZE) {
+        return -ENOMEM;
+    }
+
+    uint32_t horizon = _tail(kv);
+    for (unsigned i = 0; i < numof; i++) {
+        const mtdkv_update_t *update = &updates[i];
+        size_t klen = strlen(update->key);
+
+        memcpy(&kv->buf[HDR_HORIZON], &horizon, sizeof(horizon));
+        kv->buf[HDR_FLAGS] = ((i == 0) ? F_FIRST : 0) |
+                             ((i < (numof - 1)) ? F_MORE : 0) |
+                             ((update->value == NULL) ? F_DELETE : 0);
+        kv->buf[HDR_KEY_LEN] = klen;
+        memcpy(&kv->buf[MTDKV_RECORD_HDR], update->key, klen);
+        if (update->value != NULL) {
+            memcpy(&kv->buf[MTDKV_RECORD_HDR + klen], update->value,
+                   update->len);
+        }
+        res = mtdlog_append(&kv->log, kv->buf, _record_len(update), &pos[i]);
+        if (res < 0) {
+            /* the records written are discarded on mount */
+            return res;
+        }
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        res = _apply(kv, updates[i].key, strlen(updates[i].key), &pos[i],
+                     updates[i].value == NULL);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return _trim(kv);
+}
+
+static bool _valid(const mtdkv_update_t *update)
+{
+    size_t klen = strlen(update->key);
+
+    return (klen > 0) && (klen <= MTDKV_KEY_MAX) &&
+           ((update->value == NULL) || (update->len <= MTDKV_VALUE_MAX));
+}
+
+int mtdkv_init(mtdkv_t *kv, mtd_dev_t *dev, uint32_t first, uint32_t numof)
+{
+    int res = mtdlog_init(&kv->log, dev, first, numof);
+
+    if (res < 0) {
+        return res;
+    }
+    if ((kv->log.sector_size < MTDLOG_RECORD_SIZE(sizeof(kv->buf))) ||
+        (MTDLOG_SECTOR_PAYLOAD(kv->log.sector_size) <
+         MTDLOG_RECORD_SIZE(sizeof(kv->buf)))) {
+        return -EINVAL;
+    }
+    kv->log.keep = true;
+    mutex_init(&kv->lock);
+
+    mutex_lock(&kv->lock);
+    res = _mount(kv);
+    if (res == 0) {
+        res = _trim(kv);
+    }
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int mtdkv_get(mtdkv_t *kv, const char *key, void *value, size_t len)
+{
+    size_t klen = strlen(key);
+    int rec_len;
+
+    mutex_lock(&kv->lock);
+    int res = _find(kv, key, klen, _hash(key, klen), &rec_len);
+    if ((res >= 0) && (kv->index[res].flags & SLOT_DELETED)) {
+        res = -ENOENT;
+    }
+    else if (res >= 0) {
+        size_t vlen = rec_len - MTDKV_RECORD_HDR - klen;
+
+        if (vlen > len) {
+            res = -ENOBUFS;
+        }
+        else {
+            memcpy(value, &kv->buf[MTDKV_RECORD_HDR + klen], vlen);
+            res = vlen;
+        }
+    }
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int mtdkv_set(mtdkv_t *kv, const char *key, const void *value, size_t len)
+{
+    mtdkv_update_t update = { .key = key, .value = value, .len = len };
+
+    return mtdkv_commit(kv, &update, 1);
+}
+
+int mtdkv_delete(mtdkv_t *kv, const char *key)
+{
+    mtdkv_update_t update = { .key = key };
+    size_t klen = strlen(key);
+
+    if (!_valid(&update)) {
+        return -ENOENT;
+    }
+    mutex_lock(&kv->lock);
+    int res = _find(kv, key, klen, _hash(key, klen), NULL);
+    if ((res >= 0) && (kv->index[res].flags & SLOT_DELETED)) {
+        res = -ENOENT;
+    }
+    if (res >= 0) {
+        res = _commit(kv, &update, 1);
+    }
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int mtdkv_commit(mtdkv_t *kv, const mtdkv_update_t *updates, unsigned numof)
+{
+    if (numof > MTDKV_COMMIT_MAX) {
+        return -EINVAL;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        if (!_valid(&updates[i])) {
+            return -EINVAL;
+        }
+    }
+    if (numof == 0) {
+        return 0;
+    }
+
+    mutex_lock(&kv->lock);
+    int res = _commit(kv, updates, numof);
+    mutex_unlock(&kv->lock);
+    return res;
+}
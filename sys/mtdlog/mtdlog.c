@@ -0,0 +1,508 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_mtdlog
+ * @{
+ *
+ * @file
+ * @brief       Append-only ring log implementation
+ *
+ * The used sectors are the ones from tail to head, their sequence numbers
+ * increase by one from tail_seq to head_seq. An empty log has
+ * head_seq == tail_seq - 1 and a full head sector, so the first append
+ * erases and uses sector 0.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "mtdlog.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define ALIGN(n)        ((((n) + MTDLOG_ALIGN - 1) / MTDLOG_ALIGN) * MTDLOG_ALIGN)
+#define SECTOR_HDR      ALIGN(sizeof(mtdlog_sector_hdr_t))
+#define RECORD_HDR      sizeof(mtdlog_record_hdr_t)
+/* staging buffer for writes, a multiple of the alignment */
+#define STAGE_SIZE      ALIGN(32U)
+
+static uint32_t _addr(const mtdlog_t *log, uint32_t sector, uint32_t off)
+{
+    return ((log->first + sector) * log->sector_size) + off;
+}
+
+static uint32_t _used(const mtdlog_t *log)
+{
+    return log->head_seq - log->tail_seq + 1;
+}
+
+static int _write(mtdlog_t *log, uint32_t addr, const uint8_t *data,
+                  size_t len)
+{
+    uint32_t page_size = log->dev->page_size;
+
+    /* page programs must not cross page boundaries */
+    while (len > 0) {
+        size_t chunk = page_size - (addr % page_size);
+        if (chunk > len) {
+            chunk = len;
+        }
+        int res = mtd_write(log->dev, data, addr, chunk);
+        if (res < 0) {
+            return res;
+        }
+        data += chunk;
+        addr += chunk;
+        len -= chunk;
+    }
+    return 0;
+}
+
+/* writes a followed by b, padded to the alignment */
+static int _write_padded(mtdlog_t *log, uint32_t addr, const void *a,
+                         size_t a_len, const void *b, size_t b_len)
+{
+    uint8_t stage[STAGE_SIZE];
+    const uint8_t *src = a;
+    size_t fill = 0;
+    size_t left = a_len;
+
+    for (unsigned part = 0; part < 2; part++) {
+        while (left > 0) {
+            size_t chunk = sizeof(stage) - fill;
+            if (chunk > left) {
+                chunk = left;
+            }
+            memcpy(&stage[fill], src, chunk);
+            fill += chunk;
+            src += chunk;
+            left -= chunk;
+            if (fill == sizeof(stage)) {
+                int res = _write(log, addr, stage, fill);
+                if (res < 0) {
+                    return res;
+                }
+                addr += fill;
+                fill = 0;
+            }
+        }
+        src = b;
+        left = b_len;
+    }
+    if (fill > 0) {
+        memset(&stage[fill], 0xff, ALIGN(fill) - fill);
+        return _write(log, addr, stage, ALIGN(fill));
+    }
+    return 0;
+}
+
+/* returns 1 if the sector is in use, 0 if not */
+static int _read_sector_hdr(mtdlog_t *log, uint32_t sector, uint32_t *seq)
+{
+    mtdlog_sector_hdr_t hdr;
+    int res = mtd_read(log->dev, &hdr, _addr(log, sector, 0), sizeof(hdr));
+
+    if (res < 0) {
+        return res;
+    }
+    *seq = hdr.seq;
+    return (hdr.magic == MTDLOG_MAGIC);
+}
+
+static uint16_t _crc_start(uint16_t len)
+{
+    return crc16_ccitt_calc((const unsigned char *)&len, sizeof(len));
+}
+
+/* returns 1 if the data of the record at addr matches its CRC */
+static int _check_record(mtdlog_t *log, uint32_t addr,
+                         const mtdlog_record_hdr_t *hdr)
+{
+    uint8_t buf[STAGE_SIZE];
+    uint16_t crc = _crc_start(hdr->len);
+
+    addr += RECORD_HDR;
+    for (size_t left = hdr->len; left > 0;) {
+        size_t chunk = (left > sizeof(buf)) ? sizeof(buf) : left;
+        int res = mtd_read(log->dev, buf, addr, chunk);
+        if (res < 0) {
+            return res;
+        }
+        crc = crc16_ccitt_update(crc, buf, chunk);
+        addr += chunk;
+        left -= chunk;
+    }
+    return (crc == hdr->crc);
+}
+
+/* returns 1 if the rest of the sector is erased */
+static int _check_erased(mtdlog_t *log, uint32_t sector, uint32_t off)
+{
+    uint8_t buf[STAGE_SIZE];
+
+    while (off < log->sector_size) {
+        size_t chunk = log->sector_size - off;
+        if (chunk > sizeof(buf)) {
+            chunk = sizeof(buf);
+        }
+        int res = mtd_read(log->dev, buf, _addr(log, sector, off), chunk);
+        if (res < 0) {
+            return res;
+        }
+        for (size_t i = 0; i < chunk; i++) {
+            if (buf[i] != 0xff) {
+                return 0;
+            }
+        }
+        off += chunk;
+    }
+    return 1;
+}
+
+static void _set_empty(mtdlog_t *log)
+{
+    log->tail = 0;
+    log->tail_seq = 0;
+    log->head = log->numof - 1;
+    log->head_seq = UINT32_MAX;
+    log->head_off = log->sector_size;
+}
+
+/* finds the end of the records in the head sector */
+static int _scan_head(mtdlog_t *log)
+{
+    uint32_t off = SECTOR_HDR;
+    int res;
+
+    while ((off + RECORD_HDR) <= log->sector_size) {
+        mtdlog_record_hdr_t hdr;
+        uint32_t addr = _addr(log, log->head, off);
+
+        res = mtd_read(log->dev, &hdr, addr, sizeof(hdr));
+        if (res < 0) {
+            return res;
+        }
+        if (hdr.len == UINT16_MAX) {
+            break;
+        }
+        if ((off + RECORD_HDR + hdr.len) > log->sector_size) {
+            off = log->sector_size;
+            break;
+        }
+        res = _check_record(log, addr, &hdr);
+        if (res < 0) {
+            return res;
+        }
+        if (res == 0) {
+            DEBUG("mtdlog: torn record at %" PRIu32 "\n", off);
+            off = log->sector_size;
+            break;
+        }
+        off += ALIGN(RECORD_HDR + hdr.len);
+    }
+    /* a write torn by a power loss may have left bits behind the last
+     * record, appending continues in the next sector then */
+    res = _check_erased(log, log->head, off);
+    if (res < 0) {
+        return res;
+    }
+    log->head_off = (res == 1) ? off : log->sector_size;
+    return 0;
+}
+
+static int _mount(mtdlog_t *log)
+{
+    uint32_t seq0;
+    uint32_t seq;
+    int res = _read_sector_hdr(log, 0, &seq0);
+
+    if (res < 0) {
+        return res;
+    }
+    bool valid0 = (res == 1);
+    if (!valid0) {
+        /* either the log is empty, or power was lost while recycling
+         * sector 0 after the last sector */
+        res = _read_sector_hdr(log, log->numof - 1, &seq);
+        if (res < 0) {
+            return res;
+        }
+        if (res == 0) {
+            _set_empty(log);
+            DEBUG("mtdlog: empty\n");
+            return 0;
+        }
+        log->head = log->numof - 1;
+        log->head_seq = seq;
+    }
+    else {
+        /* sectors 0 to head continue the sequence of sector 0, all behind
+         * the head are older or unused */
+        uint32_t lo = 0;
+        uint32_t hi = log->numof - 1;
+
+        log->head_seq = seq0;
+        while (lo < hi) {
+            uint32_t mid = lo + ((hi - lo + 1) / 2);
+            res = _read_sector_hdr(log, mid, &seq);
+            if (res < 0) {
+                return res;
+            }
+            if ((res == 1) && ((seq - seq0) < log->numof)) {
+                lo = mid;
+                log->head_seq = seq;
+            }
+            else {
+                hi = mid - 1;
+            }
+        }
+        log->head = lo;
+    }
+
+    /* the tail follows the head, or the sector after it if power was lost
+     * while recycling, or is sector 0 if the log did not wrap yet */
+    log->tail = log->head;
+    log->tail_seq = log->head_seq;
+    for (uint32_t i = 1; i <= 2; i++) {
+        uint32_t sector = (log->head + i) % log->numof;
+        res = _read_sector_hdr(log, sector, &seq);
+        if (res < 0) {
+            return res;
+        }
+        if ((res == 1) && ((log->head_seq - seq) < log->numof)) {
+            log->tail = sector;
+            log->tail_seq = seq;
+            break;
+        }
+        if ((i == 2) && valid0) {
+            log->tail = 0;
+            log->tail_seq = seq0;
+        }
+    }
+    DEBUG("mtdlog: head %" PRIu32 " (%" PRIu32 "), tail %" PRIu32 " (%" PRIu32
+          ")\n", log->head, log->head_seq, log->tail, log->tail_seq);
+    return _scan_head(log);
+}
+
+int mtdlog_init(mtdlog_t *log, mtd_dev_t *dev, uint32_t first, uint32_t numof)
+{
+    int res = mtd_init(dev);
+
+    if (res < 0) {
+        return res;
+    }
+    if ((numof < 2) || ((first + numof) > dev->sector_count)) {
+        return -EINVAL;
+    }
+    log->dev = dev;
+    log->first = first;
+    log->numof = numof;
+    log->sector_size = dev->page_size * dev->pages_per_sector;
+    log->keep = false;
+    mutex_init(&log->lock);
+
+    mutex_lock(&log->lock);
+    res = _mount(log);
+    mutex_unlock(&log->lock);
+    return res;
+}
+
+static int _advance(mtdlog_t *log)
+{
+    uint32_t next = (log->head + 1) % log->numof;
+    mtdlog_sector_hdr_t hdr = {
+        .seq = log->head_seq + 1,
+        .magic = MTDLOG_MAGIC,
+    };
+
+    if (_used(log) == log->numof) {
+        if (log->keep) {
+            return -ENOSPC;
+        }
+        /* overwrite the oldest records */
+        log->tail = (log->tail + 1) % log->numof;
+        log->tail_seq++;
+    }
+    DEBUG("mtdlog: advance to sector %" PRIu32 " (%" PRIu32 ")\n", next,
+          hdr.seq);
+    int res = mtd_erase(log->dev, _addr(log, next, 0), log->sector_size);
+    if (res < 0) {
+        return res;
+    }
+    res = _write_padded(log, _addr(log, next, 0), &hdr, sizeof(hdr), NULL, 0);
+    if (res < 0) {
+        return res;
+    }
+    log->head = next;
+    log->head_seq++;
+    log->head_off = SECTOR_HDR;
+    return 0;
+}
+
+int mtdlog_append(mtdlog_t *log, const void *data, size_t len,
+                  mtdlog_cursor_t *pos)
+{
+    if ((len >= UINT16_MAX) ||
+        ((SECTOR_HDR + RECORD_HDR + len) > log->sector_size)) {
+        return -EMSGSIZE;
+    }
+
+    mtdlog_record_hdr_t hdr = { .len = len };
+    hdr.crc = crc16_ccitt_update(_crc_start(hdr.len), data, len);
+
+    mutex_lock(&log->lock);
+    int res = 0;
+    if ((log->head_off + RECORD_HDR + len) > log->sector_size) {
+        res = _advance(log);
+    }
+    if (res == 0) {
+        res = _write_padded(log, _addr(log, log->head, log->head_off),
+                            &hdr, sizeof(hdr), data, len);
+        if (res < 0) {
+            /* the record may be partially written */
+            log->head_off = log->sector_size;
+        }
+        else {
+            if (pos != NULL) {
+                pos->seq = log->head_seq;
+                pos->off = log->head_off;
+            }
+            log->head_off += ALIGN(RECORD_HDR + len);
+        }
+    }
+    mutex_unlock(&log->lock);
+    return res;
+}
+
+uint32_t mtdlog_sectors_free(mtdlog_t *log)
+{
+    mutex_lock(&log->lock);
+    uint32_t res = log->numof - _used(log);
+    mutex_unlock(&log->lock);
+    return res;
+}
+
+int mtdlog_drop_oldest(mtdlog_t *log)
+{
+    int res = -EINVAL;
+
+    mutex_lock(&log->lock);
+    if (_used(log) > 1) {
+        log->tail = (log->tail + 1) % log->numof;
+        log->tail_seq++;
+        res = 0;
+    }
+    mutex_unlock(&log->lock);
+    return res;
+}
+
+void mtdlog_seal(mtdlog_t *log)
+{
+    mutex_lock(&log->lock);
+    log->head_off = log->sector_size;
+    mutex_unlock(&log->lock);
+}
+
+int mtdlog_erase(mtdlog_t *log)
+{
+    mutex_lock(&log->lock);
+    int res = mtd_erase(log->dev, _addr(log, 0, 0),
+                        log->numof * log->sector_size);
+    _set_empty(log);
+    mutex_unlock(&log->lock);
+    return res;
+}
+
+void mtdlog_cursor_oldest(mtdlog_t *log, mtdlog_cursor_t *cur)
+{
+    mutex_lock(&log->lock);
+    cur->seq = log->tail_seq;
+    cur->off = SECTOR_HDR;
+    mutex_unlock(&log->lock);
+}
+
+void mtdlog_cursor_newest(mtdlog_t *log, mtdlog_cursor_t *cur)
+{
+    mutex_lock(&log->lock);
+    if (_used(log) == 0) {
+        cur->seq = log->tail_seq;
+        cur->off = SECTOR_HDR;
+    }
+    else {
+        cur->seq = log->head_seq;
+        cur->off = log->head_off;
+    }
+    mutex_unlock(&log->lock);
+}
+
+int mtdlog_read(mtdlog_t *log, mtdlog_cursor_t *cur, void *buf, size_t len)
+{
+    int res;
+
+    mutex_lock(&log->lock);
+    while (1) {
+        uint32_t idx = cur->seq - log->tail_seq;
+
+        if ((int32_t)idx < 0) {
+            /* the sector was recycled */
+            cur->seq = log->tail_seq;
+            cur->off = SECTOR_HDR;
+            res = -EOVERFLOW;
+            break;
+        }
+        if ((idx >= _used(log)) ||
+            ((cur->seq == log->head_seq) && (cur->off >= log->head_off))) {
+            res = 0;
+            break;
+        }
+
+        uint32_t sector = (log->tail + idx) % log->numof;
+        uint32_t addr = _addr(log, sector, cur->off);
+        mtdlog_record_hdr_t hdr;
+
+        if ((cur->off + RECORD_HDR) <= log->sector_size) {
+            res = mtd_read(log->dev, &hdr, addr, sizeof(hdr));
+            if (res < 0) {
+                break;
+            }
+            if ((hdr.len != UINT16_MAX) &&
+                ((cur->off + RECORD_HDR + hdr.len) <= log->sector_size)) {
+                if (hdr.len > len) {
+                    res = _check_record(log, addr, &hdr);
+                    if (res != 0) {
+                        res = (res < 0) ? res : -ENOBUFS;
+                        break;
+                    }
+                }
+                else {
+                    res = mtd_read(log->dev, buf, addr + RECORD_HDR, hdr.len);
+                    if (res < 0) {
+                        break;
+                    }
+                    if (crc16_ccitt_update(_crc_start(hdr.len), buf,
+                                           hdr.len) == hdr.crc) {
+                        cur->off += ALIGN(RECORD_HDR + hdr.len);
+                        res = hdr.len;
+                        break;
+                    }
+                }
+            }
+        }
+        /* end of the records in this sector */
+        cur->seq++;
+        cur->off = SECTOR_HDR;
+    }
+    mutex_unlock(&log->lock);
+    return res;
+}
@@ -34,18 +34,22 @@
 #define RETRY_TO                (ASYMCUTE_T_RETRY * US_PER_SEC)
 #define KEEPALIVE_TO            (ASYMCUTE_KEEPALIVE_PING * US_PER_SEC)
 
-#define VALID_PUBLISH_FLAGS     (MQTTSN_QOS_1 | MQTTSN_DUP | MQTTSN_RETAIN)
-#define VALID_SUBSCRIBE_FLAGS   (MQTTSN_QOS_1 | MQTTSN_DUP)
+#define VALID_PUBLISH_FLAGS     (MQTTSN_QOS_MASK | MQTTSN_DUP | MQTTSN_RETAIN)
+#define VALID_SUBSCRIBE_FLAGS   (MQTTSN_QOS_MASK | MQTTSN_DUP)
 
 #define MINLEN_CONNACK          (3U)
 #define MINLEN_DISCONNECT       (2U)
 #define MINLEN_REGACK           (7U)
 #define MINLEN_PUBACK           (7U)
+#define MINLEN_PUBREC           (4U)
+#define MINLEN_PUBCOMP          (4U)
 #define MINLEN_SUBACK           (8U)
 #define MINLEN_UNSUBACK         (4U)
 
 #define IDPOS_REGACK            (4U)
 #define IDPOS_PUBACK            (4U)
+#define IDPOS_PUBREC            (2U)
+#define IDPOS_PUBCOMP           (2U)
 #define IDPOS_SUBACK            (5U)
 #define IDPOS_UNSUBACK          (2U)
 
@@ -93,14 +97,97 @@ static size_t _len_get(uint8_t *buf, size_t *len)
 }
 
 /* @pre con is locked */
-static uint16_t _msg_id_next(asymcute_con_t *con)
+static bool _msg_id_used(const asymcute_con_t *con, uint16_t msg_id)
 {
-    if (++con->last_id == 0) {
-        return ++con->last_id;
+    for (asymcute_req_t *req = con->pending; req; req = req->next) {
+        if (req->msg_id == msg_id) {
+            return true;
+        }
     }
+    for (asymcute_req_t *req = con->queued; req; req = req->next) {
+        if (req->msg_id == msg_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* @pre con is locked */
+static uint16_t _msg_id_next(asymcute_con_t *con)
+{
+    /* after wrapping around, an acknowledgement must not match two requests */
+    do {
+        if (++con->last_id == 0) {
+            ++con->last_id;
+        }
+    } while (_msg_id_used(con, con->last_id));
     return con->last_id;
 }
 
+static uint8_t _req_type(asymcute_req_t *req)
+{
+    size_t len;
+    return req->data[_len_get(req->data, &len)];
+}
+
+/* QoS 1 and QoS 2 publish requests are the ones taking part in the window */
+static bool _req_is_pub(asymcute_req_t *req)
+{
+    uint8_t type = _req_type(req);
+    return ((type == MQTTSN_PUBLISH) || (type == MQTTSN_PUBREL));
+}
+
+static void _topic_cache_put(asymcute_con_t *con, const char *name,
+                             uint16_t id)
+{
+#if ASYMCUTE_TOPIC_CACHE_SIZE
+    unsigned i;
+
+    for (i = 0; i < ASYMCUTE_TOPIC_CACHE_SIZE; i++) {
+        if (strcmp(con->topics[i].name, name) == 0) {
+            break;
+        }
+    }
+    if (i == ASYMCUTE_TOPIC_CACHE_SIZE) {
+        i = con->topics_next;
+        con->topics_next = (i + 1) % ASYMCUTE_TOPIC_CACHE_SIZE;
+    }
+    con->topics[i].id = id;
+    strncpy(con->topics[i].name, name, ASYMCUTE_TOPIC_MAXLEN);
+    con->topics[i].name[ASYMCUTE_TOPIC_MAXLEN] = '\0';
+#else
+    (void)con;
+    (void)name;
+    (void)id;
+#endif
+}
+
+static uint16_t _topic_cache_get(const asymcute_con_t *con, const char *name)
+{
+#if ASYMCUTE_TOPIC_CACHE_SIZE
+    for (unsigned i = 0; i < ASYMCUTE_TOPIC_CACHE_SIZE; i++) {
+        if ((con->topics[i].id != 0) &&
+            (strcmp(con->topics[i].name, name) == 0)) {
+            return con->topics[i].id;
+        }
+    }
+#else
+    (void)con;
+    (void)name;
+#endif
+    return 0;
+}
+
+static void _topic_cache_clear(asymcute_con_t *con)
+{
+#if ASYMCUTE_TOPIC_CACHE_SIZE
+    memset(con->topics, 0, sizeof(con->topics));
+    con->topics_next = 0;
+#else
+    (void)con;
+#endif
+}
+
 /* @pre con is locked */
 static asymcute_req_t *_req_preprocess(asymcute_con_t *con,
                                        size_t msg_len, size_t min_len,
@@ -197,6 +284,47 @@ static void _req_send_once(asymcute_req_t *req, asymcute_con_t *con)
     mutex_unlock(&req->lock);
 }
 
+static unsigned _on_pub_timeout(asymcute_con_t *con, asymcute_req_t *req);
+
+/* @pre con is locked */
+static void _pub_send(asymcute_req_t *req, asymcute_con_t *con)
+{
+    con->inflight++;
+    _req_send(req, con, _on_pub_timeout);
+}
+
+/* @pre con is locked */
+static void _pub_flush(asymcute_con_t *con)
+{
+    while (con->queued && (con->inflight < ASYMCUTE_PUBLISH_WINDOW)) {
+        asymcute_req_t *req = con->queued;
+        con->queued = req->next;
+        _pub_send(req, con);
+    }
+}
+
+/* @pre con is locked */
+static void _pub_done(asymcute_con_t *con)
+{
+    con->inflight--;
+    if (con->state == CONNECTED) {
+        _pub_flush(con);
+    }
+}
+
+/* @pre con is locked */
+static void _pub_queue(asymcute_req_t *req, asymcute_con_t *con)
+{
+    asymcute_req_t **last = &con->queued;
+
+    while (*last) {
+        last = &(*last)->next;
+    }
+    req->con = con;
+    req->next = NULL;
+    *last = req;
+}
+
 static void _req_cancel(asymcute_req_t *req)
 {
     asymcute_con_t *con = req->con;
@@ -206,6 +334,19 @@ static void _req_cancel(asymcute_req_t *req)
     con->user_cb(req, ASYMCUTE_CANCELED);
 }
 
+/* @pre con is locked */
+static void _queue_cancel(asymcute_con_t *con)
+{
+    asymcute_req_t *req = con->queued;
+
+    con->queued = NULL;
+    while (req) {
+        asymcute_req_t *next = req->next;
+        _req_cancel(req);
+        req = next;
+    }
+}
+
 static void _sub_cancel(asymcute_sub_t *sub)
 {
     sub->cb(sub, ASYMCUTE_CANCELED, NULL, 0, sub->arg);
@@ -216,12 +357,32 @@ static void _sub_cancel(asymcute_sub_t *sub)
 static void _disconnect(asymcute_con_t *con, uint8_t state)
 {
     if (con->state == CONNECTED) {
-        /* cancel all pending requests */
+        /* cancel all pending requests, but hold publish requests for the
+         * next connection if the connection was lost */
         event_timeout_clear(&con->keepalive_timer);
-        for (asymcute_req_t *req = con->pending; req; req = req->next) {
-            _req_cancel(req);
-        }
+        asymcute_req_t *req = con->pending;
         con->pending = NULL;
+        while (req) {
+            asymcute_req_t *next = req->next;
+            if ((state == NOTCON) && _req_is_pub(req)) {
+                event_timeout_clear(&req->to_timer);
+                if (_req_type(req) == MQTTSN_PUBLISH) {
+                    size_t len;
+                    req->data[_len_get(req->data, &len) + 1] |= MQTTSN_DUP;
+                }
+                /* pending is in reverse order of sending */
+                req->next = con->queued;
+                con->queued = req;
+            }
+            else {
+                _req_cancel(req);
+            }
+            req = next;
+        }
+        con->inflight = 0;
+        if (state != NOTCON) {
+            _queue_cancel(con);
+        }
         for (asymcute_sub_t *sub = con->subscriptions; sub; sub = sub->next) {
             _sub_cancel(sub);
         }
@@ -241,6 +402,10 @@ static void _on_req_timeout(void *arg)
 
     if (req->retry_cnt--) {
         /* resend the packet */
+        if (_req_type(req) == MQTTSN_PUBLISH) {
+            size_t len;
+            req->data[_len_get(req->data, &len) + 1] |= MQTTSN_DUP;
+        }
         _req_resend(req, req->con);
         return;
     }
@@ -275,6 +440,14 @@ static unsigned _on_discon_timeout(asymcute_con_t *con, asymcute_req_t *req)
     return ASYMCUTE_DISCONNECTED;
 }
 
+static unsigned _on_pub_timeout(asymcute_con_t *con, asymcute_req_t *req)
+{
+    (void)req;
+
+    _pub_done(con);
+    return ASYMCUTE_TIMEOUT;
+}
+
 static unsigned _on_suback_timeout(asymcute_con_t *con, asymcute_req_t *req)
 {
     (void)con;
@@ -326,6 +499,8 @@ static void _on_connack(asymcute_con_t *con, const uint8_t *data, size_t len)
         con->state = CONNECTED;
         /* start keep alive timer */
         event_timeout_set(&con->keepalive_timer, KEEPALIVE_TO);
+        /* send the publish requests held from the last connection */
+        _pub_flush(con);
         ret = ASYMCUTE_CONNECTED;
     }
 
@@ -390,6 +565,7 @@ static void _on_regack(asymcute_con_t *con, const uint8_t *data, size_t len)
         asymcute_topic_t *topic = (asymcute_topic_t *)req->arg;
         topic->id = byteorder_bebuftohs(&data[2]);
         topic->con = con;
+        _topic_cache_put(con, topic->name, topic->id);
         ret = ASYMCUTE_REGISTERED;
     }
 
@@ -419,8 +595,28 @@ static void _on_publish(asymcute_con_t *con, uint8_t *data,
         }
     }
 
-    /* send PUBACK if needed (QoS > 0 or on invalid topic ID) */
-    if ((sub == NULL) || (data[pos + 1] & MQTTSN_QOS_1)) {
+    uint8_t qos = (data[pos + 1] & MQTTSN_QOS_MASK);
+    if (sub && (qos == MQTTSN_QOS_2)) {
+        uint16_t msg_id = byteorder_bebuftohs(&data[pos + 4]);
+        unsigned i;
+
+        /* deliver retransmissions only once */
+        for (i = 0; i < ASYMCUTE_QOS2_RX_NUMOF; i++) {
+            if (con->qos2_rx[i] == msg_id) {
+                sub = NULL;
+                break;
+            }
+        }
+        if (sub) {
+            con->qos2_rx[con->qos2_rx_next] = msg_id;
+            con->qos2_rx_next = (con->qos2_rx_next + 1) % ASYMCUTE_QOS2_RX_NUMOF;
+        }
+        uint8_t pkt[4] = { 4, MQTTSN_PUBREC, 0, 0 };
+        memcpy(&pkt[2], &data[pos + 4], 2);
+        sock_udp_send(&con->sock, pkt, 4, &con->server_ep);
+    }
+    /* send PUBACK if needed (QoS 1 or on invalid topic ID) */
+    else if ((sub == NULL) || (qos == MQTTSN_QOS_1)) {
         uint8_t ret = (sub) ? MQTTSN_ACCEPTED : MQTTSN_REJ_INV_TOPIC_ID;
         uint8_t pkt[7] = { 7, MQTTSN_PUBACK, 0, 0, 0, 0, ret };
         /* copy topic and message id */
@@ -448,11 +644,69 @@ static void _on_puback(asymcute_con_t *con, const uint8_t *data, size_t len)
 
     unsigned ret = (data[6] == MQTTSN_ACCEPTED) ?
                     ASYMCUTE_PUBLISHED : ASYMCUTE_REJECTED;
+    if (_req_is_pub(req)) {
+        _pub_done(con);
+    }
     mutex_unlock(&req->lock);
     mutex_unlock(&con->lock);
     con->user_cb(req, ret);
 }
 
+static void _on_pubrec(asymcute_con_t *con, const uint8_t *data, size_t len)
+{
+    mutex_lock(&con->lock);
+    asymcute_req_t *req = _req_preprocess(con, len, MINLEN_PUBREC,
+                                          data, IDPOS_PUBREC);
+    if (req == NULL) {
+        mutex_unlock(&con->lock);
+        return;
+    }
+
+    /* the request stays in flight, but continues with PUBREL */
+    req->data[0] = 4;
+    req->data[1] = MQTTSN_PUBREL;
+    byteorder_htobebufs(&req->data[2], req->msg_id);
+    req->data_len = 4;
+    _req_send(req, con, _on_pub_timeout);
+    mutex_unlock(&con->lock);
+}
+
+static void _on_pubrel(asymcute_con_t *con, const uint8_t *data, size_t len)
+{
+    if (len < 4) {
+        return;
+    }
+
+    uint16_t msg_id = byteorder_bebuftohs(&data[2]);
+
+    mutex_lock(&con->lock);
+    for (unsigned i = 0; i < ASYMCUTE_QOS2_RX_NUMOF; i++) {
+        if (con->qos2_rx[i] == msg_id) {
+            con->qos2_rx[i] = 0;
+        }
+    }
+    /* answer retransmitted PUBRELs as well */
+    uint8_t pkt[4] = { 4, MQTTSN_PUBCOMP, data[2], data[3] };
+    sock_udp_send(&con->sock, pkt, 4, &con->server_ep);
+    mutex_unlock(&con->lock);
+}
+
+static void _on_pubcomp(asymcute_con_t *con, const uint8_t *data, size_t len)
+{
+    mutex_lock(&con->lock);
+    asymcute_req_t *req = _req_preprocess(con, len, MINLEN_PUBCOMP,
+                                          data, IDPOS_PUBCOMP);
+    if (req == NULL) {
+        mutex_unlock(&con->lock);
+        return;
+    }
+
+    _pub_done(con);
+    mutex_unlock(&req->lock);
+    mutex_unlock(&con->lock);
+    con->user_cb(req, ASYMCUTE_PUBLISHED);
+}
+
 static void _on_suback(asymcute_con_t *con, const uint8_t *data, size_t len)
 {
     mutex_lock(&con->lock);
@@ -469,6 +723,10 @@ static void _on_suback(asymcute_con_t *con, const uint8_t *data, size_t len)
         asymcute_sub_t *sub = (asymcute_sub_t *)req->arg;
         sub->topic->id = byteorder_bebuftohs(&data[3]);
         sub->topic->con = con;
+        if (((sub->topic->flags & MQTTSN_TIT_MASK) == MQTTSN_TIT_NORMAL) &&
+            (sub->topic->id != 0)) {
+            _topic_cache_put(con, sub->topic->name, sub->topic->id);
+        }
         /* insert subscription to connection context */
         sub->next = con->subscriptions;
         con->subscriptions = sub;
@@ -514,6 +772,27 @@ static void _on_unsuback(asymcute_con_t *con, const uint8_t *data, size_t len)
     con->user_cb(req, ASYMCUTE_UNSUBSCRIBED);
 }
 
+static void _on_register(asymcute_con_t *con, uint8_t *data,
+                         size_t pos, size_t len)
+{
+    /* verify message length */
+    if ((len < (pos + 6)) || ((len - (pos + 5)) > ASYMCUTE_TOPIC_MAXLEN)) {
+        return;
+    }
+
+    char name[ASYMCUTE_TOPIC_MAXLEN + 1];
+    memcpy(name, &data[pos + 5], len - (pos + 5));
+    name[len - (pos + 5)] = '\0';
+
+    /* remember the topic ID the gateway assigned and acknowledge it */
+    mutex_lock(&con->lock);
+    _topic_cache_put(con, name, byteorder_bebuftohs(&data[pos + 1]));
+    uint8_t pkt[7] = { 7, MQTTSN_REGACK, 0, 0, 0, 0, MQTTSN_ACCEPTED };
+    memcpy(&pkt[2], &data[pos + 1], 4);
+    sock_udp_send(&con->sock, pkt, 7, &con->server_ep);
+    mutex_unlock(&con->lock);
+}
+
 static void _on_data(asymcute_con_t *con, size_t pkt_len, sock_udp_ep_t *remote)
 {
     size_t len;
@@ -545,6 +824,9 @@ static void _on_data(asymcute_con_t *con, size_t pkt_len, sock_udp_ep_t *remote)
         case MQTTSN_PINGRESP:
             _on_pingresp(con);
             break;
+        case MQTTSN_REGISTER:
+            _on_register(con, con->rxbuf, pos, len);
+            break;
         case MQTTSN_REGACK:
             _on_regack(con, con->rxbuf, len);
             break;
@@ -554,6 +836,15 @@ static void _on_data(asymcute_con_t *con, size_t pkt_len, sock_udp_ep_t *remote)
         case MQTTSN_PUBACK:
             _on_puback(con, con->rxbuf, len);
             break;
+        case MQTTSN_PUBREC:
+            _on_pubrec(con, con->rxbuf, len);
+            break;
+        case MQTTSN_PUBREL:
+            _on_pubrel(con, con->rxbuf, len);
+            break;
+        case MQTTSN_PUBCOMP:
+            _on_pubcomp(con, con->rxbuf, len);
+            break;
         case MQTTSN_SUBACK:
             _on_suback(con, con->rxbuf, len);
             break;
@@ -724,6 +1015,12 @@ int asymcute_connect(asymcute_con_t *con, asymcute_req_t *req,
         goto end;
     }
 
+    /* a clean session forgets about the last one */
+    if (clean) {
+        _queue_cancel(con);
+        _topic_cache_clear(con);
+    }
+
     /* prepare the connection context */
     con->state = CONNECTING;
     strncpy(con->cli_id, cli_id, sizeof(con->cli_id));
@@ -779,6 +1076,16 @@ end:
     return ret;
 }
 
+static void _on_reg_cached(void *arg)
+{
+    asymcute_req_t *req = (asymcute_req_t *)arg;
+    asymcute_con_t *con = req->con;
+
+    req->con = NULL;
+    mutex_unlock(&req->lock);
+    con->user_cb(req, ASYMCUTE_REGISTERED);
+}
+
 int asymcute_register(asymcute_con_t *con, asymcute_req_t *req,
                       asymcute_topic_t *topic)
 {
@@ -808,6 +1115,17 @@ int asymcute_register(asymcute_con_t *con, asymcute_req_t *req,
     req->arg = (void *)topic;
     size_t topic_len = strlen(topic->name);
 
+    /* skip the round trip for topic IDs we know already */
+    uint16_t id = _topic_cache_get(con, topic->name);
+    if (id != 0) {
+        topic->id = id;
+        topic->con = con;
+        req->con = con;
+        event_callback_init(&req->to_evt, _on_reg_cached, (void *)req);
+        event_post(&_queue, &req->to_evt.super);
+        goto end;
+    }
+
     /* prepare registration request */
     req->msg_id = _msg_id_next(con);
     size_t pos = _len_set(req->data, (topic_len + 5));
@@ -836,8 +1154,9 @@ int asymcute_publish(asymcute_con_t *con, asymcute_req_t *req,
 
     int ret = ASYMCUTE_OK;
 
-    /* check for valid flags */
-    if ((flags & VALID_PUBLISH_FLAGS) != flags) {
+    /* check for valid flags, QoS -1 is not supported */
+    if (((flags & VALID_PUBLISH_FLAGS) != flags) ||
+        ((flags & MQTTSN_QOS_MASK) == MQTTSN_QOS_MASK)) {
         return ASYMCUTE_NOTSUP;
     }
     /* check for message size */
@@ -873,8 +1192,13 @@ int asymcute_publish(asymcute_con_t *con, asymcute_req_t *req,
     req->data_len = (pos + 6 + data_len);
 
     /* publish selected data */
-    if (flags & MQTTSN_QOS_1) {
-        _req_send(req, con, NULL);
+    if (flags & MQTTSN_QOS_MASK) {
+        if (con->inflight < ASYMCUTE_PUBLISH_WINDOW) {
+            _pub_send(req, con);
+        }
+        else {
+            _pub_queue(req, con);
+        }
     }
     else {
         _req_send_once(req, con);
@@ -898,7 +1222,8 @@ int asymcute_subscribe(asymcute_con_t *con, asymcute_req_t *req,
     int ret = ASYMCUTE_OK;
 
     /* check flags for validity */
-    if ((flags & VALID_SUBSCRIBE_FLAGS) != flags) {
+    if (((flags & VALID_SUBSCRIBE_FLAGS) != flags) ||
+        ((flags & MQTTSN_QOS_MASK) == MQTTSN_QOS_MASK)) {
         return ASYMCUTE_NOTSUP;
     }
     /* is topic initialized? (though it does not need to be registered) */
@@ -37,11 +37,12 @@
 #define ENABLE_DEBUG        (0)
 #include "debug.h"
 
-#define FLAG_SUCCESS        (0x0001)
-#define FLAG_TIMEOUT        (0x0002)
-#define FLAG_ERR            (0x0004)
-#define FLAG_OVERFLOW       (0x0008)
-#define FLAG_MASK           (0x000f)
+/* leaves THREAD_FLAG_EVENT alone, so requests can be done in event handlers */
+#define FLAG_SUCCESS        (0x0002)
+#define FLAG_TIMEOUT        (0x0004)
+#define FLAG_ERR            (0x0008)
+#define FLAG_OVERFLOW       (0x0010)
+#define FLAG_MASK           (0x001e)
 
 #define BUFSIZE             (512U)
 
@@ -27,6 +27,9 @@
 #include "net/cord/ep.h"
 #include "net/cord/config.h"
 #include "net/cord/ep_standalone.h"
+#ifdef MODULE_EVENT_WORKQ
+#include "event/workq.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -40,17 +43,26 @@
 
 #define TIMEOUT_US          ((uint64_t)(CORD_UPDATE_INTERVAL * US_PER_SEC))
 
-static char _stack[STACKSIZE];
-
 static xtimer_t _timer;
+#ifdef MODULE_EVENT_WORKQ
+static void _on_update(event_t *event);
+
+static event_t _update_event = { .handler = _on_update };
+#else
+static char _stack[STACKSIZE];
 static kernel_pid_t _runner_pid;
 static msg_t _msg;
+#endif
 
 static cord_ep_standalone_cb_t _cb = NULL;
 
 static void _set_timer(void)
 {
+#ifdef MODULE_EVENT_WORKQ
+    xtimer_set64(&_timer, TIMEOUT_US);
+#else
     xtimer_set_msg64(&_timer, TIMEOUT_US, &_msg, _runner_pid);
+#endif
 }
 
 static void _notify(cord_ep_standalone_event_t event)
@@ -60,6 +72,36 @@ static void _notify(cord_ep_standalone_event_t event)
     }
 }
 
+static void _update(void)
+{
+    if (cord_ep_update() == CORD_EP_OK) {
+        _set_timer();
+        _notify(CORD_EP_UPDATED);
+    }
+    else {
+        _notify(CORD_EP_DEREGISTERED);
+    }
+}
+
+#ifdef MODULE_EVENT_WORKQ
+static void _post_update(void *arg)
+{
+    (void)arg;
+    event_post(event_workq(EVENT_WORKQ_PRIO_LOW), &_update_event);
+}
+
+static void _on_update(event_t *event)
+{
+    (void)event;
+    _update();
+}
+
+void cord_ep_standalone_run(void)
+{
+    /* updates run on the shared work queue instead of an own thread */
+    _timer.callback = _post_update;
+}
+#else
 static void *_reg_runner(void *arg)
 {
     (void)arg;
@@ -72,13 +114,7 @@ static void *_reg_runner(void *arg)
     while (1) {
         msg_receive(&in);
         if (in.type == UPDATE_TIMEOUT) {
-            if (cord_ep_update() == CORD_EP_OK) {
-                _set_timer();
-                _notify(CORD_EP_UPDATED);
-            }
-            else {
-                _notify(CORD_EP_DEREGISTERED);
-            }
+            _update();
         }
     }
 
@@ -90,6 +126,7 @@ void cord_ep_standalone_run(void)
     thread_create(_stack, sizeof(_stack), PRIO, THREAD_CREATE_STACKTEST,
                   _reg_runner, NULL, TNAME);
 }
+#endif
 
 void cord_ep_standalone_signal(bool connected)
 {
@@ -23,11 +23,45 @@
 #include "xtimer.h"
 #include "net/cord/epsim.h"
 #include "net/cord/config.h"
+#ifdef MODULE_EVENT_WORKQ
+#include "event/workq.h"
+#endif
 
 #define STACKSIZE           (THREAD_STACKSIZE_DEFAULT)
 #define PRIO                (THREAD_PRIORITY_MAIN - 1)
 #define TNAME               "cord_epsim"
 
+#ifdef MODULE_EVENT_WORKQ
+static void _on_register(event_t *event);
+
+static xtimer_t _timer;
+static event_t _register_event = { .handler = _on_register };
+
+static void _post_register(void *arg)
+{
+    (void)arg;
+    event_post(event_workq(EVENT_WORKQ_PRIO_LOW), &_register_event);
+}
+
+static void _on_register(event_t *event)
+{
+    (void)event;
+    if (cord_epsim_register() != CORD_EPSIM_OK) {
+        /* if this fails once, it will always fail, so we might as well
+         * quit now */
+        LOG_ERROR("[cord_epsim] error: unable to send registration\n");
+        return;
+    }
+    xtimer_set64(&_timer, (uint64_t)CORD_UPDATE_INTERVAL * US_PER_SEC);
+}
+
+static void _start(void)
+{
+    _timer.callback = _post_register;
+    /* wait some seconds to give the address configuration some time to settle */
+    xtimer_set64(&_timer, (uint64_t)CORD_STARTUP_DELAY * US_PER_SEC);
+}
+#else
 static char _stack[STACKSIZE];
 
 static void *reg_runner(void *arg)
@@ -50,10 +84,16 @@ static void *reg_runner(void *arg)
     return NULL;
 }
 
-#ifdef MODULE_CORD_EPSIM_STANDALONE
-void cord_epsim_run(void)
+static void _start(void)
 {
     thread_create(_stack, sizeof(_stack), PRIO, THREAD_CREATE_STACKTEST,
                   reg_runner, NULL, TNAME);
 }
 #endif
+
+#ifdef MODULE_CORD_EPSIM_STANDALONE
+void cord_epsim_run(void)
+{
+    _start();
+}
+#endif
@@ -23,14 +23,39 @@
 
 #ifdef RIOT_VERSION
 #include "byteorder.h"
+#include "random.h"
+#endif
+
+#ifdef MODULE_SOCK_DNS_CACHE
+#include "mutex.h"
+#include "xtimer.h"
 #endif
 
 /* min domain name length is 1, so minimum record length is 7 */
 #define DNS_MIN_REPLY_LEN   (unsigned)(sizeof(sock_dns_hdr_t ) + 7)
 
+/* RCODE of a reply for a name that does not exist */
+#define DNS_RCODE_NXDOMAIN  (3)
+
 /* global DNS server UDP endpoint */
 sock_udp_ep_t sock_dns_server;
 
+#ifdef MODULE_SOCK_DNS_CACHE
+/* Result of a recent query */
+typedef struct {
+    uint32_t expires;                       /* Time of expiry in seconds */
+    char name[SOCK_DNS_MAX_NAME_LEN + 1];   /* Queried name; entry unused if
+                                               empty */
+    uint8_t addr[16];                       /* Address */
+    uint8_t addrlen;                        /* Length of address; zero if the
+                                               name has no record */
+    uint8_t type;                           /* DNS_TYPE_A or DNS_TYPE_AAAA */
+} _cache_entry_t;
+
+static _cache_entry_t _cache[SOCK_DNS_CACHE_SIZE];
+static mutex_t _cache_lock = MUTEX_INIT;
+#endif
+
 static ssize_t _enc_domain_name(uint8_t *out, const char *domain_name)
 {
     /*
@@ -88,11 +113,23 @@ static size_t _skip_hostname(uint8_t *buf)
     return (bufpos - buf + 1);
 }
 
-static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family)
+/*
+ * Parses a reply for a record of a type.
+ *
+ * ttl[out] -- Time to live of the record in seconds, if found
+ * return length of address, 0 if the name has no such record, or <0 on a
+ *        malformed reply
+ */
+static int _parse_dns_reply(uint8_t *buf, size_t len, void *addr_out,
+                            uint16_t type, uint32_t *ttl)
 {
     sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
     uint8_t *bufpos = buf + sizeof(*hdr);
 
+    if ((ntohs(hdr->flags) & 0xf) == DNS_RCODE_NXDOMAIN) {
+        return 0;
+    }
+
     /* skip all queries that are part of the reply */
     for (unsigned n = 0; n < ntohs(hdr->qdcount); n++) {
         bufpos += _skip_hostname(bufpos);
@@ -101,11 +138,16 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
 
     for (unsigned n = 0; n < ntohs(hdr->ancount); n++) {
         bufpos += _skip_hostname(bufpos);
+        if ((bufpos + 10) > (buf + len)) {
+            return -EBADMSG;
+        }
         uint16_t _type = ntohs(_get_short(bufpos));
         bufpos += 2;
         uint16_t class = ntohs(_get_short(bufpos));
         bufpos += 2;
-        bufpos += 4; /* skip ttl */
+        uint32_t _ttl = ((uint32_t)ntohs(_get_short(bufpos)) << 16) |
+                        ntohs(_get_short(bufpos + 2));
+        bufpos += 4;
 
         unsigned addrlen = ntohs(_get_short(bufpos));
         bufpos += 2;
@@ -113,27 +155,120 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
             return -EBADMSG;
         }
 
-        /* skip unwanted answers */
-        if ((class != DNS_CLASS_IN) ||
-                ((_type == DNS_TYPE_A) && (family == AF_INET6)) ||
-                ((_type == DNS_TYPE_AAAA) && (family == AF_INET)) ||
-                ! ((_type == DNS_TYPE_A) || ((_type == DNS_TYPE_AAAA))
-                    )) {
+        /* skip unwanted answers, e.g. CNAMEs */
+        if ((class != DNS_CLASS_IN) || (_type != type) ||
+            (addrlen != ((type == DNS_TYPE_A) ? 4 : 16))) {
             bufpos += addrlen;
             continue;
         }
 
         memcpy(addr_out, bufpos, addrlen);
+        *ttl = _ttl;
         return addrlen;
     }
 
-    return -1;
+    return 0;
+}
+
+static size_t _build_query(uint8_t *buf, const char *domain_name, uint16_t id,
+                           uint16_t type)
+{
+    sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->id = id;
+    hdr->flags = htons(0x0120);
+    hdr->qdcount = htons(1);
+
+    uint8_t *bufpos = buf + sizeof(*hdr);
+    bufpos += _enc_domain_name(bufpos, domain_name);
+    bufpos += _put_short(bufpos, htons(type));
+    bufpos += _put_short(bufpos, htons(DNS_CLASS_IN));
+
+    return bufpos - buf;
+}
+
+#ifdef MODULE_SOCK_DNS_CACHE
+static uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+/*
+ * Looks up a cached result.
+ *
+ * return length of address, 0 if the name is known to have no such record,
+ *        or -1 if not cached
+ */
+static int _cache_get(const char *domain_name, void *addr_out, uint16_t type)
+{
+    int res = -1;
+    uint32_t now = _now();
+
+    mutex_lock(&_cache_lock);
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        _cache_entry_t *entry = &_cache[i];
+        if (!entry->name[0]) {
+            continue;
+        }
+        if ((int32_t)(entry->expires - now) <= 0) {
+            entry->name[0] = '\0';
+        }
+        else if ((entry->type == type) && !strcmp(entry->name, domain_name)) {
+            memcpy(addr_out, entry->addr, entry->addrlen);
+            res = entry->addrlen;
+            break;
+        }
+    }
+    mutex_unlock(&_cache_lock);
+
+    return res;
+}
+
+/* Caches a result, replacing the entry that expires first if none is free */
+static void _cache_add(const char *domain_name, const void *addr, int addrlen,
+                       uint16_t type, uint32_t ttl)
+{
+    uint32_t now = _now();
+    _cache_entry_t *entry = &_cache[0];
+
+    if (ttl == 0) {
+        return;
+    }
+    if (ttl > SOCK_DNS_CACHE_TTL_MAX) {
+        ttl = SOCK_DNS_CACHE_TTL_MAX;
+    }
+
+    mutex_lock(&_cache_lock);
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        _cache_entry_t *cur = &_cache[i];
+        if (!cur->name[0] ||
+            ((cur->type == type) && !strcmp(cur->name, domain_name))) {
+            entry = cur;
+            break;
+        }
+        if ((int32_t)(cur->expires - entry->expires) < 0) {
+            entry = cur;
+        }
+    }
+    strcpy(entry->name, domain_name);
+    memcpy(entry->addr, addr, addrlen);
+    entry->addrlen = addrlen;
+    entry->type = type;
+    entry->expires = now + ttl;
+    mutex_unlock(&_cache_lock);
 }
+#endif
 
 int sock_dns_query(const char *domain_name, void *addr_out, int family)
 {
     uint8_t buf[SOCK_DNS_QUERYBUF_LEN];
     uint8_t reply_buf[512];
+    /* AAAA is preferred, so it comes first */
+    uint16_t types[2];
+    uint8_t addrs[2][16];
+    int results[2] = { -1, -1 };
+    unsigned numof = 0;
+    uint16_t id;
 
     if (sock_dns_server.port == 0) {
         return -ECONNREFUSED;
@@ -143,54 +278,105 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         return -ENOSPC;
     }
 
-    sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
-    memset(hdr, 0, sizeof(*hdr));
-    hdr->id = 0; /* random? */
-    hdr->flags = htons(0x0120);
-    hdr->qdcount = htons(1 + (family == AF_UNSPEC));
-
-    uint8_t *bufpos = buf + sizeof(*hdr);
-
-    unsigned _name_ptr;
     if ((family == AF_INET6) || (family == AF_UNSPEC)) {
-        _name_ptr = (bufpos - buf);
-        bufpos += _enc_domain_name(bufpos, domain_name);
-        bufpos += _put_short(bufpos, htons(DNS_TYPE_AAAA));
-        bufpos += _put_short(bufpos, htons(DNS_CLASS_IN));
+        types[numof++] = DNS_TYPE_AAAA;
     }
-
     if ((family == AF_INET) || (family == AF_UNSPEC)) {
-        if (family == AF_UNSPEC) {
-            bufpos += _put_short(bufpos, htons((0xc000) | (_name_ptr)));
-        }
-        else {
-            bufpos += _enc_domain_name(bufpos, domain_name);
+        types[numof++] = DNS_TYPE_A;
+    }
+
+#ifdef MODULE_SOCK_DNS_CACHE
+    for (unsigned q = 0; q < numof; q++) {
+        results[q] = _cache_get(domain_name, addrs[q], types[q]);
+    }
+    for (unsigned q = 0; q < numof; q++) {
+        if (results[q] > 0) {
+            memcpy(addr_out, addrs[q], results[q]);
+            return results[q];
         }
-        bufpos += _put_short(bufpos, htons(DNS_TYPE_A));
-        bufpos += _put_short(bufpos, htons(DNS_CLASS_IN));
     }
+    if ((results[0] == 0) && ((numof == 1) || (results[1] == 0))) {
+        return -EHOSTUNREACH;
+    }
+#endif
+
+#ifdef RIOT_VERSION
+    id = random_uint32();
+#else
+    id = 0;
+#endif
 
     sock_udp_t sock_dns;
 
     ssize_t res = sock_udp_create(&sock_dns, NULL, &sock_dns_server, 0);
     if (res) {
-            puts("a");
         goto out;
     }
 
     for (int i = 0; i < SOCK_DNS_RETRIES; i++) {
-        res = sock_udp_send(&sock_dns, buf, (bufpos-buf), NULL);
-        if (res <= 0) {
-            continue;
+        unsigned pending = 0;
+
+        /* send queries for all types in parallel */
+        for (unsigned q = 0; q < numof; q++) {
+            if (results[q] >= 0) {
+                continue;
+            }
+            size_t len = _build_query(buf, domain_name, id + q, types[q]);
+            if (sock_udp_send(&sock_dns, buf, len, NULL) > 0) {
+                pending++;
+            }
         }
-        res = sock_udp_recv(&sock_dns, reply_buf, sizeof(reply_buf), 1000000LU, NULL);
-        if ((res > 0) && (res > (int)DNS_MIN_REPLY_LEN)) {
-            if ((res = _parse_dns_reply(reply_buf, res, addr_out, family)) > 0) {
-                goto out;
+
+        while (pending > 0) {
+            res = sock_udp_recv(&sock_dns, reply_buf, sizeof(reply_buf),
+                                1000000LU, NULL);
+            if (res == -ETIMEDOUT) {
+                break;
+            }
+            if ((res <= 0) || (res <= (int)DNS_MIN_REPLY_LEN)) {
+                continue;
             }
+            unsigned q = (uint16_t)(((sock_dns_hdr_t *)reply_buf)->id - id);
+            if ((q >= numof) || (results[q] >= 0)) {
+                /* stale or foreign reply */
+                continue;
+            }
+            uint32_t ttl = SOCK_DNS_CACHE_NEG_TTL;
+            res = _parse_dns_reply(reply_buf, res, addrs[q], types[q], &ttl);
+            if (res < 0) {
+                continue;
+            }
+            results[q] = res;
+            pending--;
+#ifdef MODULE_SOCK_DNS_CACHE
+            _cache_add(domain_name, addrs[q], res, types[q], ttl);
+#else
+            (void)ttl;
+#endif
+            /* a reply for the preferred type ends the query */
+            if ((q == 0) && (res > 0)) {
+                break;
+            }
+        }
+
+        if ((results[0] > 0) || ((numof > 1) && (results[1] > 0)) ||
+            ((results[0] == 0) && ((numof == 1) || (results[1] == 0)))) {
+            break;
         }
     }
 
+    res = -ETIMEDOUT;
+    for (unsigned q = 0; q < numof; q++) {
+        if (results[q] > 0) {
+            memcpy(addr_out, addrs[q], results[q]);
+            res = results[q];
+            break;
+        }
+    }
+    if ((results[0] == 0) && ((numof == 1) || (results[1] == 0))) {
+        res = -EHOSTUNREACH;
+    }
+
 out:
     sock_udp_close(&sock_dns);
     return res;
@@ -41,6 +41,7 @@
 #define TFLAGS_RESP         (0x0001)
 #define TFLAGS_TIMEOUT      (0x0002)
 #define TFLAGS_ANY          (TFLAGS_RESP | TFLAGS_TIMEOUT)
+#define TFLAGS_INFLIGHT     (0x0004)
 
 
 static const char *cli_id;
@@ -60,6 +61,33 @@ static volatile uint8_t waiton = 0xff;
 static volatile uint16_t waitonid = 0;
 static volatile int result;
 
+#ifdef MODULE_EMCUTE_ASYNC
+/**
+ * @brief   QoS 1 publish message awaiting its PUBACK
+ */
+typedef struct {
+    emcute_pub_cb_t cb;             /**< completion callback */
+    void *arg;                      /**< argument for @p cb */
+    uint32_t sent;                  /**< time of the last transmission */
+    uint16_t id;                    /**< message ID */
+    uint16_t len;                   /**< length of @p buf, 0 if slot is free */
+    uint8_t retries;                /**< number of retransmissions */
+    uint8_t buf[EMCUTE_INFLIGHT_BUFSIZE];   /**< the PUBLISH message */
+} inflight_t;
+
+/**
+ * @brief   Progress of a call to emcute_pub_batch()
+ */
+typedef struct {
+    thread_t *thread;               /**< calling thread */
+    volatile unsigned done;         /**< completed messages */
+    volatile unsigned acked;        /**< acknowledged messages */
+} batch_t;
+
+static inflight_t inflight[EMCUTE_INFLIGHT_MAX];
+static mutex_t inflight_lock = MUTEX_INIT;
+#endif
+
 static size_t set_len(uint8_t *buf, size_t len)
 {
     if (len < (0xff - 7)) {
@@ -68,7 +96,7 @@ static size_t set_len(uint8_t *buf, size_t len)
     }
     else {
         buf[0] = 0x01;
-        byteorder_htobebufs(&tbuf[1], (uint16_t)(len + 3));
+        byteorder_htobebufs(&buf[1], (uint16_t)(len + 3));
         return 3;
     }
 }
@@ -147,6 +175,88 @@ static void on_ack(uint8_t type, int id_pos, int ret_pos, int res_pos)
     }
 }
 
+#ifdef MODULE_EMCUTE_ASYNC
+/* must be called with inflight_lock held, releases it while calling back */
+static void inflight_done(inflight_t *msg, int res)
+{
+    emcute_pub_cb_t cb = msg->cb;
+    void *arg = msg->arg;
+
+    msg->len = 0;
+    if (cb) {
+        mutex_unlock(&inflight_lock);
+        cb(res, arg);
+        mutex_lock(&inflight_lock);
+    }
+}
+
+static void inflight_flush(int res)
+{
+    mutex_lock(&inflight_lock);
+    for (unsigned i = 0; i < EMCUTE_INFLIGHT_MAX; i++) {
+        if (inflight[i].len > 0) {
+            inflight_done(&inflight[i], res);
+        }
+    }
+    mutex_unlock(&inflight_lock);
+}
+
+/* retransmits overdue messages, returns the time until the next one is due */
+static uint32_t inflight_check(uint32_t now)
+{
+    uint32_t t_next = (EMCUTE_T_RETRY * US_PER_SEC);
+
+    mutex_lock(&inflight_lock);
+    for (unsigned i = 0; i < EMCUTE_INFLIGHT_MAX; i++) {
+        inflight_t *msg = &inflight[i];
+        if (msg->len == 0) {
+            continue;
+        }
+        uint32_t age = (now - msg->sent);
+        if (age < (EMCUTE_T_RETRY * US_PER_SEC)) {
+            if (((EMCUTE_T_RETRY * US_PER_SEC) - age) < t_next) {
+                t_next = (EMCUTE_T_RETRY * US_PER_SEC) - age;
+            }
+            continue;
+        }
+        if (msg->retries >= EMCUTE_N_RETRY) {
+            DEBUG("[emcute] inflight: no PUBACK for msg id %u\n",
+                  (unsigned)msg->id);
+            inflight_done(msg, EMCUTE_TIMEOUT);
+            continue;
+        }
+        uint16_t tmp;
+        size_t pos = get_len(msg->buf, &tmp);
+        msg->buf[pos + 1] |= EMCUTE_DUP;
+        msg->retries++;
+        msg->sent = now;
+        sock_udp_send(&sock, msg->buf, msg->len, &gateway);
+    }
+    mutex_unlock(&inflight_lock);
+
+    return t_next;
+}
+
+static void on_puback(size_t len)
+{
+    if (len >= 7) {
+        uint16_t id = byteorder_bebuftohs(&rbuf[4]);
+
+        mutex_lock(&inflight_lock);
+        for (unsigned i = 0; i < EMCUTE_INFLIGHT_MAX; i++) {
+            if ((inflight[i].len > 0) && (inflight[i].id == id)) {
+                inflight_done(&inflight[i], (rbuf[6] == ACCEPT) ? EMCUTE_OK
+                                                                : EMCUTE_REJECT);
+                mutex_unlock(&inflight_lock);
+                return;
+            }
+        }
+        mutex_unlock(&inflight_lock);
+    }
+    on_ack(PUBACK, 4, 6, 0);
+}
+#endif
+
 static void on_publish(size_t len, size_t pos)
 {
     /* make sure packet length is valid - if not, drop packet silently */
@@ -293,7 +403,13 @@ int emcute_discon(void)
     tbuf[0] = 2;
     tbuf[1] = DISCONNECT;
 
-    return syncsend(DISCONNECT, 2, true);
+    int res = syncsend(DISCONNECT, 2, true);
+#ifdef MODULE_EMCUTE_ASYNC
+    if (res == EMCUTE_OK) {
+        inflight_flush(EMCUTE_NOGW);
+    }
+#endif
+    return res;
 }
 
 int emcute_reg(emcute_topic_t *topic)
@@ -365,6 +481,129 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
     return res;
 }
 
+#ifdef MODULE_EMCUTE_ASYNC
+int emcute_pub_async(emcute_topic_t *topic, const void *data, size_t len,
+                     unsigned flags, emcute_pub_cb_t cb, void *arg)
+{
+    assert((topic->id != 0) && data && (len > 0) && !(flags & ~PUB_FLAGS));
+    assert((flags & EMCUTE_QOS_MASK) == EMCUTE_QOS_1);
+
+    if (gateway.port == 0) {
+        return EMCUTE_NOGW;
+    }
+    if (len >= (EMCUTE_INFLIGHT_BUFSIZE - 9)) {
+        return EMCUTE_OVERFLOW;
+    }
+
+    /* message IDs are shared with the synchronous requests. Don't hold
+     * inflight_lock while waiting for txlock: the emCute thread needs it to
+     * process the response the holder of txlock waits for */
+    mutex_lock(&txlock);
+    uint16_t id = id_next++;
+    mutex_unlock(&txlock);
+
+    mutex_lock(&inflight_lock);
+    inflight_t *msg = NULL;
+    for (unsigned i = 0; i < EMCUTE_INFLIGHT_MAX; i++) {
+        if (inflight[i].len == 0) {
+            msg = &inflight[i];
+            break;
+        }
+    }
+    if (msg == NULL) {
+        mutex_unlock(&inflight_lock);
+        return EMCUTE_BUSY;
+    }
+
+    msg->id = id;
+
+    size_t pos = set_len(msg->buf, (len + 6));
+    msg->buf[pos++] = PUBLISH;
+    msg->buf[pos++] = flags;
+    byteorder_htobebufs(&msg->buf[pos], topic->id);
+    pos += 2;
+    byteorder_htobebufs(&msg->buf[pos], msg->id);
+    pos += 2;
+    memcpy(&msg->buf[pos], data, len);
+    msg->len = (uint16_t)(pos + len);
+    msg->cb = cb;
+    msg->arg = arg;
+    msg->retries = 0;
+    msg->sent = xtimer_now_usec();
+
+    sock_udp_send(&sock, msg->buf, msg->len, &gateway);
+    mutex_unlock(&inflight_lock);
+
+    return EMCUTE_OK;
+}
+
+static void batch_cb(int res, void *arg)
+{
+    batch_t *batch = arg;
+
+    if (res == EMCUTE_OK) {
+        batch->acked++;
+    }
+    batch->done++;
+    thread_flags_set(batch->thread, TFLAGS_INFLIGHT);
+}
+
+int emcute_pub_batch(emcute_topic_t *topic, const emcute_msg_t *msgs,
+                     size_t num, unsigned flags)
+{
+    assert(msgs || (num == 0));
+
+    if (gateway.port == 0) {
+        return EMCUTE_NOGW;
+    }
+    if (flags & EMCUTE_QOS_2) {
+        return EMCUTE_NOTSUP;
+    }
+
+    int count = 0;
+    if (!(flags & EMCUTE_QOS_1)) {
+        for (size_t i = 0; i < num; i++) {
+            if (emcute_pub(topic, msgs[i].data, msgs[i].len, flags) == EMCUTE_OK) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    batch_t batch = { .thread = (thread_t *)sched_active_thread };
+    unsigned queued = 0;
+    xtimer_t wait = { .callback = time_evt, .arg = batch.thread };
+
+    thread_flags_clear(TFLAGS_INFLIGHT | TFLAGS_TIMEOUT);
+    for (size_t i = 0; i < num;) {
+        int res = emcute_pub_async(topic, msgs[i].data, msgs[i].len, flags,
+                                   batch_cb, &batch);
+        if (res == EMCUTE_BUSY) {
+            /* other users may hold all slots, so don't wait for our own
+             * messages only */
+            xtimer_set(&wait, (EMCUTE_T_RETRY * US_PER_SEC));
+            thread_flags_wait_any(TFLAGS_INFLIGHT | TFLAGS_TIMEOUT);
+            xtimer_remove(&wait);
+            continue;
+        }
+        if (res == EMCUTE_OK) {
+            queued++;
+        }
+        else {
+            DEBUG("[emcute] pub batch: unable to send message %u\n",
+                  (unsigned)i);
+        }
+        i++;
+    }
+    while (batch.done < queued) {
+        thread_flags_wait_any(TFLAGS_INFLIGHT);
+    }
+    thread_flags_clear(TFLAGS_INFLIGHT | TFLAGS_TIMEOUT);
+
+    return (int)batch.acked;
+}
+#endif
+
 int emcute_sub(emcute_sub_t *sub, unsigned flags)
 {
     assert(sub && (sub->cb) && (sub->topic.name) && !(flags & ~SUB_FLAGS));
@@ -538,7 +777,11 @@ void emcute_run(uint16_t port, const char *id)
                 case WILLMSGREQ:    on_ack(type, 0, 0, 0);              break;
                 case REGACK:        on_ack(type, 4, 6, 2);              break;
                 case PUBLISH:       on_publish((size_t)pkt_len, pos);   break;
+#ifdef MODULE_EMCUTE_ASYNC
+                case PUBACK:        on_puback((size_t)pkt_len);         break;
+#else
                 case PUBACK:        on_ack(type, 4, 6, 0);              break;
+#endif
                 case SUBACK:        on_ack(type, 5, 7, 3);              break;
                 case UNSUBACK:      on_ack(type, 2, 0, 0);              break;
                 case PINGREQ:       on_pingreq(&remote);                break;
@@ -561,5 +804,13 @@ void emcute_run(uint16_t port, const char *id)
         else {
             t_out = (EMCUTE_KEEPALIVE * US_PER_SEC) - (now - start);
         }
+#ifdef MODULE_EMCUTE_ASYNC
+        /* wake up at least every EMCUTE_T_RETRY, so messages queued while
+         * waiting for a packet are retransmitted in time */
+        uint32_t t_retry = inflight_check(now);
+        if (t_retry < t_out) {
+            t_out = t_retry;
+        }
+#endif
     }
 }
@@ -24,11 +24,19 @@
 #include <string.h>
 
 #include "assert.h"
+#include "byteorder.h"
 #include "net/gcoap.h"
+#include "net/gcoap/oscore.h"
 #include "net/sock/util.h"
 #include "mutex.h"
 #include "random.h"
 #include "thread.h"
+#ifdef MODULE_GCOAP_WORKER
+#include "event.h"
+#endif
+#ifdef MODULE_GNRC_IPV6_NIB
+#include "net/gnrc/ipv6/nib/nc.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -47,12 +55,25 @@
 #define GCOAP_RESP_OPTIONS_BUF  (4)
 #define GCOAP_OBS_OPTIONS_BUF   (4)
 
+#ifdef MODULE_GCOAP_PROXY
+/* Maximum length of an ETag (RFC 7252, section 5.10.6) */
+#define GCOAP_PROXY_ETAG_MAX    (8)
+
+#if GCOAP_TOKENLEN == 0
+#error "gcoap_proxy matches responses by token; GCOAP_TOKENLEN must not be 0"
+#endif
+#endif
+
 /* Internal functions */
 static void *_event_loop(void *arg);
 static void _listen(sock_udp_t *sock);
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len, void *ctx);
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
-                                                         sock_udp_ep_t *remote);
+                          sock_udp_ep_t *remote, gcoap_oscore_req_t *oscore);
+static size_t _req_send(const uint8_t *buf, size_t len,
+                        const sock_udp_ep_t *remote,
+                        gcoap_resp_handler_t resp_handler,
+                        const gcoap_oscore_req_t *oscore);
 static void _expire_request(gcoap_request_memo_t *memo);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                            const sock_udp_ep_t *remote);
@@ -63,6 +84,34 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu);
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource);
+static void _handle_empty(coap_pkt_t *pdu, sock_udp_ep_t *remote);
+static void _obs_memo_remove(gcoap_observe_memo_t *memo);
+static unsigned _nstart(const sock_udp_ep_t *remote);
+static int _req_hdr_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                         unsigned code);
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+static void _index_listener(gcoap_listener_t *listener);
+#endif
+#ifdef MODULE_GCOAP_DEDUP
+static void _dedup_add(uint16_t msgid, const sock_udp_ep_t *remote,
+                       const uint8_t *resp, size_t resp_len, uint32_t now);
+#endif
+#ifdef MODULE_GCOAP_WORKER
+static size_t _defer_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                         const coap_resource_t *resource, sock_udp_ep_t *remote,
+                         const gcoap_oscore_req_t *oscore);
+static void _worker_init(void);
+#endif
+#ifdef MODULE_GCOAP_OSCORE
+static int _oscore_req(coap_pkt_t *pdu, gcoap_oscore_req_t *oscore);
+static int _oscore_resp(gcoap_request_memo_t *memo, coap_pkt_t *pdu);
+static size_t _oscore_protect_resp(uint8_t *buf, size_t len, size_t buf_len,
+                                   gcoap_oscore_req_t *oscore);
+#endif
+#ifdef MODULE_GCOAP_PROXY
+static size_t _proxy_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                         sock_udp_ep_t *remote);
+#endif
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -72,9 +121,121 @@ const coap_resource_t _default_resources[] = {
 static gcoap_listener_t _default_listener = {
     &_default_resources[0],
     sizeof(_default_resources) / sizeof(_default_resources[0]),
-    NULL
+    NULL,
+    0
 };
 
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+/* Entry of the resource lookup index */
+typedef struct {
+    const coap_resource_t *resource;    /* Indexed resource */
+    gcoap_listener_t *listener;         /* Listener of the resource */
+} gcoap_resource_entry_t;
+#endif
+
+#ifdef MODULE_GCOAP_WORKER
+/* Worker thread for deferred resource handlers */
+typedef struct {
+    event_queue_t queue;                /* Jobs for this worker */
+    unsigned pending;                   /* Number of jobs in queue */
+    char stack[GCOAP_WORKER_STACK_SIZE];
+} gcoap_worker_t;
+
+/* Request handed to a worker thread */
+typedef struct {
+    event_t event;                      /* Posted to the worker's queue */
+    const coap_resource_t *resource;    /* Resource; job unused if NULL */
+    gcoap_worker_t *worker;             /* Worker handling the job */
+    sock_udp_ep_t remote;               /* Requesting endpoint */
+    bool separate;                      /* Request was acknowledged already;
+                                           response is a new message */
+    coap_pkt_t pdu;                     /* Request, pointing into buf */
+#ifdef MODULE_GCOAP_OSCORE
+    gcoap_oscore_req_t oscore;          /* Protection of the request */
+#endif
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];    /* Request, then response */
+} gcoap_job_t;
+#endif
+
+/* Observe client, with pacing state for its notifications */
+typedef struct {
+    sock_udp_ep_t ep;                   /* Endpoint; unused if AF_UNSPEC */
+    uint32_t con_sent;                  /* Time the outstanding confirmable
+                                           notification was sent */
+    uint16_t msgid;                     /* Message ID of last notification */
+    uint8_t notifications;              /* Notifications since last CON */
+    uint8_t con_retries;                /* Notifications sent again as CON
+                                           without ACK */
+    bool con_pending;                   /* Waiting for ACK of a CON */
+} gcoap_observer_t;
+
+/* Observed resource with its list of registrations */
+typedef struct {
+    const coap_resource_t *resource;    /* Observed resource */
+    gcoap_observe_memo_t *memos;        /* Registrations; entry unused if NULL */
+} gcoap_obs_resource_t;
+
+static gcoap_obs_resource_t *_obs_resource(const coap_resource_t *resource,
+                                           bool create);
+
+/* Limit of outstanding requests to an endpoint */
+typedef struct {
+    sock_udp_ep_t ep;                   /* Endpoint; unused if AF_UNSPEC */
+    unsigned nstart;                    /* Maximum outstanding requests */
+} gcoap_nstart_t;
+
+#ifdef MODULE_GCOAP_DEDUP
+/* Response to a recent request, to answer duplicates of it */
+typedef struct {
+    sock_udp_ep_t remote;               /* Requesting endpoint */
+    uint32_t time;                      /* Time the request was received */
+    uint16_t msgid;                     /* Message ID of the request */
+    uint16_t resp_len;                  /* Length of response; zero if none
+                                           was sent */
+    bool used;                          /* Entry holds a request */
+    uint8_t resp[GCOAP_PDU_BUF_SIZE];   /* Response */
+} gcoap_dedup_entry_t;
+
+static gcoap_dedup_entry_t *_dedup_find(coap_pkt_t *pdu,
+                                        const sock_udp_ep_t *remote,
+                                        uint32_t now);
+#endif
+
+#ifdef MODULE_GCOAP_PROXY
+/* Response to a proxied GET */
+typedef struct {
+    sock_udp_ep_t ep;                   /* Server; unused if AF_UNSPEC */
+    char path[GCOAP_PROXY_PATH_MAX];    /* Path and query of the URI */
+    uint32_t expires;                   /* Time in sec the response is stale */
+    uint16_t format;                    /* Content-Format */
+    uint16_t payload_len;               /* Length of payload */
+    uint8_t etag_len;                   /* Length of ETag; zero if none */
+    uint8_t etag[GCOAP_PROXY_ETAG_MAX]; /* ETag */
+    uint8_t payload[GCOAP_PROXY_PAYLOAD_MAX];   /* Payload */
+} gcoap_proxy_entry_t;
+
+/* Client waiting for the response to a forwarded request */
+typedef struct {
+    sock_udp_ep_t ep;                   /* Requesting endpoint */
+    uint8_t token[GCOAP_TOKENLEN_MAX];  /* Token of the request */
+    uint8_t token_len;                  /* Length of token */
+    uint8_t etag_len;                   /* Length of ETag of the request; zero
+                                           if none */
+    uint8_t etag[GCOAP_PROXY_ETAG_MAX]; /* ETag of the request */
+} gcoap_proxy_waiter_t;
+
+/* Request forwarded to a server */
+typedef struct {
+    sock_udp_ep_t ep;                   /* Server; unused if AF_UNSPEC */
+    char path[GCOAP_PROXY_PATH_MAX];    /* Path and query of the URI */
+    uint8_t token[GCOAP_TOKENLEN];      /* Token of the forwarded request */
+    uint8_t method;                     /* Method of the request */
+    uint8_t waiters_numof;              /* Number of waiting clients */
+    gcoap_proxy_waiter_t waiters[GCOAP_PROXY_WAITERS_MAX];
+                                        /* Clients to send the response to */
+} gcoap_proxy_req_t;
+#endif
+
 /* Container for the state of gcoap itself */
 typedef struct {
     mutex_t lock;                       /* Shares state attributes safely */
@@ -84,21 +245,70 @@ typedef struct {
                                            byte of an entry is zero, the entry
                                            is available */
     atomic_uint next_message_id;        /* Next message ID to use */
-    sock_udp_ep_t observers[GCOAP_OBS_CLIENTS_MAX];
+    gcoap_observer_t observers[GCOAP_OBS_CLIENTS_MAX];
                                         /* Observe clients; allows reuse for
                                            observe memos */
     gcoap_observe_memo_t observe_memos[GCOAP_OBS_REGISTRATIONS_MAX];
                                         /* Observed resource registrations */
+    gcoap_obs_resource_t obs_resources[GCOAP_OBS_RESOURCES_MAX];
+                                        /* Registrations by resource */
+    uint8_t obs_buf[GCOAP_PDU_BUF_SIZE + GCOAP_TOKENLEN_MAX];
+                                        /* Notification, with room for the
+                                           longest token in front */
     uint8_t resend_bufs[GCOAP_RESEND_BUFS_MAX][GCOAP_PDU_BUF_SIZE];
                                         /* Buffers for PDU for request resends;
                                            if first byte of an entry is zero,
                                            the entry is available */
+    gcoap_nstart_t nstart[GCOAP_NSTART_ENDPOINTS_MAX];
+                                        /* Endpoints with their own limit of
+                                           outstanding requests */
+#ifdef MODULE_GCOAP_DEDUP
+    gcoap_dedup_entry_t dedup[GCOAP_DEDUP_CACHE_SIZE];
+                                        /* Recent responses; only used on the
+                                           gcoap thread */
+#endif
+#ifdef MODULE_GCOAP_PROXY
+    gcoap_proxy_entry_t proxy_cache[GCOAP_PROXY_CACHE_SIZE];
+                                        /* Responses to proxied GET requests;
+                                           the proxy runs on the gcoap thread
+                                           only */
+    gcoap_proxy_req_t proxy_reqs[GCOAP_PROXY_PENDING_MAX];
+                                        /* Forwarded requests */
+    uint8_t proxy_buf[GCOAP_PDU_BUF_SIZE + GCOAP_TOKENLEN_MAX];
+                                        /* Forwarded request, or response to a
+                                           waiting client, with room for the
+                                           longest token */
+    char proxy_uri[GCOAP_PROXY_URI_MAX];
+                                        /* URI of proxied request */
+#endif
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+    gcoap_resource_entry_t index[GCOAP_RESOURCE_INDEX_SIZE];
+                                        /* Resources of all listeners, sorted
+                                           by path, then registration order */
+    unsigned index_len;                 /* Number of used index entries */
+    bool index_overflow;                /* Not all resources fit in the index;
+                                           search the listeners instead */
+#endif
+#ifdef MODULE_GCOAP_WORKER
+    gcoap_worker_t workers[GCOAP_WORKER_NUMOF];
+    gcoap_job_t jobs[GCOAP_WORKER_JOBS_MAX];
+                                        /* Requests for deferred resources */
+#endif
 } gcoap_state_t;
 
 static gcoap_state_t _coap_state = {
     .listeners   = &_default_listener,
 };
 
+/* First pool of request memos is part of gcoap state */
+static gcoap_req_memo_pool_t _default_memo_pool = {
+    .memos             = &_coap_state.open_reqs[0],
+    .memos_numof       = GCOAP_REQ_WAITING_MAX,
+    .resend_bufs       = &_coap_state.resend_bufs[0],
+    .resend_bufs_numof = GCOAP_RESEND_BUFS_MAX,
+    .next              = NULL,
+};
+
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _msg_stack[GCOAP_STACK_SIZE];
 static msg_t _msg_queue[GCOAP_MSG_QUEUE_SIZE];
@@ -176,37 +386,40 @@ static void _listen(sock_udp_t *sock)
 {
     coap_pkt_t pdu;
     uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    void *data, *buf_ctx = NULL;
     sock_udp_ep_t remote;
     gcoap_request_memo_t *memo = NULL;
     uint8_t open_reqs = gcoap_op_state();
 
     /* We expect a -EINTR response here when unlimited waiting (SOCK_NO_TIMEOUT)
      * is interrupted when sending a message in gcoap_req_send2(). While a
-     * request is outstanding, sock_udp_recv() is called here with limited
+     * request is outstanding, sock_udp_recv_buf() is called here with limited
      * waiting so the request's timeout can be handled in a timely manner in
-     * _event_loop(). */
-    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf),
-                                open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
-                                &remote);
+     * _event_loop().
+     * The message is parsed right in the packet buffer of the stack; a
+     * response is built in buf. */
+    ssize_t res = sock_udp_recv_buf(sock, &data, &buf_ctx,
+                                    open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
+                                    &remote);
     if (res <= 0) {
 #if ENABLE_DEBUG
         if (res < 0 && res != -ETIMEDOUT) {
             DEBUG("gcoap: udp recv failure: %d\n", res);
         }
 #endif
-        return;
+        goto release;
     }
 
-    res = coap_parse(&pdu, buf, res);
+    res = coap_parse(&pdu, data, res);
     if (res < 0) {
         DEBUG("gcoap: parse failure: %d\n", (int)res);
         /* If a response, can't clear memo, but it will timeout later. */
-        return;
+        goto release;
     }
 
     if (pdu.hdr->code == COAP_CODE_EMPTY) {
-        DEBUG("gcoap: empty messages not handled yet\n");
-        return;
+        _handle_empty(&pdu, &remote);
+        goto release;
     }
 
     /* validate class and type for incoming */
@@ -215,7 +428,41 @@ static void _listen(sock_udp_t *sock)
     case COAP_CLASS_REQ:
         if (coap_get_type(&pdu) == COAP_TYPE_NON
                 || coap_get_type(&pdu) == COAP_TYPE_CON) {
-            size_t pdu_len = _handle_req(&pdu, buf, sizeof(buf), &remote);
+#ifdef MODULE_GCOAP_DEDUP
+            uint32_t now = xtimer_now_usec();
+            gcoap_dedup_entry_t *dup = _dedup_find(&pdu, &remote, now);
+            if (dup) {
+                DEBUG("gcoap: duplicate request %u\n", coap_get_id(&pdu));
+                if (dup->resp_len > 0) {
+                    sock_udp_send(sock, dup->resp, dup->resp_len, &remote);
+                }
+                break;
+            }
+            /* the response overwrites the request */
+            uint16_t msgid = coap_get_id(&pdu);
+#endif
+#ifdef MODULE_GCOAP_OSCORE
+            gcoap_oscore_req_t oscore = { .ctx = NULL };
+            size_t pdu_len;
+            res = _oscore_req(&pdu, &oscore);
+            if (res < 0) {
+                DEBUG("gcoap: unprotecting request failed: %d\n", (int)res);
+                coap_clear_observe(&pdu);
+                pdu_len = gcoap_response(&pdu, buf, sizeof(buf),
+                                         (res == -EBADMSG) ? COAP_CODE_BAD_REQUEST
+                                                           : COAP_CODE_UNAUTHORIZED);
+            }
+            else {
+                pdu_len = _handle_req(&pdu, buf, sizeof(buf), &remote,
+                                      (res > 0) ? &oscore : NULL);
+                pdu_len = _oscore_protect_resp(buf, pdu_len, sizeof(buf), &oscore);
+            }
+#else
+            size_t pdu_len = _handle_req(&pdu, buf, sizeof(buf), &remote, NULL);
+#endif
+#ifdef MODULE_GCOAP_DEDUP
+            _dedup_add(msgid, &remote, buf, pdu_len, now);
+#endif
             if (pdu_len > 0) {
                 ssize_t bytes = sock_udp_send(sock, buf, pdu_len, &remote);
                 if (bytes <= 0) {
@@ -237,7 +484,21 @@ static void _listen(sock_udp_t *sock)
             switch (coap_get_type(&pdu)) {
             case COAP_TYPE_NON:
             case COAP_TYPE_ACK:
+#ifdef MODULE_GCOAP_OSCORE
+                if (_oscore_resp(memo, &pdu) < 0) {
+                    /* keep waiting for the genuine response */
+                    DEBUG("gcoap: unprotecting response failed\n");
+                    break;
+                }
+#endif
                 xtimer_remove(&memo->response_timer);
+#if defined(MODULE_GNRC_IPV6_NIB) && defined(SOCK_HAS_IPV6)
+                /* the response confirms the server's reachability, if it is
+                 * a neighbor */
+                if (remote.family == AF_INET6) {
+                    gnrc_ipv6_nib_nc_mark_reachable((ipv6_addr_t *)&remote.addr.ipv6);
+                }
+#endif
                 memo->state = GCOAP_MEMO_RESP;
                 if (memo->resp_handler) {
                     memo->resp_handler(memo->state, &pdu, &remote);
@@ -263,6 +524,11 @@ static void _listen(sock_udp_t *sock)
     default:
         DEBUG("gcoap: illegal code class: %u\n", coap_get_code_class(&pdu));
     }
+
+release:
+    if (buf_ctx != NULL) {
+        sock_udp_recv_buf(sock, &data, &buf_ctx, 0, NULL);
+    }
 }
 
 /*
@@ -273,7 +539,7 @@ static void _listen(sock_udp_t *sock)
  * return length of response pdu, or < 0 if can't handle
  */
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
-                                                         sock_udp_ep_t *remote)
+                          sock_udp_ep_t *remote, gcoap_oscore_req_t *oscore)
 {
     const coap_resource_t *resource     = NULL;
     gcoap_listener_t *listener          = NULL;
@@ -281,46 +547,60 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     gcoap_observe_memo_t *memo          = NULL;
     gcoap_observe_memo_t *resource_memo = NULL;
 
+#ifdef MODULE_GCOAP_PROXY
+    uint8_t *proxy_opt;
+    if ((coap_opt_get_opaque(pdu, COAP_OPT_PROXY_URI, &proxy_opt) >= 0)
+            || (coap_opt_get_opaque(pdu, COAP_OPT_PROXY_SCHEME, &proxy_opt) >= 0)) {
+        return _proxy_req(pdu, buf, len, remote);
+    }
+#endif
+
     switch (_find_resource(pdu, &resource, &listener)) {
         case GCOAP_RESOURCE_WRONG_METHOD:
             return gcoap_response(pdu, buf, len, COAP_CODE_METHOD_NOT_ALLOWED);
         case GCOAP_RESOURCE_NO_PATH:
             return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
         case GCOAP_RESOURCE_FOUND:
-            /* find observe registration for resource */
-            _find_obs_memo_resource(&resource_memo, resource);
             break;
     }
 
+    mutex_lock(&_coap_state.lock);
+    /* find observe registrations for resource */
+    _find_obs_memo_resource(&resource_memo, resource);
+
     if (coap_get_observe(pdu) == COAP_OBS_REGISTER) {
         /* lookup remote+token */
         int empty_slot = _find_obs_memo(&memo, remote, pdu);
         /* validate re-registration request */
-        if (resource_memo != NULL) {
-            if (memo != NULL) {
-                if (memo != resource_memo) {
-                    /* reject token already used for a different resource */
-                    memo = NULL;
-                    coap_clear_observe(pdu);
-                    DEBUG("gcoap: can't change resource for token\n");
-                }
-                /* otherwise OK to re-register resource with the same token */
+        if (memo != NULL) {
+            if (memo->resource != resource) {
+                /* reject token already used for a different resource */
+                memo = NULL;
+                coap_clear_observe(pdu);
+                DEBUG("gcoap: can't change resource for token\n");
             }
-            else if (sock_udp_ep_equal(remote, resource_memo->observer)) {
-                /* accept new token for resource */
-                memo = resource_memo;
+            /* otherwise OK to re-register resource with the same token */
+        }
+        else {
+            /* accept new token for resource */
+            for (memo = resource_memo; memo; memo = memo->next) {
+                if (sock_udp_ep_equal(remote, memo->observer)) {
+                    break;
+                }
             }
         }
         /* initialize new registration request */
         if ((memo == NULL) && coap_has_observe(pdu)) {
-            /* verify resource not already registerered (for another endpoint) */
-            if ((empty_slot >= 0) && (resource_memo == NULL)) {
+            gcoap_obs_resource_t *entry = _obs_resource(resource, true);
+            if ((empty_slot >= 0) && (entry != NULL)) {
                 int obs_slot = _find_observer(&observer, remote);
                 /* cache new observer */
                 if (observer == NULL) {
                     if (obs_slot >= 0) {
-                        observer = &_coap_state.observers[obs_slot];
-                        memcpy(observer, remote, sizeof(sock_udp_ep_t));
+                        gcoap_observer_t *obs = &_coap_state.observers[obs_slot];
+                        memset(obs, 0, sizeof(gcoap_observer_t));
+                        memcpy(&obs->ep, remote, sizeof(sock_udp_ep_t));
+                        observer = &obs->ep;
                     } else {
                         DEBUG("gcoap: can't register observer\n");
                     }
@@ -328,6 +608,9 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                 if (observer != NULL) {
                     memo = &_coap_state.observe_memos[empty_slot];
                     memo->observer = observer;
+                    memo->resource = resource;
+                    memo->next     = entry->memos;
+                    entry->memos   = memo;
                 }
             }
             if (memo == NULL) {
@@ -337,8 +620,6 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         }
         /* finish registration */
         if (memo != NULL) {
-            /* resource may be assigned here if it is not already registered */
-            memo->resource = resource;
             memo->token_len = coap_get_token_len(pdu);
             if (memo->token_len) {
                 memcpy(&memo->token[0], pdu->token, memo->token_len);
@@ -351,8 +632,8 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         /* clear memo, and clear observer if no other memos */
         if (memo != NULL) {
             DEBUG("gcoap: Deregistering observer for: %s\n", memo->resource->path);
-            memo->observer = NULL;
-            memo           = NULL;
+            _obs_memo_remove(memo);
+            memo = NULL;
             _find_obs_memo(&memo, remote, NULL);
             if (memo == NULL) {
                 _find_observer(&observer, remote);
@@ -364,10 +645,19 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         coap_clear_observe(pdu);
 
     } else if (coap_has_observe(pdu)) {
+        mutex_unlock(&_coap_state.lock);
         /* bogus request; don't respond */
         DEBUG("gcoap: Observe value unexpected: %" PRIu32 "\n", coap_get_observe(pdu));
         return -1;
     }
+    mutex_unlock(&_coap_state.lock);
+
+#ifdef MODULE_GCOAP_WORKER
+    if (listener->flags & GCOAP_LISTENER_DEFERRED) {
+        return _defer_req(pdu, buf, len, resource, remote, oscore);
+    }
+#endif
+    (void)oscore;
 
     ssize_t pdu_len = resource->handler(pdu, buf, len, resource->context);
     if (pdu_len < 0) {
@@ -393,14 +683,41 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
     int ret = GCOAP_RESOURCE_NO_PATH;
     unsigned method_flag = coap_method2flag(coap_get_code_detail(pdu));
 
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+    if (!_coap_state.index_overflow) {
+        const gcoap_resource_entry_t *index = &_coap_state.index[0];
+        unsigned lo = 0;
+        unsigned hi = _coap_state.index_len;
+
+        /* find first entry with the path */
+        while (lo < hi) {
+            unsigned mid = (lo + hi) / 2;
+            if (coap_uri_path_cmp(pdu, index[mid].resource->path) > 0) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        /* entries with the same path are in registration order */
+        for (; lo < _coap_state.index_len; lo++) {
+            if (coap_uri_path_cmp(pdu, index[lo].resource->path) != 0) {
+                break;
+            }
+            if (index[lo].resource->methods & method_flag) {
+                *resource_ptr = index[lo].resource;
+                *listener_ptr = index[lo].listener;
+                return GCOAP_RESOURCE_FOUND;
+            }
+            ret = GCOAP_RESOURCE_WRONG_METHOD;
+        }
+        return ret;
+    }
+#endif
+
     /* Find path for CoAP msg among listener resources and execute callback. */
     gcoap_listener_t *listener = _coap_state.listeners;
 
-    uint8_t uri[NANOCOAP_URI_MAX];
-    if (coap_get_uri_path(pdu, uri) <= 0) {
-        return GCOAP_RESOURCE_NO_PATH;
-    }
-
     while (listener) {
         const coap_resource_t *resource = listener->resources;
         for (size_t i = 0; i < listener->resources_len; i++) {
@@ -408,7 +725,7 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
                 resource++;
             }
 
-            int res = strcmp((char *)&uri[0], resource->path);
+            int res = coap_uri_path_cmp(pdu, resource->path);
             if (res > 0) {
                 continue;
             }
@@ -433,9 +750,264 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
     return ret;
 }
 
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+/*
+ * Adds the resources of a listener to the lookup index. Resources are inserted
+ * behind those with the same path, so earlier listeners take precedence as
+ * when searching the listeners one by one.
+ */
+static void _index_listener(gcoap_listener_t *listener)
+{
+    gcoap_resource_entry_t *index = &_coap_state.index[0];
+
+    for (size_t i = 0; i < listener->resources_len; i++) {
+        const coap_resource_t *resource = &listener->resources[i];
+        unsigned lo = 0;
+        unsigned hi = _coap_state.index_len;
+
+        if (_coap_state.index_len == GCOAP_RESOURCE_INDEX_SIZE) {
+            DEBUG("gcoap: resource index full, searching listeners\n");
+            _coap_state.index_overflow = true;
+            return;
+        }
+
+        while (lo < hi) {
+            unsigned mid = (lo + hi) / 2;
+            if (strcmp(resource->path, index[mid].resource->path) >= 0) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        memmove(&index[lo + 1], &index[lo],
+                (_coap_state.index_len - lo) * sizeof(index[0]));
+        index[lo].resource = resource;
+        index[lo].listener = listener;
+        _coap_state.index_len++;
+    }
+}
+#endif
+
+#ifdef MODULE_GCOAP_WORKER
+/*
+ * Hands a request over to the least busy worker thread. Acknowledges a
+ * confirmable request, so the handler may take its time.
+ *
+ * return length of the empty ACK or error response to send, or 0 if nothing
+ *        to send
+ */
+static size_t _defer_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                         const coap_resource_t *resource, sock_udp_ep_t *remote,
+                         const gcoap_oscore_req_t *oscore)
+{
+    gcoap_job_t *job = NULL;
+
+    mutex_lock(&_coap_state.lock);
+    for (unsigned i = 0; i < GCOAP_WORKER_JOBS_MAX; i++) {
+        if (_coap_state.jobs[i].resource == NULL) {
+            job = &_coap_state.jobs[i];
+            break;
+        }
+    }
+    if (job) {
+        job->resource = resource;
+        job->worker   = &_coap_state.workers[0];
+        for (unsigned i = 1; i < GCOAP_WORKER_NUMOF; i++) {
+            if (_coap_state.workers[i].pending < job->worker->pending) {
+                job->worker = &_coap_state.workers[i];
+            }
+        }
+        job->worker->pending++;
+    }
+    mutex_unlock(&_coap_state.lock);
+
+    if (!job) {
+        DEBUG("gcoap: no worker job available\n");
+        return gcoap_response(pdu, buf, len, COAP_CODE_SERVICE_UNAVAILABLE);
+    }
+
+    /* copy request and rebase the parsed packet on the copy */
+    uint8_t *req = (uint8_t *)pdu->hdr;
+    size_t req_len = (pdu->payload - req) + pdu->payload_len;
+    if (req_len > sizeof(job->buf)) {
+        mutex_lock(&_coap_state.lock);
+        job->worker->pending--;
+        job->resource = NULL;
+        mutex_unlock(&_coap_state.lock);
+        DEBUG("gcoap: request too large to defer\n");
+        return gcoap_response(pdu, buf, len, COAP_CODE_REQUEST_ENTITY_TOO_LARGE);
+    }
+    memcpy(&job->buf[0], req, req_len);
+    memcpy(&job->pdu, pdu, sizeof(coap_pkt_t));
+    job->pdu.hdr     = (coap_hdr_t *)&job->buf[0];
+    job->pdu.token   = &job->buf[pdu->token - req];
+    job->pdu.payload = &job->buf[pdu->payload - req];
+    memcpy(&job->remote, remote, sizeof(sock_udp_ep_t));
+#ifdef MODULE_GCOAP_OSCORE
+    /* the response is protected on the worker */
+    job->oscore.ctx = NULL;
+    if (oscore) {
+        job->oscore = *oscore;
+    }
+#else
+    (void)oscore;
+#endif
+
+    size_t pdu_len = 0;
+    job->separate  = (coap_get_type(pdu) == COAP_TYPE_CON);
+    if (job->separate) {
+        /* separate response is sent non-confirmable; gcoap_resp_init() keeps
+         * the type */
+        coap_hdr_set_type(job->pdu.hdr, COAP_TYPE_NON);
+        pdu_len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_ACK, NULL, 0,
+                                 COAP_CODE_EMPTY, coap_get_id(pdu));
+    }
+
+    event_post(&job->worker->queue, &job->event);
+    return pdu_len;
+}
+
+/* Runs a resource handler on a worker thread and sends the response. */
+static void _job_handler(event_t *event)
+{
+    gcoap_job_t *job = container_of(event, gcoap_job_t, event);
+    coap_pkt_t *pdu  = &job->pdu;
+
+    if (job->separate) {
+        uint16_t msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
+        pdu->hdr->id = htons(msgid);
+    }
+
+    ssize_t pdu_len = job->resource->handler(pdu, &job->buf[0], sizeof(job->buf),
+                                             job->resource->context);
+    if (pdu_len < 0) {
+        pdu_len = gcoap_response(pdu, &job->buf[0], sizeof(job->buf),
+                                 COAP_CODE_INTERNAL_SERVER_ERROR);
+    }
+#ifdef MODULE_GCOAP_OSCORE
+    pdu_len = _oscore_protect_resp(&job->buf[0], pdu_len, sizeof(job->buf),
+                                   &job->oscore);
+#endif
+    if (pdu_len > 0) {
+        ssize_t bytes = sock_udp_send(&_sock, &job->buf[0], pdu_len, &job->remote);
+        if (bytes <= 0) {
+            DEBUG("gcoap: send deferred response failed: %d\n", (int)bytes);
+        }
+    }
+
+    mutex_lock(&_coap_state.lock);
+    job->worker->pending--;
+    job->resource = NULL;
+    mutex_unlock(&_coap_state.lock);
+}
+
+/* Event loop for a worker thread. */
+static void *_worker_loop(void *arg)
+{
+    gcoap_worker_t *worker = (gcoap_worker_t *)arg;
+
+    event_loop(&worker->queue);
+    return NULL;
+}
+
+static void _worker_init(void)
+{
+    for (unsigned i = 0; i < GCOAP_WORKER_JOBS_MAX; i++) {
+        _coap_state.jobs[i].event.handler = _job_handler;
+    }
+    for (unsigned i = 0; i < GCOAP_WORKER_NUMOF; i++) {
+        gcoap_worker_t *worker = &_coap_state.workers[i];
+        kernel_pid_t pid = thread_create(worker->stack, sizeof(worker->stack),
+                                         GCOAP_WORKER_PRIO, THREAD_CREATE_STACKTEST,
+                                         _worker_loop, worker, "coap_worker");
+        /* set owner here, the worker may not have run yet */
+        worker->queue.waiter = (thread_t *)thread_get(pid);
+    }
+}
+#endif
+
+#ifdef MODULE_GCOAP_OSCORE
+/*
+ * Removes the protection of a request. The proxy forwards requests with a
+ * Proxy-Uri or Proxy-Scheme option as they are.
+ *
+ * return 0 if the request is not protected, 1 if it was, < 0 on error
+ */
+static int _oscore_req(coap_pkt_t *pdu, gcoap_oscore_req_t *oscore)
+{
+#ifdef MODULE_GCOAP_PROXY
+    uint8_t *proxy_opt;
+    if ((coap_opt_get_opaque(pdu, COAP_OPT_PROXY_URI, &proxy_opt) >= 0)
+            || (coap_opt_get_opaque(pdu, COAP_OPT_PROXY_SCHEME, &proxy_opt) >= 0)) {
+        return 0;
+    }
+#endif
+
+    ssize_t len = gcoap_oscore_unprotect(pdu, oscore);
+    if (len == -ENOENT) {
+        return 0;
+    }
+    if (len < 0) {
+        return len;
+    }
+    if (coap_parse(pdu, (uint8_t *)pdu->hdr, len) < 0) {
+        return -EBADMSG;
+    }
+    /* notifications are not protected, so no observer is registered */
+    coap_clear_observe(pdu);
+    return 1;
+}
+
+/*
+ * Removes the protection of the response to a protected request. Unprotected
+ * error responses are passed on, e.g. 4.01 for an unknown security context.
+ *
+ * return 0 if the response is to be handled, < 0 to drop it
+ */
+static int _oscore_resp(gcoap_request_memo_t *memo, coap_pkt_t *pdu)
+{
+    if (memo->oscore.ctx == NULL) {
+        return 0;
+    }
+
+    ssize_t len = gcoap_oscore_unprotect(pdu, &memo->oscore);
+    if (len == -ENOENT) {
+        return (coap_get_code_class(pdu) >= COAP_CLASS_CLIENT_FAILURE)
+               ? 0 : -EBADMSG;
+    }
+    if (len < 0) {
+        return len;
+    }
+    return (coap_parse(pdu, (uint8_t *)pdu->hdr, len) < 0) ? -EBADMSG : 0;
+}
+
+/*
+ * Protects the response to a protected request in its buffer.
+ *
+ * return length of the protected response, or 0 if it cannot be sent
+ */
+static size_t _oscore_protect_resp(uint8_t *buf, size_t len, size_t buf_len,
+                                   gcoap_oscore_req_t *oscore)
+{
+    /* an empty ACK is sent as it is */
+    if ((oscore->ctx == NULL) || (len == 0)
+            || (((coap_hdr_t *)buf)->code == COAP_CODE_EMPTY)) {
+        return len;
+    }
+
+    ssize_t res = gcoap_oscore_protect(buf, len, buf_len, oscore, false);
+    if (res < 0) {
+        DEBUG("gcoap: protecting response failed: %d\n", (int)res);
+        return 0;
+    }
+    return res;
+}
+#endif
+
 /*
- * Finds the memo for an outstanding request within the _coap_state.open_reqs
- * array. Matches on remote endpoint and token.
+ * Finds the memo for an outstanding request within the memo pools.
+ * Matches on remote endpoint and token.
  *
  * memo_ptr[out] -- Registered request memo, or NULL if not found
  * src_pdu[in] -- PDU for token to match
@@ -450,27 +1022,106 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     coap_pkt_t *memo_pdu = &memo_pdu_data;
     unsigned cmplen      = coap_get_token_len(src_pdu);
 
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED)
-            continue;
+    for (gcoap_req_memo_pool_t *pool = &_default_memo_pool; pool; pool = pool->next) {
+        for (size_t i = 0; i < pool->memos_numof; i++) {
+            if (pool->memos[i].state == GCOAP_MEMO_UNUSED)
+                continue;
 
-        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
-        if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-            memo_pdu->hdr = (coap_hdr_t *) &memo->msg.hdr_buf[0];
-        }
-        else {
-            memo_pdu->hdr = (coap_hdr_t *) memo->msg.data.pdu_buf;
+            gcoap_request_memo_t *memo = &pool->memos[i];
+            if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
+                memo_pdu->hdr = (coap_hdr_t *) &memo->msg.hdr_buf[0];
+            }
+            else {
+                memo_pdu->hdr = (coap_hdr_t *) memo->msg.data.pdu_buf;
+            }
+
+            if (coap_get_token_len(memo_pdu) == cmplen) {
+                memo_pdu->token = coap_hdr_data_ptr(memo_pdu->hdr);
+                if ((memcmp(src_pdu->token, memo_pdu->token, cmplen) == 0)
+                        && sock_udp_ep_equal(&memo->remote_ep, remote)) {
+                    *memo_ptr = memo;
+                    return;
+                }
+            }
         }
+    }
+}
+
+/*
+ * Finds an unused memo in the memo pools and an unused resend buffer for it,
+ * if requested. Must be called with the gcoap lock held.
+ *
+ * resend_buf[out] -- Resend buffer, or NULL if none is available; NULL to
+ *                    not look for one
+ * return memo or NULL if none is available
+ */
+static gcoap_request_memo_t *_alloc_req_memo(uint8_t **resend_buf)
+{
+    gcoap_request_memo_t *memo = NULL;
+    gcoap_req_memo_pool_t *pool;
 
-        if (coap_get_token_len(memo_pdu) == cmplen) {
-            memo_pdu->token = coap_hdr_data_ptr(memo_pdu->hdr);
-            if ((memcmp(src_pdu->token, memo_pdu->token, cmplen) == 0)
-                    && sock_udp_ep_equal(&memo->remote_ep, remote)) {
-                *memo_ptr = memo;
+    for (pool = &_default_memo_pool; pool && !memo; pool = pool->next) {
+        for (size_t i = 0; i < pool->memos_numof; i++) {
+            if (pool->memos[i].state == GCOAP_MEMO_UNUSED) {
+                memo = &pool->memos[i];
                 break;
             }
         }
     }
+    if (memo && resend_buf) {
+        *resend_buf = NULL;
+        for (pool = &_default_memo_pool; pool && !*resend_buf; pool = pool->next) {
+            for (size_t i = 0; i < pool->resend_bufs_numof; i++) {
+                if (!pool->resend_bufs[i][0]) {
+                    *resend_buf = &pool->resend_bufs[i][0];
+                    break;
+                }
+            }
+        }
+    }
+    return memo;
+}
+
+/*
+ * Checks whether another request may be sent to an endpoint. Must be called
+ * with the gcoap lock held.
+ *
+ * return true if less requests than the limit for the endpoint are waiting
+ *        for a response
+ */
+static bool _nstart_ok(const sock_udp_ep_t *remote)
+{
+    unsigned limit = _nstart(remote);
+    unsigned outstanding = 0;
+
+    if (limit == 0) {
+        return true;
+    }
+    for (gcoap_req_memo_pool_t *pool = &_default_memo_pool; pool; pool = pool->next) {
+        for (size_t i = 0; i < pool->memos_numof; i++) {
+            if ((pool->memos[i].state == GCOAP_MEMO_WAIT)
+                    && sock_udp_ep_equal(&pool->memos[i].remote_ep, remote)
+                    && (++outstanding >= limit)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * Finds the limit of outstanding requests to an endpoint. Must be called with
+ * the gcoap lock held.
+ */
+static unsigned _nstart(const sock_udp_ep_t *remote)
+{
+    for (unsigned i = 0; i < GCOAP_NSTART_ENDPOINTS_MAX; i++) {
+        if ((_coap_state.nstart[i].ep.family != AF_UNSPEC)
+                && sock_udp_ep_equal(&_coap_state.nstart[i].ep, remote)) {
+            return _coap_state.nstart[i].nstart;
+        }
+    }
+    return GCOAP_NSTART;
 }
 
 /* Calls handler callback on receipt of a timeout message. */
@@ -531,11 +1182,11 @@ static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
     *observer      = NULL;
     for (unsigned i = 0; i < GCOAP_OBS_CLIENTS_MAX; i++) {
 
-        if (_coap_state.observers[i].family == AF_UNSPEC) {
+        if (_coap_state.observers[i].ep.family == AF_UNSPEC) {
             empty_slot = i;
         }
-        else if (sock_udp_ep_equal(&_coap_state.observers[i], remote)) {
-            *observer = &_coap_state.observers[i];
+        else if (sock_udp_ep_equal(&_coap_state.observers[i].ep, remote)) {
+            *observer = &_coap_state.observers[i].ep;
             break;
         }
     }
@@ -596,34 +1247,726 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource)
 {
-    *memo = NULL;
-    for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
-        if (_coap_state.observe_memos[i].observer != NULL
-                && _coap_state.observe_memos[i].resource == resource) {
-            *memo = &_coap_state.observe_memos[i];
-            break;
+    gcoap_obs_resource_t *entry = _obs_resource(resource, false);
+
+    *memo = (entry != NULL) ? entry->memos : NULL;
+}
+
+/*
+ * Find the list of observe registrations for a resource.
+ *
+ * resource[in] -- Resource to match
+ * create[in] -- Take an unused entry if the resource has no registrations
+ *
+ * return Entry for the resource, or NULL if not found
+ */
+static gcoap_obs_resource_t *_obs_resource(const coap_resource_t *resource,
+                                           bool create)
+{
+    gcoap_obs_resource_t *empty = NULL;
+
+    for (unsigned i = 0; i < GCOAP_OBS_RESOURCES_MAX; i++) {
+        gcoap_obs_resource_t *entry = &_coap_state.obs_resources[i];
+        if (entry->memos == NULL) {
+            empty = entry;
+        }
+        else if (entry->resource == resource) {
+            return entry;
         }
     }
+    if (create && (empty != NULL)) {
+        empty->resource = resource;
+        return empty;
+    }
+    return NULL;
 }
 
 /*
- * gcoap interface functions
+ * Removes an observe registration from the list of its resource and releases
+ * the memo.
  */
-
-kernel_pid_t gcoap_init(void)
+static void _obs_memo_remove(gcoap_observe_memo_t *memo)
 {
-    if (_pid != KERNEL_PID_UNDEF) {
-        return -EEXIST;
+    gcoap_obs_resource_t *entry = _obs_resource(memo->resource, false);
+
+    if (entry != NULL) {
+        gcoap_observe_memo_t **prev = &entry->memos;
+        while (*prev && (*prev != memo)) {
+            prev = &(*prev)->next;
+        }
+        if (*prev) {
+            *prev = memo->next;
+        }
     }
-    _pid = thread_create(_msg_stack, sizeof(_msg_stack), THREAD_PRIORITY_MAIN - 1,
-                            THREAD_CREATE_STACKTEST, _event_loop, NULL, "coap");
+    memo->next     = NULL;
+    memo->observer = NULL;
+}
+
+/*
+ * Removes an observer with all its registrations, when it rejected a
+ * notification or did not acknowledge a confirmable one (see RFC 7641,
+ * sections 3.6 and 4.5). Must be called with the gcoap lock held.
+ */
+static void _obs_remove_observer(gcoap_observer_t *obs)
+{
+    DEBUG("gcoap: removing observer\n");
+    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        if (_coap_state.observe_memos[i].observer == &obs->ep) {
+            _obs_memo_remove(&_coap_state.observe_memos[i]);
+        }
+    }
+    obs->ep.family = AF_UNSPEC;
+}
+
+/*
+ * Handles an empty message, which may acknowledge or reject the last
+ * notification to an observer.
+ */
+static void _handle_empty(coap_pkt_t *pdu, sock_udp_ep_t *remote)
+{
+    unsigned type = coap_get_type(pdu);
+    sock_udp_ep_t *observer = NULL;
+
+    if ((type != COAP_TYPE_ACK) && (type != COAP_TYPE_RST)) {
+        DEBUG("gcoap: empty message type %u not handled\n", type);
+        return;
+    }
+
+    mutex_lock(&_coap_state.lock);
+    _find_observer(&observer, remote);
+    if (observer != NULL) {
+        gcoap_observer_t *obs = container_of(observer, gcoap_observer_t, ep);
+        if (obs->msgid == coap_get_id(pdu)) {
+            if (type == COAP_TYPE_RST) {
+                _obs_remove_observer(obs);
+            }
+            else if (obs->con_pending) {
+                obs->con_pending   = false;
+                obs->con_retries   = 0;
+                obs->notifications = 0;
+            }
+        }
+    }
+    mutex_unlock(&_coap_state.lock);
+}
+
+/*
+ * Decides how to send the next notification to an observer. Confirmable
+ * notifications are sent every GCOAP_OBS_CON_INTERVAL notifications, and only
+ * one may be outstanding per observer. While it is, further notifications are
+ * dropped until the ACK timeout expired; the next one then replaces the
+ * outstanding notification, with exponential back-off (see RFC 7641,
+ * section 4.5.2).
+ *
+ * return COAP_TYPE_CON or COAP_TYPE_NON, or -1 to not send now
+ */
+static int _obs_pace(gcoap_observer_t *obs, uint32_t now)
+{
+    if (obs->con_pending) {
+        uint32_t timeout = ((uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC) << obs->con_retries;
+        if ((now - obs->con_sent) < timeout) {
+            return -1;
+        }
+        if (obs->con_retries >= COAP_MAX_RETRANSMIT) {
+            _obs_remove_observer(obs);
+            return -1;
+        }
+        obs->con_retries++;
+        obs->con_sent = now;
+        return COAP_TYPE_CON;
+    }
+    if (++obs->notifications >= GCOAP_OBS_CON_INTERVAL) {
+        obs->notifications = 0;
+        obs->con_pending   = true;
+        obs->con_retries   = 0;
+        obs->con_sent      = now;
+        return COAP_TYPE_CON;
+    }
+    return COAP_TYPE_NON;
+}
+
+#ifdef MODULE_GCOAP_DEDUP
+/*
+ * Finds the cached response to a request with the message ID of a PDU from an
+ * endpoint, if it is not expired.
+ *
+ * return entry, or NULL if not found
+ */
+static gcoap_dedup_entry_t *_dedup_find(coap_pkt_t *pdu,
+                                        const sock_udp_ep_t *remote,
+                                        uint32_t now)
+{
+    uint16_t msgid = coap_get_id(pdu);
+
+    for (unsigned i = 0; i < GCOAP_DEDUP_CACHE_SIZE; i++) {
+        gcoap_dedup_entry_t *entry = &_coap_state.dedup[i];
+        if (!entry->used) {
+            continue;
+        }
+        if ((now - entry->time) >= GCOAP_DEDUP_LIFETIME) {
+            entry->used = false;
+        }
+        else if ((entry->msgid == msgid)
+                    && sock_udp_ep_equal(&entry->remote, remote)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Caches the response to a request, replacing an unused or the oldest entry.
+ *
+ * resp_len -- Length of response; zero if none was sent
+ */
+static void _dedup_add(uint16_t msgid, const sock_udp_ep_t *remote,
+                       const uint8_t *resp, size_t resp_len, uint32_t now)
+{
+    gcoap_dedup_entry_t *entry = &_coap_state.dedup[0];
+
+    for (unsigned i = 0; i < GCOAP_DEDUP_CACHE_SIZE; i++) {
+        if (!_coap_state.dedup[i].used) {
+            entry = &_coap_state.dedup[i];
+            break;
+        }
+        if ((now - _coap_state.dedup[i].time) > (now - entry->time)) {
+            entry = &_coap_state.dedup[i];
+        }
+    }
+
+    memcpy(&entry->remote, remote, sizeof(sock_udp_ep_t));
+    entry->time     = now;
+    entry->msgid    = msgid;
+    entry->resp_len = resp_len;
+    entry->used     = true;
+    memcpy(entry->resp, resp, resp_len);
+}
+#endif
+
+#ifdef MODULE_GCOAP_PROXY
+static uint32_t _proxy_now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+/*
+ * Gets the server and the path and query of the URI a request is proxied to,
+ * from the Proxy-Uri option, or from the Proxy-Scheme and Uri-* options.
+ *
+ * param[out] path -- "/path?query", GCOAP_PROXY_PATH_MAX bytes
+ * return 0 on success, -EINVAL if the URI is not supported, -ENOSPC if it is
+ *        too long
+ */
+static int _proxy_target(coap_pkt_t *pdu, sock_udp_ep_t *ep, char *path)
+{
+    static const char scheme[] = "coap://";
+    char *uri = _coap_state.proxy_uri;
+    uint8_t *val;
+    ssize_t val_len = coap_opt_get_opaque(pdu, COAP_OPT_PROXY_URI, &val);
+
+    if (val_len >= 0) {
+        if ((size_t)val_len >= GCOAP_PROXY_URI_MAX) {
+            return -ENOSPC;
+        }
+        memcpy(uri, val, val_len);
+        uri[val_len] = '\0';
+        if (strncmp(uri, scheme, sizeof(scheme) - 1) != 0) {
+            return -EINVAL;
+        }
+        /* move host and port to the start, terminated by the path */
+        memmove(uri, &uri[sizeof(scheme) - 1],
+                val_len - (sizeof(scheme) - 1) + 1);
+
+        char *pathstart = uri + strcspn(uri, "/?");
+        size_t path_len = strlen(pathstart);
+        unsigned slash = (*pathstart != '/');
+        if ((slash + path_len) >= GCOAP_PROXY_PATH_MAX) {
+            return -ENOSPC;
+        }
+        path[0] = '/';
+        memcpy(&path[slash], pathstart, path_len + 1);
+        *pathstart = '\0';
+    }
+    else {
+        val_len = coap_opt_get_opaque(pdu, COAP_OPT_PROXY_SCHEME, &val);
+        if ((val_len != 4) || (memcmp(val, "coap", 4) != 0)) {
+            return -EINVAL;
+        }
+        /* an IPv6 literal, possibly without brackets */
+        val_len = coap_opt_get_opaque(pdu, COAP_OPT_URI_HOST, &val);
+        if (val_len <= 0) {
+            return -EINVAL;
+        }
+        if ((size_t)val_len + 2 >= GCOAP_PROXY_URI_MAX) {
+            return -ENOSPC;
+        }
+        if (val[0] == '[') {
+            memcpy(uri, val, val_len);
+            uri[val_len] = '\0';
+        }
+        else {
+            uri[0] = '[';
+            memcpy(&uri[1], val, val_len);
+            uri[val_len + 1] = ']';
+            uri[val_len + 2] = '\0';
+        }
+
+        ssize_t res = coap_opt_get_string(pdu, COAP_OPT_URI_PATH,
+                                          (uint8_t *)path,
+                                          GCOAP_PROXY_PATH_MAX, '/');
+        if (res < 0) {
+            return -ENOSPC;
+        }
+        if (coap_opt_get_opaque(pdu, COAP_OPT_URI_QUERY, &val) >= 0) {
+            size_t path_len = res - 1;
+            res = coap_opt_get_string(pdu, COAP_OPT_URI_QUERY,
+                                      (uint8_t *)&path[path_len],
+                                      GCOAP_PROXY_PATH_MAX - path_len, '&');
+            if (res < 0) {
+                return -ENOSPC;
+            }
+            path[path_len] = '?';
+        }
+    }
+
+    if ((sock_udp_str2ep(ep, uri) < 0) || (ep->family != AF_INET6)) {
+        return -EINVAL;
+    }
+    if (ep->port == 0) {
+        uint32_t port = COAP_PORT;
+        coap_get_option_uint(pdu, COAP_OPT_URI_PORT, &port);
+        ep->port = port;
+    }
+    return 0;
+}
+
+static gcoap_proxy_entry_t *_proxy_cache_find(const sock_udp_ep_t *ep,
+                                              const char *path)
+{
+    for (unsigned i = 0; i < GCOAP_PROXY_CACHE_SIZE; i++) {
+        gcoap_proxy_entry_t *entry = &_coap_state.proxy_cache[i];
+        if ((entry->ep.family != AF_UNSPEC)
+                && sock_udp_ep_equal(&entry->ep, ep)
+                && (strcmp(entry->path, path) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Finds a forwarded GET request for a URI, to wait for its response.
+ */
+static gcoap_proxy_req_t *_proxy_req_find(const sock_udp_ep_t *ep,
+                                          const char *path)
+{
+    for (unsigned i = 0; i < GCOAP_PROXY_PENDING_MAX; i++) {
+        gcoap_proxy_req_t *req = &_coap_state.proxy_reqs[i];
+        if ((req->ep.family != AF_UNSPEC)
+                && (req->method == COAP_METHOD_GET)
+                && sock_udp_ep_equal(&req->ep, ep)
+                && (strcmp(req->path, path) == 0)) {
+            return req;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Writes a cached response to a client after the header in a PDU. Answers
+ * 2.03 (Valid) if the client has the same ETag.
+ *
+ * return length of the PDU
+ */
+static ssize_t _proxy_cache_resp(coap_pkt_t *pdu,
+                                 const gcoap_proxy_entry_t *entry,
+                                 const uint8_t *etag, size_t etag_len,
+                                 uint32_t now)
+{
+    bool valid = (etag_len > 0) && (etag_len == entry->etag_len)
+                    && (memcmp(etag, entry->etag, etag_len) == 0);
+    uint32_t max_age = ((int32_t)(entry->expires - now) > 0)
+                    ? (entry->expires - now) : 0;
+
+    coap_hdr_set_code(pdu->hdr, valid ? COAP_CODE_VALID : COAP_CODE_CONTENT);
+    if (entry->etag_len) {
+        coap_opt_add_opaque(pdu, COAP_OPT_ETAG, entry->etag, entry->etag_len);
+    }
+    if (!valid && (entry->format != COAP_FORMAT_NONE)) {
+        coap_opt_add_uint(pdu, COAP_OPT_CONTENT_FORMAT, entry->format);
+    }
+    coap_opt_add_uint(pdu, COAP_OPT_MAX_AGE, max_age);
+
+    if (valid || (entry->payload_len == 0)) {
+        return coap_opt_finish(pdu, COAP_OPT_FINISH_NONE);
+    }
+    ssize_t hdr_len = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+    assert(pdu->payload_len >= entry->payload_len);
+    memcpy(pdu->payload, entry->payload, entry->payload_len);
+    return hdr_len + entry->payload_len;
+}
+
+/*
+ * Updates the cache with the response to a forwarded GET request, replacing
+ * an unused or the entry that expires first.
+ *
+ * return entry to answer the waiting clients from, or NULL if the response is
+ *        not cached
+ */
+static gcoap_proxy_entry_t *_proxy_cache_update(const gcoap_proxy_req_t *req,
+                                                coap_pkt_t *pdu)
+{
+    gcoap_proxy_entry_t *entry = _proxy_cache_find(&req->ep, req->path);
+    uint32_t now = _proxy_now();
+    uint32_t max_age = GCOAP_PROXY_MAX_AGE_DEFAULT;
+    uint8_t *etag;
+    ssize_t etag_len = coap_opt_get_opaque(pdu, COAP_OPT_ETAG, &etag);
+
+    if (etag_len < 0) {
+        etag_len = 0;
+    }
+    coap_get_option_uint(pdu, COAP_OPT_MAX_AGE, &max_age);
+
+    if (coap_get_code_raw(pdu) == COAP_CODE_VALID) {
+        /* validated the stale entry */
+        if ((entry == NULL) || (etag_len != entry->etag_len)
+                || (memcmp(etag, entry->etag, etag_len) != 0)) {
+            return NULL;
+        }
+        entry->expires = now + max_age;
+        return entry;
+    }
+    if ((coap_get_code_raw(pdu) != COAP_CODE_CONTENT) || (max_age == 0)
+            || (pdu->payload_len > GCOAP_PROXY_PAYLOAD_MAX)
+            || (etag_len > GCOAP_PROXY_ETAG_MAX)) {
+        if (entry) {
+            entry->ep.family = AF_UNSPEC;
+        }
+        return NULL;
+    }
+
+    if (entry == NULL) {
+        entry = &_coap_state.proxy_cache[0];
+        for (unsigned i = 0; i < GCOAP_PROXY_CACHE_SIZE; i++) {
+            gcoap_proxy_entry_t *cur = &_coap_state.proxy_cache[i];
+            if (cur->ep.family == AF_UNSPEC) {
+                entry = cur;
+                break;
+            }
+            if ((int32_t)(cur->expires - entry->expires) < 0) {
+                entry = cur;
+            }
+        }
+    }
+    memcpy(&entry->ep, &req->ep, sizeof(sock_udp_ep_t));
+    strcpy(entry->path, req->path);
+    entry->expires     = now + max_age;
+    entry->format      = coap_get_content_type(pdu);
+    entry->etag_len    = etag_len;
+    memcpy(entry->etag, etag, etag_len);
+    entry->payload_len = pdu->payload_len;
+    memcpy(entry->payload, pdu->payload, pdu->payload_len);
+    return entry;
+}
+
+/*
+ * Sends the response to a forwarded request to a waiting client, as a
+ * separate non-confirmable message. Takes the response from the cache entry,
+ * or else the options and payload from the server's response, or else sends
+ * only the code.
+ */
+static void _proxy_reply(const gcoap_proxy_waiter_t *waiter, unsigned code,
+                         const gcoap_proxy_entry_t *entry, coap_pkt_t *resp)
+{
+    uint8_t *buf = &_coap_state.proxy_buf[0];
+    uint16_t msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
+    ssize_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON,
+                                 (uint8_t *)waiter->token, waiter->token_len,
+                                 code, msgid);
+
+    if (entry) {
+        coap_pkt_t pdu;
+        coap_pkt_init(&pdu, buf, sizeof(_coap_state.proxy_buf), len);
+        len = _proxy_cache_resp(&pdu, entry, waiter->etag, waiter->etag_len,
+                                _proxy_now());
+    }
+    else if (resp) {
+        uint8_t *opts = (uint8_t *)resp->hdr + coap_get_total_hdr_len(resp);
+        size_t opts_len = (resp->payload - opts) + resp->payload_len;
+        if ((len + opts_len) <= sizeof(_coap_state.proxy_buf)) {
+            memcpy(&buf[len], opts, opts_len);
+            len += opts_len;
+        }
+        else {
+            DEBUG("gcoap: proxied response too large\n");
+            coap_hdr_set_code((coap_hdr_t *)buf, COAP_CODE_BAD_GATEWAY);
+        }
+    }
+
+    ssize_t res = sock_udp_send(&_sock, buf, len, &waiter->ep);
+    if (res <= 0) {
+        DEBUG("gcoap: send proxied response failed: %d\n", (int)res);
+    }
+}
+
+/* Answers the clients waiting for a forwarded request. */
+static void _proxy_resp_handler(unsigned req_state, coap_pkt_t *pdu,
+                                sock_udp_ep_t *remote)
+{
+    gcoap_proxy_req_t *req = NULL;
+    gcoap_proxy_entry_t *entry = NULL;
+    unsigned code = COAP_CODE_BAD_GATEWAY;
+    uint8_t *block;
+    (void)remote;
+
+    for (unsigned i = 0; i < GCOAP_PROXY_PENDING_MAX; i++) {
+        gcoap_proxy_req_t *cur = &_coap_state.proxy_reqs[i];
+        if ((cur->ep.family != AF_UNSPEC)
+                && (memcmp(cur->token, coap_hdr_data_ptr(pdu->hdr),
+                           GCOAP_TOKENLEN) == 0)) {
+            req = cur;
+            break;
+        }
+    }
+    if (req == NULL) {
+        return;
+    }
+
+    if (req_state == GCOAP_MEMO_TIMEOUT) {
+        code = COAP_CODE_GATEWAY_TIMEOUT;
+        pdu  = NULL;
+    }
+    else if ((req_state != GCOAP_MEMO_RESP)
+                || (coap_opt_get_opaque(pdu, COAP_OPT_BLOCK2, &block) >= 0)) {
+        /* block-wise transfers are not proxied */
+        pdu  = NULL;
+    }
+    else {
+        code = coap_get_code_raw(pdu);
+        if (req->method == COAP_METHOD_GET) {
+            entry = _proxy_cache_update(req, pdu);
+        }
+        if ((code == COAP_CODE_VALID) && (entry == NULL)) {
+            /* validated entry was replaced meanwhile */
+            code = COAP_CODE_BAD_GATEWAY;
+            pdu  = NULL;
+        }
+    }
+
+    DEBUG("gcoap: proxy answers %u clients with %u\n",
+          (unsigned)req->waiters_numof, code);
+    for (unsigned i = 0; i < req->waiters_numof; i++) {
+        _proxy_reply(&req->waiters[i], code, entry, pdu);
+    }
+    req->ep.family = AF_UNSPEC;
+}
+
+/*
+ * Forwards a request to a server. Validates the stale cache entry, if it has
+ * an ETag.
+ *
+ * return 0 on success, or the response code to answer the client with
+ */
+static unsigned _proxy_forward(coap_pkt_t *pdu, const sock_udp_ep_t *ep,
+                               const char *path,
+                               const gcoap_proxy_entry_t *stale,
+                               gcoap_proxy_req_t **req_ptr)
+{
+    gcoap_proxy_req_t *req = NULL;
+    coap_pkt_t fwd;
+    uint8_t *buf = &_coap_state.proxy_buf[0];
+    char *uri = _coap_state.proxy_uri;
+    unsigned format = coap_get_content_type(pdu);
+
+    for (unsigned i = 0; i < GCOAP_PROXY_PENDING_MAX; i++) {
+        if (_coap_state.proxy_reqs[i].ep.family == AF_UNSPEC) {
+            req = &_coap_state.proxy_reqs[i];
+            break;
+        }
+    }
+    if (req == NULL) {
+        DEBUG("gcoap: too many proxied requests\n");
+        return COAP_CODE_SERVICE_UNAVAILABLE;
+    }
+
+    /* header, payload marker, Content-Format and ETag; an option per path
+     * segment and query parameter takes at most two bytes besides its value */
+    size_t need = sizeof(coap_hdr_t) + GCOAP_TOKENLEN + 1 + 3
+                  + (stale ? stale->etag_len + 1 : 0)
+                  + strlen(path) + pdu->payload_len;
+    for (const char *c = path; *c; c++) {
+        if ((*c == '/') || (*c == '?') || (*c == '&')) {
+            need++;
+        }
+    }
+    if (need > (GCOAP_PDU_BUF_SIZE - GCOAP_REQ_OPTIONS_BUF)) {
+        return COAP_CODE_REQUEST_ENTITY_TOO_LARGE;
+    }
+
+    if (_req_hdr_init(&fwd, buf, GCOAP_PDU_BUF_SIZE, coap_get_code_raw(pdu)) < 0) {
+        return COAP_CODE_INTERNAL_SERVER_ERROR;
+    }
+    coap_hdr_set_type(fwd.hdr, COAP_TYPE_CON);
+
+    ssize_t res = 0;
+    strcpy(uri, path);
+    char *query = strchr(uri, '?');
+    if (query) {
+        *query++ = '\0';
+    }
+    if (stale && stale->etag_len) {
+        res = coap_opt_add_opaque(&fwd, COAP_OPT_ETAG, stale->etag,
+                                  stale->etag_len);
+    }
+    if (res >= 0) {
+        res = coap_opt_add_string(&fwd, COAP_OPT_URI_PATH, uri, '/');
+    }
+    if ((res >= 0) && pdu->payload_len && (format != COAP_FORMAT_NONE)) {
+        res = coap_opt_add_uint(&fwd, COAP_OPT_CONTENT_FORMAT, format);
+    }
+    if ((res >= 0) && query) {
+        res = coap_opt_add_string(&fwd, COAP_OPT_URI_QUERY, query, '&');
+    }
+    if (res < 0) {
+        DEBUG("gcoap: too many options to proxy\n");
+        return COAP_CODE_REQUEST_ENTITY_TOO_LARGE;
+    }
+    size_t len = coap_opt_finish(&fwd, pdu->payload_len
+                                       ? COAP_OPT_FINISH_PAYLOAD
+                                       : COAP_OPT_FINISH_NONE);
+    memcpy(fwd.payload, pdu->payload, pdu->payload_len);
+    len += pdu->payload_len;
+
+    if (gcoap_req_send2(buf, len, ep, _proxy_resp_handler) == 0) {
+        return COAP_CODE_BAD_GATEWAY;
+    }
+    memcpy(&req->ep, ep, sizeof(sock_udp_ep_t));
+    strcpy(req->path, path);
+    memcpy(req->token, coap_hdr_data_ptr(fwd.hdr), GCOAP_TOKENLEN);
+    req->method        = coap_get_code_raw(pdu);
+    req->waiters_numof = 0;
+    *req_ptr = req;
+    return 0;
+}
+
+/*
+ * Handles a request with Proxy-Uri or Proxy-Scheme option. Answers a GET from
+ * the cache if possible, waits for an identical GET forwarded before, or
+ * forwards the request to the server. Acknowledges a confirmable request that
+ * is not answered right away.
+ *
+ * return length of the response, empty ACK or error response to send, or 0 if
+ *        nothing to send
+ */
+static size_t _proxy_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                         sock_udp_ep_t *remote)
+{
+    sock_udp_ep_t ep;
+    char path[GCOAP_PROXY_PATH_MAX];
+    gcoap_proxy_entry_t *entry;
+    gcoap_proxy_req_t *req = NULL;
+    uint8_t *etag, *block;
+    ssize_t etag_len = coap_opt_get_opaque(pdu, COAP_OPT_ETAG, &etag);
+    uint32_t now = _proxy_now();
+
+    /* observing and block-wise transfers are not proxied */
+    coap_clear_observe(pdu);
+    if ((coap_opt_get_opaque(pdu, COAP_OPT_BLOCK1, &block) >= 0)
+            || (_proxy_target(pdu, &ep, path) < 0)) {
+        DEBUG("gcoap: can't proxy request\n");
+        return gcoap_response(pdu, buf, len, COAP_CODE_PROXYING_NOT_SUPPORTED);
+    }
+    if ((etag_len < 0) || (etag_len > GCOAP_PROXY_ETAG_MAX)) {
+        etag_len = 0;
+    }
+
+    entry = _proxy_cache_find(&ep, path);
+    if (coap_get_code_raw(pdu) == COAP_METHOD_GET) {
+        if (entry && ((int32_t)(entry->expires - now) > 0)) {
+            DEBUG("gcoap: proxy cache hit for %s\n", path);
+            gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+            return _proxy_cache_resp(pdu, entry, etag, etag_len, now);
+        }
+        req = _proxy_req_find(&ep, path);
+    }
+    else if (entry) {
+        /* other methods may change the resource */
+        entry->ep.family = AF_UNSPEC;
+        entry = NULL;
+    }
+
+    if (req == NULL) {
+        unsigned code = _proxy_forward(pdu, &ep, path, entry, &req);
+        if (code) {
+            return gcoap_response(pdu, buf, len, code);
+        }
+    }
+
+    /* a resent request is already waiting */
+    gcoap_proxy_waiter_t *waiter = NULL;
+    for (unsigned i = 0; i < req->waiters_numof; i++) {
+        gcoap_proxy_waiter_t *cur = &req->waiters[i];
+        if (sock_udp_ep_equal(&cur->ep, remote)
+                && (cur->token_len == coap_get_token_len(pdu))
+                && (memcmp(cur->token, pdu->token, cur->token_len) == 0)) {
+            waiter = cur;
+            break;
+        }
+    }
+    if (waiter == NULL) {
+        if (req->waiters_numof == GCOAP_PROXY_WAITERS_MAX) {
+            DEBUG("gcoap: too many clients waiting for proxied request\n");
+            return gcoap_response(pdu, buf, len, COAP_CODE_SERVICE_UNAVAILABLE);
+        }
+        waiter = &req->waiters[req->waiters_numof++];
+        memcpy(&waiter->ep, remote, sizeof(sock_udp_ep_t));
+        waiter->token_len = coap_get_token_len(pdu);
+        memcpy(waiter->token, pdu->token, waiter->token_len);
+        waiter->etag_len = etag_len;
+        memcpy(waiter->etag, etag, etag_len);
+    }
+
+    if (coap_get_type(pdu) == COAP_TYPE_CON) {
+        return coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_ACK, NULL, 0,
+                              COAP_CODE_EMPTY, coap_get_id(pdu));
+    }
+    return 0;
+}
+#endif
+
+/*
+ * gcoap interface functions
+ */
+
+kernel_pid_t gcoap_init(void)
+{
+    if (_pid != KERNEL_PID_UNDEF) {
+        return -EEXIST;
+    }
+    _pid = thread_create(_msg_stack, sizeof(_msg_stack), THREAD_PRIORITY_MAIN - 1,
+                            THREAD_CREATE_STACKTEST, _event_loop, NULL, "coap");
 
     mutex_init(&_coap_state.lock);
     /* Blank lists so we know if an entry is available. */
     memset(&_coap_state.open_reqs[0], 0, sizeof(_coap_state.open_reqs));
     memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
     memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
+    memset(&_coap_state.obs_resources[0], 0, sizeof(_coap_state.obs_resources));
     memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
+    memset(&_coap_state.nstart[0], 0, sizeof(_coap_state.nstart));
+#ifdef MODULE_GCOAP_DEDUP
+    memset(&_coap_state.dedup[0], 0, sizeof(_coap_state.dedup));
+#endif
+#ifdef MODULE_GCOAP_PROXY
+    memset(&_coap_state.proxy_cache[0], 0, sizeof(_coap_state.proxy_cache));
+    memset(&_coap_state.proxy_reqs[0], 0, sizeof(_coap_state.proxy_reqs));
+#endif
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+    _index_listener(&_default_listener);
+#endif
+#ifdef MODULE_GCOAP_WORKER
+    _worker_init();
+#endif
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
 
@@ -640,13 +1983,79 @@ void gcoap_register_listener(gcoap_listener_t *listener)
 
     listener->next = NULL;
     _last->next = listener;
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+    _index_listener(listener);
+#endif
 }
 
-int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
-                   unsigned code, const char *path)
+void gcoap_req_memo_pool_add(gcoap_req_memo_pool_t *pool)
 {
-    assert((path != NULL) && (path[0] == '/'));
+    assert(pool != NULL);
+
+    memset(pool->memos, 0, pool->memos_numof * sizeof(gcoap_request_memo_t));
+    if (pool->resend_bufs) {
+        memset(pool->resend_bufs, 0, pool->resend_bufs_numof * GCOAP_PDU_BUF_SIZE);
+    }
+    else {
+        pool->resend_bufs_numof = 0;
+    }
+    pool->next = NULL;
+
+    /* Add the pool to the end of the linked list. */
+    mutex_lock(&_coap_state.lock);
+    gcoap_req_memo_pool_t *_last = &_default_memo_pool;
+    while (_last->next) {
+        _last = _last->next;
+    }
+    _last->next = pool;
+    mutex_unlock(&_coap_state.lock);
+}
+
+int gcoap_nstart_set(const sock_udp_ep_t *remote, unsigned nstart)
+{
+    gcoap_nstart_t *entry = NULL;
+    int res = 0;
+
+    assert(remote != NULL);
+
+    mutex_lock(&_coap_state.lock);
+    for (unsigned i = 0; i < GCOAP_NSTART_ENDPOINTS_MAX; i++) {
+        gcoap_nstart_t *cur = &_coap_state.nstart[i];
+        if (cur->ep.family == AF_UNSPEC) {
+            entry = entry ? entry : cur;
+        }
+        else if (sock_udp_ep_equal(&cur->ep, remote)) {
+            entry = cur;
+            break;
+        }
+    }
+    if (nstart == GCOAP_NSTART) {
+        /* default applies without an entry */
+        if (entry) {
+            entry->ep.family = AF_UNSPEC;
+        }
+    }
+    else if (entry) {
+        memcpy(&entry->ep, remote, sizeof(sock_udp_ep_t));
+        entry->nstart = nstart;
+    }
+    else {
+        res = -ENOMEM;
+    }
+    mutex_unlock(&_coap_state.lock);
+
+    return res;
+}
 
+/*
+ * Writes the header of a non-confirmable request with a new message ID and
+ * token, and prepares the PDU for options.
+ *
+ * return 0 on success, -1 on failure
+ */
+static int _req_hdr_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                         unsigned code)
+{
     pdu->hdr = (coap_hdr_t *)buf;
 
     /* generate token */
@@ -669,7 +2078,6 @@ int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 
     if (hdrlen > 0) {
         coap_pkt_init(pdu, buf, len - GCOAP_REQ_OPTIONS_BUF, hdrlen);
-        coap_opt_add_string(pdu, COAP_OPT_URI_PATH, path, '/');
         return 0;
     }
     else {
@@ -678,6 +2086,18 @@ int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     }
 }
 
+int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                   unsigned code, const char *path)
+{
+    assert((path != NULL) && (path[0] == '/'));
+
+    if (_req_hdr_init(pdu, buf, len, code) < 0) {
+        return -1;
+    }
+    coap_opt_add_string(pdu, COAP_OPT_URI_PATH, path, '/');
+    return 0;
+}
+
 /*
  * Assumes pdu.payload_len attribute was reduced in gcoap_xxx_init() to
  * ensure enough space in PDU buffer to write Content-Format option and
@@ -734,6 +2154,36 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len, const ipv6_addr_t *addr,
 size_t gcoap_req_send2(const uint8_t *buf, size_t len,
                        const sock_udp_ep_t *remote,
                        gcoap_resp_handler_t resp_handler)
+{
+    return _req_send(buf, len, remote, resp_handler, NULL);
+}
+
+#ifdef MODULE_GCOAP_OSCORE
+size_t gcoap_req_send_oscore(uint8_t *buf, size_t len, size_t buf_len,
+                             const sock_udp_ep_t *remote,
+                             gcoap_resp_handler_t resp_handler,
+                             gcoap_oscore_ctx_t *ctx)
+{
+    gcoap_oscore_req_t oscore = { .ctx = ctx };
+    ssize_t res = gcoap_oscore_protect(buf, len, buf_len, &oscore, true);
+
+    if (res < 0) {
+        DEBUG("gcoap: protecting request failed: %d\n", (int)res);
+        return 0;
+    }
+    return _req_send(buf, res, remote, resp_handler, &oscore);
+}
+#endif
+
+/*
+ * Sends a request and tracks its response.
+ *
+ * oscore[in] -- Protection of the request, NULL if not protected
+ */
+static size_t _req_send(const uint8_t *buf, size_t len,
+                        const sock_udp_ep_t *remote,
+                        gcoap_resp_handler_t resp_handler,
+                        const gcoap_oscore_req_t *oscore)
 {
     gcoap_request_memo_t *memo = NULL;
     unsigned msg_type  = (*buf & 0x30) >> 4;
@@ -744,16 +2194,20 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
     /* Only allocate memory if necessary (i.e. if user is interested in the
      * response or request is confirmable) */
     if ((resp_handler != NULL) || (msg_type == COAP_TYPE_CON)) {
+        uint8_t *resend_buf = NULL;
+
         mutex_lock(&_coap_state.lock);
+        if (!_nstart_ok(remote)) {
+            mutex_unlock(&_coap_state.lock);
+            DEBUG("gcoap: dropping request; too many outstanding to endpoint\n");
+            return 0;
+        }
         /* Find empty slot in list of open requests. */
-        for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-            if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
-                memo = &_coap_state.open_reqs[i];
-                memo->state = GCOAP_MEMO_WAIT;
-                break;
-            }
+        memo = _alloc_req_memo((msg_type == COAP_TYPE_CON) ? &resend_buf : NULL);
+        if (memo) {
+            memo->state = GCOAP_MEMO_WAIT;
         }
-        if (!memo) {
+        else {
             mutex_unlock(&_coap_state.lock);
             DEBUG("gcoap: dropping request; no space for response tracking\n");
             return 0;
@@ -761,20 +2215,22 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
 
         memo->resp_handler = resp_handler;
         memcpy(&memo->remote_ep, remote, sizeof(sock_udp_ep_t));
+#ifdef MODULE_GCOAP_OSCORE
+        memo->oscore.ctx = NULL;
+        if (oscore) {
+            memo->oscore = *oscore;
+        }
+#else
+        (void)oscore;
+#endif
 
         switch (msg_type) {
         case COAP_TYPE_CON:
             /* copy buf to resend_bufs record */
-            memo->msg.data.pdu_buf = NULL;
-            for (int i = 0; i < GCOAP_RESEND_BUFS_MAX; i++) {
-                if (!_coap_state.resend_bufs[i][0]) {
-                    memo->msg.data.pdu_buf = &_coap_state.resend_bufs[i][0];
-                    memcpy(memo->msg.data.pdu_buf, buf, GCOAP_PDU_BUF_SIZE);
-                    memo->msg.data.pdu_len = len;
-                    break;
-                }
-            }
+            memo->msg.data.pdu_buf = resend_buf;
             if (memo->msg.data.pdu_buf) {
+                memcpy(memo->msg.data.pdu_buf, buf, GCOAP_PDU_BUF_SIZE);
+                memo->msg.data.pdu_len = len;
                 memo->send_limit  = COAP_MAX_RETRANSMIT;
                 timeout           = (uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC;
                 uint32_t variance = (uint32_t)COAP_ACK_VARIANCE * US_PER_SEC;
@@ -811,8 +2267,8 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
          * gcoap's. First, put a message in the mbox for the sock udp object,
          * which will interrupt listening on the gcoap thread. (When there are
          * no outstanding requests, gcoap blocks indefinitely in _listen() at
-         * sock_udp_recv().) While the message sent here is outstanding, the
-         * sock_udp_recv() call will be set to a short timeout so the request
+         * sock_udp_recv_buf().) While the message sent here is outstanding, the
+         * sock_udp_recv_buf() call will be set to a short timeout so the request
          * timer below, also on the gcoap thread, is processed in a timely
          * manner. */
         msg_t mbox_msg;
@@ -843,6 +2299,13 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
 
 int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
 {
+    if ((uint8_t *)pdu->hdr != buf) {
+        /* request was parsed in the packet buffer of the stack; start the
+         * response from a copy of its header */
+        memcpy(buf, pdu->hdr, coap_get_total_hdr_len(pdu));
+        pdu->hdr   = (coap_hdr_t *)buf;
+        pdu->token = coap_hdr_data_ptr(pdu->hdr);
+    }
     if (coap_get_type(pdu) == COAP_TYPE_CON) {
         coap_hdr_set_type(pdu->hdr, COAP_TYPE_ACK);
     }
@@ -869,8 +2332,10 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 {
     gcoap_observe_memo_t *memo = NULL;
 
+    mutex_lock(&_coap_state.lock);
     _find_obs_memo_resource(&memo, resource);
     if (memo == NULL) {
+        mutex_unlock(&_coap_state.lock);
         /* Unique return value to specify there is not an observer */
         return GCOAP_OBS_INIT_UNUSED;
     }
@@ -879,6 +2344,7 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     uint16_t msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
     ssize_t hdrlen = coap_build_hdr(pdu->hdr, COAP_TYPE_NON, &memo->token[0],
                                     memo->token_len, COAP_CODE_CONTENT, msgid);
+    mutex_unlock(&_coap_state.lock);
 
     if (hdrlen > 0) {
         coap_pkt_init(pdu, buf, len - GCOAP_OBS_OPTIONS_BUF, hdrlen);
@@ -898,25 +2364,64 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 size_t gcoap_obs_send(const uint8_t *buf, size_t len,
                       const coap_resource_t *resource)
 {
-    gcoap_observe_memo_t *memo = NULL;
-
-    _find_obs_memo_resource(&memo, resource);
+    const coap_hdr_t *hdr = (const coap_hdr_t *)buf;
+    size_t sent = 0;
 
-    if (memo) {
-        ssize_t bytes = sock_udp_send(&_sock, buf, len, memo->observer);
-        return (size_t)((bytes > 0) ? bytes : 0);
+    if ((len < sizeof(coap_hdr_t)) || (len > GCOAP_PDU_BUF_SIZE)) {
+        return 0;
     }
-    else {
+    size_t hdr_len = sizeof(coap_hdr_t) + (hdr->ver_t_tkl & 0xf);
+    if (hdr_len > len) {
         return 0;
     }
+
+    mutex_lock(&_coap_state.lock);
+    gcoap_observe_memo_t *memo = NULL;
+    _find_obs_memo_resource(&memo, resource);
+
+    /* Copy options and payload once, behind room for the longest header.
+     * Only header and token are written for each observer. */
+    uint8_t *body = &_coap_state.obs_buf[GCOAP_HEADER_MAXLEN];
+    memcpy(body, buf + hdr_len, len - hdr_len);
+
+    uint32_t now = xtimer_now_usec();
+    while (memo) {
+        /* pacing may remove the registration */
+        gcoap_observe_memo_t *next = memo->next;
+        gcoap_observer_t *obs = container_of(memo->observer, gcoap_observer_t, ep);
+        int type = _obs_pace(obs, now);
+
+        if (type >= 0) {
+            uint8_t *start  = body - sizeof(coap_hdr_t) - memo->token_len;
+            uint16_t msgid  = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
+            ssize_t pdu_len = coap_build_hdr((coap_hdr_t *)start, type, &memo->token[0],
+                                             memo->token_len, hdr->code, msgid);
+            obs->msgid = msgid;
+            pdu_len += len - hdr_len;
+
+            ssize_t bytes = sock_udp_send(&_sock, start, pdu_len, &obs->ep);
+            if (bytes > 0) {
+                sent = len;
+            }
+            else {
+                DEBUG("gcoap: sock notification failed: %d\n", (int)bytes);
+            }
+        }
+        memo = next;
+    }
+    mutex_unlock(&_coap_state.lock);
+
+    return sent;
 }
 
 uint8_t gcoap_op_state(void)
 {
     uint8_t count = 0;
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state != GCOAP_MEMO_UNUSED) {
-            count++;
+    for (gcoap_req_memo_pool_t *pool = &_default_memo_pool; pool; pool = pool->next) {
+        for (size_t i = 0; i < pool->memos_numof; i++) {
+            if (pool->memos[i].state != GCOAP_MEMO_UNUSED) {
+                count++;
+            }
         }
     }
     return count;
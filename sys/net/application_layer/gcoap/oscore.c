@@ -0,0 +1,645 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gcoap_oscore
+ * @{
+ *
+ * @file
+ * @brief       OSCORE with in-place AES-CCM over the PDU buffer
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "crypto/aes.h"
+#include "crypto/modes/ccm.h"
+#include "hashes/sha256.h"
+#include "mutex.h"
+#include "net/gcoap/oscore.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALG_AES_CCM_16_64_128  (10U)   /* COSE algorithm identifier */
+#define _KEY_LEN                (16U)
+#define _CCM_LENGTH_ENC         (15U - GCOAP_OSCORE_NONCE_LEN)
+#define _SEQ_MAX                ((1ULL << (8 * GCOAP_OSCORE_PIV_MAX)) - 1)
+#define _REPLAY_WINDOW          (32U)
+
+/* OSCORE option flags */
+#define _FLAG_N_MASK            (0x07U) /* length of the Partial IV */
+#define _FLAG_K                 (0x08U) /* key ID present */
+#define _FLAG_H                 (0x10U) /* key ID context present */
+#define _FLAG_RESERVED          (0xe0U)
+
+#define _PAYLOAD_MARKER         (0xffU)
+
+/* AAD: Enc_structure with the external AAD, up to 5 + 7 + 5 CBOR bytes */
+#define _AAD_MAX                (32U)
+
+/* outer option of a message, staged while the buffer is rearranged */
+typedef struct {
+    uint16_t num;
+    uint16_t len;
+    const uint8_t *val;
+} _opt_t;
+
+static gcoap_oscore_ctx_t *_ctxs;
+static mutex_t _lock = MUTEX_INIT;
+
+static bool _is_outer(unsigned num)
+{
+    switch (num) {
+        case COAP_OPT_URI_HOST:
+        case COAP_OPT_OBSERVE:
+        case COAP_OPT_URI_PORT:
+        case COAP_OPT_OSCORE:
+        case COAP_OPT_PROXY_URI:
+        case COAP_OPT_PROXY_SCHEME:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* HKDF-SHA-256 (RFC 5869) expanding to at most one hash, with the info of
+ * RFC 8613, section 3.2.1: [id, null, alg, type, L] */
+static void _derive(uint8_t *out, size_t out_len, const uint8_t *prk,
+                    const uint8_t *id, size_t id_len, const char *type)
+{
+    hmac_context_t hmac;
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    uint8_t info[4 + GCOAP_OSCORE_ID_MAX + 6];
+    size_t type_len = strlen(type);
+    size_t pos = 0;
+
+    info[pos++] = 0x85;                     /* array of 5 */
+    info[pos++] = 0x40 | id_len;            /* bstr */
+    memcpy(&info[pos], id, id_len);
+    pos += id_len;
+    info[pos++] = 0xf6;                     /* null */
+    info[pos++] = _ALG_AES_CCM_16_64_128;
+    info[pos++] = 0x60 | type_len;          /* tstr */
+    memcpy(&info[pos], type, type_len);
+    pos += type_len;
+    info[pos++] = out_len;
+
+    hmac_sha256_init(&hmac, prk, SHA256_DIGEST_LENGTH);
+    hmac_sha256_update(&hmac, info, pos);
+    hmac_sha256_update(&hmac, "\x01", 1);
+    hmac_sha256_final(&hmac, digest);
+    memcpy(out, digest, out_len);
+    memset(digest, 0, sizeof(digest));
+}
+
+int gcoap_oscore_ctx_init(gcoap_oscore_ctx_t *ctx,
+                          const uint8_t *secret, size_t secret_len,
+                          const uint8_t *salt, size_t salt_len,
+                          const uint8_t *sender_id, size_t sender_id_len,
+                          const uint8_t *recipient_id, size_t recipient_id_len)
+{
+    hmac_context_t hmac;
+    uint8_t prk[SHA256_DIGEST_LENGTH];
+    uint8_t key[_KEY_LEN];
+    int res = 0;
+
+    if ((sender_id_len > GCOAP_OSCORE_ID_MAX) ||
+        (recipient_id_len > GCOAP_OSCORE_ID_MAX)) {
+        return -EINVAL;
+    }
+    memset(ctx, 0, sizeof(*ctx));
+    memcpy(ctx->sender_id, sender_id, sender_id_len);
+    ctx->sender_id_len = sender_id_len;
+    memcpy(ctx->recipient_id, recipient_id, recipient_id_len);
+    ctx->recipient_id_len = recipient_id_len;
+
+    /* an empty salt is a hash length of zeros for HMAC */
+    hmac_sha256_init(&hmac, salt, salt_len);
+    hmac_sha256_update(&hmac, secret, secret_len);
+    hmac_sha256_final(&hmac, prk);
+
+    _derive(key, sizeof(key), prk, sender_id, sender_id_len, "Key");
+    if (cipher_init(&ctx->sender, CIPHER_AES_128, key,
+                    sizeof(key)) != CIPHER_INIT_SUCCESS) {
+        res = -ENOTSUP;
+    }
+    _derive(key, sizeof(key), prk, recipient_id, recipient_id_len, "Key");
+    if (cipher_init(&ctx->recipient, CIPHER_AES_128, key,
+                    sizeof(key)) != CIPHER_INIT_SUCCESS) {
+        res = -ENOTSUP;
+    }
+    _derive(ctx->common_iv, sizeof(ctx->common_iv), prk, NULL, 0, "IV");
+
+    memset(key, 0, sizeof(key));
+    memset(prk, 0, sizeof(prk));
+    return res;
+}
+
+void gcoap_oscore_ctx_register(gcoap_oscore_ctx_t *ctx)
+{
+    mutex_lock(&_lock);
+    for (gcoap_oscore_ctx_t *c = _ctxs; c; c = c->next) {
+        if (c == ctx) {
+            mutex_unlock(&_lock);
+            return;
+        }
+    }
+    ctx->next = _ctxs;
+    _ctxs = ctx;
+    mutex_unlock(&_lock);
+}
+
+gcoap_oscore_ctx_t *gcoap_oscore_ctx_find(const uint8_t *kid, size_t kid_len)
+{
+    gcoap_oscore_ctx_t *ctx;
+
+    mutex_lock(&_lock);
+    for (ctx = _ctxs; ctx; ctx = ctx->next) {
+        if ((ctx->recipient_id_len == kid_len) &&
+            (memcmp(ctx->recipient_id, kid, kid_len) == 0)) {
+            break;
+        }
+    }
+    mutex_unlock(&_lock);
+    return ctx;
+}
+
+/* Checks the sequence number of a verified request against the replay
+ * window and adds it (RFC 8613, section 7.4) */
+static bool _replay_accept(gcoap_oscore_ctx_t *ctx, uint64_t seq)
+{
+    bool accept = true;
+
+    mutex_lock(&_lock);
+    if (!ctx->replay_valid || (seq > ctx->replay_max)) {
+        uint64_t shift = (ctx->replay_valid) ? (seq - ctx->replay_max)
+                                             : _REPLAY_WINDOW;
+
+        ctx->replay_window = (shift < _REPLAY_WINDOW)
+                             ? (ctx->replay_window << shift) : 0;
+        ctx->replay_window |= 1;
+        ctx->replay_max = seq;
+        ctx->replay_valid = true;
+    }
+    else if (((ctx->replay_max - seq) >= _REPLAY_WINDOW) ||
+             (ctx->replay_window & (1UL << (ctx->replay_max - seq)))) {
+        accept = false;
+    }
+    else {
+        ctx->replay_window |= 1UL << (ctx->replay_max - seq);
+    }
+    mutex_unlock(&_lock);
+    return accept;
+}
+
+/* nonce of RFC 8613, section 5.2: the ID and the Partial IV, padded, XOR
+ * the common IV */
+static void _nonce(uint8_t *nonce, const gcoap_oscore_ctx_t *ctx,
+                   const uint8_t *id, size_t id_len,
+                   const uint8_t *piv, size_t piv_len)
+{
+    memset(nonce, 0, GCOAP_OSCORE_NONCE_LEN);
+    nonce[0] = id_len;
+    memcpy(&nonce[1 + GCOAP_OSCORE_ID_MAX - id_len], id, id_len);
+    memcpy(&nonce[GCOAP_OSCORE_NONCE_LEN - piv_len], piv, piv_len);
+    for (unsigned i = 0; i < GCOAP_OSCORE_NONCE_LEN; i++) {
+        nonce[i] ^= ctx->common_iv[i];
+    }
+}
+
+/* Enc_structure ["Encrypt0", h'', external_aad] with the external AAD
+ * [1, [alg], request_kid, request_piv, h''] of RFC 8613, section 5.4 */
+static size_t _aad(uint8_t *aad, const uint8_t *kid, size_t kid_len,
+                   const uint8_t *piv, size_t piv_len)
+{
+    static const uint8_t head[] = {
+        0x83, 0x68, 'E', 'n', 'c', 'r', 'y', 'p', 't', '0', 0x40
+    };
+    size_t pos = sizeof(head);
+
+    memcpy(aad, head, sizeof(head));
+    aad[pos++] = 0x40 | (7 + kid_len + piv_len);
+    aad[pos++] = 0x85;
+    aad[pos++] = 0x01;
+    aad[pos++] = 0x81;
+    aad[pos++] = _ALG_AES_CCM_16_64_128;
+    aad[pos++] = 0x40 | kid_len;
+    memcpy(&aad[pos], kid, kid_len);
+    pos += kid_len;
+    aad[pos++] = 0x40 | piv_len;
+    memcpy(&aad[pos], piv, piv_len);
+    pos += piv_len;
+    aad[pos++] = 0x40;
+    return pos;
+}
+
+/* Runs AES-CCM over data in place, tag behind it */
+static int _ccm(cipher_t *cipher, bool encrypt, const uint8_t *nonce,
+                uint8_t *aad, size_t aad_len, uint8_t *data, size_t len)
+{
+    ccm_context_t ccm;
+    iolist_t ad = { .iol_next = NULL, .iol_base = aad, .iol_len = aad_len };
+    int res = cipher_ccm_init(&ccm, cipher, &ad, GCOAP_OSCORE_TAG_LEN,
+                              _CCM_LENGTH_ENC, nonce, GCOAP_OSCORE_NONCE_LEN,
+                              len);
+
+    if (res < 0) {
+        return res;
+    }
+    if (encrypt) {
+        res = cipher_ccm_encrypt_update(&ccm, data, len, data);
+        return (res < 0) ? res : cipher_ccm_encrypt_finish(&ccm, data + len);
+    }
+    res = cipher_ccm_decrypt_update(&ccm, data, len, data);
+    return (res < 0) ? res : cipher_ccm_decrypt_finish(&ccm, data + len);
+}
+
+static size_t _ext_len(unsigned val)
+{
+    return (val < 13) ? 0 : ((val < 269) ? 1 : 2);
+}
+
+static size_t _opt_len(unsigned delta, size_t len)
+{
+    return 1 + _ext_len(delta) + _ext_len(len) + len;
+}
+
+static unsigned _put_ext(uint8_t **pos, unsigned val)
+{
+    if (val < 13) {
+        return val;
+    }
+    if (val < 269) {
+        *(*pos)++ = val - 13;
+        return 13;
+    }
+    val -= 269;
+    *(*pos)++ = val >> 8;
+    *(*pos)++ = val & 0xff;
+    return 14;
+}
+
+/* Writes an option; the value is moved first, so it may overlap buf */
+static size_t _put_opt(uint8_t *buf, unsigned delta, const uint8_t *val,
+                       size_t len)
+{
+    size_t opt_len = _opt_len(delta, len);
+    uint8_t *pos = buf + 1;
+
+    memmove(buf + opt_len - len, val, len);
+    buf[0] = _put_ext(&pos, delta) << 4;
+    buf[0] |= _put_ext(&pos, len);
+    return opt_len;
+}
+
+static int _get_ext(unsigned nibble, const uint8_t **pos, const uint8_t *end)
+{
+    int val = nibble;
+
+    if (nibble == 13) {
+        if (*pos >= end) {
+            return -1;
+        }
+        val = 13 + *(*pos)++;
+    }
+    else if (nibble == 14) {
+        if ((*pos + 1) >= end) {
+            return -1;
+        }
+        val = 269 + (((*pos)[0] << 8) | (*pos)[1]);
+        *pos += 2;
+    }
+    else if (nibble == 15) {
+        return -1;
+    }
+    return val;
+}
+
+/* Parses the next option at pos; returns 1 for an option, 0 at the payload
+ * marker or the end, -1 if malformed */
+static int _next_opt(const uint8_t **pos, const uint8_t *end, _opt_t *opt)
+{
+    if ((*pos >= end) || (**pos == _PAYLOAD_MARKER)) {
+        return 0;
+    }
+
+    uint8_t byte = *(*pos)++;
+    int delta = _get_ext(byte >> 4, pos, end);
+    int len = _get_ext(byte & 0xf, pos, end);
+
+    if ((delta < 0) || (len < 0) || ((end - *pos) < len)) {
+        return -1;
+    }
+    opt->num += delta;
+    opt->len = len;
+    opt->val = *pos;
+    *pos += len;
+    return 1;
+}
+
+/* Encodes the Partial IV of a sequence number, at least one byte */
+static size_t _piv_put(uint8_t *piv, uint64_t seq)
+{
+    size_t len = 1;
+
+    while ((len < GCOAP_OSCORE_PIV_MAX) && (seq >> (8 * len))) {
+        len++;
+    }
+    for (size_t i = 0; i < len; i++) {
+        piv[len - 1 - i] = seq >> (8 * i);
+    }
+    return len;
+}
+
+ssize_t gcoap_oscore_protect(uint8_t *buf, size_t len, size_t buf_len,
+                             gcoap_oscore_req_t *req, bool request)
+{
+    coap_pkt_t pkt;
+    gcoap_oscore_ctx_t *ctx = req->ctx;
+    uint8_t outer[GCOAP_OSCORE_OUTER_MAX];
+    uint8_t oscore[1 + GCOAP_OSCORE_PIV_MAX + GCOAP_OSCORE_ID_MAX];
+    uint8_t nonce[GCOAP_OSCORE_NONCE_LEN];
+    uint8_t aad[_AAD_MAX];
+    size_t oscore_len = 0, outer_len = 0, inner_len = 1;
+    unsigned outer_prev = 0, inner_prev = 0;
+    const uint8_t *kid;
+    size_t kid_len;
+
+    if ((coap_parse(&pkt, buf, len) < 0) ||
+        (coap_get_code_raw(&pkt) == COAP_CODE_EMPTY)) {
+        return -EBADMSG;
+    }
+    if (request) {
+        mutex_lock(&_lock);
+        uint64_t seq = ctx->sender_seq;
+        if (seq <= _SEQ_MAX) {
+            ctx->sender_seq++;
+        }
+        mutex_unlock(&_lock);
+        if (seq > _SEQ_MAX) {
+            return -EOVERFLOW;
+        }
+        req->piv_len = _piv_put(req->piv, seq);
+        oscore[oscore_len++] = _FLAG_K | req->piv_len;
+        memcpy(&oscore[oscore_len], req->piv, req->piv_len);
+        oscore_len += req->piv_len;
+        memcpy(&oscore[oscore_len], ctx->sender_id, ctx->sender_id_len);
+        oscore_len += ctx->sender_id_len;
+        kid = ctx->sender_id;
+        kid_len = ctx->sender_id_len;
+    }
+    else {
+        kid = ctx->recipient_id;
+        kid_len = ctx->recipient_id_len;
+    }
+
+    /* encode the outer options with the OSCORE option into the scratch
+     * buffer, size up the inner ones */
+    bool oscore_put = false;
+    for (unsigned i = 0; i <= pkt.options_len; i++) {
+        const coap_optpos_t *opt = &pkt.options[i];
+        unsigned num = (i < pkt.options_len) ? opt->opt_num : UINT16_MAX;
+
+        if (num == COAP_OPT_OSCORE) {
+            return -EBADMSG;
+        }
+        if (!oscore_put && (num > COAP_OPT_OSCORE)) {
+            size_t n = _opt_len(COAP_OPT_OSCORE - outer_prev, oscore_len);
+            if ((outer_len + n) > sizeof(outer)) {
+                return -ENOBUFS;
+            }
+            outer_len += _put_opt(&outer[outer_len], COAP_OPT_OSCORE - outer_prev,
+                                  oscore, oscore_len);
+            outer_prev = COAP_OPT_OSCORE;
+            oscore_put = true;
+        }
+        if (i == pkt.options_len) {
+            break;
+        }
+        if (_is_outer(num)) {
+            size_t n = _opt_len(num - outer_prev, opt->len);
+            if ((outer_len + n) > sizeof(outer)) {
+                return -ENOBUFS;
+            }
+            outer_len += _put_opt(&outer[outer_len], num - outer_prev,
+                                  buf + opt->offset, opt->len);
+            outer_prev = num;
+        }
+        else {
+            inner_len += _opt_len(num - inner_prev, opt->len);
+            inner_prev = num;
+        }
+    }
+
+    size_t payload_len = pkt.payload_len;
+    size_t plain_len = inner_len + ((payload_len) ? 1 + payload_len : 0);
+    size_t hdr_len = coap_get_total_hdr_len(&pkt);
+    uint8_t *plain = buf + hdr_len + outer_len + 1;
+
+    if ((size_t)(plain - buf) + plain_len + GCOAP_OSCORE_TAG_LEN > buf_len) {
+        return -ENOBUFS;
+    }
+
+    /* The plaintext only grows by the encoded outer options, so moving the
+     * payload and then the inner options back to front towards the end never
+     * overwrites what is still to be moved. */
+    if (payload_len) {
+        memmove(plain + inner_len + 1, pkt.payload, payload_len);
+        plain[inner_len] = _PAYLOAD_MARKER;
+    }
+    size_t end = inner_len;
+    for (int i = pkt.options_len - 1; i >= 0; i--) {
+        const coap_optpos_t *opt = &pkt.options[i];
+        unsigned prev = 0;
+
+        if (_is_outer(opt->opt_num)) {
+            continue;
+        }
+        for (int j = i - 1; j >= 0; j--) {
+            if (!_is_outer(pkt.options[j].opt_num)) {
+                prev = pkt.options[j].opt_num;
+                break;
+            }
+        }
+        end -= _opt_len(opt->opt_num - prev, opt->len);
+        _put_opt(plain + end, opt->opt_num - prev, buf + opt->offset, opt->len);
+    }
+    plain[0] = coap_get_code_raw(&pkt);
+    memcpy(buf + hdr_len, outer, outer_len);
+    plain[-1] = _PAYLOAD_MARKER;
+    pkt.hdr->code = (request) ? COAP_METHOD_POST : COAP_CODE_CHANGED;
+
+    _nonce(nonce, ctx, kid, kid_len, req->piv, req->piv_len);
+    size_t aad_len = _aad(aad, kid, kid_len, req->piv, req->piv_len);
+    int res = _ccm(&ctx->sender, true, nonce, aad, aad_len, plain, plain_len);
+    if (res < 0) {
+        DEBUG("oscore: encryption failed: %d\n", res);
+        return -EBADMSG;
+    }
+    return (plain - buf) + plain_len + GCOAP_OSCORE_TAG_LEN;
+}
+
+ssize_t gcoap_oscore_unprotect(coap_pkt_t *pdu, gcoap_oscore_req_t *req)
+{
+    uint8_t *buf = (uint8_t *)pdu->hdr;
+    const coap_optpos_t *oscore = NULL;
+    _opt_t outer[NANOCOAP_NOPTS_MAX];
+    uint8_t scratch[GCOAP_OSCORE_OUTER_MAX];
+    uint8_t nonce[GCOAP_OSCORE_NONCE_LEN];
+    uint8_t aad[_AAD_MAX];
+    unsigned outer_numof = 0;
+    size_t scratch_len = 0;
+    bool request = (coap_get_code_class(pdu) == COAP_CLASS_REQ);
+
+    for (unsigned i = 0; i < pdu->options_len; i++) {
+        if (pdu->options[i].opt_num == COAP_OPT_OSCORE) {
+            oscore = &pdu->options[i];
+            break;
+        }
+    }
+    if (oscore == NULL) {
+        return -ENOENT;
+    }
+
+    /* flags, Partial IV, key ID context and key ID */
+    const uint8_t *val = buf + oscore->offset;
+    const uint8_t *piv = NULL, *kid = NULL;
+    size_t piv_len = 0, kid_len = 0, pos = 1;
+    uint8_t flags = 0;
+
+    if (oscore->len) {
+        flags = val[0];
+        if ((flags & _FLAG_RESERVED) ||
+            ((flags & _FLAG_N_MASK) > GCOAP_OSCORE_PIV_MAX)) {
+            return -EBADMSG;
+        }
+        piv_len = flags & _FLAG_N_MASK;
+        piv = &val[pos];
+        pos += piv_len;
+        if (flags & _FLAG_H) {
+            if (pos >= oscore->len) {
+                return -EBADMSG;
+            }
+            pos += 1 + val[pos];
+        }
+        if (pos > oscore->len) {
+            return -EBADMSG;
+        }
+        if (flags & _FLAG_K) {
+            kid = &val[pos];
+            kid_len = oscore->len - pos;
+        }
+    }
+
+    gcoap_oscore_ctx_t *ctx;
+    uint64_t seq = 0;
+    if (request) {
+        if (!(flags & _FLAG_K) || (piv_len == 0)) {
+            return -EBADMSG;
+        }
+        ctx = gcoap_oscore_ctx_find(kid, kid_len);
+        if (ctx == NULL) {
+            DEBUG("oscore: no context for key ID\n");
+            return -EACCES;
+        }
+        for (size_t i = 0; i < piv_len; i++) {
+            seq = (seq << 8) | piv[i];
+        }
+        req->ctx = ctx;
+        memcpy(req->piv, piv, piv_len);
+        req->piv_len = piv_len;
+        _nonce(nonce, ctx, kid, kid_len, piv, piv_len);
+    }
+    else {
+        ctx = req->ctx;
+        kid = ctx->sender_id;
+        kid_len = ctx->sender_id_len;
+        if (piv_len) {
+            _nonce(nonce, ctx, ctx->recipient_id, ctx->recipient_id_len,
+                   piv, piv_len);
+        }
+        else {
+            _nonce(nonce, ctx, kid, kid_len, req->piv, req->piv_len);
+        }
+    }
+
+    if (pdu->payload_len <= GCOAP_OSCORE_TAG_LEN) {
+        return -EBADMSG;
+    }
+    size_t plain_len = pdu->payload_len - GCOAP_OSCORE_TAG_LEN;
+    uint8_t *plain = pdu->payload;
+    size_t aad_len = _aad(aad, kid, kid_len, req->piv, req->piv_len);
+    if (_ccm(&ctx->recipient, false, nonce, aad, aad_len, plain,
+             plain_len) < 0) {
+        DEBUG("oscore: decryption failed\n");
+        return -EBADMSG;
+    }
+    if (request && !_replay_accept(ctx, seq)) {
+        DEBUG("oscore: replayed request\n");
+        return -EALREADY;
+    }
+
+    /* stage the outer options but the OSCORE option */
+    for (unsigned i = 0; i < pdu->options_len; i++) {
+        const coap_optpos_t *opt = &pdu->options[i];
+
+        if (opt->opt_num == COAP_OPT_OSCORE) {
+            continue;
+        }
+        if ((scratch_len + opt->len) > sizeof(scratch)) {
+            return -ENOBUFS;
+        }
+        memcpy(&scratch[scratch_len], buf + opt->offset, opt->len);
+        outer[outer_numof].num = opt->opt_num;
+        outer[outer_numof].len = opt->len;
+        outer[outer_numof].val = &scratch[scratch_len];
+        scratch_len += opt->len;
+        outer_numof++;
+    }
+
+    /* Merge the outer and inner options from the start of the options on.
+     * Merged deltas are no longer than those of either list, and the OSCORE
+     * option, the payload marker and the code are dropped, so an inner
+     * option is always parsed before its place is written to. */
+    uint8_t code = plain[0];
+    const uint8_t *pos_in = plain + 1, *end = plain + plain_len;
+    size_t w = coap_get_total_hdr_len(pdu);
+    unsigned prev = 0, u = 0;
+    _opt_t inner = { .num = 0 };
+    int res = _next_opt(&pos_in, end, &inner);
+
+    while ((u < outer_numof) || (res > 0)) {
+        if ((u < outer_numof) && ((res <= 0) || (outer[u].num <= inner.num))) {
+            w += _put_opt(buf + w, outer[u].num - prev, outer[u].val,
+                          outer[u].len);
+            prev = outer[u++].num;
+        }
+        else {
+            w += _put_opt(buf + w, inner.num - prev, inner.val, inner.len);
+            prev = inner.num;
+            res = _next_opt(&pos_in, end, &inner);
+        }
+    }
+    if (res < 0) {
+        return -EBADMSG;
+    }
+    if (pos_in < end) {
+        size_t payload_len = end - ++pos_in;
+
+        if (payload_len == 0) {
+            return -EBADMSG;
+        }
+        buf[w++] = _PAYLOAD_MARKER;
+        memmove(buf + w, pos_in, payload_len);
+        w += payload_len;
+    }
+    pdu->hdr->code = code;
+    return w;
+}
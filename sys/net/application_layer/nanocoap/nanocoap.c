@@ -40,7 +40,7 @@
 /** @} */
 
 static int _decode_value(unsigned val, uint8_t **pkt_pos_ptr, uint8_t *pkt_end);
-int coap_get_option_uint(coap_pkt_t *pkt, unsigned opt_num, uint32_t *target);
+static const coap_optpos_t *_find_opt(const coap_pkt_t *pkt, unsigned opt_num);
 static uint32_t _decode_uint(uint8_t *pkt_pos, unsigned nbytes);
 static size_t _encode_uint(uint32_t *val);
 
@@ -83,7 +83,6 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
 
     /* parse options */
     while (pkt_pos != pkt_end) {
-        uint8_t *option_start = pkt_pos;
         uint8_t option_byte = *pkt_pos++;
         if (option_byte == 0xff) {
             pkt->payload = pkt_pos;
@@ -105,20 +104,24 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
             option_nr += option_delta;
             DEBUG("option count=%u nr=%u len=%i\n", option_count, option_nr, option_len);
 
-            if (option_delta) {
-                optpos->opt_num = option_nr;
-                optpos->offset = (uintptr_t)option_start - (uintptr_t)hdr;
-                DEBUG("optpos option_nr=%u %u\n", (unsigned)option_nr, (unsigned)optpos->offset);
-                optpos++;
-                option_count++;
-            }
-
-            pkt_pos += option_len;
-
-            if (pkt_pos > (buf + len)) {
+            if ((pkt_pos + option_len) > (buf + len)) {
                 DEBUG("nanocoap: bad pkt\n");
                 return -EBADMSG;
             }
+            if (option_count == NANOCOAP_NOPTS_MAX) {
+                DEBUG("nanocoap: too many options\n");
+                return -ENOMEM;
+            }
+
+            /* index every option, so lookups don't parse the packet again */
+            optpos->opt_num = option_nr;
+            optpos->offset = (uintptr_t)pkt_pos - (uintptr_t)hdr;
+            optpos->len = option_len;
+            DEBUG("optpos option_nr=%u %u\n", (unsigned)option_nr, (unsigned)optpos->offset);
+            optpos++;
+            option_count++;
+
+            pkt_pos += option_len;
         }
     }
 
@@ -141,93 +144,63 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
     return 0;
 }
 
-uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
+/*
+ * Finds the first instance of an option in the index. Options are indexed in
+ * ascending order of their numbers.
+ */
+static const coap_optpos_t *_find_opt(const coap_pkt_t *pkt, unsigned opt_num)
 {
-    const coap_optpos_t *optpos = pkt->options;
-    unsigned opt_count = pkt->options_len;
+    unsigned lo = 0;
+    unsigned hi = pkt->options_len;
 
-    while (opt_count--) {
-        if (optpos->opt_num == opt_num) {
-            return (uint8_t*)pkt->hdr + optpos->offset;
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        if (pkt->options[mid].opt_num < opt_num) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
         }
-        optpos++;
+    }
+    if ((lo < pkt->options_len) && (pkt->options[lo].opt_num == opt_num)) {
+        return &pkt->options[lo];
     }
     return NULL;
 }
 
-static uint8_t *_parse_option(const coap_pkt_t *pkt,
-                              uint8_t *pkt_pos, uint16_t *delta, int *opt_len)
+static inline uint8_t *_opt_value(const coap_pkt_t *pkt, const coap_optpos_t *opt)
 {
-    uint8_t *hdr_end = pkt->payload;
-
-    if (pkt_pos == hdr_end) {
-        return NULL;
-    }
-
-    uint8_t option_byte = *pkt_pos++;
-
-    *delta = _decode_value(option_byte >> 4, &pkt_pos, hdr_end);
-    *opt_len = _decode_value(option_byte & 0xf, &pkt_pos, hdr_end);
-
-    return pkt_pos;
+    return (uint8_t *)pkt->hdr + opt->offset;
 }
 
 int coap_get_option_uint(coap_pkt_t *pkt, unsigned opt_num, uint32_t *target)
 {
     assert(target);
 
-    uint8_t *opt_pos = coap_find_option(pkt, opt_num);
-    if (opt_pos) {
-        uint16_t delta;
-        int option_len = 0;
-        uint8_t *pkt_pos = _parse_option(pkt, opt_pos, &delta, &option_len);
-        if (option_len >= 0) {
-            if (option_len > 4) {
-                DEBUG("nanocoap: uint option with len > 4 (unsupported).\n");
-                return -ENOSPC;
-            }
-            *target = _decode_uint(pkt_pos, option_len);
-            return 0;
-        }
-        else {
-            DEBUG("nanocoap: discarding packet with invalid option length.\n");
-            return -EBADMSG;
+    const coap_optpos_t *opt = _find_opt(pkt, opt_num);
+    if (opt) {
+        if (opt->len > 4) {
+            DEBUG("nanocoap: uint option with len > 4 (unsupported).\n");
+            return -ENOSPC;
         }
+        *target = _decode_uint(_opt_value(pkt, opt), opt->len);
+        return 0;
     }
     return -1;
 }
 
-uint8_t *coap_iterate_option(const coap_pkt_t *pkt, uint8_t **optpos,
-                             int *opt_len, int first)
-{
-    uint8_t *data_start;
-
-    uint16_t delta = 0;
-    data_start = _parse_option(pkt, *optpos, &delta, opt_len);
-    if (data_start && (first || !delta)) {
-        *optpos = data_start + *opt_len;
-        return data_start;
-    }
-    else {
-        *optpos = NULL;
-        return NULL;
-    }
-}
-
 unsigned coap_get_content_type(coap_pkt_t *pkt)
 {
-    uint8_t *opt_pos = coap_find_option(pkt, COAP_OPT_CONTENT_FORMAT);
+    const coap_optpos_t *opt = _find_opt(pkt, COAP_OPT_CONTENT_FORMAT);
     unsigned content_type = COAP_FORMAT_NONE;
-    if (opt_pos) {
-        uint16_t delta;
-        int option_len = 0;
-        uint8_t *pkt_pos = _parse_option(pkt, opt_pos, &delta, &option_len);
+    if (opt) {
+        uint8_t *pkt_pos = _opt_value(pkt, opt);
 
-        if (option_len == 0) {
+        if (opt->len == 0) {
             content_type = 0;
-        } else if (option_len == 1) {
+        } else if (opt->len == 1) {
             content_type = *pkt_pos;
-        } else if (option_len == 2) {
+        } else if (opt->len == 2) {
             memcpy(&content_type, pkt_pos, 2);
             content_type = ntohs(content_type);
         }
@@ -236,56 +209,90 @@ unsigned coap_get_content_type(coap_pkt_t *pkt)
     return content_type;
 }
 
+ssize_t coap_opt_get_opaque(const coap_pkt_t *pkt, unsigned optnum,
+                            uint8_t **value)
+{
+    assert(value);
+
+    const coap_optpos_t *opt = _find_opt(pkt, optnum);
+    if (!opt) {
+        return -ENOENT;
+    }
+    *value = _opt_value(pkt, opt);
+    return opt->len;
+}
+
 ssize_t coap_opt_get_string(const coap_pkt_t *pkt, uint16_t optnum,
                             uint8_t *target, size_t max_len, char separator)
 {
     assert(pkt && target && (max_len > 1));
 
-    uint8_t *opt_pos = coap_find_option(pkt, optnum);
-    if (!opt_pos) {
+    const coap_optpos_t *opt = _find_opt(pkt, optnum);
+    if (!opt) {
         *target++ = (uint8_t)separator;
         *target = '\0';
         return 2;
     }
 
     unsigned left = max_len - 1;
-    uint8_t *part_start = NULL;
-    do {
-        int opt_len;
-        part_start = coap_iterate_option(pkt, &opt_pos, &opt_len,
-                                         (part_start == NULL));
-        if (part_start) {
-            if (left < (unsigned)(opt_len + 1)) {
-                return -ENOSPC;
-            }
-            *target++ = (uint8_t)separator;
-            memcpy(target, part_start, opt_len);
-            target += opt_len;
-            left -= (opt_len + 1);
+    const coap_optpos_t *opt_end = &pkt->options[pkt->options_len];
+    for (; (opt < opt_end) && (opt->opt_num == optnum); opt++) {
+        if (left < (unsigned)(opt->len + 1)) {
+            return -ENOSPC;
         }
-    } while(opt_pos);
+        *target++ = (uint8_t)separator;
+        memcpy(target, _opt_value(pkt, opt), opt->len);
+        target += opt->len;
+        left -= (opt->len + 1);
+    }
 
     *target = '\0';
 
     return (int)(max_len - left);
 }
 
+int coap_uri_path_cmp(const coap_pkt_t *pkt, const char *path)
+{
+    const uint8_t *pos = (const uint8_t *)path;
+    const coap_optpos_t *opt = _find_opt(pkt, COAP_OPT_URI_PATH);
+
+    if (!opt) {
+        /* coap_get_uri_path() yields "/" without URI_PATH options */
+        if (*pos != '/') {
+            return '/' - *pos;
+        }
+        return 0 - pos[1];
+    }
+
+    const coap_optpos_t *opt_end = &pkt->options[pkt->options_len];
+    for (; (opt < opt_end) && (opt->opt_num == COAP_OPT_URI_PATH); opt++) {
+        const uint8_t *part_start = _opt_value(pkt, opt);
+        if (*pos != '/') {
+            return '/' - *pos;
+        }
+        pos++;
+        for (unsigned i = 0; i < opt->len; i++, pos++) {
+            if ((part_start[i] != *pos) || (*pos == '\0')) {
+                return part_start[i] - *pos;
+            }
+        }
+    }
+
+    return 0 - *pos;
+}
+
 int coap_get_blockopt(coap_pkt_t *pkt, uint16_t option, uint32_t *blknum, unsigned *szx)
 {
-    uint8_t *optpos = coap_find_option(pkt, option);
-    if (!optpos) {
+    const coap_optpos_t *opt = _find_opt(pkt, option);
+    if (!opt) {
         *blknum = 0;
         *szx = 0;
         return -1;
     }
 
-    int option_len;
-    uint16_t delta;
-
-    uint8_t *data_start = _parse_option(pkt, optpos, &delta, &option_len);
-    uint32_t blkopt = _decode_uint(data_start, option_len);
+    uint32_t blkopt = _decode_uint(_opt_value(pkt, opt), opt->len);
 
-    DEBUG("nanocoap: blkopt len: %i\n", option_len);
+    DEBUG("nanocoap: blkopt len: %u\n", (unsigned)opt->len);
     DEBUG("nanocoap: blkopt: 0x%08x\n", (unsigned)blkopt);
     *blknum = blkopt >> COAP_BLOCKWISE_NUM_OFF;
     *szx = blkopt & COAP_BLOCKWISE_SZX_MASK;
@@ -688,7 +695,9 @@ static ssize_t _add_opt_pkt(coap_pkt_t *pkt, uint16_t optnum, uint8_t *val,
     assert(pkt->payload_len > optlen);
 
     pkt->options[pkt->options_len].opt_num = optnum;
-    pkt->options[pkt->options_len].offset = pkt->payload - (uint8_t *)pkt->hdr;
+    pkt->options[pkt->options_len].offset = pkt->payload + (optlen - val_len)
+                                            - (uint8_t *)pkt->hdr;
+    pkt->options[pkt->options_len].len = val_len;
     pkt->options_len++;
     pkt->payload += optlen;
     pkt->payload_len -= optlen;
@@ -745,6 +754,15 @@ ssize_t coap_opt_add_uint(coap_pkt_t *pkt, uint16_t optnum, uint32_t value)
     return _add_opt_pkt(pkt, optnum, (uint8_t *)&tmp, tmp_len);
 }
 
+ssize_t coap_opt_add_opaque(coap_pkt_t *pkt, uint16_t optnum,
+                            const uint8_t *val, size_t val_len)
+{
+    if (pkt->options_len == NANOCOAP_NOPTS_MAX) {
+        return -ENOSPC;
+    }
+    return _add_opt_pkt(pkt, optnum, (uint8_t *)val, val_len);
+}
+
 ssize_t coap_opt_finish(coap_pkt_t *pkt, uint16_t flags)
 {
     if (flags & COAP_OPT_FINISH_PAYLOAD) {
@@ -845,6 +863,112 @@ size_t coap_blockwise_put_bytes(coap_block_slicer_t *slicer, uint8_t *bufpos,
     return str_len;
 }
 
+ssize_t coap_block2_reply_stream(coap_pkt_t *pkt, unsigned code,
+                                 uint8_t *buf, size_t len, unsigned ct,
+                                 coap_block_read_t read_cb, void *arg)
+{
+    /* Content-Format (3), Block2 (4) and payload marker, plus the byte
+     * read to detect further blocks */
+    const size_t overhead = coap_get_total_hdr_len(pkt) + 3 + 4 + 1 + 1;
+    uint32_t blknum;
+    unsigned szx;
+
+    if (coap_get_blockopt(pkt, COAP_OPT_BLOCK2, &blknum, &szx) < 0) {
+        szx = NANOCOAP_BLOCK_SIZE_EXP_MAX - 4;
+    }
+    else if (szx >= COAP_BLOCKWISE_SZX_MAX) {
+        return coap_build_reply(pkt, COAP_CODE_BAD_OPTION, buf, len, 0);
+    }
+
+    /* Smaller block sizes divide larger ones, so the offset stays aligned */
+    size_t offset = (size_t)blknum << (szx + 4);
+    if (szx > NANOCOAP_BLOCK_SIZE_EXP_MAX - 4) {
+        szx = NANOCOAP_BLOCK_SIZE_EXP_MAX - 4;
+    }
+    while ((overhead + coap_szx2size(szx)) > len) {
+        if (szx == 0) {
+            return -ENOSPC;
+        }
+        szx--;
+    }
+    blknum = offset >> (szx + 4);
+
+    uint8_t *payload = buf + coap_get_total_hdr_len(pkt);
+    uint8_t *bufpos = payload;
+    bufpos += coap_put_option_ct(bufpos, 0, ct);
+    uint8_t *opt = bufpos;
+    size_t optlen = coap_put_option_block(opt, COAP_OPT_CONTENT_FORMAT, blknum,
+                                          szx, 1, COAP_OPT_BLOCK2);
+    bufpos += optlen;
+    *bufpos++ = 0xff;
+
+    size_t blksize = coap_szx2size(szx);
+    ssize_t res = read_cb(arg, offset, bufpos, blksize + 1);
+    if (res < 0) {
+        DEBUG("nanocoap: block2 read at %u failed\n", (unsigned)offset);
+        return coap_build_reply(pkt, COAP_CODE_INTERNAL_SERVER_ERROR, buf, len, 0);
+    }
+    if ((res == 0) && (offset > 0)) {
+        return coap_build_reply(pkt, COAP_CODE_BAD_OPTION, buf, len, 0);
+    }
+
+    size_t read_len = res;
+    if (read_len > blksize) {
+        read_len = blksize;
+    }
+    else {
+        /* Last block, clearing the more bit may shorten the option */
+        size_t last_len = coap_put_option_block(opt, COAP_OPT_CONTENT_FORMAT,
+                                                blknum, szx, 0, COAP_OPT_BLOCK2);
+        if (last_len != optlen) {
+            memmove(opt + last_len, opt + optlen, (bufpos - (opt + optlen)) + read_len);
+            bufpos -= optlen - last_len;
+        }
+    }
+    if (read_len == 0) {
+        /* No payload marker for an empty resource */
+        bufpos--;
+    }
+
+    return coap_build_reply(pkt, code, buf, len, (bufpos - payload) + read_len);
+}
+
+ssize_t coap_block1_handle_stream(coap_pkt_t *pkt, unsigned code,
+                                  uint8_t *buf, size_t len,
+                                  coap_block_write_t write_cb, void *arg)
+{
+    coap_block1_t block1;
+    int blockwise = coap_get_block1(pkt, &block1);
+    bool more = (block1.more == 1);
+
+    /* All blocks but the last must fill the block size */
+    if (blockwise && ((block1.szx >= COAP_BLOCKWISE_SZX_MAX) ||
+                      (more && (pkt->payload_len != coap_szx2size(block1.szx))))) {
+        return coap_build_reply(pkt, COAP_CODE_BAD_REQUEST, buf, len, 0);
+    }
+
+    /* Consume the payload before the reply may overwrite it */
+    ssize_t res = write_cb(arg, block1.offset, pkt->payload, pkt->payload_len,
+                           more);
+    if (res < 0) {
+        DEBUG("nanocoap: block1 write at %u failed\n", (unsigned)block1.offset);
+        code = (res == -ENOSPC) ? COAP_CODE_REQUEST_ENTITY_TOO_LARGE
+                                : COAP_CODE_INTERNAL_SERVER_ERROR;
+        return coap_build_reply(pkt, code, buf, len, 0);
+    }
+
+    size_t opt_len = 0;
+    if (blockwise) {
+        opt_len = coap_put_option_block1(buf + coap_get_total_hdr_len(pkt), 0,
+                                         block1.blknum, block1.szx, more);
+        if (more) {
+            code = COAP_CODE_231;
+        }
+    }
+
+    return coap_build_reply(pkt, code, buf, len, opt_len);
+}
+
 ssize_t coap_well_known_core_default_handler(coap_pkt_t *pkt, uint8_t *buf, \
                                              size_t len, void *context)
 {
@@ -14,15 +14,74 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+static inline uint32_t _fold(uint32_t csum)
+{
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+/* sums up buf in host byte order, so the result is byte-swapped on little
+ * endian platforms. buf must be 16-bit aligned */
+static uint32_t _sum_words(const uint8_t *buf, size_t len)
+{
+    uint32_t csum = 0;
+    const uint32_t *words;
+
+    if (((uintptr_t)buf & 0x2) && (len >= 2)) {
+        csum += *((const uint16_t *)buf);
+        buf += 2;
+        len -= 2;
+    }
+    words = (const uint32_t *)buf;
+    /* add up 32-bit words with end-around carry, unrolled by 4 */
+    while (len >= (4 * sizeof(uint32_t))) {
+        uint32_t w;
+
+        w = words[0]; csum += w; csum += (csum < w);
+        w = words[1]; csum += w; csum += (csum < w);
+        w = words[2]; csum += w; csum += (csum < w);
+        w = words[3]; csum += w; csum += (csum < w);
+        words += 4;
+        len -= 4 * sizeof(uint32_t);
+    }
+    while (len >= sizeof(uint32_t)) {
+        uint32_t w = *(words++);
+
+        csum += w;
+        csum += (csum < w);
+        len -= sizeof(uint32_t);
+    }
+    buf = (const uint8_t *)words;
+    csum = _fold(csum);
+    if (len >= 2) {
+        csum += *((const uint16_t *)buf);
+        buf += 2;
+        len -= 2;
+    }
+    if (len) {
+        /* pad last byte to a 16-bit word */
+        uint16_t last = 0;
+
+        *((uint8_t *)&last) = *buf;
+        csum += last;
+    }
+    return csum;
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
+    uint16_t part;
 
     DEBUG("inet_sum: sum = 0x%04" PRIx16 ", len = %" PRIu16, sum, len);
 #if ENABLE_DEBUG
@@ -41,25 +100,36 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
         len--;
-        accum_len++;
     }
 
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    if (len == 0) {
+        return _fold(csum);
     }
-
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
-
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
+    if ((uintptr_t)buf & 0x1) {
+        /* sum up as if buf was preceded by a zero byte, which swaps the
+         * bytes of the result (see RFC 1071, section 2 (B)) */
+        part = ntohs(_fold(_sum_words(buf + 1, len - 1)));
+        part = byteorder_swaps(_fold(part + *buf));
     }
+    else {
+        part = ntohs(_fold(_sum_words(buf, len)));
+    }
+    csum = _fold(csum + part);
 
     DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
 
     return csum;
 }
 
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_buf, const uint8_t *new_buf,
+                          uint16_t len)
+{
+    /* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum;
+
+    sum += (uint16_t)~inet_csum(0, old_buf, len);
+    sum += inet_csum(0, new_buf, len);
+    return (uint16_t)~_fold(sum);
+}
+
 /** @} */
@@ -47,12 +47,14 @@ static kernel_pid_t _tftp_kernel_pid;
 #endif
 
 #define MIN(a, b)                   ((a) > (b) ? (b) : (a))
+#define MAX(a, b)                   ((a) > (b) ? (a) : (b))
 #define ARRAY_LEN(x)                (sizeof(x) / sizeof(x[0]))
 
 #define TFTP_TIMEOUT_MSG            0x4000
 #define TFTP_STOP_SERVER_MSG        0x4001
 #define TFTP_DEFAULT_DATA_SIZE      (GNRC_TFTP_MAX_TRANSFER_UNIT    \
                                      + sizeof(tftp_packet_data_t))
+#define TFTP_MIN_BLKSIZE            (8)     /* see RFC 2348 */
 
 /**
  * @brief TFTP mode help support
@@ -112,6 +114,7 @@ typedef enum {
     TOPT_BLKSIZE,
     TOPT_TIMEOUT,
     TOPT_TSIZE,
+    TOPT_WINDOWSIZE,
 } tftp_options_t;
 
 /* ordered as @see tftp_options_t */
@@ -119,6 +122,7 @@ tftp_opt_t _tftp_options[] = {
     [TOPT_BLKSIZE] = MODE(blksize),
     [TOPT_TIMEOUT] = MODE(timeout),
     [TOPT_TSIZE]   = MODE(tsize),
+    [TOPT_WINDOWSIZE] = MODE(windowsize),
 };
 
 /**
@@ -161,7 +165,13 @@ typedef struct {
 
     /* transfer parameters */
     uint16_t block_nr;
+    uint16_t block_acked;           /* last block acknowledged */
     uint16_t block_size;
+    uint16_t window_size;
+    uint16_t window_ooo;            /* blocks out of sequence since the last
+                                     * block in sequence */
+    uint8_t opts;                   /* options the client sent, bits of
+                                     * tftp_options_t */
     size_t transfer_size;
     uint32_t block_timeout;
     uint32_t retries;
@@ -202,6 +212,12 @@ static inline tftp_opcodes_t _tftp_parse_type(uint8_t *buf)
     return ((tftp_header_t *)buf)->opc;
 }
 
+/* check if we send the data blocks or receive them */
+static inline bool _tftp_sends_data(const tftp_context_t *ctxt)
+{
+    return (ctxt->ct == CT_CLIENT) == (ctxt->op == TO_WRQ);
+}
+
 /* initialize the context to it's default state */
 static int _tftp_init_ctxt(ipv6_addr_t *addr, const char *file_name,
                            tftp_opcodes_t op, tftp_mode_t mode, tftp_context_type type,
@@ -226,6 +242,9 @@ static tftp_state _tftp_send_start(tftp_context_t *ctxt, gnrc_pktsnip_t *buf);
 /* send data or and ack depending if we are reading or writing */
 static tftp_state _tftp_send_dack(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_opcodes_t op);
 
+/* send the window of data blocks following the last acknowledged block */
+static tftp_state _tftp_send_window(tftp_context_t *ctxt, gnrc_pktsnip_t *buf);
+
 /* send and TFTP error to the client */
 static tftp_state _tftp_send_error(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_err_codes_t err, const char *err_msg);
 
@@ -250,18 +269,23 @@ static int _tftp_decode_error(uint8_t *buf, tftp_err_codes_t *err, const char *
 /* TFTP super loop server */
 static int _tftp_server(tftp_context_t *ctxt);
 
-/* get the maximum allowed transfer unit to avoid 6Lo fragmentation */
-static uint16_t _tftp_get_maximum_block_size(void)
+/* get the maximum block size that fits into the path MTU to the peer */
+static uint16_t _tftp_get_maximum_block_size(const ipv6_addr_t *peer)
 {
-    uint16_t tmp;
+    uint16_t tmp, mtu = IPV6_MIN_MTU;
     gnrc_netif_t *netif = gnrc_netif_iter(NULL);
 
+    /* without path MTU discovery only the minimum MTU is safe for peers
+     * that are not on the link */
     if ((netif != NULL) && gnrc_netapi_get(netif->pid, NETOPT_MAX_PACKET_SIZE,
-                                           0, &tmp, sizeof(uint16_t)) >= 0) {
-        /* TODO calculate proper block size */
-        return tmp - sizeof(udp_hdr_t) - sizeof(ipv6_hdr_t) - 10;
+                                           GNRC_NETTYPE_IPV6, &tmp,
+                                           sizeof(uint16_t)) >= 0) {
+        if (ipv6_addr_is_link_local(peer) || (tmp < mtu)) {
+            mtu = tmp;
+        }
     }
-    return GNRC_TFTP_MAX_TRANSFER_UNIT;
+    mtu -= sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t) + sizeof(tftp_packet_data_t);
+    return MIN(mtu, GNRC_TFTP_MAX_TRANSFER_UNIT);
 }
 
 int gnrc_tftp_client_read(ipv6_addr_t *addr, const char *file_name, tftp_mode_t mode,
@@ -279,7 +303,7 @@ int gnrc_tftp_client_read(ipv6_addr_t *addr, const char *file_name, tftp_mode_t
     }
 
     /* set the transfer options */
-    uint16_t mtu = _tftp_get_maximum_block_size();
+    uint16_t mtu = _tftp_get_maximum_block_size(addr);
     if (!use_option_extensions ||
         _tftp_set_opts(&ctxt, mtu, GNRC_TFTP_DEFAULT_TIMEOUT, 0) != TS_FINISHED) {
         _tftp_set_default_options(&ctxt);
@@ -312,7 +336,7 @@ int gnrc_tftp_client_write(ipv6_addr_t *addr, const char *file_name, tftp_mode_t
     }
 
     /* set the transfer options */
-    uint16_t mtu = _tftp_get_maximum_block_size();
+    uint16_t mtu = _tftp_get_maximum_block_size(addr);
     if (!use_option_extensions ||
         _tftp_set_opts(&ctxt, mtu, GNRC_TFTP_DEFAULT_TIMEOUT, total_size) != TS_FINISHED) {
 
@@ -361,7 +385,9 @@ int _tftp_init_ctxt(ipv6_addr_t *addr, const char *file_name,
 
     /* transport layer parameters */
     ctxt->block_size = GNRC_TFTP_MAX_TRANSFER_UNIT;
+    ctxt->timeout = GNRC_TFTP_DEFAULT_TIMEOUT;
     ctxt->block_timeout = GNRC_TFTP_DEFAULT_TIMEOUT;
+    ctxt->window_size = 1;
     ctxt->write_finished = false;
 
     /* generate a random source UDP source port */
@@ -378,6 +404,7 @@ void _tftp_set_default_options(tftp_context_t *ctxt)
     ctxt->timeout = GNRC_TFTP_DEFAULT_TIMEOUT;
     ctxt->block_timeout = GNRC_TFTP_DEFAULT_TIMEOUT;
     ctxt->transfer_size = 0;
+    ctxt->window_size = 1;
     ctxt->use_options = false;
 }
 
@@ -391,6 +418,7 @@ int _tftp_set_opts(tftp_context_t *ctxt, size_t blksize, uint32_t timeout, size_
     ctxt->timeout = timeout;
     ctxt->block_timeout = timeout;
     ctxt->transfer_size = total_size;
+    ctxt->window_size = GNRC_TFTP_WINDOW_SIZE;
     ctxt->use_options = true;
 
     return TS_FINISHED;
@@ -587,8 +615,11 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
         else {
             DEBUG("tftp: last data or ack packet lost, resending\n");
             /* we are sending / receiving data */
-            /* if we are reading resent the ACK, if writing the DATA */
-            return _tftp_send_dack(ctxt, outbuf, (ctxt->op == TO_RRQ) ? TO_ACK : TO_DATA);
+            /* if we are reading resent the ACK, if writing the window */
+            if (_tftp_sends_data(ctxt)) {
+                return _tftp_send_window(ctxt, outbuf);
+            }
+            return _tftp_send_dack(ctxt, outbuf, TO_ACK);
         }
     }
     else if (m->type != GNRC_NETAPI_MSG_TYPE_RCV) {
@@ -644,7 +675,7 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
 
             /* try to decode the options */
             tftp_state state;
-            tftp_opcodes_t opcode;
+            tftp_opcodes_t opcode = TO_ACK;
             if (ctxt->enable_options &&
                 _tftp_decode_options(ctxt, pkt, offset) > offset) {
                 DEBUG("tftp: send option ACK\n");
@@ -660,12 +691,8 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
 
                 /* send the first data block */
                 if (ctxt->op == TO_RRQ) {
-                    ++(ctxt->block_nr);
                     opcode = TO_DATA;
                 }
-                else {
-                    opcode = TO_ACK;
-                }
             }
 
             /* validate if the application accepts the action, mode, filename and transfer_size */
@@ -677,7 +704,12 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
             }
 
             /* the client send the TFTP options */
-            state = _tftp_send_dack(ctxt, outbuf, opcode);
+            if (opcode == TO_DATA) {
+                state = _tftp_send_window(ctxt, outbuf);
+            }
+            else {
+                state = _tftp_send_dack(ctxt, outbuf, opcode);
+            }
 
             /* check if the client negotiation was successful */
             if (state != TS_BUSY) {
@@ -699,15 +731,23 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
             }
 
             if (proc == TS_DUP) {
-                DEBUG("tftp: duplicated data received, acking...\n");
-                _tftp_send_dack(ctxt, outbuf, TO_ACK);
+                /* acknowledge the last block in sequence, so the peer
+                 * resends from there, but only once per window of blocks
+                 * out of sequence (RFC 7440, section 4) */
+                if ((ctxt->window_ooo++ % ctxt->window_size) == 0) {
+                    DEBUG("tftp: block out of sequence received, acking...\n");
+                    ctxt->block_acked = ctxt->block_nr;
+                    _tftp_send_dack(ctxt, outbuf, TO_ACK);
+                }
+                else {
+                    gnrc_pktbuf_release(outbuf);
+                }
                 return TS_BUSY;
             }
 
             /* check if this is the first block */
             if (!ctxt->block_nr
-                && ctxt->dst_port == GNRC_TFTP_DEFAULT_DST_PORT
-                && !ctxt->use_options) {
+                && ctxt->dst_port == GNRC_TFTP_DEFAULT_DST_PORT) {
                 /* no OACK received, restore default TFTP parameters */
                 _tftp_set_default_options(ctxt);
                 DEBUG("tftp: restore default TFTP parameters\n");
@@ -719,7 +759,18 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
             /* wait for the next data block */
             DEBUG("tftp: wait for the next data block\n");
             ++(ctxt->block_nr);
-            _tftp_send_dack(ctxt, outbuf, TO_ACK);
+            ctxt->window_ooo = 0;
+            ctxt->retries = 0;
+
+            /* acknowledge the window once it is complete */
+            if ((proc < (int)ctxt->block_size) ||
+                ((uint16_t)(ctxt->block_nr - ctxt->block_acked) >= ctxt->window_size)) {
+                ctxt->block_acked = ctxt->block_nr;
+                _tftp_send_dack(ctxt, outbuf, TO_ACK);
+            }
+            else {
+                gnrc_pktbuf_release(outbuf);
+            }
 
             /* check if the data transfer has finished */
             if (proc < (int)ctxt->block_size) {
@@ -744,8 +795,11 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
                 return TS_BUSY;
             }
 
+            ctxt->block_acked = byteorder_ntohs(((tftp_packet_data_t *)data)->block_nr);
+            ctxt->retries = 0;
+
             /* check if the write action is finished */
-            if (ctxt->write_finished) {
+            if (ctxt->write_finished && (ctxt->block_acked == ctxt->block_nr)) {
                 gnrc_pktbuf_release(outbuf);
 
                 if (ctxt->stop_cb) {
@@ -764,10 +818,8 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
                 ctxt->dst_port = byteorder_ntohs(udp->src_port);
             }
 
-            /* send the next data block */
-            ++(ctxt->block_nr);
-
-            return _tftp_send_dack(ctxt, outbuf, TO_DATA);
+            /* send the next window, or resend from the first block lost */
+            return _tftp_send_window(ctxt, outbuf);
         } break;
 
         case TO_ERROR: {
@@ -795,19 +847,26 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
                 /* decode the options */
                 _tftp_decode_options(ctxt, pkt, 0);
 
+                /* the options the server did not acknowledge are declined */
+                if (!(ctxt->opts & (1U << TOPT_BLKSIZE))) {
+                    ctxt->block_size = GNRC_TFTP_MAX_TRANSFER_UNIT;
+                }
+                if (!(ctxt->opts & (1U << TOPT_WINDOWSIZE))) {
+                    ctxt->window_size = 1;
+                }
+
                 /* take the new source port */
                 ctxt->dst_port = byteorder_ntohs(udp->src_port);
-
-                /* we must send block one to finish the negotiation in send mode */
-                if (ctxt->op == TO_WRQ) {
-                    ++(ctxt->block_nr);
-                }
             }
             else {
                 DEBUG("tftp: dropping double TO_OACK\n");
             }
 
-            return _tftp_send_dack(ctxt, outbuf, (ctxt->op == TO_WRQ) ? TO_DATA : TO_ACK);
+            /* we must send block one to finish the negotiation in send mode */
+            if (ctxt->op == TO_WRQ) {
+                return _tftp_send_window(ctxt, outbuf);
+            }
+            return _tftp_send_dack(ctxt, outbuf, TO_ACK);
         } break;
     }
 
@@ -831,18 +890,33 @@ size_t _tftp_add_option(uint8_t *dst, tftp_opt_t *opt, uint32_t value)
     return ++offset;
 }
 
+/* check if an option goes into a request or option ACK */
+static inline bool _tftp_use_option(tftp_context_t *ctxt, tftp_options_t opt)
+{
+    /* the server must only acknowledge options the client sent */
+    return (ctxt->ct == CT_CLIENT) || (ctxt->opts & (1U << opt));
+}
+
 uint32_t _tftp_append_options(tftp_context_t *ctxt, tftp_header_t *hdr, uint32_t offset)
 {
-    offset += _tftp_add_option(hdr->data + offset, _tftp_options + TOPT_BLKSIZE, ctxt->block_size);
-    offset += _tftp_add_option(hdr->data + offset, _tftp_options + TOPT_TIMEOUT, (ctxt->timeout / US_PER_SEC));
+    if (_tftp_use_option(ctxt, TOPT_BLKSIZE)) {
+        offset += _tftp_add_option(hdr->data + offset, _tftp_options + TOPT_BLKSIZE, ctxt->block_size);
+    }
+    if (_tftp_use_option(ctxt, TOPT_TIMEOUT)) {
+        offset += _tftp_add_option(hdr->data + offset, _tftp_options + TOPT_TIMEOUT, (ctxt->timeout / US_PER_SEC));
+    }
+    if (_tftp_use_option(ctxt, TOPT_WINDOWSIZE)) {
+        offset += _tftp_add_option(hdr->data + offset, _tftp_options + TOPT_WINDOWSIZE, ctxt->window_size);
+    }
 
     /**
      * Only set the transfer option if we are sending.
      * Or when we are reading in bin mode.
      */
-    if ((ctxt->ct == CT_SERVER && ctxt->op == TO_RRQ) ||
-        (ctxt->ct == CT_CLIENT && ctxt->op == TO_WRQ) ||
-        ctxt->mode == TTM_OCTET) {
+    if (_tftp_use_option(ctxt, TOPT_TSIZE) &&
+        ((ctxt->ct == CT_SERVER && ctxt->op == TO_RRQ) ||
+         (ctxt->ct == CT_CLIENT && ctxt->op == TO_WRQ) ||
+         ctxt->mode == TTM_OCTET)) {
         offset += _tftp_add_option(hdr->data + offset, _tftp_options + TOPT_TSIZE, ctxt->transfer_size);
     }
 
@@ -910,6 +984,34 @@ tftp_state _tftp_send_dack(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_opcod
     return _tftp_send(buf, ctxt, sizeof(tftp_packet_data_t) + len);
 }
 
+tftp_state _tftp_send_window(tftp_context_t *ctxt, gnrc_pktsnip_t *buf)
+{
+    tftp_state state = TS_BUSY;
+
+    ctxt->block_nr = ctxt->block_acked;
+    ctxt->write_finished = false;
+    for (unsigned i = 0; i < ctxt->window_size; i++) {
+        if (buf == NULL) {
+            buf = gnrc_pktbuf_add(NULL, NULL, TFTP_DEFAULT_DATA_SIZE,
+                                  GNRC_NETTYPE_UNDEF);
+            if (buf == NULL) {
+                /* the rest of the window is sent on timeout */
+                DEBUG("tftp: no buffer for block %u\n", i + 1);
+                break;
+            }
+        }
+
+        ++(ctxt->block_nr);
+        state = _tftp_send_dack(ctxt, buf, TO_DATA);
+        buf = NULL;
+        if ((state != TS_BUSY) || ctxt->write_finished) {
+            break;
+        }
+    }
+
+    return state;
+}
+
 tftp_state _tftp_send_error(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_err_codes_t err, const char *err_msg)
 {
     int strl = err_msg ? strlen(err_msg) + 1 : 0;
@@ -1018,8 +1120,18 @@ tftp_state _tftp_send(gnrc_pktsnip_t *buf, tftp_context_t *ctxt, size_t len)
 bool _tftp_validate_ack(tftp_context_t *ctxt, uint8_t *buf)
 {
     tftp_packet_data_t *pkt = (tftp_packet_data_t *) buf;
+    uint16_t acked = byteorder_ntohs(pkt->block_nr) - ctxt->block_acked;
 
-    return ctxt->block_nr == byteorder_ntohs(pkt->block_nr);
+    if (ctxt->block_nr == 0) {
+        /* the ACK of the request */
+        return acked == 0;
+    }
+    if (acked == 0) {
+        /* no block of the window arrived in sequence, resend it */
+        return ctxt->window_size > 1;
+    }
+    /* one of the blocks sent since the last ACK */
+    return acked <= (uint16_t)(ctxt->block_nr - ctxt->block_acked);
 }
 
 int _tftp_decode_start(tftp_context_t *ctxt, uint8_t *buf, gnrc_pktsnip_t *outbuf)
@@ -1075,10 +1187,18 @@ int _tftp_decode_options(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, uint32_t sta
         /* check what option we are parsing */
         for (uint32_t idx = 0; idx < ARRAY_LEN(_tftp_options); ++idx) {
             if (memcmp(name, _tftp_options[idx].name, _tftp_options[idx].len) == 0) {
+                int num = atoi(value);
+
+                ctxt->opts |= (1U << idx);
                 /* set the option value of the known options */
                 switch (idx) {
                     case TOPT_BLKSIZE:
-                        ctxt->block_size = atoi(value);
+                        /* a server offers at most what fits the path, a
+                         * client accepts at most what it requested */
+                        ctxt->block_size = MIN(MAX(num, TFTP_MIN_BLKSIZE),
+                                               (ctxt->ct == CT_SERVER)
+                                               ? _tftp_get_maximum_block_size(&ctxt->peer)
+                                               : ctxt->block_size);
                         DEBUG("tftp: got option TOPT_BLKSIZE = %" PRIu16 "\n", ctxt->block_size);
                         break;
 
@@ -1095,6 +1215,14 @@ int _tftp_decode_options(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, uint32_t sta
                         ctxt->timeout = atoi(value) * US_PER_SEC;
                         DEBUG("tftp: option TOPT_TIMEOUT = %" PRIu32 " ms\n", ctxt->timeout / US_PER_MS);
                         break;
+
+                    case TOPT_WINDOWSIZE:
+                        ctxt->window_size = MIN(MAX(num, 1),
+                                                (ctxt->ct == CT_SERVER)
+                                                ? GNRC_TFTP_WINDOW_SIZE
+                                                : ctxt->window_size);
+                        DEBUG("tftp: got option TOPT_WINDOWSIZE = %" PRIu16 "\n", ctxt->window_size);
+                        break;
                 }
 
                 break;
@@ -1118,7 +1246,8 @@ int _tftp_process_data(tftp_context_t *ctxt, gnrc_pktsnip_t *buf)
     if (block_nr > (ctxt->block_nr + 1)) {
         DEBUG("tftp: incorrect block_nr %d received from server, expected %d\n",
                block_nr, (ctxt->block_nr + 1));
-        return TS_FAILED;
+        /* with a window, the blocks before were lost */
+        return (ctxt->window_size > 1) ? TS_DUP : TS_FAILED;
     }
     if (block_nr < (ctxt->block_nr + 1)) {
         DEBUG("tftp: not the packet we were waiting for, expected %d, received %d\n",
@@ -20,6 +20,7 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 
 #include "net/gnrc.h"
 #include "net/gnrc/mac/internal.h"
@@ -48,6 +49,22 @@ gnrc_priority_pktqueue_node_t *_alloc_pktqueue_node(gnrc_priority_pktqueue_node_
 
 #if GNRC_MAC_TX_QUEUE_SIZE != 0
 #if GNRC_MAC_NEIGHBOR_COUNT != 0
+/* Next unicast neighbor id after i, wrapping around to 1 */
+#define _NEXT_NEIGHBOR(i)   (((i) % GNRC_MAC_NEIGHBOR_COUNT) + 1)
+
+/* Home position of an address in the neighbor table, so in most cases only
+ * one entry needs to be compared */
+static unsigned _gnrc_mac_neighbor_hash(const uint8_t *addr, int addr_len)
+{
+    unsigned hash = 0;
+
+    for (int i = 0; i < addr_len; i++) {
+        hash = (hash * 31) + addr[i];
+    }
+    /* Broadcast neighbor is not hashed, so start at index 1 */
+    return (hash % GNRC_MAC_NEIGHBOR_COUNT) + 1;
+}
+
 /* Find the neighbor's id based on the given address */
 int _gnrc_mac_find_neighbor(gnrc_mac_tx_t *tx, const uint8_t *dst_addr, int addr_len)
 {
@@ -58,51 +75,58 @@ int _gnrc_mac_find_neighbor(gnrc_mac_tx_t *tx, const uint8_t *dst_addr, int addr
     gnrc_mac_tx_neighbor_t *neighbors;
     neighbors = tx->neighbors;
 
-    /* Don't attempt to find broadcast neighbor, so start at index 1 */
-    for (int i = 1; i <= (signed)GNRC_MAC_NEIGHBOR_COUNT; i++) {
+    /* Entries are freed anywhere, so probe the whole table from the home
+     * position on */
+    unsigned i = _gnrc_mac_neighbor_hash(dst_addr, addr_len);
+    for (unsigned n = 0; n < GNRC_MAC_NEIGHBOR_COUNT; n++) {
         if (neighbors[i].l2_addr_len == addr_len) {
             if (memcmp(&(neighbors[i].l2_addr), dst_addr, addr_len) == 0) {
                 return i;
             }
         }
+        i = _NEXT_NEIGHBOR(i);
     }
     return -ENOENT;
 }
 
-/* Free first empty queue (neighbor) that is not active */
-int _gnrc_mac_free_neighbor(gnrc_mac_tx_t *tx)
+/* Free first empty queue (neighbor) that is not active, starting at the home
+ * position of addr */
+int _gnrc_mac_free_neighbor(gnrc_mac_tx_t *tx, const uint8_t *addr, int addr_len)
 {
     assert(tx != NULL);
 
     gnrc_mac_tx_neighbor_t *neighbors;
     neighbors = tx->neighbors;
 
-    /* Don't attempt to free broadcast neighbor, so start at index 1 */
-    for (int i = 1; i <= (signed)GNRC_MAC_NEIGHBOR_COUNT; i++) {
+    unsigned i = _gnrc_mac_neighbor_hash(addr, addr_len);
+    for (unsigned n = 0; n < GNRC_MAC_NEIGHBOR_COUNT; n++) {
         if ((gnrc_priority_pktqueue_length(&(neighbors[i].queue)) == 0) &&
             (&neighbors[i] != tx->current_neighbor)) {
             /* Mark as free */
             neighbors[i].l2_addr_len = 0;
             return i;
         }
+        i = _NEXT_NEIGHBOR(i);
     }
     return -ENOSPC;
 }
 
-/* Allocate first unused queue (neighbor) */
-int _gnrc_mac_alloc_neighbor(gnrc_mac_tx_t *tx)
+/* Allocate first unused queue (neighbor), starting at the home position of
+ * addr */
+int _gnrc_mac_alloc_neighbor(gnrc_mac_tx_t *tx, const uint8_t *addr, int addr_len)
 {
     assert(tx != NULL);
 
     gnrc_mac_tx_neighbor_t *neighbors;
     neighbors = tx->neighbors;
 
-    /* Don't attempt to allocate broadcast neighbor, so start at index 1 */
-    for (int i = 1; i <= (signed)GNRC_MAC_NEIGHBOR_COUNT; i++) {
+    unsigned i = _gnrc_mac_neighbor_hash(addr, addr_len);
+    for (unsigned n = 0; n < GNRC_MAC_NEIGHBOR_COUNT; n++) {
         if (neighbors[i].l2_addr_len == 0) {
             gnrc_priority_pktqueue_init(&(neighbors[i].queue));
             return i;
         }
+        i = _NEXT_NEIGHBOR(i);
     }
     return -ENOSPC;
 }
@@ -116,8 +140,88 @@ void _gnrc_mac_init_neighbor(gnrc_mac_tx_neighbor_t *neighbor, const uint8_t *ad
 
     neighbor->l2_addr_len = len;
     neighbor->phase = GNRC_MAC_PHASE_MAX;
+    neighbor->deficit = 0;
+    memset(&neighbor->stats, 0, sizeof(neighbor->stats));
     memcpy(&(neighbor->l2_addr), addr, len);
 }
+
+/* Drop the last packet of the longest queue for a packet to neighbor, if that
+ * queue is longer than the one of neighbor */
+static gnrc_priority_pktqueue_node_t *_gnrc_mac_push_out(gnrc_mac_tx_t *tx,
+                                                         gnrc_mac_tx_neighbor_t *neighbor)
+{
+    gnrc_mac_tx_neighbor_t *longest = neighbor;
+    uint32_t longest_len = gnrc_priority_pktqueue_length(&neighbor->queue);
+    gnrc_priority_pktqueue_node_t *node;
+
+    for (unsigned i = 0; i <= GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        uint32_t len = gnrc_priority_pktqueue_length(&tx->neighbors[i].queue);
+
+        if (len > longest_len) {
+            longest = &tx->neighbors[i];
+            longest_len = len;
+        }
+    }
+    if (longest == neighbor) {
+        return NULL;
+    }
+
+    /* The last packet has the lowest priority */
+    node = gnrc_priority_pktqueue_last(&longest->queue);
+    gnrc_priority_pktqueue_remove(&longest->queue, node);
+    gnrc_pktbuf_release(node->pkt);
+    longest->stats.dropped++;
+    DEBUG("[gnrc_mac-int] Dropped packet of neighbor #%d for neighbor #%d\n",
+          (int)(longest - tx->neighbors), (int)(neighbor - tx->neighbors));
+    gnrc_priority_pktqueue_node_init(node, 0, NULL);
+    return node;
+}
+
+gnrc_pktsnip_t *gnrc_mac_dequeue_tx_packet(gnrc_mac_tx_t *tx,
+                                           gnrc_mac_tx_neighbor_t **neighbor)
+{
+    assert(tx != NULL);
+    assert(neighbor != NULL);
+
+    bool pending = false;
+
+    for (unsigned i = 1; i <= GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        if (gnrc_priority_pktqueue_length(&tx->neighbors[i].queue) > 0) {
+            pending = true;
+            break;
+        }
+    }
+    if (!pending) {
+        return NULL;
+    }
+
+    /* Terminates, as every non-empty queue gains credit each round */
+    while (1) {
+        gnrc_mac_tx_neighbor_t *current = &tx->neighbors[tx->drr_next];
+        gnrc_pktsnip_t *head = gnrc_priority_pktqueue_head(&current->queue);
+
+        /* Broadcast queue (id 0, before the first round) is not scheduled */
+        if (tx->drr_next != 0) {
+            if (head == NULL) {
+                /* Credit is not kept over idle periods */
+                current->deficit = 0;
+            }
+            else if (gnrc_pkt_len(head) <= current->deficit) {
+                current->deficit -= gnrc_pkt_len(head);
+                *neighbor = current;
+                return gnrc_priority_pktqueue_pop(&current->queue);
+            }
+        }
+
+        /* Round continues with the next queue */
+        tx->drr_next = _NEXT_NEIGHBOR(tx->drr_next);
+        current = &tx->neighbors[tx->drr_next];
+        if ((gnrc_priority_pktqueue_length(&current->queue) > 0) &&
+            (current->deficit <= (UINT16_MAX - GNRC_MAC_TX_DRR_QUANTUM))) {
+            current->deficit += GNRC_MAC_TX_DRR_QUANTUM;
+        }
+    }
+}
 #endif /* GNRC_MAC_NEIGHBOR_COUNT != 0 */
 
 bool gnrc_mac_queue_tx_packet(gnrc_mac_tx_t *tx, uint32_t priority, gnrc_pktsnip_t *pkt)
@@ -172,7 +276,7 @@ bool gnrc_mac_queue_tx_packet(gnrc_mac_tx_t *tx, uint32_t priority, gnrc_pktsnip
             neighbor_known = false;
 
             /* Try to allocate neighbor entry */
-            neighbor_id = _gnrc_mac_alloc_neighbor(tx);
+            neighbor_id = _gnrc_mac_alloc_neighbor(tx, addr, addr_len);
 
             /* No neighbor entries left */
             if (neighbor_id < 0) {
@@ -180,7 +284,7 @@ bool gnrc_mac_queue_tx_packet(gnrc_mac_tx_t *tx, uint32_t priority, gnrc_pktsnip
                       "GNRC_MAC_NEIGHBOR_COUNT for better performance\n");
 
                 /* Try to free an unused queue */
-                neighbor_id = _gnrc_mac_free_neighbor(tx);
+                neighbor_id = _gnrc_mac_free_neighbor(tx, addr, addr_len);
 
                 /* All queues are in use, so reject */
                 if (neighbor_id < 0) {
@@ -199,13 +303,24 @@ bool gnrc_mac_queue_tx_packet(gnrc_mac_tx_t *tx, uint32_t priority, gnrc_pktsnip
 
     gnrc_priority_pktqueue_node_t *node;
     node = _alloc_pktqueue_node(tx->_queue_nodes, GNRC_MAC_TX_QUEUE_SIZE);
+    if (node == NULL) {
+        node = _gnrc_mac_push_out(tx, neighbor);
+    }
     if (node) {
+        uint32_t len;
+
         gnrc_priority_pktqueue_node_init(node, priority, pkt);
         gnrc_priority_pktqueue_push(&neighbor->queue, node);
+        neighbor->stats.queued++;
+        len = gnrc_priority_pktqueue_length(&neighbor->queue);
+        if (len > neighbor->stats.depth_max) {
+            neighbor->stats.depth_max = len;
+        }
         DEBUG("[gnrc_mac-int] Queuing pkt to neighbor #%d\n", neighbor_id);
         return true;
     }
 
+    neighbor->stats.dropped++;
     DEBUG("[gnrc_mac-int] Can't push to neighbor #%d's queue, no entries left\n",
           neighbor_id);
     return false;
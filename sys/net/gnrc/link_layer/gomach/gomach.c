@@ -699,6 +699,28 @@ static void gomach_t2k_wait_cp_txfeedback(gnrc_netif_t *netif)
     }
 }
 
+static uint32_t _vtdma_frame_duration(gnrc_pktsnip_t *pkt)
+{
+    /* The NETIF header is not part of the frame. */
+    return (gnrc_pkt_len(pkt->next) * GNRC_GOMACH_VTDMA_BYTE_US) +
+           GNRC_GOMACH_VTDMA_FRAME_GUARD_US;
+}
+
+static uint32_t _vtdma_time_left(gnrc_netif_t *netif)
+{
+    int32_t left = (int32_t)(netif->mac.tx.vtdma_para.slots_end_us - xtimer_now_usec());
+
+    return (left > 0) ? (uint32_t)left : 0;
+}
+
+static void _vtdma_start(gnrc_netif_t *netif)
+{
+    /* The allocated slots are used as a time budget for a train of packets. */
+    netif->mac.tx.vtdma_para.slots_end_us = xtimer_now_usec() +
+                                            (netif->mac.tx.vtdma_para.slots_num *
+                                             GNRC_GOMACH_VTDMA_SLOT_SIZE_US);
+}
+
 static void gomach_t2k_wait_beacon(gnrc_netif_t *netif)
 {
     /* Process the beacon if we receive it. */
@@ -741,6 +763,7 @@ static void gomach_t2k_wait_beacon(gnrc_netif_t *netif)
             else {
                 /* If the allocated slots period is the first one in vTDMA,
                  * start sending packets. */
+                _vtdma_start(netif);
                 gnrc_pktsnip_t *pkt =
                     gnrc_priority_pktqueue_pop(&(netif->mac.tx.current_neighbor->queue));
                 if (pkt != NULL) {
@@ -779,6 +802,7 @@ static void gomach_t2k_wait_own_slots(gnrc_netif_t *netif)
     if (gnrc_gomach_timeout_is_expired(netif, GNRC_GOMACH_TIMEOUT_WAIT_SLOTS)) {
         /* The node is now in its scheduled slots period, start burst sending packets. */
         gnrc_gomach_set_netdev_state(netif, NETOPT_STATE_IDLE);
+        _vtdma_start(netif);
 
         gnrc_pktsnip_t *pkt = gnrc_priority_pktqueue_pop(&(netif->mac.tx.current_neighbor->queue));
         if (pkt != NULL) {
@@ -801,8 +825,21 @@ static void gomach_t2k_trans_in_slots(gnrc_netif_t *netif)
         device_state->seq = netif->mac.tx.tx_seq;
     }
 
+    /* Tell the receiver whether another packet of the train follows. */
+    gnrc_netif_hdr_t *netif_hdr = netif->mac.tx.packet->data;
+    gnrc_pktsnip_t *next = gnrc_priority_pktqueue_head(&netif->mac.tx.current_neighbor->queue);
+    if ((next != NULL) &&
+        (_vtdma_time_left(netif) >= (_vtdma_frame_duration(netif->mac.tx.packet) +
+                                     _vtdma_frame_duration(next)))) {
+        netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+
     /* Send data packet in its allocated slots (scheduled slots period). */
     int res = gnrc_gomach_send_data(netif, NETOPT_DISABLE);
+
+    /* The frame is built, don't keep the flag for retransmissions outside
+     * of vTDMA. */
+    netif_hdr->flags &= ~GNRC_NETIF_HDR_FLAGS_MORE_DATA;
     if (res < 0) {
         LOG_ERROR("ERROR: [GOMACH] t2k vTDMA transmission fail: %d, drop packet.\n", res);
 
@@ -820,7 +857,6 @@ static void gomach_t2k_trans_in_slots(gnrc_netif_t *netif)
 
     gnrc_gomach_set_timeout(netif, GNRC_GOMACH_TIMEOUT_NO_TX_ISR, GNRC_GOMACH_NO_TX_ISR_US);
 
-    netif->mac.tx.vtdma_para.slots_num--;
     netif->mac.tx.t2k_state = GNRC_GOMACH_T2K_WAIT_VTDMA_FEEDBACK;
     gnrc_gomach_set_update(netif, false);
 }
@@ -832,10 +868,10 @@ static void _t2k_wait_vtdma_tx_success(gnrc_netif_t *netif)
     netif->mac.tx.packet = NULL;
     netif->mac.tx.no_ack_counter = 0;
 
-    /* If the sender has pending packets and scheduled slots,
-     * continue vTDMA transmission. */
-    if ((netif->mac.tx.vtdma_para.slots_num > 0) &&
-        (gnrc_priority_pktqueue_length(&netif->mac.tx.current_neighbor->queue) > 0)) {
+    /* If the sender has pending packets and the next one fits into the rest
+     * of its scheduled slots period, continue vTDMA transmission. */
+    gnrc_pktsnip_t *next = gnrc_priority_pktqueue_head(&netif->mac.tx.current_neighbor->queue);
+    if ((next != NULL) && (_vtdma_time_left(netif) >= _vtdma_frame_duration(next))) {
         gnrc_pktsnip_t *pkt = gnrc_priority_pktqueue_pop(&netif->mac.tx.current_neighbor->queue);
         if (pkt != NULL) {
             netif->mac.tx.packet = pkt;
@@ -869,7 +905,7 @@ static void _t2k_wait_vtdma_tx_default(gnrc_netif_t *netif)
     netif->mac.tx.tx_seq = device_state->seq - 1;
 
     /* Do not release the packet here, continue sending the same packet. ***/
-    if (netif->mac.tx.vtdma_para.slots_num > 0) {
+    if (_vtdma_time_left(netif) >= _vtdma_frame_duration(netif->mac.tx.packet)) {
         LOG_DEBUG("[GOMACH] no ACK in vTDMA, retry in next slot.\n");
         netif->mac.tx.t2k_state = GNRC_GOMACH_T2K_VTDMA_TRANS;
     }
@@ -2169,7 +2205,7 @@ static void _gomach_init(gnrc_netif_t *netif)
     gnrc_gomach_set_buffer_full(netif, false);
     gnrc_gomach_set_phase_backoff(netif, false);
     netif->mac.rx.check_dup_pkt.queue_head = 0;
-    netif->mac.tx.last_tx_neighbor_id = 0;
+    netif->mac.tx.drr_next = 0;
 
     netdev_ieee802154_t *device_state = (netdev_ieee802154_t *)netif->dev;
     device_state->seq = netif->l2addr[netif->l2addr_len - 1];
@@ -446,6 +446,7 @@ int gnrc_gomach_send_beacon(gnrc_netif_t *netif)
     uint8_t j = 0;
     uint8_t total_tdma_node_num = 0;
     uint8_t total_tdma_slot_num = 0;
+    uint16_t total_demand = 0;
     gnrc_pktsnip_t *pkt = NULL;
     gnrc_pktsnip_t *gomach_pkt = NULL;
     gnrc_netif_hdr_t *nethdr_beacon = NULL;
@@ -467,27 +468,18 @@ int gnrc_gomach_send_beacon(gnrc_netif_t *netif)
                             GNRC_GOMACH_VTDMA_SLOT_SIZE_US;
 
     for (i = 0; i < GNRC_GOMACH_SLOSCH_UNIT_COUNT; i++) {
-        if (netif->mac.rx.slosch_list[i].queue_indicator > 0) {
+        if ((netif->mac.rx.slosch_list[i].queue_indicator > 0) &&
+            (total_tdma_node_num < max_slot_num)) {
             /* Record the device's (that will be allocated slots) address to the ID list. */
             memcpy(id_list[j].addr,
                    netif->mac.rx.slosch_list[i].node_addr.addr,
                    netif->mac.rx.slosch_list[i].node_addr.len);
 
-            /* Record the number of allocated slots to the slots list. */
+            /* Record the requested number of slots to the slots list. */
             slots_list[j] = netif->mac.rx.slosch_list[i].queue_indicator;
 
             total_tdma_node_num++;
-            total_tdma_slot_num += slots_list[j];
-
-            /* If there is no room for allocating more slots, stop. */
-            if (total_tdma_slot_num >= max_slot_num) {
-                uint8_t redueced_slots_num;
-                redueced_slots_num = total_tdma_slot_num - max_slot_num;
-                slots_list[j] -= redueced_slots_num;
-                total_tdma_slot_num -= redueced_slots_num;
-                break;
-            }
-
+            total_demand += slots_list[j];
             j++;
 
             /* If reach the maximum sender ID number limit, stop. */
@@ -497,6 +489,30 @@ int gnrc_gomach_send_beacon(gnrc_netif_t *netif)
         }
     }
 
+    if (total_demand > max_slot_num) {
+        /* Not all requests fit into the vTDMA period, share it among the
+         * senders in proportion to their queue-lengths, so that bulk flows
+         * are not starved by the senders coming first in the list. Every
+         * sender keeps at least one slot. */
+        uint16_t spare = max_slot_num - total_tdma_node_num;
+        uint16_t left = max_slot_num;
+
+        for (i = 0; i < total_tdma_node_num; i++) {
+            slots_list[i] = 1 + ((uint32_t)(slots_list[i] - 1) * spare) /
+                            (total_demand - total_tdma_node_num);
+            left -= slots_list[i];
+        }
+        /* Shares are rounded down, hand out the rest one by one. */
+        for (i = 0; left > 0; i = (i + 1) % total_tdma_node_num) {
+            slots_list[i]++;
+            left--;
+        }
+        total_tdma_slot_num = max_slot_num;
+    }
+    else {
+        total_tdma_slot_num = total_demand;
+    }
+
     gomach_beaocn_hdr.schedulelist_size = total_tdma_node_num;
 
     if (total_tdma_node_num > 0) {
@@ -1147,7 +1163,8 @@ bool gnrc_gomach_find_next_tx_neighbor(gnrc_netif_t *netif)
 {
     assert(netif != NULL);
 
-    int next = -1;
+    gnrc_pktsnip_t *pkt;
+    gnrc_mac_tx_neighbor_t *neighbor;
 
     /* If current neighbor pointer is not NULL, it means we have pending packet from last
      * t2u or t2k or bcast to send. In this case, return immediately. */
@@ -1157,46 +1174,21 @@ bool gnrc_gomach_find_next_tx_neighbor(gnrc_netif_t *netif)
 
     /* First check whether we have broadcast packet to send. */
     if (gnrc_priority_pktqueue_length(&netif->mac.tx.neighbors[0].queue) > 0) {
-        next = 0;
+        neighbor = &netif->mac.tx.neighbors[0];
+        pkt = gnrc_priority_pktqueue_pop(&neighbor->queue);
     }
     else {
-        /* Find the next neighbor to send data packet to. */
-
-        /* Don't always start checking with ID 0, take turns to check every neighbor's queue,
-         * thus to be more fair. */
-        uint8_t j = netif->mac.tx.last_tx_neighbor_id + 1;
-
-        if (j >= GNRC_MAC_NEIGHBOR_COUNT) {
-            j = 1;
-        }
-
-        for (uint8_t i = 1; i < GNRC_MAC_NEIGHBOR_COUNT; i++) {
-            if (gnrc_priority_pktqueue_length(&netif->mac.tx.neighbors[j].queue) > 0) {
-                netif->mac.tx.last_tx_neighbor_id = j;
-                next = (int) j;
-                break;
-            }
-            else {
-                j++;
-                if (j >= GNRC_MAC_NEIGHBOR_COUNT) {
-                    j = 1;
-                }
-            }
-        }
+        /* Find the next neighbor to send data packet to. Neighbors get their
+         * fair share of transmissions, regardless of their queue lengths. */
+        pkt = gnrc_mac_dequeue_tx_packet(&netif->mac.tx, &neighbor);
     }
 
-    if (next >= 0) {
-        gnrc_pktsnip_t *pkt = gnrc_priority_pktqueue_pop(&netif->mac.tx.neighbors[next].queue);
-        if (pkt != NULL) {
-            netif->mac.tx.packet = pkt;
-            netif->mac.tx.current_neighbor = &netif->mac.tx.neighbors[next];
-            netif->mac.tx.tx_seq = 0;
-            netif->mac.tx.t2u_retry_counter = 0;
-            return true;
-        }
-        else {
-            return false;
-        }
+    if (pkt != NULL) {
+        netif->mac.tx.packet = pkt;
+        netif->mac.tx.current_neighbor = neighbor;
+        netif->mac.tx.tx_seq = 0;
+        netif->mac.tx.t2u_retry_counter = 0;
+        return true;
     }
 
     return false;
@@ -374,6 +374,36 @@ static inline uint32_t _gnrc_lwmac_ticks_until_phase(uint32_t phase)
     return (uint32_t)tmp;
 }
 
+/**
+ * @brief Get the wake-up interval for a wake-up interval shift
+ *
+ * @param[in]   shift    wake-up interval shift
+ *
+ * @return               wake-up interval in RTT ticks
+ */
+static inline uint32_t _gnrc_lwmac_wakeup_interval_ticks(uint8_t shift)
+{
+    return RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US) >> shift;
+}
+
+/**
+ * @brief Calculate how many ticks remaining to the next wake-up of a neighbor
+ *
+ * @param[in]   neighbor    the neighbor
+ *
+ * @return                  RTT ticks
+ */
+static inline uint32_t _gnrc_lwmac_ticks_until_wakeup(const gnrc_mac_tx_neighbor_t *neighbor)
+{
+    uint32_t ticks = _gnrc_lwmac_ticks_until_phase(neighbor->phase);
+
+    /* Unknown phases are kept at the end of the interval */
+    if (neighbor->phase < RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US)) {
+        ticks %= _gnrc_lwmac_wakeup_interval_ticks(neighbor->wakeup_shift);
+    }
+    return ticks;
+}
+
 /**
  * @brief Store the received packet to the dispatch buffer and remove possible
  *        duplicate packets.
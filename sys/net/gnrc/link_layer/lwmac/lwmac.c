@@ -202,12 +202,12 @@ static gnrc_mac_tx_neighbor_t *_next_tx_neighbor(gnrc_netif_t *netif)
     gnrc_mac_tx_neighbor_t *next = NULL;
     uint32_t phase_nearest = GNRC_LWMAC_PHASE_MAX;
 
-    for (unsigned i = 0; i < GNRC_MAC_NEIGHBOR_COUNT; i++) {
+    for (unsigned i = 0; i <= GNRC_MAC_NEIGHBOR_COUNT; i++) {
         if (gnrc_priority_pktqueue_length(&netif->mac.tx.neighbors[i].queue) > 0) {
             /* Unknown destinations are initialized with their phase at the end
              * of the local interval, so known destinations that still wakeup
              * in this interval will be preferred. */
-            uint32_t phase_check = _gnrc_lwmac_ticks_until_phase(netif->mac.tx.neighbors[i].phase);
+            uint32_t phase_check = _gnrc_lwmac_ticks_until_wakeup(&netif->mac.tx.neighbors[i]);
 
             if (phase_check <= phase_nearest) {
                 next = &(netif->mac.tx.neighbors[i]);
@@ -239,6 +239,57 @@ static uint32_t _next_inphase_event(uint32_t last, uint32_t interval)
     return last;
 }
 
+/* Wake-ups of shortened intervals are derived from the last wake-up at the
+ * phase of the full interval, so they don't drift away from the phase
+ * neighbors have locked on */
+static uint32_t _next_wakeup(gnrc_netif_t *netif)
+{
+    gnrc_lwmac_t *lwmac = &netif->mac.prot.lwmac;
+    uint32_t interval = RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US);
+    uint32_t subintervals = 1U << lwmac->wakeup_shift;
+    uint32_t alarm;
+
+    lwmac->base_wakeup = _next_inphase_event(lwmac->base_wakeup, interval) - interval;
+    for (uint32_t i = 1; i < subintervals; i++) {
+        alarm = lwmac->base_wakeup + ((i * interval) >> lwmac->wakeup_shift);
+        if ((int32_t)(alarm - (rtt_get_counter() + GNRC_LWMAC_RTT_EVENT_MARGIN_TICKS)) >= 0) {
+            return alarm;
+        }
+    }
+    return lwmac->base_wakeup + interval;
+}
+
+/* Called at wake-ups at the phase of the full interval */
+static void _adapt_wakeup_interval(gnrc_netif_t *netif)
+{
+    gnrc_lwmac_t *lwmac = &netif->mac.prot.lwmac;
+    unsigned load = lwmac->rx_count;
+
+    for (unsigned i = 0; i <= GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        load += gnrc_priority_pktqueue_length(&netif->mac.tx.neighbors[i].queue);
+    }
+    lwmac->rx_count = 0;
+
+    if (load >= GNRC_LWMAC_WAKEUP_ADAPT_BUSY) {
+        lwmac->idle_count = 0;
+        if (lwmac->wakeup_shift < GNRC_LWMAC_WAKEUP_INTERVAL_SHIFT_MAX) {
+            lwmac->wakeup_shift++;
+            LOG_DEBUG("[LWMAC] Wake-up interval shortened to %" PRIu32 " us\n",
+                      RTT_TICKS_TO_US(_gnrc_lwmac_wakeup_interval_ticks(lwmac->wakeup_shift)));
+        }
+    }
+    else if (load > 0) {
+        lwmac->idle_count = 0;
+    }
+    else if ((lwmac->wakeup_shift > 0) &&
+             (++lwmac->idle_count >= GNRC_LWMAC_WAKEUP_ADAPT_IDLE)) {
+        lwmac->idle_count = 0;
+        lwmac->wakeup_shift--;
+        LOG_DEBUG("[LWMAC] Wake-up interval relaxed to %" PRIu32 " us\n",
+                  RTT_TICKS_TO_US(_gnrc_lwmac_wakeup_interval_ticks(lwmac->wakeup_shift)));
+    }
+}
+
 inline void lwmac_schedule_update(gnrc_netif_t *netif)
 {
     gnrc_lwmac_set_reschedule(netif, true);
@@ -308,8 +359,11 @@ void lwmac_set_state(gnrc_netif_t *netif, gnrc_lwmac_state_t newstate)
                 LOG_WARNING("WARNING: [LWMAC] phase backoffed: %lu us\n",
                             (unsigned long)RTT_TICKS_TO_US(alarm));
                 netif->mac.prot.lwmac.last_wakeup = netif->mac.prot.lwmac.last_wakeup + alarm;
-                alarm = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup,
-                                            RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
+                /* New phase of the full interval, one interval back to be
+                 * in the past */
+                netif->mac.prot.lwmac.base_wakeup = netif->mac.prot.lwmac.last_wakeup -
+                                                    RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US);
+                alarm = _next_wakeup(netif);
                 rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING);
             }
 
@@ -393,12 +447,13 @@ static void _sleep_management(gnrc_netif_t *netif)
 
             /* Offset in microseconds when the earliest (phase) destination
              * node wakes up that we have packets for. */
-            uint32_t time_until_tx = RTT_TICKS_TO_US(_gnrc_lwmac_ticks_until_phase(neighbour->phase));
+            uint32_t time_until_tx = RTT_TICKS_TO_US(_gnrc_lwmac_ticks_until_wakeup(neighbour));
 
             /* If there's not enough time to prepare a WR to catch the phase
              * postpone to next interval */
             if (time_until_tx < GNRC_LWMAC_WR_PREPARATION_US) {
-                time_until_tx += GNRC_LWMAC_WAKEUP_INTERVAL_US;
+                time_until_tx += RTT_TICKS_TO_US(
+                    _gnrc_lwmac_wakeup_interval_ticks(neighbour->wakeup_shift));
             }
             time_until_tx -= GNRC_LWMAC_WR_PREPARATION_US;
 
@@ -451,7 +506,7 @@ static void _rx_management_failed(gnrc_netif_t *netif)
         phase = phase - netif->mac.prot.lwmac.last_wakeup;
     }
     /* If the relative phase is beyond 4/5 cycle time, go to sleep. */
-    if (phase > (4 * RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US) / 5)) {
+    if (phase > (4 * _gnrc_lwmac_wakeup_interval_ticks(netif->mac.prot.lwmac.wakeup_shift) / 5)) {
         gnrc_lwmac_set_quit_rx(netif, true);
     }
 
@@ -468,6 +523,9 @@ static void _rx_management_success(gnrc_netif_t *netif)
 {
     LOG_DEBUG("[LWMAC] Reception was successful\n");
     gnrc_lwmac_rx_stop(netif);
+    if (netif->mac.prot.lwmac.rx_count < UINT8_MAX) {
+        netif->mac.prot.lwmac.rx_count++;
+    }
     /* Dispatch received packets, timing is not critical anymore */
     gnrc_mac_dispatch(&netif->mac.rx);
 
@@ -482,7 +540,7 @@ static void _rx_management_success(gnrc_netif_t *netif)
         phase = phase - netif->mac.prot.lwmac.last_wakeup;
     }
     /* If the relative phase is beyond 4/5 cycle time, go to sleep. */
-    if (phase > (4 * RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US) / 5)) {
+    if (phase > (4 * _gnrc_lwmac_wakeup_interval_ticks(netif->mac.prot.lwmac.wakeup_shift) / 5)) {
         gnrc_lwmac_set_quit_rx(netif, true);
     }
 
@@ -701,6 +759,12 @@ void rtt_handler(uint32_t event, gnrc_netif_t *netif)
         case GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING: {
             /* A new cycle starts, set sleep timing and initialize related MAC-info flags. */
             netif->mac.prot.lwmac.last_wakeup = rtt_get_alarm();
+            netif->mac.prot.lwmac.wakeup_count++;
+            if ((netif->mac.prot.lwmac.last_wakeup - netif->mac.prot.lwmac.base_wakeup) ==
+                RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US)) {
+                netif->mac.prot.lwmac.base_wakeup = netif->mac.prot.lwmac.last_wakeup;
+                _adapt_wakeup_interval(netif);
+            }
             alarm = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup,
                                         RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_DURATION_US));
             rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_SLEEP_PENDING);
@@ -713,8 +777,7 @@ void rtt_handler(uint32_t event, gnrc_netif_t *netif)
         }
         case GNRC_LWMAC_EVENT_RTT_SLEEP_PENDING: {
             /* Set next wake-up timing. */
-            alarm = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup,
-                                        RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
+            alarm = _next_wakeup(netif);
             rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING);
             lwmac_set_state(netif, GNRC_LWMAC_SLEEPING);
             break;
@@ -738,8 +801,7 @@ void rtt_handler(uint32_t event, gnrc_netif_t *netif)
         case GNRC_LWMAC_EVENT_RTT_RESUME: {
             LOG_DEBUG("[LWMAC] RTT: Resume duty cycling\n");
             rtt_clear_alarm();
-            alarm = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup,
-                                        RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
+            alarm = _next_wakeup(netif);
             rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING);
             gnrc_lwmac_set_dutycycle_active(netif, true);
             break;
@@ -933,11 +995,12 @@ static void _lwmac_init(gnrc_netif_t *netif)
     /* Start duty cycling */
     lwmac_set_state(netif, GNRC_LWMAC_START);
 
-#if (GNRC_LWMAC_ENABLE_DUTYCYLE_RECORD == 1)
-    /* Start duty cycle recording */
-    netif->mac.prot.lwmac.system_start_time_ticks = rtt_get_counter();
-    netif->mac.prot.lwmac.last_radio_on_time_ticks = netif->mac.prot.lwmac.system_start_time_ticks;
+    /* Start radio on-time recording */
+    netif->mac.prot.lwmac.last_radio_on_time_ticks = rtt_get_counter();
     netif->mac.prot.lwmac.awake_duration_sum_ticks = 0;
     netif->mac.prot.lwmac.lwmac_info |= GNRC_LWMAC_RADIO_IS_ON;
+#if (GNRC_LWMAC_ENABLE_DUTYCYLE_RECORD == 1)
+    netif->mac.prot.lwmac.system_start_time_ticks =
+        netif->mac.prot.lwmac.last_radio_on_time_ticks;
 #endif
 }
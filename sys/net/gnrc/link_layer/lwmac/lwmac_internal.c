@@ -155,6 +155,11 @@ int _gnrc_lwmac_parse_packet(gnrc_pktsnip_t *pkt, gnrc_lwmac_packet_info_t *info
         }
     }
 
+    if (lwmac_snip == NULL) {
+        /* Frame shorter than its header */
+        return -3;
+    }
+
     /* Memory location may have changed while marking */
     lwmac_hdr = lwmac_snip->data;
 
@@ -191,7 +196,6 @@ void _gnrc_lwmac_set_netdev_state(gnrc_netif_t *netif, netopt_state_t devstate)
                             &devstate,
                             sizeof(devstate));
 
-#if (GNRC_LWMAC_ENABLE_DUTYCYLE_RECORD == 1)
     if (devstate == NETOPT_STATE_IDLE) {
         if (!(netif->mac.prot.lwmac.lwmac_info & GNRC_LWMAC_RADIO_IS_ON)) {
             netif->mac.prot.lwmac.last_radio_on_time_ticks = rtt_get_counter();
@@ -199,17 +203,18 @@ void _gnrc_lwmac_set_netdev_state(gnrc_netif_t *netif, netopt_state_t devstate)
         }
         return;
     }
-    else if ((devstate == NETOPT_STATE_SLEEP) &&
+    else if (((devstate == NETOPT_STATE_SLEEP) || (devstate == NETOPT_STATE_OFF)) &&
              (netif->mac.prot.lwmac.lwmac_info & GNRC_LWMAC_RADIO_IS_ON)) {
-        netif->mac.prot.lwmac.radio_off_time_ticks = rtt_get_counter();
+        uint32_t now = rtt_get_counter();
 
+#if (GNRC_LWMAC_ENABLE_DUTYCYLE_RECORD == 1)
+        netif->mac.prot.lwmac.radio_off_time_ticks = now;
+#endif
         netif->mac.prot.lwmac.awake_duration_sum_ticks +=
-            (netif->mac.prot.lwmac.radio_off_time_ticks -
-             netif->mac.prot.lwmac.last_radio_on_time_ticks);
+            (now - netif->mac.prot.lwmac.last_radio_on_time_ticks);
 
         netif->mac.prot.lwmac.lwmac_info &= ~GNRC_LWMAC_RADIO_IS_ON;
     }
-#endif
 }
 
 netopt_state_t _gnrc_lwmac_get_netdev_state(gnrc_netif_t *netif)
@@ -132,6 +132,7 @@ static bool _send_wa(gnrc_netif_t *netif)
     gnrc_lwmac_frame_wa_t lwmac_hdr;
     lwmac_hdr.header.type = GNRC_LWMAC_FRAMETYPE_WA;
     lwmac_hdr.dst_addr = netif->mac.rx.l2_addr;
+    lwmac_hdr.wakeup_shift = netif->mac.prot.lwmac.wakeup_shift;
 
     uint32_t phase_now = _gnrc_lwmac_phase_now();
 
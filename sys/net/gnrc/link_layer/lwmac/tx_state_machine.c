@@ -314,6 +314,9 @@ static uint8_t _packet_process_in_wait_for_wa(gnrc_netif_t *netif)
                 netif->mac.tx.timestamp += RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US);
                 netif->mac.tx.timestamp -= wa_hdr->current_phase;
             }
+            netif->mac.tx.current_neighbor->wakeup_shift =
+                (wa_hdr->wakeup_shift <= GNRC_LWMAC_WAKEUP_INTERVAL_SHIFT_MAX) ?
+                wa_hdr->wakeup_shift : GNRC_LWMAC_WAKEUP_INTERVAL_SHIFT_MAX;
 
             uint32_t own_phase;
             own_phase = _gnrc_lwmac_ticks_to_phase(netif->mac.prot.lwmac.last_wakeup);
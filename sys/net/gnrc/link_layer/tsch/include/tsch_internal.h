@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Internal schedule functions of TSCH
+ */
+
+#ifndef TSCH_INTERNAL_H
+#define TSCH_INTERNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tsch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Gets the channel of a cell in a slot
+ *
+ * @param[in] asn       absolute slot number of the slot
+ * @param[in] choff     channel offset of the cell
+ *
+ * @return  The IEEE 802.15.4 channel
+ */
+uint8_t _gnrc_tsch_channel(uint64_t asn, uint8_t choff);
+
+/**
+ * @brief   Adds a cell to the slotframe
+ *
+ * @param[in] tsch      TSCH state
+ * @param[in] cell      cell to add
+ *
+ * @return  0 on success
+ * @return  -EINVAL for an invalid cell
+ * @return  -ENOMEM if no cell is free
+ */
+int _gnrc_tsch_cell_add(gnrc_tsch_t *tsch, const gnrc_tsch_cell_t *cell);
+
+/**
+ * @brief   Removes all cells at a slot and channel offset
+ *
+ * @param[in] tsch      TSCH state
+ * @param[in] slot      slot offset
+ * @param[in] choff     channel offset
+ *
+ * @return  Number of cells removed
+ */
+int _gnrc_tsch_cell_remove(gnrc_tsch_t *tsch, uint16_t slot, uint8_t choff);
+
+/**
+ * @brief   Checks whether there is a transmit cell to a neighbor
+ *
+ * @param[in] tsch      TSCH state
+ * @param[in] addr      address of the neighbor
+ * @param[in] addr_len  length of @p addr
+ *
+ * @return  true, if a cell has gnrc_tsch_cell_t::addr set to @p addr
+ */
+bool _gnrc_tsch_has_tx_cell(const gnrc_tsch_t *tsch, const uint8_t *addr,
+                            uint8_t addr_len);
+
+/**
+ * @brief   Sets up the minimal cell and the autonomous receive cell
+ *
+ * @param[in] netif     TSCH interface with its long address set
+ */
+void _gnrc_tsch_schedule_init(gnrc_netif_t *netif);
+
+/**
+ * @brief   Installs autonomous transmit cells to the neighbors with queued
+ *          frames and removes those to neighbors without
+ *
+ * @param[in] netif     TSCH interface
+ */
+void _gnrc_tsch_schedule_update(gnrc_netif_t *netif);
+
+/**
+ * @brief   Gets the distance to the next slot with a cell
+ *
+ * @param[in] tsch      TSCH state
+ * @param[in] slot      current slot offset
+ *
+ * @return  Number of slots to the next slot with a cell, between 1 and
+ *          @ref GNRC_TSCH_SLOTFRAME_LEN
+ */
+uint16_t _gnrc_tsch_schedule_next(const gnrc_tsch_t *tsch, uint16_t slot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TSCH_INTERNAL_H */
+/** @} */
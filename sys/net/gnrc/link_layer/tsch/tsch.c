@@ -0,0 +1,894 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Slot engine and network interface of TSCH
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "random.h"
+#include "utlist.h"
+#include "xtimer.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/mac/internal.h"
+#include "net/netdev/ieee802154.h"
+#include "net/gnrc/tsch.h"
+#include "include/tsch_internal.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifndef LOG_LEVEL
+/**
+ * @brief Default log level define
+ */
+#define LOG_LEVEL LOG_WARNING
+#endif
+
+#include "log.h"
+
+/* enhanced beacon payload: dispatch, ASN (5 bytes, little endian) and join
+ * priority */
+#define EB_LEN              (7U)
+
+static void _tsch_init(gnrc_netif_t *netif);
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif);
+static void _tsch_msg_handler(gnrc_netif_t *netif, msg_t *msg);
+
+static const gnrc_netif_ops_t tsch_ops = {
+    .init = _tsch_init,
+    .send = _send,
+    .recv = _recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+    .msg_handler = _tsch_msg_handler,
+};
+
+gnrc_netif_t *gnrc_netif_tsch_create(char *stack, int stacksize,
+                                     char priority, char *name,
+                                     netdev_t *dev)
+{
+    return gnrc_netif_create(stack, stacksize, priority, name, dev,
+                             &tsch_ops);
+}
+
+static gnrc_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
+{
+    gnrc_pktsnip_t *snip;
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN], dst[IEEE802154_LONG_ADDRESS_LEN];
+    int src_len, dst_len;
+    le_uint16_t _pan_tmp;   /* TODO: hand-up PAN IDs to GNRC? */
+
+    dst_len = ieee802154_get_dst(mhr, dst, &_pan_tmp);
+    src_len = ieee802154_get_src(mhr, src, &_pan_tmp);
+    if ((dst_len < 0) || (src_len < 0)) {
+        DEBUG("_make_netif_hdr: unable to get addresses\n");
+        return NULL;
+    }
+    /* allocate space for header */
+    snip = gnrc_netif_hdr_build(src, (size_t)src_len, dst, (size_t)dst_len);
+    if (snip == NULL) {
+        DEBUG("_make_netif_hdr: no space left in packet buffer\n");
+        return NULL;
+    }
+    /* set broadcast flag for broadcast destination */
+    if ((dst_len == 2) && (dst[0] == 0xff) && (dst[1] == 0xff)) {
+        gnrc_netif_hdr_t *hdr = snip->data;
+        hdr->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    }
+    return snip;
+}
+
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    netdev_ieee802154_rx_info_t rx_info;
+    netdev_ieee802154_t *state = (netdev_ieee802154_t *)netif->dev;
+    gnrc_pktsnip_t *pkt = NULL;
+    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+
+    if (bytes_expected > 0) {
+        int nread;
+
+        pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+        if (pkt == NULL) {
+            DEBUG("_recv_ieee802154: cannot allocate pktsnip.\n");
+            /* drop the frame */
+            dev->driver->recv(dev, NULL, bytes_expected, NULL);
+            return NULL;
+        }
+        nread = dev->driver->recv(dev, pkt->data, bytes_expected, &rx_info);
+        if (nread <= 0) {
+            gnrc_pktbuf_release(pkt);
+            return NULL;
+        }
+        if (!(state->flags & NETDEV_IEEE802154_RAW)) {
+            gnrc_pktsnip_t *ieee802154_hdr, *netif_hdr;
+            gnrc_netif_hdr_t *hdr;
+            size_t mhr_len = ieee802154_get_frame_hdr_len(pkt->data);
+
+            if (mhr_len == 0) {
+                DEBUG("_recv_ieee802154: illegally formatted frame received\n");
+                gnrc_pktbuf_release(pkt);
+                return NULL;
+            }
+            nread -= mhr_len;
+            /* mark IEEE 802.15.4 header */
+            ieee802154_hdr = gnrc_pktbuf_mark(pkt, mhr_len, GNRC_NETTYPE_UNDEF);
+            if (ieee802154_hdr == NULL) {
+                DEBUG("_recv_ieee802154: no space left in packet buffer\n");
+                gnrc_pktbuf_release(pkt);
+                return NULL;
+            }
+            netif_hdr = _make_netif_hdr(ieee802154_hdr->data);
+            if (netif_hdr == NULL) {
+                DEBUG("_recv_ieee802154: no space left in packet buffer\n");
+                gnrc_pktbuf_release(pkt);
+                return NULL;
+            }
+
+            hdr = netif_hdr->data;
+
+#ifdef MODULE_L2FILTER
+            if (!l2filter_pass(dev->filter, gnrc_netif_hdr_get_src_addr(hdr),
+                               hdr->src_l2addr_len)) {
+                gnrc_pktbuf_release(pkt);
+                gnrc_pktbuf_release(netif_hdr);
+                DEBUG("_recv_ieee802154: packet dropped by l2filter\n");
+                return NULL;
+            }
+#endif
+
+            hdr->lqi = rx_info.lqi;
+            hdr->rssi = rx_info.rssi;
+            hdr->if_pid = thread_getpid();
+            pkt->type = state->proto;
+            gnrc_pktbuf_remove_snip(pkt, ieee802154_hdr);
+            LL_APPEND(pkt, netif_hdr);
+        }
+
+        DEBUG("_recv_ieee802154: reallocating.\n");
+        gnrc_pktbuf_realloc_data(pkt, nread);
+    }
+
+    return pkt;
+}
+
+static int _transmit(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    netdev_t *dev = netif->dev;
+    netdev_ieee802154_t *state = (netdev_ieee802154_t *)netif->dev;
+    gnrc_netif_hdr_t *netif_hdr;
+    const uint8_t *dst;
+    int res = 0;
+    size_t dst_len;
+    uint8_t mhr[IEEE802154_MAX_HDR_LEN];
+    uint8_t flags = (uint8_t)(state->flags & NETDEV_IEEE802154_SEND_MASK);
+    le_uint16_t dev_pan = byteorder_btols(byteorder_htons(state->pan));
+
+    flags |= IEEE802154_FCF_TYPE_DATA;
+    netif_hdr = pkt->data;
+    /* prepare destination address */
+    if (netif_hdr->flags & /* If any of these flags is set assume broadcast */
+        (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        dst = ieee802154_addr_bcast;
+        dst_len = IEEE802154_ADDR_BCAST_LEN;
+        flags &= ~IEEE802154_FCF_ACK_REQ;
+    }
+    else {
+        dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
+        dst_len = netif_hdr->dst_l2addr_len;
+    }
+    /* time sources are identified by their long address */
+    if ((res = ieee802154_set_frame_hdr(mhr, netif->l2addr,
+                                        netif->l2addr_len,
+                                        dst, dst_len, dev_pan,
+                                        dev_pan, flags, state->seq++)) == 0) {
+        DEBUG("gnrc_tsch: error preparing frame\n");
+        gnrc_pktbuf_release(pkt);
+        return -EINVAL;
+    }
+
+    /* prepare packet for sending */
+    iolist_t iolist = {
+        .iol_next = (iolist_t *)pkt->next,
+        .iol_base = mhr,
+        .iol_len = (size_t)res
+    };
+
+#ifdef MODULE_NETSTATS_L2
+    if (netif_hdr->flags &
+            (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        netif->dev->stats.tx_mcast_count++;
+    }
+    else {
+        netif->dev->stats.tx_unicast_count++;
+    }
+#endif
+    res = dev->driver->send(dev, &iolist);
+
+    /* release old data */
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+static void _radio_set_state(gnrc_netif_t *netif, netopt_state_t state)
+{
+    netif->dev->driver->set(netif->dev, NETOPT_STATE, &state, sizeof(state));
+}
+
+static void _radio_set_channel(gnrc_netif_t *netif, uint8_t channel)
+{
+    uint16_t chan = channel;
+
+    netif->dev->driver->set(netif->dev, NETOPT_CHANNEL, &chan, sizeof(chan));
+}
+
+/* arm a timer for an absolute time, the message carries the ASN it is meant
+ * for, so messages of timers that fired before they were re-armed are
+ * recognized */
+static void _set_timer(gnrc_netif_t *netif, xtimer_t *timer, msg_t *msg,
+                       uint32_t target, uint64_t asn)
+{
+    int32_t offset = (int32_t)(target - xtimer_now_usec());
+
+    msg->content.value = (uint32_t)asn;
+    xtimer_set_msg(timer, (offset > 0) ? (uint32_t)offset : 0, msg,
+                   netif->pid);
+}
+
+static void _set_action(gnrc_netif_t *netif, uint8_t slot_state,
+                        uint32_t offset)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+
+    tsch->slot_state = slot_state;
+    _set_timer(netif, &tsch->action_timer, &tsch->action_msg,
+               tsch->slot_start + offset, tsch->asn);
+}
+
+/* (re-)arm the slot timer for the next slot with a cell */
+static void _schedule_next_slot(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+
+    tsch->skip = _gnrc_tsch_schedule_next(tsch,
+                                          tsch->asn % GNRC_TSCH_SLOTFRAME_LEN);
+    _set_timer(netif, &tsch->slot_timer, &tsch->slot_msg,
+               tsch->slot_start + (tsch->skip * GNRC_TSCH_SLOT_DURATION_US),
+               tsch->asn + tsch->skip);
+}
+
+static void _scan(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+
+    LOG_INFO("gnrc_tsch: scanning for enhanced beacons\n");
+    xtimer_remove(&tsch->slot_timer);
+    xtimer_remove(&tsch->action_timer);
+    netif->mac.tx.current_neighbor = NULL;
+    tsch->tx_pkt = NULL;
+    tsch->tx_cell = NULL;
+    tsch->state = GNRC_TSCH_STATE_SCANNING;
+    tsch->slot_state = GNRC_TSCH_SLOT_IDLE;
+    tsch->time_source_len = 0;
+    tsch->asn = 0;
+    _radio_set_channel(netif, _gnrc_tsch_channel(0, 0));
+    _radio_set_state(netif, NETOPT_STATE_IDLE);
+}
+
+static void _start_coordinator(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+
+    LOG_INFO("gnrc_tsch: starting network as PAN coordinator\n");
+    xtimer_remove(&tsch->slot_timer);
+    xtimer_remove(&tsch->action_timer);
+    tsch->state = GNRC_TSCH_STATE_COORDINATOR;
+    tsch->slot_state = GNRC_TSCH_SLOT_IDLE;
+    tsch->join_prio = 0;
+    tsch->time_source_len = 0;
+    tsch->asn = 0;
+    tsch->slot_start = xtimer_now_usec();
+    /* announce the network in the first advertising cell */
+    tsch->last_eb = tsch->slot_start - GNRC_TSCH_EB_PERIOD_US;
+    _radio_set_state(netif, NETOPT_STATE_SLEEP);
+    tsch->skip = 0;
+    _set_timer(netif, &tsch->slot_timer, &tsch->slot_msg, tsch->slot_start, 0);
+}
+
+static gnrc_pktsnip_t *_build_eb(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_pktsnip_t *pkt, *hdr;
+    uint8_t *eb;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, EB_LEN, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)hdr->data)->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    LL_PREPEND(pkt, hdr);
+    eb = pkt->next->data;
+    eb[0] = GNRC_TSCH_EB_DISPATCH;
+    for (unsigned i = 0; i < 5; i++) {
+        eb[1 + i] = (uint8_t)(tsch->asn >> (8 * i));
+    }
+    eb[6] = tsch->join_prio;
+    return pkt;
+}
+
+static gnrc_mac_tx_neighbor_t *_neighbor(gnrc_netif_t *netif,
+                                         const uint8_t *addr, uint8_t addr_len)
+{
+    gnrc_mac_tx_neighbor_t *neighbors = netif->mac.tx.neighbors;
+
+    for (unsigned i = 1; i <= GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        if ((neighbors[i].l2_addr_len == addr_len) &&
+            (memcmp(neighbors[i].l2_addr, addr, addr_len) == 0)) {
+            return &neighbors[i];
+        }
+    }
+    return NULL;
+}
+
+/* pick the frame for this slot, the frame stays in its queue until it was
+ * acknowledged or ran out of retries */
+static gnrc_pktsnip_t *_select_tx(gnrc_netif_t *netif, uint16_t slot)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_mac_tx_neighbor_t *neighbors = netif->mac.tx.neighbors;
+
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        gnrc_tsch_cell_t *cell = &tsch->cells[i];
+        gnrc_mac_tx_neighbor_t *neighbor;
+        gnrc_pktsnip_t *pkt;
+
+        if (!(cell->flags & GNRC_TSCH_CELL_TX) || (cell->slot != slot)) {
+            continue;
+        }
+        if ((cell->flags & GNRC_TSCH_CELL_SHARED) && (tsch->backoff > 0)) {
+            tsch->backoff--;
+            continue;
+        }
+        tsch->tx_cell = cell;
+        if (cell->addr_len) {
+            neighbor = _neighbor(netif, cell->addr, cell->addr_len);
+            if (neighbor &&
+                (pkt = gnrc_priority_pktqueue_head(&neighbor->queue))) {
+                netif->mac.tx.current_neighbor = neighbor;
+                return pkt;
+            }
+            continue;
+        }
+        /* cell to any neighbor: broadcasts first, then beacons, then
+         * unicasts without a cell of their own */
+        if ((pkt = gnrc_priority_pktqueue_head(&neighbors[0].queue))) {
+            netif->mac.tx.current_neighbor = &neighbors[0];
+            return pkt;
+        }
+        if ((cell->flags & GNRC_TSCH_CELL_ADV) &&
+            ((xtimer_now_usec() - tsch->last_eb) >= GNRC_TSCH_EB_PERIOD_US) &&
+            (pkt = _build_eb(netif))) {
+            netif->mac.tx.current_neighbor = NULL;
+            return pkt;
+        }
+        for (unsigned j = 1; j <= GNRC_MAC_NEIGHBOR_COUNT; j++) {
+            neighbor = &neighbors[j];
+            if (neighbor->l2_addr_len &&
+                !_gnrc_tsch_has_tx_cell(tsch, neighbor->l2_addr,
+                                        neighbor->l2_addr_len) &&
+                (pkt = gnrc_priority_pktqueue_head(&neighbor->queue))) {
+                netif->mac.tx.current_neighbor = neighbor;
+                return pkt;
+            }
+        }
+    }
+    tsch->tx_cell = NULL;
+    return NULL;
+}
+
+static bool _has_rx_cell(gnrc_tsch_t *tsch, uint16_t slot)
+{
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        if ((tsch->cells[i].flags & GNRC_TSCH_CELL_RX) &&
+            (tsch->cells[i].slot == slot)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint8_t _rx_choff(gnrc_tsch_t *tsch, uint16_t slot)
+{
+    /* the minimal cell wins if more than one receive cell is at slot */
+    uint8_t choff = UINT8_MAX;
+
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        if ((tsch->cells[i].flags & GNRC_TSCH_CELL_RX) &&
+            (tsch->cells[i].slot == slot) && (tsch->cells[i].choff < choff)) {
+            choff = tsch->cells[i].choff;
+        }
+    }
+    return choff;
+}
+
+static void _tx_done(gnrc_netif_t *netif, bool success)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_mac_tx_neighbor_t *neighbor = netif->mac.tx.current_neighbor;
+    bool shared = tsch->tx_cell &&
+                  (tsch->tx_cell->flags & GNRC_TSCH_CELL_SHARED);
+
+    _radio_set_state(netif, NETOPT_STATE_SLEEP);
+    tsch->slot_state = GNRC_TSCH_SLOT_IDLE;
+    if (neighbor == NULL) {
+        /* enhanced beacons are not acknowledged */
+        tsch->last_eb = xtimer_now_usec();
+    }
+    else {
+        if (success || (neighbor == netif->mac.tx.neighbors) ||
+            (++neighbor->tsch_retries > GNRC_TSCH_MAX_RETRIES)) {
+            /* the frame might be pushed out of the queue meanwhile */
+            if (gnrc_priority_pktqueue_head(&neighbor->queue) == tsch->tx_pkt) {
+                gnrc_pktbuf_release(gnrc_priority_pktqueue_pop(&neighbor->queue));
+            }
+            if (!success) {
+                DEBUG("gnrc_tsch: dropped frame after %u retries\n",
+                      neighbor->tsch_retries);
+            }
+            neighbor->tsch_retries = 0;
+        }
+        if (success && ((tsch->time_source_len == neighbor->l2_addr_len) &&
+                        (memcmp(tsch->time_source, neighbor->l2_addr,
+                                neighbor->l2_addr_len) == 0))) {
+            /* the acknowledgment keeps us in the network */
+            tsch->last_sync = xtimer_now_usec();
+        }
+    }
+    if (shared && neighbor && (neighbor != netif->mac.tx.neighbors)) {
+        if (success) {
+            tsch->backoff_exp = GNRC_TSCH_MIN_BE;
+            tsch->backoff = 0;
+        }
+        else {
+            if (tsch->backoff_exp < GNRC_TSCH_MAX_BE) {
+                tsch->backoff_exp++;
+            }
+            tsch->backoff = random_uint32_range(0, 1U << tsch->backoff_exp);
+        }
+    }
+    netif->mac.tx.current_neighbor = NULL;
+    tsch->tx_pkt = NULL;
+    tsch->tx_cell = NULL;
+}
+
+static void _slot_start(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_pktsnip_t *pkt;
+    uint16_t slot;
+
+    xtimer_remove(&tsch->action_timer);
+    if (tsch->slot_state == GNRC_TSCH_SLOT_TX_BUSY) {
+        /* the radio never reported the end of the transmission */
+        _tx_done(netif, false);
+    }
+    else if (tsch->slot_state != GNRC_TSCH_SLOT_IDLE) {
+        /* the slot ended before the frame went out or came in */
+        bool loaded = tsch->preload &&
+                      (tsch->slot_state == GNRC_TSCH_SLOT_TX);
+
+        if (tsch->tx_pkt && !loaded &&
+            (netif->mac.tx.current_neighbor == NULL)) {
+            /* beacons are not queued */
+            gnrc_pktbuf_release(tsch->tx_pkt);
+        }
+        netif->mac.tx.current_neighbor = NULL;
+        tsch->tx_pkt = NULL;
+        tsch->tx_cell = NULL;
+        _radio_set_state(netif, NETOPT_STATE_SLEEP);
+    }
+    tsch->slot_start += tsch->skip * GNRC_TSCH_SLOT_DURATION_US;
+    tsch->asn += tsch->skip;
+    tsch->slot_state = GNRC_TSCH_SLOT_IDLE;
+
+    if ((tsch->state == GNRC_TSCH_STATE_JOINED) &&
+        ((tsch->slot_start - tsch->last_sync) > GNRC_TSCH_DESYNC_TIMEOUT_US)) {
+        LOG_WARNING("gnrc_tsch: lost time source\n");
+        _scan(netif);
+        return;
+    }
+    _gnrc_tsch_schedule_update(netif);
+    slot = tsch->asn % GNRC_TSCH_SLOTFRAME_LEN;
+    if ((pkt = _select_tx(netif, slot))) {
+        tsch->tx_pkt = pkt;
+        _radio_set_channel(netif, _gnrc_tsch_channel(tsch->asn,
+                                                     tsch->tx_cell->choff));
+        if (tsch->preload) {
+            _set_action(netif, GNRC_TSCH_SLOT_TX_LOAD,
+                        GNRC_TSCH_TX_OFFSET_US - GNRC_TSCH_TX_DELAY_US -
+                        GNRC_TSCH_TX_LOAD_US);
+        }
+        else {
+            _set_action(netif, GNRC_TSCH_SLOT_TX,
+                        GNRC_TSCH_TX_OFFSET_US - GNRC_TSCH_TX_DELAY_US);
+        }
+    }
+    else if (_has_rx_cell(tsch, slot)) {
+        _radio_set_channel(netif, _gnrc_tsch_channel(tsch->asn,
+                                                     _rx_choff(tsch, slot)));
+        _set_action(netif, GNRC_TSCH_SLOT_RX, GNRC_TSCH_RX_OFFSET_US);
+    }
+    _schedule_next_slot(netif);
+}
+
+static void _slot_action(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+
+    switch (tsch->slot_state) {
+        case GNRC_TSCH_SLOT_TX_LOAD:
+            if (netif->mac.tx.current_neighbor) {
+                /* keep the frame in the queue for retransmissions */
+                gnrc_pktbuf_hold(tsch->tx_pkt, 1);
+            }
+            if (_transmit(netif, tsch->tx_pkt) < 0) {
+                _tx_done(netif, false);
+                break;
+            }
+            _set_action(netif, GNRC_TSCH_SLOT_TX,
+                        GNRC_TSCH_TX_OFFSET_US - GNRC_TSCH_TX_DELAY_US);
+            break;
+        case GNRC_TSCH_SLOT_TX:
+            tsch->slot_state = GNRC_TSCH_SLOT_TX_BUSY;
+            if (tsch->preload) {
+                _radio_set_state(netif, NETOPT_STATE_TX);
+            }
+            else {
+                if (netif->mac.tx.current_neighbor) {
+                    gnrc_pktbuf_hold(tsch->tx_pkt, 1);
+                }
+                if (_transmit(netif, tsch->tx_pkt) < 0) {
+                    _tx_done(netif, false);
+                }
+            }
+            break;
+        case GNRC_TSCH_SLOT_RX:
+            _radio_set_state(netif, NETOPT_STATE_IDLE);
+            _set_action(netif, GNRC_TSCH_SLOT_RX_LISTEN,
+                        GNRC_TSCH_RX_OFFSET_US + GNRC_TSCH_RX_WAIT_US);
+            break;
+        case GNRC_TSCH_SLOT_RX_LISTEN:
+            /* nothing received */
+            _radio_set_state(netif, NETOPT_STATE_SLEEP);
+            tsch->slot_state = GNRC_TSCH_SLOT_IDLE;
+            break;
+        default:
+            break;
+    }
+}
+
+static bool _from_time_source(gnrc_tsch_t *tsch, gnrc_netif_hdr_t *hdr)
+{
+    return (tsch->time_source_len == hdr->src_l2addr_len) &&
+           (memcmp(tsch->time_source, gnrc_netif_hdr_get_src_addr(hdr),
+                   hdr->src_l2addr_len) == 0);
+}
+
+static void _join(gnrc_netif_t *netif, gnrc_netif_hdr_t *hdr,
+                  const uint8_t *eb)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    uint32_t now = xtimer_now_usec();
+
+    if ((hdr->src_l2addr_len != IEEE802154_LONG_ADDRESS_LEN) ||
+        (eb[6] == UINT8_MAX)) {
+        return;
+    }
+    tsch->asn = 0;
+    for (unsigned i = 0; i < 5; i++) {
+        tsch->asn |= ((uint64_t)eb[1 + i]) << (8 * i);
+    }
+    tsch->join_prio = eb[6] + 1;
+    memcpy(tsch->time_source, gnrc_netif_hdr_get_src_addr(hdr),
+           hdr->src_l2addr_len);
+    tsch->time_source_len = hdr->src_l2addr_len;
+    tsch->slot_start = tsch->rx_time - GNRC_TSCH_RX_DELAY_US -
+                       GNRC_TSCH_TX_OFFSET_US;
+    tsch->last_sync = now;
+    /* spread the beacons of the nodes joining at the same time */
+    tsch->last_eb = now - random_uint32_range(0, GNRC_TSCH_EB_PERIOD_US);
+    tsch->backoff = 0;
+    tsch->backoff_exp = GNRC_TSCH_MIN_BE;
+    tsch->state = GNRC_TSCH_STATE_JOINED;
+    tsch->slot_state = GNRC_TSCH_SLOT_IDLE;
+    LOG_INFO("gnrc_tsch: joined network at ASN %lu, join priority %u\n",
+             (unsigned long)tsch->asn, tsch->join_prio);
+    _radio_set_state(netif, NETOPT_STATE_SLEEP);
+    _schedule_next_slot(netif);
+}
+
+static void _resync(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    int32_t drift = (int32_t)(tsch->rx_time - GNRC_TSCH_RX_DELAY_US -
+                              GNRC_TSCH_TX_OFFSET_US - tsch->slot_start);
+
+    tsch->last_sync = xtimer_now_usec();
+    if ((drift != 0) && (drift < (int32_t)(GNRC_TSCH_SLOT_DURATION_US / 2)) &&
+        (drift > -(int32_t)(GNRC_TSCH_SLOT_DURATION_US / 2))) {
+        DEBUG("gnrc_tsch: time correction %" PRId32 " us\n", drift);
+        tsch->slot_start += drift;
+        xtimer_remove(&tsch->slot_timer);
+        _set_timer(netif, &tsch->slot_timer, &tsch->slot_msg,
+                   tsch->slot_start +
+                   (tsch->skip * GNRC_TSCH_SLOT_DURATION_US),
+                   tsch->asn + tsch->skip);
+    }
+}
+
+static void _rx_done(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_pktsnip_t *netif_snip = gnrc_pktsnip_search_type(pkt,
+                                                          GNRC_NETTYPE_NETIF);
+    gnrc_netif_hdr_t *hdr;
+    const uint8_t *eb = pkt->data;
+
+    if (tsch->state != GNRC_TSCH_STATE_SCANNING) {
+        _radio_set_state(netif, NETOPT_STATE_SLEEP);
+        tsch->slot_state = GNRC_TSCH_SLOT_IDLE;
+    }
+    if (netif_snip == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    hdr = netif_snip->data;
+    if ((pkt->size == EB_LEN) && (eb[0] == GNRC_TSCH_EB_DISPATCH)) {
+        if (tsch->state == GNRC_TSCH_STATE_SCANNING) {
+            _join(netif, hdr, eb);
+        }
+        else if (_from_time_source(tsch, hdr)) {
+            _resync(netif);
+        }
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (tsch->state == GNRC_TSCH_STATE_SCANNING) {
+        /* not synchronized */
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (_from_time_source(tsch, hdr)) {
+        _resync(netif);
+    }
+    if (!gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL,
+                                      pkt)) {
+        DEBUG("gnrc_tsch: unable to forward packet of type %i\n", pkt->type);
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static void _tsch_event_cb(netdev_t *dev, netdev_event_t event)
+{
+    gnrc_netif_t *netif = (gnrc_netif_t *) dev->context;
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+
+    if (event == NETDEV_EVENT_ISR) {
+        msg_t msg;
+
+        /* time stamp of the start of frame interrupt */
+        tsch->isr_time = xtimer_now_usec();
+        msg.type = NETDEV_MSG_TYPE_EVENT;
+        msg.content.ptr = (void *) netif;
+
+        if (msg_send(&msg, netif->pid) <= 0) {
+            LOG_WARNING("WARNING: [TSCH] gnrc_netdev: possibly lost interrupt.\n");
+        }
+        return;
+    }
+    DEBUG("gnrc_tsch: event triggered -> %i\n", event);
+    gnrc_netif_acquire(netif);
+    switch (event) {
+        case NETDEV_EVENT_RX_STARTED:
+            tsch->rx_time = tsch->isr_time;
+            if (tsch->slot_state == GNRC_TSCH_SLOT_RX_LISTEN) {
+                tsch->slot_state = GNRC_TSCH_SLOT_RX_BUSY;
+            }
+            break;
+        case NETDEV_EVENT_RX_COMPLETE: {
+            gnrc_pktsnip_t *pkt = netif->ops->recv(netif);
+
+            if (pkt) {
+                _rx_done(netif, pkt);
+            }
+            else if (tsch->state != GNRC_TSCH_STATE_SCANNING) {
+                _radio_set_state(netif, NETOPT_STATE_SLEEP);
+                tsch->slot_state = GNRC_TSCH_SLOT_IDLE;
+            }
+            break;
+        }
+        case NETDEV_EVENT_TX_COMPLETE:
+        case NETDEV_EVENT_TX_COMPLETE_DATA_PENDING:
+            if (tsch->slot_state == GNRC_TSCH_SLOT_TX_BUSY) {
+                _tx_done(netif, true);
+            }
+            break;
+        case NETDEV_EVENT_TX_NOACK:
+        case NETDEV_EVENT_TX_MEDIUM_BUSY:
+            if (tsch->slot_state == GNRC_TSCH_SLOT_TX_BUSY) {
+                _tx_done(netif, false);
+            }
+            break;
+        default:
+            DEBUG("gnrc_tsch: unhandled netdev event: %u\n", event);
+            break;
+    }
+    gnrc_netif_release(netif);
+}
+
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    int res = 0;
+
+    if ((pkt == NULL) || (pkt->type != GNRC_NETTYPE_NETIF)) {
+        DEBUG("gnrc_tsch: first header is not generic netif header\n");
+        if (pkt) {
+            gnrc_pktbuf_release(pkt);
+        }
+        return -EBADMSG;
+    }
+    gnrc_netif_acquire(netif);
+    if (!gnrc_mac_queue_tx_packet(&netif->mac.tx, 0, pkt)) {
+        gnrc_pktbuf_release(pkt);
+        LOG_WARNING("WARNING: [TSCH] TX queue full, drop packet\n");
+        res = -ENOBUFS;
+    }
+    else if (tsch->state != GNRC_TSCH_STATE_SCANNING) {
+        /* the neighbor might get an autonomous cell before the next slot
+         * with a cell */
+        _gnrc_tsch_schedule_update(netif);
+        xtimer_remove(&tsch->slot_timer);
+        _schedule_next_slot(netif);
+    }
+    gnrc_netif_release(netif);
+    return res;
+}
+
+static void _tsch_msg_handler(gnrc_netif_t *netif, msg_t *msg)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+
+    gnrc_netif_acquire(netif);
+    switch (msg->type) {
+        case GNRC_TSCH_MSG_SLOT_START:
+            if ((tsch->state != GNRC_TSCH_STATE_SCANNING) &&
+                (msg->content.value == (uint32_t)(tsch->asn + tsch->skip))) {
+                _slot_start(netif);
+            }
+            break;
+        case GNRC_TSCH_MSG_SLOT_ACTION:
+            if ((tsch->state != GNRC_TSCH_STATE_SCANNING) &&
+                (msg->content.value == (uint32_t)tsch->asn)) {
+                _slot_action(netif);
+            }
+            break;
+        case GNRC_TSCH_MSG_COORDINATOR:
+            _start_coordinator(netif);
+            break;
+        default:
+            DEBUG("gnrc_tsch: unknown message type 0x%04x\n", msg->type);
+            break;
+    }
+    gnrc_netif_release(netif);
+}
+
+static void _tsch_init(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    netopt_enable_t enable = NETOPT_ENABLE;
+    netopt_enable_t disable = NETOPT_DISABLE;
+    uint16_t src_len = IEEE802154_LONG_ADDRESS_LEN;
+    uint8_t retrans = 0;
+
+    dev->event_callback = _tsch_event_cb;
+
+    /* the start of frame interrupt is the time stamp for synchronization */
+    dev->driver->set(dev, NETOPT_RX_START_IRQ, &enable, sizeof(enable));
+    dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable, sizeof(enable));
+    dev->driver->set(dev, NETOPT_SRC_LEN, &src_len, sizeof(src_len));
+    /* retransmissions and backoff happen in later cells */
+    dev->driver->set(dev, NETOPT_RETRANS, &retrans, sizeof(retrans));
+    dev->driver->set(dev, NETOPT_CSMA, &disable, sizeof(disable));
+    tsch->preload = (dev->driver->set(dev, NETOPT_PRELOADING, &enable,
+                                      sizeof(enable)) >= 0);
+
+    netif->l2addr_len = dev->driver->get(dev, NETOPT_ADDRESS_LONG,
+                                         &netif->l2addr,
+                                         IEEE802154_LONG_ADDRESS_LEN);
+
+    tsch->slot_msg.type = GNRC_TSCH_MSG_SLOT_START;
+    tsch->action_msg.type = GNRC_TSCH_MSG_SLOT_ACTION;
+    tsch->tx_pkt = NULL;
+    tsch->tx_cell = NULL;
+    tsch->backoff = 0;
+    tsch->backoff_exp = GNRC_TSCH_MIN_BE;
+    tsch->join_prio = UINT8_MAX;
+    _gnrc_tsch_schedule_init(netif);
+#if GNRC_TSCH_COORDINATOR
+    _start_coordinator(netif);
+#else
+    _scan(netif);
+#endif
+}
+
+int gnrc_tsch_coordinator_start(gnrc_netif_t *netif)
+{
+    msg_t msg = { .type = GNRC_TSCH_MSG_COORDINATOR };
+
+    return (msg_try_send(&msg, netif->pid) > 0) ? 0 : -EBUSY;
+}
+
+int gnrc_tsch_cell_add(gnrc_netif_t *netif, const gnrc_tsch_cell_t *cell)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    int res;
+
+    gnrc_netif_acquire(netif);
+    res = _gnrc_tsch_cell_add(tsch, cell);
+    if ((res == 0) && (tsch->state != GNRC_TSCH_STATE_SCANNING)) {
+        xtimer_remove(&tsch->slot_timer);
+        _schedule_next_slot(netif);
+    }
+    gnrc_netif_release(netif);
+    return res;
+}
+
+int gnrc_tsch_cell_remove(gnrc_netif_t *netif, uint16_t slot, uint8_t choff)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    int res;
+
+    gnrc_netif_acquire(netif);
+    res = _gnrc_tsch_cell_remove(tsch, slot, choff);
+    if ((res > 0) && (tsch->state != GNRC_TSCH_STATE_SCANNING)) {
+        xtimer_remove(&tsch->slot_timer);
+        _schedule_next_slot(netif);
+    }
+    gnrc_netif_release(netif);
+    return res;
+}
+
+uint64_t gnrc_tsch_get_asn(gnrc_netif_t *netif)
+{
+    uint64_t asn;
+
+    gnrc_netif_acquire(netif);
+    asn = netif->mac.prot.tsch.asn;
+    gnrc_netif_release(netif);
+    return asn;
+}
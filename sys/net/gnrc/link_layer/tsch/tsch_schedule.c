@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Slotframe and autonomous scheduling function of TSCH
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/gnrc/mac/types.h"
+#include "include/tsch_internal.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static const uint8_t _hopping_seq[] = GNRC_TSCH_HOPPING_SEQUENCE;
+
+#define HOPPING_SEQ_LEN     (sizeof(_hopping_seq))
+
+/* slot and channel offset of the autonomous cells of a node, slot 0 and
+ * channel offset 0 are left to the minimal cell (see RFC 9033, 3.) */
+static void _auto_cell(gnrc_tsch_cell_t *cell, const uint8_t *addr,
+                       uint8_t addr_len)
+{
+    uint32_t hash = 0;
+
+    for (unsigned i = 0; i < addr_len; i++) {
+        hash = (hash * 31) + addr[i];
+    }
+    cell->slot = 1 + (hash % (GNRC_TSCH_SLOTFRAME_LEN - 1));
+    cell->choff = 1 + ((hash / GNRC_TSCH_SLOTFRAME_LEN) % (HOPPING_SEQ_LEN - 1));
+}
+
+uint8_t _gnrc_tsch_channel(uint64_t asn, uint8_t choff)
+{
+    return _hopping_seq[(asn + choff) % HOPPING_SEQ_LEN];
+}
+
+int _gnrc_tsch_cell_add(gnrc_tsch_t *tsch, const gnrc_tsch_cell_t *cell)
+{
+    if ((cell->slot >= GNRC_TSCH_SLOTFRAME_LEN) ||
+        (cell->addr_len > sizeof(cell->addr)) ||
+        !(cell->flags & (GNRC_TSCH_CELL_TX | GNRC_TSCH_CELL_RX))) {
+        return -EINVAL;
+    }
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        if (tsch->cells[i].flags == 0) {
+            tsch->cells[i] = *cell;
+            DEBUG("gnrc_tsch: cell %u at slot %u, choff %u, flags 0x%02x\n",
+                  i, cell->slot, cell->choff, cell->flags);
+            return 0;
+        }
+    }
+    return -ENOMEM;
+}
+
+int _gnrc_tsch_cell_remove(gnrc_tsch_t *tsch, uint16_t slot, uint8_t choff)
+{
+    int res = 0;
+
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        gnrc_tsch_cell_t *cell = &tsch->cells[i];
+
+        if (cell->flags && (cell->slot == slot) && (cell->choff == choff)) {
+            if (tsch->tx_cell == cell) {
+                tsch->tx_cell = NULL;
+            }
+            cell->flags = 0;
+            res++;
+        }
+    }
+    return res;
+}
+
+bool _gnrc_tsch_has_tx_cell(const gnrc_tsch_t *tsch, const uint8_t *addr,
+                            uint8_t addr_len)
+{
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        const gnrc_tsch_cell_t *cell = &tsch->cells[i];
+
+        if ((cell->flags & GNRC_TSCH_CELL_TX) && (cell->addr_len == addr_len) &&
+            (memcmp(cell->addr, addr, addr_len) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void _gnrc_tsch_schedule_init(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_tsch_cell_t cell = {
+        .slot = 0,
+        .choff = 0,
+        .flags = GNRC_TSCH_CELL_TX | GNRC_TSCH_CELL_RX |
+                 GNRC_TSCH_CELL_SHARED | GNRC_TSCH_CELL_ADV,
+        .addr_len = 0,
+    };
+
+    memset(tsch->cells, 0, sizeof(tsch->cells));
+    _gnrc_tsch_cell_add(tsch, &cell);
+    /* neighbors send to us in the cell derived from our address */
+    _auto_cell(&cell, netif->l2addr, netif->l2addr_len);
+    cell.flags = GNRC_TSCH_CELL_RX | GNRC_TSCH_CELL_AUTO;
+    _gnrc_tsch_cell_add(tsch, &cell);
+}
+
+void _gnrc_tsch_schedule_update(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_mac_tx_neighbor_t *neighbors = netif->mac.tx.neighbors;
+
+    /* drop autonomous cells to neighbors without frames */
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        gnrc_tsch_cell_t *cell = &tsch->cells[i];
+        bool queued = false;
+
+        if ((cell->flags & (GNRC_TSCH_CELL_AUTO | GNRC_TSCH_CELL_TX)) !=
+            (GNRC_TSCH_CELL_AUTO | GNRC_TSCH_CELL_TX)) {
+            continue;
+        }
+        for (unsigned j = 1; j <= GNRC_MAC_NEIGHBOR_COUNT; j++) {
+            if ((neighbors[j].l2_addr_len == cell->addr_len) &&
+                (memcmp(neighbors[j].l2_addr, cell->addr,
+                        cell->addr_len) == 0)) {
+                queued = gnrc_priority_pktqueue_length(&neighbors[j].queue);
+                break;
+            }
+        }
+        if (!queued && (tsch->tx_cell != cell)) {
+            cell->flags = 0;
+        }
+    }
+    /* and add them for neighbors that have frames queued */
+    for (unsigned j = 1; j <= GNRC_MAC_NEIGHBOR_COUNT; j++) {
+        gnrc_tsch_cell_t cell;
+
+        if ((neighbors[j].l2_addr_len == 0) ||
+            (gnrc_priority_pktqueue_length(&neighbors[j].queue) == 0) ||
+            _gnrc_tsch_has_tx_cell(tsch, neighbors[j].l2_addr,
+                                   neighbors[j].l2_addr_len)) {
+            continue;
+        }
+        memcpy(cell.addr, neighbors[j].l2_addr, neighbors[j].l2_addr_len);
+        cell.addr_len = neighbors[j].l2_addr_len;
+        cell.flags = GNRC_TSCH_CELL_TX | GNRC_TSCH_CELL_SHARED |
+                     GNRC_TSCH_CELL_AUTO;
+        _auto_cell(&cell, cell.addr, cell.addr_len);
+        if (_gnrc_tsch_cell_add(tsch, &cell) < 0) {
+            /* the frames go out in the minimal cell */
+            DEBUG("gnrc_tsch: no cell left for neighbor #%u\n", j);
+            break;
+        }
+    }
+}
+
+uint16_t _gnrc_tsch_schedule_next(const gnrc_tsch_t *tsch, uint16_t slot)
+{
+    uint16_t next = GNRC_TSCH_SLOTFRAME_LEN;
+
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        const gnrc_tsch_cell_t *cell = &tsch->cells[i];
+        uint16_t dist;
+
+        if (cell->flags == 0) {
+            continue;
+        }
+        dist = (cell->slot + GNRC_TSCH_SLOTFRAME_LEN - slot) %
+               GNRC_TSCH_SLOTFRAME_LEN;
+        if (dist == 0) {
+            dist = GNRC_TSCH_SLOTFRAME_LEN;
+        }
+        if (dist < next) {
+            next = dist;
+        }
+    }
+    return next;
+}
@@ -23,6 +23,9 @@
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
+#ifdef MODULE_GNRC_NETIF_SHARED
+#include "net/gnrc/netif/shared.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -50,6 +53,11 @@ static inline int _get_set(kernel_pid_t pid, uint16_t type,
     o.context = context;
     o.data = data;
     o.data_len = data_len;
+#ifdef MODULE_GNRC_NETIF_SHARED
+    if (gnrc_netif_shared_is(pid)) {
+        return gnrc_netif_shared_get_set(pid, type, &o);
+    }
+#endif
     /* set outgoing message's fields */
     cmd.type = type;
     cmd.content.ptr = (void *)&o;
@@ -63,6 +71,13 @@ static inline int _get_set(kernel_pid_t pid, uint16_t type,
 static inline int _snd_rcv(kernel_pid_t pid, uint16_t type, gnrc_pktsnip_t *pkt)
 {
     msg_t msg;
+#ifdef MODULE_GNRC_NETIF_SHARED
+    if (gnrc_netif_shared_is(pid)) {
+        /* the interfaces of the shared thread only send */
+        return (type == GNRC_NETAPI_MSG_TYPE_SND) ?
+               gnrc_netif_shared_send(pid, pkt) : -1;
+    }
+#endif
     /* set the outgoing message's fields */
     msg.type = type;
     msg.content.ptr = (void *)pkt;
@@ -79,6 +94,13 @@ static inline int _snd_rcv(kernel_pid_t pid, uint16_t type, gnrc_pktsnip_t *pkt)
 static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt)
 {
     msg_t msg;
+    /* packets waiting in the mbox of a sock count against its quota */
+    if ((type == GNRC_NETAPI_MSG_TYPE_RCV) &&
+        (gnrc_pktbuf_set_class(pkt, GNRC_PKTBUF_CLASS_SOCK) < 0)) {
+        DEBUG("gnrc_netapi: dropped message to %p (sock quota exceeded)\n",
+              (void*)mbox);
+        return 0;
+    }
     /* set the outgoing message's fields */
     msg.type = type;
     msg.content.ptr = (void *)pkt;
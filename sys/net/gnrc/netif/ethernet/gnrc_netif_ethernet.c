@@ -20,6 +20,7 @@
 #include "net/ethernet/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/netif/ethernet.h"
+#include "net/gnrc/pktcap.h"
 #ifdef MODULE_GNRC_IPV6
 #include "net/ipv6/hdr.h"
 #endif
@@ -151,6 +152,7 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         dev->stats.tx_unicast_count++;
     }
 #endif
+    gnrc_pktcap_frame(netif, &iolist, true);
     res = dev->driver->send(dev, &iolist);
 
     gnrc_pktbuf_release(pkt);
@@ -162,9 +164,57 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
 {
     netdev_t *dev = netif->dev;
     int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
-    gnrc_pktsnip_t *pkt = NULL;
+    gnrc_pktsnip_t *pkt = NULL, *eth_hdr = NULL;
+    int nread;
+
+    if ((bytes_expected > (int)sizeof(ethernet_hdr_t)) &&
+        (dev->driver->recv_iolist != NULL)) {
+        /* read header and payload directly into separate snips, so the
+         * payload does not need to be split off the header afterwards */
+        eth_hdr = gnrc_pktbuf_add(NULL, NULL, sizeof(ethernet_hdr_t),
+                                  GNRC_NETTYPE_UNDEF);
+        pkt = gnrc_pktbuf_add(NULL, NULL,
+                              bytes_expected - sizeof(ethernet_hdr_t),
+                              GNRC_NETTYPE_UNDEF);
+        if (!eth_hdr || !pkt) {
+            DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+            gnrc_pktbuf_release(eth_hdr);
+            gnrc_pktbuf_release(pkt);
+            pkt = NULL;
+
+            /* drop the packet */
+            dev->driver->recv(dev, NULL, bytes_expected, NULL);
 
-    if (bytes_expected > 0) {
+            goto out;
+        }
+
+        iolist_t payload = {
+            .iol_next = NULL,
+            .iol_base = pkt->data,
+            .iol_len = pkt->size,
+        };
+        iolist_t iolist = {
+            .iol_next = &payload,
+            .iol_base = eth_hdr->data,
+            .iol_len = eth_hdr->size,
+        };
+        nread = dev->driver->recv_iolist(dev, &iolist, NULL);
+        if (nread <= (int)sizeof(ethernet_hdr_t)) {
+            DEBUG("gnrc_netif_ethernet: read error.\n");
+            gnrc_pktbuf_release(eth_hdr);
+            goto safe_out;
+        }
+
+        if (nread < bytes_expected) {
+            DEBUG("gnrc_netif_ethernet: reallocating.\n");
+            gnrc_pktbuf_realloc_data(pkt, nread - sizeof(ethernet_hdr_t));
+        }
+        payload.iol_base = pkt->data;
+        payload.iol_len = pkt->size;
+        gnrc_pktcap_frame(netif, &iolist, false);
+        LL_APPEND(pkt, eth_hdr);
+    }
+    else if (bytes_expected > 0) {
         pkt = gnrc_pktbuf_add(NULL, NULL,
                               bytes_expected,
                               GNRC_NETTYPE_UNDEF);
@@ -178,7 +228,7 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             goto out;
         }
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+        nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
         if (nread <= 0) {
             DEBUG("gnrc_netif_ethernet: read error.\n");
             goto safe_out;
@@ -191,14 +241,21 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             DEBUG("gnrc_netif_ethernet: reallocating.\n");
             gnrc_pktbuf_realloc_data(pkt, nread);
         }
+#ifdef MODULE_GNRC_PKTCAP
+        iolist_t frame = { .iol_next = NULL, .iol_base = pkt->data,
+                           .iol_len = pkt->size };
+        gnrc_pktcap_frame(netif, &frame, false);
+#endif
 
         /* mark ethernet header */
-        gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
+        eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
         if (!eth_hdr) {
             DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
             goto safe_out;
         }
+    }
 
+    if (pkt) {
         ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
 
 #ifdef MODULE_L2FILTER
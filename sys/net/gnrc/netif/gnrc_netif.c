@@ -28,24 +28,72 @@
 #ifdef MODULE_NETSTATS_IPV6
 #include "net/netstats.h"
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+#include "net/gnrc/sixlowpan/iphc.h"
+#endif
+#ifdef MODULE_GNRC_NETIF_ETX
+#include "net/gnrc/netif/etx.h"
+#endif
+#ifdef MODULE_GNRC_NETIF_ISR_FLAG
+#include "event/wait_multi.h"
+#endif
+#ifdef MODULE_GNRC_PKTTRACE
+#include "xtimer.h"
+#endif
+#ifdef MODULE_GNRC_NETIF_SHARED
+#include "kernel_defines.h"
+#include "mutex.h"
+#endif
 #include "fmt.h"
+#include "irq.h"
 #include "log.h"
 #include "sched.h"
 
 #include "net/gnrc/netif.h"
 #include "net/gnrc/netif/internal.h"
+#include "net/gnrc/pkttrace.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
 #define _NETIF_NETAPI_MSG_QUEUE_SIZE    (8)
 
+/* run the RX path from fast memory with fastmem_gnrc_netif */
+#ifdef MODULE_FASTMEM_GNRC_NETIF
+#define _NETIF_FASTCODE                 FASTCODE
+#else
+#define _NETIF_FASTCODE
+#endif
+
+#ifdef MODULE_GNRC_NETIF_ISR_FLAG
+/* set by the netdev ISR instead of sending a message */
+#define _NETIF_THREAD_FLAG_ISR          (1u << 1)
+#endif
+
 static gnrc_netif_t _netifs[GNRC_NETIF_NUMOF];
 
+#ifdef MODULE_GNRC_NETIF_SINGLE
+/* the only interface, NULL until it was created */
+static inline gnrc_netif_t *_single(void)
+{
+    return (_netifs[0].ops != NULL) ? &_netifs[0] : NULL;
+}
+#endif
+
+#ifdef MODULE_GNRC_NETIF_SHARED
+static event_queue_t _shared_queue;
+static char _shared_stack[GNRC_NETIF_SHARED_STACKSIZE];
+static kernel_pid_t _shared_pid = KERNEL_PID_UNDEF;
+#endif
+
 static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void _configure_netdev(netdev_t *dev);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
+static void _isr(gnrc_netif_t *netif);
+#ifdef MODULE_GNRC_NETIF_SHARED
+static void _shared_create(gnrc_netif_t *netif);
+#endif
 
 gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, char priority,
                                 const char *name, netdev_t *netdev,
@@ -67,6 +115,16 @@ gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, char priority,
     netif->ops = ops;
     assert(netif->dev == NULL);
     netif->dev = netdev;
+#ifdef MODULE_GNRC_NETIF_SHARED
+    if (stack == NULL) {
+        (void)stacksize;
+        (void)priority;
+        (void)name;
+        (void)res;
+        _shared_create(netif);
+        return netif;
+    }
+#endif
     res = thread_create(stack, stacksize, priority, THREAD_CREATE_STACKTEST,
                         _gnrc_netif_thread, (void *)netif, name);
     (void)res;
@@ -76,6 +134,9 @@ gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, char priority,
 
 unsigned gnrc_netif_numof(void)
 {
+#ifdef MODULE_GNRC_NETIF_SINGLE
+    return (_single() != NULL);
+#else
     gnrc_netif_t *netif = NULL;
     unsigned res = 0;
 
@@ -85,11 +146,15 @@ unsigned gnrc_netif_numof(void)
         }
     }
     return res;
+#endif
 }
 
 gnrc_netif_t *gnrc_netif_iter(const gnrc_netif_t *prev)
 {
     assert((prev == NULL) || (prev >= _netifs));
+#ifdef MODULE_GNRC_NETIF_SINGLE
+    return (prev == NULL) ? _single() : NULL;
+#else
     for (const gnrc_netif_t *netif = (prev == NULL) ? _netifs : (prev + 1);
          netif < (_netifs + GNRC_NETIF_NUMOF); netif++) {
         if (netif->ops != NULL) {
@@ -98,6 +163,7 @@ gnrc_netif_t *gnrc_netif_iter(const gnrc_netif_t *prev)
         }
     }
     return NULL;
+#endif
 }
 
 int gnrc_netif_get_from_netdev(gnrc_netif_t *netif, gnrc_netapi_opt_t *opt)
@@ -358,6 +424,11 @@ int gnrc_netif_set_from_netdev(gnrc_netif_t *netif,
 
 gnrc_netif_t *gnrc_netif_get_by_pid(kernel_pid_t pid)
 {
+#ifdef MODULE_GNRC_NETIF_SINGLE
+    gnrc_netif_t *netif = _single();
+
+    return ((netif != NULL) && (netif->pid == pid)) ? netif : NULL;
+#else
     gnrc_netif_t *netif = NULL;
 
     while ((netif = gnrc_netif_iter(netif))) {
@@ -366,8 +437,25 @@ gnrc_netif_t *gnrc_netif_get_by_pid(kernel_pid_t pid)
         }
     }
     return NULL;
+#endif
 }
 
+#ifdef MODULE_GNRC_NETIF_CSUM_OFFLOAD
+bool gnrc_netif_csum_offload_rx(gnrc_pktsnip_t *pkt, unsigned csum)
+{
+    gnrc_pktsnip_t *netif_hdr = gnrc_pktsnip_search_type(pkt,
+                                                         GNRC_NETTYPE_NETIF);
+    gnrc_netif_t *netif;
+
+    if (netif_hdr == NULL) {
+        /* e.g. looped back */
+        return false;
+    }
+    netif = gnrc_netif_get_by_pid(((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid);
+    return (netif != NULL) && (netif->csum_offload_rx & csum);
+}
+#endif
+
 char *gnrc_netif_addr_to_str(const uint8_t *addr, size_t addr_len, char *out)
 {
     char *res = out;
@@ -605,6 +693,7 @@ int gnrc_netif_ipv6_addr_add_internal(gnrc_netif_t *netif,
 #endif /* GNRC_IPV6_NIB_CONF_ARSM */
     netif->ipv6.addrs_flags[idx] = flags;
     memcpy(&netif->ipv6.addrs[idx], addr, sizeof(netif->ipv6.addrs[idx]));
+    gnrc_ipv6_flow_cache_invalidate();
 #ifdef MODULE_GNRC_IPV6_NIB
     if (_get_state(netif, idx) == GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID) {
         void *state = NULL;
@@ -651,6 +740,7 @@ void gnrc_netif_ipv6_addr_remove_internal(gnrc_netif_t *netif,
         if (ipv6_addr_equal(&netif->ipv6.addrs[i], addr)) {
             netif->ipv6.addrs_flags[i] = 0;
             ipv6_addr_set_unspecified(&netif->ipv6.addrs[i]);
+            gnrc_ipv6_flow_cache_invalidate();
         }
         else {
             ipv6_addr_t tmp;
@@ -725,6 +815,13 @@ gnrc_netif_t *gnrc_netif_get_by_ipv6_addr(const ipv6_addr_t *addr)
 
     DEBUG("gnrc_netif: get interface by IPv6 address %s\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
+#ifdef MODULE_GNRC_NETIF_SINGLE
+    netif = _single();
+    if ((netif != NULL) && (_addr_idx(netif, addr) < 0) &&
+        (_group_idx(netif, addr) < 0)) {
+        netif = NULL;
+    }
+#else
     while ((netif = gnrc_netif_iter(netif))) {
         if (_addr_idx(netif, addr) >= 0) {
             break;
@@ -733,11 +830,18 @@ gnrc_netif_t *gnrc_netif_get_by_ipv6_addr(const ipv6_addr_t *addr)
             break;
         }
     }
+#endif
     return netif;
 }
 
 gnrc_netif_t *gnrc_netif_get_by_prefix(const ipv6_addr_t *prefix)
 {
+#ifdef MODULE_GNRC_NETIF_SINGLE
+    gnrc_netif_t *netif = _single();
+
+    return ((netif != NULL) && (_match_to_len(netif, prefix) > 0)) ? netif
+                                                                   : NULL;
+#else
     gnrc_netif_t *netif = NULL, *best_netif = NULL;
     unsigned best_match = 0;
 
@@ -751,6 +855,7 @@ gnrc_netif_t *gnrc_netif_get_by_prefix(const ipv6_addr_t *prefix)
         }
     }
     return best_netif;
+#endif
 }
 
 int gnrc_netif_ipv6_group_join_internal(gnrc_netif_t *netif,
@@ -968,7 +1073,9 @@ static int _create_candidate_set(const gnrc_netif_t *netif,
          *  be included in a candidate set."
          */
         if ((netif->ipv6.addrs_flags[i] == 0) ||
-            gnrc_netif_ipv6_addr_dad_trans(netif, i)) {
+            (gnrc_netif_ipv6_addr_dad_trans(netif, i) &&
+             !(netif->ipv6.addrs_flags[i] &
+               GNRC_NETIF_IPV6_ADDRS_FLAGS_OPTIMISTIC))) {
             continue;
         }
         /* Check if we only want link local addresses */
@@ -1157,6 +1264,10 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif)
     if (res > 0) {
         netif->l2addr_len = res;
     }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    /* compression of addresses derived from the link-layer address changes */
+    gnrc_sixlowpan_iphc_cache_invalidate();
+#endif
 }
 
 static void _init_from_device(gnrc_netif_t *netif)
@@ -1216,6 +1327,20 @@ static void _init_from_device(gnrc_netif_t *netif)
 #endif
             break;
     }
+#ifdef MODULE_GNRC_NETIF_CSUM_OFFLOAD
+    {
+        uint8_t csum;
+
+        if (dev->driver->get(dev, NETOPT_CSUM_OFFLOAD_TX, &csum,
+                             sizeof(csum)) == sizeof(csum)) {
+            netif->csum_offload_tx = csum;
+        }
+        if (dev->driver->get(dev, NETOPT_CSUM_OFFLOAD_RX, &csum,
+                             sizeof(csum)) == sizeof(csum)) {
+            netif->csum_offload_rx = csum;
+        }
+    }
+#endif
     _update_l2addr_from_dev(netif);
 }
 
@@ -1227,7 +1352,8 @@ static void _configure_netdev(netdev_t *dev)
     if (res < 0) {
         DEBUG("gnrc_netif: enable NETOPT_RX_END_IRQ failed: %d\n", res);
     }
-#ifdef MODULE_NETSTATS_L2
+#if defined(MODULE_NETSTATS_L2) || defined(MODULE_GNRC_NETIF_ETX) || \
+    defined(MODULE_GNRC_NETIF_PKTQ)
     res = dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable, sizeof(enable));
     if (res < 0) {
         DEBUG("gnrc_netif: enable NETOPT_TX_END_IRQ failed: %d\n", res);
@@ -1235,22 +1361,59 @@ static void _configure_netdev(netdev_t *dev)
 #endif
 }
 
-static void *_gnrc_netif_thread(void *args)
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
-    gnrc_netapi_opt_t *opt;
-    gnrc_netif_t *netif;
-    netdev_t *dev;
     int res;
-    msg_t reply = { .type = GNRC_NETAPI_MSG_TYPE_ACK };
-    msg_t msg, msg_queue[_NETIF_NETAPI_MSG_QUEUE_SIZE];
+#ifdef MODULE_GNRC_PKTTRACE
+    uint32_t stamp;
+    /* pkt is released by ops->send() */
+    bool traced = gnrc_pkttrace_time(pkt, &stamp);
+#endif
+
+#ifdef MODULE_GNRC_NETIF_ETX
+    gnrc_netif_etx_sending(netif->pid, pkt);
+#endif
+    res = netif->ops->send(netif, pkt);
+#ifdef MODULE_GNRC_PKTTRACE
+    if (traced) {
+        gnrc_pkttrace_record(GNRC_PKTTRACE_TX_NETDEV,
+                             xtimer_now_usec() - stamp);
+    }
+#endif
+    if (res < 0) {
+        DEBUG("gnrc_netif: error sending packet %p (code: %u)\n",
+              (void *)pkt, res);
+    }
+    return res;
+}
+
+#ifdef MODULE_GNRC_NETIF_PKTQ
+static void _send_queued(gnrc_netif_t *netif)
+{
+    gnrc_pktsnip_t *pkt;
+
+    while ((pkt = gnrc_netif_pktq_head(&netif->send_queue))) {
+        /* netif->ops->send() releases the packet, keep it for the case the
+         * device is busy */
+        gnrc_pktbuf_hold(pkt, 1);
+        if (_send(netif, pkt) == -EBUSY) {
+            /* try again on the next event of the device or after a while */
+            xtimer_set_msg(&netif->send_queue.timer, GNRC_NETIF_PKTQ_RETRY_US,
+                           &netif->send_queue.msg, netif->pid);
+            return;
+        }
+        gnrc_pktbuf_release(gnrc_netif_pktq_get(&netif->send_queue));
+    }
+}
+#endif
+
+/* initializes the device and the interface, called by the interface's
+ * thread with the interface acquired */
+static int _init(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    int res;
 
-    DEBUG("gnrc_netif: starting thread %i\n", sched_active_pid);
-    netif = args;
-    gnrc_netif_acquire(netif);
-    dev = netif->dev;
-    netif->pid = sched_active_pid;
-    /* setup the link-layer's message queue */
-    msg_init_queue(msg_queue, _NETIF_NETAPI_MSG_QUEUE_SIZE);
     /* register the event callback with the device driver */
     dev->event_callback = _event_cb;
     dev->context = netif;
@@ -1264,10 +1427,13 @@ static void *_gnrc_netif_thread(void *args)
         netif->dev = NULL;
         dev->event_callback = NULL;
         dev->context = NULL;
-        return NULL;
+        return res;
     }
     _configure_netdev(dev);
     _init_from_device(netif);
+#ifdef MODULE_GNRC_NETIF_PKTQ
+    gnrc_netif_pktq_init(&netif->send_queue);
+#endif
     netif->cur_hl = GNRC_NETIF_DEFAULT_HL;
 #ifdef MODULE_GNRC_IPV6_NIB
     gnrc_ipv6_nib_init_iface(netif);
@@ -1275,26 +1441,77 @@ static void *_gnrc_netif_thread(void *args)
     if (netif->ops->init) {
         netif->ops->init(netif);
     }
+    return 0;
+}
+
+static _NETIF_FASTCODE void *_gnrc_netif_thread(void *args)
+{
+    gnrc_netapi_opt_t *opt;
+    gnrc_netif_t *netif;
+    int res;
+    msg_t reply = { .type = GNRC_NETAPI_MSG_TYPE_ACK };
+    msg_t msg, msg_queue[_NETIF_NETAPI_MSG_QUEUE_SIZE];
+
+    DEBUG("gnrc_netif: starting thread %i\n", sched_active_pid);
+    netif = args;
+    gnrc_netif_acquire(netif);
+    netif->pid = sched_active_pid;
+    /* setup the link-layer's message queue */
+    msg_init_queue(msg_queue, _NETIF_NETAPI_MSG_QUEUE_SIZE);
+    if (_init(netif) < 0) {
+        return NULL;
+    }
     /* now let rest of GNRC use the interface */
     gnrc_netif_release(netif);
 
     while (1) {
+#ifdef MODULE_GNRC_NETIF_PKTQ
+        /* sort all pending packets into the queue before sending any */
+        if (msg_avail() == 0) {
+            _send_queued(netif);
+        }
+#endif
         DEBUG("gnrc_netif: waiting for incoming messages\n");
+#ifdef MODULE_GNRC_NETIF_ISR_FLAG
+        event_wait_multi_t wait;
+
+        if (event_wait_multi(NULL, _NETIF_THREAD_FLAG_ISR,
+                             &wait) == EVENT_WAIT_MULTI_FLAGS) {
+            DEBUG("gnrc_netif: ISR flag set\n");
+            _isr(netif);
+            continue;
+        }
+        msg = wait.msg;
+#else
         msg_receive(&msg);
+#endif
         /* dispatch netdev, MAC and gnrc_netapi messages */
         switch (msg.type) {
             case NETDEV_MSG_TYPE_EVENT:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
-                dev->driver->isr(dev);
+                _isr(netif);
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
-                res = netif->ops->send(netif, msg.content.ptr);
-                if (res < 0) {
-                    DEBUG("gnrc_netif: error sending packet %p (code: %u)\n",
-                          msg.content.ptr, res);
+                gnrc_pkttrace(msg.content.ptr, GNRC_PKTTRACE_TX_NETIF);
+#ifdef MODULE_GNRC_NETIF_PKTQ
+                if ((gnrc_pktbuf_set_class(msg.content.ptr,
+                                           GNRC_PKTBUF_CLASS_TX) < 0) ||
+                    (gnrc_netif_pktq_put(&netif->send_queue,
+                                         msg.content.ptr) < 0)) {
+                    DEBUG("gnrc_netif: send queue full, dropping packet %p\n",
+                          msg.content.ptr);
+                    gnrc_pktbuf_release_error(msg.content.ptr, ENOBUFS);
                 }
+#else
+                _send(netif, msg.content.ptr);
+#endif
+                break;
+#ifdef MODULE_GNRC_NETIF_PKTQ
+            case GNRC_NETIF_PKTQ_DEQUEUE_MSG:
+                /* sent at the beginning of the next iteration */
                 break;
+#endif
             case GNRC_NETAPI_MSG_TYPE_SET:
                 opt = msg.content.ptr;
 #ifdef MODULE_NETOPT
@@ -1352,25 +1569,164 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
-static void _event_cb(netdev_t *dev, netdev_event_t event)
+#ifdef MODULE_GNRC_NETIF_POLL
+/* stops polling, unless the device interrupted in the meantime */
+static bool _poll_stop(gnrc_netif_t *netif)
+{
+    unsigned state = irq_disable();
+    bool irq = netif->poll_irq;
+
+    netif->poll_irq = false;
+    netif->polling = irq;
+    irq_restore(state);
+    return !irq;
+}
+
+static _NETIF_FASTCODE void _isr(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT, .content = { .ptr = netif } };
+
+    while (1) {
+        unsigned budget = GNRC_NETIF_POLL_BUDGET;
+
+        do {
+            netif->poll_rx = 0;
+            dev->driver->isr(dev);
+            if (netif->poll_rx == 0) {
+                if (!netif->polling || _poll_stop(netif)) {
+                    return;
+                }
+                /* interrupted while draining the device: handle it now */
+                continue;
+            }
+            netif->polling = true;
+            netif->poll_irq = false;
+            budget = (netif->poll_rx < budget) ? (budget - netif->poll_rx) : 0;
+        } while (budget > 0);
+        /* let the pending messages through and continue polling after them */
+        DEBUG("gnrc_netif: poll budget exhausted\n");
+#ifdef MODULE_GNRC_NETIF_SHARED
+        if (gnrc_netif_shared_is(netif->pid)) {
+            /* the events of the other interfaces go first */
+            event_post(&_shared_queue, &netif->shared.isr);
+            return;
+        }
+#endif
+        if (msg_send_to_self(&msg) > 0) {
+            return;
+        }
+        /* message queue is full, the messages wait for the next round */
+    }
+}
+#else
+static inline void _isr(gnrc_netif_t *netif)
+{
+    netif->dev->driver->isr(netif->dev);
+}
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+/* drops a received frame before it is read from the device if the packet
+ * buffer is too short of space for it */
+static bool _rx_admit(netdev_t *dev)
+{
+    int bytes = dev->driver->recv(dev, NULL, 0, NULL);
+
+    if ((bytes > 0) &&
+        !gnrc_pktbuf_admit(GNRC_PKTBUF_CLASS_RX,
+                           bytes + GNRC_PKTBUF_RX_HEADROOM)) {
+        DEBUG("gnrc_netif: packet buffer low, dropping %d byte frame\n",
+              bytes);
+        dev->driver->recv(dev, NULL, bytes, NULL);
+        return false;
+    }
+    return true;
+}
+#else
+static inline bool _rx_admit(netdev_t *dev)
+{
+    (void)dev;
+    return true;
+}
+#endif
+
+static _NETIF_FASTCODE void _event_cb(netdev_t *dev, netdev_event_t event)
 {
     gnrc_netif_t *netif = (gnrc_netif_t *) dev->context;
 
     if (event == NETDEV_EVENT_ISR) {
+#ifdef MODULE_GNRC_NETIF_POLL
+        if (netif->polling) {
+            /* the thread calls the driver's isr() anyway */
+            netif->poll_irq = true;
+            return;
+        }
+#endif
+#ifdef MODULE_GNRC_NETIF_SHARED
+        if (gnrc_netif_shared_is(netif->pid)) {
+            /* can't get lost, posting a pending event again does nothing */
+            event_post(&_shared_queue, &netif->shared.isr);
+            return;
+        }
+#endif
+#ifdef MODULE_GNRC_NETIF_ISR_FLAG
+        /* can't get lost, but subsequent interrupts are handled by one
+         * call to the driver's isr() */
+        thread_flags_set((thread_t *)thread_get(netif->pid),
+                         _NETIF_THREAD_FLAG_ISR);
+#else
         msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT,
                       .content = { .ptr = netif } };
 
         if (msg_send(&msg, netif->pid) <= 0) {
             puts("gnrc_netif: possibly lost interrupt.");
         }
+#endif
     }
     else {
         DEBUG("gnrc_netif: event triggered -> %i\n", event);
+#ifdef MODULE_GNRC_NETIF_ETX
+        {
+            uint8_t retries = 0;
+
+            if (((event == NETDEV_EVENT_TX_COMPLETE) ||
+                 (event == NETDEV_EVENT_TX_COMPLETE_DATA_PENDING)) &&
+                (dev->driver->get(dev, NETOPT_TX_RETRIES_NEEDED, &retries,
+                                  sizeof(retries)) < 0)) {
+                /* device does not report retransmissions */
+                retries = 0;
+            }
+            gnrc_netif_etx_tx_done(netif->pid, event, retries);
+        }
+#endif
         switch (event) {
             case NETDEV_EVENT_RX_COMPLETE: {
-                    gnrc_pktsnip_t *pkt = netif->ops->recv(netif);
+#ifdef MODULE_GNRC_PKTTRACE
+                    uint32_t rx_time = xtimer_now_usec();
+#endif
+                    gnrc_pktsnip_t *pkt = _rx_admit(dev) ?
+                                          netif->ops->recv(netif) : NULL;
 
+#ifdef MODULE_GNRC_NETIF_POLL
+                    if (netif->poll_rx < UINT8_MAX) {
+                        netif->poll_rx++;
+                    }
+#endif
+
+                    if (pkt &&
+                        (gnrc_pktbuf_set_class(pkt, GNRC_PKTBUF_CLASS_RX) < 0)) {
+                        DEBUG("gnrc_netif: RX quota exceeded, dropping %p\n",
+                              (void *)pkt);
+                        gnrc_pktbuf_release(pkt);
+                        pkt = NULL;
+                    }
                     if (pkt) {
+#ifdef MODULE_GNRC_PKTTRACE
+                        gnrc_pkttrace_start(pkt, GNRC_PKTTRACE_RX_NETDEV,
+                                            rx_time);
+                        gnrc_pkttrace(pkt, GNRC_PKTTRACE_RX_NETIF);
+#endif
                         _pass_on_packet(pkt);
                     }
                 }
@@ -1392,4 +1748,148 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
         }
     }
 }
+
+#ifdef MODULE_GNRC_NETIF_SHARED
+/* request of gnrc_netif_shared_get_set(), on the stack of the caller */
+typedef struct {
+    event_t super;
+    gnrc_netif_t *netif;
+    gnrc_netapi_opt_t *opt;
+    uint16_t type;
+    int res;
+    mutex_t done;
+} _shared_req_t;
+
+static void *_shared_thread(void *args)
+{
+    (void)args;
+    DEBUG("gnrc_netif: starting shared thread %i\n", sched_active_pid);
+    event_loop(&_shared_queue);
+    /* never reached */
+    return NULL;
+}
+
+static void _shared_isr(event_t *event)
+{
+    _isr(container_of(event, gnrc_netif_t, shared.isr));
+}
+
+/* first handler of gnrc_netif_shared_t::isr */
+static void _shared_init(event_t *event)
+{
+    gnrc_netif_t *netif = container_of(event, gnrc_netif_t, shared.isr);
+
+    gnrc_netif_acquire(netif);
+    if (_init(netif) == 0) {
+        event->handler = _shared_isr;
+    }
+    gnrc_netif_release(netif);
+}
+
+static void _shared_tx(event_t *event)
+{
+    gnrc_netif_t *netif = container_of(event, gnrc_netif_t, shared.tx);
+
+    while (1) {
+        unsigned state = irq_disable();
+        int idx = cib_get(&netif->shared.tx_cib);
+        irq_restore(state);
+
+        if (idx < 0) {
+            return;
+        }
+        gnrc_pkttrace(netif->shared.tx_queue[idx], GNRC_PKTTRACE_TX_NETIF);
+        _send(netif, netif->shared.tx_queue[idx]);
+    }
+}
+
+static void _shared_req(event_t *event)
+{
+    _shared_req_t *req = container_of(event, _shared_req_t, super);
+
+    if (req->type == GNRC_NETAPI_MSG_TYPE_GET) {
+        req->res = req->netif->ops->get(req->netif, req->opt);
+    }
+    else {
+        req->res = req->netif->ops->set(req->netif, req->opt);
+    }
+    mutex_unlock(&req->done);
+}
+
+static gnrc_netif_t *_shared_get(kernel_pid_t pid)
+{
+    gnrc_netif_t *netif = &_netifs[pid - GNRC_NETIF_SHARED_PID_FIRST];
+
+    return (netif->pid == pid) ? netif : NULL;
+}
+
+static void _shared_create(gnrc_netif_t *netif)
+{
+    /* messages beyond netapi can't reach the interface */
+    assert(netif->ops->msg_handler == NULL);
+    if (_shared_pid == KERNEL_PID_UNDEF) {
+        event_queue_init(&_shared_queue);
+        _shared_pid = thread_create(_shared_stack, sizeof(_shared_stack),
+                                    GNRC_NETIF_SHARED_PRIO,
+                                    THREAD_CREATE_STACKTEST |
+                                    THREAD_CREATE_WOUT_YIELD,
+                                    _shared_thread, NULL, "netif");
+        assert(_shared_pid > 0);
+        _shared_queue.waiter = (thread_t *)thread_get(_shared_pid);
+    }
+    netif->pid = GNRC_NETIF_SHARED_PID_FIRST + (netif - _netifs);
+    cib_init(&netif->shared.tx_cib, GNRC_NETIF_SHARED_TX_QUEUE_SIZE);
+    netif->shared.isr.handler = _shared_init;
+    netif->shared.tx.handler = _shared_tx;
+    event_post(&_shared_queue, &netif->shared.isr);
+}
+
+int gnrc_netif_shared_send(kernel_pid_t pid, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_t *netif = _shared_get(pid);
+
+    if (netif == NULL) {
+        return -1;
+    }
+
+    unsigned state = irq_disable();
+    int idx = cib_put(&netif->shared.tx_cib);
+
+    if (idx >= 0) {
+        netif->shared.tx_queue[idx] = pkt;
+    }
+    irq_restore(state);
+    if (idx < 0) {
+        return 0;
+    }
+    event_post(&_shared_queue, &netif->shared.tx);
+    return 1;
+}
+
+int gnrc_netif_shared_get_set(kernel_pid_t pid, uint16_t type,
+                              gnrc_netapi_opt_t *opt)
+{
+    _shared_req_t req = {
+        .super = { .handler = _shared_req },
+        .netif = _shared_get(pid),
+        .opt = opt,
+        .type = type,
+        .done = MUTEX_INIT_LOCKED,
+    };
+
+    if (req.netif == NULL) {
+        return -ENODEV;
+    }
+    if (sched_active_pid == _shared_pid) {
+        /* e.g. a netapi callback of another interface: waiting would block
+         * the thread forever */
+        _shared_req(&req.super);
+    }
+    else {
+        event_post(&_shared_queue, &req.super);
+        mutex_lock(&req.done);
+    }
+    return req.res;
+}
+#endif
 /** @} */
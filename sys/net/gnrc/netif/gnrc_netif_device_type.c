@@ -62,17 +62,22 @@ int gnrc_netif_ipv6_iid_from_addr(const gnrc_netif_t *netif,
                     return -EINVAL;
                 }
 #endif  /* defined(MODULE_NETDEV_IEEE802154) || defined(MODULE_XBEE) */
-#ifdef MODULE_NORDIC_SOFTDEVICE_BLE
+#if defined(MODULE_NORDIC_SOFTDEVICE_BLE) || defined(MODULE_NIMBLE_NETIF)
             case NETDEV_TYPE_BLE:
                 if (addr_len == sizeof(eui64_t)) {
                     memcpy(iid, addr, sizeof(eui64_t));
                     iid->uint8[0] ^= 0x02;
                     return sizeof(eui64_t);
                 }
+                else if (addr_len == sizeof(eui48_t)) {
+                    /* BLE device address, see RFC 7668, section 3.2.2 */
+                    eui48_to_ipv6_iid(iid, (const eui48_t *)addr);
+                    return sizeof(eui64_t);
+                }
                 else {
                     return -EINVAL;
                 }
-#endif  /* MODULE_NORDIC_SOFTDEVICE_BLE */
+#endif  /* defined(MODULE_NORDIC_SOFTDEVICE_BLE) || defined(MODULE_NIMBLE_NETIF) */
 #if defined(MODULE_CC110X) || defined(MODULE_NRFMIN)
             case NETDEV_TYPE_CC110X:
             case NETDEV_TYPE_NRFMIN:
@@ -125,12 +130,16 @@ int gnrc_netif_ipv6_iid_to_addr(const gnrc_netif_t *netif, const eui64_t *iid,
             addr[1] = iid->uint8[7];
             return sizeof(uint16_t);
 #endif  /* MODULE_NETDEV_IEEE802154 */
-#ifdef MODULE_NORDIC_SOFTDEVICE_BLE
+#if defined(MODULE_NORDIC_SOFTDEVICE_BLE) || defined(MODULE_NIMBLE_NETIF)
         case NETDEV_TYPE_BLE:
+            if (netif->l2addr_len == sizeof(eui48_t)) {
+                eui48_from_ipv6_iid((eui48_t *)addr, iid);
+                return sizeof(eui48_t);
+            }
             memcpy(addr, iid, sizeof(eui64_t));
             addr[0] ^= 0x02;
             return sizeof(eui64_t);
-#endif  /* MODULE_NORDIC_SOFTDEVICE_BLE */
+#endif  /* defined(MODULE_NORDIC_SOFTDEVICE_BLE) || defined(MODULE_NIMBLE_NETIF) */
 #ifdef MODULE_CC110X
         case NETDEV_TYPE_CC110X:
             addr[0] = iid->uint8[7];
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/netif/conf.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/etx.h"
+#ifdef MODULE_GNRC_IPV6_NIB
+#include "net/gnrc/ipv6/nib/nc.h"
+#endif
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   ETX estimate of a neighbor
+ */
+typedef struct {
+    uint8_t l2addr[GNRC_NETIF_L2ADDR_MAXLEN];   /**< address of the neighbor */
+    uint8_t l2addr_len;         /**< length of l2addr, 0 if unused */
+    bool pending;               /**< TX status of a frame is outstanding */
+    kernel_pid_t pid;           /**< interface to the neighbor */
+    uint16_t etx;               /**< ETX times GNRC_NETIF_ETX_DIVISOR */
+    uint16_t used;              /**< value of _clock at last update */
+} _etx_t;
+
+static _etx_t _etx[GNRC_NETIF_ETX_NUMOF];
+static uint16_t _clock;
+static mutex_t _mutex = MUTEX_INIT;
+
+static _etx_t *_find(kernel_pid_t pid, const uint8_t *l2addr,
+                     unsigned l2addr_len)
+{
+    for (unsigned i = 0; i < GNRC_NETIF_ETX_NUMOF; i++) {
+        _etx_t *entry = &_etx[i];
+
+        if ((entry->l2addr_len == l2addr_len) && (entry->pid == pid) &&
+            (memcmp(entry->l2addr, l2addr, l2addr_len) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* replaces the least recently updated neighbor, if there is no free entry */
+static _etx_t *_get(kernel_pid_t pid, const uint8_t *l2addr,
+                    unsigned l2addr_len)
+{
+    _etx_t *res = _find(pid, l2addr, l2addr_len);
+
+    if (res == NULL) {
+        res = &_etx[0];
+        for (unsigned i = 0; i < GNRC_NETIF_ETX_NUMOF; i++) {
+            if (_etx[i].l2addr_len == 0) {
+                res = &_etx[i];
+                break;
+            }
+            if ((uint16_t)(_clock - _etx[i].used) >
+                (uint16_t)(_clock - res->used)) {
+                res = &_etx[i];
+            }
+        }
+        memcpy(res->l2addr, l2addr, l2addr_len);
+        res->l2addr_len = l2addr_len;
+        res->pid = pid;
+        res->etx = GNRC_NETIF_ETX_INIT;
+        res->used = _clock;
+    }
+    return res;
+}
+
+static void _clear_pending(kernel_pid_t pid)
+{
+    for (unsigned i = 0; i < GNRC_NETIF_ETX_NUMOF; i++) {
+        if (_etx[i].pid == pid) {
+            _etx[i].pending = false;
+        }
+    }
+}
+
+void gnrc_netif_etx_sending(kernel_pid_t pid, const gnrc_pktsnip_t *pkt)
+{
+    const gnrc_netif_hdr_t *hdr;
+
+    if ((pkt == NULL) || (pkt->type != GNRC_NETTYPE_NETIF)) {
+        return;
+    }
+    hdr = pkt->data;
+    mutex_lock(&_mutex);
+    _clear_pending(pid);
+    if (!(hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                        GNRC_NETIF_HDR_FLAGS_MULTICAST)) &&
+        (hdr->dst_l2addr_len > 0) &&
+        (hdr->dst_l2addr_len <= GNRC_NETIF_L2ADDR_MAXLEN)) {
+        /* cast to non-const is fine, the header is not modified */
+        _get(pid, gnrc_netif_hdr_get_dst_addr((gnrc_netif_hdr_t *)hdr),
+             hdr->dst_l2addr_len)->pending = true;
+    }
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_netif_etx_tx_done(kernel_pid_t pid, netdev_event_t event,
+                            unsigned retries)
+{
+    unsigned tx;
+#ifdef MODULE_GNRC_IPV6_NIB
+    uint8_t l2addr[GNRC_NETIF_L2ADDR_MAXLEN];
+    unsigned l2addr_len = 0;
+#endif
+
+    switch (event) {
+        case NETDEV_EVENT_TX_COMPLETE:
+        case NETDEV_EVENT_TX_COMPLETE_DATA_PENDING:
+            tx = retries + 1;
+            break;
+        case NETDEV_EVENT_TX_NOACK:
+            tx = GNRC_NETIF_ETX_NOACK_PENALTY;
+            break;
+        default:
+            /* e.g. channel access failures tell nothing about the link */
+            return;
+    }
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < GNRC_NETIF_ETX_NUMOF; i++) {
+        _etx_t *entry = &_etx[i];
+
+        if (entry->pending && (entry->pid == pid)) {
+            uint32_t etx = (entry->etx * GNRC_NETIF_ETX_ALPHA) +
+                           (tx * GNRC_NETIF_ETX_DIVISOR *
+                            (100U - GNRC_NETIF_ETX_ALPHA));
+
+            entry->etx = (uint16_t)(etx / 100U);
+            entry->pending = false;
+            entry->used = ++_clock;
+            DEBUG("gnrc_netif_etx: %u transmissions, ETX now %u/%u\n",
+                  tx, entry->etx, GNRC_NETIF_ETX_DIVISOR);
+#ifdef MODULE_GNRC_IPV6_NIB
+            if (event != NETDEV_EVENT_TX_NOACK) {
+                memcpy(l2addr, entry->l2addr, entry->l2addr_len);
+                l2addr_len = entry->l2addr_len;
+            }
+#endif
+            break;
+        }
+    }
+    mutex_unlock(&_mutex);
+#ifdef MODULE_GNRC_IPV6_NIB
+    /* the acknowledgement confirms the neighbor's reachability */
+    if (l2addr_len > 0) {
+        gnrc_ipv6_nib_nc_mark_reachable_l2(pid, l2addr, l2addr_len);
+    }
+#endif
+}
+
+uint16_t gnrc_netif_etx_get(kernel_pid_t pid, const uint8_t *l2addr,
+                            unsigned l2addr_len)
+{
+    const _etx_t *entry;
+    uint16_t res = GNRC_NETIF_ETX_INIT;
+
+    if (l2addr_len == 0) {
+        return res;
+    }
+    mutex_lock(&_mutex);
+    if ((entry = _find(pid, l2addr, l2addr_len)) != NULL) {
+        res = entry->etx;
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+/** @} */
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_netif_pktq
+ * @{
+ *
+ * @file
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+
+#include "net/protnum.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/pktq.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* DSCPs (RFC 2474, RFC 8622) */
+#define DSCP_LE         (1U)
+#define DSCP_CS1        (8U)
+#define DSCP_CS4        (32U)
+#define DSCP_CS6        (48U)
+
+static const uint8_t _limits[GNRC_NETIF_PKTQ_PRIO_NUMOF] =
+    GNRC_NETIF_PKTQ_LIMITS;
+
+/* position of the GNRC_NETIF_HDR_PRIO_* values in the queue, lower first */
+static const uint8_t _order[GNRC_NETIF_PKTQ_PRIO_NUMOF] = {
+    [GNRC_NETIF_HDR_PRIO_CONTROL] = 0,
+    [GNRC_NETIF_HDR_PRIO_EXPEDITED] = 1,
+    [GNRC_NETIF_HDR_PRIO_BEST_EFFORT] = 2,
+    [GNRC_NETIF_HDR_PRIO_BULK] = 3,
+};
+
+static unsigned _prio(gnrc_pktsnip_t *pkt)
+{
+    return ((gnrc_netif_hdr_t *)pkt->data)->flags &
+           GNRC_NETIF_HDR_FLAGS_PRIO_MASK;
+}
+
+static gnrc_priority_pktqueue_node_t *_alloc(gnrc_netif_pktq_t *q)
+{
+    for (unsigned i = 0; i < GNRC_NETIF_PKTQ_SIZE; i++) {
+        if (q->nodes[i].pkt == NULL) {
+            return &q->nodes[i];
+        }
+    }
+    return NULL;
+}
+
+/* the packet of the lowest priority, if that is lower than prio */
+static gnrc_priority_pktqueue_node_t *_victim(const gnrc_netif_pktq_t *q,
+                                              unsigned prio)
+{
+    gnrc_priority_pktqueue_node_t *last;
+
+    last = gnrc_priority_pktqueue_last((gnrc_priority_pktqueue_t *)&q->queue);
+    if ((last == NULL) || (last->priority <= _order[prio])) {
+        return NULL;
+    }
+    return last;
+}
+
+void gnrc_netif_pktq_init(gnrc_netif_pktq_t *q)
+{
+    gnrc_priority_pktqueue_init(&q->queue);
+    for (unsigned i = 0; i < GNRC_NETIF_PKTQ_SIZE; i++) {
+        gnrc_priority_pktqueue_node_init(&q->nodes[i], 0, NULL);
+    }
+    for (unsigned i = 0; i < GNRC_NETIF_PKTQ_PRIO_NUMOF; i++) {
+        q->len[i] = 0;
+        q->dropped[i] = 0;
+    }
+    q->msg.type = GNRC_NETIF_PKTQ_DEQUEUE_MSG;
+}
+
+unsigned gnrc_netif_pktq_ipv6_prio(const ipv6_hdr_t *hdr)
+{
+    unsigned dscp = ipv6_hdr_get_tc_dscp(hdr);
+
+    if (dscp >= DSCP_CS6) {
+        return GNRC_NETIF_HDR_PRIO_CONTROL;
+    }
+    if (dscp >= DSCP_CS4) {
+        return GNRC_NETIF_HDR_PRIO_EXPEDITED;
+    }
+    if ((dscp == DSCP_LE) || (dscp == DSCP_CS1)) {
+        return GNRC_NETIF_HDR_PRIO_BULK;
+    }
+    /* neighbor discovery and routing protocols hardly ever set a DSCP */
+    if ((dscp == 0) && (hdr->nh == PROTNUM_ICMPV6)) {
+        return GNRC_NETIF_HDR_PRIO_CONTROL;
+    }
+    return GNRC_NETIF_HDR_PRIO_BEST_EFFORT;
+}
+
+bool gnrc_netif_pktq_full(const gnrc_netif_pktq_t *q, unsigned prio)
+{
+    unsigned len = 0;
+
+    assert(prio < GNRC_NETIF_PKTQ_PRIO_NUMOF);
+    if (q->len[prio] >= _limits[prio]) {
+        return true;
+    }
+    for (unsigned i = 0; i < GNRC_NETIF_PKTQ_PRIO_NUMOF; i++) {
+        len += q->len[i];
+    }
+    return (len >= GNRC_NETIF_PKTQ_SIZE) && (_victim(q, prio) == NULL);
+}
+
+int gnrc_netif_pktq_put(gnrc_netif_pktq_t *q, gnrc_pktsnip_t *pkt)
+{
+    unsigned prio = _prio(pkt);
+    gnrc_priority_pktqueue_node_t *node;
+
+    if (q->len[prio] >= _limits[prio]) {
+        DEBUG("gnrc_netif_pktq: priority %u at its limit\n", prio);
+        q->dropped[prio]++;
+        return -ENOBUFS;
+    }
+    if ((node = _alloc(q)) == NULL) {
+        gnrc_pktsnip_t *out;
+
+        if ((node = _victim(q, prio)) == NULL) {
+            DEBUG("gnrc_netif_pktq: queue full\n");
+            q->dropped[prio]++;
+            return -ENOBUFS;
+        }
+        out = node->pkt;
+        gnrc_priority_pktqueue_remove(&q->queue, node);
+        DEBUG("gnrc_netif_pktq: pushed out %p of priority %u\n",
+              (void *)out, _prio(out));
+        q->len[_prio(out)]--;
+        q->dropped[_prio(out)]++;
+        gnrc_pktbuf_release_error(out, ENOBUFS);
+    }
+    gnrc_priority_pktqueue_node_init(node, _order[prio], pkt);
+    gnrc_priority_pktqueue_push(&q->queue, node);
+    q->len[prio]++;
+    return 0;
+}
+
+gnrc_pktsnip_t *gnrc_netif_pktq_head(gnrc_netif_pktq_t *q)
+{
+    return gnrc_priority_pktqueue_head(&q->queue);
+}
+
+gnrc_pktsnip_t *gnrc_netif_pktq_get(gnrc_netif_pktq_t *q)
+{
+    gnrc_pktsnip_t *pkt = gnrc_priority_pktqueue_pop(&q->queue);
+
+    if (pkt) {
+        q->len[_prio(pkt)]--;
+    }
+    return pkt;
+}
@@ -15,6 +15,7 @@
 
 #include "net/gnrc.h"
 #include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/pktcap.h"
 #include "net/netdev/ieee802154.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -95,6 +96,11 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             gnrc_pktbuf_release(pkt);
             return NULL;
         }
+#ifdef MODULE_GNRC_PKTCAP
+        iolist_t frame = { .iol_next = NULL, .iol_base = pkt->data,
+                           .iol_len = nread };
+        gnrc_pktcap_frame(netif, &frame, false);
+#endif
         if (netif->flags & GNRC_NETIF_FLAGS_RAWMODE) {
             /* Raw mode, skip packet processing, but provide rx_info via
              * GNRC_NETTYPE_NETIF */
@@ -247,6 +253,7 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         netif->dev->stats.tx_unicast_count++;
     }
 #endif
+    gnrc_pktcap_frame(netif, &iolist, true);
 #ifdef MODULE_GNRC_MAC
     if (netif->mac.mac_info & GNRC_NETIF_MAC_INFO_CSMA_ENABLED) {
         res = csma_sender_csma_ca_send(dev, &iolist, &netif->mac.csma_conf);
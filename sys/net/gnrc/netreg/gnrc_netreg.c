@@ -28,13 +28,24 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#ifdef MODULE_GNRC_NETREG_HASH
+#define _BUCKETS            (GNRC_NETREG_HASH_SIZE)
+#else
+#define _BUCKETS            (1U)
+#endif
+
+/* all entries with the same demux context end up in the same bucket, so
+ * gnrc_netreg_getnext() can just follow the bucket's list */
+#define _BUCKET(demux_ctx)  ((((demux_ctx) >> 16) ^ (demux_ctx)) % _BUCKETS)
+
+/* The registry as lookup table by gnrc_nettype_t (and by hash of the demux
+ * context with gnrc_netreg_hash) */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][_BUCKETS];
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -59,7 +70,7 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    LL_PREPEND(netreg[type][_BUCKET(entry->demux_ctx)], entry);
 
     return 0;
 }
@@ -70,7 +81,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(netreg[type][_BUCKET(entry->demux_ctx)], entry);
 }
 
 /**
@@ -92,7 +103,8 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
     gnrc_netreg_entry_t *res = NULL;
 
     if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
+        gnrc_netreg_entry_t *head = (from) ? from->next :
+                                    netreg[type][_BUCKET(demux_ctx)];
         LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
     }
 
@@ -12,11 +12,14 @@
  * @file
  */
 
+#include <errno.h>
+
 #include "net/gnrc.h"
 
 #include "od.h"
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/icmpv6/echo.h"
+#include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/hdr.h"
 #include "utlist.h"
 
@@ -110,4 +113,66 @@ void gnrc_icmpv6_echo_req_handle(gnrc_netif_t *netif, ipv6_hdr_t *ipv6_hdr,
     }
 }
 
+int gnrc_icmpv6_echo_req_reply(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ipv6 = pkt->next, *netif_snip;
+    icmpv6_echo_t *echo = pkt->data;
+    ipv6_hdr_t *ipv6_hdr;
+    ipv6_addr_t addr;
+    uint32_t csum;
+    msg_t msg;
+
+    /* only for unshared packets without extension headers, that is
+     * ICMPv6 <- IPv6 <- netif, received on an interface */
+    if ((netif == NULL) || (pkt->size < sizeof(icmpv6_echo_t)) ||
+        (pkt->users != 1) || (ipv6 == NULL) ||
+        (ipv6->type != GNRC_NETTYPE_IPV6) || (ipv6->users != 1) ||
+        ((netif_snip = ipv6->next) == NULL) ||
+        (netif_snip->type != GNRC_NETTYPE_NETIF) ||
+        (netif_snip->users != 1) || (netif_snip->next != NULL)) {
+        return -EINVAL;
+    }
+    ipv6_hdr = ipv6->data;
+    if (ipv6_addr_is_multicast(&ipv6_hdr->dst)) {
+        /* the reply needs a unicast source address selected by IPv6 */
+        return -EINVAL;
+    }
+
+    DEBUG("icmpv6_echo: reply in place to id=%" PRIu16 ", seq=%" PRIu16 "\n",
+          byteorder_ntohs(echo->id), byteorder_ntohs(echo->seq));
+    memcpy(&addr, &ipv6_hdr->src, sizeof(addr));
+    memcpy(&ipv6_hdr->src, &ipv6_hdr->dst, sizeof(addr));
+    memcpy(&ipv6_hdr->dst, &addr, sizeof(addr));
+    ipv6_hdr->hl = netif->cur_hl;
+
+    /* patch the checksum for the changed type (RFC 1624), the sum of the
+     * pseudo header is the same for swapped addresses */
+    csum = (uint16_t)~byteorder_ntohs(echo->csum);
+    csum += (uint16_t)~(ICMPV6_ECHO_REQ << 8);
+    csum += (ICMPV6_ECHO_REP << 8);
+    csum = (csum & 0xffff) + (csum >> 16);
+    csum = (csum & 0xffff) + (csum >> 16);
+    echo->type = ICMPV6_ECHO_REP;
+    echo->csum = byteorder_htons(~csum);
+
+    /* only the interface is taken from the netif header */
+    ((gnrc_netif_hdr_t *)netif_snip->data)->if_pid = netif->pid;
+    ((gnrc_netif_hdr_t *)netif_snip->data)->flags = 0;
+
+    /* the snips are not shared, so this only relinks them */
+    pkt = gnrc_pktbuf_reverse_snips(pkt);
+    if (pkt == NULL) {
+        DEBUG("icmpv6_echo: unable to reverse packet\n");
+        return 0;
+    }
+
+    msg.type = GNRC_IPV6_MSG_TYPE_SND_PREPARED;
+    msg.content.ptr = pkt;
+    if (msg_try_send(&msg, gnrc_ipv6_pid) < 1) {
+        DEBUG("icmpv6_echo: unable to hand reply over to IPv6\n");
+        gnrc_pktbuf_release(pkt);
+    }
+    return 0;
+}
+
 /** @} */
@@ -76,17 +76,31 @@ void gnrc_icmpv6_demux(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 
     hdr = (icmpv6_hdr_t *)icmpv6->data;
 
-    if (_calc_csum(icmpv6, ipv6, pkt)) {
+    if (!gnrc_netif_csum_offload_rx(pkt, NETOPT_CSUM_OFFLOAD_ICMPV6) &&
+        _calc_csum(icmpv6, ipv6, pkt)) {
         DEBUG("icmpv6: wrong checksum.\n");
         /* don't release: IPv6 does this */
         return;
     }
 
+    /* NDP, RPL and errors may use the space reserved for the control plane,
+     * echo requests stay with the traffic they came with */
+    if ((hdr->type != ICMPV6_ECHO_REQ) &&
+        (gnrc_pktbuf_set_class(pkt, GNRC_PKTBUF_CLASS_CTRL) < 0)) {
+        DEBUG("icmpv6: control plane quota exceeded.\n");
+        return;
+    }
+
     switch (hdr->type) {
         /* TODO: handle ICMPv6 errors */
 #ifdef MODULE_GNRC_ICMPV6_ECHO
         case ICMPV6_ECHO_REQ:
             DEBUG("icmpv6: handle echo request.\n");
+            if ((gnrc_netreg_num(GNRC_NETTYPE_ICMPV6, ICMPV6_ECHO_REQ) == 0) &&
+                (gnrc_icmpv6_echo_req_reply(netif, pkt) == 0)) {
+                /* nobody else is interested: the request became the reply */
+                return;
+            }
             gnrc_icmpv6_echo_req_handle(netif, (ipv6_hdr_t *)ipv6->data,
                                         (icmpv6_echo_t *)hdr, icmpv6->size);
             break;
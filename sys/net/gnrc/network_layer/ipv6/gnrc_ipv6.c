@@ -18,7 +18,9 @@
 
 #include "byteorder.h"
 #include "cpu_conf.h"
+#include "irq.h"
 #include "kernel_types.h"
+#include "mutex.h"
 #include "net/gnrc.h"
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/sixlowpan/ctx.h"
@@ -31,9 +33,17 @@
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/ipv6/whitelist.h"
 #include "net/gnrc/ipv6/blacklist.h"
+#include "net/gnrc/pkttrace.h"
 
 #include "net/gnrc/ipv6.h"
 
+#ifdef MODULE_GNRC_MPL
+#include "net/gnrc/mpl.h"
+#endif
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+#include "net/gnrc/rpl/srh.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -53,6 +63,11 @@ static char _stack[GNRC_IPV6_STACK_SIZE];
  */
 static fib_entry_t _fib_entries[GNRC_IPV6_FIB_TABLE_SIZE];
 
+/**
+ * @brief buffer to store the index of the IPv6 forwarding table
+ */
+static uint16_t _fib_index[FIB_INDEX_SIZE(GNRC_IPV6_FIB_TABLE_SIZE)];
+
 /**
  * @brief the IPv6 forwarding table
  */
@@ -63,6 +78,34 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 kernel_pid_t gnrc_ipv6_pid = KERNEL_PID_UNDEF;
 
+/**
+ * @brief   Flow cache entry
+ */
+typedef struct {
+    ipv6_addr_t dst;            /**< destination address of the flow */
+    ipv6_addr_t src;            /**< selected source address (or ::) */
+    gnrc_netif_t *netif;        /**< interface to send over (NULL if unused) */
+    unsigned gen;               /**< generation the entry was created in */
+    kernel_pid_t hint;          /**< interface requested by upper layer */
+    uint8_t l2addr_len;         /**< length of _flow_t::l2addr */
+    uint8_t l2addr[GNRC_IPV6_NIB_L2ADDR_MAX_LEN];   /**< next hop's L2 address */
+} _flow_t;
+
+#ifdef MODULE_GNRC_IPV6_FLOW_CACHE
+static _flow_t _flows[GNRC_IPV6_FLOW_CACHE_SIZE];
+static unsigned _flows_next;
+/* bumped by other threads, so entries are invalidated by comparison rather
+ * than by clearing them */
+static volatile unsigned _flow_gen = 1U;
+#endif
+
+#ifdef MODULE_GNRC_IPV6_FAST_FORWARD
+/* the interface threads look entries up while the IPv6 thread adds them */
+static mutex_t _flows_lock = MUTEX_INIT;
+static gnrc_ipv6_fwd_stats_t _fwd_stats;
+#endif
+
+
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
 /* Sends packet over the appropriate interface(s).
@@ -84,6 +127,7 @@ kernel_pid_t gnrc_ipv6_init(void)
     gnrc_ipv6_fib_table.data.entries = _fib_entries;
     gnrc_ipv6_fib_table.table_type = FIB_TABLE_TYPE_SH;
     gnrc_ipv6_fib_table.size = GNRC_IPV6_FIB_TABLE_SIZE;
+    gnrc_ipv6_fib_table.index = _fib_index;
     fib_init(&gnrc_ipv6_fib_table);
 #endif
 
@@ -236,15 +280,37 @@ static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _direct_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        /* run-to-completion in the thread of the lower layer */
+        _receive(pkt);
+    }
+    else if (gnrc_netapi_send(gnrc_ipv6_pid, pkt) < 1) {
+        DEBUG("ipv6: unable to hand packet over to IPv6 thread\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static gnrc_netreg_entry_cbd_t _direct_cbd = { _direct_cb, NULL };
+#endif
+
 static void *_event_loop(void *args)
 {
-    msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
-    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
-                                                            sched_active_pid);
+    msg_t msgs[GNRC_IPV6_MSG_BATCH_SIZE], reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
+    gnrc_netreg_entry_t me_reg;
 
     (void)args;
     msg_init_queue(msg_q, GNRC_IPV6_MSG_QUEUE_SIZE);
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    gnrc_netreg_entry_init_cb(&me_reg, GNRC_NETREG_DEMUX_CTX_ALL, &_direct_cbd);
+#else
+    gnrc_netreg_entry_init_pid(&me_reg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               sched_active_pid);
+#endif
     /* register interest in all IPv6 packets */
     gnrc_netreg_register(GNRC_NETTYPE_IPV6, &me_reg);
 
@@ -254,47 +320,56 @@ static void *_event_loop(void *args)
     /* start event loop */
     while (1) {
         DEBUG("ipv6: waiting for incoming message.\n");
-        msg_receive(&msg);
-
-        switch (msg.type) {
-            case GNRC_NETAPI_MSG_TYPE_RCV:
-                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
-                _receive(msg.content.ptr);
-                break;
-
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
-                _send(msg.content.ptr, true);
-                break;
-
-            case GNRC_NETAPI_MSG_TYPE_GET:
-            case GNRC_NETAPI_MSG_TYPE_SET:
-                DEBUG("ipv6: reply to unsupported get/set\n");
-                reply.content.value = -ENOTSUP;
-                msg_reply(&msg, &reply);
-                break;
-
-            case GNRC_IPV6_NIB_SND_UC_NS:
-            case GNRC_IPV6_NIB_SND_MC_NS:
-            case GNRC_IPV6_NIB_SND_NA:
-            case GNRC_IPV6_NIB_SEARCH_RTR:
-            case GNRC_IPV6_NIB_REPLY_RS:
-            case GNRC_IPV6_NIB_SND_MC_RA:
-            case GNRC_IPV6_NIB_REACH_TIMEOUT:
-            case GNRC_IPV6_NIB_DELAY_TIMEOUT:
-            case GNRC_IPV6_NIB_ADDR_REG_TIMEOUT:
-            case GNRC_IPV6_NIB_ABR_TIMEOUT:
-            case GNRC_IPV6_NIB_PFX_TIMEOUT:
-            case GNRC_IPV6_NIB_RTR_TIMEOUT:
-            case GNRC_IPV6_NIB_RECALC_REACH_TIME:
-            case GNRC_IPV6_NIB_REREG_ADDRESS:
-            case GNRC_IPV6_NIB_DAD:
-            case GNRC_IPV6_NIB_VALID_ADDR:
-                DEBUG("ipv6: NIB timer event received\n");
-                gnrc_ipv6_nib_handle_timer_event(msg.content.ptr, msg.type);
-                break;
-            default:
-                break;
+        int n = msg_receive_batch(msgs, GNRC_IPV6_MSG_BATCH_SIZE);
+
+        for (int i = 0; i < n; i++) {
+            msg_t *msg = &msgs[i];
+
+            switch (msg->type) {
+                case GNRC_NETAPI_MSG_TYPE_RCV:
+                    DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
+                    _receive(msg->content.ptr);
+                    break;
+
+                case GNRC_NETAPI_MSG_TYPE_SND:
+                    DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
+                    _send(msg->content.ptr, true);
+                    break;
+
+                case GNRC_IPV6_MSG_TYPE_SND_PREPARED:
+                    DEBUG("ipv6: GNRC_IPV6_MSG_TYPE_SND_PREPARED received\n");
+                    _send(msg->content.ptr, false);
+                    break;
+
+                case GNRC_NETAPI_MSG_TYPE_GET:
+                case GNRC_NETAPI_MSG_TYPE_SET:
+                    DEBUG("ipv6: reply to unsupported get/set\n");
+                    reply.content.value = -ENOTSUP;
+                    msg_reply(msg, &reply);
+                    break;
+
+                case GNRC_IPV6_NIB_SND_UC_NS:
+                case GNRC_IPV6_NIB_SND_MC_NS:
+                case GNRC_IPV6_NIB_SND_NA:
+                case GNRC_IPV6_NIB_SEARCH_RTR:
+                case GNRC_IPV6_NIB_REPLY_RS:
+                case GNRC_IPV6_NIB_SND_MC_RA:
+                case GNRC_IPV6_NIB_REACH_TIMEOUT:
+                case GNRC_IPV6_NIB_DELAY_TIMEOUT:
+                case GNRC_IPV6_NIB_ADDR_REG_TIMEOUT:
+                case GNRC_IPV6_NIB_ABR_TIMEOUT:
+                case GNRC_IPV6_NIB_PFX_TIMEOUT:
+                case GNRC_IPV6_NIB_RTR_TIMEOUT:
+                case GNRC_IPV6_NIB_RECALC_REACH_TIME:
+                case GNRC_IPV6_NIB_REREG_ADDRESS:
+                case GNRC_IPV6_NIB_DAD:
+                case GNRC_IPV6_NIB_VALID_ADDR:
+                    DEBUG("ipv6: NIB timer event received\n");
+                    gnrc_ipv6_nib_handle_timer_event(msg->content.ptr, msg->type);
+                    break;
+                default:
+                    break;
+            }
         }
     }
 
@@ -305,6 +380,13 @@ static void _send_to_iface(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
     assert(netif != NULL);
     ((gnrc_netif_hdr_t *)pkt->data)->if_pid = netif->pid;
+#ifdef MODULE_GNRC_NETIF_PKTQ
+    if (!(((gnrc_netif_hdr_t *)pkt->data)->flags &
+          GNRC_NETIF_HDR_FLAGS_PRIO_MASK)) {
+        ((gnrc_netif_hdr_t *)pkt->data)->flags |=
+            gnrc_netif_pktq_ipv6_prio(pkt->next->data);
+    }
+#endif
     if (gnrc_pkt_len(pkt->next) > netif->ipv6.mtu) {
         DEBUG("ipv6: packet too big\n");
         gnrc_icmpv6_error_pkt_too_big_send(netif->ipv6.mtu, pkt);
@@ -366,7 +448,30 @@ static bool _is_ipv6_hdr(gnrc_pktsnip_t *hdr)
 #endif
 }
 
-static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
+static bool _csum_offload(const gnrc_netif_t *netif,
+                          const gnrc_pktsnip_t *payload)
+{
+    switch (payload->type) {
+#ifdef MODULE_GNRC_UDP
+        case GNRC_NETTYPE_UDP:
+            return gnrc_netif_csum_offload_tx(netif, NETOPT_CSUM_OFFLOAD_UDP);
+#endif
+#ifdef MODULE_GNRC_TCP
+        case GNRC_NETTYPE_TCP:
+            return gnrc_netif_csum_offload_tx(netif, NETOPT_CSUM_OFFLOAD_TCP);
+#endif
+        case GNRC_NETTYPE_ICMPV6:
+            return gnrc_netif_csum_offload_tx(netif,
+                                              NETOPT_CSUM_OFFLOAD_ICMPV6);
+        default:
+            return false;
+    }
+}
+
+/* loopback: packet does not leave the node, so no device can calculate its
+ * upper layer checksum */
+static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6,
+                          bool loopback)
 {
     int res;
     ipv6_hdr_t *hdr = ipv6->data;
@@ -434,6 +539,10 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
         prev->next = payload;
         prev = payload;
     } while (_is_ipv6_hdr(payload) && (payload->next != NULL));
+    if (!loopback && _csum_offload(netif, payload)) {
+        DEBUG("ipv6: checksum for upper header left to the device.\n");
+        return 0;
+    }
     DEBUG("ipv6: calculate checksum for upper header.\n");
     if ((res = gnrc_netreg_calc_csum(payload, ipv6)) < 0) {
         if (res != -ENOENT) {   /* if there is no checksum we are okay */
@@ -447,9 +556,9 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
 }
 
 static bool _safe_fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
-                                bool prep_hdr)
+                                bool prep_hdr, bool loopback)
 {
-    if (prep_hdr && (_fill_ipv6_hdr(netif, pkt) < 0)) {
+    if (prep_hdr && (_fill_ipv6_hdr(netif, pkt, loopback) < 0)) {
         /* error on filling up header */
         gnrc_pktbuf_release(pkt);
         return false;
@@ -457,24 +566,198 @@ static bool _safe_fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
     return true;
 }
 
+/* flow cache */
+#ifdef MODULE_GNRC_IPV6_FLOW_CACHE
+void gnrc_ipv6_flow_cache_invalidate(void)
+{
+    _flow_gen++;
+}
+
+static inline unsigned _flow_cache_gen(void)
+{
+    return _flow_gen;
+}
+
+static _flow_t *_flow_cache_get(const ipv6_addr_t *dst, kernel_pid_t hint,
+                                unsigned gen)
+{
+    for (unsigned i = 0; i < GNRC_IPV6_FLOW_CACHE_SIZE; i++) {
+        _flow_t *flow = &_flows[i];
+
+        if ((flow->netif != NULL) && (flow->gen == gen) &&
+            (flow->hint == hint) && ipv6_addr_equal(&flow->dst, dst)) {
+            return flow;
+        }
+    }
+    return NULL;
+}
+
+static void _flow_cache_add(const ipv6_addr_t *dst, kernel_pid_t hint,
+                            unsigned gen, gnrc_netif_t *netif,
+                            const gnrc_ipv6_nib_nc_t *nce,
+                            const ipv6_addr_t *src)
+{
+    _flow_t *flow = NULL;
+
+    switch (gnrc_ipv6_nib_nc_get_nud_state(nce)) {
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED:
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE:
+            break;
+        default:
+            /* neighbor unreachability detection needs to see the packets */
+            return;
+    }
+    if (nce->l2addr_len > sizeof(flow->l2addr)) {
+        return;
+    }
+    for (unsigned i = 0; i < GNRC_IPV6_FLOW_CACHE_SIZE; i++) {
+        if ((_flows[i].netif == NULL) || (_flows[i].gen != gen)) {
+            flow = &_flows[i];
+            break;
+        }
+    }
+    if (flow == NULL) {
+        /* replace entries round-robin */
+        flow = &_flows[_flows_next];
+        _flows_next = (_flows_next + 1) % GNRC_IPV6_FLOW_CACHE_SIZE;
+    }
+    DEBUG("ipv6: add %s to flow cache\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+#ifdef MODULE_GNRC_IPV6_FAST_FORWARD
+    mutex_lock(&_flows_lock);
+#endif
+    memcpy(&flow->dst, dst, sizeof(flow->dst));
+    if (src != NULL) {
+        memcpy(&flow->src, src, sizeof(flow->src));
+    }
+    else {
+        ipv6_addr_set_unspecified(&flow->src);
+    }
+    flow->netif = netif;
+    flow->gen = gen;
+    flow->hint = hint;
+    flow->l2addr_len = nce->l2addr_len;
+    memcpy(flow->l2addr, nce->l2addr, nce->l2addr_len);
+#ifdef MODULE_GNRC_IPV6_FAST_FORWARD
+    mutex_unlock(&_flows_lock);
+#endif
+}
+#else   /* MODULE_GNRC_IPV6_FLOW_CACHE */
+static inline unsigned _flow_cache_gen(void)
+{
+    return 0U;
+}
+
+static inline _flow_t *_flow_cache_get(const ipv6_addr_t *dst,
+                                       kernel_pid_t hint, unsigned gen)
+{
+    (void)dst;
+    (void)hint;
+    (void)gen;
+    return NULL;
+}
+
+static inline void _flow_cache_add(const ipv6_addr_t *dst, kernel_pid_t hint,
+                                   unsigned gen, gnrc_netif_t *netif,
+                                   const gnrc_ipv6_nib_nc_t *nce,
+                                   const ipv6_addr_t *src)
+{
+    (void)dst;
+    (void)hint;
+    (void)gen;
+    (void)netif;
+    (void)nce;
+    (void)src;
+}
+#endif  /* MODULE_GNRC_IPV6_FLOW_CACHE */
+
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+/* only ever used in the IPv6 thread */
+static uint8_t _srh[GNRC_RPL_SRH_ROOT_SRH_MAX];
+
+/* inserts the source routing header after the filled IPv6 header, so the
+ * upper layer checksum is still calculated for the final destination */
+static bool _srh_insert(gnrc_pktsnip_t *pkt, ipv6_hdr_t *ipv6_hdr,
+                        unsigned len, const ipv6_addr_t *first_hop)
+{
+    gnrc_pktsnip_t *ext = gnrc_pktbuf_add(pkt->next, _srh, len,
+                                          GNRC_NETTYPE_IPV6_EXT);
+
+    if (ext == NULL) {
+        DEBUG("ipv6: unable to allocate source routing header\n");
+        gnrc_pktbuf_release_error(pkt, ENOBUFS);
+        return false;
+    }
+    ((gnrc_rpl_srh_t *)ext->data)->nh = ipv6_hdr->nh;
+    ipv6_hdr->nh = PROTNUM_IPV6_EXT_RH;
+    ipv6_hdr->len = byteorder_htons(byteorder_ntohs(ipv6_hdr->len) + len);
+    memcpy(&ipv6_hdr->dst, first_hop, sizeof(ipv6_hdr->dst));
+    pkt->next = ext;
+    return true;
+}
+#endif  /* MODULE_GNRC_RPL_SRH_ROOT */
+
 /* functions for sending */
 static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                           gnrc_netif_t *netif, ipv6_hdr_t *ipv6_hdr,
                           uint8_t netif_hdr_flags)
 {
     gnrc_ipv6_nib_nc_t nce;
+    const kernel_pid_t hint = (netif == NULL) ? KERNEL_PID_UNDEF : netif->pid;
+    /* take generation before looking anything up, so the entry added below
+     * is stale if anything changes while we do */
+    const unsigned gen = _flow_cache_gen();
+    const bool select_src = prep_hdr &&
+                            ipv6_addr_is_unspecified(&ipv6_hdr->src);
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+    ipv6_addr_t first_hop;
+    const int srh_len = gnrc_rpl_srh_root_get(&ipv6_hdr->dst, &first_hop,
+                                              _srh, sizeof(_srh));
+    /* the flow cache does not know when source routes change */
+    _flow_t *flow = (srh_len > 0) ? NULL
+                                  : _flow_cache_get(&ipv6_hdr->dst, hint, gen);
+    const ipv6_addr_t *next_dst = (srh_len > 0) ? &first_hop : &ipv6_hdr->dst;
+#else
+    _flow_t *flow = _flow_cache_get(&ipv6_hdr->dst, hint, gen);
+    const ipv6_addr_t *next_dst = &ipv6_hdr->dst;
+#endif
 
     DEBUG("ipv6: send unicast\n");
-    if (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, netif, pkt,
-                                          &nce) < 0) {
-        /* packet is released by NIB */
-        DEBUG("ipv6: no link-layer address or interface for next hop to %s",
+    if (flow != NULL) {
+        DEBUG("ipv6: found %s in flow cache\n",
               ipv6_addr_to_str(addr_str, &ipv6_hdr->dst, sizeof(addr_str)));
-        return;
+        netif = flow->netif;
+        nce.l2addr_len = flow->l2addr_len;
+        memcpy(nce.l2addr, flow->l2addr, flow->l2addr_len);
+        if (select_src) {
+            /* if still unspecified, _fill_ipv6_hdr() will try again */
+            memcpy(&ipv6_hdr->src, &flow->src, sizeof(ipv6_hdr->src));
+        }
     }
-    netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
-    assert(netif != NULL);
-    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+    else {
+        if (gnrc_ipv6_nib_get_next_hop_l2addr(next_dst, netif, pkt,
+                                              &nce) < 0) {
+            /* packet is released by NIB */
+            DEBUG("ipv6: no link-layer address or interface for next hop to %s",
+                  ipv6_addr_to_str(addr_str, next_dst, sizeof(addr_str)));
+            return;
+        }
+        netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
+        assert(netif != NULL);
+    }
+    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr, false)) {
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+        /* changes the destination to the first hop, so the flow cache entry
+         * below gets added for the first hop */
+        if ((srh_len > 0) &&
+            !_srh_insert(pkt, ipv6_hdr, srh_len, &first_hop)) {
+            return;
+        }
+#endif
+        if (flow == NULL) {
+            _flow_cache_add(&ipv6_hdr->dst, hint, gen, netif, &nce,
+                            (select_src) ? &ipv6_hdr->src : NULL);
+        }
         DEBUG("ipv6: add interface header to packet\n");
         if ((pkt = _create_netif_hdr(nce.l2addr, nce.l2addr_len, pkt,
                                      netif_hdr_flags)) == NULL) {
@@ -542,7 +825,7 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                     gnrc_pktbuf_release(pkt);
                     return;
                 }
-                if (_fill_ipv6_hdr(netif, tmp) < 0) {
+                if (_fill_ipv6_hdr(netif, tmp, false) < 0) {
                     /* error on filling up header */
                     if (tmp != pkt) {
                         gnrc_pktbuf_release(tmp);
@@ -555,7 +838,7 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
         }
     }
     else {
-        if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+        if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr, false)) {
             _send_multicast_over_iface(pkt, netif, netif_hdr_flags);
         }
     }
@@ -569,7 +852,7 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
             return;
         }
     }
-    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr, false)) {
         _send_multicast_over_iface(pkt, netif, netif_hdr_flags);
     }
 #endif  /* GNRC_NETIF_NUMOF */
@@ -581,7 +864,7 @@ static void _send_to_self(gnrc_pktsnip_t *pkt, bool prep_hdr,
     uint8_t *rcv_data;
     gnrc_pktsnip_t *ptr = pkt, *rcv_pkt;
 
-    if (!_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+    if (!_safe_fill_ipv6_hdr(netif, pkt, prep_hdr, true)) {
         return;
     }
     rcv_pkt = gnrc_pktbuf_add(NULL, NULL, gnrc_pkt_len(pkt), GNRC_NETTYPE_IPV6);
@@ -611,6 +894,25 @@ static void _send_to_self(gnrc_pktsnip_t *pkt, bool prep_hdr,
     }
 }
 
+#ifdef MODULE_GNRC_MPL
+/* fills the header once for all interfaces, and makes the packet a data
+ * message of the MPL domain it is sent to */
+static gnrc_pktsnip_t *_mpl_seed(gnrc_pktsnip_t *pkt, gnrc_netif_t *netif)
+{
+    if ((netif == NULL) && ((netif = gnrc_netif_iter(NULL)) == NULL)) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    /* the MPL option is inserted after the checksum is calculated, so do not
+     * leave it to the device */
+    if (_fill_ipv6_hdr(netif, pkt, true) < 0) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    return gnrc_mpl_seed(pkt);
+}
+#endif
+
 static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
 {
     gnrc_netif_t *netif = NULL;
@@ -618,6 +920,7 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     ipv6_hdr_t *ipv6_hdr;
     uint8_t netif_hdr_flags = 0U;
 
+    gnrc_pkttrace(pkt, GNRC_PKTTRACE_TX_IPV6);
     /* get IPv6 snip and (if present) generic interface header */
     if (pkt->type == GNRC_NETTYPE_NETIF) {
         /* If there is already a netif header (routing protocols and
@@ -668,6 +971,18 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     ipv6_hdr = pkt->data;
 
     if (ipv6_addr_is_multicast(&ipv6_hdr->dst)) {
+#ifdef MODULE_GNRC_MPL
+        if (prep_hdr && ((pkt->next == NULL) || !_is_ipv6_hdr(pkt->next)) &&
+            gnrc_mpl_is_domain(&ipv6_hdr->dst)) {
+            DEBUG("ipv6: sending to MPL domain\n");
+            if ((pkt = _mpl_seed(pkt, netif)) == NULL) {
+                return;
+            }
+            /* MPL floods on all interfaces */
+            prep_hdr = false;
+            netif = NULL;
+        }
+#endif
         _send_multicast(pkt, prep_hdr, netif, netif_hdr_flags);
     }
     else {
@@ -684,6 +999,84 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     }
 }
 
+#ifdef MODULE_GNRC_IPV6_FAST_FORWARD
+void gnrc_ipv6_fwd_stats_get(gnrc_ipv6_fwd_stats_t *stats)
+{
+    unsigned state = irq_disable();
+
+    *stats = _fwd_stats;
+    irq_restore(state);
+}
+
+/* the counters are bumped by the interface threads and the IPv6 thread */
+static void _fwd_stats_inc(uint32_t *counter)
+{
+    unsigned state = irq_disable();
+
+    (*counter)++;
+    irq_restore(state);
+}
+
+/* forwards a received packet in (reversed) receive order from the thread of
+ * the receiving interface, if the flow cache knows its destination */
+static bool _fast_forward(gnrc_pktsnip_t *pkt, const ipv6_hdr_t *hdr)
+{
+    _flow_t flow;
+    _flow_t *entry;
+    gnrc_pktsnip_t *netif_hdr;
+    size_t hdr_size;
+
+    if (!mutex_trylock(&_flows_lock)) {
+        /* IPv6 thread is just changing the flow cache */
+        return false;
+    }
+    entry = _flow_cache_get(&hdr->dst, KERNEL_PID_UNDEF, _flow_cache_gen());
+    if (entry != NULL) {
+        flow = *entry;
+    }
+    mutex_unlock(&_flows_lock);
+    if (entry == NULL) {
+        return false;
+    }
+    DEBUG("ipv6: fast forward to %s over interface %" PRIkernel_pid "\n",
+          ipv6_addr_to_str(addr_str, &hdr->dst, sizeof(addr_str)),
+          flow.netif->pid);
+    hdr_size = sizeof(gnrc_netif_hdr_t) + flow.l2addr_len;
+    netif_hdr = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    /* rewrite the interface header of the received packet, if possible */
+    if ((netif_hdr == NULL) || (netif_hdr->users > 1) ||
+        (netif_hdr->size < hdr_size) ||
+        (gnrc_pktbuf_realloc_data(netif_hdr, hdr_size) != 0)) {
+        if (netif_hdr != NULL) {
+            gnrc_pktbuf_remove_snip(pkt, netif_hdr);
+        }
+        netif_hdr = gnrc_netif_hdr_build(NULL, 0, flow.l2addr,
+                                         flow.l2addr_len);
+        if (netif_hdr == NULL) {
+            DEBUG("ipv6: error on interface header allocation\n");
+            return false;
+        }
+        LL_APPEND(pkt, netif_hdr);
+    }
+    else {
+        gnrc_netif_hdr_init(netif_hdr->data, 0, flow.l2addr_len);
+        gnrc_netif_hdr_set_dst_addr(netif_hdr->data, flow.l2addr,
+                                    flow.l2addr_len);
+    }
+    if ((pkt = gnrc_pktbuf_reverse_snips(pkt)) == NULL) {
+        DEBUG("ipv6: unable to reverse pkt from receive order to send "
+              "order; dropping it\n");
+        return true;
+    }
+    _fwd_stats_inc(&_fwd_stats.fast);
+#ifdef MODULE_NETSTATS_IPV6
+    flow.netif->ipv6.stats.tx_unicast_count++;
+#endif
+    _send_to_iface(flow.netif, pkt);
+    return true;
+}
+#endif  /* MODULE_GNRC_IPV6_FAST_FORWARD */
+
 /* functions for receiving */
 static inline bool _pkt_not_for_me(gnrc_netif_t **netif, ipv6_hdr_t *hdr)
 {
@@ -707,6 +1100,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
     ipv6_hdr_t *hdr;
 
     assert(pkt != NULL);
+    gnrc_pkttrace(pkt, GNRC_PKTTRACE_RX_IPV6);
 
     netif_hdr = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
 
@@ -804,6 +1198,14 @@ static void _receive(gnrc_pktsnip_t *pkt)
           ipv6_addr_to_str(addr_str, &(hdr->dst), sizeof(addr_str)),
           hdr->nh, byteorder_ntohs(hdr->len));
 
+#ifdef MODULE_GNRC_MPL
+    if ((hdr->nh == PROTNUM_IPV6_EXT_HOPOPT) && gnrc_mpl_receive(pkt, ipv6)) {
+        DEBUG("ipv6: dropped by MPL\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+#endif
+
     if (_pkt_not_for_me(&netif, hdr)) { /* if packet is not for me */
         DEBUG("ipv6: packet destination not this host\n");
 
@@ -842,6 +1244,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
                 return;
             }
 
+#ifdef MODULE_GNRC_IPV6_FAST_FORWARD
+            if ((sched_active_pid != gnrc_ipv6_pid) &&
+                _fast_forward(pkt, ipv6->data)) {
+                return;
+            }
+            _fwd_stats_inc(&_fwd_stats.slow);
+#endif
             /* remove L2 headers around IPV6 */
             netif_hdr = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
             if (netif_hdr != NULL) {
@@ -849,6 +1258,21 @@ static void _receive(gnrc_pktsnip_t *pkt)
             }
             pkt = gnrc_pktbuf_reverse_snips(pkt);
             if (pkt != NULL) {
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+                if (sched_active_pid != gnrc_ipv6_pid) {
+                    /* hand the packet over so _send() only ever runs in
+                     * the IPv6 thread */
+                    msg_t msg = { .type = GNRC_IPV6_MSG_TYPE_SND_PREPARED,
+                                  .content = { .ptr = pkt } };
+
+                    if (msg_try_send(&msg, gnrc_ipv6_pid) < 1) {
+                        DEBUG("ipv6: unable to hand packet over to IPv6 "
+                              "thread: dropping it\n");
+                        gnrc_pktbuf_release(pkt);
+                    }
+                    return;
+                }
+#endif
                 _send(pkt, false);
             }
             else {
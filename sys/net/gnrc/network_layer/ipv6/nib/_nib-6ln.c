@@ -102,8 +102,10 @@ uint8_t _handle_aro(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
                           "Scheduling re-registration in %" PRIu32 "ms\n",
                           ipv6_addr_to_str(addr_str, &ipv6->dst,
                                            sizeof(addr_str)), rereg_time);
-                    netif->ipv6.addrs_flags[idx] &= ~GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_MASK;
+                    netif->ipv6.addrs_flags[idx] &= ~(GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_MASK |
+                                                      GNRC_NETIF_IPV6_ADDRS_FLAGS_OPTIMISTIC);
                     netif->ipv6.addrs_flags[idx] |= GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID;
+                    gnrc_ipv6_flow_cache_invalidate();
                     _evtimer_add(&netif->ipv6.addrs[idx],
                                  GNRC_IPV6_NIB_REREG_ADDRESS,
                                  &netif->ipv6.addrs_timers[idx],
@@ -169,6 +171,31 @@ static inline bool _is_valid(const gnrc_netif_t *netif, int idx)
             GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID);
 }
 
+/*
+ * Re-registers the other valid addresses of an interface that are due within
+ * GNRC_IPV6_NIB_CONF_REREG_BATCH_MS along with the address at idx
+ */
+static void _rereg_batch(gnrc_netif_t *netif, const _nib_dr_entry_t *router,
+                         int idx)
+{
+    for (int i = 0; i < GNRC_NETIF_IPV6_ADDRS_NUMOF; i++) {
+        const ipv6_addr_t *addr = &netif->ipv6.addrs[i];
+
+        if ((i == idx) || !_is_valid(netif, i) ||
+            (_evtimer_lookup(&netif->ipv6.addrs_timers[i],
+                             GNRC_IPV6_NIB_REREG_ADDRESS) >
+             GNRC_IPV6_NIB_CONF_REREG_BATCH_MS)) {
+            continue;
+        }
+        DEBUG("nib: Re-registering %s along\n",
+              ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
+        _snd_ns(&router->next_hop->ipv6, netif, addr, &router->next_hop->ipv6);
+        _evtimer_add(&netif->ipv6.addrs[i], GNRC_IPV6_NIB_REREG_ADDRESS,
+                     &netif->ipv6.addrs_timers[i],
+                     SIXLOWPAN_ND_MAX_RS_SEC_INTERVAL * MS_PER_SEC);
+    }
+}
+
 void _handle_rereg_address(const ipv6_addr_t *addr)
 {
     gnrc_netif_t *netif = gnrc_netif_get_by_ipv6_addr(addr);
@@ -201,6 +228,7 @@ void _handle_rereg_address(const ipv6_addr_t *addr)
 
             if (_is_valid(netif, idx)) {
                 retrans_time = SIXLOWPAN_ND_MAX_RS_SEC_INTERVAL * MS_PER_SEC;
+                _rereg_batch(netif, router, idx);
             }
             else {
                 retrans_time = netif->ipv6.retrans_time;
@@ -169,6 +169,7 @@ void _handle_sl2ao(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
         if (!_rtr_sol_on_6lr(netif, icmpv6)) {
             nce->l2addr_len = l2addr_len;
             memcpy(nce->l2addr, sl2ao + 1, l2addr_len);
+            gnrc_ipv6_flow_cache_invalidate();
         }
 #endif  /* GNRC_IPV6_NIB_CONF_ARSM */
     }
@@ -324,7 +325,7 @@ void _probe_nbr(_nib_onl_entry_t *nbr, bool reset)
         case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_INCOMPLETE:
         case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNREACHABLE: {
                 gnrc_netif_t *netif = gnrc_netif_get_by_pid(_nib_onl_get_if(nbr));
-                uint32_t next_ns = _evtimer_lookup(nbr,
+                uint32_t next_ns = _evtimer_lookup(&nbr->nud_timeout,
                                                    GNRC_IPV6_NIB_SND_MC_NS);
 
                 assert(netif != NULL);
@@ -403,6 +404,7 @@ void _handle_adv_l2(gnrc_netif_t *netif, _nib_onl_entry_t *nce,
         else {
             nce->l2addr_len = 0;
         }
+        gnrc_ipv6_flow_cache_invalidate();
         if (_sflag_set((ndp_nbr_adv_t *)icmpv6)) {
             _set_reachable(netif, nce);
         }
@@ -482,6 +484,7 @@ void _set_nud_state(gnrc_netif_t *netif, _nib_onl_entry_t *nce,
 {
     nce->info &= ~GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK;
     nce->info |= state;
+    gnrc_ipv6_flow_cache_invalidate();
 
 #if GNRC_IPV6_NIB_CONF_ROUTER
     gnrc_netif_acquire(netif);
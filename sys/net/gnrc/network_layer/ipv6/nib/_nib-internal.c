@@ -24,13 +24,22 @@
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/netif/internal.h"
 #include "random.h"
+#ifdef MODULE_GNRC_RPL_ROUTES
+#include "net/gnrc/rpl/routes.h"
+#endif
 
 #include "_nib-internal.h"
 #include "_nib-router.h"
+#include "_nib-trie.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_GNRC_NETIF_SHARED
+static_assert((GNRC_NETIF_SHARED_PID_FIRST + GNRC_NETIF_NUMOF - 1) <= _NIB_IF_MAX,
+              "NIB interface field can't hold the shared netif PIDs");
+#endif
+
 /* pointers for default router selection */
 _nib_dr_entry_t *_prime_def_router = NULL;
 static clist_node_t _next_removable = { NULL };
@@ -52,6 +61,75 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node);
 static inline bool _node_unreachable(_nib_onl_entry_t *node);
 
+#if GNRC_IPV6_NIB_CONF_ONL_HASH
+#define _ONL_HASH_SIZE  (2 * GNRC_IPV6_NIB_NUMOF)
+
+/* open-addressed (linear probing) index over _nodes by address, slots hold
+ * the index of the entry in _nodes + 1 with 0 marking a free slot. The
+ * interface is not part of the key, since lookups may use 0 as a wildcard */
+static uint16_t _onl_hash[_ONL_HASH_SIZE];
+
+static inline unsigned _onl_hash_home(const ipv6_addr_t *addr)
+{
+    uint32_t h = addr->u32[0].u32 ^ addr->u32[1].u32 ^ addr->u32[2].u32 ^
+                 addr->u32[3].u32;
+
+    h ^= h >> 16;
+    h *= 0x45d9f3bU;
+    h ^= h >> 16;
+    return h % _ONL_HASH_SIZE;
+}
+
+static inline unsigned _onl_hash_next(unsigned slot)
+{
+    return (slot + 1) % _ONL_HASH_SIZE;
+}
+
+static void _onl_hash_add(const _nib_onl_entry_t *node)
+{
+    uint16_t idx = (node - _nodes) + 1;
+    unsigned slot = _onl_hash_home(&node->ipv6);
+
+    /* the table has twice as many slots as there are entries, so there is
+     * always a free one */
+    while (_onl_hash[slot] != 0) {
+        if (_onl_hash[slot] == idx) {
+            return;
+        }
+        slot = _onl_hash_next(slot);
+    }
+    _onl_hash[slot] = idx;
+}
+
+void _nib_onl_hash_del(const _nib_onl_entry_t *node)
+{
+    uint16_t idx = (node - _nodes) + 1;
+    unsigned hole = _onl_hash_home(&node->ipv6);
+
+    while (_onl_hash[hole] != idx) {
+        if (_onl_hash[hole] == 0) {
+            return;     /* not indexed */
+        }
+        hole = _onl_hash_next(hole);
+    }
+    /* close the gap by shifting back later entries of the probe sequence that
+     * would not be found anymore otherwise */
+    for (unsigned slot = _onl_hash_next(hole); _onl_hash[slot] != 0;
+         slot = _onl_hash_next(slot)) {
+        unsigned home = _onl_hash_home(&_nodes[_onl_hash[slot] - 1].ipv6);
+
+        if ((slot > hole) ? ((home <= hole) || (home > slot))
+                          : ((home <= hole) && (home > slot))) {
+            _onl_hash[hole] = _onl_hash[slot];
+            hole = slot;
+        }
+    }
+    _onl_hash[hole] = 0;
+}
+#else   /* GNRC_IPV6_NIB_CONF_ONL_HASH */
+#define _onl_hash_add(node)     (void)node
+#endif  /* GNRC_IPV6_NIB_CONF_ONL_HASH */
+
 void _nib_init(void)
 {
 #ifdef TEST_SUITES
@@ -60,10 +138,14 @@ void _nib_init(void)
     memset(_nodes, 0, sizeof(_nodes));
     memset(_def_routers, 0, sizeof(_def_routers));
     memset(_dsts, 0, sizeof(_dsts));
+#if GNRC_IPV6_NIB_CONF_ONL_HASH
+    memset(_onl_hash, 0, sizeof(_onl_hash));
+#endif  /* GNRC_IPV6_NIB_CONF_ONL_HASH */
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 #endif  /* TEST_SUITES */
+    _nib_trie_init();
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
 }
@@ -199,24 +281,49 @@ _nib_onl_entry_t *_nib_onl_iter(const _nib_onl_entry_t *last)
     return NULL;
 }
 
+static inline bool _onl_matches(const _nib_onl_entry_t *node,
+                                const ipv6_addr_t *addr, unsigned iface)
+{
+    return (node->mode != _EMPTY) &&
+           /* either requested or current interface undefined or
+            * interfaces equal */
+           ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
+            (_nib_onl_get_if(node) == iface)) &&
+           ipv6_addr_equal(&node->ipv6, addr);
+}
+
 _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
 {
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if GNRC_IPV6_NIB_CONF_ONL_HASH
+    _nib_onl_entry_t *res = NULL;
+
+    for (unsigned slot = _onl_hash_home(addr); _onl_hash[slot] != 0;
+         slot = _onl_hash_next(slot)) {
+        _nib_onl_entry_t *node = &_nodes[_onl_hash[slot] - 1];
+
+        /* return the same entry as the linear search would if the address
+         * exists on multiple interfaces */
+        if (_onl_matches(node, addr, iface) && ((res == NULL) || (node < res))) {
+            res = node;
+        }
+    }
+    if (res != NULL) {
+        DEBUG("  Found %p\n", (void *)res);
+        return res;
+    }
+#else   /* GNRC_IPV6_NIB_CONF_ONL_HASH */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
 
-        if ((node->mode != _EMPTY) &&
-            /* either requested or current interface undefined or
-             * interfaces equal */
-            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
-             (_nib_onl_get_if(node) == iface)) &&
-            ipv6_addr_equal(&node->ipv6, addr)) {
+        if (_onl_matches(node, addr, iface)) {
             DEBUG("  Found %p\n", (void *)node);
             return node;
         }
     }
+#endif  /* GNRC_IPV6_NIB_CONF_ONL_HASH */
     DEBUG("  No suitable entry found\n");
     return NULL;
 }
@@ -250,6 +357,7 @@ void _nib_nc_remove(_nib_onl_entry_t *node)
           ipv6_addr_to_str(addr_str, &node->ipv6, sizeof(addr_str)),
           _nib_onl_get_if(node));
     node->mode &= ~(_NC);
+    gnrc_ipv6_flow_cache_invalidate();
     evtimer_del((evtimer_t *)&_nib_evtimer, &node->snd_na.event);
 #if GNRC_IPV6_NIB_CONF_ARSM
     evtimer_del((evtimer_t *)&_nib_evtimer, &node->nud_timeout.event);
@@ -350,6 +458,7 @@ _nib_dr_entry_t *_nib_drl_add(const ipv6_addr_t *router_addr, unsigned iface)
 
 void _nib_drl_remove(_nib_dr_entry_t *nib_dr)
 {
+    gnrc_ipv6_flow_cache_invalidate();
     if (nib_dr->next_hop != NULL) {
         nib_dr->next_hop->mode &= ~(_DRL);
         _nib_onl_clear(nib_dr->next_hop);
@@ -466,7 +575,10 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             /* exact match (or next hop address was previously unset) */
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
+                _nib_onl_hash_del(tmp_node);
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+                _onl_hash_add(tmp_node);
+                gnrc_ipv6_flow_cache_invalidate();
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
@@ -487,6 +599,8 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+        _nib_trie_add(dst);
+        gnrc_ipv6_flow_cache_invalidate();
     }
     return dst;
 }
@@ -518,7 +632,9 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+        _nib_trie_remove(dst);
         memset(dst, 0, sizeof(_nib_offl_entry_t));
+        gnrc_ipv6_flow_cache_invalidate();
     }
 }
 
@@ -548,6 +664,9 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 
     DEBUG("nib: get match for destination %s from NIB\n",
           ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    if (_nib_trie_get_match(dst, &res)) {
+        return res;
+    }
     for (_nib_offl_entry_t *entry = _dsts; _in_dsts(entry); entry++) {
         if (entry->mode != _EMPTY) {
             uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
@@ -592,6 +711,12 @@ int _nib_get_route(const ipv6_addr_t *dst, gnrc_pktsnip_t *pkt,
     DEBUG("nib: get route %s for packet %p\n",
           ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)),
           (void *)pkt);
+#ifdef MODULE_GNRC_RPL_ROUTES
+    /* downward routes of RPL are host routes, so they always match best */
+    if (gnrc_rpl_routes_get(dst, fte) == 0) {
+        return 0;
+    }
+#endif
     _nib_offl_entry_t *offl = _nib_offl_get_match(dst);
 
     if ((offl == NULL) || (offl->mode == _PL)) {
@@ -763,7 +888,7 @@ _nib_offl_entry_t *_nib_pl_add(unsigned iface,
     }
     assert(valid_ltime >= pref_ltime);
     if ((valid_ltime != UINT32_MAX) || (pref_ltime != UINT32_MAX)) {
-        uint32_t now = (xtimer_now_usec64() / US_PER_MS) & UINT32_MAX;
+        uint32_t now = xtimer_now_msec();
         if (pref_ltime != UINT32_MAX) {
             _evtimer_add(dst, GNRC_IPV6_NIB_PFX_TIMEOUT, &dst->pfx_timeout,
                          pref_ltime);
@@ -795,9 +920,12 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
 {
     _nib_onl_clear(node);
     if (addr != NULL) {
+        _nib_onl_hash_del(node);
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     }
     _nib_onl_set_if(node, iface);
+    _onl_hash_add(node);
+    gnrc_ipv6_flow_cache_invalidate();
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
@@ -812,21 +940,14 @@ static inline bool _node_unreachable(_nib_onl_entry_t *node)
     }
 }
 
-uint32_t _evtimer_lookup(const void *ctx, uint16_t type)
+uint32_t _evtimer_lookup(const evtimer_msg_event_t *event, uint16_t type)
 {
-    evtimer_msg_event_t *event = (evtimer_msg_event_t *)_nib_evtimer.events;
-    uint32_t offset = 0;
-
-    DEBUG("nib: lookup ctx = %p, type = %04x\n", (void *)ctx, type);
-    while (event != NULL) {
-        offset += event->event.offset;
-        if ((event->msg.type == type) &&
-            ((ctx == NULL) || (event->msg.content.ptr == ctx))) {
-            return offset;
-        }
-        event = (evtimer_msg_event_t *)event->event.next;
+    DEBUG("nib: lookup ctx = %p, type = %04x\n", event->msg.content.ptr, type);
+    /* events are shared by some types of the same context */
+    if (event->msg.type != type) {
+        return UINT32_MAX;
     }
-    return UINT32_MAX;
+    return evtimer_remaining(&_nib_evtimer, &event->event);
 }
 
 /** @} */
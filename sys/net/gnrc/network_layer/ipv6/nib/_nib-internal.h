@@ -194,7 +194,7 @@ typedef struct {
 /**
  * @brief   Off-link NIB entry
  */
-typedef struct {
+typedef struct _nib_offl_entry {
     _nib_onl_entry_t *next_hop; /**< next hop to destination */
     ipv6_addr_t pfx;            /**< prefix to the destination */
     /**
@@ -216,6 +216,15 @@ typedef struct {
                                      valid (UINT32_MAX means forever) */
     uint32_t pref_until;        /**< timestamp (in ms) until which the prefix
                                      preferred (UINT32_MAX means forever) */
+#if GNRC_IPV6_NIB_CONF_OFFL_TRIE || defined(DOXYGEN)
+    /**
+     * @brief   Next entry with the same prefix in the longest-prefix-match
+     *          index
+     *
+     * @note    Only available if @ref GNRC_IPV6_NIB_CONF_OFFL_TRIE.
+     */
+    struct _nib_offl_entry *trie_next;
+#endif
 } _nib_offl_entry_t;
 
 /**
@@ -251,6 +260,13 @@ extern mutex_t _nib_mutex;
  */
 extern evtimer_msg_t _nib_evtimer;
 
+#if GNRC_IPV6_NIB_CONF_DNS || defined(DOXYGEN)
+/**
+ * @brief   Event for the lifetime of the DNS server
+ */
+extern evtimer_msg_event_t _nib_rdnss_timeout;
+#endif
+
 /**
  * @brief   Primary default router.
  *
@@ -304,6 +320,21 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
  */
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 
+#if GNRC_IPV6_NIB_CONF_ONL_HASH || defined(DOXYGEN)
+/**
+ * @brief   Removes an on-link entry from the address index
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_ONL_HASH.
+ *
+ * Needs to be called before _nib_onl_entry_t::ipv6 of an entry changes.
+ *
+ * @param[in] node  An entry.
+ */
+void _nib_onl_hash_del(const _nib_onl_entry_t *node);
+#else   /* GNRC_IPV6_NIB_CONF_ONL_HASH || defined(DOXYGEN) */
+#define _nib_onl_hash_del(node)         (void)node
+#endif  /* GNRC_IPV6_NIB_CONF_ONL_HASH || defined(DOXYGEN) */
+
 /**
  * @brief   Clears out a NIB entry (on-link version)
  *
@@ -315,7 +346,9 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
+        _nib_onl_hash_del(node);
         memset(node, 0, sizeof(_nib_onl_entry_t));
+        gnrc_ipv6_flow_cache_invalidate();
         return true;
     }
     return false;
@@ -789,13 +822,16 @@ int _nib_get_route(const ipv6_addr_t *dst, gnrc_pktsnip_t *ctx,
 /**
  * @brief   Looks up if an event is queued in the event timer
  *
- * @param[in] ctx   Context of the event. May be NULL for any event context.
+ * With module `evtimer_heap` this takes constant time.
+ *
+ * @param[in] event The event of the context, e.g. gnrc_netif_ipv6_t::search_rtr
+ *                  of an interface.
  * @param[in] type  [Type of the event](@ref net_gnrc_ipv6_nib_msg).
  *
  * @return  Milliseconds to the event, if event in queue.
  * @return  UINT32_MAX, event is not in queue.
  */
-uint32_t _evtimer_lookup(const void *ctx, uint16_t type);
+uint32_t _evtimer_lookup(const evtimer_msg_event_t *event, uint16_t type);
 
 /**
  * @brief   Adds an event to the event timer
@@ -55,7 +55,8 @@ void _handle_snd_mc_ra(gnrc_netif_t *netif)
         bool final_ra = (netif->ipv6.ra_sent > (UINT8_MAX - NDP_MAX_FIN_RA_NUMOF));
         uint32_t next_ra_time = random_uint32_range(NDP_MIN_RA_INTERVAL_MS,
                                                     NDP_MAX_RA_INTERVAL_MS);
-        uint32_t next_scheduled = _evtimer_lookup(netif, GNRC_IPV6_NIB_SND_MC_RA);
+        uint32_t next_scheduled = _evtimer_lookup(&netif->ipv6.snd_mc_ra,
+                                                  GNRC_IPV6_NIB_SND_MC_RA);
 
         /* router has router advertising interface or the RA is one of the
          * (now deactivated) routers final one (and there is no next
@@ -63,7 +64,7 @@ void _handle_snd_mc_ra(gnrc_netif_t *netif)
         if ((final_ra && (next_scheduled > NDP_MAX_RA_INTERVAL_MS)) ||
             gnrc_netif_is_rtr_adv(netif)) {
             _snd_rtr_advs(netif, NULL, final_ra);
-            netif->ipv6.last_ra = (xtimer_now_usec64() / US_PER_MS) & UINT32_MAX;
+            netif->ipv6.last_ra = xtimer_now_msec();
             if ((netif->ipv6.ra_sent < NDP_MAX_INIT_RA_NUMOF) || final_ra) {
                 if ((netif->ipv6.ra_sent < NDP_MAX_INIT_RA_NUMOF) &&
                     (next_ra_time > NDP_MAX_INIT_RA_INTERVAL)) {
@@ -100,7 +101,7 @@ void _snd_rtr_advs(gnrc_netif_t *netif, const ipv6_addr_t *dst, bool final)
 static gnrc_pktsnip_t *_offl_to_pio(_nib_offl_entry_t *offl,
                                     gnrc_pktsnip_t *ext_opts)
 {
-    uint32_t now = (xtimer_now_usec64() / US_PER_MS) & UINT32_MAX;
+    uint32_t now = xtimer_now_msec();
     gnrc_pktsnip_t *pio;
     uint8_t flags = 0;
     uint32_t valid_ltime = (offl->valid_until == UINT32_MAX) ? UINT32_MAX :
@@ -135,7 +136,7 @@ static gnrc_pktsnip_t *_build_ext_opts(gnrc_netif_t *netif,
     unsigned id = netif->pid;
 
 #if GNRC_IPV6_NIB_CONF_DNS && SOCK_HAS_IPV6
-    uint32_t rdnss_ltime = _evtimer_lookup(&sock_dns_server,
+    uint32_t rdnss_ltime = _evtimer_lookup(&_nib_rdnss_timeout,
                                            GNRC_IPV6_NIB_RDNSS_TIMEOUT);
 
     if ((rdnss_ltime < UINT32_MAX) &&
@@ -51,6 +51,14 @@ void _auto_configure_addr(gnrc_netif_t *netif, const ipv6_addr_t *pfx,
         }
 #if GNRC_IPV6_NIB_CONF_6LN
         new_address = true;
+#if GNRC_IPV6_NIB_CONF_6LN_OPTIMISTIC
+        /* interface identifier from EUI-64 is unique */
+        if (gnrc_netif_is_6ln(netif) &&
+            (netif->l2addr_len == sizeof(eui64_t))) {
+            netif->ipv6.addrs_flags[idx] |= GNRC_NETIF_IPV6_ADDRS_FLAGS_OPTIMISTIC;
+            gnrc_ipv6_flow_cache_invalidate();
+        }
+#endif  /* GNRC_IPV6_NIB_CONF_6LN_OPTIMISTIC */
 #endif  /* GNRC_IPV6_NIB_CONF_6LN */
     }
 
@@ -63,6 +71,7 @@ void _auto_configure_addr(gnrc_netif_t *netif, const ipv6_addr_t *pfx,
          *    locked here) */
         netif->ipv6.addrs_flags[idx] &= ~GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_MASK;
         netif->ipv6.addrs_flags[idx] |= GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID;
+        gnrc_ipv6_flow_cache_invalidate();
     }
 #endif  /* GNRC_IPV6_NIB_CONF_6LN */
 #if GNRC_IPV6_NIB_CONF_6LN
@@ -192,6 +201,7 @@ void _handle_valid_addr(const ipv6_addr_t *addr)
     if (idx >= 0) {
         netif->ipv6.addrs_flags[idx] &= ~GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_MASK;
         netif->ipv6.addrs_flags[idx] |= GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID;
+        gnrc_ipv6_flow_cache_invalidate();
     }
     if (netif != NULL) {
         /* was acquired in `_get_netif_state()` */
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "_nib-trie.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if GNRC_IPV6_NIB_CONF_OFFL_TRIE
+
+typedef struct _trie_node {
+    ipv6_addr_t pfx;                /**< prefix of the node (zero padded) */
+    struct _trie_node *child[2];    /**< sub-tries for next bit 0 and 1 */
+    _nib_offl_entry_t *entries;     /**< entries with exactly this prefix */
+    uint8_t len;                    /**< length of _trie_node::pfx in bits */
+} _trie_node_t;
+
+static _trie_node_t _trie_nodes[2 * GNRC_IPV6_NIB_OFFL_NUMOF];
+static _trie_node_t *_free_nodes;
+static _trie_node_t *_root;
+static bool _incomplete;
+
+static inline unsigned _bit(const ipv6_addr_t *addr, unsigned pos)
+{
+    return (addr->u8[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+static _trie_node_t *_node_alloc(const ipv6_addr_t *pfx, unsigned len)
+{
+    _trie_node_t *node = _free_nodes;
+
+    if (node == NULL) {
+        /* can't happen with the pool size chosen, but better be safe than
+         * sorry */
+        DEBUG("nib: trie ran out of nodes, falling back to linear search\n");
+        _incomplete = true;
+        return NULL;
+    }
+    _free_nodes = node->child[0];
+    memset(node, 0, sizeof(*node));
+    ipv6_addr_init_prefix(&node->pfx, pfx, len);
+    node->len = len;
+    return node;
+}
+
+static inline void _node_free(_trie_node_t *node)
+{
+    node->child[0] = _free_nodes;
+    _free_nodes = node;
+}
+
+/* removes the node *link refers to if it became superfluous */
+static void _compact(_trie_node_t **link)
+{
+    _trie_node_t *node = *link;
+
+    if ((node->entries != NULL) ||
+        ((node->child[0] != NULL) && (node->child[1] != NULL))) {
+        return;
+    }
+    *link = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+    _node_free(node);
+}
+
+void _nib_trie_init(void)
+{
+    _free_nodes = NULL;
+    for (unsigned i = 0; i < (sizeof(_trie_nodes) / sizeof(_trie_nodes[0])); i++) {
+        _node_free(&_trie_nodes[i]);
+    }
+    _root = NULL;
+    _incomplete = false;
+}
+
+void _nib_trie_add(_nib_offl_entry_t *entry)
+{
+    const ipv6_addr_t *pfx = &entry->pfx;
+    unsigned len = entry->pfx_len;
+    _trie_node_t **link = &_root;
+    _trie_node_t *leaf;
+
+    assert((len > 0) && (len <= IPV6_ADDR_BIT_LEN));
+    while (*link != NULL) {
+        _trie_node_t *node = *link;
+        unsigned match = ipv6_addr_match_prefix(&node->pfx, pfx);
+
+        if (match > len) {
+            match = len;
+        }
+        if (match >= node->len) {
+            if (node->len == len) {
+                /* keep entries sharing a prefix in storage order, so the
+                 * result of a lookup matches the one of a linear search */
+                _nib_offl_entry_t **ptr = &node->entries;
+
+                while ((*ptr != NULL) && (*ptr < entry)) {
+                    ptr = &(*ptr)->trie_next;
+                }
+                if (*ptr != entry) {
+                    entry->trie_next = *ptr;
+                    *ptr = entry;
+                }
+                return;
+            }
+            link = &node->child[_bit(pfx, node->len)];
+            continue;
+        }
+        /* pfx is shorter than or diverges within the prefix of node */
+        if ((leaf = _node_alloc(pfx, len)) == NULL) {
+            return;
+        }
+        if (match == len) {
+            leaf->child[_bit(&node->pfx, len)] = node;
+            *link = leaf;
+        }
+        else {
+            _trie_node_t *branch = _node_alloc(pfx, match);
+
+            if (branch == NULL) {
+                _node_free(leaf);
+                return;
+            }
+            branch->child[_bit(pfx, match)] = leaf;
+            branch->child[_bit(&node->pfx, match)] = node;
+            *link = branch;
+        }
+        leaf->entries = entry;
+        entry->trie_next = NULL;
+        return;
+    }
+    if ((leaf = _node_alloc(pfx, len)) != NULL) {
+        *link = leaf;
+        leaf->entries = entry;
+        entry->trie_next = NULL;
+    }
+}
+
+void _nib_trie_remove(_nib_offl_entry_t *entry)
+{
+    _trie_node_t **parent = NULL, **link = &_root;
+    _trie_node_t *node;
+
+    while (((node = *link) != NULL) && (node->len < entry->pfx_len)) {
+        parent = link;
+        link = &node->child[_bit(&entry->pfx, node->len)];
+    }
+    if ((node == NULL) || (node->len != entry->pfx_len) ||
+        !ipv6_addr_equal(&node->pfx, &entry->pfx)) {
+        return;
+    }
+    for (_nib_offl_entry_t **ptr = &node->entries; *ptr != NULL;
+         ptr = &(*ptr)->trie_next) {
+        if (*ptr == entry) {
+            *ptr = entry->trie_next;
+            entry->trie_next = NULL;
+            _compact(link);
+            if (parent != NULL) {
+                _compact(parent);
+            }
+            return;
+        }
+    }
+}
+
+bool _nib_trie_get_match(const ipv6_addr_t *dst, _nib_offl_entry_t **res)
+{
+    _trie_node_t *node = _root;
+
+    if (_incomplete) {
+        return false;
+    }
+    *res = NULL;
+    while ((node != NULL) &&
+           (ipv6_addr_match_prefix(&node->pfx, dst) >= node->len)) {
+        for (_nib_offl_entry_t *entry = node->entries; entry != NULL;
+             entry = entry->trie_next) {
+            if (entry->mode != _EMPTY) {
+                *res = entry;
+                break;
+            }
+        }
+        if (node->len >= IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        node = node->child[_bit(dst, node->len)];
+    }
+    return true;
+}
+#else   /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
+typedef int dont_be_pedantic;
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
+
+/** @} */
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_ipv6_nib
+ * @{
+ *
+ * @file
+ * @brief   Longest-prefix-match index over the NIB's off-link entries
+ * @see     @ref GNRC_IPV6_NIB_CONF_OFFL_TRIE
+ *
+ * The index is a path-compressed binary trie. Its nodes are allocated from a
+ * static pool of `2 * GNRC_IPV6_NIB_OFFL_NUMOF` nodes, which is the maximum
+ * number of nodes required to index @ref GNRC_IPV6_NIB_OFFL_NUMOF prefixes.
+ * Entries with equal prefixes (e.g. a prefix list and a forwarding table entry
+ * for the same prefix) share a node and are chained in order of their storage
+ * location.
+ */
+#ifndef PRIV_NIB_TRIE_H
+#define PRIV_NIB_TRIE_H
+
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/ipv6/addr.h"
+
+#include "_nib-internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if GNRC_IPV6_NIB_CONF_OFFL_TRIE || defined(DOXYGEN)
+/**
+ * @brief   Initializes (i.e. empties) the index
+ */
+void _nib_trie_init(void);
+
+/**
+ * @brief   Adds an off-link entry to the index
+ *
+ * @pre `(entry != NULL) && (entry->pfx_len > 0) && (entry->pfx_len <= 128)`
+ *
+ * @param[in] entry An off-link entry with _nib_offl_entry_t::pfx and
+ *                  _nib_offl_entry_t::pfx_len set.
+ */
+void _nib_trie_add(_nib_offl_entry_t *entry);
+
+/**
+ * @brief   Removes an off-link entry from the index
+ *
+ * @param[in] entry An off-link entry previously added with _nib_trie_add().
+ *                  Entries not in the index are ignored.
+ */
+void _nib_trie_remove(_nib_offl_entry_t *entry);
+
+/**
+ * @brief   Gets the off-link entry with the longest prefix matching @p dst
+ *
+ * @param[in] dst   A destination address.
+ * @param[out] res  The best matching entry that is in use. NULL if none
+ *                  matches.
+ *
+ * @return  true, when @p res is valid.
+ * @return  false, when the index is incomplete (because it ran out of nodes)
+ *          and the caller needs to fall back to a linear search.
+ */
+bool _nib_trie_get_match(const ipv6_addr_t *dst, _nib_offl_entry_t **res);
+#else   /* GNRC_IPV6_NIB_CONF_OFFL_TRIE || defined(DOXYGEN) */
+#define _nib_trie_init()                (void)0
+#define _nib_trie_add(entry)            (void)entry
+#define _nib_trie_remove(entry)         (void)entry
+#define _nib_trie_get_match(dst, res)   (false)
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_TRIE || defined(DOXYGEN) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIV_NIB_TRIE_H */
+/** @} */
@@ -51,7 +51,7 @@ static gnrc_pktqueue_t _queue_pool[GNRC_IPV6_NIB_NUMOF];
 #endif  /* GNRC_IPV6_NIB_CONF_QUEUE_PKT */
 
 #if GNRC_IPV6_NIB_CONF_DNS
-static evtimer_msg_event_t _rdnss_timeout;
+evtimer_msg_event_t _nib_rdnss_timeout;
 #endif
 
 /**
@@ -493,7 +493,7 @@ static void _handle_rtr_sol(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
         nce = _nib_onl_get(&ipv6->src, netif->pid);
     }
     if (!gnrc_netif_is_6ln(netif)) {
-        uint32_t next_ra_scheduled = _evtimer_lookup(netif,
+        uint32_t next_ra_scheduled = _evtimer_lookup(&netif->ipv6.snd_mc_ra,
                                                      GNRC_IPV6_NIB_SND_MC_RA);
         if (next_ra_scheduled < next_ra_delay) {
             DEBUG("nib: There is a MC RA scheduled within the next %" PRIu32 "ms. "
@@ -1208,7 +1208,7 @@ static void _handle_snd_na(gnrc_pktsnip_t *pkt)
 static void _handle_pfx_timeout(_nib_offl_entry_t *pfx)
 {
     gnrc_netif_t *netif = gnrc_netif_get_by_pid(_nib_onl_get_if(pfx->next_hop));
-    uint32_t now = (xtimer_now_usec64() / US_PER_MS) & UINT32_MAX;
+    uint32_t now = xtimer_now_msec();
 
     gnrc_netif_acquire(netif);
     if (now >= pfx->valid_until) {
@@ -1231,6 +1231,7 @@ static void _handle_pfx_timeout(_nib_offl_entry_t *pfx)
                 netif->ipv6.addrs_flags[i] |= GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_DEPRECATED;
             }
         }
+        gnrc_ipv6_flow_cache_invalidate();
         _evtimer_add(pfx, GNRC_IPV6_NIB_PFX_TIMEOUT, &pfx->pfx_timeout,
                      pfx->valid_until - now);
     }
@@ -1267,7 +1268,8 @@ void _handle_search_rtr(gnrc_netif_t *netif)
 #if !GNRC_IPV6_NIB_CONF_NO_RTR_SOL
     gnrc_netif_acquire(netif);
     if (!(gnrc_netif_is_rtr_adv(netif)) || gnrc_netif_is_6ln(netif)) {
-        uint32_t next_rs = _evtimer_lookup(netif, GNRC_IPV6_NIB_SEARCH_RTR);
+        uint32_t next_rs = _evtimer_lookup(&netif->ipv6.search_rtr,
+                                          GNRC_IPV6_NIB_SEARCH_RTR);
         uint32_t interval = _get_next_rs_interval(netif);
 
         if (next_rs > interval) {
@@ -1353,11 +1355,11 @@ static uint32_t _handle_rdnsso(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
                 ltime = (ltime > (UINT32_MAX / MS_PER_SEC)) ?
                               (UINT32_MAX - 1) : ltime * MS_PER_SEC;
                 _evtimer_add(&sock_dns_server, GNRC_IPV6_NIB_RDNSS_TIMEOUT,
-                             &_rdnss_timeout, ltime);
+                             &_nib_rdnss_timeout, ltime);
             }
         }
         else {
-            evtimer_del(&_nib_evtimer, &_rdnss_timeout.event);
+            evtimer_del(&_nib_evtimer, &_nib_rdnss_timeout.event);
             _handle_rdnss_timeout(&sock_dns_server);
         }
     }
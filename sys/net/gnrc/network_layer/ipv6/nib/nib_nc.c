@@ -16,6 +16,7 @@
 #include <errno.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/netif.h"
@@ -31,7 +32,7 @@ int gnrc_ipv6_nib_nc_set(const ipv6_addr_t *ipv6, unsigned iface,
 
     assert(ipv6 != NULL);
     assert(l2addr_len <= GNRC_IPV6_NIB_L2ADDR_MAX_LEN);
-    assert((iface > KERNEL_PID_UNDEF) && (iface <= KERNEL_PID_LAST));
+    assert((iface > KERNEL_PID_UNDEF) && (iface <= _NIB_IF_MAX));
     mutex_lock(&_nib_mutex);
     node = _nib_nc_add(ipv6, iface, GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED);
     if (node == NULL) {
@@ -51,6 +52,7 @@ int gnrc_ipv6_nib_nc_set(const ipv6_addr_t *ipv6, unsigned iface,
                     GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK);
     node->info |= (GNRC_IPV6_NIB_NC_INFO_AR_STATE_MANUAL |
                    GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED);
+    gnrc_ipv6_flow_cache_invalidate();
     mutex_unlock(&_nib_mutex);
     return 0;
 }
@@ -70,6 +72,35 @@ void gnrc_ipv6_nib_nc_del(const ipv6_addr_t *ipv6, unsigned iface)
     mutex_unlock(&_nib_mutex);
 }
 
+static void _mark_reachable(_nib_onl_entry_t *node)
+{
+    switch (node->info & GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK) {
+        /* unmanaged entries are always reachable, incomplete ones have no
+         * link-layer address yet that could have been confirmed */
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED:
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_INCOMPLETE:
+            return;
+#if GNRC_IPV6_NIB_CONF_ARSM
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE: {
+            /* hints come with about every packet of a flow, so only restart
+             * the reachable time once half of it passed */
+            gnrc_netif_t *netif = gnrc_netif_get_by_pid(_nib_onl_get_if(node));
+            uint32_t remaining = _evtimer_lookup(&node->nud_timeout,
+                                                 GNRC_IPV6_NIB_REACH_TIMEOUT);
+
+            if ((netif != NULL) && (remaining != UINT32_MAX) &&
+                (remaining > (netif->ipv6.reach_time / 2))) {
+                return;
+            }
+            break;
+        }
+#endif  /* GNRC_IPV6_NIB_CONF_ARSM */
+        default:
+            break;
+    }
+    _nib_nc_set_reachable(node);
+}
+
 void gnrc_ipv6_nib_nc_mark_reachable(const ipv6_addr_t *ipv6)
 {
     _nib_onl_entry_t *node = NULL;
@@ -77,16 +108,41 @@ void gnrc_ipv6_nib_nc_mark_reachable(const ipv6_addr_t *ipv6)
     mutex_lock(&_nib_mutex);
     while ((node = _nib_onl_iter(node)) != NULL) {
         if ((node->mode & _NC) && ipv6_addr_equal(ipv6, &node->ipv6)) {
-            /* only set reachable if not unmanaged */
-            if ((node->info & GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK)) {
-                _nib_nc_set_reachable(node);
-            }
+            _mark_reachable(node);
             break;
         }
     }
     mutex_unlock(&_nib_mutex);
 }
 
+void gnrc_ipv6_nib_nc_mark_reachable_l2(unsigned iface, const uint8_t *l2addr,
+                                        size_t l2addr_len)
+{
+#if GNRC_IPV6_NIB_CONF_ARSM
+    _nib_onl_entry_t *node = NULL;
+
+    assert((l2addr != NULL) || (l2addr_len == 0));
+    /* the NIB acquires network interfaces while holding its mutex, so the
+     * thread of an interface must not wait for it */
+    if (!mutex_trylock(&_nib_mutex)) {
+        return;
+    }
+    while ((node = _nib_onl_iter(node)) != NULL) {
+        /* the neighbor may have more than one address: mark them all */
+        if ((node->mode & _NC) && (_nib_onl_get_if(node) == iface) &&
+            (node->l2addr_len == l2addr_len) &&
+            (memcmp(node->l2addr, l2addr, l2addr_len) == 0)) {
+            _mark_reachable(node);
+        }
+    }
+    mutex_unlock(&_nib_mutex);
+#else   /* GNRC_IPV6_NIB_CONF_ARSM */
+    (void)iface;
+    (void)l2addr;
+    (void)l2addr_len;
+#endif  /* GNRC_IPV6_NIB_CONF_ARSM */
+}
+
 bool gnrc_ipv6_nib_nc_iter(unsigned iface, void **state,
                            gnrc_ipv6_nib_nc_t *entry)
 {
@@ -0,0 +1,826 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_mpl
+ * @{
+ *
+ * @file
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "bloom.h"
+#include "byteorder.h"
+#include "mutex.h"
+#include "random.h"
+#include "thread.h"
+#include "trickle.h"
+#include "xtimer.h"
+#include "net/icmpv6.h"
+#include "net/ipv6/ext.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/gnrc.h"
+#include "net/gnrc/icmpv6.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/mpl.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define _WINDOW             (32U)   /* sequence numbers tracked per seed */
+#define _HBH_LEN            (8U)    /* hop-by-hop header with the option */
+#define _OPT_PAD1           (0U)
+#define _OPT_PADN           (1U)
+#define _BLOOM_K            (7U)
+#define _BLOOM_CAPACITY     (GNRC_MPL_BLOOM_BLOCKS * 50U)
+
+typedef struct {
+    uint32_t seen;          /* bit i: min_seq + i was received */
+    uint32_t expires;       /* in seconds */
+    uint8_t id[MPL_SEED_ID_LEN_MAX];
+    uint8_t s;              /* S of the MPL option */
+    uint8_t domain;
+    uint8_t min_seq;        /* lowest sequence number accepted */
+    bool used;
+} _seed_t;
+
+typedef struct {
+    trickle_t trickle;
+    gnrc_pktsnip_t *pkt;    /* the message in one snip, NULL if unused */
+    _seed_t *seed;
+    uint32_t age;           /* the higher, the newer */
+    uint8_t seq;
+    uint8_t expirations;    /* trickle intervals left, 0 if stopped */
+} _buf_t;
+
+typedef struct {
+    trickle_t trickle;      /* control messages */
+    ipv6_addr_t addr;
+    uint8_t seq;            /* of the next message seeded by this node */
+    uint8_t expirations;    /* trickle intervals left, 0 if stopped */
+    bool used;
+} _domain_t;
+
+kernel_pid_t gnrc_mpl_pid = KERNEL_PID_UNDEF;
+
+static char _stack[GNRC_MPL_STACK_SIZE];
+static msg_t _msg_q[GNRC_MPL_MSG_QUEUE_SIZE];
+static gnrc_netreg_entry_t _ctrl_reg;
+static mutex_t _lock = MUTEX_INIT;
+static gnrc_mpl_mode_t _mode = GNRC_MPL_MODE;
+static _domain_t _domains[GNRC_MPL_DOMAINS_NUMOF];
+static _seed_t _seeds[GNRC_MPL_SEED_SET_SIZE];
+static _buf_t _bufs[GNRC_MPL_BUFFER_SIZE];
+static uint32_t _age;
+/* sequence numbers of evicted seeds */
+static bloom_blocked_t _evicted;
+static uint32_t _evicted_blocks[BLOOM_BLOCKED_WORDS(GNRC_MPL_BLOOM_BLOCKS)];
+static unsigned _evicted_numof;
+
+static void _send_data(void *arg);
+static void _send_control(void *arg);
+
+static inline bool _proactive(void)
+{
+    return _mode != GNRC_MPL_MODE_REACTIVE;
+}
+
+static inline bool _control(void)
+{
+    return _mode != GNRC_MPL_MODE_PROACTIVE;
+}
+
+static uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+/* seeds identified by their source address keep it as 128 bit seed-id */
+static unsigned _id_len(uint8_t s)
+{
+    return (s == MPL_SEED_ID_SRC) ? MPL_SEED_ID_LEN_MAX : mpl_seed_id_len(s);
+}
+
+static void _link_local(ipv6_addr_t *ll, const ipv6_addr_t *addr)
+{
+    *ll = *addr;
+    ll->u8[1] = (ll->u8[1] & 0xf0) | IPV6_ADDR_MCAST_SCP_LINK_LOCAL;
+}
+
+static int _domain_idx(const ipv6_addr_t *addr, bool ll)
+{
+    for (unsigned i = 0; i < GNRC_MPL_DOMAINS_NUMOF; i++) {
+        ipv6_addr_t tmp = _domains[i].addr;
+
+        if (ll) {
+            _link_local(&tmp, &_domains[i].addr);
+        }
+        if (_domains[i].used && ipv6_addr_equal(&tmp, addr)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static size_t _key(uint8_t *key, const _seed_t *seed, uint8_t seq)
+{
+    key[0] = seed->domain;
+    key[1] = seed->s;
+    key[2] = seq;
+    memcpy(&key[3], seed->id, _id_len(seed->s));
+    return 3 + _id_len(seed->s);
+}
+
+static _seed_t *_seed_find(unsigned domain, uint8_t s, const uint8_t *id)
+{
+    for (unsigned i = 0; i < GNRC_MPL_SEED_SET_SIZE; i++) {
+        _seed_t *seed = &_seeds[i];
+
+        if (seed->used && (seed->domain == domain) && (seed->s == s) &&
+            (memcmp(seed->id, id, _id_len(s)) == 0)) {
+            return seed;
+        }
+    }
+    return NULL;
+}
+
+static _buf_t *_buf_find(const _seed_t *seed, uint8_t seq)
+{
+    for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+        if (_bufs[i].pkt && (_bufs[i].seed == seed) && (_bufs[i].seq == seq)) {
+            return &_bufs[i];
+        }
+    }
+    return NULL;
+}
+
+static void _buf_free(_buf_t *buf)
+{
+    trickle_stop(&buf->trickle);
+    gnrc_pktbuf_release(buf->pkt);
+    buf->pkt = NULL;
+    buf->expirations = 0;
+}
+
+/* raises the lowest sequence number accepted from seed to seq */
+static void _seed_advance(_seed_t *seed, uint8_t seq)
+{
+    uint8_t shift = seq - seed->min_seq;
+
+    if ((int8_t)shift <= 0) {
+        return;
+    }
+    seed->seen = (shift < _WINDOW) ? (seed->seen >> shift) : 0;
+    seed->min_seq = seq;
+    for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+        _buf_t *buf = &_bufs[i];
+
+        if (buf->pkt && (buf->seed == seed) && ((int8_t)(buf->seq - seq) < 0)) {
+            _buf_free(buf);
+        }
+    }
+}
+
+static void _seed_evict(_seed_t *seed)
+{
+    uint8_t key[3 + MPL_SEED_ID_LEN_MAX];
+
+    DEBUG("mpl: evicting seed of domain %u\n", (unsigned)seed->domain);
+    /* remember what was received, duplicates may still be on their way */
+    for (unsigned i = 0; i < _WINDOW; i++) {
+        if (seed->seen & (1UL << i)) {
+            if (_evicted_numof >= _BLOOM_CAPACITY) {
+                bloom_blocked_clear(&_evicted);
+                _evicted_numof = 0;
+            }
+            bloom_blocked_add(&_evicted, key, _key(key, seed, seed->min_seq + i));
+            _evicted_numof++;
+        }
+    }
+    for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+        if (_bufs[i].pkt && (_bufs[i].seed == seed)) {
+            _buf_free(&_bufs[i]);
+        }
+    }
+    seed->used = false;
+}
+
+static _seed_t *_seed_add(unsigned domain, uint8_t s, const uint8_t *id,
+                          uint8_t seq)
+{
+    _seed_t *seed = NULL;
+    uint32_t now = _now();
+
+    for (unsigned i = 0; i < GNRC_MPL_SEED_SET_SIZE; i++) {
+        if (!_seeds[i].used) {
+            seed = &_seeds[i];
+            break;
+        }
+        /* the least recently active one expires first */
+        if ((seed == NULL) ||
+            ((int32_t)(_seeds[i].expires - seed->expires) < 0)) {
+            seed = &_seeds[i];
+        }
+    }
+    if (seed->used) {
+        _seed_evict(seed);
+    }
+    seed->used = true;
+    seed->domain = domain;
+    seed->s = s;
+    memcpy(seed->id, id, _id_len(s));
+    seed->min_seq = seq;
+    seed->seen = 0;
+    seed->expires = now + GNRC_MPL_SEED_SET_ENTRY_LIFETIME;
+    return seed;
+}
+
+/* returns < 0 for an old message, 0 for a duplicate, > 0 for a new one */
+static int _seed_accept(_seed_t *seed, uint8_t seq)
+{
+    int8_t off = seq - seed->min_seq;
+
+    if (off < 0) {
+        return -1;
+    }
+    if (off >= (int8_t)_WINDOW) {
+        _seed_advance(seed, seq - _WINDOW + 1);
+        off = _WINDOW - 1;
+    }
+    if (seed->seen & (1UL << off)) {
+        return 0;
+    }
+    seed->seen |= (1UL << off);
+    seed->expires = _now() + GNRC_MPL_SEED_SET_ENTRY_LIFETIME;
+    return 1;
+}
+
+static bool _seed_has(const _seed_t *seed, uint8_t seq)
+{
+    int8_t off = seq - seed->min_seq;
+
+    if (off < 0) {
+        /* not accepted anymore anyway */
+        return true;
+    }
+    return (off < (int8_t)_WINDOW) && (seed->seen & (1UL << off));
+}
+
+static void _data_start(_buf_t *buf)
+{
+    if (buf->expirations == 0) {
+        trickle_start(gnrc_mpl_pid, &buf->trickle, GNRC_MPL_MSG_TYPE_TRICKLE,
+                      GNRC_MPL_DATA_MESSAGE_IMIN, GNRC_MPL_DATA_MESSAGE_IMAX,
+                      GNRC_MPL_DATA_MESSAGE_K);
+    }
+    else if (buf->trickle.I > buf->trickle.Imin) {
+        trickle_reset_timer(&buf->trickle);
+    }
+    buf->expirations = GNRC_MPL_DATA_MESSAGE_TIMER_EXPIRATIONS;
+}
+
+static void _control_reset(_domain_t *domain)
+{
+    if (domain->expirations == 0) {
+        trickle_start(gnrc_mpl_pid, &domain->trickle, GNRC_MPL_MSG_TYPE_TRICKLE,
+                      GNRC_MPL_CONTROL_MESSAGE_IMIN,
+                      GNRC_MPL_CONTROL_MESSAGE_IMAX,
+                      GNRC_MPL_CONTROL_MESSAGE_K);
+    }
+    else if (domain->trickle.I > domain->trickle.Imin) {
+        trickle_reset_timer(&domain->trickle);
+    }
+    domain->expirations = GNRC_MPL_CONTROL_MESSAGE_TIMER_EXPIRATIONS;
+}
+
+static void _buf_add(_seed_t *seed, uint8_t seq, gnrc_pktsnip_t *pkt)
+{
+    _buf_t *buf = NULL;
+
+    for (unsigned i = 0; (i < GNRC_MPL_BUFFER_SIZE) && (buf == NULL); i++) {
+        if (_bufs[i].pkt == NULL) {
+            buf = &_bufs[i];
+        }
+    }
+    if (buf == NULL) {
+        /* evict the oldest message, preferring those sent on already */
+        buf = &_bufs[0];
+        for (unsigned i = 1; i < GNRC_MPL_BUFFER_SIZE; i++) {
+            _buf_t *tmp = &_bufs[i];
+
+            if (((tmp->expirations == 0) && (buf->expirations != 0)) ||
+                (((tmp->expirations == 0) == (buf->expirations == 0)) &&
+                 ((int32_t)(tmp->age - buf->age) < 0))) {
+                buf = tmp;
+            }
+        }
+        _seed_t *old = buf->seed;
+        uint8_t old_seq = buf->seq;
+
+        _buf_free(buf);
+        _seed_advance(old, old_seq + 1);
+        if ((int8_t)(seq - seed->min_seq) < 0) {
+            /* only newer messages of the same seed were buffered */
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+    }
+    buf->pkt = pkt;
+    buf->seed = seed;
+    buf->seq = seq;
+    buf->age = _age++;
+    buf->expirations = 0;
+    buf->trickle.callback.func = _send_data;
+    buf->trickle.callback.args = buf;
+    if (_proactive()) {
+        _data_start(buf);
+    }
+    if (_control()) {
+        _control_reset(&_domains[seed->domain]);
+    }
+}
+
+static const mpl_opt_t *_find_opt(const uint8_t *hbh, size_t size)
+{
+    size_t len;
+
+    if ((size < sizeof(ipv6_ext_t)) ||
+        ((len = (hbh[1] + 1) * IPV6_EXT_LEN_UNIT) > size)) {
+        return NULL;
+    }
+    for (size_t pos = sizeof(ipv6_ext_t); pos < len;) {
+        if (hbh[pos] == _OPT_PAD1) {
+            pos++;
+            continue;
+        }
+        if (((pos + 2) > len) || ((pos + 2 + hbh[pos + 1]) > len)) {
+            return NULL;
+        }
+        if (hbh[pos] == MPL_OPT_TYPE) {
+            return (const mpl_opt_t *)&hbh[pos];
+        }
+        pos += 2 + hbh[pos + 1];
+    }
+    return NULL;
+}
+
+/* copies a packet in receive order to one snip in send order */
+static gnrc_pktsnip_t *_copy(gnrc_pktsnip_t *pkt)
+{
+    size_t len = gnrc_pkt_len_upto(pkt, GNRC_NETTYPE_IPV6);
+    gnrc_pktsnip_t *copy = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_IPV6);
+
+    if (copy == NULL) {
+        return NULL;
+    }
+    uint8_t *data = (uint8_t *)copy->data + len;
+
+    for (gnrc_pktsnip_t *snip = pkt; snip != NULL; snip = snip->next) {
+        data -= snip->size;
+        memcpy(data, snip->data, snip->size);
+        if (snip->type == GNRC_NETTYPE_IPV6) {
+            break;
+        }
+    }
+    return copy;
+}
+
+gnrc_pktsnip_t *gnrc_mpl_seed(gnrc_pktsnip_t *pkt)
+{
+    const ipv6_hdr_t *hdr = pkt->data;
+    size_t len = gnrc_pkt_len(pkt);
+    gnrc_pktsnip_t *msg;
+    ipv6_hdr_t *msg_hdr;
+    uint8_t *hbh;
+    int idx;
+
+    if (ipv6_addr_is_unspecified(&hdr->src)) {
+        /* no seed-id, send it as it is */
+        return pkt;
+    }
+    msg = gnrc_pktbuf_add(NULL, NULL, len + _HBH_LEN, GNRC_NETTYPE_IPV6);
+    if (msg == NULL) {
+        DEBUG("mpl: no space for data message\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    msg_hdr = msg->data;
+    hbh = (uint8_t *)msg->data + sizeof(ipv6_hdr_t);
+    memcpy(msg_hdr, hdr, sizeof(ipv6_hdr_t));
+    len = sizeof(ipv6_hdr_t) + _HBH_LEN;
+    for (gnrc_pktsnip_t *snip = pkt->next; snip != NULL; snip = snip->next) {
+        memcpy((uint8_t *)msg->data + len, snip->data, snip->size);
+        len += snip->size;
+    }
+    gnrc_pktbuf_release(pkt);
+
+    /* hop-by-hop header with the MPL option, seed-id is the source */
+    hbh[0] = msg_hdr->nh;
+    hbh[1] = 0;
+    hbh[2] = MPL_OPT_TYPE;
+    hbh[3] = MPL_OPT_LEN_MIN;
+    hbh[4] = (MPL_SEED_ID_SRC << MPL_OPT_S_POS) | MPL_OPT_M;
+    hbh[5] = 0;
+    hbh[6] = _OPT_PADN;
+    hbh[7] = 0;
+    msg_hdr->nh = PROTNUM_IPV6_EXT_HOPOPT;
+    msg_hdr->len = byteorder_htons(len - sizeof(ipv6_hdr_t));
+
+    mutex_lock(&_lock);
+    if ((idx = _domain_idx(&msg_hdr->dst, false)) >= 0) {
+        uint8_t seq = _domains[idx].seq++;
+        _seed_t *seed = _seed_find(idx, MPL_SEED_ID_SRC, msg_hdr->src.u8);
+
+        hbh[5] = seq;
+        if (seed == NULL) {
+            seed = _seed_add(idx, MPL_SEED_ID_SRC, msg_hdr->src.u8, seq);
+        }
+        if (_seed_accept(seed, seq) > 0) {
+            gnrc_pktbuf_hold(msg, 1);
+            _buf_add(seed, seq, msg);
+        }
+    }
+    mutex_unlock(&_lock);
+    return msg;
+}
+
+bool gnrc_mpl_receive(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *ipv6)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+    const mpl_opt_t *opt = _find_opt(pkt->data, pkt->size);
+    const uint8_t *id;
+    bool drop = true;
+    uint8_t s;
+    int idx;
+
+    if (opt == NULL) {
+        return false;
+    }
+    s = (opt->flags & MPL_OPT_S_MASK) >> MPL_OPT_S_POS;
+    if ((opt->len < (MPL_OPT_LEN_MIN + mpl_seed_id_len(s))) ||
+        (opt->flags & MPL_OPT_V)) {
+        DEBUG("mpl: invalid MPL option\n");
+        return true;
+    }
+    id = (s == MPL_SEED_ID_SRC) ? hdr->src.u8 : (const uint8_t *)(opt + 1);
+
+    mutex_lock(&_lock);
+    if ((idx = _domain_idx(&hdr->dst, false)) < 0) {
+        /* not forwarding for that domain */
+        mutex_unlock(&_lock);
+        return false;
+    }
+
+    _seed_t *seed = _seed_find(idx, s, id);
+
+    if (seed == NULL) {
+        uint8_t key[3 + MPL_SEED_ID_LEN_MAX];
+
+        seed = _seed_add(idx, s, id, opt->seq);
+        if ((_evicted_numof > 0) &&
+            bloom_blocked_check(&_evicted, key, _key(key, seed, opt->seq))) {
+            DEBUG("mpl: duplicate of evicted seed\n");
+            seed->min_seq = opt->seq + 1;
+            goto out;
+        }
+    }
+    switch (_seed_accept(seed, opt->seq)) {
+        case 0: {
+            /* a neighbor sent what is buffered here */
+            _buf_t *buf = _buf_find(seed, opt->seq);
+
+            if ((buf != NULL) && (buf->expirations > 0)) {
+                trickle_increment_counter(&buf->trickle);
+            }
+        }
+        /* fall through */
+        case -1:
+            DEBUG("mpl: dropping duplicate %u\n", (unsigned)opt->seq);
+            goto out;
+        default:
+            break;
+    }
+    drop = false;
+    if (hdr->hl > 1) {
+        gnrc_pktsnip_t *copy = _copy(pkt);
+
+        if (copy != NULL) {
+            ((ipv6_hdr_t *)copy->data)->hl--;
+            _buf_add(seed, opt->seq, copy);
+        }
+        else {
+            DEBUG("mpl: no space to buffer message %u\n", (unsigned)opt->seq);
+        }
+    }
+out:
+    mutex_unlock(&_lock);
+    return drop;
+}
+
+static void _send_data(void *arg)
+{
+    _buf_t *buf = arg;
+    msg_t msg = { .type = GNRC_IPV6_MSG_TYPE_SND_PREPARED,
+                  .content = { .ptr = buf->pkt } };
+
+    DEBUG("mpl: sending message %u\n", (unsigned)buf->seq);
+    gnrc_pktbuf_hold(buf->pkt, 1);
+    if (msg_try_send(&msg, gnrc_ipv6_pid) < 1) {
+        DEBUG("mpl: unable to hand message over to IPv6\n");
+        gnrc_pktbuf_release(buf->pkt);
+    }
+}
+
+static size_t _seed_info(const _seed_t *seed, uint8_t *info)
+{
+    unsigned id_len = _id_len(seed->s);
+    unsigned bm_len = 0;
+
+    for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+        if (_bufs[i].pkt && (_bufs[i].seed == seed)) {
+            unsigned len = ((uint8_t)(_bufs[i].seq - seed->min_seq) / 8) + 1;
+
+            bm_len = (len > bm_len) ? len : bm_len;
+        }
+    }
+    if (info != NULL) {
+        uint8_t *bm = &info[2 + id_len];
+
+        info[0] = seed->min_seq;
+        info[1] = (bm_len << MPL_SEED_INFO_BM_POS) | seed->s;
+        memcpy(&info[2], seed->id, id_len);
+        memset(bm, 0, bm_len);
+        for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+            if (_bufs[i].pkt && (_bufs[i].seed == seed)) {
+                uint8_t off = _bufs[i].seq - seed->min_seq;
+
+                bm[off / 8] |= 0x80 >> (off % 8);
+            }
+        }
+    }
+    return 2 + id_len + bm_len;
+}
+
+static void _send_control(void *arg)
+{
+    _domain_t *domain = arg;
+    unsigned idx = domain - _domains;
+    gnrc_pktsnip_t *pkt, *ipv6;
+    ipv6_addr_t dst;
+    size_t len = 0;
+
+    for (unsigned i = 0; i < GNRC_MPL_SEED_SET_SIZE; i++) {
+        if (_seeds[i].used && (_seeds[i].domain == idx)) {
+            len += _seed_info(&_seeds[i], NULL);
+        }
+    }
+    pkt = gnrc_icmpv6_build(NULL, ICMPV6_MPL_CTRL, 0,
+                            sizeof(icmpv6_hdr_t) + len);
+    if (pkt == NULL) {
+        DEBUG("mpl: no space for control message\n");
+        return;
+    }
+    len = sizeof(icmpv6_hdr_t);
+    for (unsigned i = 0; i < GNRC_MPL_SEED_SET_SIZE; i++) {
+        if (_seeds[i].used && (_seeds[i].domain == idx)) {
+            len += _seed_info(&_seeds[i], (uint8_t *)pkt->data + len);
+        }
+    }
+    _link_local(&dst, &domain->addr);
+    if ((ipv6 = gnrc_ipv6_hdr_build(pkt, NULL, &dst)) == NULL) {
+        DEBUG("mpl: no space for IPv6 header of control message\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ((ipv6_hdr_t *)ipv6->data)->hl = 255;
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6,
+                                   GNRC_NETREG_DEMUX_CTX_ALL, ipv6)) {
+        DEBUG("mpl: unable to send control message\n");
+        gnrc_pktbuf_release(ipv6);
+    }
+}
+
+/* compares the seed infos of a neighbor with the seed set */
+static void _recv_seed_info(unsigned idx, const uint8_t *info, size_t len)
+{
+    bool listed[GNRC_MPL_SEED_SET_SIZE] = { false };
+    bool inconsistent = false;
+
+    while (len >= 2) {
+        uint8_t min_seq = info[0];
+        uint8_t s = info[1] & MPL_SEED_INFO_S_MASK;
+        unsigned bm_bits = (info[1] >> MPL_SEED_INFO_BM_POS) * 8;
+        unsigned info_len = 2 + _id_len(s) + (bm_bits / 8);
+        const uint8_t *bm = &info[2 + _id_len(s)];
+        _seed_t *seed;
+
+        if (len < info_len) {
+            break;
+        }
+        seed = _seed_find(idx, s, &info[2]);
+        if (seed != NULL) {
+            listed[seed - _seeds] = true;
+            /* messages the neighbor misses */
+            for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+                _buf_t *buf = &_bufs[i];
+                uint8_t off = buf->seq - min_seq;
+
+                if (buf->pkt && (buf->seed == seed) && ((int8_t)off >= 0) &&
+                    ((off >= bm_bits) || !(bm[off / 8] & (0x80 >> (off % 8))))) {
+                    _data_start(buf);
+                    inconsistent = true;
+                }
+            }
+        }
+        /* messages missed here */
+        for (unsigned i = 0; i < bm_bits; i++) {
+            if ((bm[i / 8] & (0x80 >> (i % 8))) &&
+                ((seed == NULL) || !_seed_has(seed, min_seq + i))) {
+                inconsistent = true;
+            }
+        }
+        info += info_len;
+        len -= info_len;
+    }
+    /* seeds the neighbor does not know */
+    for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+        _buf_t *buf = &_bufs[i];
+
+        if (buf->pkt && (buf->seed->domain == idx) &&
+            !listed[buf->seed - _seeds]) {
+            _data_start(buf);
+            inconsistent = true;
+        }
+    }
+    if (inconsistent) {
+        _control_reset(&_domains[idx]);
+    }
+    else if (_domains[idx].expirations > 0) {
+        trickle_increment_counter(&_domains[idx].trickle);
+    }
+}
+
+static void _recv_control(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+    ipv6_hdr_t *hdr;
+    int idx;
+
+    if ((ipv6 == NULL) || (pkt->size < sizeof(icmpv6_hdr_t))) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    hdr = ipv6->data;
+    mutex_lock(&_lock);
+    if (ipv6_addr_is_link_local(&hdr->src) &&
+        ((idx = _domain_idx(&hdr->dst, true)) >= 0)) {
+        _recv_seed_info(idx, (uint8_t *)pkt->data + sizeof(icmpv6_hdr_t),
+                        pkt->size - sizeof(icmpv6_hdr_t));
+    }
+    mutex_unlock(&_lock);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _trickle(trickle_t *trickle)
+{
+    uint8_t *expirations = NULL;
+
+    for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+        if ((&_bufs[i].trickle == trickle) && (_bufs[i].pkt != NULL)) {
+            expirations = &_bufs[i].expirations;
+        }
+    }
+    for (unsigned i = 0; i < GNRC_MPL_DOMAINS_NUMOF; i++) {
+        if (&_domains[i].trickle == trickle) {
+            expirations = &_domains[i].expirations;
+        }
+    }
+    /* the timer may have stopped while its message was queued */
+    if ((expirations == NULL) || (*expirations == 0)) {
+        return;
+    }
+    trickle_callback(trickle);
+    if (--(*expirations) == 0) {
+        trickle_stop(trickle);
+    }
+}
+
+static void *_event_loop(void *arg)
+{
+    msg_t msg, reply = { .type = GNRC_NETAPI_MSG_TYPE_ACK,
+                         .content = { .value = -ENOTSUP } };
+
+    (void)arg;
+    msg_init_queue(_msg_q, GNRC_MPL_MSG_QUEUE_SIZE);
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_MPL_MSG_TYPE_TRICKLE:
+                mutex_lock(&_lock);
+                _trickle(msg.content.ptr);
+                mutex_unlock(&_lock);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+                _recv_control(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+kernel_pid_t gnrc_mpl_init(void)
+{
+    static const ipv6_addr_t all_mpl_forwarders = MPL_ALL_FORWARDERS_REALM_LOCAL;
+    uint8_t key[SIPHASH_KEY_LEN];
+
+    if (gnrc_mpl_pid != KERNEL_PID_UNDEF) {
+        return gnrc_mpl_pid;
+    }
+    random_bytes(key, sizeof(key));
+    bloom_blocked_init(&_evicted, _evicted_blocks, GNRC_MPL_BLOOM_BLOCKS,
+                       _BLOOM_K, key);
+    gnrc_mpl_pid = thread_create(_stack, sizeof(_stack), GNRC_MPL_PRIO,
+                                 THREAD_CREATE_STACKTEST, _event_loop, NULL,
+                                 "mpl");
+    if (gnrc_mpl_pid == KERNEL_PID_UNDEF) {
+        DEBUG("mpl: could not start the thread\n");
+        return KERNEL_PID_UNDEF;
+    }
+    gnrc_netreg_entry_init_pid(&_ctrl_reg, ICMPV6_MPL_CTRL, gnrc_mpl_pid);
+    gnrc_netreg_register(GNRC_NETTYPE_ICMPV6, &_ctrl_reg);
+    gnrc_mpl_domain_add(&all_mpl_forwarders);
+    return gnrc_mpl_pid;
+}
+
+int gnrc_mpl_domain_add(const ipv6_addr_t *addr)
+{
+    _domain_t *domain = NULL;
+    ipv6_addr_t ll;
+
+    if (!ipv6_addr_is_multicast(addr) ||
+        ((addr->u8[1] & 0x0f) < IPV6_ADDR_MCAST_SCP_REALM_LOCAL)) {
+        return -EINVAL;
+    }
+    mutex_lock(&_lock);
+    if (_domain_idx(addr, false) >= 0) {
+        mutex_unlock(&_lock);
+        return 0;
+    }
+    for (unsigned i = 0; (i < GNRC_MPL_DOMAINS_NUMOF) && !domain; i++) {
+        if (!_domains[i].used) {
+            domain = &_domains[i];
+        }
+    }
+    if (domain == NULL) {
+        mutex_unlock(&_lock);
+        return -ENOMEM;
+    }
+    domain->used = true;
+    domain->addr = *addr;
+    domain->seq = random_uint32();
+    domain->expirations = 0;
+    domain->trickle.callback.func = _send_control;
+    domain->trickle.callback.args = domain;
+    mutex_unlock(&_lock);
+
+    _link_local(&ll, addr);
+    for (gnrc_netif_t *netif = gnrc_netif_iter(NULL); netif != NULL;
+         netif = gnrc_netif_iter(netif)) {
+        gnrc_netif_ipv6_group_join_internal(netif, addr);
+        gnrc_netif_ipv6_group_join_internal(netif, &ll);
+    }
+    return 0;
+}
+
+bool gnrc_mpl_is_domain(const ipv6_addr_t *addr)
+{
+    bool res;
+
+    mutex_lock(&_lock);
+    res = (_domain_idx(addr, false) >= 0);
+    mutex_unlock(&_lock);
+    return res;
+}
+
+void gnrc_mpl_set_mode(gnrc_mpl_mode_t mode)
+{
+    mutex_lock(&_lock);
+    _mode = mode;
+    mutex_unlock(&_lock);
+}
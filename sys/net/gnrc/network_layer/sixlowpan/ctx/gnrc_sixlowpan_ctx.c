@@ -17,6 +17,7 @@
 
 #include "mutex.h"
 #include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
 #include "xtimer.h"
 
 #define ENABLE_DEBUG    (0)
@@ -126,6 +127,7 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
     _ctx_inval_times[id] = ltime + _current_minute();
 
     mutex_unlock(&_ctx_mutex);
+    gnrc_sixlowpan_iphc_cache_invalidate();
     return &(_ctxs[id]);
 }
 
@@ -161,6 +163,7 @@ static void _update_lifetime(uint8_t id)
 void gnrc_sixlowpan_ctx_reset(void)
 {
     memset(_ctxs, 0, sizeof(_ctxs));
+    gnrc_sixlowpan_iphc_cache_invalidate();
 }
 #endif
 
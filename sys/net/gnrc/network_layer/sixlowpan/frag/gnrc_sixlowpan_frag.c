@@ -23,17 +23,22 @@
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/internal.h"
 #include "net/gnrc/netif.h"
+#include "net/gnrc/priority_pktqueue.h"
 #include "net/sixlowpan.h"
 #include "utlist.h"
 
 #include "rbuf.h"
+#include "vrb.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-static gnrc_sixlowpan_msg_frag_t _fragment_msg = {
-        NULL, 0, 0, KERNEL_PID_UNDEF
-    };
+static gnrc_sixlowpan_msg_frag_t _fragment_msg[GNRC_SIXLOWPAN_MSG_FRAG_SIZE];
+/* datagrams currently being fragmented, by priority */
+static gnrc_priority_pktqueue_t _frag_queue = PRIORITY_PKTQUEUE_INIT;
+static gnrc_priority_pktqueue_node_t _frag_nodes[GNRC_SIXLOWPAN_MSG_FRAG_SIZE];
+/* a GNRC_SIXLOWPAN_MSG_FRAG_SND message is in the message queue */
+static bool _frag_sched_pending;
 
 #if ENABLE_DEBUG
 /* For PRIu16 etc. */
@@ -87,7 +92,8 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
 }
 
 static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size)
+                                   size_t payload_len, size_t datagram_size,
+                                   uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     uint16_t local_offset = 0;
@@ -115,7 +121,7 @@ static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
 
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
 
     /* Tell the link layer that we will send more fragments */
     gnrc_netif_hdr_t *netif_hdr = frag->data;
@@ -138,14 +144,14 @@ static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
 
     DEBUG("6lo frag: send first fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, local_offset);
+          (unsigned int)datagram_size, tag, local_offset);
     gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
     return local_offset;
 }
 
 static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
                                    size_t payload_len, size_t datagram_size,
-                                   uint16_t offset)
+                                   uint16_t offset, uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     /* since dispatches aren't supposed to go into subsequent fragments, we need not account
@@ -171,7 +177,7 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
     /* XXX: truncation of datagram_size > 4095 may happen here */
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
     /* don't mention payload diff in offset */
     hdr->offset = (uint8_t)((offset + (datagram_size - payload_len)) >> 3);
     pkt = pkt->next;    /* don't copy netif header */
@@ -223,86 +229,149 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
     DEBUG("6lo frag: send subsequent fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", offset: %" PRIu8 " (%u bytes), "
           "fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, hdr->offset, hdr->offset << 3,
+          (unsigned int)datagram_size, tag, hdr->offset, hdr->offset << 3,
           local_offset);
     gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
     return local_offset;
 }
 
+uint16_t gnrc_sixlowpan_frag_next_tag(void)
+{
+    return ++_tag;
+}
+
 gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void)
 {
-    return (_fragment_msg.pkt == NULL) ? &_fragment_msg : NULL;
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_MSG_FRAG_SIZE; i++) {
+        if (_fragment_msg[i].pkt == NULL) {
+            return &_fragment_msg[i];
+        }
+    }
+    return NULL;
 }
 
-void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
+static inline unsigned _frag_msg_idx(const gnrc_sixlowpan_msg_frag_t *fragment_msg)
+{
+    return fragment_msg - _fragment_msg;
+}
+
+static void _frag_sched_add(gnrc_sixlowpan_msg_frag_t *fragment_msg)
+{
+    gnrc_priority_pktqueue_node_t *node = &_frag_nodes[_frag_msg_idx(fragment_msg)];
+
+    /* smaller datagrams take precedence, so they are not held up by large
+     * ones. Datagrams of equal size are served round-robin (a node is queued
+     * behind all nodes of the same priority) */
+    gnrc_priority_pktqueue_node_init(node, fragment_msg->datagram_size,
+                                     fragment_msg->pkt);
+    gnrc_priority_pktqueue_push(&_frag_queue, node);
+}
+
+static void _frag_sched_trigger(void)
+{
+    msg_t msg;
+
+    if (_frag_sched_pending ||
+        (gnrc_priority_pktqueue_length(&_frag_queue) == 0)) {
+        return;
+    }
+    /* go through the message queue between any two fragments so packets
+     * that do not need fragmentation (and the fragments of other datagrams)
+     * can be sent in between */
+    msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
+    msg.content.ptr = NULL;
+    if (msg_send_to_self(&msg)) {
+        _frag_sched_pending = true;
+    }
+    else {
+        DEBUG("6lo frag: message queue full, retry on next datagram\n");
+    }
+}
+
+static void _frag_msg_free(gnrc_sixlowpan_msg_frag_t *fragment_msg)
+{
+    /* remove original packet from packet buffer */
+    gnrc_pktbuf_release(fragment_msg->pkt);
+    /* slot is free for next fragmentation */
+    fragment_msg->pkt = NULL;
+}
+
+/* sends the next fragment of the datagram in fragment_msg. Returns true when
+ * the datagram was sent completely or could not be sent */
+static bool _send_fragment(gnrc_sixlowpan_msg_frag_t *fragment_msg)
 {
-    assert(ctx != NULL);
-    gnrc_sixlowpan_msg_frag_t *fragment_msg = ctx;
     gnrc_netif_t *iface = gnrc_netif_get_by_pid(fragment_msg->pid);
     uint16_t res;
     /* payload_len: actual size of the packet vs
      * datagram_size: size of the uncompressed IPv6 packet */
     size_t payload_len = gnrc_pkt_len(fragment_msg->pkt->next);
-    msg_t msg;
 
-    assert((fragment_msg->pkt == pkt) || (pkt == NULL));
-    (void)page;
-    (void)pkt;
 #if defined(DEVELHELP) && ENABLE_DEBUG
     if (iface == NULL) {
         DEBUG("6lo frag: iface == NULL, expect segmentation fault.\n");
-        /* remove original packet from packet buffer */
-        gnrc_pktbuf_release(fragment_msg->pkt);
-        /* 6LoWPAN free for next fragmentation */
-        fragment_msg->pkt = NULL;
-        return;
+        return true;
     }
 #endif
 
     /* Check whether to send the first or an Nth fragment */
     if (fragment_msg->offset == 0) {
-        /* increment tag for successive, fragmented datagrams */
-        _tag++;
-        if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size)) == 0) {
+        if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
+                                      fragment_msg->tag)) == 0) {
             /* error sending first fragment */
             DEBUG("6lo frag: error sending 1st fragment\n");
-            gnrc_pktbuf_release(fragment_msg->pkt);
-            fragment_msg->pkt = NULL;
-            return;
+            return true;
         }
-        fragment_msg->offset += res;
+    }
+    /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
+    else if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
+                                       fragment_msg->offset, fragment_msg->tag)) == 0) {
+        /* error sending subsequent fragment */
+        DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
+              ")\n", fragment_msg->offset);
+        return true;
+    }
+    fragment_msg->offset += res;
+    return (fragment_msg->offset >= payload_len);
+}
 
-        /* send message to self*/
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = (void *)fragment_msg;
-        msg_send_to_self(&msg);
-        thread_yield();
+void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
+{
+    gnrc_sixlowpan_msg_frag_t *fragment_msg = ctx;
+
+    (void)page;
+    if (pkt != NULL) {
+        /* new datagram */
+        assert((fragment_msg != NULL) && (fragment_msg->pkt == pkt));
+        /* increment tag for successive, fragmented datagrams */
+        fragment_msg->tag = gnrc_sixlowpan_frag_next_tag();
+        _frag_sched_add(fragment_msg);
+        if (_frag_sched_pending) {
+            return;
+        }
     }
     else {
-        /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
-        if (fragment_msg->offset < payload_len) {
-            if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
-                                          fragment_msg->offset)) == 0) {
-                /* error sending subsequent fragment */
-                DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
-                      ")\n", fragment_msg->offset);
-                gnrc_pktbuf_release(fragment_msg->pkt);
-                fragment_msg->pkt = NULL;
-                return;
-                }
-            fragment_msg->offset += res;
+        _frag_sched_pending = false;
+    }
 
-            /* send message to self*/
-            msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-            msg.content.ptr = (void *)fragment_msg;
-            msg_send_to_self(&msg);
-            thread_yield();
+    pkt = gnrc_priority_pktqueue_pop(&_frag_queue);
+    if (pkt != NULL) {
+        fragment_msg = NULL;
+        for (unsigned i = 0; i < GNRC_SIXLOWPAN_MSG_FRAG_SIZE; i++) {
+            if (_fragment_msg[i].pkt == pkt) {
+                fragment_msg = &_fragment_msg[i];
+                break;
+            }
+        }
+        assert(fragment_msg != NULL);
+        if (_send_fragment(fragment_msg)) {
+            _frag_msg_free(fragment_msg);
         }
         else {
-            gnrc_pktbuf_release(fragment_msg->pkt);
-            fragment_msg->pkt = NULL;
+            _frag_sched_add(fragment_msg);
         }
     }
+    _frag_sched_trigger();
+    thread_yield();
 }
 
 void gnrc_sixlowpan_frag_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
@@ -327,6 +396,9 @@ void gnrc_sixlowpan_frag_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             return;
     }
 
+    if (vrb_forward(hdr, pkt, offset)) {
+        return;
+    }
     rbuf_add(hdr, pkt, offset, page);
 }
 
@@ -369,6 +441,13 @@ void gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(gnrc_sixlowpan_rbuf_t *rbuf
         new_netif_hdr->lqi = netif_hdr->lqi;
         new_netif_hdr->rssi = netif_hdr->rssi;
         LL_APPEND(rbuf->pkt, netif);
+        /* the datagram leaves the reassembly buffer */
+        if (gnrc_pktbuf_set_class(rbuf->pkt, GNRC_PKTBUF_CLASS_RX) < 0) {
+            DEBUG("6lo rbuf: RX quota exceeded\n");
+            gnrc_pktbuf_release(rbuf->pkt);
+            gnrc_sixlowpan_frag_rbuf_remove(rbuf);
+            return;
+        }
         gnrc_sixlowpan_dispatch_recv(rbuf->pkt, NULL, 0);
         gnrc_sixlowpan_frag_rbuf_remove(rbuf);
     }
@@ -43,8 +43,23 @@
 #endif
 
 static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
+/* intervals that were returned by rbuf_rm() */
+static rbuf_int_t *_rbuf_int_free;
+/* number of intervals in rbuf_int that were never used */
+static unsigned _rbuf_int_unused = RBUF_INT_SIZE;
 
 static rbuf_t rbuf[RBUF_SIZE];
+/* index over the entries in use, hashed by source address and tag */
+static rbuf_t *_rbuf_hash[RBUF_HASH_SIZE];
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+static gnrc_sixlowpan_frag_stats_t _stats;
+static unsigned _rbuf_used;
+
+#define _STATS_INC(field)   _stats.field++
+#else
+#define _STATS_INC(field)   (void)0
+#endif
 
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
@@ -155,6 +170,52 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     gnrc_pktbuf_release(pkt);
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+gnrc_sixlowpan_frag_stats_t *gnrc_sixlowpan_frag_stats_get(void)
+{
+    return &_stats;
+}
+#endif
+
+static inline unsigned _rbuf_hash_bucket(const uint8_t *src, size_t src_len,
+                                         uint16_t tag)
+{
+    /* tags are assigned per sender, so mix in the last byte of its address */
+    return (tag ^ ((src_len > 0) ? src[src_len - 1] : 0)) % RBUF_HASH_SIZE;
+}
+
+static inline void _rbuf_hash_add(rbuf_t *entry)
+{
+    unsigned bucket = _rbuf_hash_bucket(entry->super.src, entry->super.src_len,
+                                        entry->super.tag);
+
+    entry->hash_next = _rbuf_hash[bucket];
+    _rbuf_hash[bucket] = entry;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    if (++_rbuf_used > _stats.rbuf_max_used) {
+        _stats.rbuf_max_used = _rbuf_used;
+    }
+#endif
+}
+
+static inline void _rbuf_hash_del(rbuf_t *entry)
+{
+    unsigned bucket = _rbuf_hash_bucket(entry->super.src, entry->super.src_len,
+                                        entry->super.tag);
+
+    for (rbuf_t **ptr = &_rbuf_hash[bucket]; *ptr != NULL;
+         ptr = &(*ptr)->hash_next) {
+        if (*ptr == entry) {
+            *ptr = entry->hash_next;
+            entry->hash_next = NULL;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+            _rbuf_used--;
+#endif
+            return;
+        }
+    }
+}
+
 static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
 {
     /* start and ends are both inclusive, so using <= for both */
@@ -164,13 +225,16 @@ static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, ui
 
 static rbuf_int_t *_rbuf_int_get_free(void)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
-    }
+    rbuf_int_t *res = _rbuf_int_free;
 
-    return NULL;
+    if (res != NULL) {
+        _rbuf_int_free = res->next;
+        res->next = NULL;
+    }
+    else if (_rbuf_int_unused > 0) {
+        res = &rbuf_int[RBUF_INT_SIZE - _rbuf_int_unused--];
+    }
+    return res;
 }
 
 void rbuf_rm(rbuf_t *entry)
@@ -180,10 +244,14 @@ void rbuf_rm(rbuf_t *entry)
 
         entry->ints->start = 0;
         entry->ints->end = 0;
-        entry->ints->next = NULL;
+        entry->ints->next = _rbuf_int_free;
+        _rbuf_int_free = entry->ints;
         entry->ints = next;
     }
 
+    if (entry->super.pkt != NULL) {
+        _rbuf_hash_del(entry);
+    }
     entry->super.pkt = NULL;
 }
 
@@ -196,6 +264,7 @@ static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
 
     if (new == NULL) {
         DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
+        _STATS_INC(ints_full);
         return false;
     }
 
@@ -237,6 +306,7 @@ void rbuf_gc(void)
 
             gnrc_pktbuf_release(rbuf[i].super.pkt);
             rbuf_rm(&(rbuf[i]));
+            _STATS_INC(rbuf_timeouts);
         }
     }
 }
@@ -253,27 +323,30 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     rbuf_t *res = NULL, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
 
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].super.pkt != NULL) && (rbuf[i].super.pkt->size == size) &&
-            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
+    /* check first if entry already available */
+    for (rbuf_t *entry = _rbuf_hash[_rbuf_hash_bucket(src, src_len, tag)];
+         entry != NULL; entry = entry->hash_next) {
+        if ((entry->super.pkt->size == size) &&
+            (entry->super.tag == tag) && (entry->super.src_len == src_len) &&
+            (entry->super.dst_len == dst_len) &&
+            (memcmp(entry->super.src, src, src_len) == 0) &&
+            (memcmp(entry->super.dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)entry,
+                  gnrc_netif_addr_to_str(entry->super.src,
+                                         entry->super.src_len,
                                          l2addr_str));
             DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
+                  gnrc_netif_addr_to_str(entry->super.dst,
+                                         entry->super.dst_len,
                                          l2addr_str),
-                  (unsigned)rbuf[i].super.pkt->size, rbuf[i].super.tag);
-            rbuf[i].arrival = now_usec;
+                  (unsigned)entry->super.pkt->size, entry->super.tag);
+            entry->arrival = now_usec;
             _set_rbuf_timeout();
-            return &(rbuf[i]);
+            return entry;
         }
+    }
 
+    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
         /* if there is a free spot: remember it */
         if ((res == NULL) && (rbuf[i].super.pkt == NULL)) {
             res = &(rbuf[i]);
@@ -294,6 +367,7 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
         DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
         gnrc_pktbuf_release(oldest->super.pkt);
         rbuf_rm(oldest);
+        _STATS_INC(rbuf_full);
         res = oldest;
     }
 
@@ -315,6 +389,12 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
         DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
         return NULL;
     }
+    if (gnrc_pktbuf_set_class(res->super.pkt, GNRC_PKTBUF_CLASS_REASS) < 0) {
+        DEBUG("6lo rfrag: reassembly buffer quota exceeded.\n");
+        gnrc_pktbuf_release(res->super.pkt);
+        res->super.pkt = NULL;
+        return NULL;
+    }
 
     *((uint64_t *)res->super.pkt->data) = 0;  /* clean first few bytes for later
                                                * look-ups */
@@ -325,6 +405,7 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+    _rbuf_hash_add(res);
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -30,8 +30,17 @@
 extern "C" {
 #endif
 
-#define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
-#define RBUF_TIMEOUT        (3U * US_PER_SEC) /**< timeout for reassembly in microseconds */
+#ifndef RBUF_SIZE
+#define RBUF_SIZE           (4U)                /**< size of the reassembly buffer */
+#endif
+#define RBUF_TIMEOUT        (3U * US_PER_SEC)   /**< timeout for reassembly in microseconds */
+
+/**
+ * @brief   Number of buckets in the index over the reassembly buffer entries
+ */
+#ifndef RBUF_HASH_SIZE
+#define RBUF_HASH_SIZE      (RBUF_SIZE)
+#endif
 
 /**
  * @brief   Fragment intervals to identify limits of fragments.
@@ -60,9 +69,11 @@ typedef struct rbuf_int {
  *
  * @extends gnrc_sixlowpan_rbuf_t
  */
-typedef struct {
+typedef struct rbuf {
     gnrc_sixlowpan_rbuf_t super;        /**< exposed part of the reassembly buffer */
     rbuf_int_t *ints;                   /**< intervals of the fragment */
+    struct rbuf *hash_next;             /**< next entry in the same bucket of
+                                         *   the index */
     uint32_t arrival;                   /**< time in microseconds of arrival of
                                          *   last received fragment */
 } rbuf_t;
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/sixlowpan.h"
+#include "xtimer.h"
+
+#include "vrb.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+
+static vrb_t _vrb[GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+
+static inline bool _vrb_timed_out(const vrb_t *entry, uint32_t now_usec)
+{
+    return (now_usec - entry->arrival) > GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT;
+}
+
+static vrb_t *_vrb_get(const uint8_t *src, size_t src_len, uint16_t tag,
+                       uint16_t datagram_size)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        vrb_t *entry = &_vrb[i];
+
+        if ((entry->out_netif != NULL) && (entry->tag == tag) &&
+            (entry->datagram_size == datagram_size) &&
+            (entry->src_len == src_len) &&
+            (memcmp(entry->src, src, src_len) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static vrb_t *_vrb_alloc(uint32_t now_usec)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        vrb_t *entry = &_vrb[i];
+
+        if ((entry->out_netif == NULL) || _vrb_timed_out(entry, now_usec)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+bool gnrc_sixlowpan_frag_vrb_send_1st(const gnrc_sixlowpan_rbuf_t *rbuf,
+                                      gnrc_pktsnip_t *pkt, size_t frag_size)
+{
+    assert(rbuf != NULL);
+    assert((pkt != NULL) && (pkt->type == GNRC_NETTYPE_NETIF));
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+    gnrc_netif_t *netif = gnrc_netif_hdr_get_netif(netif_hdr);
+    uint16_t datagram_size = (uint16_t)rbuf->pkt->size;
+    uint32_t now_usec = xtimer_now_usec();
+    gnrc_pktsnip_t *frag;
+    sixlowpan_frag_t *hdr;
+    vrb_t *entry;
+
+    if ((netif == NULL) || (netif_hdr->dst_l2addr_len > sizeof(entry->out_dst)) ||
+        ((gnrc_pkt_len(pkt->next) + sizeof(sixlowpan_frag_t)) >
+         netif->sixlo.max_frag_size)) {
+        DEBUG("6lo vrb: first fragment does not fit outgoing interface\n");
+        return false;
+    }
+    if ((entry = _vrb_get(rbuf->src, rbuf->src_len, rbuf->tag,
+                          datagram_size)) == NULL) {
+        entry = _vrb_alloc(now_usec);
+    }
+    if (entry == NULL) {
+        DEBUG("6lo vrb: virtual reassembly buffer full\n");
+        return false;
+    }
+    frag = gnrc_pktbuf_add(pkt->next, NULL, sizeof(sixlowpan_frag_t),
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo vrb: unable to allocate fragment header\n");
+        return false;
+    }
+    pkt->next = frag;
+
+    entry->out_netif = netif;
+    memcpy(entry->src, rbuf->src, rbuf->src_len);
+    entry->src_len = rbuf->src_len;
+    memcpy(entry->out_dst, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           netif_hdr->dst_l2addr_len);
+    entry->out_dst_len = netif_hdr->dst_l2addr_len;
+    entry->arrival = now_usec;
+    entry->datagram_size = datagram_size;
+    entry->tag = rbuf->tag;
+    entry->out_tag = gnrc_sixlowpan_frag_next_tag();
+    entry->current_size = (uint16_t)frag_size;
+
+    hdr = frag->data;
+    hdr->disp_size = byteorder_htons(datagram_size);
+    hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    hdr->tag = byteorder_htons(entry->out_tag);
+    netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+
+    DEBUG("6lo vrb: forward first fragment (datagram size: %u, tag: %u => %u)\n",
+          (unsigned)datagram_size, (unsigned)entry->tag,
+          (unsigned)entry->out_tag);
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, 0);
+    return true;
+}
+
+bool vrb_forward(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
+                 size_t offset)
+{
+    sixlowpan_frag_n_t *hdr = frag->data;
+    uint32_t now_usec = xtimer_now_usec();
+    gnrc_pktsnip_t *netif;
+    gnrc_netif_hdr_t *new_netif_hdr;
+    vrb_t *entry;
+    size_t payload_len;
+
+    entry = _vrb_get(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                     netif_hdr->src_l2addr_len, byteorder_ntohs(hdr->tag),
+                     byteorder_ntohs(hdr->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK);
+    if (entry == NULL) {
+        return false;
+    }
+    if ((offset == 0) || _vrb_timed_out(entry, now_usec)) {
+        /* a first fragment starts a new datagram that needs to be routed
+         * anew */
+        entry->out_netif = NULL;
+        return false;
+    }
+    if (frag->size > entry->out_netif->sixlo.max_frag_size) {
+        DEBUG("6lo vrb: fragment does not fit outgoing interface, "
+              "dropping datagram\n");
+        entry->out_netif = NULL;
+        gnrc_pktbuf_release(frag);
+        return true;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, entry->out_dst, entry->out_dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo vrb: unable to allocate netif header\n");
+        gnrc_pktbuf_release(frag);
+        return true;
+    }
+    new_netif_hdr = netif->data;
+    new_netif_hdr->if_pid = entry->out_netif->pid;
+
+    payload_len = frag->size - sizeof(sixlowpan_frag_n_t);
+    entry->arrival = now_usec;
+    entry->current_size += payload_len;
+    if (entry->current_size < entry->datagram_size) {
+        /* Tell the link layer that we will send more fragments */
+        new_netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    else {
+        /* all fragments forwarded */
+        entry->out_netif = NULL;
+    }
+    hdr->tag = byteorder_htons(entry->out_tag);
+
+    DEBUG("6lo vrb: forward subsequent fragment (offset: %u, tag: %u => %u)\n",
+          (unsigned)offset, (unsigned)entry->tag, (unsigned)entry->out_tag);
+    /* replace netif header of previous hop */
+    gnrc_pktbuf_remove_snip(frag, frag->next);
+    netif->next = frag;
+    gnrc_sixlowpan_dispatch_send(netif, NULL, 0);
+    return true;
+}
+
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+typedef int dont_be_pedantic;
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+/** @} */
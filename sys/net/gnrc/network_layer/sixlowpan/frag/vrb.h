@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @{
+ *
+ * @file
+ * @internal
+ * @brief   6LoWPAN virtual reassembly buffer
+ * @see     gnrc_sixlowpan_frag_vrb_send_1st()
+ */
+#ifndef VRB_H
+#define VRB_H
+
+#include <stdbool.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pkt.h"
+#include "net/ieee802154.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   An entry in the virtual reassembly buffer
+ *
+ * Maps a datagram, identified by the link-layer source address of the
+ * previous hop, its tag, and its size, to the next hop it is forwarded to.
+ *
+ * @internal
+ */
+typedef struct {
+    gnrc_netif_t *out_netif;                        /**< outgoing interface,
+                                                     *   NULL if entry is
+                                                     *   unused */
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];       /**< link-layer source
+                                                     *   address of the
+                                                     *   previous hop */
+    uint8_t out_dst[IEEE802154_LONG_ADDRESS_LEN];   /**< link-layer address
+                                                     *   of the next hop */
+    uint32_t arrival;                               /**< time in microseconds
+                                                     *   of arrival of last
+                                                     *   received fragment */
+    uint16_t datagram_size;                         /**< size of the
+                                                     *   uncompressed datagram */
+    uint16_t tag;                                   /**< tag of the datagram
+                                                     *   on the incoming link */
+    uint16_t out_tag;                               /**< tag of the datagram
+                                                     *   on the outgoing link */
+    uint16_t current_size;                          /**< number of bytes of the
+                                                     *   datagram forwarded */
+    uint8_t src_len;                                /**< length of vrb_t::src */
+    uint8_t out_dst_len;                            /**< length of
+                                                     *   vrb_t::out_dst */
+} vrb_t;
+
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) || defined(DOXYGEN)
+/**
+ * @brief   Forwards a fragment if there is a virtual reassembly buffer entry
+ *          for its datagram
+ *
+ * @param[in] netif_hdr The interface header of the fragment.
+ * @param[in] frag      The fragment in receive order.
+ * @param[in] offset    The fragment's offset.
+ *
+ * @return  true, if @p frag was consumed (i.e. forwarded or dropped).
+ * @return  false, if @p frag needs to be added to the reassembly buffer.
+ *
+ * @internal
+ */
+bool vrb_forward(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
+                 size_t offset);
+#else
+#define vrb_forward(netif_hdr, frag, offset)    (false)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VRB_H */
+/** @} */
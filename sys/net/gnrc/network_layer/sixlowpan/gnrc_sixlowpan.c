@@ -22,6 +22,7 @@
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/netif.h"
+#include "net/gnrc/pkttrace.h"
 #include "net/sixlowpan.h"
 
 #define ENABLE_DEBUG    (0)
@@ -151,6 +152,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
     gnrc_pktsnip_t *payload;
     uint8_t *dispatch;
 
+    gnrc_pkttrace(pkt, GNRC_PKTTRACE_RX_SIXLOWPAN);
     /* seize payload as a temporary variable */
     payload = gnrc_pktbuf_start_write(pkt); /* need to duplicate since pkt->next
                                              * might get replaced */
@@ -256,6 +258,7 @@ static void _send(gnrc_pktsnip_t *pkt)
         gnrc_pktbuf_release(pkt);
         return;
     }
+    gnrc_pkttrace(pkt, GNRC_PKTTRACE_TX_SIXLOWPAN);
 
     if ((pkt->next == NULL) || (pkt->next->type != GNRC_NETTYPE_IPV6)) {
         DEBUG("6lo: Sending packet has no IPv6 header\n");
@@ -27,9 +27,13 @@
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/internal.h"
 #include "net/sixlowpan.h"
-#include "utlist.h"
 #include "net/gnrc/nettype.h"
+#include "net/gnrc/pkttrace.h"
 #include "net/gnrc/udp.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/ipv6/nib.h"
+#include "net/protnum.h"
+#endif
 
 #include "net/gnrc/sixlowpan/iphc.h"
 
@@ -119,42 +123,36 @@ static inline bool _context_overlaps_iid(gnrc_sixlowpan_ctx_t *ctx,
  *
  * @param[in] pkt                   The IPHC encoded packet
  * @param[in] offset                The offset of the NHC encoded header
- * @param[in] ipv6_payload_len      Length of the unencoded, reassembled IPv6
- *                                  datagram in @p ipv6 with out the outer-most
- *                                  IPv6 header
- * @param[out] ipv6                 The packet to write the decoded data to
- * @param[in,out] uncomp_hdr_len    Number of bytes already decoded into @p ipv6
- *                                  by IPHC and other NHC. Adds size of @ref
- *                                  udp_hdr_t after successful UDP header
- *                                  decompression
+ * @param[out] uncomp               The buffer to write the decoded data to.
+ *                                  Starts with the IPv6 header and must have
+ *                                  space for at least a @ref udp_hdr_t after
+ *                                  @p uncomp_hdr_len bytes.
+ * @param[in] datagram_size         Size of the unencoded, reassembled IPv6
+ *                                  datagram, if it is fragmented. 0 otherwise.
+ * @param[in,out] uncomp_hdr_len    Number of bytes already decoded into
+ *                                  @p uncomp by IPHC and other NHC. Adds size
+ *                                  of @ref udp_hdr_t after successful UDP
+ *                                  header decompression
  *
  * @return  The offset after UDP NHC header on success.
  * @return  0 on error.
  */
 static size_t _iphc_nhc_udp_decode(gnrc_pktsnip_t *sixlo, size_t offset,
-                                   gnrc_pktsnip_t *ipv6, size_t *uncomp_hdr_len)
+                                   uint8_t *uncomp, size_t datagram_size,
+                                   size_t *uncomp_hdr_len)
 {
     uint8_t *payload = sixlo->data;
-    ipv6_hdr_t *ipv6_hdr;
-    udp_hdr_t *udp_hdr;
-    bool frag = true;   /* datagram is fragmented => infer payload length from
-                         * ipv6 snip (== reassembly buffer space) */
+    ipv6_hdr_t *ipv6_hdr = (ipv6_hdr_t *)uncomp;
+    udp_hdr_t *udp_hdr = (udp_hdr_t *)(uncomp + *uncomp_hdr_len);
     uint16_t payload_len;
     uint8_t udp_nhc = payload[offset++];
     uint8_t tmp;
 
-    /* realloc size for uncompressed snip, if too small */
-    if (ipv6->size < (*uncomp_hdr_len + sizeof(udp_hdr_t))) {
-        if (gnrc_pktbuf_realloc_data(ipv6,
-                                     *uncomp_hdr_len + sizeof(udp_hdr_t))) {
-            DEBUG("6lo: unable to decode UDP NHC (not enough buffer space)\n");
-            return 0;
-        }
-        frag = false;   /* datagram was not fragmented => infer payload length
-                         * from original 6Lo packet*/
+    if ((datagram_size != 0) &&
+        (datagram_size < (*uncomp_hdr_len + sizeof(udp_hdr_t)))) {
+        DEBUG("6lo: unable to decode UDP NHC (not enough buffer space)\n");
+        return 0;
     }
-    ipv6_hdr = ipv6->data;
-    udp_hdr = (udp_hdr_t *)((uint8_t *)ipv6->data + *uncomp_hdr_len);
     network_uint16_t *src_port = &(udp_hdr->src_port);
     network_uint16_t *dst_port = &(udp_hdr->dst_port);
 
@@ -202,10 +200,14 @@ static size_t _iphc_nhc_udp_decode(gnrc_pktsnip_t *sixlo, size_t offset,
         udp_hdr->checksum.u8[1] = payload[offset++];
     }
 
-    if (frag) {
-        payload_len = ipv6->size - *uncomp_hdr_len;
+    if (datagram_size != 0) {
+        /* datagram is fragmented => infer payload length from reassembly
+         * buffer space */
+        payload_len = datagram_size - *uncomp_hdr_len;
     }
     else {
+        /* datagram was not fragmented => infer payload length from original
+         * 6Lo packet*/
         payload_len = sixlo->size + sizeof(udp_hdr_t) - offset;
     }
     udp_hdr->length = byteorder_htons(payload_len);
@@ -216,6 +218,78 @@ static size_t _iphc_nhc_udp_decode(gnrc_pktsnip_t *sixlo, size_t offset,
 }
 #endif
 
+/* compresses the IPv6 header (and following compressible headers) of pkt.
+ * On error pkt is released and false is returned */
+static bool _iphc_encode(gnrc_pktsnip_t *pkt);
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+/* forwards the first fragment in sixlo without reassembling its datagram,
+ * if the datagram is not for this node */
+static bool _forward_frag(gnrc_pktsnip_t *sixlo, gnrc_sixlowpan_rbuf_t *rbuf,
+                          size_t payload_offset, size_t uncomp_hdr_len)
+{
+    ipv6_hdr_t *ipv6_hdr = rbuf->pkt->data;
+    gnrc_pktsnip_t *pkt, *ipv6, *payload;
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_netif_t *netif;
+    size_t frag_size = uncomp_hdr_len + (sixlo->size - payload_offset);
+
+    /* only forward if no other fragment of the datagram arrived before and
+     * all processing of the datagram is up to the next hop, leave all other
+     * cases (including sending errors) to the IPv6 layer */
+    if ((rbuf->current_size != sixlo->size) || (ipv6_hdr->hl <= 1) ||
+        ipv6_addr_is_multicast(&ipv6_hdr->dst) ||
+        ipv6_addr_is_link_local(&ipv6_hdr->dst) ||
+        ipv6_addr_is_link_local(&ipv6_hdr->src) ||
+        (ipv6_hdr->nh == PROTNUM_IPV6_EXT_HOPOPT) ||
+        (ipv6_hdr->nh == PROTNUM_IPV6_EXT_RH) ||
+        (gnrc_netif_get_by_ipv6_addr(&ipv6_hdr->dst) != NULL) ||
+        (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, NULL, NULL,
+                                           &nce) < 0)) {
+        return false;
+    }
+    netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
+    if ((netif == NULL) || !(netif->flags & GNRC_NETIF_FLAGS_6LO_HC) ||
+        (frag_size <= sizeof(ipv6_hdr_t))) {
+        return false;
+    }
+    pkt = gnrc_netif_hdr_build(NULL, 0, nce.l2addr, nce.l2addr_len);
+    if (pkt == NULL) {
+        return false;
+    }
+    ((gnrc_netif_hdr_t *)pkt->data)->if_pid = netif->pid;
+    ipv6 = gnrc_pktbuf_add(NULL, ipv6_hdr, sizeof(ipv6_hdr_t),
+                           GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    pkt->next = ipv6;
+    /* payload is "most likely UDP" for _iphc_encode() as for other forwarded
+     * packets */
+    payload = gnrc_pktbuf_add(NULL, NULL, frag_size - sizeof(ipv6_hdr_t),
+                              GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    ipv6->next = payload;
+    memcpy(payload->data, ipv6_hdr + 1, uncomp_hdr_len - sizeof(ipv6_hdr_t));
+    memcpy(((uint8_t *)payload->data) + uncomp_hdr_len - sizeof(ipv6_hdr_t),
+           ((uint8_t *)sixlo->data) + payload_offset,
+           sixlo->size - payload_offset);
+    ((ipv6_hdr_t *)ipv6->data)->hl--;
+    if (!_iphc_encode(pkt)) {
+        return false;
+    }
+    if (!gnrc_sixlowpan_frag_vrb_send_1st(rbuf, pkt, frag_size)) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    return true;
+}
+#endif
+
 static inline void _recv_error_release(gnrc_pktsnip_t *sixlo,
                                        gnrc_pktsnip_t *ipv6,
                                        gnrc_sixlowpan_rbuf_t *rbuf) {
@@ -226,11 +300,39 @@ static inline void _recv_error_release(gnrc_pktsnip_t *sixlo,
     gnrc_pktbuf_release(sixlo);
 }
 
+/* replaces the compressed headers in front of the payload of sixlo with the
+ * uncomp_hdr_len bytes of decompressed headers in uncomp */
+static bool _iphc_decompress_in_place(gnrc_pktsnip_t *sixlo,
+                                      const uint8_t *uncomp,
+                                      size_t uncomp_hdr_len,
+                                      size_t payload_offset)
+{
+    size_t payload_len = sixlo->size - payload_offset;
+    size_t datagram_len = uncomp_hdr_len + payload_len;
+
+    /* the packet buffer typically extends the chunk of sixlo into the space
+     * directly behind it, so neither allocation nor copy to another chunk is
+     * required in that case */
+    if ((datagram_len > sixlo->size) &&
+        (gnrc_pktbuf_realloc_data(sixlo, datagram_len) != 0)) {
+        return false;
+    }
+    memmove(((uint8_t *)sixlo->data) + uncomp_hdr_len,
+            ((uint8_t *)sixlo->data) + payload_offset, payload_len);
+    memcpy(sixlo->data, uncomp, uncomp_hdr_len);
+    if (datagram_len < sixlo->size) {
+        /* shrinking never fails */
+        gnrc_pktbuf_realloc_data(sixlo, datagram_len);
+    }
+    sixlo->type = GNRC_NETTYPE_IPV6;
+    return true;
+}
+
 void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
                               unsigned page)
 {
     assert(sixlo != NULL);
-    gnrc_pktsnip_t *ipv6, *netif;
+    gnrc_pktsnip_t *ipv6 = NULL, *netif;
     gnrc_netif_hdr_t *netif_hdr;
     gnrc_netif_t *iface;
     ipv6_hdr_t *ipv6_hdr;
@@ -239,23 +341,24 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
     size_t uncomp_hdr_len = sizeof(ipv6_hdr_t);
     gnrc_sixlowpan_ctx_t *ctx = NULL;
     gnrc_sixlowpan_rbuf_t *rbuf = rbuf_ptr;
+    /* decompressed headers of an unfragmented datagram, before they are
+     * moved in front of the payload */
+    union {
+        ipv6_hdr_t ipv6_hdr;
+        uint8_t u8[sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t)];
+    } uncomp;
 
     if (rbuf != NULL) {
         ipv6 = rbuf->pkt;
         assert(ipv6 != NULL);
+        assert(ipv6->size >= sizeof(ipv6_hdr_t));
+        ipv6_hdr = ipv6->data;
     }
     else {
-        ipv6 = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t),
-                               GNRC_NETTYPE_IPV6);
-        if (ipv6 == NULL) {
-            gnrc_pktbuf_release(sixlo);
-            return;
-        }
+        memset(&uncomp, 0, sizeof(uncomp));
+        ipv6_hdr = &uncomp.ipv6_hdr;
     }
 
-    assert(ipv6->size >= sizeof(ipv6_hdr_t));
-    ipv6_hdr = ipv6->data;
-
     if (iphc_hdr[IPHC2_IDX] & SIXLOWPAN_IPHC2_CID_EXT) {
         payload_offset++;
     }
@@ -541,7 +644,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
         switch (iphc_hdr[payload_offset] & NHC_ID_MASK) {
             case NHC_UDP_ID: {
                 payload_offset = _iphc_nhc_udp_decode(sixlo, payload_offset,
-                                                      ipv6, &uncomp_hdr_len);
+                                                      (uint8_t *)ipv6_hdr,
+                                                      (rbuf != NULL) ? ipv6->size : 0,
+                                                      &uncomp_hdr_len);
                 if (payload_offset == 0) {
                     _recv_error_release(sixlo, ipv6, rbuf);
                     return;
@@ -564,29 +669,39 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
         payload_len = (sixlo->size + uncomp_hdr_len -
                        payload_offset - sizeof(ipv6_hdr_t));
     }
-    if ((rbuf == NULL) &&
-        (gnrc_pktbuf_realloc_data(ipv6, uncomp_hdr_len + payload_len) != 0)) {
-        DEBUG("6lo iphc: no space left to copy payload\n");
-        _recv_error_release(sixlo, ipv6, rbuf);
+    ipv6_hdr->len = byteorder_htons(payload_len);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    if ((rbuf != NULL) &&
+        _forward_frag(sixlo, rbuf, payload_offset, uncomp_hdr_len)) {
+        gnrc_pktbuf_release(ipv6);
+        gnrc_sixlowpan_frag_rbuf_remove(rbuf);
+        gnrc_pktbuf_release(sixlo);
         return;
     }
-    /* re-assign IPv6 header in case realloc changed the address */
-    ipv6_hdr = ipv6->data;
-    ipv6_hdr->len = byteorder_htons(payload_len);
-    memcpy(((uint8_t *)ipv6->data) + uncomp_hdr_len,
-           ((uint8_t *)sixlo->data) + payload_offset,
-           sixlo->size - payload_offset);
+#endif
     if (rbuf != NULL) {
+        memcpy(((uint8_t *)ipv6->data) + uncomp_hdr_len,
+               ((uint8_t *)sixlo->data) + payload_offset,
+               sixlo->size - payload_offset);
         rbuf->current_size += (uncomp_hdr_len - payload_offset);
         gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(rbuf, netif_hdr);
+        gnrc_pktbuf_release(sixlo);
+        return;
     }
-    else {
-        LL_DELETE(sixlo, netif);
-        LL_APPEND(ipv6, netif);
-        gnrc_sixlowpan_dispatch_recv(ipv6, NULL, page);
+    assert(uncomp_hdr_len <= sizeof(uncomp));
+    if ((ipv6 = gnrc_pktbuf_start_write(sixlo)) == NULL) {
+        DEBUG("6lo iphc: unable to get write access to packet\n");
+        gnrc_pktbuf_release(sixlo);
+        return;
     }
-    gnrc_pktbuf_release(sixlo);
-    return;
+    if (!_iphc_decompress_in_place(ipv6, uncomp.u8, uncomp_hdr_len,
+                                   payload_offset)) {
+        DEBUG("6lo iphc: no space left to copy payload\n");
+        gnrc_pktbuf_release(ipv6);
+        return;
+    }
+    gnrc_pkttrace(ipv6, GNRC_PKTTRACE_RX_IPHC);
+    gnrc_sixlowpan_dispatch_recv(ipv6, NULL, page);
 }
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
@@ -654,72 +769,106 @@ static inline bool _compressible(gnrc_pktsnip_t *hdr)
     }
 }
 
-void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
+/* compressed source and destination address of an IPv6 header */
+typedef struct {
+    uint8_t data[2 * sizeof(ipv6_addr_t)];  /* inline address bytes */
+    uint8_t iphc2;      /* SAC, SAM, M, DAC, DAM, and CID flags */
+    uint8_t cid_ext;    /* context identifier extension (if CID is set) */
+    uint8_t len;        /* number of used bytes in data */
+} _iphc_addr_t;
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+typedef struct {
+    ipv6_addr_t src;
+    ipv6_addr_t dst;
+    _iphc_addr_t addr;
+    unsigned gen;                   /* _cache_gen at time of creation */
+    kernel_pid_t iface;             /* KERNEL_PID_UNDEF if unused */
+    uint8_t dst_l2addr[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+    uint8_t dst_l2addr_len;
+} _iphc_cache_t;
+
+static _iphc_cache_t _cache[GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+static unsigned _cache_next;
+/* incremented on invalidation, so entries created before become stale */
+static volatile unsigned _cache_gen;
+
+void gnrc_sixlowpan_iphc_cache_invalidate(void)
 {
-    assert(pkt != NULL);
-    gnrc_netif_hdr_t *netif_hdr = pkt->data;
-    ipv6_hdr_t *ipv6_hdr;
-    gnrc_netif_t *iface = gnrc_netif_hdr_get_netif(netif_hdr);
-    uint8_t *iphc_hdr;
-    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    gnrc_pktsnip_t *dispatch, *ptr = pkt->next;
-    bool addr_comp = false;
-    size_t dispatch_size = 0;
-    /* datagram size before compression */
-    size_t orig_datagram_size = gnrc_pkt_len(pkt->next);
-    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+    _cache_gen++;
+}
 
-    (void)ctx;
-    dispatch = NULL;    /* use dispatch as temporary pointer for prev */
-    /* determine maximum dispatch size and write protect all headers until
-     * then because they will be removed */
-    while (_compressible(ptr)) {
-        gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(ptr);
+static inline bool _cache_ctx_valid(uint8_t id)
+{
+    gnrc_sixlowpan_ctx_t *ctx = gnrc_sixlowpan_ctx_lookup_id(id);
 
-        if (tmp == NULL) {
-            DEBUG("6lo iphc: unable to write protect compressible header\n");
-            if (addr_comp) {    /* addr_comp was used as release indicator */
-                gnrc_pktbuf_release(pkt);
-            }
-            return;
-        }
-        ptr = tmp;
-        if (dispatch == NULL) {
-            /* pkt was already write protected in gnrc_sixlowpan.c:_send so
-             * we shouldn't do it again */
-            pkt->next = ptr;    /* reset original packet */
-        }
-        else {
-            dispatch->next = ptr;
+    /* lookup also updates the lifetime of the context */
+    return (ctx != NULL) && (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP);
+}
+
+static _iphc_cache_t *_cache_get(const gnrc_netif_hdr_t *netif_hdr,
+                                 const ipv6_hdr_t *ipv6_hdr, unsigned gen)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        _iphc_cache_t *entry = &_cache[i];
+        uint8_t iphc2 = entry->addr.iphc2;
+
+        if ((entry->iface != netif_hdr->if_pid) ||
+            (entry->iface == KERNEL_PID_UNDEF) || (entry->gen != gen) ||
+            (entry->dst_l2addr_len != netif_hdr->dst_l2addr_len) ||
+            !ipv6_addr_equal(&entry->dst, &ipv6_hdr->dst) ||
+            !ipv6_addr_equal(&entry->src, &ipv6_hdr->src) ||
+            (memcmp(entry->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                    entry->dst_l2addr_len) != 0)) {
+            continue;
         }
-        if (ptr->type == GNRC_NETTYPE_UNDEF) {
-            /* most likely UDP for now so use that (XXX: extend if extension
-             * headers make problems) */
-            dispatch_size += sizeof(udp_hdr_t);
-            break;  /* nothing special after UDP so quit even if more UNDEF
-                     * come */
+        /* contexts might have timed out in the meantime */
+        if (((iphc2 & SIXLOWPAN_IPHC2_SAC) && (iphc2 & SIXLOWPAN_IPHC2_SAM) &&
+             !_cache_ctx_valid(entry->addr.cid_ext >> 4)) ||
+            ((iphc2 & SIXLOWPAN_IPHC2_DAC) &&
+             !_cache_ctx_valid(entry->addr.cid_ext & 0x0f))) {
+            entry->iface = KERNEL_PID_UNDEF;
+            return NULL;
         }
-        else {
-            dispatch_size += ptr->size;
-        }
-        dispatch = ptr; /* use dispatch as temporary point for prev */
-        ptr = ptr->next;
+        return entry;
     }
-    ipv6_hdr = pkt->next->data;
-    dispatch = gnrc_pktbuf_add(NULL, NULL, dispatch_size,
-                               GNRC_NETTYPE_SIXLOWPAN);
+    return NULL;
+}
 
-    if (dispatch == NULL) {
-        DEBUG("6lo iphc: error allocating dispatch space\n");
-        gnrc_pktbuf_release(pkt);
+static void _cache_add(const gnrc_netif_hdr_t *netif_hdr,
+                       const ipv6_hdr_t *ipv6_hdr, const _iphc_addr_t *addr,
+                       unsigned gen)
+{
+    _iphc_cache_t *entry = &_cache[_cache_next];
+
+    if (netif_hdr->dst_l2addr_len > sizeof(entry->dst_l2addr)) {
         return;
     }
+    _cache_next = (_cache_next + 1) % GNRC_SIXLOWPAN_IPHC_CACHE_SIZE;
+    memcpy(&entry->src, &ipv6_hdr->src, sizeof(entry->src));
+    memcpy(&entry->dst, &ipv6_hdr->dst, sizeof(entry->dst));
+    memcpy(&entry->addr, addr, sizeof(entry->addr));
+    memcpy(entry->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           netif_hdr->dst_l2addr_len);
+    entry->dst_l2addr_len = netif_hdr->dst_l2addr_len;
+    entry->gen = gen;
+    entry->iface = netif_hdr->if_pid;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_IPHC_CACHE */
+
+/* determines the address compression of ipv6_hdr, i.e. the respective flags
+ * of the second IPHC byte, the context identifier extension, and the inline
+ * address bytes */
+static bool _iphc_encode_addr(gnrc_netif_t *iface,
+                              const gnrc_netif_hdr_t *netif_hdr,
+                              ipv6_hdr_t *ipv6_hdr, _iphc_addr_t *addr)
+{
+    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
+    bool addr_comp = false;
 
-    iphc_hdr = dispatch->data;
-
-    /* set initial dispatch value*/
-    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
-    iphc_hdr[IPHC2_IDX] = 0;
+    addr->iphc2 = 0;
+    addr->cid_ext = 0;
+    addr->len = 0;
 
     /* check for available contexts */
     if (!ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
@@ -747,87 +896,19 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
         ((dst_ctx != NULL) &&
             ((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0))) {
         /* add context identifier extension */
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_CID_EXT;
-        iphc_hdr[CID_EXT_IDX] = 0;
-
-        /* move position to behind CID extension */
-        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
-    }
-
-    /* compress flow label and traffic class */
-    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
-        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
-            /* elide both traffic class and flow label */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
-        }
-        else {
-            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-        }
-    }
-    else {
-        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
-            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
-                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
-        }
-        else {
-            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
-        }
-
-        /* copy remaining byteos of flow label */
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff) >> 8);
-    }
-
-    /* check for compressible next header */
-    switch (ipv6_hdr->nh) {
-#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
-        case PROTNUM_UDP:
-            iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
-            break;
-#endif
-
-        default:
-            iphc_hdr[inline_pos++] = ipv6_hdr->nh;
-            break;
-    }
-
-    /* compress hop limit */
-    switch (ipv6_hdr->hl) {
-        case 1:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
-            break;
-
-        case 64:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
-            break;
-
-        case 255:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
-            break;
-
-        default:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
-            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
-            break;
+        addr->iphc2 |= SIXLOWPAN_IPHC2_CID_EXT;
     }
 
     if (ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_UNSPEC;
+        addr->iphc2 |= IPHC_SAC_SAM_UNSPEC;
     }
     else {
         if (src_ctx != NULL) {
             /* stateful source address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_SAC;
+            addr->iphc2 |= SIXLOWPAN_IPHC2_SAC;
 
             if (((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) << 4);
+                addr->cid_ext |= ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) << 4);
             }
         }
 
@@ -839,39 +920,38 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             if (gnrc_netif_ipv6_get_iid(iface, &iid) < 0) {
                 DEBUG("6lo iphc: could not get interface's IID\n");
                 gnrc_netif_release(iface);
-                gnrc_pktbuf_release(pkt);
-                return;
+                return false;
             }
             gnrc_netif_release(iface);
 
             if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
                 _context_overlaps_iid(src_ctx, &ipv6_hdr->src, &iid)) {
                 /* 0 bits. The address is derived from link-layer address */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_L2;
+                addr->iphc2 |= IPHC_SAC_SAM_L2;
                 addr_comp = true;
             }
             else if ((byteorder_ntohl(ipv6_hdr->src.u32[2]) == 0x000000ff) &&
                      (byteorder_ntohs(ipv6_hdr->src.u16[6]) == 0xfe00)) {
                 /* 16 bits. The address is derived using 16 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_16;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u16 + 7, 2);
-                inline_pos += 2;
+                addr->iphc2 |= IPHC_SAC_SAM_16;
+                memcpy(addr->data + addr->len, ipv6_hdr->src.u16 + 7, 2);
+                addr->len += 2;
                 addr_comp = true;
             }
             else {
                 /* 64 bits. The address is derived using 64 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_64;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u64 + 1, 8);
-                inline_pos += 8;
+                addr->iphc2 |= IPHC_SAC_SAM_64;
+                memcpy(addr->data + addr->len, ipv6_hdr->src.u64 + 1, 8);
+                addr->len += 8;
                 addr_comp = true;
             }
         }
 
         if (!addr_comp) {
             /* full address is carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-            memcpy(iphc_hdr + inline_pos, &ipv6_hdr->src, 16);
-            inline_pos += 16;
+            addr->iphc2 |= IPHC_SAC_SAM_FULL;
+            memcpy(addr->data + addr->len, &ipv6_hdr->src, 16);
+            addr->len += 16;
         }
     }
 
@@ -879,7 +959,7 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
 
     /* M: Multicast compression */
     if (ipv6_addr_is_multicast(&(ipv6_hdr->dst))) {
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_M;
+        addr->iphc2 |= SIXLOWPAN_IPHC2_M;
 
         /* if multicast address is of format ffXX::XXXX:XXXX:XXXX */
         if ((ipv6_hdr->dst.u16[1].u16 == 0) &&
@@ -891,27 +971,27 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
                 (ipv6_hdr->dst.u16[6].u16 == 0) &&
                 (ipv6_hdr->dst.u8[14] == 0)) {
                 /* 8 bits. The address is derived using 8 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_8;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[15];
+                addr->iphc2 |= IPHC_M_DAC_DAM_M_8;
+                addr->data[addr->len++] = ipv6_hdr->dst.u8[15];
                 addr_comp = true;
             }
             /* if multicast address is of format ffXX::XX:XXXX */
             else if ((ipv6_hdr->dst.u16[5].u16 == 0) &&
                      (ipv6_hdr->dst.u8[12] == 0)) {
                 /* 32 bits. The address is derived using 32 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_32;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 13, 3);
-                inline_pos += 3;
+                addr->iphc2 |= IPHC_M_DAC_DAM_M_32;
+                addr->data[addr->len++] = ipv6_hdr->dst.u8[1];
+                memcpy(addr->data + addr->len, ipv6_hdr->dst.u8 + 13, 3);
+                addr->len += 3;
                 addr_comp = true;
             }
             /* if multicast address is of format ffXX::XX:XXXX:XXXX */
             else if (ipv6_hdr->dst.u8[10] == 0) {
                 /* 48 bits. The address is derived using 48 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_48;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 11, 5);
-                inline_pos += 5;
+                addr->iphc2 |= IPHC_M_DAC_DAM_M_48;
+                addr->data[addr->len++] = ipv6_hdr->dst.u8[1];
+                memcpy(addr->data + addr->len, ipv6_hdr->dst.u8 + 11, 5);
+                addr->len += 5;
                 addr_comp = true;
             }
         }
@@ -931,14 +1011,14 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
                 /* Unicast prefix based IPv6 multicast address
                  * (https://tools.ietf.org/html/rfc3306) with given context
                  * for unicast prefix -> context based compression */
-                iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
+                addr->iphc2 |= SIXLOWPAN_IPHC2_DAC;
                 if ((ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0) {
-                    iphc_hdr[CID_EXT_IDX] |= (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+                    addr->cid_ext |= (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
                 }
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[2];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u16 + 6, 4);
-                inline_pos += 4;
+                addr->data[addr->len++] = ipv6_hdr->dst.u8[1];
+                addr->data[addr->len++] = ipv6_hdr->dst.u8[2];
+                memcpy(addr->data + addr->len, ipv6_hdr->dst.u16 + 6, 4);
+                addr->len += 4;
                 addr_comp = true;
             }
         }
@@ -949,48 +1029,212 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
 
         if (dst_ctx != NULL) {
             /* stateful destination address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
+            addr->iphc2 |= SIXLOWPAN_IPHC2_DAC;
 
             if (((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+                addr->cid_ext |= (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
             }
         }
 
         if (gnrc_netif_hdr_ipv6_iid_from_dst(iface, netif_hdr, &iid) < 0) {
             DEBUG("6lo iphc: could not get destination's IID\n");
-            gnrc_pktbuf_release(pkt);
-            return;
+            return false;
         }
 
         if ((ipv6_hdr->dst.u64[1].u64 == iid.uint64.u64) ||
             _context_overlaps_iid(dst_ctx, &(ipv6_hdr->dst), &iid)) {
             /* 0 bits. The address is derived using the link-layer address */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_L2;
+            addr->iphc2 |= IPHC_M_DAC_DAM_U_L2;
             addr_comp = true;
         }
         else if ((byteorder_ntohl(ipv6_hdr->dst.u32[2]) == 0x000000ff) &&
                  (byteorder_ntohs(ipv6_hdr->dst.u16[6]) == 0xfe00)) {
             /* 16 bits. The address is derived using 16 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_16;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u16[7]), 2);
-            inline_pos += 2;
+            addr->iphc2 |= IPHC_M_DAC_DAM_U_16;
+            memcpy(&(addr->data[addr->len]), &(ipv6_hdr->dst.u16[7]), 2);
+            addr->len += 2;
             addr_comp = true;
         }
         else {
             /* 64 bits. The address is derived using 64 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_64;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u8[8]), 8);
-            inline_pos += 8;
+            addr->iphc2 |= IPHC_M_DAC_DAM_U_64;
+            memcpy(&(addr->data[addr->len]), &(ipv6_hdr->dst.u8[8]), 8);
+            addr->len += 8;
             addr_comp = true;
         }
     }
 
     if (!addr_comp) {
         /* full destination address is carried inline */
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-        memcpy(iphc_hdr + inline_pos, &ipv6_hdr->dst, 16);
-        inline_pos += 16;
+        addr->iphc2 |= IPHC_SAC_SAM_FULL;
+        memcpy(addr->data + addr->len, &ipv6_hdr->dst, 16);
+        addr->len += 16;
+    }
+    return true;
+}
+
+/* gets the address compression of ipv6_hdr, either from the cache or by
+ * determining it */
+static bool _iphc_addr_get(gnrc_netif_t *iface,
+                           const gnrc_netif_hdr_t *netif_hdr,
+                           ipv6_hdr_t *ipv6_hdr, _iphc_addr_t *addr)
+{
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    /* read generation first, so an invalidation during _iphc_encode_addr()
+     * marks the new entry stale */
+    unsigned gen = _cache_gen;
+    _iphc_cache_t *entry = _cache_get(netif_hdr, ipv6_hdr, gen);
+
+    if (entry != NULL) {
+        memcpy(addr, &entry->addr, sizeof(*addr));
+        return true;
     }
+    if (!_iphc_encode_addr(iface, netif_hdr, ipv6_hdr, addr)) {
+        return false;
+    }
+    _cache_add(netif_hdr, ipv6_hdr, addr, gen);
+    return true;
+#else
+    return _iphc_encode_addr(iface, netif_hdr, ipv6_hdr, addr);
+#endif
+}
+
+static bool _iphc_encode(gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+    ipv6_hdr_t *ipv6_hdr;
+    gnrc_netif_t *iface = gnrc_netif_hdr_get_netif(netif_hdr);
+    uint8_t *iphc_hdr;
+    gnrc_pktsnip_t *dispatch, *ptr = pkt->next;
+    _iphc_addr_t addr;
+    size_t dispatch_size = 0;
+    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+
+    dispatch = NULL;    /* use dispatch as temporary pointer for prev */
+    /* determine maximum dispatch size and write protect all headers until
+     * then because they will be removed */
+    while (_compressible(ptr)) {
+        gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(ptr);
+
+        if (tmp == NULL) {
+            DEBUG("6lo iphc: unable to write protect compressible header\n");
+            return false;
+        }
+        ptr = tmp;
+        if (dispatch == NULL) {
+            /* pkt was already write protected in gnrc_sixlowpan.c:_send so
+             * we shouldn't do it again */
+            pkt->next = ptr;    /* reset original packet */
+        }
+        else {
+            dispatch->next = ptr;
+        }
+        if (ptr->type == GNRC_NETTYPE_UNDEF) {
+            /* most likely UDP for now so use that (XXX: extend if extension
+             * headers make problems) */
+            dispatch_size += sizeof(udp_hdr_t);
+            break;  /* nothing special after UDP so quit even if more UNDEF
+                     * come */
+        }
+        else {
+            dispatch_size += ptr->size;
+        }
+        dispatch = ptr; /* use dispatch as temporary point for prev */
+        ptr = ptr->next;
+    }
+    ipv6_hdr = pkt->next->data;
+    dispatch = gnrc_pktbuf_add(NULL, NULL, dispatch_size,
+                               GNRC_NETTYPE_SIXLOWPAN);
+
+    if (dispatch == NULL) {
+        DEBUG("6lo iphc: error allocating dispatch space\n");
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+
+    iphc_hdr = dispatch->data;
+
+    /* set initial dispatch value*/
+    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
+
+    if (!_iphc_addr_get(iface, netif_hdr, ipv6_hdr, &addr)) {
+        gnrc_pktbuf_release(dispatch);
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    iphc_hdr[IPHC2_IDX] = addr.iphc2;
+    if (addr.iphc2 & SIXLOWPAN_IPHC2_CID_EXT) {
+        iphc_hdr[CID_EXT_IDX] = addr.cid_ext;
+        /* move position to behind CID extension */
+        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
+    }
+
+    /* compress flow label and traffic class */
+    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
+        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
+            /* elide both traffic class and flow label */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
+        }
+        else {
+            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+        }
+    }
+    else {
+        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
+            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
+                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
+        }
+        else {
+            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
+        }
+
+        /* copy remaining byteos of flow label */
+        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
+        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff) >> 8);
+    }
+
+    /* check for compressible next header */
+    switch (ipv6_hdr->nh) {
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+        case PROTNUM_UDP:
+            iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
+            break;
+#endif
+
+        default:
+            iphc_hdr[inline_pos++] = ipv6_hdr->nh;
+            break;
+    }
+
+    /* compress hop limit */
+    switch (ipv6_hdr->hl) {
+        case 1:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
+            break;
+
+        case 64:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
+            break;
+
+        case 255:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
+            break;
+
+        default:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
+            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
+            break;
+    }
+
+    memcpy(iphc_hdr + inline_pos, addr.data, addr.len);
+    inline_pos += addr.len;
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
     switch (ipv6_hdr->nh) {
@@ -1007,7 +1251,7 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
                 if (udp == NULL) {
                     DEBUG("gnrc_sixlowpan_iphc_encode: unable to mark UDP header\n");
                     gnrc_pktbuf_release(dispatch);
-                    return;
+                    return false;
                 }
             }
             gnrc_pktbuf_remove_snip(pkt, udp);
@@ -1028,10 +1272,23 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     /* insert dispatch into packet */
     dispatch->next = pkt->next;
     pkt->next = dispatch;
+    return true;
+}
 
-    gnrc_netif_t *netif = gnrc_netif_hdr_get_netif(netif_hdr);
-    assert(netif != NULL);
-    gnrc_sixlowpan_multiplex_by_size(pkt, orig_datagram_size, netif, page);
+void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
+{
+    assert(pkt != NULL);
+    /* datagram size before compression */
+    size_t orig_datagram_size = gnrc_pkt_len(pkt->next);
+
+    (void)ctx;
+    if (_iphc_encode(pkt)) {
+        gnrc_netif_t *netif = gnrc_netif_hdr_get_netif(pkt->data);
+
+        assert(netif != NULL);
+        gnrc_pkttrace(pkt, GNRC_PKTTRACE_TX_IPHC);
+        gnrc_sixlowpan_multiplex_by_size(pkt, orig_datagram_size, netif, page);
+    }
 }
 
 /** @} */
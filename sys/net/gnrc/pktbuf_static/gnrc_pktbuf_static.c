@@ -26,6 +26,9 @@
 #include "mutex.h"
 #include "od.h"
 #include "utlist.h"
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+#include "memarray.h"
+#endif
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
@@ -51,13 +54,263 @@ static uint16_t max_byte_count = 0;
 
 /* internal gnrc_pktbuf functions */
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
-                                    gnrc_nettype_t type);
+                                    gnrc_nettype_t type, unsigned cls);
 static void *_pktbuf_alloc(size_t size);
+static bool _pktbuf_grow(void *data, size_t old_size, size_t size);
 static void _pktbuf_free(void *data, size_t size);
 
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+/* size of a pool chunk fitted to byte alignment */
+#define _SLAB_CHUNK(size)           (((size) + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK))
+/* number of pointer-aligned words needed for a pool's storage */
+#define _SLAB_WORDS(size, num)      ((_SLAB_CHUNK(size) * (num)) / sizeof(void *))
+#define _SLAB_CLASS(storage, chunk, numof) \
+    { .pool = { .size = _SLAB_CHUNK(chunk), .num = (numof) }, \
+      .data = (uint8_t *)(storage) }
+
+typedef struct {
+    memarray_t pool;        /**< free list of the size class */
+    uint8_t *data;          /**< start of the size class' storage */
+    uint16_t used;          /**< number of chunks currently in use */
+    uint16_t max_used;      /**< maximum number of chunks ever in use */
+} _slab_t;
+
+#if GNRC_PKTBUF_SLAB_SNIP_NUMOF
+static void *_slab_snip[_SLAB_WORDS(sizeof(gnrc_pktsnip_t),
+                                    GNRC_PKTBUF_SLAB_SNIP_NUMOF)];
+#endif
+#if GNRC_PKTBUF_SLAB_32_NUMOF
+static void *_slab_32[_SLAB_WORDS(32, GNRC_PKTBUF_SLAB_32_NUMOF)];
+#endif
+#if GNRC_PKTBUF_SLAB_128_NUMOF
+static void *_slab_128[_SLAB_WORDS(128, GNRC_PKTBUF_SLAB_128_NUMOF)];
+#endif
+#if GNRC_PKTBUF_SLAB_256_NUMOF
+static void *_slab_256[_SLAB_WORDS(256, GNRC_PKTBUF_SLAB_256_NUMOF)];
+#endif
+#if GNRC_PKTBUF_SLAB_1280_NUMOF
+static void *_slab_1280[_SLAB_WORDS(1280, GNRC_PKTBUF_SLAB_1280_NUMOF)];
+#endif
+
+static _slab_t _slabs[] = {
+#if GNRC_PKTBUF_SLAB_SNIP_NUMOF
+    _SLAB_CLASS(_slab_snip, sizeof(gnrc_pktsnip_t), GNRC_PKTBUF_SLAB_SNIP_NUMOF),
+#endif
+#if GNRC_PKTBUF_SLAB_32_NUMOF
+    _SLAB_CLASS(_slab_32, 32, GNRC_PKTBUF_SLAB_32_NUMOF),
+#endif
+#if GNRC_PKTBUF_SLAB_128_NUMOF
+    _SLAB_CLASS(_slab_128, 128, GNRC_PKTBUF_SLAB_128_NUMOF),
+#endif
+#if GNRC_PKTBUF_SLAB_256_NUMOF
+    _SLAB_CLASS(_slab_256, 256, GNRC_PKTBUF_SLAB_256_NUMOF),
+#endif
+#if GNRC_PKTBUF_SLAB_1280_NUMOF
+    _SLAB_CLASS(_slab_1280, 1280, GNRC_PKTBUF_SLAB_1280_NUMOF),
+#endif
+};
+
+#define _SLAB_NUMOF     (sizeof(_slabs) / sizeof(_slabs[0]))
+
+static _slab_t *_slab_find(void *ptr)
+{
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        if ((unsigned)((uint8_t *)ptr - slab->data) <
+            (slab->pool.size * slab->pool.num)) {
+            return slab;
+        }
+    }
+    return NULL;
+}
+
+static inline bool _slab_contains(void *ptr)
+{
+    return _slab_find(ptr) != NULL;
+}
+
+static void _slab_init(void)
+{
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        memarray_init(&slab->pool, slab->data, slab->pool.size, slab->pool.num);
+        slab->used = 0;
+        slab->max_used = 0;
+    }
+}
+
+static void *_slab_alloc(size_t size)
+{
+    _slab_t *best = NULL;
+    size_t smallest = SIZE_MAX;
+    void *chunk;
+
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        if (slab->pool.size < smallest) {
+            smallest = slab->pool.size;
+        }
+        if ((size <= slab->pool.size) && (slab->pool.free_data != NULL) &&
+            ((best == NULL) || (slab->pool.size < best->pool.size))) {
+            best = slab;
+        }
+    }
+    /* leave sizes that would waste more than 3/4 of a chunk to the arena,
+     * anything fitting into the smallest class is always taken */
+    if ((best == NULL) ||
+        ((best->pool.size > smallest) && (best->pool.size > (4 * size)))) {
+        DEBUG("pktbuf: no fitting slab chunk for %u byte\n", (unsigned)size);
+        return NULL;
+    }
+    chunk = memarray_alloc(&best->pool);
+    if (++best->used > best->max_used) {
+        best->max_used = best->used;
+    }
+    return chunk;
+}
+
+static void _slab_free(_slab_t *slab, void *chunk)
+{
+    assert((((uint8_t *)chunk - slab->data) % slab->pool.size) == 0);
+    assert(slab->used > 0);
+    memarray_free(&slab->pool, chunk);
+    slab->used--;
+}
+#else
+static inline bool _slab_contains(void *ptr)
+{
+    (void)ptr;
+    return false;
+}
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+typedef struct {
+    size_t quota;           /**< maximum number of bytes of the class */
+    size_t used;            /**< number of bytes accounted to the class */
+    size_t max_used;        /**< maximum number of bytes ever accounted */
+    unsigned refused;       /**< number of refused allocations */
+} _quota_t;
+
+static _quota_t _quotas[GNRC_PKTBUF_CLASS_NUMOF] = {
+    [GNRC_PKTBUF_CLASS_OTHER] = { .quota = GNRC_PKTBUF_QUOTA_OTHER },
+    [GNRC_PKTBUF_CLASS_RX] = { .quota = GNRC_PKTBUF_QUOTA_RX },
+    [GNRC_PKTBUF_CLASS_REASS] = { .quota = GNRC_PKTBUF_QUOTA_REASS },
+    [GNRC_PKTBUF_CLASS_TX] = { .quota = GNRC_PKTBUF_QUOTA_TX },
+    [GNRC_PKTBUF_CLASS_SOCK] = { .quota = GNRC_PKTBUF_QUOTA_SOCK },
+    [GNRC_PKTBUF_CLASS_CTRL] = { .quota = GNRC_PKTBUF_QUOTA_CTRL },
+};
+/* number of bytes accounted to all classes */
+static size_t _quota_used;
+/* number of bytes only the control plane may use */
+static size_t _ctrl_reserve = GNRC_PKTBUF_CTRL_RESERVE;
+
+static bool _quota_fits(unsigned cls, size_t bytes)
+{
+    if ((_quotas[cls].used + bytes) > _quotas[cls].quota) {
+        return false;
+    }
+    /* only the control plane may dig into the reserve */
+    return (cls == GNRC_PKTBUF_CLASS_CTRL) ||
+           ((_quota_used + bytes + _ctrl_reserve) <= GNRC_PKTBUF_SIZE);
+}
+
+static void _quota_add(unsigned cls, size_t bytes)
+{
+    _quotas[cls].used += bytes;
+    _quota_used += bytes;
+    if (_quotas[cls].used > _quotas[cls].max_used) {
+        _quotas[cls].max_used = _quotas[cls].used;
+    }
+}
+
+static bool _quota_charge(unsigned cls, size_t bytes)
+{
+    if (!_quota_fits(cls, bytes)) {
+        DEBUG("pktbuf: %u byte exceed quota of class %u\n", (unsigned)bytes,
+              cls);
+        _quotas[cls].refused++;
+        return false;
+    }
+    _quota_add(cls, bytes);
+    return true;
+}
+
+static void _quota_refund(unsigned cls, size_t bytes)
+{
+    assert(_quotas[cls].used >= bytes);
+    _quotas[cls].used -= bytes;
+    _quota_used -= bytes;
+}
+
+static inline unsigned _class_of(const gnrc_pktsnip_t *pkt)
+{
+    return pkt->cls;
+}
+
+static inline void _set_class(gnrc_pktsnip_t *pkt, unsigned cls)
+{
+    pkt->cls = cls;
+}
+
+/* class of a new snip in front of next */
+static inline unsigned _class_new(const gnrc_pktsnip_t *next,
+                                  gnrc_nettype_t type)
+{
+    if (next != NULL) {
+        return next->cls;
+    }
+#ifdef MODULE_GNRC_ICMPV6
+    if (type == GNRC_NETTYPE_ICMPV6) {
+        return GNRC_PKTBUF_CLASS_CTRL;
+    }
+#else
+    (void)type;
+#endif
+    return GNRC_PKTBUF_CLASS_OTHER;
+}
+#else
+static inline bool _quota_charge(unsigned cls, size_t bytes)
+{
+    (void)cls;
+    (void)bytes;
+    return true;
+}
+
+static inline void _quota_refund(unsigned cls, size_t bytes)
+{
+    (void)cls;
+    (void)bytes;
+}
+
+static inline unsigned _class_of(const gnrc_pktsnip_t *pkt)
+{
+    (void)pkt;
+    return 0;
+}
+
+static inline void _set_class(gnrc_pktsnip_t *pkt, unsigned cls)
+{
+    (void)pkt;
+    (void)cls;
+}
+
+static inline unsigned _class_new(const gnrc_pktsnip_t *next,
+                                  gnrc_nettype_t type)
+{
+    (void)next;
+    (void)type;
+    return 0;
+}
+#endif
+
 static inline bool _pktbuf_contains(void *ptr)
 {
-    return (unsigned)((uint8_t *)ptr - _pktbuf) < GNRC_PKTBUF_SIZE;
+    return ((unsigned)((uint8_t *)ptr - _pktbuf) < GNRC_PKTBUF_SIZE) ||
+           _slab_contains(ptr);
 }
 
 /* fits size to byte alignment */
@@ -77,6 +330,9 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
 #ifdef MODULE_GNRC_NETERR
     pkt->err_sub = KERNEL_PID_UNDEF;
 #endif
+#ifdef MODULE_GNRC_PKTTRACE
+    pkt->trace_point = 0;
+#endif
 }
 
 void gnrc_pktbuf_init(void)
@@ -85,6 +341,15 @@ void gnrc_pktbuf_init(void)
     _first_unused = (_unused_t *)_pktbuf;
     _first_unused->next = NULL;
     _first_unused->size = sizeof(_pktbuf);
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    _slab_init();
+#endif
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+    for (unsigned i = 0; i < GNRC_PKTBUF_CLASS_NUMOF; i++) {
+        _quotas[i].used = 0;
+    }
+    _quota_used = 0;
+#endif
     mutex_unlock(&_mutex);
 }
 
@@ -99,7 +364,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t s
         return NULL;
     }
     mutex_lock(&_mutex);
-    pkt = _create_snip(next, data, size, type);
+    pkt = _create_snip(next, data, size, type, _class_new(next, type));
     mutex_unlock(&_mutex);
     return pkt;
 }
@@ -120,21 +385,28 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         mutex_unlock(&_mutex);
         return NULL;
     }
+    if (!_quota_charge(_class_of(pkt), sizeof(gnrc_pktsnip_t))) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
     /* create new snip descriptor for marked data */
     marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
     if (marked_snip == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
+        _quota_refund(_class_of(pkt), sizeof(gnrc_pktsnip_t));
         mutex_unlock(&_mutex);
         return NULL;
     }
-    /* marked data would not fit _unused_t marker => move data around to allow
-     * for proper free */
-    if ((pkt->size != size) && (size < required_new_size)) {
+    /* marked data would not fit _unused_t marker or is part of a fixed-size
+     * pool chunk => move data around to allow for proper free */
+    if ((pkt->size != size) &&
+        ((size < required_new_size) || _slab_contains(pkt->data))) {
         void *new_data_rest;
         new_data_marked = _pktbuf_alloc(size);
         if (new_data_marked == NULL) {
             DEBUG("pktbuf: could not reallocate marked section.\n");
             _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            _quota_refund(_class_of(pkt), sizeof(gnrc_pktsnip_t));
             mutex_unlock(&_mutex);
             return NULL;
         }
@@ -143,6 +415,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
             DEBUG("pktbuf: could not reallocate remaining section.\n");
             _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
             _pktbuf_free(new_data_marked, size);
+            _quota_refund(_class_of(pkt), sizeof(gnrc_pktsnip_t));
             mutex_unlock(&_mutex);
             return NULL;
         }
@@ -160,6 +433,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
     }
     pkt->size -= size;
     _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    _set_class(marked_snip, _class_of(pkt));
     pkt->next = marked_snip;
     mutex_unlock(&_mutex);
     return marked_snip;
@@ -179,6 +453,10 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         mutex_unlock(&_mutex);
         return 0;
     }
+    if ((size > pkt->size) && !_quota_charge(_class_of(pkt), size - pkt->size)) {
+        mutex_unlock(&_mutex);
+        return ENOMEM;
+    }
     /* new size is 0 and data pointer isn't already NULL */
     if ((size == 0) && (pkt->data != NULL)) {
         /* set data pointer to NULL */
@@ -186,10 +464,15 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         pkt->data = NULL;
     }
     /* if new size is bigger than old size */
+    else if ((size > pkt->size) && (pkt->data != NULL) &&
+             _pktbuf_grow(pkt->data, pkt->size, size)) {
+        /* chunk was extended in place */
+    }
     else if (size > pkt->size) {    /* new size does not fit */
         void *new_data = _pktbuf_alloc(size);
         if (new_data == NULL) {
             DEBUG("pktbuf: error allocating new data section\n");
+            _quota_refund(_class_of(pkt), size - pkt->size);
             mutex_unlock(&_mutex);
             return ENOMEM;
         }
@@ -199,10 +482,14 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         _pktbuf_free(pkt->data, pkt->size);
         pkt->data = new_data;
     }
-    else if (_align(pkt->size) > aligned_size) {
+    /* pool chunks can't be split, so they just keep their spare room */
+    else if (!_slab_contains(pkt->data) && (_align(pkt->size) > aligned_size)) {
         _pktbuf_free(((uint8_t *)pkt->data) + aligned_size,
                      pkt->size - aligned_size);
     }
+    if (size < pkt->size) {
+        _quota_refund(_class_of(pkt), pkt->size - size);
+    }
     pkt->size = size;
     mutex_unlock(&_mutex);
     return 0;
@@ -227,6 +514,7 @@ static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
         tmp = pkt->next;
         if (pkt->users == 1) {
             pkt->users = 0; /* not necessary but to be on the safe side */
+            _quota_refund(_class_of(pkt), sizeof(gnrc_pktsnip_t) + pkt->size);
             _pktbuf_free(pkt->data, pkt->size);
             _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
         }
@@ -255,9 +543,14 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
     }
     if (pkt->users > 1) {
         gnrc_pktsnip_t *new;
-        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type,
+                           _class_of(pkt));
         if (new != NULL) {
             pkt->users--;
+#ifdef MODULE_GNRC_PKTTRACE
+            new->trace_time = pkt->trace_time;
+            new->trace_point = pkt->trace_point;
+#endif
         }
         mutex_unlock(&_mutex);
         return new;
@@ -266,6 +559,76 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
     return pkt;
 }
 
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+/* control traffic keeps its class in the queues it passes */
+static inline bool _class_moves(const gnrc_pktsnip_t *pkt, unsigned cls)
+{
+    return (pkt->cls != cls) && (pkt->cls != GNRC_PKTBUF_CLASS_CTRL);
+}
+
+int gnrc_pktbuf_set_class(gnrc_pktsnip_t *pkt, gnrc_pktbuf_class_t cls)
+{
+    size_t bytes = 0;
+
+    assert((unsigned)cls < GNRC_PKTBUF_CLASS_NUMOF);
+    mutex_lock(&_mutex);
+    for (gnrc_pktsnip_t *ptr = pkt; ptr != NULL; ptr = ptr->next) {
+        if (_class_moves(ptr, cls)) {
+            bytes += sizeof(gnrc_pktsnip_t) + ptr->size;
+        }
+    }
+    /* the snips are allocated already, so only the quota applies */
+    if ((_quotas[cls].used + bytes) > _quotas[cls].quota) {
+        DEBUG("pktbuf: %u byte exceed quota of class %u\n", (unsigned)bytes,
+              (unsigned)cls);
+        _quotas[cls].refused++;
+        mutex_unlock(&_mutex);
+        return -ENOBUFS;
+    }
+    for (gnrc_pktsnip_t *ptr = pkt; ptr != NULL; ptr = ptr->next) {
+        if (_class_moves(ptr, cls)) {
+            _quota_refund(ptr->cls, sizeof(gnrc_pktsnip_t) + ptr->size);
+            _quota_add(cls, sizeof(gnrc_pktsnip_t) + ptr->size);
+            ptr->cls = cls;
+        }
+    }
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+bool gnrc_pktbuf_admit(gnrc_pktbuf_class_t cls, size_t size)
+{
+    bool res;
+
+    assert((unsigned)cls < GNRC_PKTBUF_CLASS_NUMOF);
+    mutex_lock(&_mutex);
+    res = _quota_fits(cls, sizeof(gnrc_pktsnip_t) + size);
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+void gnrc_pktbuf_set_quota(gnrc_pktbuf_class_t cls, size_t quota)
+{
+    assert((unsigned)cls < GNRC_PKTBUF_CLASS_NUMOF);
+    mutex_lock(&_mutex);
+    _quotas[cls].quota = quota;
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_pktbuf_set_reserve(size_t reserve)
+{
+    mutex_lock(&_mutex);
+    _ctrl_reserve = reserve;
+    mutex_unlock(&_mutex);
+}
+
+size_t gnrc_pktbuf_usage(gnrc_pktbuf_class_t cls)
+{
+    assert((unsigned)cls < GNRC_PKTBUF_CLASS_NUMOF);
+    return _quotas[cls].used;
+}
+#endif
+
 #ifdef DEVELHELP
 #ifdef MODULE_OD
 static inline void _print_chunk(void *chunk, size_t size, int num)
@@ -284,6 +647,20 @@ static inline void _print_unused(_unused_t *ptr)
 
 void gnrc_pktbuf_stats(void)
 {
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        printf("slab class %4u B: %3u/%3u chunks used (max: %3u)\n",
+               (unsigned)_slabs[i].pool.size, (unsigned)_slabs[i].used,
+               (unsigned)_slabs[i].pool.num, (unsigned)_slabs[i].max_used);
+    }
+#endif
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+    for (unsigned i = 0; i < GNRC_PKTBUF_CLASS_NUMOF; i++) {
+        printf("class %u: %5u/%5u B used (max: %5u), %u refused\n", i,
+               (unsigned)_quotas[i].used, (unsigned)_quotas[i].quota,
+               (unsigned)_quotas[i].max_used, _quotas[i].refused);
+    }
+#endif
 #ifdef MODULE_OD
     _unused_t *ptr = _first_unused;
     uint8_t *chunk = &_pktbuf[0];
@@ -327,6 +704,13 @@ void gnrc_pktbuf_stats(void)
 #ifdef TEST_SUITES
 bool gnrc_pktbuf_is_empty(void)
 {
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        if (_slabs[i].used > 0) {
+            return false;
+        }
+    }
+#endif
     return (_first_unused == (_unused_t *)_pktbuf) &&
            (_first_unused->size == sizeof(_pktbuf));
 }
@@ -364,13 +748,18 @@ bool gnrc_pktbuf_is_sane(void)
 #endif
 
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
-                                    gnrc_nettype_t type)
+                                    gnrc_nettype_t type, unsigned cls)
 {
-    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    gnrc_pktsnip_t *pkt;
     void *_data = NULL;
 
+    if (!_quota_charge(cls, sizeof(gnrc_pktsnip_t) + size)) {
+        return NULL;
+    }
+    pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
     if (pkt == NULL) {
         DEBUG("pktbuf: error allocating new packet snip\n");
+        _quota_refund(cls, sizeof(gnrc_pktsnip_t) + size);
         return NULL;
     }
     if (size > 0) {
@@ -378,10 +767,12 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size
         if (_data == NULL) {
             DEBUG("pktbuf: error allocating data for new packet snip\n");
             _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+            _quota_refund(cls, sizeof(gnrc_pktsnip_t) + size);
             return NULL;
         }
     }
     _set_pktsnip(pkt, next, _data, size, type);
+    _set_class(pkt, cls);
     if (data != NULL) {
         memcpy(_data, data, size);
     }
@@ -392,6 +783,12 @@ static void *_pktbuf_alloc(size_t size)
 {
     _unused_t *prev = NULL, *ptr = _first_unused;
 
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    void *chunk = _slab_alloc(size);
+    if (chunk != NULL) {
+        return chunk;
+    }
+#endif
     size = _align(size);
     while (ptr && (size > ptr->size)) {
         prev = ptr;
@@ -435,6 +832,68 @@ static void *_pktbuf_alloc(size_t size)
     return (void *)ptr;
 }
 
+/* extends the chunk at data by the unused space directly behind it, if it is
+ * big enough */
+static bool _pktbuf_grow(void *data, size_t old_size, size_t size)
+{
+    uint8_t *end = ((uint8_t *)data) + _align(old_size);
+    size_t required = _align(size) - _align(old_size);
+    _unused_t *prev = NULL, *ptr = _first_unused;
+
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    _slab_t *slab = _slab_find(data);
+    if (slab != NULL) {
+        /* pool chunks have a fixed size */
+        return (size <= slab->pool.size);
+    }
+#endif
+    if (required == 0) {
+        /* fits into the alignment padding of the chunk */
+        return true;
+    }
+    while (ptr && (((uint8_t *)ptr) < end)) {
+        prev = ptr;
+        ptr = ptr->next;
+    }
+    if ((((uint8_t *)ptr) != end) || (required > ptr->size)) {
+        return false;
+    }
+    /* _unused_t struct would fit => keep rest of ptr as unused space */
+    if (sizeof(_unused_t) > (ptr->size - required)) {
+        if (prev == NULL) { /* ptr was _first_unused */
+            _first_unused = ptr->next;
+        }
+        else {
+            prev->next = ptr->next;
+        }
+    }
+    else {
+        _unused_t *new = (_unused_t *)(end + required);
+        _unused_t *next = ptr->next;
+        size_t new_size = ptr->size - required;
+
+        if (((((uint8_t *)new) - &(_pktbuf[0])) + sizeof(_unused_t)) > GNRC_PKTBUF_SIZE) {
+            /* content of new would exceed packet buffer size so set to NULL */
+            _first_unused = NULL;
+        }
+        else if (prev == NULL) { /* ptr was _first_unused */
+            _first_unused = new;
+        }
+        else {
+            prev->next = new;
+        }
+        new->next = next;
+        new->size = new_size;
+    }
+#ifdef DEVELHELP
+    uint16_t last_byte = (uint16_t)((end + required) - &(_pktbuf[0]));
+    if (last_byte > max_byte_count) {
+        max_byte_count = last_byte;
+    }
+#endif
+    return true;
+}
+
 static inline bool _too_small_hole(_unused_t *a, _unused_t *b)
 {
     return sizeof(_unused_t) > (size_t)(((uint8_t *)b) - (((uint8_t *)a) + a->size));
@@ -454,6 +913,13 @@ static void _pktbuf_free(void *data, size_t size)
     size_t bytes_at_end;
     _unused_t *new = (_unused_t *)data, *prev = NULL, *ptr = _first_unused;
 
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    _slab_t *slab = _slab_find(data);
+    if (slab != NULL) {
+        _slab_free(slab, data);
+        return;
+    }
+#endif
     if (!_pktbuf_contains(data)) {
         return;
     }
@@ -498,7 +964,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
     gnrc_pktsnip_t *tmp;
     gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
     gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
-    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type, _class_of(pkt));
 
     if (new == NULL) {
         mutex_unlock(&_mutex);
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pktcap
+ * @{
+ *
+ * @file
+ * @}
+ */
+
+#include <string.h>
+
+#include "irq.h"
+#include "xtimer.h"
+#include "net/ethernet/hdr.h"
+#include "net/ethertype.h"
+#include "net/ieee802154.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/gnrc/pktcap.h"
+
+#if GNRC_PKTCAP_SNAPLEN > UINT8_MAX
+#error "GNRC_PKTCAP_SNAPLEN must be at most 255"
+#endif
+
+/* pcapng block types and link types */
+#define _SHB                    (0x0a0d0d0aUL)
+#define _SHB_MAGIC              (0x1a2b3c4dUL)
+#define _IDB                    (0x00000001UL)
+#define _EPB                    (0x00000006UL)
+#define _EPB_FLAGS              (2U)
+#define _EPB_FLAGS_IN           (1U)
+#define _EPB_FLAGS_OUT          (2U)
+#define _LINKTYPE_ETHERNET      (1U)
+#define _LINKTYPE_IEEE802154    (230U)  /* IEEE 802.15.4 without FCS */
+#define _LINKTYPE_USER0         (147U)
+
+#define _SHB_LEN                (28U)
+#define _IDB_LEN                (20U)
+#define _EPB_LEN                (44U)   /* without data, with epb_flags */
+
+typedef struct {
+    uint64_t time;              /* µs */
+    kernel_pid_t pid;
+    uint16_t len;
+    uint8_t caplen;
+    bool tx;
+    uint8_t data[GNRC_PKTCAP_SNAPLEN];
+} _rec_t;
+
+/* window of the pcapng file gnrc_pktcap_read() is writing */
+typedef struct {
+    size_t pos;                 /* position of the file written next */
+    size_t offset;
+    size_t len;
+    uint8_t *buf;
+} _reader_t;
+
+static _rec_t _ring[GNRC_PKTCAP_NUMOF];
+static unsigned _next;
+static unsigned _count;
+static gnrc_pktcap_stats_t _stats;
+static bool _enabled = true;
+static uint16_t _ethertype;
+static uint16_t _port;
+
+static uint16_t _get16(const uint8_t *buf)
+{
+    return (buf[0] << 8) | buf[1];
+}
+
+/* checks the ports of an IPv6 packet in the captured head */
+static bool _match_port(const uint8_t *ipv6, size_t len)
+{
+    const ipv6_hdr_t *hdr = (const ipv6_hdr_t *)ipv6;
+
+    if (_port == 0) {
+        return true;
+    }
+    if ((len < (sizeof(ipv6_hdr_t) + 4)) || !ipv6_hdr_is(hdr) ||
+        ((hdr->nh != PROTNUM_UDP) && (hdr->nh != PROTNUM_TCP))) {
+        return false;
+    }
+    ipv6 += sizeof(ipv6_hdr_t);
+    return (_get16(ipv6) == _port) || (_get16(ipv6 + 2) == _port);
+}
+
+static bool _match(const gnrc_netif_t *netif, const uint8_t *head,
+                   size_t len)
+{
+    switch (netif->device_type) {
+        case NETDEV_TYPE_ETHERNET:
+            if (len < sizeof(ethernet_hdr_t)) {
+                return (_ethertype == 0) && (_port == 0);
+            }
+            if ((_ethertype != 0) && (_get16(&head[12]) != _ethertype)) {
+                return false;
+            }
+            return (_get16(&head[12]) != ETHERTYPE_IPV6) ?
+                   (_port == 0) :
+                   _match_port(&head[sizeof(ethernet_hdr_t)],
+                               len - sizeof(ethernet_hdr_t));
+#ifdef MODULE_IEEE802154
+        case NETDEV_TYPE_IEEE802154: {
+            size_t mhr_len = ieee802154_get_frame_hdr_len(head);
+
+            if ((_ethertype != 0) && (_ethertype != ETHERTYPE_IPV6)) {
+                return false;
+            }
+            if (_port == 0) {
+                return true;
+            }
+            if ((mhr_len == 0) || (len <= mhr_len) ||
+                (head[mhr_len] != SIXLOWPAN_UNCOMP)) {
+                return false;
+            }
+            return _match_port(&head[mhr_len + 1], len - mhr_len - 1);
+        }
+#endif
+        default:
+            return (_ethertype == 0) && (_port == 0);
+    }
+}
+
+void gnrc_pktcap_frame(const gnrc_netif_t *netif, const iolist_t *frame,
+                       bool tx)
+{
+    uint8_t head[GNRC_PKTCAP_SNAPLEN];
+    size_t caplen = 0, len = 0;
+
+    if (!_enabled) {
+        return;
+    }
+    for (const iolist_t *iol = frame; iol; iol = iol->iol_next) {
+        if (caplen < sizeof(head)) {
+            size_t n = sizeof(head) - caplen;
+
+            n = (iol->iol_len < n) ? iol->iol_len : n;
+            memcpy(&head[caplen], iol->iol_base, n);
+            caplen += n;
+        }
+        len += iol->iol_len;
+    }
+
+    bool match = _match(netif, head, caplen);
+    uint64_t now = xtimer_now_usec64();
+    /* the interfaces run in different threads */
+    unsigned state = irq_disable();
+
+    if (!match) {
+        _stats.filtered++;
+        irq_restore(state);
+        return;
+    }
+
+    _rec_t *rec = &_ring[_next];
+
+    _next = (_next + 1) % GNRC_PKTCAP_NUMOF;
+    if (_count < GNRC_PKTCAP_NUMOF) {
+        _count++;
+    }
+    else {
+        _stats.overwritten++;
+    }
+    _stats.captured++;
+    rec->time = now;
+    rec->pid = netif->pid;
+    rec->len = (len > UINT16_MAX) ? UINT16_MAX : len;
+    rec->caplen = caplen;
+    rec->tx = tx;
+    memcpy(rec->data, head, caplen);
+    irq_restore(state);
+}
+
+void gnrc_pktcap_enable(bool enable)
+{
+    _enabled = enable;
+}
+
+void gnrc_pktcap_filter(uint16_t ethertype, uint16_t port)
+{
+    unsigned state = irq_disable();
+
+    _ethertype = ethertype;
+    _port = port;
+    irq_restore(state);
+}
+
+void gnrc_pktcap_clear(void)
+{
+    unsigned state = irq_disable();
+
+    _count = 0;
+    memset(&_stats, 0, sizeof(_stats));
+    irq_restore(state);
+}
+
+void gnrc_pktcap_stats(gnrc_pktcap_stats_t *stats)
+{
+    unsigned state = irq_disable();
+
+    *stats = _stats;
+    irq_restore(state);
+}
+
+/* writes the part of data that falls into the window of the reader */
+static void _put(_reader_t *r, const void *data, size_t len)
+{
+    if (((r->pos + len) > r->offset) && (r->pos < (r->offset + r->len))) {
+        size_t skip = (r->offset > r->pos) ? (r->offset - r->pos) : 0;
+        size_t n = len - skip;
+
+        if ((r->pos + skip + n) > (r->offset + r->len)) {
+            n = r->offset + r->len - r->pos - skip;
+        }
+        memcpy(&r->buf[r->pos + skip - r->offset],
+               (const uint8_t *)data + skip, n);
+    }
+    r->pos += len;
+}
+
+static void _put16(_reader_t *r, uint16_t val)
+{
+    _put(r, &val, sizeof(val));
+}
+
+static void _put32(_reader_t *r, uint32_t val)
+{
+    _put(r, &val, sizeof(val));
+}
+
+static void _put_idb(_reader_t *r, const gnrc_netif_t *netif)
+{
+    uint16_t linktype;
+
+    switch (netif->device_type) {
+        case NETDEV_TYPE_ETHERNET:
+            linktype = _LINKTYPE_ETHERNET;
+            break;
+        case NETDEV_TYPE_IEEE802154:
+            linktype = _LINKTYPE_IEEE802154;
+            break;
+        default:
+            linktype = _LINKTYPE_USER0;
+            break;
+    }
+    _put32(r, _IDB);
+    _put32(r, _IDB_LEN);
+    _put16(r, linktype);
+    _put16(r, 0);                   /* reserved */
+    _put32(r, GNRC_PKTCAP_SNAPLEN);
+    _put32(r, _IDB_LEN);
+}
+
+static void _put_epb(_reader_t *r, const _rec_t *rec)
+{
+    static const uint8_t pad[3] = { 0 };
+    uint32_t padded = (rec->caplen + 3U) & ~3U;
+    uint32_t iface = 0;
+
+    for (gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+         (netif != NULL) && (netif->pid != rec->pid);
+         netif = gnrc_netif_iter(netif)) {
+        iface++;
+    }
+    _put32(r, _EPB);
+    _put32(r, _EPB_LEN + padded);
+    _put32(r, iface);
+    _put32(r, (uint32_t)(rec->time >> 32));
+    _put32(r, (uint32_t)rec->time);
+    _put32(r, rec->caplen);
+    _put32(r, rec->len);
+    _put(r, rec->data, rec->caplen);
+    _put(r, pad, padded - rec->caplen);
+    _put16(r, _EPB_FLAGS);
+    _put16(r, 4);
+    _put32(r, (rec->tx) ? _EPB_FLAGS_OUT : _EPB_FLAGS_IN);
+    _put32(r, 0);                   /* opt_endofopt */
+    _put32(r, _EPB_LEN + padded);
+}
+
+ssize_t gnrc_pktcap_read(void *arg, size_t offset, void *buf, size_t len)
+{
+    _reader_t r = { .pos = 0, .offset = offset, .len = len, .buf = buf };
+    unsigned state = irq_disable();
+    unsigned first = (_next + GNRC_PKTCAP_NUMOF - _count) % GNRC_PKTCAP_NUMOF;
+    unsigned count = _count;
+
+    irq_restore(state);
+    (void)arg;
+
+    _put32(&r, _SHB);
+    _put32(&r, _SHB_LEN);
+    _put32(&r, _SHB_MAGIC);
+    _put16(&r, 1);                  /* version 1.0 */
+    _put16(&r, 0);
+    _put32(&r, UINT32_MAX);         /* section length unknown */
+    _put32(&r, UINT32_MAX);
+    _put32(&r, _SHB_LEN);
+    for (gnrc_netif_t *netif = gnrc_netif_iter(NULL); netif != NULL;
+         netif = gnrc_netif_iter(netif)) {
+        _put_idb(&r, netif);
+    }
+    for (unsigned i = 0; (i < count) && (r.pos < (offset + len)); i++) {
+        _put_epb(&r, &_ring[(first + i) % GNRC_PKTCAP_NUMOF]);
+    }
+    if (r.pos <= offset) {
+        return 0;
+    }
+    return ((r.pos - offset) < len) ? (ssize_t)(r.pos - offset) : (ssize_t)len;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pkttrace
+ * @{
+ *
+ * @file
+ * @}
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "xtimer.h"
+#include "net/gnrc/pkttrace.h"
+
+static gnrc_pkttrace_hist_t _hists[GNRC_PKTTRACE_NUMOF];
+
+static const char *_names[GNRC_PKTTRACE_NUMOF] = {
+    [GNRC_PKTTRACE_RX_NETDEV] = "rx_netdev",
+    [GNRC_PKTTRACE_RX_NETIF] = "rx_netif",
+    [GNRC_PKTTRACE_RX_SIXLOWPAN] = "rx_sixlowpan",
+    [GNRC_PKTTRACE_RX_IPHC] = "rx_iphc",
+    [GNRC_PKTTRACE_RX_IPV6] = "rx_ipv6",
+    [GNRC_PKTTRACE_RX_UDP] = "rx_udp",
+    [GNRC_PKTTRACE_RX_SOCK] = "rx_sock",
+    [GNRC_PKTTRACE_TX_SOCK] = "tx_sock",
+    [GNRC_PKTTRACE_TX_UDP] = "tx_udp",
+    [GNRC_PKTTRACE_TX_IPV6] = "tx_ipv6",
+    [GNRC_PKTTRACE_TX_SIXLOWPAN] = "tx_sixlowpan",
+    [GNRC_PKTTRACE_TX_IPHC] = "tx_iphc",
+    [GNRC_PKTTRACE_TX_NETIF] = "tx_netif",
+    [GNRC_PKTTRACE_TX_NETDEV] = "tx_netdev",
+};
+
+static unsigned _bucket(uint32_t latency)
+{
+    unsigned bucket = 0;
+
+    /* bitarithm_msb() takes an unsigned, which is too short on 16-bit
+     * platforms */
+    while ((latency >>= 1) && (bucket < (GNRC_PKTTRACE_BUCKETS - 1))) {
+        bucket++;
+    }
+    return bucket;
+}
+
+void gnrc_pkttrace_start(gnrc_pktsnip_t *pkt, gnrc_pkttrace_point_t point,
+                         uint32_t time)
+{
+    assert(point < GNRC_PKTTRACE_NUMOF);
+    pkt->trace_time = time;
+    pkt->trace_point = point + 1;
+}
+
+static const gnrc_pktsnip_t *_stamped(const gnrc_pktsnip_t *pkt)
+{
+    while ((pkt != NULL) && (pkt->trace_point == 0)) {
+        pkt = pkt->next;
+    }
+    return pkt;
+}
+
+void gnrc_pkttrace(gnrc_pktsnip_t *pkt, gnrc_pkttrace_point_t point)
+{
+    gnrc_pktsnip_t *stamped = (gnrc_pktsnip_t *)_stamped(pkt);
+    uint32_t now;
+
+    assert(point < GNRC_PKTTRACE_NUMOF);
+    if (stamped == NULL) {
+        return;
+    }
+    now = xtimer_now_usec();
+    gnrc_pkttrace_record(point, now - stamped->trace_time);
+    stamped->trace_time = now;
+    stamped->trace_point = point + 1;
+}
+
+bool gnrc_pkttrace_time(const gnrc_pktsnip_t *pkt, uint32_t *time)
+{
+    const gnrc_pktsnip_t *stamped = _stamped(pkt);
+
+    if (stamped == NULL) {
+        return false;
+    }
+    *time = stamped->trace_time;
+    return true;
+}
+
+void gnrc_pkttrace_record(gnrc_pkttrace_point_t point, uint32_t latency)
+{
+    gnrc_pkttrace_hist_t *hist = &_hists[point];
+    unsigned state;
+
+    assert(point < GNRC_PKTTRACE_NUMOF);
+    /* the layers run in different threads */
+    state = irq_disable();
+    hist->buckets[_bucket(latency)]++;
+    hist->sum += latency;
+    if (latency > hist->max) {
+        hist->max = latency;
+    }
+    irq_restore(state);
+}
+
+void gnrc_pkttrace_get(gnrc_pkttrace_point_t point,
+                       gnrc_pkttrace_hist_t *hist)
+{
+    unsigned state;
+
+    assert(point < GNRC_PKTTRACE_NUMOF);
+    state = irq_disable();
+    *hist = _hists[point];
+    irq_restore(state);
+}
+
+const char *gnrc_pkttrace_point_str(gnrc_pkttrace_point_t point)
+{
+    return (point < GNRC_PKTTRACE_NUMOF) ? _names[point] : "unknown";
+}
+
+void gnrc_pkttrace_reset(void)
+{
+    unsigned state = irq_disable();
+
+    memset(_hists, 0, sizeof(_hists));
+    irq_restore(state);
+}
+
+void gnrc_pkttrace_print(void)
+{
+    for (unsigned i = 0; i < GNRC_PKTTRACE_NUMOF; i++) {
+        gnrc_pkttrace_hist_t hist;
+        uint32_t count = 0;
+
+        gnrc_pkttrace_get(i, &hist);
+        for (unsigned j = 0; j < GNRC_PKTTRACE_BUCKETS; j++) {
+            count += hist.buckets[j];
+        }
+        if (count == 0) {
+            continue;
+        }
+        printf("%-12s count: %" PRIu32 " avg: %" PRIu32 " us max: %" PRIu32
+               " us\n", _names[i], count, hist.sum / count, hist.max);
+        for (unsigned j = 0; j < GNRC_PKTTRACE_BUCKETS; j++) {
+            if (hist.buckets[j] == 0) {
+                continue;
+            }
+            printf("    %s%6" PRIu32 " us: %" PRIu32 "\n",
+                   (j == (GNRC_PKTTRACE_BUCKETS - 1)) ? ">=" : "< ",
+                   (j == (GNRC_PKTTRACE_BUCKETS - 1)) ? (UINT32_C(1) << j)
+                                                      : (UINT32_C(2) << j),
+                   hist.buckets[j]);
+        }
+    }
+}
@@ -24,11 +24,27 @@
 
 /******************************************************************************/
 
+#ifdef MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP
+typedef priority_heap_node_t _node_t;
+
+#define _add(queue, node)       priority_heap_add(queue, node)
+#define _remove(queue, node)    priority_heap_remove(queue, node)
+#define _remove_head(queue)     priority_heap_remove_head(queue)
+#define _head(queue)            priority_heap_head(queue)
+#else
+typedef priority_queue_node_t _node_t;
+
+#define _add(queue, node)       priority_queue_add(queue, node)
+#define _remove(queue, node)    priority_queue_remove(queue, node)
+#define _remove_head(queue)     priority_queue_remove_head(queue)
+#define _head(queue)            ((queue)->first)
+#endif
+
 static inline void _free_node(gnrc_priority_pktqueue_node_t *node)
 {
     assert(node != NULL);
 
-    priority_queue_node_init((priority_queue_node_t *)node);
+    gnrc_priority_pktqueue_node_init(node, 0, NULL);
 }
 
 /******************************************************************************/
@@ -38,7 +54,7 @@ gnrc_pktsnip_t *gnrc_priority_pktqueue_pop(gnrc_priority_pktqueue_t *queue)
     if (!queue || (gnrc_priority_pktqueue_length(queue) == 0)) {
         return NULL;
     }
-    priority_queue_node_t *head = priority_queue_remove_head(queue);
+    _node_t *head = _remove_head(queue);
     gnrc_pktsnip_t *pkt = (gnrc_pktsnip_t *) head->data;
     _free_node((gnrc_priority_pktqueue_node_t *)head);
     return pkt;
@@ -51,7 +67,7 @@ gnrc_pktsnip_t *gnrc_priority_pktqueue_head(gnrc_priority_pktqueue_t *queue)
     if (!queue || (gnrc_priority_pktqueue_length(queue) == 0)) {
         return NULL;
     }
-    return (gnrc_pktsnip_t *)queue->first->data;
+    return (gnrc_pktsnip_t *)_head(queue)->data;
 }
 /******************************************************************************/
 
@@ -63,7 +79,35 @@ void gnrc_priority_pktqueue_push(gnrc_priority_pktqueue_t *queue,
     assert(node->pkt != NULL);
     assert(sizeof(unsigned int) == sizeof(gnrc_pktsnip_t *));
 
-    priority_queue_add(queue, (priority_queue_node_t *)node);
+    _add(queue, (_node_t *)node);
+}
+
+/******************************************************************************/
+
+gnrc_priority_pktqueue_node_t *gnrc_priority_pktqueue_last(gnrc_priority_pktqueue_t *queue)
+{
+    assert(queue != NULL);
+
+#ifdef MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP
+    return (gnrc_priority_pktqueue_node_t *)priority_heap_last(queue);
+#else
+    priority_queue_node_t *node = queue->first;
+    while (node && node->next) {
+        node = node->next;
+    }
+    return (gnrc_priority_pktqueue_node_t *)node;
+#endif
+}
+
+/******************************************************************************/
+
+void gnrc_priority_pktqueue_remove(gnrc_priority_pktqueue_t *queue,
+                                   gnrc_priority_pktqueue_node_t *node)
+{
+    assert(queue != NULL);
+    assert(node != NULL);
+
+    _remove(queue, (_node_t *)node);
 }
 
 /******************************************************************************/
@@ -76,7 +120,7 @@ void gnrc_priority_pktqueue_flush(gnrc_priority_pktqueue_t *queue)
         return;
     }
     gnrc_priority_pktqueue_node_t *node;
-    while ((node = (gnrc_priority_pktqueue_node_t *)priority_queue_remove_head(queue))) {
+    while ((node = (gnrc_priority_pktqueue_node_t *)_remove_head(queue))) {
         gnrc_pktbuf_release(node->pkt);
         _free_node(node);
     }
@@ -87,6 +131,9 @@ uint32_t gnrc_priority_pktqueue_length(gnrc_priority_pktqueue_t *queue)
 {
     assert(queue != NULL);
 
+#ifdef MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP
+    return priority_heap_len(queue);
+#else
     uint32_t length = 0;
     priority_queue_node_t *node = queue->first;
     if (!node) {
@@ -99,4 +146,5 @@ uint32_t gnrc_priority_pktqueue_length(gnrc_priority_pktqueue_t *queue)
         node = node->next;
     }
     return length;
+#endif
 }
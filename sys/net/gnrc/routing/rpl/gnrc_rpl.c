@@ -329,6 +329,7 @@ void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag)
     evtimer_add_msg(&gnrc_rpl_evtimer, &dodag->dao_event, gnrc_rpl_pid);
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
+    dodag->dao_aggregating = false;
 }
 
 void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag)
@@ -341,10 +342,29 @@ void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag)
     evtimer_add_msg(&gnrc_rpl_evtimer, &dodag->dao_event, gnrc_rpl_pid);
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
+    dodag->dao_aggregating = false;
+}
+
+void gnrc_rpl_aggregate_dao(gnrc_rpl_dodag_t *dodag)
+{
+    if (dodag->dao_aggregating) {
+        /* the scheduled DAO will carry the update as well */
+        return;
+    }
+    evtimer_del(&gnrc_rpl_evtimer, (evtimer_event_t *)&dodag->dao_event);
+    ((evtimer_event_t *)&(dodag->dao_event))->offset = random_uint32_range(
+        GNRC_RPL_DAO_AGGREGATION_WINDOW,
+        GNRC_RPL_DAO_AGGREGATION_WINDOW + GNRC_RPL_DAO_DELAY_JITTER
+    );
+    evtimer_add_msg(&gnrc_rpl_evtimer, &dodag->dao_event, gnrc_rpl_pid);
+    dodag->dao_counter = 0;
+    dodag->dao_ack_received = false;
+    dodag->dao_aggregating = true;
 }
 
 void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
 {
+    dodag->dao_aggregating = false;
     if (dodag->node_status == GNRC_RPL_ROOT_NODE) {
         return;
     }
@@ -355,6 +375,8 @@ void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
 #endif
     if ((dodag->dao_ack_received == false) && (dodag->dao_counter < GNRC_RPL_DAO_SEND_RETRIES)) {
         dodag->dao_counter++;
+        /* only the DAO-ACK to the latest DAO confirms all targets */
+        dodag->dao_ack_seq = dodag->dao_seq;
         gnrc_rpl_send_DAO(dodag->instance, NULL, dodag->default_lifetime);
         evtimer_del(&gnrc_rpl_evtimer, (evtimer_event_t *)&dodag->dao_event);
         ((evtimer_event_t *)&(dodag->dao_event))->offset = GNRC_RPL_DAO_ACK_DELAY;
@@ -43,6 +43,14 @@
 #include "net/gnrc/rpl/p2p.h"
 #endif
 
+#ifdef MODULE_GNRC_RPL_ROUTES
+#include "net/gnrc/rpl/routes.h"
+#endif
+
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+#include "net/gnrc/rpl/srh.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -216,7 +224,7 @@ gnrc_pktsnip_t *_dio_prefix_info_build(gnrc_pktsnip_t *pkt, gnrc_rpl_dodag_t *do
     prefix_info->prefix_len = 64;
     if (_get_pl_entry(dodag->iface, &dodag->dodag_id, prefix_info->prefix_len,
                       &ple)) {
-        uint32_t now = (xtimer_now_usec64() / US_PER_MS) & UINT32_MAX;
+        uint32_t now = xtimer_now_msec();
         uint32_t valid_ltime = (ple.valid_until < UINT32_MAX) ?
                                (ple.valid_until - now) / MS_PER_SEC : UINT32_MAX;
         uint32_t pref_ltime = (ple.pref_until < UINT32_MAX) ?
@@ -393,6 +401,45 @@ static inline uint32_t _sec_to_ms(uint32_t sec)
     }
 }
 
+static void _dao_route_update(gnrc_rpl_opt_target_t *target, ipv6_addr_t *src,
+                              kernel_pid_t iface, uint32_t lifetime)
+{
+    gnrc_ipv6_nib_ft_del(&(target->target), target->prefix_length);
+#ifdef MODULE_GNRC_RPL_ROUTES
+    if ((target->prefix_length == IPV6_ADDR_BIT_LEN) &&
+        (gnrc_rpl_routes_add(&(target->target), src, iface, lifetime) == 0)) {
+        return;
+    }
+    /* fall back to the NIB if the route store is full */
+#endif
+    gnrc_ipv6_nib_ft_add(&(target->target), target->prefix_length, src,
+                         iface, lifetime);
+}
+
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+static inline bool _is_non_storing_root(gnrc_rpl_instance_t *inst)
+{
+    return (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) &&
+           (inst->dodag.node_status == GNRC_RPL_ROOT_NODE);
+}
+
+/* returns the parent address of a transit option with one, NULL otherwise */
+static ipv6_addr_t *_dao_transit_parent(gnrc_rpl_opt_transit_t *transit)
+{
+    if (transit->length < (sizeof(gnrc_rpl_opt_transit_t) -
+                           sizeof(gnrc_rpl_opt_t) + sizeof(ipv6_addr_t))) {
+        return NULL;
+    }
+    return (ipv6_addr_t *)(transit + 1);
+}
+
+static inline bool _is_me(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr)
+{
+    return ipv6_addr_equal(addr, &dodag->dodag_id) ||
+           (gnrc_netif_get_by_ipv6_addr(addr) != NULL);
+}
+#endif
+
 /** @todo allow target prefixes in target options to be of variable length */
 bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt, uint16_t len,
                     ipv6_addr_t *src, uint32_t *included_opts)
@@ -521,10 +568,15 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                       ipv6_addr_to_str(addr_str, &(target->target), (unsigned)sizeof(addr_str)),
                       target->prefix_length);
 
-                gnrc_ipv6_nib_ft_del(&(target->target), target->prefix_length);
-                gnrc_ipv6_nib_ft_add(&(target->target), target->prefix_length, src,
-                                     dodag->iface,
-                                     dodag->default_lifetime * dodag->lifetime_unit);
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+                /* the originator is no neighbor, wait for the parent address
+                 * of the transit information */
+                if (_is_non_storing_root(inst)) {
+                    break;
+                }
+#endif
+                _dao_route_update(target, src, dodag->iface,
+                                  dodag->default_lifetime * dodag->lifetime_unit);
                 break;
 
             case (GNRC_RPL_OPT_TRANSIT):
@@ -537,17 +589,32 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                     break;
                 }
 
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+                ipv6_addr_t *parent = _is_non_storing_root(inst)
+                                    ? _dao_transit_parent(transit) : NULL;
+#endif
                 do {
-                    DEBUG("RPL: updating FT entry %s/%d\n",
-                          ipv6_addr_to_str(addr_str, &(first_target->target), sizeof(addr_str)),
-                          first_target->prefix_length);
-
-                    gnrc_ipv6_nib_ft_del(&(first_target->target),
-                                         first_target->prefix_length);
-                    gnrc_ipv6_nib_ft_add(&(first_target->target),
-                                         first_target->prefix_length, src,
-                                         dodag->iface,
-                                         transit->path_lifetime * dodag->lifetime_unit);
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+                    if (parent != NULL) {
+                        DEBUG("RPL: updating DAO parent of %s\n",
+                              ipv6_addr_to_str(addr_str, &(first_target->target),
+                                               sizeof(addr_str)));
+                        gnrc_rpl_srh_root_update(&(first_target->target),
+                                                 _is_me(dodag, parent) ? NULL : parent,
+                                                 transit->path_lifetime *
+                                                 dodag->lifetime_unit);
+                    }
+                    else
+#endif
+                    {
+                        DEBUG("RPL: updating FT entry %s/%d\n",
+                              ipv6_addr_to_str(addr_str, &(first_target->target),
+                                               sizeof(addr_str)),
+                              first_target->prefix_length);
+
+                        _dao_route_update(first_target, src, dodag->iface,
+                                          transit->path_lifetime * dodag->lifetime_unit);
+                    }
 
                     first_target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (first_target)) +
                                    sizeof(gnrc_rpl_opt_t) + first_target->length);
@@ -799,7 +866,7 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
     /* incoming DIO is from pref. parent */
     else if (parent == dodag->parents) {
         if (parent->dtsn != dio->dtsn) {
-            gnrc_rpl_delay_dao(dodag);
+            gnrc_rpl_aggregate_dao(dodag);
         }
         parent->dtsn = dio->dtsn;
         dodag->grounded = dio->g_mop_prf >> GNRC_RPL_GROUNDED_SHIFT;
@@ -854,6 +921,28 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
     return opt_snip;
 }
 
+static gnrc_pktsnip_t *_dao_fte_build(gnrc_pktsnip_t *pkt, uint8_t lifetime,
+                                      gnrc_ipv6_nib_ft_t *fte)
+{
+    DEBUG("RPL: Send DAO - building transit option\n");
+
+    if ((pkt = _dao_transit_build(pkt, lifetime, false)) == NULL) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        return NULL;
+    }
+    if (ipv6_addr_is_global(&fte->dst) &&
+        !ipv6_addr_is_unspecified(&fte->next_hop)) {
+        DEBUG("RPL: Send DAO - building target %s/%d\n",
+              ipv6_addr_to_str(addr_str, &fte->dst, sizeof(addr_str)), fte->dst_len);
+
+        if ((pkt = _dao_target_build(pkt, &fte->dst, fte->dst_len)) == NULL) {
+            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+            return NULL;
+        }
+    }
+    return pkt;
+}
+
 void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t lifetime)
 {
     gnrc_rpl_dodag_t *dodag;
@@ -904,23 +993,18 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     void *ft_state = NULL;
     gnrc_ipv6_nib_ft_t fte;
     while(gnrc_ipv6_nib_ft_iter(NULL, dodag->iface, &ft_state, &fte)) {
-        DEBUG("RPL: Send DAO - building transit option\n");
-
-        if ((pkt = _dao_transit_build(pkt, lifetime, false)) == NULL) {
-            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        if ((pkt = _dao_fte_build(pkt, lifetime, &fte)) == NULL) {
             return;
         }
-        if (ipv6_addr_is_global(&fte.dst) &&
-            !ipv6_addr_is_unspecified(&fte.next_hop)) {
-            DEBUG("RPL: Send DAO - building target %s/%d\n",
-                  ipv6_addr_to_str(addr_str, &fte.dst, sizeof(addr_str)), fte.dst_len);
-
-            if ((pkt = _dao_target_build(pkt, &fte.dst, fte.dst_len)) == NULL) {
-                DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-                return;
-            }
+    }
+#ifdef MODULE_GNRC_RPL_ROUTES
+    ft_state = NULL;
+    while (gnrc_rpl_routes_iter(dodag->iface, &ft_state, &fte)) {
+        if ((pkt = _dao_fte_build(pkt, lifetime, &fte)) == NULL) {
+            return;
         }
     }
+#endif
 
     /* add own address */
     DEBUG("RPL: Send DAO - building target %s/128\n",
@@ -1094,7 +1178,7 @@ void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src
         gnrc_rpl_send_DAO_ACK(inst, src, dao->dao_sequence);
     }
 
-    gnrc_rpl_delay_dao(dodag);
+    gnrc_rpl_aggregate_dao(dodag);
 }
 
 void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6_addr_t *src,
@@ -1134,13 +1218,18 @@ void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6
         }
     }
 
-    if ((dao_ack->status != 0) && (dao_ack->dao_sequence != dodag->dao_seq)) {
+    if (dao_ack->dao_sequence != dodag->dao_ack_seq) {
         DEBUG("RPL: DAO-ACK sequence (%d) does not match expected sequence (%d)\n",
-                dao_ack->dao_sequence, dodag->dao_seq);
+                dao_ack->dao_sequence, dodag->dao_ack_seq);
         return;
     }
 
     dodag->dao_ack_received = true;
+    /* the DAO went up via the preferred parent, so the parent is reachable
+     * (RFC 4861, section 7.3.1) */
+    if (dodag->parents != NULL) {
+        gnrc_ipv6_nib_nc_mark_reachable(&dodag->parents->addr);
+    }
     gnrc_rpl_long_delay_dao(dodag);
 }
 
@@ -33,6 +33,14 @@
 #include "net/gnrc/rpl/p2p_dodag.h"
 #endif
 
+#ifdef MODULE_GNRC_RPL_ROUTES
+#include "net/gnrc/rpl/routes.h"
+#endif
+
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+#include "net/gnrc/rpl/srh.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -117,6 +125,14 @@ bool gnrc_rpl_instance_remove(gnrc_rpl_instance_t *inst)
     gnrc_rpl_p2p_ext_remove(dodag);
 #endif
     gnrc_rpl_dodag_remove_all_parents(dodag);
+#ifdef MODULE_GNRC_RPL_ROUTES
+    gnrc_rpl_routes_flush(dodag->iface);
+#endif
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+    if (dodag->node_status == GNRC_RPL_ROOT_NODE) {
+        gnrc_rpl_srh_root_flush();
+    }
+#endif
     trickle_stop(&dodag->trickle);
     evtimer_del(&gnrc_rpl_evtimer, (evtimer_event_t *)&dodag->dao_event);
     evtimer_del(&gnrc_rpl_evtimer, (evtimer_event_t *)&inst->cleanup_event);
@@ -155,6 +171,7 @@ bool gnrc_rpl_dodag_init(gnrc_rpl_instance_t *instance, ipv6_addr_t *dodag_id, k
     dodag->dtsn = 0;
     dodag->dao_ack_received = false;
     dodag->dao_counter = 0;
+    dodag->dao_aggregating = false;
     dodag->instance = instance;
     dodag->iface = iface;
     dodag->dao_event.msg.content.ptr = instance;
@@ -315,7 +332,16 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
     LL_SORT(dodag->parents, dodag->instance->of->parent_cmp);
     new_best = dodag->parents;
 
-    if (new_best->rank == GNRC_RPL_INFINITE_RANK) {
+    /* the objective function may prefer the current parent (hysteresis) */
+    if ((new_best != old_best) && (dodag->instance->of->which_parent != NULL) &&
+        (dodag->instance->of->which_parent(old_best, new_best) == old_best)) {
+        LL_DELETE(dodag->parents, old_best);
+        LL_PREPEND(dodag->parents, old_best);
+        new_best = old_best;
+    }
+
+    if ((new_best->rank == GNRC_RPL_INFINITE_RANK) ||
+        (dodag->instance->of->calc_rank(new_best, 0) == GNRC_RPL_INFINITE_RANK)) {
         return NULL;
     }
 
@@ -324,7 +350,7 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
         if ((dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_NO_MC) ||
             (dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_MC)) {
             gnrc_rpl_send_DAO(dodag->instance, &old_best->addr, 0);
-            gnrc_rpl_delay_dao(dodag);
+            gnrc_rpl_aggregate_dao(dodag);
         }
 
 #ifdef MODULE_GNRC_RPL_P2P
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl
+ * @{
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function.
+ *
+ * Implementation of MRHOF (RFC 6719) without metric container: the rank
+ * increase of a parent is the ETX of the link to it, scaled to the
+ * MinHopRankIncrease of the instance.
+ * @}
+ */
+
+#include "mrhof.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netif/etx.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/structs.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static uint16_t calc_rank(gnrc_rpl_parent_t *, uint16_t);
+static gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static int parent_cmp(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    GNRC_RPL_MRHOF_OCP,
+    calc_rank,
+    which_parent,
+    parent_cmp,
+    which_dodag,
+    reset,
+    NULL,
+    NULL,
+    NULL
+};
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+static void reset(gnrc_rpl_dodag_t *dodag)
+{
+    /* estimates are kept by the interface, nothing to do */
+    (void) dodag;
+}
+
+static uint16_t _link_etx(gnrc_rpl_parent_t *parent)
+{
+    void *state = NULL;
+    gnrc_ipv6_nib_nc_t nce;
+
+    while (gnrc_ipv6_nib_nc_iter(parent->dodag->iface, &state, &nce)) {
+        if (ipv6_addr_equal(&nce.ipv6, &parent->addr)) {
+            return gnrc_netif_etx_get(parent->dodag->iface, nce.l2addr,
+                                      nce.l2addr_len);
+        }
+    }
+    return GNRC_NETIF_ETX_INIT;
+}
+
+/* rank increase for ETX, never less than MinHopRankIncrease */
+static inline uint32_t _rank_inc(uint32_t etx, uint16_t min_hop_rank_inc)
+{
+    if (etx < GNRC_NETIF_ETX_DIVISOR) {
+        etx = GNRC_NETIF_ETX_DIVISOR;
+    }
+    return (etx * min_hop_rank_inc) / GNRC_NETIF_ETX_DIVISOR;
+}
+
+static uint16_t calc_rank(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    uint32_t add, rank;
+
+    if (base_rank == 0) {
+        if (parent == NULL) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+
+        base_rank = parent->rank;
+    }
+    if (base_rank == GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    if (parent != NULL) {
+        uint16_t etx = _link_etx(parent);
+
+        if (etx > GNRC_RPL_MRHOF_MAX_LINK_METRIC) {
+            DEBUG("RPL MRHOF: link to parent too lossy (ETX %u/%u)\n",
+                  etx, GNRC_NETIF_ETX_DIVISOR);
+            return GNRC_RPL_INFINITE_RANK;
+        }
+        add = _rank_inc(etx, parent->dodag->instance->min_hop_rank_inc);
+    }
+    else {
+        add = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    }
+
+    rank = base_rank + add;
+    if (rank >= GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    return (uint16_t)rank;
+}
+
+/* switches from the preferred parent p1 to p2 only if p2 is better by
+ * GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD */
+static gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *p1, gnrc_rpl_parent_t *p2)
+{
+    uint32_t rank1 = calc_rank(p1, 0);
+    uint32_t rank2 = calc_rank(p2, 0);
+
+    if (rank1 == GNRC_RPL_INFINITE_RANK) {
+        return p2;
+    }
+    if ((rank2 + _rank_inc(GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD,
+                           p1->dodag->instance->min_hop_rank_inc)) < rank1) {
+        return p2;
+    }
+    return p1;
+}
+
+static int parent_cmp(gnrc_rpl_parent_t *parent1, gnrc_rpl_parent_t *parent2)
+{
+    uint16_t rank1 = calc_rank(parent1, 0);
+    uint16_t rank2 = calc_rank(parent2, 0);
+
+    if (rank1 < rank2) {
+        return -1;
+    }
+    else if (rank1 > rank2) {
+        return 1;
+    }
+    return 0;
+}
+
+/* Not used yet */
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void) d2;
+    return d1;
+}
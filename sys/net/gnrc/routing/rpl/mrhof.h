@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl
+ * @{
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function.
+ *
+ * Header-file, which defines all functions for the implementation of MRHOF
+ * with the ETX of @ref net_gnrc_netif_etx as link metric.
+ */
+
+#ifndef MRHOF_H
+#define MRHOF_H
+
+#include "net/gnrc/rpl/structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Objective Code Point of MRHOF
+ */
+#define GNRC_RPL_MRHOF_OCP  (0x1)
+
+/**
+ * @brief   Return the address to the MRHOF objective function
+ *
+ * @return  Address of the MRHOF objective function
+ */
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MRHOF_H */
+/**
+ * @}
+ */
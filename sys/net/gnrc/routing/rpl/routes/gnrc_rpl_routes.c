@@ -0,0 +1,328 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "xtimer.h"
+#include "net/gnrc/rpl/routes.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+
+#define IID_LEN         (8U)    /**< length of the interface identifier */
+#define INFINITE        (UINT32_MAX)
+
+/**
+ * @brief   Downward route
+ *
+ * Routes are kept sorted by prefix index and interface identifier.
+ */
+typedef struct {
+    uint32_t expires;           /**< expiration time in seconds */
+    uint8_t iid[IID_LEN];       /**< interface identifier of the target */
+    uint8_t pfx;                /**< index into _pfxs */
+    uint8_t next_hop;           /**< index into _next_hops */
+} _route_t;
+
+/**
+ * @brief   /64 prefix shared by routes
+ */
+typedef struct {
+    uint8_t pfx[IPV6_ADDR_BIT_LEN / 8 - IID_LEN];   /**< the prefix */
+    uint16_t refs;              /**< number of routes, 0 if unused */
+} _pfx_t;
+
+/**
+ * @brief   Next hop shared by routes
+ */
+typedef struct {
+    ipv6_addr_t addr;           /**< address of the next hop */
+    uint16_t iface;             /**< interface to the next hop */
+    uint16_t refs;              /**< number of routes, 0 if unused */
+} _next_hop_t;
+
+static _route_t _routes[GNRC_RPL_ROUTES_NUMOF];
+static _pfx_t _pfxs[GNRC_RPL_ROUTES_PREFIX_NUMOF];
+static _next_hop_t _next_hops[GNRC_RPL_ROUTES_NEXT_HOP_NUMOF];
+static unsigned _routes_numof;
+static mutex_t _mutex = MUTEX_INIT;
+
+static inline uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+static inline bool _is_expired(const _route_t *route, uint32_t now)
+{
+    return (route->expires != INFINITE) &&
+           ((int32_t)(route->expires - now) <= 0);
+}
+
+static int _pfx_find(const ipv6_addr_t *addr)
+{
+    for (unsigned i = 0; i < GNRC_RPL_ROUTES_PREFIX_NUMOF; i++) {
+        if ((_pfxs[i].refs > 0) &&
+            (memcmp(_pfxs[i].pfx, addr->u8, sizeof(_pfxs[i].pfx)) == 0)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int _pfx_get(const ipv6_addr_t *addr)
+{
+    int res = _pfx_find(addr);
+
+    if (res < 0) {
+        for (unsigned i = 0; i < GNRC_RPL_ROUTES_PREFIX_NUMOF; i++) {
+            if (_pfxs[i].refs == 0) {
+                /* claimed only once a route references it */
+                memcpy(_pfxs[i].pfx, addr->u8, sizeof(_pfxs[i].pfx));
+                return i;
+            }
+        }
+    }
+    return res;
+}
+
+static int _next_hop_get(const ipv6_addr_t *addr, unsigned iface)
+{
+    int free = -1;
+
+    for (unsigned i = 0; i < GNRC_RPL_ROUTES_NEXT_HOP_NUMOF; i++) {
+        if (_next_hops[i].refs == 0) {
+            if (free < 0) {
+                free = i;
+            }
+        }
+        else if ((_next_hops[i].iface == iface) &&
+                 ipv6_addr_equal(&_next_hops[i].addr, addr)) {
+            return i;
+        }
+    }
+    if (free >= 0) {
+        memcpy(&_next_hops[free].addr, addr, sizeof(ipv6_addr_t));
+        _next_hops[free].iface = iface;
+    }
+    return free;
+}
+
+static inline int _cmp(const _route_t *route, uint8_t pfx, const uint8_t *iid)
+{
+    if (route->pfx != pfx) {
+        return (route->pfx < pfx) ? -1 : 1;
+    }
+    return memcmp(route->iid, iid, IID_LEN);
+}
+
+/* binary search, sets pos to the position of the route or the position it
+ * would have to be inserted at */
+static bool _search(uint8_t pfx, const uint8_t *iid, unsigned *pos)
+{
+    unsigned lo = 0, hi = _routes_numof;
+
+    while (lo < hi) {
+        unsigned mid = lo + ((hi - lo) / 2);
+        int cmp = _cmp(&_routes[mid], pfx, iid);
+
+        if (cmp == 0) {
+            *pos = mid;
+            return true;
+        }
+        else if (cmp < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    *pos = lo;
+    return false;
+}
+
+static void _remove(unsigned pos)
+{
+    assert(pos < _routes_numof);
+    _pfxs[_routes[pos].pfx].refs--;
+    _next_hops[_routes[pos].next_hop].refs--;
+    _routes_numof--;
+    memmove(&_routes[pos], &_routes[pos + 1],
+            (_routes_numof - pos) * sizeof(_route_t));
+}
+
+static void _remove_expired(uint32_t now)
+{
+    unsigned pos = 0;
+
+    while (pos < _routes_numof) {
+        if (_is_expired(&_routes[pos], now)) {
+            _remove(pos);
+        }
+        else {
+            pos++;
+        }
+    }
+}
+
+static void _route_to_fte(const _route_t *route, gnrc_ipv6_nib_ft_t *fte)
+{
+    const _next_hop_t *next_hop = &_next_hops[route->next_hop];
+
+    memcpy(fte->dst.u8, _pfxs[route->pfx].pfx, sizeof(_pfxs[0].pfx));
+    memcpy(&fte->dst.u8[sizeof(_pfxs[0].pfx)], route->iid, IID_LEN);
+    memcpy(&fte->next_hop, &next_hop->addr, sizeof(ipv6_addr_t));
+    fte->dst_len = IPV6_ADDR_BIT_LEN;
+    fte->primary = 0;
+    fte->iface = next_hop->iface;
+}
+
+int gnrc_rpl_routes_add(const ipv6_addr_t *dst, const ipv6_addr_t *next_hop,
+                        unsigned iface, uint32_t lifetime)
+{
+    const uint8_t *iid;
+    uint32_t now = _now();
+    unsigned pos;
+    int pfx, nh, res = 0;
+
+    if ((dst == NULL) || (next_hop == NULL) || (iface == 0) ||
+        ipv6_addr_is_multicast(dst) || ipv6_addr_is_unspecified(dst)) {
+        return -EINVAL;
+    }
+    iid = &dst->u8[sizeof(_pfxs[0].pfx)];
+    mutex_lock(&_mutex);
+    _remove_expired(now);
+    if (((pfx = _pfx_get(dst)) < 0) ||
+        ((nh = _next_hop_get(next_hop, iface)) < 0)) {
+        DEBUG("rpl_routes: no space left for %s\n",
+              ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+        res = -ENOMEM;
+        goto out;
+    }
+    if (_search(pfx, iid, &pos)) {
+        _next_hops[_routes[pos].next_hop].refs--;
+    }
+    else if (_routes_numof < GNRC_RPL_ROUTES_NUMOF) {
+        memmove(&_routes[pos + 1], &_routes[pos],
+                (_routes_numof - pos) * sizeof(_route_t));
+        _routes_numof++;
+        _routes[pos].pfx = pfx;
+        memcpy(_routes[pos].iid, iid, IID_LEN);
+        _pfxs[pfx].refs++;
+    }
+    else {
+        DEBUG("rpl_routes: route table full\n");
+        res = -ENOMEM;
+        goto out;
+    }
+    _routes[pos].next_hop = nh;
+    _routes[pos].expires = (lifetime == 0) ? INFINITE : (now + lifetime);
+    _next_hops[nh].refs++;
+out:
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+void gnrc_rpl_routes_del(const ipv6_addr_t *dst)
+{
+    unsigned pos;
+    int pfx;
+
+    assert(dst != NULL);
+    mutex_lock(&_mutex);
+    if (((pfx = _pfx_find(dst)) >= 0) &&
+        _search(pfx, &dst->u8[sizeof(_pfxs[0].pfx)], &pos)) {
+        _remove(pos);
+    }
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_rpl_routes_flush(unsigned iface)
+{
+    unsigned pos = 0;
+
+    mutex_lock(&_mutex);
+    while (pos < _routes_numof) {
+        if ((iface == 0) || (_next_hops[_routes[pos].next_hop].iface == iface)) {
+            _remove(pos);
+        }
+        else {
+            pos++;
+        }
+    }
+    mutex_unlock(&_mutex);
+}
+
+int gnrc_rpl_routes_get(const ipv6_addr_t *dst, gnrc_ipv6_nib_ft_t *fte)
+{
+    unsigned pos;
+    int pfx, res = -ENETUNREACH;
+
+    assert((dst != NULL) && (fte != NULL));
+    mutex_lock(&_mutex);
+    if (((pfx = _pfx_find(dst)) >= 0) &&
+        _search(pfx, &dst->u8[sizeof(_pfxs[0].pfx)], &pos)) {
+        if (_is_expired(&_routes[pos], _now())) {
+            _remove(pos);
+        }
+        else {
+            _route_to_fte(&_routes[pos], fte);
+            res = 0;
+        }
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+bool gnrc_rpl_routes_iter(unsigned iface, void **state,
+                          gnrc_ipv6_nib_ft_t *fte)
+{
+    uintptr_t pos = (uintptr_t)*state;
+    uint32_t now = _now();
+    bool res = false;
+
+    assert((state != NULL) && (fte != NULL));
+    mutex_lock(&_mutex);
+    for (; pos < _routes_numof; pos++) {
+        const _route_t *route = &_routes[pos];
+
+        if (!_is_expired(route, now) &&
+            ((iface == 0) || (_next_hops[route->next_hop].iface == iface))) {
+            _route_to_fte(route, fte);
+            *state = (void *)(pos + 1);
+            res = true;
+            break;
+        }
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+unsigned gnrc_rpl_routes_numof(void)
+{
+    unsigned res;
+
+    mutex_lock(&_mutex);
+    _remove_expired(_now());
+    res = _routes_numof;
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+/** @} */
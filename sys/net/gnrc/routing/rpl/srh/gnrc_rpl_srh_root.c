@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Source route computation for non-storing RPL roots
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "xtimer.h"
+#include "net/ipv6/ext/rh.h"
+#include "net/gnrc/rpl/srh.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+
+#define PARENT_ROOT     (0xff)      /**< parent is this node */
+#define PARENT_NONE     (0xfe)      /**< node is only known as parent */
+#define INFINITE        (UINT32_MAX)
+
+/**
+ * @brief   Node of the DAO parent graph
+ */
+typedef struct {
+    ipv6_addr_t addr;       /**< address of the node */
+    uint32_t expires;       /**< expiration time of the path in seconds */
+    uint8_t parent;         /**< index of the DAO parent */
+    uint8_t used;           /**< != 0, if the entry is in use */
+} _node_t;
+
+/**
+ * @brief   Cached source routing header
+ */
+typedef struct {
+    ipv6_addr_t dst;        /**< destination */
+    ipv6_addr_t first_hop;  /**< IPv6 destination to use */
+    uint32_t expires;       /**< first expiration of a node on the path */
+    unsigned gen;           /**< graph generation the header was built of */
+    uint16_t len;           /**< length of srh */
+    uint8_t srh[GNRC_RPL_SRH_ROOT_SRH_MAX]; /**< the header */
+} _cache_t;
+
+static _node_t _nodes[GNRC_RPL_SRH_ROOT_NODES_NUMOF];
+static _cache_t _cache[GNRC_RPL_SRH_ROOT_CACHE_NUMOF];
+static unsigned _cache_next;
+/* changed whenever a path changes, starts at one, so the zeroed cache is
+ * invalid */
+static unsigned _gen = 1;
+static mutex_t _mutex = MUTEX_INIT;
+
+static inline uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+static inline bool _is_expired(uint32_t expires, uint32_t now)
+{
+    return (expires != INFINITE) && ((int32_t)(expires - now) <= 0);
+}
+
+static int _node_find(const ipv6_addr_t *addr)
+{
+    for (unsigned i = 0; i < GNRC_RPL_SRH_ROOT_NODES_NUMOF; i++) {
+        if (_nodes[i].used && ipv6_addr_equal(&_nodes[i].addr, addr)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static bool _is_referenced(unsigned idx)
+{
+    for (unsigned i = 0; i < GNRC_RPL_SRH_ROOT_NODES_NUMOF; i++) {
+        if (_nodes[i].used && (_nodes[i].parent == idx)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* frees nodes that neither announced a path nor are the parent of one */
+static void _gc(uint32_t now)
+{
+    bool removed;
+
+    do {
+        removed = false;
+        for (unsigned i = 0; i < GNRC_RPL_SRH_ROOT_NODES_NUMOF; i++) {
+            _node_t *node = &_nodes[i];
+
+            if (!node->used) {
+                continue;
+            }
+            if ((node->parent != PARENT_NONE) &&
+                _is_expired(node->expires, now)) {
+                DEBUG("RPL SRH root: path to %s expired\n",
+                      ipv6_addr_to_str(addr_str, &node->addr,
+                                       sizeof(addr_str)));
+                node->parent = PARENT_NONE;
+                _gen++;
+            }
+            if ((node->parent == PARENT_NONE) && !_is_referenced(i)) {
+                node->used = 0;
+                removed = true;
+            }
+        }
+    } while (removed);
+}
+
+static int _node_get(const ipv6_addr_t *addr)
+{
+    int res = _node_find(addr);
+
+    if (res < 0) {
+        for (unsigned i = 0; i < GNRC_RPL_SRH_ROOT_NODES_NUMOF; i++) {
+            if (!_nodes[i].used) {
+                memcpy(&_nodes[i].addr, addr, sizeof(ipv6_addr_t));
+                _nodes[i].parent = PARENT_NONE;
+                _nodes[i].used = 1;
+                return i;
+            }
+        }
+    }
+    return res;
+}
+
+int gnrc_rpl_srh_root_update(const ipv6_addr_t *target,
+                             const ipv6_addr_t *parent, uint32_t lifetime)
+{
+    uint32_t now = _now();
+    int idx, parent_idx = PARENT_ROOT;
+    int res = 0;
+
+    assert(target != NULL);
+    mutex_lock(&_mutex);
+    _gc(now);
+    if (lifetime == 0) {
+        if (((idx = _node_find(target)) >= 0) &&
+            (_nodes[idx].parent != PARENT_NONE)) {
+            DEBUG("RPL SRH root: no path to %s\n",
+                  ipv6_addr_to_str(addr_str, target, sizeof(addr_str)));
+            _nodes[idx].parent = PARENT_NONE;
+            _gen++;
+            _gc(now);
+        }
+        goto out;
+    }
+    if ((idx = _node_get(target)) < 0) {
+        res = -ENOMEM;
+        goto out;
+    }
+    if ((parent != NULL) && ((parent_idx = _node_get(parent)) < 0)) {
+        if (_nodes[idx].parent == PARENT_NONE) {
+            /* release target again */
+            _gc(now);
+        }
+        res = -ENOMEM;
+        goto out;
+    }
+    if (_nodes[idx].parent != parent_idx) {
+        DEBUG("RPL SRH root: parent of %s changed\n",
+              ipv6_addr_to_str(addr_str, target, sizeof(addr_str)));
+        _nodes[idx].parent = parent_idx;
+        /* cached paths may go through the target */
+        _gen++;
+    }
+    _nodes[idx].expires = now + lifetime;
+    /* old parent may be unused now */
+    _gc(now);
+out:
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+void gnrc_rpl_srh_root_flush(void)
+{
+    mutex_lock(&_mutex);
+    memset(_nodes, 0, sizeof(_nodes));
+    _gen++;
+    mutex_unlock(&_mutex);
+}
+
+static unsigned _common_prefix(const ipv6_addr_t *a, const ipv6_addr_t *b)
+{
+    unsigned res = 0;
+
+    /* at most 15 octets can be elided */
+    while ((res < (sizeof(ipv6_addr_t) - 1)) && (a->u8[res] == b->u8[res])) {
+        res++;
+    }
+    return res;
+}
+
+/* builds the header from the graph, the path is collected from the
+ * destination upwards */
+static int _build(int idx, uint32_t now, _cache_t *entry)
+{
+    const ipv6_addr_t *path[GNRC_RPL_SRH_ROOT_HOPS_MAX];
+    gnrc_rpl_srh_t *rh = (gnrc_rpl_srh_t *)entry->srh;
+    uint8_t *addr_vec = (uint8_t *)(rh + 1);
+    unsigned hops = 0, cmpr_i = sizeof(ipv6_addr_t) - 1, cmpr_e;
+    size_t size;
+
+    entry->expires = INFINITE;
+    while (idx != PARENT_ROOT) {
+        if ((idx == PARENT_NONE) || _is_expired(_nodes[idx].expires, now)) {
+            return -ENETUNREACH;
+        }
+        if (hops >= GNRC_RPL_SRH_ROOT_HOPS_MAX) {
+            return -ELOOP;
+        }
+        if ((entry->expires == INFINITE) ||
+            ((int32_t)(_nodes[idx].expires - entry->expires) < 0)) {
+            entry->expires = _nodes[idx].expires;
+        }
+        path[hops++] = &_nodes[idx].addr;
+        idx = _nodes[idx].parent;
+    }
+    /* path[hops - 1] is the first hop, path[0] the destination */
+    memcpy(&entry->first_hop, path[hops - 1], sizeof(ipv6_addr_t));
+    if (hops == 1) {
+        entry->len = 0;
+        return 0;
+    }
+    cmpr_e = _common_prefix(path[hops - 1], path[0]);
+    for (unsigned i = 1; i < (hops - 1); i++) {
+        unsigned common = _common_prefix(path[hops - 1], path[i]);
+
+        if (common < cmpr_i) {
+            cmpr_i = common;
+        }
+        common = _common_prefix(path[i], path[0]);
+        if (common < cmpr_e) {
+            cmpr_e = common;
+        }
+    }
+    if (hops == 2) {
+        /* no intermediate address, CmprI is meaningless */
+        cmpr_i = cmpr_e;
+    }
+    size = ((hops - 2) * (sizeof(ipv6_addr_t) - cmpr_i)) +
+           (sizeof(ipv6_addr_t) - cmpr_e);
+    memset(rh, 0, sizeof(*rh));
+    rh->len = (size + 7) / 8;
+    rh->type = IPV6_EXT_RH_TYPE_RPL_SRH;
+    rh->seg_left = hops - 1;
+    rh->compr = (cmpr_i << 4) | cmpr_e;
+    rh->pad_resv = ((rh->len * 8) - size) << 4;
+    for (unsigned i = hops - 1; i > 1; i--) {
+        memcpy(addr_vec, &path[i - 1]->u8[cmpr_i],
+               sizeof(ipv6_addr_t) - cmpr_i);
+        addr_vec += sizeof(ipv6_addr_t) - cmpr_i;
+    }
+    memcpy(addr_vec, &path[0]->u8[cmpr_e], sizeof(ipv6_addr_t) - cmpr_e);
+    memset(addr_vec + (sizeof(ipv6_addr_t) - cmpr_e), 0,
+           (rh->len * 8) - size);
+    entry->len = sizeof(*rh) + (rh->len * 8);
+    return entry->len;
+}
+
+int gnrc_rpl_srh_root_get(const ipv6_addr_t *dst, ipv6_addr_t *first_hop,
+                          void *buf, size_t len)
+{
+    uint32_t now = _now();
+    _cache_t *entry = NULL;
+    int res, idx;
+
+    assert((dst != NULL) && (first_hop != NULL) && (buf != NULL));
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < GNRC_RPL_SRH_ROOT_CACHE_NUMOF; i++) {
+        if ((_cache[i].gen == _gen) && !_is_expired(_cache[i].expires, now) &&
+            ipv6_addr_equal(&_cache[i].dst, dst)) {
+            entry = &_cache[i];
+            break;
+        }
+    }
+    if (entry == NULL) {
+        if ((idx = _node_find(dst)) < 0) {
+            res = -ENETUNREACH;
+            goto out;
+        }
+        entry = &_cache[_cache_next];
+        entry->gen = 0;
+        if ((res = _build(idx, now, entry)) < 0) {
+            DEBUG("RPL SRH root: unable to build SRH to %s (%d)\n",
+                  ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)), res);
+            goto out;
+        }
+        DEBUG("RPL SRH root: built SRH of %u byte to %s\n",
+              (unsigned)entry->len,
+              ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+        memcpy(&entry->dst, dst, sizeof(ipv6_addr_t));
+        entry->gen = _gen;
+        _cache_next = (_cache_next + 1) % GNRC_RPL_SRH_ROOT_CACHE_NUMOF;
+    }
+    if (entry->len > len) {
+        res = -ENOBUFS;
+        goto out;
+    }
+    memcpy(first_hop, &entry->first_hop, sizeof(ipv6_addr_t));
+    memcpy(buf, entry->srh, entry->len);
+    res = entry->len;
+out:
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+/** @} */
@@ -15,11 +15,13 @@
 
 #include <errno.h>
 
+#include "irq.h"
 #include "net/af.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/netreg.h"
+#include "net/gnrc/pkttrace.h"
 #include "net/udp.h"
 #include "utlist.h"
 #include "xtimer.h"
@@ -44,10 +46,49 @@ static void _callback_put(void *arg)
 }
 #endif
 
+#ifdef MODULE_GNRC_SOCK_ASYNC
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        msg_t msg = { .type = GNRC_NETAPI_MSG_TYPE_RCV,
+                      .content = { .ptr = pkt } };
+        gnrc_sock_reg_t *reg = ctx;
+        gnrc_sock_reg_cb_t cb;
+        void *arg;
+        /* the callback is taken together with the message, so a callback
+         * set in between reports this message exactly once */
+        unsigned state = irq_disable();
+        int res = mbox_try_put(&reg->mbox, &msg);
+
+        cb = reg->async_cb.generic;
+        arg = reg->async_cb_arg;
+        irq_restore(state);
+        if (res < 1) {
+            gnrc_pktbuf_release(pkt);
+        }
+        else if (cb) {
+            cb(reg, SOCK_ASYNC_MSG_RECV, arg);
+        }
+    }
+    else {
+        gnrc_pktbuf_release(pkt);
+    }
+}
+#endif
+
 void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
 {
     mbox_init(&reg->mbox, reg->mbox_queue, SOCK_MBOX_SIZE);
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    /* the packets are put into the mbox by the callback, which notifies the
+     * sock right after */
+    reg->async_cb.generic = NULL;
+    reg->netreg_cb.cb = _netapi_cb;
+    reg->netreg_cb.ctx = reg;
+    gnrc_netreg_entry_init_cb(&reg->entry, demux_ctx, &reg->netreg_cb);
+#else
     gnrc_netreg_entry_init_mbox(&reg->entry, demux_ctx, &reg->mbox);
+#endif
     gnrc_netreg_register(type, &reg->entry);
 }
 
@@ -83,6 +124,7 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
     switch (msg.type) {
         case GNRC_NETAPI_MSG_TYPE_RCV:
             pkt = msg.content.ptr;
+            gnrc_pkttrace(pkt, GNRC_PKTTRACE_RX_SOCK);
             break;
 #ifdef MODULE_XTIMER
         case _TIMEOUT_MSG_TYPE:
@@ -125,6 +167,11 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
         gnrc_pktbuf_release(payload);
         return -EAFNOSUPPORT;
     }
+#ifdef MODULE_GNRC_PKTTRACE
+    /* stamp the snip surviving header compression: the tail */
+    for (pkt = payload; pkt->next != NULL; pkt = pkt->next) {}
+    gnrc_pkttrace_start(pkt, GNRC_PKTTRACE_TX_SOCK, xtimer_now_usec());
+#endif
     switch (local->family) {
 #ifdef SOCK_HAS_IPV6
         case AF_INET6: {
@@ -159,6 +206,22 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
         /* TODO: use API in #5511 */
         iface = (kernel_pid_t)remote->netif;
     }
+#ifdef MODULE_GNRC_NETIF_PKTQ
+    {
+        /* back off instead of having the interface drop the packet */
+        gnrc_netif_t *netif = (iface != KERNEL_PID_UNDEF) ?
+                              gnrc_netif_get_by_pid(iface) :
+                              ((gnrc_netif_numof() == 1) ?
+                               gnrc_netif_iter(NULL) : NULL);
+
+        if ((netif != NULL) &&
+            gnrc_netif_pktq_full(&netif->send_queue,
+                                 gnrc_netif_pktq_ipv6_prio(pkt->data))) {
+            gnrc_pktbuf_release(pkt);
+            return -EAGAIN;
+        }
+    }
+#endif
     if (iface != KERNEL_PID_UNDEF) {
         gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
         gnrc_netif_hdr_t *netif_hdr;
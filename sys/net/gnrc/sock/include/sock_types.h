@@ -40,18 +40,53 @@ extern "C" {
 #define SOCK_MBOX_SIZE      (8)         /**< Size for gnrc_sock_reg_t::mbox_queue */
 #endif
 
+/**
+ * @brief   Type for the sock @ref net_gnrc_netreg info
+ * @internal
+ */
+typedef struct gnrc_sock_reg gnrc_sock_reg_t;
+
+#ifdef MODULE_GNRC_SOCK_ASYNC
+/**
+ * @brief   Callback for the readiness notifications of a sock
+ * @internal
+ */
+typedef void (*gnrc_sock_reg_cb_t)(gnrc_sock_reg_t *sock,
+                                   sock_async_flags_t flags, void *arg);
+#endif
+
 /**
  * @brief   sock @ref net_gnrc_netreg info
  * @internal
  */
-typedef struct gnrc_sock_reg {
+struct gnrc_sock_reg {
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
     struct gnrc_sock_reg *next;         /**< list-like for internal storage */
 #endif
     gnrc_netreg_entry_t entry;          /**< @ref net_gnrc_netreg entry for mbox */
     mbox_t mbox;                        /**< @ref core_mbox target for the sock */
     msg_t mbox_queue[SOCK_MBOX_SIZE];   /**< queue for gnrc_sock_reg_t::mbox */
-} gnrc_sock_reg_t;
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    /**
+     * @brief   netreg callback putting the packets into
+     *          gnrc_sock_reg_t::mbox
+     */
+    gnrc_netreg_entry_cbd_t netreg_cb;
+    /**
+     * @brief   readiness callback of the sock
+     */
+    union {
+        gnrc_sock_reg_cb_t generic;     /**< generic version */
+#ifdef MODULE_SOCK_IP
+        sock_ip_cb_t ip;                /**< IP version */
+#endif
+#ifdef MODULE_SOCK_UDP
+        sock_udp_cb_t udp;              /**< UDP version */
+#endif
+    } async_cb;
+    void *async_cb_arg;                 /**< argument of gnrc_sock_reg_t::async_cb */
+#endif
+};
 
 /**
  * @brief   Raw IP sock type
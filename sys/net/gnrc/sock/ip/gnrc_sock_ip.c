@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include "byteorder.h"
+#include "irq.h"
 #include "net/af.h"
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
@@ -66,6 +67,24 @@ void sock_ip_close(sock_ip_t *sock)
     gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, &sock->reg.entry);
 }
 
+#ifdef MODULE_SOCK_ASYNC
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *arg)
+{
+    unsigned state, pending;
+
+    assert(sock != NULL);
+    state = irq_disable();
+    pending = cib_avail(&sock->reg.mbox.cib);
+    sock->reg.async_cb_arg = arg;
+    sock->reg.async_cb.ip = cb;
+    irq_restore(state);
+    /* report the messages that were received before */
+    while (cb && pending--) {
+        cb(sock, SOCK_ASYNC_MSG_RECV, arg);
+    }
+}
+#endif
+
 int sock_ip_get_local(sock_ip_t *sock, sock_ip_ep_t *local)
 {
     assert(sock && local);
@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include "byteorder.h"
+#include "irq.h"
 #include "net/af.h"
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
@@ -155,6 +156,24 @@ void sock_udp_close(sock_udp_t *sock)
 #endif
 }
 
+#ifdef MODULE_SOCK_ASYNC
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *arg)
+{
+    unsigned state, pending;
+
+    assert(sock != NULL);
+    state = irq_disable();
+    pending = cib_avail(&sock->reg.mbox.cib);
+    sock->reg.async_cb_arg = arg;
+    sock->reg.async_cb.udp = cb;
+    irq_restore(state);
+    /* report the messages that were received before */
+    while (cb && pending--) {
+        cb(sock, SOCK_ASYNC_MSG_RECV, arg);
+    }
+}
+#endif
+
 int sock_udp_get_local(sock_udp_t *sock, sock_udp_ep_t *local)
 {
     assert(sock && local);
@@ -177,13 +196,41 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
 
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote)
+{
+    void *pkt = NULL, *ptr;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = sock_udp_recv_buf(sock, &ptr, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    if ((size_t)res > max_len) {
+        res = -ENOBUFS;
+    }
+    else {
+        memcpy(data, ptr, res);
+    }
+    /* release packet */
+    sock_udp_recv_buf(sock, &ptr, &pkt, 0, NULL);
+    return res;
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        *data = NULL;
+        gnrc_pktbuf_release(*buf_ctx);
+        *buf_ctx = NULL;
+        return 0;
+    }
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -192,10 +239,6 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
@@ -214,14 +257,66 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
-    memcpy(data, pkt->data, pkt->size);
-    res = (int)pkt->size;
-    gnrc_pktbuf_release(pkt);
-    return res;
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return (ssize_t)pkt->size;
+}
+
+ssize_t sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                            size_t count, uint32_t timeout)
+{
+    size_t i;
+
+    assert((msgs != NULL) && (count > 0));
+    for (i = 0; i < count; i++) {
+        /* only wait for the first message */
+        ssize_t res = sock_udp_recv(sock, msgs[i].data, msgs[i].len,
+                                    (i == 0) ? timeout : 0, msgs[i].remote);
+        if (res < 0) {
+            if (i == 0) {
+                return res;
+            }
+            break;
+        }
+        msgs[i].len = res;
+    }
+    return i;
 }
 
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote)
+{
+    iolist_t snip = {
+        .iol_next = NULL,
+        .iol_base = (void *)data,
+        .iol_len = len,
+    };
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+    return sock_udp_sendv(sock, &snip, remote);
+}
+
+ssize_t sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                            size_t count)
+{
+    size_t i;
+
+    assert((msgs != NULL) && (count > 0));
+    for (i = 0; i < count; i++) {
+        ssize_t res = sock_udp_send(sock, msgs[i].data, msgs[i].len,
+                                    msgs[i].remote);
+        if (res < 0) {
+            if (i == 0) {
+                return res;
+            }
+            break;
+        }
+    }
+    return i;
+}
+
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
 {
     int res;
     gnrc_pktsnip_t *payload, *pkt;
@@ -231,7 +326,6 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     sock_ip_ep_t *rem;
 
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     if (remote != NULL) {
         if (remote->port == 0) {
@@ -304,10 +398,15 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         return -EINVAL;
     }
     /* generate payload and header snips */
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    payload = gnrc_pktbuf_add(NULL, NULL, iolist_size(snips), GNRC_NETTYPE_UNDEF);
     if (payload == NULL) {
         return -ENOMEM;
     }
+    uint8_t *pos = payload->data;
+    for (const iolist_t *snip = snips; snip != NULL; snip = snip->iol_next) {
+        memcpy(pos, snip->iol_base, snip->iol_len);
+        pos += snip->iol_len;
+    }
     pkt = gnrc_udp_hdr_build(payload, src_port, dst_port);
     if (pkt == NULL) {
         gnrc_pktbuf_release(payload);
@@ -107,6 +107,7 @@ static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtime
  * @param[in]     local_addr    Local address to bind on, if this is a passive connection.
  * @param[in]     local_port    Local port to bind on, if this is a passive connection.
  * @param[in]     passive       Flag to indicate if this is a active or passive open.
+ * @param[in]     async         Return right after the opening was started.
  *
  * @returns   Zero on success.
  *            -EISCONN if TCB is already connected.
@@ -116,7 +117,8 @@ static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtime
  *            -ECONNREFUSED if the connection was resetted by the peer.
  */
 static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, char *target_addr, uint16_t target_port,
-                          const char *local_addr, uint16_t local_port, uint8_t passive)
+                          const char *local_addr, uint16_t local_port, uint8_t passive,
+                          bool async)
 {
     msg_t msg;
     xtimer_t connection_timeout;
@@ -151,6 +153,8 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, char *target_addr, uint16_t targe
         else if (tcb->address_family == AF_INET6) {
             if (ipv6_addr_from_str((ipv6_addr_t *) tcb->local_addr,  local_addr) == NULL) {
                 DEBUG("gnrc_tcp.c : _gnrc_tcp_open() : Invalid peer addr\n");
+                tcb->status &= ~STATUS_WAIT_FOR_MSG;
+                mutex_unlock(&(tcb->function_lock));
                 return -EINVAL;
             }
         }
@@ -171,6 +175,8 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, char *target_addr, uint16_t targe
             int ll_iface = ipv6_addr_split_iface(target_addr);
             if (ipv6_addr_from_str((ipv6_addr_t *) tcb->peer_addr, target_addr) == NULL) {
                 DEBUG("gnrc_tcp.c : _gnrc_tcp_open() : Invalid peer addr\n");
+                tcb->status &= ~STATUS_WAIT_FOR_MSG;
+                mutex_unlock(&(tcb->function_lock));
                 return -EINVAL;
             }
 
@@ -185,8 +191,10 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, char *target_addr, uint16_t targe
         tcb->peer_port = target_port;
 
         /* Setup connection timeout: Put timeout message in TCBs mbox on expiration */
-        _setup_timeout(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
-                       _cb_mbox_put_msg, &connection_timeout_arg);
+        if (!async) {
+            _setup_timeout(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
+                           _cb_mbox_put_msg, &connection_timeout_arg);
+        }
     }
 
     /* Call FSM with event: CALL_OPEN */
@@ -198,6 +206,13 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, char *target_addr, uint16_t targe
         DEBUG("gnrc_tcp.c : _gnrc_tcp_open() : local_port is already in use.\n");
     }
 
+    /* Events report the outcome of asynchronous calls */
+    if (async) {
+        tcb->status &= ~STATUS_WAIT_FOR_MSG;
+        mutex_unlock(&(tcb->function_lock));
+        return ret;
+    }
+
     /* Wait until a connection was established or closed */
     while (ret >= 0 && tcb->state != FSM_STATE_CLOSED && tcb->state != FSM_STATE_ESTABLISHED &&
            tcb->state != FSM_STATE_CLOSE_WAIT) {
@@ -260,14 +275,51 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     tcb->rtt_var = RTO_UNINITIALIZED;
     tcb->srtt = RTO_UNINITIALIZED;
     tcb->rto = RTO_UNINITIALIZED;
+    tcb->cc = &gnrc_tcp_cc_newreno;
     mbox_init(&(tcb->mbox), tcb->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
     mutex_init(&(tcb->fsm_lock));
     mutex_init(&(tcb->function_lock));
 }
 
-int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
-                         char *target_addr, uint16_t target_port,
-                         uint16_t local_port)
+int gnrc_tcp_tcb_set_rcv_buf(gnrc_tcp_tcb_t *tcb, void *buf, size_t size)
+{
+    assert(tcb != NULL);
+    assert((buf != NULL) || (size == 0));
+
+    mutex_lock(&(tcb->function_lock));
+    if (tcb->state != FSM_STATE_CLOSED) {
+        mutex_unlock(&(tcb->function_lock));
+        return -EISCONN;
+    }
+    tcb->rcv_buf_user = buf;
+    tcb->rcv_buf_user_size = size;
+    mutex_unlock(&(tcb->function_lock));
+    return 0;
+}
+
+int gnrc_tcp_tcb_set_cc(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_cc_t *cc)
+{
+    assert(tcb != NULL);
+    assert(cc != NULL);
+
+    mutex_lock(&(tcb->function_lock));
+    if (tcb->state != FSM_STATE_CLOSED) {
+        mutex_unlock(&(tcb->function_lock));
+        return -EISCONN;
+    }
+    tcb->cc = cc;
+    mutex_unlock(&(tcb->function_lock));
+    return 0;
+}
+
+/**
+ * @brief   Checks the arguments of an active open and starts it
+ *
+ * @see gnrc_tcp_open_active()
+ */
+static int _open_active(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
+                        char *target_addr, uint16_t target_port,
+                        uint16_t local_port, bool async)
 {
     assert(tcb != NULL);
     assert(target_addr != NULL);
@@ -287,11 +339,16 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
         return -EINVAL;
     }
     /* Proceed with connection opening */
-    return _gnrc_tcp_open(tcb, target_addr, target_port, NULL, local_port, 0);
+    return _gnrc_tcp_open(tcb, target_addr, target_port, NULL, local_port, 0, async);
 }
 
-int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
-                          const char *local_addr, uint16_t local_port)
+/**
+ * @brief   Checks the arguments of a passive open and starts it
+ *
+ * @see gnrc_tcp_open_passive()
+ */
+static int _open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
+                         const char *local_addr, uint16_t local_port, bool async)
 {
     assert(tcb != NULL);
     assert(local_port != PORT_UNSPEC);
@@ -311,7 +368,20 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
         }
     }
     /* Proceed with connection opening */
-    return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1);
+    return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1, async);
+}
+
+int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
+                         char *target_addr, uint16_t target_port,
+                         uint16_t local_port)
+{
+    return _open_active(tcb, address_family, target_addr, target_port, local_port, false);
+}
+
+int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
+                          const char *local_addr, uint16_t local_port)
+{
+    return _open_passive(tcb, address_family, local_addr, local_port, false);
 }
 
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
@@ -357,7 +427,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     }
 
     /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent and there is room to send more */
+    while (ret == 0 || tcb->pkt_retransmit_num >= GNRC_TCP_SND_QUEUE_SIZE) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -599,6 +670,84 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
     mutex_unlock(&(tcb->function_lock));
 }
 
+#ifdef MODULE_GNRC_TCP_ASYNC
+int gnrc_tcp_async_open_active(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
+                               char *target_addr, uint16_t target_port,
+                               uint16_t local_port)
+{
+    assert(tcb != NULL);
+    assert(tcb->async_cb != NULL);
+
+    return _open_active(tcb, address_family, target_addr, target_port, local_port, true);
+}
+
+int gnrc_tcp_async_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
+                                const char *local_addr, uint16_t local_port)
+{
+    assert(tcb != NULL);
+    assert(tcb->async_cb != NULL);
+
+    return _open_passive(tcb, address_family, local_addr, local_port, true);
+}
+
+ssize_t gnrc_tcp_async_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len)
+{
+    assert(tcb != NULL);
+    assert(data != NULL);
+
+    ssize_t ret = 0;
+
+    /* Lock the TCB for this function call */
+    mutex_lock(&(tcb->function_lock));
+
+    /* Check if connection is in a valid state */
+    if (tcb->state != FSM_STATE_ESTABLISHED && tcb->state != FSM_STATE_CLOSE_WAIT) {
+        mutex_unlock(&(tcb->function_lock));
+        return -ENOTCONN;
+    }
+
+    /* Send what window and retransmission queue allow, GNRC_TCP_ASYNC_WRITABLE
+     * follows if that was not everything */
+    ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+    if (ret == 0 && len > 0) {
+        ret = -EAGAIN;
+    }
+    mutex_unlock(&(tcb->function_lock));
+    return ret;
+}
+
+void gnrc_tcp_async_close(gnrc_tcp_tcb_t *tcb)
+{
+    assert(tcb != NULL);
+
+    /* Lock the TCB for this function call */
+    mutex_lock(&(tcb->function_lock));
+    if (tcb->state != FSM_STATE_CLOSED) {
+        /* Start connection teardown sequence, GNRC_TCP_ASYNC_CLOSED follows */
+        _fsm(tcb, FSM_EVENT_CALL_CLOSE, NULL, NULL, 0);
+    }
+    mutex_unlock(&(tcb->function_lock));
+}
+#endif
+
+void gnrc_tcp_get_stats(gnrc_tcp_tcb_t *tcb, gnrc_tcp_stats_t *stats)
+{
+    assert(tcb != NULL);
+    assert(stats != NULL);
+
+    /* Only the FSM lock: a blocking call might hold the function lock */
+    mutex_lock(&(tcb->fsm_lock));
+    *stats = tcb->stats;
+    stats->srtt = (tcb->srtt == RTO_UNINITIALIZED) ? 0 : tcb->srtt;
+    stats->rtt_var = (tcb->rtt_var == RTO_UNINITIALIZED) ? 0 : tcb->rtt_var;
+    stats->rto = (tcb->rto == RTO_UNINITIALIZED) ? 0 : tcb->rto;
+    stats->cwnd = tcb->cwnd;
+    stats->ssthresh = tcb->ssthresh;
+    stats->snd_wnd = tcb->snd_wnd;
+    stats->flight_size = tcb->snd_nxt - tcb->snd_una;
+    mutex_unlock(&(tcb->fsm_lock));
+}
+
 int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr)
 {
     uint16_t csum;
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/async.h
+ * @}
+ */
+#include <assert.h>
+#include "kernel_defines.h"
+#include "net/gnrc/tcp.h"
+#include "internal/common.h"
+#include "internal/async.h"
+#include "internal/cc.h"
+#include "internal/fsm.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief Event handler, passes pending events to the callback of a TCB.
+ *
+ * @param[in] event   async_event of the TCB.
+ */
+static void _async_handler(event_t *event)
+{
+    gnrc_tcp_tcb_t *tcb = container_of(event, gnrc_tcp_tcb_t, async_event);
+    unsigned events;
+
+    /* Fetch events under lock, but call back without: the callback is
+     * expected to call into the API again */
+    mutex_lock(&(tcb->fsm_lock));
+    events = tcb->async_events;
+    tcb->async_events = 0;
+    mutex_unlock(&(tcb->fsm_lock));
+
+    if ((events != 0) && (tcb->async_cb != NULL)) {
+        tcb->async_cb(tcb, events, tcb->async_arg);
+    }
+}
+
+/**
+ * @brief (Re)starts the asynchronous timer.
+ *
+ * @param[in,out] tcb        TCB holding the connection information.
+ * @param[in]     type       Message type to send to the TCP thread on expiration.
+ * @param[in]     duration   Duration in microseconds.
+ */
+static void _async_set_timer(gnrc_tcp_tcb_t *tcb, uint16_t type, uint32_t duration)
+{
+    tcb->async_msg.type = type;
+    tcb->async_msg.content.ptr = (void *) tcb;
+    xtimer_set_msg(&(tcb->async_tim), duration, &(tcb->async_msg), gnrc_tcp_pid);
+    tcb->async_status |= ASYNC_TIMER_ARMED;
+}
+
+void gnrc_tcp_async_init(gnrc_tcp_tcb_t *tcb, event_queue_t *queue,
+                         gnrc_tcp_async_cb_t cb, void *arg)
+{
+    assert(tcb != NULL);
+    assert(queue != NULL);
+    assert(cb != NULL);
+
+    mutex_lock(&(tcb->fsm_lock));
+    tcb->async_event.handler = _async_handler;
+    tcb->async_queue = queue;
+    tcb->async_cb = cb;
+    tcb->async_arg = arg;
+    tcb->async_events = 0;
+    tcb->async_status = 0;
+    mutex_unlock(&(tcb->fsm_lock));
+}
+
+void _async_check_writable(gnrc_tcp_tcb_t *tcb)
+{
+    if ((tcb->async_status & ASYNC_WANT_WRITE) &&
+        (tcb->pkt_retransmit_num < GNRC_TCP_SND_QUEUE_SIZE) &&
+        (_cc_usable_window(tcb) > 0)) {
+        tcb->async_status &= ~ASYNC_WANT_WRITE;
+        _async_event(tcb, GNRC_TCP_ASYNC_WRITABLE);
+    }
+}
+
+void _async_post(gnrc_tcp_tcb_t *tcb)
+{
+    bool pending = false;
+    bool probe = false;
+
+    if (tcb->async_cb == NULL) {
+        return;
+    }
+
+    if (tcb->async_events != 0) {
+        event_post(tcb->async_queue, &(tcb->async_event));
+    }
+
+    /* Connections that wait for the peer time out without progress, as they
+     * would in the blocking calls */
+    switch (tcb->state) {
+        case FSM_STATE_CLOSED:
+        case FSM_STATE_LISTEN:
+        case FSM_STATE_TIME_WAIT:
+            break;
+
+        case FSM_STATE_SYN_SENT:
+        case FSM_STATE_SYN_RCVD:
+        case FSM_STATE_FIN_WAIT_2:
+            pending = true;
+            break;
+
+        default:
+            pending = (tcb->pkt_retransmit_num > 0);
+            /* Probe a closed send window while the user waits for it */
+            probe = !pending && (tcb->snd_wnd == 0) &&
+                    (tcb->async_status & ASYNC_WANT_WRITE);
+            break;
+    }
+
+    if (pending) {
+        if ((tcb->status & STATUS_NOTIFY_USER) || !(tcb->async_status & ASYNC_TIMER_ARMED) ||
+            (tcb->async_msg.type != MSG_TYPE_CONNECTION_TIMEOUT)) {
+            _async_set_timer(tcb, MSG_TYPE_CONNECTION_TIMEOUT,
+                             GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+        }
+    }
+    else if (probe) {
+        if (!(tcb->async_status & ASYNC_TIMER_ARMED) ||
+            (tcb->async_msg.type != MSG_TYPE_PROBE_TIMEOUT)) {
+            uint32_t duration = tcb->rto;
+
+            /* Boundry check for time interval between probes */
+            if (duration < GNRC_TCP_PROBE_LOWER_BOUND) {
+                duration = GNRC_TCP_PROBE_LOWER_BOUND;
+            }
+            else if (duration > GNRC_TCP_PROBE_UPPER_BOUND) {
+                duration = GNRC_TCP_PROBE_UPPER_BOUND;
+            }
+            _async_set_timer(tcb, MSG_TYPE_PROBE_TIMEOUT, duration);
+        }
+    }
+    else if (tcb->async_status & ASYNC_TIMER_ARMED) {
+        xtimer_remove(&(tcb->async_tim));
+        tcb->async_status &= ~ASYNC_TIMER_ARMED;
+    }
+}
+
+void _async_timeout(gnrc_tcp_tcb_t *tcb, uint16_t type)
+{
+    mutex_lock(&(tcb->fsm_lock));
+    tcb->async_status &= ~ASYNC_TIMER_ARMED;
+    mutex_unlock(&(tcb->fsm_lock));
+
+    if (type == MSG_TYPE_PROBE_TIMEOUT) {
+        DEBUG("gnrc_tcp_async.c : _async_timeout() : PROBE_TIMEOUT\n");
+        _fsm(tcb, FSM_EVENT_SEND_PROBE, NULL, NULL, 0);
+    }
+    else {
+        DEBUG("gnrc_tcp_async.c : _async_timeout() : CONNECTION_TIMEOUT\n");
+        _fsm(tcb, FSM_EVENT_TIMEOUT_CONNECTION, NULL, NULL, 0);
+    }
+}
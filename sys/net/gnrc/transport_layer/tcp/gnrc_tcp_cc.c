@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/cc.h and NewReno congestion control
+ * @}
+ */
+#include "net/gnrc/tcp/cc.h"
+#include "internal/common.h"
+#include "internal/cc.h"
+#include "internal/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief Size of the largest segment this side sends.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Sender maximum segment size in bytes.
+ */
+static inline uint32_t _smss(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->mss < GNRC_TCP_MSS) ? tcb->mss : GNRC_TCP_MSS;
+}
+
+/**
+ * @brief Number of bytes sent, but not acknowledged yet.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Flight size in bytes.
+ */
+static inline uint32_t _flight_size(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->snd_nxt - tcb->snd_una;
+}
+
+/**
+ * @brief Slow start threshold after congestion was detected (see RFC 5681, eq. 4).
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Half the flight size, but at least two segments.
+ */
+static inline uint32_t _newreno_ssthresh(const gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t half = _flight_size(tcb) / 2;
+
+    return (half > (2 * _smss(tcb))) ? half : (2 * _smss(tcb));
+}
+
+static void _newreno_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    /* Initial window (see RFC 5681, section 3.1) */
+    if (smss > 2190) {
+        tcb->cwnd = 2 * smss;
+    }
+    else if (smss > 1095) {
+        tcb->cwnd = 3 * smss;
+    }
+    else {
+        tcb->cwnd = 4 * smss;
+    }
+    tcb->ssthresh = UINT32_MAX;
+}
+
+static void _newreno_event(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cc_event_t event, uint32_t acked)
+{
+    uint32_t smss = _smss(tcb);
+    uint32_t inc = 0;
+
+    switch (event) {
+        case GNRC_TCP_CC_EVENT_ACK:
+            /* Slow start or congestion avoidance */
+            if (tcb->cwnd < tcb->ssthresh) {
+                inc = (acked < smss) ? acked : smss;
+            }
+            else {
+                inc = (smss * smss) / tcb->cwnd;
+                inc = (inc > 0) ? inc : 1;
+            }
+            tcb->cwnd = (tcb->cwnd < (UINT32_MAX - inc)) ? (tcb->cwnd + inc) : UINT32_MAX;
+            break;
+
+        case GNRC_TCP_CC_EVENT_RECOVERY_START:
+            tcb->ssthresh = _newreno_ssthresh(tcb);
+            tcb->cwnd = tcb->ssthresh + (GNRC_TCP_DUP_ACK_THRESHOLD * smss);
+            break;
+
+        case GNRC_TCP_CC_EVENT_DUP_ACK:
+            /* Inflate window by the segment that left the network */
+            tcb->cwnd += smss;
+            break;
+
+        case GNRC_TCP_CC_EVENT_PARTIAL_ACK:
+            /* Deflate window by the acknowledged data (see RFC 6582, section 3.2) */
+            tcb->cwnd = (tcb->cwnd > acked) ? (tcb->cwnd - acked) : 0;
+            if (acked >= smss) {
+                tcb->cwnd += smss;
+            }
+            if (tcb->cwnd < smss) {
+                tcb->cwnd = smss;
+            }
+            break;
+
+        case GNRC_TCP_CC_EVENT_RECOVERY_END:
+            inc = (_flight_size(tcb) > smss) ? _flight_size(tcb) : smss;
+            tcb->cwnd = (tcb->ssthresh < (inc + smss)) ? tcb->ssthresh : (inc + smss);
+            break;
+
+        case GNRC_TCP_CC_EVENT_TIMEOUT:
+            /* Loss window of one segment */
+            tcb->ssthresh = _newreno_ssthresh(tcb);
+            tcb->cwnd = smss;
+            break;
+    }
+}
+
+const gnrc_tcp_cc_t gnrc_tcp_cc_newreno = {
+    .init = _newreno_init,
+    .event = _newreno_event,
+};
+
+void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    tcb->dup_acks = 0;
+    tcb->recover = tcb->iss;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+    tcb->cc->init(tcb);
+}
+
+void _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked)
+{
+    tcb->dup_acks = 0;
+
+    if (!(tcb->status & STATUS_FAST_RECOVERY)) {
+        tcb->cc->event(tcb, GNRC_TCP_CC_EVENT_ACK, acked);
+    }
+    /* Partial ACK: the next segment was lost as well, retransmit it */
+    else if (LSS_32_BIT(tcb->snd_una, tcb->recover)) {
+        DEBUG("gnrc_tcp_cc.c : _cc_ack() : Partial ACK, retransmit\n");
+        tcb->cc->event(tcb, GNRC_TCP_CC_EVENT_PARTIAL_ACK, acked);
+        _pkt_resend(tcb);
+    }
+    else {
+        DEBUG("gnrc_tcp_cc.c : _cc_ack() : Fast recovery complete\n");
+        tcb->status &= ~STATUS_FAST_RECOVERY;
+        tcb->cc->event(tcb, GNRC_TCP_CC_EVENT_RECOVERY_END, acked);
+    }
+}
+
+void _cc_dup_ack(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        tcb->cc->event(tcb, GNRC_TCP_CC_EVENT_DUP_ACK, 0);
+        return;
+    }
+    if (++tcb->dup_acks < GNRC_TCP_DUP_ACK_THRESHOLD) {
+        return;
+    }
+    tcb->dup_acks = 0;
+
+    /* Don't start over for losses of data sent before the last recovery
+     * (see RFC 6582, section 3.2, step 2) */
+    if (!GRT_32_BIT(tcb->snd_una, tcb->recover)) {
+        return;
+    }
+    DEBUG("gnrc_tcp_cc.c : _cc_dup_ack() : Fast retransmit\n");
+    tcb->recover = tcb->snd_nxt;
+    tcb->status |= STATUS_FAST_RECOVERY;
+    tcb->stats.fast_retransmits++;
+    tcb->cc->event(tcb, GNRC_TCP_CC_EVENT_RECOVERY_START, 0);
+    _pkt_resend(tcb);
+}
+
+void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    tcb->dup_acks = 0;
+    tcb->recover = tcb->snd_nxt;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+    tcb->stats.timeouts++;
+    tcb->cc->event(tcb, GNRC_TCP_CC_EVENT_TIMEOUT, 0);
+}
+
+uint32_t _cc_usable_window(const gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t wnd = (tcb->snd_wnd < tcb->cwnd) ? tcb->snd_wnd : tcb->cwnd;
+
+    return (wnd > _flight_size(tcb)) ? (wnd - _flight_size(tcb)) : 0;
+}
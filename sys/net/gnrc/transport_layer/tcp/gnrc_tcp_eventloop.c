@@ -23,6 +23,7 @@
 #include "net/tcp.h"
 #include "net/gnrc.h"
 #include "internal/common.h"
+#include "internal/async.h"
 #include "internal/pkt.h"
 #include "internal/fsm.h"
 #include "internal/eventloop.h"
@@ -107,6 +108,7 @@ static int _receive(gnrc_pktsnip_t *pkt)
     gnrc_pktsnip_t *ip = NULL;
     gnrc_pktsnip_t *reset = NULL;
     gnrc_tcp_tcb_t *tcb = NULL;
+    gnrc_tcp_tcb_t *listener = NULL;
     tcp_hdr_t *hdr;
 
     /* Get write access to the TCP header */
@@ -165,7 +167,8 @@ static int _receive(gnrc_pktsnip_t *pkt)
     }
 
     /* Validate checksum */
-    if (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt)) {
+    if (!gnrc_netif_csum_offload_rx(pkt, NETOPT_CSUM_OFFLOAD_TCP) &&
+        (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt))) {
         DEBUG("gnrc_tcp_eventloop.c : _receive() : Invalid checksum\n");
         gnrc_pktbuf_release(pkt);
         return -EINVAL;
@@ -180,17 +183,20 @@ static int _receive(gnrc_pktsnip_t *pkt)
         if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
             /* If SYN is set, a connection is listening on that port ... */
             ipv6_addr_t *tmp_addr = NULL;
-            if (syn && tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
+            if (syn && listener == NULL && tcb->local_port == dst &&
+                tcb->state == FSM_STATE_LISTEN) {
                 /* ... and local addr is unspec or pre configured */
                 tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
                 if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
                     ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                    break;
+                    /* A retransmitted SYN must still reach the connection
+                     * it already created, keep searching */
+                    listener = tcb;
                 }
             }
 
-            /* If SYN is not set and the ports match ... */
-            if (!syn && tcb->local_port == dst && tcb->peer_port == src) {
+            /* If the ports match ... */
+            if (tcb->local_port == dst && tcb->peer_port == src) {
                 /* .. and the IPv6 addresses match */
                 tmp_addr = &((ipv6_hdr_t * )ip->data)->src;
                 if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) tmp_addr)) {
@@ -206,6 +212,9 @@ static int _receive(gnrc_pktsnip_t *pkt)
 #endif
         tcb = tcb->next;
     }
+    if (tcb == NULL) {
+        tcb = listener;
+    }
     mutex_unlock(&_list_tcb_lock);
 
     /* Call FSM with event RCVD_PKT if a fitting TCB was found */
@@ -281,6 +290,15 @@ void *_event_loop(__attribute__((unused)) void *arg)
                      NULL, NULL, 0);
                 break;
 
+#ifdef MODULE_GNRC_TCP_ASYNC
+            /* Timer of a TCB using the asynchronous API expired */
+            case MSG_TYPE_CONNECTION_TIMEOUT:
+            case MSG_TYPE_PROBE_TIMEOUT:
+                DEBUG("gnrc_tcp_eventloop.c : _event_loop() : async timeout\n");
+                _async_timeout((gnrc_tcp_tcb_t *)msg.content.ptr, msg.type);
+                break;
+#endif
+
             default:
                 DEBUG("gnrc_tcp_eventloop.c : _event_loop() : received expected message\n");
         }
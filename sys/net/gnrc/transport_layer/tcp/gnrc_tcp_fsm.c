@@ -17,12 +17,16 @@
  * @}
  */
 
+#include <string.h>
 #include <utlist.h>
 #include <errno.h>
 #include "random.h"
 #include "net/af.h"
 #include "net/gnrc.h"
+#include "net/gnrc/tcp.h"
 #include "internal/common.h"
+#include "internal/async.h"
+#include "internal/cc.h"
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
@@ -32,6 +36,10 @@
 #include "net/gnrc/ipv6.h"
 #endif
 
+#ifdef MODULE_GNRC_IPV6_NIB
+#include "net/gnrc/ipv6/nib/nc.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -83,11 +91,14 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->pkt_retransmit_num > 0) {
+        for (unsigned i = 0; i < tcb->pkt_retransmit_num; i++) {
+            gnrc_pktbuf_release(tcb->pkt_retransmit[i]);
+        }
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        tcb->pkt_retransmit_num = 0;
     }
+    tcb->status &= ~STATUS_RTT_MEASURE;
     return 0;
 }
 
@@ -134,6 +145,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             /* Free potencially allocated receive buffer */
             _rcvbuf_release_buffer(tcb);
             tcb->status |= STATUS_NOTIFY_USER;
+            if (tcb->state != FSM_STATE_CLOSED) {
+                _async_event(tcb, GNRC_TCP_ASYNC_CLOSED);
+            }
             break;
 
         case FSM_STATE_LISTEN:
@@ -152,6 +166,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
                 return -ENOMEM;
             }
+            tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -167,6 +182,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
                 return -ENOMEM;
             }
+            tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -192,8 +208,15 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_ESTABLISHED:
+            /* Start with a fresh congestion window */
+            _cc_init(tcb);
+            tcb->status |= STATUS_NOTIFY_USER;
+            _async_event(tcb, GNRC_TCP_ASYNC_CONNECTED);
+            break;
+
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
+            _async_event(tcb, GNRC_TCP_ASYNC_EOF);
             break;
 
         case FSM_STATE_TIME_WAIT:
@@ -221,7 +244,7 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     int ret = 0;
 
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_open()\n");
-    tcb->rcv_wnd = GNRC_TCP_DEFAULT_WINDOW;
+    memset(&tcb->stats, 0, sizeof(tcb->stats));
 
     if (tcb->status & STATUS_PASSIVE) {
         /* Passive open, T: CLOSED -> LISTEN */
@@ -266,24 +289,36 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t sent = 0;
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
+    /* Send segments as long as send window, congestion window and
+     * retransmission queue allow */
+    while (sent < len && tcb->pkt_retransmit_num < GNRC_TCP_SND_QUEUE_SIZE) {
+        size_t payload = _cc_usable_window(tcb);
+
+        if (payload == 0) {
+            break;
+        }
         /* Calculate segment size */
         payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
         payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        payload = (payload < (len - sent)) ? payload : (len - sent);
 
         /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *) buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    if (sent < len) {
+        _async_want_write(tcb);
+    }
+    return sent;
 }
 
 /**
@@ -419,6 +454,10 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     seg_seq = byteorder_ntohl(tcp_hdr->seq_num);
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
+    /* The window of SYN segments is never scaled */
+    if (!(ctl & MSK_SYN)) {
+        seg_wnd <<= tcb->snd_wnd_scale;
+    }
 
     /* Extract network layer header */
 #ifdef MODULE_GNRC_IPV6
@@ -631,8 +670,27 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
+
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+                    _cc_ack(tcb, acked);
+#ifdef MODULE_GNRC_IPV6_NIB
+                    /* new data got through: the peer is reachable, if it
+                     * is a neighbor (RFC 4861, section 7.3.1) */
+                    if (tcb->address_family == AF_INET6) {
+                        gnrc_ipv6_nib_nc_mark_reachable((ipv6_addr_t *)tcb->peer_addr);
+                    }
+#endif
+
+                    /* Signal user: there might be room for more data */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK (see RFC 5681, section 2): a segment might be lost */
+                else if (seg_ack == tcb->snd_una && tcb->snd_una != tcb->snd_nxt &&
+                         pay_len == 0 && !(ctl & MSK_FIN) && seg_wnd == tcb->snd_wnd) {
+                    _cc_dup_ack(tcb);
+                    tcb->status |= STATUS_NOTIFY_USER;
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -653,28 +711,29 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                         tcb->status |= STATUS_NOTIFY_USER;
                     }
                 }
+                _async_check_writable(tcb);
                 /* Additional processing */
                 /* Check additionaly if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_num == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_num == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_num == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_num == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -692,17 +751,14 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Search for begin of payload */
                 LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
 
-                /* Accept only data that is expected, to be received */
-                if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
+                /* Copy contents into receive buffer, out-of-order data is
+                 * kept until the gap before it is filled */
+                if (_rcvbuf_add_segment(tcb, seg_seq, snp) > 0) {
                     /* Shrink receive window */
                     tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
+                    _async_event(tcb, GNRC_TCP_ASYNC_READABLE);
                 }
                 /* Send ACK, if FIN processing sends ACK already */
                 /* NOTE: this is the place to add payload piggybagging in the future */
@@ -719,6 +775,13 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_SYN_SENT) {
                 return 0;
             }
+            /* Ignore FIN until all data before it was received */
+            if (GRT_32_BIT(seg_seq + pay_len, tcb->rcv_nxt)) {
+                _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                           NULL, 0);
+                _pkt_send(tcb, out_pkt, seq_con, false);
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
@@ -728,7 +791,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->pkt_retransmit_num == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -770,9 +833,10 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->pkt_retransmit_num > 0) {
+        _cc_timeout(tcb);
+        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit[0], true);
+        _pkt_resend(tcb);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -901,6 +965,7 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
         msg.type = MSG_TYPE_NOTIFY_USER;
         mbox_try_put(&(tcb->mbox), &msg);
     }
+    _async_post(tcb);
     /* Unlock FSM */
     mutex_unlock(&(tcb->fsm_lock));
     return result;
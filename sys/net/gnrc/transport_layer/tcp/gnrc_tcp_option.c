@@ -24,8 +24,17 @@
 
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+
+    /* Options negotiated during connection setup are only valid on SYN */
+    if (ctl & MSK_SYN) {
+        tcb->status &= ~(STATUS_WND_SCALE | STATUS_SACK);
+        tcb->snd_wnd_scale = 0;
+        tcb->rcv_wnd_scale = 0;
+    }
+
     /* Extract offset value. Return if no options are set */
-    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint8_t offset = GET_OFFSET(ctl);
     if (offset <= TCP_HDR_OFFSET_MIN) {
         return 0;
     }
@@ -39,17 +48,21 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
         tcp_hdr_opt_t *option = (tcp_hdr_opt_t *) opt_ptr;
 
         /* Examine current option */
+        if (option->kind == TCP_OPTION_KIND_EOL) {
+            DEBUG("gnrc_tcp_option.c : _option_parse() : EOL option found\n");
+            break;
+        }
+        if (option->kind == TCP_OPTION_KIND_NOP) {
+            DEBUG("gnrc_tcp_option.c : _option_parse() : NOP option found\n");
+            opt_ptr += 1;
+            opt_left -= 1;
+            continue;
+        }
+        if ((opt_left < 2) || (option->length < 2) || (option->length > opt_left)) {
+            DEBUG("gnrc_tcp_option.c : _option_parse() : invalid option length.\n");
+            return -1;
+        }
         switch (option->kind) {
-            case TCP_OPTION_KIND_EOL:
-                DEBUG("gnrc_tcp_option.c : _option_parse() : EOL option found\n");
-                return 0;
-
-            case TCP_OPTION_KIND_NOP:
-                DEBUG("gnrc_tcp_option.c : _option_parse() : NOP option found\n");
-                opt_ptr += 1;
-                opt_left -= 1;
-                continue;
-
             case TCP_OPTION_KIND_MSS:
                 if (option->length != TCP_OPTION_LENGTH_MSS) {
                     DEBUG("gnrc_tcp_option.c : _option_parse() : invalid MSS Option length.\n");
@@ -60,6 +73,39 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_WND_SCALE:
+                if (option->length != TCP_OPTION_LENGTH_WND_SCALE) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid WS Option length.\n");
+                    return -1;
+                }
+                if (GNRC_TCP_CONF_WND_SCALE && (ctl & MSK_SYN)) {
+                    tcb->status |= STATUS_WND_SCALE;
+                    tcb->snd_wnd_scale = (option->value[0] < TCP_WND_SCALE_MAX) ?
+                                         option->value[0] : TCP_WND_SCALE_MAX;
+                    tcb->rcv_wnd_scale = _option_calc_wnd_scale(tcb->rcv_buf.size);
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : WS option found. SHIFT=%"PRIu8"\n",
+                      option->value[0]);
+                break;
+
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK Permitted Option "
+                          "length.\n");
+                    return -1;
+                }
+                if (GNRC_TCP_CONF_SACK && (ctl & MSK_SYN)) {
+                    tcb->status |= STATUS_SACK;
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK Permitted option found.\n");
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                /* With only one segment in flight, there is nothing the
+                 * peer's SACK blocks could spare from retransmission */
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK option found.\n");
+                break;
+
             default:
                 DEBUG("gnrc_tcp_option.c : _option_parse() : Unknown option found.\
                       KIND=%"PRIu8", LENGTH=%"PRIu8"\n", option->kind, option->length);
@@ -164,14 +164,39 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     tcp_hdr.checksum = byteorder_htons(0);
     tcp_hdr.seq_num = byteorder_htonl(seq_num);
     tcp_hdr.ack_num = byteorder_htonl(ack_num);
-    tcp_hdr.window = byteorder_htons(tcb->rcv_wnd);
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
+    /* The window of SYN segments is never scaled */
+    uint32_t wnd = (ctl & MSK_SYN) ? tcb->rcv_wnd : (tcb->rcv_wnd >> tcb->rcv_wnd_scale);
+    tcp_hdr.window = byteorder_htons((wnd < UINT16_MAX) ? wnd : UINT16_MAX);
+
+    /* Window scale and SACK are offered on active open, and accepted if the
+     * peer offered them */
+    bool wnd_scale = false;
+    bool sack_perm = false;
+    unsigned sack_blocks = 0;
+    if (ctl & MSK_SYN) {
+        wnd_scale = GNRC_TCP_CONF_WND_SCALE &&
+                    (!(ctl & MSK_ACK) || (tcb->status & STATUS_WND_SCALE));
+        sack_perm = GNRC_TCP_CONF_SACK &&
+                    (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK));
+    }
+    else if ((ctl & MSK_ACK) && (tcb->status & STATUS_SACK)) {
+        sack_blocks = (tcb->ooseq_num < TCP_SACK_BLOCKS_MAX) ? tcb->ooseq_num :
+                      TCP_SACK_BLOCKS_MAX;
+    }
+
     /* Calculate option field size. */
     /* Add MSS option if SYN is sent */
     if (ctl & MSK_SYN) {
         offset += 1;
     }
+    /* Window scale and SACK permitted: padded with NOPs to one word each */
+    offset += wnd_scale + sack_perm;
+    /* SACK blocks: two NOPs, kind, length, and two words per block */
+    if (sack_blocks > 0) {
+        offset += 1 + (2 * sack_blocks);
+    }
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(_option_build_offset_control(offset, ctl));
 
@@ -196,8 +221,36 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             if (ctl & MSK_SYN) {
                 network_uint32_t mss_option = byteorder_htonl(_option_build_mss(GNRC_TCP_MSS));
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+            }
+            if (wnd_scale) {
+                opt_ptr[0] = TCP_OPTION_KIND_NOP;
+                opt_ptr[1] = TCP_OPTION_KIND_WND_SCALE;
+                opt_ptr[2] = TCP_OPTION_LENGTH_WND_SCALE;
+                opt_ptr[3] = _option_calc_wnd_scale(tcb->rcv_buf.size);
+                opt_ptr += 4;
+            }
+            if (sack_perm) {
+                opt_ptr[0] = TCP_OPTION_KIND_NOP;
+                opt_ptr[1] = TCP_OPTION_KIND_NOP;
+                opt_ptr[2] = TCP_OPTION_KIND_SACK_PERM;
+                opt_ptr[3] = TCP_OPTION_LENGTH_SACK_PERM;
+                opt_ptr += 4;
+            }
+            if (sack_blocks > 0) {
+                opt_ptr[0] = TCP_OPTION_KIND_NOP;
+                opt_ptr[1] = TCP_OPTION_KIND_NOP;
+                opt_ptr[2] = TCP_OPTION_KIND_SACK;
+                opt_ptr[3] = 2 + (sack_blocks * 2 * sizeof(network_uint32_t));
+                opt_ptr += 4;
+                for (unsigned i = 0; i < sack_blocks; i++) {
+                    network_uint32_t edge = byteorder_htonl(tcb->ooseq[i].start);
+                    memcpy(opt_ptr, &edge, sizeof(edge));
+                    edge = byteorder_htonl(tcb->ooseq[i].end);
+                    memcpy(opt_ptr + sizeof(edge), &edge, sizeof(edge));
+                    opt_ptr += 2 * sizeof(edge);
+                }
             }
-            /* Increase opt_ptr and decrease opt_ptr, if other options are added */
             /* NOTE: Add additional options here */
         }
         *(out_pkt) = tcp_snp;
@@ -262,11 +315,17 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
 
     /* If this is no retransmission, advance sequence number and measure time */
     if (!retransmit) {
-        tcb->retries = 0;
+        /* Time one segment per round trip */
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_MEASURE)) {
+            tcb->status |= STATUS_RTT_MEASURE;
+            tcb->rtt_start = xtimer_now_usec();
+            tcb->rtt_seq = tcb->snd_nxt + seq_con;
+        }
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
     }
     else {
+        /* Retransmitted data gives no valid sample (Karns Algorithm) */
+        tcb->status &= ~STATUS_RTT_MEASURE;
         tcb->retries += 1;
     }
 
@@ -339,6 +398,43 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt)
     return seg_len;
 }
 
+/**
+ * @brief Calculates the retransmission timeout from the current RTT estimates.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _calc_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* Without a sample: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief Starts the retransmission timer with the current RTO.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _set_retransmit_timer(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundry checks on current RTO before usage */
+    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
+    tcb->msg_tout.content.ptr = (void *) tcb;
+    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit)
 {
     gnrc_pktsnip_t *snp = NULL;
@@ -351,35 +447,32 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
-        return -ENOMEM;
-    }
+    if (!retransmit) {
+        /* Extract control bits and segment length */
+        LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
+        ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
+        len = _pkt_get_pay_len(pkt);
 
-    /* Extract control bits and segment length */
-    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
-    ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
-    len = _pkt_get_pay_len(pkt);
+        /* Check if pkt contains reset or is a pure ACK, return */
+        if ((ctl & MSK_RST) || (((ctl & MSK_SYN_FIN_ACK) == MSK_ACK) && len == 0)) {
+            return 0;
+        }
 
-    /* Check if pkt contains reset or is a pure ACK, return */
-    if ((ctl & MSK_RST) || (((ctl & MSK_SYN_FIN_ACK) == MSK_ACK) && len == 0)) {
-        return 0;
-    }
+        /* Check if retransmit queue is full */
+        if (tcb->pkt_retransmit_num >= GNRC_TCP_SND_QUEUE_SIZE) {
+            DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Retransmit queue is full\n");
+            return -ENOMEM;
+        }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
-    gnrc_pktbuf_hold(pkt, 1);
+        /* Append pkt and increase users: every send attempt consumes a user */
+        tcb->pkt_retransmit[tcb->pkt_retransmit_num++] = pkt;
+        gnrc_pktbuf_hold(pkt, 1);
 
-    /* RTO adjustment */
-    if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+        /* The timer is already running for an older segment */
+        if (tcb->pkt_retransmit_num > 1) {
+            return 0;
         }
+        _calc_rto(tcb);
     }
     else {
         /* If this is a retransmission: Double the rto (Timer Backoff) */
@@ -392,20 +485,24 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
             tcb->rtt_var = RTO_UNINITIALIZED;
         }
     }
+    _set_retransmit_timer(tcb);
+    return 0;
+}
 
-    /* Perform boundry checks on current RTO before usage */
-    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-    }
-    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+int _pkt_resend(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_pktsnip_t *pkt = NULL;
+
+    if (tcb->pkt_retransmit_num == 0) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_resend() : Retransmit queue is empty\n");
+        return -ENODATA;
     }
 
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
-    return 0;
+    /* Every send attempt consumes a user */
+    pkt = tcb->pkt_retransmit[0];
+    gnrc_pktbuf_hold(pkt, 1);
+    tcb->stats.retransmits++;
+    return _pkt_send(tcb, pkt, 0, true);
 }
 
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
@@ -413,30 +510,39 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
     uint32_t seg = 0;
     gnrc_pktsnip_t *snp = NULL;
     tcp_hdr_t *hdr;
+    bool acked = false;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->pkt_retransmit_num == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
-
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+    /* Release every segment that is acknowledged completely */
+    while (tcb->pkt_retransmit_num > 0) {
+        LL_SEARCH_SCALAR(tcb->pkt_retransmit[0], snp, type, GNRC_NETTYPE_TCP);
+        hdr = (tcp_hdr_t *) snp->data;
+        seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit[0]) - 1;
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(tcb->pkt_retransmit[0]);
+        tcb->pkt_retransmit_num--;
+        memmove(&tcb->pkt_retransmit[0], &tcb->pkt_retransmit[1],
+                tcb->pkt_retransmit_num * sizeof(tcb->pkt_retransmit[0]));
+        acked = true;
+    }
+    if (!acked) {
+        return 0;
+    }
 
-        /* Measure round trip time */
-        int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
+    /* Measure round trip time, if the timed segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_MEASURE) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
+        int32_t rtt = xtimer_now_usec() - tcb->rtt_start;
 
-        /* Use time only if ther was no timer overflow and no retransmission (Karns Alogrithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        tcb->status &= ~STATUS_RTT_MEASURE;
+        /* Use time only if ther was no timer overflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -451,6 +557,15 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
             }
         }
     }
+
+    /* New data was acknowledged: end timer backoff and restart the timer
+     * for the remaining segments (see RFC 6298, section 5) */
+    tcb->retries = 0;
+    xtimer_remove(&(tcb->tim_tout));
+    if (tcb->pkt_retransmit_num > 0) {
+        _calc_rto(tcb);
+        _set_retransmit_timer(tcb);
+    }
     return 0;
 }
 
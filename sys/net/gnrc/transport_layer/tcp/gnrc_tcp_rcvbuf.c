@@ -16,6 +16,8 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
+#include "internal/common.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
@@ -79,7 +81,13 @@ static void _rcvbuf_free(void * const buf)
 
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
+    tcb->ooseq_num = 0;
     if (tcb->rcv_buf_raw == NULL) {
+        if (tcb->rcv_buf_user != NULL) {
+            tcb->rcv_buf_raw = tcb->rcv_buf_user;
+            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, tcb->rcv_buf_user_size);
+            return 0;
+        }
         tcb->rcv_buf_raw = _rcvbuf_alloc();
         if (tcb->rcv_buf_raw == NULL) {
             DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
@@ -95,7 +103,147 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
+        if (tcb->rcv_buf_raw != tcb->rcv_buf_user) {
+            _rcvbuf_free(tcb->rcv_buf_raw);
+        }
         tcb->rcv_buf_raw = NULL;
     }
+    tcb->ooseq_num = 0;
+}
+
+/**
+ * @brief Copy data behind the readable data of a ringbuffer, without making
+ *        it readable.
+ *
+ * @pre @p offset + @p len must not exceed the free space of @p rb.
+ *
+ * @param[in,out] rb       Ringbuffer to copy into.
+ * @param[in]     offset   Number of bytes to leave out after the readable data.
+ * @param[in]     data     Data to copy.
+ * @param[in]     len      Number of bytes in @p data.
+ */
+static void _write_at(ringbuffer_t *rb, uint32_t offset, const uint8_t *data, uint32_t len)
+{
+    uint32_t pos = (rb->start + rb->avail + offset) % rb->size;
+    uint32_t part = rb->size - pos;
+
+    if (part > len) {
+        part = len;
+    }
+    memcpy(rb->buf + pos, data, part);
+    memcpy(rb->buf, data + part, len - part);
+}
+
+/**
+ * @brief Removes entry @p i from the out-of-order data ranges.
+ */
+static void _ooseq_remove(gnrc_tcp_tcb_t *tcb, unsigned i)
+{
+    tcb->ooseq_num--;
+    memmove(&tcb->ooseq[i], &tcb->ooseq[i + 1],
+            (tcb->ooseq_num - i) * sizeof(tcb->ooseq[0]));
+}
+
+/**
+ * @brief Records the out-of-order data range [@p start, @p end).
+ */
+static void _ooseq_add(gnrc_tcp_tcb_t *tcb, uint32_t start, uint32_t end)
+{
+    unsigned i = 0;
+
+    /* absorb all ranges the new one overlaps or touches */
+    while (i < tcb->ooseq_num) {
+        gnrc_tcp_ooseq_t *range = &tcb->ooseq[i];
+
+        if (LEQ_32_BIT(range->start, end) && LEQ_32_BIT(start, range->end)) {
+            if (LSS_32_BIT(range->start, start)) {
+                start = range->start;
+            }
+            if (LSS_32_BIT(end, range->end)) {
+                end = range->end;
+            }
+            _ooseq_remove(tcb, i);
+        }
+        else {
+            i++;
+        }
+    }
+    /* most recent range goes first, as required for SACK. If all entries are
+     * in use, the oldest one is forgotten and gets retransmitted by the peer */
+    if (tcb->ooseq_num == GNRC_TCP_OOSEQ_NUMOF) {
+        tcb->ooseq_num--;
+    }
+    memmove(&tcb->ooseq[1], &tcb->ooseq[0], tcb->ooseq_num * sizeof(tcb->ooseq[0]));
+    tcb->ooseq[0].start = start;
+    tcb->ooseq[0].end = end;
+    tcb->ooseq_num++;
+}
+
+uint32_t _rcvbuf_add_segment(gnrc_tcp_tcb_t *tcb, uint32_t seq, gnrc_pktsnip_t *payload)
+{
+    ringbuffer_t *rb = &tcb->rcv_buf;
+    uint32_t wnd = ringbuffer_get_free(rb);
+    uint32_t start = seq;
+    uint32_t end;
+    uint32_t old_nxt = tcb->rcv_nxt;
+
+    /* skip data that was already received */
+    while (payload && payload->type == GNRC_NETTYPE_UNDEF &&
+           LEQ_32_BIT(seq + payload->size, tcb->rcv_nxt)) {
+        seq += payload->size;
+        payload = payload->next;
+    }
+    if (LSS_32_BIT(start, tcb->rcv_nxt)) {
+        start = tcb->rcv_nxt;
+    }
+    end = start;
+
+    /* copy the rest into its place in the receive buffer, as far as the
+     * window allows */
+    while (payload && payload->type == GNRC_NETTYPE_UNDEF) {
+        uint32_t skip = end - seq;
+        uint32_t offset = end - tcb->rcv_nxt;
+        uint32_t len = payload->size - skip;
+
+        if (offset >= wnd) {
+            break;
+        }
+        if (len > wnd - offset) {
+            len = wnd - offset;
+        }
+        _write_at(rb, offset, (uint8_t *) payload->data + skip, len);
+        end += len;
+        seq += payload->size;
+        payload = payload->next;
+    }
+    if (start == end) {
+        return 0;
+    }
+    if (start != tcb->rcv_nxt) {
+        DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_add_segment() : Out-of-order data stored\n");
+        _ooseq_add(tcb, start, end);
+        return 0;
+    }
+
+    /* data is in order: make it readable together with all out-of-order data
+     * it closes the gap to */
+    rb->avail += end - start;
+    tcb->rcv_nxt = end;
+    for (unsigned i = 0; i < tcb->ooseq_num;) {
+        gnrc_tcp_ooseq_t *range = &tcb->ooseq[i];
+
+        if (LEQ_32_BIT(range->start, tcb->rcv_nxt)) {
+            if (LSS_32_BIT(tcb->rcv_nxt, range->end)) {
+                rb->avail += range->end - tcb->rcv_nxt;
+                tcb->rcv_nxt = range->end;
+            }
+            _ooseq_remove(tcb, i);
+            /* the new rcv_nxt might close the gap to an already checked range */
+            i = 0;
+        }
+        else {
+            i++;
+        }
+    }
+    return tcb->rcv_nxt - old_nxt;
 }
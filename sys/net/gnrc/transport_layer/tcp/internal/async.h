@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's TCP implementation for the GNRC network stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event generation for the asynchronous API.
+ *
+ * All functions must be called with the FSM lock of the TCB held.
+ */
+
+#ifndef ASYNC_H
+#define ASYNC_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_GNRC_TCP_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief Asynchronous API status flags
+ * @{
+ */
+#define ASYNC_WANT_WRITE   (1 << 0)     /**< A send call could not send everything */
+#define ASYNC_TIMER_ARMED  (1 << 1)     /**< async_tim is running */
+/** @} */
+
+/**
+ * @brief Marks events to be passed to the callback of an asynchronous TCB.
+ *
+ * @param[in,out] tcb      TCB holding the connection information.
+ * @param[in]     events   `GNRC_TCP_ASYNC_*` events.
+ */
+static inline void _async_event(gnrc_tcp_tcb_t *tcb, uint8_t events)
+{
+    if (tcb->async_cb != NULL) {
+        tcb->async_events |= events;
+    }
+}
+
+/**
+ * @brief Remembers that the user waits for room in the send window.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static inline void _async_want_write(gnrc_tcp_tcb_t *tcb)
+{
+    tcb->async_status |= ASYNC_WANT_WRITE;
+}
+
+/**
+ * @brief Marks @ref GNRC_TCP_ASYNC_WRITABLE if the user waits for it and
+ *        more data can be sent.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _async_check_writable(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Posts pending events and updates the connection timeout and probe
+ *        timer after an FSM call.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _async_post(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Handles expiration of the asynchronous timer in the TCP thread.
+ *
+ * @note This function must be called without the FSM lock held.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     type   Message type of the timer message.
+ */
+void _async_timeout(gnrc_tcp_tcb_t *tcb, uint16_t type);
+#else
+static inline void _async_event(gnrc_tcp_tcb_t *tcb, uint8_t events)
+{
+    (void)tcb;
+    (void)events;
+}
+
+static inline void _async_want_write(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+
+static inline void _async_check_writable(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+
+static inline void _async_post(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASYNC_H */
+/** @} */
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's TCP implementation for the GNRC network stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Fast retransmit and fast recovery, driving congestion control.
+ */
+
+#ifndef CC_H
+#define CC_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Resets the congestion control state of a newly established connection.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Processes an ACK that acknowledged new data.
+ *
+ * Must be called after the acknowledged segments were removed from the
+ * retransmission queue. Retransmits the next segment on a partial ACK
+ * during fast recovery.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+void _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked);
+
+/**
+ * @brief Processes a duplicate ACK.
+ *
+ * Retransmits the first unacknowledged segment and enters fast recovery on the
+ * @ref GNRC_TCP_DUP_ACK_THRESHOLD th duplicate ACK.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_dup_ack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Processes an expired retransmission timer.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_timeout(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Calculates how many bytes may be sent right now.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Number of bytes the send and congestion windows allow on top of
+ *            the data in flight.
+ */
+uint32_t _cc_usable_window(const gnrc_tcp_tcb_t *tcb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC_H */
+/** @} */
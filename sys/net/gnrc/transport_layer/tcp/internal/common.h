@@ -49,6 +49,10 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_WND_SCALE      (1 << 4)
+#define STATUS_SACK           (1 << 5)
+#define STATUS_RTT_MEASURE    (1 << 6)
+#define STATUS_FAST_RECOVERY  (1 << 7)
 /** @} */
 
 /**
@@ -44,6 +44,23 @@ static inline uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to calculate the window scale shift count.
+ *
+ * @param[in] size   Size of the receive buffer.
+ *
+ * @returns   Smallest shift count that allows to announce a window of @p size.
+ */
+static inline uint8_t _option_calc_wnd_scale(uint32_t size)
+{
+    uint8_t shift = 0;
+
+    while (((size >> shift) > UINT16_MAX) && (shift < TCP_WND_SCALE_MAX)) {
+        shift++;
+    }
+    return shift;
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
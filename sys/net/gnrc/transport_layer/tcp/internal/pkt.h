@@ -121,7 +121,17 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Sends the oldest unacknowledged packet again.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   Zero on success.
+ *            -ENODATA if the retransmission queue is empty.
+ */
+int _pkt_resend(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
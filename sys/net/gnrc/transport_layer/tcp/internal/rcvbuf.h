@@ -55,6 +55,9 @@ void _rcvbuf_init(void);
 /**
  * @brief Allocate receive buffer and assign it to TCB.
  *
+ * If a receive buffer was given with gnrc_tcp_tcb_set_rcv_buf(), that one is
+ * used instead of one of the preallocated buffers.
+ *
  * @param[in,out] tcb   TCB that aquires receive buffer.
  *
  * @returns   Zero  on success.
@@ -69,6 +72,22 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Store the payload of a received segment in the receive buffer.
+ *
+ * Data in front of gnrc_tcp_tcb_t::rcv_nxt is skipped, data beyond the
+ * receive window is dropped. Data that arrived out of order is kept in the
+ * buffer and becomes readable as soon as the gap in front of it is filled.
+ *
+ * @param[in,out] tcb       TCB holding the receive buffer.
+ * @param[in]     seq       Sequence number of the segment.
+ * @param[in]     payload   First payload snip of the segment.
+ *
+ * @returns   Number of bytes gnrc_tcp_tcb_t::rcv_nxt advanced by, i.e. that
+ *            became readable.
+ */
+uint32_t _rcvbuf_add_segment(gnrc_tcp_tcb_t *tcb, uint32_t seq, gnrc_pktsnip_t *payload);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,7 @@
 #include "net/gnrc/udp.h"
 #include "net/gnrc.h"
 #include "net/gnrc/icmpv6/error.h"
+#include "net/gnrc/pkttrace.h"
 #include "net/inet_csum.h"
 
 
@@ -105,6 +106,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
     udp_hdr_t *hdr;
     uint32_t port;
 
+    gnrc_pkttrace(pkt, GNRC_PKTTRACE_RX_UDP);
     /* mark UDP header */
     udp = gnrc_pktbuf_start_write(pkt);
     if (udp == NULL) {
@@ -146,7 +148,8 @@ static void _receive(gnrc_pktsnip_t *pkt)
         gnrc_pktbuf_release(pkt);
         return;
     }
-    if (_calc_csum(udp, ipv6, pkt) != 0xFFFF) {
+    if (!gnrc_netif_csum_offload_rx(pkt, NETOPT_CSUM_OFFLOAD_UDP) &&
+        (_calc_csum(udp, ipv6, pkt) != 0xFFFF)) {
         DEBUG("udp: received packet with invalid checksum, dropping it\n");
         gnrc_pktbuf_release(pkt);
         return;
@@ -170,6 +173,7 @@ static void _send(gnrc_pktsnip_t *pkt)
     gnrc_pktsnip_t *udp_snip, *tmp;
     gnrc_nettype_t target_type = pkt->type;
 
+    gnrc_pkttrace(pkt, GNRC_PKTTRACE_TX_UDP);
     /* write protect first header */
     tmp = gnrc_pktbuf_start_write(pkt);
     if (tmp == NULL) {
@@ -220,40 +224,68 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _direct_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        /* run-to-completion in the thread of the network layer */
+        _receive(pkt);
+    }
+    else if (gnrc_netapi_send(_pid, pkt) < 1) {
+        DEBUG("udp: unable to hand packet over to UDP thread\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static gnrc_netreg_entry_cbd_t _direct_cbd = { _direct_cb, NULL };
+#endif
+
 static void *_event_loop(void *arg)
 {
     (void)arg;
-    msg_t msg, reply;
+    msg_t msgs[GNRC_UDP_MSG_BATCH_SIZE], reply;
     msg_t msg_queue[GNRC_UDP_MSG_QUEUE_SIZE];
-    gnrc_netreg_entry_t netreg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
-                                                            sched_active_pid);
+    gnrc_netreg_entry_t netreg;
+
     /* preset reply message */
     reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
     reply.content.value = (uint32_t)-ENOTSUP;
     /* initialize message queue */
     msg_init_queue(msg_queue, GNRC_UDP_MSG_QUEUE_SIZE);
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    gnrc_netreg_entry_init_cb(&netreg, GNRC_NETREG_DEMUX_CTX_ALL, &_direct_cbd);
+#else
+    gnrc_netreg_entry_init_pid(&netreg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               sched_active_pid);
+#endif
     /* register UPD at netreg */
     gnrc_netreg_register(GNRC_NETTYPE_UDP, &netreg);
 
     /* dispatch NETAPI messages */
     while (1) {
-        msg_receive(&msg);
-        switch (msg.type) {
-            case GNRC_NETAPI_MSG_TYPE_RCV:
-                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
-                _receive(msg.content.ptr);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
-                _send(msg.content.ptr);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_SET:
-            case GNRC_NETAPI_MSG_TYPE_GET:
-                msg_reply(&msg, &reply);
-                break;
-            default:
-                DEBUG("udp: received unidentified message\n");
-                break;
+        int n = msg_receive_batch(msgs, GNRC_UDP_MSG_BATCH_SIZE);
+
+        for (int i = 0; i < n; i++) {
+            msg_t *msg = &msgs[i];
+
+            switch (msg->type) {
+                case GNRC_NETAPI_MSG_TYPE_RCV:
+                    DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
+                    _receive(msg->content.ptr);
+                    break;
+                case GNRC_NETAPI_MSG_TYPE_SND:
+                    DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
+                    _send(msg->content.ptr);
+                    break;
+                case GNRC_NETAPI_MSG_TYPE_SET:
+                case GNRC_NETAPI_MSG_TYPE_GET:
+                    msg_reply(msg, &reply);
+                    break;
+                default:
+                    DEBUG("udp: received unidentified message\n");
+                    break;
+            }
         }
     }
 
@@ -30,6 +30,7 @@
 #include "xtimer.h"
 #include "timex.h"
 #include "utlist.h"
+#include "hashes.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -65,6 +66,212 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+/**
+ * @brief returns the prefix length of an entry with a prefix, 0 otherwise
+ */
+static size_t fib_prefix_len(const fib_entry_t *entry)
+{
+    return (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) >> FIB_FLAG_NET_PREFIX_SHIFT;
+}
+
+static bool fib_is_expired(const fib_entry_t *entry, uint64_t now)
+{
+    return (entry->lifetime != FIB_LIFETIME_NO_EXPIRE) && (entry->lifetime < now);
+}
+
+/**
+ * @brief returns the home slot in the index of the given address
+ */
+static size_t fib_index_home(fib_table_t *table, const uint8_t *addr, size_t addr_size)
+{
+    return murmur3_32_hash(addr, addr_size, addr_size) % FIB_INDEX_SIZE(table->size);
+}
+
+/**
+ * @brief returns the indexed entry of exactly the given destination address,
+ *        NULL if there is none
+ */
+static fib_entry_t *fib_index_get(fib_table_t *table, const uint8_t *addr, size_t addr_size)
+{
+    size_t slots = FIB_INDEX_SIZE(table->size);
+
+    for (size_t pos = fib_index_home(table, addr, addr_size); table->index[pos];
+         pos = (pos + 1) % slots) {
+        fib_entry_t *entry = &table->data.entries[table->index[pos] - 1];
+
+        if ((entry->global->address_size == addr_size) &&
+            (memcmp(entry->global->address, addr, addr_size) == 0)) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief checks if a prefix has bits set beyond its length
+ */
+static bool fib_prefix_is_incomplete(const fib_entry_t *entry, size_t prefix_len)
+{
+    const universal_address_container_t *global = entry->global;
+
+    for (size_t bit = prefix_len; bit < (size_t)(global->address_size << 3); bit++) {
+        if (global->address[bit >> 3] & (0x80 >> (bit & 7))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief adds the prefix length of an entry to the bitmap of prefix lengths
+ */
+static void fib_index_add_prefix(fib_table_t *table, const fib_entry_t *entry)
+{
+    size_t prefix_len = fib_prefix_len(entry);
+
+    if ((prefix_len > 0) && (prefix_len < (size_t)(entry->global->address_size << 3))) {
+        table->prefix_lens[prefix_len / 32] |= 1UL << (prefix_len % 32);
+        if (fib_prefix_is_incomplete(entry, prefix_len)) {
+            table->index_incomplete = true;
+        }
+    }
+}
+
+/**
+ * @brief adds a newly created entry to the index
+ */
+static void fib_index_add(fib_table_t *table, fib_entry_t *entry)
+{
+    if (table->index == NULL) {
+        return;
+    }
+
+    size_t slots = FIB_INDEX_SIZE(table->size);
+    size_t pos = fib_index_home(table, entry->global->address, entry->global->address_size);
+
+    while (table->index[pos]) {
+        pos = (pos + 1) % slots;
+    }
+    table->index[pos] = (entry - table->data.entries) + 1;
+    fib_index_add_prefix(table, entry);
+}
+
+/**
+ * @brief removes an entry from the index, and the lengths of the prefixes
+ *        that are no longer present
+ */
+static void fib_index_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    if ((table->index == NULL) || (entry->global == NULL)) {
+        return;
+    }
+
+    size_t slots = FIB_INDEX_SIZE(table->size);
+    uint16_t idx = (entry - table->data.entries) + 1;
+    size_t pos = fib_index_home(table, entry->global->address, entry->global->address_size);
+
+    while (table->index[pos] && (table->index[pos] != idx)) {
+        pos = (pos + 1) % slots;
+    }
+    if (table->index[pos] == 0) {
+        /* never indexed, e.g. a partially created entry */
+        return;
+    }
+
+    /* shift back the following entries that are not at their home slot */
+    table->index[pos] = 0;
+    for (size_t next = (pos + 1) % slots; table->index[next]; next = (next + 1) % slots) {
+        fib_entry_t *moved = &table->data.entries[table->index[next] - 1];
+        size_t home = fib_index_home(table, moved->global->address,
+                                     moved->global->address_size);
+        bool stays = (pos <= next) ? ((pos < home) && (home <= next))
+                                   : ((pos < home) || (home <= next));
+
+        if (!stays) {
+            table->index[pos] = table->index[next];
+            table->index[next] = 0;
+            pos = next;
+        }
+    }
+
+    memset(table->prefix_lens, 0, sizeof(table->prefix_lens));
+    table->index_incomplete = false;
+    for (size_t i = 0; i < table->size; ++i) {
+        if ((&table->data.entries[i] != entry) && (table->data.entries[i].lifetime != 0)) {
+            fib_index_add_prefix(table, &table->data.entries[i]);
+        }
+    }
+}
+
+/**
+ * @brief returns the indexed entry of exactly the given address, removing it
+ *        if its lifetime expired
+ */
+static fib_entry_t *fib_index_get_valid(fib_table_t *table, const uint8_t *addr,
+                                        size_t addr_size, uint64_t now)
+{
+    fib_entry_t *entry = fib_index_get(table, addr, addr_size);
+
+    if (entry && fib_is_expired(entry, now)) {
+        fib_remove(table, entry);
+        return NULL;
+    }
+
+    return entry;
+}
+
+/**
+ * @brief returns the entry for the given destination address with the index,
+ *        see fib_find_entry()
+ *
+ * A prefix entry holds the prefix followed by zeros. So for each prefix length
+ * present in the table, from the longest to the shortest, the destination is
+ * cut to this length and looked up by its exact address.
+ */
+static int fib_find_entry_indexed(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                                  fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+    uint64_t now = xtimer_now_usec64();
+    uint8_t masked[UNIVERSAL_ADDRESS_SIZE];
+    fib_entry_t *entry;
+
+    *entry_arr_size = 0;
+    if (dst_size > sizeof(masked)) {
+        return -EHOSTUNREACH;
+    }
+
+    entry = fib_index_get_valid(table, dst, dst_size, now);
+    if (entry) {
+        entry_arr[0] = entry;
+        *entry_arr_size = 1;
+        return 1;
+    }
+
+    memcpy(masked, dst, dst_size);
+    for (size_t len = dst_size << 3; len-- > 0;) {
+        /* keep the first len bits */
+        masked[len >> 3] &= ~(0x80 >> (len & 7));
+
+        /* all zeros is the default route, e.g. ::/0 for IPv6 */
+        if ((len > 0) && !(table->prefix_lens[len / 32] & (1UL << (len % 32)))) {
+            continue;
+        }
+
+        entry = fib_index_get_valid(table, masked, dst_size, now);
+        if (entry && ((len == 0) || (fib_prefix_len(entry) == len))) {
+            entry_arr[0] = entry;
+            *entry_arr_size = 1;
+            return 0;
+        }
+    }
+
+    return -EHOSTUNREACH;
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -97,6 +304,10 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     DEBUG("\n");
 #endif
 
+    if ((table->index != NULL) && !table->index_incomplete) {
+        return fib_find_entry_indexed(table, dst, dst_size, entry_arr, entry_arr_size);
+    }
+
     for (size_t i = 0; i < dst_size; ++i) {
         if (dst[i] != 0) {
             is_all_zeros_addr = false;
@@ -112,20 +323,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
             /* check if the lifetime expired */
             if (table->data.entries[i].lifetime < now) {
                 /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
-
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
-                }
-
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
-                }
+                fib_remove(table, &table->data.entries[i]);
             }
         }
 
@@ -246,7 +444,15 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                             uint8_t *next_hop, size_t next_hop_size, uint32_t
                             next_hop_flags, uint32_t lifetime)
 {
+    uint64_t now = xtimer_now_usec64();
+
     for (size_t i = 0; i < table->size; ++i) {
+        /* with the index, expired entries are only removed when found */
+        if ((table->data.entries[i].lifetime != 0) &&
+            fib_is_expired(&table->data.entries[i], now)) {
+            fib_remove(table, &table->data.entries[i]);
+        }
+
         if (table->data.entries[i].lifetime == 0) {
 
             table->data.entries[i].global = universal_address_add(dst, dst_size);
@@ -268,6 +474,7 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+                fib_index_add(table, &table->data.entries[i]);
                 return 0;
             }
         }
@@ -279,12 +486,15 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table of the entry
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+    fib_index_remove(table, entry);
+
     if (entry->global != NULL) {
         universal_address_rem(entry->global);
     }
@@ -457,7 +667,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +687,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -596,6 +806,11 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        if (table->index) {
+            memset(table->index, 0, FIB_INDEX_SIZE(table->size) * sizeof(uint16_t));
+        }
+        memset(table->prefix_lens, 0, sizeof(table->prefix_lens));
+        table->index_incomplete = false;
     }
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
@@ -621,6 +836,11 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        if (table->index) {
+            memset(table->index, 0, FIB_INDEX_SIZE(table->size) * sizeof(uint16_t));
+        }
+        memset(table->prefix_lens, 0, sizeof(table->prefix_lens));
+        table->index_incomplete = false;
     }
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
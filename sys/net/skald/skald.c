@@ -18,9 +18,11 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "assert.h"
+#include "irq.h"
 #include "random.h"
 #include "luid.h"
 
@@ -41,6 +43,7 @@
 
 #define JITTER_MIN              (0U)            /* 0ms */
 #define JITTER_MAX              (10000U)        /* 10ms */
+#define CHAN_SPACING            (150U)          /* between two channels */
 
 #define ADV_CHAN_NUMOF          sizeof(_adv_chan)
 #define ADV_AA                  (0x8e89bed6)    /* access address */
@@ -55,51 +58,103 @@ static netdev_ble_ctx_t _ble_ctx = {
 
 static netdev_t *_radio;
 
-static void _stop_radio(void)
+/* one timer for all contexts, the ones waiting for their next advertising
+ * event are kept sorted by their deadline */
+static void _on_timer(void *arg);
+static xtimer_t _timer = { .callback = _on_timer };
+static skald_ctx_t *_queue;
+/* context of the ongoing advertising event */
+static skald_ctx_t *_cur;
+
+static inline bool _before(uint32_t a, uint32_t b)
 {
-    netdev_ble_stop(_radio);
-    _radio->context = NULL;
+    return ((int32_t)(a - b) < 0);
 }
 
-static void _sched_next(skald_ctx_t *ctx)
+static void _enqueue(skald_ctx_t *ctx)
 {
-    ctx->last += SKALD_INTERVAL;
-    /* schedule next advertising event, adding a random jitter between
-     * 0ms and 10ms (see spec v5.0-vol6-b-4.4.2.2.1) */
-    ctx->last += random_uint32_range(JITTER_MIN, JITTER_MAX);
-    /* compensate the time passed since the timer triggered last by using the
-     * current value of the timer */
-    xtimer_set(&ctx->timer, (ctx->last - xtimer_now_usec()));
+    skald_ctx_t **pos = &_queue;
+
+    while (*pos && !_before(ctx->deadline, (*pos)->deadline)) {
+        pos = &(*pos)->next;
+    }
+    ctx->next = *pos;
+    *pos = ctx;
 }
 
-static void _on_adv_evt(void *arg)
+static bool _dequeue(skald_ctx_t *ctx)
 {
-    skald_ctx_t *ctx = (skald_ctx_t *)arg;
-
-    /* advertise on the next adv channel - or skip this event if the radio is
-     * busy */
-    if ((ctx->cur_chan < ADV_CHAN_NUMOF) && (_radio->context == NULL)) {
-        _radio->context = ctx;
-        _ble_ctx.chan = _adv_chan[ctx->cur_chan];
-        netdev_ble_set_ctx(_radio, &_ble_ctx);
-        netdev_ble_send(_radio, &ctx->pkt);
-        ++ctx->cur_chan;
+    for (skald_ctx_t **pos = &_queue; *pos; pos = &(*pos)->next) {
+        if (*pos == ctx) {
+            *pos = ctx->next;
+            ctx->next = NULL;
+            return true;
+        }
     }
-    else {
-        ctx->cur_chan = 0;
-        _sched_next(ctx);
+    return false;
+}
+
+/* must be called with interrupts disabled */
+static void _sched_next(void)
+{
+    uint32_t now;
+
+    if ((_cur != NULL) || (_queue == NULL)) {
+        return;
     }
+    /* events delayed by the ones of other contexts are started right away */
+    now = xtimer_now_usec();
+    xtimer_set(&_timer, _before(now, _queue->deadline)
+                        ? (_queue->deadline - now) : 0);
+}
+
+static void _send(void)
+{
+    _radio->context = _cur;
+    _ble_ctx.chan = _adv_chan[_cur->cur_chan];
+    netdev_ble_set_ctx(_radio, &_ble_ctx);
+    netdev_ble_send(_radio, &_cur->pkt);
+}
+
+static void _on_timer(void *arg)
+{
+    (void)arg;
+
+    if (_cur == NULL) {
+        if (_queue == NULL) {
+            return;
+        }
+        /* start the advertising event of the earliest deadline */
+        _cur = _queue;
+        _queue = _cur->next;
+        _cur->next = NULL;
+        _cur->cur_chan = 0;
+        _cur->last = xtimer_now_usec();
+    }
+    _send();
 }
 
 static void _on_radio_evt(netdev_t *netdev, netdev_event_t event)
 {
     (void)netdev;
 
-    if (event == NETDEV_EVENT_TX_COMPLETE) {
-        skald_ctx_t *ctx = _radio->context;
-        _stop_radio();
-        xtimer_set(&ctx->timer, 150);
+    if ((event != NETDEV_EVENT_TX_COMPLETE) || (_cur == NULL)) {
+        return;
     }
+    netdev_ble_stop(_radio);
+    _radio->context = NULL;
+
+    if (++_cur->cur_chan < ADV_CHAN_NUMOF) {
+        xtimer_set(&_timer, CHAN_SPACING);
+        return;
+    }
+    /* schedule the next advertising event of this context, adding a random
+     * advDelay between 0ms and 10ms (see spec v5.0-vol6-b-4.4.2.2.1) */
+    _cur->deadline = _cur->last + _cur->interval +
+                     random_uint32_range(JITTER_MIN, JITTER_MAX);
+    _enqueue(_cur);
+    _cur = NULL;
+    _sched_next();
 }
 
 void skald_init(void)
@@ -124,24 +179,42 @@ void skald_adv_start(skald_ctx_t *ctx)
     skald_adv_stop(ctx);
 
     /* initialize advertising context */
-    ctx->timer.callback = _on_adv_evt;
-    ctx->timer.arg = ctx;
-    ctx->last = xtimer_now_usec();
+    if (ctx->interval == 0) {
+        ctx->interval = SKALD_INTERVAL;
+    }
     ctx->cur_chan = 0;
     ctx->pkt.flags = (BLE_ADV_NONCON_IND | BLE_LL_FLAG_TXADD);
 
-    /* start advertising */
-    _sched_next(ctx);
+    /* start advertising after the random advDelay, this also spreads the
+     * first events of contexts started at the same time */
+    unsigned state = irq_disable();
+    ctx->deadline = xtimer_now_usec() +
+                    random_uint32_range(JITTER_MIN, JITTER_MAX);
+    _enqueue(ctx);
+    if ((_queue == ctx) && (_cur == NULL)) {
+        xtimer_remove(&_timer);
+        _sched_next();
+    }
+    irq_restore(state);
 }
 
 void skald_adv_stop(skald_ctx_t *ctx)
 {
     assert(ctx);
 
-    xtimer_remove(&ctx->timer);
-    if (_radio->context == (void *)ctx) {
-        _stop_radio();
+    unsigned state = irq_disable();
+    if (_cur == ctx) {
+        xtimer_remove(&_timer);
+        netdev_ble_stop(_radio);
+        _radio->context = NULL;
+        _cur = NULL;
+        _sched_next();
+    }
+    else if (_dequeue(ctx) && (_cur == NULL)) {
+        xtimer_remove(&_timer);
+        _sched_next();
     }
+    irq_restore(state);
 }
 
 void skald_generate_random_addr(uint8_t *buf)
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_phydat
+ * @{
+ *
+ * @file
+ * @brief       CBOR encoding of phydat_t values
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "cbor_enc.h"
+#include "phydat.h"
+
+void phydat_to_cbor(const phydat_t *data, uint8_t dim, cbor_enc_t *enc)
+{
+    assert(dim <= PHYDAT_DIM);
+
+    const char *unit = phydat_unit_to_str(data->unit);
+
+    cbor_enc_map(enc, (*unit != '\0') ? 2 : 1);
+    cbor_enc_str(enc, "v");
+    cbor_enc_array(enc, dim);
+    for (unsigned i = 0; i < dim; i++) {
+        if (data->scale == 0) {
+            cbor_enc_int(enc, data->val[i]);
+        }
+        else {
+            cbor_enc_decfrac(enc, data->val[i], data->scale);
+        }
+    }
+    if (*unit != '\0') {
+        cbor_enc_str(enc, "u");
+        cbor_enc_str(enc, unit);
+    }
+}
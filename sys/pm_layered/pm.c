@@ -18,9 +18,14 @@
  * @}
  */
 
+#include <stdbool.h>
+
 #include "irq.h"
 #include "periph/pm.h"
 #include "pm_layered.h"
+#ifdef MODULE_PM_LAYERED_GOVERNOR
+#include "xtimer.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -46,6 +51,29 @@ typedef union {
  */
 volatile pm_blocker_t pm_blocker = PM_BLOCKER_INITIAL;
 
+#ifdef MODULE_PM_LAYERED_GOVERNOR
+static const uint32_t _latency[PM_NUM_MODES] = PM_LATENCY_US;
+static pm_layered_stats_t _stats[PM_NUM_MODES + 1];
+
+/* returns the lowest mode starting at mode that pays off until the next
+ * timer fires */
+static unsigned _govern(unsigned mode)
+{
+    uint32_t idle = xtimer_usec_until_next();
+
+    while ((mode < PM_NUM_MODES) &&
+           (_latency[mode] > idle / PM_LAYERED_RESIDENCY_FACTOR)) {
+        mode++;
+    }
+    return mode;
+}
+
+const pm_layered_stats_t *pm_layered_stats(void)
+{
+    return _stats;
+}
+#endif
+
 void pm_set_lowest(void)
 {
     pm_blocker_t blocker = pm_blocker;
@@ -60,12 +88,37 @@ void pm_set_lowest(void)
     /* set lowest mode if blocker is still the same */
     unsigned state = irq_disable();
     if (blocker.val_u32 == pm_blocker.val_u32) {
+#ifdef MODULE_PM_LAYERED_GOVERNOR
+        mode = _govern(mode);
+        uint32_t start = xtimer_now_usec();
+#endif
+#ifdef MODULE_XTIMER_TICKLESS
+        bool tickless = false;
+        if (mode <= PM_TIMER_STOP_MODE) {
+            tickless = (xtimer_tickless_suspend(_latency[mode]) == 0);
+            if (!tickless) {
+                /* xtimer would lose time */
+                mode = PM_TIMER_STOP_MODE + 1;
+            }
+        }
+#endif
         DEBUG("pm: setting mode %u\n", mode);
         pm_set(mode);
+#ifdef MODULE_XTIMER_TICKLESS
+        if (tickless) {
+            xtimer_tickless_resume();
+        }
+#endif
+        irq_restore(state);
+#ifdef MODULE_PM_LAYERED_GOVERNOR
+        /* only the idle thread gets here, so no locking is needed */
+        _stats[mode].count++;
+        _stats[mode].residency_us += xtimer_now_usec() - start;
+#endif
+        return;
     }
-    else {
-        DEBUG("pm: mode block changed\n");
-    }
+
+    DEBUG("pm: mode block changed\n");
     irq_restore(state);
 }
 
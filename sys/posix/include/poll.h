@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_sockets
+ * @{
+ */
+
+/**
+ * @file
+ * @brief   Waiting for events on sockets
+ * @see     <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/poll.h.html">
+ *              The Open Group Base Specifications Issue 7, <poll.h>
+ *          </a>
+ *
+ * Only available with module `posix_poll`. Only datagram and raw sockets
+ * are supported, other file descriptors are reported with @ref POLLNVAL.
+ */
+#ifndef POLL_H
+#define POLL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Thread flag poll() waits for
+ *
+ * Set on the polling thread whenever one of the sockets it polls received a
+ * message.
+ */
+#ifndef POSIX_POLL_THREAD_FLAG
+#define POSIX_POLL_THREAD_FLAG  (1U << 13)
+#endif
+
+/**
+ * @name    Events of struct pollfd
+ * @{
+ */
+#define POLLIN      (0x0001)    /**< data other than high-priority data may
+                                 *   be read without blocking */
+#define POLLRDNORM  (0x0002)    /**< normal data may be read without
+                                 *   blocking */
+#define POLLRDBAND  (0x0004)    /**< priority data may be read without
+                                 *   blocking */
+#define POLLPRI     (0x0008)    /**< high-priority data may be read without
+                                 *   blocking */
+#define POLLOUT     (0x0010)    /**< normal data may be written without
+                                 *   blocking */
+#define POLLWRNORM  (POLLOUT)   /**< equivalent to @ref POLLOUT */
+#define POLLWRBAND  (0x0020)    /**< priority data may be written */
+#define POLLERR     (0x0040)    /**< an error has occurred (revents only) */
+#define POLLHUP     (0x0080)    /**< device has been disconnected (revents
+                                 *   only) */
+#define POLLNVAL    (0x0100)    /**< invalid file descriptor (revents only) */
+/** @} */
+
+/**
+ * @brief   Type for the number of file descriptors
+ */
+typedef unsigned int nfds_t;
+
+/**
+ * @brief   A file descriptor and the events to wait for
+ */
+struct pollfd {
+    int fd;                     /**< the file descriptor, ignored if
+                                 *   negative */
+    short events;               /**< the events to wait for */
+    short revents;              /**< the events that occurred */
+};
+
+/**
+ * @brief   Waits for events on a set of file descriptors
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/poll.html">
+ *          The Open Group Base Specification Issue 7, poll
+ *      </a>
+ *
+ * @param[in,out] fds   the file descriptors and the events to wait for
+ * @param[in] nfds      number of entries in @p fds
+ * @param[in] timeout   timeout in milliseconds, 0 to return immediately,
+ *                      -1 to wait forever
+ *
+ * @return  the number of entries in @p fds with events on success, 0 on
+ *          timeout
+ * @return  -1 on error, with errno set to EINVAL
+ */
+int poll(struct pollfd *fds, nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+/** @} */
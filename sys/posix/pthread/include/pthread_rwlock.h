@@ -21,6 +21,7 @@
 #include "thread.h"
 
 #include <errno.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 
 #ifdef __cplusplus
@@ -33,6 +34,10 @@ extern "C" {
  *            won't starve each other.
  *            E.g. no new readers will get into the critical section
  *            if a writer of the same or a higher priority already waits for the lock.
+ *
+ *            While no thread waits for the lock, readers take and release it
+ *            by changing pthread_rwlock_t::readers atomically, without
+ *            locking pthread_rwlock_t::mutex.
  */
 typedef struct
 {
@@ -43,7 +48,7 @@ typedef struct
      *            * `> 0`: the number of readers currently in the critical section.
      *            * `< 0`: a writer is currently in the critical section.
      */
-    int readers;
+    atomic_int readers;
 
     /**
      * @brief     Queue of waiting threads.
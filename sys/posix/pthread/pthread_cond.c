@@ -105,17 +105,37 @@ void _init_cond_wait(pthread_cond_t *cond, priority_queue_node_t *n)
     irq_restore(old_state);
 }
 
+/* wakes a waiter, or queues it on its mutex if that is locked (wait morphing),
+ * returns the priority to switch to or -1 */
+static int _wake(thread_t *thread)
+{
+    /* a waiter may be signaled before it went to sleep */
+    if ((thread->status == STATUS_SLEEPING) &&
+        _mutex_morph(thread->wait_data, thread)) {
+        /* the waiter holds the mutex when woken */
+        thread->wait_data = NULL;
+        return -1;
+    }
+    sched_set_status(thread, STATUS_PENDING);
+    return thread->priority;
+}
+
 int pthread_cond_wait(pthread_cond_t *cond, mutex_t *mutex)
 {
     if (cond == NULL) {
         return EINVAL;
     }
+    thread_t *me = (thread_t *)sched_active_thread;
     priority_queue_node_t n;
+
+    me->wait_data = mutex;
     _init_cond_wait(cond, &n);
 
     mutex_unlock_and_sleep(mutex);
 
-    mutex_lock(mutex);
+    if (me->wait_data != NULL) {
+        mutex_lock(mutex);
+    }
 
     return 0;
 }
@@ -130,7 +150,10 @@ int pthread_cond_timedwait(pthread_cond_t *cond, mutex_t *mutex, const struct ti
     uint64_t then = ((uint64_t)abstime->tv_sec * US_PER_SEC) +
                     (abstime->tv_nsec / NS_PER_US);
 
+    thread_t *me = (thread_t *)sched_active_thread;
     int ret = 0;
+
+    me->wait_data = mutex;
     if (then > now) {
         xtimer_t timer;
         priority_queue_node_t n;
@@ -154,7 +177,9 @@ int pthread_cond_timedwait(pthread_cond_t *cond, mutex_t *mutex, const struct ti
         mutex_unlock(mutex);
         ret = ETIMEDOUT;
     }
-    mutex_lock(mutex);
+    if (me->wait_data != NULL) {
+        mutex_lock(mutex);
+    }
     return ret;
 }
 
@@ -167,8 +192,7 @@ int pthread_cond_signal(pthread_cond_t *cond)
     if (head != NULL) {
         thread_t *other_thread = (thread_t *) sched_threads[head->data];
         if (other_thread) {
-            other_prio = other_thread->priority;
-            sched_set_status(other_thread, STATUS_PENDING);
+            other_prio = _wake(other_thread);
         }
         head->data = -1u;
     }
@@ -201,8 +225,11 @@ int pthread_cond_broadcast(pthread_cond_t *cond)
 
         thread_t *other_thread = (thread_t *) sched_threads[head->data];
         if (other_thread) {
-            other_prio = max_prio(other_prio, other_thread->priority);
-            sched_set_status(other_thread, STATUS_PENDING);
+            int prio = _wake(other_thread);
+
+            if (prio >= 0) {
+                other_prio = max_prio(other_prio, prio);
+            }
         }
         head->data = -1u;
     }
@@ -99,6 +99,42 @@ bool __pthread_rwlock_blocked_writingly(const pthread_rwlock_t *rwlock)
     return rwlock->readers != 0;
 }
 
+/* takes the lock for a reader without locking the mutex, if no one waits */
+static bool _rdlock_fast(pthread_rwlock_t *rwlock)
+{
+    int readers = atomic_load_explicit(&rwlock->readers, memory_order_relaxed);
+
+    /* do not pass by waiting writers */
+    while ((readers >= 0) && (rwlock->queue.first == NULL)) {
+        if (atomic_compare_exchange_weak_explicit(&rwlock->readers, &readers,
+                                                  readers + 1,
+                                                  memory_order_acquire,
+                                                  memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* takes the lock with the mutex locked, if it is not blocked */
+static bool _acquire(pthread_rwlock_t *rwlock,
+                     bool (*is_blocked)(const pthread_rwlock_t *rwlock),
+                     int incr_when_held)
+{
+    if (is_blocked(rwlock)) {
+        return false;
+    }
+    if (incr_when_held > 0) {
+        /* only writers holding the mutex decrease readers below 0 */
+        atomic_fetch_add(&rwlock->readers, 1);
+        return true;
+    }
+
+    /* a reader may have taken the lock on the fast path meanwhile */
+    int open = 0;
+    return atomic_compare_exchange_strong(&rwlock->readers, &open, -1);
+}
+
 static int pthread_rwlock_lock(pthread_rwlock_t *rwlock,
                                bool (*is_blocked)(const pthread_rwlock_t *rwlock),
                                bool is_writer,
@@ -111,11 +147,14 @@ static int pthread_rwlock_lock(pthread_rwlock_t *rwlock,
         return EINVAL;
     }
 
+    if (!is_writer && _rdlock_fast(rwlock)) {
+        return 0;
+    }
+
     mutex_lock(&rwlock->mutex);
-    if (!is_blocked(rwlock)) {
+    if (_acquire(rwlock, is_blocked, incr_when_held)) {
         DEBUG("Thread %" PRIkernel_pid ": pthread_rwlock_%s(): is_writer=%u, allow_spurious=%u %s\n",
               thread_getpid(), "lock", is_writer, allow_spurious, "is open");
-        rwlock->readers += incr_when_held;
     }
     else {
         DEBUG("Thread %" PRIkernel_pid ": pthread_rwlock_%s(): is_writer=%u, allow_spurious=%u %s\n",
@@ -167,16 +206,17 @@ static int pthread_rwlock_trylock(pthread_rwlock_t *rwlock,
         DEBUG("Thread %" PRIkernel_pid ": pthread_rwlock_%s(): rwlock=NULL supplied\n", thread_getpid(), "trylock");
         return EINVAL;
     }
+    else if ((incr_when_held > 0) && _rdlock_fast(rwlock)) {
+        return 0;
+    }
     else if (mutex_trylock(&rwlock->mutex) == 0) {
         return EBUSY;
     }
-    else if (is_blocked(rwlock)) {
+    else if (!_acquire(rwlock, is_blocked, incr_when_held)) {
         mutex_unlock(&rwlock->mutex);
         return EBUSY;
     }
 
-    rwlock->readers += incr_when_held;
-
     mutex_unlock(&rwlock->mutex);
     return 0;
 }
@@ -243,6 +283,17 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
         return EINVAL;
     }
 
+    /* a reader that is not the last one has no one to wake up */
+    int readers = atomic_load_explicit(&rwlock->readers, memory_order_relaxed);
+    while (readers > 1) {
+        if (atomic_compare_exchange_weak_explicit(&rwlock->readers, &readers,
+                                                  readers - 1,
+                                                  memory_order_release,
+                                                  memory_order_relaxed)) {
+            return 0;
+        }
+    }
+
     mutex_lock(&rwlock->mutex);
     if (rwlock->readers == 0) {
         /* the lock is open */
@@ -267,9 +318,18 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
         return 0;
     }
 
+    __pthread_rwlock_waiter_node_t *waiting_node = (__pthread_rwlock_waiter_node_t *) rwlock->queue.first->data;
+    int open = 0;
+    if (waiting_node->is_writer &&
+        !atomic_compare_exchange_strong(&rwlock->readers, &open, -1)) {
+        /* a reader took the lock on the fast path meanwhile, it wakes up the writer */
+        DEBUG("Thread %" PRIkernel_pid ": pthread_rwlock_%s(): lock taken by reader\n", thread_getpid(), "unlock");
+        mutex_unlock(&rwlock->mutex);
+        return 0;
+    }
+
     /* wake up the next thread */
     priority_queue_node_t *qnode = priority_queue_remove_head(&rwlock->queue);
-    __pthread_rwlock_waiter_node_t *waiting_node = (__pthread_rwlock_waiter_node_t *) qnode->data;
     waiting_node->continue_ = true;
     uint16_t prio = qnode->priority;
     sched_set_status(waiting_node->thread, STATUS_PENDING);
@@ -277,7 +337,6 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
     if (waiting_node->is_writer) {
         DEBUG("Thread %" PRIkernel_pid ": pthread_rwlock_%s(): continue %s %" PRIkernel_pid "\n",
               thread_getpid(), "unlock", "writer", waiting_node->thread->pid);
-        --rwlock->readers;
     }
     else {
         DEBUG("Thread %" PRIkernel_pid ": pthread_rwlock_%s(): continue %s %" PRIkernel_pid "\n",
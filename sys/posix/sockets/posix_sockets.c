@@ -36,6 +36,14 @@
 #include "net/sock/udp.h"
 #include "net/sock/tcp.h"
 
+#ifdef MODULE_POSIX_POLL
+#include "irq.h"
+#include "poll.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+#endif
+
 /* enough to create sockets both with socket() and accept() */
 #define _ACTUAL_SOCKET_POOL_SIZE   (SOCKET_POOL_SIZE + \
                                     (SOCKET_POOL_SIZE * SOCKET_TCP_QUEUE_SIZE))
@@ -79,6 +87,10 @@ typedef struct {
     unsigned queue_array_len;
 #endif
     sock_tcp_ep_t local;        /* to store bind before connect/listen */
+#ifdef MODULE_POSIX_POLL
+    unsigned available;         /* number of messages received */
+    thread_t *poller;           /* thread waiting in poll() */
+#endif
 } socket_t;
 
 static socket_t _socket_pool[_ACTUAL_SOCKET_POOL_SIZE];
@@ -100,6 +112,40 @@ static ssize_t socket_sendto(socket_t *s, const void *buffer, size_t length,
                              int flags, const struct sockaddr *address,
                              socklen_t address_len);
 
+#ifdef MODULE_POSIX_POLL
+static void _notify(socket_t *s)
+{
+    unsigned state = irq_disable();
+    thread_t *poller = s->poller;
+
+    s->available++;
+    irq_restore(state);
+    if (poller != NULL) {
+        thread_flags_set(poller, POSIX_POLL_THREAD_FLAG);
+    }
+}
+
+#ifdef MODULE_SOCK_IP
+static void _ip_cb(sock_ip_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    if (flags & SOCK_ASYNC_MSG_RECV) {
+        _notify(arg);
+    }
+}
+#endif
+
+#ifdef MODULE_SOCK_UDP
+static void _udp_cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)sock;
+    if (flags & SOCK_ASYNC_MSG_RECV) {
+        _notify(arg);
+    }
+}
+#endif
+#endif  /* MODULE_POSIX_POLL */
+
 static socket_t *_get_free_socket(void)
 {
     for (int i = 0; i < _ACTUAL_SOCKET_POOL_SIZE; i++) {
@@ -361,6 +407,10 @@ int socket(int domain, int type, int protocol)
             }
             s->bound = false;
             s->sock = NULL;
+#ifdef MODULE_POSIX_POLL
+            s->available = 0;
+            s->poller = NULL;
+#endif
 #ifdef POSIX_SETSOCKOPT
             s->recv_timeout = SOCK_NO_TIMEOUT;
 #endif
@@ -591,6 +641,23 @@ static int _bind_connect(socket_t *s, const struct sockaddr *address,
         return -1;
     }
     s->sock = sock;
+#ifdef MODULE_POSIX_POLL
+    s->available = 0;
+    switch (s->type) {
+#ifdef MODULE_SOCK_IP
+        case SOCK_RAW:
+            sock_ip_set_cb(&sock->raw, _ip_cb, s);
+            break;
+#endif
+#ifdef MODULE_SOCK_UDP
+        case SOCK_DGRAM:
+            sock_udp_set_cb(&sock->udp, _udp_cb, s);
+            break;
+#endif
+        default:
+            break;
+    }
+#endif
     return 0;
 }
 
@@ -863,6 +930,15 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
             res = -EOPNOTSUPP;
             break;
     }
+#ifdef MODULE_POSIX_POLL
+    if ((res >= 0) && (s->type != SOCK_STREAM)) {
+        unsigned state = irq_disable();
+        if (s->available > 0) {
+            s->available--;
+        }
+        irq_restore(state);
+    }
+#endif
     if ((res >= 0) && (address != NULL) && (address_len != NULL)) {
         switch (s->type) {
 #ifdef MODULE_SOCK_TCP
@@ -1046,6 +1122,90 @@ int setsockopt(int socket, int level, int option_name, const void *option_value,
 #endif
 }
 
+#ifdef MODULE_POSIX_POLL
+/* returns the number of entries with events, registers the polling thread
+ * with the sockets */
+static int _poll_check(struct pollfd *fds, nfds_t nfds, thread_t *poller)
+{
+    int res = 0;
+
+    for (nfds_t i = 0; i < nfds; i++) {
+        socket_t *s;
+
+        fds[i].revents = 0;
+        if (fds[i].fd < 0) {
+            continue;
+        }
+        mutex_lock(&_socket_pool_mutex);
+        s = _get_socket(fds[i].fd);
+        mutex_unlock(&_socket_pool_mutex);
+        /* sock_tcp does not report when it becomes ready */
+        if ((s == NULL) || ((s->type != SOCK_DGRAM) &&
+                            (s->type != SOCK_RAW))) {
+            fds[i].revents = POLLNVAL;
+            res++;
+            continue;
+        }
+        unsigned state = irq_disable();
+        s->poller = poller;
+        if (s->available > 0) {
+            fds[i].revents |= (fds[i].events & (POLLIN | POLLRDNORM));
+        }
+        irq_restore(state);
+        /* datagrams are sent right away */
+        fds[i].revents |= (fds[i].events & (POLLOUT | POLLWRNORM));
+        if (fds[i].revents) {
+            res++;
+        }
+    }
+    return res;
+}
+
+int poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+    xtimer_t timer;
+    int res;
+
+    if ((fds == NULL) && (nfds > 0)) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (timeout > 0) {
+        xtimer_set_timeout_flag(&timer, (uint32_t)timeout * US_PER_MS);
+    }
+    while (1) {
+        /* cleared before checking, so no notification in between is lost */
+        thread_flags_clear(POSIX_POLL_THREAD_FLAG);
+        res = _poll_check(fds, nfds, me);
+        if ((res != 0) || (timeout == 0)) {
+            break;
+        }
+        if (thread_flags_wait_any(POSIX_POLL_THREAD_FLAG |
+                                  THREAD_FLAG_TIMEOUT) & THREAD_FLAG_TIMEOUT) {
+            res = _poll_check(fds, nfds, me);
+            break;
+        }
+    }
+    if (timeout > 0) {
+        xtimer_remove(&timer);
+        thread_flags_clear(THREAD_FLAG_TIMEOUT);
+    }
+    /* unregister from the sockets again */
+    for (nfds_t i = 0; i < nfds; i++) {
+        socket_t *s;
+
+        mutex_lock(&_socket_pool_mutex);
+        s = (fds[i].fd < 0) ? NULL : _get_socket(fds[i].fd);
+        mutex_unlock(&_socket_pool_mutex);
+        if ((s != NULL) && (s->poller == me)) {
+            s->poller = NULL;
+        }
+    }
+    return res;
+}
+#endif  /* MODULE_POSIX_POLL */
+
 /**
  * @}
  */
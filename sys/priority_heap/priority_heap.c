@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_priority_heap
+ * @{
+ *
+ * @file
+ * @brief       Pairing heap implementation
+ *
+ * The children of a node form a list through next and prev, with prev of the
+ * first child pointing to the parent. The root has neither siblings nor a
+ * parent.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include "priority_heap.h"
+
+/* order of removal: by priority, then by the order of adding */
+static inline bool _before(const priority_heap_node_t *a,
+                           const priority_heap_node_t *b)
+{
+    if (a->priority != b->priority) {
+        return a->priority < b->priority;
+    }
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+/* joins two trees, the one with the later root becomes the first child */
+static priority_heap_node_t *_meld(priority_heap_node_t *a,
+                                   priority_heap_node_t *b)
+{
+    if (a == NULL) {
+        return b;
+    }
+    if (b == NULL) {
+        return a;
+    }
+    if (_before(b, a)) {
+        priority_heap_node_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    b->prev = a;
+    a->child = b;
+    a->next = NULL;
+    a->prev = NULL;
+    return a;
+}
+
+/* joins a list of siblings to a tree: pairwise from the first to the last,
+ * then the pairs from the last to the first */
+static priority_heap_node_t *_merge_pairs(priority_heap_node_t *first)
+{
+    priority_heap_node_t *pairs = NULL;
+
+    while (first) {
+        priority_heap_node_t *a = first;
+        priority_heap_node_t *b = a->next;
+
+        first = (b) ? b->next : NULL;
+        a->next = NULL;
+        a->prev = NULL;
+        if (b) {
+            b->next = NULL;
+            b->prev = NULL;
+        }
+        a = _meld(a, b);
+        /* the pairs are collected in reverse order */
+        a->next = pairs;
+        pairs = a;
+    }
+
+    priority_heap_node_t *root = NULL;
+
+    while (pairs) {
+        priority_heap_node_t *next = pairs->next;
+
+        pairs->next = NULL;
+        root = _meld(root, pairs);
+        pairs = next;
+    }
+    return root;
+}
+
+void priority_heap_add(priority_heap_t *heap, priority_heap_node_t *node)
+{
+    assert(node != heap->root);
+    node->next = NULL;
+    node->prev = NULL;
+    node->child = NULL;
+    node->seq = heap->seq++;
+    heap->root = _meld(heap->root, node);
+    heap->numof++;
+}
+
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *heap)
+{
+    priority_heap_node_t *head = heap->root;
+
+    if (head) {
+        heap->root = _merge_pairs(head->child);
+        head->child = NULL;
+        heap->numof--;
+    }
+    return head;
+}
+
+void priority_heap_remove(priority_heap_t *heap, priority_heap_node_t *node)
+{
+    if (node == heap->root) {
+        priority_heap_remove_head(heap);
+        return;
+    }
+    assert(node->prev != NULL);
+
+    /* cut the subtree of node */
+    if (node->prev->child == node) {
+        node->prev->child = node->next;
+    }
+    else {
+        node->prev->next = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+    node->next = NULL;
+    node->prev = NULL;
+
+    heap->root = _meld(heap->root, _merge_pairs(node->child));
+    node->child = NULL;
+    heap->numof--;
+}
+
+static priority_heap_node_t *_parent(const priority_heap_node_t *node)
+{
+    /* move to the first sibling, whose prev is the parent */
+    while (node->prev && (node->prev->next == node)) {
+        node = node->prev;
+    }
+    return node->prev;
+}
+
+priority_heap_node_t *priority_heap_last(const priority_heap_t *heap)
+{
+    priority_heap_node_t *last = heap->root;
+    priority_heap_node_t *node = heap->root;
+
+    /* depth-first walk, the tree is not ordered among siblings */
+    while (node) {
+        if (_before(last, node)) {
+            last = node;
+        }
+        if (node->child) {
+            node = node->child;
+            continue;
+        }
+        while (node && (node->next == NULL)) {
+            node = _parent(node);
+        }
+        if (node) {
+            node = node->next;
+        }
+    }
+    return last;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_profiler
+ * @{
+ *
+ * @file
+ * @brief       Sampling profiler implementation
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "cpu.h"
+#include "irq.h"
+#include "sched.h"
+#include "profiler.h"
+#ifdef CPU_NATIVE
+#include "native_internal.h"
+#endif
+
+#if (PROFILER_SLOTS & (PROFILER_SLOTS - 1)) != 0
+#error "PROFILER_SLOTS must be a power of two"
+#endif
+
+/* number of slots probed before a sample is dropped */
+#define PROBES              (8U)
+
+typedef struct {
+    uintptr_t pc;           /* program counter, 0 for an unused slot */
+    kernel_pid_t pid;       /* thread the sample was taken in */
+    uint32_t count;         /* number of samples */
+} _slot_t;
+
+static _slot_t _slots[PROFILER_SLOTS];
+static uint32_t _isr_samples;
+static uint32_t _dropped;
+static volatile bool _enabled;
+
+/* returns 0 if the interrupted code was not a thread */
+static uintptr_t _interrupted_pc(void)
+{
+#if defined(CPU_NATIVE)
+    /* signals are blocked while an interrupt is handled, so this is always
+     * the PC of a thread */
+    return _native_saved_eip;
+#elif defined(MODULE_CORTEXM_COMMON)
+#ifdef SCB_ICSR_RETTOBASE_Msk
+    /* threads run on the process stack, only if no other exception is active
+     * the topmost frame on it belongs to this interrupt */
+    if (!(SCB->ICSR & SCB_ICSR_RETTOBASE_Msk)) {
+        return 0;
+    }
+#endif
+    /* the PC is the seventh word of the exception stack frame */
+    return ((uint32_t *)__get_PSP())[6];
+#else
+    return 0;
+#endif
+}
+
+static void _count(uintptr_t pc, kernel_pid_t pid)
+{
+    /* the lowest bits of the PC carry little information */
+    unsigned hash = (unsigned)((pc >> 1) ^ (pc >> 9) ^ ((unsigned)pid << 4));
+
+    for (unsigned i = 0; i < PROBES; i++) {
+        _slot_t *slot = &_slots[(hash + i) & (PROFILER_SLOTS - 1)];
+
+        if (slot->pc == 0) {
+            slot->pc = pc;
+            slot->pid = pid;
+        }
+        if ((slot->pc == pc) && (slot->pid == pid)) {
+            slot->count++;
+            return;
+        }
+    }
+    _dropped++;
+}
+
+static void _sample(void *arg, int channel)
+{
+    (void)arg;
+
+    timer_set(PROFILER_TIMER, channel, PROFILER_INTERVAL);
+    if (!_enabled) {
+        return;
+    }
+
+    uintptr_t pc = _interrupted_pc();
+    if (pc == 0) {
+        _isr_samples++;
+    }
+    else {
+        _count(pc, sched_active_pid);
+    }
+}
+
+int profiler_init(void)
+{
+    if (timer_init(PROFILER_TIMER, PROFILER_TIMER_FREQ, _sample, NULL) < 0) {
+        puts("profiler: unable to initialize timer");
+        return -1;
+    }
+    profiler_start();
+    timer_set(PROFILER_TIMER, PROFILER_TIMER_CHAN, PROFILER_INTERVAL);
+    return 0;
+}
+
+void profiler_start(void)
+{
+    _enabled = true;
+}
+
+void profiler_stop(void)
+{
+    _enabled = false;
+}
+
+void profiler_reset(void)
+{
+    unsigned state = irq_disable();
+
+    for (unsigned i = 0; i < PROFILER_SLOTS; i++) {
+        _slots[i].pc = 0;
+        _slots[i].count = 0;
+    }
+    _isr_samples = 0;
+    _dropped = 0;
+    irq_restore(state);
+}
+
+void profiler_dump(void)
+{
+    bool enabled = _enabled;
+    uint32_t total = _isr_samples;
+
+    _enabled = false;
+    puts("profiler: pid pc count");
+    for (unsigned i = 0; i < PROFILER_SLOTS; i++) {
+        const _slot_t *slot = &_slots[i];
+
+        if (slot->pc != 0) {
+            printf("%d 0x%08" PRIxPTR " %" PRIu32 "\n",
+                   (int)slot->pid, slot->pc, slot->count);
+            total += slot->count;
+        }
+    }
+    printf("profiler: %" PRIu32 " samples, %" PRIu32 " in isr, "
+           "%" PRIu32 " dropped\n", total + _dropped, _isr_samples, _dropped);
+    _enabled = enabled;
+}
@@ -16,6 +16,7 @@
  */
 
 #include <stdio.h>
+#include <inttypes.h>
 
 #include "thread.h"
 #include "sched.h"
@@ -150,3 +151,44 @@ void ps(void)
 #   endif
 #endif
 }
+
+#ifdef MODULE_SCHEDSTATISTICS
+void ps_latency(void)
+{
+    printf("\tpid | "
+#ifdef DEVELHELP
+           "%-21s| "
+#endif
+           "wakeups  | preempt  | max lat. | histogram (log2 ticks)\n"
+#ifdef DEVELHELP
+           , "name"
+#endif
+          );
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        thread_t *p = (thread_t *)sched_threads[i];
+
+        if (p != NULL) {
+            schedstat *stat = &sched_pidlist[i];
+            int last = SCHEDSTAT_LATENCY_BUCKETS - 1;
+            while ((last > 0) && !stat->latency_hist[last]) {
+                last--;
+            }
+            printf("\t%3" PRIkernel_pid
+#ifdef DEVELHELP
+                   " | %-20s"
+#endif
+                   " | %8u | %8u | %8" PRIu32 " |",
+                   p->pid,
+#ifdef DEVELHELP
+                   p->name,
+#endif
+                   stat->wakeups, stat->preemptions, stat->latency_max);
+            for (int b = 0; b <= last; b++) {
+                printf(" %u", stat->latency_hist[b]);
+            }
+            puts("");
+        }
+    }
+}
+#endif /* MODULE_SCHEDSTATISTICS */
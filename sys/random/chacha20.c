@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+ /**
+ * @ingroup sys_random
+ * @{
+ * @file
+ *
+ * @brief   ChaCha20 based CSPRNG
+ *
+ * The generator uses fast key erasure: each refill of the buffer produces a
+ * ChaCha20 block, whose first half is the next key and whose second half is
+ * handed out. Handed out bytes are erased from the buffer, so the state never
+ * reveals earlier output. Bulk requests are served with whole keystream
+ * blocks, followed by a single key change.
+ *
+ * With `periph_hwrng`, entropy from the hardware RNG is mixed into the key
+ * after each @ref PRNG_CHACHA20_RESEED_INTERVAL bytes of output.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crypto/chacha.h"
+#include "mutex.h"
+#include "random.h"
+#ifdef MODULE_PERIPH_HWRNG
+#include "periph/hwrng.h"
+#endif
+
+#define KEY_SIZE        (32U)
+#define BLOCK_SIZE      (64U)
+#define ROUNDS          (20U)
+
+static const uint8_t _nonce[8];
+static chacha_ctx _ctx;
+static uint32_t _buf[BLOCK_SIZE / sizeof(uint32_t)];
+/* bytes of _buf handed out or used as key */
+static unsigned _pos = BLOCK_SIZE;
+#ifdef MODULE_PERIPH_HWRNG
+static uint32_t _output;
+#endif
+static mutex_t _lock = MUTEX_INIT;
+
+/* generates a block, its first half, XORed with data, becomes the key */
+static void _rekey(const uint8_t *data, size_t len)
+{
+    uint8_t *key = (uint8_t *)_buf;
+
+    chacha_keystream_bytes(&_ctx, _buf);
+    for (size_t i = 0; i < len; i++) {
+        key[i % KEY_SIZE] ^= data[i];
+    }
+    chacha_init(&_ctx, ROUNDS, key, KEY_SIZE, _nonce);
+    memset(key, 0, KEY_SIZE);
+    _pos = KEY_SIZE;
+}
+
+static void _count(size_t bytes)
+{
+#ifdef MODULE_PERIPH_HWRNG
+    _output += bytes;
+    if (_output >= PRNG_CHACHA20_RESEED_INTERVAL) {
+        uint8_t entropy[KEY_SIZE];
+
+        _output = 0;
+        hwrng_read(entropy, sizeof(entropy));
+        _rekey(entropy, sizeof(entropy));
+        memset(entropy, 0, sizeof(entropy));
+    }
+#else
+    (void)bytes;
+#endif
+}
+
+static void _seed(const void *data, size_t len)
+{
+    mutex_lock(&_lock);
+    memset(_buf, 0, sizeof(_buf));
+    chacha_init(&_ctx, ROUNDS, (uint8_t *)_buf, KEY_SIZE, _nonce);
+    _rekey(data, len);
+    mutex_unlock(&_lock);
+}
+
+void random_init(uint32_t s)
+{
+    _seed(&s, sizeof(s));
+}
+
+void random_init_by_array(uint32_t init_key[], int key_length)
+{
+    _seed(init_key, sizeof(uint32_t) * key_length);
+}
+
+void random_bytes(uint8_t *buf, size_t size)
+{
+    uint8_t *data = (uint8_t *)_buf;
+
+    mutex_lock(&_lock);
+    _count(size);
+
+    /* serve whole blocks directly from the keystream */
+    if (size >= BLOCK_SIZE) {
+        while (size >= BLOCK_SIZE) {
+            chacha_keystream_bytes(&_ctx, _buf);
+            memcpy(buf, _buf, BLOCK_SIZE);
+            buf += BLOCK_SIZE;
+            size -= BLOCK_SIZE;
+        }
+        _rekey(NULL, 0);
+    }
+
+    while (size > 0) {
+        if (_pos == BLOCK_SIZE) {
+            _rekey(NULL, 0);
+        }
+        size_t chunk = BLOCK_SIZE - _pos;
+        if (chunk > size) {
+            chunk = size;
+        }
+        memcpy(buf, &data[_pos], chunk);
+        memset(&data[_pos], 0, chunk);
+        _pos += chunk;
+        buf += chunk;
+        size -= chunk;
+    }
+    mutex_unlock(&_lock);
+}
+
+uint32_t random_uint32(void)
+{
+    uint32_t res;
+
+    random_bytes((uint8_t *)&res, sizeof(res));
+    return res;
+}
@@ -77,7 +77,7 @@ static void _read(uint8_t *out, size_t bytes)
         /* advance bytes and buffer */
         bytes -= chunk;
         out += chunk;
-    } while (bytes > FORTUNA_RESEED_LIMIT);
+    } while (bytes > 0);
 }
 
 void random_init_by_array(uint32_t init_key[], int key_length)
@@ -98,3 +98,11 @@ uint32_t random_uint32(void)
 
     return data;
 }
+
+void random_bytes(uint8_t *buf, size_t size)
+{
+    /* a single request re-keys the generator once */
+    if (size > 0) {
+        _read(buf, size);
+    }
+}
@@ -18,6 +18,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "log.h"
 #include "luid.h"
@@ -26,12 +27,24 @@
 #ifdef MODULE_PUF_SRAM
 #include "puf_sram.h"
 #endif
+#ifdef MODULE_PERIPH_HWRNG
+#include "periph/hwrng.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 void auto_init_random(void)
 {
+#ifdef MODULE_PERIPH_HWRNG
+    /* the hardware RNG provides a seed as large as a generator may use */
+    uint32_t key[RANDOM_SEED_HWRNG_WORDS];
+
+    hwrng_read(key, sizeof(key));
+    DEBUG("random: using %u words from the hwrng\n",
+          (unsigned)RANDOM_SEED_HWRNG_WORDS);
+    random_init_by_array(key, RANDOM_SEED_HWRNG_WORDS);
+#else
     uint32_t seed;
 #ifdef MODULE_PUF_SRAM
     /* TODO: hand state to application? */
@@ -47,22 +60,27 @@ void auto_init_random(void)
 #endif
     DEBUG("random: using seed value %u\n", (unsigned)seed);
     random_init(seed);
+#endif
 }
 
+/* these generators produce bytes natively and implement random_bytes() */
+#if !defined(MODULE_PRNG_FORTUNA) && !defined(MODULE_PRNG_SHA1PRNG) && \
+    !defined(MODULE_PRNG_CHACHA20)
 void random_bytes(uint8_t *target, size_t n)
 {
     uint32_t random;
-    uint8_t *random_pos = (uint8_t*)&random;
-    unsigned _n = 0;
 
-    while (n--) {
-        if (! (_n++ & 0x3)) {
-            random = random_uint32();
-            random_pos = (uint8_t *) &random;
-        }
-        *target++ = *random_pos++;
+    for (; n >= sizeof(random); n -= sizeof(random)) {
+        random = random_uint32();
+        memcpy(target, &random, sizeof(random));
+        target += sizeof(random);
+    }
+    if (n > 0) {
+        random = random_uint32();
+        memcpy(target, &random, n);
     }
 }
+#endif
 
 uint32_t random_uint32_range(uint32_t a, uint32_t b)
 {
@@ -24,6 +24,7 @@
 #include <string.h>
 
 #include "hashes/sha1.h"
+#include "random.h"
 
 #define SEED_SIZE           (20)
 
@@ -65,7 +66,7 @@ void _updatestate(int8_t *state)
     sha1_update(&ctx, (void *)state, sizeof(state));
 }
 
-void _random_bytes(uint8_t *bytes, size_t size) /* TODO: use with global API */
+void random_bytes(uint8_t *bytes, size_t size)
 {
     uint32_t loc = 0;
     while (loc < size)
@@ -132,7 +133,7 @@ uint32_t random_uint32(void)
 {
     uint32_t ret;
     int8_t bytes[sizeof(uint32_t)];
-    _random_bytes((uint8_t *)bytes, sizeof(uint32_t));
+    random_bytes((uint8_t *)bytes, sizeof(uint32_t));
 
     ret = ((bytes[0] & 0xff) << 24)
         | ((bytes[1] & 0xff) << 16)
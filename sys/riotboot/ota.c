@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_riotboot_ota
+ * @{
+ *
+ * @file
+ * @brief       Streaming firmware image writer implementation
+ *
+ * The data passes the decompressor, the delta decoder and the page buffer,
+ * each taking the output of the previous one as it comes.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "riotboot/ota.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static uint32_t _le32(const uint8_t *buf)
+{
+    return buf[0] | (buf[1] << 8) | ((uint32_t)buf[2] << 16) |
+           ((uint32_t)buf[3] << 24);
+}
+
+static int _flush(riotboot_ota_t *ota)
+{
+    uint8_t *page = (uint8_t *)ota->page;
+    unsigned idx = (ota->offset - 1) / FLASHPAGE_SIZE;
+    size_t fill = ota->offset - (idx * FLASHPAGE_SIZE);
+
+    memset(page + fill, 0xff, FLASHPAGE_SIZE - fill);
+    if (idx == 0) {
+        /* keep the header erased until the image is verified */
+        memcpy(ota->hold, page, sizeof(ota->hold));
+        memset(page, 0xff, sizeof(ota->hold));
+    }
+    DEBUG("riotboot_ota: write page %u\n", ota->first + idx);
+    if (flashpage_write_and_verify(ota->first + idx, page) != FLASHPAGE_OK) {
+        return -EIO;
+    }
+    return 0;
+}
+
+static int _emit(riotboot_ota_t *ota, const uint8_t *data, size_t len)
+{
+    while (len > 0) {
+        size_t pos = ota->offset % FLASHPAGE_SIZE;
+        size_t chunk = FLASHPAGE_SIZE - pos;
+
+        if (ota->offset >= (ota->numof * FLASHPAGE_SIZE)) {
+            return -EFBIG;
+        }
+        if (chunk > len) {
+            chunk = len;
+        }
+        memcpy((uint8_t *)ota->page + pos, data, chunk);
+        sha256_update(&ota->sha, data, chunk);
+        ota->offset += chunk;
+        data += chunk;
+        len -= chunk;
+        if ((ota->offset % FLASHPAGE_SIZE) == 0) {
+            int res = _flush(ota);
+            if (res < 0) {
+                return res;
+            }
+        }
+    }
+    return 0;
+}
+
+static int _delta(riotboot_ota_t *ota, const uint8_t *data, size_t len)
+{
+    if (!(ota->flags & RIOTBOOT_OTA_DELTA)) {
+        return _emit(ota, data, len);
+    }
+    while (len > 0) {
+        int res;
+
+        if (ota->insert > 0) {
+            size_t chunk = (len < ota->insert) ? len : ota->insert;
+
+            res = _emit(ota, data, chunk);
+            if (res < 0) {
+                return res;
+            }
+            ota->insert -= chunk;
+            data += chunk;
+            len -= chunk;
+            continue;
+        }
+
+        ota->op[ota->op_len++] = *data++;
+        len--;
+        if ((ota->op[0] != RIOTBOOT_OTA_OP_COPY) &&
+            (ota->op[0] != RIOTBOOT_OTA_OP_INSERT)) {
+            return -EINVAL;
+        }
+        if (ota->op_len < ((ota->op[0] == RIOTBOOT_OTA_OP_COPY) ? 9 : 5)) {
+            continue;
+        }
+        ota->op_len = 0;
+
+        uint32_t op_len = _le32(&ota->op[1]);
+        if (ota->op[0] == RIOTBOOT_OTA_OP_INSERT) {
+            ota->insert = op_len;
+            continue;
+        }
+
+        uint32_t src_off = _le32(&ota->op[5]);
+        if ((src_off > ota->src_len) || (op_len > (ota->src_len - src_off))) {
+            return -EINVAL;
+        }
+        res = _emit(ota, ota->src + src_off, op_len);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+#ifdef MODULE_HEATSHRINK
+static int _drain(riotboot_ota_t *ota)
+{
+    uint8_t buf[32];
+    HSD_poll_res poll;
+
+    do {
+        size_t n;
+        int res;
+
+        poll = heatshrink_decoder_poll(&ota->hsd, buf, sizeof(buf), &n);
+        if (poll < 0) {
+            return -EINVAL;
+        }
+        res = _delta(ota, buf, n);
+        if (res < 0) {
+            return res;
+        }
+    } while (poll == HSDR_POLL_MORE);
+    return 0;
+}
+#endif
+
+int riotboot_ota_init(riotboot_ota_t *ota, unsigned first, unsigned numof,
+                      unsigned flags, const void *src, size_t src_len)
+{
+#ifndef MODULE_HEATSHRINK
+    if (flags & RIOTBOOT_OTA_COMPRESSED) {
+        return -ENOTSUP;
+    }
+#endif
+    if ((numof == 0) || (first >= FLASHPAGE_NUMOF) ||
+        (numof > (FLASHPAGE_NUMOF - first))) {
+        return -EINVAL;
+    }
+
+    memset(ota, 0, offsetof(riotboot_ota_t, page));
+    sha256_init(&ota->sha);
+#ifdef MODULE_HEATSHRINK
+    heatshrink_decoder_reset(&ota->hsd);
+#endif
+    ota->src = src;
+    ota->src_len = (src != NULL) ? src_len : 0;
+    ota->first = first;
+    ota->numof = numof;
+    ota->flags = flags;
+
+    /* invalidate the image there */
+    flashpage_write(first, NULL);
+    return 0;
+}
+
+int riotboot_ota_write(riotboot_ota_t *ota, const void *data, size_t len)
+{
+    const uint8_t *in = data;
+
+#ifdef MODULE_HEATSHRINK
+    if (ota->flags & RIOTBOOT_OTA_COMPRESSED) {
+        while (len > 0) {
+            size_t sunk;
+
+            if (heatshrink_decoder_sink(&ota->hsd, (uint8_t *)in, len,
+                                        &sunk) < 0) {
+                return -EINVAL;
+            }
+            in += sunk;
+            len -= sunk;
+            int res = _drain(ota);
+            if (res < 0) {
+                return res;
+            }
+        }
+        return 0;
+    }
+#endif
+    return _delta(ota, in, len);
+}
+
+int riotboot_ota_finish(riotboot_ota_t *ota,
+                        const uint8_t digest[SHA256_DIGEST_LENGTH])
+{
+    uint8_t res_digest[SHA256_DIGEST_LENGTH];
+    int res;
+
+#ifdef MODULE_HEATSHRINK
+    if (ota->flags & RIOTBOOT_OTA_COMPRESSED) {
+        HSD_finish_res fin;
+
+        while ((fin = heatshrink_decoder_finish(&ota->hsd)) ==
+               HSDR_FINISH_MORE) {
+            res = _drain(ota);
+            if (res < 0) {
+                return res;
+            }
+        }
+        if (fin < 0) {
+            return -EINVAL;
+        }
+    }
+#endif
+    if ((ota->op_len > 0) || (ota->insert > 0) ||
+        (ota->offset < RIOTBOOT_OTA_HOLD)) {
+        return -EINVAL;
+    }
+    if (ota->offset % FLASHPAGE_SIZE) {
+        res = _flush(ota);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    sha256_final(&ota->sha, res_digest);
+    if (memcmp(res_digest, digest, sizeof(res_digest)) != 0) {
+        DEBUG("riotboot_ota: digest mismatch\n");
+        return -EBADMSG;
+    }
+
+    /* rewrite the first page with its header */
+    flashpage_read(ota->first, ota->page);
+    memcpy(ota->page, ota->hold, sizeof(ota->hold));
+    if (flashpage_write_and_verify(ota->first, ota->page) != FLASHPAGE_OK) {
+        return -EIO;
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_riotboot_verify
+ * @{
+ *
+ * @file
+ * @brief       Cached image verification
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "riotboot/verify.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static void _mac(const riotboot_verify_marker_t *marker,
+                 const riotboot_hdr_t *hdr, const void *key, size_t key_len,
+                 uint8_t mac[SHA256_DIGEST_LENGTH])
+{
+    hmac_context_t hmac;
+
+    hmac_sha256_init(&hmac, key, key_len);
+    hmac_sha256_update(&hmac, marker, offsetof(riotboot_verify_marker_t, mac));
+    hmac_sha256_update(&hmac, hdr, sizeof(*hdr));
+    hmac_sha256_final(&hmac, mac);
+}
+
+/* compares in constant time, so the MAC cannot be guessed byte by byte */
+static int _equal(const uint8_t *a, const uint8_t *b, size_t len)
+{
+    uint8_t diff = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+int riotboot_verify_check(const riotboot_verify_marker_t *marker,
+                          const riotboot_hdr_t *hdr, size_t len,
+                          const void *key, size_t key_len)
+{
+    uint8_t mac[SHA256_DIGEST_LENGTH];
+
+    if ((marker->magic != RIOTBOOT_VERIFY_MAGIC) || (marker->len != len)) {
+        return -EBADMSG;
+    }
+    _mac(marker, hdr, key, key_len, mac);
+    return _equal(mac, marker->mac, sizeof(mac)) ? 0 : -EBADMSG;
+}
+
+int riotboot_verify(riotboot_verify_marker_t *marker,
+                    const riotboot_hdr_t *hdr, size_t len,
+                    const uint8_t digest[SHA256_DIGEST_LENGTH],
+                    const void *key, size_t key_len)
+{
+    if ((riotboot_verify_check(marker, hdr, len, key, key_len) == 0) &&
+        _equal(marker->digest, digest, SHA256_DIGEST_LENGTH)) {
+        return RIOTBOOT_VERIFY_CACHED;
+    }
+
+    DEBUG("riotboot_verify: no valid marker, hashing %u bytes\n",
+          (unsigned)len);
+    riotboot_verify_clear(marker);
+    if ((len < sizeof(*hdr)) || (riotboot_hdr_validate(hdr) != 0)) {
+        return -EBADMSG;
+    }
+    sha256(hdr, len, marker->digest);
+    if (!_equal(marker->digest, digest, SHA256_DIGEST_LENGTH)) {
+        DEBUG("riotboot_verify: digest mismatch\n");
+        memset(marker->digest, 0, sizeof(marker->digest));
+        return -EBADMSG;
+    }
+
+    marker->magic = RIOTBOOT_VERIFY_MAGIC;
+    marker->len = len;
+    _mac(marker, hdr, key, key_len, marker->mac);
+    return RIOTBOOT_VERIFY_FULL;
+}
+
+void riotboot_verify_clear(riotboot_verify_marker_t *marker)
+{
+    memset(marker, 0, sizeof(*marker));
+}
@@ -18,6 +18,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
@@ -30,6 +31,96 @@
  */
 saul_reg_t *saul_reg = NULL;
 
+#ifdef MODULE_SAUL_REG_INDEX
+/* compares the type or name of a device to a key */
+typedef int (*_cmp_t)(const saul_reg_t *dev, const void *key);
+
+static saul_reg_t *_by_pos[SAUL_REG_INDEX_NUMOF];
+static saul_reg_t *_by_type[SAUL_REG_INDEX_NUMOF];
+static saul_reg_t *_by_name[SAUL_REG_INDEX_NUMOF];
+static unsigned _numof;
+/* more devices are registered than the index holds, so it is not used */
+static bool _overflow;
+
+static int _cmp_type(const saul_reg_t *dev, const void *key)
+{
+    return (int)dev->driver->type - *(const uint8_t *)key;
+}
+
+static int _cmp_name(const saul_reg_t *dev, const void *key)
+{
+    return strcmp(dev->name, key);
+}
+
+/* returns the first entry not less (upper: greater) than key */
+static unsigned _bound(saul_reg_t *const *idx, _cmp_t cmp, const void *key,
+                       bool upper)
+{
+    unsigned lo = 0;
+    unsigned hi = _numof;
+
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        int res = cmp(idx[mid], key);
+
+        if ((res < 0) || (upper && (res == 0))) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void _insert(saul_reg_t **idx, unsigned pos, saul_reg_t *dev)
+{
+    memmove(&idx[pos + 1], &idx[pos], (_numof - pos) * sizeof(*idx));
+    idx[pos] = dev;
+}
+
+static void _remove(saul_reg_t **idx, saul_reg_t *dev)
+{
+    unsigned pos = 0;
+
+    while (idx[pos] != dev) {
+        pos++;
+    }
+    memmove(&idx[pos], &idx[pos + 1], (_numof - pos - 1) * sizeof(*idx));
+}
+
+/* keeps entries of the same type or name in the order of registration */
+static void _index_add(saul_reg_t *dev)
+{
+    if (_numof == SAUL_REG_INDEX_NUMOF) {
+        _overflow = true;
+        return;
+    }
+    _by_pos[_numof] = dev;
+    _insert(_by_type, _bound(_by_type, _cmp_type, &dev->driver->type, true),
+            dev);
+    _insert(_by_name, _bound(_by_name, _cmp_name, dev->name, true), dev);
+    _numof++;
+}
+
+static void _index_rm(saul_reg_t *dev)
+{
+    if (_overflow) {
+        /* rebuild, in case all of the devices fit in again */
+        _numof = 0;
+        _overflow = false;
+        for (saul_reg_t *tmp = saul_reg; tmp; tmp = tmp->next) {
+            _index_add(tmp);
+        }
+        return;
+    }
+    _remove(_by_pos, dev);
+    _remove(_by_type, dev);
+    _remove(_by_name, dev);
+    _numof--;
+}
+#endif
+
 
 int saul_reg_add(saul_reg_t *dev)
 {
@@ -51,6 +142,9 @@ int saul_reg_add(saul_reg_t *dev)
         }
         tmp->next = dev;
     }
+#ifdef MODULE_SAUL_REG_INDEX
+    _index_add(dev);
+#endif
     return 0;
 }
 
@@ -63,6 +157,9 @@ int saul_reg_rm(saul_reg_t *dev)
     }
     if (saul_reg == dev) {
         saul_reg = dev->next;
+#ifdef MODULE_SAUL_REG_INDEX
+        _index_rm(dev);
+#endif
         return 0;
     }
     while (tmp->next && (tmp->next != dev)) {
@@ -74,11 +171,19 @@ int saul_reg_rm(saul_reg_t *dev)
     else {
         return -ENODEV;
     }
+#ifdef MODULE_SAUL_REG_INDEX
+    _index_rm(dev);
+#endif
     return 0;
 }
 
 saul_reg_t *saul_reg_find_nth(int pos)
 {
+#ifdef MODULE_SAUL_REG_INDEX
+    if (!_overflow) {
+        return ((pos >= 0) && ((unsigned)pos < _numof)) ? _by_pos[pos] : NULL;
+    }
+#endif
     saul_reg_t *tmp = saul_reg;
 
     for (int i = 0; (i < pos) && tmp; i++) {
@@ -89,6 +194,14 @@ saul_reg_t *saul_reg_find_nth(int pos)
 
 saul_reg_t *saul_reg_find_type(uint8_t type)
 {
+#ifdef MODULE_SAUL_REG_INDEX
+    if (!_overflow) {
+        unsigned pos = _bound(_by_type, _cmp_type, &type, false);
+
+        return ((pos < _numof) && (_by_type[pos]->driver->type == type)) ?
+               _by_type[pos] : NULL;
+    }
+#endif
     saul_reg_t *tmp = saul_reg;
 
     while (tmp) {
@@ -102,6 +215,14 @@ saul_reg_t *saul_reg_find_type(uint8_t type)
 
 saul_reg_t *saul_reg_find_name(const char *name)
 {
+#ifdef MODULE_SAUL_REG_INDEX
+    if (!_overflow) {
+        unsigned pos = _bound(_by_name, _cmp_name, name, false);
+
+        return ((pos < _numof) && (strcmp(_by_name[pos]->name, name) == 0)) ?
+               _by_name[pos] : NULL;
+    }
+#endif
     saul_reg_t *tmp = saul_reg;
 
     while (tmp) {
@@ -121,6 +242,21 @@ int saul_reg_read(saul_reg_t *dev, phydat_t *res)
     return dev->driver->read(dev->dev, res);
 }
 
+int saul_reg_read_burst(saul_reg_t *dev, phydat_t *res, unsigned max)
+{
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+    if (max == 0) {
+        return 0;
+    }
+    if (dev->driver->read_burst != NULL) {
+        return dev->driver->read_burst(dev->dev, res, max);
+    }
+    int dim = dev->driver->read(dev->dev, res);
+    return (dim > 0) ? 1 : dim;
+}
+
 int saul_reg_write(saul_reg_t *dev, phydat_t *data)
 {
     if (dev == NULL) {
@@ -128,3 +264,67 @@ int saul_reg_write(saul_reg_t *dev, phydat_t *data)
     }
     return dev->driver->write(dev->dev, data);
 }
+
+static bool _matches(uint8_t type, uint8_t class)
+{
+    switch (type) {
+        case SAUL_CLASS_ANY:
+            return true;
+        case SAUL_SENSE_ANY:
+        case SAUL_ACT_ANY:
+            /* the top-level class is given by the two highest bits */
+            return (class & 0xc0) == type;
+        default:
+            return class == type;
+    }
+}
+
+unsigned saul_reg_find_all(uint8_t type, saul_reg_t **devs, unsigned max)
+{
+    unsigned numof = 0;
+
+#ifdef MODULE_SAUL_REG_INDEX
+    if (!_overflow) {
+        /* the devices of a class are adjacent, as the class is given by the
+         * highest bits of the type */
+        uint8_t first = (type == SAUL_CLASS_ANY) ? 0 : type;
+        uint8_t last = type;
+
+        if ((type == SAUL_SENSE_ANY) || (type == SAUL_ACT_ANY)) {
+            last = type | 0x3f;
+        }
+        unsigned pos = _bound(_by_type, _cmp_type, &first, false);
+        unsigned end = _bound(_by_type, _cmp_type, &last, true);
+
+        for (; (pos < end) && (numof < max); pos++) {
+            devs[numof++] = _by_type[pos];
+        }
+        return numof;
+    }
+#endif
+    for (saul_reg_t *tmp = saul_reg; tmp && (numof < max); tmp = tmp->next) {
+        if (_matches(type, tmp->driver->type)) {
+            devs[numof++] = tmp;
+        }
+    }
+    return numof;
+}
+
+int saul_reg_read_all(uint8_t type, saul_reg_read_cb_t cb, void *arg)
+{
+    int numof = 0;
+
+    for (saul_reg_t *tmp = saul_reg; tmp; tmp = tmp->next) {
+        phydat_t res;
+
+        if (!_matches(type, tmp->driver->type)) {
+            continue;
+        }
+        int dim = tmp->driver->read(tmp->dev, &res);
+        if (dim > 0) {
+            cb(tmp, &res, dim, arg);
+            numof++;
+        }
+    }
+    return numof;
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_round_robin
+ * @{
+ *
+ * @file
+ * @brief       Round robin scheduling implementation
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+
+#include "clist.h"
+#include "sched.h"
+#include "xtimer.h"
+#include "sched_round_robin.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static void _expired(void *arg);
+
+static xtimer_t _timer = { .callback = _expired };
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static bool _armed;
+
+static void _expired(void *arg)
+{
+    thread_t *active = (thread_t *)sched_active_thread;
+
+    (void)arg;
+    _armed = false;
+    /* the thread may have blocked in the meantime without sched_run()
+     * noticing a change, e.g. the timer fired during the context switch */
+    if ((active != NULL) && (active->pid == _pid) &&
+        (active->status >= STATUS_ON_RUNQUEUE)) {
+        DEBUG("sched_round_robin: quantum of %" PRIkernel_pid " expired\n",
+              active->pid);
+        /* active thread is the head of its runqueue */
+        clist_lpoprpush(&sched_runqueues[active->priority]);
+        sched_context_switch_request = 1;
+    }
+}
+
+void sched_round_robin_check(thread_t *thread)
+{
+    /* clist is circular, a single entry points to itself */
+    if (thread->rq_entry.next != &thread->rq_entry) {
+        /* keep a running quantum, sched_run() is also called when nothing
+         * changes */
+        if (!_armed || (_pid != thread->pid)) {
+            _pid = thread->pid;
+            _armed = true;
+            xtimer_set(&_timer, SCHED_ROUND_ROBIN_QUANTUM);
+        }
+    }
+    else if (_armed) {
+        _armed = false;
+        xtimer_remove(&_timer);
+    }
+}
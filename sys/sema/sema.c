@@ -28,7 +28,7 @@ void sema_create(sema_t *sema, unsigned int value)
 {
     assert(sema != NULL);
 
-    sema->value = value;
+    atomic_init(&sema->value, value);
     sema->state = SEMA_OK;
     mutex_init(&sema->mutex);
     if (value == 0) {
@@ -52,6 +52,19 @@ int _sema_wait(sema_t *sema, int block, uint64_t us)
         return -ECANCELED;
     }
 
+    /* fast path: take a posted value without blocking */
+    unsigned int cur = atomic_load_explicit(&sema->value, memory_order_relaxed);
+    while (cur > 0) {
+        if (atomic_compare_exchange_weak_explicit(&sema->value, &cur, cur - 1,
+                                                  memory_order_acquire,
+                                                  memory_order_relaxed)) {
+            return 0;
+        }
+    }
+    if (!block) {
+        return -EAGAIN;
+    }
+
     int did_block = block;
     unsigned old = irq_disable();
     while ((sema->value == 0) && block) {
@@ -100,15 +113,18 @@ int sema_post(sema_t *sema)
 {
     assert(sema != NULL);
 
-    unsigned old = irq_disable();
-    if (sema->value == UINT_MAX) {
-        irq_restore(old);
-        return -EOVERFLOW;
-    }
-
-    unsigned value = sema->value++;
-    irq_restore(old);
+    unsigned int value = atomic_load_explicit(&sema->value,
+                                              memory_order_relaxed);
+    do {
+        if (value == UINT_MAX) {
+            return -EOVERFLOW;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&sema->value, &value,
+                                                    value + 1,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
 
+    /* only threads waiting for a value of 0 block on the mutex */
     if (value == 0) {
         mutex_unlock(&sema->mutex);
     }
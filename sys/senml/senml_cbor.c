@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_senml
+ * @{
+ *
+ * @file
+ * @brief       SenML-CBOR encoder implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "senml.h"
+
+/* opens the map of a record and writes all fields but the value */
+static void _rec(cbor_enc_t *enc, const senml_rec_t *rec, int value_label)
+{
+    unsigned numof = 1;
+
+    numof += (rec->bn != NULL) + (rec->n != NULL) + (rec->u != NULL);
+    cbor_enc_map(enc, numof);
+    if (rec->bn) {
+        cbor_enc_int(enc, SENML_LABEL_BN);
+        cbor_enc_str(enc, rec->bn);
+    }
+    if (rec->n) {
+        cbor_enc_int(enc, SENML_LABEL_N);
+        cbor_enc_str(enc, rec->n);
+    }
+    if (rec->u) {
+        cbor_enc_int(enc, SENML_LABEL_U);
+        cbor_enc_str(enc, rec->u);
+    }
+    cbor_enc_int(enc, value_label);
+}
+
+void senml_cbor_int(cbor_enc_t *enc, const senml_rec_t *rec, int64_t val)
+{
+    _rec(enc, rec, SENML_LABEL_V);
+    cbor_enc_int64(enc, val);
+}
+
+void senml_cbor_decfrac(cbor_enc_t *enc, const senml_rec_t *rec,
+                        int32_t mantissa, int32_t exponent)
+{
+    _rec(enc, rec, SENML_LABEL_V);
+    cbor_enc_decfrac(enc, mantissa, exponent);
+}
+
+void senml_cbor_float(cbor_enc_t *enc, const senml_rec_t *rec, float val)
+{
+    _rec(enc, rec, SENML_LABEL_V);
+    cbor_enc_float(enc, val);
+}
+
+void senml_cbor_bool(cbor_enc_t *enc, const senml_rec_t *rec, bool val)
+{
+    _rec(enc, rec, SENML_LABEL_VB);
+    cbor_enc_bool(enc, val);
+}
+
+void senml_cbor_str(cbor_enc_t *enc, const senml_rec_t *rec,
+                    const char *str, size_t len)
+{
+    _rec(enc, rec, SENML_LABEL_VS);
+    cbor_enc_tstr(enc, str, len);
+}
+
+void senml_cbor_data(cbor_enc_t *enc, const senml_rec_t *rec,
+                     const void *data, size_t len)
+{
+    _rec(enc, rec, SENML_LABEL_VD);
+    cbor_enc_bstr(enc, data, len);
+}
+
+const char *senml_unit(uint8_t unit)
+{
+    switch (unit) {
+        case UNIT_TEMP_C:   return "Cel";
+        case UNIT_TEMP_K:   return "K";
+        case UNIT_LUX:      return "lx";
+        case UNIT_M:        return "m";
+        case UNIT_M2:       return "m2";
+        case UNIT_M3:       return "m3";
+        case UNIT_GR:       return "g";
+        case UNIT_A:        return "A";
+        case UNIT_V:        return "V";
+        case UNIT_PA:       return "Pa";
+        case UNIT_CD:       return "cd";
+        case UNIT_PERCENT:  return "%";
+        case UNIT_PPM:      return "ppm";
+        default:            return NULL;
+    }
+}
+
+void senml_cbor_phydat(cbor_enc_t *enc, const char *bn,
+                       const char *const *names, const phydat_t *data,
+                       uint8_t dim)
+{
+    assert(dim <= PHYDAT_DIM);
+
+    senml_rec_t rec = { .bn = bn, .u = senml_unit(data->unit) };
+
+    for (unsigned i = 0; i < dim; i++) {
+        rec.n = (names) ? names[i] : NULL;
+        if (data->unit == UNIT_BOOL) {
+            senml_cbor_bool(enc, &rec, data->val[i] != 0);
+        }
+        else if (data->scale == 0) {
+            senml_cbor_int(enc, &rec, data->val[i]);
+        }
+        else {
+            senml_cbor_decfrac(enc, &rec, data->val[i], data->scale);
+        }
+        /* the base name applies to all following records */
+        rec.bn = NULL;
+    }
+}
+
+#ifdef MODULE_SAUL_REG
+int senml_cbor_saul(cbor_enc_t *enc, const char *bn,
+                    const char *const *names, saul_reg_t *dev)
+{
+    phydat_t res;
+    int dim = saul_reg_read(dev, &res);
+
+    if (dim <= 0) {
+        return dim;
+    }
+    senml_cbor_phydat(enc, bn, names, &res, dim);
+    return dim;
+}
+#endif
@@ -19,6 +19,7 @@
  */
 
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
@@ -51,6 +52,27 @@ static int _list(int argc, char **argv)
     return 0;
 }
 
+static int _stats(int argc, char **argv)
+{
+    if (argc != 2) {
+        _can_usage();
+        return 1;
+    }
+
+    can_stats_t stats;
+    int ifnum = atoi(argv[1]);
+    if (raw_can_get_stats(ifnum, &stats) < 0) {
+        puts("Invalid ifnum");
+        return 1;
+    }
+    printf("RX: %" PRIu32 " frames, %" PRIu32 " overruns, %" PRIu32 " errors\n",
+           stats.rx_frames, stats.rx_overruns, stats.rx_errors);
+    printf("TX: %" PRIu32 " frames, %" PRIu32 " errors\n",
+           stats.tx_frames, stats.tx_errors);
+
+    return 0;
+}
+
 static int _send(int argc, char **argv)
 {
     if (argc < 3 || argc > 11) {
@@ -156,6 +178,7 @@ static int _can_usage(void)
     puts("commands:");
     puts("\tlist");
     puts("\tsend ifnum id [B1 .. B8]");
+    puts("\tstats ifnum");
     puts("\tdump ifnum nb ms [id1[:mask1][,id2[:mask2], .. id"
          xstr(SC_CAN_MAX_FILTERS) ":[mask" xstr(SC_CAN_MAX_FILTERS) "]]");
     return 0;
@@ -176,6 +199,9 @@ int _can_handler(int argc, char **argv)
     else if (strncmp(argv[1], "dump", 5) == 0) {
         return _dump(argc - 1, argv + 1);
     }
+    else if (strncmp(argv[1], "stats", 6) == 0) {
+        return _stats(argc - 1, argv + 1);
+    }
     else {
         printf("unknown command: %s\n", argv[1]);
         return 1;
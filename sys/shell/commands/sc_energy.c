@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the energy accounting module
+ *
+ * @}
+ */
+
+#include "energy.h"
+
+int _energy_handler(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    energy_print();
+    return 0;
+}
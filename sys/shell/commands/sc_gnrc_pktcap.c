@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the gnrc_pktcap module
+ *
+ * @}
+ */
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/gnrc/pktcap.h"
+#ifdef MODULE_VFS
+#include "vfs.h"
+#endif
+
+/* bytes per line of the hex dump, as `xxd -p` */
+#define _DUMP_LINE      (30U)
+
+static void _usage(const char *cmd)
+{
+    printf("usage: %s [on|off|clear|dump]\n", cmd);
+    printf("       %s filter <ethertype (hex)> <port>\n", cmd);
+#ifdef MODULE_VFS
+    printf("       %s save <file>\n", cmd);
+#endif
+}
+
+static void _print_stats(void)
+{
+    gnrc_pktcap_stats_t stats;
+
+    gnrc_pktcap_stats(&stats);
+    printf("captured: %" PRIu32 ", overwritten: %" PRIu32
+           ", filtered: %" PRIu32 "\n",
+           stats.captured, stats.overwritten, stats.filtered);
+}
+
+static void _dump(void)
+{
+    uint8_t buf[_DUMP_LINE];
+    size_t offset = 0;
+    ssize_t res;
+
+    while ((res = gnrc_pktcap_read(NULL, offset, buf, sizeof(buf))) > 0) {
+        for (ssize_t i = 0; i < res; i++) {
+            printf("%02x", buf[i]);
+        }
+        puts("");
+        offset += res;
+    }
+}
+
+#ifdef MODULE_VFS
+static int _save(const char *path)
+{
+    uint8_t buf[64];
+    size_t offset = 0;
+    ssize_t res;
+    int fd = vfs_open(path, O_WRONLY | O_CREAT | O_TRUNC, 0);
+
+    if (fd < 0) {
+        printf("error: can't open %s: %d\n", path, fd);
+        return 1;
+    }
+    while ((res = gnrc_pktcap_read(NULL, offset, buf, sizeof(buf))) > 0) {
+        if ((res = vfs_write(fd, buf, res)) < 0) {
+            printf("error: can't write %s: %d\n", path, (int)res);
+            vfs_close(fd);
+            return 1;
+        }
+        offset += res;
+    }
+    vfs_close(fd);
+    printf("%u bytes written to %s\n", (unsigned)offset, path);
+    return 0;
+}
+#endif
+
+int _gnrc_pktcap_cmd(int argc, char **argv)
+{
+    if (argc == 1) {
+        _print_stats();
+        return 0;
+    }
+    if ((argc == 2) && (strcmp(argv[1], "on") == 0)) {
+        gnrc_pktcap_enable(true);
+        return 0;
+    }
+    if ((argc == 2) && (strcmp(argv[1], "off") == 0)) {
+        gnrc_pktcap_enable(false);
+        return 0;
+    }
+    if ((argc == 2) && (strcmp(argv[1], "clear") == 0)) {
+        gnrc_pktcap_clear();
+        return 0;
+    }
+    if ((argc == 2) && (strcmp(argv[1], "dump") == 0)) {
+        /* don't let the dump capture itself, e.g. on a network shell */
+        gnrc_pktcap_enable(false);
+        _dump();
+        gnrc_pktcap_enable(true);
+        return 0;
+    }
+    if ((argc == 4) && (strcmp(argv[1], "filter") == 0)) {
+        gnrc_pktcap_filter(strtoul(argv[2], NULL, 16),
+                           strtoul(argv[3], NULL, 10));
+        return 0;
+    }
+#ifdef MODULE_VFS
+    if ((argc == 3) && (strcmp(argv[1], "save") == 0)) {
+        int res;
+
+        gnrc_pktcap_enable(false);
+        res = _save(argv[2]);
+        gnrc_pktcap_enable(true);
+        return res;
+    }
+#endif
+    _usage(argv[0]);
+    return 1;
+}
@@ -16,7 +16,9 @@
  */
 
 #include <stdio.h>
+#include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 
 #ifdef MODULE_GNRC_ICMPV6
@@ -34,6 +36,13 @@
 #include "utlist.h"
 #include "xtimer.h"
 
+/**
+ * @brief   Number of round trip times kept for the percentiles of a flood
+ */
+#ifndef PING6_FLOOD_SAMPLES
+#define PING6_FLOOD_SAMPLES     (128U)
+#endif
+
 static uint16_t id = 0x53;
 static uint16_t min_seq_expected = 0;
 static uint16_t max_seq_expected = 0;
@@ -42,12 +51,15 @@ static char ipv6_str[IPV6_ADDR_MAX_STR_LEN];
 static void usage(char **argv)
 {
     printf("%s [<count>] <ipv6 addr>[%%<interface>] [<payload_len>] [<delay in ms>] [<stats interval>]\n", argv[0]);
+    printf("%s -f [<count>] <ipv6 addr>[%%<interface>] [<payload_len>] [<timeout in ms>]\n", argv[0]);
+    puts("    -f: flood, send the next request as soon as the reply arrived");
     puts("defaults:");
     puts("    count = 3");
     puts("    interface = first interface if only one present, only needed for link-local addresses");
     puts("    payload_len = 4");
     puts("    delay = 1000");
     puts("    stats interval = count");
+    puts("    timeout = 100 (flood)");
 }
 
 void _set_payload(icmpv6_echo_t *hdr, size_t payload_len)
@@ -147,6 +159,210 @@ static void _print_stats(char *addr_str, int success, int count, uint64_t total_
     }
 }
 
+static int _parse_addr(char *addr_str, ipv6_addr_t *addr,
+                       kernel_pid_t *src_iface)
+{
+    *src_iface = ipv6_addr_split_iface(addr_str);
+    if (*src_iface == -1) {
+        *src_iface = KERNEL_PID_UNDEF;
+    }
+
+    if (ipv6_addr_from_str(addr, addr_str) == NULL) {
+        puts("error: malformed address");
+        return -1;
+    }
+
+    if (ipv6_addr_is_link_local(addr) || (*src_iface != KERNEL_PID_UNDEF)) {
+        size_t ifnum = gnrc_netif_numof();
+
+        if (*src_iface == KERNEL_PID_UNDEF) {
+            if (ifnum == 1) {
+                *src_iface = gnrc_netif_iter(NULL)->pid;
+            }
+            else {
+                puts("error: link local target needs interface parameter (use \"<address>%<ifnum>\")\n");
+                return -1;
+            }
+        }
+        else {
+            if (gnrc_netif_get_by_pid(*src_iface) == NULL) {
+                printf("error: %"PRIkernel_pid" is not a valid interface.\n", *src_iface);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int _send_req(const ipv6_addr_t *addr, kernel_pid_t src_iface,
+                     size_t payload_len)
+{
+    gnrc_pktsnip_t *pkt;
+
+    pkt = gnrc_icmpv6_echo_build(ICMPV6_ECHO_REQ, id, ++max_seq_expected,
+                                 NULL, payload_len);
+
+    if (pkt == NULL) {
+        puts("error: packet buffer full");
+        return -1;
+    }
+
+    _set_payload(pkt->data, payload_len);
+
+    pkt = gnrc_ipv6_hdr_build(pkt, NULL, addr);
+
+    if (pkt == NULL) {
+        puts("error: packet buffer full");
+        return -1;
+    }
+
+    if (src_iface != KERNEL_PID_UNDEF) {
+        pkt = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_netif_hdr_t),
+                              GNRC_NETTYPE_NETIF);
+
+        if (pkt == NULL) {
+            puts("error: packet buffer full");
+            return -1;
+        }
+
+        gnrc_netif_hdr_init(((gnrc_netif_hdr_t *)pkt->data), 0, 0);
+        ((gnrc_netif_hdr_t *)pkt->data)->if_pid = src_iface;
+    }
+
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+        puts("error: unable to send ICMPv6 echo request\n");
+        gnrc_pktbuf_release(pkt);
+        return -1;
+    }
+    return 0;
+}
+
+static int _cmp_rtt(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void _print_percentiles(uint32_t *rtts, unsigned num)
+{
+    static const uint8_t pcts[] = { 50, 90, 99 };
+
+    qsort(rtts, num, sizeof(uint32_t), _cmp_rtt);
+    printf("rtt");
+    for (unsigned i = 0; i < sizeof(pcts); i++) {
+        uint32_t rtt = rtts[((num - 1) * pcts[i]) / 100];
+
+        printf(" p%u=%" PRIu32 ".%03" PRIu32, pcts[i], rtt / US_PER_MS,
+               rtt % US_PER_MS);
+    }
+    printf(" ms (of the last %u replies)\n", num);
+}
+
+static int _icmpv6_ping_flood(int argc, char **argv)
+{
+    /* static so it doesn't weigh on the shell's stack */
+    static uint32_t rtts[PING6_FLOOD_SAMPLES];
+    int count = 100, sent = 0, success = 0, param_offset = 0;
+    size_t payload_len = 4;
+    uint32_t timeout = 100 * US_PER_MS;
+    unsigned rtts_num = 0, rtts_next = 0;
+    ipv6_addr_t addr;
+    kernel_pid_t src_iface;
+    msg_t msg;
+    gnrc_netreg_entry_t my_entry = GNRC_NETREG_ENTRY_INIT_PID(ICMPV6_ECHO_REP,
+                                                              sched_active_pid);
+    uint64_t ping_start, total_time;
+
+    if ((argc > 2) && ((count = atoi(argv[1])) > 0)) {
+        param_offset = 1;
+    }
+    else {
+        count = 100;
+    }
+    if (argc < (2 + param_offset)) {
+        return -1;
+    }
+    if (argc > (2 + param_offset)) {
+        payload_len = atoi(argv[2 + param_offset]);
+    }
+    if (argc > (3 + param_offset)) {
+        timeout = atoi(argv[3 + param_offset]) * US_PER_MS;
+    }
+    if ((int)payload_len < 0) {
+        return -1;
+    }
+    if (_parse_addr(argv[1 + param_offset], &addr, &src_iface) < 0) {
+        return 1;
+    }
+    if (gnrc_netreg_register(GNRC_NETTYPE_ICMPV6, &my_entry) < 0) {
+        puts("error: network registry is full");
+        return 1;
+    }
+
+    ping_start = xtimer_now_usec64();
+    while (sent < count) {
+        uint32_t start = xtimer_now_usec(), now = start;
+        uint16_t seq;
+
+        if (_send_req(&addr, src_iface, payload_len) < 0) {
+            break;
+        }
+        sent++;
+        seq = max_seq_expected;
+        /* wait for this request's reply, late replies of earlier requests
+         * are dropped */
+        while ((now - start) < timeout) {
+            if (xtimer_msg_receive_timeout(&msg, timeout - (now - start)) < 0) {
+                break;
+            }
+            now = xtimer_now_usec();
+            if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+                gnrc_pktsnip_t *pkt = msg.content.ptr;
+                gnrc_pktsnip_t *icmpv6 = gnrc_pktsnip_search_type(pkt,
+                                                                  GNRC_NETTYPE_ICMPV6);
+                icmpv6_echo_t *echo = (icmpv6) ? icmpv6->data : NULL;
+                bool match = (echo != NULL) &&
+                             (byteorder_ntohs(echo->id) == id) &&
+                             (byteorder_ntohs(echo->seq) == seq);
+
+                gnrc_pktbuf_release(pkt);
+                if (match) {
+                    rtts[rtts_next] = now - start;
+                    rtts_next = (rtts_next + 1) % PING6_FLOOD_SAMPLES;
+                    if (rtts_num < PING6_FLOOD_SAMPLES) {
+                        rtts_num++;
+                    }
+                    success++;
+                    break;
+                }
+            }
+        }
+    }
+    total_time = xtimer_now_usec64() - ping_start;
+
+    gnrc_netreg_unregister(GNRC_NETTYPE_ICMPV6, &my_entry);
+    while (msg_try_receive(&msg) > 0) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+    max_seq_expected = 0;
+    id++;
+
+    printf("--- %s ping flood statistics ---\n", argv[1 + param_offset]);
+    printf("%d packets transmitted, %d received, time %" PRIu32 " ms\n", sent,
+           success, (uint32_t)(total_time / US_PER_MS));
+    if ((success > 0) && (total_time > 0)) {
+        uint64_t rate = ((uint64_t)success * US_PER_SEC) / total_time;
+
+        printf("%" PRIu32 " replies/s, %" PRIu32 " payload bytes/s\n",
+               (uint32_t)rate, (uint32_t)(rate * payload_len));
+        _print_percentiles(rtts, rtts_num);
+    }
+    return success ? 0 : 1;
+}
+
 int _icmpv6_ping(int argc, char **argv)
 {
     int count = 3, success = 0, remaining, stat_interval = 0, stat_counter = 0;
@@ -163,6 +379,16 @@ int _icmpv6_ping(int argc, char **argv)
     uint64_t ping_start;
     int param_offset = 0;
 
+    if ((argc > 1) && (strcmp(argv[1], "-f") == 0)) {
+        int res = _icmpv6_ping_flood(argc - 1, argv + 1);
+
+        if (res < 0) {
+            usage(argv);
+            return 1;
+        }
+        return res;
+    }
+
     if (argc < 2) {
         usage(argv);
         return 1;
@@ -192,36 +418,10 @@ int _icmpv6_ping(int argc, char **argv)
         return 1;
     }
 
-    src_iface = ipv6_addr_split_iface(addr_str);
-    if (src_iface == -1) {
-        src_iface = KERNEL_PID_UNDEF;
-    }
-
-    if (ipv6_addr_from_str(&addr, addr_str) == NULL) {
-        puts("error: malformed address");
+    if (_parse_addr(addr_str, &addr, &src_iface) < 0) {
         return 1;
     }
 
-    if (ipv6_addr_is_link_local(&addr) || (src_iface != KERNEL_PID_UNDEF)) {
-        size_t ifnum = gnrc_netif_numof();
-
-        if (src_iface == KERNEL_PID_UNDEF) {
-            if (ifnum == 1) {
-                src_iface = gnrc_netif_iter(NULL)->pid;
-            }
-            else {
-                puts("error: link local target needs interface parameter (use \"<address>%<ifnum>\")\n");
-                return 1;
-            }
-        }
-        else {
-            if (gnrc_netif_get_by_pid(src_iface) == NULL) {
-                printf("error: %"PRIkernel_pid" is not a valid interface.\n", src_iface);
-                return 1;
-            }
-        }
-    }
-
     if (gnrc_netreg_register(GNRC_NETTYPE_ICMPV6, &my_entry) < 0) {
         puts("error: network registry is full");
         return 1;
@@ -232,43 +432,10 @@ int _icmpv6_ping(int argc, char **argv)
     ping_start = xtimer_now_usec64();
 
     while ((remaining--) > 0) {
-        gnrc_pktsnip_t *pkt;
         uint32_t start, timeout = 1 * US_PER_SEC;
 
-        pkt = gnrc_icmpv6_echo_build(ICMPV6_ECHO_REQ, id, ++max_seq_expected,
-                                     NULL, payload_len);
-
-        if (pkt == NULL) {
-            puts("error: packet buffer full");
-            continue;
-        }
-
-        _set_payload(pkt->data, payload_len);
-
-        pkt = gnrc_ipv6_hdr_build(pkt, NULL, &addr);
-
-        if (pkt == NULL) {
-            puts("error: packet buffer full");
-            continue;
-        }
-
-        if (src_iface != KERNEL_PID_UNDEF) {
-            pkt = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_netif_hdr_t),
-                                  GNRC_NETTYPE_NETIF);
-
-            if (pkt == NULL) {
-                puts("error: packet buffer full");
-                continue;
-            }
-
-            gnrc_netif_hdr_init(((gnrc_netif_hdr_t *)pkt->data), 0, 0);
-            ((gnrc_netif_hdr_t *)pkt->data)->if_pid = src_iface;
-        }
-
         start = xtimer_now_usec();
-        if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
-            puts("error: unable to send ICMPv6 echo request\n");
-            gnrc_pktbuf_release(pkt);
+        if (_send_req(&addr, src_iface, payload_len) < 0) {
             continue;
         }
 
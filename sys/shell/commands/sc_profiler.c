@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the profiler module
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "profiler.h"
+
+int _profiler_handler(int argc, char **argv)
+{
+    if (argc == 2) {
+        if (strcmp(argv[1], "start") == 0) {
+            profiler_start();
+            return 0;
+        }
+        if (strcmp(argv[1], "stop") == 0) {
+            profiler_stop();
+            return 0;
+        }
+        if (strcmp(argv[1], "dump") == 0) {
+            profiler_dump();
+            return 0;
+        }
+        if (strcmp(argv[1], "reset") == 0) {
+            profiler_reset();
+            return 0;
+        }
+    }
+    printf("usage: %s <start|stop|dump|reset>\n", argv[0]);
+    return 1;
+}
@@ -18,12 +18,25 @@
  * @}
  */
 
+#include <stdio.h>
+#include <string.h>
+
 #include "ps.h"
 
 int _ps_handler(int argc, char **argv)
 {
-    (void) argc;
-    (void) argv;
+    if (argc > 1) {
+#ifdef MODULE_SCHEDSTATISTICS
+        if (strcmp(argv[1], "-l") == 0) {
+            ps_latency();
+            return 0;
+        }
+        printf("usage: %s [-l]\n", argv[0]);
+#else
+        printf("usage: %s\n", argv[0]);
+#endif
+        return 1;
+    }
 
     ps();
 
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the xtimer_stats module
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "xtimer.h"
+
+static void _print_row(const char *name, const uint32_t *hist)
+{
+    printf("%-9s", name);
+    for (unsigned i = 0; i < XTIMER_STATS_BUCKETS; i++) {
+        printf(" %7" PRIu32, hist[i]);
+    }
+    puts("");
+}
+
+int _xtimer_stats_handler(int argc, char **argv)
+{
+    xtimer_stats_t stats;
+
+    if ((argc == 2) && (strcmp(argv[1], "reset") == 0)) {
+        xtimer_stats_reset();
+        return 0;
+    }
+    if (argc != 1) {
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+
+    xtimer_stats_get(&stats);
+    /* lower bound of each bucket */
+    printf("%-9s", "from");
+    for (unsigned i = 0; i < XTIMER_STATS_BUCKETS; i++) {
+        printf(" %7lu", (i) ? (1LU << (i - 1)) : 0LU);
+    }
+    puts("");
+    _print_row("late[us]", stats.late);
+    _print_row("isr[us]", stats.isr);
+    _print_row("list", stats.list);
+    _print_row("longlist", stats.long_list);
+    printf("max late: %" PRIu32 " us, max isr: %" PRIu32 " us\n",
+           stats.late_max, stats.isr_max);
+    return 0;
+}
@@ -37,6 +37,22 @@ extern int _heap_handler(int argc, char **argv);
 extern int _ps_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_TRACING
+extern int _tracing_handler(int argc, char **argv);
+#endif
+
+#ifdef MODULE_PROFILER
+extern int _profiler_handler(int argc, char **argv);
+#endif
+
+#ifdef MODULE_XTIMER_STATS
+extern int _xtimer_stats_handler(int argc, char **argv);
+#endif
+
+#ifdef MODULE_ENERGY
+extern int _energy_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_SHT1X
 extern int _get_temperature_handler(int argc, char **argv);
 extern int _get_humidity_handler(int argc, char **argv);
@@ -112,6 +128,14 @@ extern int _blacklist(int argc, char **argv);
 extern int _gnrc_pktbuf_cmd(int argc, char **argv);
 #endif
 
+#ifdef MODULE_GNRC_PKTCAP
+extern int _gnrc_pktcap_cmd(int argc, char **argv);
+#endif
+
+#ifdef MODULE_GNRC_PKTTRACE
+extern int _gnrc_pkttrace_cmd(int argc, char **argv);
+#endif
+
 #ifdef MODULE_GNRC_RPL
 extern int _gnrc_rpl(int argc, char **argv);
 #endif
@@ -157,6 +181,18 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
 #endif
+#ifdef MODULE_TRACING
+    {"trace", "Starts, stops or dumps function tracing", _tracing_handler},
+#endif
+#ifdef MODULE_PROFILER
+    {"prof", "Starts, stops, dumps or resets the sampling profiler", _profiler_handler},
+#endif
+#ifdef MODULE_XTIMER_STATS
+    {"timerstats", "Prints or resets the xtimer jitter and load histograms", _xtimer_stats_handler},
+#endif
+#ifdef MODULE_ENERGY
+    {"energy", "Prints the estimated charge drawn per component", _energy_handler},
+#endif
 #ifdef MODULE_SHT1X
     {"temp", "Prints measured temperature.", _get_temperature_handler},
     {"hum", "Prints measured humidity.", _get_humidity_handler},
@@ -210,6 +246,12 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_GNRC_PKTBUF_CMD
     {"pktbuf", "prints internal stats of the packet buffer", _gnrc_pktbuf_cmd },
 #endif
+#ifdef MODULE_GNRC_PKTCAP
+    {"pktcap", "controls packet capture, exports it as pcapng", _gnrc_pktcap_cmd },
+#endif
+#ifdef MODULE_GNRC_PKTTRACE
+    {"pkttrace", "prints or resets the packet latency histograms", _gnrc_pkttrace_cmd },
+#endif
 #ifdef MODULE_GNRC_RPL
     {"rpl", "rpl configuration tool ('rpl help' for more information)", _gnrc_rpl },
 #endif
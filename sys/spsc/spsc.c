@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_spsc
+ * @{
+ *
+ * @file
+ * @brief       Lock-free message channel implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "spsc.h"
+
+void spsc_init(spsc_t *chan, msg_t *buf, unsigned size, thread_flags_t flag)
+{
+    /* make sure size is a power of two */
+    assert((size != 0) && !(size & (size - 1)));
+    chan->buf = buf;
+    chan->mask = size - 1;
+    atomic_init(&chan->writes, 0);
+    atomic_init(&chan->reads, 0);
+    atomic_init(&chan->waiting, false);
+    chan->consumer = NULL;
+    chan->flag = flag;
+}
+
+int spsc_put(spsc_t *chan, const msg_t *msg)
+{
+    unsigned writes = atomic_load_explicit(&chan->writes, memory_order_relaxed);
+    unsigned reads = atomic_load_explicit(&chan->reads, memory_order_acquire);
+    msg_t *slot;
+
+    if ((writes - reads) > chan->mask) {
+        return 0;
+    }
+    slot = &chan->buf[writes & chan->mask];
+    *slot = *msg;
+    slot->sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    /* sequentially consistent, so either the consumer sees the message when
+     * it rechecks after announcing to wait, or we see it waiting */
+    atomic_store(&chan->writes, writes + 1);
+    if (atomic_exchange(&chan->waiting, false)) {
+        thread_flags_set(chan->consumer, chan->flag);
+    }
+    return 1;
+}
+
+int spsc_get(spsc_t *chan, msg_t *msg)
+{
+    return spsc_get_bulk(chan, msg, 1);
+}
+
+unsigned spsc_get_bulk(spsc_t *chan, msg_t *msgs, unsigned n)
+{
+    unsigned writes = atomic_load_explicit(&chan->writes, memory_order_acquire);
+    unsigned reads = atomic_load_explicit(&chan->reads, memory_order_relaxed);
+
+    if (n > (writes - reads)) {
+        n = writes - reads;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        msgs[i] = chan->buf[(reads + i) & chan->mask];
+    }
+    /* hands the slots back to the producer */
+    atomic_store_explicit(&chan->reads, reads + n, memory_order_release);
+    return n;
+}
+
+unsigned spsc_avail(spsc_t *chan)
+{
+    return atomic_load(&chan->writes) -
+           atomic_load_explicit(&chan->reads, memory_order_relaxed);
+}
+
+unsigned spsc_wait(spsc_t *chan)
+{
+    unsigned avail;
+
+    chan->consumer = (thread_t *)sched_active_thread;
+    while ((avail = spsc_avail(chan)) == 0) {
+        atomic_store(&chan->waiting, true);
+        /* the producer may have put a message before it could see us
+         * waiting */
+        if ((avail = spsc_avail(chan)) != 0) {
+            /* a flag set in the meantime makes the next wait return early,
+             * which the loop copes with */
+            atomic_store(&chan->waiting, false);
+            break;
+        }
+        thread_flags_wait_any(chan->flag);
+    }
+    return avail;
+}
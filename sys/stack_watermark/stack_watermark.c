@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_stack_watermark
+ * @{
+ *
+ * @file
+ * @brief       Stack watermark sampler implementation
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "irq.h"
+#include "log.h"
+#include "sched.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "stack_watermark.h"
+
+#ifndef DEVELHELP
+#error "stack_watermark requires DEVELHELP"
+#endif
+
+/**
+ * @brief   Maximum usage of a thread
+ */
+typedef struct {
+    char *stack_start;      /**< identifies the thread behind the PID */
+    uint16_t used;          /**< maximum number of bytes used */
+} _watermark_t;
+
+static _watermark_t _watermarks[KERNEL_PID_LAST + 1];
+static char _stack[STACK_WATERMARK_STACKSIZE];
+#ifdef ISR_STACKSIZE
+static unsigned _isr_used;
+#endif
+
+unsigned stack_watermark_sample(void)
+{
+    unsigned res = 0;
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        _watermark_t *wm = &_watermarks[i];
+        unsigned state = irq_disable();
+        thread_t *thread = (thread_t *)sched_threads[i];
+        char *stack_start;
+        const char *name;
+        int stack_size;
+        unsigned used;
+
+        if (thread == NULL) {
+            irq_restore(state);
+            continue;
+        }
+        /* the stack stays readable, even if the thread exits while we scan
+         * it */
+        stack_start = thread->stack_start;
+        stack_size = thread->stack_size;
+        name = thread->name;
+        irq_restore(state);
+
+        if (wm->stack_start != stack_start) {
+            /* PID got reused */
+            wm->stack_start = stack_start;
+            wm->used = 0;
+        }
+        used = stack_size - thread_measure_stack_free(stack_start);
+        if (used > wm->used) {
+            wm->used = used;
+            res++;
+            LOG_INFO("stack_watermark: %s (%" PRIkernel_pid ") uses %u of "
+                     "%d byte\n", name, i, used, stack_size);
+            if ((stack_size - used) < STACK_WATERMARK_LOW) {
+                LOG_WARNING("stack_watermark: %s (%" PRIkernel_pid ") has "
+                            "only %u byte of stack left\n", name, i,
+                            (unsigned)(stack_size - used));
+            }
+        }
+    }
+#ifdef ISR_STACKSIZE
+    int isr_used = thread_isr_stack_usage();
+
+    if ((isr_used > 0) && ((unsigned)isr_used > _isr_used)) {
+        _isr_used = isr_used;
+        res++;
+        LOG_INFO("stack_watermark: ISR stack uses %u of %u byte\n",
+                 _isr_used, (unsigned)ISR_STACKSIZE);
+    }
+#endif
+    return res;
+}
+
+unsigned stack_watermark_get(kernel_pid_t pid)
+{
+    if (!pid_is_valid(pid)) {
+        return 0;
+    }
+    return _watermarks[pid].used;
+}
+
+unsigned stack_watermark_isr(void)
+{
+#ifdef ISR_STACKSIZE
+    return _isr_used;
+#else
+    return 0;
+#endif
+}
+
+static void *_sampler(void *arg)
+{
+    (void)arg;
+    while (1) {
+        stack_watermark_sample();
+        xtimer_sleep(STACK_WATERMARK_INTERVAL);
+    }
+    return NULL;
+}
+
+void stack_watermark_init(void)
+{
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_IDLE - 1,
+                  THREAD_CREATE_STACKTEST, _sampler, NULL, "stack_watermark");
+}
@@ -33,6 +33,15 @@
 #include "periph/uart.h"
 #include "isrpipe.h"
 
+#ifdef MODULE_STDIO_UART_TX_ASYNC
+#include <stdbool.h>
+
+#include "irq.h"
+#include "mutex.h"
+#include "thread.h"
+#include "tsrb.h"
+#endif
+
 #ifdef USE_ETHOS_FOR_STDIO
 #include "ethos.h"
 extern ethos_t ethos;
@@ -49,12 +58,102 @@ extern ethos_t ethos;
 static char _rx_buf_mem[STDIO_UART_RX_BUFSIZE];
 isrpipe_t stdio_uart_isrpipe = ISRPIPE_INIT(_rx_buf_mem);
 
+#if defined(MODULE_STDIO_UART_TX_ASYNC) && !defined(USE_ETHOS_FOR_STDIO)
+#define TX_ASYNC    (1)
+
+static char _tx_buf_mem[STDIO_UART_TX_BUFSIZE];
+static tsrb_t _tx_buf = TSRB_INIT(_tx_buf_mem);
+/* unlocked when data was added to the buffer */
+static mutex_t _tx_data = MUTEX_INIT_LOCKED;
+/* unlocked when data of the buffer was sent */
+static mutex_t _tx_sent = MUTEX_INIT_LOCKED;
+static kernel_pid_t _tx_pid = KERNEL_PID_UNDEF;
+static char _tx_stack[STDIO_UART_TX_STACKSIZE];
+
+/* sends the buffer in place, no other thread writes into it */
+static void _tx_send(void)
+{
+    size_t len;
+    const char *data;
+
+    while ((data = tsrb_peek_region(&_tx_buf, &len)), len) {
+        uart_write(STDIO_UART_DEV, (const uint8_t *)data, len);
+        tsrb_drop(&_tx_buf, len);
+        mutex_unlock(&_tx_sent);
+    }
+}
+
+static void *_tx_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        mutex_lock(&_tx_data);
+        _tx_send();
+    }
+    return NULL;
+}
+
+void stdio_uart_tx_init(void)
+{
+    _tx_pid = thread_create(_tx_stack, sizeof(_tx_stack), STDIO_UART_TX_PRIO,
+                            THREAD_CREATE_STACKTEST, _tx_thread, NULL,
+                            "stdio_uart_tx");
+}
+
+void stdio_uart_tx_flush(void)
+{
+    if (irq_is_in() || (_tx_pid == KERNEL_PID_UNDEF)) {
+        _tx_send();
+        return;
+    }
+    while (!tsrb_empty(&_tx_buf)) {
+        mutex_lock(&_tx_sent);
+    }
+}
+
+/* interrupts, and the thread itself, can not wait for the buffer */
+static inline bool _tx_may_block(void)
+{
+#ifdef STDIO_UART_TX_DROP
+    return false;
+#else
+    return !irq_is_in() && (thread_getpid() != _tx_pid);
+#endif
+}
+
+static void _tx_write(const char *data, size_t len)
+{
+    while (1) {
+        /* the writers may be threads and interrupts */
+        unsigned state = irq_disable();
+        size_t done = tsrb_add(&_tx_buf, data, len);
+        irq_restore(state);
+        mutex_unlock(&_tx_data);
+
+        data += done;
+        len -= done;
+        if ((len == 0) || !_tx_may_block()) {
+            return;
+        }
+        mutex_lock(&_tx_sent);
+    }
+}
+#else
+#define TX_ASYNC    (0)
+#endif
+
+static void _rx_cb(void *arg, const uint8_t *data, size_t len)
+{
+    isrpipe_write(arg, (const char *)data, len);
+}
+
 void stdio_init(void)
 {
 #ifndef USE_ETHOS_FOR_STDIO
-    uart_init(STDIO_UART_DEV, STDIO_UART_BAUDRATE, (uart_rx_cb_t) isrpipe_write_one, &stdio_uart_isrpipe);
+    uart_init_block(STDIO_UART_DEV, STDIO_UART_BAUDRATE, _rx_cb, &stdio_uart_isrpipe);
 #else
-    uart_init(ETHOS_UART, ETHOS_BAUDRATE, (uart_rx_cb_t) isrpipe_write_one, &stdio_uart_isrpipe);
+    uart_init_block(ETHOS_UART, ETHOS_BAUDRATE, _rx_cb, &stdio_uart_isrpipe);
 #endif
 #if MODULE_VFS
     vfs_bind_stdio();
@@ -69,6 +168,12 @@ ssize_t stdio_read(void* buffer, size_t count)
 ssize_t stdio_write(const void* buffer, size_t len)
 {
 #ifndef USE_ETHOS_FOR_STDIO
+#if TX_ASYNC
+    if (_tx_pid != KERNEL_PID_UNDEF) {
+        _tx_write(buffer, len);
+        return len;
+    }
+#endif
     uart_write(STDIO_UART_DEV, (const uint8_t *)buffer, len);
 #else
     ethos_send_frame(&ethos, (const uint8_t *)buffer, len, ETHOS_FRAME_TYPE_TEXT);
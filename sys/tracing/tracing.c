@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_tracing
+ * @{
+ *
+ * @file
+ * @brief       Function tracing implementation
+ *
+ * This file is not instrumented, nor is anything called from the hooks.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "cpu.h"
+#include "irq.h"
+#include "sched.h"
+#include "tracing.h"
+#include "xtimer.h"
+
+#define NO_TRACE            __attribute__((no_instrument_function))
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+#define _HAS_CYCCNT         (1)
+#else
+#define _HAS_CYCCNT         (0)
+#endif
+
+/* called by the code instrumented with -finstrument-functions */
+NO_TRACE void __cyg_profile_func_enter(void *fn, void *site);
+NO_TRACE void __cyg_profile_func_exit(void *fn, void *site);
+
+static tracing_event_t _events[TRACING_NUMOF];
+/* number of events recorded, the next one goes to _pos % TRACING_NUMOF */
+static unsigned _pos;
+static volatile bool _enabled;
+#if _HAS_CYCCNT
+static bool _cycles;
+#endif
+
+static inline NO_TRACE uint32_t _now(void)
+{
+#if _HAS_CYCCNT
+    if (_cycles) {
+        return DWT->CYCCNT;
+    }
+#endif
+    return xtimer_now_usec();
+}
+
+static inline NO_TRACE void _record(tracing_type_t type, uintptr_t addr,
+                                    uintptr_t site)
+{
+    if (!_enabled) {
+        return;
+    }
+
+    uint32_t time = _now();
+    /* a single core only needs to be protected against interrupts */
+    unsigned state = irq_disable();
+    tracing_event_t *event = &_events[_pos++ % TRACING_NUMOF];
+
+    event->time = time;
+    event->type = type;
+    event->addr = addr;
+    event->site = site;
+    irq_restore(state);
+}
+
+NO_TRACE void __cyg_profile_func_enter(void *fn, void *site)
+{
+    _record(TRACING_ENTER, (uintptr_t)fn, (uintptr_t)site);
+}
+
+NO_TRACE void __cyg_profile_func_exit(void *fn, void *site)
+{
+    _record(TRACING_EXIT, (uintptr_t)fn, (uintptr_t)site);
+}
+
+static NO_TRACE void _sched_cb(uint32_t timestamp, uint32_t pid)
+{
+    (void)timestamp;
+    _record(TRACING_SWITCH, pid, 0);
+}
+
+void tracing_init(void)
+{
+#if _HAS_CYCCNT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    /* some implementations of the DWT unit come without cycle counter */
+    if (!(DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk)) {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        _cycles = true;
+    }
+#endif
+    sched_register_cb(_sched_cb);
+    tracing_start();
+}
+
+void tracing_start(void)
+{
+    _enabled = true;
+}
+
+void tracing_stop(void)
+{
+    _enabled = false;
+}
+
+void tracing_dump(void)
+{
+    static const char types[] = { 'E', 'X', 'S' };
+    bool enabled = _enabled;
+    unsigned first = 0;
+    const char *unit = "us";
+
+    _enabled = false;
+#if _HAS_CYCCNT
+    if (_cycles) {
+        unit = "cycles";
+    }
+#endif
+    if (_pos > TRACING_NUMOF) {
+        first = _pos - TRACING_NUMOF;
+    }
+
+    printf("tracing: %s %u\n", unit, _pos - first);
+    for (unsigned i = first; i < _pos; i++) {
+        const tracing_event_t *event = &_events[i % TRACING_NUMOF];
+
+        printf("%" PRIu32 " %c 0x%08" PRIxPTR " 0x%08" PRIxPTR "\n",
+               event->time, types[event->type], event->addr, event->site);
+    }
+    puts("tracing: end");
+
+    _pos = 0;
+    _enabled = enabled;
+}
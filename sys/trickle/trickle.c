@@ -17,10 +17,114 @@
 #include "inttypes.h"
 #include "random.h"
 #include "trickle.h"
+#ifdef MODULE_TRICKLE_EVENT
+#include "mutex.h"
+#endif
 
 #define ENABLE_DEBUG        (0)
 #include "debug.h"
 
+/* the time in us the timer of the current interval may be late */
+static uint32_t _slack(const trickle_t *trickle)
+{
+#if TRICKLE_SLACK_DIV
+    uint32_t slack = trickle->I / TRICKLE_SLACK_DIV;
+
+    return (slack > (UINT32_MAX / US_PER_MS)) ? UINT32_MAX : slack * US_PER_MS;
+#else
+    (void)trickle;
+    return 0;
+#endif
+}
+
+#ifdef MODULE_TRICKLE_EVENT
+/* instances run by the event queue, sorted by deadline */
+static trickle_t *_list;
+static mutex_t _lock = MUTEX_INIT;
+static xtimer_t _timer;
+static event_queue_t *_queue;
+
+static void _handler(event_t *event);
+static event_t _event = { .handler = _handler };
+
+static void _timer_cb(void *arg)
+{
+    (void)arg;
+    event_post(_queue, &_event);
+}
+
+/* must be called with _lock held */
+static void _remove(trickle_t *trickle)
+{
+    for (trickle_t **pos = &_list; *pos; pos = &(*pos)->next) {
+        if (*pos == trickle) {
+            *pos = trickle->next;
+            return;
+        }
+    }
+}
+
+/* must be called with _lock held */
+static void _update_timer(void)
+{
+    if (_list) {
+        uint64_t now = xtimer_now_usec64();
+        uint64_t offset = (_list->deadline > now) ? (_list->deadline - now) : 0;
+
+        xtimer_set_slack(&_timer, offset, _slack(_list));
+    }
+    else {
+        xtimer_remove(&_timer);
+    }
+}
+
+static void _schedule(trickle_t *trickle, uint64_t offset)
+{
+    trickle_t **pos = &_list;
+
+    mutex_lock(&_lock);
+    _remove(trickle);
+    trickle->deadline = xtimer_now_usec64() + offset;
+    while (*pos && ((*pos)->deadline <= trickle->deadline)) {
+        pos = &(*pos)->next;
+    }
+    trickle->next = *pos;
+    *pos = trickle;
+    if (_list == trickle) {
+        _update_timer();
+    }
+    mutex_unlock(&_lock);
+}
+
+static void _handler(event_t *event)
+{
+    uint64_t now = xtimer_now_usec64();
+
+    (void)event;
+    while (1) {
+        trickle_t *trickle;
+
+        mutex_lock(&_lock);
+        trickle = _list;
+        if (!trickle || (trickle->deadline > now)) {
+            _update_timer();
+            mutex_unlock(&_lock);
+            return;
+        }
+        _list = trickle->next;
+        mutex_unlock(&_lock);
+        /* reschedules the instance */
+        trickle_callback(trickle);
+    }
+}
+
+void trickle_event_init(event_queue_t *queue)
+{
+    _queue = queue;
+    _timer.callback = _timer_cb;
+}
+#endif
+
 void trickle_callback(trickle_t *trickle)
 {
     /* Handle k=0 like k=infinity (according to RFC6206, section 6.5) */
@@ -51,9 +155,15 @@ void trickle_interval(trickle_t *trickle)
     /* old_interval == trickle->I / 2 */
     trickle->t = random_uint32_range(old_interval, trickle->I);
 
-    uint64_t msg_time = (trickle->t + diff) * US_PER_MS;
-    xtimer_set_msg64(&trickle->msg_timer, msg_time, &trickle->msg,
-                     trickle->pid);
+    uint64_t msg_time = (uint64_t)(trickle->t + diff) * US_PER_MS;
+#ifdef MODULE_TRICKLE_EVENT
+    if (trickle->pid == KERNEL_PID_UNDEF) {
+        _schedule(trickle, msg_time);
+        return;
+    }
+#endif
+    xtimer_set_msg_slack(&trickle->msg_timer, msg_time, _slack(trickle),
+                         &trickle->msg, trickle->pid);
 }
 
 void trickle_reset_timer(trickle_t *trickle)
@@ -65,20 +175,23 @@ void trickle_reset_timer(trickle_t *trickle)
     trickle_interval(trickle);
 }
 
-void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
-                   uint32_t Imin, uint8_t Imax, uint8_t k)
+static void _init(trickle_t *trickle, uint32_t Imin, uint8_t Imax, uint8_t k)
 {
     assert(Imin > 0);
     assert((Imin << Imax) < (UINT32_MAX / 2));
 
-    trickle->pid = pid;
-
     trickle->c = 0;
     trickle->k = k;
     trickle->Imin = Imin;
     trickle->Imax = Imax;
     trickle->I = trickle->t = random_uint32_range(trickle->Imin,
                                                   4 * trickle->Imin);
+}
+
+void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
+                   uint32_t Imin, uint8_t Imax, uint8_t k)
+{
+    _init(trickle, Imin, Imax, k);
     trickle->pid = pid;
     trickle->msg.content.ptr = trickle;
     trickle->msg.type = msg_type;
@@ -86,8 +199,31 @@ void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
     trickle_interval(trickle);
 }
 
+#ifdef MODULE_TRICKLE_EVENT
+void trickle_event_start(trickle_t *trickle, uint32_t Imin, uint8_t Imax,
+                         uint8_t k)
+{
+    assert(_queue);
+
+    _init(trickle, Imin, Imax, k);
+    /* marks the instance as run by the event queue */
+    trickle->pid = KERNEL_PID_UNDEF;
+
+    trickle_interval(trickle);
+}
+#endif
+
 void trickle_stop(trickle_t *trickle)
 {
+#ifdef MODULE_TRICKLE_EVENT
+    if (trickle->pid == KERNEL_PID_UNDEF) {
+        mutex_lock(&_lock);
+        _remove(trickle);
+        _update_timer();
+        mutex_unlock(&_lock);
+        return;
+    }
+#endif
     xtimer_remove(&trickle->msg_timer);
 }
 
@@ -17,8 +17,18 @@
  * @}
  */
 
+#include <string.h>
+
 #include "tsrb.h"
 
+/* Keeps the compiler from moving the copy of the data across the accesses of
+ * the counters, which hand the data over between writer and reader. Both run
+ * on the same core, so no memory barrier instruction is needed. */
+static inline void _barrier(void)
+{
+    __asm__ volatile ("" : : : "memory");
+}
+
 static void _push(tsrb_t *rb, char c)
 {
     rb->buf[rb->writes++ & (rb->size - 1)] = c;
@@ -41,22 +51,36 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, char *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    size_t len;
+    const char *src = tsrb_peek_region(rb, &len);
+
+    if (n <= len) {
+        memcpy(dst, src, n);
+    }
+    else {
+        /* the rest wraps around to the start of the buffer */
+        size_t avail = tsrb_avail(rb);
+
+        if (n > avail) {
+            n = avail;
+        }
+        memcpy(dst, src, len);
+        memcpy(dst + len, rb->buf, n - len);
     }
-    return (n - tmp);
+    _barrier();
+    rb->reads += n;
+    return n;
 }
 
 int tsrb_drop(tsrb_t *rb, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        _pop(rb);
-        tmp--;
+    size_t avail = tsrb_avail(rb);
+
+    if (n > avail) {
+        n = avail;
     }
-    return (n - tmp);
+    rb->reads += n;
+    return n;
 }
 
 int tsrb_add_one(tsrb_t *rb, char c)
@@ -72,10 +96,47 @@ int tsrb_add_one(tsrb_t *rb, char c)
 
 int tsrb_add(tsrb_t *rb, const char *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    size_t len;
+    char *dst = tsrb_reserve(rb, &len);
+
+    if (n <= len) {
+        memcpy(dst, src, n);
+    }
+    else {
+        size_t free = tsrb_free(rb);
+
+        if (n > free) {
+            n = free;
+        }
+        memcpy(dst, src, len);
+        memcpy(rb->buf, src + len, n - len);
     }
-    return (n - tmp);
+    tsrb_commit(rb, n);
+    return n;
+}
+
+char *tsrb_reserve(tsrb_t *rb, size_t *n)
+{
+    unsigned pos = rb->writes & (rb->size - 1);
+    size_t free = tsrb_free(rb);
+
+    *n = (free < rb->size - pos) ? free : rb->size - pos;
+    _barrier();
+    return &rb->buf[pos];
+}
+
+void tsrb_commit(tsrb_t *rb, size_t n)
+{
+    _barrier();
+    rb->writes += n;
+}
+
+char *tsrb_peek_region(tsrb_t *rb, size_t *n)
+{
+    unsigned pos = rb->reads & (rb->size - 1);
+    size_t avail = tsrb_avail(rb);
+
+    *n = (avail < rb->size - pos) ? avail : rb->size - pos;
+    _barrier();
+    return &rb->buf[pos];
 }
@@ -25,6 +25,8 @@
 #include "net/gnrc/ipv6.h"
 #endif
 #endif
+#include "bitalloc.h"
+#include "hashes.h"
 #include "mutex.h"
 
 #define ENABLE_DEBUG (0)
@@ -46,6 +48,13 @@
 #   define UNIVERSAL_ADDRESS_MAX_ENTRIES    (UA_ADD0)
 #endif
 
+/**
+ * @brief Number of hash buckets indexing the entries
+ */
+#ifndef UNIVERSAL_ADDRESS_BUCKETS
+#define UNIVERSAL_ADDRESS_BUCKETS           (UNIVERSAL_ADDRESS_MAX_ENTRIES + 1)
+#endif
+
 /**
  * @brief counter indicating the number of entries allocated
  */
@@ -56,11 +65,62 @@ static size_t universal_address_table_filled = 0;
  */
 static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_MAX_ENTRIES];
 
+/**
+ * @brief the entries with a use_count of 0
+ */
+static bitalloc_t universal_address_unused;
+static unsigned universal_address_unused_map[BITALLOC_MAP_WORDS(UNIVERSAL_ADDRESS_MAX_ENTRIES)];
+static unsigned universal_address_unused_summary[BITALLOC_SUMMARY_WORDS(UNIVERSAL_ADDRESS_MAX_ENTRIES)];
+
 /**
  * @brief access mutex to control exclusive operations on calls
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
+/**
+ * @brief index + 1 of the first entry of each bucket, 0 for none
+ *
+ * All entries holding an address are indexed, including unused ones, as
+ * their address is kept for reuse.
+ */
+static uint16_t universal_address_buckets[UNIVERSAL_ADDRESS_BUCKETS];
+
+/**
+ * @brief index + 1 of the next entry of the same bucket, 0 for none
+ */
+static uint16_t universal_address_chain[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
+static uint16_t *universal_address_bucket(const uint8_t *addr, size_t addr_size)
+{
+    uint32_t hash = murmur3_32_hash(addr, addr_size, addr_size);
+
+    return &universal_address_buckets[hash % UNIVERSAL_ADDRESS_BUCKETS];
+}
+
+static void universal_address_link(universal_address_container_t *entry)
+{
+    uint16_t *bucket = universal_address_bucket(entry->address,
+                                                entry->address_size);
+    size_t idx = entry - universal_address_table;
+
+    universal_address_chain[idx] = *bucket;
+    *bucket = idx + 1;
+}
+
+static void universal_address_unlink(universal_address_container_t *entry)
+{
+    uint16_t *pos = universal_address_bucket(entry->address,
+                                             entry->address_size);
+    size_t idx = entry - universal_address_table;
+
+    while (*pos && (*pos != idx + 1)) {
+        pos = &universal_address_chain[*pos - 1];
+    }
+    if (*pos) {
+        *pos = universal_address_chain[idx];
+    }
+}
+
 /**
  * @brief finds the universal address container for the given address
  *
@@ -72,14 +132,13 @@ static mutex_t mtx_access = MUTEX_INIT;
  */
 static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
 {
-    /* cppcheck-suppress unsignedLessThanZero
-     * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
-     * code is optimized out) */
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        if (universal_address_table[i].address_size == addr_size) {
-            if (memcmp((universal_address_table[i].address), addr, addr_size) == 0) {
-                return &(universal_address_table[i]);
-            }
+    for (uint16_t i = *universal_address_bucket(addr, addr_size); i;
+         i = universal_address_chain[i - 1]) {
+        universal_address_container_t *entry = &universal_address_table[i - 1];
+
+        if ((entry->address_size == addr_size) &&
+            (memcmp(entry->address, addr, addr_size) == 0)) {
+            return entry;
         }
     }
 
@@ -94,20 +153,9 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
  */
 static universal_address_container_t *universal_address_get_next_unused_entry(void)
 {
-    /* cppcheck-suppress unsignedLessThanZero
-     * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
-     * code is optimized out) */
-    if (universal_address_table_filled < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
-        /* cppcheck-suppress unsignedLessThanZero
-         * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero, see above) */
-        for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-            if (universal_address_table[i].use_count == 0) {
-                return &(universal_address_table[i]);
-            }
-        }
-    }
+    int i = bitalloc_find(&universal_address_unused);
 
-    return NULL;
+    return (i < 0) ? NULL : &(universal_address_table[i]);
 }
 
 universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_size)
@@ -125,6 +173,9 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
             return NULL;
         }
 
+        /* the former address is not found anymore */
+        universal_address_unlink(pEntry);
+
         /* look if the former memory has distinct size */
         if (pEntry->address_size != addr_size) {
             /* clean the address */
@@ -137,6 +188,7 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
 
         /* copy the address */
         memcpy((pEntry->address), addr, addr_size);
+        universal_address_link(pEntry);
     }
 
     pEntry->use_count++;
@@ -145,6 +197,8 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
         DEBUG("[universal_address_add] universal_address_table_filled: %d\n", \
               (int)universal_address_table_filled);
         universal_address_table_filled++;
+        bitalloc_take(&universal_address_unused,
+                      pEntry - universal_address_table);
     }
 
     mutex_unlock(&mtx_access);
@@ -163,6 +217,8 @@ void universal_address_rem(universal_address_container_t *entry)
 
             if (entry->use_count == 0) {
                 universal_address_table_filled--;
+                bitalloc_put(&universal_address_unused,
+                             entry - universal_address_table);
             }
         }
         else {
@@ -310,6 +366,11 @@ void universal_address_init(void)
         universal_address_table[i].address_size = 0;
         memset(universal_address_table[i].address, 0, UNIVERSAL_ADDRESS_SIZE);
     }
+    memset(universal_address_buckets, 0, sizeof(universal_address_buckets));
+    bitalloc_init(&universal_address_unused, universal_address_unused_map,
+                  universal_address_unused_summary,
+                  UNIVERSAL_ADDRESS_MAX_ENTRIES);
+    universal_address_table_filled = 0;
 
     mutex_unlock(&mtx_access);
 }
@@ -325,6 +386,7 @@ void universal_address_reset(void)
         universal_address_table[i].use_count = 0;
     }
 
+    bitalloc_reset(&universal_address_unused);
     universal_address_table_filled = 0;
     mutex_unlock(&mtx_access);
 }
@@ -249,6 +249,24 @@ off_t vfs_lseek(int fd, off_t off, int whence)
     return filp->f_op->lseek(filp, off, whence);
 }
 
+ssize_t vfs_mmap(int fd, const void **addr)
+{
+    DEBUG("vfs_mmap: %d, %p\n", fd, (void *)addr);
+    if (addr == NULL) {
+        return -EFAULT;
+    }
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (filp->f_op->mmap == NULL) {
+        /* driver does not implement mmap() */
+        return -ENOTSUP;
+    }
+    return filp->f_op->mmap(filp, addr);
+}
+
 int vfs_open(const char *name, int flags, mode_t mode)
 {
     DEBUG("vfs_open: \"%s\", 0x%x, 0%03lo\n", name, flags, (long unsigned int)mode);
@@ -333,6 +351,50 @@ ssize_t vfs_write(int fd, const void *src, size_t count)
     return filp->f_op->write(filp, src, count);
 }
 
+ssize_t vfs_readv(int fd, const iolist_t *iolist)
+{
+    ssize_t total = 0;
+
+    DEBUG("vfs_readv: %d, %p\n", fd, (void *)iolist);
+    for (; iolist != NULL; iolist = iolist->iol_next) {
+        if (iolist->iol_len == 0) {
+            continue;
+        }
+        ssize_t res = vfs_read(fd, iolist->iol_base, iolist->iol_len);
+        if (res < 0) {
+            return (total > 0) ? total : res;
+        }
+        total += res;
+        if ((size_t)res < iolist->iol_len) {
+            /* end of file */
+            break;
+        }
+    }
+    return total;
+}
+
+ssize_t vfs_writev(int fd, const iolist_t *iolist)
+{
+    ssize_t total = 0;
+
+    DEBUG_NOT_STDOUT(fd, "vfs_writev: %d, %p\n", fd, (void *)iolist);
+    for (; iolist != NULL; iolist = iolist->iol_next) {
+        if (iolist->iol_len == 0) {
+            continue;
+        }
+        ssize_t res = vfs_write(fd, iolist->iol_base, iolist->iol_len);
+        if (res < 0) {
+            return (total > 0) ? total : res;
+        }
+        total += res;
+        if ((size_t)res < iolist->iol_len) {
+            /* file system is full */
+            break;
+        }
+    }
+    return total;
+}
+
 int vfs_opendir(vfs_DIR *dirp, const char *dirname)
 {
     DEBUG("vfs_opendir: %p, \"%s\"\n", (void *)dirp, dirname);
@@ -462,6 +524,17 @@ int vfs_format(vfs_mount_t *mountp)
     return -ENOTSUP;
 }
 
+static int _mount_len_cmp(clist_node_t *a, clist_node_t *b)
+{
+    size_t a_len = container_of(a, vfs_mount_t, list_entry)->mount_point_len;
+    size_t b_len = container_of(b, vfs_mount_t, list_entry)->mount_point_len;
+
+    if (a_len > b_len) {
+        return -1;
+    }
+    return (a_len < b_len) ? 1 : 0;
+}
+
 int vfs_mount(vfs_mount_t *mountp)
 {
     DEBUG("vfs_mount: %p\n", (void *)mountp);
@@ -481,8 +554,10 @@ int vfs_mount(vfs_mount_t *mountp)
             }
         }
     }
-    /* insert last in list */
+    /* insert last in list, then keep the longest mount points first for
+     * _find_mount */
     clist_rpush(&_vfs_mounts_list, &mountp->list_entry);
+    clist_sort(&_vfs_mounts_list, _mount_len_cmp);
     mutex_unlock(&_mount_mutex);
     DEBUG("vfs_mount: mount done\n");
     return 0;
@@ -924,8 +999,6 @@ static inline int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *moun
 
 static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const char **rel_path)
 {
-    size_t longest_match = 0;
-    size_t name_len = strlen(name);
     mutex_lock(&_mount_mutex);
 
     clist_node_t *node = _vfs_mounts_list.next;
@@ -934,30 +1007,22 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
         mutex_unlock(&_mount_mutex);
         return -ENOENT;
     }
+    /* the mounts are sorted by descending mount point length (see
+     * vfs_mount), so the first match is the longest one */
     vfs_mount_t *mountp = NULL;
     do {
         node = node->next;
         vfs_mount_t *it = container_of(node, vfs_mount_t, list_entry);
         size_t len = it->mount_point_len;
-        if (len < longest_match) {
-            /* Already found a longer prefix */
+        /* strncmp stops at the end of name, if it is shorter */
+        if (strncmp(name, it->mount_point, len) != 0) {
             continue;
         }
-        if (len > name_len) {
-            /* path name is shorter than the mount point name */
-            continue;
-        }
-        if ((len > 1) && (name[len] != '/') && (name[len] != '\0')) {
-            /* name does not have a directory separator where mount point name ends */
-            continue;
-        }
-        if (strncmp(name, it->mount_point, len) == 0) {
-            /* mount_point is a prefix of name */
-            /* special check for mount_point == "/" */
-            if (len > 1) {
-                longest_match = len;
-            }
+        /* name must have a directory separator where mount point name ends,
+         * except for mount_point == "/" */
+        if ((len == 1) || (name[len] == '/') || (name[len] == '\0')) {
             mountp = it;
+            break;
         }
     } while (node != _vfs_mounts_list.next);
     if (mountp == NULL) {
@@ -970,7 +1035,9 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
     mutex_unlock(&_mount_mutex);
     *mountpp = mountp;
     if (rel_path != NULL) {
-        *rel_path = name + longest_match;
+        /* the relative path keeps its leading slash for mount_point == "/" */
+        *rel_path = (mountp->mount_point_len > 1) ? name + mountp->mount_point_len
+                                                   : name;
     }
     return 0;
 }
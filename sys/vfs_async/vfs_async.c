@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_vfs_async
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous VFS I/O implementation
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+#include "vfs.h"
+#include "vfs_async.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static void _handler(event_t *event)
+{
+    vfs_async_t *req = container_of(event, vfs_async_t, super);
+
+    if (req->write) {
+        req->res = vfs_writev(req->fd, req->iolist);
+    }
+    else {
+        req->res = vfs_readv(req->fd, req->iolist);
+    }
+    DEBUG("vfs_async: %s %d: %d\n", req->write ? "write" : "read", req->fd,
+          (int)req->res);
+    event_post(req->queue, req->done);
+}
+
+static void _post(vfs_async_t *req, int fd, const iolist_t *iolist,
+                  bool write, event_queue_t *queue, event_t *done)
+{
+    req->super.handler = _handler;
+    req->iolist = iolist;
+    req->queue = queue;
+    req->done = done;
+    req->fd = fd;
+    req->write = write;
+    event_post(event_workq(VFS_ASYNC_PRIO), &req->super);
+}
+
+void vfs_readv_async(vfs_async_t *req, int fd, const iolist_t *iolist,
+                     event_queue_t *queue, event_t *done)
+{
+    _post(req, fd, iolist, false, queue, done);
+}
+
+void vfs_writev_async(vfs_async_t *req, int fd, const iolist_t *iolist,
+                      event_queue_t *queue, event_t *done)
+{
+    _post(req, fd, iolist, true, queue, done);
+}
+
+void vfs_read_async(vfs_async_t *req, int fd, void *dest, size_t count,
+                    event_queue_t *queue, event_t *done)
+{
+    req->buf.iol_next = NULL;
+    req->buf.iol_base = dest;
+    req->buf.iol_len = count;
+    _post(req, fd, &req->buf, false, queue, done);
+}
+
+void vfs_write_async(vfs_async_t *req, int fd, const void *src, size_t count,
+                     event_queue_t *queue, event_t *done)
+{
+    req->buf.iol_next = NULL;
+    req->buf.iol_base = (void *)src;
+    req->buf.iol_len = count;
+    _post(req, fd, &req->buf, true, queue, done);
+}
@@ -26,6 +26,7 @@
 #include "mutex.h"
 #include "thread.h"
 #include "irq.h"
+#include "bitarithm.h"
 #include "div.h"
 #include "list.h"
 
@@ -183,6 +184,28 @@ void _xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_pid_t pid)
     _xtimer_set64(timer, offset, offset >> 32);
 }
 
+uint64_t _xtimer_slack(uint64_t offset, uint32_t slack)
+{
+    uint64_t now = _xtimer_now64();
+    uint64_t target = now + offset;
+    uint64_t latest = target + slack;
+    uint64_t diff = target ^ latest;
+    unsigned bit;
+
+    if (!diff) {
+        return offset;
+    }
+
+    /* both only share the bits above the highest differing one, where
+     * latest has a one and target a zero: clearing all bits of latest below
+     * it gives the value in [target, latest] with the most trailing zeros */
+    bit = (diff >> 32) ? (32 + bitarithm_msb(diff >> 32))
+                       : bitarithm_msb((uint32_t)diff);
+    latest &= ~((1ULL << bit) - 1);
+
+    return latest - now;
+}
+
 void xtimer_now_timex(timex_t *out)
 {
     uint64_t now = xtimer_usec_from_ticks64(xtimer_now64());
@@ -252,6 +275,7 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t timeout)
     xtimer_t t;
     mutex_thread_t mt = { mutex, (thread_t *)sched_active_thread, 0 };
 
+    t.target = t.long_target = 0;
     if (timeout != 0) {
         t.callback = _mutex_timeout;
         t.arg = (void *)((mutex_thread_t *)&mt);
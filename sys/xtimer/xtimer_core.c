@@ -46,6 +46,9 @@ static xtimer_t *timer_list_head = NULL;
 static xtimer_t *overflow_list_head = NULL;
 static xtimer_t *long_list_head = NULL;
 
+/* value the low-level timer is currently programmed to */
+static uint32_t _lltimer_target;
+
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
 static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
 static void _shoot(xtimer_t *timer);
@@ -53,6 +56,21 @@ static void _remove(xtimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
 static uint32_t _time_left(uint32_t target, uint32_t reference);
 
+#ifdef MODULE_XTIMER_STATS
+/* number of timers in a list, counting stops in the last histogram bucket to
+ * keep the ISR short */
+static unsigned _list_len(const xtimer_t *list)
+{
+    unsigned len = 0;
+
+    while (list && (len < (1U << (XTIMER_STATS_BUCKETS - 2)))) {
+        list = list->next;
+        len++;
+    }
+    return len;
+}
+#endif
+
 static void _timer_callback(void);
 static void _periph_timer_callback(void *arg, int chan);
 
@@ -83,17 +101,17 @@ void xtimer_init(void)
 
 static void _xtimer_now_internal(uint32_t *short_term, uint32_t *long_term)
 {
-    uint32_t before, after, long_value;
+    uint32_t short_value, long_value;
 
-    /* loop to cope with possible overflow of _xtimer_now() */
+    /* _next_period() advances _long_cnt in the overflow ISR, so a sample is
+     * consistent if _long_cnt did not change while reading the timer. This
+     * never masks interrupts and takes only one low-level timer read. */
     do {
-        before = _xtimer_now();
         long_value = _long_cnt;
-        after = _xtimer_now();
+        short_value = _xtimer_now();
+    } while (long_value != _long_cnt);
 
-    } while (before > after);
-
-    *short_term = after;
+    *short_term = short_value;
     *long_term = long_value;
 }
 
@@ -172,7 +190,13 @@ static inline void _lltimer_set(uint32_t target)
         return;
     }
     DEBUG("_lltimer_set(): setting %" PRIu32 "\n", _xtimer_lltimer_mask(target));
-    timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, _xtimer_lltimer_mask(target));
+    _lltimer_target = target;
+    _xtimer_lltimer_set_absolute(target);
+}
+
+void _xtimer_lltimer_rearm(void)
+{
+    _xtimer_lltimer_set_absolute(_lltimer_target);
 }
 
 int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
@@ -320,6 +344,20 @@ void xtimer_remove(xtimer_t *timer)
     irq_restore(state);
 }
 
+uint32_t xtimer_usec_until_next(void)
+{
+    unsigned state = irq_disable();
+    uint32_t target = _xtimer_lltimer_mask(0xFFFFFFFF);
+
+    if (timer_list_head) {
+        target = _xtimer_lltimer_mask(timer_list_head->target);
+    }
+    uint32_t left = _time_left(target, 0);
+    irq_restore(state);
+
+    return _xtimer_usec_from_ticks(left);
+}
+
 static uint32_t _time_left(uint32_t target, uint32_t reference)
 {
     uint32_t now = _xtimer_lltimer_now();
@@ -470,6 +508,10 @@ static void _timer_callback(void)
 
     _in_handler = 1;
 
+#ifdef MODULE_XTIMER_STATS
+    uint32_t start = _xtimer_lltimer_now();
+#endif
+
     DEBUG("_timer_callback() now=%" PRIu32 " (%" PRIu32 ")pleft=%" PRIu32 "\n",
           xtimer_now().ticks32, _xtimer_lltimer_mask(xtimer_now().ticks32),
           _xtimer_lltimer_mask(0xffffffff - xtimer_now().ticks32));
@@ -506,6 +548,11 @@ overflow:
         /* pick first timer in list */
         xtimer_t *timer = timer_list_head;
 
+#ifdef MODULE_XTIMER_STATS
+        _xtimer_stats_late(_xtimer_lltimer_mask(_xtimer_lltimer_now() -
+                                                timer->target));
+#endif
+
         /* advance list */
         timer_list_head = timer->next;
 
@@ -566,6 +613,11 @@ overflow:
         }
     }
 
+#ifdef MODULE_XTIMER_STATS
+    _xtimer_stats_isr(_xtimer_lltimer_mask(_xtimer_lltimer_now() - start),
+                      _list_len(timer_list_head), _list_len(long_list_head));
+#endif
+
     _in_handler = 0;
 
     /* set low level timer */
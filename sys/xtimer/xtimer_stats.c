@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_xtimer
+ * @{
+ *
+ * @file
+ * @brief       xtimer jitter and load statistics
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "irq.h"
+#include "xtimer.h"
+
+static xtimer_stats_t _stats;
+
+static unsigned _bucket(uint32_t val)
+{
+    unsigned i = 0;
+
+    while (val && (i < (XTIMER_STATS_BUCKETS - 1))) {
+        val >>= 1;
+        i++;
+    }
+    return i;
+}
+
+void _xtimer_stats_late(uint32_t ticks)
+{
+    uint32_t usec = _xtimer_usec_from_ticks(ticks);
+
+    _stats.late[_bucket(usec)]++;
+    if (usec > _stats.late_max) {
+        _stats.late_max = usec;
+    }
+}
+
+void _xtimer_stats_isr(uint32_t ticks, unsigned list, unsigned long_list)
+{
+    uint32_t usec = _xtimer_usec_from_ticks(ticks);
+
+    _stats.isr[_bucket(usec)]++;
+    if (usec > _stats.isr_max) {
+        _stats.isr_max = usec;
+    }
+    _stats.list[_bucket(list)]++;
+    _stats.long_list[_bucket(long_list)]++;
+}
+
+void xtimer_stats_get(xtimer_stats_t *stats)
+{
+    unsigned state = irq_disable();
+
+    memcpy(stats, &_stats, sizeof(_stats));
+    irq_restore(state);
+}
+
+void xtimer_stats_reset(void)
+{
+    unsigned state = irq_disable();
+
+    memset(&_stats, 0, sizeof(_stats));
+    irq_restore(state);
+}
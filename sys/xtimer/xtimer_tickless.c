@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_xtimer
+ *
+ * @{
+ * @file
+ * @brief xtimer timekeeping on the RTT during deep sleep
+ *
+ * While the xtimer timer is stopped, the RTT measures the time slept. On
+ * wake up, the time is added to the low-level timer counter as an offset.
+ * The sleep never reaches the next low-level timer event, so no timer
+ * period can pass unnoticed.
+ * @}
+ */
+
+#include <inttypes.h>
+
+#include "periph/rtt.h"
+#include "periph/timer.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#ifndef RTT_MAX_VALUE
+#define RTT_MAX_VALUE       (0xffffffff)
+#endif
+
+uint32_t _xtimer_lltimer_offset = 0;
+
+static uint32_t _rtt_start;
+/* most ticks the offset may be advanced by without passing the next event */
+static uint32_t _max_ticks;
+
+static void _rtt_cb(void *arg)
+{
+    /* only there to wake up the CPU */
+    (void)arg;
+}
+
+void xtimer_tickless_init(void)
+{
+    rtt_init();
+}
+
+int xtimer_tickless_suspend(uint32_t latency_us)
+{
+    uint32_t left = xtimer_usec_until_next();
+
+    if (left < XTIMER_TICKLESS_MIN_US + latency_us) {
+        return -1;
+    }
+
+    _max_ticks = _xtimer_ticks_from_usec(left) -
+                 (XTIMER_OVERHEAD + XTIMER_ISR_BACKOFF);
+    timer_stop(XTIMER_DEV);
+    _rtt_start = rtt_get_counter();
+
+    /* the alarm may fire up to two ticks early, but never late */
+    uint32_t sleep = RTT_US_TO_TICKS(left - latency_us);
+    DEBUG("xtimer_tickless: sleeping %" PRIu32 " RTT ticks\n", sleep);
+    rtt_set_alarm((_rtt_start + sleep) & RTT_MAX_VALUE, _rtt_cb, NULL);
+    return 0;
+}
+
+void xtimer_tickless_resume(void)
+{
+    uint32_t slept = (rtt_get_counter() - _rtt_start) & RTT_MAX_VALUE;
+    uint32_t ticks = _xtimer_ticks_from_usec(RTT_TICKS_TO_US(slept));
+
+    rtt_clear_alarm();
+    if (ticks > _max_ticks) {
+        /* the RTT is coarser than the timer, better lose a little time than
+         * to skip the next event */
+        ticks = _max_ticks;
+    }
+    _xtimer_lltimer_offset += ticks;
+    _xtimer_lltimer_rearm();
+    timer_start(XTIMER_DEV);
+}
@@ -0,0 +1,541 @@
+/**
+ * Copyright (C) 2015 Kaspar Schleiser <kaspar@schleiser.de>
+ *               2016 Eistec AB
+ *               2018 Josua Arndt
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_xtimer
+ *
+ * @{
+ * @file
+ * @brief xtimer core functionality, hierarchical timer wheel backend
+ *
+ * Drop-in replacement for xtimer_core.c, selected by the `xtimer_wheel`
+ * module.
+ *
+ * All armed timers are kept in a hierarchy of @ref XTIMER_WHEEL_LEVELS wheels
+ * of 2^@ref XTIMER_WHEEL_BITS slots each, indexed by the bits of their 64 bit
+ * target time.  A timer lives on the level of the most significant bit group
+ * in which its target differs from the current wheel time, so level 0 slots
+ * only contain timers expiring at exactly the same tick.  When the wheel time
+ * enters an occupied slot of a higher level, the slot's timers are cascaded
+ * down.  Timers too far in the future for the wheel are kept in an unsorted
+ * list that is redistributed once per wheel revolution.
+ *
+ * Slot lists are doubly linked, so both inserting and removing a timer are
+ * O(1).  The next expiry is found through per-level occupancy bitmaps in
+ * O(@ref XTIMER_WHEEL_LEVELS) without touching any timer.
+ *
+ * @author Kaspar Schleiser <kaspar@schleiser.de>
+ * @author Joakim Nohlgård <joakim.nohlgard@eistec.se>
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "board.h"
+#include "periph/timer.h"
+#include "periph_conf.h"
+
+#include "bitarithm.h"
+#include "xtimer.h"
+#include "irq.h"
+
+/* WARNING! enabling this will have side effects and can lead to timer underflows. */
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define WHEEL_SLOTS     (1U << XTIMER_WHEEL_BITS)
+#define WHEEL_MASK      (WHEEL_SLOTS - 1)
+#define WHEEL_SPAN_BITS (XTIMER_WHEEL_BITS * XTIMER_WHEEL_LEVELS)
+#define LLTIMER_MAX     (_xtimer_lltimer_mask(0xFFFFFFFF))
+
+static volatile int _in_handler = 0;
+
+static volatile uint32_t _long_cnt = 0;
+#if XTIMER_MASK
+volatile uint32_t _xtimer_high_cnt = 0;
+#endif
+
+/* low-level timer value seen the last time the period was synchronized */
+static uint32_t _last_ll = 0;
+/* time the low-level timer is currently programmed to */
+static uint64_t _alarm = 0;
+/* set if the low-level timer has been programmed to the end of the period */
+static int _alarm_at_period_end = 0;
+
+/* wheel time, all armed timers have a target >= _wheel_base */
+static uint64_t _wheel_base = 0;
+static xtimer_t *_wheel[XTIMER_WHEEL_LEVELS][WHEEL_SLOTS];
+static unsigned _occupied[XTIMER_WHEEL_LEVELS];
+static xtimer_t *_far_list = NULL;
+
+static void _timer_callback(void);
+static void _periph_timer_callback(void *arg, int chan);
+
+static inline int _is_set(xtimer_t *timer)
+{
+    return (timer->target || timer->long_target);
+}
+
+static inline uint64_t _target64(xtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+static inline void xtimer_spin_until(uint32_t target)
+{
+#if XTIMER_MASK
+    target = _xtimer_lltimer_mask(target);
+#endif
+    while (_xtimer_lltimer_now() > target) {}
+    while (_xtimer_lltimer_now() < target) {}
+}
+
+void xtimer_init(void)
+{
+    /* initialize low-level timer */
+    timer_init(XTIMER_DEV, XTIMER_HZ, _periph_timer_callback, NULL);
+
+    /* register initial overflow tick */
+    _alarm = LLTIMER_MAX;
+    _alarm_at_period_end = 1;
+    _xtimer_lltimer_set_absolute(LLTIMER_MAX);
+}
+
+/**
+ * @brief handle low-level timer overflow, advance to next short timer period
+ */
+static void _next_period(void)
+{
+#if XTIMER_MASK
+    /* advance <32bit mask register */
+    _xtimer_high_cnt += ~XTIMER_MASK + 1;
+    if (_xtimer_high_cnt == 0) {
+        /* high_cnt overflowed, so advance >32bit counter */
+        _long_cnt++;
+    }
+#else
+    /* advance >32bit counter */
+    _long_cnt++;
+#endif
+}
+
+/**
+ * @brief detect a low-level timer overflow since the last call
+ *
+ * The low-level timer is never programmed beyond the end of the current
+ * period, so at most one overflow can happen between two calls.
+ * Must be called with interrupts disabled.
+ */
+static void _sync_period(void)
+{
+    uint32_t ll = _xtimer_lltimer_now();
+
+    if (ll < _last_ll) {
+        _next_period();
+    }
+    _last_ll = ll;
+}
+
+static void _xtimer_now_internal(uint32_t *short_term, uint32_t *long_term)
+{
+    uint32_t before, after, long_value;
+
+    /* loop to cope with possible overflow of _xtimer_now() */
+    do {
+        before = _xtimer_now();
+        long_value = _long_cnt;
+        after = _xtimer_now();
+
+    } while (before > after);
+
+    *short_term = after;
+    *long_term = long_value;
+}
+
+uint64_t _xtimer_now64(void)
+{
+    uint32_t short_term, long_term;
+
+    _xtimer_now_internal(&short_term, &long_term);
+
+    return ((uint64_t)long_term << 32) + short_term;
+}
+
+/* must be called with interrupts disabled */
+static uint64_t _now64_locked(void)
+{
+    _sync_period();
+    return ((uint64_t)_long_cnt << 32) | _xtimer_now();
+}
+
+static void _list_add(xtimer_t **head, xtimer_t *timer)
+{
+    timer->next = *head;
+    timer->pprev = head;
+    if (*head) {
+        (*head)->pprev = &timer->next;
+    }
+    *head = timer;
+}
+
+static void _insert(xtimer_t *timer)
+{
+    uint64_t target = _target64(timer);
+
+    if (target < _wheel_base) {
+        /* already due, handled on the next wheel advance */
+        target = _wheel_base;
+    }
+
+    uint64_t diff = (target ^ _wheel_base) >> XTIMER_WHEEL_BITS;
+    unsigned level = 0;
+    while (diff && (level < XTIMER_WHEEL_LEVELS)) {
+        diff >>= XTIMER_WHEEL_BITS;
+        level++;
+    }
+
+    if (level == XTIMER_WHEEL_LEVELS) {
+        DEBUG("xtimer_wheel: timer %p goes to far list\n", (void *)timer);
+        _list_add(&_far_list, timer);
+        return;
+    }
+
+    unsigned slot = (target >> (XTIMER_WHEEL_BITS * level)) & WHEEL_MASK;
+    DEBUG("xtimer_wheel: timer %p at level %u slot %u\n", (void *)timer,
+          level, slot);
+    _list_add(&_wheel[level][slot], timer);
+    _occupied[level] |= (1U << slot);
+}
+
+static void _unlink(xtimer_t *timer)
+{
+    xtimer_t **pprev = timer->pprev;
+
+    *pprev = timer->next;
+    if (timer->next) {
+        timer->next->pprev = pprev;
+    }
+    else if ((pprev >= &_wheel[0][0]) &&
+             (pprev < &_wheel[0][0] + (XTIMER_WHEEL_LEVELS * WHEEL_SLOTS)) &&
+             (*pprev == NULL)) {
+        /* slot list is empty now */
+        unsigned idx = pprev - &_wheel[0][0];
+        _occupied[idx / WHEEL_SLOTS] &= ~(1U << (idx % WHEEL_SLOTS));
+    }
+    timer->next = NULL;
+    timer->pprev = NULL;
+}
+
+static void _remove(xtimer_t *timer)
+{
+    if (timer->pprev) {
+        _unlink(timer);
+    }
+    timer->target = 0;
+    timer->long_target = 0;
+}
+
+/**
+ * @brief find the next wheel time at which something needs to be done
+ *
+ * Either the expiry of a level 0 slot, the time at which an occupied slot of
+ * a higher level has to be cascaded, or the wrap of the whole wheel if
+ * timers are waiting in the far list.
+ *
+ * @return  0 if no timer is armed, 1 if @p next was set
+ */
+static int _next_event(uint64_t *next)
+{
+    for (unsigned level = 0; level < XTIMER_WHEEL_LEVELS; level++) {
+        unsigned shift = XTIMER_WHEEL_BITS * level;
+        unsigned cur = (_wheel_base >> shift) & WHEEL_MASK;
+        /* the current slot only needs handling on level 0, higher level
+         * slots are cascaded as soon as the wheel time enters them */
+        unsigned pending = _occupied[level] &
+                           ~((level ? (2U << cur) : (1U << cur)) - 1);
+        if (pending) {
+            /* all timers of this level expire before anything on higher
+             * levels, so the first hit is the earliest event */
+            uint64_t start = _wheel_base &
+                             ~((((uint64_t)1) << (shift + XTIMER_WHEEL_BITS)) - 1);
+            *next = start | ((uint64_t)bitarithm_lsb(pending) << shift);
+            return 1;
+        }
+    }
+
+    if (_far_list) {
+        *next = ((_wheel_base >> WHEEL_SPAN_BITS) + 1) << WHEEL_SPAN_BITS;
+        return 1;
+    }
+
+    return 0;
+}
+
+static void _reinsert_list(xtimer_t *list)
+{
+    while (list) {
+        xtimer_t *timer = list;
+        list = list->next;
+        _insert(timer);
+    }
+}
+
+static xtimer_t *_take_slot(unsigned level, unsigned slot)
+{
+    xtimer_t *list = _wheel[level][slot];
+
+    _wheel[level][slot] = NULL;
+    _occupied[level] &= ~(1U << slot);
+    return list;
+}
+
+/**
+ * @brief move the wheel time to @p t, cascade and fire what is due there
+ */
+static void _advance(uint64_t t)
+{
+    uint64_t old = _wheel_base;
+
+    _wheel_base = t;
+
+    if ((old >> WHEEL_SPAN_BITS) != (t >> WHEEL_SPAN_BITS)) {
+        xtimer_t *far = _far_list;
+        _far_list = NULL;
+        _reinsert_list(far);
+    }
+
+    for (unsigned level = XTIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+        unsigned slot = (t >> (XTIMER_WHEEL_BITS * level)) & WHEEL_MASK;
+        if (_occupied[level] & (1U << slot)) {
+            _reinsert_list(_take_slot(level, slot));
+        }
+    }
+
+    unsigned slot = t & WHEEL_MASK;
+    if (_occupied[0] & (1U << slot)) {
+        xtimer_t *list = _take_slot(0, slot);
+        while (list) {
+            xtimer_t *timer = list;
+            list = list->next;
+
+            /* make sure timer is recognized as being already fired */
+            timer->next = NULL;
+            timer->pprev = NULL;
+            timer->target = 0;
+            timer->long_target = 0;
+
+            /* fire timer */
+            timer->callback(timer->arg);
+        }
+    }
+}
+
+/**
+ * @brief program the low-level timer for the next event or period end
+ *
+ * An alarm that is already programmed earlier than needed is kept, the
+ * handler re-evaluates the wheel anyway.  This way a burst of xtimer_set()
+ * calls cannot keep pushing out an imminent alarm.
+ *
+ * Must be called with interrupts disabled.
+ */
+static void _update_alarm(void)
+{
+    if (_in_handler) {
+        return;
+    }
+
+    uint64_t now = _now64_locked();
+    uint64_t period_end = now | LLTIMER_MAX;
+    uint64_t alarm = period_end;
+    uint64_t next;
+
+    if (_next_event(&next) && (next < period_end)) {
+        if (next < now + XTIMER_OVERHEAD + XTIMER_ISR_BACKOFF) {
+            /* too close, the handler spins for the remaining ticks */
+            next = now + XTIMER_ISR_BACKOFF;
+        }
+        else {
+            next -= XTIMER_OVERHEAD;
+        }
+        if (next < period_end) {
+            alarm = next;
+        }
+    }
+
+    if (alarm >= _alarm) {
+        return;
+    }
+
+    _alarm = alarm;
+    _alarm_at_period_end = (alarm == period_end);
+    DEBUG("_update_alarm(): setting %" PRIu32 "\n", (uint32_t)alarm);
+    _xtimer_lltimer_set_absolute((uint32_t)alarm);
+}
+
+void _xtimer_lltimer_rearm(void)
+{
+    _xtimer_lltimer_set_absolute((uint32_t)_alarm);
+}
+
+static void _add(xtimer_t *timer)
+{
+    uint64_t next;
+
+    if (!_next_event(&next)) {
+        /* wheel is empty, catch up with the current time so the new timer
+         * does not need to be cascaded through all levels */
+        _wheel_base = _now64_locked();
+    }
+    _insert(timer);
+    _update_alarm();
+}
+
+void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
+    if (!long_offset) {
+        /* timer fits into the short timer */
+        _xtimer_set(timer, (uint32_t)offset);
+    }
+    else {
+        unsigned state = irq_disable();
+        if (_is_set(timer)) {
+            _remove(timer);
+        }
+
+        uint64_t target = _now64_locked() + offset +
+                          ((uint64_t)long_offset << 32);
+        timer->target = (uint32_t)target;
+        timer->long_target = (uint32_t)(target >> 32);
+
+        _add(timer);
+        irq_restore(state);
+        DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
+              timer->long_target, timer->target);
+    }
+}
+
+void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
+          offset, xtimer_now().ticks32, _xtimer_lltimer_now());
+    if (!timer->callback) {
+        DEBUG("timer_set(): timer has no callback.\n");
+        return;
+    }
+
+    xtimer_remove(timer);
+
+    if (offset < XTIMER_BACKOFF) {
+        _xtimer_spin(offset);
+        timer->callback(timer->arg);
+    }
+    else {
+        uint32_t target = _xtimer_now() + offset;
+        _xtimer_set_absolute(timer, target);
+    }
+}
+
+static void _periph_timer_callback(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+    _timer_callback();
+}
+
+int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    uint32_t now = _xtimer_now();
+
+    /* see xtimer_core.c for why 'target - now' is always the offset */
+    uint32_t offset = (target - now);
+
+    DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 " offset=%" PRIu32 "\n",
+          now, target, offset);
+
+    if (offset <= XTIMER_BACKOFF) {
+        /* backoff */
+        xtimer_spin_until(target);
+        timer->callback(timer->arg);
+        return 0;
+    }
+
+    unsigned state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+
+    uint64_t now64 = _now64_locked();
+    uint64_t target64 = (now64 & 0xFFFFFFFF00000000ull) | target;
+    if (target < (uint32_t)now64) {
+        /* 32 bit target overflow, target is in next 32bit period */
+        target64 += 0x100000000ull;
+    }
+    timer->target = target;
+    timer->long_target = (uint32_t)(target64 >> 32);
+
+    _add(timer);
+    irq_restore(state);
+
+    return 0;
+}
+
+void xtimer_remove(xtimer_t *timer)
+{
+    unsigned state = irq_disable();
+
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+    irq_restore(state);
+}
+
+uint32_t xtimer_usec_until_next(void)
+{
+    unsigned state = irq_disable();
+    uint64_t now = _now64_locked();
+    /* the alarm is never programmed beyond the end of the period */
+    uint32_t left = (_alarm > now) ? (uint32_t)(_alarm - now) : 0;
+    irq_restore(state);
+
+    return _xtimer_usec_from_ticks(left);
+}
+
+/**
+ * @brief main xtimer callback function
+ */
+static void _timer_callback(void)
+{
+    uint64_t next;
+
+    _in_handler = 1;
+
+    if (_alarm_at_period_end) {
+        /* make sure the timer counter also arrived
+         * in the next timer period */
+        while (_xtimer_lltimer_now() == LLTIMER_MAX) {}
+    }
+
+    /* only touch the wheel where something is due, timers firing close to
+     * each other are handled in one go */
+    while (_next_event(&next) &&
+           (next <= _now64_locked() + XTIMER_ISR_BACKOFF)) {
+        /* make sure we don't fire too early */
+        while (_now64_locked() < next) {}
+        _advance(next);
+    }
+
+    _in_handler = 0;
+
+    /* set low level timer */
+    _alarm = UINT64_MAX;
+    _update_alarm();
+}
@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the runtime of the ciphers, hashes and signatures of
+ *              sys/crypto, sys/hashes and the crypto packages
+ *
+ * Besides the time per call, the time per byte of the processed message is
+ * printed, so the results of different boards and implementations can be
+ * compared directly.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/modes/cbc.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/ecb.h"
+#include "hashes/sha256.h"
+#include "hashes/sha3.h"
+
+#ifdef MODULE_MICRO_ECC
+#include "uECC.h"
+#endif
+#ifdef MODULE_MONOCYPHER
+#include "monocypher.h"
+#endif
+#ifdef MODULE_TINYCRYPT
+#include "tinycrypt/aes.h"
+#endif
+#ifdef MODULE_TWEETNACL
+#include "tweetnacl.h"
+#endif
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL)
+#endif
+
+#ifndef BENCH_RUNS_SIGN
+#define BENCH_RUNS_SIGN     (1UL)
+#endif
+
+#define BUF_SIZE            (256U)
+#define MAC_SIZE            (16U)
+#define SIG_MSG_SIZE        (32U)
+
+#if defined(MODULE_PERIPH_HWCRYPTO)
+#define AES_IMPL            "hwcrypto"
+#elif defined(MODULE_CRYPTO_AES_CT)
+#define AES_IMPL            "riot-ct"
+#else
+#define AES_IMPL            "riot"
+#endif
+
+/**
+ * @brief   A benchmark case and what it measures
+ */
+typedef struct {
+    benchmark_case_t bench;     /**< the case run by benchmark_run() */
+    const char *impl;           /**< implementation measured */
+    size_t bytes;               /**< bytes processed per call */
+} bench_crypto_t;
+
+static const uint8_t _key[32] = {
+    0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+    0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+    0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+    0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4,
+};
+static const uint8_t _nonce[13];
+static uint8_t _iv[16];
+static uint8_t _in[BUF_SIZE];
+static uint8_t _out[BUF_SIZE + MAC_SIZE];
+static uint8_t _digest[SHA256_DIGEST_LENGTH];
+static cipher_t _cipher;
+
+BENCHMARK_LOOP(_aes_ecb, cipher_encrypt_ecb(&_cipher, _in, BUF_SIZE, _out))
+BENCHMARK_LOOP(_aes_cbc, cipher_encrypt_cbc(&_cipher, _iv, _in, BUF_SIZE,
+                                            _out))
+BENCHMARK_LOOP(_aes_ctr, cipher_encrypt_ctr(&_cipher, _iv, 8, _in, BUF_SIZE,
+                                            _out))
+BENCHMARK_LOOP(_aes_ccm, cipher_encrypt_ccm(&_cipher, NULL, 0, 8, 2, _nonce,
+                                            13, _in, BUF_SIZE, _out))
+BENCHMARK_LOOP(_chacha20poly1305,
+               chacha20poly1305_encrypt(_out, _in, BUF_SIZE, NULL, 0, _key,
+                                        _nonce))
+BENCHMARK_LOOP(_sha256, sha256(_in, BUF_SIZE, _digest))
+BENCHMARK_LOOP(_sha3_256, sha3_256(_digest, _in, BUF_SIZE))
+BENCHMARK_LOOP(_hmac_sha256, hmac_sha256(_key, sizeof(_key), _in, BUF_SIZE,
+                                         _digest))
+
+#ifdef MODULE_MICRO_ECC
+static uint8_t _uecc_priv[32];
+static uint8_t _uecc_pub[64];
+static uint8_t _uecc_sig[64];
+static uint8_t _uecc_tmp[2 * SHA256_DIGEST_LENGTH +
+                         SHA256_INTERNAL_BLOCK_SIZE];
+
+typedef struct {
+    uECC_HashContext uECC;
+    sha256_context_t ctx;
+} _uecc_hash_t;
+
+static void _uecc_init(const uECC_HashContext *base)
+{
+    sha256_init(&((_uecc_hash_t *)base)->ctx);
+}
+
+static void _uecc_update(const uECC_HashContext *base, const uint8_t *data,
+                         unsigned len)
+{
+    sha256_update(&((_uecc_hash_t *)base)->ctx, data, len);
+}
+
+static void _uecc_finish(const uECC_HashContext *base, uint8_t *hash)
+{
+    sha256_final(&((_uecc_hash_t *)base)->ctx, hash);
+}
+
+static _uecc_hash_t _uecc_hash = {
+    .uECC = {
+        .init_hash = _uecc_init,
+        .update_hash = _uecc_update,
+        .finish_hash = _uecc_finish,
+        .block_size = SHA256_INTERNAL_BLOCK_SIZE,
+        .result_size = SHA256_DIGEST_LENGTH,
+        .tmp = _uecc_tmp,
+    },
+};
+
+BENCHMARK_LOOP(_uecc_sign,
+               uECC_sign_deterministic(_uecc_priv, _in, SIG_MSG_SIZE,
+                                       &_uecc_hash.uECC, _uecc_sig,
+                                       uECC_secp256r1()))
+BENCHMARK_LOOP(_uecc_verify,
+               uECC_verify(_uecc_pub, _in, SIG_MSG_SIZE, _uecc_sig,
+                           uECC_secp256r1()))
+#endif
+
+#ifdef MODULE_MONOCYPHER
+static uint8_t _mc_pub[32];
+static uint8_t _mc_sig[64];
+
+BENCHMARK_LOOP(_mc_sign, crypto_sign(_mc_sig, _key, _mc_pub, _in,
+                                     SIG_MSG_SIZE))
+BENCHMARK_LOOP(_mc_verify, crypto_check(_mc_sig, _mc_pub, _in, SIG_MSG_SIZE))
+#endif
+
+#ifdef MODULE_TINYCRYPT
+static struct tc_aes_key_sched_struct _tc_sched;
+
+static void _tc_ecb(void)
+{
+    for (unsigned i = 0; i < BUF_SIZE; i += TC_AES_BLOCK_SIZE) {
+        tc_aes_encrypt(&_out[i], &_in[i], &_tc_sched);
+    }
+}
+
+BENCHMARK_LOOP(_tc_aes_ecb, _tc_ecb())
+#endif
+
+#ifdef MODULE_TWEETNACL
+static unsigned char _nacl_pub[crypto_sign_PUBLICKEYBYTES];
+static unsigned char _nacl_priv[crypto_sign_SECRETKEYBYTES];
+static unsigned char _nacl_sm[SIG_MSG_SIZE + crypto_sign_BYTES];
+static unsigned char _nacl_m[SIG_MSG_SIZE + crypto_sign_BYTES];
+static unsigned long long _nacl_len;
+
+BENCHMARK_LOOP(_nacl_sign, crypto_sign(_nacl_sm, &_nacl_len, _in,
+                                       SIG_MSG_SIZE, _nacl_priv))
+BENCHMARK_LOOP(_nacl_verify, crypto_sign_open(_nacl_m, &_nacl_len, _nacl_sm,
+                                              sizeof(_nacl_sm), _nacl_pub))
+#endif
+
+static const bench_crypto_t _cases[] = {
+    { { "aes128-ecb", _aes_ecb, BENCH_RUNS }, AES_IMPL, BUF_SIZE },
+    { { "aes128-cbc", _aes_cbc, BENCH_RUNS }, AES_IMPL, BUF_SIZE },
+    { { "aes128-ctr", _aes_ctr, BENCH_RUNS }, AES_IMPL, BUF_SIZE },
+    { { "aes128-ccm", _aes_ccm, BENCH_RUNS }, AES_IMPL, BUF_SIZE },
+#ifdef MODULE_TINYCRYPT
+    { { "aes128-ecb", _tc_aes_ecb, BENCH_RUNS }, "tinycrypt", BUF_SIZE },
+#endif
+    { { "chacha20-poly1305", _chacha20poly1305, BENCH_RUNS }, "riot",
+      BUF_SIZE },
+    { { "sha256", _sha256, BENCH_RUNS }, "riot", BUF_SIZE },
+    { { "sha3-256", _sha3_256, BENCH_RUNS }, "riot", BUF_SIZE },
+    { { "hmac-sha256", _hmac_sha256, BENCH_RUNS }, "riot", BUF_SIZE },
+#ifdef MODULE_MICRO_ECC
+    { { "ecdsa-p256 sign", _uecc_sign, BENCH_RUNS_SIGN }, "micro-ecc",
+      SIG_MSG_SIZE },
+    { { "ecdsa-p256 verify", _uecc_verify, BENCH_RUNS_SIGN }, "micro-ecc",
+      SIG_MSG_SIZE },
+#endif
+#ifdef MODULE_MONOCYPHER
+    { { "eddsa sign", _mc_sign, BENCH_RUNS_SIGN }, "monocypher",
+      SIG_MSG_SIZE },
+    { { "eddsa verify", _mc_verify, BENCH_RUNS_SIGN }, "monocypher",
+      SIG_MSG_SIZE },
+#endif
+#ifdef MODULE_TWEETNACL
+    { { "ed25519 sign", _nacl_sign, BENCH_RUNS_SIGN }, "tweetnacl",
+      SIG_MSG_SIZE },
+    { { "ed25519 verify", _nacl_verify, BENCH_RUNS_SIGN }, "tweetnacl",
+      SIG_MSG_SIZE },
+#endif
+};
+
+/* prints time / div with three decimal places */
+static void _print_div(const char *sep, int width, uint32_t time,
+                       uint64_t div)
+{
+    uint32_t full = (uint32_t)(time / div);
+    uint32_t frac = (uint32_t)(((time - (full * div)) * 1000) / div);
+
+    printf("%s%*" PRIu32 ".%03" PRIu32, sep, width, full, frac);
+}
+
+static void _print_header(void)
+{
+#if BENCHMARK_FORMAT == BENCHMARK_FORMAT_CSV
+    puts("name,impl,unit,bytes,runs,samples,median,min,max,stddev,"
+         "median_per_byte");
+#elif BENCHMARK_FORMAT == BENCHMARK_FORMAT_TEXT
+    printf("%-18s %-10s %6s  %14s %14s %14s  (%s)\n", "name", "impl",
+           "bytes", "per call", "stddev", "per byte", benchmark_unit());
+#endif
+}
+
+static void _print(const bench_crypto_t *c, const benchmark_result_t *res)
+{
+    unsigned long runs = c->bench.runs;
+    uint64_t bytes = (uint64_t)runs * c->bytes;
+
+#if BENCHMARK_FORMAT == BENCHMARK_FORMAT_JSON
+    printf("{\"name\": \"%s\", \"impl\": \"%s\", \"unit\": \"%s\", "
+           "\"bytes\": %u, \"runs\": %lu, \"samples\": %u",
+           c->bench.name, c->impl, benchmark_unit(), (unsigned)c->bytes, runs,
+           res->samples);
+    _print_div(", \"median\": ", 0, res->median, runs);
+    _print_div(", \"min\": ", 0, res->min, runs);
+    _print_div(", \"max\": ", 0, res->max, runs);
+    _print_div(", \"stddev\": ", 0, res->stddev, runs);
+    _print_div(", \"median_per_byte\": ", 0, res->median, bytes);
+    puts("}");
+#elif BENCHMARK_FORMAT == BENCHMARK_FORMAT_CSV
+    printf("%s,%s,%s,%u,%lu,%u", c->bench.name, c->impl, benchmark_unit(),
+           (unsigned)c->bytes, runs, res->samples);
+    _print_div(",", 0, res->median, runs);
+    _print_div(",", 0, res->min, runs);
+    _print_div(",", 0, res->max, runs);
+    _print_div(",", 0, res->stddev, runs);
+    _print_div(",", 0, res->median, bytes);
+    puts("");
+#else
+    printf("%-18s %-10s %6u ", c->bench.name, c->impl, (unsigned)c->bytes);
+    _print_div(" ", 10, res->median, runs);
+    _print_div(" ", 10, res->stddev, runs);
+    _print_div(" ", 10, res->median, bytes);
+    puts("");
+#endif
+}
+
+static void _setup(void)
+{
+    for (unsigned i = 0; i < sizeof(_in); i++) {
+        _in[i] = (uint8_t)((i * 7) + 3);
+    }
+    cipher_init(&_cipher, CIPHER_AES_128, _key, AES_KEY_SIZE);
+
+#ifdef MODULE_MICRO_ECC
+    memcpy(_uecc_priv, _key, sizeof(_uecc_priv));
+    uECC_compute_public_key(_uecc_priv, _uecc_pub, uECC_secp256r1());
+    _uecc_sign(1);
+#endif
+#ifdef MODULE_MONOCYPHER
+    crypto_sign_public_key(_mc_pub, _key);
+    _mc_sign(1);
+#endif
+#ifdef MODULE_TINYCRYPT
+    tc_aes128_set_encrypt_key(&_tc_sched, _key);
+#endif
+#ifdef MODULE_TWEETNACL
+    crypto_sign_keypair(_nacl_pub, _nacl_priv);
+    _nacl_sign(1);
+#endif
+}
+
+int main(void)
+{
+    _setup();
+
+    puts("crypto benchmark\n");
+    _print_header();
+    for (unsigned i = 0; i < sizeof(_cases) / sizeof(_cases[0]); i++) {
+        benchmark_result_t res;
+
+        benchmark_run(&_cases[i].bench, &res);
+        _print(&_cases[i], &res);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of the stages of sys/dsp_pipeline
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "dsp_pipeline.h"
+#include "periph_conf.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL)
+#endif
+
+#define BLOCK_LEN           (256U)
+#define FIR_NUMOF           (32U)
+#define BIQUAD_STAGES       (2U)
+#define DECIMATE_FACTOR     (4U)
+
+static dsp_q15_t _block[BLOCK_LEN];
+static dsp_q15_t _out[BLOCK_LEN];
+static dsp_q15_t _coeffs[FIR_NUMOF];
+static dsp_q15_t _fir_state[DSP_FIR_STATE_LEN(FIR_NUMOF, BLOCK_LEN)];
+static dsp_q15_t _dec_state[DSP_FIR_STATE_LEN(FIR_NUMOF, BLOCK_LEN)];
+static dsp_q15_t _bq_state[DSP_BIQUAD_STATE_LEN(BIQUAD_STAGES)];
+/* two low pass biquads of about 0.1 fs, a1 and a2 negated */
+static const dsp_q15_t _bq_coeffs[6 * BIQUAD_STAGES] = {
+    1064, 0, 2128, 1064, 18336, -6211,
+    1064, 0, 2128, 1064, 18336, -6211,
+};
+
+static dsp_convert_t _conv;
+static dsp_fir_t _fir;
+static dsp_decimate_t _dec;
+static dsp_biquad_t _bq;
+static dsp_features_t _feat;
+#ifdef MODULE_CMSIS_DSP
+static dsp_q15_t _fft_buf[2 * BLOCK_LEN];
+static dsp_fft_t _fft;
+#endif
+static dsp_pipeline_t _pipe;
+
+static void _process(dsp_stage_t *stage)
+{
+    size_t len = BLOCK_LEN;
+
+    stage->process(stage, _block, _out, &len);
+}
+
+static void _run(void)
+{
+    size_t len = BLOCK_LEN;
+
+    dsp_pipeline_run(&_pipe, _block, &len);
+}
+
+BENCHMARK_LOOP(_bench_convert, _process(&_conv.stage))
+BENCHMARK_LOOP(_bench_fir, _process(&_fir.stage))
+BENCHMARK_LOOP(_bench_decimate, _process(&_dec.stage))
+BENCHMARK_LOOP(_bench_biquad, _process(&_bq.stage))
+BENCHMARK_LOOP(_bench_features, _process(&_feat.stage))
+#ifdef MODULE_CMSIS_DSP
+BENCHMARK_LOOP(_bench_fft, _process(&_fft.stage))
+#endif
+BENCHMARK_LOOP(_bench_pipeline, _run())
+
+static const benchmark_case_t _cases[] = {
+    { "convert", _bench_convert, BENCH_RUNS },
+    { "fir 32", _bench_fir, BENCH_RUNS },
+    { "decimate 32 / 4", _bench_decimate, BENCH_RUNS },
+    { "biquad 2", _bench_biquad, BENCH_RUNS },
+    { "features", _bench_features, BENCH_RUNS },
+#ifdef MODULE_CMSIS_DSP
+    { "fft 256", _bench_fft, BENCH_RUNS },
+#endif
+    { "pipeline", _bench_pipeline, BENCH_RUNS },
+};
+
+static void _print_rate(const benchmark_case_t *bench,
+                        const benchmark_result_t *res)
+{
+    uint64_t samples = (uint64_t)BLOCK_LEN * bench->runs;
+    /* the time is either given in CPU cycles or in µs */
+    uint64_t per_sec = US_PER_SEC;
+
+#ifdef CLOCK_CORECLOCK
+    if (strcmp(benchmark_unit(), "cycles") == 0) {
+        per_sec = CLOCK_CORECLOCK;
+    }
+#endif
+
+    printf("%25s: %" PRIu32 " samples/s\n", bench->name,
+           (uint32_t)((samples * per_sec) / (res->median ? res->median : 1)));
+}
+
+int main(void)
+{
+    benchmark_result_t res[sizeof(_cases) / sizeof(_cases[0])];
+
+    for (unsigned i = 0; i < FIR_NUMOF; i++) {
+        /* triangle window, as a simple low pass */
+        unsigned dist = (i < FIR_NUMOF / 2) ? i + 1 : FIR_NUMOF - i;
+        _coeffs[i] = (dsp_q15_t)((dist * 32767U) / (FIR_NUMOF * FIR_NUMOF / 4));
+    }
+    for (unsigned i = 0; i < BLOCK_LEN; i++) {
+        _block[i] = (dsp_q15_t)((i * 2654435761U) >> 16);
+    }
+
+    dsp_convert_init(&_conv, 12);
+    dsp_fir_init(&_fir, _coeffs, FIR_NUMOF, _fir_state, BLOCK_LEN);
+    dsp_decimate_init(&_dec, _coeffs, FIR_NUMOF, DECIMATE_FACTOR, _dec_state,
+                      BLOCK_LEN);
+    dsp_biquad_init(&_bq, _bq_coeffs, BIQUAD_STAGES, 1, _bq_state);
+    dsp_features_init(&_feat);
+#ifdef MODULE_CMSIS_DSP
+    dsp_fft_init(&_fft, BLOCK_LEN, _fft_buf);
+#endif
+
+    /* the biquads and the features run on the decimated signal */
+    dsp_pipeline_init(&_pipe, _out, BLOCK_LEN);
+    dsp_pipeline_add(&_pipe, &_conv.stage);
+    dsp_pipeline_add(&_pipe, &_fir.stage);
+    dsp_pipeline_add(&_pipe, &_dec.stage);
+    dsp_pipeline_add(&_pipe, &_bq.stage);
+    dsp_pipeline_add(&_pipe, &_feat.stage);
+
+#ifdef MODULE_CMSIS_DSP
+    puts("dsp_pipeline with CMSIS DSP library");
+#else
+    puts("dsp_pipeline with portable code");
+#endif
+    printf("times for blocks of %u samples\n\n", BLOCK_LEN);
+
+    benchmark_print_header();
+    for (unsigned i = 0; i < sizeof(_cases) / sizeof(_cases[0]); i++) {
+        benchmark_run(&_cases[i], &res[i]);
+        benchmark_print_result(&_cases[i], &res[i]);
+    }
+    puts("");
+    for (unsigned i = 0; i < sizeof(_cases) / sizeof(_cases[0]); i++) {
+        _print_rate(&_cases[i], &res[i]);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
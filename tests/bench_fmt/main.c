@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the runtime of the number formatting of sys/fmt
+ *              compared to snprintf()
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "fmt.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (100UL)
+#endif
+
+#define NUMOF               (8U)
+
+static const uint32_t _u32[NUMOF] = {
+    0, 7, 42, 1000, 65535, 1234567, 99999999, UINT32_MAX,
+};
+static const uint64_t _u64[NUMOF] = {
+    0, 42, 65535, UINT32_MAX, 1099511627776LLU, 1000000000000000LLU,
+    1234567890123456789LLU, UINT64_MAX,
+};
+static const int32_t _dfp[NUMOF] = {
+    0, -7, 2150, -12345, 100000, 2147483647, -2147483647, 31415,
+};
+static const float _flt[NUMOF] = {
+    0.0f, 0.1f, -2.5f, 3.14159f, 1234.5678f, 1e-3f, 65504.0f, -0.333333f,
+};
+static char _buf[32];
+
+static void _fmt_u32(void)
+{
+    for (unsigned i = 0; i < NUMOF; i++) {
+        fmt_u32_dec(_buf, _u32[i]);
+    }
+}
+
+static void _printf_u32(void)
+{
+    for (unsigned i = 0; i < NUMOF; i++) {
+        snprintf(_buf, sizeof(_buf), "%" PRIu32, _u32[i]);
+    }
+}
+
+static void _fmt_u64(void)
+{
+    for (unsigned i = 0; i < NUMOF; i++) {
+        fmt_u64_dec(_buf, _u64[i]);
+    }
+}
+
+static void _fmt_dfp(void)
+{
+    for (unsigned i = 0; i < NUMOF; i++) {
+        fmt_s32_dfp(_buf, _dfp[i], -3);
+    }
+}
+
+static void _printf_dfp(void)
+{
+    for (unsigned i = 0; i < NUMOF; i++) {
+        int32_t val = _dfp[i];
+        uint32_t abs = (val < 0) ? -(uint32_t)val : (uint32_t)val;
+
+        snprintf(_buf, sizeof(_buf), "%s%" PRIu32 ".%03" PRIu32,
+                 (val < 0) ? "-" : "", abs / 1000, abs % 1000);
+    }
+}
+
+static void _fmt_float(void)
+{
+    for (unsigned i = 0; i < NUMOF; i++) {
+        fmt_float(_buf, _flt[i], 3);
+    }
+}
+
+static void _printf_float(void)
+{
+    for (unsigned i = 0; i < NUMOF; i++) {
+        snprintf(_buf, sizeof(_buf), "%.3f", (double)_flt[i]);
+    }
+}
+
+static void _fmt_float_shortest(void)
+{
+    for (unsigned i = 0; i < NUMOF; i++) {
+        fmt_float_shortest(_buf, _flt[i]);
+    }
+}
+
+static void _printf_float_g(void)
+{
+    /* nine digits always round-trip, but are not the shortest */
+    for (unsigned i = 0; i < NUMOF; i++) {
+        snprintf(_buf, sizeof(_buf), "%.9g", (double)_flt[i]);
+    }
+}
+
+BENCHMARK_LOOP(_bench_fmt_u32, _fmt_u32())
+BENCHMARK_LOOP(_bench_printf_u32, _printf_u32())
+BENCHMARK_LOOP(_bench_fmt_u64, _fmt_u64())
+BENCHMARK_LOOP(_bench_fmt_dfp, _fmt_dfp())
+BENCHMARK_LOOP(_bench_printf_dfp, _printf_dfp())
+BENCHMARK_LOOP(_bench_fmt_float, _fmt_float())
+BENCHMARK_LOOP(_bench_printf_float, _printf_float())
+BENCHMARK_LOOP(_bench_fmt_float_shortest, _fmt_float_shortest())
+BENCHMARK_LOOP(_bench_printf_float_g, _printf_float_g())
+
+static const benchmark_case_t _cases[] = {
+    { "fmt_u32_dec", _bench_fmt_u32, BENCH_RUNS },
+    { "snprintf %u", _bench_printf_u32, BENCH_RUNS },
+    { "fmt_u64_dec", _bench_fmt_u64, BENCH_RUNS },
+    { "fmt_s32_dfp -3", _bench_fmt_dfp, BENCH_RUNS },
+    { "snprintf %d.%03d", _bench_printf_dfp, BENCH_RUNS },
+    { "fmt_float 3", _bench_fmt_float, BENCH_RUNS },
+    { "snprintf %.3f", _bench_printf_float, BENCH_RUNS },
+    { "fmt_float_shortest", _bench_fmt_float_shortest, BENCH_RUNS },
+    { "snprintf %.9g", _bench_printf_float_g, BENCH_RUNS },
+};
+
+int main(void)
+{
+    printf("fmt, times for %u numbers\n\n", NUMOF);
+    benchmark_run_all(_cases, sizeof(_cases) / sizeof(_cases[0]));
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,565 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure throughput and latency of the GNRC network stack
+ *              over netdev_test devices
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iolist.h"
+#include "msg.h"
+#include "mutex.h"
+#include "net/ethernet.h"
+#include "net/gnrc.h"
+#include "net/gnrc/icmpv6.h"
+#include "net/gnrc/icmpv6/echo.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/udp.h"
+#include "net/icmpv6.h"
+#include "net/ieee802154.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000U)
+#endif
+
+#ifndef PAYLOAD_LEN
+#define PAYLOAD_LEN         (32U)
+#endif
+
+/* fragmented into three frames over IEEE 802.15.4 */
+#ifndef FRAG_PAYLOAD_LEN
+#define FRAG_PAYLOAD_LEN    (256U)
+#endif
+
+#define BENCH_PORT          (4242U)
+#define MSG_QUEUE_SIZE      (8U)
+#define TIMEOUT_US          (100U * US_PER_MS)
+#define IEEE802154_MAX_FRAG_SIZE    (102U)
+#define FRAMES_MAX          (4U)
+#define FRAME_SIZE          (IEEE802154_FRAME_LEN_MAX + 1)
+
+enum {
+    LINK_ETHERNET = 0,
+    LINK_IEEE802154,
+    LINK_NUMOF,
+};
+
+/* what the end of an operation is waiting for */
+enum {
+    WAIT_FRAMES = 0,    /* frames sent by a device */
+    WAIT_UDP,           /* a datagram delivered to the main thread */
+};
+
+typedef struct {
+    const char *test;
+    unsigned link;          /* link the operation starts at */
+    size_t len;             /* payload length */
+    void (*capture)(void);  /* if not NULL, the frames the operation
+                             * injects are captured from this one */
+    void (*op)(void);       /* operation to measure */
+    unsigned wait;
+} bench_t;
+
+static const char *_link_names[] = {
+    [LINK_ETHERNET] = "ethernet",
+    [LINK_IEEE802154] = "ieee802154",
+};
+
+static const uint8_t _eth_local[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const uint8_t _eth_remote[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+static const uint8_t _ieee802154_local[] = {
+    0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01
+};
+static const uint8_t _ieee802154_remote[] = {
+    0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02
+};
+
+/* 2001:db8:1::/64 is on the Ethernet link, 2001:db8:2::/64 is routed via
+ * the IEEE 802.15.4 neighbor */
+static ipv6_addr_t _eth_local_addr = { .u8 = {
+    0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01
+} };
+static ipv6_addr_t _eth_remote_addr = { .u8 = {
+    0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02
+} };
+static ipv6_addr_t _routed_pfx = { .u8 = {
+    0x20, 0x01, 0x0d, 0xb8, 0x00, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+} };
+static ipv6_addr_t _routed_addr = { .u8 = {
+    0x20, 0x01, 0x0d, 0xb8, 0x00, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02
+} };
+static ipv6_addr_t _ieee802154_remote_addr;
+
+static char _netif_stacks[LINK_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _devs[LINK_NUMOF];
+static gnrc_netif_t *_netifs[LINK_NUMOF];
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+
+/* operation state */
+static const bench_t *_bench;
+static uint16_t _seq;
+
+/* device state: frames sent since the start of an operation, the frames to
+ * capture, and the frame to receive */
+static mutex_t _sent = MUTEX_INIT_LOCKED;
+static volatile unsigned _frames;
+static unsigned _expected;
+static bool _capture;
+static unsigned _captured;
+static uint8_t _capture_buf[FRAMES_MAX][FRAME_SIZE];
+static size_t _capture_len[FRAMES_MAX];
+static const uint8_t *_rx_frame;
+static size_t _rx_len;
+
+static int _netdev_send(netdev_t *dev, const iolist_t *iolist)
+{
+    size_t len = iolist_size(iolist);
+
+    (void)dev;
+    if (_capture && (_captured < FRAMES_MAX) && (len <= FRAME_SIZE)) {
+        uint8_t *buf = _capture_buf[_captured];
+
+        for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
+            memcpy(buf, iol->iol_base, iol->iol_len);
+            buf += iol->iol_len;
+        }
+        _capture_len[_captured++] = len;
+    }
+    if (++_frames == _expected) {
+        mutex_unlock(&_sent);
+    }
+    return (int)len;
+}
+
+static int _netdev_recv(netdev_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return (int)_rx_len;
+    }
+    if ((size_t)len < _rx_len) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _rx_frame, _rx_len);
+    return (int)_rx_len;
+}
+
+static void _netdev_isr(netdev_t *dev)
+{
+    dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+static unsigned _link(netdev_t *dev)
+{
+    return (unsigned)((netdev_test_t *)dev - _devs);
+}
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)max_len;
+    *((uint16_t *)value) = (_link(dev) == LINK_ETHERNET)
+                         ? NETDEV_TYPE_ETHERNET : NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)max_len;
+    *((uint16_t *)value) = (_link(dev) == LINK_ETHERNET)
+                         ? ETHERNET_DATA_LEN : IEEE802154_MAX_FRAG_SIZE;
+    return sizeof(uint16_t);
+}
+
+static int _get_address(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    memcpy(value, _eth_local, sizeof(_eth_local));
+    return sizeof(_eth_local);
+}
+
+static int _get_address_long(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    memcpy(value, _ieee802154_local, sizeof(_ieee802154_local));
+    return sizeof(_ieee802154_local);
+}
+
+static int _get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = sizeof(_ieee802154_local);
+    return sizeof(uint16_t);
+}
+
+static int _get_proto(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static void _init_dev(unsigned link)
+{
+    netdev_test_t *dev = &_devs[link];
+
+    netdev_test_setup(dev, NULL);
+    netdev_test_set_send_cb(dev, _netdev_send);
+    netdev_test_set_recv_cb(dev, _netdev_recv);
+    netdev_test_set_isr_cb(dev, _netdev_isr);
+    netdev_test_set_get_cb(dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(dev, NETOPT_MAX_PACKET_SIZE, _get_max_packet_size);
+    if (link == LINK_ETHERNET) {
+        netdev_test_set_get_cb(dev, NETOPT_ADDRESS, _get_address);
+    }
+    else {
+        netdev_test_set_get_cb(dev, NETOPT_ADDRESS_LONG, _get_address_long);
+        netdev_test_set_get_cb(dev, NETOPT_SRC_LEN, _get_src_len);
+        netdev_test_set_get_cb(dev, NETOPT_PROTO, _get_proto);
+    }
+}
+
+static int _init(void)
+{
+    eui64_t iid;
+
+    _init_dev(LINK_ETHERNET);
+    _init_dev(LINK_IEEE802154);
+    _netifs[LINK_ETHERNET] = gnrc_netif_ethernet_create(
+            _netif_stacks[LINK_ETHERNET], THREAD_STACKSIZE_DEFAULT,
+            GNRC_NETIF_PRIO, "eth", (netdev_t *)&_devs[LINK_ETHERNET]);
+    _netifs[LINK_IEEE802154] = gnrc_netif_ieee802154_create(
+            _netif_stacks[LINK_IEEE802154], THREAD_STACKSIZE_DEFAULT,
+            GNRC_NETIF_PRIO, "ieee802154",
+            (netdev_t *)&_devs[LINK_IEEE802154]);
+    if ((_netifs[LINK_ETHERNET] == NULL) ||
+        (_netifs[LINK_IEEE802154] == NULL)) {
+        puts("unable to create interfaces");
+        return -1;
+    }
+    /* no router advertisements in between the measurements */
+    for (unsigned i = 0; i < LINK_NUMOF; i++) {
+        gnrc_ipv6_nib_change_rtr_adv_iface(_netifs[i], false);
+    }
+    if (gnrc_netapi_set(_netifs[LINK_ETHERNET]->pid, NETOPT_IPV6_ADDR,
+                        64U << 8U, &_eth_local_addr,
+                        sizeof(_eth_local_addr)) < 0) {
+        puts("unable to add address to Ethernet interface");
+        return -1;
+    }
+    ipv6_addr_set_link_local_prefix(&_ieee802154_remote_addr);
+    ieee802154_get_iid(&iid, _ieee802154_remote,
+                       sizeof(_ieee802154_remote));
+    ipv6_addr_set_aiid(&_ieee802154_remote_addr, iid.uint8);
+    if ((gnrc_ipv6_nib_nc_set(&_eth_remote_addr, _netifs[LINK_ETHERNET]->pid,
+                              _eth_remote, sizeof(_eth_remote)) < 0) ||
+        (gnrc_ipv6_nib_nc_set(&_ieee802154_remote_addr,
+                              _netifs[LINK_IEEE802154]->pid,
+                              _ieee802154_remote,
+                              sizeof(_ieee802154_remote)) < 0) ||
+        (gnrc_ipv6_nib_ft_add(&_routed_pfx, 64U, &_ieee802154_remote_addr,
+                              _netifs[LINK_IEEE802154]->pid, 0) < 0)) {
+        puts("unable to configure neighbors and routes");
+        return -1;
+    }
+    return 0;
+}
+
+static void _send(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *netif_hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+
+    if (netif_hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = _netifs[_bench->link]->pid;
+    LL_PREPEND(pkt, netif_hdr);
+    if (!gnrc_netapi_dispatch_send(type, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static void _send_udp(const ipv6_addr_t *src, const ipv6_addr_t *dst)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, _bench->len,
+                                          GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *udp, *ipv6;
+
+    if (pkt == NULL) {
+        return;
+    }
+    memset(pkt->data, 0x55, pkt->size);
+    udp = gnrc_udp_hdr_build(pkt, BENCH_PORT, BENCH_PORT);
+    if (udp == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ipv6 = gnrc_ipv6_hdr_build(udp, src, dst);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(udp);
+        return;
+    }
+    _send(ipv6, GNRC_NETTYPE_UDP);
+}
+
+static const ipv6_addr_t *_remote_addr(void)
+{
+    return (_bench->link == LINK_ETHERNET) ? &_eth_remote_addr
+                                           : &_ieee802154_remote_addr;
+}
+
+static void _op_udp_send(void)
+{
+    _send_udp(NULL, _remote_addr());
+}
+
+static void _op_echo_req_send(void)
+{
+    gnrc_pktsnip_t *pkt, *ipv6;
+
+    pkt = gnrc_icmpv6_echo_build(ICMPV6_ECHO_REQ, 1, _seq++, NULL,
+                                 _bench->len);
+    if (pkt == NULL) {
+        return;
+    }
+    ipv6 = gnrc_ipv6_hdr_build(pkt, NULL, _remote_addr());
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    _send(ipv6, GNRC_NETTYPE_IPV6);
+}
+
+static void _op_fwd_send(void)
+{
+    /* reversed by _reverse() into a datagram from the Ethernet neighbor to
+     * the routed prefix */
+    _send_udp(&_routed_addr, &_eth_remote_addr);
+}
+
+static void _op_inject(void)
+{
+    netdev_t *dev = (netdev_t *)&_devs[_bench->link];
+
+    for (unsigned i = 0; i < _captured; i++) {
+        /* the interface thread has a higher priority, so the frame is read
+         * before the next one is set */
+        _rx_frame = _capture_buf[i];
+        _rx_len = _capture_len[i];
+        dev->event_callback(dev, NETDEV_EVENT_ISR);
+    }
+}
+
+static void _swap(uint8_t *a, uint8_t *b, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        uint8_t tmp = a[i];
+
+        a[i] = b[i];
+        b[i] = tmp;
+    }
+}
+
+/* turns a captured frame into one the neighbor sent us */
+static int _reverse(uint8_t *frame)
+{
+    if (_bench->link == LINK_ETHERNET) {
+        uint8_t *ipv6 = frame + sizeof(ethernet_hdr_t);
+
+        _swap(frame + offsetof(ethernet_hdr_t, dst),
+              frame + offsetof(ethernet_hdr_t, src), ETHERNET_ADDR_LEN);
+        /* the checksums stay valid, the pseudo header sums both addresses */
+        _swap(ipv6 + offsetof(ipv6_hdr_t, src),
+              ipv6 + offsetof(ipv6_hdr_t, dst), sizeof(ipv6_addr_t));
+    }
+    else {
+        uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+        uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+        le_uint16_t src_pan, dst_pan;
+        int src_len = ieee802154_get_src(frame, src, &src_pan);
+        int dst_len = ieee802154_get_dst(frame, dst, &dst_pan);
+
+        /* the IPv6 addresses are elided by IPHC, so they are swapped with the
+         * link-layer addresses */
+        if ((src_len <= 0) || (dst_len <= 0) ||
+            (ieee802154_set_frame_hdr(frame, dst, dst_len, src, src_len,
+                                      dst_pan, src_pan,
+                                      IEEE802154_FCF_TYPE_DATA,
+                                      ieee802154_get_seq(frame)) == 0)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _capture_frames(void)
+{
+    _captured = 0;
+    _capture = true;
+    _bench->capture();
+    xtimer_usleep(TIMEOUT_US);
+    _capture = false;
+    if (_captured == 0) {
+        return -1;
+    }
+    for (unsigned i = 0; i < _captured; i++) {
+        if (_reverse(_capture_buf[i]) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static bool _done(void)
+{
+    if (_bench->wait == WAIT_FRAMES) {
+        return (xtimer_mutex_lock_timeout(&_sent, TIMEOUT_US) == 0);
+    }
+    else {
+        msg_t msg;
+        gnrc_pktsnip_t *pkt;
+        bool res;
+
+        if ((xtimer_msg_receive_timeout(&msg, TIMEOUT_US) < 0) ||
+            (msg.type != GNRC_NETAPI_MSG_TYPE_RCV)) {
+            return false;
+        }
+        pkt = msg.content.ptr;
+        res = (pkt->size == _bench->len);
+        gnrc_pktbuf_release(pkt);
+        return res;
+    }
+}
+
+static int _run(const bench_t *bench)
+{
+    uint32_t start, elapsed;
+    unsigned expected;
+
+    _bench = bench;
+    if ((bench->capture != NULL) && (_capture_frames() < 0)) {
+        printf("%s over %s: no frames to inject\n", bench->test,
+               _link_names[bench->link]);
+        return -1;
+    }
+    /* find the number of frames an operation causes */
+    _expected = 0;
+    _frames = 0;
+    bench->op();
+    xtimer_usleep(TIMEOUT_US);
+    expected = _frames;
+    if ((bench->wait == WAIT_FRAMES) ? (expected == 0) : !_done()) {
+        printf("%s over %s: operation failed\n", bench->test,
+               _link_names[bench->link]);
+        return -1;
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        mutex_trylock(&_sent);
+        _frames = 0;
+        _expected = expected;
+        bench->op();
+        if (!_done()) {
+            printf("%s over %s: operation %u timed out\n", bench->test,
+                   _link_names[bench->link], i);
+            return -1;
+        }
+    }
+    elapsed = xtimer_now_usec() - start;
+    _expected = 0;
+
+    printf("{ \"test\" : \"%s\", \"link\" : \"%s\", \"payload\" : %u, "
+           "\"frames\" : %u, \"pkts_per_s\" : %" PRIu32 ", "
+           "\"ns_per_pkt\" : %" PRIu32,
+           bench->test, _link_names[bench->link], (unsigned)bench->len,
+           expected,
+           (uint32_t)(((uint64_t)BENCH_RUNS * US_PER_SEC) / elapsed),
+           (uint32_t)(((uint64_t)elapsed * 1000U) / BENCH_RUNS));
+#ifdef CLOCK_CORECLOCK
+    printf(", \"cycles_per_pkt\" : %" PRIu32,
+           (uint32_t)(((uint64_t)elapsed * CLOCK_CORECLOCK) /
+                      ((uint64_t)US_PER_SEC * BENCH_RUNS)));
+#endif
+    puts(" }");
+    return 0;
+}
+
+static const bench_t _benches[] = {
+    { "udp_tx", LINK_ETHERNET, PAYLOAD_LEN, NULL, _op_udp_send,
+      WAIT_FRAMES },
+    { "udp_tx", LINK_IEEE802154, PAYLOAD_LEN, NULL, _op_udp_send,
+      WAIT_FRAMES },
+    { "udp_tx", LINK_IEEE802154, FRAG_PAYLOAD_LEN, NULL, _op_udp_send,
+      WAIT_FRAMES },
+    { "udp_rx", LINK_ETHERNET, PAYLOAD_LEN, _op_udp_send, _op_inject,
+      WAIT_UDP },
+    { "udp_rx", LINK_IEEE802154, PAYLOAD_LEN, _op_udp_send, _op_inject,
+      WAIT_UDP },
+    { "udp_rx", LINK_IEEE802154, FRAG_PAYLOAD_LEN, _op_udp_send, _op_inject,
+      WAIT_UDP },
+    { "icmpv6_echo", LINK_ETHERNET, PAYLOAD_LEN, _op_echo_req_send,
+      _op_inject, WAIT_FRAMES },
+    { "icmpv6_echo", LINK_IEEE802154, PAYLOAD_LEN, _op_echo_req_send,
+      _op_inject, WAIT_FRAMES },
+    /* received over Ethernet, forwarded over IEEE 802.15.4 */
+    { "ipv6_fwd", LINK_ETHERNET, PAYLOAD_LEN, _op_fwd_send, _op_inject,
+      WAIT_FRAMES },
+};
+
+int main(void)
+{
+    gnrc_netreg_entry_t me = GNRC_NETREG_ENTRY_INIT_PID(BENCH_PORT,
+                                                        sched_active_pid);
+    int res = 0;
+
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    if (_init() < 0) {
+        puts("\n[FAILED]");
+        return 1;
+    }
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &me);
+    /* let the interfaces finish their initialization */
+    xtimer_sleep(1);
+
+    for (unsigned i = 0; i < sizeof(_benches) / sizeof(_benches[0]); i++) {
+        if (_run(&_benches[i]) < 0) {
+            res = 1;
+        }
+    }
+
+    gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &me);
+    puts((res == 0) ? "\n[SUCCESS]" : "\n[FAILED]");
+    return res;
+}
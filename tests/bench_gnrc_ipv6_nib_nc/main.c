@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure runtime of neighbor lookups in the NIB
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/ipv6/addr.h"
+
+#include "_nib-internal.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#define NEIGHBOR_IFACE      (7U)
+
+static const unsigned _neighbors[] = { 16, 64, 256 };
+static const uint8_t _l2addr[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00 };
+static unsigned _numof;
+static unsigned _next;
+
+static void _set_addr(ipv6_addr_t *addr, unsigned idx)
+{
+    /* 2001:db8::<idx + 1> */
+    ipv6_addr_set_unspecified(addr);
+    addr->u8[0] = 0x20;
+    addr->u8[1] = 0x01;
+    addr->u8[2] = 0x0d;
+    addr->u8[3] = 0xb8;
+    addr->u8[14] = (idx + 1) >> 8;
+    addr->u8[15] = (idx + 1) & 0xff;
+}
+
+static void _lookup(void)
+{
+    ipv6_addr_t addr;
+
+    _set_addr(&addr, _next);
+    if (++_next >= _numof) {
+        _next = 0;
+    }
+    if (_nib_onl_get(&addr, NEIGHBOR_IFACE) == NULL) {
+        puts("error: neighbor not found");
+    }
+}
+
+BENCHMARK_LOOP(_bench_lookup, _lookup())
+
+int main(void)
+{
+    unsigned added = 0;
+    char name[32];
+    benchmark_case_t bench = { NULL, _bench_lookup, BENCH_RUNS };
+    benchmark_result_t res;
+
+    printf("Neighbor lookup (%s, GNRC_IPV6_NIB_NUMOF=%u)\n\n",
+           (GNRC_IPV6_NIB_CONF_ONL_HASH) ? "hash index" : "linear search",
+           (unsigned)GNRC_IPV6_NIB_NUMOF);
+    benchmark_print_header();
+
+    for (unsigned i = 0; i < sizeof(_neighbors) / sizeof(_neighbors[0]); i++) {
+        if (_neighbors[i] > GNRC_IPV6_NIB_NUMOF) {
+            break;
+        }
+        for (; added < _neighbors[i]; added++) {
+            ipv6_addr_t addr;
+
+            _set_addr(&addr, added);
+            if (gnrc_ipv6_nib_nc_set(&addr, NEIGHBOR_IFACE, _l2addr,
+                                     sizeof(_l2addr)) < 0) {
+                puts("error: unable to add neighbor");
+                return 1;
+            }
+        }
+        _numof = _neighbors[i];
+        _next = 0;
+        snprintf(name, sizeof(name), "%3u neighbors", _numof);
+        bench.name = name;
+        benchmark_run(&bench, &res);
+        benchmark_print_result(&bench, &res);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure latency and throughput of the GNRC receive path
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10000UL)
+#endif
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#ifndef BURST_SIZE
+#define BURST_SIZE          (4U)
+#endif
+
+#define BENCH_PORT          (4242U)
+#define PAYLOAD_LEN         (32U)
+#define MSG_QUEUE_SIZE      (8U)
+
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+#define MODE                "direct"
+#else
+#define MODE                "thread"
+#endif
+
+static struct {
+    ipv6_hdr_t ipv6;
+    udp_hdr_t udp;
+    uint8_t payload[PAYLOAD_LEN];
+} _datagram;
+
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static volatile unsigned _flag;
+static unsigned long _lost;
+
+static void _timer_cb(void *arg)
+{
+    (void)arg;
+    _flag = 1;
+}
+
+static void _init_datagram(void)
+{
+    uint16_t udp_len = sizeof(_datagram.udp) + sizeof(_datagram.payload);
+    uint16_t csum;
+
+    ipv6_hdr_set_version(&_datagram.ipv6);
+    _datagram.ipv6.len = byteorder_htons(udp_len);
+    _datagram.ipv6.nh = PROTNUM_UDP;
+    _datagram.ipv6.hl = 64;
+    ipv6_addr_set_loopback(&_datagram.ipv6.src);
+    ipv6_addr_set_loopback(&_datagram.ipv6.dst);
+    _datagram.udp.src_port = byteorder_htons(BENCH_PORT);
+    _datagram.udp.dst_port = byteorder_htons(BENCH_PORT);
+    _datagram.udp.length = byteorder_htons(udp_len);
+    for (unsigned i = 0; i < sizeof(_datagram.payload); i++) {
+        _datagram.payload[i] = (uint8_t)i;
+    }
+    csum = inet_csum(0, (uint8_t *)&_datagram.udp, udp_len);
+    csum = ~ipv6_hdr_inet_csum(csum, &_datagram.ipv6, PROTNUM_UDP, udp_len);
+    _datagram.udp.checksum = byteorder_htons((csum == 0) ? 0xffff : csum);
+}
+
+static void _inject(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, &_datagram, sizeof(_datagram),
+                                          GNRC_NETTYPE_IPV6);
+
+    if (pkt == NULL) {
+        _lost++;
+        return;
+    }
+    /* same as a network interface would do */
+    if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6,
+                                      GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+        gnrc_pktbuf_release(pkt);
+        _lost++;
+    }
+}
+
+static void _deliver(void)
+{
+    msg_t msg;
+    gnrc_pktsnip_t *pkt;
+
+    /* the layers either ran in this thread or have a higher priority, so
+     * the datagram is already queued when _inject() returns */
+    if ((msg_try_receive(&msg) < 0) ||
+        (msg.type != GNRC_NETAPI_MSG_TYPE_RCV)) {
+        _lost++;
+        return;
+    }
+    pkt = msg.content.ptr;
+    if (pkt->size != PAYLOAD_LEN) {
+        _lost++;
+    }
+    gnrc_pktbuf_release(pkt);
+}
+
+static uint32_t _bench_latency(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        _inject();
+        _deliver();
+    }
+    return (uint32_t)(((uint64_t)(xtimer_now_usec() - start) * 1000U) /
+                      BENCH_RUNS);
+}
+
+static uint32_t _bench_throughput(void)
+{
+    xtimer_t timer = { .callback = _timer_cb };
+    uint32_t n = 0;
+
+    _flag = 0;
+    xtimer_set(&timer, TEST_DURATION);
+    while (!_flag) {
+        for (unsigned i = 0; i < BURST_SIZE; i++) {
+            _inject();
+        }
+        for (unsigned i = 0; i < BURST_SIZE; i++) {
+            _deliver();
+        }
+        n += BURST_SIZE;
+    }
+    return (uint32_t)(((uint64_t)n * US_PER_SEC) / TEST_DURATION);
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t me = GNRC_NETREG_ENTRY_INIT_PID(BENCH_PORT,
+                                                        sched_active_pid);
+
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    _init_datagram();
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &me);
+
+    /* check the datagram is delivered at all before measuring */
+    _inject();
+    if ((_lost > 0) || (msg_avail() == 0)) {
+        puts("datagram was not delivered");
+        puts("\n[FAILED]");
+        return 1;
+    }
+    _deliver();
+
+    printf("{ \"test\" : \"latency\", \"mode\" : \"%s\", "
+           "\"ns_per_datagram\" : %" PRIu32 " }\n", MODE, _bench_latency());
+    printf("{ \"test\" : \"throughput\", \"mode\" : \"%s\", "
+           "\"datagrams_per_s\" : %" PRIu32 " }\n", MODE, _bench_throughput());
+
+    gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &me);
+    if (_lost > 0) {
+        printf("%lu datagrams lost\n", _lost);
+        puts("\n[FAILED]");
+        return 1;
+    }
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure runtime of SHA-256 and its derived functions
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "hashes/sha256.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (100UL)
+#endif
+
+#define BUF_SIZE            (1024U)
+#define MULTI_COUNT         (4U)
+#define MULTI_SIZE          (64U)
+#define CHAIN_LEN           (16U)
+
+static uint8_t _buf[BUF_SIZE];
+static uint8_t _digest[SHA256_DIGEST_LENGTH];
+static uint8_t _digests[MULTI_COUNT][SHA256_DIGEST_LENGTH];
+static const void *const _data[MULTI_COUNT] = {
+    &_buf[0 * MULTI_SIZE], &_buf[1 * MULTI_SIZE],
+    &_buf[2 * MULTI_SIZE], &_buf[3 * MULTI_SIZE],
+};
+static void *const _results[MULTI_COUNT] = {
+    _digests[0], _digests[1], _digests[2], _digests[3],
+};
+
+static void _sequential(void)
+{
+    for (unsigned i = 0; i < MULTI_COUNT; i++) {
+        sha256(_data[i], MULTI_SIZE, _results[i]);
+    }
+}
+
+BENCHMARK_LOOP(_bench_64, sha256(_buf, 64, _digest))
+BENCHMARK_LOOP(_bench_1024, sha256(_buf, BUF_SIZE, _digest))
+BENCHMARK_LOOP(_bench_hmac, hmac_sha256(_buf, 32, _buf, 64, _digest))
+BENCHMARK_LOOP(_bench_chain, sha256_chain(_buf, 32, CHAIN_LEN, _digest))
+BENCHMARK_LOOP(_bench_sequential, _sequential())
+BENCHMARK_LOOP(_bench_multi, sha256_multi(_data, MULTI_SIZE, _results,
+                                          MULTI_COUNT))
+
+static const benchmark_case_t _cases[] = {
+    { "sha256 64 byte", _bench_64, BENCH_RUNS },
+    { "sha256 1024 byte", _bench_1024, BENCH_RUNS },
+    { "hmac_sha256 64 byte", _bench_hmac, BENCH_RUNS },
+    { "sha256_chain 16 elements", _bench_chain, BENCH_RUNS },
+    { "4 x sha256 64 byte", _bench_sequential, BENCH_RUNS },
+    { "sha256_multi 4 x 64 byte", _bench_multi, BENCH_RUNS },
+};
+
+int main(void)
+{
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = (uint8_t)((i * 7) + 3);
+    }
+
+    puts("SHA-256\n");
+    benchmark_run_all(_cases, sizeof(_cases) / sizeof(_cases[0]));
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure runtime of the Internet Checksum calculation
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "net/inet_csum.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL)
+#endif
+
+#define BUF_SIZE            (1280U)
+
+/* keep word-aligned, one spare byte to test odd start addresses */
+static uint32_t _buf[(BUF_SIZE / sizeof(uint32_t)) + 1];
+static uint8_t _new_addr[16];
+static volatile uint16_t _res;
+
+#define _BUF                ((uint8_t *)_buf)
+
+BENCHMARK_LOOP(_bench_64, _res = inet_csum(0, _BUF, 64))
+BENCHMARK_LOOP(_bench_64_unaligned, _res = inet_csum(0, _BUF + 1, 64))
+BENCHMARK_LOOP(_bench_512, _res = inet_csum(0, _BUF, 512))
+BENCHMARK_LOOP(_bench_512_unaligned, _res = inet_csum(0, _BUF + 1, 512))
+BENCHMARK_LOOP(_bench_1280, _res = inet_csum(0, _BUF, 1280))
+BENCHMARK_LOOP(_bench_1280_unaligned, _res = inet_csum(0, _BUF + 1, 1280))
+BENCHMARK_LOOP(_bench_update, _res = inet_csum_update(_res, _BUF + 8, _new_addr,
+                                                      sizeof(_new_addr)))
+
+static const benchmark_case_t _cases[] = {
+    { "64 byte aligned", _bench_64, BENCH_RUNS },
+    { "64 byte unaligned", _bench_64_unaligned, BENCH_RUNS },
+    { "512 byte aligned", _bench_512, BENCH_RUNS },
+    { "512 byte unaligned", _bench_512_unaligned, BENCH_RUNS },
+    { "1280 byte aligned", _bench_1280, BENCH_RUNS },
+    { "1280 byte unaligned", _bench_1280_unaligned, BENCH_RUNS },
+    { "16 byte update", _bench_update, BENCH_RUNS },
+};
+
+int main(void)
+{
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _BUF[i] = (uint8_t)((i * 7) + 3);
+    }
+    for (unsigned i = 0; i < sizeof(_new_addr); i++) {
+        _new_addr[i] = (uint8_t)(0xa5 ^ i);
+    }
+
+    puts("Internet checksum\n");
+    benchmark_run_all(_cases, sizeof(_cases) / sizeof(_cases[0]));
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -11,7 +11,8 @@
  * @{
  *
  * @file
- * @brief       Measure messages send per second
+ * @brief       Measure messages send per second, also when receiving
+ *              batches from a message queue
  *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  *
@@ -28,8 +29,15 @@
 #define TEST_DURATION       (1000000U)
 #endif
 
+#define BATCH_QUEUE_SIZE    (32U)
+#define BATCH_MAX           (32U)
+#define MSG_TYPE_SYNC       (0x5a5a)
+
 volatile unsigned _flag = 0;
 static char _stack[THREAD_STACKSIZE_MAIN];
+static char _batch_stack[THREAD_STACKSIZE_DEFAULT];
+static volatile unsigned _batch_size;
+static const unsigned _batch_sizes[] = { 1, 8, 32 };
 
 static void _timer_callback(void*arg)
 {
@@ -50,6 +58,46 @@ static void *_second_thread(void *arg)
     return NULL;
 }
 
+static void *_batch_thread(void *arg)
+{
+    (void)arg;
+    static msg_t queue[BATCH_QUEUE_SIZE];
+    static msg_t msgs[BATCH_MAX];
+
+    msg_init_queue(queue, BATCH_QUEUE_SIZE);
+
+    while(1) {
+        int n = msg_receive_batch(msgs, _batch_size);
+
+        for (int i = 0; i < n; i++) {
+            if (msgs[i].type == MSG_TYPE_SYNC) {
+                msg_reply(&msgs[i], &msgs[i]);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static uint32_t _bench_batch(xtimer_t *timer, kernel_pid_t batch, unsigned size)
+{
+    msg_t test = { .type = 0 };
+    msg_t sync = { .type = MSG_TYPE_SYNC };
+    uint32_t n = 0;
+
+    _batch_size = size;
+    _flag = 0;
+    xtimer_set(timer, TEST_DURATION);
+    while(!_flag) {
+        msg_send(&test, batch);
+        n++;
+    }
+    /* wait until the receiver drained everything sent so far */
+    msg_send_receive(&sync, &sync, batch);
+
+    return n;
+}
+
 int main(void)
 {
     printf("main starting\n");
@@ -77,5 +125,21 @@ int main(void)
 
     printf("{ \"result\" : %"PRIu32" }\n", n);
 
+    /* the receiver has a lower priority so it only runs once the queue is
+     * full, then drains it in batches of the given size */
+    kernel_pid_t batch = thread_create(_batch_stack,
+                                       sizeof(_batch_stack),
+                                       (THREAD_PRIORITY_MAIN + 1),
+                                       THREAD_CREATE_STACKTEST,
+                                       _batch_thread,
+                                       NULL,
+                                       "batch_thread");
+
+    for (unsigned i = 0; i < sizeof(_batch_sizes) / sizeof(_batch_sizes[0]); i++) {
+        n = _bench_batch(&timer, batch, _batch_sizes[i]);
+        printf("{ \"batch\" : %u, \"result\" : %"PRIu32" }\n",
+               _batch_sizes[i], n);
+    }
+
     return 0;
 }
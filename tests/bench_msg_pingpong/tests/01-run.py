@@ -13,6 +13,8 @@ from testrunner import run
 
 def testfunc(child):
     child.expect(r"{ \"result\" : \d+ }")
+    for batch in (1, 8, 32):
+        child.expect(r"{ \"batch\" : %d, \"result\" : \d+ }" % batch)
 
 
 if __name__ == "__main__":
@@ -54,6 +54,9 @@ static void *_second_thread(void *arg)
 int main(void)
 {
     printf("main starting\n");
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    puts("priority inheritance enabled");
+#endif
 
     thread_create(_stack,
                   sizeof(_stack),
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare the sorted list priority_queue with priority_heap
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "priority_heap.h"
+#include "priority_queue.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL)
+#endif
+
+/* number of distinct priorities, as of e.g. packets of a few neighbours */
+#define PRIO_NUMOF          (16U)
+
+#define SIZES_NUMOF         (3U)
+
+static const unsigned _sizes[SIZES_NUMOF] = { 8, 64, 256 };
+
+static priority_queue_t _list[SIZES_NUMOF];
+static priority_queue_node_t _list_nodes[8 + 64 + 256];
+static priority_heap_t _heap[SIZES_NUMOF];
+static priority_heap_node_t _heap_nodes[8 + 64 + 256];
+
+static uint32_t _prio_state = 1;
+
+static uint32_t _prio(void)
+{
+    _prio_state = _prio_state * 1103515245U + 12345U;
+    return (_prio_state >> 16) % PRIO_NUMOF;
+}
+
+/* one step of a queue in equilibrium: take the head, add a new entry */
+static void _list_step(priority_queue_t *queue)
+{
+    priority_queue_node_t *node = priority_queue_remove_head(queue);
+
+    node->priority = _prio();
+    priority_queue_add(queue, node);
+}
+
+static void _heap_step(priority_heap_t *heap)
+{
+    priority_heap_node_t *node = priority_heap_remove_head(heap);
+
+    node->priority = _prio();
+    priority_heap_add(heap, node);
+}
+
+BENCHMARK_LOOP(_bench_list_8, _list_step(&_list[0]))
+BENCHMARK_LOOP(_bench_list_64, _list_step(&_list[1]))
+BENCHMARK_LOOP(_bench_list_256, _list_step(&_list[2]))
+BENCHMARK_LOOP(_bench_heap_8, _heap_step(&_heap[0]))
+BENCHMARK_LOOP(_bench_heap_64, _heap_step(&_heap[1]))
+BENCHMARK_LOOP(_bench_heap_256, _heap_step(&_heap[2]))
+
+static const benchmark_case_t _cases[] = {
+    { "priority_queue 8", _bench_list_8, BENCH_RUNS },
+    { "priority_queue 64", _bench_list_64, BENCH_RUNS },
+    { "priority_queue 256", _bench_list_256, BENCH_RUNS },
+    { "priority_heap 8", _bench_heap_8, BENCH_RUNS },
+    { "priority_heap 64", _bench_heap_64, BENCH_RUNS },
+    { "priority_heap 256", _bench_heap_256, BENCH_RUNS },
+};
+
+int main(void)
+{
+    benchmark_result_t res;
+    unsigned offset = 0;
+
+    for (unsigned i = 0; i < SIZES_NUMOF; i++) {
+        priority_queue_init(&_list[i]);
+        priority_heap_init(&_heap[i]);
+        for (unsigned j = 0; j < _sizes[i]; j++) {
+            priority_queue_node_t *list_node = &_list_nodes[offset + j];
+            priority_heap_node_t *heap_node = &_heap_nodes[offset + j];
+            uint32_t prio = _prio();
+
+            priority_queue_node_init(list_node);
+            list_node->priority = prio;
+            priority_queue_add(&_list[i], list_node);
+            priority_heap_node_init(heap_node);
+            heap_node->priority = prio;
+            priority_heap_add(&_heap[i], heap_node);
+        }
+        offset += _sizes[i];
+    }
+
+    puts("times for removing the head and adding an entry");
+    printf("at 8, 64 and 256 entries of %u priorities\n\n", PRIO_NUMOF);
+
+    benchmark_print_header();
+    for (unsigned i = 0; i < sizeof(_cases) / sizeof(_cases[0]); i++) {
+        benchmark_run(&_cases[i], &res);
+        benchmark_print_result(&_cases[i], &res);
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -26,7 +26,7 @@
 #include "thread_flags.h"
 
 #ifndef BENCH_RUNS
-#define BENCH_RUNS          (1000UL * 1000UL)
+#define BENCH_RUNS          (100UL * 1000UL)
 #endif
 
 static mutex_t _lock;
@@ -58,25 +58,37 @@ static void _flag_waitone(void)
     thread_flags_wait_one(_flag);
 }
 
+BENCHMARK_LOOP(_bench_nop, __asm__ volatile ("nop"))
+BENCHMARK_LOOP(_bench_mutex_init, mutex_init(&_lock))
+BENCHMARK_LOOP(_bench_mutex_lockunlock, _mutex_lockunlock())
+BENCHMARK_LOOP(_bench_flags_set, thread_flags_set(t, _flag))
+BENCHMARK_LOOP(_bench_flags_clear, thread_flags_clear(_flag))
+BENCHMARK_LOOP(_bench_flags_waitany, _flag_waitany())
+BENCHMARK_LOOP(_bench_flags_waitall, _flag_waitall())
+BENCHMARK_LOOP(_bench_flags_waitone, _flag_waitone())
+BENCHMARK_LOOP(_bench_msg_try_receive, msg_try_receive(&_msg))
+BENCHMARK_LOOP(_bench_msg_avail, msg_avail())
+
+static const benchmark_case_t _cases[] = {
+    { "nop loop", _bench_nop, BENCH_RUNS },
+    { "mutex_init()", _bench_mutex_init, BENCH_RUNS },
+    { "mutex lock/unlock", _bench_mutex_lockunlock, BENCH_RUNS },
+    { "thread_flags_set()", _bench_flags_set, BENCH_RUNS },
+    { "thread_flags_clear()", _bench_flags_clear, BENCH_RUNS },
+    { "thread flags set/wait any", _bench_flags_waitany, BENCH_RUNS },
+    { "thread flags set/wait all", _bench_flags_waitall, BENCH_RUNS },
+    { "thread flags set/wait one", _bench_flags_waitone, BENCH_RUNS },
+    { "msg_try_receive()", _bench_msg_try_receive, BENCH_RUNS },
+    { "msg_avail()", _bench_msg_avail, BENCH_RUNS },
+};
+
 int main(void)
 {
     puts("Runtime of Selected Core API functions\n");
 
     t = (thread_t *)sched_active_thread;
 
-    BENCHMARK_FUNC("nop loop", BENCH_RUNS, __asm__ volatile ("nop"));
-    puts("");
-    BENCHMARK_FUNC("mutex_init()", BENCH_RUNS, mutex_init(&_lock));
-    BENCHMARK_FUNC("mutex lock/unlock", BENCH_RUNS, _mutex_lockunlock());
-    puts("");
-    BENCHMARK_FUNC("thread_flags_set()", BENCH_RUNS, thread_flags_set(t, _flag));
-    BENCHMARK_FUNC("thread_flags_clear()", BENCH_RUNS, thread_flags_clear(_flag));
-    BENCHMARK_FUNC("thread flags set/wait any", BENCH_RUNS, _flag_waitany());
-    BENCHMARK_FUNC("thread flags set/wait all", BENCH_RUNS, _flag_waitall());
-    BENCHMARK_FUNC("thread flags set/wait one", BENCH_RUNS, _flag_waitone());
-    puts("");
-    BENCHMARK_FUNC("msg_try_receive()", BENCH_RUNS, msg_try_receive(&_msg));
-    BENCHMARK_FUNC("msg_avail()", BENCH_RUNS, msg_avail());
+    benchmark_run_all(_cases, sizeof(_cases) / sizeof(_cases[0]));
 
     puts("\n[SUCCESS]");
     return 0;
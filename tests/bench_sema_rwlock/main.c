@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Uncontended semaphore and reader/writer lock benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "pthread.h"
+#include "sema.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL)
+#endif
+
+static sema_t _sema = SEMA_CREATE_LOCKED();
+static pthread_rwlock_t _rwlock;
+
+static void _sema_post_wait(void)
+{
+    sema_post(&_sema);
+    sema_wait(&_sema);
+}
+
+static void _rdlock_nested(void)
+{
+    /* the inner unlock is not the last reader's */
+    pthread_rwlock_rdlock(&_rwlock);
+    pthread_rwlock_rdlock(&_rwlock);
+    pthread_rwlock_unlock(&_rwlock);
+    pthread_rwlock_unlock(&_rwlock);
+}
+
+static void _tryrdlock(void)
+{
+    pthread_rwlock_tryrdlock(&_rwlock);
+    pthread_rwlock_unlock(&_rwlock);
+}
+
+static void _rdlock(void)
+{
+    pthread_rwlock_rdlock(&_rwlock);
+    pthread_rwlock_unlock(&_rwlock);
+}
+
+static void _wrlock(void)
+{
+    pthread_rwlock_wrlock(&_rwlock);
+    pthread_rwlock_unlock(&_rwlock);
+}
+
+BENCHMARK_LOOP(_bench_sema_post_wait, _sema_post_wait())
+BENCHMARK_LOOP(_bench_sema_try_wait, sema_try_wait(&_sema))
+BENCHMARK_LOOP(_bench_rdlock, _rdlock())
+BENCHMARK_LOOP(_bench_rdlock_nested, _rdlock_nested())
+BENCHMARK_LOOP(_bench_tryrdlock, _tryrdlock())
+BENCHMARK_LOOP(_bench_wrlock, _wrlock())
+
+static const benchmark_case_t _cases[] = {
+    { "sema_post + sema_wait", _bench_sema_post_wait, BENCH_RUNS },
+    { "sema_try_wait (empty)", _bench_sema_try_wait, BENCH_RUNS },
+    { "rdlock + unlock", _bench_rdlock, BENCH_RUNS },
+    { "2x rdlock + 2x unlock", _bench_rdlock_nested, BENCH_RUNS },
+    { "tryrdlock + unlock", _bench_tryrdlock, BENCH_RUNS },
+    { "wrlock + unlock", _bench_wrlock, BENCH_RUNS },
+};
+
+int main(void)
+{
+    pthread_rwlock_init(&_rwlock, NULL);
+
+    puts("times of uncontended semaphore and reader/writer lock operations\n");
+    benchmark_run_all(_cases, sizeof(_cases) / sizeof(_cases[0]));
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure runtime of the 6LoWPAN IPHC decoder
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "byteorder.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "thread.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL)
+#endif
+
+#define MSG_QUEUE_SIZE      (4U)
+#define LARGE_PAYLOAD_LEN   (80U)
+
+typedef struct {
+    const uint8_t *data;    /**< the 6LoWPAN frame (without MAC header) */
+    size_t len;             /**< length of the frame */
+    size_t comp_hdr_len;    /**< length of the compressed headers */
+    size_t uncomp_hdr_len;  /**< length of the decompressed headers */
+    uint8_t nh;             /**< next header of the IPv6 header */
+} _frame_t;
+
+/* fe80::212:4b00:613:d2a -> fe80::212:4b00:613:d45, UDP 61617 -> 61618,
+ * hop limit 255 */
+#define UDP_64_HDR \
+    0x7f, 0x11, \
+    0x02, 0x12, 0x4b, 0x00, 0x06, 0x13, 0x0d, 0x2a, \
+    0x02, 0x12, 0x4b, 0x00, 0x06, 0x13, 0x0d, 0x45, \
+    0xf3, 0x12, 0x5a, 0x3c
+#define UDP_64_HDR_LEN      (22U)
+
+static const uint8_t _udp_64[] = {
+    UDP_64_HDR,
+    'h', 'e', 'l', 'l', 'o', ' ', '6', 'l', 'o', 'w', 'p', 'a', 'n', '!', '\n',
+    0x00
+};
+
+/* fe80::ff:fe00:1 -> fe80::ff:fe00:2, ICMPv6 echo request, hop limit 64 */
+static const uint8_t _icmpv6_16[] = {
+    0x7a, 0x22, PROTNUM_ICMPV6, 0x00, 0x01, 0x00, 0x02,
+    0x80, 0x00, 0xd4, 0x1b, 0x12, 0x34, 0x00, 0x01,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+};
+
+/* filled with a payload in main() */
+static uint8_t _udp_large[UDP_64_HDR_LEN + LARGE_PAYLOAD_LEN] = { UDP_64_HDR };
+
+static const _frame_t _frames[] = {
+    { _udp_64, sizeof(_udp_64), UDP_64_HDR_LEN,
+      sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t), PROTNUM_UDP },
+    { _icmpv6_16, sizeof(_icmpv6_16), 7U,
+      sizeof(ipv6_hdr_t), PROTNUM_ICMPV6 },
+    { _udp_large, sizeof(_udp_large), UDP_64_HDR_LEN,
+      sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t), PROTNUM_UDP },
+};
+
+static uint8_t _src_l2[] = { 0x02, 0x12, 0x4b, 0x00, 0x06, 0x13, 0x0d, 0x2a };
+static uint8_t _dst_l2[] = { 0x02, 0x12, 0x4b, 0x00, 0x06, 0x13, 0x0d, 0x45 };
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static unsigned _failed;
+
+static void _recv_frame(const _frame_t *frame)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+
+    netif = gnrc_netif_hdr_build(_src_l2, sizeof(_src_l2),
+                                 _dst_l2, sizeof(_dst_l2));
+    if (netif == NULL) {
+        _failed++;
+        return;
+    }
+    pkt = gnrc_pktbuf_add(netif, frame->data, frame->len,
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(netif);
+        _failed++;
+        return;
+    }
+    gnrc_sixlowpan_iphc_recv(pkt, NULL, 0);
+}
+
+static bool _check_frame(const _frame_t *frame)
+{
+    size_t payload_len = frame->len - frame->comp_hdr_len;
+    gnrc_pktsnip_t *pkt;
+    ipv6_hdr_t *hdr;
+    msg_t msg;
+    bool res;
+
+    _recv_frame(frame);
+    if ((msg_try_receive(&msg) < 0) ||
+        (msg.type != GNRC_NETAPI_MSG_TYPE_RCV)) {
+        return false;
+    }
+    pkt = msg.content.ptr;
+    hdr = pkt->data;
+    res = (pkt->type == GNRC_NETTYPE_IPV6) &&
+          (pkt->size == (frame->uncomp_hdr_len + payload_len)) &&
+          ipv6_hdr_is(hdr) && (hdr->nh == frame->nh) &&
+          (byteorder_ntohs(hdr->len) == (pkt->size - sizeof(ipv6_hdr_t))) &&
+          (memcmp(((uint8_t *)pkt->data) + frame->uncomp_hdr_len,
+                  frame->data + frame->comp_hdr_len, payload_len) == 0);
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+BENCHMARK_LOOP(_bench_udp_64, _recv_frame(&_frames[0]))
+BENCHMARK_LOOP(_bench_icmpv6_16, _recv_frame(&_frames[1]))
+BENCHMARK_LOOP(_bench_udp_large, _recv_frame(&_frames[2]))
+
+static const benchmark_case_t _cases[] = {
+    { "UDP, 64-bit IIDs", _bench_udp_64, BENCH_RUNS },
+    { "ICMPv6, 16-bit addresses", _bench_icmpv6_16, BENCH_RUNS },
+    { "UDP, 80 byte payload", _bench_udp_large, BENCH_RUNS },
+};
+
+int main(void)
+{
+    gnrc_netreg_entry_t me = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                        sched_active_pid);
+    gnrc_netreg_entry_t *entry;
+
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    for (unsigned i = UDP_64_HDR_LEN; i < sizeof(_udp_large); i++) {
+        _udp_large[i] = (uint8_t)i;
+    }
+    /* decoded datagrams should not reach the IPv6 thread */
+    while ((entry = gnrc_netreg_lookup(GNRC_NETTYPE_IPV6,
+                                       GNRC_NETREG_DEMUX_CTX_ALL)) != NULL) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, entry);
+    }
+
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &me);
+    for (unsigned i = 0; i < (sizeof(_frames) / sizeof(_frames[0])); i++) {
+        if (!_check_frame(&_frames[i])) {
+            printf("frame %u decoded incorrectly\n", i);
+            puts("\n[FAILED]");
+            return 1;
+        }
+    }
+    gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, &me);
+
+    puts("6LoWPAN IPHC decoding\n");
+    benchmark_run_all(_cases, sizeof(_cases) / sizeof(_cases[0]));
+
+    if (_failed > 0) {
+        puts("\n[FAILED]");
+        return 1;
+    }
+    puts("\n[SUCCESS]");
+    return 0;
+}
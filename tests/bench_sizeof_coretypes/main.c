@@ -94,9 +94,7 @@ int main(void)
     P(flags);
 #endif
     P(rq_entry);
-#if defined(MODULE_CORE_MSG) || defined(MODULE_CORE_THREAD_FLAGS) || defined(MODULE_CORE_MBOX)
     P(wait_data);
-#endif
 #ifdef MODULE_CORE_MSG
     P(msg_waiters);
     P(msg_queue);
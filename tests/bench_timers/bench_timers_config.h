@@ -238,6 +238,29 @@ extern "C" {
 #define SPIN_MAX_TARGET 16
 #endif
 
+/* Maximum number of background timers armed while measuring the cost of
+ * xtimer_set/xtimer_remove, 0 disables the measurement. The measurement is
+ * done with 10, 100 and 1000 armed timers, as far as this limit allows */
+#ifndef TEST_ARMED_MAX
+#if TEST_XTIMER
+#define TEST_ARMED_MAX 1000
+#else
+#define TEST_ARMED_MAX 0
+#endif
+#endif
+/* Range of offsets for the background timers (TUT ticks), these must not
+ * expire while measuring */
+#ifndef TEST_ARMED_OFFSET_MIN
+#define TEST_ARMED_OFFSET_MIN ((TIM_TEST_FREQ) * 10)
+#endif
+#ifndef TEST_ARMED_OFFSET_MAX
+#define TEST_ARMED_OFFSET_MAX ((TIM_TEST_FREQ) * 60)
+#endif
+/* Number of set/remove pairs measured per number of armed timers */
+#ifndef TEST_ARMED_ITERATIONS
+#define TEST_ARMED_ITERATIONS 256
+#endif
+
 /* estimate_cpu_overhead will loop for this many iterations to get a proper estimate */
 #define ESTIMATE_CPU_ITERATIONS 2048
 
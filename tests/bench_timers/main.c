@@ -369,6 +369,56 @@ static void nop(void *arg)
     (void)arg;
 }
 
+#if TEST_ARMED_MAX
+/* Background timers, armed far in the future while measuring set/remove cost */
+static xtimer_t armed_timers[TEST_ARMED_MAX];
+
+static void bench_armed_timers(void)
+{
+    static const unsigned counts[] = { 10, 100, 1000 };
+    xtimer_t probe = { .callback = nop };
+
+    print_str("xtimer set/remove cost with armed timers, in reference timer ticks\n");
+    print_str("   armed    set   remove\n");
+    for (unsigned k = 0; k < (sizeof(counts) / sizeof(counts[0])); ++k) {
+        unsigned num = counts[k];
+        if (num > TEST_ARMED_MAX) {
+            break;
+        }
+        for (unsigned i = 0; i < num; ++i) {
+            armed_timers[i].callback = nop;
+            armed_timers[i].target = armed_timers[i].long_target = 0;
+            _xtimer_set(&armed_timers[i],
+                        random_uint32_range(TEST_ARMED_OFFSET_MIN,
+                                            TEST_ARMED_OFFSET_MAX));
+        }
+        matstat_state_t set_state = MATSTAT_STATE_INIT;
+        matstat_state_t remove_state = MATSTAT_STATE_INIT;
+        for (unsigned i = 0; i < TEST_ARMED_ITERATIONS; ++i) {
+            uint32_t offset = random_uint32_range(TEST_ARMED_OFFSET_MIN,
+                                                  TEST_ARMED_OFFSET_MAX);
+            unsigned int begin = timer_read(TIM_REF_DEV);
+            _xtimer_set(&probe, offset);
+            unsigned int middle = timer_read(TIM_REF_DEV);
+            xtimer_remove(&probe);
+            unsigned int end = timer_read(TIM_REF_DEV);
+            matstat_add(&set_state, middle - begin);
+            matstat_add(&remove_state, end - middle);
+        }
+        for (unsigned i = 0; i < num; ++i) {
+            xtimer_remove(&armed_timers[i]);
+        }
+        print_str("   ");
+        print_u32_dec(num);
+        print_str("    ");
+        print_s32_dec(matstat_mean(&set_state));
+        print_str("    ");
+        print_s32_dec(matstat_mean(&remove_state));
+        print("\n", 1);
+    }
+}
+#endif /* TEST_ARMED_MAX */
+
 static void run_test(test_ctx_t *ctx, uint32_t interval, unsigned int variant)
 {
     interval += TEST_MIN;
@@ -737,6 +787,9 @@ int main(void)
     print_u32_dec(spin_max);
     print("\n", 1);
     estimate_cpu_overhead();
+#if TEST_XTIMER && TEST_ARMED_MAX
+    bench_armed_timers();
+#endif
 #ifdef MODULE_PERIPH_RTT
     rtt_begin = rtt_get_counter();
 #endif
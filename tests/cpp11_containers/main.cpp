@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test memarray allocator and fixed capacity containers
+ *
+ * @}
+ */
+#include <list>
+#include <cstdio>
+#include <cassert>
+#include <stdexcept>
+
+#include "riot/memarray_allocator.hpp"
+#include "riot/static_vector.hpp"
+#include "riot/ring_buffer.hpp"
+
+using namespace riot;
+
+#define NODES   (4U)
+
+static memarray_pool<4 * sizeof(void*), NODES> pool;
+
+int main() {
+  puts("\n************ C++ containers test ***********");
+
+  puts("std::list on a memarray pool ... ");
+  {
+    std::list<int, memarray_allocator<int>> list{memarray_allocator<int>(pool)};
+    for (unsigned i = 0; i < NODES; ++i) {
+      list.push_back(i);
+    }
+    bool thrown = false;
+    try {
+      list.push_back(NODES);
+    } catch (std::bad_alloc&) {
+      thrown = true;
+    }
+    assert(thrown);
+    assert(list.size() == NODES);
+    list.pop_front();
+    list.push_back(NODES);
+    assert(list.front() == 1);
+    assert(list.back() == (int)NODES);
+  }
+  puts("Done\n");
+
+  puts("static_vector ... ");
+  {
+    static_vector<int, 3> vec{1, 2};
+    vec.push_back(3);
+    assert(vec.full());
+    bool thrown = false;
+    try {
+      vec.push_back(4);
+    } catch (std::length_error&) {
+      thrown = true;
+    }
+    assert(thrown);
+    vec.erase(vec.begin());
+    assert((vec.size() == 2) && (vec[0] == 2) && (vec.back() == 3));
+    int sum = 0;
+    for (int value : vec) {
+      sum += value;
+    }
+    assert(sum == 5);
+  }
+  puts("Done\n");
+
+  puts("ring_buffer ... ");
+  {
+    ring_buffer<int, 3> buf;
+    for (int i = 0; i < 5; ++i) {
+      buf.push_back_overwrite(i);
+    }
+    assert(buf.full() && (buf.front() == 2) && (buf.back() == 4));
+    buf.pop_front();
+    buf.push_back(5);
+    assert((buf[0] == 3) && (buf[1] == 4) && (buf[2] == 5));
+    buf.clear();
+    assert(buf.empty());
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("*****************************************\n");
+
+  return 0;
+}
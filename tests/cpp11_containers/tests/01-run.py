@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("************ C++ containers test ***********")
+    child.expect_exact("std::list on a memarray pool ...")
+    child.expect_exact("Done")
+    child.expect_exact("static_vector ...")
+    child.expect_exact("Done")
+    child.expect_exact("ring_buffer ...")
+    child.expect_exact("Done")
+    child.expect_exact("Bye, bye.")
+    child.expect_exact("*****************************************")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test static thread and promise/future
+ *
+ * @}
+ */
+#include <cstdio>
+#include <cassert>
+#include <utility>
+#include <system_error>
+
+#include "riot/chrono.hpp"
+#include "riot/future.hpp"
+#include "riot/thread.hpp"
+#include "riot/static_thread.hpp"
+
+using namespace std;
+using namespace riot;
+
+/* a move-only argument */
+struct token {
+  explicit token(int v) : value{v} {}
+  token(const token&) = delete;
+  token(token&& other) : value{other.value} { other.value = 0; }
+  int value;
+};
+
+static static_thread<> worker;
+static promise<int> result;
+static promise<void> started;
+
+int main() {
+  puts("\n************ C++ static_thread test ***********");
+
+  puts("Start and join ... ");
+  for (int round = 0; round < 2; ++round) {
+    int res = 0;
+    worker.start([&res](token t) { res = t.value; }, token{round + 1});
+    assert(worker.joinable());
+    worker.join();
+    assert(!worker.joinable());
+    assert(res == round + 1);
+  }
+  puts("Done\n");
+
+  puts("Start twice ... ");
+  {
+    bool thrown = false;
+    worker.start([] { this_thread::sleep_for(chrono::milliseconds(10)); });
+    try {
+      worker.start([] {});
+    } catch (system_error&) {
+      thrown = true;
+    }
+    assert(thrown);
+    worker.join();
+  }
+  puts("Done\n");
+
+  puts("Promise and future ... ");
+  {
+    future<int> fut = result.get_future();
+    future<void> fut_started = started.get_future();
+    assert(fut.valid());
+    worker.start([] {
+      started.set_value();
+      this_thread::sleep_for(chrono::milliseconds(10));
+      result.set_value(42);
+    });
+    fut_started.get();
+    assert(fut.get() == 42);
+    assert(!fut.valid());
+    worker.join();
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("*****************************************\n");
+
+  return 0;
+}
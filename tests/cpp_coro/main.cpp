@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test coroutines sharing the main thread
+ *
+ * @}
+ */
+#include <cstdio>
+
+#include "event.h"
+#include "mutex.h"
+#include "thread.h"
+#include "riot/coro.hpp"
+
+using namespace riot;
+
+#define TICK_US     (20U * US_PER_MS)
+#define TICKS       (5U)
+#define TEST_FLAG   (0x2)
+
+static event_queue_t queue;
+static coro::event_awaiter go;
+static mutex_t mtx = MUTEX_INIT;
+static unsigned ticks[2];
+static unsigned done;
+
+static coro::task ticker(unsigned id) {
+  for (unsigned i = 0; i < TICKS; i++) {
+    co_await coro::sleep_for(TICK_US);
+    ticks[id]++;
+  }
+  printf("ticker %u done\n", id);
+  done++;
+}
+
+static coro::task waiter(thread_t *main_thread) {
+  co_await go;
+  puts("event received");
+
+  /* the mutex is held by the controller */
+  co_await coro::lock(mtx);
+  puts("mutex locked");
+  mutex_unlock(&mtx);
+
+  thread_flags_set(main_thread, TEST_FLAG);
+  thread_flags_t flags = co_await coro::flags_any(TEST_FLAG);
+  printf("flags 0x%x\n", (unsigned)flags);
+  done++;
+}
+
+static coro::task controller() {
+  mutex_lock(&mtx);
+  co_await coro::sleep_for(TICK_US);
+  event_post(&queue, go.event());
+  co_await coro::sleep_for(TICK_US);
+  mutex_unlock(&mtx);
+
+  while (done < 3) {
+    co_await coro::yield();
+  }
+  if ((ticks[0] == TICKS) && (ticks[1] == TICKS)) {
+    puts("[SUCCESS]");
+  }
+  else {
+    puts("[FAILED]");
+  }
+}
+
+int main() {
+  puts("cpp_coro test application");
+
+  event_queue_init(&queue);
+  coro::spawn(&queue, ticker(0));
+  coro::spawn(&queue, ticker(1));
+  coro::spawn(&queue, waiter((thread_t *)sched_active_thread));
+  coro::spawn(&queue, controller());
+  event_loop(&queue);
+
+  return 0;
+}
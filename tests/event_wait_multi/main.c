@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       event_wait_multi test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "event/wait_multi.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_FLAG       (0x2)
+#define TEST_MSG_TYPE   (0x1234)
+#define DELAY_US        (10U * US_PER_MS)
+
+static event_queue_t queue;
+static msg_t msg_queue[4];
+static kernel_pid_t main_pid;
+static xtimer_t timer;
+static unsigned handled;
+
+static void _handler(event_t *event)
+{
+    (void)event;
+    handled++;
+}
+
+static event_t event = { .handler = _handler };
+
+static void _post(void *arg)
+{
+    (void)arg;
+    event_post(&queue, &event);
+}
+
+static void _set_flag(void *arg)
+{
+    (void)arg;
+    thread_flags_set((thread_t *)thread_get(main_pid), TEST_FLAG);
+}
+
+static void _send(void *arg)
+{
+    msg_t msg = { .type = TEST_MSG_TYPE };
+
+    (void)arg;
+    msg_send_int(&msg, main_pid);
+}
+
+static int _expect(event_wait_multi_type_t expected, const char *what)
+{
+    event_wait_multi_t res;
+    event_wait_multi_type_t type = event_wait_multi(&queue, TEST_FLAG, &res);
+
+    if (type != expected) {
+        printf("[FAILED] expected %s, got %d\n", what, (int)type);
+        return 1;
+    }
+    switch (type) {
+        case EVENT_WAIT_MULTI_FLAGS:
+            if (res.flags != TEST_FLAG) {
+                puts("[FAILED] wrong flags");
+                return 1;
+            }
+            break;
+        case EVENT_WAIT_MULTI_EVENT:
+            res.event->handler(res.event);
+            break;
+        case EVENT_WAIT_MULTI_MSG:
+            if (res.msg.type != TEST_MSG_TYPE) {
+                puts("[FAILED] wrong message");
+                return 1;
+            }
+            break;
+        default:
+            break;
+    }
+    printf("got %s\n", what);
+    return 0;
+}
+
+int main(void)
+{
+    event_wait_multi_t res;
+
+    puts("event_wait_multi test application");
+
+    event_queue_init(&queue);
+    msg_init_queue(msg_queue, 4);
+    main_pid = thread_getpid();
+
+    /* blocking, one source at a time */
+    timer.callback = _set_flag;
+    xtimer_set(&timer, DELAY_US);
+    if (_expect(EVENT_WAIT_MULTI_FLAGS, "flags")) {
+        return 1;
+    }
+    timer.callback = _post;
+    xtimer_set(&timer, DELAY_US);
+    if (_expect(EVENT_WAIT_MULTI_EVENT, "event")) {
+        return 1;
+    }
+    timer.callback = _send;
+    xtimer_set(&timer, DELAY_US);
+    if (_expect(EVENT_WAIT_MULTI_MSG, "message")) {
+        return 1;
+    }
+
+    /* fast path, all pending: flags first, then events, then messages */
+    _send(NULL);
+    _post(NULL);
+    _set_flag(NULL);
+    if (_expect(EVENT_WAIT_MULTI_FLAGS, "flags") ||
+        _expect(EVENT_WAIT_MULTI_EVENT, "event") ||
+        _expect(EVENT_WAIT_MULTI_MSG, "message")) {
+        return 1;
+    }
+    if (event_wait_multi_try(&queue, TEST_FLAG, &res) != EVENT_WAIT_MULTI_NONE) {
+        puts("[FAILED] nothing should be pending");
+        return 1;
+    }
+    if (handled != 2) {
+        puts("[FAILED] event handler not called");
+        return 1;
+    }
+
+    puts("[SUCCESS]");
+    return 0;
+}
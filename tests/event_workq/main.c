@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       event_workq test application
+ *
+ * Two handlers block at the same time, which only works with two workers.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "event/workq.h"
+#include "irq.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define BLOCK_US    (100U * US_PER_MS)
+
+static unsigned _order[2];
+static unsigned _count;
+
+static void _record(unsigned id)
+{
+    unsigned state = irq_disable();
+    _order[_count++] = id;
+    irq_restore(state);
+}
+
+static void _blocking_handler(event_t *event)
+{
+    (void)event;
+    printf("blocking handler runs in %s (%" PRIkernel_pid ")\n",
+           thread_getname(thread_getpid()), thread_getpid());
+    xtimer_usleep(BLOCK_US);
+    _record(0);
+}
+
+static void _quick_handler(event_t *event)
+{
+    (void)event;
+    printf("quick handler runs in %s (%" PRIkernel_pid ")\n",
+           thread_getname(thread_getpid()), thread_getpid());
+    _record(1);
+}
+
+static event_t _blocking = { .handler = _blocking_handler };
+static event_t _quick = { .handler = _quick_handler };
+
+int main(void)
+{
+    puts("event_workq test application");
+
+    event_post(event_workq(EVENT_WORKQ_PRIO_MEDIUM), &_blocking);
+    event_post(event_workq(EVENT_WORKQ_PRIO_HIGH), &_quick);
+
+    /* let the quick handler pass the blocked worker */
+    xtimer_usleep(BLOCK_US / 2);
+    if (_count != 1 || _order[0] != 1) {
+        puts("[FAILED] quick handler did not run while the other blocked");
+        return 1;
+    }
+
+    xtimer_usleep(BLOCK_US);
+    if (_count != 2 || _order[1] != 0) {
+        puts("[FAILED] blocking handler did not finish");
+        return 1;
+    }
+
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -338,6 +338,64 @@ static void test_sock_udp_recv__socketed_with_port0(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_buf(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, &result));
+    assert(data != NULL);
+    assert(ctx != NULL);
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(_TEST_PORT_REMOTE == result.port);
+    /* release packet */
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, 0, NULL));
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_batch(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    sock_udp_msg_t msgs[3] = {
+        { .data = &_test_buffer[0], .len = 8, .remote = &result },
+        { .data = &_test_buffer[8], .len = 8, .remote = NULL },
+        { .data = &_test_buffer[16], .len = 8, .remote = NULL },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "EF", sizeof("EF"),
+                          _TEST_NETIF));
+    /* only the waiting messages are received */
+    assert(2 == sock_udp_recv_batch(&_sock, msgs, 3, SOCK_NO_TIMEOUT));
+    assert(sizeof("ABCD") == msgs[0].len);
+    assert(sizeof("EF") == msgs[1].len);
+    assert(8 == msgs[2].len);
+    assert(memcmp(&_test_buffer[0], "ABCD", sizeof("ABCD")) == 0);
+    assert(memcmp(&_test_buffer[8], "EF", sizeof("EF")) == 0);
+    assert(AF_INET6 == result.family);
+    assert(_TEST_PORT_REMOTE == result.port);
+    assert(-EAGAIN == sock_udp_recv_batch(&_sock, msgs, 3, 0));
+    assert(_check_net());
+}
+
 static void test_sock_udp_recv__unsocketed(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
@@ -421,6 +479,50 @@ static void test_sock_udp_recv__non_blocking(void)
     assert(_check_net());
 }
 
+static unsigned _recv_events;
+
+static void _recv_cb(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    assert(sock == &_sock);
+    assert(arg == &_recv_events);
+    if (flags & SOCK_ASYNC_MSG_RECV) {
+        _recv_events++;
+    }
+}
+
+static void test_sock_udp_set_cb(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+
+    _recv_events = 0;
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    /* the message received before is reported when setting the callback */
+    sock_udp_set_cb(&_sock, _recv_cb, &_recv_events);
+    assert(1 == _recv_events);
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "EFGH", sizeof("EFGH"),
+                          _TEST_NETIF));
+    assert(2 == _recv_events);
+    assert(sizeof("ABCD") == sock_udp_recv(&_sock, _test_buffer,
+                                           sizeof(_test_buffer), 0, NULL));
+    assert(sizeof("EFGH") == sock_udp_recv(&_sock, _test_buffer,
+                                           sizeof(_test_buffer), 0, NULL));
+    sock_udp_set_cb(&_sock, NULL, NULL);
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(2 == _recv_events);
+    assert(sizeof("ABCD") == sock_udp_recv(&_sock, _test_buffer,
+                                           sizeof(_test_buffer), 0, NULL));
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
@@ -693,6 +795,24 @@ static void test_sock_udp_send__no_sock(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_sendv__no_sock(void)
+{
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .netif = _TEST_NETIF,
+                                          .port = _TEST_PORT_REMOTE };
+    iolist_t payload = { .iol_next = NULL, .iol_base = "CD", .iol_len = sizeof("CD") };
+    iolist_t hdr = { .iol_next = &payload, .iol_base = "AB", .iol_len = 2 };
+
+    assert(sizeof("ABCD") == sock_udp_sendv(NULL, &hdr, &remote));
+    assert(_check_packet(&ipv6_addr_unspecified, &dst_addr, 0,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, true));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 int main(void)
 {
     _net_init();
@@ -720,10 +840,13 @@ int main(void)
     CALL(test_sock_udp_recv__socketed());
     CALL(test_sock_udp_recv__socketed_with_remote());
     CALL(test_sock_udp_recv__socketed_with_port0());
+    CALL(test_sock_udp_recv_buf());
+    CALL(test_sock_udp_recv_batch());
     CALL(test_sock_udp_recv__unsocketed());
     CALL(test_sock_udp_recv__unsocketed_with_remote());
     CALL(test_sock_udp_recv__with_timeout());
     CALL(test_sock_udp_recv__non_blocking());
+    CALL(test_sock_udp_set_cb());
     _prepare_send_checks();
     CALL(test_sock_udp_send__EAFNOSUPPORT());
     CALL(test_sock_udp_send__EINVAL_addr());
@@ -741,6 +864,7 @@ int main(void)
     CALL(test_sock_udp_send__unsocketed());
     CALL(test_sock_udp_send__no_sock_no_netif());
     CALL(test_sock_udp_send__no_sock());
+    CALL(test_sock_udp_sendv__no_sock());
 
     puts("ALL TESTS SUCCESSFUL");
 
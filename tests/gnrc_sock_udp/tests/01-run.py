@@ -33,6 +33,7 @@ def testfunc(child):
     child.expect_exact(u"Calling test_sock_udp_recv__unsocketed_with_remote()")
     child.expect_exact(u"Calling test_sock_udp_recv__with_timeout()")
     child.expect_exact(u"Calling test_sock_udp_recv__non_blocking()")
+    child.expect_exact(u"Calling test_sock_udp_set_cb()")
     child.expect_exact(u"Calling test_sock_udp_send__EAFNOSUPPORT()")
     child.expect_exact(u"Calling test_sock_udp_send__EINVAL_addr()")
     child.expect_exact(u"Calling test_sock_udp_send__EINVAL_netif()")
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the deferred binary log
+ *
+ * The records are decoded with
+ *
+ *     make term | ../../dist/tools/log_binary/log_decode.py bin/<board>/tests_log_binary.elf
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "log.h"
+#include "xtimer.h"
+
+#define RUNS        (10U)
+#define BATCH       (10U)
+
+int main(void)
+{
+    uint32_t time = 0;
+
+    LOG_ERROR("error %d\n", -42);
+    LOG_WARNING("warning 0x%08" PRIx32 " %" PRIu64 "\n", UINT32_C(0xdeadbeef),
+                UINT64_C(1234567890123));
+    LOG_INFO("info %s %c\n", "string", '!');
+    LOG_DEBUG("debug without arguments\n");
+    log_binary_flush();
+
+    /* batches small enough not to fill the buffer */
+    for (unsigned i = 0; i < RUNS; i++) {
+        uint32_t start = xtimer_now_usec();
+
+        for (unsigned j = 0; j < BATCH; j++) {
+            LOG_INFO("message %u of %u\n", j, BATCH);
+        }
+        time += xtimer_now_usec() - start;
+        log_binary_flush();
+    }
+
+    printf("\n%" PRIu32 " us per message\n", time / (RUNS * BATCH));
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+RUNS = 10
+BATCH = 10
+
+
+def testfunc(child):
+    # the header of a record is 6 bytes, followed by the arguments
+    for _ in range(4 + RUNS * BATCH):
+        child.expect(r'@[0-9a-f]{12,}\r?\n')
+    child.expect(r'\d+ us per message')
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
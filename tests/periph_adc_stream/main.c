@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for continuous ADC sampling
+ *
+ * Samples ADC_LINE(0) continuously and processes each block in a thread,
+ * using the CMSIS DSP library.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "arm_math.h"
+#include "periph/adc.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#ifndef LINE
+#define LINE            ADC_LINE(0)
+#endif
+
+#ifndef FREQ
+#define FREQ            (8000U)
+#endif
+
+/* samples of each block, the buffer holds two */
+#ifndef BLOCK_LEN
+#define BLOCK_LEN       (256U)
+#endif
+
+#define FLAG_BLOCK      (0x1)
+
+static uint16_t _buf[2 * BLOCK_LEN];
+
+static thread_t *_consumer;
+static uint16_t *volatile _block;
+static volatile unsigned _overruns;
+
+static void _block_cb(void *arg, uint16_t *block, size_t len)
+{
+    (void)arg;
+    (void)len;
+
+    if (_block) {
+        /* the previous block is still being processed, and DMA overwrites
+         * it right now */
+        _overruns++;
+    }
+    _block = block;
+    thread_flags_set(_consumer, FLAG_BLOCK);
+}
+
+static void _process(uint16_t *block)
+{
+    q15_t *samples = (q15_t *)block;
+    q15_t rms, max, min;
+    q15_t mean;
+    uint32_t index;
+
+    /* 12 bit offset binary to Q15 */
+    for (unsigned i = 0; i < BLOCK_LEN; i++) {
+        samples[i] = (q15_t)((block[i] << 4) ^ 0x8000);
+    }
+    arm_mean_q15(samples, BLOCK_LEN, &mean);
+    arm_offset_q15(samples, -mean, samples, BLOCK_LEN);
+    arm_rms_q15(samples, BLOCK_LEN, &rms);
+    arm_max_q15(samples, BLOCK_LEN, &max, &index);
+    arm_min_q15(samples, BLOCK_LEN, &min, &index);
+
+    /* back to ADC counts */
+    printf("mean %d rms %d min %d max %d overruns %u\n",
+           (mean + 0x8000) >> 4, rms >> 4, min >> 4, max >> 4, _overruns);
+}
+
+int main(void)
+{
+    unsigned blocks = 0;
+
+    puts("\nRIOT continuous ADC sampling test\n");
+    printf("Sampling ADC_LINE(0) at %u Hz in blocks of %u samples, printing "
+           "the statistics of every 16th block\n\n", FREQ, BLOCK_LEN);
+
+    _consumer = (thread_t *)thread_get(thread_getpid());
+    if (adc_init(LINE) < 0) {
+        puts("Initialization of the ADC line failed");
+        return 1;
+    }
+    if (adc_stream_start(LINE, ADC_RES_12BIT, FREQ, _buf, 2 * BLOCK_LEN,
+                         _block_cb, NULL) < 0) {
+        puts("Starting the stream failed");
+        return 1;
+    }
+
+    while (1) {
+        thread_flags_wait_any(FLAG_BLOCK);
+        uint16_t *block = _block;
+
+        if ((blocks++ % 16) == 0) {
+            _process(block);
+        }
+        _block = NULL;
+    }
+
+    return 0;
+}
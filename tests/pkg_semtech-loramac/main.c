@@ -35,7 +35,7 @@ static char print_buf[LORAMAC_APPKEY_LEN * 2 + 1];
 
 static void _loramac_usage(void)
 {
-    puts("Usage: loramac <get|set|join|tx|link_check"
+    puts("Usage: loramac <get|set|join|tx|link_check|airtime"
 #ifdef MODULE_PERIPH_EEPROM
          "|save|erase"
 #endif
@@ -466,6 +466,19 @@ static int _cmd_loramac(int argc, char **argv)
         semtech_loramac_request_link_check(&loramac);
         puts("Link check request scheduled");
     }
+    else if (strcmp(argv[1], "airtime") == 0) {
+        if (argc > 2) {
+            _loramac_usage();
+            return 1;
+        }
+
+        semtech_loramac_airtime_t stats[SEMTECH_LORAMAC_AIRTIME_NUMOF];
+        unsigned num = semtech_loramac_get_airtime(stats, SEMTECH_LORAMAC_AIRTIME_NUMOF);
+        for (unsigned i = 0; i < num; i++) {
+            printf("%" PRIu32 " Hz: %" PRIu32 " frames, %" PRIu32 " ms\n",
+                   stats[i].frequency, stats[i].count, stats[i].airtime);
+        }
+    }
 #ifdef MODULE_PERIPH_EEPROM
     else if (strcmp(argv[1], "save") == 0) {
         if (argc > 2) {
@@ -55,10 +55,19 @@ def _check_ps(child):
         child.expect(line)
 
 
+def _check_ps_latency(child):
+    child.sendline('ps -l')
+    child.expect_exact('\tpid | name                 | wakeups  | preempt  | '
+                       'max lat. | histogram (log2 ticks)')
+    child.expect('\t  1 | idle                 | +\d+ | +\d+ | +\d+ |( \d+)+')
+    child.expect('\t  2 | main                 | +\d+ | +\d+ | +\d+ |( \d+)+')
+
+
 def testfunc(child):
     _check_startup(child)
     _check_help(child)
     _check_ps(child)
+    _check_ps_latency(child)
 
 
 if __name__ == "__main__":
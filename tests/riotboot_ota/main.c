@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup    tests
+ * @{
+ *
+ * @file
+ * @brief      Tests for module riotboot_ota
+ *
+ * The images are written to the last pages of the flash, the running
+ * application is the source of the delta images.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "heatshrink_encoder.h"
+#include "riotboot/ota.h"
+
+#define IMAGE_PAGES     (2U)
+#define IMAGE_FIRST     (FLASHPAGE_NUMOF - IMAGE_PAGES)
+#define IMAGE_LEN       (FLASHPAGE_SIZE + (FLASHPAGE_SIZE / 2))
+#define SRC_OFF         (100U)
+
+static riotboot_ota_t _ota;
+static heatshrink_encoder _encoder;
+static uint8_t _digest[SHA256_DIGEST_LENGTH];
+static uint8_t _buf[64];
+
+static const riotboot_hdr_t _hdr = {
+    .magic_number = RIOTBOOT_MAGIC,
+    .version = 1,
+    .start_addr = 0x00001100,
+};
+
+static const uint8_t *_src(void)
+{
+    return flashpage_addr(0);
+}
+
+/* the delta image: the header, then the running application from SRC_OFF */
+static size_t _delta(uint8_t *buf)
+{
+    uint32_t copy_len = IMAGE_LEN - sizeof(_hdr);
+    uint8_t *pos = buf;
+
+    *pos++ = RIOTBOOT_OTA_OP_INSERT;
+    *pos++ = sizeof(_hdr);
+    memset(pos, 0, 3);
+    pos += 3;
+    memcpy(pos, &_hdr, sizeof(_hdr));
+    pos += sizeof(_hdr);
+    *pos++ = RIOTBOOT_OTA_OP_COPY;
+    for (unsigned i = 0; i < 4; i++) {
+        *pos++ = copy_len >> (8 * i);
+    }
+    for (unsigned i = 0; i < 4; i++) {
+        *pos++ = SRC_OFF >> (8 * i);
+    }
+    return pos - buf;
+}
+
+static void _delta_digest(void)
+{
+    sha256_context_t sha;
+
+    sha256_init(&sha);
+    sha256_update(&sha, &_hdr, sizeof(_hdr));
+    sha256_update(&sha, _src() + SRC_OFF, IMAGE_LEN - sizeof(_hdr));
+    sha256_final(&sha, _digest);
+}
+
+static void _check_delta_image(void)
+{
+    const uint8_t *image = flashpage_addr(IMAGE_FIRST);
+
+    TEST_ASSERT_EQUAL_INT(0, memcmp(image, &_hdr, sizeof(_hdr)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(image + sizeof(_hdr), _src() + SRC_OFF,
+                                    IMAGE_LEN - sizeof(_hdr)));
+    TEST_ASSERT_EQUAL_INT(0xff, image[IMAGE_LEN]);
+}
+
+static void test_riotboot_ota_plain(void)
+{
+    sha256_context_t sha;
+    const uint8_t *image = flashpage_addr(IMAGE_FIRST);
+
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_init(&_ota, IMAGE_FIRST,
+                                               IMAGE_PAGES, 0, NULL, 0));
+    sha256_init(&sha);
+    for (unsigned i = 0; i < IMAGE_LEN; i += sizeof(_buf)) {
+        size_t len = ((IMAGE_LEN - i) < sizeof(_buf)) ? (IMAGE_LEN - i)
+                                                        : sizeof(_buf);
+        memset(_buf, i / sizeof(_buf), len);
+        sha256_update(&sha, _buf, len);
+        TEST_ASSERT_EQUAL_INT(0, riotboot_ota_write(&_ota, _buf, len));
+    }
+    sha256_final(&sha, _digest);
+    /* the header is held back */
+    TEST_ASSERT_EQUAL_INT(0xff, image[0]);
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_finish(&_ota, _digest));
+    TEST_ASSERT_EQUAL_INT(0, image[0]);
+    TEST_ASSERT_EQUAL_INT((IMAGE_LEN - 1) / sizeof(_buf),
+                          image[IMAGE_LEN - 1]);
+}
+
+static void test_riotboot_ota_delta(void)
+{
+    uint8_t delta[64];
+    size_t len = _delta(delta);
+
+    _delta_digest();
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_init(&_ota, IMAGE_FIRST, IMAGE_PAGES,
+                                               RIOTBOOT_OTA_DELTA, _src(),
+                                               2 * FLASHPAGE_SIZE));
+    /* operations split over chunks */
+    for (size_t i = 0; i < len; i += 7) {
+        TEST_ASSERT_EQUAL_INT(0, riotboot_ota_write(&_ota, &delta[i],
+                                                    ((len - i) < 7) ? (len - i)
+                                                                    : 7));
+    }
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_finish(&_ota, _digest));
+    _check_delta_image();
+}
+
+static void test_riotboot_ota_compressed(void)
+{
+    uint8_t delta[64];
+    uint8_t *in = delta;
+    size_t len = _delta(delta);
+
+    _delta_digest();
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_init(&_ota, IMAGE_FIRST, IMAGE_PAGES,
+                                               RIOTBOOT_OTA_COMPRESSED |
+                                               RIOTBOOT_OTA_DELTA, _src(),
+                                               2 * FLASHPAGE_SIZE));
+    heatshrink_encoder_reset(&_encoder);
+    while (1) {
+        size_t n = 0;
+
+        if (len > 0) {
+            heatshrink_encoder_sink(&_encoder, in, len, &n);
+            in += n;
+            len -= n;
+        }
+        else if (heatshrink_encoder_finish(&_encoder) != HSER_FINISH_MORE) {
+            break;
+        }
+        heatshrink_encoder_poll(&_encoder, _buf, sizeof(_buf), &n);
+        TEST_ASSERT_EQUAL_INT(0, riotboot_ota_write(&_ota, _buf, n));
+    }
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_finish(&_ota, _digest));
+    _check_delta_image();
+}
+
+static void test_riotboot_ota_errors(void)
+{
+    uint8_t delta[64];
+    size_t len = _delta(delta);
+    uint8_t bad = 0x42;
+
+    _delta_digest();
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_init(&_ota, IMAGE_FIRST, IMAGE_PAGES,
+                                               RIOTBOOT_OTA_DELTA, _src(),
+                                               2 * FLASHPAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_write(&_ota, delta, len));
+    _digest[0] ^= 1;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, riotboot_ota_finish(&_ota, _digest));
+    TEST_ASSERT_EQUAL_INT(0xff, *(uint8_t *)flashpage_addr(IMAGE_FIRST));
+
+    /* copy beyond the source */
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_init(&_ota, IMAGE_FIRST, IMAGE_PAGES,
+                                               RIOTBOOT_OTA_DELTA, _src(),
+                                               SRC_OFF));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, riotboot_ota_write(&_ota, delta, len));
+
+    /* unknown operation, truncated operation */
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_init(&_ota, IMAGE_FIRST, IMAGE_PAGES,
+                                               RIOTBOOT_OTA_DELTA, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, riotboot_ota_write(&_ota, &bad, 1));
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_init(&_ota, IMAGE_FIRST, IMAGE_PAGES,
+                                               RIOTBOOT_OTA_DELTA, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_write(&_ota, delta, 10));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, riotboot_ota_finish(&_ota, _digest));
+
+    /* image too large */
+    TEST_ASSERT_EQUAL_INT(0, riotboot_ota_init(&_ota, IMAGE_FIRST, 1, 0,
+                                               NULL, 0));
+    for (unsigned i = 0; i < (FLASHPAGE_SIZE / sizeof(_buf)); i++) {
+        TEST_ASSERT_EQUAL_INT(0, riotboot_ota_write(&_ota, _buf,
+                                                    sizeof(_buf)));
+    }
+    TEST_ASSERT_EQUAL_INT(-EFBIG, riotboot_ota_write(&_ota, _buf, 1));
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, riotboot_ota_init(&_ota, IMAGE_FIRST,
+                                                     IMAGE_PAGES + 1, 0,
+                                                     NULL, 0));
+}
+
+Test *tests_riotboot_ota(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_riotboot_ota_plain),
+        new_TestFixture(test_riotboot_ota_delta),
+        new_TestFixture(test_riotboot_ota_compressed),
+        new_TestFixture(test_riotboot_ota_errors),
+    };
+
+    EMB_UNIT_TESTCALLER(riotboot_ota_tests, NULL, NULL, fixtures);
+
+    return (Test *)&riotboot_ota_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_riotboot_ota());
+    TESTS_END();
+    return 0;
+}
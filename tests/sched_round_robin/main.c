@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Round robin scheduling test application
+ *
+ * Two threads with the same priority spin without ever yielding. Without
+ * round robin scheduling the second one would never run.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "thread.h"
+
+#define WORKER_NUMOF    (2U)
+
+static char _stacks[WORKER_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static volatile unsigned _started;
+
+static void *_worker(void *arg)
+{
+    unsigned num = (unsigned)(uintptr_t)arg;
+
+    printf("worker %u running\n", num);
+    if (++_started == WORKER_NUMOF) {
+        puts("SUCCESS");
+    }
+    while (1) {
+        /* spin, never yield */
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    puts("round robin scheduling test");
+
+    for (unsigned i = 0; i < WORKER_NUMOF; i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]), THREAD_PRIORITY_MAIN + 1,
+                      THREAD_CREATE_WOUT_YIELD, _worker, (void *)(uintptr_t)i, "worker");
+    }
+    return 0;
+}
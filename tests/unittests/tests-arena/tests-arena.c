@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "arena.h"
+#include "memarray.h"
+
+#include "tests-arena.h"
+
+#define BUF_SIZE        (64U)
+#define BLOCK_SIZE      (48U)
+#define BLOCK_NUMOF     (2U)
+/* the header of a block takes up ARENA_ALIGN bytes */
+#define PAYLOAD         (BLOCK_SIZE - ARENA_ALIGN)
+
+static uint64_t _buf[BUF_SIZE / sizeof(uint64_t)];
+static uint64_t _blocks_data[BLOCK_NUMOF][BLOCK_SIZE / sizeof(uint64_t)];
+static memarray_t _blocks;
+static arena_t _arena;
+
+static void set_up(void)
+{
+    memset(_buf, 0xff, sizeof(_buf));
+    memarray_init(&_blocks, _blocks_data, BLOCK_SIZE, BLOCK_NUMOF);
+}
+
+static void test_arena_alloc__aligned(void)
+{
+    uint8_t *a, *b;
+
+    arena_init(&_arena, _buf, sizeof(_buf), NULL);
+    a = arena_alloc(&_arena, 1);
+    b = arena_alloc(&_arena, 1);
+    TEST_ASSERT((uint8_t *)_buf == a);
+    TEST_ASSERT_EQUAL_INT(0, (uintptr_t)b % ARENA_ALIGN);
+    TEST_ASSERT(b > a);
+}
+
+static void test_arena_alloc__full(void)
+{
+    arena_init(&_arena, _buf, sizeof(_buf), NULL);
+    TEST_ASSERT_NOT_NULL(arena_alloc(&_arena, BUF_SIZE - 1));
+    TEST_ASSERT_NULL(arena_alloc(&_arena, 1));
+    arena_reset(&_arena);
+    TEST_ASSERT((void *)_buf == arena_alloc(&_arena, BUF_SIZE));
+    TEST_ASSERT_NULL(arena_alloc(&_arena, 1));
+}
+
+static void test_arena_calloc(void)
+{
+    uint8_t *a;
+
+    arena_init(&_arena, _buf, sizeof(_buf), NULL);
+    a = arena_calloc(4, 4, &_arena);
+    TEST_ASSERT_NOT_NULL(a);
+    for (unsigned i = 0; i < 16; i++) {
+        TEST_ASSERT_EQUAL_INT(0, a[i]);
+    }
+    TEST_ASSERT_NULL(arena_calloc(SIZE_MAX / 2, 4, &_arena));
+}
+
+static void test_arena_reset_to(void)
+{
+    arena_mark_t mark;
+    void *a, *b;
+
+    arena_init(&_arena, _buf, sizeof(_buf), NULL);
+    TEST_ASSERT_NOT_NULL(arena_alloc(&_arena, 8));
+    mark = arena_mark(&_arena);
+    a = arena_alloc(&_arena, 16);
+    TEST_ASSERT_NOT_NULL(arena_alloc(&_arena, 16));
+    arena_reset_to(&_arena, mark);
+    b = arena_alloc(&_arena, 16);
+    TEST_ASSERT(a == b);
+}
+
+static void test_arena_blocks(void)
+{
+    arena_mark_t mark;
+    uint8_t *a, *b;
+
+    arena_init(&_arena, _buf, sizeof(_buf), &_blocks);
+    TEST_ASSERT_NOT_NULL(arena_alloc(&_arena, BUF_SIZE));
+    mark = arena_mark(&_arena);
+    /* too big for a block */
+    TEST_ASSERT_NULL(arena_alloc(&_arena, BLOCK_SIZE));
+    a = arena_alloc(&_arena, 16);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT((a >= (uint8_t *)_blocks_data) &&
+                (a < (uint8_t *)&_blocks_data[BLOCK_NUMOF]));
+    /* the rest of the first block does not fit this one */
+    b = arena_alloc(&_arena, 32);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT(b != (a + 16));
+    TEST_ASSERT_NOT_NULL(arena_alloc(&_arena, 8));
+    /* both blocks are used up */
+    TEST_ASSERT_NULL(arena_alloc(&_arena, PAYLOAD));
+    arena_reset_to(&_arena, mark);
+    /* the blocks were given back */
+    TEST_ASSERT(a == arena_alloc(&_arena, 16));
+    TEST_ASSERT_NOT_NULL(arena_alloc(&_arena, 32));
+    TEST_ASSERT_NULL(arena_alloc(&_arena, 1 + PAYLOAD));
+}
+
+static void test_arena_blocks__no_buf(void)
+{
+    uint8_t *a;
+
+    arena_init(&_arena, NULL, 0, &_blocks);
+    a = arena_alloc(&_arena, 1);
+    TEST_ASSERT_NOT_NULL(a);
+    arena_reset(&_arena);
+    TEST_ASSERT(a == arena_alloc(&_arena, 1));
+}
+
+Test *tests_arena_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_arena_alloc__aligned),
+        new_TestFixture(test_arena_alloc__full),
+        new_TestFixture(test_arena_calloc),
+        new_TestFixture(test_arena_reset_to),
+        new_TestFixture(test_arena_blocks),
+        new_TestFixture(test_arena_blocks__no_buf),
+    };
+
+    EMB_UNIT_TESTCALLER(arena_tests, set_up, NULL, fixtures);
+
+    return (Test *)&arena_tests;
+}
+
+void tests_arena(void)
+{
+    TESTS_RUN(tests_arena_tests());
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include "embUnit.h"
+
+#include "bitalloc.h"
+#include "tests-bitalloc.h"
+
+/* more than one word, and more than one summary word on 16-bit platforms */
+#define _NUMOF      (300U)
+
+static unsigned _map[BITALLOC_MAP_WORDS(_NUMOF)];
+static unsigned _summary[BITALLOC_SUMMARY_WORDS(_NUMOF)];
+static bitalloc_t _ba;
+
+static void set_up(void)
+{
+    bitalloc_init(&_ba, _map, _summary, _NUMOF);
+}
+
+static void test_bitalloc_get_all(void)
+{
+    for (unsigned i = 0; i < _NUMOF; i++) {
+        TEST_ASSERT(bitalloc_is_free(&_ba, i));
+        TEST_ASSERT_EQUAL_INT(i, bitalloc_get(&_ba));
+        TEST_ASSERT(!bitalloc_is_free(&_ba, i));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, bitalloc_find(&_ba));
+    TEST_ASSERT_EQUAL_INT(-1, bitalloc_get(&_ba));
+}
+
+static void test_bitalloc_put_lowest(void)
+{
+    for (unsigned i = 0; i < _NUMOF; i++) {
+        bitalloc_get(&_ba);
+    }
+    bitalloc_put(&_ba, _NUMOF - 1);
+    bitalloc_put(&_ba, 40);
+    bitalloc_put(&_ba, 200);
+    TEST_ASSERT_EQUAL_INT(40, bitalloc_find(&_ba));
+    TEST_ASSERT_EQUAL_INT(40, bitalloc_get(&_ba));
+    TEST_ASSERT_EQUAL_INT(200, bitalloc_get(&_ba));
+    TEST_ASSERT_EQUAL_INT(_NUMOF - 1, bitalloc_get(&_ba));
+    TEST_ASSERT_EQUAL_INT(-1, bitalloc_get(&_ba));
+}
+
+static void test_bitalloc_take(void)
+{
+    bitalloc_take(&_ba, 0);
+    bitalloc_take(&_ba, 1);
+    bitalloc_take(&_ba, 1);
+    TEST_ASSERT_EQUAL_INT(2, bitalloc_get(&_ba));
+    bitalloc_put(&_ba, 1);
+    bitalloc_put(&_ba, 1);
+    TEST_ASSERT_EQUAL_INT(1, bitalloc_get(&_ba));
+    TEST_ASSERT_EQUAL_INT(3, bitalloc_get(&_ba));
+}
+
+static void test_bitalloc_reset(void)
+{
+    for (unsigned i = 0; i < _NUMOF; i++) {
+        bitalloc_get(&_ba);
+    }
+    bitalloc_reset(&_ba);
+    TEST_ASSERT_EQUAL_INT(0, bitalloc_get(&_ba));
+}
+
+static void test_bitalloc_word_size(void)
+{
+    unsigned map[1], summary[1];
+
+    bitalloc_init(&_ba, map, summary, BITALLOC_WORD_BITS);
+    for (unsigned i = 0; i < BITALLOC_WORD_BITS; i++) {
+        TEST_ASSERT_EQUAL_INT(i, bitalloc_get(&_ba));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, bitalloc_get(&_ba));
+}
+
+Test *tests_bitalloc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_bitalloc_get_all),
+        new_TestFixture(test_bitalloc_put_lowest),
+        new_TestFixture(test_bitalloc_take),
+        new_TestFixture(test_bitalloc_reset),
+        new_TestFixture(test_bitalloc_word_size),
+    };
+
+    EMB_UNIT_TESTCALLER(bitalloc_tests, set_up, NULL, fixtures);
+
+    return (Test *)&bitalloc_tests;
+}
+
+void tests_bitalloc(void)
+{
+    TESTS_RUN(tests_bitalloc_tests());
+}
+/** @} */
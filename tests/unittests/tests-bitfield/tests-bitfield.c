@@ -116,6 +116,22 @@ static void test_bf_get_unset_lastbyte(void)
     TEST_ASSERT_EQUAL_INT(39, res);
 }
 
+static void test_bf_get_unset_words(void)
+{
+    int res = 0;
+    uint8_t field[13];
+    memset(field, 0xff, sizeof(field));
+
+    field[12] = 0x0f;
+    res = bf_get_unset(field, 100);
+    TEST_ASSERT_EQUAL_INT(-1, res);
+
+    field[9] = 0xfd;
+    res = bf_get_unset(field, 100);
+    TEST_ASSERT_EQUAL_INT(73, res);
+    TEST_ASSERT_EQUAL_INT(0xff, field[9]);
+}
+
 Test *tests_bitfield_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -123,6 +139,7 @@ Test *tests_bitfield_tests(void)
         new_TestFixture(test_bf_get_unset_firstbyte),
         new_TestFixture(test_bf_get_unset_middle),
         new_TestFixture(test_bf_get_unset_lastbyte),
+        new_TestFixture(test_bf_get_unset_words),
     };
 
     EMB_UNIT_TESTCALLER(bitfield_tests, NULL, NULL, fixtures);
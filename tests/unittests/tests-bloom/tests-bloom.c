@@ -22,6 +22,8 @@
 #define TESTS_BLOOM_PROB_IN_FILTER (4)
 #define TESTS_BLOOM_NOT_IN_FILTER (996)
 #define TESTS_BLOOM_FALSE_POS_RATE_THR (0.005)
+#define TESTS_BLOOM_BLOCKS (2)
+#define TESTS_BLOOM_PROBES (6)
 
 static bloom_t bloom;
 BITFIELD(bf, TESTS_BLOOM_BITS);
@@ -85,6 +87,89 @@ static void test_bloom_based_on_dictionary_fixture(void)
     TEST_ASSERT(false_positive_rate < TESTS_BLOOM_FALSE_POS_RATE_THR);
 }
 
+static bloom_blocked_t blocked;
+static uint32_t blocks[BLOOM_BLOCKED_WORDS(TESTS_BLOOM_BLOCKS)];
+
+static void set_up_bloom_blocked(void)
+{
+    bloom_blocked_init(&blocked, blocks, TESTS_BLOOM_BLOCKS,
+                       TESTS_BLOOM_PROBES, NULL);
+}
+
+static void test_bloom_blocked_dictionary(void)
+{
+    int in = 0;
+
+    for (int i = 0; i < lenB; i++) {
+        bloom_blocked_add(&blocked, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (int i = 0; i < lenB; i++) {
+        TEST_ASSERT(bloom_blocked_check(&blocked, (const uint8_t *) B[i],
+                                        strlen(B[i])));
+    }
+    for (int i = 0; i < lenA; i++) {
+        if (bloom_blocked_check(&blocked, (const uint8_t *) A[i],
+                                strlen(A[i]))) {
+            in++;
+        }
+    }
+    TEST_ASSERT((double) in / (double) lenA < TESTS_BLOOM_FALSE_POS_RATE_THR);
+
+    bloom_blocked_clear(&blocked);
+    TEST_ASSERT(!bloom_blocked_check(&blocked, (const uint8_t *) B[0],
+                                     strlen(B[0])));
+}
+
+static void test_bloom_blocked_test_and_add(void)
+{
+    for (int i = 0; i < lenB; i++) {
+        TEST_ASSERT(!bloom_blocked_test_and_add(&blocked,
+                                                (const uint8_t *) B[i],
+                                                strlen(B[i])));
+        TEST_ASSERT(bloom_blocked_test_and_add(&blocked,
+                                               (const uint8_t *) B[i],
+                                               strlen(B[i])));
+    }
+}
+
+static void test_bloom_counting(void)
+{
+    bloom_counting_init(&blocked, blocks, TESTS_BLOOM_BLOCKS,
+                        TESTS_BLOOM_PROBES, NULL);
+    for (int i = 0; i < lenB; i++) {
+        bloom_counting_add(&blocked, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (int i = 0; i < lenB / 2; i++) {
+        bloom_counting_remove(&blocked, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    /* no false negatives for the remaining elements */
+    for (int i = lenB / 2; i < lenB; i++) {
+        TEST_ASSERT(bloom_counting_check(&blocked, (const uint8_t *) B[i],
+                                         strlen(B[i])));
+    }
+    for (int i = lenB / 2; i < lenB; i++) {
+        bloom_counting_remove(&blocked, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    /* all counters are back to zero */
+    for (unsigned i = 0; i < BLOOM_BLOCKED_WORDS(TESTS_BLOOM_BLOCKS); i++) {
+        TEST_ASSERT_EQUAL_INT(0, blocks[i]);
+    }
+}
+
+Test *tests_bloom_blocked_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_bloom_blocked_dictionary),
+        new_TestFixture(test_bloom_blocked_test_and_add),
+        new_TestFixture(test_bloom_counting),
+    };
+
+    EMB_UNIT_TESTCALLER(bloom_blocked_tests, set_up_bloom_blocked, NULL,
+                        fixtures);
+
+    return (Test *)&bloom_blocked_tests;
+}
+
 Test *tests_bloom_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -100,4 +185,5 @@ Test *tests_bloom_tests(void)
 void tests_bloom(void)
 {
     TESTS_RUN(tests_bloom_tests());
+    TESTS_RUN(tests_bloom_blocked_tests());
 }
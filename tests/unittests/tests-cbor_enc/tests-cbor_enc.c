@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "cbor_enc.h"
+#include "tests-cbor_enc.h"
+
+static uint8_t _buf[32];
+static cbor_enc_t _enc;
+
+static void set_up(void)
+{
+    memset(_buf, 0xff, sizeof(_buf));
+    cbor_enc_init(&_enc, _buf, sizeof(_buf));
+}
+
+static void _assert_encoding(const uint8_t *expected, size_t len)
+{
+    TEST_ASSERT_EQUAL_INT(len, cbor_enc_len(&_enc));
+    TEST_ASSERT(memcmp(expected, _buf, len) == 0);
+}
+
+/* the examples of RFC 7049, appendix A */
+static void test_cbor_enc_uint(void)
+{
+    static const uint8_t expected[] = {
+        0x00, 0x17, 0x18, 0x18, 0x18, 0xff, 0x19, 0x01, 0x00,
+        0x19, 0x03, 0xe8, 0x1a, 0x00, 0x0f, 0x42, 0x40,
+        0x1a, 0xff, 0xff, 0xff, 0xff,
+    };
+
+    cbor_enc_uint(&_enc, 0);
+    cbor_enc_uint(&_enc, 23);
+    cbor_enc_uint(&_enc, 24);
+    cbor_enc_uint(&_enc, 255);
+    cbor_enc_uint(&_enc, 256);
+    cbor_enc_uint(&_enc, 1000);
+    cbor_enc_uint(&_enc, 1000000);
+    cbor_enc_uint(&_enc, UINT32_MAX);
+    _assert_encoding(expected, sizeof(expected));
+}
+
+static void test_cbor_enc_int(void)
+{
+    static const uint8_t expected[] = {
+        0x0a, 0x20, 0x29, 0x38, 0x63, 0x39, 0x03, 0xe7,
+        0x3a, 0x7f, 0xff, 0xff, 0xff,
+    };
+
+    cbor_enc_int(&_enc, 10);
+    cbor_enc_int(&_enc, -1);
+    cbor_enc_int(&_enc, -10);
+    cbor_enc_int(&_enc, -100);
+    cbor_enc_int(&_enc, -1000);
+    cbor_enc_int(&_enc, INT32_MIN);
+    _assert_encoding(expected, sizeof(expected));
+}
+
+static void test_cbor_enc_int64(void)
+{
+    static const uint8_t expected[] = {
+        0x1a, 0xff, 0xff, 0xff, 0xff,
+        0x1b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x10, 0x00,
+        0x3b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x0f, 0xff,
+    };
+
+    cbor_enc_int64(&_enc, UINT32_MAX);
+    cbor_enc_int64(&_enc, 1000000000000);
+    cbor_enc_int64(&_enc, -1000000000000);
+    _assert_encoding(expected, sizeof(expected));
+}
+
+static void test_cbor_enc_float(void)
+{
+    static const uint8_t expected[] = {
+        0xfa, 0x47, 0xc3, 0x50, 0x00, 0xfa, 0xbf, 0x80, 0x00, 0x00,
+    };
+
+    cbor_enc_float(&_enc, 100000.0f);
+    cbor_enc_float(&_enc, -1.0f);
+    _assert_encoding(expected, sizeof(expected));
+}
+
+static void test_cbor_enc_str(void)
+{
+    static const uint8_t expected[] = {
+        0x60, 0x61, 0x61, 0x64, 0x49, 0x45, 0x54, 0x46,
+        0x44, 0x01, 0x02, 0x03, 0x04,
+    };
+    static const uint8_t bytes[] = { 0x01, 0x02, 0x03, 0x04 };
+
+    cbor_enc_str(&_enc, "");
+    cbor_enc_str(&_enc, "a");
+    cbor_enc_tstr(&_enc, "IETF, ignored", 4);
+    cbor_enc_bstr(&_enc, bytes, sizeof(bytes));
+    _assert_encoding(expected, sizeof(expected));
+}
+
+static void test_cbor_enc_containers(void)
+{
+    /* {"a": 1, "b": [2, 3]} and [_ 1, [2, 3]] */
+    static const uint8_t expected[] = {
+        0xa2, 0x61, 0x61, 0x01, 0x61, 0x62, 0x82, 0x02, 0x03,
+        0x9f, 0x01, 0x82, 0x02, 0x03, 0xff,
+    };
+
+    cbor_enc_map(&_enc, 2);
+    cbor_enc_str(&_enc, "a");
+    cbor_enc_uint(&_enc, 1);
+    cbor_enc_str(&_enc, "b");
+    cbor_enc_array(&_enc, 2);
+    cbor_enc_uint(&_enc, 2);
+    cbor_enc_uint(&_enc, 3);
+    cbor_enc_array_indef(&_enc);
+    cbor_enc_uint(&_enc, 1);
+    cbor_enc_array(&_enc, 2);
+    cbor_enc_uint(&_enc, 2);
+    cbor_enc_uint(&_enc, 3);
+    cbor_enc_break(&_enc);
+    _assert_encoding(expected, sizeof(expected));
+}
+
+static void test_cbor_enc_simple(void)
+{
+    /* false, true, null, 4([-2, 27315]) */
+    static const uint8_t expected[] = {
+        0xf4, 0xf5, 0xf6, 0xc4, 0x82, 0x21, 0x19, 0x6a, 0xb3,
+    };
+
+    cbor_enc_bool(&_enc, false);
+    cbor_enc_bool(&_enc, true);
+    cbor_enc_null(&_enc);
+    cbor_enc_decfrac(&_enc, 27315, -2);
+    _assert_encoding(expected, sizeof(expected));
+}
+
+static void test_cbor_enc_overflow(void)
+{
+    static const uint8_t bytes[sizeof(_buf)];
+
+    cbor_enc_map_indef(&_enc);
+    cbor_enc_bstr(&_enc, bytes, sizeof(bytes) - 4);
+    TEST_ASSERT_EQUAL_INT(sizeof(_buf) - 1, cbor_enc_len(&_enc));
+    /* does not fit, and neither does anything after it */
+    cbor_enc_uint(&_enc, 1000);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_enc_len(&_enc));
+    cbor_enc_break(&_enc);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_enc_len(&_enc));
+}
+
+static void test_cbor_enc_length_only(void)
+{
+    cbor_enc_init(&_enc, NULL, 0);
+    cbor_enc_map(&_enc, 1);
+    cbor_enc_str(&_enc, "temp");
+    cbor_enc_decfrac(&_enc, 2150, -2);
+    TEST_ASSERT_EQUAL_INT(12, cbor_enc_len(&_enc));
+    TEST_ASSERT_EQUAL_INT(0xff, _buf[0]);
+}
+
+Test *tests_cbor_enc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_cbor_enc_uint),
+        new_TestFixture(test_cbor_enc_int),
+        new_TestFixture(test_cbor_enc_int64),
+        new_TestFixture(test_cbor_enc_float),
+        new_TestFixture(test_cbor_enc_str),
+        new_TestFixture(test_cbor_enc_containers),
+        new_TestFixture(test_cbor_enc_simple),
+        new_TestFixture(test_cbor_enc_overflow),
+        new_TestFixture(test_cbor_enc_length_only),
+    };
+
+    EMB_UNIT_TESTCALLER(cbor_enc_tests, set_up, NULL, fixtures);
+
+    return (Test *)&cbor_enc_tests;
+}
+
+void tests_cbor_enc(void)
+{
+    TESTS_RUN(tests_cbor_enc_tests());
+}
+/** @} */
@@ -16,6 +16,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <string.h>
+
 #include "thread.h"
 #include "ringbuffer.h"
 #include "mutex.h"
@@ -131,11 +133,73 @@ static void tests_core_ringbuffer_remove(void)
 
 }
 
+static void tests_core_ringbuffer_bulk(void)
+{
+    char mem[5];
+    char out[8];
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_add(&buf, "abc", 3));
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_get(&buf, out, 2));
+    /* wraps around, only 4 fit */
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_add(&buf, "defgh", 5));
+    TEST_ASSERT(ringbuffer_full(&buf));
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_get(&buf, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "cdefg", 5));
+    TEST_ASSERT(ringbuffer_empty(&buf));
+}
+
+static void tests_core_ringbuffer_regions(void)
+{
+    char mem[5];
+    ringbuffer_t buf;
+    unsigned n;
+    char *region;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    region = ringbuffer_reserve(&buf, &n);
+    TEST_ASSERT(region == mem);
+    TEST_ASSERT_EQUAL_INT(5, n);
+    memcpy(region, "abcd", 4);
+    ringbuffer_commit(&buf, 4);
+    TEST_ASSERT_EQUAL_INT(4, buf.avail);
+
+    region = ringbuffer_peek_region(&buf, &n);
+    TEST_ASSERT(region == mem);
+    TEST_ASSERT_EQUAL_INT(4, n);
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_remove(&buf, 3));
+
+    /* the free space wraps around */
+    region = ringbuffer_reserve(&buf, &n);
+    TEST_ASSERT(region == &mem[4]);
+    TEST_ASSERT_EQUAL_INT(1, n);
+    *region = 'e';
+    ringbuffer_commit(&buf, 1);
+    region = ringbuffer_reserve(&buf, &n);
+    TEST_ASSERT(region == mem);
+    TEST_ASSERT_EQUAL_INT(3, n);
+    memcpy(region, "fg", 2);
+    ringbuffer_commit(&buf, 2);
+
+    region = ringbuffer_peek_region(&buf, &n);
+    TEST_ASSERT(region == &mem[3]);
+    TEST_ASSERT_EQUAL_INT(2, n);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(region, "de", 2));
+    ringbuffer_remove(&buf, n);
+    region = ringbuffer_peek_region(&buf, &n);
+    TEST_ASSERT(region == mem);
+    TEST_ASSERT_EQUAL_INT(2, n);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(region, "fg", 2));
+}
+
 Test *tests_core_ringbuffer_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(tests_core_ringbuffer),
         new_TestFixture(tests_core_ringbuffer_remove),
+        new_TestFixture(tests_core_ringbuffer_bulk),
+        new_TestFixture(tests_core_ringbuffer_regions),
     };
 
     EMB_UNIT_TESTCALLER(ringbuffer_tests, NULL, NULL, fixtures);
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+#include "tests-crypto.h"
+
+#include "crypto/chacha20poly1305.h"
+
+/* RFC 8439, section 2.8.2 */
+static const uint8_t key[] = {
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f,
+};
+
+static const uint8_t nonce[] = {
+    0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+};
+
+static const uint8_t aad[] = {
+    0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+};
+
+static const char msg[] = "Ladies and Gentlemen of the class of '99: If I could "
+                         "offer you only one tip for the future, sunscreen "
+                         "would be it.";
+
+/* ciphertext followed by the tag */
+static const uint8_t cipher[] = {
+    0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb, 0x7b, 0x86, 0xaf, 0xbc, 0x53, 0xef, 0x7e, 0xc2,
+    0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe, 0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6,
+    0x3d, 0xbe, 0xa4, 0x5e, 0x8c, 0xa9, 0x67, 0x12, 0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+    0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29, 0x05, 0xd6, 0xa5, 0xb6, 0x7e, 0xcd, 0x3b, 0x36,
+    0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c, 0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58,
+    0xfa, 0xb3, 0x24, 0xe4, 0xfa, 0xd6, 0x75, 0x94, 0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+    0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d, 0xe5, 0x76, 0xd2, 0x65, 0x86, 0xce, 0xc6, 0x4b,
+    0x61, 0x16, 0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a, 0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60,
+    0x06, 0x91,
+};
+
+static void test_crypto_chacha20poly1305_encrypt(void)
+{
+    uint8_t buf[sizeof(cipher)];
+
+    chacha20poly1305_encrypt(buf, (const uint8_t *)msg, sizeof(msg) - 1,
+                             aad, sizeof(aad), key, nonce);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(cipher, buf, sizeof(cipher)));
+}
+
+static void test_crypto_chacha20poly1305_decrypt(void)
+{
+    uint8_t buf[sizeof(cipher)];
+    size_t len;
+
+    /* in place */
+    memcpy(buf, cipher, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(1, chacha20poly1305_decrypt(buf, sizeof(buf), buf,
+                                                      &len, aad, sizeof(aad),
+                                                      key, nonce));
+    TEST_ASSERT_EQUAL_INT(sizeof(msg) - 1, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(msg, buf, len));
+}
+
+static void test_crypto_chacha20poly1305_forged(void)
+{
+    uint8_t buf[sizeof(cipher)], out[sizeof(cipher)] = { 0 };
+    size_t len;
+
+    memcpy(buf, cipher, sizeof(buf));
+    buf[42] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(0, chacha20poly1305_decrypt(buf, sizeof(buf), out,
+                                                      &len, aad, sizeof(aad),
+                                                      key, nonce));
+    /* nothing is decrypted */
+    TEST_ASSERT_EQUAL_INT(0, out[0]);
+
+    /* wrong additional data */
+    TEST_ASSERT_EQUAL_INT(0, chacha20poly1305_decrypt(cipher, sizeof(cipher),
+                                                      out, &len, aad,
+                                                      sizeof(aad) - 1,
+                                                      key, nonce));
+    /* shorter than the tag */
+    TEST_ASSERT_EQUAL_INT(0, chacha20poly1305_decrypt(cipher,
+                                                      CHACHA20POLY1305_TAG_BYTES - 1,
+                                                      out, &len, aad,
+                                                      sizeof(aad), key, nonce));
+}
+
+Test *tests_crypto_chacha20poly1305_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crypto_chacha20poly1305_encrypt),
+        new_TestFixture(test_crypto_chacha20poly1305_decrypt),
+        new_TestFixture(test_crypto_chacha20poly1305_forged),
+    };
+    EMB_UNIT_TESTCALLER(crypto_chacha20poly1305_tests, NULL, NULL, fixtures);
+    return (Test *) &crypto_chacha20poly1305_tests;
+}
@@ -8,6 +8,8 @@
 
 #include <limits.h>
 
+#include <string.h>
+
 #include "embUnit.h"
 #include "crypto/ciphers.h"
 #include "tests-crypto.h"
@@ -59,11 +61,61 @@ static void test_crypto_cipher_aes_decrypt(void)
     TEST_ASSERT_MESSAGE(1 == cmp , "wrong plaintext");
 }
 
+static void test_crypto_cipher_aes_blocks(void)
+{
+    cipher_t cipher;
+    int err;
+    uint8_t data[48], ref[48], chain[16], mac[16] = {0};
+
+    err = cipher_init(&cipher, CIPHER_AES_128, TEST_KEY, 16);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+
+    /* CBC by single blocks */
+    memcpy(ref, data, sizeof(ref));
+    for (unsigned n = 0; n < sizeof(ref); n += 16) {
+        for (unsigned i = 0; i < 16; i++) {
+            ref[n + i] ^= (n == 0) ? TEST_INP[i] : ref[n + i - 16];
+        }
+        TEST_ASSERT_EQUAL_INT(1, cipher_encrypt(&cipher, &ref[n], &ref[n]));
+    }
+
+    memcpy(chain, TEST_INP, sizeof(chain));
+    err = cipher_encrypt_blocks(&cipher, data, data, 3, chain);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(ref, data, sizeof(ref)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&ref[32], chain, sizeof(chain)));
+
+    /* in place */
+    memcpy(chain, TEST_INP, sizeof(chain));
+    err = cipher_decrypt_blocks(&cipher, data, data, 3, chain);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&ref[32], chain, sizeof(chain)));
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        TEST_ASSERT_EQUAL_INT(i, data[i]);
+    }
+
+    /* CBC-MAC without output */
+    memcpy(mac, TEST_INP, sizeof(mac));
+    err = cipher_encrypt_blocks(&cipher, data, NULL, 3, mac);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&ref[32], mac, sizeof(mac)));
+
+    /* ECB */
+    err = cipher_encrypt_blocks(&cipher, TEST_INP, data, 1, NULL);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_ENC_AES, data, 16));
+}
+
 Test* tests_crypto_cipher_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_cipher_aes_encrypt),
-        new_TestFixture(test_crypto_cipher_aes_decrypt)
+        new_TestFixture(test_crypto_cipher_aes_decrypt),
+        new_TestFixture(test_crypto_cipher_aes_blocks),
     };
 
     EMB_UNIT_TESTCALLER(crypto_cipher_tests, NULL, NULL, fixtures);
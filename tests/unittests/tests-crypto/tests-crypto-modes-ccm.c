@@ -248,18 +248,97 @@ static void test_crypto_modes_ccm_check_len(void)
     ret = _test_ccm_len(cipher_decrypt_ccm, 8, einput, 16, 0);
     TEST_ASSERT_MESSAGE(ret > 0, "Decryption : failed with valid input_len");
 
+    /* Length using all octets of the length encoding */
+    static uint8_t long_data[256 + 8];
+    cipher_t cipher;
+    uint8_t zero[16] = {0};
+
+    cipher_init(&cipher, CIPHER_AES_128, zero, 16);
+    ret = cipher_encrypt_ccm(&cipher, NULL, 0, 8, 2, zero, 13, long_data, 256,
+                             long_data);
+    TEST_ASSERT_EQUAL_INT(256 + 8, ret);
+    ret = cipher_decrypt_ccm(&cipher, NULL, 0, 8, 2, zero, 13, long_data,
+                             256 + 8, long_data);
+    TEST_ASSERT_EQUAL_INT(256, ret);
+
     /* ccm library does not support auth_data_len > 0xFEFF */
     ret = _test_ccm_len(cipher_encrypt_ccm, 2, NULL, 0, 0xFEFF + 1);
     TEST_ASSERT_EQUAL_INT(-1, ret);
 }
 
 
+/* RFC 3610 packet vector #2, additional data and message split in and at
+ * block boundaries */
+static void test_crypto_modes_ccm_stream(void)
+{
+    cipher_t cipher;
+    ccm_context_t ctx;
+    uint8_t buf[TEST_2_INPUT_LEN];
+    uint8_t mac[TEST_2_MAC_LEN];
+    uint8_t len_encoding = nonce_and_len_encoding_size - TEST_2_NONCE_LEN;
+    iolist_t adata[] = {
+        { &adata[1], (uint8_t *)TEST_2_INPUT, 3 },
+        { NULL, (uint8_t *)TEST_2_INPUT + 3, TEST_2_ADATA_LEN - 3 },
+    };
+    iolist_t msg[] = {
+        { &msg[1], &buf[0], 17 },
+        { &msg[2], &buf[17], 0 },
+        { NULL, &buf[17], TEST_2_INPUT_LEN - 17 },
+    };
+    const size_t msg_len = TEST_2_INPUT_LEN;
+
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_2_KEY,
+                                         TEST_2_KEY_LEN));
+
+    memcpy(buf, TEST_2_INPUT + TEST_2_ADATA_LEN, msg_len);
+    TEST_ASSERT_EQUAL_INT(0, cipher_ccm_init(&ctx, &cipher, adata,
+                                             TEST_2_MAC_LEN, len_encoding,
+                                             TEST_2_NONCE, TEST_2_NONCE_LEN,
+                                             msg_len));
+    TEST_ASSERT_EQUAL_INT(0, cipher_ccm_encrypt_iolist(&ctx, msg));
+    TEST_ASSERT_EQUAL_INT(TEST_2_MAC_LEN,
+                          cipher_ccm_encrypt_finish(&ctx, mac));
+    TEST_ASSERT(compare(TEST_2_EXPECTED + TEST_2_ADATA_LEN, buf, msg_len));
+    TEST_ASSERT(compare(TEST_2_EXPECTED + TEST_2_ADATA_LEN + msg_len, mac,
+                        TEST_2_MAC_LEN));
+
+    TEST_ASSERT_EQUAL_INT(0, cipher_ccm_init(&ctx, &cipher, adata,
+                                             TEST_2_MAC_LEN, len_encoding,
+                                             TEST_2_NONCE, TEST_2_NONCE_LEN,
+                                             msg_len));
+    TEST_ASSERT_EQUAL_INT(0, cipher_ccm_decrypt_iolist(&ctx, msg));
+    TEST_ASSERT_EQUAL_INT(0, cipher_ccm_decrypt_finish(&ctx, mac));
+    TEST_ASSERT(compare(TEST_2_INPUT + TEST_2_ADATA_LEN, buf, msg_len));
+
+    /* a modified MAC is rejected */
+    mac[0] ^= 1;
+    TEST_ASSERT_EQUAL_INT(0, cipher_ccm_init(&ctx, &cipher, adata,
+                                             TEST_2_MAC_LEN, len_encoding,
+                                             TEST_2_NONCE, TEST_2_NONCE_LEN,
+                                             msg_len));
+    TEST_ASSERT_EQUAL_INT(0, cipher_ccm_decrypt_update(&ctx, buf, msg_len,
+                                                       buf));
+    TEST_ASSERT_EQUAL_INT(CCM_ERR_INVALID_CBC_MAC,
+                          cipher_ccm_decrypt_finish(&ctx, mac));
+
+    /* the length of the message is checked */
+    TEST_ASSERT_EQUAL_INT(0, cipher_ccm_init(&ctx, &cipher, NULL,
+                                             TEST_2_MAC_LEN, len_encoding,
+                                             TEST_2_NONCE, TEST_2_NONCE_LEN,
+                                             1));
+    TEST_ASSERT_EQUAL_INT(CCM_ERR_INVALID_DATA_LENGTH,
+                          cipher_ccm_encrypt_update(&ctx, buf, 2, buf));
+    TEST_ASSERT_EQUAL_INT(CCM_ERR_INVALID_DATA_LENGTH,
+                          cipher_ccm_encrypt_finish(&ctx, mac));
+}
+
 Test* tests_crypto_modes_ccm_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_modes_ccm_encrypt),
         new_TestFixture(test_crypto_modes_ccm_decrypt),
         new_TestFixture(test_crypto_modes_ccm_check_len),
+        new_TestFixture(test_crypto_modes_ccm_stream),
     };
 
     EMB_UNIT_TESTCALLER(crypto_modes_ccm_tests, NULL, NULL, fixtures);
@@ -275,6 +275,20 @@ static void test_crypto_poly1305_11(void)
     _test_poly1305(key_11, msg_11, sizeof(msg_11), tag_11);
 }
 
+static void test_crypto_poly1305_split(void)
+{
+    poly1305_ctx_t ctx;
+    uint8_t gen_tag[16];
+
+    /* partial chunks around whole blocks */
+    poly1305_init(&ctx, key_2);
+    poly1305_update(&ctx, msg_2, 7);
+    poly1305_update(&ctx, &msg_2[7], 50);
+    poly1305_update(&ctx, &msg_2[57], sizeof(msg_2) - 57);
+    poly1305_finish(&ctx, gen_tag);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(gen_tag, tag_2, sizeof(gen_tag)));
+}
+
 Test *tests_crypto_poly1305_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -289,6 +303,7 @@ Test *tests_crypto_poly1305_tests(void)
         new_TestFixture(test_crypto_poly1305_9),
         new_TestFixture(test_crypto_poly1305_10),
         new_TestFixture(test_crypto_poly1305_11),
+        new_TestFixture(test_crypto_poly1305_split),
     };
     EMB_UNIT_TESTCALLER(crypto_poly1305_tests, NULL, NULL, fixtures);
     return (Test *) &crypto_poly1305_tests;
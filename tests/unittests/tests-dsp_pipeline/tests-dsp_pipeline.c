@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "dsp_pipeline.h"
+#include "tests-dsp_pipeline.h"
+
+#define BLOCK_LEN       (8U)
+
+static dsp_q15_t _block[BLOCK_LEN];
+static dsp_q15_t _out[BLOCK_LEN];
+static dsp_q15_t _state[DSP_FIR_STATE_LEN(4, BLOCK_LEN)];
+
+static void set_up(void)
+{
+    memset(_block, 0, sizeof(_block));
+    memset(_out, 0x55, sizeof(_out));
+}
+
+static void test_dsp_convert(void)
+{
+    dsp_convert_t conv;
+    size_t len = 3;
+
+    dsp_convert_init(&conv, 12);
+    _block[0] = 0;
+    _block[1] = 2048;
+    _block[2] = 4095;
+    TEST_ASSERT(conv.stage.process(&conv.stage, _block, _out, &len) == _block);
+    TEST_ASSERT_EQUAL_INT(3, len);
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, _block[0]);
+    TEST_ASSERT_EQUAL_INT(0, _block[1]);
+    TEST_ASSERT_EQUAL_INT(32752, _block[2]);
+}
+
+static void test_dsp_fir(void)
+{
+    /* time reversed */
+    static const dsp_q15_t coeffs[] = { 1000, 2000, 3000, 4000 };
+    dsp_fir_t fir;
+    size_t len = BLOCK_LEN;
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, dsp_fir_init(&fir, coeffs, 3, _state,
+                                                BLOCK_LEN));
+    TEST_ASSERT_EQUAL_INT(0, dsp_fir_init(&fir, coeffs, 4, _state,
+                                          BLOCK_LEN));
+
+    /* impulse of 0.5 at the end of a block, continued in the next one */
+    _block[BLOCK_LEN - 1] = 16384;
+    TEST_ASSERT(fir.stage.process(&fir.stage, _block, _out, &len) == _out);
+    TEST_ASSERT_EQUAL_INT(BLOCK_LEN, len);
+    TEST_ASSERT_EQUAL_INT(0, _out[BLOCK_LEN - 2]);
+    TEST_ASSERT_EQUAL_INT(2000, _out[BLOCK_LEN - 1]);
+
+    memset(_block, 0, sizeof(_block));
+    fir.stage.process(&fir.stage, _block, _out, &len);
+    TEST_ASSERT_EQUAL_INT(1500, _out[0]);
+    TEST_ASSERT_EQUAL_INT(1000, _out[1]);
+    TEST_ASSERT_EQUAL_INT(500, _out[2]);
+    TEST_ASSERT_EQUAL_INT(0, _out[3]);
+}
+
+static void test_dsp_decimate(void)
+{
+    /* mean of the last two samples */
+    static const dsp_q15_t coeffs[] = { 0, 0, 16384, 16384 };
+    dsp_decimate_t dec;
+    size_t len = BLOCK_LEN;
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, dsp_decimate_init(&dec, coeffs, 4, 3,
+                                                     _state, BLOCK_LEN));
+    TEST_ASSERT_EQUAL_INT(0, dsp_decimate_init(&dec, coeffs, 4, 2, _state,
+                                               BLOCK_LEN));
+    for (unsigned i = 0; i < BLOCK_LEN; i++) {
+        _block[i] = 100 * i;
+    }
+    TEST_ASSERT(dec.stage.process(&dec.stage, _block, _out, &len) == _out);
+    TEST_ASSERT_EQUAL_INT(BLOCK_LEN / 2, len);
+    TEST_ASSERT_EQUAL_INT(50, _out[0]);
+    TEST_ASSERT_EQUAL_INT(250, _out[1]);
+    TEST_ASSERT_EQUAL_INT(450, _out[2]);
+    TEST_ASSERT_EQUAL_INT(650, _out[3]);
+}
+
+static void test_dsp_biquad(void)
+{
+    /* y[n] = 0.5 * x[n] + 0.5 * y[n-1], then a gain of almost 2, with all
+     * coefficients scaled down by 2 */
+    static const dsp_q15_t coeffs[] = {
+        8192, 0, 0, 0, 8192, 0,
+        32767, 0, 0, 0, 0, 0,
+    };
+    dsp_q15_t state[DSP_BIQUAD_STATE_LEN(2)];
+    dsp_biquad_t bq;
+    size_t len = 4;
+
+    dsp_biquad_init(&bq, coeffs, 2, 1, state);
+    for (unsigned i = 0; i < len; i++) {
+        _block[i] = 1000;
+    }
+    TEST_ASSERT(bq.stage.process(&bq.stage, _block, _out, &len) == _out);
+    TEST_ASSERT_EQUAL_INT(4, len);
+    /* 500, 750, 875 and 937, times 32767 / 16384 */
+    TEST_ASSERT_EQUAL_INT(999, _out[0]);
+    TEST_ASSERT_EQUAL_INT(1499, _out[1]);
+    TEST_ASSERT_EQUAL_INT(1749, _out[2]);
+    TEST_ASSERT_EQUAL_INT(1873, _out[3]);
+}
+
+static void test_dsp_features(void)
+{
+    dsp_features_t feat;
+    size_t len = BLOCK_LEN;
+
+    dsp_features_init(&feat);
+    for (unsigned i = 0; i < BLOCK_LEN; i++) {
+        _block[i] = (i & 1) ? 1000 : -1000;
+    }
+    _block[3] = 1200;
+    TEST_ASSERT(feat.stage.process(&feat.stage, _block, _out, &len) == _block);
+    TEST_ASSERT_EQUAL_INT(BLOCK_LEN, len);
+    TEST_ASSERT_EQUAL_INT(1200, feat.peak);
+    /* sqrt((7 * 1000^2 + 1200^2) / 8) */
+    TEST_ASSERT_EQUAL_INT(1027, feat.rms);
+
+    _block[0] = INT16_MIN;
+    feat.stage.process(&feat.stage, _block, _out, &len);
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, feat.peak);
+}
+
+static void test_dsp_pipeline_run(void)
+{
+    static const dsp_q15_t coeffs[] = { 0, 0, 0, 32767 };
+    dsp_pipeline_t pipe;
+    dsp_convert_t conv;
+    dsp_decimate_t dec;
+    dsp_features_t feat;
+    size_t len = BLOCK_LEN;
+
+    dsp_pipeline_init(&pipe, _out, BLOCK_LEN);
+    TEST_ASSERT(dsp_pipeline_run(&pipe, _block, &len) == _block);
+
+    dsp_convert_init(&conv, 8);
+    dsp_decimate_init(&dec, coeffs, 4, 4, _state, BLOCK_LEN);
+    dsp_features_init(&feat);
+    dsp_pipeline_add(&pipe, &conv.stage);
+    dsp_pipeline_add(&pipe, &dec.stage);
+    dsp_pipeline_add(&pipe, &feat.stage);
+
+    for (unsigned i = 0; i < BLOCK_LEN; i++) {
+        _block[i] = 128 + 16 * i;
+    }
+    TEST_ASSERT(dsp_pipeline_run(&pipe, _block, &len) == _out);
+    TEST_ASSERT_EQUAL_INT(2, len);
+    /* every 4th sample, times 32767 / 32768 */
+    TEST_ASSERT_EQUAL_INT(12287, _out[0]);
+    TEST_ASSERT_EQUAL_INT(28671, _out[1]);
+    TEST_ASSERT_EQUAL_INT(28671, feat.peak);
+}
+
+Test *tests_dsp_pipeline_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_dsp_convert),
+        new_TestFixture(test_dsp_fir),
+        new_TestFixture(test_dsp_decimate),
+        new_TestFixture(test_dsp_biquad),
+        new_TestFixture(test_dsp_features),
+        new_TestFixture(test_dsp_pipeline_run),
+    };
+
+    EMB_UNIT_TESTCALLER(dsp_pipeline_tests, set_up, NULL, fixtures);
+
+    return (Test *)&dsp_pipeline_tests;
+}
+
+void tests_dsp_pipeline(void)
+{
+    TESTS_RUN(tests_dsp_pipeline_tests());
+}
+/** @} */
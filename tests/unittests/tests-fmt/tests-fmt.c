@@ -12,6 +12,7 @@
  * @file
  */
 #include <errno.h>
+#include <math.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -237,6 +238,27 @@ static void test_fmt_u32_dec(void)
     TEST_ASSERT_EQUAL_STRING("zzzz", &out[11]);
 }
 
+static void test_fmt_u32_dec_b(void)
+{
+    static const uint32_t vals[] = {
+        0, 9, 10, 99, 100, 101, 909, 1000, 99999, 100000, 999999999,
+        1000000000, UINT32_MAX
+    };
+    static const char *const strs[] = {
+        "0", "9", "10", "99", "100", "101", "909", "1000", "99999", "100000",
+        "999999999", "1000000000", "4294967295"
+    };
+    char out[16];
+
+    for (unsigned i = 0; i < sizeof(vals) / sizeof(vals[0]); i++) {
+        size_t chars = fmt_u32_dec(out, vals[i]);
+        TEST_ASSERT_EQUAL_INT(strlen(strs[i]), chars);
+        TEST_ASSERT_EQUAL_INT(chars, fmt_u32_dec(NULL, vals[i]));
+        out[chars] = '\0';
+        TEST_ASSERT_EQUAL_STRING(strs[i], (char *) out);
+    }
+}
+
 static void test_fmt_u16_dec(void)
 {
     char out[8] = "zzzzzzz";
@@ -718,6 +740,66 @@ static void test_fmt_s32_dfp(void)
     TEST_ASSERT_EQUAL_STRING("z", &out[28]);
 }
 
+static void test_fmt_u64_dec_d(void)
+{
+    char out[24];
+    uint8_t chars = 0;
+
+    chars = fmt_u64_dec(out, UINT32_MAX);
+    out[chars] = '\0';
+    TEST_ASSERT_EQUAL_STRING("4294967295", (char *) out);
+
+    chars = fmt_u64_dec(out, (uint64_t)UINT32_MAX + 1);
+    out[chars] = '\0';
+    TEST_ASSERT_EQUAL_STRING("4294967296", (char *) out);
+
+    /* chunks of four digits with leading zeros */
+    chars = fmt_u64_dec(out, 10000000010000000001LLU);
+    out[chars] = '\0';
+    TEST_ASSERT_EQUAL_STRING("10000000010000000001", (char *) out);
+
+    chars = fmt_u64_dec(out, UINT64_MAX);
+    TEST_ASSERT_EQUAL_INT(20, chars);
+    TEST_ASSERT_EQUAL_INT(20, fmt_u64_dec(NULL, UINT64_MAX));
+    out[chars] = '\0';
+    TEST_ASSERT_EQUAL_STRING("18446744073709551615", (char *) out);
+}
+
+static void test_fmt_float_shortest(void)
+{
+    static const float vals[] = {
+        0.0f, -0.0f, 1.0f, 0.1f, 0.3f, -2.5f, 100.0f, 123456.7f, 16777216.0f,
+        123456789.0f, 1e9f, 0.0001f, 0.00001f, 1.5e-7f, 3.4028235e38f,
+        1.17549435e-38f, 1.4e-45f
+    };
+    static const char *const strs[] = {
+        "0", "-0", "1", "0.1", "0.3", "-2.5", "100", "123456.7", "16777216",
+        "123456790", "1e9", "0.0001", "1e-5", "1.5e-7", "3.4028235e38",
+        "1.1754944e-38", "1e-45"
+    };
+    char out[16];
+
+    for (unsigned i = 0; i < sizeof(vals) / sizeof(vals[0]); i++) {
+        size_t chars = fmt_float_shortest(out, vals[i]);
+        TEST_ASSERT_EQUAL_INT(strlen(strs[i]), chars);
+        TEST_ASSERT_EQUAL_INT(chars, fmt_float_shortest(NULL, vals[i]));
+        out[chars] = '\0';
+        TEST_ASSERT_EQUAL_STRING(strs[i], (char *) out);
+    }
+
+    size_t chars = fmt_float_shortest(out, INFINITY);
+    out[chars] = '\0';
+    TEST_ASSERT_EQUAL_STRING("inf", (char *) out);
+
+    chars = fmt_float_shortest(out, -INFINITY);
+    out[chars] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-inf", (char *) out);
+
+    chars = fmt_float_shortest(out, NAN);
+    out[chars] = '\0';
+    TEST_ASSERT_EQUAL_STRING("nan", (char *) out);
+}
+
 static void test_fmt_strlen(void)
 {
     const char *empty_str = "";
@@ -833,9 +915,11 @@ Test *tests_fmt_tests(void)
         new_TestFixture(test_fmt_u32_hex),
         new_TestFixture(test_fmt_u64_hex),
         new_TestFixture(test_fmt_u32_dec),
+        new_TestFixture(test_fmt_u32_dec_b),
         new_TestFixture(test_fmt_u64_dec_a),
         new_TestFixture(test_fmt_u64_dec_b),
         new_TestFixture(test_fmt_u64_dec_c),
+        new_TestFixture(test_fmt_u64_dec_d),
         new_TestFixture(test_fmt_u16_dec),
         new_TestFixture(test_fmt_s32_dec_a),
         new_TestFixture(test_fmt_s32_dec_b),
@@ -845,6 +929,7 @@ Test *tests_fmt_tests(void)
         new_TestFixture(test_fmt_s16_dec),
         new_TestFixture(test_fmt_s16_dfp),
         new_TestFixture(test_fmt_s32_dfp),
+        new_TestFixture(test_fmt_float_shortest),
         new_TestFixture(test_fmt_strlen),
         new_TestFixture(test_fmt_strnlen),
         new_TestFixture(test_fmt_str),
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+#include <errno.h>
+
+#include "embUnit.h"
+
+#include "fs/checkpoint.h"
+
+#include "tests-fs_checkpoint.h"
+
+#define SECTOR_COUNT    (2)
+#define PAGE_PER_SECTOR (2)
+#define PAGE_SIZE       (32)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+#define SECTOR          (1)
+
+/* RAM based mtd, keeping its contents over mtd_init() like flash does */
+static uint8_t _memory[SECTOR_SIZE * SECTOR_COUNT];
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+    if (addr + size > sizeof(_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, _memory + addr, size);
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    const uint8_t *src = buff;
+
+    (void)dev;
+    if ((addr + size > sizeof(_memory)) ||
+        (((addr % PAGE_SIZE) + size) > PAGE_SIZE) ||
+        (addr % FS_CHECKPOINT_ALIGN) || (size % FS_CHECKPOINT_ALIGN)) {
+        return -EOVERFLOW;
+    }
+    /* programming clears bits only */
+    for (uint32_t i = 0; i < size; i++) {
+        _memory[addr + i] &= src[i];
+    }
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+    if ((addr % SECTOR_SIZE) || (size % SECTOR_SIZE) ||
+        (addr + size > sizeof(_memory))) {
+        return -EOVERFLOW;
+    }
+    memset(_memory + addr, 0xff, size);
+    return 0;
+}
+
+static const mtd_desc_t _driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+};
+
+static mtd_dev_t _dev = {
+    .driver = &_driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+/* crosses a page boundary, not a multiple of the alignment */
+static const char _state[] = "state of the file system..";
+
+static void set_up(void)
+{
+    memset(_memory, 0, sizeof(_memory));
+}
+
+static void test_fs_checkpoint_save_take(void)
+{
+    char buf[sizeof(_state)];
+
+    TEST_ASSERT_EQUAL_INT(0, fs_checkpoint_save(&_dev, SECTOR, _state,
+                                                sizeof(_state)));
+    /* the other sector is untouched */
+    TEST_ASSERT_EQUAL_INT(0, _memory[SECTOR_SIZE - 1]);
+
+    TEST_ASSERT_EQUAL_INT(0, fs_checkpoint_take(&_dev, SECTOR, buf,
+                                                sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING(_state, buf);
+
+    /* taken once only */
+    TEST_ASSERT_EQUAL_INT(-ENOENT, fs_checkpoint_take(&_dev, SECTOR, buf,
+                                                      sizeof(buf)));
+}
+
+static void test_fs_checkpoint_invalid(void)
+{
+    char buf[sizeof(_state)];
+
+    /* never saved */
+    TEST_ASSERT_EQUAL_INT(0, fs_checkpoint_discard(&_dev, SECTOR));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, fs_checkpoint_take(&_dev, SECTOR, buf,
+                                                      sizeof(buf)));
+
+    /* other length */
+    TEST_ASSERT_EQUAL_INT(0, fs_checkpoint_save(&_dev, SECTOR, _state,
+                                                sizeof(_state)));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, fs_checkpoint_take(&_dev, SECTOR, buf,
+                                                      sizeof(buf) - 1));
+
+    /* corrupted */
+    _memory[SECTOR * SECTOR_SIZE + sizeof(fs_checkpoint_hdr_t) + 2] ^= 0x10;
+    TEST_ASSERT_EQUAL_INT(-ENOENT, fs_checkpoint_take(&_dev, SECTOR, buf,
+                                                      sizeof(buf)));
+
+    /* discarded */
+    TEST_ASSERT_EQUAL_INT(0, fs_checkpoint_save(&_dev, SECTOR, _state,
+                                                sizeof(_state)));
+    TEST_ASSERT_EQUAL_INT(0, fs_checkpoint_discard(&_dev, SECTOR));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, fs_checkpoint_take(&_dev, SECTOR, buf,
+                                                      sizeof(buf)));
+
+    /* too large */
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, fs_checkpoint_save(&_dev, SECTOR, _memory,
+                                                      SECTOR_SIZE));
+}
+
+Test *tests_fs_checkpoint_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_fs_checkpoint_save_take),
+        new_TestFixture(test_fs_checkpoint_invalid),
+    };
+
+    EMB_UNIT_TESTCALLER(fs_checkpoint_tests, set_up, NULL, fixtures);
+
+    return (Test *)&fs_checkpoint_tests;
+}
+
+void tests_fs_checkpoint(void)
+{
+    TESTS_RUN(tests_fs_checkpoint_tests());
+}
+/** @} */
@@ -18,6 +18,7 @@
 #include "embUnit.h"
 
 #include "net/gcoap.h"
+#include "net/gcoap/oscore.h"
 
 #include "unittests-constants.h"
 #include "tests-gcoap.h"
@@ -339,6 +340,125 @@ static void test_gcoap__server_get_resource_list(void)
     TEST_ASSERT_EQUAL_STRING(resource_list_str, (char *)res);
 }
 
+/*
+ * OSCORE security contexts of RFC 8613, appendix C.1.1, for the client and
+ * the server
+ */
+static void _oscore_init(gcoap_oscore_ctx_t *client, gcoap_oscore_ctx_t *server)
+{
+    static const uint8_t secret[] = {
+        0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+        0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10
+    };
+    static const uint8_t salt[] = {
+        0x9e, 0x7c, 0xa9, 0x22, 0x23, 0x78, 0x63, 0x40
+    };
+    static const uint8_t server_id[] = { 0x01 };
+
+    TEST_ASSERT_EQUAL_INT(0, gcoap_oscore_ctx_init(client, secret, sizeof(secret),
+                                                   salt, sizeof(salt), NULL, 0,
+                                                   server_id, sizeof(server_id)));
+    TEST_ASSERT_EQUAL_INT(0, gcoap_oscore_ctx_init(server, secret, sizeof(secret),
+                                                   salt, sizeof(salt),
+                                                   server_id, sizeof(server_id),
+                                                   NULL, 0));
+}
+
+/*
+ * Derivation of the common IV, RFC 8613, appendix C.1.1
+ */
+static void test_gcoap__oscore_ctx(void)
+{
+    gcoap_oscore_ctx_t client, server;
+    static const uint8_t common_iv[] = {
+        0x46, 0x22, 0xd4, 0xdd, 0x6d, 0x94, 0x41, 0x68,
+        0xee, 0xfb, 0x54, 0x98, 0x7c
+    };
+    uint8_t id[GCOAP_OSCORE_ID_MAX + 1] = { 0 };
+
+    _oscore_init(&client, &server);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(common_iv, client.common_iv, sizeof(common_iv)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(common_iv, server.common_iv, sizeof(common_iv)));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gcoap_oscore_ctx_init(&client, id, 1, NULL, 0,
+                                                         id, sizeof(id), NULL, 0));
+}
+
+/*
+ * Protected request and response of RFC 8613, appendices C.4 and C.7: the
+ * client protects the request, the server removes its protection, rejects
+ * it when replayed and protects its response in place.
+ */
+static void test_gcoap__oscore_req_resp(void)
+{
+    static gcoap_oscore_ctx_t client, server;
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    gcoap_oscore_req_t client_req = { .ctx = &client };
+    gcoap_oscore_req_t server_req = { .ctx = NULL };
+
+    /* CON GET coap://localhost/tv1 */
+    static const uint8_t req[] = {
+        0x44, 0x01, 0x5d, 0x1f, 0x00, 0x00, 0x39, 0x74,
+        0x39, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x68, 0x6f,
+        0x73, 0x74, 0x83, 0x74, 0x76, 0x31
+    };
+    static const uint8_t req_prot[] = {
+        0x44, 0x02, 0x5d, 0x1f, 0x00, 0x00, 0x39, 0x74,
+        0x39, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x68, 0x6f,
+        0x73, 0x74, 0x62, 0x09, 0x14, 0xff, 0x61, 0x2f,
+        0x10, 0x92, 0xf1, 0x77, 0x6f, 0x1c, 0x16, 0x68,
+        0xb3, 0x82, 0x5e
+    };
+    /* ACK 2.05 "Hello World!" */
+    static const uint8_t resp[] = {
+        0x64, 0x45, 0x5d, 0x1f, 0x00, 0x00, 0x39, 0x74,
+        0xff, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x20, 0x57,
+        0x6f, 0x72, 0x6c, 0x64, 0x21
+    };
+    static const uint8_t resp_prot[] = {
+        0x64, 0x44, 0x5d, 0x1f, 0x00, 0x00, 0x39, 0x74,
+        0x90, 0xff, 0xdb, 0xaa, 0xd1, 0xe9, 0xa7, 0xe7,
+        0xb2, 0xa8, 0x13, 0xd3, 0xc3, 0x15, 0x24, 0x37,
+        0x83, 0x03, 0xcd, 0xaf, 0xae, 0x11, 0x91, 0x06
+    };
+
+    _oscore_init(&client, &server);
+    gcoap_oscore_ctx_register(&server);
+    client.sender_seq = 20;
+
+    memcpy(buf, req, sizeof(req));
+    ssize_t len = gcoap_oscore_protect(buf, sizeof(req), sizeof(buf),
+                                       &client_req, true);
+    TEST_ASSERT_EQUAL_INT(sizeof(req_prot), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(req_prot, buf, sizeof(req_prot)));
+
+    TEST_ASSERT(coap_parse(&pdu, buf, len) >= 0);
+    len = gcoap_oscore_unprotect(&pdu, &server_req);
+    TEST_ASSERT_EQUAL_INT(sizeof(req), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(req, buf, sizeof(req)));
+    TEST_ASSERT(server_req.ctx == &server);
+
+    memcpy(buf, req_prot, sizeof(req_prot));
+    TEST_ASSERT(coap_parse(&pdu, buf, sizeof(req_prot)) >= 0);
+    TEST_ASSERT_EQUAL_INT(-EALREADY, gcoap_oscore_unprotect(&pdu, &server_req));
+
+    memcpy(buf, resp, sizeof(resp));
+    len = gcoap_oscore_protect(buf, sizeof(resp), sizeof(buf), &server_req, false);
+    TEST_ASSERT_EQUAL_INT(sizeof(resp_prot), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(resp_prot, buf, sizeof(resp_prot)));
+
+    TEST_ASSERT(coap_parse(&pdu, buf, len) >= 0);
+    len = gcoap_oscore_unprotect(&pdu, &client_req);
+    TEST_ASSERT_EQUAL_INT(sizeof(resp), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(resp, buf, sizeof(resp)));
+
+    /* a forged tag does not verify */
+    memcpy(buf, resp_prot, sizeof(resp_prot));
+    buf[sizeof(resp_prot) - 1] ^= 0x01;
+    TEST_ASSERT(coap_parse(&pdu, buf, sizeof(resp_prot)) >= 0);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, gcoap_oscore_unprotect(&pdu, &client_req));
+}
+
 Test *tests_gcoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -350,7 +470,9 @@ Test *tests_gcoap_tests(void)
         new_TestFixture(test_gcoap__server_get_resp),
         new_TestFixture(test_gcoap__server_con_req),
         new_TestFixture(test_gcoap__server_con_resp),
-        new_TestFixture(test_gcoap__server_get_resource_list)
+        new_TestFixture(test_gcoap__server_get_resource_list),
+        new_TestFixture(test_gcoap__oscore_ctx),
+        new_TestFixture(test_gcoap__oscore_req_resp),
     };
 
     EMB_UNIT_TESTCALLER(gcoap_tests, NULL, NULL, fixtures);
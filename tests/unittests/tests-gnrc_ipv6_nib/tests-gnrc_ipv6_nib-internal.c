@@ -19,6 +19,7 @@
 #include "net/ndp.h"
 #include "net/gnrc/ipv6/nib/conf.h"
 #include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/shared.h"
 
 #include "_nib-internal.h"
 
@@ -470,6 +471,34 @@ static void test_nib_nc_add__success(void)
     TEST_ASSERT_EQUAL_INT(IFACE, _nib_onl_get_if(node));
 }
 
+/*
+ * Creates a neighbor cache entry on the highest PID of an interface of the
+ * shared netif thread and registers it with 6Lo-AR.
+ * Expected result: the entry should be found on that interface and both the
+ * interface and the AR state should be retrievable unchanged
+ */
+static void test_nib_nc_add__success_shared_netif(void)
+{
+    _nib_onl_entry_t *node;
+    gnrc_ipv6_nib_nc_t nce;
+    static const ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                               { .u64 = TEST_UINT64 } } };
+    const unsigned iface = GNRC_NETIF_SHARED_PID_FIRST + GNRC_NETIF_NUMOF - 1;
+
+    TEST_ASSERT_NOT_NULL((node = _nib_nc_add(&addr, iface,
+                                             GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE)));
+    node->info |= GNRC_IPV6_NIB_NC_INFO_AR_STATE_REGISTERED;
+    TEST_ASSERT_EQUAL_INT(iface, _nib_onl_get_if(node));
+    TEST_ASSERT(node == _nib_onl_get(&addr, iface));
+    TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE));
+    _nib_nc_get(node, &nce);
+    TEST_ASSERT_EQUAL_INT(iface, gnrc_ipv6_nib_nc_get_iface(&nce));
+    TEST_ASSERT_EQUAL_INT(GNRC_IPV6_NIB_NC_INFO_AR_STATE_REGISTERED,
+                          gnrc_ipv6_nib_nc_get_ar_state(&nce));
+    TEST_ASSERT_EQUAL_INT(GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE,
+                          gnrc_ipv6_nib_nc_get_nud_state(&nce));
+}
+
 /*
  * Creates GNRC_IPV6_NIB_NUMOF neighbor cache entries with differnt IP address.
  * Expected result: new entries should still be able to be created and further
@@ -1934,6 +1963,7 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_nc_add__no_space_left_diff_addr_iface),
         new_TestFixture(test_nib_nc_add__success_duplicate),
         new_TestFixture(test_nib_nc_add__success),
+        new_TestFixture(test_nib_nc_add__success_shared_netif),
         new_TestFixture(test_nib_nc_add__success_full_but_garbage_collectible),
         new_TestFixture(test_nib_nc_remove__uncleared),
         new_TestFixture(test_nib_nc_remove__cleared),
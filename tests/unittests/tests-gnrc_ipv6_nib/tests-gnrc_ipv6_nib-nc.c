@@ -14,6 +14,7 @@
  */
 
 #include <inttypes.h>
+#include <string.h>
 
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/ipv6/nib/nc.h"
@@ -303,6 +304,70 @@ static void test_nib_nc_mark_reachable__success(void)
     TEST_ASSERT(!gnrc_ipv6_nib_nc_iter(0, &iter_state, &nce));
 }
 
+/*
+ * Creates a non-manual neighbor cache entry in state INCOMPLETE and then calls
+ * gnrc_ipv6_nib_mark_reachable().
+ * Expected result: The entry should still be incomplete, since there is no
+ * link-layer address the confirmation could refer to.
+ */
+static void test_nib_nc_mark_reachable__incomplete(void)
+{
+    void *iter_state = NULL;
+    static const ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                             { .u64 = TEST_UINT64 } } };
+    gnrc_ipv6_nib_nc_t nce;
+
+    TEST_ASSERT_NOT_NULL(_nib_nc_add(&addr, IFACE,
+                                     GNRC_IPV6_NIB_NC_INFO_NUD_STATE_INCOMPLETE));
+    gnrc_ipv6_nib_nc_mark_reachable(&addr);
+    TEST_ASSERT(gnrc_ipv6_nib_nc_iter(0, &iter_state, &nce));
+    TEST_ASSERT_EQUAL_INT(GNRC_IPV6_NIB_NC_INFO_NUD_STATE_INCOMPLETE,
+                          gnrc_ipv6_nib_nc_get_nud_state(&nce));
+    TEST_ASSERT(!gnrc_ipv6_nib_nc_iter(0, &iter_state, &nce));
+}
+
+#if GNRC_IPV6_NIB_CONF_ARSM
+/*
+ * Creates two non-manual neighbor cache entries with the same link-layer
+ * address, sets them to STALE and then calls
+ * gnrc_ipv6_nib_mark_reachable_l2() with that link-layer address on another
+ * interface and on their interface
+ * Expected result: the entries should be in state STALE after the first call
+ * and both in state REACHABLE after the second.
+ */
+static void test_nib_nc_mark_reachable_l2__success(void)
+{
+    void *iter_state = NULL;
+    ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                  { .u64 = TEST_UINT64 } } };
+    static const uint8_t l2addr[] = L2ADDR;
+    gnrc_ipv6_nib_nc_t nce;
+
+    for (unsigned i = 0; i < 2; i++) {
+        _nib_onl_entry_t *node = _nib_nc_add(&addr, IFACE,
+                                             GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE);
+
+        TEST_ASSERT_NOT_NULL(node);
+        memcpy(node->l2addr, l2addr, sizeof(l2addr));
+        node->l2addr_len = sizeof(l2addr);
+        addr.u64[1].u64++;
+    }
+    gnrc_ipv6_nib_nc_mark_reachable_l2(IFACE + 1, l2addr, sizeof(l2addr));
+    while (gnrc_ipv6_nib_nc_iter(0, &iter_state, &nce)) {
+        TEST_ASSERT_EQUAL_INT(GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE,
+                              gnrc_ipv6_nib_nc_get_nud_state(&nce));
+    }
+    gnrc_ipv6_nib_nc_mark_reachable_l2(IFACE, l2addr, sizeof(l2addr));
+    iter_state = NULL;
+    for (unsigned i = 0; i < 2; i++) {
+        TEST_ASSERT(gnrc_ipv6_nib_nc_iter(0, &iter_state, &nce));
+        TEST_ASSERT_EQUAL_INT(GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE,
+                              gnrc_ipv6_nib_nc_get_nud_state(&nce));
+    }
+    TEST_ASSERT(!gnrc_ipv6_nib_nc_iter(0, &iter_state, &nce));
+}
+#endif
+
 Test *tests_gnrc_ipv6_nib_nc_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -316,6 +381,10 @@ Test *tests_gnrc_ipv6_nib_nc_tests(void)
         new_TestFixture(test_nib_nc_mark_reachable__not_in_neighbor_cache),
         new_TestFixture(test_nib_nc_mark_reachable__unmanaged),
         new_TestFixture(test_nib_nc_mark_reachable__success),
+        new_TestFixture(test_nib_nc_mark_reachable__incomplete),
+#if GNRC_IPV6_NIB_CONF_ARSM
+        new_TestFixture(test_nib_nc_mark_reachable_l2__success),
+#endif
         /* gnrc_ipv6_nib_nc_iter() is tested during all the tests above */
     };
 
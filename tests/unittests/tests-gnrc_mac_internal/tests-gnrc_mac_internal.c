@@ -27,6 +27,29 @@ static void set_up(void)
     gnrc_pktbuf_init();
 }
 
+#if (GNRC_MAC_TX_QUEUE_SIZE != 0) && (GNRC_MAC_NEIGHBOR_COUNT != 0)
+/* neighbors are placed by the hash of their address, so look them up */
+static gnrc_mac_tx_neighbor_t *_neighbor(gnrc_mac_tx_t *tx, const uint8_t *addr)
+{
+    for (unsigned i = 1; i <= GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        if ((tx->neighbors[i].l2_addr_len == 2) &&
+            (memcmp(tx->neighbors[i].l2_addr, addr, 2) == 0)) {
+            return &tx->neighbors[i];
+        }
+    }
+    return NULL;
+}
+
+static gnrc_pktsnip_t *_pkt(const uint8_t *addr, size_t len)
+{
+    gnrc_pktsnip_t *hdr = gnrc_netif_hdr_build(NULL, 0, (uint8_t *)addr, 2);
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+
+    LL_APPEND(hdr, pkt);
+    return hdr;
+}
+#endif
+
 #if GNRC_MAC_TX_QUEUE_SIZE != 0
 /**
  * @brief This function test the `gnrc_mac_queue_tx_packet()`, to see whether it can
@@ -37,8 +60,8 @@ static void set_up(void)
  *        queues 4 packets, which are pkt1, pkt2, pkt3 and pkt_bcast, into a defined `tx`
  *        (type of `gnrc_mac_tx_t`). Pkt1, pkt2 have the same destination address of "0x76b6",
  *        , pkt3 is heading for "0x447e", while pkt_bcast is for broadcasting.
- *        Expected results: pkt1 and pkt2 should be queued to `tx::neighbors[1]::queue`,
- *        pkt3 should be queued to `tx::neighbors[2]::queue`, while pkt_bcast should be
+ *        Expected results: pkt1 and pkt2 should be queued to the same neighbor queue,
+ *        pkt3 should be queued to another unicast neighbor queue, while pkt_bcast should be
  *        queued to `tx::neighbors[0]::queue`.
  *
  *        In case when the `gnrc_mac_tx_neighbor_t` structure is not in used (indicated by
@@ -92,32 +115,40 @@ static void test_gnrc_mac_queue_tx_packet(void)
 
 #if GNRC_MAC_NEIGHBOR_COUNT != 0
 
+    static const uint8_t addr1[] = { 0x76, 0xb6 };
+    static const uint8_t addr2[] = { 0x44, 0x7e };
+    gnrc_mac_tx_neighbor_t *n1, *n2;
     gnrc_pktsnip_t *pkt_head;
     TEST_ASSERT(gnrc_mac_queue_tx_packet(&tx,1,pkt1));
-    pkt_head = gnrc_priority_pktqueue_head(&tx.neighbors[1].queue);
+    n1 = _neighbor(&tx, addr1);
+    TEST_ASSERT_NOT_NULL(n1);
+    pkt_head = gnrc_priority_pktqueue_head(&n1->queue);
     TEST_ASSERT(pkt_head == pkt1);
-    TEST_ASSERT(1 == gnrc_priority_pktqueue_length(&tx.neighbors[1].queue));
+    TEST_ASSERT(1 == gnrc_priority_pktqueue_length(&n1->queue));
     TEST_ASSERT_EQUAL_STRING(TEST_STRING4, pkt_head->next->data);
 
     TEST_ASSERT(gnrc_mac_queue_tx_packet(&tx,0,pkt2));
-    pkt_head = gnrc_priority_pktqueue_head(&tx.neighbors[1].queue);
+    pkt_head = gnrc_priority_pktqueue_head(&n1->queue);
     TEST_ASSERT(pkt_head == pkt2);
-    TEST_ASSERT(2 == gnrc_priority_pktqueue_length(&tx.neighbors[1].queue));
+    TEST_ASSERT(2 == gnrc_priority_pktqueue_length(&n1->queue));
     TEST_ASSERT_EQUAL_STRING(TEST_STRING8, pkt_head->next->data);
 
-    pkt_head = gnrc_priority_pktqueue_pop(&tx.neighbors[1].queue);
+    pkt_head = gnrc_priority_pktqueue_pop(&n1->queue);
     TEST_ASSERT(pkt_head == pkt2);
-    TEST_ASSERT(1 == gnrc_priority_pktqueue_length(&tx.neighbors[1].queue));
+    TEST_ASSERT(1 == gnrc_priority_pktqueue_length(&n1->queue));
     TEST_ASSERT_EQUAL_STRING(TEST_STRING8, pkt_head->next->data);
 
-    pkt_head = gnrc_priority_pktqueue_head(&tx.neighbors[1].queue);
+    pkt_head = gnrc_priority_pktqueue_head(&n1->queue);
     TEST_ASSERT(pkt_head == pkt1);
     TEST_ASSERT_EQUAL_STRING(TEST_STRING4, pkt_head->next->data);
 
     TEST_ASSERT(gnrc_mac_queue_tx_packet(&tx,0,pkt3));
-    pkt_head = gnrc_priority_pktqueue_head(&tx.neighbors[2].queue);
+    n2 = _neighbor(&tx, addr2);
+    TEST_ASSERT_NOT_NULL(n2);
+    TEST_ASSERT(n1 != n2);
+    pkt_head = gnrc_priority_pktqueue_head(&n2->queue);
     TEST_ASSERT(pkt_head == pkt3);
-    TEST_ASSERT(1 == gnrc_priority_pktqueue_length(&tx.neighbors[2].queue));
+    TEST_ASSERT(1 == gnrc_priority_pktqueue_length(&n2->queue));
     TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt_head->next->data);
 
     TEST_ASSERT(gnrc_mac_queue_tx_packet(&tx,0,pkt_bcast));
@@ -174,6 +205,87 @@ static void test_gnrc_mac_queue_tx_packet(void)
 
 #endif /* GNRC_MAC_NEIGHBOR_COUNT != 0 */
 }
+
+#if GNRC_MAC_NEIGHBOR_COUNT != 0
+/**
+ * @brief Checks that a neighbor with a full queue does not block the queue
+ *        entries for other neighbors.
+ */
+static void test_gnrc_mac_queue_tx_packet__push_out(void)
+{
+    static const uint8_t addr1[] = { 0x76, 0xb6 };
+    static const uint8_t addr2[] = { 0x44, 0x7e };
+    gnrc_mac_tx_t tx = GNRC_MAC_TX_INIT;
+    gnrc_mac_tx_neighbor_t *n1, *n2;
+    gnrc_pktsnip_t *pkt;
+
+    for (unsigned i = 0; i < GNRC_MAC_TX_QUEUE_SIZE; i++) {
+        TEST_ASSERT(gnrc_mac_queue_tx_packet(&tx, 0, _pkt(addr1, 8)));
+    }
+    n1 = _neighbor(&tx, addr1);
+    TEST_ASSERT_NOT_NULL(n1);
+    TEST_ASSERT_EQUAL_INT(GNRC_MAC_TX_QUEUE_SIZE, n1->stats.depth_max);
+
+    /* last packet of the longer queue is dropped */
+    TEST_ASSERT(gnrc_mac_queue_tx_packet(&tx, 0, _pkt(addr2, 8)));
+    n2 = _neighbor(&tx, addr2);
+    TEST_ASSERT_NOT_NULL(n2);
+    TEST_ASSERT_EQUAL_INT(GNRC_MAC_TX_QUEUE_SIZE - 1,
+                          gnrc_priority_pktqueue_length(&n1->queue));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_priority_pktqueue_length(&n2->queue));
+    TEST_ASSERT_EQUAL_INT(1, n1->stats.dropped);
+
+    /* until both queues are of the same length */
+    while (gnrc_priority_pktqueue_length(&n2->queue) <
+           gnrc_priority_pktqueue_length(&n1->queue)) {
+        TEST_ASSERT(gnrc_mac_queue_tx_packet(&tx, 0, _pkt(addr2, 8)));
+    }
+    pkt = _pkt(addr2, 8);
+    TEST_ASSERT(!gnrc_mac_queue_tx_packet(&tx, 0, pkt));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(1, n2->stats.dropped);
+    TEST_ASSERT_EQUAL_INT(GNRC_MAC_TX_QUEUE_SIZE - n1->stats.dropped,
+                          gnrc_priority_pktqueue_length(&n1->queue));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+}
+
+/**
+ * @brief Checks that neighbor queues take turns independently of their
+ *        lengths.
+ */
+static void test_gnrc_mac_dequeue_tx_packet(void)
+{
+    static const uint8_t addr1[] = { 0x76, 0xb6 };
+    static const uint8_t addr2[] = { 0x44, 0x7e };
+    /* one packet per round */
+    static const size_t len = GNRC_MAC_TX_DRR_QUANTUM - sizeof(gnrc_netif_hdr_t) - 2;
+    gnrc_mac_tx_t tx = GNRC_MAC_TX_INIT;
+    gnrc_mac_tx_neighbor_t *n1, *n2, *neighbor, *first;
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NULL(gnrc_mac_dequeue_tx_packet(&tx, &neighbor));
+    for (unsigned i = 0; i < (GNRC_MAC_TX_QUEUE_SIZE - 1); i++) {
+        TEST_ASSERT(gnrc_mac_queue_tx_packet(&tx, 0, _pkt(addr1, len)));
+    }
+    TEST_ASSERT(gnrc_mac_queue_tx_packet(&tx, 0, _pkt(addr2, len)));
+    n1 = _neighbor(&tx, addr1);
+    n2 = _neighbor(&tx, addr2);
+
+    TEST_ASSERT_NOT_NULL(pkt = gnrc_mac_dequeue_tx_packet(&tx, &first));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT((first == n1) || (first == n2));
+    TEST_ASSERT_NOT_NULL(pkt = gnrc_mac_dequeue_tx_packet(&tx, &neighbor));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT((neighbor == n1) || (neighbor == n2));
+    TEST_ASSERT(neighbor != first);
+    while ((pkt = gnrc_mac_dequeue_tx_packet(&tx, &neighbor)) != NULL) {
+        TEST_ASSERT(neighbor == n1);
+        gnrc_pktbuf_release(pkt);
+    }
+    TEST_ASSERT_EQUAL_INT(0, gnrc_priority_pktqueue_length(&n1->queue));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif /* GNRC_MAC_NEIGHBOR_COUNT != 0 */
 #endif /* GNRC_MAC_TX_QUEUE_SIZE != 0 */
 
 #if GNRC_MAC_RX_QUEUE_SIZE != 0
@@ -263,6 +375,10 @@ Test *tests_gnrc_mac_internal_tests(void)
     EMB_UNIT_TESTFIXTURES(fixtures) {
 #if GNRC_MAC_TX_QUEUE_SIZE != 0
         new_TestFixture(test_gnrc_mac_queue_tx_packet),
+#if GNRC_MAC_NEIGHBOR_COUNT != 0
+        new_TestFixture(test_gnrc_mac_queue_tx_packet__push_out),
+        new_TestFixture(test_gnrc_mac_dequeue_tx_packet),
+#endif /* GNRC_MAC_NEIGHBOR_COUNT != 0 */
 #endif /* GNRC_MAC_TX_QUEUE_SIZE != 0 */
 #if GNRC_MAC_RX_QUEUE_SIZE != 0
         new_TestFixture(test_gnrc_mac_queue_rx_packet),
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+#include "embUnit.h"
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/etx.h"
+
+#include "tests-gnrc_netif_etx.h"
+
+#define L2ADDR              { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22, 0xfd, 0x0a }
+#define L2ADDR_LEN          (8U)
+#define ETX(old, tx)        ((((old) * GNRC_NETIF_ETX_ALPHA) + \
+                              ((tx) * GNRC_NETIF_ETX_DIVISOR * \
+                               (100U - GNRC_NETIF_ETX_ALPHA))) / 100U)
+
+static uint8_t _hdr_buf[sizeof(gnrc_netif_hdr_t) + L2ADDR_LEN];
+static gnrc_pktsnip_t _pkt = { .data = _hdr_buf, .size = sizeof(_hdr_buf),
+                               .type = GNRC_NETTYPE_NETIF };
+static uint8_t _l2addr[L2ADDR_LEN] = L2ADDR;
+/* every test uses its own interface, as estimates can't be removed */
+static kernel_pid_t _pid = 1;
+
+static void set_up(void)
+{
+    gnrc_netif_hdr_t *hdr = (gnrc_netif_hdr_t *)_hdr_buf;
+
+    gnrc_netif_hdr_init(hdr, 0, sizeof(_l2addr));
+    gnrc_netif_hdr_set_dst_addr(hdr, _l2addr, sizeof(_l2addr));
+    _pid++;
+}
+
+static uint16_t _get(void)
+{
+    return gnrc_netif_etx_get(_pid, _l2addr, sizeof(_l2addr));
+}
+
+static void test_netif_etx_get__unknown(void)
+{
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ETX_INIT, _get());
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ETX_INIT,
+                          gnrc_netif_etx_get(_pid, _l2addr, 0));
+}
+
+static void test_netif_etx_tx_done__complete(void)
+{
+    gnrc_netif_etx_sending(_pid, &_pkt);
+    gnrc_netif_etx_tx_done(_pid, NETDEV_EVENT_TX_COMPLETE, 0);
+    TEST_ASSERT_EQUAL_INT(ETX(GNRC_NETIF_ETX_INIT, 1), _get());
+    /* only one TX status per frame */
+    gnrc_netif_etx_tx_done(_pid, NETDEV_EVENT_TX_COMPLETE, 0);
+    TEST_ASSERT_EQUAL_INT(ETX(GNRC_NETIF_ETX_INIT, 1), _get());
+}
+
+static void test_netif_etx_tx_done__retries(void)
+{
+    gnrc_netif_etx_sending(_pid, &_pkt);
+    gnrc_netif_etx_tx_done(_pid, NETDEV_EVENT_TX_COMPLETE, 3);
+    TEST_ASSERT_EQUAL_INT(ETX(GNRC_NETIF_ETX_INIT, 4), _get());
+}
+
+static void test_netif_etx_tx_done__noack(void)
+{
+    gnrc_netif_etx_sending(_pid, &_pkt);
+    gnrc_netif_etx_tx_done(_pid, NETDEV_EVENT_TX_NOACK, 0);
+    TEST_ASSERT_EQUAL_INT(ETX(GNRC_NETIF_ETX_INIT,
+                              GNRC_NETIF_ETX_NOACK_PENALTY), _get());
+}
+
+static void test_netif_etx_tx_done__medium_busy(void)
+{
+    gnrc_netif_etx_sending(_pid, &_pkt);
+    gnrc_netif_etx_tx_done(_pid, NETDEV_EVENT_TX_MEDIUM_BUSY, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ETX_INIT, _get());
+    /* frame is still pending */
+    gnrc_netif_etx_tx_done(_pid, NETDEV_EVENT_TX_COMPLETE, 0);
+    TEST_ASSERT_EQUAL_INT(ETX(GNRC_NETIF_ETX_INIT, 1), _get());
+}
+
+static void test_netif_etx_tx_done__broadcast(void)
+{
+    gnrc_netif_hdr_t *hdr = (gnrc_netif_hdr_t *)_hdr_buf;
+
+    gnrc_netif_etx_sending(_pid, &_pkt);
+    hdr->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    gnrc_netif_etx_sending(_pid, &_pkt);
+    gnrc_netif_etx_tx_done(_pid, NETDEV_EVENT_TX_NOACK, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ETX_INIT, _get());
+}
+
+static void test_netif_etx_tx_done__other_iface(void)
+{
+    gnrc_netif_etx_sending(_pid, &_pkt);
+    gnrc_netif_etx_tx_done(_pid + 1, NETDEV_EVENT_TX_NOACK, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_ETX_INIT, _get());
+}
+
+static void test_netif_etx_tx_done__converge(void)
+{
+    for (unsigned i = 0; i < 100; i++) {
+        gnrc_netif_etx_sending(_pid, &_pkt);
+        gnrc_netif_etx_tx_done(_pid, NETDEV_EVENT_TX_COMPLETE, 0);
+    }
+    TEST_ASSERT(_get() < (GNRC_NETIF_ETX_DIVISOR + (GNRC_NETIF_ETX_DIVISOR / 8)));
+}
+
+static Test *tests_netif_etx_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_netif_etx_get__unknown),
+        new_TestFixture(test_netif_etx_tx_done__complete),
+        new_TestFixture(test_netif_etx_tx_done__retries),
+        new_TestFixture(test_netif_etx_tx_done__noack),
+        new_TestFixture(test_netif_etx_tx_done__medium_busy),
+        new_TestFixture(test_netif_etx_tx_done__broadcast),
+        new_TestFixture(test_netif_etx_tx_done__other_iface),
+        new_TestFixture(test_netif_etx_tx_done__converge),
+    };
+
+    EMB_UNIT_TESTCALLER(netif_etx_tests, set_up, NULL, fixtures);
+
+    return (Test *)&netif_etx_tests;
+}
+
+void tests_gnrc_netif_etx(void)
+{
+    TESTS_RUN(tests_netif_etx_tests());
+}
+/** @} */
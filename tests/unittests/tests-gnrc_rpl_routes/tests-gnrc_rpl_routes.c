@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+#include "embUnit.h"
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/rpl/routes.h"
+
+#include "tests-gnrc_rpl_routes.h"
+
+#define IFACE1              (6)
+#define IFACE2              (7)
+#define DST                 {{ 0x20, 0x01, 0xab, 0xcd, \
+                               0x00, 0x00, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x01 }}
+#define NEXT_HOP1           {{ 0xfe, 0x80, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x01 }}
+#define NEXT_HOP2           {{ 0xfe, 0x80, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x02 }}
+
+static void set_up(void)
+{
+    gnrc_rpl_routes_flush(0);
+}
+
+static void test_rpl_routes_add__EINVAL(void)
+{
+    static const ipv6_addr_t dst = DST;
+    static const ipv6_addr_t next_hop = NEXT_HOP1;
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_rpl_routes_add(NULL, &next_hop,
+                                                       IFACE1, 0));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_rpl_routes_add(&dst, NULL,
+                                                       IFACE1, 0));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_rpl_routes_add(&dst, &next_hop,
+                                                       0, 0));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_rpl_routes_add(&ipv6_addr_all_nodes_link_local,
+                                                       &next_hop, IFACE1, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_numof());
+}
+
+static void test_rpl_routes_get__ENETUNREACH(void)
+{
+    static const ipv6_addr_t dst = DST;
+    static const ipv6_addr_t next_hop = NEXT_HOP1;
+    ipv6_addr_t other = DST;
+    gnrc_ipv6_nib_ft_t fte;
+
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH, gnrc_rpl_routes_get(&dst, &fte));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_add(&dst, &next_hop, IFACE1, 0));
+    other.u8[15]++;
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH, gnrc_rpl_routes_get(&other, &fte));
+    other.u8[15]--;
+    other.u8[7]++;
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH, gnrc_rpl_routes_get(&other, &fte));
+}
+
+static void test_rpl_routes_add_get(void)
+{
+    static const ipv6_addr_t dst = DST;
+    static const ipv6_addr_t next_hop = NEXT_HOP1;
+    gnrc_ipv6_nib_ft_t fte;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_add(&dst, &next_hop, IFACE1, 0));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_routes_numof());
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_get(&dst, &fte));
+    TEST_ASSERT(ipv6_addr_equal(&dst, &fte.dst));
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &fte.next_hop));
+    TEST_ASSERT_EQUAL_INT(IPV6_ADDR_BIT_LEN, fte.dst_len);
+    TEST_ASSERT_EQUAL_INT(0, fte.primary);
+    TEST_ASSERT_EQUAL_INT(IFACE1, fte.iface);
+}
+
+static void test_rpl_routes_add__update(void)
+{
+    static const ipv6_addr_t dst = DST;
+    static const ipv6_addr_t next_hop1 = NEXT_HOP1;
+    static const ipv6_addr_t next_hop2 = NEXT_HOP2;
+    gnrc_ipv6_nib_ft_t fte;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_add(&dst, &next_hop1, IFACE1, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_add(&dst, &next_hop2, IFACE2, 0));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_routes_numof());
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_get(&dst, &fte));
+    TEST_ASSERT(ipv6_addr_equal(&next_hop2, &fte.next_hop));
+    TEST_ASSERT_EQUAL_INT(IFACE2, fte.iface);
+}
+
+/*
+ * Fills the store in descending order, so every route is inserted at the
+ * front, and checks that all of them can be found.
+ */
+static void test_rpl_routes_add__ENOMEM(void)
+{
+    static const ipv6_addr_t next_hop = NEXT_HOP1;
+    ipv6_addr_t dst = DST;
+    gnrc_ipv6_nib_ft_t fte;
+
+    for (unsigned i = GNRC_RPL_ROUTES_NUMOF; i > 0; i--) {
+        dst.u8[14] = i >> 8;
+        dst.u8[15] = i & 0xff;
+        TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_add(&dst, &next_hop,
+                                                     IFACE1, 0));
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_ROUTES_NUMOF, gnrc_rpl_routes_numof());
+    dst.u8[15] = 0;
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_rpl_routes_add(&dst, &next_hop,
+                                                       IFACE1, 0));
+    for (unsigned i = 1; i <= GNRC_RPL_ROUTES_NUMOF; i++) {
+        dst.u8[14] = i >> 8;
+        dst.u8[15] = i & 0xff;
+        TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_get(&dst, &fte));
+        TEST_ASSERT(ipv6_addr_equal(&dst, &fte.dst));
+    }
+}
+
+static void test_rpl_routes_add__prefix_ENOMEM(void)
+{
+    static const ipv6_addr_t next_hop = NEXT_HOP1;
+    ipv6_addr_t dst = DST;
+
+    for (unsigned i = 0; i < GNRC_RPL_ROUTES_PREFIX_NUMOF; i++) {
+        dst.u8[7] = i;
+        TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_add(&dst, &next_hop,
+                                                     IFACE1, 0));
+    }
+    dst.u8[7] = GNRC_RPL_ROUTES_PREFIX_NUMOF;
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_rpl_routes_add(&dst, &next_hop,
+                                                       IFACE1, 0));
+    /* prefix is free again after its last route is gone */
+    dst.u8[7] = 0;
+    gnrc_rpl_routes_del(&dst);
+    dst.u8[7] = GNRC_RPL_ROUTES_PREFIX_NUMOF;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_add(&dst, &next_hop, IFACE1, 0));
+}
+
+static void test_rpl_routes_del(void)
+{
+    static const ipv6_addr_t dst = DST;
+    static const ipv6_addr_t next_hop = NEXT_HOP1;
+    gnrc_ipv6_nib_ft_t fte;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_add(&dst, &next_hop, IFACE1, 0));
+    gnrc_rpl_routes_del(&dst);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_numof());
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH, gnrc_rpl_routes_get(&dst, &fte));
+}
+
+static void test_rpl_routes_iter_flush(void)
+{
+    static const ipv6_addr_t next_hop1 = NEXT_HOP1;
+    static const ipv6_addr_t next_hop2 = NEXT_HOP2;
+    ipv6_addr_t dst = DST;
+    gnrc_ipv6_nib_ft_t fte;
+    void *state = NULL;
+    unsigned count = 0;
+
+    for (unsigned i = 0; i < 3; i++) {
+        dst.u8[15] = i;
+        TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_add(&dst, &next_hop1,
+                                                     IFACE1, 0));
+    }
+    dst.u8[15] = 3;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_add(&dst, &next_hop2, IFACE2, 0));
+
+    while (gnrc_rpl_routes_iter(IFACE1, &state, &fte)) {
+        TEST_ASSERT(ipv6_addr_equal(&next_hop1, &fte.next_hop));
+        count++;
+    }
+    TEST_ASSERT_EQUAL_INT(3, count);
+    state = NULL;
+    count = 0;
+    while (gnrc_rpl_routes_iter(0, &state, &fte)) {
+        count++;
+    }
+    TEST_ASSERT_EQUAL_INT(4, count);
+
+    gnrc_rpl_routes_flush(IFACE1);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_routes_numof());
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_routes_get(&dst, &fte));
+}
+
+static Test *tests_rpl_routes_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rpl_routes_add__EINVAL),
+        new_TestFixture(test_rpl_routes_get__ENETUNREACH),
+        new_TestFixture(test_rpl_routes_add_get),
+        new_TestFixture(test_rpl_routes_add__update),
+        new_TestFixture(test_rpl_routes_add__ENOMEM),
+        new_TestFixture(test_rpl_routes_add__prefix_ENOMEM),
+        new_TestFixture(test_rpl_routes_del),
+        new_TestFixture(test_rpl_routes_iter_flush),
+    };
+
+    EMB_UNIT_TESTCALLER(rpl_routes_tests, set_up, NULL, fixtures);
+
+    return (Test *)&rpl_routes_tests;
+}
+
+void tests_gnrc_rpl_routes(void)
+{
+    TESTS_RUN(tests_rpl_routes_tests());
+}
+/** @} */
@@ -14,6 +14,7 @@
  * @author Cenk Gündoğan <mail@cgundogan.de>
  * @author Martine Lenders <m.lenders@fu-berlin.de>
  */
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 #include "embUnit.h"
@@ -58,6 +59,9 @@ static void set_up(void)
 {
     memset(&hdr, 0, sizeof(hdr));
     memset(buf, 0, sizeof(buf));
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+    gnrc_rpl_srh_root_flush();
+#endif
 }
 
 static inline void _init_hdrs(gnrc_rpl_srh_t **srh, uint8_t **vec,
@@ -180,6 +184,102 @@ static void test_rpl_srh_nexthop_prefix_elided(void)
     TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &expected2));
 }
 
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+static void test_rpl_srh_root_get__ENETUNREACH(void)
+{
+    static const ipv6_addr_t a1 = IPV6_ADDR1, dst = IPV6_DST;
+    uint8_t srh[GNRC_RPL_SRH_ROOT_SRH_MAX];
+    ipv6_addr_t first_hop;
+
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH,
+                          gnrc_rpl_srh_root_get(&dst, &first_hop, srh,
+                                                sizeof(srh)));
+    /* parent of dst has no path */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&dst, &a1, 60));
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH,
+                          gnrc_rpl_srh_root_get(&dst, &first_hop, srh,
+                                                sizeof(srh)));
+}
+
+static void test_rpl_srh_root_get__child(void)
+{
+    static const ipv6_addr_t dst = IPV6_DST;
+    uint8_t srh[GNRC_RPL_SRH_ROOT_SRH_MAX];
+    ipv6_addr_t first_hop;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&dst, NULL, 60));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_get(&dst, &first_hop, srh,
+                                                   sizeof(srh)));
+    TEST_ASSERT(ipv6_addr_equal(&dst, &first_hop));
+}
+
+/* builds the header of a path of three hops and follows it */
+static void test_rpl_srh_root_get__process(void)
+{
+    static const ipv6_addr_t a1 = IPV6_ADDR1, a2 = IPV6_ADDR2, dst = IPV6_DST;
+    uint8_t srh[GNRC_RPL_SRH_ROOT_SRH_MAX];
+    gnrc_rpl_srh_t *rh = (gnrc_rpl_srh_t *)srh;
+    int res;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&dst, &a2, 60));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&a2, &a1, 60));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&a1, NULL, 60));
+    res = gnrc_rpl_srh_root_get(&dst, &hdr.dst, srh, sizeof(srh));
+    TEST_ASSERT_EQUAL_INT(sizeof(gnrc_rpl_srh_t) + 8, res);
+    TEST_ASSERT(ipv6_addr_equal(&a1, &hdr.dst));
+    TEST_ASSERT_EQUAL_INT(2, rh->seg_left);
+    TEST_ASSERT_EQUAL_INT(0xff, rh->compr);
+
+    res = gnrc_rpl_srh_process(&hdr, rh);
+    TEST_ASSERT_EQUAL_INT(res, GNRC_IPV6_EXT_RH_FORWARDED);
+    TEST_ASSERT(ipv6_addr_equal(&a2, &hdr.dst));
+    res = gnrc_rpl_srh_process(&hdr, rh);
+    TEST_ASSERT_EQUAL_INT(res, GNRC_IPV6_EXT_RH_FORWARDED);
+    TEST_ASSERT(ipv6_addr_equal(&dst, &hdr.dst));
+    TEST_ASSERT_EQUAL_INT(0, rh->seg_left);
+}
+
+static void test_rpl_srh_root_get__invalidate(void)
+{
+    static const ipv6_addr_t a1 = IPV6_ADDR1, a2 = IPV6_ADDR2, dst = IPV6_DST;
+    uint8_t srh[GNRC_RPL_SRH_ROOT_SRH_MAX];
+    gnrc_rpl_srh_t *rh = (gnrc_rpl_srh_t *)srh;
+    ipv6_addr_t first_hop;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&dst, &a2, 60));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&a2, &a1, 60));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&a1, NULL, 60));
+    TEST_ASSERT(0 < gnrc_rpl_srh_root_get(&dst, &first_hop, srh, sizeof(srh)));
+    TEST_ASSERT_EQUAL_INT(2, rh->seg_left);
+
+    /* parent change is picked up instead of the cached header */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&dst, &a1, 60));
+    TEST_ASSERT(0 < gnrc_rpl_srh_root_get(&dst, &first_hop, srh, sizeof(srh)));
+    TEST_ASSERT(ipv6_addr_equal(&a1, &first_hop));
+    TEST_ASSERT_EQUAL_INT(1, rh->seg_left);
+
+    /* No-Path DAO of the parent */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&a1, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH,
+                          gnrc_rpl_srh_root_get(&dst, &first_hop, srh,
+                                                sizeof(srh)));
+}
+
+static void test_rpl_srh_root_get__ELOOP(void)
+{
+    static const ipv6_addr_t a1 = IPV6_ADDR1, a2 = IPV6_ADDR2, dst = IPV6_DST;
+    uint8_t srh[GNRC_RPL_SRH_ROOT_SRH_MAX];
+    ipv6_addr_t first_hop;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&dst, &a1, 60));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&a1, &a2, 60));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_root_update(&a2, &a1, 60));
+    TEST_ASSERT_EQUAL_INT(-ELOOP,
+                          gnrc_rpl_srh_root_get(&dst, &first_hop, srh,
+                                                sizeof(srh)));
+}
+#endif
+
 static Test *tests_rpl_srh_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -188,6 +288,13 @@ static Test *tests_rpl_srh_tests(void)
         new_TestFixture(test_rpl_srh_too_many_seg_left),
         new_TestFixture(test_rpl_srh_nexthop_no_prefix_elided),
         new_TestFixture(test_rpl_srh_nexthop_prefix_elided),
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+        new_TestFixture(test_rpl_srh_root_get__ENETUNREACH),
+        new_TestFixture(test_rpl_srh_root_get__child),
+        new_TestFixture(test_rpl_srh_root_get__process),
+        new_TestFixture(test_rpl_srh_root_get__invalidate),
+        new_TestFixture(test_rpl_srh_root_get__ELOOP),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(rpl_srh_tests, set_up, NULL, fixtures);
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     unittests
+ * @{
+ *
+ * @file
+ * @brief       Test cases for the word-wise non-cryptographic hashes
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "hashes.h"
+
+#include "tests-hashes.h"
+
+#define SEED    (0x9747b28c)
+
+static uint32_t _xxh32(const char *str, uint32_t seed)
+{
+    return xxh32_hash((const uint8_t *)str, strlen(str), seed);
+}
+
+static uint32_t _murmur3(const char *str, uint32_t seed)
+{
+    return murmur3_32_hash((const uint8_t *)str, strlen(str), seed);
+}
+
+/* results of the reference implementations */
+static void test_hashes_xxh32(void)
+{
+    TEST_ASSERT_EQUAL_INT(0x02cc5d05, _xxh32("", 0));
+    TEST_ASSERT_EQUAL_INT(0x550d7456, _xxh32("a", 0));
+    TEST_ASSERT_EQUAL_INT(0x32d153ff, _xxh32("abc", 0));
+    TEST_ASSERT_EQUAL_INT(0x7c948494, _xxh32("message digest", 0));
+    TEST_ASSERT_EQUAL_INT(0x63a14d5f, _xxh32("abcdefghijklmnopqrstuvwxyz", 0));
+    TEST_ASSERT_EQUAL_INT(0xe85ea4de,
+        _xxh32("The quick brown fox jumps over the lazy dog", 0));
+    TEST_ASSERT_EQUAL_INT(0x8d3b42d8, _xxh32("", SEED));
+    TEST_ASSERT_EQUAL_INT(0x4d4cb222, _xxh32("abc", SEED));
+    TEST_ASSERT_EQUAL_INT(0x82d26340,
+        _xxh32("abcdefghijklmnopqrstuvwxyz", SEED));
+}
+
+static void test_hashes_xxh32_unaligned(void)
+{
+    static const char str[] = "_The quick brown fox jumps over the lazy dog";
+
+    TEST_ASSERT_EQUAL_INT(0xe85ea4de, _xxh32(&str[1], 0));
+}
+
+static void test_hashes_murmur3(void)
+{
+    TEST_ASSERT_EQUAL_INT(0x00000000, _murmur3("", 0));
+    TEST_ASSERT_EQUAL_INT(0x514e28b7, _murmur3("", 1));
+    TEST_ASSERT_EQUAL_INT(0x3c2569b2, _murmur3("a", 0));
+    TEST_ASSERT_EQUAL_INT(0xb3dd93fa, _murmur3("abc", 0));
+    TEST_ASSERT_EQUAL_INT(0x638f4169, _murmur3("message digest", 0));
+    TEST_ASSERT_EQUAL_INT(0x2e4ff723,
+        _murmur3("The quick brown fox jumps over the lazy dog", 0));
+    TEST_ASSERT_EQUAL_INT(0xebb6c228, _murmur3("", SEED));
+    TEST_ASSERT_EQUAL_INT(0xc84a62dd, _murmur3("abc", SEED));
+    TEST_ASSERT_EQUAL_INT(0x2fa826cd,
+        _murmur3("The quick brown fox jumps over the lazy dog", SEED));
+}
+
+Test *tests_hashes_non_crypto_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_hashes_xxh32),
+        new_TestFixture(test_hashes_xxh32_unaligned),
+        new_TestFixture(test_hashes_murmur3),
+    };
+
+    EMB_UNIT_TESTCALLER(hashes_non_crypto_tests, NULL, NULL, fixtures);
+
+    return (Test *)&hashes_non_crypto_tests;
+}
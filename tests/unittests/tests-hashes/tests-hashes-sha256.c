@@ -212,6 +212,22 @@ static void test_hashes_sha256_hash_long_sequence(void)
                     hlong_sequence));
 }
 
+static void test_hashes_sha256_multi(void)
+{
+    static const char *const data[] = {
+        "1234567890_1", "1234567890_2", "1234567890_3", "1234567890_4",
+    };
+    static const unsigned char *const expected[] = { h01, h02, h03, h04 };
+    unsigned char hashes[4][SHA256_DIGEST_LENGTH];
+    void *const digests[] = { hashes[0], hashes[1], hashes[2], hashes[3] };
+
+    sha256_multi((const void *const *)data, strlen(data[0]), digests, 4);
+    for (unsigned i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(0, memcmp(expected[i], hashes[i],
+                                        SHA256_DIGEST_LENGTH));
+    }
+}
+
 Test *tests_hashes_sha256_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -227,6 +243,7 @@ Test *tests_hashes_sha256_tests(void)
         new_TestFixture(test_hashes_sha256_hash_sequence_failing_compare),
 
         new_TestFixture(test_hashes_sha256_hash_long_sequence),
+        new_TestFixture(test_hashes_sha256_multi),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha256_tests, NULL, NULL,
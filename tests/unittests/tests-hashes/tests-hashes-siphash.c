@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     unittests
+ * @{
+ *
+ * @file
+ * @brief       Test cases for the SipHash implementation
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "embUnit/embUnit.h"
+
+#include "hashes/siphash.h"
+
+#include "tests-hashes.h"
+
+static uint8_t key[SIPHASH_KEY_LEN];
+static uint8_t msg[64];
+
+static void set_up(void)
+{
+    /* key and messages of the test vectors of the reference code */
+    for (unsigned i = 0; i < sizeof(key); i++) {
+        key[i] = i;
+    }
+    for (unsigned i = 0; i < sizeof(msg); i++) {
+        msg[i] = i;
+    }
+}
+
+static void test_hashes_siphash24(void)
+{
+    TEST_ASSERT(siphash24(key, msg, 0) == 0x726fdb47dd0e0e31ULL);
+    TEST_ASSERT(siphash24(key, msg, 1) == 0x74f839c593dc67fdULL);
+    TEST_ASSERT(siphash24(key, msg, 7) == 0xab0200f58b01d137ULL);
+    TEST_ASSERT(siphash24(key, msg, 8) == 0x93f5f5799a932462ULL);
+    TEST_ASSERT(siphash24(key, msg, 15) == 0xa129ca6149be45e5ULL);
+    TEST_ASSERT(siphash24(key, msg, 16) == 0x3f2acc7f57c29bdbULL);
+    TEST_ASSERT(siphash24(key, msg, 63) == 0x958a324ceb064572ULL);
+}
+
+static void test_hashes_siphash13(void)
+{
+    TEST_ASSERT(siphash13(key, msg, 0) == 0xabac0158050fc4dcULL);
+    TEST_ASSERT(siphash13(key, msg, 1) == 0xc9f49bf37d57ca93ULL);
+    TEST_ASSERT(siphash13(key, msg, 7) == 0xd3927d989bb11140ULL);
+    TEST_ASSERT(siphash13(key, msg, 8) == 0x369095118d299a8eULL);
+    TEST_ASSERT(siphash13(key, msg, 15) == 0xd320d86d2a519956ULL);
+    TEST_ASSERT(siphash13(key, msg, 16) == 0xcc4fdd1a7d908b66ULL);
+    TEST_ASSERT(siphash13(key, msg, 63) == 0x9d199062b7bbb3a8ULL);
+}
+
+Test *tests_hashes_siphash_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_hashes_siphash24),
+        new_TestFixture(test_hashes_siphash13),
+    };
+
+    EMB_UNIT_TESTCALLER(hashes_siphash_tests, set_up, NULL, fixtures);
+
+    return (Test *)&hashes_siphash_tests;
+}
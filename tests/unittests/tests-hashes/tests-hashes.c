@@ -29,4 +29,6 @@ void tests_hashes(void)
     TESTS_RUN(tests_hashes_sha256_hmac_tests());
     TESTS_RUN(tests_hashes_sha256_chain_tests());
     TESTS_RUN(tests_hashes_sha3_tests());
+    TESTS_RUN(tests_hashes_non_crypto_tests());
+    TESTS_RUN(tests_hashes_siphash_tests());
 }
@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "hashmap.h"
+
+#include "tests-hashmap.h"
+
+#define NUMOF       (16U)
+
+/* a key of odd size, as e.g. an EUI-48 */
+typedef struct {
+    uint8_t addr[6];
+} mac_key_t;
+
+static uint32_t slots[HASHMAP_SLOTS_WORDS(NUMOF, sizeof(mac_key_t),
+                                          sizeof(uint32_t))];
+static uint8_t dist[NUMOF];
+static hashmap_t map;
+
+/* home slot given by the key, to provoke collisions */
+static uint32_t _hash_first(const uint8_t *key, size_t len, uint32_t seed)
+{
+    (void)len;
+    (void)seed;
+    return key[0];
+}
+
+static mac_key_t _key(uint8_t home, uint8_t id)
+{
+    mac_key_t key = { { home, id, 0xaa, 0xbb, 0xcc, 0xdd } };
+
+    return key;
+}
+
+static void set_up(void)
+{
+    hashmap_init(&map, slots, dist, NUMOF, sizeof(mac_key_t),
+                 sizeof(uint32_t), NULL, 0);
+}
+
+static void test_hashmap_put_get(void)
+{
+    for (unsigned i = 0; i < NUMOF; i++) {
+        mac_key_t key = _key(i * 3, i);
+        uint32_t val = i * 1000;
+
+        TEST_ASSERT_NOT_NULL(hashmap_put(&map, &key, &val));
+    }
+    TEST_ASSERT_EQUAL_INT(NUMOF, hashmap_len(&map));
+
+    for (unsigned i = 0; i < NUMOF; i++) {
+        mac_key_t key = _key(i * 3, i);
+        uint32_t *val = hashmap_get(&map, &key);
+
+        TEST_ASSERT_NOT_NULL(val);
+        TEST_ASSERT_EQUAL_INT(i * 1000, *val);
+    }
+
+    mac_key_t missing = _key(1, 1);
+    TEST_ASSERT_NULL(hashmap_get(&map, &missing));
+}
+
+static void test_hashmap_replace(void)
+{
+    mac_key_t key = _key(1, 2);
+    uint32_t val = 1;
+    uint32_t *stored;
+
+    hashmap_put(&map, &key, &val);
+    val = 2;
+    stored = hashmap_put(&map, &key, &val);
+    TEST_ASSERT_EQUAL_INT(2, *stored);
+    TEST_ASSERT_EQUAL_INT(1, hashmap_len(&map));
+
+    /* without a value, an existing value is kept */
+    stored = hashmap_put(&map, &key, NULL);
+    TEST_ASSERT_EQUAL_INT(2, *stored);
+
+    /* and a new value is zeroed */
+    key = _key(3, 4);
+    stored = hashmap_put(&map, &key, NULL);
+    TEST_ASSERT_EQUAL_INT(0, *stored);
+    TEST_ASSERT_EQUAL_INT(2, hashmap_len(&map));
+}
+
+static void test_hashmap_full(void)
+{
+    uint32_t val = 0;
+
+    for (unsigned i = 0; i < NUMOF; i++) {
+        mac_key_t key = _key(i, i);
+
+        TEST_ASSERT_NOT_NULL(hashmap_put(&map, &key, &val));
+    }
+    mac_key_t key = _key(NUMOF, NUMOF);
+    TEST_ASSERT_NULL(hashmap_put(&map, &key, &val));
+
+    /* existing keys can still be replaced */
+    key = _key(0, 0);
+    TEST_ASSERT_NOT_NULL(hashmap_put(&map, &key, &val));
+
+    hashmap_clear(&map);
+    TEST_ASSERT_EQUAL_INT(0, hashmap_len(&map));
+    TEST_ASSERT_NULL(hashmap_get(&map, &key));
+}
+
+static void test_hashmap_collisions(void)
+{
+    hashmap_init(&map, slots, dist, NUMOF, sizeof(mac_key_t),
+                 sizeof(uint32_t), _hash_first, 0);
+
+    /* runs across the end of the slots, and entries displaced by others */
+    static const uint8_t homes[] = { 14, 14, 15, 14, 0, 1, 15, 1, 3 };
+    for (unsigned i = 0; i < sizeof(homes); i++) {
+        mac_key_t key = _key(homes[i], i);
+        uint32_t val = i;
+
+        TEST_ASSERT_NOT_NULL(hashmap_put(&map, &key, &val));
+    }
+    for (unsigned i = 0; i < sizeof(homes); i++) {
+        mac_key_t key = _key(homes[i], i);
+        uint32_t *val = hashmap_get(&map, &key);
+
+        TEST_ASSERT_NOT_NULL(val);
+        TEST_ASSERT_EQUAL_INT(i, *val);
+    }
+
+    /* remove every other entry, the others must be found as before */
+    for (unsigned i = 0; i < sizeof(homes); i += 2) {
+        mac_key_t key = _key(homes[i], i);
+
+        TEST_ASSERT_EQUAL_INT(0, hashmap_remove(&map, &key));
+        TEST_ASSERT_EQUAL_INT(-ENOENT, hashmap_remove(&map, &key));
+    }
+    for (unsigned i = 0; i < sizeof(homes); i++) {
+        mac_key_t key = _key(homes[i], i);
+        uint32_t *val = hashmap_get(&map, &key);
+
+        if (i % 2) {
+            TEST_ASSERT_NOT_NULL(val);
+            TEST_ASSERT_EQUAL_INT(i, *val);
+        }
+        else {
+            TEST_ASSERT_NULL(val);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(sizeof(homes) / 2, hashmap_len(&map));
+}
+
+static void test_hashmap_iter(void)
+{
+    uint32_t seen = 0;
+    unsigned pos = 0;
+    const void *key;
+    uint32_t *val;
+
+    for (unsigned i = 0; i < 10; i++) {
+        mac_key_t k = _key(i, i);
+
+        hashmap_put(&map, &k, &i);
+    }
+    while ((val = hashmap_iter(&map, &pos, &key))) {
+        const mac_key_t *k = key;
+
+        TEST_ASSERT_EQUAL_INT(k->addr[1], *val);
+        seen |= 1UL << *val;
+    }
+    TEST_ASSERT_EQUAL_INT(0x3ff, seen);
+    TEST_ASSERT_NULL(hashmap_iter(&map, &pos, NULL));
+}
+
+static void test_hashmap_set(void)
+{
+    static uint32_t set_slots[HASHMAP_SLOTS_WORDS(NUMOF, sizeof(uint16_t), 0)];
+    uint16_t key = 0x1234;
+
+    hashmap_init(&map, set_slots, dist, NUMOF, sizeof(key), 0, NULL, 0);
+    TEST_ASSERT_NULL(hashmap_get(&map, &key));
+    TEST_ASSERT_NOT_NULL(hashmap_put(&map, &key, NULL));
+    TEST_ASSERT_NOT_NULL(hashmap_get(&map, &key));
+    TEST_ASSERT_EQUAL_INT(0, hashmap_remove(&map, &key));
+    TEST_ASSERT_NULL(hashmap_get(&map, &key));
+}
+
+static uint32_t _hash_zero(const uint8_t *key, size_t len, uint32_t seed)
+{
+    (void)key;
+    (void)len;
+    (void)seed;
+    return 0;
+}
+
+static void test_hashmap_large(void)
+{
+    static uint32_t big_slots[HASHMAP_SLOTS_WORDS(HASHMAP_NUMOF_MAX / 2,
+                                                  sizeof(uint16_t), 0)];
+    static uint8_t big_dist[HASHMAP_NUMOF_MAX / 2];
+    uint16_t key;
+
+    hashmap_init(&map, big_slots, big_dist, HASHMAP_NUMOF_MAX / 2,
+                 sizeof(key), 0, NULL, 0);
+    for (key = 0; key < HASHMAP_NUMOF_MAX / 2; key++) {
+        TEST_ASSERT_NOT_NULL(hashmap_put(&map, &key, NULL));
+    }
+    TEST_ASSERT_EQUAL_INT(HASHMAP_NUMOF_MAX / 2, hashmap_len(&map));
+    for (key = 0; key < HASHMAP_NUMOF_MAX / 2; key++) {
+        TEST_ASSERT_NOT_NULL(hashmap_get(&map, &key));
+    }
+
+    /* a run can not grow longer than the distances can count */
+    hashmap_init(&map, big_slots, big_dist, HASHMAP_NUMOF_MAX / 2,
+                 sizeof(key), 0, _hash_zero, 0);
+    for (key = 0; key < UINT8_MAX; key++) {
+        TEST_ASSERT_NOT_NULL(hashmap_put(&map, &key, NULL));
+    }
+    TEST_ASSERT_NULL(hashmap_put(&map, &key, NULL));
+    TEST_ASSERT_NULL(hashmap_get(&map, &key));
+    key = UINT8_MAX - 1;
+    TEST_ASSERT_NOT_NULL(hashmap_get(&map, &key));
+    TEST_ASSERT_EQUAL_INT(0, hashmap_remove(&map, &key));
+    TEST_ASSERT_NOT_NULL(hashmap_put(&map, &key, NULL));
+}
+
+Test *tests_hashmap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_hashmap_put_get),
+        new_TestFixture(test_hashmap_replace),
+        new_TestFixture(test_hashmap_full),
+        new_TestFixture(test_hashmap_collisions),
+        new_TestFixture(test_hashmap_iter),
+        new_TestFixture(test_hashmap_set),
+        new_TestFixture(test_hashmap_large),
+    };
+
+    EMB_UNIT_TESTCALLER(hashmap_tests, set_up, NULL, fixtures);
+
+    return (Test *)&hashmap_tests;
+}
+
+void tests_hashmap(void)
+{
+    TESTS_RUN(tests_hashmap_tests());
+}
+/** @} */
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,57 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__unaligned(void)
+{
+    /* source: https://tools.ietf.org/html/rfc1071#section-3 */
+    static const uint8_t data[] = {
+        0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7
+    };
+    /* long enough to also cover the word-wise summation */
+    uint32_t storage[(8 * sizeof(data)) / sizeof(uint32_t) + 1];
+    uint8_t *buf = (uint8_t *)storage;
+
+    for (unsigned offset = 0; offset < sizeof(uint32_t); offset++) {
+        for (unsigned i = 0; i < 8; i++) {
+            memcpy(&buf[offset + (i * sizeof(data))], data, sizeof(data));
+        }
+        TEST_ASSERT_EQUAL_INT(0xddf2, inet_csum(0, &buf[offset],
+                                                sizeof(data)));
+        /* 8 * 0xddf2 with end-around carry */
+        TEST_ASSERT_EQUAL_INT(0xef96, inet_csum(0, &buf[offset],
+                                                8 * sizeof(data)));
+        /* odd length and odd accumulated length */
+        TEST_ASSERT_EQUAL_INT(0xdcfb, inet_csum_slice(0, &buf[offset],
+                                                      sizeof(data) - 1, 0));
+        TEST_ASSERT_EQUAL_INT(0xf2dd, inet_csum_slice(0, &buf[offset],
+                                                      sizeof(data), 1));
+    }
+}
+
+static void test_inet_csum__update(void)
+{
+    /* IPv6 pseudo header and UDP header (no payload) */
+    uint8_t data[] = {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* IPv6 source */
+        0x5a, 0x6d, 0x8f, 0xff, 0xfe, 0x56, 0x30, 0x09,
+        0xff, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* IPv6 destination */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x11, /* length + next header */
+        0x22, 0x33, 0x16, 0x33, 0x00, 0x08, 0x00, 0x00, /* UDP header */
+    };
+    const uint8_t new_dst[] = {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xab, 0xcd,
+    };
+    uint16_t csum = ~inet_csum(0, data, sizeof(data));
+    uint16_t updated;
+
+    updated = inet_csum_update(csum, &data[16], new_dst, sizeof(new_dst));
+    memcpy(&data[16], new_dst, sizeof(new_dst));
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, data, sizeof(data)),
+                          updated);
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +228,8 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__unaligned),
+        new_TestFixture(test_inet_csum__update),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
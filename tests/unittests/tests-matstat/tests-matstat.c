@@ -272,6 +272,108 @@ static void test_matstat_accuracy(void)
     TEST_ASSERT_EQUAL_INT(12293, mean);
 }
 
+static void test_matstat_window(void)
+{
+    int32_t values[4];
+    matstat_window_t win;
+
+    matstat_window_init(&win, values, 4);
+    TEST_ASSERT_EQUAL_INT(0, matstat_window_mean(&win));
+    TEST_ASSERT(matstat_window_variance(&win) == 0);
+    TEST_ASSERT_EQUAL_INT(INT32_MAX, matstat_window_min(&win));
+    matstat_window_add(&win, 7);
+    TEST_ASSERT_EQUAL_INT(7, matstat_window_mean(&win));
+    TEST_ASSERT_EQUAL_INT(7, matstat_window_max(&win));
+
+    /* only 3, 4, 5 and 6 remain */
+    for (int32_t i = 1; i <= 6; i++) {
+        matstat_window_add(&win, (i == 1) ? -1000 : i);
+    }
+    TEST_ASSERT_EQUAL_INT(4, win.count);
+    TEST_ASSERT_EQUAL_INT(4, matstat_window_mean(&win));
+    /* 5 / 3 */
+    TEST_ASSERT(matstat_window_variance(&win) == 1);
+    TEST_ASSERT_EQUAL_INT(3, matstat_window_min(&win));
+    TEST_ASSERT_EQUAL_INT(6, matstat_window_max(&win));
+
+    for (int32_t i = 0; i < 4; i++) {
+        matstat_window_add(&win, -1000 * (i & 1));
+    }
+    TEST_ASSERT_EQUAL_INT(-500, matstat_window_mean(&win));
+    /* 4 * 500^2 / 3 */
+    TEST_ASSERT(matstat_window_variance(&win) == 333333);
+}
+
+static void test_matstat_window_large(void)
+{
+    int32_t values[16];
+    matstat_window_t win;
+
+    /* sums beyond 32 bit, variance 0 */
+    matstat_window_init(&win, values, 16);
+    for (unsigned i = 0; i < 100; i++) {
+        matstat_window_add(&win, -(1L << 28));
+    }
+    TEST_ASSERT_EQUAL_INT(-(1L << 28), matstat_window_mean(&win));
+    TEST_ASSERT(matstat_window_variance(&win) == 0);
+}
+
+static void test_matstat_hist(void)
+{
+    uint32_t buckets[MATSTAT_HIST_BUCKETS(16, 2)];
+    matstat_hist_t hist;
+
+    matstat_hist_init(&hist, buckets, MATSTAT_HIST_BUCKETS(16, 2), 2);
+    TEST_ASSERT_EQUAL_INT(60, hist.numof);
+    TEST_ASSERT_EQUAL_INT(0, matstat_hist_quantile(&hist, 500000));
+
+    /* exact below 8 */
+    for (uint32_t i = 0; i < 8; i++) {
+        matstat_hist_add(&hist, i);
+    }
+    TEST_ASSERT_EQUAL_INT(0, matstat_hist_quantile(&hist, 0));
+    TEST_ASSERT_EQUAL_INT(3, matstat_hist_quantile(&hist, 500000));
+    TEST_ASSERT_EQUAL_INT(4, matstat_hist_quantile(&hist, 500001));
+    TEST_ASSERT_EQUAL_INT(7, matstat_hist_quantile(&hist, 1000000));
+
+    /* 1000 falls into the bucket of 896 to 1023 */
+    matstat_hist_add(&hist, 1000);
+    TEST_ASSERT_EQUAL_INT(1023, matstat_hist_quantile(&hist, 1000000));
+    TEST_ASSERT_EQUAL_INT(7, matstat_hist_quantile(&hist, 888888));
+
+    /* beyond the last bucket */
+    matstat_hist_add(&hist, UINT32_MAX);
+    TEST_ASSERT_EQUAL_INT(10, hist.count);
+    TEST_ASSERT_EQUAL_INT(65535, matstat_hist_quantile(&hist, 1000000));
+
+    matstat_hist_clear(&hist);
+    TEST_ASSERT_EQUAL_INT(0, hist.count);
+    TEST_ASSERT_EQUAL_INT(0, matstat_hist_quantile(&hist, 1000000));
+}
+
+static void test_matstat_hist_error(void)
+{
+    uint32_t buckets[MATSTAT_HIST_BUCKETS(32, 3)];
+    uint32_t other[MATSTAT_HIST_BUCKETS(32, 3)];
+    matstat_hist_t hist, hist2;
+
+    matstat_hist_init(&hist, buckets, MATSTAT_HIST_BUCKETS(32, 3), 3);
+    matstat_hist_init(&hist2, other, MATSTAT_HIST_BUCKETS(32, 3), 3);
+    /* latencies of 1 to 1000 µs, in two histograms */
+    for (uint32_t i = 1; i <= 1000; i++) {
+        matstat_hist_add((i & 1) ? &hist : &hist2, i);
+    }
+    matstat_hist_merge(&hist, &hist2);
+    TEST_ASSERT_EQUAL_INT(1000, hist.count);
+
+    uint32_t p50 = matstat_hist_quantile(&hist, 500000);
+    uint32_t p99 = matstat_hist_quantile(&hist, 990000);
+    TEST_ASSERT((p50 >= 500) && (p50 < 500 + 500 / 8));
+    TEST_ASSERT((p99 >= 990) && (p99 < 990 + 990 / 8));
+    matstat_hist_add(&hist, UINT32_MAX);
+    TEST_ASSERT(matstat_hist_quantile(&hist, 1000000) == UINT32_MAX);
+}
+
 Test *tests_matstat_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -283,6 +385,10 @@ Test *tests_matstat_tests(void)
         new_TestFixture(test_matstat_merge_variance_regr1),
         new_TestFixture(test_matstat_accuracy),
         new_TestFixture(test_matstat_negative_variance),
+        new_TestFixture(test_matstat_window),
+        new_TestFixture(test_matstat_window_large),
+        new_TestFixture(test_matstat_hist),
+        new_TestFixture(test_matstat_hist_error),
     };
 
     EMB_UNIT_TESTCALLER(matstat_tests, NULL, NULL, fixtures);
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "msg_buf.h"
+#include "sched.h"
+
+#include "tests-msg_buf.h"
+
+#define CAPACITY    (13U)
+#define NUMOF       (3U)
+
+static MSG_BUF_POOL_DATA(_data, CAPACITY, NUMOF);
+static msg_buf_pool_t _pool;
+static unsigned _released;
+
+static void set_up(void)
+{
+    msg_buf_pool_init(&_pool, _data, CAPACITY, NUMOF);
+    _released = 0;
+}
+
+static void _count_release(msg_buf_t *buf)
+{
+    (void)buf;
+    _released++;
+}
+
+static void test_msg_buf_alloc__exhausted(void)
+{
+    msg_buf_t *bufs[NUMOF];
+
+    for (unsigned i = 0; i < NUMOF; i++) {
+        bufs[i] = msg_buf_alloc(&_pool);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+        TEST_ASSERT_EQUAL_INT(0, bufs[i]->size);
+        TEST_ASSERT_EQUAL_INT(CAPACITY, bufs[i]->capacity);
+        /* the payload is usable */
+        memset(bufs[i]->data, i, CAPACITY);
+    }
+    TEST_ASSERT_NULL(msg_buf_alloc(&_pool));
+    for (unsigned i = 0; i < NUMOF; i++) {
+        for (unsigned j = 0; j < CAPACITY; j++) {
+            TEST_ASSERT_EQUAL_INT(i, bufs[i]->data[j]);
+        }
+    }
+}
+
+static void test_msg_buf_release(void)
+{
+    msg_buf_t *buf;
+
+    for (unsigned i = 0; i < NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL(msg_buf_alloc(&_pool));
+    }
+    TEST_ASSERT_NULL(msg_buf_alloc(&_pool));
+    set_up();
+    buf = msg_buf_alloc(&_pool);
+    msg_buf_release(buf);
+    /* the buffer returned to the pool */
+    for (unsigned i = 0; i < NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL(msg_buf_alloc(&_pool));
+    }
+}
+
+static void test_msg_buf_init__release(void)
+{
+    uint8_t data[4];
+    msg_buf_t buf;
+
+    msg_buf_init(&buf, data, sizeof(data), _count_release, NULL);
+    TEST_ASSERT(buf.data == data);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), buf.size);
+    msg_buf_release(&buf);
+    TEST_ASSERT_EQUAL_INT(1, _released);
+    msg_buf_init(&buf, data, sizeof(data), NULL, NULL);
+    msg_buf_release(&buf);
+}
+
+static void test_msg_try_send_buf__undelivered(void)
+{
+    uint8_t data[4];
+    msg_buf_t buf;
+
+    msg_buf_init(&buf, data, sizeof(data), _count_release, NULL);
+    /* the thread running the tests has no message queue */
+    TEST_ASSERT_EQUAL_INT(0, msg_try_send_buf(sched_active_pid, 0x1234, &buf));
+    TEST_ASSERT_EQUAL_INT(1, _released);
+}
+
+static void test_msg_send_buf__invalid_target(void)
+{
+    msg_buf_t *buf = msg_buf_alloc(&_pool);
+
+    TEST_ASSERT_EQUAL_INT(-1, msg_send_buf(KERNEL_PID_LAST, 0x1234, buf));
+    /* the buffer returned to the pool */
+    for (unsigned i = 0; i < NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL(msg_buf_alloc(&_pool));
+    }
+}
+
+static Test *tests_msg_buf_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_msg_buf_alloc__exhausted),
+        new_TestFixture(test_msg_buf_release),
+        new_TestFixture(test_msg_buf_init__release),
+        new_TestFixture(test_msg_try_send_buf__undelivered),
+        new_TestFixture(test_msg_send_buf__invalid_target),
+    };
+
+    EMB_UNIT_TESTCALLER(msg_buf_tests, set_up, NULL, fixtures);
+
+    return (Test *)&msg_buf_tests;
+}
+
+void tests_msg_buf(void)
+{
+    TESTS_RUN(tests_msg_buf_tests());
+}
+/** @} */
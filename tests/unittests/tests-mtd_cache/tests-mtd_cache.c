@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+#include <errno.h>
+
+#include "embUnit.h"
+
+#include "mtd_cache.h"
+
+#include "tests-mtd_cache.h"
+
+#define SECTOR_COUNT    (4)
+#define PAGE_PER_SECTOR (4)
+#define PAGE_SIZE       (64)
+#define CACHE_NUMOF     (2)
+
+/* RAM based mtd counting the accesses */
+static uint8_t _memory[PAGE_PER_SECTOR * PAGE_SIZE * SECTOR_COUNT];
+static unsigned _reads;
+static unsigned _writes;
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+    memset(_memory, 0xff, sizeof(_memory));
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+    if (addr + size > sizeof(_memory)) {
+        return -EOVERFLOW;
+    }
+    _reads++;
+    memcpy(buff, _memory + addr, size);
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    (void)dev;
+    if ((addr + size > sizeof(_memory)) ||
+        (((addr % PAGE_SIZE) + size) > PAGE_SIZE)) {
+        return -EOVERFLOW;
+    }
+    _writes++;
+    memcpy(_memory + addr, buff, size);
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+    memset(_memory + addr, 0xff, size);
+    return 0;
+}
+
+static const mtd_desc_t _driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+};
+
+static mtd_dev_t _parent = {
+    .driver = &_driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static uint8_t _buf[CACHE_NUMOF * PAGE_SIZE];
+static mtd_cache_page_t _pages[CACHE_NUMOF];
+static mtd_cache_t _cache = {
+    .base = { .driver = &mtd_cache_driver },
+    .parent = &_parent,
+    .buf = _buf,
+    .pages = _pages,
+    .numof = CACHE_NUMOF,
+};
+
+static mtd_dev_t *dev = &_cache.base;
+
+static void set_up(void)
+{
+    _cache.read_ahead = 0;
+    mtd_init(dev);
+    _reads = 0;
+    _writes = 0;
+}
+
+static void test_mtd_cache_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT, dev->sector_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR, dev->pages_per_sector);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, dev->page_size);
+}
+
+static void test_mtd_cache_read_hit(void)
+{
+    uint8_t buf[8];
+
+    memcpy(_memory + 10, "ABCDEFGH", sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_read(dev, buf, 10, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, "ABCDEFGH", sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, _reads);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_read(dev, buf, 10, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, _reads);
+}
+
+static void test_mtd_cache_read_bypass(void)
+{
+    uint8_t buf[3 * PAGE_SIZE];
+
+    /* three uncached whole pages are read at once */
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_read(dev, buf, 0, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, _reads);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, _memory, sizeof(buf)));
+}
+
+static void test_mtd_cache_read_ahead(void)
+{
+    uint8_t buf[4];
+
+    _cache.read_ahead = 1;
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_read(dev, buf, 0, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(2, _reads);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf),
+                          mtd_read(dev, buf, PAGE_SIZE, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(2, _reads);
+}
+
+static void test_mtd_cache_write_back(void)
+{
+    uint8_t buf[8];
+
+    TEST_ASSERT_EQUAL_INT(4, mtd_write(dev, "ABCD", 4, 4));
+    TEST_ASSERT_EQUAL_INT(0, _writes);
+    TEST_ASSERT_EQUAL_INT(0xff, _memory[4]);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_read(dev, buf, 0, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf + 4, "ABCD", 4));
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_flush(dev));
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_memory + 4, "ABCD", 4));
+    /* clean pages are not written again */
+    TEST_ASSERT_EQUAL_INT(0, mtd_flush(dev));
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+}
+
+static void test_mtd_cache_evict(void)
+{
+    uint8_t buf[4];
+
+    TEST_ASSERT_EQUAL_INT(4, mtd_write(dev, "ABCD", 0, 4));
+    TEST_ASSERT_EQUAL_INT(4, mtd_read(dev, buf, PAGE_SIZE, 4));
+    TEST_ASSERT_EQUAL_INT(0, _writes);
+    /* page 0 is the least recently used one */
+    TEST_ASSERT_EQUAL_INT(4, mtd_read(dev, buf, 2 * PAGE_SIZE, 4));
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_memory, "ABCD", 4));
+}
+
+static void test_mtd_cache_erase(void)
+{
+    uint8_t buf[4];
+
+    TEST_ASSERT_EQUAL_INT(4, mtd_write(dev, "ABCD", 0, 4));
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(dev, 0, PAGE_PER_SECTOR * PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(4, mtd_read(dev, buf, 0, 4));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, "\xff\xff\xff\xff", 4));
+    TEST_ASSERT_EQUAL_INT(0, mtd_flush(dev));
+    TEST_ASSERT_EQUAL_INT(0, _writes);
+}
+
+static void test_mtd_cache_overflow(void)
+{
+    uint8_t buf[4] = { 0 };
+
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_write(dev, buf, PAGE_SIZE - 2, 4));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_read(dev, buf, sizeof(_memory) - 2,
+                                               4));
+}
+
+Test *tests_mtd_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_cache_init),
+        new_TestFixture(test_mtd_cache_read_hit),
+        new_TestFixture(test_mtd_cache_read_bypass),
+        new_TestFixture(test_mtd_cache_read_ahead),
+        new_TestFixture(test_mtd_cache_write_back),
+        new_TestFixture(test_mtd_cache_evict),
+        new_TestFixture(test_mtd_cache_erase),
+        new_TestFixture(test_mtd_cache_overflow),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_cache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mtd_cache_tests;
+}
+
+void tests_mtd_cache(void)
+{
+    TESTS_RUN(tests_mtd_cache_tests());
+}
+/** @} */
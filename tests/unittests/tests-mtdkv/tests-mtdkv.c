@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+#include <errno.h>
+
+#include "embUnit.h"
+
+#include "mtdkv.h"
+
+#include "tests-mtdkv.h"
+
+#define SECTOR_COUNT    (8)
+#define PAGE_PER_SECTOR (2)
+#define PAGE_SIZE       (64)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+
+/* RAM based mtd, keeping its contents over mtd_init() like flash does */
+static uint8_t _memory[SECTOR_SIZE * SECTOR_COUNT];
+/* number of writes until writing fails, 0 for never */
+static unsigned _fail_after;
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+    if (addr + size > sizeof(_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, _memory + addr, size);
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    const uint8_t *src = buff;
+
+    (void)dev;
+    if ((addr + size > sizeof(_memory)) ||
+        (((addr % PAGE_SIZE) + size) > PAGE_SIZE)) {
+        return -EOVERFLOW;
+    }
+    if (_fail_after && (--_fail_after == 0)) {
+        return -EIO;
+    }
+    /* programming clears bits only */
+    for (uint32_t i = 0; i < size; i++) {
+        _memory[addr + i] &= src[i];
+    }
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+    if ((addr % SECTOR_SIZE) || (size % SECTOR_SIZE) ||
+        (addr + size > sizeof(_memory))) {
+        return -EOVERFLOW;
+    }
+    memset(_memory + addr, 0xff, size);
+    return 0;
+}
+
+static const mtd_desc_t _driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+};
+
+static mtd_dev_t _dev = {
+    .driver = &_driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static mtdkv_t _kv;
+
+/* a value never stored if the key is not found */
+#define NOT_FOUND       (0xdeadbeef)
+
+static uint32_t _get_val(const char *key)
+{
+    uint32_t val;
+
+    if (mtdkv_get(&_kv, key, &val, sizeof(val)) != sizeof(val)) {
+        return NOT_FOUND;
+    }
+    return val;
+}
+
+static void _set_val(const char *key, uint32_t val)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_set(&_kv, key, &val, sizeof(val)));
+}
+
+static void set_up(void)
+{
+    memset(_memory, 0xff, sizeof(_memory));
+    _fail_after = 0;
+    mtdkv_init(&_kv, &_dev, 0, 2);
+}
+
+static void test_mtdkv_set_get(void)
+{
+    uint8_t big[MTDKV_VALUE_MAX + 1] = { 0 };
+    uint8_t small;
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtdkv_get(&_kv, "a", &small, 1));
+    _set_val("a", 1);
+    _set_val("b", 2);
+    TEST_ASSERT_EQUAL_INT(1, _get_val("a"));
+    TEST_ASSERT_EQUAL_INT(2, _get_val("b"));
+    _set_val("a", 3);
+    TEST_ASSERT_EQUAL_INT(3, _get_val("a"));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, mtdkv_get(&_kv, "a", &small, 1));
+
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_set(&_kv, "empty", &small, 0));
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_get(&_kv, "empty", &small, 1));
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtdkv_set(&_kv, "", &small, 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtdkv_set(&_kv, "a", big, sizeof(big)));
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          mtdkv_set(&_kv, "01234567890123456", &small, 1));
+}
+
+static void test_mtdkv_delete(void)
+{
+    uint32_t val;
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtdkv_delete(&_kv, "a"));
+    _set_val("a", 1);
+    _set_val("b", 2);
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_delete(&_kv, "a"));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtdkv_get(&_kv, "a", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtdkv_delete(&_kv, "a"));
+    TEST_ASSERT_EQUAL_INT(2, _get_val("b"));
+
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_init(&_kv, &_dev, 0, 2));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtdkv_get(&_kv, "a", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(2, _get_val("b"));
+    _set_val("a", 4);
+    TEST_ASSERT_EQUAL_INT(4, _get_val("a"));
+}
+
+static void test_mtdkv_remount(void)
+{
+    uint8_t buf[MTDKV_VALUE_MAX];
+
+    memset(buf, 0x42, sizeof(buf));
+    _set_val("a", 1);
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_set(&_kv, "long", buf, sizeof(buf)));
+    _set_val("a", 2);
+
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_init(&_kv, &_dev, 0, 2));
+    TEST_ASSERT_EQUAL_INT(2, _get_val("a"));
+    memset(buf, 0, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf),
+                          mtdkv_get(&_kv, "long", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0x42, buf[sizeof(buf) - 1]);
+}
+
+static void _wear(uint32_t numof)
+{
+    uint32_t val;
+
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_init(&_kv, &_dev, 0, numof));
+    _set_val("gone", 42);
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_delete(&_kv, "gone"));
+    _set_val("const", 7);
+    for (uint32_t i = 0; i < 200; i++) {
+        _set_val("x", i);
+        _set_val("y", ~i);
+        if ((i % 37) == 0) {
+            TEST_ASSERT_EQUAL_INT(0, mtdkv_init(&_kv, &_dev, 0, numof));
+        }
+        TEST_ASSERT_EQUAL_INT(i, _get_val("x"));
+        TEST_ASSERT_EQUAL_INT(~i, _get_val("y"));
+        TEST_ASSERT_EQUAL_INT(7, _get_val("const"));
+        TEST_ASSERT_EQUAL_INT(-ENOENT,
+                              mtdkv_get(&_kv, "gone", &val, sizeof(val)));
+    }
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_init(&_kv, &_dev, 0, numof));
+    TEST_ASSERT_EQUAL_INT(199, _get_val("x"));
+    TEST_ASSERT_EQUAL_INT(7, _get_val("const"));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtdkv_get(&_kv, "gone", &val, sizeof(val)));
+}
+
+static void test_mtdkv_wear(void)
+{
+    _wear(2);
+    memset(_memory, 0xff, sizeof(_memory));
+    _wear(3);
+    memset(_memory, 0xff, sizeof(_memory));
+    _wear(SECTOR_COUNT);
+}
+
+static void test_mtdkv_commit(void)
+{
+    uint32_t one = 1, two = 2, val;
+    mtdkv_update_t updates[] = {
+        { .key = "a", .value = &one, .len = sizeof(one) },
+        { .key = "b", .value = &two, .len = sizeof(two) },
+        { .key = "c" },
+    };
+
+    _set_val("c", 3);
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_commit(&_kv, updates, 3));
+    TEST_ASSERT_EQUAL_INT(1, _get_val("a"));
+    TEST_ASSERT_EQUAL_INT(2, _get_val("b"));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtdkv_get(&_kv, "c", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_init(&_kv, &_dev, 0, 2));
+    TEST_ASSERT_EQUAL_INT(2, _get_val("b"));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, mtdkv_get(&_kv, "c", &val, sizeof(val)));
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          mtdkv_commit(&_kv, updates, MTDKV_COMMIT_MAX + 1));
+}
+
+static void test_mtdkv_torn_commit(void)
+{
+    uint32_t one = 1, two = 2;
+    mtdkv_update_t updates[] = {
+        { .key = "a", .value = &one, .len = sizeof(one) },
+        { .key = "b", .value = &two, .len = sizeof(two) },
+    };
+
+    _set_val("a", 10);
+    _set_val("b", 20);
+    /* power lost while writing the second record */
+    _fail_after = 2;
+    TEST_ASSERT_EQUAL_INT(-EIO, mtdkv_commit(&_kv, updates, 2));
+    TEST_ASSERT_EQUAL_INT(10, _get_val("a"));
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_init(&_kv, &_dev, 0, 2));
+    TEST_ASSERT_EQUAL_INT(10, _get_val("a"));
+    TEST_ASSERT_EQUAL_INT(20, _get_val("b"));
+
+    /* the torn commit stays discarded after more updates */
+    _set_val("c", 30);
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_init(&_kv, &_dev, 0, 2));
+    TEST_ASSERT_EQUAL_INT(10, _get_val("a"));
+    TEST_ASSERT_EQUAL_INT(30, _get_val("c"));
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_commit(&_kv, updates, 2));
+    TEST_ASSERT_EQUAL_INT(1, _get_val("a"));
+}
+
+static void test_mtdkv_full(void)
+{
+    char key[] = "k00";
+    uint32_t val = 0;
+    unsigned i;
+
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_init(&_kv, &_dev, 0, SECTOR_COUNT));
+    for (i = 0; i < (MTDKV_INDEX_SIZE - 1); i++) {
+        key[1] = '0' + (i / 10);
+        key[2] = '0' + (i % 10);
+        _set_val(key, i);
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, mtdkv_set(&_kv, "new", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_init(&_kv, &_dev, 0, SECTOR_COUNT));
+    TEST_ASSERT_EQUAL_INT(17, _get_val("k17"));
+
+    /* two sectors hold two values of maximum length */
+    uint8_t buf[MTDKV_VALUE_MAX] = { 0 };
+    memset(_memory, 0xff, sizeof(_memory));
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_init(&_kv, &_dev, 0, 2));
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_set(&_kv, "a", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, mtdkv_set(&_kv, "b", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, mtdkv_set(&_kv, "a", buf, sizeof(buf)));
+}
+
+Test *tests_mtdkv_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtdkv_set_get),
+        new_TestFixture(test_mtdkv_delete),
+        new_TestFixture(test_mtdkv_remount),
+        new_TestFixture(test_mtdkv_wear),
+        new_TestFixture(test_mtdkv_commit),
+        new_TestFixture(test_mtdkv_torn_commit),
+        new_TestFixture(test_mtdkv_full),
+    };
+
+    EMB_UNIT_TESTCALLER(mtdkv_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mtdkv_tests;
+}
+
+void tests_mtdkv(void)
+{
+    TESTS_RUN(tests_mtdkv_tests());
+}
+/** @} */
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``mtdkv`` module
+ */
+#ifndef TESTS_MTDKV_H
+#define TESTS_MTDKV_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_mtdkv(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_MTDKV_H */
+/** @} */
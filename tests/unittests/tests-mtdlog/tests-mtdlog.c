@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+#include <errno.h>
+
+#include "embUnit.h"
+
+#include "mtdlog.h"
+
+#include "tests-mtdlog.h"
+
+#define SECTOR_COUNT    (4)
+#define PAGE_PER_SECTOR (2)
+#define PAGE_SIZE       (32)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+
+/* RAM based mtd, keeping its contents over mtd_init() like flash does */
+static uint8_t _memory[SECTOR_SIZE * SECTOR_COUNT];
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+    if (addr + size > sizeof(_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, _memory + addr, size);
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    const uint8_t *src = buff;
+
+    (void)dev;
+    if ((addr + size > sizeof(_memory)) ||
+        (((addr % PAGE_SIZE) + size) > PAGE_SIZE)) {
+        return -EOVERFLOW;
+    }
+    /* programming clears bits only */
+    for (uint32_t i = 0; i < size; i++) {
+        _memory[addr + i] &= src[i];
+    }
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+    if ((addr % SECTOR_SIZE) || (size % SECTOR_SIZE) ||
+        (addr + size > sizeof(_memory))) {
+        return -EOVERFLOW;
+    }
+    memset(_memory + addr, 0xff, size);
+    return 0;
+}
+
+static const mtd_desc_t _driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+};
+
+static mtd_dev_t _dev = {
+    .driver = &_driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static mtdlog_t _log;
+
+/* 12 byte records, three of them fit into a sector */
+static void _append(uint32_t val)
+{
+    uint32_t rec[3] = { val, ~val, val };
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_append(&_log, rec, sizeof(rec), NULL));
+}
+
+static int _read_val(mtdlog_cursor_t *cur, uint32_t *val)
+{
+    uint32_t rec[3];
+    int res = mtdlog_read(&_log, cur, rec, sizeof(rec));
+
+    if (res == sizeof(rec)) {
+        /* never the value of a record */
+        *val = (rec[0] == ~rec[1]) ? rec[0] : UINT32_MAX;
+    }
+    return res;
+}
+
+static void set_up(void)
+{
+    memset(_memory, 0xff, sizeof(_memory));
+    mtdlog_init(&_log, &_dev, 0, SECTOR_COUNT);
+}
+
+static void test_mtdlog_empty(void)
+{
+    mtdlog_cursor_t cur;
+    uint32_t val;
+
+    mtdlog_cursor_oldest(&_log, &cur);
+    TEST_ASSERT_EQUAL_INT(0, _read_val(&cur, &val));
+    mtdlog_cursor_newest(&_log, &cur);
+    TEST_ASSERT_EQUAL_INT(0, _read_val(&cur, &val));
+    /* the cursor picks up the first record */
+    _append(1);
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(1, val);
+}
+
+static void test_mtdlog_append_read(void)
+{
+    mtdlog_cursor_t cur;
+    uint32_t val;
+
+    for (uint32_t i = 0; i < 10; i++) {
+        _append(i);
+    }
+    mtdlog_cursor_oldest(&_log, &cur);
+    for (uint32_t i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+        TEST_ASSERT_EQUAL_INT(i, val);
+    }
+    TEST_ASSERT_EQUAL_INT(0, _read_val(&cur, &val));
+    _append(10);
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(10, val);
+}
+
+static void test_mtdlog_wrap(void)
+{
+    mtdlog_cursor_t cur;
+    uint32_t val;
+
+    mtdlog_cursor_oldest(&_log, &cur);
+    /* 50 records use 17 sectors, so the ring wraps several times */
+    for (uint32_t i = 0; i < 50; i++) {
+        _append(i);
+    }
+    /* the records of the first sectors were overwritten */
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, _read_val(&cur, &val));
+    /* the last 4 sectors hold 39 to 49 */
+    for (uint32_t i = 39; i < 50; i++) {
+        TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+        TEST_ASSERT_EQUAL_INT(i, val);
+    }
+    TEST_ASSERT_EQUAL_INT(0, _read_val(&cur, &val));
+}
+
+static void test_mtdlog_remount(void)
+{
+    mtdlog_cursor_t cur;
+    uint32_t val;
+
+    /* head in every possible sector, before and after wrapping */
+    for (uint32_t i = 0; i < 40; i++) {
+        _append(i);
+        TEST_ASSERT_EQUAL_INT(0, mtdlog_init(&_log, &_dev, 0, SECTOR_COUNT));
+    }
+    mtdlog_cursor_newest(&_log, &cur);
+    _append(40);
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(40, val);
+
+    mtdlog_cursor_oldest(&_log, &cur);
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(30, val);
+}
+
+static void test_mtdlog_torn_recycle(void)
+{
+    mtdlog_cursor_t cur;
+    uint32_t val;
+
+    /* sectors 0 to 3 full, power lost after erasing sector 0 again */
+    for (uint32_t i = 0; i < 12; i++) {
+        _append(i);
+    }
+    memset(_memory, 0xff, SECTOR_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_init(&_log, &_dev, 0, SECTOR_COUNT));
+    mtdlog_cursor_oldest(&_log, &cur);
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(3, val);
+
+    /* the same in the middle of the ring */
+    for (uint32_t i = 12; i < 20; i++) {
+        _append(i);
+    }
+    memset(&_memory[3 * SECTOR_SIZE], 0xff, SECTOR_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_init(&_log, &_dev, 0, SECTOR_COUNT));
+    mtdlog_cursor_oldest(&_log, &cur);
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(12, val);
+    _append(20);
+    while (_read_val(&cur, &val) > 0) {}
+    TEST_ASSERT_EQUAL_INT(20, val);
+}
+
+static void test_mtdlog_torn_record(void)
+{
+    mtdlog_cursor_t cur;
+    uint32_t val;
+
+    _append(0);
+    _append(1);
+    /* corrupt the data of the second record */
+    _memory[8 + 16 + 4] = 0;
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_init(&_log, &_dev, 0, SECTOR_COUNT));
+    _append(2);
+
+    mtdlog_cursor_oldest(&_log, &cur);
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(0, val);
+    /* appending continued in the next sector */
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(2, val);
+    TEST_ASSERT_EQUAL_INT(0, _read_val(&cur, &val));
+}
+
+static void test_mtdlog_limits(void)
+{
+    mtdlog_cursor_t cur;
+    uint8_t buf[SECTOR_SIZE];
+
+    memset(buf, 0x42, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(-EMSGSIZE, mtdlog_append(&_log, buf, SECTOR_SIZE - 11, NULL));
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_append(&_log, buf, SECTOR_SIZE - 12, NULL));
+
+    mtdlog_cursor_oldest(&_log, &cur);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, mtdlog_read(&_log, &cur, buf, 8));
+    TEST_ASSERT_EQUAL_INT(SECTOR_SIZE - 12,
+                          mtdlog_read(&_log, &cur, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0x42, buf[SECTOR_SIZE - 13]);
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtdlog_init(&_log, &_dev, 1, SECTOR_COUNT));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtdlog_init(&_log, &_dev, 0, 1));
+}
+
+static void test_mtdlog_keep_drop(void)
+{
+    mtdlog_cursor_t cur, pos;
+    uint32_t rec[3] = { 7, ~7, 7 };
+    uint32_t val;
+
+    _log.keep = true;
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT, mtdlog_sectors_free(&_log));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtdlog_drop_oldest(&_log));
+    for (uint32_t i = 0; i < 12; i++) {
+        _append(i);
+    }
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_sectors_free(&_log));
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, mtdlog_append(&_log, rec, sizeof(rec), NULL));
+
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_drop_oldest(&_log));
+    TEST_ASSERT_EQUAL_INT(1, mtdlog_sectors_free(&_log));
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_append(&_log, rec, sizeof(rec), &pos));
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&pos, &val));
+    TEST_ASSERT_EQUAL_INT(7, val);
+
+    mtdlog_cursor_oldest(&_log, &cur);
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(3, val);
+
+    /* sealing starts a new sector */
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_drop_oldest(&_log));
+    mtdlog_seal(&_log);
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_append(&_log, rec, sizeof(rec), &pos));
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_sectors_free(&_log));
+
+    /* dropped sectors show up again after mounting */
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_init(&_log, &_dev, 0, SECTOR_COUNT));
+    mtdlog_cursor_oldest(&_log, &cur);
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(6, val);
+}
+
+static void test_mtdlog_erase(void)
+{
+    mtdlog_cursor_t cur;
+    uint32_t val;
+
+    _append(0);
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_erase(&_log));
+    mtdlog_cursor_oldest(&_log, &cur);
+    TEST_ASSERT_EQUAL_INT(0, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(0, mtdlog_init(&_log, &_dev, 0, SECTOR_COUNT));
+    _append(1);
+    TEST_ASSERT_EQUAL_INT(12, _read_val(&cur, &val));
+    TEST_ASSERT_EQUAL_INT(1, val);
+}
+
+Test *tests_mtdlog_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtdlog_empty),
+        new_TestFixture(test_mtdlog_append_read),
+        new_TestFixture(test_mtdlog_wrap),
+        new_TestFixture(test_mtdlog_remount),
+        new_TestFixture(test_mtdlog_torn_recycle),
+        new_TestFixture(test_mtdlog_torn_record),
+        new_TestFixture(test_mtdlog_limits),
+        new_TestFixture(test_mtdlog_keep_drop),
+        new_TestFixture(test_mtdlog_erase),
+    };
+
+    EMB_UNIT_TESTCALLER(mtdlog_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mtdlog_tests;
+}
+
+void tests_mtdlog(void)
+{
+    TESTS_RUN(tests_mtdlog_tests());
+}
+/** @} */
@@ -155,6 +155,107 @@ static void test_nanocoap__get_multi_path(void)
     TEST_ASSERT_EQUAL_STRING((char *)path, (char *)uri);
 }
 
+/*
+ * Builds on get_multi_path test, to test comparing the path in place.
+ */
+static void test_nanocoap__uri_path_cmp(void)
+{
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+    uint16_t msgid = 0xABCD;
+    uint8_t token[2] = {0xDA, 0xEC};
+    char path[] = "/ab/cde";
+
+    size_t len = coap_build_hdr((coap_hdr_t *)&buf[0], COAP_TYPE_NON,
+                                &token[0], 2, COAP_METHOD_GET, msgid);
+
+    coap_pkt_init(&pkt, &buf[0], sizeof(buf), len);
+
+    /* root path without URI_PATH options */
+    TEST_ASSERT_EQUAL_INT(0, coap_uri_path_cmp(&pkt, "/"));
+    TEST_ASSERT(coap_uri_path_cmp(&pkt, "/a") < 0);
+
+    coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, &path[0], '/');
+
+    TEST_ASSERT_EQUAL_INT(0, coap_uri_path_cmp(&pkt, "/ab/cde"));
+    TEST_ASSERT(coap_uri_path_cmp(&pkt, "/ab/cdf") < 0);
+    TEST_ASSERT(coap_uri_path_cmp(&pkt, "/ab/cde/f") < 0);
+    TEST_ASSERT(coap_uri_path_cmp(&pkt, "/ab/cd") > 0);
+    TEST_ASSERT(coap_uri_path_cmp(&pkt, "/ab") > 0);
+    TEST_ASSERT(coap_uri_path_cmp(&pkt, "/abc") < 0);
+    TEST_ASSERT(coap_uri_path_cmp(&pkt, "/aa/cde") > 0);
+}
+
+/*
+ * Builds on get_multi_path test, to test the option index of a parsed packet.
+ */
+static void test_nanocoap__parse_option_index(void)
+{
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+    uint16_t msgid = 0xABCD;
+    uint8_t token[2] = {0xDA, 0xEC};
+    char path[] = "/a/bc/d";
+    char qs[] = "x=1";
+
+    size_t len = coap_build_hdr((coap_hdr_t *)&buf[0], COAP_TYPE_NON,
+                                &token[0], 2, COAP_METHOD_GET, msgid);
+
+    coap_pkt_init(&pkt, &buf[0], sizeof(buf), len);
+    coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, &path[0], '/');
+    coap_opt_add_uint(&pkt, COAP_OPT_CONTENT_FORMAT, COAP_FORMAT_JSON);
+    coap_opt_add_string(&pkt, COAP_OPT_URI_QUERY, &qs[0], '&');
+    len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, &buf[0], len));
+    /* each Uri-Path segment is indexed */
+    TEST_ASSERT_EQUAL_INT(5, pkt.options_len);
+    TEST_ASSERT_EQUAL_INT(COAP_FORMAT_JSON, coap_get_content_type(&pkt));
+
+    char uri[10] = {0};
+    coap_get_uri_path(&pkt, (uint8_t *)&uri[0]);
+    TEST_ASSERT_EQUAL_STRING((char *)path, (char *)uri);
+    coap_get_uri_query(&pkt, (uint8_t *)&uri[0]);
+    TEST_ASSERT_EQUAL_STRING("&x=1", (char *)uri);
+
+    /* a packet with more options than can be indexed is rejected */
+    len = coap_build_hdr((coap_hdr_t *)&buf[0], COAP_TYPE_NON,
+                         &token[0], 2, COAP_METHOD_GET, msgid);
+    memset(&buf[len], 0, NANOCOAP_NOPTS_MAX + 1);
+    len += NANOCOAP_NOPTS_MAX + 1;
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, coap_parse(&pkt, &buf[0], len));
+}
+
+/*
+ * Adds and reads an opaque option and a uint option after it.
+ */
+static void test_nanocoap__opaque_option(void)
+{
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+    uint8_t etag[4] = {0x01, 0x02, 0x03, 0x04};
+    uint8_t *val;
+    uint32_t max_age = 0;
+
+    size_t len = coap_build_hdr((coap_hdr_t *)&buf[0], COAP_TYPE_NON, NULL, 0,
+                                COAP_CODE_CONTENT, 0xABCD);
+
+    coap_pkt_init(&pkt, &buf[0], sizeof(buf), len);
+    coap_opt_add_opaque(&pkt, COAP_OPT_ETAG, &etag[0], sizeof(etag));
+    coap_opt_add_uint(&pkt, COAP_OPT_MAX_AGE, 300);
+    len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, &buf[0], len));
+    TEST_ASSERT_EQUAL_INT(sizeof(etag),
+                          coap_opt_get_opaque(&pkt, COAP_OPT_ETAG, &val));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&etag[0], val, sizeof(etag)));
+    TEST_ASSERT_EQUAL_INT(0, coap_get_option_uint(&pkt, COAP_OPT_MAX_AGE,
+                                                  &max_age));
+    TEST_ASSERT_EQUAL_INT(300, max_age);
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          coap_opt_get_opaque(&pkt, COAP_OPT_PROXY_URI, &val));
+}
+
 /*
  * Builds on get_req test, to test path with trailing slash.
  */
@@ -322,8 +423,13 @@ static void test_nanocoap__get_multi_query(void)
     /* skip initial '&' from coap_get_uri_query() */
     TEST_ASSERT_EQUAL_STRING((char *)qs, &query[1]);
 
-    /* overwrite query to test buffer-based put */
-    coap_opt_put_uri_query(query_pos, COAP_OPT_URI_PATH, qs);
+    /* overwrite query to test buffer-based put; options are indexed when
+     * added, so the put must reproduce the encoding byte by byte */
+    uint8_t encoded[sizeof(qs) + 2];
+    memcpy(&encoded[0], query_pos, query_opt_len);
+    len = coap_opt_put_uri_query(query_pos, 0, qs);
+    TEST_ASSERT_EQUAL_INT(query_opt_len, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&encoded[0], query_pos, query_opt_len));
     coap_get_uri_query(&pkt, (uint8_t *)&query[0]);
     /* skip initial '&' from coap_get_uri_query() */
     TEST_ASSERT_EQUAL_STRING((char *)qs, &query[1]);
@@ -433,6 +539,186 @@ static void test_nanocoap__server_reply_simple_con(void)
     TEST_ASSERT_EQUAL_INT(COAP_TYPE_ACK, coap_get_type(&pkt));
 }
 
+/*
+ * Resource for the block-wise streaming tests below.
+ */
+static uint8_t _stream_res[100];
+static size_t _stream_res_len;
+
+static ssize_t _stream_read(void *arg, size_t offset, void *buf, size_t len)
+{
+    (void)arg;
+    if (offset >= sizeof(_stream_res)) {
+        return 0;
+    }
+    if (len > sizeof(_stream_res) - offset) {
+        len = sizeof(_stream_res) - offset;
+    }
+    memcpy(buf, &_stream_res[offset], len);
+    return len;
+}
+
+static ssize_t _stream_write(void *arg, size_t offset, const void *buf,
+                             size_t len, bool more)
+{
+    (void)more;
+    if (offset + len > sizeof(_stream_res)) {
+        return -ENOSPC;
+    }
+    memcpy(&_stream_res[offset], buf, len);
+    _stream_res_len = offset + len;
+    *(bool *)arg = more;
+    return len;
+}
+
+/*
+ * Helper for the block-wise streaming tests. Builds a request with a block
+ * option and optional payload.
+ */
+static size_t _build_block_req(uint8_t *buf, unsigned method, uint16_t optnum,
+                               uint32_t blkopt, const uint8_t *payload,
+                               size_t payload_len)
+{
+    coap_pkt_t pkt;
+    uint8_t token[2] = {0xDA, 0xEC};
+
+    size_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON,
+                                &token[0], 2, method, 0xABCD);
+    coap_pkt_init(&pkt, buf, _BUF_SIZE, len);
+    coap_opt_add_string(&pkt, COAP_OPT_URI_PATH, "/file", '/');
+    coap_opt_add_uint(&pkt, optnum, blkopt);
+    len = coap_opt_finish(&pkt, payload_len ? COAP_OPT_FINISH_PAYLOAD
+                                            : COAP_OPT_FINISH_NONE);
+    if (payload_len) {
+        memcpy(pkt.payload, payload, payload_len);
+    }
+
+    return len + payload_len;
+}
+
+/*
+ * Server reads only the requested block of a resource.
+ */
+static void test_nanocoap__block2_stream(void)
+{
+    uint8_t req[_BUF_SIZE];
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+    coap_block1_t block2;
+
+    for (unsigned i = 0; i < sizeof(_stream_res); i++) {
+        _stream_res[i] = i;
+    }
+
+    /* block 1 of size 32 */
+    size_t len = _build_block_req(req, COAP_METHOD_GET, COAP_OPT_BLOCK2,
+                                  (1 << 4) | 1, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, req, len));
+    ssize_t res = coap_block2_reply_stream(&pkt, COAP_CODE_205, buf, sizeof(buf),
+                                           COAP_FORMAT_OCTET, _stream_read, NULL);
+    TEST_ASSERT(res > 0);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_205, coap_get_code_raw(&pkt));
+    TEST_ASSERT_EQUAL_INT(COAP_FORMAT_OCTET, coap_get_content_type(&pkt));
+    TEST_ASSERT_EQUAL_INT(1, coap_get_block2(&pkt, &block2));
+    TEST_ASSERT_EQUAL_INT(1, block2.blknum);
+    TEST_ASSERT_EQUAL_INT(1, block2.szx);
+    TEST_ASSERT_EQUAL_INT(1, block2.more);
+    TEST_ASSERT_EQUAL_INT(32, pkt.payload_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pkt.payload, &_stream_res[32], 32));
+
+    /* last block */
+    len = _build_block_req(req, COAP_METHOD_GET, COAP_OPT_BLOCK2,
+                           (3 << 4) | 1, NULL, 0);
+    coap_parse(&pkt, req, len);
+    res = coap_block2_reply_stream(&pkt, COAP_CODE_205, buf, sizeof(buf),
+                                   COAP_FORMAT_OCTET, _stream_read, NULL);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT_EQUAL_INT(1, coap_get_block2(&pkt, &block2));
+    TEST_ASSERT_EQUAL_INT(3, block2.blknum);
+    TEST_ASSERT_EQUAL_INT(0, block2.more);
+    TEST_ASSERT_EQUAL_INT(4, pkt.payload_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pkt.payload, &_stream_res[96], 4));
+
+    /* block size reduced to fit the buffer, offset preserved */
+    len = _build_block_req(req, COAP_METHOD_GET, COAP_OPT_BLOCK2,
+                           (0 << 4) | 3, NULL, 0);
+    coap_parse(&pkt, req, len);
+    res = coap_block2_reply_stream(&pkt, COAP_CODE_205, buf, sizeof(buf),
+                                   COAP_FORMAT_OCTET, _stream_read, NULL);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT_EQUAL_INT(1, coap_get_block2(&pkt, &block2));
+    TEST_ASSERT_EQUAL_INT(2, block2.szx);
+    TEST_ASSERT_EQUAL_INT(0, block2.blknum);
+    TEST_ASSERT_EQUAL_INT(1, block2.more);
+    TEST_ASSERT_EQUAL_INT(64, pkt.payload_len);
+
+    /* beyond the end of the resource */
+    len = _build_block_req(req, COAP_METHOD_GET, COAP_OPT_BLOCK2,
+                           (4 << 4) | 1, NULL, 0);
+    coap_parse(&pkt, req, len);
+    res = coap_block2_reply_stream(&pkt, COAP_CODE_205, buf, sizeof(buf),
+                                   COAP_FORMAT_OCTET, _stream_read, NULL);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_BAD_OPTION, coap_get_code_raw(&pkt));
+}
+
+/*
+ * Server passes each block1 payload at its offset, replying in place.
+ */
+static void test_nanocoap__block1_stream(void)
+{
+    uint8_t buf[_BUF_SIZE];
+    uint8_t data[32];
+    coap_pkt_t pkt;
+    coap_block1_t block1;
+    bool more = false;
+
+    memset(_stream_res, 0, sizeof(_stream_res));
+    _stream_res_len = 0;
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        data[i] = 0x80 | i;
+    }
+
+    /* block 2 of size 32, more to follow */
+    size_t len = _build_block_req(buf, COAP_METHOD_PUT, COAP_OPT_BLOCK1,
+                                  (2 << 4) | 0x8 | 1, data, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, len));
+    ssize_t res = coap_block1_handle_stream(&pkt, COAP_CODE_204, buf, sizeof(buf),
+                                            _stream_write, &more);
+    TEST_ASSERT_EQUAL_INT(96, _stream_res_len);
+    TEST_ASSERT(more);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_stream_res[64], data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_231, coap_get_code_raw(&pkt));
+    TEST_ASSERT_EQUAL_INT(1, coap_get_block1(&pkt, &block1));
+    TEST_ASSERT_EQUAL_INT(2, block1.blknum);
+    TEST_ASSERT_EQUAL_INT(1, block1.more);
+
+    /* last block */
+    len = _build_block_req(buf, COAP_METHOD_PUT, COAP_OPT_BLOCK1,
+                           (3 << 4) | 1, data, 4);
+    coap_parse(&pkt, buf, len);
+    res = coap_block1_handle_stream(&pkt, COAP_CODE_204, buf, sizeof(buf),
+                                    _stream_write, &more);
+    TEST_ASSERT_EQUAL_INT(100, _stream_res_len);
+    TEST_ASSERT(!more);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_204, coap_get_code_raw(&pkt));
+    TEST_ASSERT_EQUAL_INT(1, coap_get_block1(&pkt, &block1));
+    TEST_ASSERT_EQUAL_INT(0, block1.more);
+
+    /* resource does not fit */
+    len = _build_block_req(buf, COAP_METHOD_PUT, COAP_OPT_BLOCK1,
+                           (4 << 4) | 1, data, 4);
+    coap_parse(&pkt, buf, len);
+    res = coap_block1_handle_stream(&pkt, COAP_CODE_204, buf, sizeof(buf),
+                                    _stream_write, &more);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_REQUEST_ENTITY_TOO_LARGE,
+                          coap_get_code_raw(&pkt));
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -440,6 +726,9 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__get_req),
         new_TestFixture(test_nanocoap__put_req),
         new_TestFixture(test_nanocoap__get_multi_path),
+        new_TestFixture(test_nanocoap__uri_path_cmp),
+        new_TestFixture(test_nanocoap__parse_option_index),
+        new_TestFixture(test_nanocoap__opaque_option),
         new_TestFixture(test_nanocoap__get_path_trailing_slash),
         new_TestFixture(test_nanocoap__get_root_path),
         new_TestFixture(test_nanocoap__get_max_path),
@@ -450,6 +739,8 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__server_reply_simple),
         new_TestFixture(test_nanocoap__server_get_req_con),
         new_TestFixture(test_nanocoap__server_reply_simple_con),
+        new_TestFixture(test_nanocoap__block2_stream),
+        new_TestFixture(test_nanocoap__block1_stream),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
@@ -139,6 +139,43 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_lookup__many_ctxs(void)
+{
+    gnrc_netreg_entry_t many[GNRC_NETREG_HASH_SIZE + 2];
+    gnrc_netreg_entry_t *res;
+
+    /* one more than buckets, so at least one bucket holds 2 demux contexts */
+    for (unsigned i = 0; i < (GNRC_NETREG_HASH_SIZE + 1); i++) {
+        gnrc_netreg_entry_init_pid(&many[i], TEST_UINT16 + i, TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &many[i]));
+    }
+    /* second listener for the first demux context */
+    gnrc_netreg_entry_init_pid(&many[GNRC_NETREG_HASH_SIZE + 1], TEST_UINT16,
+                               TEST_UINT8 + 1);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                  &many[GNRC_NETREG_HASH_SIZE + 1]));
+    for (unsigned i = 0; i < (GNRC_NETREG_HASH_SIZE + 1); i++) {
+        TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                       TEST_UINT16 + i)));
+        TEST_ASSERT_EQUAL_INT(TEST_UINT16 + i, res->demux_ctx);
+        TEST_ASSERT_EQUAL_INT((i == 0) ? 2 : 1,
+                              gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16 + i));
+    }
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                        TEST_UINT16 + GNRC_NETREG_HASH_SIZE + 1));
+    res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16);
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_getnext(res)));
+    TEST_ASSERT_EQUAL_INT(TEST_UINT16, res->demux_ctx);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    for (unsigned i = 0; i < (GNRC_NETREG_HASH_SIZE + 2); i++) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many[i]);
+    }
+    for (unsigned i = 0; i < (GNRC_NETREG_HASH_SIZE + 1); i++) {
+        TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + i));
+    }
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +192,7 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_lookup__many_ctxs),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
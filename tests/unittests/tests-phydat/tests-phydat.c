@@ -7,6 +7,8 @@
  * directory for more details.
  */
 
+#include <string.h>
+
 #include "embUnit.h"
 #include "tests-phydat.h"
 
@@ -114,10 +116,38 @@ static void test_phydat_fit(void)
     }
 }
 
+static void test_phydat_to_cbor(void)
+{
+    /* {"v": [4([-1, 215])], "u": "°C"} */
+    static const uint8_t temp[] = {
+        0xa2, 0x61, 0x76, 0x81, 0xc4, 0x82, 0x20, 0x18, 0xd7,
+        0x61, 0x75, 0x63, 0xc2, 0xb0, 0x43,
+    };
+    /* {"v": [1, -2, 300]} */
+    static const uint8_t accel[] = {
+        0xa1, 0x61, 0x76, 0x83, 0x01, 0x21, 0x19, 0x01, 0x2c,
+    };
+    uint8_t buf[16];
+    cbor_enc_t enc;
+    phydat_t dat = { .val = { 215 }, .unit = UNIT_TEMP_C, .scale = -1 };
+
+    cbor_enc_init(&enc, buf, sizeof(buf));
+    phydat_to_cbor(&dat, 1, &enc);
+    TEST_ASSERT_EQUAL_INT(sizeof(temp), cbor_enc_len(&enc));
+    TEST_ASSERT(memcmp(temp, buf, sizeof(temp)) == 0);
+
+    dat = (phydat_t){ .val = { 1, -2, 300 }, .unit = UNIT_UNDEF, .scale = 0 };
+    cbor_enc_init(&enc, buf, sizeof(buf));
+    phydat_to_cbor(&dat, 3, &enc);
+    TEST_ASSERT_EQUAL_INT(sizeof(accel), cbor_enc_len(&enc));
+    TEST_ASSERT(memcmp(accel, buf, sizeof(accel)) == 0);
+}
+
 Test *tests_phydat_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_phydat_fit),
+        new_TestFixture(test_phydat_to_cbor),
     };
 
     EMB_UNIT_TESTCALLER(phydat_tests, NULL, NULL, fixtures);
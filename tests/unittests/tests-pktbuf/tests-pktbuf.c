@@ -321,7 +321,8 @@ static void test_pktbuf_mark__pkt_NOT_NULL__size_greater_than_pkt_size(void)
 
 static void test_pktbuf_mark__pkt_NOT_NULL__pkt_data_NULL(void)
 {
-    gnrc_pktsnip_t pkt = { NULL, NULL, sizeof(TEST_STRING16), 1, GNRC_NETTYPE_TEST };
+    gnrc_pktsnip_t pkt = { .size = sizeof(TEST_STRING16), .users = 1,
+                           .type = GNRC_NETTYPE_TEST };
 
     TEST_ASSERT_NULL(gnrc_pktbuf_mark(&pkt, sizeof(TEST_STRING16) - 1,
                                       GNRC_NETTYPE_TEST));
@@ -576,6 +577,34 @@ static void test_pktbuf_realloc_data__nomemenough(void)
     TEST_ASSERT_EQUAL_INT(1, pkt1->users);
 }
 
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
+static void test_pktbuf_realloc_data__grow_in_place(void)
+{
+    gnrc_pktsnip_t *pkt1, *pkt2;
+    void *data;
+
+    pkt1 = gnrc_pktbuf_add(NULL, TEST_STRING8, sizeof(TEST_STRING8), GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt1);
+    data = pkt1->data;
+
+    /* space behind pkt1->data is unused, so the chunk can just be extended */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt1, 200));
+    TEST_ASSERT(data == pkt1->data);
+    TEST_ASSERT_EQUAL_INT(200, pkt1->size);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING8, pkt1->data);
+
+    pkt2 = gnrc_pktbuf_add(NULL, NULL, 4, GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt2);
+    TEST_ASSERT(((uint8_t *)pkt2) >= (((uint8_t *)pkt1->data) + 200));
+
+    gnrc_pktbuf_release(pkt1);
+    gnrc_pktbuf_release(pkt2);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif
+
 static void test_pktbuf_realloc_data__alignment(void)
 {
     gnrc_pktsnip_t *pkt1, *pkt2, *pkt3;
@@ -658,10 +687,16 @@ static void test_pktbuf_merge_data__memfull(void)
     gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, (GNRC_PKTBUF_SIZE / 4),
                                           GNRC_NETTYPE_TEST);
 
+    gnrc_pktsnip_t *blocker;
+
     pkt = gnrc_pktbuf_add(pkt, NULL, (GNRC_PKTBUF_SIZE / 4) + 1,
                           GNRC_NETTYPE_TEST);
+    /* occupy space behind pkt->data, so it can't be extended in place */
+    blocker = gnrc_pktbuf_add(NULL, NULL, (GNRC_PKTBUF_SIZE / 4), GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(blocker);
     TEST_ASSERT_EQUAL_INT(ENOMEM, gnrc_pktbuf_merge(pkt));
     gnrc_pktbuf_release(pkt);
+    gnrc_pktbuf_release(blocker);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
@@ -707,7 +742,8 @@ static void test_pktbuf_hold__pkt_null(void)
 
 static void test_pktbuf_hold__pkt_external(void)
 {
-    gnrc_pktsnip_t pkt = { NULL, TEST_STRING8, sizeof(TEST_STRING8), 1, GNRC_NETTYPE_TEST };
+    gnrc_pktsnip_t pkt = { .data = TEST_STRING8, .size = sizeof(TEST_STRING8),
+                           .users = 1, .type = GNRC_NETTYPE_TEST };
 
     gnrc_pktbuf_hold(&pkt, 1);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
@@ -901,6 +937,103 @@ static void test_pktbuf_reverse_snips__success(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+static void test_pktbuf_quota__ctrl_reserve(void)
+{
+    gnrc_pktsnip_t *ctrl, *pkt;
+    const size_t ctrl_size = 16;
+    const size_t reserve = GNRC_PKTBUF_SIZE / 8;
+    const size_t fill_size = GNRC_PKTBUF_SIZE - reserve -
+                             (2 * sizeof(gnrc_pktsnip_t)) - ctrl_size;
+
+    gnrc_pktbuf_set_reserve(reserve);
+    ctrl = gnrc_pktbuf_add(NULL, NULL, ctrl_size, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(ctrl);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_set_class(ctrl,
+                                                   GNRC_PKTBUF_CLASS_CTRL));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_OTHER));
+    gnrc_pktbuf_set_quota(GNRC_PKTBUF_CLASS_OTHER, GNRC_PKTBUF_SIZE);
+    pkt = gnrc_pktbuf_add(NULL, NULL, fill_size, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* the rest is reserved for the control plane */
+    TEST_ASSERT(!gnrc_pktbuf_admit(GNRC_PKTBUF_CLASS_OTHER, 1));
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, 1, GNRC_NETTYPE_UNDEF));
+    TEST_ASSERT(gnrc_pktbuf_admit(GNRC_PKTBUF_CLASS_CTRL, 1));
+    /* new snips in front of a control packet are control packets too */
+    ctrl = gnrc_pktbuf_add(ctrl, NULL, ctrl_size, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(ctrl);
+    TEST_ASSERT_EQUAL_INT(2 * (sizeof(gnrc_pktsnip_t) + ctrl_size),
+                          gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_CTRL));
+    /* control packets keep their class */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_set_class(ctrl,
+                                                   GNRC_PKTBUF_CLASS_TX));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_TX));
+    gnrc_pktbuf_release(ctrl);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_CTRL));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_OTHER));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    gnrc_pktbuf_set_quota(GNRC_PKTBUF_CLASS_OTHER, GNRC_PKTBUF_QUOTA_OTHER);
+    gnrc_pktbuf_set_reserve(GNRC_PKTBUF_CTRL_RESERVE);
+}
+
+static void test_pktbuf_quota__set_class(void)
+{
+    gnrc_pktsnip_t *pkt;
+    const size_t bytes = sizeof(gnrc_pktsnip_t) + 64;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, 64, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(bytes, gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_OTHER));
+    gnrc_pktbuf_set_quota(GNRC_PKTBUF_CLASS_SOCK, bytes - 1);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          gnrc_pktbuf_set_class(pkt, GNRC_PKTBUF_CLASS_SOCK));
+    TEST_ASSERT_EQUAL_INT(bytes, gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_OTHER));
+    TEST_ASSERT(!gnrc_pktbuf_admit(GNRC_PKTBUF_CLASS_SOCK, 64));
+    gnrc_pktbuf_set_quota(GNRC_PKTBUF_CLASS_SOCK, bytes);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_set_class(pkt,
+                                                   GNRC_PKTBUF_CLASS_SOCK));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_OTHER));
+    TEST_ASSERT_EQUAL_INT(bytes, gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_SOCK));
+    /* in place operations can't exceed the quota either */
+    TEST_ASSERT_EQUAL_INT(ENOMEM, gnrc_pktbuf_realloc_data(pkt, 65));
+    TEST_ASSERT_NULL(gnrc_pktbuf_mark(pkt, 8, GNRC_NETTYPE_UNDEF));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_SOCK));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    gnrc_pktbuf_set_quota(GNRC_PKTBUF_CLASS_SOCK, GNRC_PKTBUF_QUOTA_SOCK);
+}
+
+static void test_pktbuf_quota__accounting(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr, *dup;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, 16, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_set_class(pkt, GNRC_PKTBUF_CLASS_RX));
+    hdr = gnrc_pktbuf_mark(pkt, 8, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT_EQUAL_INT((2 * sizeof(gnrc_pktsnip_t)) + 16,
+                          gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_RX));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 4));
+    TEST_ASSERT_EQUAL_INT((2 * sizeof(gnrc_pktsnip_t)) + 12,
+                          gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_RX));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 20));
+    TEST_ASSERT_EQUAL_INT((2 * sizeof(gnrc_pktsnip_t)) + 28,
+                          gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_RX));
+    gnrc_pktbuf_hold(pkt, 1);
+    dup = gnrc_pktbuf_start_write(pkt);
+    TEST_ASSERT_NOT_NULL(dup);
+    TEST_ASSERT((3 * sizeof(gnrc_pktsnip_t)) + 48 ==
+                gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_RX));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_OTHER));
+    gnrc_pktbuf_release(dup);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_usage(GNRC_PKTBUF_CLASS_RX));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif
+
 Test *tests_pktbuf_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -937,6 +1070,9 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_realloc_data__nomemenough),
         new_TestFixture(test_pktbuf_realloc_data__shrink),
         new_TestFixture(test_pktbuf_realloc_data__memenough),
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
+        new_TestFixture(test_pktbuf_realloc_data__grow_in_place),
+#endif
         new_TestFixture(test_pktbuf_realloc_data__alignment),
         new_TestFixture(test_pktbuf_realloc_data__success),
         new_TestFixture(test_pktbuf_realloc_data__success2),
@@ -958,6 +1094,11 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_get_iovec__null),
         new_TestFixture(test_pktbuf_reverse_snips__too_full),
         new_TestFixture(test_pktbuf_reverse_snips__success),
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+        new_TestFixture(test_pktbuf_quota__ctrl_reserve),
+        new_TestFixture(test_pktbuf_quota__set_class),
+        new_TestFixture(test_pktbuf_quota__accounting),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(gnrc_pktbuf_tests, set_up, NULL, fixtures);
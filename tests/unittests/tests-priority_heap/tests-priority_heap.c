@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+
+#include "embUnit/embUnit.h"
+
+#include "priority_heap.h"
+
+#include "tests-priority_heap.h"
+
+#define NODES_NUMOF     (32U)
+
+static priority_heap_t heap;
+static priority_heap_node_t nodes[NODES_NUMOF];
+
+static void set_up(void)
+{
+    priority_heap_init(&heap);
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        priority_heap_node_init(&nodes[i]);
+        nodes[i].data = i;
+    }
+}
+
+static void test_priority_heap_empty(void)
+{
+    TEST_ASSERT_NULL(priority_heap_head(&heap));
+    TEST_ASSERT_NULL(priority_heap_remove_head(&heap));
+    TEST_ASSERT_NULL(priority_heap_last(&heap));
+    TEST_ASSERT_EQUAL_INT(0, priority_heap_len(&heap));
+}
+
+static void test_priority_heap_order(void)
+{
+    /* priorities in a scrambled order, the multiplier is coprime to 32 */
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        nodes[i].priority = (i * 13) % NODES_NUMOF;
+        priority_heap_add(&heap, &nodes[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(NODES_NUMOF, priority_heap_len(&heap));
+    TEST_ASSERT_EQUAL_INT(NODES_NUMOF - 1,
+                          priority_heap_last(&heap)->priority);
+
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        priority_heap_node_t *node = priority_heap_remove_head(&heap);
+
+        TEST_ASSERT_NOT_NULL(node);
+        TEST_ASSERT_EQUAL_INT(i, node->priority);
+    }
+    TEST_ASSERT_NULL(priority_heap_remove_head(&heap));
+}
+
+static void test_priority_heap_stable(void)
+{
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        nodes[i].priority = i % 2;
+        priority_heap_add(&heap, &nodes[i]);
+    }
+    TEST_ASSERT(priority_heap_last(&heap) == &nodes[NODES_NUMOF - 1]);
+
+    /* all even nodes, then all odd nodes, each in the order of adding */
+    for (unsigned i = 0; i < NODES_NUMOF; i += 2) {
+        TEST_ASSERT(priority_heap_remove_head(&heap) == &nodes[i]);
+    }
+    for (unsigned i = 1; i < NODES_NUMOF; i += 2) {
+        TEST_ASSERT(priority_heap_remove_head(&heap) == &nodes[i]);
+    }
+}
+
+static void test_priority_heap_remove(void)
+{
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        nodes[i].priority = (i * 7) % NODES_NUMOF;
+        priority_heap_add(&heap, &nodes[i]);
+    }
+    /* shape the heap, then remove inner nodes and the head */
+    priority_heap_remove_head(&heap);
+    for (unsigned i = 1; i < NODES_NUMOF; i += 3) {
+        priority_heap_remove(&heap, &nodes[i]);
+    }
+
+    uint32_t prev = 0;
+    unsigned numof = 0;
+    priority_heap_node_t *node;
+
+    while ((node = priority_heap_remove_head(&heap))) {
+        TEST_ASSERT(node->data % 3 != 1);
+        TEST_ASSERT(node->priority >= prev);
+        prev = node->priority;
+        numof++;
+    }
+    /* node 0 was the head, nodes 1, 4, ..., 31 were removed */
+    TEST_ASSERT_EQUAL_INT(NODES_NUMOF - 1 - 11, numof);
+}
+
+static void test_priority_heap_remove_last(void)
+{
+    for (unsigned i = 0; i < NODES_NUMOF; i++) {
+        nodes[i].priority = (i * 13) % NODES_NUMOF;
+        priority_heap_add(&heap, &nodes[i]);
+    }
+    priority_heap_remove_head(&heap);
+
+    for (unsigned i = NODES_NUMOF - 1; i > 0; i--) {
+        priority_heap_node_t *last = priority_heap_last(&heap);
+
+        TEST_ASSERT_EQUAL_INT(i, last->priority);
+        priority_heap_remove(&heap, last);
+        TEST_ASSERT_EQUAL_INT(i - 1, priority_heap_len(&heap));
+    }
+    TEST_ASSERT_NULL(priority_heap_head(&heap));
+}
+
+static void test_priority_heap_readd(void)
+{
+    nodes[0].priority = 5;
+    nodes[1].priority = 5;
+    priority_heap_add(&heap, &nodes[0]);
+    priority_heap_add(&heap, &nodes[1]);
+
+    /* an added again node goes behind the nodes of the same priority */
+    priority_heap_add(&heap, priority_heap_remove_head(&heap));
+    TEST_ASSERT(priority_heap_remove_head(&heap) == &nodes[1]);
+    TEST_ASSERT(priority_heap_remove_head(&heap) == &nodes[0]);
+}
+
+Test *tests_priority_heap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_priority_heap_empty),
+        new_TestFixture(test_priority_heap_order),
+        new_TestFixture(test_priority_heap_stable),
+        new_TestFixture(test_priority_heap_remove),
+        new_TestFixture(test_priority_heap_remove_last),
+        new_TestFixture(test_priority_heap_readd),
+    };
+
+    EMB_UNIT_TESTCALLER(priority_heap_tests, set_up, NULL, fixtures);
+
+    return (Test *)&priority_heap_tests;
+}
+
+void tests_priority_heap(void)
+{
+    TESTS_RUN(tests_priority_heap_tests());
+}
+/** @} */
@@ -25,10 +25,10 @@
 #include "saul_reg.h"
 #include "tests-saul_reg.h"
 
-static const saul_driver_t s0_dri = { NULL, NULL, SAUL_ACT_SERVO };
-static const saul_driver_t s1_dri = { NULL, NULL, SAUL_SENSE_TEMP };
-static const saul_driver_t s2_dri = { NULL, NULL, SAUL_SENSE_LIGHT };
-static const saul_driver_t s3_dri = { NULL, NULL, SAUL_ACT_LED_RGB };
+static const saul_driver_t s0_dri = { NULL, NULL, SAUL_ACT_SERVO, NULL };
+static const saul_driver_t s1_dri = { NULL, NULL, SAUL_SENSE_TEMP, NULL };
+static const saul_driver_t s2_dri = { NULL, NULL, SAUL_SENSE_LIGHT, NULL };
+static const saul_driver_t s3_dri = { NULL, NULL, SAUL_ACT_LED_RGB, NULL };
 
 static saul_reg_t s0 = { NULL, NULL, "S0", &s0_dri };
 static saul_reg_t s1 = { NULL, NULL, "S1", &s1_dri };
@@ -144,6 +144,20 @@ static void test_reg_find_name(void)
     TEST_ASSERT_NULL(dev);
 }
 
+static void test_reg_find_all(void)
+{
+    saul_reg_t *devs[4];
+
+    TEST_ASSERT_EQUAL_INT(4, saul_reg_find_all(SAUL_CLASS_ANY, devs, 4));
+    TEST_ASSERT_EQUAL_INT(2, saul_reg_find_all(SAUL_SENSE_ANY, devs, 4));
+    TEST_ASSERT(((devs[0] == &s1) && (devs[1] == &s2)) ||
+                ((devs[0] == &s2) && (devs[1] == &s1)));
+    TEST_ASSERT_EQUAL_INT(1, saul_reg_find_all(SAUL_ACT_ANY, devs, 1));
+    TEST_ASSERT_EQUAL_INT(1, saul_reg_find_all(SAUL_ACT_LED_RGB, devs, 4));
+    TEST_ASSERT(devs[0] == &s3);
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_find_all(SAUL_ACT_MOTOR, devs, 4));
+}
+
 static void test_reg_rm(void)
 {
     int res;
@@ -184,6 +198,143 @@ static void test_reg_rm(void)
     TEST_ASSERT_NULL(saul_reg);
 }
 
+static void test_reg_many(void)
+{
+    static const saul_driver_t temp_dri = { NULL, NULL, SAUL_SENSE_TEMP, NULL };
+    static const char *const names[] = {
+        "M9", "M8", "M7", "M6", "M5", "M4", "M3", "M2", "M1", "M0",
+        "N9", "N8", "N7", "N6", "N5", "N4", "N3", "N2", "N1", "N0",
+    };
+    saul_reg_t devs[sizeof(names) / sizeof(names[0])];
+    saul_reg_t *found[sizeof(devs) / sizeof(devs[0])];
+    const unsigned numof = sizeof(devs) / sizeof(devs[0]);
+
+    for (unsigned i = 0; i < numof; i++) {
+        devs[i].dev = NULL;
+        devs[i].name = names[i];
+        devs[i].driver = (i & 1) ? &temp_dri : &s0_dri;
+        saul_reg_add(&devs[i]);
+    }
+    /* lookups work whether all devices fit into the index or not */
+    for (unsigned n = numof; n > 0; n--) {
+        TEST_ASSERT(saul_reg_find_nth(0) == &devs[0]);
+        TEST_ASSERT(saul_reg_find_nth(n - 1) == &devs[n - 1]);
+        TEST_ASSERT_NULL(saul_reg_find_nth(n));
+        TEST_ASSERT(saul_reg_find_name(names[n - 1]) == &devs[n - 1]);
+        TEST_ASSERT(saul_reg_find_type(SAUL_ACT_SERVO) == &devs[0]);
+        TEST_ASSERT_EQUAL_INT(n, saul_reg_find_all(SAUL_CLASS_ANY, found,
+                                                   numof));
+        TEST_ASSERT_EQUAL_INT(n / 2, saul_reg_find_all(SAUL_SENSE_TEMP, found,
+                                                       numof));
+        if (n > 1) {
+            TEST_ASSERT(saul_reg_find_type(SAUL_SENSE_TEMP) == &devs[1]);
+            TEST_ASSERT(found[0] == &devs[1]);
+        }
+        saul_reg_rm(&devs[n - 1]);
+        TEST_ASSERT_NULL(saul_reg_find_name(names[n - 1]));
+    }
+    TEST_ASSERT_NULL(saul_reg);
+    TEST_ASSERT_NULL(saul_reg_find_nth(0));
+}
+
+static int read_temp(const void *dev, phydat_t *res)
+{
+    (void)dev;
+    res->val[0] = 215;
+    res->unit = UNIT_TEMP_C;
+    res->scale = -1;
+    return 1;
+}
+
+static int read_fail(const void *dev, phydat_t *res)
+{
+    (void)dev;
+    (void)res;
+    return -ECANCELED;
+}
+
+static void read_cb(saul_reg_t *dev, const phydat_t *res, int dim, void *arg)
+{
+    int *sum = arg;
+
+    TEST_ASSERT_EQUAL_INT(1, dim);
+    TEST_ASSERT(dev->driver->read == read_temp);
+    *sum += res->val[0];
+}
+
+static void test_reg_read_all(void)
+{
+    static const saul_driver_t temp_dri = { read_temp, NULL, SAUL_SENSE_TEMP, NULL };
+    static const saul_driver_t fail_dri = { read_fail, NULL, SAUL_SENSE_HUM, NULL };
+    static const saul_driver_t act_dri = { read_temp, NULL, SAUL_ACT_SWITCH, NULL };
+    saul_reg_t t0 = { NULL, NULL, "T0", &temp_dri };
+    saul_reg_t t1 = { NULL, NULL, "T1", &fail_dri };
+    saul_reg_t t2 = { NULL, NULL, "T2", &temp_dri };
+    saul_reg_t t3 = { NULL, NULL, "T3", &act_dri };
+    int sum = 0;
+
+    saul_reg_add(&t0);
+    saul_reg_add(&t1);
+    saul_reg_add(&t2);
+    saul_reg_add(&t3);
+
+    /* the failing device is skipped, the actuator does not match */
+    TEST_ASSERT_EQUAL_INT(2, saul_reg_read_all(SAUL_SENSE_ANY, read_cb, &sum));
+    TEST_ASSERT_EQUAL_INT(430, sum);
+
+    sum = 0;
+    TEST_ASSERT_EQUAL_INT(2, saul_reg_read_all(SAUL_SENSE_TEMP, read_cb, &sum));
+    TEST_ASSERT_EQUAL_INT(430, sum);
+
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_read_all(SAUL_SENSE_LIGHT, read_cb,
+                                               &sum));
+
+    saul_reg_rm(&t0);
+    saul_reg_rm(&t1);
+    saul_reg_rm(&t2);
+    saul_reg_rm(&t3);
+    TEST_ASSERT_NULL(saul_reg);
+}
+
+static int read_burst(const void *dev, phydat_t *res, unsigned max)
+{
+    (void)dev;
+    unsigned i;
+
+    for (i = 0; (i < max) && (i < 4); i++) {
+        read_temp(dev, &res[i]);
+        res[i].val[0] += i;
+    }
+    return i;
+}
+
+static void test_reg_read_burst(void)
+{
+    static const saul_driver_t temp_dri = { read_temp, NULL, SAUL_SENSE_TEMP,
+                                            NULL };
+    static const saul_driver_t fifo_dri = { read_temp, NULL, SAUL_SENSE_TEMP,
+                                            read_burst };
+    static const saul_driver_t fail_dri = { read_fail, NULL, SAUL_SENSE_HUM,
+                                            NULL };
+    saul_reg_t t0 = { NULL, NULL, "T0", &temp_dri };
+    saul_reg_t t1 = { NULL, NULL, "T1", &fifo_dri };
+    saul_reg_t t2 = { NULL, NULL, "T2", &fail_dri };
+    phydat_t res[8];
+
+    TEST_ASSERT_EQUAL_INT(-ENODEV, saul_reg_read_burst(NULL, res, 8));
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_read_burst(&t0, res, 0));
+
+    /* without a burst function a single sample is read */
+    TEST_ASSERT_EQUAL_INT(1, saul_reg_read_burst(&t0, res, 8));
+    TEST_ASSERT_EQUAL_INT(215, res[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(-ECANCELED, saul_reg_read_burst(&t2, res, 8));
+
+    TEST_ASSERT_EQUAL_INT(4, saul_reg_read_burst(&t1, res, 8));
+    TEST_ASSERT_EQUAL_INT(215, res[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(218, res[3].val[0]);
+    TEST_ASSERT_EQUAL_INT(2, saul_reg_read_burst(&t1, res, 2));
+}
+
 Test *tests_saul_reg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -192,7 +343,11 @@ Test *tests_saul_reg_tests(void)
         new_TestFixture(test_reg_find_nth),
         new_TestFixture(test_reg_find_type),
         new_TestFixture(test_reg_find_name),
-        new_TestFixture(test_reg_rm)
+        new_TestFixture(test_reg_find_all),
+        new_TestFixture(test_reg_rm),
+        new_TestFixture(test_reg_many),
+        new_TestFixture(test_reg_read_all),
+        new_TestFixture(test_reg_read_burst)
     };
 
     EMB_UNIT_TESTCALLER(pkt_tests, NULL, NULL, fixtures);
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "senml.h"
+#include "tests-senml.h"
+
+static uint8_t _buf[64];
+static cbor_enc_t _enc;
+
+static void set_up(void)
+{
+    memset(_buf, 0xff, sizeof(_buf));
+    cbor_enc_init(&_enc, _buf, sizeof(_buf));
+}
+
+static void _assert_encoding(const uint8_t *expected, size_t len)
+{
+    TEST_ASSERT_EQUAL_INT(len, cbor_enc_len(&_enc));
+    TEST_ASSERT(memcmp(expected, _buf, len) == 0);
+}
+
+static void test_senml_cbor_records(void)
+{
+    /* [{0: "on", 4: true}, {3: "ab"}, {-2: "a", 2: -1000000000000}] */
+    static const uint8_t expected[] = {
+        0x83,
+        0xa2, 0x00, 0x62, 0x6f, 0x6e, 0x04, 0xf5,
+        0xa1, 0x03, 0x62, 0x61, 0x62,
+        0xa2, 0x21, 0x61, 0x61, 0x02,
+        0x3b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x0f, 0xff,
+    };
+    senml_rec_t rec = { .n = "on" };
+
+    cbor_enc_array(&_enc, 3);
+    senml_cbor_bool(&_enc, &rec, true);
+    rec.n = NULL;
+    senml_cbor_str(&_enc, &rec, "ab", 2);
+    rec.bn = "a";
+    senml_cbor_int(&_enc, &rec, -1000000000000);
+    _assert_encoding(expected, sizeof(expected));
+}
+
+static void test_senml_cbor_phydat(void)
+{
+    /* [{-2: "/3303/0/", 0: "5700", 1: "Cel", 2: 4([-1, 215])}] */
+    static const uint8_t expected[] = {
+        0x81, 0xa4,
+        0x21, 0x68, 0x2f, 0x33, 0x33, 0x30, 0x33, 0x2f, 0x30, 0x2f,
+        0x00, 0x64, 0x35, 0x37, 0x30, 0x30,
+        0x01, 0x63, 0x43, 0x65, 0x6c,
+        0x02, 0xc4, 0x82, 0x20, 0x18, 0xd7,
+    };
+    static const char *const names[] = { "5700" };
+    phydat_t data = { .val = { 215 }, .unit = UNIT_TEMP_C, .scale = -1 };
+
+    cbor_enc_array(&_enc, 1);
+    senml_cbor_phydat(&_enc, "/3303/0/", names, &data, 1);
+    _assert_encoding(expected, sizeof(expected));
+}
+
+static void test_senml_cbor_phydat_dim3(void)
+{
+    /* [_ {-2: "a", 2: 1}, {2: -2}, {2: 3}] without a SenML unit for g */
+    static const uint8_t expected[] = {
+        0x9f,
+        0xa2, 0x21, 0x61, 0x61, 0x02, 0x01,
+        0xa1, 0x02, 0x21,
+        0xa1, 0x02, 0x03,
+        0xff,
+    };
+    phydat_t data = { .val = { 1, -2, 3 }, .unit = UNIT_G, .scale = 0 };
+
+    cbor_enc_array_indef(&_enc);
+    senml_cbor_phydat(&_enc, "a", NULL, &data, 3);
+    cbor_enc_break(&_enc);
+    _assert_encoding(expected, sizeof(expected));
+}
+
+Test *tests_senml_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_senml_cbor_records),
+        new_TestFixture(test_senml_cbor_phydat),
+        new_TestFixture(test_senml_cbor_phydat_dim3),
+    };
+
+    EMB_UNIT_TESTCALLER(senml_tests, set_up, NULL, fixtures);
+
+    return (Test *)&senml_tests;
+}
+
+void tests_senml(void)
+{
+    TESTS_RUN(tests_senml_tests());
+}
+/** @} */
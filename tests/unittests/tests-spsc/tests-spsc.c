@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include "embUnit.h"
+
+#include "sched.h"
+#include "spsc.h"
+
+#include "tests-spsc.h"
+
+#define BUF_SIZE    (4U)
+
+static msg_t _buf[BUF_SIZE];
+static spsc_t _chan;
+
+static void set_up(void)
+{
+    spsc_init(&_chan, _buf, BUF_SIZE, SPSC_THREAD_FLAG);
+}
+
+static void test_spsc_get__empty(void)
+{
+    msg_t msg;
+
+    TEST_ASSERT_EQUAL_INT(0, spsc_avail(&_chan));
+    TEST_ASSERT_EQUAL_INT(0, spsc_get(&_chan, &msg));
+    TEST_ASSERT_EQUAL_INT(0, spsc_get_bulk(&_chan, &msg, 1));
+}
+
+static void test_spsc_put_get(void)
+{
+    msg_t msg = { .type = 0x1234, .content = { .value = 42 } };
+
+    TEST_ASSERT_EQUAL_INT(1, spsc_put(&_chan, &msg));
+    TEST_ASSERT_EQUAL_INT(1, spsc_avail(&_chan));
+    msg.type = 0;
+    msg.content.value = 0;
+    TEST_ASSERT_EQUAL_INT(1, spsc_get(&_chan, &msg));
+    TEST_ASSERT_EQUAL_INT(0x1234, msg.type);
+    TEST_ASSERT_EQUAL_INT(42, msg.content.value);
+    TEST_ASSERT_EQUAL_INT(sched_active_pid, msg.sender_pid);
+    TEST_ASSERT_EQUAL_INT(0, spsc_avail(&_chan));
+}
+
+static void test_spsc_put__full(void)
+{
+    msg_t msg = { .type = 0 };
+
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(1, spsc_put(&_chan, &msg));
+    }
+    TEST_ASSERT_EQUAL_INT(0, spsc_put(&_chan, &msg));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, spsc_avail(&_chan));
+    /* one slot is free again after a get */
+    TEST_ASSERT_EQUAL_INT(1, spsc_get(&_chan, &msg));
+    TEST_ASSERT_EQUAL_INT(1, spsc_put(&_chan, &msg));
+}
+
+static void test_spsc_get_bulk__wrap(void)
+{
+    msg_t msgs[BUF_SIZE + 1];
+    msg_t msg = { .type = 0 };
+
+    /* move the indices off zero, so the bulk read wraps around */
+    for (unsigned i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(1, spsc_put(&_chan, &msg));
+        TEST_ASSERT_EQUAL_INT(1, spsc_get(&_chan, &msg));
+    }
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        msg.type = i;
+        TEST_ASSERT_EQUAL_INT(1, spsc_put(&_chan, &msg));
+    }
+    TEST_ASSERT_EQUAL_INT(2, spsc_get_bulk(&_chan, msgs, 2));
+    TEST_ASSERT_EQUAL_INT(0, msgs[0].type);
+    TEST_ASSERT_EQUAL_INT(1, msgs[1].type);
+    TEST_ASSERT_EQUAL_INT(2, spsc_get_bulk(&_chan, msgs, BUF_SIZE + 1));
+    TEST_ASSERT_EQUAL_INT(2, msgs[0].type);
+    TEST_ASSERT_EQUAL_INT(3, msgs[1].type);
+    TEST_ASSERT_EQUAL_INT(0, spsc_avail(&_chan));
+}
+
+static void test_spsc_wait__avail(void)
+{
+    msg_t msg = { .type = 0 };
+
+    TEST_ASSERT_EQUAL_INT(1, spsc_put(&_chan, &msg));
+    TEST_ASSERT_EQUAL_INT(1, spsc_put(&_chan, &msg));
+    /* returns immediately, since there are messages */
+    TEST_ASSERT_EQUAL_INT(2, spsc_wait(&_chan));
+}
+
+static Test *tests_spsc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_spsc_get__empty),
+        new_TestFixture(test_spsc_put_get),
+        new_TestFixture(test_spsc_put__full),
+        new_TestFixture(test_spsc_get_bulk__wrap),
+        new_TestFixture(test_spsc_wait__avail),
+    };
+
+    EMB_UNIT_TESTCALLER(spsc_tests, set_up, NULL, fixtures);
+
+    return (Test *)&spsc_tests;
+}
+
+void tests_spsc(void)
+{
+    TESTS_RUN(tests_spsc_tests());
+}
+/** @} */
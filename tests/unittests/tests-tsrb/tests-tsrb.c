@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "tsrb.h"
+#include "tests-tsrb.h"
+
+static char _mem[8];
+static tsrb_t _rb;
+
+static void set_up(void)
+{
+    tsrb_init(&_rb, _mem, sizeof(_mem));
+}
+
+static void test_tsrb_one(void)
+{
+    TEST_ASSERT_EQUAL_INT(-1, tsrb_get_one(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_add_one(&_rb, 'a'));
+    TEST_ASSERT_EQUAL_INT(1, tsrb_avail(&_rb));
+    TEST_ASSERT_EQUAL_INT('a', tsrb_get_one(&_rb));
+    TEST_ASSERT(tsrb_empty(&_rb));
+}
+
+static void test_tsrb_bulk(void)
+{
+    char out[16];
+
+    TEST_ASSERT_EQUAL_INT(6, tsrb_add(&_rb, "abcdef", 6));
+    TEST_ASSERT_EQUAL_INT(5, tsrb_get(&_rb, out, 5));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "abcde", 5));
+    /* wraps around, only 7 fit */
+    TEST_ASSERT_EQUAL_INT(7, tsrb_add(&_rb, "ghijklmn", 8));
+    TEST_ASSERT(tsrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(-1, tsrb_add_one(&_rb, 'x'));
+    TEST_ASSERT_EQUAL_INT(8, tsrb_get(&_rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "fghijklm", 8));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_get(&_rb, out, sizeof(out)));
+}
+
+static void test_tsrb_drop(void)
+{
+    tsrb_add(&_rb, "abc", 3);
+    TEST_ASSERT_EQUAL_INT(2, tsrb_drop(&_rb, 2));
+    TEST_ASSERT_EQUAL_INT('c', tsrb_get_one(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_drop(&_rb, 2));
+}
+
+static void test_tsrb_regions(void)
+{
+    size_t n;
+    char *region;
+
+    region = tsrb_reserve(&_rb, &n);
+    TEST_ASSERT(region == _mem);
+    TEST_ASSERT_EQUAL_INT(8, n);
+    memcpy(region, "abcdef", 6);
+    tsrb_commit(&_rb, 6);
+    TEST_ASSERT_EQUAL_INT(6, tsrb_avail(&_rb));
+
+    region = tsrb_peek_region(&_rb, &n);
+    TEST_ASSERT(region == _mem);
+    TEST_ASSERT_EQUAL_INT(6, n);
+    tsrb_drop(&_rb, 4);
+
+    /* the free space wraps around */
+    region = tsrb_reserve(&_rb, &n);
+    TEST_ASSERT(region == &_mem[6]);
+    TEST_ASSERT_EQUAL_INT(2, n);
+    memcpy(region, "gh", 2);
+    tsrb_commit(&_rb, 2);
+    region = tsrb_reserve(&_rb, &n);
+    TEST_ASSERT(region == _mem);
+    TEST_ASSERT_EQUAL_INT(4, n);
+    memcpy(region, "i", 1);
+    tsrb_commit(&_rb, 1);
+
+    region = tsrb_peek_region(&_rb, &n);
+    TEST_ASSERT(region == &_mem[4]);
+    TEST_ASSERT_EQUAL_INT(4, n);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(region, "efgh", 4));
+    tsrb_drop(&_rb, n);
+    region = tsrb_peek_region(&_rb, &n);
+    TEST_ASSERT(region == _mem);
+    TEST_ASSERT_EQUAL_INT(1, n);
+    TEST_ASSERT_EQUAL_INT('i', *region);
+}
+
+Test *tests_tsrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tsrb_one),
+        new_TestFixture(test_tsrb_bulk),
+        new_TestFixture(test_tsrb_drop),
+        new_TestFixture(test_tsrb_regions),
+    };
+
+    EMB_UNIT_TESTCALLER(tsrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&tsrb_tests;
+}
+
+void tests_tsrb(void)
+{
+    TESTS_RUN(tests_tsrb_tests());
+}
+/** @} */
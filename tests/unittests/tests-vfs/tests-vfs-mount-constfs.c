@@ -55,6 +55,36 @@ static const constfs_t fs_data = {
     .nfiles = sizeof(_files) / sizeof(_files[0]),
 };
 
+/* sorted by path */
+static const constfs_file_t _sorted_files[] = {
+    {
+        .path = "/a",
+        .data = str_data,
+        .size = 1,
+    },
+    {
+        .path = "/data.bin",
+        .data = bin_data,
+        .size = sizeof(bin_data),
+    },
+    {
+        .path = "/dir/test.txt",
+        .data = str_data,
+        .size = sizeof(str_data),
+    },
+    {
+        .path = "/test.txt",
+        .data = str_data,
+        .size = sizeof(str_data),
+    },
+};
+
+static const constfs_t sorted_fs_data = {
+    .files = _sorted_files,
+    .nfiles = sizeof(_sorted_files) / sizeof(_sorted_files[0]),
+    .sorted = true,
+};
+
 static vfs_mount_t _test_vfs_mount_invalid_mount = {
     .mount_point = "test",
     .fs = &constfs_file_system,
@@ -67,6 +97,12 @@ static vfs_mount_t _test_vfs_mount = {
     .private_data = (void *)&fs_data,
 };
 
+static vfs_mount_t _test_vfs_mount_sorted = {
+    .mount_point = "/test",
+    .fs = &constfs_file_system,
+    .private_data = (void *)&sorted_fs_data,
+};
+
 static void test_vfs_mount_umount(void)
 {
     int res;
@@ -76,6 +112,40 @@ static void test_vfs_mount_umount(void)
     TEST_ASSERT_EQUAL_INT(0, res);
 }
 
+static vfs_mount_t _test_vfs_mount_nested = {
+    .mount_point = "/test/nested",
+    .fs = &constfs_file_system,
+    .private_data = (void *)&fs_data,
+};
+
+static void test_vfs_mount__nested(void)
+{
+    int res;
+    /* mounted in reverse order, the longest mount point must win anyway */
+    res = vfs_mount(&_test_vfs_mount_nested);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    int fd = vfs_open("/test/nested/test.txt", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+    /* the file is open on the nested mount */
+    res = vfs_umount(&_test_vfs_mount_nested);
+    TEST_ASSERT_EQUAL_INT(-EBUSY, res);
+    vfs_close(fd);
+
+    fd = vfs_open("/test/nestedx/test.txt", O_RDONLY, 0);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, fd);
+    fd = vfs_open("/test/test.txt", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+    res = vfs_umount(&_test_vfs_mount_nested);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    vfs_close(fd);
+
+    res = vfs_umount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
 static void test_vfs_mount__invalid(void)
 {
     int res;
@@ -171,6 +241,119 @@ static void test_vfs_constfs_read_lseek(void)
     TEST_ASSERT_EQUAL_INT(0, res);
 }
 
+static void test_vfs_constfs_readv(void)
+{
+    int res;
+    res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    int fd = vfs_open("/test/data.bin", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+
+    uint8_t head[4];
+    uint8_t tail[64];
+    iolist_t iol_tail = { .iol_base = tail, .iol_len = sizeof(tail) };
+    iolist_t iol_empty = { .iol_next = &iol_tail };
+    iolist_t iol_head = { .iol_next = &iol_empty, .iol_base = head,
+                          .iol_len = sizeof(head) };
+    ssize_t nbytes = vfs_readv(fd, &iol_head);
+    TEST_ASSERT_EQUAL_INT(sizeof(bin_data), nbytes);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(head, bin_data, sizeof(head)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(tail, &bin_data[sizeof(head)],
+                                    sizeof(bin_data) - sizeof(head)));
+
+    /* end of file */
+    nbytes = vfs_readv(fd, &iol_head);
+    TEST_ASSERT_EQUAL_INT(0, nbytes);
+
+    res = vfs_writev(fd, &iol_head);
+    TEST_ASSERT_EQUAL_INT(-EBADF, res);
+
+    res = vfs_close(fd);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    res = vfs_umount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
+static void test_vfs_constfs_mmap(void)
+{
+    int res;
+    res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    int fd = vfs_open("/test/data.bin", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+
+    const void *addr = NULL;
+    ssize_t nbytes = vfs_mmap(fd, &addr);
+    TEST_ASSERT_EQUAL_INT(sizeof(bin_data), nbytes);
+    TEST_ASSERT(addr == bin_data);
+
+    /* the position is not changed, but followed */
+    off_t pos = vfs_lseek(fd, 0, SEEK_CUR);
+    TEST_ASSERT_EQUAL_INT(0, pos);
+    pos = vfs_lseek(fd, 4, SEEK_SET);
+    TEST_ASSERT_EQUAL_INT(4, pos);
+    nbytes = vfs_mmap(fd, &addr);
+    TEST_ASSERT_EQUAL_INT(sizeof(bin_data) - 4, nbytes);
+    TEST_ASSERT(addr == &bin_data[4]);
+
+    pos = vfs_lseek(fd, 1, SEEK_END);
+    TEST_ASSERT_EQUAL_INT(sizeof(bin_data) + 1, pos);
+    nbytes = vfs_mmap(fd, &addr);
+    TEST_ASSERT_EQUAL_INT(0, nbytes);
+
+    res = vfs_mmap(fd, NULL);
+    TEST_ASSERT_EQUAL_INT(-EFAULT, res);
+
+    res = vfs_close(fd);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_mmap(fd, &addr);
+    TEST_ASSERT_EQUAL_INT(-EBADF, res);
+
+    res = vfs_umount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
+static void test_vfs_constfs_sorted(void)
+{
+    static const char *paths[] = {
+        "/test/a", "/test/data.bin", "/test/dir/test.txt", "/test/test.txt",
+    };
+    int res;
+    res = vfs_mount(&_test_vfs_mount_sorted);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    for (unsigned i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        struct stat buf;
+        res = vfs_stat(paths[i], &buf);
+        TEST_ASSERT_EQUAL_INT(0, res);
+        TEST_ASSERT_EQUAL_INT(_sorted_files[i].size, buf.st_size);
+        TEST_ASSERT_EQUAL_INT(i, buf.st_ino);
+
+        int fd = vfs_open(paths[i], O_RDONLY, 0);
+        TEST_ASSERT(fd >= 0);
+        const void *addr;
+        ssize_t nbytes = vfs_mmap(fd, &addr);
+        TEST_ASSERT_EQUAL_INT(_sorted_files[i].size, nbytes);
+        TEST_ASSERT(addr == _sorted_files[i].data);
+        vfs_close(fd);
+    }
+
+    /* before, between and after the files */
+    static const char *missing[] = {
+        "/test/0", "/test/b", "/test/dir", "/test/zzz",
+    };
+    for (unsigned i = 0; i < sizeof(missing) / sizeof(missing[0]); i++) {
+        int fd = vfs_open(missing[i], O_RDONLY, 0);
+        TEST_ASSERT_EQUAL_INT(-ENOENT, fd);
+    }
+
+    res = vfs_umount(&_test_vfs_mount_sorted);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
 #if MODULE_NEWLIB || defined(BOARD_NATIVE)
 static void test_vfs_constfs__posix(void)
 {
@@ -206,10 +389,14 @@ Test *tests_vfs_mount_constfs_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_vfs_mount_umount),
+        new_TestFixture(test_vfs_mount__nested),
         new_TestFixture(test_vfs_mount__invalid),
         new_TestFixture(test_vfs_umount__invalid_mount),
         new_TestFixture(test_vfs_constfs_open),
         new_TestFixture(test_vfs_constfs_read_lseek),
+        new_TestFixture(test_vfs_constfs_readv),
+        new_TestFixture(test_vfs_constfs_mmap),
+        new_TestFixture(test_vfs_constfs_sorted),
 #if MODULE_NEWLIB || defined(BOARD_NATIVE)
         new_TestFixture(test_vfs_constfs__posix),
 #endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       vfs_async test application
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fs/constfs.h"
+#include "thread.h"
+#include "vfs.h"
+#include "vfs_async.h"
+
+static const uint8_t _data[] = "0123456789abcdef";
+
+static const constfs_file_t _files[] = {
+    {
+        .path = "/data.txt",
+        .data = _data,
+        .size = sizeof(_data),
+    },
+};
+
+static const constfs_t _fs_data = {
+    .files = _files,
+    .nfiles = sizeof(_files) / sizeof(_files[0]),
+};
+
+static vfs_mount_t _mount = {
+    .mount_point = "/const",
+    .fs = &constfs_file_system,
+    .private_data = (void *)&_fs_data,
+};
+
+static event_queue_t _queue;
+static vfs_async_t _req;
+static event_t _done;
+
+static ssize_t _wait(void)
+{
+    event_t *event = event_wait(&_queue);
+
+    if (event != &_done) {
+        puts("[FAILED] unexpected event");
+    }
+    return _req.res;
+}
+
+int main(void)
+{
+    char head[4];
+    char tail[32];
+    iolist_t iol_tail = { .iol_base = tail, .iol_len = sizeof(tail) };
+    iolist_t iol_head = { .iol_next = &iol_tail, .iol_base = head,
+                          .iol_len = sizeof(head) };
+
+    puts("vfs_async test application");
+    event_queue_init(&_queue);
+
+    if (vfs_mount(&_mount) < 0) {
+        puts("[FAILED] mount");
+        return 1;
+    }
+    int fd = vfs_open("/const/data.txt", O_RDONLY, 0);
+    if (fd < 0) {
+        puts("[FAILED] open");
+        return 1;
+    }
+
+    vfs_readv_async(&_req, fd, &iol_head, &_queue, &_done);
+    ssize_t res = _wait();
+    printf("readv: %d\n", (int)res);
+    if ((res != sizeof(_data)) || memcmp(head, _data, sizeof(head)) ||
+        memcmp(tail, &_data[sizeof(head)], sizeof(_data) - sizeof(head))) {
+        puts("[FAILED] readv");
+        return 1;
+    }
+
+    vfs_write_async(&_req, fd, head, sizeof(head), &_queue, &_done);
+    res = _wait();
+    printf("write: %d\n", (int)res);
+    if (res != -EBADF) {
+        puts("[FAILED] write to read only file");
+        return 1;
+    }
+
+    vfs_close(fd);
+    vfs_umount(&_mount);
+    puts("[SUCCESS]");
+    return 0;
+}